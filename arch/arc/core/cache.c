@@ -140,6 +140,50 @@ void sys_cache_flush(vaddr_t start_addr, size_t size)
 	dcache_flush_mlines((u32_t)start_addr, (u32_t)size);
 }
 
+void sys_cache_data_range_flush(void *addr, size_t size)
+{
+	dcache_flush_mlines((u32_t)addr, (u32_t)size);
+}
+
+/**
+ *
+ * @brief Invalidate multiple d-cache lines
+ *
+ * The lines are discarded without being written back. Every line touched
+ * by the range is invalidated, so data sharing the first or last line with
+ * it is lost as well.
+ *
+ * @param addr the pointer to start the multi-line invalidation
+ * @param size the number of bytes that are to be invalidated
+ *
+ * @return N/A
+ */
+void sys_cache_data_range_invalidate(void *addr, size_t size)
+{
+	u32_t start_addr = (u32_t)addr;
+	u32_t end_addr;
+	unsigned int key;
+
+	if (!dcache_available() || (size == 0U)) {
+		return;
+	}
+
+	end_addr = start_addr + size - 1;
+	start_addr &= (u32_t)(~(DCACHE_LINE_SIZE - 1));
+
+	key = irq_lock(); /* --enter critical section-- */
+
+	do {
+		z_arc_v2_aux_reg_write(_ARC_V2_DC_IVDL, start_addr);
+		__asm__ volatile("nop_s");
+		__asm__ volatile("nop_s");
+		__asm__ volatile("nop_s");
+		start_addr += DCACHE_LINE_SIZE;
+	} while (start_addr <= end_addr);
+
+	irq_unlock(key); /* --exit critical section-- */
+}
+
 
 #if defined(CONFIG_CACHE_LINE_SIZE_DETECT)
 size_t sys_cache_line_size;
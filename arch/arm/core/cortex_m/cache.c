@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief d-cache maintenance for ARM Cortex-M7
+ */
+
+#include <kernel.h>
+#include <arch/cpu.h>
+#include <cache.h>
+#include <arch/arm/cortex_m/cmsis.h>
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+
+/* The maintenance by address works on whole lines */
+#define DCACHE_LINE_MASK ((uintptr_t)CONFIG_CACHE_LINE_SIZE - 1)
+
+static inline bool dcache_enabled(void)
+{
+	return (SCB->CCR & SCB_CCR_DC_Msk) != 0U;
+}
+
+void sys_cache_data_range_flush(void *addr, size_t size)
+{
+	uintptr_t start = (uintptr_t)addr & ~DCACHE_LINE_MASK;
+
+	if (!dcache_enabled() || size == 0U) {
+		return;
+	}
+
+	SCB_CleanDCache_by_Addr((uint32_t *)start,
+				size + (uintptr_t)addr - start);
+}
+
+void sys_cache_data_range_invalidate(void *addr, size_t size)
+{
+	uintptr_t start = (uintptr_t)addr & ~DCACHE_LINE_MASK;
+
+	if (!dcache_enabled() || size == 0U) {
+		return;
+	}
+
+	SCB_InvalidateDCache_by_Addr((uint32_t *)start,
+				     size + (uintptr_t)addr - start);
+}
+
+#else
+
+/* The SoC implements no d-cache */
+
+void sys_cache_data_range_flush(void *addr, size_t size)
+{
+	ARG_UNUSED(addr);
+	ARG_UNUSED(size);
+}
+
+void sys_cache_data_range_invalidate(void *addr, size_t size)
+{
+	ARG_UNUSED(addr);
+	ARG_UNUSED(size);
+}
+
+#endif /* __DCACHE_PRESENT */
+
+void sys_cache_flush(vaddr_t virt, size_t size)
+{
+	sys_cache_data_range_flush((void *)virt, size);
+}
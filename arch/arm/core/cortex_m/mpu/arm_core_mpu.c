@@ -9,6 +9,7 @@
 #include <kernel.h>
 #include <soc.h>
 #include <kernel_structs.h>
+#include <string.h>
 
 #include "arm_core_mpu_dev.h"
 #include <linker/linker-defs.h>
@@ -35,6 +36,13 @@ LOG_MODULE_REGISTER(mpu);
 	(IS_ENABLED(CONFIG_MPU_STACK_GUARD) ? 1 : 0)
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_ARM_MPU_DYNAMIC_REGIONS_CACHE)
+/* Copy of the dynamic regions currently programmed in the MPU */
+static struct k_mem_partition mpu_dyn_regions[_MAX_DYNAMIC_MPU_REGIONS_NUM];
+static u8_t mpu_dyn_regions_num;
+static bool mpu_dyn_regions_valid;
+#endif /* CONFIG_ARM_MPU_DYNAMIC_REGIONS_CACHE */
+
 /* Convenience macros to denote the start address and the size of the system
  * memory area, where dynamic memory regions may be programmed at run-time.
  */
@@ -142,6 +150,48 @@ void z_arm_configure_static_mpu_regions(void)
  * For some MPU architectures, such as the unmodified ARMv8-M MPU,
  * the function must execute with MPU enabled.
  */
+#if defined(CONFIG_ARM_MPU_DYNAMIC_REGIONS_CACHE)
+static bool mpu_dyn_region_equal(const struct k_mem_partition *region,
+	const struct k_mem_partition *programmed)
+{
+	return region->start == programmed->start &&
+		region->size == programmed->size &&
+		memcmp(&region->attr, &programmed->attr,
+		       sizeof(region->attr)) == 0;
+}
+
+/* Program the dynamic regions which differ from those already in the MPU */
+static void mpu_dyn_regions_configure(const struct k_mem_partition
+	*dynamic_regions[], u8_t region_num)
+{
+	u8_t first = 0U;
+
+	if (!mpu_dyn_regions_valid) {
+		arm_core_mpu_configure_dynamic_mpu_regions(dynamic_regions,
+			region_num);
+		mpu_dyn_regions_valid = true;
+	} else {
+		while (first < MIN(region_num, mpu_dyn_regions_num) &&
+		       mpu_dyn_region_equal(dynamic_regions[first],
+					    &mpu_dyn_regions[first])) {
+			first++;
+		}
+
+		if (first == region_num && region_num == mpu_dyn_regions_num) {
+			return;
+		}
+
+		arm_core_mpu_update_dynamic_mpu_regions(dynamic_regions,
+			region_num, first, mpu_dyn_regions_num);
+	}
+
+	for (u8_t i = first; i < region_num; i++) {
+		mpu_dyn_regions[i] = *dynamic_regions[i];
+	}
+	mpu_dyn_regions_num = region_num;
+}
+#endif /* CONFIG_ARM_MPU_DYNAMIC_REGIONS_CACHE */
+
 void z_arm_configure_dynamic_mpu_regions(struct k_thread *thread)
 {
 	/* Define an array of k_mem_partition objects to hold the configuration
@@ -253,9 +303,15 @@ void z_arm_configure_dynamic_mpu_regions(struct k_thread *thread)
 #endif /* CONFIG_MPU_STACK_GUARD */
 
 	/* Configure the dynamic MPU regions */
+#if defined(CONFIG_ARM_MPU_DYNAMIC_REGIONS_CACHE)
+	mpu_dyn_regions_configure(
+		(const struct k_mem_partition **)dynamic_regions,
+		region_num);
+#else
 	arm_core_mpu_configure_dynamic_mpu_regions(
 		(const struct k_mem_partition **)dynamic_regions,
 		region_num);
+#endif
 }
 
 #if defined(CONFIG_USERSPACE)
@@ -304,6 +360,11 @@ void arch_mem_domain_destroy(struct k_mem_domain *domain)
 	 */
 	k_mem_partition_attr_t reset_attr = K_MEM_PARTITION_P_RW_U_NA;
 
+#if defined(CONFIG_ARM_MPU_DYNAMIC_REGIONS_CACHE)
+	/* The MPU no longer matches the cached regions */
+	mpu_dyn_regions_valid = false;
+#endif
+
 	for (i = 0; i < CONFIG_MAX_DOMAIN_PARTITIONS; i++) {
 		partition = domain->partitions[i];
 		if (partition.size == 0U) {
@@ -330,6 +391,10 @@ void arch_mem_domain_partition_remove(struct k_mem_domain *domain,
 		return;
 	}
 
+#if defined(CONFIG_ARM_MPU_DYNAMIC_REGIONS_CACHE)
+	mpu_dyn_regions_valid = false;
+#endif
+
 	arm_core_mpu_mem_partition_config_update(
 		&domain->partitions[partition_id], &reset_attr);
 }
@@ -187,6 +187,30 @@ void arm_core_mpu_mark_areas_for_dynamic_regions(
 void arm_core_mpu_configure_dynamic_mpu_regions(
 	const struct k_mem_partition *dynamic_regions[], u8_t regions_num);
 
+#if defined(CONFIG_ARM_MPU_DYNAMIC_REGIONS_CACHE)
+/**
+ * @brief update a set of dynamic MPU regions
+ *
+ * Internal API function to re-configure the dynamic MPU memory regions
+ * from a given one onwards, the previous ones being unchanged since the
+ * last call to arm_core_mpu_configure_dynamic_mpu_regions() or to this
+ * function.
+ *
+ * @param dynamic_regions[] an array of pointers to memory partitions
+ *                          to be programmed
+ * @param regions_num the number of regions to be programmed
+ * @param first the first region to be programmed
+ * @param prev_regions_num the number of dynamic regions currently
+ *                         programmed
+ *
+ * The function shall assert if the operation cannot be not performed
+ * successfully.
+ */
+void arm_core_mpu_update_dynamic_mpu_regions(
+	const struct k_mem_partition *dynamic_regions[], u8_t regions_num,
+	u8_t first, u8_t prev_regions_num);
+#endif /* CONFIG_ARM_MPU_DYNAMIC_REGIONS_CACHE */
+
 #if defined(CONFIG_USERSPACE)
 /**
  * @brief update configuration of an active memory partition
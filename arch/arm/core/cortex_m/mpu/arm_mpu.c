@@ -275,6 +275,35 @@ void arm_core_mpu_configure_dynamic_mpu_regions(const struct k_mem_partition
 	}
 }
 
+#if defined(CONFIG_ARM_MPU_DYNAMIC_REGIONS_CACHE)
+/**
+ * @brief update dynamic MPU regions.
+ */
+void arm_core_mpu_update_dynamic_mpu_regions(const struct k_mem_partition
+	*dynamic_regions[], u8_t regions_num, u8_t first,
+	u8_t prev_regions_num)
+{
+	/* Without full partitioning of the background area, dynamic
+	 * region i is always programmed at MPU index static_regions_num + i.
+	 */
+	int mpu_reg_index = mpu_configure_regions(&dynamic_regions[first],
+		regions_num - first, static_regions_num + first, false);
+
+	if (mpu_reg_index == -EINVAL) {
+
+		__ASSERT(0, "Updating %u dynamic MPU regions failed\n",
+			regions_num - first);
+		return;
+	}
+
+	/* Disable the MPU regions no longer in use. */
+	for (int i = mpu_reg_index; i < static_regions_num + prev_regions_num;
+	     i++) {
+		ARM_MPU_ClrRegion(i);
+	}
+}
+#endif /* CONFIG_ARM_MPU_DYNAMIC_REGIONS_CACHE */
+
 /* ARM MPU Driver Initial Setup */
 
 /*
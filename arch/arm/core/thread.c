@@ -20,6 +20,20 @@
 extern u8_t *z_priv_stack_find(void *obj);
 #endif
 
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+#include <kernel_tls.h>
+
+/* Thread pointer of the current thread, returned by __aeabi_read_tp()
+ * and updated on every context switch.
+ */
+uintptr_t z_arm_tls_ptr;
+
+/* The ARM EABI places an 8-byte thread control block, unused by
+ * Zephyr, between the thread pointer and the TLS data.
+ */
+#define ARM_TLS_TCB_SIZE 8
+#endif
+
 /* An initial context, to be "restored" by z_arm_pendsv(), is put at the other
  * end of the stack, and thus reusable by the stack when not needed anymore.
  *
@@ -101,6 +115,19 @@ void arch_new_thread(struct k_thread *thread, k_thread_stack_t *stack,
 	z_new_thread_init(thread, pStackMem, stackSize, priority,
 			 options);
 
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+	/* Carve the TLS area from the top of the stack, below any area
+	 * already reserved there.
+	 */
+	char *p_tls = (char *)STACK_ROUND_DOWN(stackEnd -
+		(char *)top_of_stack_offset - z_tls_data_size() -
+		ARM_TLS_TCB_SIZE);
+
+	z_tls_copy(p_tls + ARM_TLS_TCB_SIZE);
+	thread->tls = (uintptr_t)p_tls;
+	top_of_stack_offset = (u32_t)(stackEnd - p_tls);
+#endif
+
 	/* Carve the thread entry struct from the "base" of the stack
 	 *
 	 * The initial carved stack frame only needs to contain the basic
@@ -395,6 +422,12 @@ void arch_switch_to_main_thread(struct k_thread *main_thread,
 	start_of_main_stack =
 		Z_THREAD_STACK_BUFFER(main_stack) + main_stack_size;
 
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+	/* The stack proper starts below the TLS area */
+	start_of_main_stack = (char *)main_thread->tls;
+	z_arm_tls_ptr = main_thread->tls;
+#endif
+
 	start_of_main_stack = (char *)STACK_ROUND_DOWN(start_of_main_stack);
 
 	_current = main_thread;
@@ -121,6 +121,12 @@ def parse_args():
             help="Generate SW ISR table")
     parser.add_argument("-V", "--vector-table", action="store_true",
             help="Generate vector table")
+    parser.add_argument("-j", "--vector-table-jump", action="store_true",
+            help="Generate the vector table as jump instructions, using "
+                 "ARCH_IRQ_VECTOR_JUMP_CODE()")
+    parser.add_argument("-D", "--dispatch", action="store_true",
+            help="Generate z_sw_isr_dispatch(), calling the ISRs of the SW "
+                 "ISR table directly")
     parser.add_argument("-i", "--intlist", required=True,
             help="Zephyr intlist binary for intList extraction")
 
@@ -147,7 +153,14 @@ def write_source_file(fp, vt, swt, intlist, syms):
 
     nv = intlist["num_vectors"]
 
-    if vt:
+    if vt and args.vector_table_jump:
+        fp.write("void __irq_vector_table __attribute__((naked)) "
+                 "_irq_vector_table(void)\n{\n\t__asm__(\n")
+        for i in range(nv):
+            fp.write("\t\tARCH_IRQ_VECTOR_JUMP_CODE({}) \"\\n\\t\"\n"
+                     .format(vt[i]))
+        fp.write("\t);\n}\n")
+    elif vt:
         fp.write("u32_t __irq_vector_table _irq_vector_table[%d] = {\n" % nv)
         for i in range(nv):
             fp.write("\t{},\n".format(vt[i]))
@@ -179,6 +192,26 @@ def write_source_file(fp, vt, swt, intlist, syms):
         fp.write("\t{{(void *){0:#x}, (void *){1}}},\n".format(param, func_as_string))
     fp.write("};\n")
 
+    if args.dispatch:
+        write_dispatch(fp, swt)
+
+def write_dispatch(fp, swt):
+    # The ISR addresses and parameters are those of the first link, which
+    # stay valid as this code is linked in an area of fixed size.
+    fp.write("\nvoid Z_GENERIC_SECTION(.irq_dispatch.text) "
+             "z_sw_isr_dispatch(unsigned int table_idx)\n{\n"
+             "\tswitch (table_idx) {\n")
+
+    for i, (param, func) in enumerate(swt):
+        if not isinstance(func, int):
+            continue
+
+        fp.write("\tcase {0}:\n\t\t((void (*)(void *)){1:#x})((void *){2:#x});\n"
+                 "\t\tbreak;\n".format(i, func, param))
+
+    fp.write("\tdefault:\n\t\tz_irq_spurious(NULL);\n"
+             "\t\tbreak;\n\t}\n}\n")
+
 def get_symbols(obj):
     for section in obj.iter_sections():
         if isinstance(section, SymbolTableSection):
@@ -187,6 +220,15 @@ def get_symbols(obj):
 
     error("Could not find symbol table")
 
+def get_func_names(obj):
+    for section in obj.iter_sections():
+        if isinstance(section, SymbolTableSection):
+            return {sym.entry.st_value: sym.name
+                    for sym in section.iter_symbols()
+                    if sym.entry.st_info.type == "STT_FUNC"}
+
+    error("Could not find symbol table")
+
 def getindex(irq, irq_aggregator_pos):
     try:
         return irq_aggregator_pos.index(irq)
@@ -201,6 +243,8 @@ def main():
     with open(args.kernel, "rb") as fp:
         kernel = ELFFile(fp)
         syms = get_symbols(kernel)
+        if args.vector_table_jump:
+            func_names = get_func_names(kernel)
 
     if "CONFIG_MULTI_LEVEL_INTERRUPTS" in syms:
         max_irq_per = syms["CONFIG_MAX_IRQ_PER_AGGREGATOR"]
@@ -230,8 +274,13 @@ def main():
     if nvec > pow(2, 15):
         raise ValueError('nvec is too large, check endianness.')
 
-    spurious_handler = "&z_irq_spurious"
-    sw_irq_handler   = "ISR_WRAPPER"
+    if args.vector_table_jump:
+        # Jump instructions take the symbol itself
+        spurious_handler = "z_irq_spurious"
+        sw_irq_handler   = "_isr_wrapper"
+    else:
+        spurious_handler = "&z_irq_spurious"
+        sw_irq_handler   = "ISR_WRAPPER"
 
     debug('offset is ' + str(offset))
     debug('num_vectors is ' + str(nvec))
@@ -259,6 +308,11 @@ def main():
             if param != 0:
                 error("Direct irq %d declared, but has non-NULL parameter"
                         % irq)
+            if args.vector_table_jump:
+                if func not in func_names:
+                    error("No function symbol at 0x%x for direct irq %d"
+                          % (func, irq))
+                func = func_names[func]
             vt[irq - offset] = func
         else:
             # Regular interrupt
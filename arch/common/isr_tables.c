@@ -38,7 +38,14 @@ Z_GENERIC_SECTION(.irq_info) struct int_list_header _iheader = {
 /* Some arches don't use a vector table, they have a common exception entry
  * point for all interrupts. Don't generate a table in this case.
  */
-#ifdef CONFIG_GEN_IRQ_VECTOR_TABLE
+#if defined(CONFIG_IRQ_VECTOR_TABLE_JUMP_BY_CODE)
+void __irq_vector_table __attribute__((naked)) _irq_vector_table(void)
+{
+	__asm__(".rept " STRINGIFY(IRQ_TABLE_SIZE) "\n\t"
+		ARCH_IRQ_VECTOR_JUMP_CODE(_isr_wrapper) "\n\t"
+		".endr");
+}
+#elif defined(CONFIG_GEN_IRQ_VECTOR_TABLE)
 u32_t __irq_vector_table _irq_vector_table[IRQ_TABLE_SIZE] = {
 	[0 ...(IRQ_TABLE_SIZE - 1)] = (u32_t)&_isr_wrapper,
 };
@@ -52,3 +59,14 @@ struct _isr_table_entry __sw_isr_table _sw_isr_table[IRQ_TABLE_SIZE] = {
 	[0 ...(IRQ_TABLE_SIZE - 1)] = {(void *)0x42, (void *)&z_irq_spurious},
 };
 #endif
+
+/* The generated dispatch code is linked in a reserved area, so this
+ * placeholder only needs to provide the symbol.
+ */
+#ifdef CONFIG_GEN_ISR_DISPATCH
+void Z_GENERIC_SECTION(.irq_dispatch.text)
+z_sw_isr_dispatch(unsigned int table_idx)
+{
+	_sw_isr_table[table_idx].isr(_sw_isr_table[table_idx].arg);
+}
+#endif
@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Alternative to posix_core.c switching the Zephyr threads with ucontext
+ *
+ * Principle of operation:
+ *
+ * All Zephyr threads run in the single pthread started by the SOC for the
+ * "CPU". Each Zephyr thread has its own native stack and context, and a
+ * thread switch is a swapcontext() call in that pthread, instead of a
+ * handover between pthreads through a mutex and a condition variable.
+ * This makes context switches several times faster, which matters for
+ * long simulations switching threads often (e.g. network stress tests).
+ *
+ * The interface towards the kernel and the SOC is the same as the one of
+ * posix_core.c. As before, only one Zephyr thread executes at a time, and
+ * the execution stays fully deterministic.
+ *
+ * The downside is that the native stacks are not managed by the host
+ * kernel anymore: their size is fixed (ARCH_POSIX_UCONTEXT_STACK_SIZE),
+ * and an overflow corrupts the memory instead of being caught.
+ */
+
+#define POSIX_ARCH_DEBUG_PRINTS 0
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+
+#include "posix_core.h"
+#include "posix_arch_internal.h"
+#include <arch/posix/posix_soc_if.h>
+#include "kernel_internal.h"
+#include "kernel_structs.h"
+#include "ksched.h"
+#include "kswap.h"
+
+#define PREFIX     "POSIX arch core: "
+#define NO_MEM_ERR PREFIX"Can't allocate memory\n"
+
+#if POSIX_ARCH_DEBUG_PRINTS
+#define PC_DEBUG(fmt, ...) posix_print_trace(PREFIX fmt, __VA_ARGS__)
+#else
+#define PC_DEBUG(...)
+#endif
+
+#define PC_ALLOC_CHUNK_SIZE 64
+#define PC_STACK_SIZE CONFIG_ARCH_POSIX_UCONTEXT_STACK_SIZE
+
+static int threads_table_size;
+struct threads_table_el {
+	enum {NOTUSED = 0, USED, ABORTING, ABORTED, FAILED} state;
+	ucontext_t context;
+	void *stack; /* Native stack of the thread */
+	int thead_cnt; /* For debugging: Unique, consecutive, thread number */
+	/* Pointer to the status kept in the Zephyr thread stack */
+	posix_thread_status_t *t_status;
+};
+
+static struct threads_table_el *threads_table;
+
+static int thread_create_count; /* For debugging. Thread creation counter */
+
+/* Thread currently running, -1 while still in the init context */
+static int currently_running_thread;
+
+/* Aborted thread whose stack is freed once we switched away from it */
+static int aborted_thread;
+
+/**
+ * Free the stack of a thread which aborted itself, once no longer on it
+ */
+static void free_aborted_stack(void)
+{
+	if (aborted_thread >= 0) {
+		free(threads_table[aborted_thread].stack);
+		threads_table[aborted_thread].stack = NULL;
+		aborted_thread = -1;
+	}
+}
+
+/**
+ * Switch to the thread <next_th>. With <this_th> < 0, the context of the
+ * current thread is not saved, as it will never be resumed
+ */
+static void posix_switch_to(int next_th, int this_th)
+{
+	PC_DEBUG("%s: We let thread [%i] %i run\n",
+		__func__,
+		threads_table[next_th].thead_cnt,
+		next_th);
+
+	currently_running_thread = next_th;
+
+	if (this_th < 0) {
+		PC_SAFE_CALL(setcontext(&threads_table[next_th].context));
+		CODE_UNREACHABLE; /* LCOV_EXCL_LINE */
+	}
+
+	PC_SAFE_CALL(swapcontext(&threads_table[this_th].context,
+				 &threads_table[next_th].context));
+
+	/* We are running again */
+	free_aborted_stack();
+}
+
+/**
+ * Let the ready thread run and block this thread until it is allowed again
+ *
+ * called from arch_swap() which does the picking from the kernel structures
+ */
+void posix_swap(int next_allowed_thread_nbr, int this_th_nbr)
+{
+	if (next_allowed_thread_nbr == this_th_nbr) {
+		return;
+	}
+
+	if (threads_table[this_th_nbr].state == ABORTING) {
+		PC_DEBUG("Thread [%i] %i: %s: Aborting curr.\n",
+			threads_table[this_th_nbr].thead_cnt,
+			this_th_nbr,
+			__func__);
+		threads_table[this_th_nbr].state = ABORTED;
+		aborted_thread = this_th_nbr;
+		posix_switch_to(next_allowed_thread_nbr, -1);
+	} else {
+		posix_switch_to(next_allowed_thread_nbr, this_th_nbr);
+	}
+}
+
+/**
+ * Let the ready thread (main) run, and leave the init context for good
+ *
+ * Called from arch_switch_to_main_thread() which does the picking from the
+ * kernel structures
+ */
+void posix_main_thread_start(int next_allowed_thread_nbr)
+{
+	posix_switch_to(next_allowed_thread_nbr, -1);
+}
+
+/**
+ * Entry point of the native context of a Zephyr thread
+ */
+static void posix_thread_starter(int thread_idx)
+{
+	PC_DEBUG("Thread [%i] %i: %s: Starting\n",
+		threads_table[thread_idx].thead_cnt,
+		thread_idx,
+		__func__);
+
+	free_aborted_stack();
+
+	posix_new_thread_pre_start();
+
+	posix_thread_status_t *ptr = threads_table[thread_idx].t_status;
+
+	z_thread_entry(ptr->entry_point, ptr->arg1, ptr->arg2, ptr->arg3);
+
+	/*
+	 * We only reach this point if the thread actually returns which should
+	 * not happen. There is no context to return to, so we stop here.
+	 */
+	/* LCOV_EXCL_START */
+	threads_table[thread_idx].state = FAILED;
+	posix_print_error_and_exit(PREFIX"Thread [%i] %i ended!?!\n",
+				   threads_table[thread_idx].thead_cnt,
+				   thread_idx);
+	/* LCOV_EXCL_STOP */
+}
+
+/**
+ * Return the first free entry index in the threads table
+ */
+static int ttable_get_empty_slot(void)
+{
+	for (int i = 0; i < threads_table_size; i++) {
+		if (threads_table[i].state == NOTUSED) {
+			return i;
+		}
+	}
+
+	/*
+	 * else, we run out table without finding an index
+	 * => we expand the table
+	 */
+
+	threads_table = realloc(threads_table,
+				(threads_table_size + PC_ALLOC_CHUNK_SIZE)
+				* sizeof(struct threads_table_el));
+	if (threads_table == NULL) { /* LCOV_EXCL_BR_LINE */
+		posix_print_error_and_exit(NO_MEM_ERR); /* LCOV_EXCL_LINE */
+	}
+
+	/* Clear new piece of table */
+	(void)memset(&threads_table[threads_table_size], 0,
+		     PC_ALLOC_CHUNK_SIZE * sizeof(struct threads_table_el));
+
+	threads_table_size += PC_ALLOC_CHUNK_SIZE;
+
+	/* The first newly created entry is good: */
+	return threads_table_size - PC_ALLOC_CHUNK_SIZE;
+}
+
+/**
+ * Called from arch_new_thread(),
+ * Create a new native context for the new Zephyr thread.
+ * arch_new_thread() picks from the kernel structures what it is that we need
+ * to call with what parameters
+ */
+void posix_new_thread(posix_thread_status_t *ptr)
+{
+	struct threads_table_el *el;
+	int t_slot;
+
+	t_slot = ttable_get_empty_slot();
+	el = &threads_table[t_slot];
+	el->state = USED;
+	el->thead_cnt = thread_create_count++;
+	el->t_status = ptr;
+	ptr->thread_idx = t_slot;
+
+	el->stack = malloc(PC_STACK_SIZE);
+	if (el->stack == NULL) { /* LCOV_EXCL_BR_LINE */
+		posix_print_error_and_exit(NO_MEM_ERR); /* LCOV_EXCL_LINE */
+	}
+
+	PC_SAFE_CALL(getcontext(&el->context));
+	el->context.uc_stack.ss_sp = el->stack;
+	el->context.uc_stack.ss_size = PC_STACK_SIZE;
+	el->context.uc_link = NULL;
+	makecontext(&el->context, (void (*)(void))posix_thread_starter, 1,
+		    t_slot);
+
+	PC_DEBUG("%s created thread [%i] %i\n",
+		__func__,
+		el->thead_cnt,
+		t_slot);
+}
+
+/**
+ * Called from zephyr_wrapper()
+ * prepare whatever needs to be prepared to be able to start threads
+ */
+void posix_init_multithreading(void)
+{
+	thread_create_count = 0;
+
+	currently_running_thread = -1;
+	aborted_thread = -1;
+
+	threads_table = calloc(PC_ALLOC_CHUNK_SIZE,
+				sizeof(struct threads_table_el));
+	if (threads_table == NULL) { /* LCOV_EXCL_BR_LINE */
+		posix_print_error_and_exit(NO_MEM_ERR); /* LCOV_EXCL_LINE */
+	}
+
+	threads_table_size = PC_ALLOC_CHUNK_SIZE;
+}
+
+/**
+ * Free any allocated memory by the posix core and clean up.
+ *
+ * The stack of the running thread is kept, as the SW pthread may still be
+ * blocked on it until the program exits.
+ */
+void posix_core_clean_up(void)
+{
+	if (!threads_table) { /* LCOV_EXCL_BR_LINE */
+		return; /* LCOV_EXCL_LINE */
+	}
+
+	for (int i = 0; i < threads_table_size; i++) {
+		if (i != currently_running_thread) {
+			free(threads_table[i].stack);
+		}
+	}
+
+	free(threads_table);
+	threads_table = NULL;
+}
+
+
+void posix_abort_thread(int thread_idx)
+{
+	if (threads_table[thread_idx].state != USED) { /* LCOV_EXCL_BR_LINE */
+		/* The thread may have been already aborted before */
+		return; /* LCOV_EXCL_LINE */
+	}
+
+	PC_DEBUG("Aborting not scheduled thread [%i] %i\n",
+		threads_table[thread_idx].thead_cnt,
+		thread_idx);
+
+	/* The thread is not running, so its stack can go at once */
+	threads_table[thread_idx].state = ABORTED;
+	free(threads_table[thread_idx].stack);
+	threads_table[thread_idx].stack = NULL;
+}
+
+
+#if defined(CONFIG_ARCH_HAS_THREAD_ABORT)
+
+extern void z_thread_single_abort(struct k_thread *thread);
+
+void z_impl_k_thread_abort(k_tid_t thread)
+{
+	unsigned int key;
+	int thread_idx;
+
+	posix_thread_status_t *tstatus =
+					(posix_thread_status_t *)
+					thread->callee_saved.thread_status;
+
+	thread_idx = tstatus->thread_idx;
+
+	key = irq_lock();
+
+	__ASSERT(!(thread->base.user_options & K_ESSENTIAL),
+		 "essential thread aborted");
+
+	z_thread_single_abort(thread);
+	z_thread_monitor_exit(thread);
+
+	if (_current == thread) {
+		if (tstatus->aborted == 0) { /* LCOV_EXCL_BR_LINE */
+			tstatus->aborted = 1;
+		} else {
+			posix_print_warning(/* LCOV_EXCL_LINE */
+				PREFIX"The kernel is trying to abort and swap "
+				"out of an already aborted thread %i. This "
+				"should NOT have happened\n",
+				thread_idx);
+		}
+		threads_table[thread_idx].state = ABORTING;
+		PC_DEBUG("Thread [%i] %i: %s Marked myself "
+			"as aborting\n",
+			threads_table[thread_idx].thead_cnt,
+			thread_idx,
+			__func__);
+
+		(void)z_swap_irqlock(key);
+		CODE_UNREACHABLE; /* LCOV_EXCL_LINE */
+	}
+
+	if (tstatus->aborted == 0) {
+		PC_DEBUG("%s aborting now [%i] %i\n",
+			__func__,
+			threads_table[thread_idx].thead_cnt,
+			thread_idx);
+
+		tstatus->aborted = 1;
+		posix_abort_thread(thread_idx);
+	} else {
+		PC_DEBUG("%s ignoring re_abort of [%i] "
+			"%i\n",
+			__func__,
+			threads_table[thread_idx].thead_cnt,
+			thread_idx);
+	}
+
+	/* The abort handler might have altered the ready queue. */
+	z_reschedule_irqlock(key);
+}
+#endif
@@ -7,6 +7,10 @@
 #include <kernel.h>
 #include <ksched.h>
 
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+#include <kernel_tls.h>
+#endif
+
 void z_thread_entry_wrapper(k_thread_entry_t thread,
 			   void *arg1,
 			   void *arg2,
@@ -24,6 +28,16 @@ void arch_new_thread(struct k_thread *thread, k_thread_stack_t *stack,
 
 	z_new_thread_init(thread, stack_memory, stack_size, priority, options);
 
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+	/* Carve the TLS area from the top of the stack. The RISC-V ABI
+	 * has tp point right at the TLS data, with no control block.
+	 */
+	thread->tls = STACK_ROUND_DOWN(stack_memory + stack_size -
+				       z_tls_data_size());
+	z_tls_copy((char *)thread->tls);
+	stack_size = (char *)thread->tls - stack_memory;
+#endif
+
 	/* Initial stack frame for thread */
 	stack_init = (struct __esf *)
 		STACK_ROUND_DOWN(stack_memory +
@@ -34,6 +48,9 @@ void arch_new_thread(struct k_thread *thread, k_thread_stack_t *stack,
 	stack_init->a1 = (ulong_t)arg1;
 	stack_init->a2 = (ulong_t)arg2;
 	stack_init->a3 = (ulong_t)arg3;
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+	stack_init->tp = thread->tls;
+#endif
 	/*
 	 * Following the RISC-V architecture,
 	 * the MSTATUS register (used to globally enable/disable interrupt),
@@ -361,6 +361,11 @@ static const struct z_exc_handle exceptions[] = {
 
 void z_x86_page_fault_handler(z_arch_esf_t *esf)
 {
+#ifdef CONFIG_X86_DEMAND_PAGING
+	if (z_x86_demand_paging_fault(esf)) {
+		return;
+	}
+#endif
 #ifdef CONFIG_USERSPACE
 	int i;
 
@@ -23,6 +23,23 @@ zephyr_library_sources(
 zephyr_library_sources_ifdef(CONFIG_IRQ_OFFLOAD		ia32/irq_offload.c)
 zephyr_library_sources_ifdef(CONFIG_X86_USERSPACE	ia32/userspace.S)
 zephyr_library_sources_ifdef(CONFIG_LAZY_FP_SHARING	ia32/float.c)
+zephyr_library_sources_ifdef(CONFIG_X86_DEMAND_PAGING	ia32/demand_paging.c)
+
+if(CONFIG_X86_DEMAND_PAGING)
+  # The paged code is not loaded with the image, it has to be programmed
+  # in the backing store at CONFIG_X86_DEMAND_PAGING_FLASH_OFFSET.
+  set_property(GLOBAL APPEND PROPERTY extra_post_build_commands
+    COMMAND ${CMAKE_OBJCOPY}
+    -O binary
+    --only-section=paged_text
+    --set-section-flags=paged_text=alloc,load,contents
+    ${KERNEL_ELF_NAME}
+    ${KERNEL_NAME}_paged.bin
+    )
+  set_property(GLOBAL APPEND PROPERTY extra_post_build_byproducts
+    ${KERNEL_NAME}_paged.bin
+    )
+endif()
 
 # Last since we declare default exception handlers here
 zephyr_library_sources(ia32/fatal.c)
@@ -63,6 +63,22 @@ _sys_cache_flush_sig(_cache_flush_clflush)
 
 #endif /* CONFIG_CLFLUSH_INSTRUCTION_SUPPORTED || CLFLUSH_DETECT */
 
+#if defined(CONFIG_CACHE_FLUSHING)
+void sys_cache_data_range_flush(void *addr, size_t size)
+{
+	sys_cache_flush((vaddr_t)addr, size);
+}
+
+void sys_cache_data_range_invalidate(void *addr, size_t size)
+{
+	/* Bus master accesses are snooped by the caches, so they never hold
+	 * stale data: there is nothing to discard.
+	 */
+	ARG_UNUSED(addr);
+	ARG_UNUSED(size);
+}
+#endif /* CONFIG_CACHE_FLUSHING */
+
 #if defined(CONFIG_CLFLUSH_DETECT) || defined(CONFIG_CACHE_LINE_SIZE_DETECT)
 
 #include <init.h>
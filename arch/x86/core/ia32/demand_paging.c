@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Demand paging of read-only code from a flash backing store
+ *
+ * The paged code is linked at CONFIG_X86_DEMAND_PAGING_VIRT_BASE, a range
+ * which is left non-present in the page tables. Executing it raises a page
+ * fault, upon which the page is read from the flash device into a RAM page
+ * frame, and mapped. When all frames are in use, one is reclaimed with the
+ * clock algorithm on the accessed bit of the page tables, approximating
+ * LRU. Code pages are never dirty, so evicting one only unmaps it.
+ */
+
+#include <kernel.h>
+#include <kernel_arch_func.h>
+#include <drivers/flash.h>
+#include <arch/x86/ia32/demand_paging.h>
+#include <logging/log.h>
+
+LOG_MODULE_DECLARE(os);
+
+#define PAGED_BASE	CONFIG_X86_DEMAND_PAGING_VIRT_BASE
+#define PAGED_SIZE	CONFIG_X86_DEMAND_PAGING_VIRT_SIZE
+#define NUM_FRAMES	CONFIG_X86_DEMAND_PAGING_FRAMES
+
+/* Page fault error code flags */
+#define PF_PRESENT	BIT(0)
+#define PF_WR		BIT(1)
+
+#define EFLAGS_IF	BIT(9)
+
+/* Builds the page tables of the range, cleared at init */
+MMU_BOOT_REGION(PAGED_BASE, PAGED_SIZE, 0);
+
+struct page_frame {
+	/* Page mapped to the frame, 0 if free */
+	uintptr_t page;
+	/* Pinned frames are never evicted */
+	u16_t pins;
+};
+
+static char __aligned(MMU_PAGE_SIZE) frame_mem[NUM_FRAMES][MMU_PAGE_SIZE];
+static struct page_frame frames[NUM_FRAMES];
+static unsigned int clock_hand;
+static struct x86_paging_stats paging_stats;
+static struct device *backing_dev;
+
+/* Taken by the faulting threads, which may block on the backing store */
+static K_MUTEX_DEFINE(paging_lock);
+
+static bool is_paged(uintptr_t addr)
+{
+	return addr >= PAGED_BASE && addr - PAGED_BASE < PAGED_SIZE;
+}
+
+static u64_t *get_pte(uintptr_t addr)
+{
+	struct x86_page_tables *ptables = &z_x86_kernel_ptables;
+	u64_t *pdpte = z_x86_pdpt_get_pdpte(z_x86_get_pdpt(ptables, addr),
+					     addr);
+	u64_t *pde = z_x86_pd_get_pde(z_x86_pdpte_get_pd(*pdpte), addr);
+
+	return z_x86_pt_get_pte(z_x86_pde_get_pt(*pde), addr);
+}
+
+static inline void tlb_flush_page(uintptr_t addr)
+{
+	__asm__ volatile ("invlpg %0" :: "m" (*(char *)addr) : "memory");
+}
+
+static struct page_frame *pte_get_frame(u64_t pte)
+{
+	uintptr_t frame = (uintptr_t)(pte & Z_X86_MMU_PTE_ADDR_MASK);
+
+	return &frames[(frame - (uintptr_t)frame_mem) / MMU_PAGE_SIZE];
+}
+
+static struct page_frame *frame_get(void)
+{
+	for (int i = 0; i < 2 * NUM_FRAMES; i++) {
+		struct page_frame *pf = &frames[clock_hand];
+		u64_t *pte;
+
+		clock_hand = (clock_hand + 1) % NUM_FRAMES;
+
+		if (pf->page == 0U) {
+			return pf;
+		}
+
+		if (pf->pins != 0U) {
+			continue;
+		}
+
+		/* Second chance for recently executed pages */
+		pte = get_pte(pf->page);
+		if ((*pte & Z_X86_MMU_A) != 0U) {
+			*pte &= ~Z_X86_MMU_A;
+			tlb_flush_page(pf->page);
+			continue;
+		}
+
+		/* Non-present entries get a zeroed address, for L1TF */
+		*pte = 0U;
+		tlb_flush_page(pf->page);
+		pf->page = 0U;
+		paging_stats.evictions++;
+
+		return pf;
+	}
+
+	return NULL;
+}
+
+static int page_in(uintptr_t page, bool pin)
+{
+	struct page_frame *pf;
+	u64_t *pte = get_pte(page);
+	char *frame;
+	int ret = 0;
+
+	k_mutex_lock(&paging_lock, K_FOREVER);
+
+	/* Another thread may have brought it in meanwhile */
+	if ((*pte & Z_X86_MMU_P) != 0U) {
+		if (pin) {
+			pte_get_frame(*pte)->pins++;
+		}
+		goto out;
+	}
+
+	if (backing_dev == NULL) {
+		backing_dev = device_get_binding(
+			CONFIG_X86_DEMAND_PAGING_FLASH_DEV_NAME);
+		if (backing_dev == NULL) {
+			ret = -ENODEV;
+			goto out;
+		}
+	}
+
+	pf = frame_get();
+	if (pf == NULL) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	frame = frame_mem[pf - frames];
+	if (flash_read(backing_dev, CONFIG_X86_DEMAND_PAGING_FLASH_OFFSET +
+		       (page - PAGED_BASE), frame, MMU_PAGE_SIZE) != 0) {
+		ret = -EIO;
+		goto out;
+	}
+
+	pf->page = page;
+	pf->pins = pin ? 1U : 0U;
+
+	/* Read-only, executable, supervisor page */
+	*pte = (uintptr_t)frame | Z_X86_MMU_P;
+	paging_stats.page_ins++;
+
+out:
+	k_mutex_unlock(&paging_lock);
+
+	return ret;
+}
+
+bool z_x86_demand_paging_fault(const z_arch_esf_t *esf)
+{
+	uintptr_t cr2;
+	int ret;
+
+	__asm__ ("mov %%cr2, %0" : "=r" (cr2));
+
+	if (!is_paged(cr2) ||
+	    (esf->errorCode & (PF_PRESENT | PF_WR)) != 0U) {
+		return false;
+	}
+
+	/* Reading the backing store may block */
+	if (k_is_in_isr() || (esf->eflags & EFLAGS_IF) == 0U) {
+		LOG_ERR("Paged code at 0x%lx run with interrupts locked", cr2);
+		return false;
+	}
+
+	ret = page_in(ROUND_DOWN(cr2, MMU_PAGE_SIZE), false);
+	if (ret != 0) {
+		LOG_ERR("Paging in 0x%lx failed (%d)", cr2, ret);
+		return false;
+	}
+
+	paging_stats.faults++;
+
+	return true;
+}
+
+int x86_paging_pin(void *addr, size_t size)
+{
+	uintptr_t start = ROUND_DOWN((uintptr_t)addr, MMU_PAGE_SIZE);
+	uintptr_t end = (uintptr_t)addr + size;
+	int ret;
+
+	if (size == 0 || !is_paged((uintptr_t)addr) || !is_paged(end - 1)) {
+		return -EINVAL;
+	}
+
+	for (uintptr_t page = start; page < end; page += MMU_PAGE_SIZE) {
+		ret = page_in(page, true);
+		if (ret != 0) {
+			x86_paging_unpin((void *)start, page - start);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+void x86_paging_unpin(void *addr, size_t size)
+{
+	uintptr_t page = ROUND_DOWN((uintptr_t)addr, MMU_PAGE_SIZE);
+	uintptr_t end = (uintptr_t)addr + size;
+
+	k_mutex_lock(&paging_lock, K_FOREVER);
+
+	for (; page < end; page += MMU_PAGE_SIZE) {
+		u64_t pte = *get_pte(page);
+
+		__ASSERT((pte & Z_X86_MMU_P) != 0U, "unpinning absent page");
+		pte_get_frame(pte)->pins--;
+	}
+
+	k_mutex_unlock(&paging_lock);
+}
+
+void x86_paging_stats_get(struct x86_paging_stats *stats)
+{
+	k_mutex_lock(&paging_lock, K_FOREVER);
+	*stats = paging_stats;
+	k_mutex_unlock(&paging_lock);
+}
+
+void z_x86_demand_paging_init(void)
+{
+	for (uintptr_t page = PAGED_BASE; page < PAGED_BASE + PAGED_SIZE;
+	     page += MMU_PAGE_SIZE) {
+		*get_pte(page) = 0U;
+	}
+}
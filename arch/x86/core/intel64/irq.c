@@ -123,4 +123,14 @@ void arch_sched_ipi(void)
 {
 	z_loapic_ipi(0, LOAPIC_ICR_IPI_OTHERS, CONFIG_SCHED_IPI_VECTOR);
 }
+
+void arch_sched_directed_ipi(u32_t cpu_bitmap)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if ((cpu_bitmap & BIT(i)) != 0U) {
+			z_loapic_ipi(x86_cpu_loapics[i], LOAPIC_ICR_IPI,
+				     CONFIG_SCHED_IPI_VECTOR);
+		}
+	}
+}
 #endif
@@ -758,6 +758,10 @@ void z_x86_paging_init(void)
 #endif
 	}
 
+#ifdef CONFIG_X86_DEMAND_PAGING
+	z_x86_demand_paging_init();
+#endif
+
 	pages_free = (page_pos - page_pool) / MMU_PAGE_SIZE;
 
 	if (pages_free != 0) {
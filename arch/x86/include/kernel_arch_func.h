@@ -47,6 +47,14 @@ void z_x86_early_serial_init(void);
 void z_x86_paging_init(void);
 #endif /* CONFIG_X86_MMU */
 
+#ifdef CONFIG_X86_DEMAND_PAGING
+/* Mark the demand paged code region non-present in the page tables */
+void z_x86_demand_paging_init(void);
+
+/* Serve a page fault on demand paged code, returns false if not one */
+bool z_x86_demand_paging_fault(const z_arch_esf_t *esf);
+#endif /* CONFIG_X86_DEMAND_PAGING */
+
 /* Called upon CPU exception that is unhandled and hence fatal; dump
  * interesting info and call z_x86_fatal_error()
  */
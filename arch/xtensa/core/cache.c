@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief d-cache maintenance for Xtensa
+ */
+
+#include <kernel.h>
+#include <cache.h>
+#include <xtensa/hal.h>
+
+void sys_cache_data_range_flush(void *addr, size_t size)
+{
+	xthal_dcache_region_writeback(addr, size);
+}
+
+void sys_cache_data_range_invalidate(void *addr, size_t size)
+{
+	xthal_dcache_region_invalidate(addr, size);
+}
+
+void sys_cache_flush(vaddr_t virt, size_t size)
+{
+	xthal_dcache_region_writeback((void *)virt, size);
+}
@@ -10,6 +10,15 @@ macro(toolchain_ld_relocation)
        "${PROJECT_BINARY_DIR}/include/generated/linker_sram_bss_relocate.ld")
   set(MEM_RELOCATION_CODE "${PROJECT_BINARY_DIR}/code_relocation.c")
 
+  if(CONFIG_CODE_DATA_RELOCATION_FUNCTIONS)
+    get_filename_component(MEM_RELOCATION_FUNCTIONS
+      ${CONFIG_CODE_DATA_RELOCATION_FUNCTIONS} ABSOLUTE
+      BASE_DIR ${APPLICATION_SOURCE_DIR})
+    set(MEM_RELOCATION_FUNCTIONS_ARGS
+      -f ${MEM_RELOCATION_FUNCTIONS}
+      -r ${CONFIG_CODE_DATA_RELOCATION_FUNCTIONS_REGION})
+  endif()
+
   add_custom_command(
     OUTPUT ${MEM_RELOCATION_CODE} ${MEM_RELOCATION_LD}
     COMMAND
@@ -22,7 +31,8 @@ macro(toolchain_ld_relocation)
     -s ${MEM_RELOCATION_SRAM_DATA_LD}
     -b ${MEM_RELOCATION_SRAM_BSS_LD}
     -c ${MEM_RELOCATION_CODE}
-    DEPENDS app kernel ${ZEPHYR_LIBS_PROPERTY}
+    ${MEM_RELOCATION_FUNCTIONS_ARGS}
+    DEPENDS app kernel ${ZEPHYR_LIBS_PROPERTY} ${MEM_RELOCATION_FUNCTIONS}
     )
 
   add_library(code_relocation_source_lib  STATIC ${MEM_RELOCATION_CODE})
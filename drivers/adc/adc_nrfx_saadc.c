@@ -8,6 +8,12 @@
 #include "adc_context.h"
 #include <hal/nrf_saadc.h>
 
+/* Streaming restarts the conversion on END through a PPI channel */
+#if defined(CONFIG_ADC_STREAM) && defined(CONFIG_HAS_HW_NRF_PPI)
+#define SAADC_STREAM
+#include <nrfx_ppi.h>
+#endif
+
 #define LOG_LEVEL CONFIG_ADC_LOG_LEVEL
 #include <logging/log.h>
 LOG_MODULE_REGISTER(adc_nrfx_saadc);
@@ -16,6 +22,13 @@ struct driver_data {
 	struct adc_context ctx;
 
 	u8_t positive_inputs[SAADC_CH_NUM];
+
+#ifdef SAADC_STREAM
+	const struct adc_stream_config *stream;
+	nrf_ppi_channel_t stream_ppi;
+	/* Index of the stream buffer being filled */
+	u8_t stream_fill;
+#endif
 };
 
 static struct driver_data m_data = {
@@ -251,7 +264,8 @@ static int check_buffer_size(const struct adc_sequence *sequence,
 	return 0;
 }
 
-static int start_read(struct device *dev, const struct adc_sequence *sequence)
+static int setup_sequence(const struct adc_sequence *sequence,
+			  u8_t *active_count)
 {
 	int error;
 	u32_t selected_channels = sequence->channels;
@@ -319,6 +333,20 @@ static int start_read(struct device *dev, const struct adc_sequence *sequence)
 		return error;
 	}
 
+	*active_count = active_channels;
+	return 0;
+}
+
+static int start_read(struct device *dev, const struct adc_sequence *sequence)
+{
+	int error;
+	u8_t active_channels;
+
+	error = setup_sequence(sequence, &active_channels);
+	if (error) {
+		return error;
+	}
+
 	error = check_buffer_size(sequence, active_channels);
 	if (error) {
 		return error;
@@ -363,10 +391,145 @@ static int adc_nrfx_read_async(struct device *dev,
 }
 #endif /* CONFIG_ADC_ASYNC */
 
+#ifdef SAADC_STREAM
+/* The internal timer of the SAADC runs at 16 MHz, with an 11-bit compare
+ * value of at least 80, and samples a single channel.
+ */
+#define SAADC_TIMER_FREQ_MHZ 16
+#define SAADC_TIMER_CC_MIN   80
+#define SAADC_TIMER_CC_MAX   2047
+
+/* Implementation of the ADC driver API function: adc_stream_start. */
+static int adc_nrfx_stream_start(struct device *dev,
+				 const struct adc_stream_config *config)
+{
+	const struct adc_sequence *sequence = config->sequence;
+	u8_t active_channels;
+	u32_t cc;
+	int error;
+
+	if (sequence->options == NULL || config->callback == NULL ||
+	    config->block_size < sizeof(nrf_saadc_value_t)) {
+		return -EINVAL;
+	}
+
+	cc = sequence->options->interval_us * SAADC_TIMER_FREQ_MHZ;
+	if (cc < SAADC_TIMER_CC_MIN || cc > SAADC_TIMER_CC_MAX) {
+		LOG_ERR("Stream interval not supported: %u us",
+			sequence->options->interval_us);
+		return -ENOTSUP;
+	}
+
+	adc_context_lock(&m_data.ctx, false, NULL);
+
+	error = setup_sequence(sequence, &active_channels);
+	if (!error && active_channels != 1U) {
+		LOG_ERR("Streaming is supported for single channel only");
+		error = -ENOTSUP;
+	}
+
+	if (!error && nrfx_ppi_channel_alloc(&m_data.stream_ppi) !=
+		      NRFX_SUCCESS) {
+		LOG_ERR("Failed to allocate PPI channel");
+		error = -EBUSY;
+	}
+
+	if (error) {
+		adc_context_release(&m_data.ctx, error);
+		return error;
+	}
+
+	nrfx_ppi_channel_assign(m_data.stream_ppi,
+		nrf_saadc_event_address_get(NRF_SAADC, NRF_SAADC_EVENT_END),
+		nrf_saadc_task_address_get(NRF_SAADC, NRF_SAADC_TASK_START));
+	nrfx_ppi_channel_enable(m_data.stream_ppi);
+
+	m_data.stream = config;
+	m_data.stream_fill = 0U;
+
+	nrf_saadc_continuous_mode_enable(NRF_SAADC, cc);
+	nrf_saadc_buffer_init(NRF_SAADC,
+			      (nrf_saadc_value_t *)config->buffers[0],
+			      config->block_size / sizeof(nrf_saadc_value_t));
+
+	nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_STARTED);
+	nrf_saadc_int_enable(NRF_SAADC, NRF_SAADC_INT_STARTED);
+
+	nrf_saadc_enable(NRF_SAADC);
+	nrf_saadc_task_trigger(NRF_SAADC, NRF_SAADC_TASK_START);
+	/* Starts the internal timer */
+	nrf_saadc_task_trigger(NRF_SAADC, NRF_SAADC_TASK_SAMPLE);
+
+	return 0;
+}
+
+/* Implementation of the ADC driver API function: adc_stream_stop. */
+static int adc_nrfx_stream_stop(struct device *dev)
+{
+	unsigned int key;
+
+	key = irq_lock();
+	if (m_data.stream == NULL) {
+		irq_unlock(key);
+		return -EALREADY;
+	}
+
+	nrfx_ppi_channel_disable(m_data.stream_ppi);
+	nrf_saadc_int_disable(NRF_SAADC, NRF_SAADC_INT_STARTED);
+	nrf_saadc_continuous_mode_disable(NRF_SAADC);
+	m_data.stream = NULL;
+	irq_unlock(key);
+
+	nrf_saadc_task_trigger(NRF_SAADC, NRF_SAADC_TASK_STOP);
+	while (!nrf_saadc_event_check(NRF_SAADC, NRF_SAADC_EVENT_STOPPED)) {
+	}
+	nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_STOPPED);
+	nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_END);
+	nrf_saadc_disable(NRF_SAADC);
+
+	nrfx_ppi_channel_free(m_data.stream_ppi);
+	adc_context_release(&m_data.ctx, 0);
+
+	return 0;
+}
+
+static void stream_irq_handler(struct device *dev)
+{
+	const struct adc_stream_config *config = m_data.stream;
+
+	if (nrf_saadc_event_check(NRF_SAADC, NRF_SAADC_EVENT_END)) {
+		nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_END);
+
+		/* The next buffer is already being filled, started by PPI */
+		config->callback(dev, config->buffers[m_data.stream_fill],
+				 config->block_size, config->user_data);
+		m_data.stream_fill ^= 1U;
+	}
+
+	if (nrf_saadc_event_check(NRF_SAADC, NRF_SAADC_EVENT_STARTED)) {
+		nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_STARTED);
+
+		/* The buffer pointer is latched on START, so it can be set
+		 * to the buffer to be filled after the current one.
+		 */
+		nrf_saadc_buffer_pointer_set(NRF_SAADC,
+			(nrf_saadc_value_t *)
+			config->buffers[m_data.stream_fill ^ 1U]);
+	}
+}
+#endif /* SAADC_STREAM */
+
 static void saadc_irq_handler(void *param)
 {
 	struct device *dev = (struct device *)param;
 
+#ifdef SAADC_STREAM
+	if (m_data.stream != NULL) {
+		stream_irq_handler(dev);
+		return;
+	}
+#endif
+
 	if (nrf_saadc_event_check(NRF_SAADC, NRF_SAADC_EVENT_END)) {
 		nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_END);
 
@@ -413,6 +576,10 @@ static const struct adc_driver_api adc_nrfx_driver_api = {
 	.read          = adc_nrfx_read,
 #ifdef CONFIG_ADC_ASYNC
 	.read_async    = adc_nrfx_read_async,
+#endif
+#ifdef SAADC_STREAM
+	.stream_start  = adc_nrfx_stream_start,
+	.stream_stop   = adc_nrfx_stream_stop,
 #endif
 	.ref_internal  = 600,
 };
@@ -439,6 +439,34 @@ static int mcp2515_send(struct device *dev, const struct zcan_frame *msg,
 	return 0;
 }
 
+static u32_t mcp2515_filter_hash(u32_t id)
+{
+	/* Fold the identifier nibbles into a bucket index */
+	id ^= id >> 16;
+	id ^= id >> 8;
+	id ^= id >> 4;
+
+	return id & (MCP2515_FILTER_HASH_SIZE - 1);
+}
+
+static u32_t *mcp2515_filter_bucket(struct mcp2515_data *dev_data,
+				    const struct zcan_filter *filter)
+{
+	if (filter->id_type == CAN_STANDARD_IDENTIFIER &&
+	    filter->std_id_mask == CAN_STD_ID_MASK) {
+		return &dev_data->filter_hash[mcp2515_filter_hash(
+						      filter->std_id)];
+	}
+
+	if (filter->id_type == CAN_EXTENDED_IDENTIFIER &&
+	    filter->ext_id_mask == CAN_EXT_ID_MASK) {
+		return &dev_data->filter_hash[mcp2515_filter_hash(
+						      filter->ext_id)];
+	}
+
+	return &dev_data->filter_masked;
+}
+
 static int mcp2515_attach_isr(struct device *dev, can_rx_callback_t rx_cb,
 			      void *cb_arg,
 			      const struct zcan_filter *filter)
@@ -463,6 +491,7 @@ static int mcp2515_attach_isr(struct device *dev, can_rx_callback_t rx_cb,
 		dev_data->filter[filter_idx] = *filter;
 		dev_data->rx_cb[filter_idx] = rx_cb;
 		dev_data->cb_arg[filter_idx] = cb_arg;
+		*mcp2515_filter_bucket(dev_data, filter) |= BIT(filter_idx);
 
 	} else {
 		filter_idx = CAN_NO_FREE_FILTER;
@@ -478,7 +507,11 @@ static void mcp2515_detach(struct device *dev, int filter_nr)
 	struct mcp2515_data *dev_data = DEV_DATA(dev);
 
 	k_mutex_lock(&dev_data->mutex, K_FOREVER);
-	dev_data->filter_usage &= ~BIT(filter_nr);
+	if (dev_data->filter_usage & BIT(filter_nr)) {
+		dev_data->filter_usage &= ~BIT(filter_nr);
+		*mcp2515_filter_bucket(dev_data, &dev_data->filter[filter_nr]) &=
+			~BIT(filter_nr);
+	}
 	k_mutex_unlock(&dev_data->mutex);
 }
 
@@ -514,40 +547,51 @@ static u8_t mcp2515_filter_match(struct zcan_frame *msg,
 	return 1;
 }
 
-static void mcp2515_rx_filter(struct device *dev, struct zcan_frame *msg)
+static void mcp2515_rx_filter(struct device *dev, struct zcan_frame *msgs,
+			      int count)
 {
 	struct mcp2515_data *dev_data = DEV_DATA(dev);
-	u8_t filter_idx = 0U;
+	u8_t filter_idx;
 	can_rx_callback_t callback;
 	struct zcan_frame tmp_msg;
+	u32_t candidates;
+	u32_t id;
 
 	k_mutex_lock(&dev_data->mutex, K_FOREVER);
 
-	for (; filter_idx < CONFIG_CAN_MCP2515_MAX_FILTER; filter_idx++) {
-		if (!(BIT(filter_idx) & dev_data->filter_usage)) {
-			continue; /* filter slot empty */
-		}
+	for (struct zcan_frame *msg = msgs; msg < msgs + count; msg++) {
+		id = msg->id_type == CAN_STANDARD_IDENTIFIER ?
+			msg->std_id : msg->ext_id;
+		candidates = dev_data->filter_hash[mcp2515_filter_hash(id)] |
+			     dev_data->filter_masked;
 
-		if (!mcp2515_filter_match(msg,
-					  &dev_data->filter[filter_idx])) {
-			continue; /* filter did not match */
-		}
+		while (candidates != 0U) {
+			filter_idx = find_lsb_set(candidates) - 1;
+			candidates &= ~BIT(filter_idx);
+
+			if (!mcp2515_filter_match(msg,
+					&dev_data->filter[filter_idx])) {
+				continue; /* filter did not match */
+			}
 
-		callback = dev_data->rx_cb[filter_idx];
-		/*Make a temporary copy in case the user modifies the message*/
-		tmp_msg = *msg;
+			callback = dev_data->rx_cb[filter_idx];
+			/* Make a temporary copy in case the user modifies
+			 * the message
+			 */
+			tmp_msg = *msg;
 
-		callback(&tmp_msg, dev_data->cb_arg[filter_idx]);
+			callback(&tmp_msg, dev_data->cb_arg[filter_idx]);
+		}
 	}
 
 	k_mutex_unlock(&dev_data->mutex);
 }
 
-static void mcp2515_rx(struct device *dev, u8_t rx_idx)
+static void mcp2515_rx(struct device *dev, u8_t rx_idx,
+		       struct zcan_frame *msg)
 {
 	__ASSERT(rx_idx < MCP2515_RX_CNT, "rx_idx < MCP2515_RX_CNT");
 
-	struct zcan_frame msg;
 	u8_t rx_frame[MCP2515_FRAME_LEN];
 	u8_t nm;
 
@@ -556,8 +600,7 @@ static void mcp2515_rx(struct device *dev, u8_t rx_idx)
 
 	/* Fetch rx buffer */
 	mcp2515_cmd_read_rx_buffer(dev, nm, rx_frame, sizeof(rx_frame));
-	mcp2515_convert_mcp2515frame_to_zcanframe(rx_frame, &msg);
-	mcp2515_rx_filter(dev, &msg);
+	mcp2515_convert_mcp2515frame_to_zcanframe(rx_frame, msg);
 }
 
 static void mcp2515_tx_done(struct device *dev, u8_t tx_idx)
@@ -639,6 +682,8 @@ static void mcp2515_handle_interrupts(struct device *dev)
 {
 	const struct mcp2515_config *dev_cfg = DEV_CFG(dev);
 	struct mcp2515_data *dev_data = DEV_DATA(dev);
+	struct zcan_frame msgs[MCP2515_RX_CNT];
+	int rx_count;
 	u32_t pin;
 	int ret;
 	u8_t canintf;
@@ -657,20 +702,29 @@ static void mcp2515_handle_interrupts(struct device *dev)
 			break;
 		}
 
+		rx_count = 0;
+
 		if (canintf & MCP2515_CANINTF_RX0IF) {
-			mcp2515_rx(dev, 0);
+			mcp2515_rx(dev, 0, &msgs[rx_count++]);
 
 			/* RX0IF flag cleared automatically during read */
 			canintf &= ~MCP2515_CANINTF_RX0IF;
 		}
 
 		if (canintf & MCP2515_CANINTF_RX1IF) {
-			mcp2515_rx(dev, 1);
+			mcp2515_rx(dev, 1, &msgs[rx_count++]);
 
 			/* RX1IF flag cleared automatically during read */
 			canintf &= ~MCP2515_CANINTF_RX1IF;
 		}
 
+		/* Both buffers are freed before dispatching, so the
+		 * controller can receive while the callbacks run.
+		 */
+		if (rx_count > 0) {
+			mcp2515_rx_filter(dev, msgs, rx_count);
+		}
+
 		if (canintf & MCP2515_CANINTF_TX0IF) {
 			mcp2515_tx_done(dev, 0);
 		}
@@ -815,6 +869,8 @@ static int mcp2515_init(struct device *dev)
 
 	(void)memset(dev_data->rx_cb, 0, sizeof(dev_data->rx_cb));
 	(void)memset(dev_data->filter, 0, sizeof(dev_data->filter));
+	(void)memset(dev_data->filter_hash, 0, sizeof(dev_data->filter_hash));
+	dev_data->filter_masked = 0U;
 	dev_data->old_state = CAN_ERROR_ACTIVE;
 
 	ret = mcp2515_configure(dev, CAN_NORMAL_MODE, dev_cfg->bus_speed);
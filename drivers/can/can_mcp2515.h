@@ -18,6 +18,9 @@
 	((const struct mcp2515_config *const)(dev)->config->config_info)
 #define DEV_DATA(dev) ((struct mcp2515_data *const)(dev)->driver_data)
 
+/* Buckets for the software filter lookup, a power of two */
+#define MCP2515_FILTER_HASH_SIZE 16
+
 struct mcp2515_tx_cb {
 	struct k_sem sem;
 	can_tx_callback_t cb;
@@ -46,6 +49,10 @@ struct mcp2515_data {
 
 	/* filter data */
 	u32_t filter_usage;
+	/* single identifier filters, bucketed by identifier hash */
+	u32_t filter_hash[MCP2515_FILTER_HASH_SIZE];
+	/* filters with a mask, checked for every frame */
+	u32_t filter_masked;
 	can_rx_callback_t rx_cb[CONFIG_CAN_MCP2515_MAX_FILTER];
 	void *cb_arg[CONFIG_CAN_MCP2515_MAX_FILTER];
 	struct zcan_filter filter[CONFIG_CAN_MCP2515_MAX_FILTER];
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <soc.h>
+#include <sys/crc.h>
+#include <sys/byteorder.h>
+
+/* The unit is shared, data is fed in chunks to bound the time the lock
+ * is held.
+ */
+#define CRC_STM32_CHUNK_SIZE 64
+
+static struct k_spinlock lock;
+
+u32_t z_crc32_ieee_hw_update(u32_t crc, const u8_t *data, size_t len)
+{
+	while (len > 0) {
+		size_t chunk = MIN(len, CRC_STM32_CHUNK_SIZE);
+		k_spinlock_key_t key = k_spin_lock(&lock);
+		size_t i = 0;
+
+		/* With reversed input and output, the unit register is the
+		 * bit reversed running value of the reflected algorithm.
+		 */
+		LL_CRC_SetInitialData(CRC, __RBIT(~crc));
+		LL_CRC_ResetCRCCalculationUnit(CRC);
+
+		/* Bytes are reversed individually, so the first byte must
+		 * be the most significant one of a word.
+		 */
+		for (; i + 4 <= chunk; i += 4) {
+			LL_CRC_FeedData32(CRC, sys_get_be32(&data[i]));
+		}
+		for (; i < chunk; i++) {
+			LL_CRC_FeedData8(CRC, data[i]);
+		}
+
+		crc = ~LL_CRC_ReadData32(CRC);
+
+		k_spin_unlock(&lock, key);
+
+		data += chunk;
+		len -= chunk;
+	}
+
+	return crc;
+}
+
+static int crc_stm32_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_CRC);
+
+	LL_CRC_SetInputDataReverseMode(CRC, LL_CRC_INDATA_REVERSE_BYTE);
+	LL_CRC_SetOutputDataReverseMode(CRC, LL_CRC_OUTDATA_REVERSE_BIT);
+
+	return 0;
+}
+
+SYS_INIT(crc_stm32_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEVICE);
@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2020 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file mbedTLS alternative AES-CCM implementation (MBEDTLS_CCM_ALT) on top
+ * of the crypto API, so that the TLS record layer runs on a crypto engine.
+ */
+
+#include <kernel.h>
+#include <errno.h>
+#include <string.h>
+#include <crypto/cipher.h>
+
+#if !defined(CONFIG_MBEDTLS_CFG_FILE)
+#include "mbedtls/config.h"
+#else
+#include CONFIG_MBEDTLS_CFG_FILE
+#endif /* CONFIG_MBEDTLS_CFG_FILE */
+
+#include <mbedtls/ccm.h>
+
+#define LOG_LEVEL CONFIG_CRYPTO_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_REGISTER(mbedtls_ccm_alt);
+
+static struct device *ccm_dev;
+static int ccm_caps;
+
+static void ccm_async_done(struct cipher_pkt *pkt, int status)
+{
+	mbedtls_ccm_context *ctx = pkt->ctx->app_sessn_state;
+
+	ctx->status = status;
+	k_sem_give(&ctx->done);
+}
+
+static struct device *ccm_get_device(void)
+{
+	if (ccm_dev != NULL) {
+		return ccm_dev;
+	}
+
+	ccm_dev = device_get_binding(CONFIG_CRYPTO_MBEDTLS_CCM_ALT_DRV_NAME);
+	if (ccm_dev == NULL) {
+		LOG_ERR("Crypto device %s not found",
+			CONFIG_CRYPTO_MBEDTLS_CCM_ALT_DRV_NAME);
+		return NULL;
+	}
+
+	ccm_caps = cipher_query_hwcaps(ccm_dev);
+
+	if (!(ccm_caps & CAP_RAW_KEY)) {
+		LOG_ERR("Crypto device does not take raw keys");
+		ccm_dev = NULL;
+		return NULL;
+	}
+
+	if (!(ccm_caps & CAP_SYNC_OPS) &&
+	    cipher_callback_set(ccm_dev, ccm_async_done) < 0) {
+		LOG_ERR("Cannot register async completion");
+		ccm_dev = NULL;
+		return NULL;
+	}
+
+	return ccm_dev;
+}
+
+static void ccm_session_end(struct mbedtls_ccm_session *session)
+{
+	if (session->active) {
+		cipher_free_session(session->ctx.device, &session->ctx);
+		session->active = false;
+	}
+}
+
+static int ccm_session_get(mbedtls_ccm_context *ctx,
+			   struct mbedtls_ccm_session *session,
+			   enum cipher_op op, size_t iv_len, size_t tag_len,
+			   bool inplace)
+{
+	struct device *dev = ccm_get_device();
+	u16_t flags;
+
+	if (dev == NULL) {
+		return MBEDTLS_ERR_CCM_HW_ACCEL_FAILED;
+	}
+
+	flags = CAP_RAW_KEY;
+	flags |= (ccm_caps & CAP_SYNC_OPS) ? CAP_SYNC_OPS : CAP_ASYNC_OPS;
+
+	/* Drivers without in place support still get in place buffers as
+	 * separate ones, all the in-tree drivers run the cipher over the
+	 * data in a single pass.
+	 */
+	if (inplace && (ccm_caps & CAP_INPLACE_OPS)) {
+		flags |= CAP_INPLACE_OPS;
+	} else {
+		flags |= CAP_SEPARATE_IO_BUFS;
+	}
+
+	if (session->active &&
+	    session->ctx.flags == flags &&
+	    session->ctx.mode_params.ccm_info.nonce_len == iv_len &&
+	    session->ctx.mode_params.ccm_info.tag_len == tag_len) {
+		return 0;
+	}
+
+	ccm_session_end(session);
+
+	session->ctx.key.bit_stream = ctx->key;
+	session->ctx.keylen = ctx->keylen;
+	session->ctx.flags = flags;
+	session->ctx.mode_params.ccm_info.nonce_len = iv_len;
+	session->ctx.mode_params.ccm_info.tag_len = tag_len;
+	session->ctx.app_sessn_state = ctx;
+
+	if (cipher_begin_session(dev, &session->ctx, CRYPTO_CIPHER_ALGO_AES,
+				 CRYPTO_CIPHER_MODE_CCM, op) < 0) {
+		return MBEDTLS_ERR_CCM_HW_ACCEL_FAILED;
+	}
+
+	session->active = true;
+
+	return 0;
+}
+
+/* The calling thread sleeps while an async only engine works */
+static int ccm_run(mbedtls_ccm_context *ctx,
+		   struct mbedtls_ccm_session *session,
+		   struct cipher_aead_pkt *aead, const unsigned char *iv)
+{
+	int ret;
+
+	aead->pkt->ctx = &session->ctx;
+
+	ret = cipher_ccm_op(&session->ctx, aead, (u8_t *)iv);
+	if (ret == 0 && (session->ctx.flags & CAP_ASYNC_OPS)) {
+		k_sem_take(&ctx->done, K_FOREVER);
+		ret = ctx->status;
+	}
+
+	return ret;
+}
+
+void mbedtls_ccm_init(mbedtls_ccm_context *ctx)
+{
+	(void)memset(ctx, 0, sizeof(*ctx));
+	k_sem_init(&ctx->done, 0, 1);
+}
+
+int mbedtls_ccm_setkey(mbedtls_ccm_context *ctx, mbedtls_cipher_id_t cipher,
+		       const unsigned char *key, unsigned int keybits)
+{
+	if (cipher != MBEDTLS_CIPHER_ID_AES ||
+	    (keybits != 128U && keybits != 192U && keybits != 256U)) {
+		return MBEDTLS_ERR_CCM_BAD_INPUT;
+	}
+
+	ccm_session_end(&ctx->enc);
+	ccm_session_end(&ctx->dec);
+
+	memcpy(ctx->key, key, keybits / 8U);
+	ctx->keylen = keybits / 8U;
+
+	return 0;
+}
+
+void mbedtls_ccm_free(mbedtls_ccm_context *ctx)
+{
+	if (ctx == NULL) {
+		return;
+	}
+
+	ccm_session_end(&ctx->enc);
+	ccm_session_end(&ctx->dec);
+
+	(void)memset(ctx->key, 0, sizeof(ctx->key));
+}
+
+/* The crypto API places the tag right after the data, which is also where
+ * the TLS record layer has it, other layouts are not supported.
+ */
+int mbedtls_ccm_encrypt_and_tag(mbedtls_ccm_context *ctx, size_t length,
+				const unsigned char *iv, size_t iv_len,
+				const unsigned char *add, size_t add_len,
+				const unsigned char *input, unsigned char *output,
+				unsigned char *tag, size_t tag_len)
+{
+	struct cipher_pkt pkt = {
+		.in_buf = (u8_t *)input,
+		.in_len = length,
+		.out_buf = output,
+		.out_buf_max = length + tag_len,
+	};
+	struct cipher_aead_pkt aead = {
+		.pkt = &pkt,
+		.ad = (u8_t *)add,
+		.ad_len = add_len,
+		.tag = tag,
+	};
+	int ret;
+
+	if (tag != output + length || tag_len == 0U) {
+		return MBEDTLS_ERR_CCM_BAD_INPUT;
+	}
+
+	ret = ccm_session_get(ctx, &ctx->enc, CRYPTO_CIPHER_OP_ENCRYPT,
+			      iv_len, tag_len, input == output);
+	if (ret != 0) {
+		return ret;
+	}
+
+	if (ccm_run(ctx, &ctx->enc, &aead, iv) < 0) {
+		return MBEDTLS_ERR_CCM_HW_ACCEL_FAILED;
+	}
+
+	return 0;
+}
+
+int mbedtls_ccm_auth_decrypt(mbedtls_ccm_context *ctx, size_t length,
+			     const unsigned char *iv, size_t iv_len,
+			     const unsigned char *add, size_t add_len,
+			     const unsigned char *input, unsigned char *output,
+			     const unsigned char *tag, size_t tag_len)
+{
+	struct cipher_pkt pkt = {
+		.in_buf = (u8_t *)input,
+		.in_len = length,
+		.out_buf = output,
+		.out_buf_max = length + tag_len,
+	};
+	struct cipher_aead_pkt aead = {
+		.pkt = &pkt,
+		.ad = (u8_t *)add,
+		.ad_len = add_len,
+		.tag = (u8_t *)tag,
+	};
+	int ret;
+
+	if (tag != input + length || tag_len == 0U) {
+		return MBEDTLS_ERR_CCM_BAD_INPUT;
+	}
+
+	ret = ccm_session_get(ctx, &ctx->dec, CRYPTO_CIPHER_OP_DECRYPT,
+			      iv_len, tag_len, input == output);
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* Drivers report a tag mismatch as a failed operation */
+	if (ccm_run(ctx, &ctx->dec, &aead, iv) < 0) {
+		(void)memset(output, 0, length);
+		return MBEDTLS_ERR_CCM_AUTH_FAILED;
+	}
+
+	return 0;
+}
+
+/* CCM* only differs from CCM by allowing a zero length tag, which the
+ * crypto API does not support.
+ */
+int mbedtls_ccm_star_encrypt_and_tag(mbedtls_ccm_context *ctx, size_t length,
+				     const unsigned char *iv, size_t iv_len,
+				     const unsigned char *add, size_t add_len,
+				     const unsigned char *input,
+				     unsigned char *output,
+				     unsigned char *tag, size_t tag_len)
+{
+	return mbedtls_ccm_encrypt_and_tag(ctx, length, iv, iv_len, add,
+					   add_len, input, output, tag,
+					   tag_len);
+}
+
+int mbedtls_ccm_star_auth_decrypt(mbedtls_ccm_context *ctx, size_t length,
+				  const unsigned char *iv, size_t iv_len,
+				  const unsigned char *add, size_t add_len,
+				  const unsigned char *input,
+				  unsigned char *output,
+				  const unsigned char *tag, size_t tag_len)
+{
+	return mbedtls_ccm_auth_decrypt(ctx, length, iv, iv_len, add,
+					add_len, input, output, tag, tag_len);
+}
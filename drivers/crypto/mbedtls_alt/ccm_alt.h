@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2020 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file mbedTLS alternative CCM context, see crypto_mtls_ccm_alt.c.
+ */
+
+#ifndef ZEPHYR_DRIVERS_CRYPTO_MBEDTLS_ALT_CCM_ALT_H_
+#define ZEPHYR_DRIVERS_CRYPTO_MBEDTLS_ALT_CCM_ALT_H_
+
+#include <kernel.h>
+#include <crypto/cipher.h>
+
+/* A driver session is set up per direction, on the first operation and
+ * again whenever the tag or nonce length changes.
+ */
+struct mbedtls_ccm_session {
+	struct cipher_ctx ctx;
+	bool active;
+};
+
+typedef struct mbedtls_ccm_context {
+	struct mbedtls_ccm_session enc;
+	struct mbedtls_ccm_session dec;
+	u8_t key[32];
+	u16_t keylen;
+
+	/* Completion of the operations of async only drivers */
+	struct k_sem done;
+	int status;
+} mbedtls_ccm_context;
+
+#endif /* ZEPHYR_DRIVERS_CRYPTO_MBEDTLS_ALT_CCM_ALT_H_ */
@@ -26,6 +26,18 @@ struct ili9340_data {
 	struct spi_config spi_config;
 #ifdef DT_INST_0_ILITEK_ILI9340_CS_GPIOS_CONTROLLER
 	struct spi_cs_control cs_ctrl;
+#endif
+	/* Serializes writes with an asynchronous one in progress */
+	struct k_sem write_sem;
+#ifdef CONFIG_SPI_ASYNC
+	const struct device *dev;
+	struct k_poll_signal write_signal;
+	struct k_poll_event write_event;
+	struct k_work_poll write_work;
+	struct spi_buf write_buf;
+	struct spi_buf_set write_bufs;
+	display_write_cb_t write_cb;
+	void *write_user_data;
 #endif
 };
 
@@ -39,6 +51,10 @@ struct ili9340_data {
 #define ILI9340_RGB_SIZE 3U
 #endif
 
+#ifdef CONFIG_SPI_ASYNC
+static void ili9340_write_done(struct k_work *work);
+#endif
+
 static void ili9340_exit_sleep(struct ili9340_data *data)
 {
 	ili9340_transmit(data, ILI9340_CMD_EXIT_SLEEP, NULL, 0);
@@ -51,6 +67,12 @@ static int ili9340_init(struct device *dev)
 
 	LOG_DBG("Initializing display driver");
 
+	k_sem_init(&data->write_sem, 1, 1);
+#ifdef CONFIG_SPI_ASYNC
+	k_poll_signal_init(&data->write_signal);
+	k_work_poll_init(&data->write_work, ili9340_write_done);
+#endif
+
 	data->spi_dev = device_get_binding(DT_INST_0_ILITEK_ILI9340_BUS_NAME);
 	if (data->spi_dev == NULL) {
 		LOG_ERR("Could not get SPI device for ILI9340");
@@ -145,6 +167,7 @@ static int ili9340_write(const struct device *dev, const u16_t x,
 
 	LOG_DBG("Writing %dx%d (w,h) @ %dx%d (x,y)", desc->width, desc->height,
 			x, y);
+	k_sem_take(&data->write_sem, K_FOREVER);
 	ili9340_set_mem_area(data, x, y, desc->width, desc->height);
 
 	if (desc->pitch > desc->width) {
@@ -170,9 +193,81 @@ static int ili9340_write(const struct device *dev, const u16_t x,
 		write_data_start += (desc->pitch * ILI9340_RGB_SIZE);
 	}
 
+	k_sem_give(&data->write_sem);
+
 	return 0;
 }
 
+#ifdef CONFIG_SPI_ASYNC
+static void ili9340_write_done(struct k_work *work)
+{
+	struct ili9340_data *data =
+		CONTAINER_OF(work, struct ili9340_data, write_work.work);
+	unsigned int signaled;
+	int status;
+
+	k_poll_signal_check(&data->write_signal, &signaled, &status);
+	k_sem_give(&data->write_sem);
+
+	data->write_cb(data->dev, status, data->write_user_data);
+}
+
+static int ili9340_write_async(const struct device *dev, const u16_t x,
+			       const u16_t y,
+			       const struct display_buffer_descriptor *desc,
+			       const void *buf, display_write_cb_t cb,
+			       void *user_data)
+{
+	struct ili9340_data *data = (struct ili9340_data *)dev->driver_data;
+	int ret;
+
+	/* Only a contiguous buffer goes out in a single transfer */
+	if (desc->pitch > desc->width) {
+		ret = ili9340_write(dev, x, y, desc, buf);
+		if (ret == 0) {
+			cb(dev, 0, user_data);
+		}
+		return ret;
+	}
+
+	k_sem_take(&data->write_sem, K_FOREVER);
+
+	ili9340_set_mem_area(data, x, y, desc->width, desc->height);
+	ili9340_transmit(data, ILI9340_CMD_MEM_WRITE, NULL, 0);
+	gpio_pin_write(data->command_data_gpio,
+		       DT_INST_0_ILITEK_ILI9340_CMD_DATA_GPIOS_PIN,
+		       ILI9340_CMD_DATA_PIN_DATA);
+
+	data->dev = dev;
+	data->write_cb = cb;
+	data->write_user_data = user_data;
+	data->write_buf.buf = (void *)buf;
+	data->write_buf.len = desc->width * ILI9340_RGB_SIZE * desc->height;
+	data->write_bufs.buffers = &data->write_buf;
+	data->write_bufs.count = 1;
+
+	k_poll_signal_reset(&data->write_signal);
+	k_poll_event_init(&data->write_event, K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &data->write_signal);
+
+	ret = k_work_poll_submit(&data->write_work, &data->write_event, 1,
+				 K_FOREVER);
+	if (ret < 0) {
+		k_sem_give(&data->write_sem);
+		return ret;
+	}
+
+	ret = spi_write_async(data->spi_dev, &data->spi_config,
+			      &data->write_bufs, &data->write_signal);
+	if (ret < 0) {
+		k_work_poll_cancel(&data->write_work);
+		k_sem_give(&data->write_sem);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_SPI_ASYNC */
+
 static int ili9340_read(const struct device *dev, const u16_t x,
 			const u16_t y,
 			const struct display_buffer_descriptor *desc,
@@ -193,7 +288,9 @@ static int ili9340_display_blanking_off(const struct device *dev)
 	struct ili9340_data *data = (struct ili9340_data *)dev->driver_data;
 
 	LOG_DBG("Turning display blanking off");
+	k_sem_take(&data->write_sem, K_FOREVER);
 	ili9340_transmit(data, ILI9340_CMD_DISPLAY_ON, NULL, 0);
+	k_sem_give(&data->write_sem);
 	return 0;
 }
 
@@ -202,7 +299,9 @@ static int ili9340_display_blanking_on(const struct device *dev)
 	struct ili9340_data *data = (struct ili9340_data *)dev->driver_data;
 
 	LOG_DBG("Turning display blanking on");
+	k_sem_take(&data->write_sem, K_FOREVER);
 	ili9340_transmit(data, ILI9340_CMD_DISPLAY_OFF, NULL, 0);
+	k_sem_give(&data->write_sem);
 	return 0;
 }
 
@@ -291,6 +390,9 @@ static const struct display_driver_api ili9340_api = {
 	.get_capabilities = ili9340_get_capabilities,
 	.set_pixel_format = ili9340_set_pixel_format,
 	.set_orientation = ili9340_set_orientation,
+#ifdef CONFIG_SPI_ASYNC
+	.write_async = ili9340_write_async,
+#endif
 };
 
 static struct ili9340_data ili9340_data;
@@ -38,6 +38,19 @@ struct st7789v_data {
 	u16_t width;
 	u16_t x_offset;
 	u16_t y_offset;
+
+	/* Serializes writes with an asynchronous one in progress */
+	struct k_sem write_sem;
+#ifdef CONFIG_SPI_ASYNC
+	const struct device *dev;
+	struct k_poll_signal write_signal;
+	struct k_poll_event write_event;
+	struct k_work_poll write_work;
+	struct spi_buf write_buf;
+	struct spi_buf_set write_bufs;
+	display_write_cb_t write_cb;
+	void *write_user_data;
+#endif
 };
 
 #ifdef CONFIG_ST7789V_RGB565
@@ -48,6 +61,9 @@ struct st7789v_data {
 
 static int st7789v_blanking_off(const struct device *dev);
 static int st7789v_blanking_on(const struct device *dev);
+#ifdef CONFIG_SPI_ASYNC
+static void st7789v_write_done(struct k_work *work);
+#endif
 
 void st7789v_set_lcd_margins(struct st7789v_data *data,
 			     u16_t x_offset, u16_t y_offset)
@@ -104,6 +120,12 @@ int st7789v_init(struct device *dev)
 {
 	struct st7789v_data *data = (struct st7789v_data *)dev->driver_data;
 
+	k_sem_init(&data->write_sem, 1, 1);
+#ifdef CONFIG_SPI_ASYNC
+	k_poll_signal_init(&data->write_signal);
+	k_work_poll_init(&data->write_work, st7789v_write_done);
+#endif
+
 	data->spi_dev = device_get_binding(DT_INST_0_SITRONIX_ST7789V_BUS_NAME);
 	if (data->spi_dev == NULL) {
 		LOG_ERR("Could not get SPI device for LCD");
@@ -202,7 +224,9 @@ static int st7789v_blanking_on(const struct device *dev)
 {
 	struct st7789v_data *driver = (struct st7789v_data *)dev->driver_data;
 
+	k_sem_take(&driver->write_sem, K_FOREVER);
 	st7789v_transmit(driver, ST7789V_CMD_DISP_OFF, NULL, 0);
+	k_sem_give(&driver->write_sem);
 	return 0;
 }
 
@@ -210,7 +234,9 @@ static int st7789v_blanking_off(const struct device *dev)
 {
 	struct st7789v_data *driver = (struct st7789v_data *)dev->driver_data;
 
+	k_sem_take(&driver->write_sem, K_FOREVER);
 	st7789v_transmit(driver, ST7789V_CMD_DISP_ON, NULL, 0);
+	k_sem_give(&driver->write_sem);
 	return 0;
 }
 
@@ -260,6 +286,7 @@ static int st7789v_write(const struct device *dev,
 
 	LOG_DBG("Writing %dx%d (w,h) @ %dx%d (x,y)",
 			desc->width, desc->height, x, y);
+	k_sem_take(&data->write_sem, K_FOREVER);
 	st7789v_set_mem_area(data, x, y, desc->width, desc->height);
 
 	if (desc->pitch > desc->width) {
@@ -285,9 +312,79 @@ static int st7789v_write(const struct device *dev,
 		write_data_start += (desc->pitch * ST7789V_PIXEL_SIZE);
 	}
 
+	k_sem_give(&data->write_sem);
+
 	return 0;
 }
 
+#ifdef CONFIG_SPI_ASYNC
+static void st7789v_write_done(struct k_work *work)
+{
+	struct st7789v_data *data =
+		CONTAINER_OF(work, struct st7789v_data, write_work.work);
+	unsigned int signaled;
+	int status;
+
+	k_poll_signal_check(&data->write_signal, &signaled, &status);
+	k_sem_give(&data->write_sem);
+
+	data->write_cb(data->dev, status, data->write_user_data);
+}
+
+static int st7789v_write_async(const struct device *dev, const u16_t x,
+			       const u16_t y,
+			       const struct display_buffer_descriptor *desc,
+			       const void *buf, display_write_cb_t cb,
+			       void *user_data)
+{
+	struct st7789v_data *data = (struct st7789v_data *)dev->driver_data;
+	int ret;
+
+	/* Only a contiguous buffer goes out in a single transfer */
+	if (desc->pitch > desc->width) {
+		ret = st7789v_write(dev, x, y, desc, buf);
+		if (ret == 0) {
+			cb(dev, 0, user_data);
+		}
+		return ret;
+	}
+
+	k_sem_take(&data->write_sem, K_FOREVER);
+
+	st7789v_set_mem_area(data, x, y, desc->width, desc->height);
+	st7789v_transmit(data, ST7789V_CMD_RAMWR, NULL, 0);
+	st7789v_set_cmd(data, false);
+
+	data->dev = dev;
+	data->write_cb = cb;
+	data->write_user_data = user_data;
+	data->write_buf.buf = (void *)buf;
+	data->write_buf.len = desc->width * ST7789V_PIXEL_SIZE * desc->height;
+	data->write_bufs.buffers = &data->write_buf;
+	data->write_bufs.count = 1;
+
+	k_poll_signal_reset(&data->write_signal);
+	k_poll_event_init(&data->write_event, K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &data->write_signal);
+
+	ret = k_work_poll_submit(&data->write_work, &data->write_event, 1,
+				 K_FOREVER);
+	if (ret < 0) {
+		k_sem_give(&data->write_sem);
+		return ret;
+	}
+
+	ret = spi_write_async(data->spi_dev, &data->spi_config,
+			      &data->write_bufs, &data->write_signal);
+	if (ret < 0) {
+		k_work_poll_cancel(&data->write_work);
+		k_sem_give(&data->write_sem);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_SPI_ASYNC */
+
 void *st7789v_get_framebuffer(const struct device *dev)
 {
 	return NULL;
@@ -359,6 +456,9 @@ static const struct display_driver_api st7789v_api = {
 	.get_capabilities = st7789v_get_capabilities,
 	.set_pixel_format = st7789v_set_pixel_format,
 	.set_orientation = st7789v_set_orientation,
+#ifdef CONFIG_SPI_ASYNC
+	.write_async = st7789v_write_async,
+#endif
 };
 
 static struct st7789v_data st7789v_data;
@@ -90,6 +90,18 @@ static void dw_dma_isr(void *arg)
 		status_block &= ~(1 << channel);
 		chan_data = &dev_data->chan[channel];
 
+		if (chan_data->cyclic) {
+			/* A cyclic list never ends, count the blocks */
+			if (++chan_data->block_idx == chan_data->blocks) {
+				chan_data->block_idx = 0U;
+				if (chan_data->dma_tfrcallback) {
+					chan_data->dma_tfrcallback(
+						chan_data->tfrcallback_arg,
+						channel, 0);
+				}
+			}
+		}
+
 		if (chan_data->dma_blkcallback) {
 
 			/* Ensure the linked list (chan_data->lli) is
@@ -112,6 +124,44 @@ static void dw_dma_isr(void *arg)
 	}
 }
 
+/* Build the linked list items of a multi-block transfer, the last one
+ * pointing back to the first for a cyclic transfer.
+ */
+static void dw_dma_build_lli(struct dma_chan_data *chan_data,
+			     struct dma_config *cfg, u32_t ctrl_lo,
+			     u32_t ctrl_hi)
+{
+	struct dma_block_config *block = cfg->head_block;
+	struct dw_lli *lli;
+
+	for (int i = 0; i < cfg->block_count; i++) {
+		lli = &chan_data->lli[i];
+
+		lli->sar = block->source_address;
+		lli->dar = block->dest_address;
+		lli->ctrl_lo = ctrl_lo | DW_CTLL_LLP_S_EN | DW_CTLL_LLP_D_EN;
+		lli->ctrl_hi = ctrl_hi | block->block_size;
+		lli->sstat = 0U;
+		lli->dstat = 0U;
+
+		if (i + 1 < cfg->block_count) {
+			lli->llp = (u32_t)&chan_data->lli[i + 1];
+		} else if (cfg->cyclic) {
+			lli->llp = (u32_t)&chan_data->lli[0];
+		} else {
+			/* last block */
+			lli->llp = 0U;
+			lli->ctrl_lo &= ~(DW_CTLL_LLP_S_EN | DW_CTLL_LLP_D_EN);
+		}
+
+		block = block->next_block;
+	}
+
+	/* the items are read by the controller */
+	SOC_DCACHE_FLUSH(chan_data->lli,
+			 cfg->block_count * sizeof(struct dw_lli));
+}
+
 static int dw_dma_config(struct device *dev, u32_t channel,
 			 struct dma_config *cfg)
 {
@@ -138,17 +188,22 @@ static int dw_dma_config(struct device *dev, u32_t channel,
 
 	cfg_blocks = cfg->head_block;
 
-	if ((cfg_blocks->next_block) || (cfg->block_count > 1)) {
-		/*
-		 * return error since the application may have allocated
-		 * memory for the buffers that may be lost when the DMA
-		 * driver discards the buffers provided in the linked blocks
-		 */
-		LOG_ERR("block_count > 1 not supported");
+	if (cfg->block_count == 0U ||
+	    cfg->block_count > CONFIG_DMA_CAVS_MAX_BLOCKS) {
+		LOG_ERR("Invalid block_count %u", cfg->block_count);
 		return -EINVAL;
 	}
 
+	if (cfg->half_complete_callback_en) {
+		/* No such event, a block can be split in two instead */
+		LOG_ERR("half complete callback not supported");
+		return -ENOTSUP;
+	}
+
 	chan_data = &dev_data->chan[channel];
+	chan_data->blocks = cfg->block_count;
+	chan_data->block_idx = 0U;
+	chan_data->cyclic = cfg->cyclic;
 
 	/* default channel config */
 	chan_data->direction = cfg->channel_direction;
@@ -213,11 +268,16 @@ static int dw_dma_config(struct device *dev, u32_t channel,
 	if (cfg->complete_callback_en) {
 		chan_data->dma_blkcallback = cfg->dma_callback;
 		chan_data->blkcallback_arg = cfg->callback_arg;
+		chan_data->dma_tfrcallback = NULL;
 		dw_write(dev_cfg->base, DW_MASK_BLOCK, INT_UNMASK(channel));
 	} else {
 		chan_data->dma_tfrcallback = cfg->dma_callback;
 		chan_data->tfrcallback_arg = cfg->callback_arg;
-		dw_write(dev_cfg->base, DW_MASK_TFR, INT_UNMASK(channel));
+		chan_data->dma_blkcallback = NULL;
+		/* a cyclic transfer never completes, its blocks are counted */
+		dw_write(dev_cfg->base,
+			 cfg->cyclic ? DW_MASK_BLOCK : DW_MASK_TFR,
+			 INT_UNMASK(channel));
 	}
 
 	dw_write(dev_cfg->base, DW_MASK_ERR, INT_UNMASK(channel));
@@ -231,14 +291,26 @@ static int dw_dma_config(struct device *dev, u32_t channel,
 	dw_write(dev_cfg->base, DW_CLEAR_DST_TRAN, 0x1 << channel);
 	dw_write(dev_cfg->base, DW_CLEAR_ERR, 0x1 << channel);
 
-	/* single transfer, must set zero */
-	dw_write(dev_cfg->base, DW_LLP(channel), 0);
+	if (cfg->block_count > 1U || cfg->cyclic) {
+		dw_dma_build_lli(chan_data, cfg, ctrl_lo,
+			DW_CFG_CLASS(dev_data->channel_data->chan[channel].class));
 
-	/* program CTLn */
-	dw_write(dev_cfg->base, DW_CTRL_LOW(channel), ctrl_lo);
-	dw_write(dev_cfg->base, DW_CTRL_HIGH(channel),
-		DW_CFG_CLASS(dev_data->channel_data->chan[channel].class) |
-		cfg_blocks->block_size);
+		/* the first item is fetched when the channel is enabled */
+		dw_write(dev_cfg->base, DW_LLP(channel),
+			 (u32_t)&chan_data->lli[0]);
+		dw_write(dev_cfg->base, DW_CTRL_LOW(channel),
+			 ctrl_lo | DW_CTLL_LLP_S_EN | DW_CTLL_LLP_D_EN);
+	} else {
+		/* single transfer, must set zero */
+		dw_write(dev_cfg->base, DW_LLP(channel), 0);
+
+		/* program CTLn */
+		dw_write(dev_cfg->base, DW_CTRL_LOW(channel), ctrl_lo);
+		dw_write(dev_cfg->base, DW_CTRL_HIGH(channel),
+			DW_CFG_CLASS(
+				dev_data->channel_data->chan[channel].class) |
+			cfg_blocks->block_size);
+	}
 
 	/* write channel config */
 	dw_write(dev_cfg->base, DW_CFG_LOW(channel), DW_CFG_LOW_DEF);
@@ -28,8 +28,24 @@ extern "C" {
 #define DW_CTLL_LLP_D_EN	(1 << 27)
 #define DW_CTLL_LLP_S_EN	(1 << 28)
 
+/* linked list item */
+struct dw_lli {
+	u32_t sar;
+	u32_t dar;
+	u32_t llp;
+	u32_t ctrl_lo;
+	u32_t ctrl_hi;
+	u32_t sstat;
+	u32_t dstat;
+	u32_t reserved;
+} __aligned(32);
+
 /* data for each DMA channel */
 struct dma_chan_data {
+	struct dw_lli lli[CONFIG_DMA_CAVS_MAX_BLOCKS];
+	u8_t blocks;
+	u8_t block_idx;
+	bool cyclic;
 	u32_t direction;
 	void *blkcallback_arg;
 	void (*dma_blkcallback)(void *arg, u32_t channel,
@@ -28,6 +28,13 @@ LOG_MODULE_REGISTER(dma_sam_xdmac);
 struct sam_xdmac_channel_cfg {
 	void *callback_arg;
 	dma_callback callback;
+	/* Descriptors of a multi-block or cyclic transfer */
+	struct sam_xdmac_linked_list_desc_view1
+		desc[CONFIG_DMA_SAM_XDMAC_MAX_BLOCKS];
+	u8_t blocks;
+	u8_t block_idx;
+	bool cyclic;
+	bool block_callback;
 };
 
 /* Device constant configuration parameters */
@@ -57,7 +64,7 @@ static void sam_xdmac_isr(void *arg)
 	Xdmac *const xdmac = dev_cfg->regs;
 	struct sam_xdmac_channel_cfg *channel_cfg;
 	u32_t isr_status;
-	u32_t err;
+	u32_t cis;
 
 	/* Get global interrupt status */
 	isr_status = xdmac->XDMAC_GIS;
@@ -69,13 +76,23 @@ static void sam_xdmac_isr(void *arg)
 
 		channel_cfg = &dev_data->dma_channels[channel];
 
-		/* Get channel errors */
-		err = xdmac->XDMAC_CHID[channel].XDMAC_CIS & XDMAC_INT_ERR;
+		/* Get channel status, reading it clears it */
+		cis = xdmac->XDMAC_CHID[channel].XDMAC_CIS;
+
+		if (!(cis & XDMAC_INT_ERR) && channel_cfg->cyclic) {
+			/* A cyclic list never ends, count the blocks */
+			if (++channel_cfg->block_idx == channel_cfg->blocks) {
+				channel_cfg->block_idx = 0U;
+			} else if (!channel_cfg->block_callback) {
+				continue;
+			}
+		}
 
 		/* Execute callback */
 		if (channel_cfg->callback) {
 			channel_cfg->callback(channel_cfg->callback_arg,
-					channel, err);
+					channel,
+					(cis & XDMAC_INT_ERR) ? -EIO : 0);
 		}
 	}
 }
@@ -174,6 +191,39 @@ int sam_xdmac_transfer_configure(struct device *dev, u32_t channel,
 	return 0;
 }
 
+/* Build a view 1 linked list from the blocks of the configuration, looping
+ * back to the first descriptor for a cyclic transfer.
+ */
+static void sam_xdmac_build_list(struct sam_xdmac_channel_cfg *channel_cfg,
+				 struct dma_config *cfg, u32_t data_size)
+{
+	struct dma_block_config *block = cfg->head_block;
+	struct sam_xdmac_linked_list_desc_view1 *desc;
+
+	for (int i = 0; i < cfg->block_count; i++) {
+		desc = &channel_cfg->desc[i];
+
+		desc->mbr_ubc = (block->block_size >> data_size)
+			| XDMA_UBC_NSEN_UPDATED
+			| XDMA_UBC_NDEN_UPDATED
+			| XDMA_UBC_NVIEW_NDV1;
+		desc->mbr_sa = block->source_address;
+		desc->mbr_da = block->dest_address;
+
+		if (i + 1 < cfg->block_count) {
+			desc->mbr_nda = (u32_t)&channel_cfg->desc[i + 1];
+			desc->mbr_ubc |= XDMA_UBC_NDE_FETCH_EN;
+		} else if (cfg->cyclic) {
+			desc->mbr_nda = (u32_t)&channel_cfg->desc[0];
+			desc->mbr_ubc |= XDMA_UBC_NDE_FETCH_EN;
+		} else {
+			desc->mbr_nda = 0U;
+		}
+
+		block = block->next_block;
+	}
+}
+
 static int sam_xdmac_config(struct device *dev, u32_t channel,
 			    struct dma_config *cfg)
 {
@@ -197,12 +247,18 @@ static int sam_xdmac_config(struct device *dev, u32_t channel,
 		return -EINVAL;
 	}
 
-	if (cfg->block_count != 1U) {
-		LOG_ERR("Only single block transfer is currently supported."
-			    " Please submit a patch.");
+	if (cfg->block_count == 0U ||
+	    cfg->block_count > CONFIG_DMA_SAM_XDMAC_MAX_BLOCKS) {
+		LOG_ERR("Invalid 'block_count' value");
 		return -EINVAL;
 	}
 
+	if (cfg->half_complete_callback_en) {
+		/* No such event, a block can be split in two instead */
+		LOG_ERR("Half complete callback is not supported");
+		return -ENOTSUP;
+	}
+
 	burst_size = find_msb_set(cfg->source_burst_length) - 1;
 	LOG_DBG("burst_size=%d", burst_size);
 	data_size = find_msb_set(cfg->source_data_size) - 1;
@@ -247,7 +303,8 @@ static int sam_xdmac_config(struct device *dev, u32_t channel,
 	channel_cfg.sus = 0U;
 	channel_cfg.dus = 0U;
 	channel_cfg.cie =
-		  (cfg->complete_callback_en ? XDMAC_CIE_BIE : XDMAC_CIE_LIE)
+		  (cfg->complete_callback_en || cfg->cyclic ?
+		   XDMAC_CIE_BIE : XDMAC_CIE_LIE)
 		| (cfg->error_callback_en ? XDMAC_INT_ERR : 0);
 
 	ret = sam_xdmac_channel_configure(dev, channel, &channel_cfg);
@@ -257,12 +314,29 @@ static int sam_xdmac_config(struct device *dev, u32_t channel,
 
 	dev_data->dma_channels[channel].callback = cfg->dma_callback;
 	dev_data->dma_channels[channel].callback_arg = cfg->callback_arg;
+	dev_data->dma_channels[channel].blocks = cfg->block_count;
+	dev_data->dma_channels[channel].block_idx = 0U;
+	dev_data->dma_channels[channel].cyclic = cfg->cyclic;
+	dev_data->dma_channels[channel].block_callback =
+		cfg->complete_callback_en;
 
 	(void)memset(&transfer_cfg, 0, sizeof(transfer_cfg));
 	transfer_cfg.sa = cfg->head_block->source_address;
 	transfer_cfg.da = cfg->head_block->dest_address;
 	transfer_cfg.ublen = cfg->head_block->block_size >> data_size;
 
+	if (cfg->block_count > 1U || cfg->cyclic) {
+		sam_xdmac_build_list(&dev_data->dma_channels[channel], cfg,
+				     data_size);
+		transfer_cfg.nda =
+			(u32_t)&dev_data->dma_channels[channel].desc[0];
+		transfer_cfg.ndc =
+			  XDMAC_CNDC_NDE_DSCR_FETCH_EN
+			| XDMAC_CNDC_NDSUP_SRC_PARAMS_UPDATED
+			| XDMAC_CNDC_NDDUP_DST_PARAMS_UPDATED
+			| XDMAC_CNDC_NDVIEW_NDV1;
+	}
+
 	ret = sam_xdmac_transfer_configure(dev, channel, &transfer_cfg);
 
 	return ret;
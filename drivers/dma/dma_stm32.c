@@ -37,6 +37,12 @@ struct dma_stm32_stream {
 	bool busy;
 	u32_t src_size;
 	u32_t dst_size;
+	bool cyclic;
+	bool block_callback;
+	bool half_complete_callback;
+	/* Blocks of a multi-block transfer, loaded one at a time */
+	struct dma_block_config *head_block;
+	struct dma_block_config *cur_block;
 	void *callback_arg;
 	void (*dma_callback)(void *arg, u32_t id,
 			     int error_code);
@@ -75,6 +81,41 @@ static void dma_stm32_clear_stream_irq(struct device *dev, u32_t id)
 	stm32_dma_clear_stream_irq(dma, id);
 }
 
+static int dma_stm32_reload(struct device *dev, u32_t id,
+			    u32_t src, u32_t dst, size_t size);
+
+/*
+ * The controller has no descriptor lists: the next block of a multi-block
+ * transfer is loaded on transfer complete, the stream being disabled by
+ * hardware at that point. Returns false at the end of the transfer.
+ */
+static bool dma_stm32_next_block(struct device *dev, u32_t id,
+				 struct dma_stm32_stream *stream)
+{
+	const struct dma_stm32_config *config = dev->config->config_info;
+	DMA_TypeDef *dma = (DMA_TypeDef *)(config->base);
+	struct dma_block_config *block = stream->cur_block->next_block;
+
+	if (block == NULL) {
+		if (!stream->cyclic) {
+			return false;
+		}
+		block = stream->head_block;
+	}
+
+	/* A single block cyclic transfer runs in circular mode */
+	if (block == stream->cur_block) {
+		return true;
+	}
+
+	stream->cur_block = block;
+	dma_stm32_reload(dev, id, block->source_address, block->dest_address,
+			 block->block_size);
+	stm32_dma_enable_stream(dma, id);
+
+	return true;
+}
+
 static void dma_stm32_irq_handler(void *arg)
 {
 	struct device *dev = arg;
@@ -85,7 +126,8 @@ static void dma_stm32_irq_handler(void *arg)
 	int id;
 
 	for (id = 0; id < data->max_streams; id++) {
-		if (func_ll_is_active_tc[id](dma)) {
+		if (func_ll_is_active_tc[id](dma) ||
+		    func_ll_is_active_ht[id](dma)) {
 			break;
 		}
 		if (stm32_dma_is_irq_happened(dma, id)) {
@@ -99,20 +141,41 @@ static void dma_stm32_irq_handler(void *arg)
 	}
 
 	stream = &data->streams[id];
-	stream->busy = false;
+
+	if (func_ll_is_active_ht[id](dma)) {
+		func_ll_clear_ht[id](dma);
+
+		if (stream->half_complete_callback) {
+			stream->dma_callback(stream->callback_arg, id,
+					     DMA_STATUS_HALF_COMPLETE);
+		}
+
+		if (!func_ll_is_active_tc[id](dma)) {
+			return;
+		}
+	}
 
 	if (func_ll_is_active_tc[id](dma)) {
+		bool last = stream->cur_block->next_block == NULL;
+
 		func_ll_clear_tc[id](dma);
 
-		stream->dma_callback(stream->callback_arg, id, 0);
+		if (!dma_stm32_next_block(dev, id, stream)) {
+			stream->busy = false;
+			stream->dma_callback(stream->callback_arg, id, 0);
+		} else if (stream->block_callback || last) {
+			stream->dma_callback(stream->callback_arg, id, 0);
+		}
 	} else if (stm32_dma_is_unexpected_irq_happened(dma, id)) {
 		LOG_ERR("Unexpected irq happened.");
+		stream->busy = false;
 		stream->dma_callback(stream->callback_arg, id, -EIO);
 	} else {
 		LOG_ERR("Transfer Error.");
 		dma_stm32_dump_stream_irq(dev, id);
 		dma_stm32_clear_stream_irq(dev, id);
 
+		stream->busy = false;
 		stream->dma_callback(stream->callback_arg, id, -EIO);
 	}
 }
@@ -237,6 +300,7 @@ static int dma_stm32_configure(struct device *dev, u32_t id,
 					dev->config->config_info;
 	DMA_TypeDef *dma = (DMA_TypeDef *)dev_config->base;
 	LL_DMA_InitTypeDef DMA_InitStruct;
+	struct dma_block_config *block;
 	u32_t msize;
 	int ret;
 
@@ -251,10 +315,13 @@ static int dma_stm32_configure(struct device *dev, u32_t id,
 	stm32_dma_disable_stream(dma, id);
 	dma_stm32_clear_stream_irq(dev, id);
 
-	if (config->head_block->block_size > DMA_STM32_MAX_DATA_ITEMS) {
-		LOG_ERR("Data size too big: %d\n",
-		       config->head_block->block_size);
-		return -EINVAL;
+	for (block = config->head_block; block != NULL;
+	     block = block->next_block) {
+		if (block->block_size > DMA_STM32_MAX_DATA_ITEMS) {
+			LOG_ERR("Data size too big: %d\n",
+			       block->block_size);
+			return -EINVAL;
+		}
 	}
 
 	if ((stream->direction == MEMORY_TO_MEMORY) &&
@@ -297,6 +364,11 @@ static int dma_stm32_configure(struct device *dev, u32_t id,
 	stream->callback_arg    = config->callback_arg;
 	stream->src_size	= config->source_data_size;
 	stream->dst_size	= config->dest_data_size;
+	stream->cyclic		= config->cyclic;
+	stream->block_callback	= config->complete_callback_en;
+	stream->half_complete_callback = config->half_complete_callback_en;
+	stream->head_block	= config->head_block;
+	stream->cur_block	= config->head_block;
 
 	if (stream->direction == MEMORY_TO_PERIPHERAL) {
 		DMA_InitStruct.MemoryOrM2MDstAddress =
@@ -348,7 +420,8 @@ static int dma_stm32_configure(struct device *dev, u32_t id,
 		return ret;
 	}
 
-	if (config->head_block->source_reload_en) {
+	if (config->head_block->source_reload_en ||
+	    (config->cyclic && config->head_block->next_block == NULL)) {
 		DMA_InitStruct.Mode = LL_DMA_MODE_CIRCULAR;
 	} else {
 		DMA_InitStruct.Mode = LL_DMA_MODE_NORMAL;
@@ -402,6 +475,12 @@ static int dma_stm32_configure(struct device *dev, u32_t id,
 
 	LL_DMA_EnableIT_TC(dma, table_ll_stream[id]);
 
+	if (config->half_complete_callback_en) {
+		LL_DMA_EnableIT_HT(dma, table_ll_stream[id]);
+	} else {
+		LL_DMA_DisableIT_HT(dma, table_ll_stream[id]);
+	}
+
 #if defined(CONFIG_DMA_STM32_V1)
 	if (DMA_InitStruct.FIFOMode == LL_DMA_FIFOMODE_ENABLE) {
 		LL_DMA_EnableFifoMode(dma, table_ll_stream[id]);
@@ -420,12 +499,15 @@ int dma_stm32_disable_stream(DMA_TypeDef *dma, u32_t id)
 
 	for (;;) {
 		if (!stm32_dma_disable_stream(dma, id)) {
+			return 0;
 		}
-		/* After trying for 5 seconds, give up */
+		/* After trying for 5 seconds, give up. Busy wait, streams are
+		 * also stopped from interrupt context.
+		 */
 		if (count++ > (5 * 1000)) {
 			return -EBUSY;
 		}
-		k_sleep(K_MSEC(1));
+		k_busy_wait(USEC_PER_MSEC);
 	}
 
 	return 0;
@@ -498,6 +580,7 @@ static int dma_stm32_stop(struct device *dev, u32_t id)
 	}
 
 	LL_DMA_DisableIT_TC(dma, table_ll_stream[id]);
+	LL_DMA_DisableIT_HT(dma, table_ll_stream[id]);
 #if defined(CONFIG_DMA_STM32_V1)
 	stm32_dma_disable_fifo_irq(dma, id);
 #endif
@@ -510,6 +593,31 @@ static int dma_stm32_stop(struct device *dev, u32_t id)
 	return 0;
 }
 
+static int dma_stm32_get_status(struct device *dev, u32_t id,
+				struct dma_status *stat)
+{
+	const struct dma_stm32_config *config = dev->config->config_info;
+	DMA_TypeDef *dma = (DMA_TypeDef *)(config->base);
+	struct dma_stm32_data *data = dev->driver_data;
+	struct dma_stm32_stream *stream;
+
+	if (id >= data->max_streams) {
+		return -EINVAL;
+	}
+
+	stream = &data->streams[id];
+	stat->dir = stream->direction;
+	stat->busy = stream->busy;
+	stat->pending_length = LL_DMA_GetDataLength(dma, table_ll_stream[id]);
+	if (stream->source_periph) {
+		stat->pending_length *= stream->src_size;
+	} else {
+		stat->pending_length *= stream->dst_size;
+	}
+
+	return 0;
+}
+
 struct k_mem_block block;
 
 static int dma_stm32_init(struct device *dev)
@@ -548,6 +656,7 @@ static const struct dma_driver_api dma_funcs = {
 	.config		 = dma_stm32_configure,
 	.start		 = dma_stm32_start,
 	.stop		 = dma_stm32_stop,
+	.get_status	 = dma_stm32_get_status,
 };
 
 #define DMA_INIT(index)							\
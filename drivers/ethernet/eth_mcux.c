@@ -148,6 +148,14 @@ static int ts_tx_rd, ts_tx_wr;
 static u8_t __aligned(ENET_BUFF_ALIGNMENT)
 rx_buffer[CONFIG_ETH_MCUX_RX_BUFFERS][ETH_MCUX_BUFFER_SIZE];
 
+#if defined(CONFIG_ETH_MCUX_RX_FRAME_POOL)
+/* Frame sized buffers MCUX gathers the received frames into, handed up
+ * the stack as they are instead of being copied into fragment buffers.
+ */
+NET_BUF_POOL_FIXED_DEFINE(eth_rx_pool, CONFIG_ETH_MCUX_RX_FRAME_POOL_BUFFERS,
+			  ETH_MCUX_BUFFER_SIZE, NULL);
+#endif
+
 static u8_t __aligned(ENET_BUFF_ALIGNMENT)
 tx_buffer[CONFIG_ETH_MCUX_TX_BUFFERS][ETH_MCUX_BUFFER_SIZE];
 
@@ -561,7 +569,8 @@ static int eth_tx(struct device *dev, struct net_pkt *pkt)
 	return 0;
 }
 
-static void eth_rx(struct device *iface)
+/* Returns false if there was no frame to receive */
+static bool eth_rx(struct device *iface)
 {
 	struct eth_context *context = iface->driver_data;
 	u16_t vlan_tag = NET_VLAN_TAG_UNSPEC;
@@ -569,6 +578,9 @@ static void eth_rx(struct device *iface)
 	struct net_pkt *pkt;
 	status_t status;
 	unsigned int imask;
+#if defined(CONFIG_ETH_MCUX_RX_FRAME_POOL)
+	struct net_buf *buf;
+#endif
 
 #if defined(CONFIG_PTP_CLOCK_MCUX)
 	enet_ptp_time_data_t ptpTimeData;
@@ -576,6 +588,10 @@ static void eth_rx(struct device *iface)
 
 	status = ENET_GetRxFrameSize(&context->enet_handle,
 				     (uint32_t *)&frame_length);
+	if (status == kStatus_ENET_RxFrameEmpty) {
+		return false;
+	}
+
 	if (status) {
 		enet_data_error_stats_t error_stats;
 
@@ -591,6 +607,34 @@ static void eth_rx(struct device *iface)
 		goto flush;
 	}
 
+#if defined(CONFIG_ETH_MCUX_RX_FRAME_POOL)
+	/* Using root iface. It will be updated in net_recv_data() */
+	pkt = net_pkt_rx_alloc_on_iface(context->iface, K_NO_WAIT);
+	if (!pkt) {
+		goto flush;
+	}
+
+	buf = net_buf_alloc(&eth_rx_pool, K_NO_WAIT);
+	if (!buf) {
+		net_pkt_unref(pkt);
+		goto flush;
+	}
+
+	net_pkt_append_buffer(pkt, buf);
+
+	imask = irq_lock();
+
+	status = ENET_ReadFrame(ENET, &context->enet_handle,
+				buf->data, frame_length);
+	if (status) {
+		irq_unlock(imask);
+		LOG_ERR("ENET_ReadFrame failed: %d", (int)status);
+		net_pkt_unref(pkt);
+		goto error;
+	}
+
+	net_buf_add(buf, frame_length);
+#else
 	/* Using root iface. It will be updated in net_recv_data() */
 	pkt = net_pkt_rx_alloc_with_buffer(context->iface, frame_length,
 					   AF_UNSPEC, 0, K_NO_WAIT);
@@ -618,6 +662,7 @@ static void eth_rx(struct device *iface)
 		net_pkt_unref(pkt);
 		goto error;
 	}
+#endif /* CONFIG_ETH_MCUX_RX_FRAME_POOL */
 
 #if defined(CONFIG_NET_VLAN)
 	{
@@ -664,7 +709,7 @@ static void eth_rx(struct device *iface)
 		goto error;
 	}
 
-	return;
+	return true;
 flush:
 	/* Flush the current read buffer.  This operation can
 	 * only report failure if there is no frame to flush,
@@ -674,8 +719,32 @@ flush:
 	assert(status == kStatus_Success);
 error:
 	eth_stats_update_errors_rx(get_iface(context, vlan_tag));
+
+	return true;
+}
+
+#if defined(CONFIG_NET_ETHERNET_RX_POLL)
+static int eth_rx_poll(struct device *dev, int budget)
+{
+	int count = 0;
+
+	while (count < budget && eth_rx(dev)) {
+		count++;
+	}
+
+	return count;
 }
 
+static void eth_rx_irq_enable(struct device *dev, bool enable)
+{
+	if (enable) {
+		ENET_EnableInterrupts(ENET, kENET_RxFrameInterrupt);
+	} else {
+		ENET_DisableInterrupts(ENET, kENET_RxFrameInterrupt);
+	}
+}
+#endif /* CONFIG_NET_ETHERNET_RX_POLL */
+
 #if defined(CONFIG_PTP_CLOCK_MCUX)
 static inline void ts_register_tx_event(struct eth_context *context)
 {
@@ -723,7 +792,11 @@ static void eth_callback(ENET_Type *base, enet_handle_t *handle,
 
 	switch (event) {
 	case kENET_RxEvent:
+#if defined(CONFIG_NET_ETHERNET_RX_POLL)
+		net_eth_rx_schedule(context->iface);
+#else
 		eth_rx(iface);
+#endif
 		break;
 	case kENET_TxEvent:
 #if defined(CONFIG_PTP_CLOCK_MCUX)
@@ -954,6 +1027,10 @@ static const struct ethernet_api api_funcs = {
 #endif
 	.get_capabilities	= eth_mcux_get_capabilities,
 	.send			= eth_tx,
+#if defined(CONFIG_NET_ETHERNET_RX_POLL)
+	.rx_poll		= eth_rx_poll,
+	.rx_irq_enable		= eth_rx_irq_enable,
+#endif
 };
 
 #if defined(CONFIG_PTP_CLOCK_MCUX)
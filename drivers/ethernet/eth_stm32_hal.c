@@ -40,10 +40,27 @@ static u8_t dma_tx_buffer[ETH_TXBUFNB][ETH_TX_BUF_SIZE] __dtcm_noinit_section;
 #else
 static ETH_DMADescTypeDef dma_rx_desc_tab[ETH_RXBUFNB] __aligned(4);
 static ETH_DMADescTypeDef dma_tx_desc_tab[ETH_TXBUFNB] __aligned(4);
+#if !defined(CONFIG_ETH_STM32_HAL_RX_ZERO_COPY)
 static u8_t dma_rx_buffer[ETH_RXBUFNB][ETH_RX_BUF_SIZE] __aligned(4);
+#endif
 static u8_t dma_tx_buffer[ETH_TXBUFNB][ETH_TX_BUF_SIZE] __aligned(4);
 #endif /* CONFIG_ETH_STM32_HAL_USE_DTCM_FOR_DMA_BUFFER */
 
+#if defined(CONFIG_ETH_STM32_HAL_RX_ZERO_COPY)
+/* The RX descriptors point straight into net_bufs, which are handed up the
+ * stack once filled and replaced with fresh ones, instead of copying the
+ * frames out of driver owned buffers.
+ */
+BUILD_ASSERT(ETH_RX_BUF_SIZE % sizeof(u32_t) == 0,
+	     "RX buffers must stay word aligned for the DMA");
+
+NET_BUF_POOL_FIXED_DEFINE(eth_rx_pool,
+			  ETH_RXBUFNB + CONFIG_ETH_STM32_HAL_RX_ZERO_COPY_BUFFERS,
+			  ETH_RX_BUF_SIZE, NULL);
+
+static struct net_buf *dma_rx_bufs[ETH_RXBUFNB];
+#endif /* CONFIG_ETH_STM32_HAL_RX_ZERO_COPY */
+
 #if defined(CONFIG_NET_L2_CANBUS_ETH_TRANSLATOR)
 #include <net/can.h>
 
@@ -153,14 +170,58 @@ error:
 	return res;
 }
 
+#if defined(CONFIG_ETH_STM32_HAL_RX_ZERO_COPY)
+static struct net_pkt *eth_rx_zero_copy(struct eth_stm32_hal_dev_data *dev_data)
+{
+	ETH_HandleTypeDef *heth = &dev_data->heth;
+	__IO ETH_DMADescTypeDef *dma_rx_desc = heth->RxFrameInfos.FSRxDesc;
+	size_t len = heth->RxFrameInfos.length;
+	struct net_buf *buf, *frag;
+	struct net_pkt *pkt;
+	int i, idx;
+
+	pkt = net_pkt_rx_alloc_on_iface(dev_data->iface, K_NO_WAIT);
+	if (!pkt) {
+		return NULL;
+	}
+
+	for (i = 0; i < heth->RxFrameInfos.SegCount; i++) {
+		buf = net_buf_alloc(&eth_rx_pool, K_NO_WAIT);
+		if (!buf) {
+			net_pkt_unref(pkt);
+			return NULL;
+		}
+
+		/* Hand the filled buffer over and give the fresh one to the
+		 * descriptor
+		 */
+		idx = (ETH_DMADescTypeDef *)dma_rx_desc - dma_rx_desc_tab;
+		frag = dma_rx_bufs[idx];
+		net_buf_add(frag, MIN(len, ETH_RX_BUF_SIZE));
+		len -= frag->len;
+		net_pkt_append_buffer(pkt, frag);
+
+		dma_rx_bufs[idx] = buf;
+		dma_rx_desc->Buffer1Addr = (u32_t)buf->data;
+
+		dma_rx_desc = (ETH_DMADescTypeDef *)
+			(dma_rx_desc->Buffer2NextDescAddr);
+	}
+
+	return pkt;
+}
+#endif /* CONFIG_ETH_STM32_HAL_RX_ZERO_COPY */
+
 static struct net_pkt *eth_rx(struct device *dev)
 {
 	struct eth_stm32_hal_dev_data *dev_data;
 	ETH_HandleTypeDef *heth;
 	__IO ETH_DMADescTypeDef *dma_rx_desc;
 	struct net_pkt *pkt;
+#if !defined(CONFIG_ETH_STM32_HAL_RX_ZERO_COPY)
 	u16_t total_len;
 	u8_t *dma_buffer;
+#endif
 	int i;
 
 	__ASSERT_NO_MSG(dev != NULL);
@@ -176,6 +237,12 @@ static struct net_pkt *eth_rx(struct device *dev)
 		return NULL;
 	}
 
+#if defined(CONFIG_ETH_STM32_HAL_RX_ZERO_COPY)
+	pkt = eth_rx_zero_copy(dev_data);
+	if (!pkt) {
+		LOG_ERR("Failed to obtain RX buffer");
+	}
+#else
 	total_len = heth->RxFrameInfos.length;
 	dma_buffer = (u8_t *)heth->RxFrameInfos.buffer;
 
@@ -194,6 +261,7 @@ static struct net_pkt *eth_rx(struct device *dev)
 	}
 
 release_desc:
+#endif /* CONFIG_ETH_STM32_HAL_RX_ZERO_COPY */
 	/* Release descriptors to DMA */
 	/* Point to first descriptor */
 	dma_rx_desc = heth->RxFrameInfos.FSRxDesc;
@@ -422,8 +490,24 @@ static void eth_iface_init(struct net_if *iface)
 
 	HAL_ETH_DMATxDescListInit(heth, dma_tx_desc_tab,
 		&dma_tx_buffer[0][0], ETH_TXBUFNB);
+#if defined(CONFIG_ETH_STM32_HAL_RX_ZERO_COPY)
+	for (int i = 0; i < ETH_RXBUFNB; i++) {
+		dma_rx_bufs[i] = net_buf_alloc(&eth_rx_pool, K_NO_WAIT);
+		__ASSERT_NO_MSG(dma_rx_bufs[i] != NULL);
+	}
+
+	/* The HAL lays the descriptors out on one contiguous buffer, which
+	 * is then replaced by the net_bufs before the DMA is started.
+	 */
+	HAL_ETH_DMARxDescListInit(heth, dma_rx_desc_tab,
+		dma_rx_bufs[0]->data, ETH_RXBUFNB);
+	for (int i = 0; i < ETH_RXBUFNB; i++) {
+		dma_rx_desc_tab[i].Buffer1Addr = (u32_t)dma_rx_bufs[i]->data;
+	}
+#else
 	HAL_ETH_DMARxDescListInit(heth, dma_rx_desc_tab,
 		&dma_rx_buffer[0][0], ETH_RXBUFNB);
+#endif
 
 	HAL_ETH_Start(heth);
 
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <errno.h>
+#include <drivers/flash.h>
+
+enum flash_async_op {
+	FLASH_ASYNC_WRITE,
+	FLASH_ASYNC_ERASE,
+};
+
+struct flash_async_req {
+	struct device *dev;
+	off_t offset;
+	const void *data;
+	size_t len;
+	struct k_poll_signal *async;
+	enum flash_async_op op;
+};
+
+K_MSGQ_DEFINE(flash_async_msgq, sizeof(struct flash_async_req),
+	      CONFIG_FLASH_ASYNC_QUEUE_SIZE, 4);
+
+static int flash_async_submit(struct flash_async_req *req)
+{
+	/* Never block the caller, this is the whole point of the API */
+	if (k_msgq_put(&flash_async_msgq, req, K_NO_WAIT)) {
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+int flash_write_async(struct device *dev, off_t offset, const void *data,
+		      size_t len, struct k_poll_signal *async)
+{
+	struct flash_async_req req = {
+		.dev = dev,
+		.offset = offset,
+		.data = data,
+		.len = len,
+		.async = async,
+		.op = FLASH_ASYNC_WRITE,
+	};
+
+	return flash_async_submit(&req);
+}
+
+int flash_erase_async(struct device *dev, off_t offset, size_t size,
+		      struct k_poll_signal *async)
+{
+	struct flash_async_req req = {
+		.dev = dev,
+		.offset = offset,
+		.len = size,
+		.async = async,
+		.op = FLASH_ASYNC_ERASE,
+	};
+
+	return flash_async_submit(&req);
+}
+
+static void flash_async_thread(void *p1, void *p2, void *p3)
+{
+	struct flash_async_req req;
+	const struct flash_driver_api *api;
+	int err;
+
+	while (1) {
+		k_msgq_get(&flash_async_msgq, &req, K_FOREVER);
+
+		api = req.dev->driver_api;
+
+		/* Write protection is left to the caller, as for the
+		 * synchronous calls, which may run concurrently.
+		 */
+		if (req.op == FLASH_ASYNC_WRITE) {
+			err = api->write(req.dev, req.offset, req.data,
+					 req.len);
+		} else {
+			err = api->erase(req.dev, req.offset, req.len);
+		}
+
+		if (req.async) {
+			k_poll_signal_raise(req.async, err);
+		}
+	}
+}
+
+K_THREAD_DEFINE(flash_async_tid, CONFIG_FLASH_ASYNC_THREAD_STACK_SIZE,
+		flash_async_thread, NULL, NULL, NULL,
+		CONFIG_FLASH_ASYNC_THREAD_PRIO, 0, K_NO_WAIT);
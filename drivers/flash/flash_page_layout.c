@@ -5,6 +5,21 @@
  */
 
 #include <drivers/flash.h>
+#include <spinlock.h>
+
+/* Group of the layout in which the last lookup ended. Layouts are static,
+ * so the group found for the last offset stays valid and lookups near it,
+ * which is the common case for storage layers walking a partition, don't
+ * need to walk the layout from its start.
+ */
+static struct {
+	const struct flash_pages_layout *layout;
+	size_t group;
+	off_t group_offs;
+	size_t page_count;
+} last_hit;
+
+static struct k_spinlock last_hit_lock;
 
 static int flash_get_page_info(struct device *dev, off_t offs,
 				   bool use_addr, struct flash_pages_info *info)
@@ -14,39 +29,58 @@ static int flash_get_page_info(struct device *dev, off_t offs,
 	size_t page_count = 0;
 	off_t group_offs = 0;
 	u32_t num_in_group;
-	off_t end = 0;
 	size_t layout_size;
+	size_t group = 0;
+	k_spinlock_key_t key;
+	off_t end;
 
 	api->page_layout(dev, &layout, &layout_size);
 
-	while (layout_size--) {
+	key = k_spin_lock(&last_hit_lock);
+	if (last_hit.layout == layout &&
+	    offs >= (use_addr ? last_hit.group_offs :
+			       (off_t)last_hit.page_count)) {
+		group = last_hit.group;
+		group_offs = last_hit.group_offs;
+		page_count = last_hit.page_count;
+	}
+	k_spin_unlock(&last_hit_lock, key);
+
+	for (; group < layout_size; group++) {
+		const struct flash_pages_layout *l = &layout[group];
+
 		if (use_addr) {
-			end += layout->pages_count * layout->pages_size;
+			end = group_offs + l->pages_count * l->pages_size;
 		} else {
-			end += layout->pages_count;
+			end = page_count + l->pages_count;
 		}
 
 		if (offs < end) {
-			info->size = layout->pages_size;
+			info->size = l->pages_size;
 
 			if (use_addr) {
 				num_in_group = (offs - group_offs) /
-					       layout->pages_size;
+					       l->pages_size;
 			} else {
 				num_in_group = offs - page_count;
 			}
 
 			info->start_offset = group_offs +
-					     num_in_group * layout->pages_size;
+					     num_in_group * l->pages_size;
 			info->index = page_count + num_in_group;
 
+			key = k_spin_lock(&last_hit_lock);
+			last_hit.layout = layout;
+			last_hit.group = group;
+			last_hit.group_offs = group_offs;
+			last_hit.page_count = page_count;
+			k_spin_unlock(&last_hit_lock, key);
+
 			return 0;
 		}
 
-		group_offs += layout->pages_count * layout->pages_size;
-		page_count += layout->pages_count;
-
-		layout++;
+		group_offs += l->pages_count * l->pages_size;
+		page_count += l->pages_count;
 	}
 
 	return -EINVAL; /* page of the index doesn't exist */
@@ -25,7 +25,7 @@
 
 #define FLASH_SLOT_ERASE     FLASH_PAGE_ERASE_MAX_TIME_US
 #define FLASH_INTERVAL_ERASE FLASH_SLOT_ERASE
-#define FLASH_SLOT_WRITE     7500
+#define FLASH_SLOT_WRITE     CONFIG_SOC_FLASH_NRF_RADIO_SYNC_WRITE_SLOT_US
 #define FLASH_INTERVAL_WRITE FLASH_SLOT_WRITE
 
 #define FLASH_RADIO_ABORT_DELAY_US 500
@@ -44,6 +44,7 @@ struct flash_context {
 	u8_t  enable_time_limit; /* execution limited to timeslot. */
 	u32_t interval;   /* timeslot interval. */
 	u32_t slot;       /* timeslot length. */
+	u32_t ticks_slot_start; /* ticks at which the timeslot started. */
 #endif /* CONFIG_SOC_FLASH_NRF_RADIO_SYNC */
 }; /*< Context type for f. @ref write_op @ref erase_op */
 
@@ -309,6 +310,10 @@ static void time_slot_callback_helper(u32_t ticks_at_expire, u32_t remainder,
 
 	ll_radio_state_abort();
 
+	/* The time spent waiting for the radio is taken from the timeslot */
+	((struct flash_op_desc *)context)->context->ticks_slot_start =
+		ticks_at_expire;
+
 	ll_timeslice_ticker_id_get(&instance_index, &ticker_id);
 
 	/* start a secondary one-shot ticker after ~ 500 us, */
@@ -420,6 +425,19 @@ static int write_in_timeslice(off_t addr, const void *data, size_t len)
 	return  work_in_time_slice(&flash_op_desc);
 }
 
+
+/* Ticks left in the timeslot, counted from its start rather than from the
+ * start of the flash operation, which is delayed by the radio abort.
+ */
+static u32_t time_slot_ticks_left(struct flash_context *ctx, u32_t ticks_now)
+{
+	u32_t ticks_slot = HAL_TICKER_US_TO_TICKS(ctx->slot);
+	u32_t ticks_used = ticker_ticks_diff_get(ticks_now,
+						 ctx->ticks_slot_start);
+
+	return (ticks_used < ticks_slot) ? (ticks_slot - ticks_used) : 0;
+}
+
 #endif /* CONFIG_SOC_FLASH_NRF_RADIO_SYNC */
 
 static int erase_op(void *context)
@@ -429,11 +447,13 @@ static int erase_op(void *context)
 
 #if defined(CONFIG_SOC_FLASH_NRF_RADIO_SYNC)
 	u32_t ticks_begin = 0U;
+	u32_t ticks_left = 0U;
 	u32_t ticks_diff;
 	u32_t i = 0U;
 
 	if (e_ctx->enable_time_limit) {
 		ticks_begin = ticker_ticks_now_get();
+		ticks_left = time_slot_ticks_left(e_ctx, ticks_begin);
 	}
 #endif /* CONFIG_SOC_FLASH_NRF_RADIO_SYNC */
 
@@ -457,8 +477,7 @@ static int erase_op(void *context)
 			ticks_diff =
 				ticker_ticks_diff_get(ticker_ticks_now_get(),
 						      ticks_begin);
-			if (ticks_diff + ticks_diff/i >
-			    HAL_TICKER_US_TO_TICKS(e_ctx->slot)) {
+			if (ticks_diff + ticks_diff/i > ticks_left) {
 				break;
 			}
 		}
@@ -483,11 +502,13 @@ static int write_op(void *context)
 
 #if defined(CONFIG_SOC_FLASH_NRF_RADIO_SYNC)
 	u32_t ticks_begin = 0U;
+	u32_t ticks_left = 0U;
 	u32_t ticks_diff;
 	u32_t i = 1U;
 
 	if (w_ctx->enable_time_limit) {
 		ticks_begin = ticker_ticks_now_get();
+		ticks_left = time_slot_ticks_left(w_ctx, ticks_begin);
 	}
 #endif /* CONFIG_SOC_FLASH_NRF_RADIO_SYNC */
 
@@ -509,8 +530,7 @@ static int write_op(void *context)
 			ticks_diff =
 				ticker_ticks_diff_get(ticker_ticks_now_get(),
 						      ticks_begin);
-			if (ticks_diff * 2U >
-			    HAL_TICKER_US_TO_TICKS(w_ctx->slot)) {
+			if (ticks_diff * 2U > ticks_left) {
 				nvmc_wait_ready();
 				return FLASH_OP_ONGOING;
 			}
@@ -532,8 +552,7 @@ static int write_op(void *context)
 			ticks_diff =
 				ticker_ticks_diff_get(ticker_ticks_now_get(),
 						      ticks_begin);
-			if (ticks_diff + ticks_diff/i >
-			    HAL_TICKER_US_TO_TICKS(w_ctx->slot)) {
+			if (ticks_diff + ticks_diff/i > ticks_left) {
 				nvmc_wait_ready();
 				return FLASH_OP_ONGOING;
 			}
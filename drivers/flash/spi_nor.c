@@ -139,18 +139,32 @@ static int spi_nor_access(const struct device *const dev,
 			  void *data, size_t length, bool is_write)
 {
 	struct spi_nor_data *const driver_data = dev->driver_data;
+	const struct spi_nor_config *params = dev->config->config_info;
 
-	u8_t buf[4] = {
-		opcode,
-		(addr & 0xFF0000) >> 16,
-		(addr & 0xFF00) >> 8,
-		(addr & 0xFF),
-	};
+	/* Opcode, address and the dummy byte of a fast read */
+	u8_t buf[1 + SPI_NOR_MAX_ADDR_WIDTH + 1];
+	size_t buf_len = 0;
+
+	buf[buf_len++] = opcode;
+
+	if (is_addressed) {
+		if (params->size > SPI_NOR_3B_ADDR_MAX_SIZE) {
+			buf[buf_len++] = (addr & 0xFF000000) >> 24;
+		}
+
+		buf[buf_len++] = (addr & 0xFF0000) >> 16;
+		buf[buf_len++] = (addr & 0xFF00) >> 8;
+		buf[buf_len++] = (addr & 0xFF);
+
+		if (opcode == SPI_NOR_CMD_READ_FAST) {
+			buf[buf_len++] = 0U;
+		}
+	}
 
 	struct spi_buf spi_buf[2] = {
 		{
 			.buf = buf,
-			.len = (is_addressed) ? 4 : 1,
+			.len = buf_len,
 		},
 		{
 			.buf = data,
@@ -324,7 +338,10 @@ static int spi_nor_read(struct device *dev, off_t addr, void *dest,
 
 	spi_nor_wait_until_ready(dev);
 
-	ret = spi_nor_cmd_addr_read(dev, SPI_NOR_CMD_READ, addr, dest, size);
+	ret = spi_nor_cmd_addr_read(dev,
+				    IS_ENABLED(CONFIG_SPI_NOR_FAST_READ) ?
+				    SPI_NOR_CMD_READ_FAST : SPI_NOR_CMD_READ,
+				    addr, dest, size);
 
 	release_device(dev);
 	return ret;
@@ -498,6 +515,12 @@ static int spi_nor_configure(struct device *dev)
 		return -ENODEV;
 	}
 
+	/* Address the upper part of devices larger than 16 MiB */
+	if ((params->size > SPI_NOR_3B_ADDR_MAX_SIZE)
+	    && (spi_nor_cmd_write(dev, SPI_NOR_CMD_EN4B) != 0)) {
+		return -ENODEV;
+	}
+
 	if (IS_ENABLED(CONFIG_SPI_NOR_IDLE_IN_DPD)
 	    && (enter_dpd(dev) != 0)) {
 		return -ENODEV;
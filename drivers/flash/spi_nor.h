@@ -30,6 +30,7 @@ struct spi_nor_config {
 #define SPI_NOR_CMD_WRSR        0x01    /* Write status register */
 #define SPI_NOR_CMD_RDSR        0x05    /* Read status register */
 #define SPI_NOR_CMD_READ        0x03    /* Read data */
+#define SPI_NOR_CMD_READ_FAST   0x0B    /* Read data at higher speed */
 #define SPI_NOR_CMD_WREN        0x06    /* Write enable */
 #define SPI_NOR_CMD_WRDI        0x04    /* Write disable */
 #define SPI_NOR_CMD_PP          0x02    /* Page program */
@@ -41,6 +42,7 @@ struct spi_nor_config {
 #define SPI_NOR_CMD_ULBPR       0x98    /* Global Block Protection Unlock */
 #define SPI_NOR_CMD_DPD         0xB9    /* Deep Power Down */
 #define SPI_NOR_CMD_RDPD        0xAB    /* Release from Deep Power Down */
+#define SPI_NOR_CMD_EN4B        0xB7    /* Enter 4-Byte Address Mode */
 
 /* Page, sector, and block size are standard, not configurable. */
 #define SPI_NOR_PAGE_SIZE    0x0100U
@@ -52,6 +54,9 @@ struct spi_nor_config {
  */
 #define SPI_NOR_BLOCK32_SIZE 0x8000
 
+/* Devices larger than this need 4-byte addresses */
+#define SPI_NOR_3B_ADDR_MAX_SIZE 0x1000000U
+
 /* Test whether offset is aligned. */
 #define SPI_NOR_IS_PAGE_ALIGNED(_ofs) (((_ofs) & (SPI_NOR_PAGE_SIZE - 1U)) == 0)
 #define SPI_NOR_IS_SECTOR_ALIGNED(_ofs) (((_ofs) & (SPI_NOR_SECTOR_SIZE - 1U)) == 0)
@@ -35,6 +35,104 @@ static inline u32_t i2c_map_dt_bitrate(u32_t bitrate)
 	return 0;
 }
 
+/* Per-bus queue of transactions waiting for the one in progress */
+struct i2c_txn_queue {
+	struct k_spinlock lock;
+	sys_slist_t list;
+	struct i2c_transaction *current;
+};
+
+/* Queue a transaction, returns true if the bus was idle, in which case
+ * the transaction is the current one and the caller must start it.
+ */
+static inline bool i2c_txn_queue_put(struct i2c_txn_queue *queue,
+				     struct i2c_transaction *txn)
+{
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+	bool idle = (queue->current == NULL);
+
+	if (idle) {
+		queue->current = txn;
+	} else {
+		sys_slist_append(&queue->list, &txn->node);
+	}
+	k_spin_unlock(&queue->lock, key);
+
+	return idle;
+}
+
+/* Report the result of the current transaction, returns the next one,
+ * which the caller must start, or NULL if the bus is now idle. In the
+ * latter case @a idle_fn is called, if not NULL, before another
+ * transaction can be queued. The transaction may be queued again from
+ * its own callback.
+ */
+static inline struct i2c_transaction *i2c_txn_queue_complete(
+	struct device *dev, struct i2c_txn_queue *queue, int result,
+	void (*idle_fn)(struct device *dev))
+{
+	struct i2c_transaction *txn = queue->current;
+	k_spinlock_key_t key;
+
+	if (txn->callback != NULL) {
+		txn->callback(dev, result, txn->user_data);
+	}
+#ifdef CONFIG_POLL
+	if (txn->signal != NULL) {
+		k_poll_signal_raise(txn->signal, result);
+	}
+#endif
+
+	key = k_spin_lock(&queue->lock);
+	txn = (struct i2c_transaction *)sys_slist_get(&queue->list);
+	queue->current = txn;
+	if (txn == NULL && idle_fn != NULL) {
+		idle_fn(dev);
+	}
+	k_spin_unlock(&queue->lock, key);
+
+	return txn;
+}
+
+struct i2c_txn_sync {
+	struct k_sem sem;
+	int result;
+};
+
+static inline void i2c_txn_sync_cb(struct device *dev, int result,
+				   void *user_data)
+{
+	struct i2c_txn_sync *sync = user_data;
+
+	sync->result = result;
+	k_sem_give(&sync->sem);
+}
+
+/* Initialize a transaction on which the caller waits with i2c_txn_wait(),
+ * used to implement i2c_transfer() on top of the transaction queue.
+ */
+static inline void i2c_txn_sync_init(struct i2c_transaction *txn,
+				     struct i2c_txn_sync *sync,
+				     struct i2c_msg *msgs, u8_t num_msgs,
+				     u16_t addr)
+{
+	k_sem_init(&sync->sem, 0, 1);
+	*txn = (struct i2c_transaction) {
+		.msgs = msgs,
+		.num_msgs = num_msgs,
+		.addr = addr,
+		.callback = i2c_txn_sync_cb,
+		.user_data = sync,
+	};
+}
+
+static inline int i2c_txn_wait(struct i2c_txn_sync *sync)
+{
+	k_sem_take(&sync->sem, K_FOREVER);
+
+	return sync->result;
+}
+
 #ifdef __cplusplus
 }
 #endif
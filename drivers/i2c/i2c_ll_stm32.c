@@ -12,13 +12,13 @@
 #include <soc.h>
 #include <errno.h>
 #include <drivers/i2c.h>
-#include "i2c_ll_stm32.h"
 
 #define LOG_LEVEL CONFIG_I2C_LOG_LEVEL
 #include <logging/log.h>
 LOG_MODULE_REGISTER(i2c_ll_stm32);
 
 #include "i2c-priv.h"
+#include "i2c_ll_stm32.h"
 
 int i2c_stm32_runtime_configure(struct device *dev, u32_t config)
 {
@@ -60,16 +60,14 @@ int i2c_stm32_runtime_configure(struct device *dev, u32_t config)
 
 #define OPERATION(msg) (((struct i2c_msg *) msg)->flags & I2C_MSG_RW_MASK)
 
-static int i2c_stm32_transfer(struct device *dev, struct i2c_msg *msg,
-			      u8_t num_msgs, u16_t slave)
+/* Check for validity of all messages, to prevent having to abort
+ * in the middle of a transfer
+ */
+static int check_msgs(struct i2c_msg *msg, u8_t num_msgs)
 {
-	struct i2c_stm32_data *data = DEV_DATA(dev);
 	struct i2c_msg *current, *next;
 	int ret = 0;
 
-	/* Check for validity of all messages, to prevent having to abort
-	 * in the middle of a transfer
-	 */
 	current = msg;
 
 	/*
@@ -107,6 +105,53 @@ static int i2c_stm32_transfer(struct device *dev, struct i2c_msg *msg,
 		current++;
 	}
 
+	return ret;
+}
+
+#ifdef CONFIG_I2C_STM32_ASYNC
+static int i2c_stm32_transfer_async(struct device *dev,
+				    struct i2c_transaction *txn)
+{
+	int ret = 0;
+
+	if (txn->num_msgs != 0) {
+		ret = check_msgs(txn->msgs, txn->num_msgs);
+		if (ret) {
+			return ret;
+		}
+	}
+
+	if (i2c_txn_queue_put(&DEV_DATA(dev)->queue, txn)) {
+		stm32_i2c_async_start(dev);
+	}
+
+	return 0;
+}
+
+static int i2c_stm32_transfer(struct device *dev, struct i2c_msg *msg,
+			      u8_t num_msgs, u16_t slave)
+{
+	struct i2c_transaction txn;
+	struct i2c_txn_sync sync;
+	int ret;
+
+	i2c_txn_sync_init(&txn, &sync, msg, num_msgs, slave);
+	ret = i2c_stm32_transfer_async(dev, &txn);
+	if (ret) {
+		return ret;
+	}
+
+	return i2c_txn_wait(&sync);
+}
+#else
+static int i2c_stm32_transfer(struct device *dev, struct i2c_msg *msg,
+			      u8_t num_msgs, u16_t slave)
+{
+	struct i2c_stm32_data *data = DEV_DATA(dev);
+	struct i2c_msg *current, *next;
+	int ret;
+
+	ret = check_msgs(msg, num_msgs);
 	if (ret) {
 		return ret;
 	}
@@ -164,10 +209,14 @@ exit:
 	k_sem_give(&data->bus_mutex);
 	return ret;
 }
+#endif /* CONFIG_I2C_STM32_ASYNC */
 
 static const struct i2c_driver_api api_funcs = {
 	.configure = i2c_stm32_runtime_configure,
 	.transfer = i2c_stm32_transfer,
+#if defined(CONFIG_I2C_STM32_ASYNC)
+	.transfer_async = i2c_stm32_transfer_async,
+#endif
 #if defined(CONFIG_I2C_SLAVE)
 	.slave_register = i2c_stm32_slave_register,
 	.slave_unregister = i2c_stm32_slave_unregister,
@@ -42,6 +42,14 @@ struct i2c_stm32_data {
 		unsigned int len;
 		u8_t *buf;
 	} current;
+#ifdef CONFIG_I2C_STM32_ASYNC
+	struct i2c_txn_queue queue;
+	/* Chunk of the current message in progress, at most 255 bytes */
+	struct i2c_msg chunk;
+	u8_t chunk_next_flags;
+	u8_t msg_idx;
+	u32_t msg_offset;
+#endif
 #ifdef CONFIG_I2C_SLAVE
 	bool master_active;
 	struct i2c_slave_config *slave_cfg;
@@ -55,6 +63,9 @@ s32_t stm32_i2c_msg_read(struct device *dev, struct i2c_msg *msg, u8_t *flg,
 			 u16_t sadr);
 s32_t stm32_i2c_configure_timing(struct device *dev, u32_t clk);
 int i2c_stm32_runtime_configure(struct device *dev, u32_t config);
+#ifdef CONFIG_I2C_STM32_ASYNC
+void stm32_i2c_async_start(struct device *dev);
+#endif
 
 void stm32_i2c_event_isr(void *arg);
 void stm32_i2c_error_isr(void *arg);
@@ -15,13 +15,13 @@
 #include <soc.h>
 #include <errno.h>
 #include <drivers/i2c.h>
-#include "i2c_ll_stm32.h"
 
 #define LOG_LEVEL CONFIG_I2C_LOG_LEVEL
 #include <logging/log.h>
 LOG_MODULE_REGISTER(i2c_ll_stm32_v2);
 
 #include "i2c-priv.h"
+#include "i2c_ll_stm32.h"
 
 static inline void msg_init(struct device *dev, struct i2c_msg *msg,
 			    u8_t *next_msg_flags, u16_t slave,
@@ -89,10 +89,137 @@ static void stm32_i2c_enable_transfer_interrupts(struct device *dev)
 	LL_I2C_EnableIT_ERR(i2c);
 }
 
+#ifdef CONFIG_I2C_STM32_ASYNC
+/* Start the current chunk of the current message, messages longer than
+ * 255 bytes are split in chunks sent in reload mode.
+ */
+static void stm32_i2c_async_chunk(struct device *dev)
+{
+	const struct i2c_stm32_config *cfg = DEV_CFG(dev);
+	struct i2c_stm32_data *data = DEV_DATA(dev);
+	struct i2c_transaction *txn = data->queue.current;
+	struct i2c_msg *msg = &txn->msgs[data->msg_idx];
+	u32_t remaining = msg->len - data->msg_offset;
+	u8_t *next_msg_flags = NULL;
+	I2C_TypeDef *i2c = cfg->i2c;
+
+	data->chunk.buf = msg->buf + data->msg_offset;
+	data->chunk.len = MIN(remaining, 255U);
+	data->chunk.flags = msg->flags;
+	if (data->msg_offset != 0U) {
+		data->chunk.flags &= ~I2C_MSG_RESTART;
+	}
+
+	if (remaining > 255U) {
+		data->chunk.flags &= ~I2C_MSG_STOP;
+		data->chunk_next_flags = data->chunk.flags & ~I2C_MSG_RESTART;
+		next_msg_flags = &data->chunk_next_flags;
+	} else if (data->msg_idx + 1 < txn->num_msgs) {
+		next_msg_flags = &txn->msgs[data->msg_idx + 1].flags;
+	}
+
+	data->current.len = data->chunk.len;
+	data->current.buf = data->chunk.buf;
+	data->current.is_write =
+		(data->chunk.flags & I2C_MSG_RW_MASK) == I2C_MSG_WRITE;
+	data->current.is_arlo = 0U;
+	data->current.is_err = 0U;
+	data->current.is_nack = 0U;
+	data->current.msg = &data->chunk;
+
+	msg_init(dev, &data->chunk, next_msg_flags, txn->addr,
+		 data->current.is_write ? LL_I2C_REQUEST_WRITE :
+					  LL_I2C_REQUEST_READ);
+
+	stm32_i2c_enable_transfer_interrupts(dev);
+	if (data->current.is_write) {
+		LL_I2C_EnableIT_TX(i2c);
+	} else {
+		LL_I2C_EnableIT_RX(i2c);
+	}
+}
+
+/* Complete the current transaction and start the next non empty one */
+static void stm32_i2c_async_complete(struct device *dev, int result)
+{
+	struct i2c_stm32_data *data = DEV_DATA(dev);
+	struct i2c_transaction *txn;
+
+	while (true) {
+		txn = i2c_txn_queue_complete(dev, &data->queue, result, NULL);
+		if (txn == NULL) {
+			return;
+		}
+
+		if (txn->num_msgs != 0) {
+			data->msg_idx = 0U;
+			data->msg_offset = 0U;
+			stm32_i2c_async_chunk(dev);
+			return;
+		}
+
+		result = 0;
+	}
+}
+
+void stm32_i2c_async_start(struct device *dev)
+{
+	struct i2c_stm32_data *data = DEV_DATA(dev);
+
+	if (data->queue.current->num_msgs == 0) {
+		stm32_i2c_async_complete(dev, 0);
+		return;
+	}
+
+	data->msg_idx = 0U;
+	data->msg_offset = 0U;
+	stm32_i2c_async_chunk(dev);
+}
+
+/* Called from the interrupt handler at the end of each chunk */
+static void stm32_i2c_async_continue(struct device *dev)
+{
+	struct i2c_stm32_data *data = DEV_DATA(dev);
+	struct i2c_transaction *txn = data->queue.current;
+
+	if (data->current.is_nack || data->current.is_err ||
+	    data->current.is_arlo) {
+		LOG_DBG("%s: NACK %d ERR %d ARLO %d", __func__,
+			data->current.is_nack, data->current.is_err,
+			data->current.is_arlo);
+		stm32_i2c_async_complete(dev, -EIO);
+		return;
+	}
+
+	data->msg_offset += data->chunk.len;
+	if (data->msg_offset == txn->msgs[data->msg_idx].len) {
+		data->msg_idx++;
+		data->msg_offset = 0U;
+	}
+
+	if (data->msg_idx < txn->num_msgs) {
+		stm32_i2c_async_chunk(dev);
+	} else {
+		stm32_i2c_async_complete(dev, 0);
+	}
+}
+#endif /* CONFIG_I2C_STM32_ASYNC */
+
+static void stm32_i2c_msg_done(struct device *dev)
+{
+#ifdef CONFIG_I2C_STM32_ASYNC
+	stm32_i2c_async_continue(dev);
+#else
+	k_sem_give(&DEV_DATA(dev)->device_sync_sem);
+#endif
+}
+
 static void stm32_i2c_master_mode_end(struct device *dev)
 {
 	const struct i2c_stm32_config *cfg = DEV_CFG(dev);
+#if defined(CONFIG_I2C_SLAVE)
 	struct i2c_stm32_data *data = DEV_DATA(dev);
+#endif
 	I2C_TypeDef *i2c = cfg->i2c;
 
 	stm32_i2c_disable_transfer_interrupts(dev);
@@ -105,7 +232,7 @@ static void stm32_i2c_master_mode_end(struct device *dev)
 #else
 	LL_I2C_Disable(i2c);
 #endif
-	k_sem_give(&data->device_sync_sem);
+	stm32_i2c_msg_done(dev);
 }
 
 #if defined(CONFIG_I2C_SLAVE)
@@ -309,7 +436,7 @@ static void stm32_i2c_event(struct device *dev)
 			LL_I2C_GenerateStopCondition(i2c);
 		} else {
 			stm32_i2c_disable_transfer_interrupts(dev);
-			k_sem_give(&data->device_sync_sem);
+			stm32_i2c_msg_done(dev);
 		}
 	}
 
@@ -14,10 +14,12 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(i2c_nrfx_twim);
 
+#include "i2c-priv.h"
+
 struct i2c_nrfx_twim_data {
-	struct k_sem transfer_sync;
-	struct k_sem completion_sync;
-	volatile nrfx_err_t res;
+	struct i2c_txn_queue queue;
+	/* Message of the transaction in progress */
+	u8_t msg_idx;
 	uint32_t dev_config;
 #ifdef CONFIG_DEVICE_POWER_MANAGEMENT
 	u32_t pm_state;
@@ -40,78 +42,113 @@ const struct i2c_nrfx_twim_config *get_dev_config(struct device *dev)
 	return dev->config->config_info;
 }
 
-static int i2c_nrfx_twim_transfer(struct device *dev, struct i2c_msg *msgs,
-				  u8_t num_msgs, u16_t addr)
+/* Start the current message of a transaction, the next one is started
+ * from the event handler when it is done.
+ */
+static int start_msg(struct device *dev, struct i2c_transaction *txn)
 {
-	int ret = 0;
+	struct i2c_msg *msg = &txn->msgs[get_dev_data(dev)->msg_idx];
+	nrfx_twim_xfer_desc_t cur_xfer = {
+		.p_primary_buf  = msg->buf,
+		.primary_length = msg->len,
+		.address	= txn->addr,
+		.type		= (msg->flags & I2C_MSG_READ) ?
+				  NRFX_TWIM_XFER_RX : NRFX_TWIM_XFER_TX
+	};
+	nrfx_err_t res;
+
+	if (I2C_MSG_ADDR_10_BITS & msg->flags) {
+		return -ENOTSUP;
+	}
 
-	k_sem_take(&(get_dev_data(dev)->transfer_sync), K_FOREVER);
-	nrfx_twim_enable(&get_dev_config(dev)->twim);
+	res = nrfx_twim_xfer(&get_dev_config(dev)->twim, &cur_xfer,
+			     (msg->flags & I2C_MSG_STOP) ?
+			     0 : NRFX_TWIM_FLAG_TX_NO_STOP);
+	if (res != NRFX_SUCCESS) {
+		return (res == NRFX_ERROR_BUSY) ? -EBUSY : -EIO;
+	}
 
-	for (size_t i = 0; i < num_msgs; i++) {
-		if (I2C_MSG_ADDR_10_BITS & msgs[i].flags) {
-			ret = -ENOTSUP;
-			break;
-		}
+	return 0;
+}
 
-		nrfx_twim_xfer_desc_t cur_xfer = {
-			.p_primary_buf  = msgs[i].buf,
-			.primary_length = msgs[i].len,
-			.address	= addr,
-			.type		= (msgs[i].flags & I2C_MSG_READ) ?
-					  NRFX_TWIM_XFER_RX : NRFX_TWIM_XFER_TX
-		};
-
-		nrfx_err_t res = nrfx_twim_xfer(&get_dev_config(dev)->twim,
-					       &cur_xfer,
-					       (msgs[i].flags & I2C_MSG_STOP) ?
-					       0 : NRFX_TWIM_FLAG_TX_NO_STOP);
-		if (res != NRFX_SUCCESS) {
-			if (res == NRFX_ERROR_BUSY) {
-				ret = -EBUSY;
-				break;
-			} else {
-				ret = -EIO;
-				break;
-			}
-		}
+static void bus_idle(struct device *dev)
+{
+	nrfx_twim_disable(&get_dev_config(dev)->twim);
+}
+
+/* Start a transaction, returns false if it completed immediately */
+static bool start_txn(struct device *dev, struct i2c_transaction *txn,
+		      int *result)
+{
+	get_dev_data(dev)->msg_idx = 0;
+	*result = 0;
+
+	if (txn->num_msgs == 0) {
+		return false;
+	}
+
+	*result = start_msg(dev, txn);
+
+	return (*result == 0);
+}
 
-		k_sem_take(&(get_dev_data(dev)->completion_sync), K_FOREVER);
-		res = get_dev_data(dev)->res;
-		if (res != NRFX_SUCCESS) {
-			LOG_ERR("Error %d occurred for message %d", res, i);
-			ret = -EIO;
-			break;
+/* Complete the current transaction and start the following ones */
+static void complete_txn(struct device *dev, int result)
+{
+	struct i2c_transaction *txn;
+
+	do {
+		txn = i2c_txn_queue_complete(dev, &get_dev_data(dev)->queue,
+					     result, bus_idle);
+	} while (txn != NULL && !start_txn(dev, txn, &result));
+}
+
+static int i2c_nrfx_twim_transfer_async(struct device *dev,
+					struct i2c_transaction *txn)
+{
+	int result;
+
+	if (i2c_txn_queue_put(&get_dev_data(dev)->queue, txn)) {
+		nrfx_twim_enable(&get_dev_config(dev)->twim);
+		if (!start_txn(dev, txn, &result)) {
+			complete_txn(dev, result);
 		}
 	}
 
-	nrfx_twim_disable(&get_dev_config(dev)->twim);
-	k_sem_give(&(get_dev_data(dev)->transfer_sync));
+	return 0;
+}
 
-	return ret;
+static int i2c_nrfx_twim_transfer(struct device *dev, struct i2c_msg *msgs,
+				  u8_t num_msgs, u16_t addr)
+{
+	struct i2c_transaction txn;
+	struct i2c_txn_sync sync;
+
+	i2c_txn_sync_init(&txn, &sync, msgs, num_msgs, addr);
+	(void)i2c_nrfx_twim_transfer_async(dev, &txn);
+
+	return i2c_txn_wait(&sync);
 }
 
 static void event_handler(nrfx_twim_evt_t const *p_event, void *p_context)
 {
 	struct device *dev = p_context;
 	struct i2c_nrfx_twim_data *dev_data = get_dev_data(dev);
-
-	switch (p_event->type) {
-	case NRFX_TWIM_EVT_DONE:
-		dev_data->res = NRFX_SUCCESS;
-		break;
-	case NRFX_TWIM_EVT_ADDRESS_NACK:
-		dev_data->res = NRFX_ERROR_DRV_TWI_ERR_ANACK;
-		break;
-	case NRFX_TWIM_EVT_DATA_NACK:
-		dev_data->res = NRFX_ERROR_DRV_TWI_ERR_DNACK;
-		break;
-	default:
-		dev_data->res = NRFX_ERROR_INTERNAL;
-		break;
+	struct i2c_transaction *txn = dev_data->queue.current;
+	int result = 0;
+
+	if (p_event->type != NRFX_TWIM_EVT_DONE) {
+		LOG_ERR("Error %d occurred for message %d", p_event->type,
+			dev_data->msg_idx);
+		result = -EIO;
+	} else if (++dev_data->msg_idx < txn->num_msgs) {
+		result = start_msg(dev, txn);
+		if (result == 0) {
+			return;
+		}
 	}
 
-	k_sem_give(&dev_data->completion_sync);
+	complete_txn(dev, result);
 }
 
 static int i2c_nrfx_twim_configure(struct device *dev, u32_t dev_config)
@@ -141,6 +178,9 @@ static int i2c_nrfx_twim_configure(struct device *dev, u32_t dev_config)
 static const struct i2c_driver_api i2c_nrfx_twim_driver_api = {
 	.configure = i2c_nrfx_twim_configure,
 	.transfer  = i2c_nrfx_twim_transfer,
+#ifdef CONFIG_I2C_ASYNC_API
+	.transfer_async = i2c_nrfx_twim_transfer_async,
+#endif
 };
 
 static int init_twim(struct device *dev)
@@ -228,12 +268,7 @@ static int twim_nrfx_pm_control(struct device *dev, u32_t ctrl_command,
 			    nrfx_isr, nrfx_twim_##idx##_irq_handler, 0);       \
 		return init_twim(dev);					       \
 	}								       \
-	static struct i2c_nrfx_twim_data twim_##idx##_data = {		       \
-		.transfer_sync = Z_SEM_INITIALIZER(                            \
-			twim_##idx##_data.transfer_sync, 1, 1),                \
-		.completion_sync = Z_SEM_INITIALIZER(                          \
-			twim_##idx##_data.completion_sync, 0, 1)               \
-	};								       \
+	static struct i2c_nrfx_twim_data twim_##idx##_data;		       \
 	static const struct i2c_nrfx_twim_config twim_##idx##z_config = {      \
 		.twim = NRFX_TWIM_INSTANCE(idx),			       \
 		.config = {						       \
@@ -212,7 +212,21 @@ static int i2s_stm32_configure(struct device *dev, enum i2s_dir dir,
 		return 0;
 	}
 
+	if (i2s_cfg->options & I2S_OPT_CYCLIC) {
+#ifdef CONFIG_I2S_STM32_CYCLIC
+		if (2 * i2s_cfg->block_size >
+		    CONFIG_I2S_STM32_CYCLIC_BUF_SIZE) {
+			LOG_ERR("block size too large for cyclic mode");
+			return -EINVAL;
+		}
+#else
+		LOG_ERR("cyclic mode not enabled");
+		return -ENOTSUP;
+#endif
+	}
+
 	memcpy(&stream->cfg, i2s_cfg, sizeof(struct i2s_config));
+	memset(&stream->stats, 0, sizeof(stream->stats));
 
 	/* set I2S bitclock */
 	bit_clk_freq = i2s_cfg->frame_clk_freq *
@@ -411,11 +425,29 @@ static int i2s_stm32_write(struct device *dev, void *mem_block, size_t size)
 	return 0;
 }
 
+static int i2s_stm32_stats_get(struct device *dev, enum i2s_dir dir,
+			       struct i2s_stats *stats)
+{
+	struct i2s_stm32_data *const dev_data = DEV_DATA(dev);
+	unsigned int key;
+
+	if (dir != I2S_DIR_RX && dir != I2S_DIR_TX) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	*stats = (dir == I2S_DIR_RX) ? dev_data->rx.stats : dev_data->tx.stats;
+	irq_unlock(key);
+
+	return 0;
+}
+
 static const struct i2s_driver_api i2s_stm32_driver_api = {
 	.configure = i2s_stm32_configure,
 	.read = i2s_stm32_read,
 	.write = i2s_stm32_write,
 	.trigger = i2s_stm32_trigger,
+	.stats_get = i2s_stm32_stats_get,
 };
 
 #define STM32_DMA_NUM_CHANNELS		8
@@ -442,11 +474,17 @@ static int start_dma(struct device *dev_dma, u32_t channel,
 		     struct dma_config *dcfg, void *src,
 		     bool src_addr_increment, void *dst,
 		     bool dst_addr_increment, u8_t fifo_threshold,
-		     u32_t blk_size)
+		     u32_t blk_size, bool cyclic)
 {
 	struct dma_block_config blk_cfg;
 	int ret;
 
+	/* A cyclic transfer notifies the completion of each half of the
+	 * block, i.e. of each half of the ring.
+	 */
+	dcfg->cyclic = cyclic;
+	dcfg->half_complete_callback_en = cyclic;
+
 	memset(&blk_cfg, 0, sizeof(blk_cfg));
 	blk_cfg.block_size = blk_size;
 	blk_cfg.source_address = (u32_t)src;
@@ -480,6 +518,87 @@ static struct device *get_dev_from_tx_dma_channel(u32_t dma_channel);
 static void rx_stream_disable(struct stream *stream, struct device *dev);
 static void tx_stream_disable(struct stream *stream, struct device *dev);
 
+#ifdef CONFIG_I2S_STM32_CYCLIC
+/* Returns the half of the ring the DMA has just completed */
+static u8_t *cyclic_half(struct stream *stream, int status)
+{
+	if (status == DMA_STATUS_HALF_COMPLETE) {
+		return stream->ring;
+	}
+
+	return stream->ring + stream->cfg.block_size;
+}
+
+/* Returns false once the stream must be stopped */
+static bool rx_cyclic_callback(struct stream *stream, int status)
+{
+	u8_t *half = cyclic_half(stream, status);
+	void *mem_block;
+
+	if (stream->state == I2S_STATE_STOPPING) {
+		stream->state = I2S_STATE_READY;
+		return false;
+	}
+
+	/* Assure cache coherency after DMA write operation */
+	DCACHE_INVALIDATE(half, stream->cfg.block_size);
+
+	if (k_mem_slab_alloc(stream->cfg.mem_slab, &mem_block,
+			     K_NO_WAIT) < 0) {
+		stream->stats.xruns++;
+		return true;
+	}
+
+	memcpy(mem_block, half, stream->cfg.block_size);
+
+	if (queue_put(&stream->mem_block_queue, mem_block,
+		      stream->cfg.block_size) < 0) {
+		k_mem_slab_free(stream->cfg.mem_slab, &mem_block);
+		stream->stats.xruns++;
+		return true;
+	}
+
+	stream->stats.blocks++;
+	k_sem_give(&stream->sem);
+
+	return true;
+}
+
+/* Refills the half of the ring which was just sent, with silence if there
+ * is no block to send. Returns false once the stream must be stopped.
+ */
+static bool tx_cyclic_fill(struct stream *stream, u8_t *half)
+{
+	size_t size = 0;
+	void *mem_block;
+
+	if (stream->last_block) {
+		stream->state = I2S_STATE_READY;
+		return false;
+	}
+
+	if (queue_get(&stream->mem_block_queue, &mem_block, &size) == 0) {
+		size = MIN(size, stream->cfg.block_size);
+		memcpy(half, mem_block, size);
+		k_mem_slab_free(stream->cfg.mem_slab, &mem_block);
+		k_sem_give(&stream->sem);
+		stream->stats.blocks++;
+	} else if (stream->state == I2S_STATE_STOPPING) {
+		/* Stop once the other half, the last block, is sent */
+		stream->last_block = true;
+	} else {
+		stream->stats.xruns++;
+	}
+
+	memset(half + size, 0, stream->cfg.block_size - size);
+
+	/* Assure cache coherency before DMA read operation */
+	DCACHE_CLEAN(half, stream->cfg.block_size);
+
+	return true;
+}
+#endif /* CONFIG_I2S_STM32_CYCLIC */
+
 /* This function is executed in the interrupt context */
 static void dma_rx_callback(void *arg, u32_t channel, int status)
 {
@@ -490,6 +609,15 @@ static void dma_rx_callback(void *arg, u32_t channel, int status)
 	void *mblk_tmp;
 	int ret;
 
+#ifdef CONFIG_I2S_STM32_CYCLIC
+	if (status >= 0 && (stream->cfg.options & I2S_OPT_CYCLIC)) {
+		if (!rx_cyclic_callback(stream, status)) {
+			goto rx_disable;
+		}
+		return;
+	}
+#endif
+
 	if (status != 0) {
 		ret = -EIO;
 		stream->state = I2S_STATE_ERROR;
@@ -509,6 +637,7 @@ static void dma_rx_callback(void *arg, u32_t channel, int status)
 	ret = k_mem_slab_alloc(stream->cfg.mem_slab, &stream->mem_block,
 			       K_NO_WAIT);
 	if (ret < 0) {
+		stream->stats.xruns++;
 		stream->state = I2S_STATE_ERROR;
 		goto rx_disable;
 	}
@@ -530,9 +659,11 @@ static void dma_rx_callback(void *arg, u32_t channel, int status)
 	ret = queue_put(&stream->mem_block_queue, mblk_tmp,
 			stream->cfg.block_size);
 	if (ret < 0) {
+		stream->stats.xruns++;
 		stream->state = I2S_STATE_ERROR;
 		goto rx_disable;
 	}
+	stream->stats.blocks++;
 	k_sem_give(&stream->sem);
 
 	/* Stop reception if we were requested */
@@ -556,6 +687,15 @@ static void dma_tx_callback(void *arg, u32_t channel, int status)
 	size_t mem_block_size;
 	int ret;
 
+#ifdef CONFIG_I2S_STM32_CYCLIC
+	if (status >= 0 && (stream->cfg.options & I2S_OPT_CYCLIC)) {
+		if (!tx_cyclic_fill(stream, cyclic_half(stream, status))) {
+			goto tx_disable;
+		}
+		return;
+	}
+#endif
+
 	if (status != 0) {
 		ret = -EIO;
 		stream->state = I2S_STATE_ERROR;
@@ -567,6 +707,7 @@ static void dma_tx_callback(void *arg, u32_t channel, int status)
 	/* All block data sent */
 	k_mem_slab_free(stream->cfg.mem_slab, &stream->mem_block);
 	stream->mem_block = NULL;
+	stream->stats.blocks++;
 
 	/* Stop transmission if there was an error */
 	if (stream->state == I2S_STATE_ERROR) {
@@ -587,6 +728,7 @@ static void dma_tx_callback(void *arg, u32_t channel, int status)
 		if (stream->state == I2S_STATE_STOPPING) {
 			stream->state = I2S_STATE_READY;
 		} else {
+			stream->stats.xruns++;
 			stream->state = I2S_STATE_ERROR;
 		}
 		goto tx_disable;
@@ -679,12 +821,21 @@ static int rx_stream_start(struct stream *stream, struct device *dev)
 {
 	const struct i2s_stm32_cfg *cfg = DEV_CFG(dev);
 	struct i2s_stm32_data *const dev_data = DEV_DATA(dev);
+	bool cyclic = stream->cfg.options & I2S_OPT_CYCLIC;
+	void *buf = NULL;
 	int ret;
 
-	ret = k_mem_slab_alloc(stream->cfg.mem_slab, &stream->mem_block,
-			       K_NO_WAIT);
-	if (ret < 0) {
-		return ret;
+	if (cyclic) {
+#ifdef CONFIG_I2S_STM32_CYCLIC
+		buf = stream->ring;
+#endif
+	} else {
+		ret = k_mem_slab_alloc(stream->cfg.mem_slab,
+				       &stream->mem_block, K_NO_WAIT);
+		if (ret < 0) {
+			return ret;
+		}
+		buf = stream->mem_block;
 	}
 
 	if (stream->master) {
@@ -699,9 +850,11 @@ static int rx_stream_start(struct stream *stream, struct device *dev)
 	ret = start_dma(dev_data->dev_dma_rx, stream->dma_channel,
 			&stream->dma_cfg,
 			(void *)LL_SPI_DMA_GetRegAddr(cfg->i2s),
-			stream->src_addr_increment, stream->mem_block,
+			stream->src_addr_increment, buf,
 			stream->dst_addr_increment, stream->fifo_threshold,
-			stream->cfg.block_size);
+			cyclic ? 2 * stream->cfg.block_size :
+				 stream->cfg.block_size,
+			cyclic);
 	if (ret < 0) {
 		LOG_ERR("Failed to start RX DMA transfer: %d", ret);
 		return ret;
@@ -719,18 +872,36 @@ static int tx_stream_start(struct stream *stream, struct device *dev)
 {
 	const struct i2s_stm32_cfg *cfg = DEV_CFG(dev);
 	struct i2s_stm32_data *const dev_data = DEV_DATA(dev);
+	bool cyclic = stream->cfg.options & I2S_OPT_CYCLIC;
 	size_t mem_block_size;
+	void *buf = NULL;
 	int ret;
 
-	ret = queue_get(&stream->mem_block_queue, &stream->mem_block,
-			&mem_block_size);
-	if (ret < 0) {
-		return ret;
-	}
-	k_sem_give(&stream->sem);
+	if (cyclic) {
+#ifdef CONFIG_I2S_STM32_CYCLIC
+		if (stream->mem_block_queue.head ==
+		    stream->mem_block_queue.tail) {
+			return -ENOMEM;
+		}
 
-	/* Assure cache coherency before DMA read operation */
-	DCACHE_CLEAN(stream->mem_block, mem_block_size);
+		buf = stream->ring;
+		stream->last_block = false;
+		(void)tx_cyclic_fill(stream, buf);
+		(void)tx_cyclic_fill(stream,
+				     (u8_t *)buf + stream->cfg.block_size);
+#endif
+	} else {
+		ret = queue_get(&stream->mem_block_queue, &stream->mem_block,
+				&mem_block_size);
+		if (ret < 0) {
+			return ret;
+		}
+		k_sem_give(&stream->sem);
+
+		/* Assure cache coherency before DMA read operation */
+		DCACHE_CLEAN(stream->mem_block, mem_block_size);
+		buf = stream->mem_block;
+	}
 
 	if (stream->master) {
 		LL_I2S_SetTransferMode(cfg->i2s, LL_I2S_MODE_MASTER_TX);
@@ -743,10 +914,12 @@ static int tx_stream_start(struct stream *stream, struct device *dev)
 
 	ret = start_dma(dev_data->dev_dma_tx, stream->dma_channel,
 			&stream->dma_cfg,
-			stream->mem_block, stream->src_addr_increment,
+			buf, stream->src_addr_increment,
 			(void *)LL_SPI_DMA_GetRegAddr(cfg->i2s),
 			stream->dst_addr_increment, stream->fifo_threshold,
-			stream->cfg.block_size);
+			cyclic ? 2 * stream->cfg.block_size :
+				 stream->cfg.block_size,
+			cyclic);
 	if (ret < 0) {
 		LOG_ERR("Failed to start TX DMA transfer: %d", ret);
 		return ret;
@@ -866,8 +1039,20 @@ static struct device *get_dev_from_tx_dma_channel(u32_t dma_channel)
 	.queue_drop = dir##_queue_drop,					\
 	.mem_block_queue.buf = dir##_##index##_ring_buf,		\
 	.mem_block_queue.len = ARRAY_SIZE(dir##_##index##_ring_buf),	\
+	I2S_CYCLIC_RING_INIT(index, dir)				\
 }
 
+#ifdef CONFIG_I2S_STM32_CYCLIC
+#define I2S_CYCLIC_RING_DEFINE(index, dir)				\
+static u8_t __aligned(4)						\
+	dir##_##index##_cyclic_ring[CONFIG_I2S_STM32_CYCLIC_BUF_SIZE];
+#define I2S_CYCLIC_RING_INIT(index, dir)				\
+	.ring = dir##_##index##_cyclic_ring,
+#else
+#define I2S_CYCLIC_RING_DEFINE(index, dir)
+#define I2S_CYCLIC_RING_INIT(index, dir)
+#endif
+
 #define I2S_INIT(index, clk_sel)					\
 static struct device DEVICE_NAME_GET(i2s_stm32_##index);		\
 									\
@@ -885,6 +1070,8 @@ static const struct i2s_stm32_cfg i2s_stm32_config_##index = {		\
 									\
 struct queue_item rx_##index##_ring_buf[CONFIG_I2S_STM32_RX_BLOCK_COUNT + 1];\
 struct queue_item tx_##index##_ring_buf[CONFIG_I2S_STM32_TX_BLOCK_COUNT + 1];\
+I2S_CYCLIC_RING_DEFINE(index, rx)					\
+I2S_CYCLIC_RING_DEFINE(index, tx)					\
 									\
 static struct i2s_stm32_data i2s_stm32_data_##index = {			\
 	I2S_DMA_CHANNEL_INIT(index, rx, RX, PERIPH, MEM),		\
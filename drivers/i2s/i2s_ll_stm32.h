@@ -92,6 +92,11 @@ struct stream {
 	void *mem_block;
 	bool last_block;
 	bool master;
+	struct i2s_stats stats;
+#ifdef CONFIG_I2S_STM32_CYCLIC
+	/* DMA ring of two blocks used with I2S_OPT_CYCLIC */
+	u8_t *ring;
+#endif
 	int (*stream_start)(struct stream *, struct device *dev);
 	void (*stream_disable)(struct stream *, struct device *dev);
 	void (*queue_drop)(struct stream *);
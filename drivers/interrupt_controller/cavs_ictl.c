@@ -18,8 +18,7 @@ static ALWAYS_INLINE void cavs_ictl_dispatch_child_isrs(u32_t intr_status,
 		intr_bitpos = find_lsb_set(intr_status) - 1;
 		intr_status &= ~(1 << intr_bitpos);
 		intr_offset = isr_base_offset + intr_bitpos;
-		_sw_isr_table[intr_offset].isr(
-			_sw_isr_table[intr_offset].arg);
+		z_sw_isr_dispatch(intr_offset);
 	}
 }
 
@@ -137,7 +137,6 @@ static void plic_irq_handler(void *arg)
 	    (volatile struct plic_regs_t *) DT_INST_0_SIFIVE_PLIC_1_0_0_REG_BASE_ADDRESS;
 
 	u32_t irq;
-	struct _isr_table_entry *ite;
 
 	/* Get the IRQ number generating the interrupt */
 	irq = regs->claim_complete;
@@ -160,8 +159,7 @@ static void plic_irq_handler(void *arg)
 	irq += CONFIG_2ND_LVL_ISR_TBL_OFFSET;
 
 	/* Call the corresponding IRQ handler in _sw_isr_table */
-	ite = (struct _isr_table_entry *)&_sw_isr_table[irq];
-	ite->isr(ite->arg);
+	z_sw_isr_dispatch(irq);
 
 	/*
 	 * Write to claim_complete register to indicate to
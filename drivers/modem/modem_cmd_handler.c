@@ -77,11 +77,6 @@ static u16_t findcrlf(struct modem_cmd_handler_data *data,
  * Cmd Handler Functions
  */
 
-static inline struct net_buf *read_rx_allocator(s32_t timeout, void *user_data)
-{
-	return net_buf_alloc((struct net_buf_pool *)user_data, timeout);
-}
-
 /* return scanned length for params */
 static int parse_params(u8_t *buf, size_t buf_len, struct modem_cmd *cmd,
 			u8_t **argv, size_t argv_len, u16_t *argc)
@@ -205,7 +200,8 @@ static void cmd_handler_process(struct modem_cmd_handler *cmd_handler,
 	struct modem_cmd_handler_data *data;
 	struct modem_cmd *cmd;
 	struct net_buf *frag = NULL;
-	size_t match_len, rx_len, bytes_read = 0;
+	size_t match_len, bytes_read = 0;
+	bool new_frag;
 	int ret;
 	u16_t offset, len;
 
@@ -216,34 +212,44 @@ static void cmd_handler_process(struct modem_cmd_handler *cmd_handler,
 
 	data = (struct modem_cmd_handler_data *)(cmd_handler->cmd_handler_data);
 
-	/* read all of the data from modem iface */
+	/* read all of the data from modem iface, straight into the tail of
+	 * the net_buf chain
+	 */
 	while (true) {
-		ret = iface->read(iface, data->read_buf,
-				  data->read_buf_len, &bytes_read);
-		if (ret < 0 || bytes_read == 0) {
-			/* modem context buffer is empty */
-			break;
-		}
+		frag = data->rx_buf ? net_buf_frag_last(data->rx_buf) : NULL;
+		new_frag = !frag || net_buf_tailroom(frag) == 0U;
 
 		/* make sure we have storage */
-		if (!data->rx_buf) {
-			data->rx_buf = net_buf_alloc(data->buf_pool,
-						     data->alloc_timeout);
-			if (!data->rx_buf) {
+		if (new_frag) {
+			frag = net_buf_alloc(data->buf_pool,
+					     data->alloc_timeout);
+			if (!frag) {
 				LOG_ERR("Can't allocate RX data! "
 					"Skipping data!");
 				break;
 			}
 		}
 
-		rx_len = net_buf_append_bytes(data->rx_buf, bytes_read,
-					      data->read_buf,
-					      data->alloc_timeout,
-					      read_rx_allocator,
-					      data->buf_pool);
-		if (rx_len < bytes_read) {
-			LOG_ERR("Data was lost! read %zu of %zu!",
-				rx_len, bytes_read);
+		ret = iface->read(iface, net_buf_tail(frag),
+				  net_buf_tailroom(frag), &bytes_read);
+		if (ret < 0 || bytes_read == 0) {
+			/* modem context buffer is empty */
+			if (new_frag) {
+				net_buf_unref(frag);
+			}
+			break;
+		}
+
+		net_buf_add(frag, bytes_read);
+
+		if (!new_frag) {
+			continue;
+		}
+
+		if (!data->rx_buf) {
+			data->rx_buf = frag;
+		} else {
+			net_buf_frag_add(data->rx_buf, frag);
 		}
 	}
 
@@ -478,7 +484,7 @@ int modem_cmd_handler_init(struct modem_cmd_handler *handler,
 		return -EINVAL;
 	}
 
-	if (!data->read_buf_len || !data->match_buf_len) {
+	if (!data->match_buf_len) {
 		return -EINVAL;
 	}
 
@@ -19,6 +19,59 @@ LOG_MODULE_REGISTER(modem_iface_uart, CONFIG_MODEM_LOG_LEVEL);
 #include "modem_context.h"
 #include "modem_iface_uart.h"
 
+#ifdef CONFIG_MODEM_IFACE_UART_ASYNC
+/**
+ * @brief  Modem interface UART event handler.
+ *
+ * @note   Moves received data to the interface ring buffer, a whole
+ *         chunk at a time, and keeps reception going by alternating
+ *         between the two halves of the ISR buffer.
+ *         When ring buffer is full the data is discarded.
+ *
+ * @param  *evt: UART event.
+ * @param  *user_data: modem interface.
+ *
+ * @retval None.
+ */
+static void modem_iface_uart_async_cb(struct uart_event *evt,
+				      void *user_data)
+{
+	struct modem_iface *iface = user_data;
+	struct modem_iface_uart_data *data = iface->iface_data;
+	size_t half = data->isr_buf_len / 2;
+	int ret;
+
+	switch (evt->type) {
+	case UART_RX_RDY:
+		ret = ring_buf_put(&data->rx_rb,
+				   evt->data.rx.buf + evt->data.rx.offset,
+				   evt->data.rx.len);
+		if (ret != evt->data.rx.len) {
+			LOG_ERR("Rx buffer doesn't have enough space. "
+				"Bytes pending: %zu, written: %d",
+				evt->data.rx.len, ret);
+		}
+
+		k_sem_give(&data->rx_sem);
+		break;
+	case UART_RX_BUF_REQUEST:
+		(void)uart_rx_buf_rsp(iface->dev,
+				      (u8_t *)data->isr_buf +
+				      data->rx_buf_next * half,
+				      half);
+		data->rx_buf_next ^= 1U;
+		break;
+	case UART_RX_DISABLED:
+		/* Reception stopped on an error, restart it */
+		data->rx_buf_next = 1U;
+		(void)uart_rx_enable(iface->dev, (u8_t *)data->isr_buf, half,
+				     CONFIG_MODEM_IFACE_UART_ASYNC_RX_TIMEOUT);
+		break;
+	default:
+		break;
+	}
+}
+#else
 /**
  * @brief  Drains UART.
  *
@@ -82,6 +135,7 @@ static void modem_iface_uart_isr(struct device *uart_dev)
 		k_sem_give(&data->rx_sem);
 	}
 }
+#endif /* CONFIG_MODEM_IFACE_UART_ASYNC */
 
 static int modem_iface_uart_read(struct modem_iface *iface,
 				 u8_t *buf, size_t size, size_t *bytes_read)
@@ -142,6 +196,14 @@ int modem_iface_uart_init(struct modem_iface *iface,
 	ring_buf_init(&data->rx_rb, data->rx_rb_buf_len, data->rx_rb_buf);
 	k_sem_init(&data->rx_sem, 0, 1);
 
+#ifdef CONFIG_MODEM_IFACE_UART_ASYNC
+	data->rx_buf_next = 1U;
+	uart_callback_set(iface->dev, modem_iface_uart_async_cb, iface);
+
+	return uart_rx_enable(iface->dev, (u8_t *)data->isr_buf,
+			      data->isr_buf_len / 2,
+			      CONFIG_MODEM_IFACE_UART_ASYNC_RX_TIMEOUT);
+#else
 	uart_irq_rx_disable(iface->dev);
 	uart_irq_tx_disable(iface->dev);
 	modem_iface_uart_flush(iface);
@@ -149,4 +211,5 @@ int modem_iface_uart_init(struct modem_iface *iface,
 	uart_irq_rx_enable(iface->dev);
 
 	return 0;
+#endif
 }
@@ -33,6 +33,11 @@ struct modem_iface_uart_data {
 
 	/* rx semaphore */
 	struct k_sem rx_sem;
+
+#ifdef CONFIG_MODEM_IFACE_UART_ASYNC
+	/* half of isr_buf to provide on the next RX buffer request */
+	u8_t rx_buf_next;
+#endif
 };
 
 /**
@@ -122,7 +122,6 @@ struct modem_data {
 
 	/* modem cmds */
 	struct modem_cmd_handler_data cmd_handler_data;
-	u8_t cmd_read_buf[MDM_RECV_BUF_SIZE];
 	u8_t cmd_match_buf[MDM_RECV_BUF_SIZE];
 
 	/* socket data */
@@ -1274,8 +1273,6 @@ static int modem_init(struct device *dev)
 	mdata.cmd_handler_data.cmds_len[CMD_RESP] = ARRAY_SIZE(response_cmds);
 	mdata.cmd_handler_data.cmds[CMD_UNSOL] = unsol_cmds;
 	mdata.cmd_handler_data.cmds_len[CMD_UNSOL] = ARRAY_SIZE(unsol_cmds);
-	mdata.cmd_handler_data.read_buf = &mdata.cmd_read_buf[0];
-	mdata.cmd_handler_data.read_buf_len = sizeof(mdata.cmd_read_buf);
 	mdata.cmd_handler_data.match_buf = &mdata.cmd_match_buf[0];
 	mdata.cmd_handler_data.match_buf_len = sizeof(mdata.cmd_match_buf);
 	mdata.cmd_handler_data.buf_pool = &mdm_recv_pool;
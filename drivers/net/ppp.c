@@ -28,6 +28,7 @@ LOG_MODULE_REGISTER(net_ppp, LOG_LEVEL);
 #include <net/net_if.h>
 #include <net/net_core.h>
 #include <console/uart_pipe.h>
+#include <drivers/uart.h>
 #include <sys/crc.h>
 
 #include "../../subsys/net/ip/net_stats.h"
@@ -35,6 +36,26 @@ LOG_MODULE_REGISTER(net_ppp, LOG_LEVEL);
 
 #define UART_BUF_LEN CONFIG_NET_PPP_UART_PIPE_BUF_LEN
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+#define UART_TX_BUF_LEN CONFIG_NET_PPP_ASYNC_UART_BUF_LEN
+
+/* Idle time in ms after which the received bytes are passed up */
+#define UART_RX_TIMEOUT 1
+#else
+#define UART_TX_BUF_LEN UART_BUF_LEN
+#endif
+
+/* Bytes escaped when sent, RFC 1662 ch. 7.1: the default ACCM (0x00 - 0x1f),
+ * the Control Escape (0x7d) and the Flag Sequence (0x7e).
+ */
+static const u8_t ppp_escape_map[32] = {
+	0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60,
+};
+
+#define PPP_NEEDS_ESCAPE(byte) \
+	(ppp_escape_map[(byte) >> 3] & BIT((byte) & 0x07))
+
 enum ppp_driver_state {
 	STATE_HDLC_FRAME_START,
 	STATE_HDLC_FRAME_ADDRESS,
@@ -53,8 +74,22 @@ struct ppp_driver_context {
 	/* ppp data is read into this buf */
 	u8_t buf[UART_BUF_LEN];
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+	struct device *dev;
+
+	/* A frame is escaped into one buffer while the other one is sent */
+	u8_t send_bufs[2][UART_TX_BUF_LEN];
+	u8_t *send_buf;
+
+	/* Given back when the UART is done with a buffer */
+	struct k_sem tx_sem;
+
+	u8_t rx_bufs[2][CONFIG_NET_PPP_ASYNC_UART_BUF_LEN];
+	u8_t rx_next;
+#else
 	/* ppp buf use when sending data */
 	u8_t send_buf[UART_BUF_LEN];
+#endif
 
 	u8_t mac_addr[6];
 	struct net_linkaddr ll_addr;
@@ -367,6 +402,99 @@ static u8_t *ppp_recv_cb(u8_t *buf, size_t *off)
 	return buf;
 }
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+static void ppp_recv_async(struct ppp_driver_context *ppp, const u8_t *data,
+			   size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		if (ppp_input_byte(ppp, data[i]) == 0) {
+			/* Ignore empty or too short frames */
+			if (ppp->pkt && net_pkt_get_len(ppp->pkt) > 3) {
+				ppp_process_msg(ppp);
+			}
+		}
+	}
+}
+
+static void ppp_rx_start(struct ppp_driver_context *ppp)
+{
+	int ret;
+
+	ppp->rx_next = 1U;
+
+	ret = uart_rx_enable(ppp->dev, ppp->rx_bufs[0],
+			     sizeof(ppp->rx_bufs[0]), UART_RX_TIMEOUT);
+	if (ret < 0) {
+		LOG_ERR("[%p] cannot enable RX (%d)", ppp, ret);
+	}
+}
+
+static void ppp_uart_cb(struct uart_event *evt, void *user_data)
+{
+	struct ppp_driver_context *ppp = user_data;
+
+	switch (evt->type) {
+	case UART_TX_ABORTED:
+		LOG_DBG("[%p] TX aborted after %zd bytes", ppp,
+			evt->data.tx.len);
+		/* fall through */
+	case UART_TX_DONE:
+		k_sem_give(&ppp->tx_sem);
+		break;
+
+	case UART_RX_RDY:
+		ppp_recv_async(ppp, evt->data.rx.buf + evt->data.rx.offset,
+			       evt->data.rx.len);
+		break;
+
+	case UART_RX_BUF_REQUEST:
+		(void)uart_rx_buf_rsp(ppp->dev, ppp->rx_bufs[ppp->rx_next],
+				      sizeof(ppp->rx_bufs[0]));
+		ppp->rx_next ^= 1U;
+		break;
+
+	case UART_RX_STOPPED:
+		LOG_DBG("[%p] RX stopped (0x%x)", ppp,
+			evt->data.rx_stop.reason);
+		break;
+
+	case UART_RX_DISABLED:
+		/* The frame being received is resynchronized on the next flag */
+		ppp_change_state(ppp, STATE_HDLC_FRAME_START);
+		ppp_rx_start(ppp);
+		break;
+
+	default:
+		break;
+	}
+}
+
+static void ppp_uart_start(struct ppp_driver_context *ppp)
+{
+	ppp->dev = device_get_binding(CONFIG_NET_PPP_ASYNC_UART_NAME);
+	if (!ppp->dev) {
+		LOG_ERR("[%p] UART %s not found", ppp,
+			CONFIG_NET_PPP_ASYNC_UART_NAME);
+		return;
+	}
+
+	if (uart_callback_set(ppp->dev, ppp_uart_cb, ppp) < 0) {
+		LOG_ERR("[%p] UART %s has no async API", ppp,
+			CONFIG_NET_PPP_ASYNC_UART_NAME);
+		return;
+	}
+
+	ppp_rx_start(ppp);
+}
+#else
+static void ppp_uart_start(struct ppp_driver_context *ppp)
+{
+	uart_pipe_register(ppp->buf, sizeof(ppp->buf), ppp_recv_cb);
+}
+#endif /* CONFIG_NET_PPP_ASYNC_UART */
+
 #if defined(CONFIG_NET_TEST)
 void ppp_driver_feed_data(u8_t *data, int data_len)
 {
@@ -402,43 +530,35 @@ void ppp_driver_feed_data(u8_t *data, int data_len)
 }
 #endif
 
-static bool calc_fcs(struct net_pkt *pkt, u16_t *fcs, u16_t protocol)
+static int ppp_send_flush(struct ppp_driver_context *ppp, int off)
 {
-	struct net_buf *buf;
-	u16_t crc;
-	u16_t c;
-
-	buf = pkt->buffer;
-	if (!buf) {
-		return false;
+	if (IS_ENABLED(CONFIG_NET_TEST)) {
+		return 0;
 	}
 
-	/* HDLC Address and Control fields */
-	c = sys_cpu_to_be16(0xff << 8 | 0x03);
-
-	crc = crc16_ccitt(0xffff, (const u8_t *)&c, sizeof(c));
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+	int ret;
 
-	if (protocol > 0) {
-		crc = crc16_ccitt(crc, (const u8_t *)&protocol,
-				  sizeof(protocol));
-	}
+	/* Only one transfer at a time, the buffer sent before this one has
+	 * to be done so that it can be filled next.
+	 */
+	k_sem_take(&ppp->tx_sem, K_FOREVER);
 
-	while (buf) {
-		crc = crc16_ccitt(crc, buf->data, buf->len);
-		buf = buf->frags;
+	ret = uart_tx(ppp->dev, ppp->send_buf, off, K_FOREVER);
+	if (ret < 0) {
+		LOG_ERR("[%p] cannot send %d bytes (%d)", ppp, off, ret);
+		k_sem_give(&ppp->tx_sem);
+		return 0;
 	}
 
-	crc ^= 0xffff;
-	*fcs = crc;
-
-	return true;
-}
-
-static int ppp_send_flush(struct ppp_driver_context *ppp, int off)
-{
-	if (!IS_ENABLED(CONFIG_NET_TEST)) {
-		uart_pipe_send(ppp->send_buf, off);
+	if (ppp->send_buf == ppp->send_bufs[0]) {
+		ppp->send_buf = ppp->send_bufs[1];
+	} else {
+		ppp->send_buf = ppp->send_bufs[0];
 	}
+#else
+	uart_pipe_send(ppp->send_buf, off);
+#endif
 
 	return 0;
 }
@@ -451,7 +571,7 @@ static int ppp_send_bytes(struct ppp_driver_context *ppp,
 	for (i = 0; i < len; i++) {
 		ppp->send_buf[off++] = data[i];
 
-		if (off >= sizeof(ppp->send_buf)) {
+		if (off >= UART_TX_BUF_LEN) {
 			off = ppp_send_flush(ppp, off);
 		}
 	}
@@ -459,15 +579,50 @@ static int ppp_send_bytes(struct ppp_driver_context *ppp,
 	return off;
 }
 
-static u16_t ppp_escape_byte(u8_t byte, int *offset)
+/* Escapes the data into the send buffer, RFC 1662 ch. 4.2. The runs of
+ * bytes that need no escaping are copied at once, and the FCS is updated
+ * while the data is still in cache.
+ */
+static int ppp_send_escaped(struct ppp_driver_context *ppp, u16_t *fcs,
+			    const u8_t *data, int len, int off)
 {
-	if (byte == 0x7e || byte == 0x7d || byte < 0x20) {
-		*offset = 0;
-		return (0x7d << 8) | (byte ^ 0x20);
+	int run, max;
+	u8_t esc[2];
+
+	if (fcs) {
+		*fcs = crc16_ccitt(*fcs, data, len);
 	}
 
-	*offset = 1;
-	return byte;
+	while (len > 0) {
+		if (PPP_NEEDS_ESCAPE(*data)) {
+			esc[0] = 0x7d;
+			esc[1] = *data ^ 0x20;
+
+			off = ppp_send_bytes(ppp, esc, sizeof(esc), off);
+
+			data++;
+			len--;
+			continue;
+		}
+
+		max = MIN(len, UART_TX_BUF_LEN - off);
+
+		for (run = 1; run < max && !PPP_NEEDS_ESCAPE(data[run]);
+		     run++) {
+		}
+
+		memcpy(&ppp->send_buf[off], data, run);
+
+		off += run;
+		data += run;
+		len -= run;
+
+		if (off >= UART_TX_BUF_LEN) {
+			off = ppp_send_flush(ppp, off);
+		}
+	}
+
+	return off;
 }
 
 static int ppp_send(struct device *dev, struct net_pkt *pkt)
@@ -476,10 +631,11 @@ static int ppp_send(struct device *dev, struct net_pkt *pkt)
 	struct net_buf *buf = pkt->buffer;
 	u16_t protocol = 0;
 	int send_off = 0;
+	static const u8_t addr_ctrl[] = { 0xff, 0x03 };
 	u32_t sync_addr_ctrl;
-	u16_t fcs, escaped;
+	u8_t fcs_bytes[2];
+	u16_t fcs;
 	u8_t byte;
-	int i, offset;
 
 #if defined(CONFIG_NET_TEST)
 	return 0;
@@ -505,26 +661,18 @@ static int ppp_send(struct device *dev, struct net_pkt *pkt)
 		}
 	}
 
-	if (!calc_fcs(pkt, &fcs, protocol)) {
-		return -ENOMEM;
-	}
-
 	/* Sync, Address & Control fields */
 	sync_addr_ctrl = sys_cpu_to_be32(0x7e << 24 | 0xff << 16 |
 					 0x7d << 8 | 0x23);
 	send_off = ppp_send_bytes(ppp, (const u8_t *)&sync_addr_ctrl,
 				  sizeof(sync_addr_ctrl), send_off);
 
-	if (protocol > 0) {
-		escaped = htons(ppp_escape_byte(protocol, &offset));
-		send_off = ppp_send_bytes(ppp, (u8_t *)&escaped + offset,
-					  offset ? 1 : 2,
-					  send_off);
+	/* The FCS covers the Address and Control fields, RFC 1662 ch. 3.1 */
+	fcs = crc16_ccitt(0xffff, addr_ctrl, sizeof(addr_ctrl));
 
-		escaped = htons(ppp_escape_byte(protocol >> 8, &offset));
-		send_off = ppp_send_bytes(ppp, (u8_t *)&escaped + offset,
-					  offset ? 1 : 2,
-					  send_off);
+	if (protocol > 0) {
+		send_off = ppp_send_escaped(ppp, &fcs, (const u8_t *)&protocol,
+					    sizeof(protocol), send_off);
 	}
 
 	/* Note that we do not print the first four bytes and FCS bytes at the
@@ -536,32 +684,25 @@ static int ppp_send(struct device *dev, struct net_pkt *pkt)
 	}
 
 	while (buf) {
-		for (i = 0; i < buf->len; i++) {
-			/* Escape illegal bytes */
-			escaped = htons(ppp_escape_byte(buf->data[i], &offset));
-			send_off = ppp_send_bytes(ppp,
-						  (u8_t *)&escaped + offset,
-						  offset ? 1 : 2,
-						  send_off);
-		}
-
+		send_off = ppp_send_escaped(ppp, &fcs, buf->data, buf->len,
+					    send_off);
 		buf = buf->frags;
 	}
 
-	escaped = htons(ppp_escape_byte(fcs, &offset));
-	send_off = ppp_send_bytes(ppp, (u8_t *)&escaped + offset,
-				  offset ? 1 : 2,
-				  send_off);
+	/* The FCS is sent least significant byte first */
+	fcs ^= 0xffff;
+	fcs_bytes[0] = fcs;
+	fcs_bytes[1] = fcs >> 8;
 
-	escaped = htons(ppp_escape_byte(fcs >> 8, &offset));
-	send_off = ppp_send_bytes(ppp, (u8_t *)&escaped + offset,
-				  offset ? 1 : 2,
-				  send_off);
+	send_off = ppp_send_escaped(ppp, NULL, fcs_bytes, sizeof(fcs_bytes),
+				    send_off);
 
 	byte = 0x7e;
 	send_off = ppp_send_bytes(ppp, &byte, 1, send_off);
 
-	(void)ppp_send_flush(ppp, send_off);
+	if (send_off > 0) {
+		(void)ppp_send_flush(ppp, send_off);
+	}
 
 	return 0;
 }
@@ -575,6 +716,11 @@ static int ppp_driver_init(struct device *dev)
 	ppp->pkt = NULL;
 	ppp_change_state(ppp, STATE_HDLC_FRAME_START);
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+	ppp->send_buf = ppp->send_bufs[0];
+	k_sem_init(&ppp->tx_sem, 1, 1);
+#endif
+
 	return 0;
 }
 
@@ -632,7 +778,7 @@ use_random_mac:
 	 * own handling of UART. See tests/net/ppp/driver for details.
 	 */
 	if (!IS_ENABLED(CONFIG_NET_TEST)) {
-		uart_pipe_register(ppp->buf, sizeof(ppp->buf), ppp_recv_cb);
+		ppp_uart_start(ppp);
 	}
 }
 
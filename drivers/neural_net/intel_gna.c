@@ -48,6 +48,38 @@ static struct intel_gna_config_desc __aligned(GNA_PG_SIZE_IN_BYTES)
 static struct intel_gna_page_table __aligned(GNA_PG_SIZE_IN_BYTES)
 	gna_page_table[GNA_NUM_PG_TABLES_NEEDED];
 
+/* Starts the request at the head of the queue, if any. Called with the
+ * GNA interrupt blocked.
+ */
+static void intel_gna_start(struct intel_gna_data *gna)
+{
+	volatile struct intel_gna_regs *regs = gna->regs;
+	struct intel_gna_pending_req pending_req;
+	struct gna_model_header *header;
+	size_t input_size;
+
+	if (k_msgq_peek(&gna->request_queue, &pending_req) != 0) {
+		gna->state = GNA_STATE_IDLE;
+		return;
+	}
+
+	header = pending_req.model->model.header;
+	input_size = header->bytes_per_input * header->num_input_nodes;
+
+	/* copy input */
+	memcpy(pending_req.model->input, pending_req.input, input_size);
+	SOC_DCACHE_FLUSH(pending_req.model->input, input_size);
+
+	/* assign layer descriptor base address to configuration descriptor */
+	gna_config_desc.labase = (u32_t)pending_req.model->vabase;
+	gna_config_desc.lacnt = (u16_t)header->layer_count;
+	SOC_DCACHE_FLUSH(&gna_config_desc, sizeof(gna_config_desc));
+
+	gna->state = GNA_STATE_ACTIVE;
+	regs->gnactrl = (regs->gnactrl & ~GNA_CTRL_INTR_DISABLE) |
+		GNA_CTRL_ACCEL_START | GNA_CTRL_STATS_ENABLE_STALL;
+}
+
 static void intel_gna_interrupt_handler(struct device *dev)
 {
 	struct intel_gna_data *const gna = DEV_DATA(dev);
@@ -89,6 +121,7 @@ static void intel_gna_interrupt_handler(struct device *dev)
 		pending_resp.response.output = pending_req.output;
 		pending_resp.response.output_len = pending_req.output_len;
 		pending_resp.callback = pending_req.callback;
+		pending_resp.signal = pending_req.signal;
 
 		pending_resp.response.stats.cycles_per_sec = 200000000U;
 		if (regs->gnasts & GNA_STS_STATS_VALID) {
@@ -106,7 +139,9 @@ static void intel_gna_interrupt_handler(struct device *dev)
 
 	/* clear GNA operation and disable interrupt */
 	regs->gnactrl |= GNA_CTRL_INTR_DISABLE | GNA_CTRL_ABORT_CLEAR;
-	gna->state = GNA_STATE_IDLE;
+
+	/* keep the accelerator busy with the next pending request */
+	intel_gna_start(gna);
 }
 
 static void gna_work_handler(struct k_work *work)
@@ -115,7 +150,13 @@ static void gna_work_handler(struct k_work *work)
 	struct intel_gna_pending_resp resp;
 
 	while (k_msgq_get(&gna->response_queue, &resp, K_NO_WAIT) == 0) {
-		resp.callback(&resp.response);
+		if (resp.callback) {
+			resp.callback(&resp.response);
+		}
+
+		if (resp.signal) {
+			k_poll_signal_raise(resp.signal, resp.response.result);
+		}
 	}
 }
 
@@ -401,21 +442,25 @@ static int intel_gna_infer(struct device *dev, struct gna_inference_req *req,
 		gna_callback callback)
 {
 	struct intel_gna_data *const gna = DEV_DATA(dev);
-	volatile struct intel_gna_regs *regs = gna->regs;
 	struct intel_gna_pending_req pending_req;
 	struct gna_model_header *header;
 	struct intel_gna_model *handle;
-	struct gna_model_info *model;
-	size_t input_size;
+	unsigned int key;
 	int ret;
 
 	LOG_DBG("device %p", dev);
+	if ((gna->state != GNA_STATE_IDLE) &&
+			(gna->state != GNA_STATE_ACTIVE)) {
+		LOG_ERR("Invalid state (%u)", gna->state);
+		return -EINVAL;
+	}
+
 	if (req == NULL) {
 		LOG_ERR("Invalid request pointer");
 		return -EINVAL;
 	}
 
-	if (callback == NULL) {
+	if ((callback == NULL) && (req->signal == NULL)) {
 		LOG_ERR("Invalid callback function pointer");
 		return -EINVAL;
 	}
@@ -437,40 +482,33 @@ static int intel_gna_infer(struct device *dev, struct gna_inference_req *req,
 		return -EINVAL;
 	}
 
-	model = &handle->model;
-	header = model->header;
-	input_size = header->bytes_per_input * header->num_input_nodes;
+	header = handle->model.header;
 
 	pending_req.model = handle;
+	pending_req.input = req->input;
 	pending_req.output = req->output;
 	pending_req.output_len = header->bytes_per_output *
 		header->num_output_nodes;
 	pending_req.callback = callback;
+	pending_req.signal = req->signal;
+
+	/* requests complete in order: start this one right away only if
+	 * the accelerator is idle, else the interrupt handler will
+	 */
+	key = irq_lock();
 
 	ret = k_msgq_put(&gna->request_queue, &pending_req, K_NO_WAIT);
+	if ((ret == 0) && (gna->state == GNA_STATE_IDLE)) {
+		intel_gna_start(gna);
+	}
+
+	irq_unlock(key);
+
 	if (ret) {
 		LOG_ERR("Unable to queue request (code %d)", ret);
 		return ret;
 	}
 
-	if (gna->state != GNA_STATE_IDLE) {
-		/* multiple pending requests are not yet supported */
-		return -EBUSY;
-	}
-
-	/* copy input */
-	memcpy(handle->input, req->input, input_size);
-	SOC_DCACHE_FLUSH(handle->input, input_size);
-
-	/* assign layer descriptor base address to configuration descriptor */
-	gna_config_desc.labase = (u32_t)handle->vabase;
-	gna_config_desc.lacnt = (u16_t)header->layer_count;
-	SOC_DCACHE_FLUSH(&gna_config_desc, sizeof(gna_config_desc));
-
-	gna->state = GNA_STATE_ACTIVE;
-	regs->gnactrl = (regs->gnactrl & ~GNA_CTRL_INTR_DISABLE) |
-		GNA_CTRL_ACCEL_START | GNA_CTRL_STATS_ENABLE_STALL;
-
 	return 0;
 }
 
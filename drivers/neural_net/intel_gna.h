@@ -163,14 +163,17 @@ struct intel_gna_model {
 
 struct intel_gna_pending_req {
 	struct intel_gna_model	*model;
+	void			*input;
 	void			*output;
 	size_t			output_len;
 	gna_callback		callback;
+	struct k_poll_signal	*signal;
 };
 
 struct intel_gna_pending_resp {
 	struct gna_inference_resp	response;
 	gna_callback			callback;
+	struct k_poll_signal		*signal;
 };
 
 enum gna_state {
@@ -24,8 +24,7 @@ LOG_MODULE_REGISTER(LSM6DSL, CONFIG_SENSOR_LOG_LEVEL);
 static const u16_t lsm6dsl_odr_map[] = {0, 12, 26, 52, 104, 208, 416, 833,
 					1660, 3330, 6660};
 
-#if defined(LSM6DSL_ACCEL_ODR_RUNTIME) || defined(LSM6DSL_GYRO_ODR_RUNTIME)
-static int lsm6dsl_freq_to_odr_val(u16_t freq)
+int lsm6dsl_freq_to_odr_val(u16_t freq)
 {
 	size_t i;
 
@@ -37,7 +36,6 @@ static int lsm6dsl_freq_to_odr_val(u16_t freq)
 
 	return -EINVAL;
 }
-#endif
 
 static int lsm6dsl_odr_to_freq_val(u16_t odr)
 {
@@ -299,6 +297,12 @@ static int lsm6dsl_attr_set(struct device *dev, enum sensor_channel chan,
 			   enum sensor_attribute attr,
 			   const struct sensor_value *val)
 {
+#ifdef CONFIG_LSM6DSL_FIFO
+	if (attr == SENSOR_ATTR_FIFO_WATERMARK) {
+		return lsm6dsl_fifo_watermark_set(dev, val->val1);
+	}
+#endif
+
 	switch (chan) {
 	case SENSOR_CHAN_ACCEL_XYZ:
 		return lsm6dsl_accel_config(dev, chan, attr, val);
@@ -699,6 +703,9 @@ static const struct sensor_driver_api lsm6dsl_api_funcs = {
 	.trigger_set = lsm6dsl_trigger_set,
 #endif
 	.sample_fetch = lsm6dsl_sample_fetch,
+#ifdef CONFIG_LSM6DSL_FIFO
+	.fifo_read = lsm6dsl_fifo_read,
+#endif
 	.channel_get = lsm6dsl_channel_get,
 };
 
@@ -70,8 +70,8 @@
 #define LSM6DSL_SHIFT_FIFO_CTRL4_DEC_DS3_FIFO		0
 
 #define LSM6DSL_REG_FIFO_CTRL5				0x0A
-#define LSM6DSL_MASK_FIFO_CTRL5_ODR_FIFO		(BIT(5) | BIT(4) | \
-							 BIT(3))
+#define LSM6DSL_MASK_FIFO_CTRL5_ODR_FIFO		(BIT(6) | BIT(5) | \
+							 BIT(4) | BIT(3))
 #define LSM6DSL_SHIFT_FIFO_CTRL5_ODR_FIFO		3
 #define LSM6DSL_MASK_FIFO_CTRL5_FIFO_MODE		(BIT(2) | BIT(1) | \
 							 BIT(0))
@@ -665,11 +665,16 @@ struct lsm6dsl_data {
 	struct device *dev;
 #endif
 
+#ifdef CONFIG_LSM6DSL_FIFO
+	/* watermark in samples, a sample is one gyro and one accel set */
+	u16_t fifo_watermark;
+#endif
 #endif /* CONFIG_LSM6DSL_TRIGGER */
 };
 
 int lsm6dsl_spi_init(struct device *dev);
 int lsm6dsl_i2c_init(struct device *dev);
+int lsm6dsl_freq_to_odr_val(u16_t freq);
 #if defined(CONFIG_LSM6DSL_SENSORHUB)
 int lsm6dsl_shub_init_external_chip(struct device *dev);
 int lsm6dsl_shub_read_external_chip(struct device *dev, u8_t *buf, u8_t len);
@@ -683,4 +688,11 @@ int lsm6dsl_trigger_set(struct device *dev,
 int lsm6dsl_init_interrupt(struct device *dev);
 #endif
 
+#ifdef CONFIG_LSM6DSL_FIFO
+int lsm6dsl_fifo_watermark_set(struct device *dev, u16_t samples);
+int lsm6dsl_fifo_enable(struct device *dev, bool enable);
+int lsm6dsl_fifo_read(struct device *dev, void *buf, size_t size,
+		      struct sensor_fifo_format *fmt);
+#endif
+
 #endif /* ZEPHYR_DRIVERS_SENSOR_LSM6DSL_LSM6DSL_H_ */
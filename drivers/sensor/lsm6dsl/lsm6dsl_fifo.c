@@ -0,0 +1,200 @@
+/* lsm6dsl_fifo.c - FIFO streaming support for LSM6DSL */
+
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <device.h>
+#include <drivers/sensor.h>
+#include <sys/util.h>
+#include <logging/log.h>
+#include "lsm6dsl.h"
+
+LOG_MODULE_DECLARE(LSM6DSL, CONFIG_SENSOR_LOG_LEVEL);
+
+/* A sample is the gyro X, Y, Z words followed by the accel X, Y, Z words */
+#define LSM6DSL_FIFO_SAMPLE_WORDS	6
+#define LSM6DSL_FIFO_SAMPLE_SIZE	(LSM6DSL_FIFO_SAMPLE_WORDS * 2)
+#define LSM6DSL_FIFO_MAX_WORDS		2047
+
+/* Largest burst of whole samples fitting the u8_t length of read_data */
+#define LSM6DSL_FIFO_CHUNK_SIZE		(20 * LSM6DSL_FIFO_SAMPLE_SIZE)
+
+#define LSM6DSL_FIFO_MODE_BYPASS	0
+#define LSM6DSL_FIFO_MODE_CONTINUOUS	6
+
+int lsm6dsl_fifo_watermark_set(struct device *dev, u16_t samples)
+{
+	struct lsm6dsl_data *data = dev->driver_data;
+	u32_t words = MIN((u32_t)samples * LSM6DSL_FIFO_SAMPLE_WORDS,
+			  LSM6DSL_FIFO_MAX_WORDS);
+
+	if (samples == 0) {
+		return -EINVAL;
+	}
+
+	if (data->hw_tf->update_reg(data, LSM6DSL_REG_FIFO_CTRL1,
+				    LSM6DSL_MASK_FIFO_CTRL1_FTH,
+				    words & 0xFF) < 0 ||
+	    data->hw_tf->update_reg(data, LSM6DSL_REG_FIFO_CTRL2,
+				    LSM6DSL_MASK_FIFO_CTRL2_FTH,
+				    words >> 8) < 0) {
+		LOG_DBG("failed to set FIFO watermark");
+		return -EIO;
+	}
+
+	data->fifo_watermark = samples;
+
+	return 0;
+}
+
+int lsm6dsl_fifo_enable(struct device *dev, bool enable)
+{
+	struct lsm6dsl_data *data = dev->driver_data;
+	u8_t mode = LSM6DSL_FIFO_MODE_BYPASS;
+	int odr = 0;
+
+	if (enable) {
+		/* Both sensors must be in the FIFO at the same rate for the
+		 * samples to hold one set of each.
+		 */
+		if (data->accel_freq != data->gyro_freq) {
+			LOG_ERR("FIFO needs equal accel and gyro rates");
+			return -ENOTSUP;
+		}
+
+		odr = lsm6dsl_freq_to_odr_val(data->accel_freq);
+		if (odr <= 0) {
+			return -EINVAL;
+		}
+
+		if (data->fifo_watermark == 0 &&
+		    lsm6dsl_fifo_watermark_set(dev, 1) < 0) {
+			return -EIO;
+		}
+
+		mode = LSM6DSL_FIFO_MODE_CONTINUOUS;
+	}
+
+	/* Going through bypass mode also flushes the FIFO */
+	if (data->hw_tf->update_reg(data, LSM6DSL_REG_FIFO_CTRL5,
+				    LSM6DSL_MASK_FIFO_CTRL5_ODR_FIFO |
+				    LSM6DSL_MASK_FIFO_CTRL5_FIFO_MODE,
+				    LSM6DSL_FIFO_MODE_BYPASS) < 0) {
+		LOG_DBG("failed to set FIFO mode");
+		return -EIO;
+	}
+
+	if (data->hw_tf->update_reg(data, LSM6DSL_REG_FIFO_CTRL3,
+				    LSM6DSL_MASK_FIFO_CTRL3_DEC_FIFO_GYRO |
+				    LSM6DSL_MASK_FIFO_CTRL3_DEC_FIFO_XL,
+				    enable ?
+				    (1 << LSM6DSL_SHIFT_FIFO_CTRL3_DEC_FIFO_GYRO) |
+				    (1 << LSM6DSL_SHIFT_FIFO_CTRL3_DEC_FIFO_XL) :
+				    0) < 0) {
+		LOG_DBG("failed to set FIFO decimation");
+		return -EIO;
+	}
+
+	if (data->hw_tf->update_reg(data, LSM6DSL_REG_INT1_CTRL,
+				    LSM6DSL_MASK_INT1_FTH |
+				    LSM6DSL_MASK_INT1_CTRL_DRDY_XL |
+				    LSM6DSL_MASK_INT1_CTRL_DRDY_G,
+				    enable ? LSM6DSL_MASK_INT1_FTH :
+				    LSM6DSL_MASK_INT1_CTRL_DRDY_XL |
+				    LSM6DSL_MASK_INT1_CTRL_DRDY_G) < 0) {
+		LOG_DBG("failed to route FIFO interrupt");
+		return -EIO;
+	}
+
+	if (!enable) {
+		return 0;
+	}
+
+	if (data->hw_tf->update_reg(data, LSM6DSL_REG_FIFO_CTRL5,
+				    LSM6DSL_MASK_FIFO_CTRL5_ODR_FIFO |
+				    LSM6DSL_MASK_FIFO_CTRL5_FIFO_MODE,
+				    (odr << LSM6DSL_SHIFT_FIFO_CTRL5_ODR_FIFO) |
+				    (mode << LSM6DSL_SHIFT_FIFO_CTRL5_FIFO_MODE))
+	    < 0) {
+		LOG_DBG("failed to set FIFO mode");
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static void lsm6dsl_fifo_format(struct lsm6dsl_data *data,
+				struct sensor_fifo_format *fmt)
+{
+	/* micro-rad/s and micro-m/s^2 per LSB, in Q16.16 */
+	u32_t gyro_scale = data->gyro_sensitivity * SENSOR_PI / 180000.0 *
+			   65536.0;
+	u32_t accel_scale = data->accel_sensitivity * SENSOR_G / 1000.0 *
+			    65536.0;
+	int i;
+
+	fmt->words = LSM6DSL_FIFO_SAMPLE_WORDS;
+	for (i = 0; i < 3; i++) {
+		fmt->chan[i] = SENSOR_CHAN_GYRO_X + i;
+		fmt->scale[i] = gyro_scale;
+		fmt->chan[i + 3] = SENSOR_CHAN_ACCEL_X + i;
+		fmt->scale[i + 3] = accel_scale;
+	}
+}
+
+int lsm6dsl_fifo_read(struct device *dev, void *buf, size_t size,
+		      struct sensor_fifo_format *fmt)
+{
+	struct lsm6dsl_data *data = dev->driver_data;
+	u8_t status[4], skip[LSM6DSL_FIFO_SAMPLE_SIZE];
+	u8_t *dst = buf;
+	u16_t unread, pattern;
+	size_t len, chunk;
+
+	/* FIFO_STATUS1 to FIFO_STATUS4 */
+	if (data->hw_tf->read_data(data, LSM6DSL_REG_FIFO_STATUS1,
+				   status, sizeof(status)) < 0) {
+		LOG_DBG("failed to read FIFO status");
+		return -EIO;
+	}
+
+	if (status[1] & LSM6DSL_MASK_FIFO_STATUS2_OVER_RUN) {
+		LOG_WRN("FIFO overrun");
+	}
+
+	unread = status[0] |
+		 (status[1] & LSM6DSL_MASK_FIFO_STATUS2_DIFF_FIFO) << 8;
+	pattern = status[2] |
+		  (status[3] & LSM6DSL_MASK_FIFO_STATUS4_FIFO_PATTERN) << 8;
+
+	/* Drop the words of a partially read sample */
+	if (pattern != 0 && unread >= LSM6DSL_FIFO_SAMPLE_WORDS - pattern) {
+		len = (LSM6DSL_FIFO_SAMPLE_WORDS - pattern) * 2;
+		if (data->hw_tf->read_data(data, LSM6DSL_REG_FIFO_DATA_OUT_L,
+					   skip, len) < 0) {
+			return -EIO;
+		}
+		unread -= LSM6DSL_FIFO_SAMPLE_WORDS - pattern;
+	} else if (pattern != 0) {
+		unread = 0;
+	}
+
+	len = MIN(unread / LSM6DSL_FIFO_SAMPLE_WORDS,
+		  size / LSM6DSL_FIFO_SAMPLE_SIZE) * LSM6DSL_FIFO_SAMPLE_SIZE;
+
+	for (size_t i = 0; i < len; i += chunk) {
+		chunk = MIN(len - i, LSM6DSL_FIFO_CHUNK_SIZE);
+		if (data->hw_tf->read_data(data, LSM6DSL_REG_FIFO_DATA_OUT_L,
+					   dst + i, chunk) < 0) {
+			LOG_DBG("failed to read FIFO data");
+			return -EIO;
+		}
+	}
+
+	lsm6dsl_fifo_format(data, fmt);
+
+	return len;
+}
@@ -21,7 +21,12 @@ int lsm6dsl_trigger_set(struct device *dev,
 {
 	struct lsm6dsl_data *drv_data = dev->driver_data;
 
+#ifdef CONFIG_LSM6DSL_FIFO
+	__ASSERT_NO_MSG(trig->type == SENSOR_TRIG_DATA_READY ||
+			trig->type == SENSOR_TRIG_FIFO_WATERMARK);
+#else
 	__ASSERT_NO_MSG(trig->type == SENSOR_TRIG_DATA_READY);
+#endif
 
 	gpio_pin_disable_callback(drv_data->gpio, DT_INST_0_ST_LSM6DSL_IRQ_GPIOS_PIN);
 
@@ -30,6 +35,13 @@ int lsm6dsl_trigger_set(struct device *dev,
 		return 0;
 	}
 
+#ifdef CONFIG_LSM6DSL_FIFO
+	if (lsm6dsl_fifo_enable(dev,
+				trig->type == SENSOR_TRIG_FIFO_WATERMARK) < 0) {
+		return -EIO;
+	}
+#endif
+
 	drv_data->data_ready_trigger = *trig;
 
 	gpio_pin_enable_callback(drv_data->gpio, DT_INST_0_ST_LSM6DSL_IRQ_GPIOS_PIN);
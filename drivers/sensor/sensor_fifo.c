@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <drivers/sensor.h>
+#include <sys/byteorder.h>
+
+static bool chan_match(enum sensor_channel word_chan, enum sensor_channel chan)
+{
+	switch (chan) {
+	case SENSOR_CHAN_ACCEL_XYZ:
+	case SENSOR_CHAN_GYRO_XYZ:
+	case SENSOR_CHAN_MAGN_XYZ:
+		/* X, Y and Z channels precede the XYZ channel */
+		return word_chan >= chan - 3 && word_chan < chan;
+	default:
+		return word_chan == chan;
+	}
+}
+
+size_t sensor_fifo_decode(const struct sensor_fifo_format *fmt,
+			  const void *buf, size_t len,
+			  enum sensor_channel chan, s32_t *out, size_t max)
+{
+	const u8_t *sample = buf;
+	size_t sample_size = fmt->words * sizeof(u16_t);
+	u8_t offset[SENSOR_FIFO_MAX_WORDS];
+	u32_t scale[SENSOR_FIFO_MAX_WORDS];
+	size_t n = 0, words = 0;
+
+	/* Resolve the words of the channel once, so that the conversion
+	 * loop is a plain multiply and shift the compiler can unroll.
+	 */
+	for (size_t i = 0; i < fmt->words; i++) {
+		if (chan_match(fmt->chan[i], chan)) {
+			offset[words] = i * sizeof(u16_t);
+			scale[words] = fmt->scale[i];
+			words++;
+		}
+	}
+
+	if (words == 0 || sample_size == 0) {
+		return 0;
+	}
+
+	for (; len >= sample_size && n + words <= max;
+	     len -= sample_size, sample += sample_size) {
+		for (size_t i = 0; i < words; i++) {
+			s16_t raw = sys_get_le16(&sample[offset[i]]);
+
+			out[n++] = ((s64_t)raw * scale[i]) >> 16;
+		}
+	}
+
+	return n;
+}
@@ -22,6 +22,9 @@
 
 #include <linker/sections.h>
 #include <clock_control/stm32_clock_control.h>
+#ifdef CONFIG_UART_ASYNC_API
+#include <dt-bindings/dma/stm32_dma.h>
+#endif
 #include "uart_stm32.h"
 
 #include <logging/log.h>
@@ -604,17 +607,601 @@ static void uart_stm32_irq_callback_set(struct device *dev,
 	data->user_data = cb_data;
 }
 
+#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+
+#ifdef CONFIG_UART_ASYNC_API
+
+#ifdef USART_TDR_TDR
+#define UART_STM32_TX_REG(UartInstance) ((u32_t)&(UartInstance)->TDR)
+#define UART_STM32_RX_REG(UartInstance) ((u32_t)&(UartInstance)->RDR)
+#else
+#define UART_STM32_TX_REG(UartInstance) ((u32_t)&(UartInstance)->DR)
+#define UART_STM32_RX_REG(UartInstance) ((u32_t)&(UartInstance)->DR)
+#endif
+
+#define UART_STM32_DMA_DT(name, DIR)					\
+	{								\
+		.name = DT_UART_STM32_##name##_DMA_CONTROLLER_##DIR,	\
+		.channel = DT_UART_STM32_##name##_DMA_CHANNEL_##DIR,	\
+		.slot = DT_UART_STM32_##name##_DMA_SLOT_##DIR,		\
+		.channel_config =					\
+			DT_UART_STM32_##name##_DMA_CHANNEL_CONFIG_##DIR, \
+	}
+
+#define UART_STM32_DMA_MAP(name)					\
+	{								\
+		.base = DT_UART_STM32_##name##_BASE_ADDRESS,		\
+		.rx = UART_STM32_DMA_DT(name, RX),			\
+		.tx = UART_STM32_DMA_DT(name, TX),			\
+	},
+
+/* Ports with DMA channels in the device tree, the only ones able to
+ * provide the asynchronous API.
+ */
+static const struct uart_stm32_dma_map uart_stm32_dma_maps[] = {
+#if defined(CONFIG_UART_1) && defined(DT_UART_STM32_USART_1_DMA_CONTROLLER_RX)
+	UART_STM32_DMA_MAP(USART_1)
+#endif
+#if defined(CONFIG_UART_2) && defined(DT_UART_STM32_USART_2_DMA_CONTROLLER_RX)
+	UART_STM32_DMA_MAP(USART_2)
+#endif
+#if defined(CONFIG_UART_3) && defined(DT_UART_STM32_USART_3_DMA_CONTROLLER_RX)
+	UART_STM32_DMA_MAP(USART_3)
+#endif
+#if defined(CONFIG_UART_6) && defined(DT_UART_STM32_USART_6_DMA_CONTROLLER_RX)
+	UART_STM32_DMA_MAP(USART_6)
+#endif
+};
+
+static void uart_stm32_async_evt(struct uart_stm32_data *data,
+				 struct uart_event *evt)
+{
+	if (data->async_cb) {
+		data->async_cb(evt, data->async_user_data);
+	}
+}
+
+static void uart_stm32_notify_rx_processed(struct uart_stm32_data *data,
+					   size_t processed)
+{
+	struct uart_event evt = {
+		.type = UART_RX_RDY,
+		.data.rx = {
+			.buf = data->rx_buf,
+			.offset = data->rx_processed_len,
+			.len = processed - data->rx_processed_len,
+		},
+	};
+
+	if (processed == data->rx_processed_len) {
+		return;
+	}
+
+	data->rx_processed_len = processed;
+
+	uart_stm32_async_evt(data, &evt);
+}
+
+static void uart_stm32_rx_flush(struct uart_stm32_data *data)
+{
+	struct dma_status stat;
+	unsigned int key = irq_lock();
+
+	if (data->rx_len != 0U &&
+	    dma_get_status(data->dma_rx.dev, data->dma_rx.channel,
+			   &stat) == 0) {
+		uart_stm32_notify_rx_processed(data,
+					       data->rx_len -
+					       stat.pending_length);
+	}
+
+	irq_unlock(key);
+}
+
+static void uart_stm32_rx_hw_disable(USART_TypeDef *UartInstance)
+{
+	LL_USART_DisableDMAReq_RX(UartInstance);
+	LL_USART_DisableIT_IDLE(UartInstance);
+	LL_USART_DisableIT_ERROR(UartInstance);
+	LL_USART_DisableIT_PE(UartInstance);
+}
+
+static int uart_stm32_callback_set(struct device *dev,
+				   uart_callback_t callback,
+				   void *user_data)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+
+	data->async_cb = callback;
+	data->async_user_data = user_data;
+
+	return 0;
+}
+
+static void uart_stm32_dma_tx_cb(void *arg, u32_t channel, int status)
+{
+	struct device *dev = arg;
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	unsigned int key;
+
+	ARG_UNUSED(channel);
+
+	k_delayed_work_cancel(&data->tx_timeout_work);
+
+	key = irq_lock();
+
+	struct uart_event evt = {
+		.type = status < 0 ? UART_TX_ABORTED : UART_TX_DONE,
+		.data.tx = {
+			.buf = data->tx_buf,
+			.len = data->tx_len,
+		},
+	};
+
+	LL_USART_DisableDMAReq_TX(UartInstance);
+	data->tx_buf = NULL;
+	data->tx_len = 0U;
+
+	uart_stm32_async_evt(data, &evt);
+
+	irq_unlock(key);
+}
+
+static int uart_stm32_tx(struct device *dev, const u8_t *buf, size_t len,
+			 u32_t timeout)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	unsigned int key;
+	int ret;
+
+	if (data->dma_tx.dev == NULL) {
+		return -ENOTSUP;
+	}
+
+	/* The DMA data counter is 16 bits wide */
+	if (len == 0U || len > 0xFFFFU) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	if (data->tx_len != 0U) {
+		ret = -EBUSY;
+		goto out;
+	}
+
+	data->dma_tx.blk.source_address = (u32_t)buf;
+	data->dma_tx.blk.dest_address = UART_STM32_TX_REG(UartInstance);
+	data->dma_tx.blk.block_size = len;
+
+	ret = dma_config(data->dma_tx.dev, data->dma_tx.channel,
+			 &data->dma_tx.cfg);
+	if (ret < 0) {
+		goto out;
+	}
+
+	data->tx_buf = buf;
+	data->tx_len = len;
+
+	LL_USART_ClearFlag_TC(UartInstance);
+	LL_USART_EnableDMAReq_TX(UartInstance);
+
+	ret = dma_start(data->dma_tx.dev, data->dma_tx.channel);
+	if (ret < 0) {
+		LL_USART_DisableDMAReq_TX(UartInstance);
+		data->tx_buf = NULL;
+		data->tx_len = 0U;
+		goto out;
+	}
+
+	if ((s32_t)timeout != K_FOREVER) {
+		k_delayed_work_submit(&data->tx_timeout_work, timeout);
+	}
+
+out:
+	irq_unlock(key);
+	return ret;
+}
+
+static int uart_stm32_tx_halt(struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	struct dma_status stat;
+	unsigned int key = irq_lock();
+
+	if (data->tx_len == 0U) {
+		irq_unlock(key);
+		return -EFAULT;
+	}
+
+	struct uart_event evt = {
+		.type = UART_TX_ABORTED,
+		.data.tx = {
+			.buf = data->tx_buf,
+			.len = 0U,
+		},
+	};
+
+	LL_USART_DisableDMAReq_TX(UartInstance);
+
+	if (dma_get_status(data->dma_tx.dev, data->dma_tx.channel,
+			   &stat) == 0) {
+		evt.data.tx.len = data->tx_len - stat.pending_length;
+	}
+
+	dma_stop(data->dma_tx.dev, data->dma_tx.channel);
+
+	data->tx_buf = NULL;
+	data->tx_len = 0U;
+
+	uart_stm32_async_evt(data, &evt);
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+static int uart_stm32_tx_abort(struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+
+	if (data->dma_tx.dev == NULL) {
+		return -ENOTSUP;
+	}
+
+	k_delayed_work_cancel(&data->tx_timeout_work);
+
+	return uart_stm32_tx_halt(dev);
+}
+
+static void uart_stm32_tx_timeout(struct k_work *work)
+{
+	struct uart_stm32_data *data =
+		CONTAINER_OF(work, struct uart_stm32_data, tx_timeout_work);
+
+	uart_stm32_tx_halt(data->dev);
+}
+
+static int uart_stm32_rx_disable(struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	struct uart_event evt;
+	unsigned int key;
+
+	if (data->dma_rx.dev == NULL) {
+		return -ENOTSUP;
+	}
+
+	k_delayed_work_cancel(&data->rx_timeout_work);
+
+	key = irq_lock();
+
+	if (data->rx_len == 0U) {
+		irq_unlock(key);
+		return -EFAULT;
+	}
+
+	uart_stm32_rx_hw_disable(UartInstance);
+	uart_stm32_rx_flush(data);
+	dma_stop(data->dma_rx.dev, data->dma_rx.channel);
+
+	evt.type = UART_RX_BUF_RELEASED;
+
+	if (data->rx_next_len != 0U) {
+		evt.data.rx_buf.buf = data->rx_next_buf;
+		data->rx_next_buf = NULL;
+		data->rx_next_len = 0U;
+		uart_stm32_async_evt(data, &evt);
+	}
+
+	evt.data.rx_buf.buf = data->rx_buf;
+	data->rx_buf = NULL;
+	data->rx_len = 0U;
+	uart_stm32_async_evt(data, &evt);
+
+	evt.type = UART_RX_DISABLED;
+	uart_stm32_async_evt(data, &evt);
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+static void uart_stm32_dma_rx_cb(void *arg, u32_t channel, int status)
+{
+	struct device *dev = arg;
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	struct uart_event evt;
+	unsigned int key;
+
+	ARG_UNUSED(channel);
+
+	if (status < 0) {
+		LOG_ERR("RX DMA error %d", status);
+		uart_stm32_rx_disable(dev);
+		return;
+	}
+
+	key = irq_lock();
+
+	if (data->rx_len == 0U) {
+		irq_unlock(key);
+		return;
+	}
+
+	uart_stm32_notify_rx_processed(data, data->rx_len);
+
+	evt.type = UART_RX_BUF_RELEASED;
+	evt.data.rx_buf.buf = data->rx_buf;
+	uart_stm32_async_evt(data, &evt);
+
+	/* No next buffer, so reception ends */
+	if (data->rx_next_len == 0U) {
+		k_delayed_work_cancel(&data->rx_timeout_work);
+		uart_stm32_rx_hw_disable(UartInstance);
+		data->rx_buf = NULL;
+		data->rx_len = 0U;
+
+		evt.type = UART_RX_DISABLED;
+		uart_stm32_async_evt(data, &evt);
+
+		irq_unlock(key);
+		return;
+	}
+
+	data->rx_buf = data->rx_next_buf;
+	data->rx_len = data->rx_next_len;
+	data->rx_next_buf = NULL;
+	data->rx_next_len = 0U;
+	data->rx_processed_len = 0U;
+
+	/* The stream stopped at the end of the block, the data register
+	 * holds the next byte until the stream is restarted.
+	 */
+	dma_reload(data->dma_rx.dev, data->dma_rx.channel,
+		   UART_STM32_RX_REG(UartInstance), (u32_t)data->rx_buf,
+		   data->rx_len);
+	dma_start(data->dma_rx.dev, data->dma_rx.channel);
+
+	evt.type = UART_RX_BUF_REQUEST;
+	uart_stm32_async_evt(data, &evt);
+
+	irq_unlock(key);
+}
+
+static int uart_stm32_rx_enable(struct device *dev, u8_t *buf, size_t len,
+				u32_t timeout)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	struct uart_event evt = {
+		.type = UART_RX_BUF_REQUEST,
+	};
+	unsigned int key;
+	int ret;
+
+	if (data->dma_rx.dev == NULL) {
+		return -ENOTSUP;
+	}
+
+	if (len == 0U || len > 0xFFFFU) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	if (data->rx_len != 0U) {
+		ret = -EBUSY;
+		goto out;
+	}
+
+	data->dma_rx.blk.source_address = UART_STM32_RX_REG(UartInstance);
+	data->dma_rx.blk.dest_address = (u32_t)buf;
+	data->dma_rx.blk.block_size = len;
+
+	ret = dma_config(data->dma_rx.dev, data->dma_rx.channel,
+			 &data->dma_rx.cfg);
+	if (ret < 0) {
+		goto out;
+	}
+
+	data->rx_buf = buf;
+	data->rx_len = len;
+	data->rx_processed_len = 0U;
+	data->rx_timeout = timeout;
+
+	/* Start from a clean state, without stale errors or idle line */
+	(void)uart_stm32_err_check(dev);
+	LL_USART_ClearFlag_IDLE(UartInstance);
+
+	ret = dma_start(data->dma_rx.dev, data->dma_rx.channel);
+	if (ret < 0) {
+		data->rx_buf = NULL;
+		data->rx_len = 0U;
+		goto out;
+	}
+
+	LL_USART_EnableDMAReq_RX(UartInstance);
+	LL_USART_EnableIT_IDLE(UartInstance);
+	LL_USART_EnableIT_ERROR(UartInstance);
+	LL_USART_EnableIT_PE(UartInstance);
+
+	uart_stm32_async_evt(data, &evt);
+
+out:
+	irq_unlock(key);
+	return ret;
+}
+
+static int uart_stm32_rx_buf_rsp(struct device *dev, u8_t *buf, size_t len)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	unsigned int key;
+	int ret = 0;
+
+	if (len == 0U || len > 0xFFFFU) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	if (data->rx_len == 0U) {
+		ret = -EACCES;
+	} else if (data->rx_next_len != 0U) {
+		ret = -EBUSY;
+	} else {
+		data->rx_next_buf = buf;
+		data->rx_next_len = len;
+	}
+
+	irq_unlock(key);
+
+	return ret;
+}
+
+static void uart_stm32_rx_timeout(struct k_work *work)
+{
+	struct uart_stm32_data *data =
+		CONTAINER_OF(work, struct uart_stm32_data, rx_timeout_work);
+
+	uart_stm32_rx_flush(data);
+}
+
+/* Called from the ISR with reception active */
+static void uart_stm32_async_isr(struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+
+	if (LL_USART_IsEnabledIT_IDLE(UartInstance) &&
+	    LL_USART_IsActiveFlag_IDLE(UartInstance)) {
+		LL_USART_ClearFlag_IDLE(UartInstance);
+
+		/* The line went idle for a character time: report what the
+		 * DMA stored so far, at once or when the inactivity
+		 * timeout elapses.
+		 */
+		if (data->rx_timeout == K_NO_WAIT) {
+			uart_stm32_rx_flush(data);
+		} else if (data->rx_timeout != K_FOREVER) {
+			k_delayed_work_submit(&data->rx_timeout_work,
+					      data->rx_timeout);
+		}
+	}
+
+	if (LL_USART_IsActiveFlag_ORE(UartInstance) ||
+	    LL_USART_IsActiveFlag_PE(UartInstance) ||
+	    LL_USART_IsActiveFlag_FE(UartInstance)) {
+		struct uart_event evt = {
+			.type = UART_RX_STOPPED,
+			.data.rx_stop.reason = uart_stm32_err_check(dev),
+		};
+
+		uart_stm32_rx_flush(data);
+		evt.data.rx_stop.data.buf = data->rx_buf;
+		evt.data.rx_stop.data.offset = data->rx_processed_len;
+		uart_stm32_async_evt(data, &evt);
+
+		uart_stm32_rx_disable(dev);
+	}
+}
+
+static void uart_stm32_async_init(struct device *dev)
+{
+	const struct uart_stm32_config *config = DEV_CFG(dev);
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	const struct uart_stm32_dma_map *map = NULL;
+	struct device *rx_dev, *tx_dev;
+	int i;
+
+	data->dev = dev;
+
+	k_delayed_work_init(&data->tx_timeout_work, uart_stm32_tx_timeout);
+	k_delayed_work_init(&data->rx_timeout_work, uart_stm32_rx_timeout);
+
+	for (i = 0; i < ARRAY_SIZE(uart_stm32_dma_maps); i++) {
+		if (uart_stm32_dma_maps[i].base == (u32_t)config->uconf.base) {
+			map = &uart_stm32_dma_maps[i];
+			break;
+		}
+	}
+
+	if (map == NULL) {
+		/* Async API not available on this port */
+		return;
+	}
+
+	rx_dev = device_get_binding(map->rx.name);
+	tx_dev = device_get_binding(map->tx.name);
+	if (rx_dev == NULL || tx_dev == NULL) {
+		/* Keep the port usable without the async API */
+		LOG_ERR("DMA device not found");
+		return;
+	}
+
+	data->dma_rx.channel = map->rx.channel;
+	data->dma_rx.blk.source_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+	data->dma_rx.blk.dest_addr_adj = DMA_ADDR_ADJ_INCREMENT;
+	data->dma_rx.cfg.dma_slot = map->rx.slot;
+	data->dma_rx.cfg.channel_direction = PERIPHERAL_TO_MEMORY;
+	data->dma_rx.cfg.channel_priority =
+		STM32_DMA_CONFIG_PRIORITY(map->rx.channel_config);
+	data->dma_rx.cfg.dma_callback = uart_stm32_dma_rx_cb;
+
+	data->dma_tx.channel = map->tx.channel;
+	data->dma_tx.blk.source_addr_adj = DMA_ADDR_ADJ_INCREMENT;
+	data->dma_tx.blk.dest_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+	data->dma_tx.cfg.dma_slot = map->tx.slot;
+	data->dma_tx.cfg.channel_direction = MEMORY_TO_PERIPHERAL;
+	data->dma_tx.cfg.channel_priority =
+		STM32_DMA_CONFIG_PRIORITY(map->tx.channel_config);
+	data->dma_tx.cfg.dma_callback = uart_stm32_dma_tx_cb;
+
+	for (i = 0; i < 2; i++) {
+		struct uart_stm32_dma *dma = i ? &data->dma_tx : &data->dma_rx;
+
+		dma->cfg.source_data_size = 1U;
+		dma->cfg.dest_data_size = 1U;
+		dma->cfg.source_burst_length = 1U;
+		dma->cfg.dest_burst_length = 1U;
+		dma->cfg.block_count = 1U;
+		dma->cfg.head_block = &dma->blk;
+		dma->cfg.callback_arg = dev;
+	}
+
+	/* Async API is only enabled once the channels are set up */
+	data->dma_rx.dev = rx_dev;
+	data->dma_tx.dev = tx_dev;
+}
+
+#endif /* CONFIG_UART_ASYNC_API */
+
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
+
 static void uart_stm32_isr(void *arg)
 {
 	struct device *dev = arg;
 	struct uart_stm32_data *data = DEV_DATA(dev);
 
+#ifdef CONFIG_UART_INTERRUPT_DRIVEN
 	if (data->user_cb) {
 		data->user_cb(data->user_data);
 	}
+#endif
+
+#ifdef CONFIG_UART_ASYNC_API
+	if (data->rx_len != 0U) {
+		uart_stm32_async_isr(dev);
+	}
+#endif
 }
 
-#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+#endif /* CONFIG_UART_INTERRUPT_DRIVEN || CONFIG_UART_ASYNC_API */
 
 static const struct uart_driver_api uart_stm32_driver_api = {
 	.poll_in = uart_stm32_poll_in,
@@ -638,6 +1225,14 @@ static const struct uart_driver_api uart_stm32_driver_api = {
 	.irq_update = uart_stm32_irq_update,
 	.irq_callback_set = uart_stm32_irq_callback_set,
 #endif	/* CONFIG_UART_INTERRUPT_DRIVEN */
+#ifdef CONFIG_UART_ASYNC_API
+	.callback_set = uart_stm32_callback_set,
+	.tx = uart_stm32_tx,
+	.tx_abort = uart_stm32_tx_abort,
+	.rx_enable = uart_stm32_rx_enable,
+	.rx_buf_rsp = uart_stm32_rx_buf_rsp,
+	.rx_disable = uart_stm32_rx_disable,
+#endif	/* CONFIG_UART_ASYNC_API */
 };
 
 /**
@@ -696,14 +1291,18 @@ static int uart_stm32_init(struct device *dev)
 	}
 #endif /* !USART_ISR_REACK */
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef CONFIG_UART_ASYNC_API
+	uart_stm32_async_init(dev);
+#endif
+
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
 	config->uconf.irq_config_func(dev);
 #endif
 	return 0;
 }
 
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
 #define STM32_UART_IRQ_HANDLER_DECL(name)				\
 	static void uart_stm32_irq_config_func_##name(struct device *dev)
 #define STM32_UART_IRQ_HANDLER_FUNC(name)				\
@@ -12,6 +12,33 @@
 #ifndef ZEPHYR_DRIVERS_SERIAL_UART_STM32_H_
 #define ZEPHYR_DRIVERS_SERIAL_UART_STM32_H_
 
+#ifdef CONFIG_UART_ASYNC_API
+#include <drivers/dma.h>
+
+/* DMA channel of a port, from the device tree */
+struct uart_stm32_dma_dt {
+	const char *name;
+	u32_t channel;
+	u32_t slot;
+	u32_t channel_config;
+};
+
+struct uart_stm32_dma_map {
+	u32_t base;
+	struct uart_stm32_dma_dt rx;
+	struct uart_stm32_dma_dt tx;
+};
+
+/* DMA stream used by the asynchronous API */
+struct uart_stm32_dma {
+	const char *name;
+	struct device *dev;
+	u32_t channel;
+	struct dma_config cfg;
+	struct dma_block_config blk;
+};
+#endif
+
 /* device config */
 struct uart_stm32_config {
 	struct uart_device_config uconf;
@@ -31,6 +58,25 @@ struct uart_stm32_data {
 	uart_irq_callback_user_data_t user_cb;
 	void *user_data;
 #endif
+#ifdef CONFIG_UART_ASYNC_API
+	struct device *dev;
+	uart_callback_t async_cb;
+	void *async_user_data;
+
+	struct uart_stm32_dma dma_tx;
+	struct k_delayed_work tx_timeout_work;
+	const u8_t *tx_buf;
+	size_t tx_len;
+
+	struct uart_stm32_dma dma_rx;
+	struct k_delayed_work rx_timeout_work;
+	s32_t rx_timeout;
+	u8_t *rx_buf;
+	size_t rx_len;
+	size_t rx_processed_len;
+	u8_t *rx_next_buf;
+	size_t rx_next_len;
+#endif
 };
 
 #endif	/* ZEPHYR_DRIVERS_SERIAL_UART_STM32_H_ */
@@ -24,6 +24,24 @@ enum spi_ctx_runtime_op_mode {
 	SPI_CTX_RUNTIME_OP_MODE_SLAVE  = BIT(1),
 };
 
+#ifdef CONFIG_SPI_ASYNC_QUEUE
+/* Starts a transaction with the context locked, completing it with
+ * spi_context_complete(). Called from interrupt context for queued
+ * transactions.
+ */
+typedef int (*spi_context_start_t)(struct device *dev,
+				   const struct spi_config *config,
+				   const struct spi_buf_set *tx_bufs,
+				   const struct spi_buf_set *rx_bufs);
+
+struct spi_context_xfer {
+	const struct spi_config *config;
+	const struct spi_buf_set *tx_bufs;
+	const struct spi_buf_set *rx_bufs;
+	struct k_poll_signal *signal;
+};
+#endif /* CONFIG_SPI_ASYNC_QUEUE */
+
 struct spi_context {
 	const struct spi_config *config;
 
@@ -35,6 +53,13 @@ struct spi_context {
 	struct k_poll_signal *signal;
 	bool asynchronous;
 #endif /* CONFIG_SPI_ASYNC */
+#ifdef CONFIG_SPI_ASYNC_QUEUE
+	struct device *dev;
+	spi_context_start_t start;
+	struct spi_context_xfer queue[CONFIG_SPI_ASYNC_QUEUE_DEPTH];
+	u8_t queue_head;
+	u8_t queue_count;
+#endif /* CONFIG_SPI_ASYNC_QUEUE */
 	const struct spi_buf *current_tx;
 	size_t tx_count;
 	const struct spi_buf *current_rx;
@@ -67,6 +92,103 @@ static inline bool spi_context_is_slave(struct spi_context *ctx)
 	return (ctx->config->operation & SPI_OP_MODE_SLAVE);
 }
 
+static inline void _spi_context_cs_control(struct spi_context *ctx,
+					   bool on, bool force_off);
+
+#ifdef CONFIG_SPI_ASYNC_QUEUE
+static inline void spi_context_queue_init(struct spi_context *ctx,
+					  struct device *dev,
+					  spi_context_start_t start)
+{
+	ctx->dev = dev;
+	ctx->start = start;
+}
+
+/* Queue an asynchronous transaction if the context is locked, returns
+ * true if it was. Buffer sets must stay valid until completion.
+ */
+static inline bool spi_context_queue(struct spi_context *ctx,
+				     const struct spi_config *config,
+				     const struct spi_buf_set *tx_bufs,
+				     const struct spi_buf_set *rx_bufs,
+				     struct k_poll_signal *signal)
+{
+	unsigned int key = irq_lock();
+	bool queued = false;
+
+	/* The lock is only given back once the queue is empty */
+	if (ctx->start != NULL && k_sem_count_get(&ctx->lock) == 0U &&
+	    ctx->queue_count < CONFIG_SPI_ASYNC_QUEUE_DEPTH) {
+		struct spi_context_xfer *xfer =
+			&ctx->queue[(ctx->queue_head + ctx->queue_count) %
+				    CONFIG_SPI_ASYNC_QUEUE_DEPTH];
+
+		xfer->config = config;
+		xfer->tx_bufs = tx_bufs;
+		xfer->rx_bufs = rx_bufs;
+		xfer->signal = signal;
+		ctx->queue_count++;
+		queued = true;
+	}
+
+	irq_unlock(key);
+
+	return queued;
+}
+
+/* Next queued transaction is for the same device and configuration */
+static inline bool spi_context_queue_chained(struct spi_context *ctx)
+{
+	return ctx->queue_count != 0U &&
+	       ctx->queue[ctx->queue_head].config == ctx->config;
+}
+#endif /* CONFIG_SPI_ASYNC_QUEUE */
+
+/* Give the lock back, or hand it over to the next queued transaction */
+static inline void spi_context_unlock(struct spi_context *ctx)
+{
+#ifdef CONFIG_SPI_ASYNC_QUEUE
+	struct spi_context_xfer xfer;
+	unsigned int key;
+	int ret;
+
+	for (;;) {
+		key = irq_lock();
+
+		if (ctx->queue_count == 0U) {
+			k_sem_give(&ctx->lock);
+			irq_unlock(key);
+			return;
+		}
+
+		xfer = ctx->queue[ctx->queue_head];
+		ctx->queue_head = (ctx->queue_head + 1) %
+				  CONFIG_SPI_ASYNC_QUEUE_DEPTH;
+		ctx->queue_count--;
+
+		irq_unlock(key);
+
+		ctx->asynchronous = true;
+		ctx->signal = xfer.signal;
+
+		ret = ctx->start(ctx->dev, xfer.config, xfer.tx_bufs,
+				 xfer.rx_bufs);
+		if (ret == 0) {
+			return;
+		}
+
+		/* Chip select may have been held for this transaction */
+		_spi_context_cs_control(ctx, false, true);
+
+		if (xfer.signal) {
+			k_poll_signal_raise(xfer.signal, ret);
+		}
+	}
+#else
+	k_sem_give(&ctx->lock);
+#endif /* CONFIG_SPI_ASYNC_QUEUE */
+}
+
 static inline void spi_context_lock(struct spi_context *ctx,
 				    bool asynchronous,
 				    struct k_poll_signal *signal)
@@ -89,10 +211,10 @@ static inline void spi_context_release(struct spi_context *ctx, int status)
 
 #ifdef CONFIG_SPI_ASYNC
 	if (!ctx->asynchronous || (status < 0)) {
-		k_sem_give(&ctx->lock);
+		spi_context_unlock(ctx);
 	}
 #else
-	k_sem_give(&ctx->lock);
+	spi_context_unlock(ctx);
 #endif /* CONFIG_SPI_ASYNC */
 }
 
@@ -138,7 +260,7 @@ static inline void spi_context_complete(struct spi_context *ctx, int status)
 		}
 
 		if (!(ctx->config->operation & SPI_LOCK_ON)) {
-			k_sem_give(&ctx->lock);
+			spi_context_unlock(ctx);
 		}
 	}
 #else
@@ -193,6 +315,12 @@ static inline void _spi_context_cs_control(struct spi_context *ctx,
 				return;
 			}
 
+#ifdef CONFIG_SPI_ASYNC_QUEUE
+			if (!force_off && spi_context_queue_chained(ctx)) {
+				return;
+			}
+#endif /* CONFIG_SPI_ASYNC_QUEUE */
+
 			k_busy_wait(ctx->config->cs->delay);
 			gpio_pin_write(ctx->config->cs->gpio_dev,
 				       ctx->config->cs->gpio_pin,
@@ -212,7 +340,7 @@ static inline void spi_context_unlock_unconditionally(struct spi_context *ctx)
 	_spi_context_cs_control(ctx, false, true);
 
 	if (!k_sem_count_get(&ctx->lock)) {
-		k_sem_give(&ctx->lock);
+		spi_context_unlock(ctx);
 	}
 }
 
@@ -384,29 +384,16 @@ static int spi_stm32_release(struct device *dev,
 	return 0;
 }
 
-static int transceive(struct device *dev,
-		      const struct spi_config *config,
-		      const struct spi_buf_set *tx_bufs,
-		      const struct spi_buf_set *rx_bufs,
-		      bool asynchronous, struct k_poll_signal *signal)
+static int spi_stm32_start(struct device *dev,
+			   const struct spi_config *config,
+			   const struct spi_buf_set *tx_bufs,
+			   const struct spi_buf_set *rx_bufs)
 {
 	const struct spi_stm32_config *cfg = DEV_CFG(dev);
 	struct spi_stm32_data *data = DEV_DATA(dev);
 	SPI_TypeDef *spi = cfg->spi;
 	int ret;
 
-	if (!tx_bufs && !rx_bufs) {
-		return 0;
-	}
-
-#ifndef CONFIG_SPI_STM32_INTERRUPT
-	if (asynchronous) {
-		return -ENOTSUP;
-	}
-#endif
-
-	spi_context_lock(&data->ctx, asynchronous, signal);
-
 	ret = spi_stm32_configure(dev, config);
 	if (ret) {
 		return ret;
@@ -435,9 +422,43 @@ static int transceive(struct device *dev,
 	}
 
 	ll_func_enable_int_tx_empty(spi);
+#endif
+
+	return 0;
+}
 
+static int transceive(struct device *dev,
+		      const struct spi_config *config,
+		      const struct spi_buf_set *tx_bufs,
+		      const struct spi_buf_set *rx_bufs,
+		      bool asynchronous, struct k_poll_signal *signal)
+{
+	struct spi_stm32_data *data = DEV_DATA(dev);
+	int ret;
+
+	if (!tx_bufs && !rx_bufs) {
+		return 0;
+	}
+
+#ifndef CONFIG_SPI_STM32_INTERRUPT
+	if (asynchronous) {
+		return -ENOTSUP;
+	}
+#endif
+
+	spi_context_lock(&data->ctx, asynchronous, signal);
+
+	ret = spi_stm32_start(dev, config, tx_bufs, rx_bufs);
+	if (ret) {
+		spi_context_release(&data->ctx, ret);
+		return ret;
+	}
+
+#ifdef CONFIG_SPI_STM32_INTERRUPT
 	ret = spi_context_wait_for_completion(&data->ctx);
 #else
+	SPI_TypeDef *spi = DEV_CFG(dev)->spi;
+
 	do {
 		ret = spi_stm32_shift_frames(spi, data);
 	} while (!ret && spi_stm32_transfer_ongoing(data));
@@ -472,6 +493,14 @@ static int spi_stm32_transceive_async(struct device *dev,
 				      const struct spi_buf_set *rx_bufs,
 				      struct k_poll_signal *async)
 {
+#ifdef CONFIG_SPI_ASYNC_QUEUE
+	if ((tx_bufs || rx_bufs) &&
+	    spi_context_queue(&DEV_DATA(dev)->ctx, config, tx_bufs, rx_bufs,
+			      async)) {
+		return 0;
+	}
+#endif /* CONFIG_SPI_ASYNC_QUEUE */
+
 	return transceive(dev, config, tx_bufs, rx_bufs, true, async);
 }
 #endif /* CONFIG_SPI_ASYNC */
@@ -501,6 +530,10 @@ static int spi_stm32_init(struct device *dev)
 	cfg->irq_config(dev);
 #endif
 
+#if defined(CONFIG_SPI_ASYNC_QUEUE) && defined(CONFIG_SPI_STM32_INTERRUPT)
+	spi_context_queue_init(&data->ctx, dev, spi_stm32_start);
+#endif
+
 	spi_context_unlock_unconditionally(&data->ctx);
 
 	return 0;
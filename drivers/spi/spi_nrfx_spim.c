@@ -204,8 +204,32 @@ static void transfer_next_chunk(struct device *dev)
 
 	LOG_DBG("Transaction finished with status %d", error);
 
-	spi_context_complete(ctx, error);
+	/* Completion may start the next queued transaction */
 	dev_data->busy = false;
+	spi_context_complete(ctx, error);
+}
+
+static int transfer_start(struct device *dev,
+			  const struct spi_config *spi_cfg,
+			  const struct spi_buf_set *tx_bufs,
+			  const struct spi_buf_set *rx_bufs)
+{
+	struct spi_nrfx_data *dev_data = get_dev_data(dev);
+	int error;
+
+	error = configure(dev, spi_cfg);
+	if (error != 0) {
+		return error;
+	}
+
+	dev_data->busy = true;
+
+	spi_context_buffers_setup(&dev_data->ctx, tx_bufs, rx_bufs, 1);
+	spi_context_cs_control(&dev_data->ctx, true);
+
+	transfer_next_chunk(dev);
+
+	return 0;
 }
 
 static int transceive(struct device *dev,
@@ -216,15 +240,8 @@ static int transceive(struct device *dev,
 	struct spi_nrfx_data *dev_data = get_dev_data(dev);
 	int error;
 
-	error = configure(dev, spi_cfg);
+	error = transfer_start(dev, spi_cfg, tx_bufs, rx_bufs);
 	if (error == 0) {
-		dev_data->busy = true;
-
-		spi_context_buffers_setup(&dev_data->ctx, tx_bufs, rx_bufs, 1);
-		spi_context_cs_control(&dev_data->ctx, true);
-
-		transfer_next_chunk(dev);
-
 		error = spi_context_wait_for_completion(&dev_data->ctx);
 	}
 
@@ -249,6 +266,13 @@ static int spi_nrfx_transceive_async(struct device *dev,
 				     const struct spi_buf_set *rx_bufs,
 				     struct k_poll_signal *async)
 {
+#ifdef CONFIG_SPI_ASYNC_QUEUE
+	if (spi_context_queue(&get_dev_data(dev)->ctx, spi_cfg,
+			      tx_bufs, rx_bufs, async)) {
+		return 0;
+	}
+#endif /* CONFIG_SPI_ASYNC_QUEUE */
+
 	spi_context_lock(&get_dev_data(dev)->ctx, true, async);
 	return transceive(dev, spi_cfg, tx_bufs, rx_bufs);
 }
@@ -311,6 +335,9 @@ static int init_spim(struct device *dev)
 
 #ifdef CONFIG_DEVICE_POWER_MANAGEMENT
 	get_dev_data(dev)->pm_state = DEVICE_PM_ACTIVE_STATE;
+#endif
+#ifdef CONFIG_SPI_ASYNC_QUEUE
+	spi_context_queue_init(&get_dev_data(dev)->ctx, dev, transfer_start);
 #endif
 	spi_context_unlock_unconditionally(&get_dev_data(dev)->ctx);
 
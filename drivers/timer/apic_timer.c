@@ -8,7 +8,10 @@
 #include <spinlock.h>
 #include <drivers/interrupt_controller/loapic.h>
 
-BUILD_ASSERT_MSG(!IS_ENABLED(CONFIG_SMP), "APIC timer doesn't support SMP");
+BUILD_ASSERT_MSG(!IS_ENABLED(CONFIG_SMP) ||
+		 (IS_ENABLED(CONFIG_TICKLESS_KERNEL) &&
+		  IS_ENABLED(CONFIG_APIC_TIMER_TSC)),
+		 "APIC timer needs TICKLESS_KERNEL and APIC_TIMER_TSC for SMP");
 
 /*
  * Overview:
@@ -38,6 +41,16 @@ BUILD_ASSERT_MSG(!IS_ENABLED(CONFIG_SMP), "APIC timer doesn't support SMP");
  *     When CONFIG_APIC_TIMER_TSC=y, these are set to indicate the ratio of
  *     the TSC frequency to CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC. This can be
  *     found via CPUID 0x15 (n = EBX, m = EAX) on most CPUs.
+ *
+ * SMP:
+ *
+ * With CONFIG_SMP, every CPU runs its own local APIC timer, so that each
+ * one wakes up for its own next timeout or time slice end, without an IPI
+ * from the CPU driving the system clock. The timers are only used as
+ * one-shot alarms: the time base shared by all CPUs is the invariant TSC,
+ * which is why CONFIG_APIC_TIMER_TSC and CONFIG_TICKLESS_KERNEL are then
+ * required. Whichever CPU takes an alarm announces the ticks elapsed
+ * since the last announcement, made by any CPU.
  */
 
 /* These should be merged into include/drivers/interrupt_controller/loapic.h. */
@@ -71,10 +84,96 @@ BUILD_ASSERT_MSG(CYCLES_PER_TICK >= 2, "APIC timer: bad CYCLES_PER_TICK");
  */
 
 static struct k_spinlock lock;
+#ifndef CONFIG_SMP
 static u64_t total_cycles;
+#endif
 static u32_t cached_icr = CYCLES_PER_TICK;
 
-#ifdef CONFIG_TICKLESS_KERNEL
+#ifdef CONFIG_SMP
+
+static u64_t last_announcement;	/* last time any CPU announced, in cycles */
+static u32_t lvt_timer;		/* LVT timer setup, replicated on each CPU */
+
+static u64_t cycles_get(void)
+{
+	return (z_tsc_read() * CONFIG_APIC_TIMER_TSC_M) /
+		CONFIG_APIC_TIMER_TSC_N;
+}
+
+void z_clock_set_timeout(s32_t n, bool idle)
+{
+	ARG_UNUSED(idle);
+
+	u64_t now, deadline;
+	int   ticks;
+
+	if (n < 1) {
+		ticks = 1;
+	} else if ((n == K_FOREVER) || (n >= MAX_TICKS)) {
+		ticks = MAX_TICKS - 1;
+	} else {
+		ticks = n;
+	}
+
+	/*
+	 * The local APIC timer of the calling CPU is set to expire on the
+	 * tick boundary 'ticks' after the last announcement. A deadline
+	 * already passed fires right away.
+	 */
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	now = cycles_get();
+	deadline = last_announcement + (u64_t)ticks * CYCLES_PER_TICK;
+	x86_write_loapic(LOAPIC_TIMER_ICR,
+			 deadline > now ? (u32_t)(deadline - now) : 1U);
+
+	k_spin_unlock(&lock, key);
+}
+
+u32_t z_clock_elapsed(void)
+{
+	u32_t ticks;
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	ticks = (cycles_get() - last_announcement) / CYCLES_PER_TICK;
+	k_spin_unlock(&lock, key);
+
+	return ticks;
+}
+
+static void isr(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	s32_t ticks;
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	ticks = (cycles_get() - last_announcement) / CYCLES_PER_TICK;
+	last_announcement += (u64_t)ticks * CYCLES_PER_TICK;
+	k_spin_unlock(&lock, key);
+
+	/* Also re-arms the timer of this CPU for its next timeout, even
+	 * when another CPU already announced the ticks.
+	 */
+	z_clock_announce(ticks);
+}
+
+void smp_timer_init(void)
+{
+	u32_t val;
+
+	val = x86_read_loapic(LOAPIC_TIMER_CONFIG);	/* set divider */
+	val &= ~DCR_DIVIDER_MASK;
+	val |= DCR_DIVIDER;
+	x86_write_loapic(LOAPIC_TIMER_CONFIG, val);
+
+	/* same vector and one-shot mode as the timer of the boot CPU */
+	x86_write_loapic(LOAPIC_TIMER, lvt_timer);
+	x86_write_loapic(LOAPIC_TIMER_ICR, CYCLES_PER_TICK);
+}
+
+#elif defined(CONFIG_TICKLESS_KERNEL)
 
 static u64_t last_announcement;	/* last time we called z_clock_announce() */
 
@@ -236,5 +335,10 @@ int z_clock_driver_init(struct device *device)
 	x86_write_loapic(LOAPIC_TIMER_ICR, cached_icr);
 	irq_enable(CONFIG_APIC_TIMER_IRQ);
 
+#ifdef CONFIG_SMP
+	last_announcement = cycles_get();
+	lvt_timer = x86_read_loapic(LOAPIC_TIMER);
+#endif
+
 	return 0;
 }
@@ -4,22 +4,79 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <zephyr.h>
+#include <spinlock.h>
+#include <linker/section_tags.h>
 
 #include <drivers/video.h>
 
+#if defined(CONFIG_NET_BUF)
+#include <net/buf.h>
+#endif
+
+#if defined(CONFIG_VIDEO_BUFFER_POOL_NOCACHE)
+/* Fixed size blocks, filled by DMA without any cache maintenance */
+static u8_t __nocache __aligned(CONFIG_VIDEO_BUFFER_POOL_ALIGN)
+	video_buffer_mem[CONFIG_VIDEO_BUFFER_POOL_NUM_MAX]
+			[ROUND_UP(CONFIG_VIDEO_BUFFER_POOL_SZ_MAX,
+				  CONFIG_VIDEO_BUFFER_POOL_ALIGN)];
+static struct k_mem_slab video_buffer_slab;
+#else
 K_MEM_POOL_DEFINE(video_buffer_pool,
 		  CONFIG_VIDEO_BUFFER_POOL_ALIGN,
 		  CONFIG_VIDEO_BUFFER_POOL_SZ_MAX,
 		  CONFIG_VIDEO_BUFFER_POOL_NUM_MAX,
 		  CONFIG_VIDEO_BUFFER_POOL_ALIGN);
+#endif
 
 static struct video_buffer video_buf[CONFIG_VIDEO_BUFFER_POOL_NUM_MAX];
+static struct k_spinlock video_buf_lock;
+
+#if defined(CONFIG_VIDEO_BUFFER_POOL_USAGE)
+static struct video_buffer_pool_stats video_buf_stats;
+#endif
+
+static void *video_buffer_mem_alloc(size_t size)
+{
+#if defined(CONFIG_VIDEO_BUFFER_POOL_NOCACHE)
+	static bool slab_ready;
+	void *mem;
+
+	if (!slab_ready) {
+		k_mem_slab_init(&video_buffer_slab, video_buffer_mem,
+				sizeof(video_buffer_mem[0]),
+				CONFIG_VIDEO_BUFFER_POOL_NUM_MAX);
+		slab_ready = true;
+	}
+
+	if (size > sizeof(video_buffer_mem[0]) ||
+	    k_mem_slab_alloc(&video_buffer_slab, &mem, K_NO_WAIT) != 0) {
+		return NULL;
+	}
+
+	return mem;
+#else
+	return k_mem_pool_malloc(&video_buffer_pool, size);
+#endif
+}
+
+static void video_buffer_mem_free(void *mem)
+{
+#if defined(CONFIG_VIDEO_BUFFER_POOL_NOCACHE)
+	k_mem_slab_free(&video_buffer_slab, &mem);
+#else
+	k_free(mem);
+#endif
+}
 
 struct video_buffer *video_buffer_alloc(size_t size)
 {
 	struct video_buffer *vbuf = NULL;
+	k_spinlock_key_t key;
+	u8_t *mem;
 	int i;
 
+	key = k_spin_lock(&video_buf_lock);
+
 	/* find available video buffer */
 	for (i = 0; i < ARRAY_SIZE(video_buf); i++) {
 		if (video_buf[i].buffer == NULL) {
@@ -28,24 +85,128 @@ struct video_buffer *video_buffer_alloc(size_t size)
 		}
 	}
 
-	if (vbuf == NULL) {
-		return NULL;
-	}
-
 	/* Alloc buffer memory */
-	vbuf->buffer = k_mem_pool_malloc(&video_buffer_pool, size);
-	if (vbuf->buffer == NULL) {
+	mem = (vbuf != NULL) ? video_buffer_mem_alloc(size) : NULL;
+	if (mem == NULL) {
+#if defined(CONFIG_VIDEO_BUFFER_POOL_USAGE)
+		video_buf_stats.alloc_failures++;
+#endif
+		k_spin_unlock(&video_buf_lock, key);
 		return NULL;
 	}
 
+	vbuf->buffer = mem;
 	vbuf->size = size;
 	vbuf->bytesused = 0;
 
+#if defined(CONFIG_VIDEO_BUFFER_POOL_USAGE)
+	video_buf_stats.allocs++;
+	video_buf_stats.in_use++;
+	video_buf_stats.max_in_use = MAX(video_buf_stats.max_in_use,
+					 video_buf_stats.in_use);
+#endif
+
+	k_spin_unlock(&video_buf_lock, key);
+
 	return vbuf;
 }
 
 void video_buffer_release(struct video_buffer *vbuf)
 {
-	k_free(vbuf->buffer);
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&video_buf_lock);
+
+	video_buffer_mem_free(vbuf->buffer);
 	vbuf->buffer = NULL;
+
+#if defined(CONFIG_VIDEO_BUFFER_POOL_USAGE)
+	video_buf_stats.releases++;
+	video_buf_stats.in_use--;
+#endif
+
+	k_spin_unlock(&video_buf_lock, key);
+}
+
+#if defined(CONFIG_VIDEO_BUFFER_POOL_USAGE)
+void video_buffer_pool_stats_get(struct video_buffer_pool_stats *stats)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&video_buf_lock);
+	*stats = video_buf_stats;
+	k_spin_unlock(&video_buf_lock, key);
+}
+#endif
+
+#if defined(CONFIG_NET_BUF)
+BUILD_ASSERT_MSG(CONFIG_NET_BUF_USER_DATA_SIZE >= sizeof(struct video_buffer *),
+		 "net_buf user data too small to hold a video buffer");
+
+/* Network buffers referencing each video buffer, plus one held while
+ * wrapping so that a failure does not release the caller's frame.
+ */
+static atomic_t video_buf_refs[CONFIG_VIDEO_BUFFER_POOL_NUM_MAX];
+
+static void video_buffer_unref(struct video_buffer *vbuf)
+{
+	if (atomic_dec(&video_buf_refs[vbuf - video_buf]) == 1) {
+		video_buffer_release(vbuf);
+	}
+}
+
+void video_buffer_net_destroy(struct net_buf *buf)
+{
+	struct video_buffer *vbuf =
+		*(struct video_buffer **)net_buf_user_data(buf);
+
+	net_buf_destroy(buf);
+	video_buffer_unref(vbuf);
+}
+
+struct net_buf *video_buffer_net_wrap(struct net_buf_pool *pool,
+				      struct video_buffer *vbuf,
+				      s32_t timeout)
+{
+	atomic_t *refs = &video_buf_refs[vbuf - video_buf];
+	struct net_buf *head = NULL, *frag;
+	u32_t off, len;
+
+	__ASSERT(pool->destroy == video_buffer_net_destroy,
+		 "pool must use video_buffer_net_destroy");
+
+	if (vbuf->bytesused == 0) {
+		return NULL;
+	}
+
+	atomic_set(refs, 1);
+
+	/* A net_buf holds at most 64 KiB, larger frames become a chain */
+	for (off = 0; off < vbuf->bytesused; off += len) {
+		len = MIN(vbuf->bytesused - off, UINT16_MAX);
+
+		frag = net_buf_alloc_with_data(pool, vbuf->buffer + off, len,
+					       timeout);
+		if (frag == NULL) {
+			if (head != NULL) {
+				net_buf_unref(head);
+			}
+			return NULL;
+		}
+
+		atomic_inc(refs);
+		*(struct video_buffer **)net_buf_user_data(frag) = vbuf;
+
+		if (head == NULL) {
+			head = frag;
+		} else {
+			net_buf_frag_add(head, frag);
+		}
+	}
+
+	/* The frame now belongs to the network buffers */
+	atomic_dec(refs);
+
+	return head;
 }
+#endif /* CONFIG_NET_BUF */
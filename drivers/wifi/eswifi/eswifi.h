@@ -18,6 +18,11 @@
 
 #define MAX_DATA_SIZE 1600
 
+/* Largest payload of a single read or write command */
+#define ESWIFI_MAX_PAYLOAD_SIZE 1460
+
+#define ESWIFI_NO_SOCKET -1
+
 #define AT_OK_STR "\r\nOK\r\n> "
 #define AT_OK_STR_LEN 8
 #define AT_RSP_DELIMITER "\r\n"
@@ -76,6 +81,7 @@ struct eswifi_dev {
 	atomic_val_t mutex_owner;
 	unsigned int mutex_depth;
 	void *bus_data;
+	int selected_socket;
 	struct eswifi_off_socket socket[ESWIFI_OFFLOAD_MAX_SOCKETS];
 };
 
@@ -114,8 +120,18 @@ static inline void eswifi_unlock(struct eswifi_dev *eswifi)
 int eswifi_at_cmd(struct eswifi_dev *eswifi, char *cmd);
 static inline int __select_socket(struct eswifi_dev *eswifi, u8_t idx)
 {
+	int err;
+
+	/* The module keeps the selection until it is reset */
+	if (eswifi->selected_socket == idx) {
+		return 0;
+	}
+
 	snprintf(eswifi->buf, sizeof(eswifi->buf), "P0=%d\r", idx);
-	return eswifi_at_cmd(eswifi, eswifi->buf);
+	err = eswifi_at_cmd(eswifi, eswifi->buf);
+	eswifi->selected_socket = (err < 0) ? ESWIFI_NO_SOCKET : idx;
+
+	return err;
 }
 
 static inline
@@ -26,6 +26,8 @@ struct eswifi_spi_data {
 	struct device *spi_dev;
 	struct eswifi_gpio csn;
 	struct eswifi_gpio dr;
+	struct gpio_callback dr_cb;
+	struct k_sem dr_sem;
 	struct k_thread poll_thread;
 	struct spi_config spi_cfg;
 	struct spi_cs_control spi_cs;
@@ -42,16 +44,31 @@ static bool eswifi_spi_cmddata_ready(struct eswifi_spi_data *spi)
 	return value ? true : false;
 }
 
+static void eswifi_spi_dr_cb(struct device *dev, struct gpio_callback *cb,
+			     u32_t pins)
+{
+	struct eswifi_spi_data *spi =
+		CONTAINER_OF(cb, struct eswifi_spi_data, dr_cb);
+
+	k_sem_give(&spi->dr_sem);
+}
+
 static int eswifi_spi_wait_cmddata_ready(struct eswifi_spi_data *spi)
 {
 	unsigned int max_retries = 60 * 1000; /* 1 minute */
 
-	do {
-		/* allow other threads to be scheduled */
-		k_sleep(K_MSEC(1));
-	} while (!eswifi_spi_cmddata_ready(spi) && --max_retries);
+	/* The data-ready rising edge ends the wait early; the timeout keeps
+	 * polling working when the pin cannot interrupt.
+	 */
+	while (!eswifi_spi_cmddata_ready(spi)) {
+		if (!--max_retries) {
+			return -ETIMEDOUT;
+		}
 
-	return max_retries ? 0 : -ETIMEDOUT;
+		k_sem_take(&spi->dr_sem, K_MSEC(1));
+	}
+
+	return 0;
 }
 
 static int eswifi_spi_write(struct eswifi_dev *eswifi, char *data, size_t dlen)
@@ -245,7 +262,18 @@ int eswifi_spi_init(struct eswifi_dev *eswifi)
 		return -ENODEV;
 	}
 	spi->dr.pin = DT_INVENTEK_ESWIFI_ESWIFI0_DATA_GPIOS_PIN;
-	gpio_pin_configure(spi->dr.dev, spi->dr.pin, GPIO_DIR_IN);
+	k_sem_init(&spi->dr_sem, 0, 1);
+	if (gpio_pin_configure(spi->dr.dev, spi->dr.pin,
+			       GPIO_DIR_IN | GPIO_INT | GPIO_INT_EDGE |
+			       GPIO_INT_ACTIVE_HIGH) == 0) {
+		gpio_init_callback(&spi->dr_cb, eswifi_spi_dr_cb,
+				   BIT(spi->dr.pin));
+		gpio_add_callback(spi->dr.dev, &spi->dr_cb);
+		gpio_pin_enable_callback(spi->dr.dev, spi->dr.pin);
+	} else {
+		LOG_WRN("Data ready pin polled");
+		gpio_pin_configure(spi->dr.dev, spi->dr.pin, GPIO_DIR_IN);
+	}
 
 
 	/* SPI CONFIG/CS */
@@ -38,6 +38,8 @@ static struct eswifi_dev eswifi0; /* static instance */
 
 static int eswifi_reset(struct eswifi_dev *eswifi)
 {
+	eswifi->selected_socket = ESWIFI_NO_SOCKET;
+
 	gpio_pin_write(eswifi->resetn.dev, eswifi->resetn.pin, 0);
 	k_sleep(K_MSEC(10));
 	gpio_pin_write(eswifi->resetn.dev, eswifi->resetn.pin, 1);
@@ -632,6 +634,7 @@ static int eswifi_init(struct device *dev)
 	LOG_DBG("");
 
 	eswifi->role = ESWIFI_ROLE_CLIENT;
+	eswifi->selected_socket = ESWIFI_NO_SOCKET;
 	k_mutex_init(&eswifi->mutex);
 
 	eswifi->bus = &eswifi_bus_ops_spi;
@@ -47,6 +47,7 @@ struct eswifi_off_socket {
 	struct k_sem read_sem;
 	struct k_sem accept_sem;
 	u16_t port;
+	u16_t read_size;
 	bool is_server;
 	int usage;
 	struct k_fifo fifo;
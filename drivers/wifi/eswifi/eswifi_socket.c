@@ -33,13 +33,20 @@ static int __stop_socket(struct eswifi_dev *eswifi,
 	return eswifi_at_cmd(eswifi, socket->is_server ? cmd_srv : cmd_cli);
 }
 
-static int __read_data(struct eswifi_dev *eswifi, size_t len, char **data)
+static int __read_data(struct eswifi_dev *eswifi,
+		       struct eswifi_off_socket *socket, size_t len,
+		       char **data)
 {
 	char cmd[] = "R0\r";
 	char size[] = "R1=9999\r";
 	char timeout[] = "R2=30000\r";
 	int ret;
 
+	/* Both settings stick to the socket, skip them on later reads */
+	if (socket->read_size == len) {
+		goto read;
+	}
+
 	/* Set max read size */
 	snprintf(size, sizeof(size), "R1=%u\r", len);
 	ret = eswifi_at_cmd(eswifi, size);
@@ -56,6 +63,9 @@ static int __read_data(struct eswifi_dev *eswifi, size_t len, char **data)
 		return -EIO;
 	}
 
+	socket->read_size = len;
+
+read:
 	return eswifi_at_cmd_rsp(eswifi, cmd, data);
 }
 
@@ -87,6 +97,7 @@ static void eswifi_off_read_work(struct k_work *work)
 {
 	struct eswifi_off_socket *socket;
 	struct eswifi_dev *eswifi;
+	s32_t next = K_MSEC(500);
 	struct net_pkt *pkt;
 	int err, len;
 	char *data;
@@ -106,7 +117,7 @@ static void eswifi_off_read_work(struct k_work *work)
 
 	__select_socket(eswifi, socket->index);
 
-	len = __read_data(eswifi, 1460, &data); /* 1460 is max size */
+	len = __read_data(eswifi, socket, ESWIFI_MAX_PAYLOAD_SIZE, &data);
 	if (len < 0) {
 		__stop_socket(eswifi, socket);
 		goto done;
@@ -138,10 +149,12 @@ static void eswifi_off_read_work(struct k_work *work)
 	k_sem_give(&socket->read_sem);
 	k_yield();
 
+	/* More data is likely pending, only back off once drained */
+	next = K_NO_WAIT;
+
 done:
 	err = k_delayed_work_submit_to_queue(&eswifi->work_q,
-					     &socket->read_work,
-					     K_MSEC(500));
+					     &socket->read_work, next);
 	if (err) {
 		LOG_ERR("Rescheduling socket read error");
 	}
@@ -285,6 +298,7 @@ int __eswifi_socket_new(struct eswifi_dev *eswifi, int family, int type,
 	}
 
 	k_delayed_work_init(&socket->read_work, eswifi_off_read_work);
+	socket->read_size = 0;
 	socket->usage = 1;
 	LOG_DBG("Socket index %d", socket->index);
 
@@ -214,6 +214,9 @@ static ssize_t eswifi_socket_send(int sock, const void *buf, size_t len,
 
 	__select_socket(eswifi, socket->index);
 
+	/* Larger writes are left to the caller, as a short send */
+	len = MIN(len, ESWIFI_MAX_PAYLOAD_SIZE);
+
 	/* header */
 	snprintf(eswifi->buf, sizeof(eswifi->buf), "S3=%u\r", len);
 	offset = strlen(eswifi->buf);
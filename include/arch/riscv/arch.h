@@ -85,6 +85,64 @@ void z_irq_spurious(void *unused);
 })
 #endif
 
+#ifdef CONFIG_RISCV_VECTORED_MODE
+/* Vector table entries must not be compressed, to stay 4 bytes apart */
+#define ARCH_IRQ_VECTOR_JUMP_CODE(v) \
+	".option push\n\t.option norvc\n\tj " STRINGIFY(v) "\n\t.option pop"
+
+/*
+ * Direct interrupts are dispatched by the CPU from the vector table, so
+ * only local interrupts, whose mcause code is the IRQ line, can be direct.
+ * External interrupts all enter through the PLIC line.
+ */
+#define ARCH_IRQ_DIRECT_CONNECT(irq_p, priority_p, isr_p, flags_p) \
+({ \
+	BUILD_ASSERT_MSG(irq_p < RV_REGSIZE * 8, \
+			 "only local interrupts can be direct"); \
+	Z_ISR_DECLARE(irq_p, ISR_FLAG_DIRECT, isr_p, NULL); \
+	irq_p; \
+})
+
+#ifdef CONFIG_TRACING
+extern void sys_trace_isr_enter(void);
+extern void sys_trace_isr_exit(void);
+#endif
+
+static inline void arch_isr_direct_header(void)
+{
+#ifdef CONFIG_TRACING
+	sys_trace_isr_enter();
+#endif
+}
+
+static inline void arch_isr_direct_footer(int maybe_swap)
+{
+	ARG_UNUSED(maybe_swap);
+#ifdef CONFIG_TRACING
+	sys_trace_isr_exit();
+#endif
+}
+
+#define ARCH_ISR_DIRECT_HEADER() arch_isr_direct_header()
+#define ARCH_ISR_DIRECT_FOOTER(swap) arch_isr_direct_footer(swap)
+#define ARCH_ISR_DIRECT_PM() do { } while (false)
+
+/*
+ * The compiler saves the registers the handler uses and returns with mret.
+ * The handler runs on the interrupted stack and cannot reschedule: use
+ * regular interrupts for handlers which may make a thread ready.
+ */
+#define ARCH_ISR_DIRECT_DECLARE(name) \
+	static inline int name##_body(void); \
+	__attribute__ ((interrupt("machine"))) void name(void) \
+	{ \
+		ISR_DIRECT_HEADER(); \
+		name##_body(); \
+		ISR_DIRECT_FOOTER(0); \
+	} \
+	static inline int name##_body(void)
+#endif /* CONFIG_RISCV_VECTORED_MODE */
+
 /*
  * use atomic instruction csrrc to lock global irq
  * csrrc: atomic read and clear bits in CSR register
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Demand paging of code from a flash backing store on IA32
+ */
+
+#ifndef ZEPHYR_INCLUDE_ARCH_X86_IA32_DEMAND_PAGING_H_
+#define ZEPHYR_INCLUDE_ARCH_X86_IA32_DEMAND_PAGING_H_
+
+#include <zephyr/types.h>
+#include <toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Place a function in the demand paged code region
+ *
+ * The function is not loaded with the image, but read from the backing
+ * store into a RAM page frame the first time it runs. It must not run from
+ * an ISR or with interrupts locked, unless pinned beforehand.
+ */
+#define __paged_text Z_GENERIC_SECTION(.paged_text)
+
+/** Demand paging counters */
+struct x86_paging_stats {
+	/** Page faults served */
+	u32_t faults;
+	/** Pages read from the backing store */
+	u32_t page_ins;
+	/** Pages evicted to make room for others */
+	u32_t evictions;
+};
+
+/**
+ * @brief Load and pin paged code
+ *
+ * Reads the pages of the range which are not resident, and keeps them all
+ * resident until unpinned, so that hot code paths run without page faults.
+ * Pins nest.
+ *
+ * @param addr Start of the range, in the paged code region
+ * @param size Size of the range, in bytes
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the range is outside the paged code region
+ * @retval -ENOMEM if no page frame can be freed, all being pinned
+ * @retval -ENODEV if the backing store is not available
+ * @retval -EIO on backing store read errors
+ */
+int x86_paging_pin(void *addr, size_t size);
+
+/**
+ * @brief Unpin paged code
+ *
+ * @param addr Start of the range, as passed to x86_paging_pin()
+ * @param size Size of the range, as passed to x86_paging_pin()
+ */
+void x86_paging_unpin(void *addr, size_t size);
+
+/**
+ * @brief Get the demand paging counters
+ *
+ * @param stats Destination of the counters
+ */
+void x86_paging_stats_get(struct x86_paging_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ARCH_X86_IA32_DEMAND_PAGING_H_ */
@@ -25,6 +25,7 @@
 #include <bluetooth/gap.h>
 #include <bluetooth/addr.h>
 #include <bluetooth/crypto.h>
+#include <bluetooth/uuid.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -497,6 +498,43 @@ int bt_le_scan_start(const struct bt_le_scan_param *param, bt_le_scan_cb_t cb);
  */
 int bt_le_scan_stop(void);
 
+/** LE scan report filter */
+struct bt_le_scan_filter {
+	/** Only report this advertiser, or NULL to report any advertiser. */
+	const bt_addr_le_t *addr;
+
+	/** Only report advertisers listing this service UUID in their
+	 *  advertising data, or NULL to report any advertiser.
+	 */
+	const struct bt_uuid *uuid;
+
+	/** Apply @ref rssi_min. Reports without an RSSI value are then not
+	 *  reported either.
+	 */
+	bool use_rssi;
+
+	/** Do not report advertisers received below this RSSI (dBm). */
+	s8_t rssi_min;
+
+	/** Do not report data already reported for the same advertiser. */
+	bool dup;
+};
+
+/** @brief Set the host filter of the scan reports.
+ *
+ *  Set the filter applied to the advertising reports before they are
+ *  given to the callback of bt_le_scan_start(). The filter stays
+ *  in effect until it is changed or removed, also across scan
+ *  restarts. Setting the filter clears the cache of the duplicate filter.
+ *
+ *  Requires CONFIG_BT_SCAN_FILTER.
+ *
+ *  @param filter Filter to apply, or NULL to report every advertiser.
+ *
+ *  @return Zero on success or (negative) error code otherwise.
+ */
+int bt_le_scan_filter_set(const struct bt_le_scan_filter *filter);
+
 /** @brief Add device (LE) to whitelist.
  *
  *  Add peer device LE address to the whitelist.
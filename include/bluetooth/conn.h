@@ -194,6 +194,18 @@ struct bt_conn_info {
  */
 int bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info);
 
+/** @brief Set the weight of a connection for the outgoing ACL data.
+ *
+ *  With CONFIG_BT_CONN_TX_FAIR the connections are served in turn, and a
+ *  connection sends up to weight ACL packets at each turn.
+ *
+ *  @param conn Connection object.
+ *  @param weight Number of ACL packets per turn, at least 1.
+ *
+ *  @return Zero on success or (negative) error code on failure.
+ */
+int bt_conn_tx_weight_set(struct bt_conn *conn, u8_t weight);
+
 /** @brief Update the connection parameters.
  *
  *  @param conn Connection object.
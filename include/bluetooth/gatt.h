@@ -864,6 +864,27 @@ static inline int bt_gatt_notify(struct bt_conn *conn,
 	return bt_gatt_notify_cb(conn, &params);
 }
 
+/** @brief Notify multiple attribute value changes.
+ *
+ *  This function works in the same way as @ref bt_gatt_notify_cb for each
+ *  of the parameters, the attributes are looked up only once for all the
+ *  peers.
+ *
+ *  If the peer supports the Multiple Handle Value Notification, and
+ *  CONFIG_BT_GATT_NOTIFY_MULTIPLE is enabled, consecutive notifications
+ *  with the same callback and user data are sent in a single PDU as long
+ *  as they fit the ATT MTU. The callback is then called once for all of
+ *  them.
+ *
+ *  @param conn Connection object, or NULL to notify all the peers.
+ *  @param num_params Number of notification parameters.
+ *  @param params Array of notification parameters.
+ *
+ *  @return 0 in case of success or negative value in case of error.
+ */
+int bt_gatt_notify_multiple(struct bt_conn *conn, u16_t num_params,
+			    struct bt_gatt_notify_params *params);
+
 /** @typedef bt_gatt_indicate_func_t
  *  @brief Indication complete result callback.
  *
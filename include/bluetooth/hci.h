@@ -1467,6 +1467,7 @@ struct bt_hci_evt_le_conn_complete {
 } __packed;
 
 #define BT_HCI_EVT_LE_ADVERTISING_REPORT        0x02
+#define BT_HCI_LE_RSSI_NOT_AVAILABLE            0x7F
 struct bt_hci_evt_le_advertising_info {
 	u8_t         evt_type;
 	bt_addr_le_t addr;
@@ -138,6 +138,8 @@ struct bt_l2cap_le_chan {
 	/** Segment SDU packet from upper layer */
 	struct net_buf			*_sdu;
 	u16_t				_sdu_len;
+	/** Credits not given back to the peer yet */
+	atomic_t			_credits;
 
 	struct k_work			rx_work;
 	struct k_fifo			rx_queue;
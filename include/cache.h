@@ -14,6 +14,7 @@ extern "C" {
 #endif
 
 #define _sys_cache_flush_sig(x) void (x)(vaddr_t virt, size_t size)
+#define _sys_cache_data_range_sig(x) void (x)(void *addr, size_t size)
 
 #if defined(CONFIG_CACHE_FLUSHING)
 
@@ -24,12 +25,36 @@ extern "C" {
 	extern _sys_cache_flush_sig(sys_cache_flush);
 #endif
 
+/**
+ * @brief Write back a range of the data cache to memory
+ *
+ * Writes the dirty data cache lines covering the range back to memory,
+ * e.g. before a DMA transfer reads the buffer. The lines stay valid.
+ *
+ * @param addr Start of the range
+ * @param size Size of the range, in bytes
+ */
+extern _sys_cache_data_range_sig(sys_cache_data_range_flush);
+
+/**
+ * @brief Invalidate a range of the data cache
+ *
+ * Discards the data cache lines covering the range, without writing them
+ * back, so that the next reads fetch the memory, e.g. after a DMA transfer
+ * wrote the buffer. Data sharing a cache line with the range is discarded
+ * as well: buffers should be aligned on, and sized in, cache lines.
+ *
+ * @param addr Start of the range
+ * @param size Size of the range, in bytes
+ */
+extern _sys_cache_data_range_sig(sys_cache_data_range_invalidate);
+
 #else
 
 /*
  * Provide NOP APIs for systems that do not have caches.
  *
- * An example is the Cortex-M chips. However, the functions are provided so
+ * An example is most Cortex-M chips. However, the functions are provided so
  * that code that need to manipulate caches can be written in an
  * architecture-agnostic manner. The functions do nothing. The cache line size
  * value is always 0.
@@ -43,6 +68,22 @@ static inline _sys_cache_flush_sig(sys_cache_flush)
 	/* do nothing */
 }
 
+static inline _sys_cache_data_range_sig(sys_cache_data_range_flush)
+{
+	ARG_UNUSED(addr);
+	ARG_UNUSED(size);
+
+	/* do nothing */
+}
+
+static inline _sys_cache_data_range_sig(sys_cache_data_range_invalidate)
+{
+	ARG_UNUSED(addr);
+	ARG_UNUSED(size);
+
+	/* do nothing */
+}
+
 #endif /* CACHE_FLUSHING */
 
 #if defined(CONFIG_CACHE_LINE_SIZE_DETECT)
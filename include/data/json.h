@@ -11,6 +11,7 @@
 #include <stddef.h>
 #include <zephyr/types.h>
 #include <sys/types.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -675,6 +676,207 @@ int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
 		    const void *val, json_append_bytes_t append_bytes,
 		    void *data);
 
+/**
+ * @brief Token reported by the streaming parser.
+ *
+ * For JSON_TOK_STRING and JSON_TOK_NUMBER, @a start and @a len give the
+ * raw text of the token. Strings are reported without the quotes and
+ * with escape sequences left as they are. The text is not NUL terminated
+ * and is only valid during the callback: it points into the chunk given
+ * to json_stream_feed() or, if the token spans several chunks, into the
+ * token buffer of the parser.
+ */
+struct json_token {
+	/** JSON_TOK_OBJECT_START, JSON_TOK_OBJECT_END, JSON_TOK_LIST_START,
+	 * JSON_TOK_LIST_END, JSON_TOK_STRING, JSON_TOK_NUMBER, JSON_TOK_TRUE,
+	 * JSON_TOK_FALSE or JSON_TOK_NULL.
+	 */
+	enum json_tokens type;
+	/** Token is the key of an object member (JSON_TOK_STRING only) */
+	bool key;
+	/** Number of objects and arrays enclosing the token */
+	u8_t depth;
+	/** Text of the token */
+	const char *start;
+	/** Length of the text of the token */
+	size_t len;
+};
+
+/**
+ * @brief Callback receiving the tokens of the streaming parser.
+ *
+ * @param token Parsed token
+ * @param user_data User-provided pointer
+ *
+ * @return 0 to continue parsing, a negative value to abort it. The value
+ * is then returned by json_stream_feed().
+ */
+typedef int (*json_token_cb_t)(const struct json_token *token,
+			       void *user_data);
+
+/** Maximum nesting of objects and arrays of the streaming parser */
+#define JSON_STREAM_MAX_DEPTH 32
+
+/**
+ * @brief Streaming parser state.
+ *
+ * All fields are private, use json_stream_init() to initialize it.
+ */
+struct json_stream {
+	json_token_cb_t cb;
+	void *user_data;
+	char *tok_buf;
+	size_t tok_buf_size;
+	size_t tok_len;
+	u32_t obj_stack;
+	int err;
+	u8_t depth;
+	u8_t expect;
+	u8_t scan;
+	u8_t lit_pos;
+	bool key;
+	bool escape;
+	bool buffered;
+};
+
+/**
+ * @brief Initialize a streaming parser.
+ *
+ * The streaming parser validates a JSON document fed in chunks of any
+ * size, e.g. as they are received from a socket, and reports each token
+ * to a callback. The document is never stored as a whole: tokens are
+ * reported directly from the chunks and only the tokens which span
+ * several chunks are assembled in @p tok_buf.
+ *
+ * @param js Parser to initialize
+ * @param tok_buf Buffer for the strings and numbers split between chunks
+ * @param tok_buf_size Size of @p tok_buf, which limits the length of the
+ * strings and numbers of the document
+ * @param cb Callback receiving the tokens
+ * @param user_data Pointer passed to @p cb
+ */
+void json_stream_init(struct json_stream *js, char *tok_buf,
+		      size_t tok_buf_size, json_token_cb_t cb,
+		      void *user_data);
+
+/**
+ * @brief Feed a chunk of the document to a streaming parser.
+ *
+ * @param js Parser
+ * @param data Chunk of the document, which may be released on return
+ * @param len Length of the chunk
+ *
+ * @return 0 on success, -EINVAL if the document is invalid, -ENOMEM if a
+ * token does not fit in the token buffer or the document is nested too
+ * deeply, or the error returned by the callback. Errors are sticky.
+ */
+int json_stream_feed(struct json_stream *js, const char *data, size_t len);
+
+/**
+ * @brief Signal the end of the document to a streaming parser.
+ *
+ * @param js Parser
+ *
+ * @return 0 if a complete document has been parsed, a negative value
+ * otherwise.
+ */
+int json_stream_finish(struct json_stream *js);
+
+/**
+ * @brief Convert a JSON_TOK_NUMBER token to an integer.
+ *
+ * @param token Token reported by the streaming parser
+ * @param num Converted value
+ *
+ * @return 0 on success, -EINVAL if the number is not an integer, -ERANGE
+ * if it does not fit in an s32_t.
+ */
+int json_token_to_s32(const struct json_token *token, s32_t *num);
+
+/**
+ * @brief Callback receiving each object decoded by an object array stream.
+ *
+ * @param val Struct holding the decoded values. Strings point into the
+ * buffer of the stream and are only valid during the callback.
+ * @param decoded Bitmap of the decoded fields, as returned by
+ * json_obj_parse()
+ * @param user_data User-provided pointer
+ *
+ * @return 0 to continue parsing, a negative value to abort it.
+ */
+typedef int (*json_obj_cb_t)(void *val, s32_t decoded, void *user_data);
+
+/**
+ * @brief Object array stream state.
+ *
+ * All fields are private, use json_obj_array_stream_init() to
+ * initialize it.
+ */
+struct json_obj_array_stream {
+	struct json_stream stream;
+	const struct json_obj_descr *descr;
+	size_t descr_len;
+	void *val;
+	char *buf;
+	size_t buf_size;
+	size_t buf_used;
+	const struct json_obj_descr *field;
+	s32_t decoded;
+	json_obj_cb_t cb;
+	void *user_data;
+};
+
+/**
+ * @brief Initialize the decoding of a streamed array of objects.
+ *
+ * Decodes a document which is an array of objects, fed in chunks, one
+ * object at a time: each object is decoded into @p val according to
+ * @p descr and passed to @p cb before the next one is decoded. The memory
+ * needed does not depend on the number of objects, so documents larger
+ * than the available RAM can be decoded.
+ *
+ * Only the primitive fields (JSON_TOK_STRING, JSON_TOK_NUMBER and
+ * JSON_TOK_TRUE/JSON_TOK_FALSE) are supported. Members of the objects
+ * which are not in @p descr are skipped, whatever their type.
+ *
+ * @param s Stream to initialize
+ * @param descr Descriptor of the objects
+ * @param descr_len Number of elements in @p descr, less than 31
+ * @param val Struct receiving the values of an object
+ * @param buf Buffer for the strings of an object
+ * @param buf_size Size of @p buf
+ * @param cb Callback receiving each decoded object
+ * @param user_data Pointer passed to @p cb
+ *
+ * @return 0 on success, -EINVAL if @p descr is not supported.
+ */
+int json_obj_array_stream_init(struct json_obj_array_stream *s,
+			       const struct json_obj_descr *descr,
+			       size_t descr_len, void *val,
+			       char *buf, size_t buf_size,
+			       json_obj_cb_t cb, void *user_data);
+
+/**
+ * @brief Feed a chunk of the document to an object array stream.
+ *
+ * @see json_stream_feed()
+ */
+static inline int json_obj_array_stream_feed(struct json_obj_array_stream *s,
+					     const char *data, size_t len)
+{
+	return json_stream_feed(&s->stream, data, len);
+}
+
+/**
+ * @brief Signal the end of the document to an object array stream.
+ *
+ * @see json_stream_finish()
+ */
+static inline int json_obj_array_stream_finish(struct json_obj_array_stream *s)
+{
+	return json_stream_finish(&s->stream);
+}
+
 #ifdef __cplusplus
 }
 #endif
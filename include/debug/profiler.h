@@ -0,0 +1,64 @@
+/**
+ * @file debug/profiler.h
+ * Statistical sampling profiler
+ */
+
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_PROFILER_H_
+#define ZEPHYR_INCLUDE_DEBUG_PROFILER_H_
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Single profiler sample. */
+struct profiler_sample {
+	/** Program counter of the interrupted thread. 0 if an interrupt
+	 *  handler was interrupted.
+	 */
+	u32_t pc;
+	/** Link register (caller) of the interrupted thread or 0. */
+	u32_t lr;
+};
+
+/**
+ * @brief Start sampling.
+ *
+ * Previously collected samples are discarded. Sampling stops when
+ * CONFIG_PROFILER_SAMPLES are collected or when profiler_stop() is called.
+ */
+void profiler_start(void);
+
+/**
+ * @brief Stop sampling.
+ */
+void profiler_stop(void);
+
+/**
+ * @brief Get collected samples.
+ *
+ * @param samples Set to the array of samples.
+ *
+ * @return Number of collected samples.
+ */
+u32_t profiler_samples_get(const struct profiler_sample **samples);
+
+/**
+ * @brief Print collected samples using printk.
+ *
+ * Output is decoded on the host by scripts/profiler/profiler_decode.py.
+ */
+void profiler_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_PROFILER_H_ */
@@ -98,32 +98,30 @@ extern "C" {
  * @details The driver api is also set here, eliminating the need to do that
  * during initialization.
  */
-#ifndef CONFIG_DEVICE_POWER_MANAGEMENT
 #define DEVICE_AND_API_INIT(dev_name, drv_name, init_fn, data, cfg_info,  \
 			    level, prio, api)				  \
-	static struct device_config _CONCAT(__config_, dev_name) __used	  \
-	__attribute__((__section__(".devconfig.init"))) = {		  \
-		.name = drv_name, .init = (init_fn),			  \
-		.config_info = (cfg_info)				  \
-	};								  \
-	static Z_DECL_ALIGN(struct device) _CONCAT(__device_, dev_name) __used \
-	__attribute__((__section__(".init_" #level STRINGIFY(prio)))) = { \
-		.config = &_CONCAT(__config_, dev_name),		  \
-		.driver_api = api,					  \
-		.driver_data = data					  \
-	}
-#else
-/*
- * Use the default device_pm_control for devices that do not call the
- * DEVICE_DEFINE macro so that caller of hook functions
- * need not check device_pm_control != NULL.
- */
-#define DEVICE_AND_API_INIT(dev_name, drv_name, init_fn, data, cfg_info, \
-			    level, prio, api)				 \
-	DEVICE_DEFINE(dev_name, drv_name, init_fn,			 \
-		      device_pm_control_nop, data, cfg_info, level,	 \
-		      prio, api)
-#endif
+	Z_DEVICE_DEFINE(dev_name, drv_name, init_fn,			  \
+			device_pm_control_nop, data, cfg_info, level,	  \
+			prio, api, false)
+
+/**
+ * @def DEVICE_AND_API_INIT_ASYNC
+ *
+ * @brief Create device object whose initialization may run asynchronously
+ *
+ * @details Same as DEVICE_AND_API_INIT(), except that with
+ * CONFIG_DEVICE_INIT_ASYNC enabled the init function is run by a worker
+ * thread at the POST_KERNEL and APPLICATION levels, so that a slow driver
+ * does not hold up the rest of the boot. Users of the device that may run
+ * before main() must first call device_init_wait() on it.
+ *
+ * @copydetails DEVICE_AND_API_INIT
+ */
+#define DEVICE_AND_API_INIT_ASYNC(dev_name, drv_name, init_fn, data,	  \
+				  cfg_info, level, prio, api)		  \
+	Z_DEVICE_DEFINE(dev_name, drv_name, init_fn,			  \
+			device_pm_control_nop, data, cfg_info, level,	  \
+			prio, api, true)
 
 /**
  * @def DEVICE_DEFINE
@@ -137,14 +135,35 @@ extern "C" {
  * @param pm_control_fn Pointer to device_pm_control function.
  * Can be empty function (device_pm_control_nop) if not implemented.
  */
-#ifndef CONFIG_DEVICE_POWER_MANAGEMENT
 #define DEVICE_DEFINE(dev_name, drv_name, init_fn, pm_control_fn,	 \
 		      data, cfg_info, level, prio, api)			 \
-	DEVICE_AND_API_INIT(dev_name, drv_name, init_fn, data, cfg_info, \
-			    level, prio, api)
+	Z_DEVICE_DEFINE(dev_name, drv_name, init_fn, pm_control_fn,	 \
+			data, cfg_info, level, prio, api, false)
+
+#ifdef CONFIG_DEVICE_INIT_ASYNC
+#define Z_DEVICE_INIT_ASYNC(async) .init_async = (async),
+#else
+#define Z_DEVICE_INIT_ASYNC(async)
+#endif
+
+#ifndef CONFIG_DEVICE_POWER_MANAGEMENT
+#define Z_DEVICE_DEFINE(dev_name, drv_name, init_fn, pm_control_fn,	  \
+			data, cfg_info, level, prio, api, async)	  \
+	static struct device_config _CONCAT(__config_, dev_name) __used	  \
+	__attribute__((__section__(".devconfig.init"))) = {		  \
+		.name = drv_name, .init = (init_fn),			  \
+		Z_DEVICE_INIT_ASYNC(async)				  \
+		.config_info = (cfg_info)				  \
+	};								  \
+	static Z_DECL_ALIGN(struct device) _CONCAT(__device_, dev_name) __used \
+	__attribute__((__section__(".init_" #level STRINGIFY(prio)))) = { \
+		.config = &_CONCAT(__config_, dev_name),		  \
+		.driver_api = api,					  \
+		.driver_data = data					  \
+	}
 #else
-#define DEVICE_DEFINE(dev_name, drv_name, init_fn, pm_control_fn,	  \
-		      data, cfg_info, level, prio, api)			  \
+#define Z_DEVICE_DEFINE(dev_name, drv_name, init_fn, pm_control_fn,	  \
+			data, cfg_info, level, prio, api, async)	  \
 	static struct device_pm _CONCAT(__pm_, dev_name) __used           \
 							= {               \
 		.usage = ATOMIC_INIT(0),                                  \
@@ -161,6 +180,7 @@ extern "C" {
 		.name = drv_name, .init = (init_fn),			  \
 		.device_pm_control = (pm_control_fn),			  \
 		.pm  = &_CONCAT(__pm_, dev_name),                         \
+		Z_DEVICE_INIT_ASYNC(async)				  \
 		.config_info = (cfg_info)				  \
 	};								  \
 	static Z_DECL_ALIGN(struct device) _CONCAT(__device_, dev_name) __used \
@@ -224,6 +244,29 @@ struct device;
 typedef void (*device_pm_cb)(struct device *dev,
 			     int status, void *context, void *arg);
 
+struct device_pm_async;
+
+/**
+ * @brief Callback notifying the completion of device_pm_get_async()
+ *
+ * @param dev Device that was resumed
+ * @param status 0 if the device is active, negative errno code otherwise
+ * @param req Request passed to device_pm_get_async()
+ */
+typedef void (*device_pm_async_cb)(struct device *dev, int status,
+				   struct device_pm_async *req);
+
+/**
+ * @brief Asynchronous resume request
+ *
+ * Owned by the caller of device_pm_get_async() until its handler is
+ * called, typically embedded in the driver data.
+ */
+struct device_pm_async {
+	sys_snode_t node;
+	device_pm_async_cb handler;
+};
+
 /**
  * @brief Device PM info
  *
@@ -234,6 +277,14 @@ typedef void (*device_pm_cb)(struct device *dev,
  * @param fsm_state device idle internal power state
  * @param event event object to listen to the sync request events
  * @param signal signal to notify the Async API callers
+ * @param autosuspend_work work deferring the suspend after the last put
+ * @param autosuspend_delay delay in milliseconds before suspending
+ * @param notify_lock lock protecting the pending async resume requests
+ * @param notify pending async resume requests
+ * @param parent device which must be active while this device is
+ * @param parent_req async resume request of the parent
+ * @param parent_held parent usage count taken by this device
+ * @param parent_ready parent resumed for this device
  */
 struct device_pm {
 	struct device *dev;
@@ -244,6 +295,14 @@ struct device_pm {
 	struct k_work work;
 	struct k_poll_event event;
 	struct k_poll_signal signal;
+	struct k_delayed_work autosuspend_work;
+	u32_t autosuspend_delay;
+	struct k_spinlock notify_lock;
+	sys_slist_t notify;
+	struct device *parent;
+	struct device_pm_async parent_req;
+	bool parent_held;
+	bool parent_ready;
 };
 
 /**
@@ -252,6 +311,7 @@ struct device_pm {
  * @param name name of the device
  * @param init init function for the driver
  * @param config_info address of driver instance config information
+ * @param init_async true if init may run asynchronously
  */
 struct device_config {
 	const char *name;
@@ -260,6 +320,9 @@ struct device_config {
 	int (*device_pm_control)(struct device *device, u32_t command,
 				 void *context, device_pm_cb cb, void *arg);
 	struct device_pm *pm;
+#endif
+#ifdef CONFIG_DEVICE_INIT_ASYNC
+	bool init_async;
 #endif
 	const void *config_info;
 };
@@ -270,15 +333,48 @@ struct device_config {
  * @param driver_api pointer to structure containing the API functions for
  * the device type. This pointer is filled in by the driver at init time.
  * @param driver_data driver instance data. For driver use only
+ * @param init_state progress of the init function, see device_init_wait()
  */
 struct device {
 	struct device_config *config;
 	const void *driver_api;
 	void *driver_data;
+#ifdef CONFIG_DEVICE_INIT_ASYNC
+	atomic_t init_state;
+#endif
 };
 
 void z_sys_device_do_config_level(s32_t level);
 
+#ifdef CONFIG_DEVICE_INIT_ASYNC
+void z_sys_device_init_async_finish(void);
+
+/**
+ * @brief Wait for a device to be initialized
+ *
+ * @details With CONFIG_DEVICE_INIT_ASYNC, devices defined with
+ * DEVICE_AND_API_INIT_ASYNC() are initialized concurrently with the rest
+ * of the boot. Init functions and threads running before main() that
+ * depend on such a device must call this first. If the device's init
+ * function has not been started yet, it is run by the caller.
+ *
+ * The device's init level must have been reached.
+ *
+ * @param device Device to wait for
+ *
+ * @retval 0 The device is initialized.
+ * @retval -ENODEV The device's init function failed.
+ */
+int device_init_wait(struct device *device);
+#else
+static inline int device_init_wait(struct device *device)
+{
+	ARG_UNUSED(device);
+
+	return 0;
+}
+#endif
+
 /**
  * @brief Retrieve the device structure for a driver by name
  *
@@ -293,6 +389,34 @@ void z_sys_device_do_config_level(s32_t level);
  */
 __syscall struct device *device_get_binding(const char *name);
 
+/**
+ * @def DEVICE_GET_BINDING_ONCE
+ *
+ * @brief Retrieve the device structure for a driver by name, once per call site
+ *
+ * @details Behaves as device_get_binding(), but the device found is kept in
+ * a static variable of the call site: the device objects are only searched
+ * until the lookup first succeeds. Meant for code looking devices up
+ * repeatedly, e.g. in an ISR or in a function called for every transfer,
+ * with a name fixed at build time such as a devicetree label.
+ *
+ * The static variable lives in kernel memory, so this is not usable from
+ * user mode.
+ *
+ * @param name device name to search for.
+ *
+ * @return pointer to device structure; NULL if not found or cannot be used.
+ */
+#define DEVICE_GET_BINDING_ONCE(name)					\
+	({								\
+		static struct device *dev__;				\
+									\
+		if (dev__ == NULL) {					\
+			dev__ = device_get_binding(name);		\
+		}							\
+		dev__;							\
+	})
+
 /**
  * @}
  */
@@ -550,6 +674,23 @@ int device_pm_get(struct device *dev);
  */
 int device_pm_get_sync(struct device *dev);
 
+/**
+ * @brief Call device resume asynchronously with a completion callback
+ *
+ * Same as device_pm_get(), but the handler of @a req is called from the
+ * system work queue once the device is active, or failed to resume. This
+ * lets a driver start a transfer as soon as the device is powered without
+ * blocking on device_pm_get_sync().
+ *
+ * @param dev Pointer to device structure of the specific device driver
+ * the caller is interested in.
+ * @param req Request, with its handler set, which must remain valid
+ * until the handler is called.
+ * @retval 0 If successfully queued the Async request.
+ * @retval Errno Negative errno code if failure.
+ */
+int device_pm_get_async(struct device *dev, struct device_pm_async *req);
+
 /**
  * @brief Call device suspend asynchronously based on usage count
  *
@@ -580,13 +721,54 @@ int device_pm_put(struct device *dev);
  * @retval Errno Negative errno code if failure.
  */
 int device_pm_put_sync(struct device *dev);
+
+/**
+ * @brief Set the autosuspend delay of a device
+ *
+ * Once the usage count drops to zero through device_pm_put(), the
+ * device is only suspended if it is not used again within @a delay_ms.
+ * This avoids a suspend/resume cycle between bursts of requests to a
+ * device which is costly to bring up. device_pm_put_sync() still
+ * suspends the device immediately.
+ *
+ * @param dev Pointer to device structure of the specific device driver
+ * the caller is interested in.
+ * @param delay_ms Delay in milliseconds, 0 to suspend immediately.
+ */
+void device_pm_set_autosuspend_delay(struct device *dev, u32_t delay_ms);
+
+/**
+ * @brief Set the parent of a device
+ *
+ * The parent, e.g. the bus controller of the device, is resumed before
+ * the device is, and released once the device is suspended, so that the
+ * usage count of a bus follows the devices on it. If the parent fails to
+ * resume, the device is left suspended and the pending resume requests of
+ * the device fail with the error of the parent.
+ *
+ * Must be called before device_pm_enable().
+ *
+ * @param dev Pointer to device structure of the specific device driver
+ * the caller is interested in.
+ * @param parent Parent device, with device idle PM enabled.
+ */
+void device_pm_set_parent(struct device *dev, struct device *parent);
 #else
 static inline void device_pm_enable(struct device *dev) { }
 static inline void device_pm_disable(struct device *dev) { }
 static inline int device_pm_get(struct device *dev) { return -ENOTSUP; }
 static inline int device_pm_get_sync(struct device *dev) { return -ENOTSUP; }
+static inline int device_pm_get_async(struct device *dev,
+				      struct device_pm_async *req)
+{
+	return -ENOTSUP;
+}
 static inline int device_pm_put(struct device *dev) { return -ENOTSUP; }
 static inline int device_pm_put_sync(struct device *dev) { return -ENOTSUP; }
+static inline void device_pm_set_autosuspend_delay(struct device *dev,
+						   u32_t delay_ms) { }
+static inline void device_pm_set_parent(struct device *dev,
+					struct device *parent) { }
 #endif
 
 #endif
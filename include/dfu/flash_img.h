@@ -9,6 +9,12 @@
 #define ZEPHYR_INCLUDE_DFU_FLASH_IMG_H_
 
 #include <storage/flash_map.h>
+#ifdef CONFIG_IMG_ERASE_AHEAD
+#include <kernel.h>
+#endif
+#ifdef CONFIG_IMG_HASH_PROGRESSIVELY
+#include <tinycrypt/sha256.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,6 +28,17 @@ struct flash_img_context {
 #ifdef CONFIG_IMG_ERASE_PROGRESSIVELY
 	off_t off_last;
 #endif
+#ifdef CONFIG_IMG_ERASE_AHEAD
+	struct k_work erase_work;
+	/* Available when no background erase is pending */
+	struct k_sem erase_sem;
+	off_t erase_off;
+	size_t erase_size;
+	int erase_rc;
+#endif
+#ifdef CONFIG_IMG_HASH_PROGRESSIVELY
+	struct tc_sha256_state_struct sha256;
+#endif
 };
 
 /**
@@ -62,6 +79,22 @@ size_t flash_img_bytes_written(struct flash_img_context *ctx);
 int flash_img_buffered_write(struct flash_img_context *ctx, u8_t *data,
 		    size_t len, bool flush);
 
+#ifdef CONFIG_IMG_HASH_PROGRESSIVELY
+/**
+ * @brief Get the SHA-256 hash of the image written to the flash.
+ *
+ * The hash covers the bytes passed to flash_img_buffered_write(), without
+ * the padding of the last block. It must be called once, after the final
+ * flush.
+ *
+ * @param ctx context
+ * @param hash buffer receiving the TC_SHA256_DIGEST_SIZE bytes of the hash
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_hash_get(struct flash_img_context *ctx, u8_t *hash);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
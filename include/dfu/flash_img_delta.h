@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DFU_FLASH_IMG_DELTA_H_
+#define ZEPHYR_INCLUDE_DFU_FLASH_IMG_DELTA_H_
+
+#include <dfu/flash_img.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief Delta image writer
+ *
+ * Builds the new image in slot 1 from the image running in slot 0 and a
+ * patch, so that only the patch needs to be downloaded. The patch is
+ * processed as it arrives, in chunks of any size, using a fixed amount
+ * of RAM.
+ *
+ * The patch is an uncompressed bsdiff-style stream, all values being
+ * little endian:
+ *
+ * - header: u32_t magic (FLASH_IMG_DELTA_MAGIC), u32_t old image size,
+ *   u32_t new image size
+ * - records until the new image is complete, each made of:
+ *   - u32_t diff length, u32_t extra length, s32_t seek
+ *   - diff bytes, added to the bytes of the old image at the current old
+ *     offset, which then advances by the diff length
+ *   - extra bytes, copied as is
+ *   - the old offset then moves by seek bytes
+ *
+ * Being uncompressed, the patch is meant to be compressed by the transport
+ * or kept small by the diff tool; the diff bytes of similar images are
+ * mostly zero.
+ */
+
+#define FLASH_IMG_DELTA_MAGIC 0x31504444 /* "DDP1" */
+
+/** Size of a control record, or of the header, in the patch stream */
+#define FLASH_IMG_DELTA_CTRL_SIZE 12
+
+struct flash_img_delta_context {
+	struct flash_img_context *img;
+	const struct flash_area *source;
+	u8_t ctrl[FLASH_IMG_DELTA_CTRL_SIZE];
+	u8_t ctrl_len;
+	bool header_done;
+	u32_t diff_left;
+	u32_t extra_left;
+	s32_t seek;
+	off_t old_off;
+	size_t new_left;
+};
+
+/**
+ * @brief Initialize context needed for applying a patch.
+ *
+ * @param ctx context to be initialized
+ * @param img image writer, initialized with flash_img_init(), receiving
+ * the new image
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_delta_init(struct flash_img_delta_context *ctx,
+			 struct flash_img_context *img);
+
+/**
+ * @brief Process a chunk of the patch.
+ *
+ * Once the whole new image has been produced, it is flushed to the flash
+ * and any further patch data is rejected.
+ *
+ * @param ctx context
+ * @param data patch data
+ * @param len number of bytes of patch data
+ *
+ * @return  0 on success, -EINVAL on a malformed patch, other negative
+ * errno code on flash failure
+ */
+int flash_img_delta_write(struct flash_img_delta_context *ctx,
+			  const u8_t *data, size_t len);
+
+/**
+ * @brief Check whether the whole new image has been produced.
+ *
+ * @param ctx context
+ *
+ * @return true once the patch has been applied completely
+ */
+static inline bool flash_img_delta_done(struct flash_img_delta_context *ctx)
+{
+	return ctx->header_done && ctx->new_left == 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ZEPHYR_INCLUDE_DFU_FLASH_IMG_DELTA_H_ */
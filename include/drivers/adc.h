@@ -14,6 +14,7 @@
 #define ZEPHYR_INCLUDE_DRIVERS_ADC_H_
 
 #include <device.h>
+#include <errno.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -265,6 +266,51 @@ struct adc_sequence {
 	bool calibrate;
 };
 
+#ifdef CONFIG_ADC_STREAM
+/**
+ * @brief Type definition of the callback delivering a block of samples
+ *        of a continuous sampling stream.
+ *
+ * Called from the ADC interrupt context each time a block is full. The
+ * block remains untouched while the other block is being filled, so it
+ * must be consumed within one block period.
+ *
+ * @param dev        Pointer to the device structure for the driver instance.
+ * @param block      Block of samples, one of the stream buffers.
+ * @param size       Size of the block in bytes.
+ * @param user_data  User data provided in the stream configuration.
+ */
+typedef void (*adc_stream_callback_t)(struct device *dev, void *block,
+				      size_t size, void *user_data);
+
+/**
+ * @brief Structure defining a continuous sampling stream.
+ */
+struct adc_stream_config {
+	/**
+	 * Channels, resolution and oversampling of the samplings. Samplings
+	 * are taken every options->interval_us microseconds, the buffer and
+	 * the other options of the sequence are not used.
+	 */
+	const struct adc_sequence *sequence;
+
+	/**
+	 * Buffers filled alternately by the hardware, without a per sample
+	 * interrupt. Each holds a whole number of samplings.
+	 */
+	void *buffers[2];
+
+	/** Size of each buffer, in bytes. */
+	size_t block_size;
+
+	/** Callback invoked with each full buffer. */
+	adc_stream_callback_t callback;
+
+	/** User data passed to the callback. */
+	void *user_data;
+};
+#endif /* CONFIG_ADC_STREAM */
+
 
 /**
  * @brief Type definition of ADC API function for configuring a channel.
@@ -291,6 +337,21 @@ typedef int (*adc_api_read_async)(struct device *dev,
 				  struct k_poll_signal *async);
 #endif
 
+#ifdef CONFIG_ADC_STREAM
+/**
+ * @brief Type definition of ADC API function for starting a stream.
+ * See adc_stream_start() for argument descriptions.
+ */
+typedef int (*adc_api_stream_start)(struct device *dev,
+				    const struct adc_stream_config *config);
+
+/**
+ * @brief Type definition of ADC API function for stopping a stream.
+ * See adc_stream_stop() for argument descriptions.
+ */
+typedef int (*adc_api_stream_stop)(struct device *dev);
+#endif
+
 /**
  * @brief ADC driver API
  *
@@ -301,6 +362,10 @@ struct adc_driver_api {
 	adc_api_read          read;
 #ifdef CONFIG_ADC_ASYNC
 	adc_api_read_async    read_async;
+#endif
+#ifdef CONFIG_ADC_STREAM
+	adc_api_stream_start  stream_start;
+	adc_api_stream_stop   stream_stop;
 #endif
 	u16_t ref_internal;	/* mV */
 };
@@ -395,6 +460,59 @@ static inline int z_impl_adc_read_async(struct device *dev,
 }
 #endif /* CONFIG_ADC_ASYNC */
 
+#ifdef CONFIG_ADC_STREAM
+/**
+ * @brief Start continuous sampling into double buffers.
+ *
+ * The hardware fills the two buffers of @p config alternately, using DMA
+ * where the ADC supports it, and the callback is invoked once per full
+ * buffer instead of once per sampling. The ADC is reserved for the
+ * stream until adc_stream_stop() is called.
+ *
+ * @param dev     Pointer to the device structure for the driver instance.
+ * @param config  Stream configuration, must remain valid while streaming.
+ *
+ * @retval 0        On success.
+ * @retval -EINVAL  If a parameter with an invalid value has been provided.
+ * @retval -ENOTSUP If streaming, or the requested configuration, is not
+ *                  supported by the driver.
+ */
+static inline int adc_stream_start(struct device *dev,
+				   const struct adc_stream_config *config)
+{
+	const struct adc_driver_api *api =
+				(const struct adc_driver_api *)dev->driver_api;
+
+	if (api->stream_start == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->stream_start(dev, config);
+}
+
+/**
+ * @brief Stop continuous sampling.
+ *
+ * The block being filled is discarded.
+ *
+ * @param dev  Pointer to the device structure for the driver instance.
+ *
+ * @retval 0         On success.
+ * @retval -EALREADY If no stream is active.
+ */
+static inline int adc_stream_stop(struct device *dev)
+{
+	const struct adc_driver_api *api =
+				(const struct adc_driver_api *)dev->driver_api;
+
+	if (api->stream_stop == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->stream_stop(dev);
+}
+#endif /* CONFIG_ADC_STREAM */
+
 /**
  * @brief Get the internal reference voltage.
  *
@@ -148,6 +148,29 @@ typedef int (*display_write_api)(const struct device *dev, const u16_t x,
 				 const struct display_buffer_descriptor *desc,
 				 const void *buf);
 
+/**
+ * @typedef display_write_cb_t
+ * @brief Completion callback of display_write_async()
+ *
+ * @param dev Pointer to device structure
+ * @param status 0 on success else negative errno code
+ * @param user_data User data given to display_write_async()
+ */
+typedef void (*display_write_cb_t)(const struct device *dev, int status,
+				   void *user_data);
+
+/**
+ * @typedef display_write_async_api
+ * @brief Callback API for writing data to the display asynchronously
+ * See display_write_async() for argument description
+ */
+typedef int (*display_write_async_api)(const struct device *dev,
+				       const u16_t x, const u16_t y,
+				       const struct display_buffer_descriptor
+				       *desc,
+				       const void *buf, display_write_cb_t cb,
+				       void *user_data);
+
 /**
  * @typedef display_read_api
  * @brief Callback API for reading data from the display
@@ -223,6 +246,7 @@ struct display_driver_api {
 	display_get_capabilities_api get_capabilities;
 	display_set_pixel_format_api set_pixel_format;
 	display_set_orientation_api set_orientation;
+	display_write_async_api write_async;
 };
 
 /**
@@ -247,6 +271,51 @@ static inline int display_write(const struct device *dev, const u16_t x,
 	return api->write(dev, x, y, desc, buf);
 }
 
+/**
+ * @brief Write data to display without waiting for the transfer
+ *
+ * The buffer is handed to the driver until @a cb is called, which happens
+ * from a thread, typically the system work queue. Writes are performed in
+ * order; a write submitted while another is in progress waits for the
+ * bus. Drivers without support perform a synchronous write and call
+ * @a cb before returning.
+ *
+ * @param dev Pointer to device structure
+ * @param x x Coordinate of the upper left corner where to write the buffer
+ * @param y y Coordinate of the upper left corner where to write the buffer
+ * @param desc Pointer to a structure describing the buffer layout
+ * @param buf Pointer to buffer array
+ * @param cb Callback called once the buffer has been transferred
+ * @param user_data User data passed to @a cb
+ *
+ * @retval 0 if the write was started, @a cb is then always called.
+ * @retval negative errno code if it failed to start.
+ */
+static inline int display_write_async(const struct device *dev,
+				      const u16_t x, const u16_t y,
+				      const struct display_buffer_descriptor
+				      *desc,
+				      const void *buf, display_write_cb_t cb,
+				      void *user_data)
+{
+	struct display_driver_api *api =
+		(struct display_driver_api *)dev->driver_api;
+	int ret;
+
+	if (api->write_async != NULL) {
+		return api->write_async(dev, x, y, desc, buf, cb, user_data);
+	}
+
+	ret = api->write(dev, x, y, desc, buf);
+	if (ret < 0) {
+		return ret;
+	}
+
+	cb(dev, 0, user_data);
+
+	return 0;
+}
+
 /**
  * @brief Read data from display
  *
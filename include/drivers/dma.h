@@ -95,6 +95,11 @@ struct dma_block_config {
 	u16_t  reserved :          3;
 };
 
+/**
+ * @brief Callback status: half of the current block has been transferred.
+ */
+#define DMA_STATUS_HALF_COMPLETE 1
+
 /**
  * @brief DMA configuration structure.
  *
@@ -116,7 +121,14 @@ struct dma_block_config {
  *     dest_chaining_en     [ 18 ]      - enable/disable destination block
  *                                        chaining.
  *                                        0-disable, 1-enable
- *     reserved             [ 19 : 31 ]
+ *     cyclic               [ 19 ]      - 0-transfer ends after the last block
+ *                                        1-transfer restarts from the head
+ *                                          block after the last one, until
+ *                                          stopped
+ *     half_complete_callback_en [ 20 ] - 0-disable, 1-callback also invoked
+ *                                          with DMA_STATUS_HALF_COMPLETE when
+ *                                          half of a block is transferred
+ *     reserved             [ 21 : 31 ]
  *
  *     source_data_size    [ 0 : 15 ]   - width of source data (in bytes)
  *     dest_data_size      [ 16 : 31 ]  - width of dest data (in bytes)
@@ -124,13 +136,19 @@ struct dma_block_config {
  *     dest_burst_length   [ 16 : 31 ]  - number of destination data units
  *
  *     block_count  is the number of blocks used for block chaining, this
- *     depends on availability of the DMA controller.
+ *     depends on availability of the DMA controller. The blocks are linked
+ *     through next_block, as a scatter-gather list.
  *
  *     callback_arg  private argument from DMA client.
  *
  * dma_callback is the callback function pointer. If enabled, callback function
  *              will be invoked at transfer completion or when error happens
  *              (error_code: zero-transfer success, non zero-error happens).
+ *              A cyclic transfer never completes: the callback is invoked
+ *              with zero each time the last block, or each block when
+ *              complete_callback_en is set, is transferred, and with
+ *              DMA_STATUS_HALF_COMPLETE at the middle of each block when
+ *              half_complete_callback_en is set. Errors are negative.
  */
 struct dma_config {
 	u32_t  dma_slot :             6;
@@ -142,7 +160,9 @@ struct dma_config {
 	u32_t  channel_priority :     4;
 	u32_t  source_chaining_en :   1;
 	u32_t  dest_chaining_en :     1;
-	u32_t  reserved :            13;
+	u32_t  cyclic :               1;
+	u32_t  half_complete_callback_en : 1;
+	u32_t  reserved :            11;
 	u32_t  source_data_size :    16;
 	u32_t  dest_data_size :      16;
 	u32_t  source_burst_length : 16;
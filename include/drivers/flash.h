@@ -208,6 +208,53 @@ static inline int z_impl_flash_write_protection_set(struct device *dev,
 	return api->write_protection(dev, enable);
 }
 
+#if defined(CONFIG_FLASH_ASYNC)
+/**
+ *  @brief  Write buffer into flash memory asynchronously.
+ *
+ *  The write is queued and executed from a dedicated thread, which raises
+ *  @p async with the result of the write.
+ *
+ *  As for flash_write(), the write protection is not changed by this call:
+ *  the caller must disable it with flash_write_protection_set() and keep it
+ *  disabled until the completion is signaled.
+ *
+ *  The buffer must remain valid until the completion is signaled.
+ *
+ *  @param  dev             : flash device
+ *  @param  offset          : starting offset for the write
+ *  @param  data            : data to write
+ *  @param  len             : Number of bytes to write
+ *  @param  async           : Pointer to a valid and ready to be signaled
+ *                            struct k_poll_signal, or NULL if no
+ *                            notification is needed.
+ *
+ *  @return  0 if the request was queued, -ENOMEM if the request queue is
+ *           full.
+ */
+int flash_write_async(struct device *dev, off_t offset, const void *data,
+		      size_t len, struct k_poll_signal *async);
+
+/**
+ *  @brief  Erase part or all of a flash memory asynchronously.
+ *
+ *  Same as flash_erase(), but queued and executed from a dedicated thread in
+ *  the same manner as flash_write_async().
+ *
+ *  @param  dev             : flash device
+ *  @param  offset          : erase area starting offset
+ *  @param  size            : size of area to be erased
+ *  @param  async           : Pointer to a valid and ready to be signaled
+ *                            struct k_poll_signal, or NULL if no
+ *                            notification is needed.
+ *
+ *  @return  0 if the request was queued, -ENOMEM if the request queue is
+ *           full.
+ */
+int flash_erase_async(struct device *dev, off_t offset, size_t size,
+		      struct k_poll_signal *async);
+#endif /* CONFIG_FLASH_ASYNC */
+
 struct flash_pages_info {
 	off_t start_offset; /* offset from the base of flash address */
 	size_t size;
@@ -60,12 +60,21 @@ struct gna_model_info {
 
 /**
  * Request to perform inference on the given neural network model
+ *
+ * Requests are queued and run in order, on their own model. The input
+ * buffer is read when the request starts, and must remain valid until it
+ * completes.
  */
 struct gna_inference_req {
 	void *model_handle;
 	void *input;
 	void *output;
 	void *intermediate;
+	/**
+	 * Optional signal raised on completion, with the enum gna_result
+	 * as result, to wait for the request with k_poll(). NULL if unused.
+	 */
+	struct k_poll_signal *signal;
 };
 
 /**
@@ -193,9 +202,14 @@ static inline int gna_deregister_model(struct device *dev, void *model)
  * input data vector
  * A callback is provided for notification of inference completion
  *
+ * Up to CONFIG_INTEL_GNA_MAX_PENDING_REQUESTS requests, on any registered
+ * models, can be pending: they are run back to back, so that queueing the
+ * next request ahead keeps the accelerator busy.
+ *
  * @param dev Pointer to the device structure for the driver instance.
  * @param req Information required to perform inference on a neural network
- * @param callback A callback function to notify inference completion
+ * @param callback A callback function to notify inference completion,
+ *        optional if the request has a signal
  *
  * @retval 0 If the request is accepted
  * @retval A negative error code in case of a failure.
@@ -19,6 +19,7 @@
  * @{
  */
 
+#include <errno.h>
 #include <zephyr/types.h>
 #include <device.h>
 
@@ -163,6 +164,43 @@ struct i2c_slave_config {
 	const struct i2c_slave_callbacks *callbacks;
 };
 
+/**
+ * @brief I2C transaction completion callback.
+ *
+ * Called from the driver, possibly in interrupt context.
+ *
+ * @param dev I2C device the transaction was queued on.
+ * @param result 0 on success, negative errno code otherwise.
+ * @param user_data User data of the transaction.
+ */
+typedef void (*i2c_callback_t)(struct device *dev, int result,
+			       void *user_data);
+
+/**
+ * @brief Asynchronous I2C transaction.
+ *
+ * The transaction, its messages and their buffers must stay valid until
+ * the transaction completes.
+ */
+struct i2c_transaction {
+	/** Private, do not modify */
+	sys_snode_t node;
+	/** Array of messages to transfer */
+	struct i2c_msg *msgs;
+	/** Number of messages to transfer */
+	u8_t num_msgs;
+	/** Address of the I2C target device */
+	u16_t addr;
+	/** Completion callback, may be NULL */
+	i2c_callback_t callback;
+	/** User data passed to the callback */
+	void *user_data;
+#ifdef CONFIG_POLL
+	/** Signal raised with the result on completion, may be NULL */
+	struct k_poll_signal *signal;
+#endif
+};
+
 typedef int (*i2c_api_configure_t)(struct device *dev,
 				   u32_t dev_config);
 typedef int (*i2c_api_full_io_t)(struct device *dev,
@@ -173,12 +211,17 @@ typedef int (*i2c_api_slave_register_t)(struct device *dev,
 					struct i2c_slave_config *cfg);
 typedef int (*i2c_api_slave_unregister_t)(struct device *dev,
 					  struct i2c_slave_config *cfg);
+typedef int (*i2c_api_transfer_async_t)(struct device *dev,
+					struct i2c_transaction *txn);
 
 struct i2c_driver_api {
 	i2c_api_configure_t configure;
 	i2c_api_full_io_t transfer;
 	i2c_api_slave_register_t slave_register;
 	i2c_api_slave_unregister_t slave_unregister;
+#ifdef CONFIG_I2C_ASYNC_API
+	i2c_api_transfer_async_t transfer_async;
+#endif
 };
 
 typedef int (*i2c_slave_api_register_t)(struct device *dev);
@@ -252,6 +295,36 @@ static inline int z_impl_i2c_transfer(struct device *dev,
 	return api->transfer(dev, msgs, num_msgs, addr);
 }
 
+#ifdef CONFIG_I2C_ASYNC_API
+/**
+ * @brief Queue a data transfer to another I2C device.
+ *
+ * Same as i2c_transfer() but returns immediately. Transactions are queued
+ * per bus and performed in order, each one signals its completion with its
+ * callback and its poll signal. This allows a single thread to keep a bus
+ * busy with transactions to many devices.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param txn Transaction to queue.
+ *
+ * @retval 0 If the transaction was queued.
+ * @retval -EINVAL If the messages of the transaction are not supported.
+ * @retval -ENOTSUP If the driver does not support asynchronous transfers.
+ */
+static inline int i2c_transfer_async(struct device *dev,
+				     struct i2c_transaction *txn)
+{
+	const struct i2c_driver_api *api =
+		(const struct i2c_driver_api *)dev->driver_api;
+
+	if (api->transfer_async == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->transfer_async(dev, txn);
+}
+#endif /* CONFIG_I2C_ASYNC_API */
+
 /**
  * @brief Registers the provided config as Slave device
  *
@@ -199,6 +199,17 @@ typedef u8_t i2s_opt_t;
  */
 #define I2S_OPT_PINGPONG                    BIT(6)
 
+/** @brief Cyclic mode
+ *
+ * The DMA transfer runs continuously over a ring owned by the driver, and
+ * is never restarted between blocks: the memory blocks are copied to or
+ * from the half of the ring which is not in use. Instead of stopping the
+ * stream, a TX underrun plays silence and an RX overrun drops a block,
+ * both counted in the statistics returned by i2s_stats_get(). This avoids
+ * the jitter of restarting the DMA for every block at high sample rates.
+ */
+#define I2S_OPT_CYCLIC                      BIT(3)
+
 /**
  * @brief I2C Direction
  */
@@ -308,6 +319,17 @@ struct i2s_config {
 	s32_t timeout;
 };
 
+/**
+ * @brief Stream statistics
+ *
+ * @param blocks Number of memory blocks transmitted or received.
+ * @param xruns Number of TX underruns or RX overruns.
+ */
+struct i2s_stats {
+	u32_t blocks;
+	u32_t xruns;
+};
+
 /**
  * @cond INTERNAL_HIDDEN
  *
@@ -322,6 +344,8 @@ struct i2s_driver_api {
 	int (*write)(struct device *dev, void *mem_block, size_t size);
 	int (*trigger)(struct device *dev, enum i2s_dir dir,
 		       enum i2s_trigger_cmd cmd);
+	int (*stats_get)(struct device *dev, enum i2s_dir dir,
+			 struct i2s_stats *stats);
 };
 /**
  * @endcond
@@ -521,6 +545,31 @@ static inline int z_impl_i2s_trigger(struct device *dev, enum i2s_dir dir,
 	return api->trigger(dev, dir, cmd);
 }
 
+/**
+ * @brief Get the statistics of a stream.
+ *
+ * The counters are cleared when the stream is configured.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param dir Stream direction: RX or TX.
+ * @param stats Filled with the statistics of the stream.
+ *
+ * @retval 0 If successful.
+ * @retval -ENOTSUP If the driver does not keep statistics.
+ */
+static inline int i2s_stats_get(struct device *dev, enum i2s_dir dir,
+				struct i2s_stats *stats)
+{
+	const struct i2s_driver_api *api =
+		(const struct i2s_driver_api *)dev->driver_api;
+
+	if (api->stats_get == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->stats_get(dev, dir, stats);
+}
+
 /**
  * @}
  */
@@ -190,6 +190,13 @@ enum sensor_trigger_type {
 	/** Trigger fires when a double tap is detected. */
 	SENSOR_TRIG_DOUBLE_TAP,
 
+	/**
+	 * Trigger fires when the sensor FIFO holds at least the number of
+	 * samples configured via the @ref SENSOR_ATTR_FIFO_WATERMARK
+	 * attribute. Samples are read with sensor_fifo_read().
+	 */
+	SENSOR_TRIG_FIFO_WATERMARK,
+
 	/**
 	 * Number of all common sensor triggers.
 	 */
@@ -251,6 +258,8 @@ enum sensor_attribute {
 	 * algorithms to calibrate itself on a certain axis, or all of them.
 	 */
 	SENSOR_ATTR_CALIB_TARGET,
+	/** FIFO watermark, in samples. */
+	SENSOR_ATTR_FIFO_WATERMARK,
 
 	/**
 	 * Number of all common sensor attributes.
@@ -316,11 +325,45 @@ typedef int (*sensor_channel_get_t)(struct device *dev,
 				    enum sensor_channel chan,
 				    struct sensor_value *val);
 
+/** Maximum number of words in a FIFO sample */
+#define SENSOR_FIFO_MAX_WORDS 8
+
+/**
+ * @brief Layout of the raw data read by sensor_fifo_read().
+ *
+ * Raw data is a sequence of samples, each made of @a words signed 16-bit
+ * little endian words, e.g. the X, Y and Z axes of the gyroscope and of
+ * the accelerometer sampled at the same time.
+ */
+struct sensor_fifo_format {
+	/** Number of words in a sample */
+	u8_t words;
+	/** Channel of each word, a single axis channel for 3-axis sensors */
+	enum sensor_channel chan[SENSOR_FIFO_MAX_WORDS];
+	/**
+	 * Scale of each word, in millionths of the channel unit per LSB,
+	 * as a Q16.16 fixed point value.
+	 */
+	u32_t scale[SENSOR_FIFO_MAX_WORDS];
+};
+
+/**
+ * @typedef sensor_fifo_read_t
+ * @brief Callback API for reading raw samples from a sensor FIFO
+ *
+ * See sensor_fifo_read() for argument description
+ */
+typedef int (*sensor_fifo_read_t)(struct device *dev, void *buf, size_t size,
+				  struct sensor_fifo_format *fmt);
+
 struct sensor_driver_api {
 	sensor_attr_set_t attr_set;
 	sensor_trigger_set_t trigger_set;
 	sensor_sample_fetch_t sample_fetch;
 	sensor_channel_get_t channel_get;
+#ifdef CONFIG_SENSOR_FIFO
+	sensor_fifo_read_t fifo_read;
+#endif
 };
 
 /**
@@ -549,6 +592,59 @@ static inline void sensor_degrees_to_rad(s32_t d, struct sensor_value *rad)
 	rad->val2 = ((s64_t)d * SENSOR_PI / 180LL) % 1000000LL;
 }
 
+#ifdef CONFIG_SENSOR_FIFO
+/**
+ * @brief Read raw samples from the sensor FIFO
+ *
+ * Reads as many whole samples as available and fitting in @a buf, in a
+ * single bus transfer where possible. Samples are left in the raw format
+ * of the sensor, described in @a fmt, and converted on demand with
+ * sensor_fifo_decode(). This is typically called from the handler of a
+ * @ref SENSOR_TRIG_FIFO_WATERMARK trigger.
+ *
+ * @param dev Pointer to the sensor device
+ * @param buf Buffer for the raw samples
+ * @param size Size of @a buf in bytes
+ * @param fmt Layout of the raw samples, filled by the driver
+ *
+ * @return Number of bytes read if successful, negative errno code if
+ * failure.
+ */
+static inline int sensor_fifo_read(struct device *dev, void *buf,
+				   size_t size, struct sensor_fifo_format *fmt)
+{
+	const struct sensor_driver_api *api =
+		(const struct sensor_driver_api *)dev->driver_api;
+
+	if (api->fifo_read == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->fifo_read(dev, buf, size, fmt);
+}
+
+/**
+ * @brief Convert raw FIFO samples of a channel
+ *
+ * Values of @a chan are converted to millionths of the channel unit,
+ * e.g. micro-m/s^2 for acceleration, for all samples of @a buf at once.
+ * For a 3-axis channel, e.g. @ref SENSOR_CHAN_ACCEL_XYZ, the X, Y and Z
+ * values of each sample are stored consecutively.
+ *
+ * @param fmt Layout of the raw samples
+ * @param buf Raw samples read with sensor_fifo_read()
+ * @param len Size of the raw samples in bytes
+ * @param chan Channel to convert
+ * @param out Converted values
+ * @param max Maximum number of values to store in @a out
+ *
+ * @return Number of values stored in @a out.
+ */
+size_t sensor_fifo_decode(const struct sensor_fifo_format *fmt,
+			  const void *buf, size_t len,
+			  enum sensor_channel chan, s32_t *out, size_t max);
+#endif /* CONFIG_SENSOR_FIFO */
+
 /**
  * @brief Helper function for converting struct sensor_value to double.
  *
@@ -541,6 +541,70 @@ struct video_buffer *video_buffer_alloc(size_t size);
  */
 void video_buffer_release(struct video_buffer *buf);
 
+/**
+ * @brief video buffer pool usage statistics
+ *
+ * @param allocs is the number of successful allocations.
+ * @param alloc_failures is the number of allocations that found the pool
+ *        exhausted, a hint to raise CONFIG_VIDEO_BUFFER_POOL_NUM_MAX.
+ * @param releases is the number of released buffers.
+ * @param in_use is the number of buffers currently allocated.
+ * @param max_in_use is the highest number of buffers allocated at once.
+ */
+struct video_buffer_pool_stats {
+	u32_t allocs;
+	u32_t alloc_failures;
+	u32_t releases;
+	u16_t in_use;
+	u16_t max_in_use;
+};
+
+/**
+ * @brief Get video buffer pool usage statistics.
+ *
+ * Requires CONFIG_VIDEO_BUFFER_POOL_USAGE.
+ *
+ * @param stats Pointer to the structure to fill.
+ */
+void video_buffer_pool_stats_get(struct video_buffer_pool_stats *stats);
+
+struct net_buf;
+struct net_buf_pool;
+
+/**
+ * @brief Wrap a video buffer into network buffers without copy.
+ *
+ * The bytesused first bytes of the frame become the data of a chain of
+ * network buffers pointing into the video buffer, e.g. to be appended to
+ * a net_pkt. Ownership of @a buf moves to the network buffers: the video
+ * buffer is released once all of them have been unreferenced, and must
+ * not be enqueued again in the meantime.
+ *
+ * The network buffer pool needs no data storage and must be defined with
+ * video_buffer_net_destroy() as destroy callback, e.g.
+ * NET_BUF_POOL_FIXED_DEFINE(pool, count, 0, video_buffer_net_destroy).
+ *
+ * Requires CONFIG_NET_BUF.
+ *
+ * @param pool Pool to allocate the network buffers from.
+ * @param buf Pointer to the filled video buffer.
+ * @param timeout Timeout for each network buffer allocation.
+ *
+ * @retval pointer to the first network buffer of the chain
+ * @retval NULL if the network buffers could not be allocated, the video
+ *         buffer then still belongs to the caller.
+ */
+struct net_buf *video_buffer_net_wrap(struct net_buf_pool *pool,
+				      struct video_buffer *buf,
+				      s32_t timeout);
+
+/**
+ * @brief Destroy callback of network buffers wrapping video buffers.
+ *
+ * @param buf Network buffer being freed.
+ */
+void video_buffer_net_destroy(struct net_buf *buf);
+
 
 /* fourcc - four-character-code */
 #define video_fourcc(a, b, c, d)\
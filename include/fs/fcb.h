@@ -76,6 +76,19 @@ struct fcb_entry_ctx {
 	/**< Flash area where the entry is placed */
 };
 
+#ifdef CONFIG_FCB_ELEM_CACHE
+/**
+ * @brief Location of an element whose CRC has been verified, so that it
+ * can be iterated over without reading it back from flash.
+ */
+struct fcb_elem_cache_entry {
+	u32_t elem_off; /**< Element offset in sector, 0 if unused */
+	u16_t data_len; /**< Size of data area of the element */
+	u8_t sector; /**< Index of the sector in fcb->f_sectors */
+	u8_t hdr_len; /**< Length of the element header in flash */
+};
+#endif
+
 /**
  * @brief FCB instance structure
  *
@@ -121,6 +134,11 @@ struct fcb {
 	/**< Flash area used by the fcb instance, , internal state.
 	 * This can be transfer to FCB user
 	 */
+
+#ifdef CONFIG_FCB_ELEM_CACHE
+	struct fcb_elem_cache_entry f_elem_cache[CONFIG_FCB_ELEM_CACHE_SIZE];
+	/**< Verified element locations, internal state */
+#endif
 };
 
 /**
@@ -268,6 +268,49 @@ ssize_t fs_read(struct fs_file_t *zfp, void *ptr, size_t size);
  */
 ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size);
 
+#if defined(CONFIG_FILE_SYSTEM_ASYNC)
+/**
+ * @brief Asynchronous file read
+ *
+ * The read is queued and executed with fs_read() from a dedicated thread,
+ * which raises @p sig with the fs_read() result. Requests are executed in
+ * submission order.
+ *
+ * The file object and buffer must remain valid until the completion is
+ * signaled.
+ *
+ * @param zfp Pointer to the file object
+ * @param ptr Pointer to the data buffer
+ * @param size Number of bytes to be read
+ * @param sig Pointer to a valid and ready to be signaled struct
+ * k_poll_signal, or NULL if no notification is needed.
+ *
+ * @retval 0 Request queued
+ * @retval -ENOMEM Request queue is full
+ */
+int fs_read_async(struct fs_file_t *zfp, void *ptr, size_t size,
+		  struct k_poll_signal *sig);
+
+/**
+ * @brief Asynchronous file write
+ *
+ * Same as fs_read_async() for fs_write(). Writes to the same file that are
+ * queued back to back may be merged into a single fs_write() call, each of
+ * them is still signaled with its own length or the error code.
+ *
+ * @param zfp Pointer to the file object
+ * @param ptr Pointer to the data buffer
+ * @param size Number of bytes to be written
+ * @param sig Pointer to a valid and ready to be signaled struct
+ * k_poll_signal, or NULL if no notification is needed.
+ *
+ * @retval 0 Request queued
+ * @retval -ENOMEM Request queue is full
+ */
+int fs_write_async(struct fs_file_t *zfp, const void *ptr, size_t size,
+		   struct k_poll_signal *sig);
+#endif /* CONFIG_FILE_SYSTEM_ASYNC */
+
 /**
  * @brief File seek
  *
@@ -37,6 +37,16 @@ struct fs_littlefs {
 	struct lfs lfs;
 	const struct flash_area *area;
 	struct k_mutex mutex;
+
+#ifdef CONFIG_FS_LITTLEFS_READ_AHEAD
+	/* Data read ahead of the last small read, only valid while
+	 * ra_len is non-zero.
+	 */
+	u8_t ra_buffer[CONFIG_FS_LITTLEFS_READ_AHEAD_SIZE];
+	lfs_block_t ra_block;
+	lfs_off_t ra_off;
+	lfs_size_t ra_len;
+#endif
 };
 
 /** @brief Define a littlefs configuration with customized size
@@ -43,6 +43,9 @@ extern "C" {
  * @param write_block_size Alignment size
  * @param nvs_lock Mutex
  * @param flash_device Flash Device
+ * @param lookup_cache Latest ATE address per id hash bucket
+ * @param gc_work Background garbage collection work item
+ * @param gc_bg_sector Sector started by the last background garbage collection
  */
 struct nvs_fs {
 	off_t offset;		/* filesystem offset in flash */
@@ -57,6 +60,13 @@ struct nvs_fs {
 
 	struct k_mutex nvs_lock;
 	struct device *flash_device;
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	u32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+#endif
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	struct k_work gc_work;
+	u16_t gc_bg_sector;
+#endif
 };
 
 /**
@@ -64,6 +64,27 @@ static inline bool k_is_pre_kernel(void)
 	DEVICE_AND_API_INIT(Z_SYS_NAME(init_fn), "", init_fn, NULL, NULL, level,\
 	prio, NULL)
 
+/**
+ * @def SYS_INIT_ASYNC
+ *
+ * @brief Run an initialization function at boot, possibly asynchronously
+ *
+ * @details Same as SYS_INIT(), except that with CONFIG_DEVICE_INIT_ASYNC
+ * enabled the function is run by a worker thread at the POST_KERNEL and
+ * APPLICATION levels while the boot carries on, see
+ * DEVICE_AND_API_INIT_ASYNC(). It is completed before main() is called.
+ *
+ * @param init_fn Pointer to the boot function to run
+ *
+ * @param level The initialization level, See DEVICE_AND_API_INIT for details.
+ *
+ * @param prio Priority within the selected initialization level. See
+ * DEVICE_AND_API_INIT for details.
+ */
+#define SYS_INIT_ASYNC(init_fn, level, prio) \
+	DEVICE_AND_API_INIT_ASYNC(Z_SYS_NAME(init_fn), "", init_fn, NULL, \
+				  NULL, level, prio, NULL)
+
 /**
  * @def SYS_DEVICE_DEFINE
  *
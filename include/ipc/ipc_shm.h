@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Zero-copy shared memory IPC
+ *
+ * Messages are exchanged between two cores through buffers in shared RAM,
+ * only the doorbell goes through an IPM device. Each direction uses one
+ * region of shared memory, initialized by its sender and holding:
+ *
+ * - a pool of fixed size blocks the sender writes messages into,
+ * - a single producer, single consumer ring of the blocks holding
+ *   messages, from the sender to the receiver,
+ * - a ring of the blocks released by the receiver, back to the sender.
+ *
+ * The rings are lock free, the only locking is local to each core. The
+ * doorbell is only rung when the receiver may have run out of messages,
+ * so a burst of messages costs a single interrupt on the receiving core.
+ *
+ * The shared memory must not be cached, or be kept coherent by hardware,
+ * and the regions must be laid out identically on both cores.
+ */
+
+#ifndef ZEPHYR_INCLUDE_IPC_IPC_SHM_H_
+#define ZEPHYR_INCLUDE_IPC_IPC_SHM_H_
+
+#include <kernel.h>
+#include <device.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Size of a shared memory region
+ *
+ * @param blocks Number of blocks, a power of two
+ * @param block_size Size of the blocks in bytes, a multiple of 4
+ */
+#define IPC_SHM_REGION_SIZE(blocks, block_size)				\
+	(4 * sizeof(u32_t) + 2 * (blocks) * sizeof(u32_t) +		\
+	 (blocks) * (block_size))
+
+struct ipc_shm;
+
+/**
+ * @brief Callback called for each received message
+ *
+ * Called from the system work queue. The data stays valid, and the block
+ * unavailable to the sender, until it is given back with
+ * ipc_shm_release(), which may be done after returning.
+ *
+ * @param ipc IPC instance
+ * @param data Message in shared memory
+ * @param len Length of the message
+ * @param user_data User data given in the configuration
+ */
+typedef void (*ipc_shm_recv_cb_t)(struct ipc_shm *ipc, void *data,
+				  size_t len, void *user_data);
+
+/** @brief Shared memory region of one direction */
+struct ipc_shm_region_cfg {
+	void *shm;
+	u16_t blocks;
+	u16_t block_size;
+};
+
+/** @brief IPC instance configuration */
+struct ipc_shm_cfg {
+	/** IPM device ringing the doorbell of the remote core */
+	struct device *ipm_tx;
+	/** IPM device receiving the doorbell of the remote core */
+	struct device *ipm_rx;
+	/** IPM channel id used as doorbell */
+	u32_t ipm_id;
+	/** Region written by this core */
+	struct ipc_shm_region_cfg tx;
+	/** Region written by the remote core */
+	struct ipc_shm_region_cfg rx;
+	ipc_shm_recv_cb_t cb;
+	void *user_data;
+};
+
+/* Single producer, single consumer ring in shared memory */
+struct ipc_shm_ring {
+	volatile u32_t *head;
+	volatile u32_t *tail;
+	volatile u32_t *slot;
+	u32_t mask;
+};
+
+struct ipc_shm_region {
+	/* Blocks holding messages, from the sender to the receiver */
+	struct ipc_shm_ring msg;
+	/* Released blocks, from the receiver to the sender */
+	struct ipc_shm_ring ret;
+	u8_t *pool;
+	u16_t block_size;
+};
+
+/** @brief IPC instance */
+struct ipc_shm {
+	const struct ipc_shm_cfg *cfg;
+	struct ipc_shm_region tx;
+	struct ipc_shm_region rx;
+	struct k_spinlock lock;
+	struct k_work rx_work;
+};
+
+/**
+ * @brief Initialize an IPC instance
+ *
+ * Initializes the transmit region, which must be done before the remote
+ * core sends its first message, and enables the doorbell.
+ *
+ * @param ipc IPC instance
+ * @param cfg Configuration, must remain valid while the instance is used
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the configuration is invalid
+ */
+int ipc_shm_init(struct ipc_shm *ipc, const struct ipc_shm_cfg *cfg);
+
+/**
+ * @brief Allocate a transmit buffer
+ *
+ * The buffer is in shared memory, the message is written in place and
+ * sent with ipc_shm_send() without being copied.
+ *
+ * @param ipc IPC instance
+ *
+ * @return Buffer of the block size, or NULL if all the blocks are in use
+ */
+void *ipc_shm_alloc(struct ipc_shm *ipc);
+
+/**
+ * @brief Send a message
+ *
+ * @param ipc IPC instance
+ * @param buf Buffer returned by ipc_shm_alloc()
+ * @param len Length of the message, at most the block size
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the buffer or length is invalid
+ * @retval Errno code of the IPM device if the doorbell failed
+ */
+int ipc_shm_send(struct ipc_shm *ipc, void *buf, size_t len);
+
+/**
+ * @brief Release a received message
+ *
+ * Gives the block back to the remote core. This does not ring the
+ * doorbell, the remote core finds the block on its next allocation.
+ *
+ * @param ipc IPC instance
+ * @param data Data passed to the receive callback
+ */
+void ipc_shm_release(struct ipc_shm *ipc, void *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_IPC_IPC_SHM_H_ */
@@ -135,6 +135,7 @@ struct k_poll_signal;
 struct k_mem_domain;
 struct k_mem_partition;
 struct k_futex;
+struct k_event;
 
 /**
  * @brief Kernel Object Types
@@ -437,6 +438,11 @@ struct _thread_base {
 	 */
 	_wait_q_t *pended_on;
 
+#if (CONFIG_PRIORITY_INHERITANCE_DEPTH > 1)
+	/* mutex the thread is waiting to lock, for transitive inheritance */
+	struct k_mutex *pended_mutex;
+#endif
+
 	/* user facing 'thread options'; values defined in include/kernel.h */
 	u8_t user_options;
 
@@ -496,6 +502,34 @@ struct _thread_base {
 	/* data returned by APIs */
 	void *swap_data;
 
+#ifdef CONFIG_SCHED_STATS
+	/* cycle count when last made ready, 0 once it has been run */
+	u32_t ready_stamp;
+#endif
+
+#ifdef CONFIG_SCHED_CBS
+	/* constant bandwidth server reservation, budget is 0 if none */
+	struct _thread_cbs {
+		/* reserved ticks per period, and the period in ticks */
+		u32_t budget;
+		u32_t period;
+
+		/* budget / period, in parts per million */
+		u32_t util;
+
+		/* ticks left in the current period, and its absolute
+		 * deadline in ticks
+		 */
+		s32_t remaining;
+		s64_t deadline;
+
+		/* budget enforcement while running, replenishment
+		 * while throttled
+		 */
+		struct _timeout timer;
+	} cbs;
+#endif
+
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 	/* this thread's entry in a timeout queue */
 	struct _timeout timeout;
@@ -517,6 +551,11 @@ struct _thread_stack_info {
 	 * that should be writable by the thread
 	 */
 	size_t size;
+
+#if defined(CONFIG_STACK_WATERMARK)
+	/* Deepest stack pointer sampled so far */
+	uintptr_t watermark;
+#endif
 };
 
 typedef struct _thread_stack_info _thread_stack_info_t;
@@ -530,6 +569,19 @@ struct _mem_domain_info {
 	struct k_mem_domain *mem_domain;
 };
 
+#if (CONFIG_USERSPACE_OBJ_CACHE_SIZE > 0)
+/* Kernel objects that passed system call validation for the thread */
+struct _thread_obj_cache {
+	/** Invalidation generation the entries belong to */
+	u32_t gen;
+	/** Next entry to replace */
+	u32_t next;
+	struct {
+		void *obj;
+		struct _k_object *ko;
+	} entry[CONFIG_USERSPACE_OBJ_CACHE_SIZE];
+};
+#endif
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_THREAD_USERSPACE_LOCAL_DATA
@@ -580,7 +632,12 @@ struct k_thread {
 	struct _thread_userspace_local_data *userspace_local_data;
 #endif
 
-#ifdef CONFIG_ERRNO
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+	/** thread pointer value, locating the thread's TLS area */
+	uintptr_t tls;
+#endif
+
+#if defined(CONFIG_ERRNO) && !defined(CONFIG_ERRNO_IN_TLS)
 #ifndef CONFIG_USERSPACE
 	/** per-thread errno variable */
 	int errno_var;
@@ -592,11 +649,20 @@ struct k_thread {
 	struct _thread_stack_info stack_info;
 #endif /* CONFIG_THREAD_STACK_INFO */
 
+#if defined(CONFIG_SCHED_THREAD_USAGE)
+	/** Hardware cycles spent running this thread */
+	u64_t usage;
+#endif
+
 #if defined(CONFIG_USERSPACE)
 	/** memory domain info of the thread */
 	struct _mem_domain_info mem_domain_info;
 	/** Base address of thread stack */
 	k_thread_stack_t *stack_obj;
+#if (CONFIG_USERSPACE_OBJ_CACHE_SIZE > 0)
+	/** validated kernel object cache */
+	struct _thread_obj_cache obj_cache;
+#endif
 #endif /* CONFIG_USERSPACE */
 
 #if defined(CONFIG_USE_SWITCH)
@@ -1092,6 +1158,47 @@ __syscall void k_thread_priority_set(k_tid_t thread, int prio);
 __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
 #endif
 
+#ifdef CONFIG_SCHED_CBS
+/**
+ * @brief Reserve CPU bandwidth for a thread
+ *
+ * Attaches a constant bandwidth server to the thread: it may run for
+ * @a budget_us out of every @a period_us microseconds, scheduled by the
+ * deadline of its server.  That deadline is ordered like the one set
+ * by k_thread_deadline_set(), that is only against threads of the same
+ * static priority, so reserved threads are normally given a common
+ * priority of their own.  Once the budget of a period is spent the
+ * thread is throttled, and not run again until the period ends and the
+ * budget is replenished.  A thread that wakes up after sleeping gets a
+ * new period, unless its remaining budget can be spent before the
+ * current deadline without exceeding the reserved bandwidth.
+ *
+ * Budgets and periods are rounded up to whole ticks.  The request is
+ * refused if it would take the summed utilization of all reservations
+ * above :option:`CONFIG_SCHED_CBS_MAX_UTILIZATION`.
+ *
+ * @note The server overrides any deadline set with
+ * k_thread_deadline_set() on the same thread.
+ *
+ * @note
+ *    @rst
+ *    You should enable :option:`CONFIG_SCHED_CBS` in your project
+ *    configuration.
+ *    @endrst
+ *
+ * @param thread Thread to reserve bandwidth for
+ * @param budget_us Run time per period in microseconds, or 0 to remove
+ *	  the reservation
+ * @param period_us Period in microseconds
+ *
+ * @retval 0 Reservation set, changed or removed
+ * @retval -EINVAL Budget exceeds the period, or the period is zero
+ * @retval -EBUSY Admission control refused the reservation
+ */
+__syscall int k_thread_cbs_set(k_tid_t thread, u32_t budget_us,
+			       u32_t period_us);
+#endif
+
 #ifdef CONFIG_SCHED_CPU_MASK
 /**
  * @brief Sets all CPU enable masks to zero
@@ -1101,7 +1208,7 @@ __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
  *
  * @note
  *    @rst
- *    You should enable :option:`CONFIG_SCHED_DEADLINE` in your project
+ *    You should enable :option:`CONFIG_SCHED_CPU_MASK` in your project
  *    configuration.
  *    @endrst
  *
@@ -1118,7 +1225,7 @@ int k_thread_cpu_mask_clear(k_tid_t thread);
  *
  * @note
  *    @rst
- *    You should enable :option:`CONFIG_SCHED_DEADLINE` in your project
+ *    You should enable :option:`CONFIG_SCHED_CPU_MASK` in your project
  *    configuration.
  *    @endrst
  *
@@ -1134,7 +1241,7 @@ int k_thread_cpu_mask_enable_all(k_tid_t thread);
  *
  * @note
  *    @rst
- *    You should enable :option:`CONFIG_SCHED_DEADLINE` in your project
+ *    You should enable :option:`CONFIG_SCHED_CPU_MASK` in your project
  *    configuration.
  *    @endrst
  *
@@ -1151,7 +1258,7 @@ int k_thread_cpu_mask_enable(k_tid_t thread, int cpu);
  *
  * @note
  *    @rst
- *    You should enable :option:`CONFIG_SCHED_DEADLINE` in your project
+ *    You should enable :option:`CONFIG_SCHED_CPU_MASK` in your project
  *    configuration.
  *    @endrst
  *
@@ -1160,6 +1267,25 @@ int k_thread_cpu_mask_enable(k_tid_t thread, int cpu);
  * @return Zero on success, otherwise error code
  */
 int k_thread_cpu_mask_disable(k_tid_t thread, int cpu);
+
+/**
+ * @brief Pin a thread to a single CPU
+ *
+ * Equivalent to k_thread_cpu_mask_clear() followed by
+ * k_thread_cpu_mask_enable() for @a cpu, done atomically.  The thread
+ * must not be currently runnable.
+ *
+ * @note
+ *    @rst
+ *    You should enable :option:`CONFIG_SCHED_CPU_MASK` in your project
+ *    configuration.
+ *    @endrst
+ *
+ * @param thread Thread to operate upon
+ * @param cpu CPU index
+ * @return Zero on success, otherwise error code
+ */
+int k_thread_cpu_pin(k_tid_t thread, int cpu);
 #endif
 
 /**
@@ -1305,6 +1431,61 @@ extern void k_sched_lock(void);
  */
 extern void k_sched_unlock(void);
 
+#if defined(CONFIG_SCHED_STATS) || defined(__DOXYGEN__)
+/** Number of thread priorities tracked by the latency histograms */
+#define K_SCHED_STATS_PRIOS (K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO + 1)
+
+/**
+ * @brief Scheduler statistics.
+ */
+struct k_sched_stats {
+	/** Times a CPU was switched to a different thread */
+	u32_t switches;
+	/** Times a thread was made ready to run */
+	u32_t wakeups;
+	/** Threads currently in the run queues */
+	u32_t runq_depth;
+	/** Highest depth observed, summed over the run queues */
+	u32_t runq_max_depth;
+	/** Highest wake-to-run latency observed, in microseconds */
+	u32_t max_latency_us;
+};
+
+/**
+ * @brief Get scheduler statistics.
+ *
+ * Counters accumulate from boot or from the last call to
+ * k_sched_stats_reset().
+ *
+ * @param stats Statistics to fill in.
+ */
+extern void k_sched_stats_get(struct k_sched_stats *stats);
+
+/**
+ * @brief Get the wake-up latency histogram of a thread priority.
+ *
+ * The latency of a wake-up is the time from a thread being made ready
+ * until the scheduler selects it to run.  Bucket 0 counts latencies
+ * below 1 microsecond and bucket @em n those in [2^(n-1), 2^n)
+ * microseconds; the last bucket also counts everything above it.
+ *
+ * @param prio Thread priority.
+ * @param hist Array of CONFIG_SCHED_STATS_HIST_BUCKETS counters to fill in.
+ *
+ * @retval 0 On success.
+ * @retval -EINVAL @a prio is not a valid thread priority.
+ */
+extern int k_sched_latency_hist_get(int prio, u32_t *hist);
+
+/**
+ * @brief Reset scheduler statistics.
+ *
+ * Clears all counters and histograms.  The current run queue depth is
+ * kept and becomes the new maximum.
+ */
+extern void k_sched_stats_reset(void);
+#endif
+
 /**
  * @brief Set current thread's custom data.
  *
@@ -1381,6 +1562,49 @@ __syscall int k_thread_name_copy(k_tid_t thread_id, char *buf,
  */
 const char *k_thread_state_str(k_tid_t thread_id);
 
+/**
+ * @brief Get the peak stack usage of a thread
+ *
+ * With CONFIG_STACK_WATERMARK, the kernel samples the stack depth of each
+ * thread when it is switched out. This returns the deepest sample, which
+ * is a lower bound of the thread's actual peak usage.
+ *
+ * @param thread Thread to query
+ * @param used Destination for the peak usage, in bytes
+ * @retval 0 Success
+ * @retval -EFAULT Memory access error
+ * @retval -ENOSYS Stack watermark feature not enabled
+ */
+__syscall int k_thread_stack_watermark_get(k_tid_t thread, size_t *used);
+
+/**
+ * @brief Get the CPU time used by a thread
+ *
+ * With CONFIG_SCHED_THREAD_USAGE, the kernel accounts the hardware cycles
+ * each thread has been running, updated when it is switched out. For a
+ * running thread the current run is included.
+ *
+ * @param thread Thread to query
+ * @param cycles Destination for the number of hardware cycles
+ * @retval 0 Success
+ * @retval -EFAULT Memory access error
+ * @retval -ENOSYS Thread usage feature not enabled
+ */
+__syscall int k_thread_cycles_get(k_tid_t thread, u64_t *cycles);
+
+/**
+ * @brief Sample the stack depth of the current thread
+ *
+ * Records the current stack depth in the watermark reported by
+ * k_thread_stack_watermark_get(), on top of the samples taken at context
+ * switches. Call it from the deepest point of a call chain that does not
+ * block, so that its depth is accounted for.
+ *
+ * Only available to supervisor threads; a no-op without
+ * CONFIG_STACK_WATERMARK.
+ */
+void k_thread_stack_watermark_sample(void);
+
 /**
  * @}
  */
@@ -1500,7 +1724,6 @@ struct k_timer {
 	{ \
 	.timeout = { \
 		.node = {},\
-		.dticks = 0, \
 		.fn = z_timer_expiration_handler \
 	}, \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
@@ -1673,6 +1896,38 @@ static inline u32_t z_impl_k_timer_remaining_get(struct k_timer *timer)
 	return (ticks > 0) ? (u32_t)k_ticks_to_ms_floor64(ticks) : 0U;
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/**
+ * @brief Allow a timer to expire late.
+ *
+ * This routine lets the kernel run the timer up to @a slack_ms
+ * milliseconds after its expiry time, so that it can be served from
+ * the same system timer interrupt as other timeouts expiring in that
+ * window.  For periodic timers the period is still measured from the
+ * nominal expiry time, so slack does not accumulate as drift.
+ *
+ * Slack is reset to zero by k_timer_init().
+ *
+ * @note
+ *    @rst
+ *    You should enable :option:`CONFIG_TIMEOUT_SLACK` in your project
+ *    configuration.
+ *    @endrst
+ *
+ * @param timer     Address of timer.
+ * @param slack_ms  Maximum expiry delay (in milliseconds).
+ *
+ * @return N/A
+ */
+__syscall void k_timer_slack_set(struct k_timer *timer, u32_t slack_ms);
+
+static inline void z_impl_k_timer_slack_set(struct k_timer *timer,
+					    u32_t slack_ms)
+{
+	timer->timeout.slack = k_ms_to_ticks_floor32(slack_ms);
+}
+#endif
+
 /**
  * @brief Associate user-specific data with a timer.
  *
@@ -2580,6 +2835,123 @@ struct k_lifo {
 
 /** @} */
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_mpsc {
+	/* items pushed by producers, most recent first */
+	atomic_ptr_t head;
+
+	/* items already taken from head, oldest first; consumer only */
+	sys_slist_t ready;
+
+	/* set by the consumer before it blocks or polls */
+	atomic_t waiting;
+
+	struct k_spinlock lock;
+	_wait_q_t wait_q;
+
+	_POLL_EVENT;
+};
+
+#define Z_MPSC_INITIALIZER(obj) \
+	{ \
+	.head = NULL, \
+	.ready = { NULL, NULL }, \
+	.waiting = ATOMIC_INIT(0), \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	_POLL_EVENT_OBJ_INIT(obj) \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup mpsc_apis MPSC Queue APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Initialize a multi-producer, single-consumer queue.
+ *
+ * An MPSC queue hands data items from any number of producers (threads
+ * or ISRs) to a single consumer thread.  Producers never take a lock
+ * unless the consumer is blocked in k_mpsc_get() or k_poll() on the
+ * queue, so they are suitable for high rate ISR-to-thread handoff.
+ * Items are delivered in the order they were put.
+ *
+ * As with FIFOs, the first word of each data item is reserved for the
+ * kernel's use.  The queue is for supervisor mode only.
+ *
+ * @param queue Address of the queue.
+ *
+ * @return N/A
+ */
+void k_mpsc_init(struct k_mpsc *queue);
+
+/**
+ * @brief Add an element to an MPSC queue.
+ *
+ * This routine adds a data item to @a queue.  It is lock-free unless
+ * the consumer is waiting on the queue, in which case it is woken up.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param queue Address of the queue.
+ * @param data Address of the data item.
+ *
+ * @return N/A
+ */
+void k_mpsc_put(struct k_mpsc *queue, void *data);
+
+/**
+ * @brief Get an element from an MPSC queue.
+ *
+ * This routine removes the oldest data item from @a queue.  It must
+ * only ever be called from the single consumer thread.
+ *
+ * @param queue Address of the queue.
+ * @param timeout Non-negative waiting period to obtain a data item (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @return Address of the data item if successful; NULL if returned
+ * without waiting, or waiting period timed out.
+ */
+void *k_mpsc_get(struct k_mpsc *queue, s32_t timeout);
+
+/**
+ * @brief Query an MPSC queue to see if it has data available.
+ *
+ * Like k_mpsc_get(), this must only be called by the consumer.
+ *
+ * @param queue Address of the queue.
+ *
+ * @return Non-zero if the queue is empty, 0 if data is available.
+ */
+static inline int k_mpsc_is_empty(struct k_mpsc *queue)
+{
+	return sys_slist_is_empty(&queue->ready) &&
+		atomic_ptr_get(&queue->head) == NULL;
+}
+
+/**
+ * @brief Statically define and initialize an MPSC queue.
+ *
+ * The queue can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_mpsc <name>; @endcode
+ *
+ * @param name Name of the queue.
+ */
+#define K_MPSC_DEFINE(name) \
+	struct k_mpsc name = Z_MPSC_INITIALIZER(name)
+
+/** @} */
+
 /**
  * @cond INTERNAL_HIDDEN
  */
@@ -2758,6 +3130,12 @@ typedef void (*k_work_handler_t)(struct k_work *work);
 struct k_work_q {
 	struct k_queue queue;
 	struct k_thread thread;
+#ifdef CONFIG_WORKQUEUE_POOL
+	struct k_spinlock lock;
+	struct k_mutex get_lock;	/* dequeue and key claim, together */
+	sys_slist_t running;	/* ordering keys being processed */
+	sys_slist_t deferred;	/* items waiting for their key */
+#endif
 };
 
 enum {
@@ -2768,6 +3146,9 @@ struct k_work {
 	void *_reserved;		/* Used by k_queue implementation. */
 	k_work_handler_t handler;
 	atomic_t flags[1];
+#ifdef CONFIG_WORKQUEUE_POOL
+	uintptr_t key;			/* Ordering key, 0 if none */
+#endif
 };
 
 struct k_delayed_work {
@@ -2832,6 +3213,29 @@ static inline void k_work_init(struct k_work *work, k_work_handler_t handler)
 	*work = (struct k_work)Z_WORK_INITIALIZER(handler);
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+/**
+ * @brief Set the ordering key of a work item.
+ *
+ * Work items with the same nonzero key are never processed at the
+ * same time by the threads of a workqueue, and are processed in the
+ * order they were submitted.  Items with a zero key, the default, may
+ * run concurrently with anything else.
+ *
+ * The key must not be changed while the work item is pending.
+ *
+ * @param work Address of work item.
+ * @param key Ordering key, e.g. the address of the object the work
+ *	      item operates on.
+ *
+ * @return N/A
+ */
+static inline void k_work_order_key_set(struct k_work *work, uintptr_t key)
+{
+	work->key = key;
+}
+#endif
+
 /**
  * @brief Submit a work item.
  *
@@ -2965,6 +3369,32 @@ extern void k_work_q_user_start(struct k_work_q *work_q,
 				k_thread_stack_t *stack,
 				size_t stack_size, int prio);
 
+#ifdef CONFIG_WORKQUEUE_POOL
+/**
+ * @brief Add a thread to a workqueue.
+ *
+ * This routine spawns an additional processing thread for workqueue
+ * @a work_q, started with k_work_q_start().  All threads of a
+ * workqueue take items from the same queue, so independent work items
+ * are processed in parallel and a slow handler only holds up its own
+ * thread.  Work items sharing an ordering key are still processed one
+ * at a time, see k_work_order_key_set().
+ *
+ * @param work_q Address of workqueue.
+ * @param thread Thread object for the new worker.
+ * @param stack Pointer to the worker thread's stack space, as defined by
+ *		K_THREAD_STACK_DEFINE()
+ * @param stack_size Size of the worker thread's stack (in bytes).
+ * @param prio Priority of the worker thread.
+ *
+ * @return N/A
+ */
+extern void k_work_q_worker_add(struct k_work_q *work_q,
+				struct k_thread *thread,
+				k_thread_stack_t *stack,
+				size_t stack_size, int prio);
+#endif
+
 /**
  * @brief Initialize a delayed work item.
  *
@@ -3120,6 +3550,29 @@ static inline s32_t k_delayed_work_remaining_get(struct k_delayed_work *work)
 	return k_ticks_to_ms_floor64(z_timeout_remaining(&work->timeout));
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/**
+ * @brief Allow a delayed work item to be submitted late.
+ *
+ * This routine lets the kernel submit the work item up to @a slack_ms
+ * milliseconds after its delay has elapsed, so that it can be served
+ * from the same system timer interrupt as other timeouts expiring in
+ * that window.
+ *
+ * Slack is reset to zero by k_delayed_work_init().
+ *
+ * @param work      Delayed work item.
+ * @param slack_ms  Maximum submission delay (in milliseconds).
+ *
+ * @return N/A
+ */
+static inline void k_delayed_work_slack_set(struct k_delayed_work *work,
+					    u32_t slack_ms)
+{
+	work->timeout.slack = k_ms_to_ticks_floor32(slack_ms);
+}
+#endif
+
 /**
  * @brief Initialize a triggered work item.
  *
@@ -3289,6 +3742,37 @@ struct k_mutex {
 	Z_STRUCT_SECTION_ITERABLE(k_mutex, name) = \
 		_K_MUTEX_INITIALIZER(name)
 
+#if defined(CONFIG_PRIORITY_INHERITANCE_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Mutex priority inheritance statistics.
+ */
+struct k_mutex_pi_stats {
+	/** Mutex owners boosted directly by a new waiter */
+	u32_t boosts;
+	/** Owners boosted or lowered transitively, further down a chain */
+	u32_t chain_updates;
+	/** Longest chain of owners updated, counting the direct owner */
+	u32_t max_chain_depth;
+	/** Chains cut short by CONFIG_PRIORITY_INHERITANCE_DEPTH */
+	u32_t depth_limit_hits;
+};
+
+/**
+ * @brief Get mutex priority inheritance statistics.
+ *
+ * Counters accumulate from boot or from the last call to
+ * k_mutex_pi_stats_reset().
+ *
+ * @param stats Statistics to fill in.
+ */
+extern void k_mutex_pi_stats_get(struct k_mutex_pi_stats *stats);
+
+/**
+ * @brief Reset mutex priority inheritance statistics.
+ */
+extern void k_mutex_pi_stats_reset(void);
+#endif
+
 /**
  * @brief Initialize a mutex.
  *
@@ -3490,6 +3974,121 @@ static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
 
 /** @} */
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_event {
+	_wait_q_t wait_q;
+	u32_t events;
+	struct k_spinlock lock;
+
+	_POLL_EVENT;
+};
+
+#define Z_EVENT_INITIALIZER(obj) \
+	{ \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.events = 0, \
+	_POLL_EVENT_OBJ_INIT(obj) \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup event_apis Event APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/** Wait for all the events instead of any of them */
+#define K_EVENT_WAIT_ALL BIT(0)
+
+/** Do not clear the events a wait was satisfied with */
+#define K_EVENT_NO_CLEAR BIT(1)
+
+/**
+ * @brief Initialize an event object.
+ *
+ * An event object holds a set of 32 events, which threads can wait for
+ * all or any of. Waiting threads are only woken up when the events they
+ * wait for are set.
+ *
+ * @param event Address of the event object.
+ *
+ * @return N/A
+ */
+__syscall void k_event_init(struct k_event *event);
+
+/**
+ * @brief Set events.
+ *
+ * This routine sets @a events in @a event, then wakes up, in priority
+ * order, the threads the wait of which is satisfied. Unless a thread
+ * waits with K_EVENT_NO_CLEAR, the events it waited for are cleared
+ * before the following waiters are checked.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events Events to set.
+ *
+ * @return The events of the object, once the woken threads cleared theirs.
+ */
+__syscall u32_t k_event_set(struct k_event *event, u32_t events);
+
+/**
+ * @brief Clear events.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events Events to clear; 0 to only read the events.
+ *
+ * @return The events of the object before clearing.
+ */
+__syscall u32_t k_event_clear(struct k_event *event, u32_t events);
+
+/**
+ * @brief Wait for events.
+ *
+ * This routine waits until any of @a events is set in @a event, or all of
+ * them with K_EVENT_WAIT_ALL. The events waited for are then cleared,
+ * unless K_EVENT_NO_CLEAR is passed.
+ *
+ * @note Can be called by ISRs, with @a timeout set to K_NO_WAIT.
+ *
+ * @param event Address of the event object.
+ * @param events Events to wait for, not 0.
+ * @param options K_EVENT_WAIT_ALL and K_EVENT_NO_CLEAR flags.
+ * @param timeout Non-negative waiting period for the events (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @return The events of the object when the wait was satisfied, before
+ *         clearing; 0 if returned without waiting, or the waiting period
+ *         timed out.
+ */
+__syscall u32_t k_event_wait(struct k_event *event, u32_t events,
+			     u32_t options, s32_t timeout);
+
+/**
+ * @brief Statically define and initialize an event object.
+ *
+ * The event object can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct k_event <name>; @endcode
+ *
+ * @param name Name of the event object.
+ */
+#define K_EVENT_DEFINE(name) \
+	struct k_event name = Z_EVENT_INITIALIZER(name)
+
+/** @} */
+
 /**
  * @defgroup msgq_apis Message Queue APIs
  * @ingroup kernel_apis
@@ -3685,6 +4284,63 @@ __syscall int k_msgq_put(struct k_msgq *q, void *data, s32_t timeout);
  */
 __syscall int k_msgq_get(struct k_msgq *q, void *data, s32_t timeout);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a count consecutive messages from @a data to
+ * message queue @a q while holding the queue lock once.  Messages are
+ * handed to waiting receivers first and then buffered; all receivers
+ * woken by the call are rescheduled together.
+ *
+ * If the queue is full on entry the caller waits, as in k_msgq_put(), until
+ * the first message can be sent.  The call returns once that one message
+ * has been sent; the remaining ones are not.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param q Address of the message queue.
+ * @param data Pointer to an array of @a count messages.
+ * @param count Number of messages to send.
+ * @param timeout Non-negative waiting period to send the first message (in
+ *                milliseconds), or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages sent (at least 1 if @a count was non-zero),
+ *         or a negative error code if none was.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_put_many(struct k_msgq *q, void *data, u32_t count,
+			      s32_t timeout);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a count messages from message queue @a q,
+ * in "first in, first out" order, into consecutive slots of @a data while
+ * holding the queue lock once.  Senders waiting for space refill the
+ * queue as it drains and are all rescheduled together.
+ *
+ * If the queue is empty on entry the caller waits, as in k_msgq_get(), for
+ * one message and returns once it has arrived.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param q Address of the message queue.
+ * @param data Address of area to hold @a count messages.
+ * @param count Maximum number of messages to receive.
+ * @param timeout Non-negative waiting period to receive the first message
+ *                (in milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @return Number of messages received (at least 1 if @a count was
+ *         non-zero), or a negative error code if none was.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_get_many(struct k_msgq *q, void *data, u32_t count,
+			      s32_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -3778,11 +4434,18 @@ static inline u32_t z_impl_k_msgq_num_used_get(struct k_msgq *q)
  * to 16M of memory managed by a single pool.  Long term it would be
  * good to move to a variable bit size based on configuration.
  */
+#ifdef CONFIG_MEM_POOL_HEAP_BACKEND
+struct k_mem_block_id {
+	struct k_mem_pool *pool;
+	void *data;
+};
+#else
 struct k_mem_block_id {
 	u32_t pool : 8;
 	u32_t level : 4;
 	u32_t block : 20;
 };
+#endif
 
 struct k_mem_block {
 	void *data;
@@ -4185,12 +4848,103 @@ __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 extern void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 			     size_t size, struct k_sem *sem);
 
+/**
+ * @brief Claim space in a pipe's buffer for writing in place.
+ *
+ * This routine returns a pointer to contiguous free space in the ring
+ * buffer of @a pipe, so that data can be produced directly into it
+ * instead of being copied in by k_pipe_put().  The data becomes
+ * visible to readers once k_pipe_put_finish() is called.
+ *
+ * Less space than requested may be returned when the buffer is nearly
+ * full or the free space wraps around its end; call again after
+ * finishing to claim the rest.
+ *
+ * @note Only one write claim may be outstanding on a pipe at a time,
+ * and k_pipe_put() must not be used on the pipe until it is finished.
+ * The claim API is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the start of the claimed space.
+ * @param size Number of bytes wanted.
+ *
+ * @return Number of bytes claimed, possibly 0.
+ */
+extern size_t k_pipe_put_claim(struct k_pipe *pipe, u8_t **data,
+			       size_t size);
+
+/**
+ * @brief Commit data written in place to a pipe.
+ *
+ * This routine makes the first @a size bytes of the space returned by
+ * k_pipe_put_claim() available to readers.  Readers waiting on the pipe
+ * are served from the buffer right away.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written, at most the amount claimed.
+ *
+ * @retval 0 Data committed.
+ * @retval -EINVAL @a size exceeds the space that could have been claimed.
+ */
+extern int k_pipe_put_finish(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim data in a pipe's buffer for reading in place.
+ *
+ * This routine returns a pointer to contiguous data in the ring buffer
+ * of @a pipe, so that it can be consumed directly instead of being
+ * copied out by k_pipe_get().  The space is only released to writers
+ * once k_pipe_get_finish() is called.
+ *
+ * Less data than requested may be returned when the buffer holds less
+ * or the data wraps around its end; call again after finishing to
+ * claim the rest.
+ *
+ * @note Only one read claim may be outstanding on a pipe at a time,
+ * and k_pipe_get() must not be used on the pipe until it is finished.
+ * The claim API is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the start of the claimed data.
+ * @param size Number of bytes wanted.
+ *
+ * @return Number of bytes claimed, possibly 0.
+ */
+extern size_t k_pipe_get_claim(struct k_pipe *pipe, u8_t **data,
+			       size_t size);
+
+/**
+ * @brief Release data read in place from a pipe.
+ *
+ * This routine frees the first @a size bytes of the data returned by
+ * k_pipe_get_claim().  Writers waiting on the pipe refill the freed
+ * space right away.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed, at most the amount claimed.
+ *
+ * @retval 0 Space released.
+ * @retval -EINVAL @a size exceeds the data that could have been claimed.
+ */
+extern int k_pipe_get_finish(struct k_pipe *pipe, size_t size);
+
 /** @} */
 
 /**
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* Per-CPU magazine of free blocks, only touched by its own CPU */
+struct z_mem_slab_cache {
+	char *free_list;
+	u32_t count;
+	u32_t hits;
+	u32_t refills;
+	u32_t flushes;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	u32_t num_blocks;
@@ -4198,6 +4952,9 @@ struct k_mem_slab {
 	char *buffer;
 	char *free_list;
 	u32_t num_used;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	struct z_mem_slab_cache cache[CONFIG_MP_NUM_CPUS];
+#endif
 
 	_OBJECT_TRACING_NEXT_PTR(k_mem_slab)
 	_OBJECT_TRACING_LINKED_FLAG
@@ -4325,7 +5082,19 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline u32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* num_used also counts blocks parked in the per-CPU caches */
+	u32_t used = slab->num_used;
+	int i;
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		used -= slab->cache[i].count;
+	}
+
+	return used;
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -4341,19 +5110,67 @@ static inline u32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline u32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
+#if defined(CONFIG_MEM_SLAB_CPU_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief Memory slab per-CPU cache statistics.
+ */
+struct k_mem_slab_cache_stats {
+	/** Allocations and frees served without taking the slab lock */
+	u32_t hits;
+	/** Batches moved from the shared free list into a cache */
+	u32_t refills;
+	/** Batches moved from a cache back to the shared free list */
+	u32_t flushes;
+	/** Free blocks currently held in the per-CPU caches */
+	u32_t cached;
+};
+
+/**
+ * @brief Get per-CPU cache statistics of a memory slab.
+ *
+ * Sums the counters of all CPU caches of @a slab. The individual
+ * counters are sampled without locking, so the result is only a
+ * snapshot while other CPUs are using the slab.
+ *
+ * @param slab Address of the memory slab.
+ * @param stats Statistics to fill in.
+ */
+extern void k_mem_slab_cache_stats_get(struct k_mem_slab *slab,
+				       struct k_mem_slab_cache_stats *stats);
+
+/**
+ * @brief Return the current CPU's cached blocks to a memory slab.
+ *
+ * Flushes every block held in the calling CPU's cache of @a slab back
+ * to the shared free list, making them available to other CPUs and to
+ * threads blocked in k_mem_slab_alloc().
+ *
+ * @param slab Address of the memory slab.
+ */
+extern void k_mem_slab_cache_flush(struct k_mem_slab *slab);
+#endif
+
 /** @} */
 
 /**
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_POOL_HEAP_BACKEND
+struct k_mem_pool {
+	struct sys_heap heap;
+	struct k_spinlock lock;
+	_wait_q_t wait_q;
+};
+#else
 struct k_mem_pool {
 	struct sys_mem_pool_base base;
 	_wait_q_t wait_q;
 };
+#endif
 
 /**
  * INTERNAL_HIDDEN @endcond
@@ -4372,6 +5189,11 @@ struct k_mem_pool {
  * quarters, down to blocks of @a min_size bytes long. The buffer is aligned
  * to a @a align -byte boundary.
  *
+ * With CONFIG_MEM_POOL_HEAP_BACKEND the pool is a TLSF heap instead: it is
+ * sized so that @a n_max blocks of @a max_size bytes fit, @a min_size is
+ * ignored and allocations of any size are carved out in constant time.
+ * Returned blocks are aligned to Z_HEAP_ALIGN bytes.
+ *
  * If the pool is to be accessed outside the module where it is defined, it
  * can be declared via
  *
@@ -4384,6 +5206,17 @@ struct k_mem_pool {
  * @param align Alignment of the pool's buffer (power of 2).
  * @req K-MPOOL-001
  */
+#ifdef CONFIG_MEM_POOL_HEAP_BACKEND
+#define K_MEM_POOL_DEFINE(name, minsz, maxsz, nmax, align)		\
+	char __aligned(MAX(WB_UP(align), Z_HEAP_ALIGN))			\
+		_mpool_buf_##name[SYS_HEAP_BUF_SIZE(WB_UP(maxsz), nmax)]; \
+	Z_STRUCT_SECTION_ITERABLE(k_mem_pool, name) = {			\
+		.heap = {						\
+			.init_mem = _mpool_buf_##name,			\
+			.init_bytes = sizeof(_mpool_buf_##name),	\
+		}							\
+	}
+#else
 #define K_MEM_POOL_DEFINE(name, minsz, maxsz, nmax, align)		\
 	char __aligned(WB_UP(align)) _mpool_buf_##name[WB_UP(maxsz) * nmax \
 				  + _MPOOL_BITS_SIZE(maxsz, minsz, nmax)]; \
@@ -4399,6 +5232,7 @@ struct k_mem_pool {
 		} \
 	}; \
 	BUILD_ASSERT(WB_UP(maxsz) >= _MPOOL_MINBLK)
+#endif
 
 /**
  * @brief Allocate memory from a memory pool.
@@ -4536,6 +5370,12 @@ enum _poll_types_bits {
 	/* queue/fifo/lifo data availability */
 	_POLL_TYPE_DATA_AVAILABLE,
 
+	/* MPSC queue data availability */
+	_POLL_TYPE_MPSC_DATA_AVAILABLE,
+
+	/* event object with events set */
+	_POLL_TYPE_EVENT,
+
 	_POLL_NUM_TYPES
 };
 
@@ -4558,6 +5398,9 @@ enum _poll_states_bits {
 	/* queue/fifo/lifo wait was cancelled */
 	_POLL_STATE_CANCELLED,
 
+	/* events are set in an event object */
+	_POLL_STATE_EVENT_SET,
+
 	_POLL_NUM_STATES
 };
 
@@ -4588,6 +5431,9 @@ enum _poll_states_bits {
 #define K_POLL_TYPE_SEM_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_SEM_AVAILABLE)
 #define K_POLL_TYPE_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_DATA_AVAILABLE)
 #define K_POLL_TYPE_FIFO_DATA_AVAILABLE K_POLL_TYPE_DATA_AVAILABLE
+#define K_POLL_TYPE_MPSC_DATA_AVAILABLE \
+	Z_POLL_TYPE_BIT(_POLL_TYPE_MPSC_DATA_AVAILABLE)
+#define K_POLL_TYPE_EVENT Z_POLL_TYPE_BIT(_POLL_TYPE_EVENT)
 
 /* public - polling modes */
 enum k_poll_modes {
@@ -4604,6 +5450,7 @@ enum k_poll_modes {
 #define K_POLL_STATE_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_DATA_AVAILABLE)
 #define K_POLL_STATE_FIFO_DATA_AVAILABLE K_POLL_STATE_DATA_AVAILABLE
 #define K_POLL_STATE_CANCELLED Z_POLL_STATE_BIT(_POLL_STATE_CANCELLED)
+#define K_POLL_STATE_EVENT_SET Z_POLL_STATE_BIT(_POLL_STATE_EVENT_SET)
 
 /* public - poll signal object */
 struct k_poll_signal {
@@ -4659,6 +5506,8 @@ struct k_poll_event {
 		struct k_sem *sem;
 		struct k_fifo *fifo;
 		struct k_queue *queue;
+		struct k_mpsc *mpsc;
+		struct k_event *event;
 	};
 };
 
@@ -4683,6 +5532,25 @@ struct k_poll_event {
 	{ .obj = event_obj }, \
 	}
 
+/**
+ * @brief Persistent set of poll events
+ *
+ * See k_poll_set_init(). All fields are private.
+ */
+struct k_poll_set {
+	/* Registration shared by every event of the set */
+	struct _poller poller;
+
+	/* Events that fired and have not been reported yet */
+	sys_dlist_t ready;
+
+	/* Events handed out by the last k_poll_set_wait() */
+	sys_dlist_t reported;
+
+	/* Thread waiting in k_poll_set_wait() */
+	_wait_q_t wait_q;
+};
+
 /**
  * @brief Initialize one struct k_poll_event instance
  *
@@ -4819,6 +5687,78 @@ __syscall void k_poll_signal_check(struct k_poll_signal *signal,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *signal, int result);
 
+/**
+ * @brief Initialize a poll set.
+ *
+ * A poll set keeps its events registered with the polled objects across
+ * calls to k_poll_set_wait(), which only has to look at the events that
+ * became ready rather than at the whole set. This makes it a better fit
+ * than k_poll() for a thread that repeatedly waits on many objects.
+ *
+ * A poll set is meant to be waited on by a single thread. Its events are
+ * ordered among other pollers of the same object according to the priority
+ * of the thread that last called k_poll_set_init() or k_poll_set_wait().
+ *
+ * @note Poll sets are only available to supervisor threads.
+ *
+ * @param set Poll set to initialize.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * The event must have been initialized with k_poll_event_init() or one of
+ * the K_POLL_EVENT_INITIALIZER macros and must not be part of another poll
+ * set or be passed to k_poll() while it belongs to this one. It stays
+ * registered until removed with k_poll_set_remove().
+ *
+ * @param set Poll set.
+ * @param event Event to add.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * @param set Poll set the event was added to.
+ * @param event Event to remove.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_remove(struct k_poll_set *set,
+			      struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to become ready.
+ *
+ * Stores pointers to up to @a max_events ready events in @a events. Their
+ * state field tells which condition was met, as with k_poll(); events that
+ * are not ready are neither reported nor touched.
+ *
+ * Readiness is level-triggered: an event whose condition still holds (e.g.
+ * a semaphore that was not taken) at the next call is reported again. The
+ * reported events are re-armed at the start of the next call, so the caller
+ * may consume the ready objects in between without racing against them.
+ *
+ * @param set Poll set.
+ * @param events Array receiving pointers to the ready events.
+ * @param max_events Size of the @a events array.
+ * @param timeout Non-negative waiting period for an event to be ready (in
+ *                milliseconds), or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of ready events stored in @a events, or -EAGAIN if the
+ *         waiting period timed out.
+ */
+extern int k_poll_set_wait(struct k_poll_set *set,
+			   struct k_poll_event **events, int max_events,
+			   s32_t timeout);
+
 /**
  * @internal
  */
@@ -62,6 +62,9 @@
 /* Thread is present in the ready queue */
 #define _THREAD_QUEUED (BIT(6))
 
+/* Thread has exhausted its CBS budget until its next replenishment */
+#define _THREAD_THROTTLED (BIT(7))
+
 /* end - states */
 
 #ifdef CONFIG_STACK_SENTINEL
@@ -90,6 +93,12 @@ struct _ready_q {
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
 #endif
+
+#ifdef CONFIG_SCHED_STATS
+	/* threads currently queued in runq, and high watermark */
+	u32_t depth;
+	u32_t max_depth;
+#endif
 };
 
 typedef struct _ready_q _ready_q_t;
@@ -128,6 +137,21 @@ struct _cpu {
 	/* True when _current is allowed to context switch */
 	u8_t swap_ok;
 #endif
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* thread most recently selected to run on this CPU */
+	struct k_thread *selected;
+
+	/* ready queue of threads whose home is this CPU: can be big,
+	 * keep after small fields
+	 */
+	struct _ready_q ready_q;
+#endif
+
+#ifdef CONFIG_SCHED_THREAD_USAGE
+	/* cycle count when _current started running on this CPU */
+	u32_t usage_start;
+#endif
 };
 
 typedef struct _cpu _cpu_t;
@@ -185,26 +185,125 @@ extern "C" {
 		}							 \
 	} while (false)
 
+/** @brief Mask used when string arguments cannot be identified at build time.
+ */
+#define Z_LOG_STR_MASK_UNKNOWN BIT_MASK(LOG_MAX_NARGS)
+
+#ifdef __cplusplus
+#define Z_LOG_STR_ARGS_MASK(...) Z_LOG_STR_MASK_UNKNOWN
+#else
+/** @brief Evaluates to true if argument has a character string type. Argument
+ *	  is not evaluated.
+ *
+ * Type is taken from (_x) + 0 rather than _x: __typeof__ is rejected on
+ * bit-fields, and the addition also decays character arrays to pointers.
+ */
+#define Z_LOG_IS_STR(_x)						    \
+	(__builtin_types_compatible_p(__typeof__((_x) + 0), char *) ||	    \
+	 __builtin_types_compatible_p(__typeof__((_x) + 0), const char *))
+
+#define Z_LOG_STR_BIT(_i, _x) (Z_LOG_IS_STR(_x) ? BIT(_i) : 0)
+
+#define Z_LOG_STR_MASK_1(_i, _x, ...)  Z_LOG_STR_BIT(_i, _x)
+#define Z_LOG_STR_MASK_2(_i, _x, ...)  (Z_LOG_STR_BIT(_i, _x) | \
+				       Z_LOG_STR_MASK_1(_i + 1, __VA_ARGS__))
+#define Z_LOG_STR_MASK_3(_i, _x, ...)  (Z_LOG_STR_BIT(_i, _x) | \
+				       Z_LOG_STR_MASK_2(_i + 1, __VA_ARGS__))
+#define Z_LOG_STR_MASK_4(_i, _x, ...)  (Z_LOG_STR_BIT(_i, _x) | \
+				       Z_LOG_STR_MASK_3(_i + 1, __VA_ARGS__))
+#define Z_LOG_STR_MASK_5(_i, _x, ...)  (Z_LOG_STR_BIT(_i, _x) | \
+				       Z_LOG_STR_MASK_4(_i + 1, __VA_ARGS__))
+#define Z_LOG_STR_MASK_6(_i, _x, ...)  (Z_LOG_STR_BIT(_i, _x) | \
+				       Z_LOG_STR_MASK_5(_i + 1, __VA_ARGS__))
+#define Z_LOG_STR_MASK_7(_i, _x, ...)  (Z_LOG_STR_BIT(_i, _x) | \
+				       Z_LOG_STR_MASK_6(_i + 1, __VA_ARGS__))
+#define Z_LOG_STR_MASK_8(_i, _x, ...)  (Z_LOG_STR_BIT(_i, _x) | \
+				       Z_LOG_STR_MASK_7(_i + 1, __VA_ARGS__))
+#define Z_LOG_STR_MASK_9(_i, _x, ...)  (Z_LOG_STR_BIT(_i, _x) | \
+				       Z_LOG_STR_MASK_8(_i + 1, __VA_ARGS__))
+#define Z_LOG_STR_MASK_10(_i, _x, ...) (Z_LOG_STR_BIT(_i, _x) | \
+				       Z_LOG_STR_MASK_9(_i + 1, __VA_ARGS__))
+#define Z_LOG_STR_MASK_11(_i, _x, ...) (Z_LOG_STR_BIT(_i, _x) | \
+				       Z_LOG_STR_MASK_10(_i + 1, __VA_ARGS__))
+#define Z_LOG_STR_MASK_12(_i, _x, ...) (Z_LOG_STR_BIT(_i, _x) | \
+				       Z_LOG_STR_MASK_11(_i + 1, __VA_ARGS__))
+#define Z_LOG_STR_MASK_13(_i, _x, ...) (Z_LOG_STR_BIT(_i, _x) | \
+				       Z_LOG_STR_MASK_12(_i + 1, __VA_ARGS__))
+#define Z_LOG_STR_MASK_14(_i, _x, ...) (Z_LOG_STR_BIT(_i, _x) | \
+				       Z_LOG_STR_MASK_13(_i + 1, __VA_ARGS__))
+#define Z_LOG_STR_MASK_15(_i, _x, ...) (Z_LOG_STR_BIT(_i, _x) | \
+				       Z_LOG_STR_MASK_14(_i + 1, __VA_ARGS__))
+
+/** @brief Build time mask of arguments which have a character string type.
+ *
+ * Arguments are not evaluated.
+ */
+#define Z_LOG_STR_ARGS_MASK(...) \
+	UTIL_CAT(Z_LOG_STR_MASK_, NUM_VA_ARGS_LESS_1(_, __VA_ARGS__)) \
+		(0, __VA_ARGS__, )
+#endif /* __cplusplus */
+
+/** @brief Check string arguments for missing log_strdup().
+ *
+ * Check is performed in the context of the log call and only if at least one
+ * argument is a character string. Mask is resolved at build time so the check
+ * is removed for messages without string arguments.
+ */
+#define Z_LOG_STRDUP_CHECK(_str, _args, _mask)				\
+	do {								\
+		if (IS_ENABLED(CONFIG_LOG_DETECT_MISSED_STRDUP) &&	\
+		    ((_mask) != 0U)) {					\
+			log_strdup_check(_str, _args, ARRAY_SIZE(_args),\
+					 _mask);			\
+		}							\
+	} while (false)
+
 #define _LOG_INTERNAL_0(_src_level, _str) \
 	log_0(_str, _src_level)
 
-#define _LOG_INTERNAL_1(_src_level, _str, _arg0) \
-	log_1(_str, (log_arg_t)(_arg0), _src_level)
+#define _LOG_INTERNAL_1(_src_level, _str, _arg0)			 \
+	do {								 \
+		log_arg_t z_log_args[] = {(log_arg_t)(_arg0)};		 \
+									 \
+		Z_LOG_STRDUP_CHECK(_str, z_log_args,			 \
+				   Z_LOG_STR_ARGS_MASK(_arg0));		 \
+		log_1(_str, z_log_args[0], _src_level);			 \
+	} while (false)
 
-#define _LOG_INTERNAL_2(_src_level, _str, _arg0, _arg1)	\
-	log_2(_str, (log_arg_t)(_arg0), (log_arg_t)(_arg1), _src_level)
+#define _LOG_INTERNAL_2(_src_level, _str, _arg0, _arg1)		 \
+	do {								 \
+		log_arg_t z_log_args[] = {(log_arg_t)(_arg0),		 \
+					  (log_arg_t)(_arg1)};		 \
+									 \
+		Z_LOG_STRDUP_CHECK(_str, z_log_args,			 \
+				   Z_LOG_STR_ARGS_MASK(_arg0, _arg1));	 \
+		log_2(_str, z_log_args[0], z_log_args[1], _src_level);	 \
+	} while (false)
 
-#define _LOG_INTERNAL_3(_src_level, _str, _arg0, _arg1, _arg2) \
-	log_3(_str, (log_arg_t)(_arg0), (log_arg_t)(_arg1), (log_arg_t)(_arg2), _src_level)
+#define _LOG_INTERNAL_3(_src_level, _str, _arg0, _arg1, _arg2)	 \
+	do {								 \
+		log_arg_t z_log_args[] = {(log_arg_t)(_arg0),		 \
+					  (log_arg_t)(_arg1),		 \
+					  (log_arg_t)(_arg2)};		 \
+									 \
+		Z_LOG_STRDUP_CHECK(_str, z_log_args,			 \
+			Z_LOG_STR_ARGS_MASK(_arg0, _arg1, _arg2));	 \
+		log_3(_str, z_log_args[0], z_log_args[1], z_log_args[2], \
+		      _src_level);					 \
+	} while (false)
 
 #define __LOG_ARG_CAST(_x) (log_arg_t)(_x),
 
 #define __LOG_ARGUMENTS(...) MACRO_MAP(__LOG_ARG_CAST, __VA_ARGS__)
 
-#define _LOG_INTERNAL_LONG(_src_level, _str, ...)		  \
-	do {							  \
-		log_arg_t args[] = {__LOG_ARGUMENTS(__VA_ARGS__)};\
-		log_n(_str, args, ARRAY_SIZE(args), _src_level);  \
+#define _LOG_INTERNAL_LONG(_src_level, _str, ...)			 \
+	do {								 \
+		log_arg_t z_log_args[] = {__LOG_ARGUMENTS(__VA_ARGS__)}; \
+									 \
+		Z_LOG_STRDUP_CHECK(_str, z_log_args,			 \
+				   Z_LOG_STR_ARGS_MASK(__VA_ARGS__));	 \
+		log_n(_str, z_log_args, ARRAY_SIZE(z_log_args),		 \
+		      _src_level);					 \
 	} while (false)
 
 #define Z_LOG_LEVEL_CHECK(_level, _check_level, _default_level) \
@@ -595,6 +694,18 @@ void log_generic_from_user(struct log_msg_ids src_level,
  */
 bool log_is_strdup(const void *buf);
 
+/** @brief Report string arguments which are neither in read only memory nor
+ *	  duplicated with log_strdup().
+ *
+ * @param str	Format string.
+ * @param args	Arguments.
+ * @param nargs	Number of arguments.
+ * @param mask	Mask of arguments which may be strings. Only arguments
+ *		which are also matched by %s specifier are checked.
+ */
+void log_strdup_check(const char *str, log_arg_t *args, u32_t nargs,
+		      u32_t mask);
+
 /** @brief Free allocated buffer.
  *
  * @param buf Buffer.
@@ -49,6 +49,11 @@ extern "C" {
  */
 #define LOG_OUTPUT_FLAG_FORMAT_SYST		BIT(7)
 
+/** @brief Flag forcing binary dictionary format. Strings are not formatted
+ *	   on the target and must be decoded on the host using the ELF file.
+ */
+#define LOG_OUTPUT_FLAG_FORMAT_DICT		BIT(8)
+
 /**
  * @brief Prototype of the function processing output data.
  *
@@ -153,6 +158,16 @@ void log_output_hexdump(const struct log_output *log_output,
  */
 void log_output_dropped_process(const struct log_output *log_output, u32_t cnt);
 
+/** @brief Process dropped messages indication in dictionary format.
+ *
+ * Function emits binary frame indicating lost log messages.
+ *
+ * @param log_output Pointer to the log output instance.
+ * @param cnt        Number of dropped messages.
+ */
+void log_output_dropped_dict_process(const struct log_output *log_output,
+				     u32_t cnt);
+
 /** @brief Flush output buffer.
  *
  * @param log_output Pointer to the log output instance.
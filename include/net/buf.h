@@ -843,7 +843,8 @@ extern const struct net_buf_data_cb net_buf_fixed_cb;
  */
 #define NET_BUF_POOL_FIXED_DEFINE(_name, _count, _data_size, _destroy)        \
 	static struct net_buf net_buf_##_name[_count] __noinit;               \
-	static u8_t __noinit net_buf_data_##_name[_count][_data_size];        \
+	static u8_t __noinit net_buf_data_##_name[_count][_data_size]         \
+		__net_buf_align;                                              \
 	static const struct net_buf_pool_fixed net_buf_fixed_##_name = {      \
 		.data_size = _data_size,                                      \
 		.data_pool = (u8_t *)net_buf_data_##_name,                    \
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief CoAP block-wise transfer engine.
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_COAP_BLOCKWISE_H_
+#define ZEPHYR_INCLUDE_NET_COAP_BLOCKWISE_H_
+
+/**
+ * @addtogroup coap COAP Library
+ * @{
+ */
+
+#include <net/coap.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct coap_blockwise;
+
+/**
+ * @typedef coap_blockwise_send_t
+ * @brief Callback used to send a block request, and its retransmissions,
+ * to the server.
+ *
+ * @param bw Block-wise transfer
+ * @param data Encoded CoAP request
+ * @param len Length of the request
+ *
+ * @return 0 in case of success or negative in case of error.
+ */
+typedef int (*coap_blockwise_send_t)(struct coap_blockwise *bw,
+				     const u8_t *data, u16_t len);
+
+/**
+ * @typedef coap_blockwise_cb_t
+ * @brief Callback used to deliver the resource, block after block in order.
+ *
+ * @param bw Block-wise transfer
+ * @param status 0 for data, negative if the transfer failed, or the CoAP
+ *        response code of an error response
+ * @param offset Offset of the data in the resource
+ * @param data Block payload, NULL if the transfer failed
+ * @param len Length of the block payload
+ * @param last True when the transfer is finished
+ */
+typedef void (*coap_blockwise_cb_t)(struct coap_blockwise *bw, int status,
+				    size_t offset, const u8_t *data, u16_t len,
+				    bool last);
+
+/**
+ * @brief A block request in flight, or a block received before the
+ * blocks preceding it.
+ */
+struct coap_blockwise_slot {
+	struct coap_pending pending;
+	s64_t deadline;
+	u32_t num;
+	u16_t payload_len;
+	u8_t code;
+	u8_t state;
+	u8_t acked;
+	u8_t token[8];
+	u8_t request[CONFIG_COAP_BLOCKWISE_REQUEST_LEN];
+	u8_t payload[CONFIG_COAP_BLOCKWISE_BLOCK_SIZE];
+};
+
+/**
+ * @brief Represents a block-wise (Block2) download of a resource.
+ */
+struct coap_blockwise {
+	/** Server address, given to the pending requests */
+	struct sockaddr addr;
+	const char * const *path;
+	coap_blockwise_send_t send;
+	coap_blockwise_cb_t cb;
+	void *user_data;
+	enum coap_block_size block_size;
+	u32_t next_num;
+	u32_t deliver_num;
+	u32_t last_num;
+	bool active;
+	struct coap_blockwise_slot slots[CONFIG_COAP_BLOCKWISE_NSTART];
+};
+
+/**
+ * @brief Starts the download of a resource with GET requests carrying the
+ * Block2 option.
+ *
+ * The first block is requested alone, the server may choose a smaller
+ * block size in its response. Afterwards up to
+ * CONFIG_COAP_BLOCKWISE_NSTART blocks are requested at the same time. The
+ * resource is delivered in order to the callback.
+ *
+ * The application passes the responses it receives to
+ * coap_blockwise_received(), acknowledges confirmable (separate)
+ * responses itself, and calls coap_blockwise_cycle() when the timeout it
+ * returned expires.
+ *
+ * @param bw Block-wise transfer to start
+ * @param addr Server address
+ * @param path NULL terminated Uri-Path segments of the resource
+ * @param block_size Requested block size, at most
+ *        CONFIG_COAP_BLOCKWISE_BLOCK_SIZE bytes
+ * @param send Callback sending the requests
+ * @param cb Callback receiving the resource
+ * @param user_data User data of the transfer
+ *
+ * @return 0 in case of success or negative in case of error.
+ */
+int coap_blockwise_get(struct coap_blockwise *bw, const struct sockaddr *addr,
+		       const char * const *path,
+		       enum coap_block_size block_size,
+		       coap_blockwise_send_t send, coap_blockwise_cb_t cb,
+		       void *user_data);
+
+/**
+ * @brief Processes a response received from the server.
+ *
+ * @param bw Block-wise transfer
+ * @param response Parsed response
+ *
+ * @return 0 if the response belongs to the transfer, -ENOENT otherwise.
+ */
+int coap_blockwise_received(struct coap_blockwise *bw,
+			    const struct coap_packet *response);
+
+/**
+ * @brief Retransmits the requests whose acknowledgment timed out, and
+ * fails the transfer when a request ran out of retransmissions.
+ *
+ * @param bw Block-wise transfer
+ *
+ * @return Time in ms until the next call, K_FOREVER when no request is
+ *         pending.
+ */
+s32_t coap_blockwise_cycle(struct coap_blockwise *bw);
+
+/**
+ * @brief Stops a transfer, the callback is not called.
+ *
+ * @param bw Block-wise transfer
+ */
+void coap_blockwise_cancel(struct coap_blockwise *bw);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_COAP_BLOCKWISE_H_ */
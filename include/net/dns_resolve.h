@@ -157,6 +157,48 @@ typedef void (*dns_resolve_cb_t)(enum dns_resolve_status status,
 				 struct dns_addrinfo *info,
 				 void *user_data);
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/**
+ * DNS resolver cache statistics.
+ */
+struct dns_cache_stats {
+	/** Queries answered with cached addresses */
+	u32_t hits;
+
+	/** Queries answered with a cached failure */
+	u32_t negative_hits;
+
+	/** Queries sent to the servers */
+	u32_t misses;
+
+	/** Valid entries replaced to make room */
+	u32_t evictions;
+};
+
+/**
+ * DNS resolver cache entry.
+ */
+struct dns_cache_entry {
+	/** Uptime in ms when the entry expires, 0 if the entry is free */
+	s64_t expiry;
+
+	/** Resolved name */
+	char name[CONFIG_DNS_RESOLVER_CACHE_NAME_LEN + 1];
+
+	/** Query type */
+	enum dns_query_type query_type;
+
+	/** 0 for addresses, otherwise the cached final status */
+	int status;
+
+	/** Number of cached addresses */
+	u8_t count;
+
+	/** Cached addresses */
+	struct sockaddr addrs[CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRS];
+};
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 /**
  * DNS resolve context structure.
  */
@@ -208,8 +250,33 @@ struct dns_resolve_context {
 
 		/** DNS id of this query */
 		u16_t id;
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+		/** Lowest TTL of the answers so far, in seconds */
+		u32_t cache_ttl;
+
+		/** Number of addresses collected for the cache */
+		u8_t cache_count;
+
+		/** Addresses collected for the cache */
+		struct sockaddr cache_addrs[CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRS];
+#endif
 	} queries[CONFIG_DNS_NUM_CONCUR_QUERIES];
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	/** Cache of the answers, with their TTL */
+	struct {
+		/** Protects the entries and statistics */
+		struct k_mutex lock;
+
+		/** Cached answers */
+		struct dns_cache_entry entries[CONFIG_DNS_RESOLVER_CACHE_SIZE];
+
+		/** Cache statistics */
+		struct dns_cache_stats stats;
+	} cache;
+#endif
+
 	/** Is this context in use */
 	bool is_used;
 };
@@ -305,6 +372,34 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 		     void *user_data,
 		     s32_t timeout);
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/**
+ * @brief Flush the DNS resolver cache.
+ *
+ * @details Drop all the cached answers of the context, for instance after
+ * a network change. The statistics are kept.
+ *
+ * @param ctx DNS context
+ */
+void dns_resolve_cache_flush(struct dns_resolve_context *ctx);
+
+/**
+ * @brief Get the DNS resolver cache statistics.
+ *
+ * @param ctx DNS context
+ * @param stats Statistics are copied here.
+ *
+ * @return 0 if ok, <0 if error.
+ */
+int dns_resolve_cache_stats_get(struct dns_resolve_context *ctx,
+				struct dns_cache_stats *stats);
+#else
+static inline void dns_resolve_cache_flush(struct dns_resolve_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 /**
  * @brief Get default DNS context.
  *
@@ -126,6 +126,9 @@ enum ethernet_hw_caps {
 
 	/** VLAN Tag stripping */
 	ETHERNET_HW_VLAN_TAG_STRIP	= BIT(14),
+
+	/** TCP segmentation offload supported, see net_pkt_gso_size() */
+	ETHERNET_HW_TX_TSO		= BIT(15),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -263,6 +266,19 @@ struct ethernet_api {
 
 	/** Send a network packet */
 	int (*send)(struct device *dev, struct net_pkt *pkt);
+
+#if defined(CONFIG_NET_ETHERNET_RX_POLL)
+	/** Receive at most budget frames, passing them to net_recv_data(),
+	 * and return the number of frames received. This is called from
+	 * the polling thread after the driver called net_eth_rx_schedule().
+	 */
+	int (*rx_poll)(struct device *dev, int budget);
+
+	/** Unmask or mask the receive interrupt. Unmasking it while frames
+	 * are pending must raise the interrupt.
+	 */
+	void (*rx_irq_enable)(struct device *dev, bool enable);
+#endif /* CONFIG_NET_ETHERNET_RX_POLL */
 };
 
 /* Make sure that the network interface API is properly setup inside
@@ -359,6 +375,19 @@ struct ethernet_context {
 	 */
 	enum net_l2_flags ethernet_l2_flags;
 
+#if defined(CONFIG_NET_ETHERNET_RX_POLL)
+	struct {
+		/** Polls the driver from the Ethernet receive thread */
+		struct k_work work;
+
+		/** Network interface of the driver */
+		struct net_if *iface;
+
+		/** Maximum number of frames received per poll */
+		int budget;
+	} rx_poll;
+#endif
+
 #if defined(CONFIG_NET_GPTP)
 	/** The gPTP port number for this network device. We need to store the
 	 * port number here so that we do not need to fetch it for every
@@ -658,6 +687,32 @@ void net_eth_carrier_on(struct net_if *iface);
  */
 void net_eth_carrier_off(struct net_if *iface);
 
+#if defined(CONFIG_NET_ETHERNET_RX_POLL)
+/**
+ * @brief Schedule the polled receive of an Ethernet interface.
+ *
+ * Called by a driver implementing rx_poll() from its receive interrupt.
+ * The receive interrupt is masked, and frames are then received from
+ * the Ethernet receive thread, at most the poll budget of the interface
+ * at a time, until rx_poll() returns less than the budget. The interrupt
+ * is then unmasked again.
+ *
+ * @param iface Network interface
+ */
+void net_eth_rx_schedule(struct net_if *iface);
+
+/**
+ * @brief Set the number of frames an Ethernet interface receives per
+ * poll.
+ *
+ * @param iface Network interface
+ * @param budget Maximum number of frames received per poll
+ *
+ * @return 0 if ok, -EINVAL if the budget or the interface is invalid
+ */
+int net_eth_set_rx_poll_budget(struct net_if *iface, int budget);
+#endif /* CONFIG_NET_ETHERNET_RX_POLL */
+
 /**
  * @brief Set promiscuous mode either ON or OFF.
  *
@@ -108,6 +108,14 @@ struct http_response {
 	/** Where the body starts */
 	u8_t *body_start;
 
+	/** Body data parsed for this callback call, the body is streamed
+	 * through the bounded recv_buf in fragments like this one.
+	 */
+	u8_t *body_frag_start;
+
+	/** Length of the body data parsed for this callback call */
+	size_t body_frag_len;
+
 	/** Where the response is stored, this is to be
 	 * provided by the user.
 	 */
@@ -148,14 +156,12 @@ struct http_response {
 	u8_t cl_present : 1;
 	u8_t body_found : 1;
 	u8_t message_complete : 1;
+	u8_t body_skipped : 1;
 };
 
 /** HTTP client internal data that the application should not touch
  */
 struct http_client_internal_data {
-	/** Work for handling timeout */
-	struct k_delayed_work work;
-
 	/** HTTP parser context */
 	struct http_parser parser;
 
@@ -278,6 +284,67 @@ struct http_request {
 int http_client_req(int sock, struct http_request *req,
 		    s32_t timeout, void *user_data);
 
+/**
+ * @brief Send several HTTP requests on a connection before reading the
+ * responses (HTTP/1.1 pipelining). The responses are parsed in order, each
+ * into the receive buffer of its request, and the data received after one
+ * response is carried over to the next request. All the receive buffers
+ * should have the same size, so that the carried data always fits.
+ * The requests must not depend on each other, and the server must support
+ * persistent connections.
+ *
+ * @param sock Socket id of the connection.
+ * @param reqs Requests to send, in order.
+ * @param count Number of requests.
+ * @param timeout Max timeout to wait for all the responses.
+ * @param user_data User specified data that is passed to the callbacks.
+ *
+ * @return <0 if error, >=0 amount of data sent to the server
+ */
+int http_client_req_pipeline(int sock, struct http_request **reqs,
+			     size_t count, s32_t timeout, void *user_data);
+
+#if defined(CONFIG_HTTP_CLIENT_POOL)
+/**
+ * @typedef http_conn_setup_cb_t
+ * @brief Callback called for a new pooled connection after the socket is
+ * created and before it is connected, for example to set the TLS
+ * credentials and hostname.
+ *
+ * @param sock Socket id of the connection
+ * @param user_data User specified data specified in http_client_conn_get()
+ *
+ * @return 0 if ok, <0 to abort the connection.
+ */
+typedef int (*http_conn_setup_cb_t)(int sock, void *user_data);
+
+/**
+ * @brief Get a connection to host:port from the connection pool. An idle
+ * connection to the same server is reused if it is still open, otherwise
+ * a new connection is created, replacing the connection idle for the
+ * longest time if the pool is full.
+ *
+ * @param host Server host name or address.
+ * @param port Server port, for example "443".
+ * @param proto Socket protocol, IPPROTO_TCP or one of the TLS protocols.
+ * @param setup_cb Called before connecting a new socket, may be NULL.
+ * @param user_data User specified data that is passed to setup_cb.
+ *
+ * @return Socket id of the connection, or <0 if error.
+ */
+int http_client_conn_get(const char *host, const char *port, int proto,
+			 http_conn_setup_cb_t setup_cb, void *user_data);
+
+/**
+ * @brief Return a connection to the pool once the requests are done. The
+ * connection is closed if the last response did not allow keeping it
+ * open. The socket must not be used after this call.
+ *
+ * @param sock Socket id returned by http_client_conn_get().
+ */
+void http_client_conn_put(int sock);
+#endif /* CONFIG_HTTP_CLIENT_POOL */
+
 #ifdef __cplusplus
 }
 #endif
@@ -435,6 +435,22 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	u32_t remaining_payload;
+
+#if defined(CONFIG_MQTT_LIB_TX_BATCH)
+	/** Internal. Length of the queued PUBLISH packets. */
+	u32_t tx_batch_len;
+
+	/** Internal. Queued PUBLISH packets. */
+	u8_t tx_batch[CONFIG_MQTT_LIB_TX_BATCH_SIZE];
+#endif
+
+#if CONFIG_MQTT_LIB_TX_INFLIGHT_MAX > 0
+	/** Internal. Number of unacknowledged QoS 1 and QoS 2 messages. */
+	u32_t inflight_count;
+
+	/** Internal. Message ids of the unacknowledged messages. */
+	u16_t inflight[CONFIG_MQTT_LIB_TX_INFLIGHT_MAX];
+#endif
 };
 
 /**
@@ -573,6 +589,24 @@ int mqtt_connect(struct mqtt_client *client);
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
 
+/**
+ * @brief API to write the queued PUBLISH packets to the transport.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ *
+ * @note
+ *       @rst
+ *          With :option:`CONFIG_MQTT_LIB_TX_BATCH`, :c:func:`mqtt_publish()`
+ *          queues the packets, which are written when the queue is full,
+ *          before any other packet and from :c:func:`mqtt_live()`. Without
+ *          it this function does nothing.
+ *       @endrst
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ */
+int mqtt_publish_flush(struct mqtt_client *client);
+
 /**
  * @brief API used by client to send acknowledgment on receiving QoS1 publish
  *        message. Should be called on reception of @ref MQTT_EVT_PUBLISH with
@@ -292,6 +292,11 @@ struct net_context {
 	int can_filter_id;
 #endif /* CONFIG_NET_SOCKETS_CAN */
 
+#if defined(CONFIG_NET_CONTEXT_STATISTICS)
+	/** Statistics of the context, one copy for each CPU */
+	struct net_stats_context stats[CONFIG_MP_NUM_CPUS];
+#endif /* CONFIG_NET_CONTEXT_STATISTICS */
+
 	/** Option values */
 	struct {
 #if defined(CONFIG_NET_CONTEXT_PRIORITY)
@@ -980,6 +985,35 @@ int net_context_sendmsg(struct net_context *context,
 			s32_t timeout,
 			void *user_data);
 
+/**
+ * @brief Send a network buffer chain without copying it.
+ *
+ * @details The fragments are linked into the outgoing packet after its
+ * protocol headers as they are, so they can reference external memory,
+ * see net_buf_alloc_with_data(). The caller's reference to @a frags is
+ * consumed, whatever the outcome. The data must stay valid and unchanged
+ * until the fragments are freed after transmission, which the destroy
+ * callback of their pool can be used to detect. The payload must fit in
+ * the MTU of the network interface. Only UDP is supported.
+ *
+ * @param context The network context to use.
+ * @param frags The data to send
+ * @param dst_addr Destination address, NULL for a connected context.
+ * @param addrlen Length of the address.
+ * @param cb Caller-supplied callback function.
+ * @param timeout Currently this value is not used.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_send_buf(struct net_context *context,
+			 struct net_buf *frags,
+			 const struct sockaddr *dst_addr,
+			 socklen_t addrlen,
+			 net_context_send_cb_t cb,
+			 s32_t timeout,
+			 void *user_data);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
@@ -1049,6 +1083,14 @@ enum net_context_option {
 	NET_OPT_TIMESTAMP	= 2,
 	NET_OPT_TXTIME		= 3,
 	NET_OPT_SOCKS5		= 4,
+	/** Maximum number of network data buffers (u16_t) held by the
+	 * packets of the context, 0 for no limit.
+	 */
+	NET_OPT_BUF_QUOTA	= 5,
+	/** Statistics of the context (struct net_stats_context), can only
+	 * be read.
+	 */
+	NET_OPT_STATS		= 6,
 };
 
 /**
@@ -221,6 +221,15 @@ void net_analyze_stack(const char *name, const char *stack, size_t size);
 #define NET_TC_COUNT 1
 #endif /* CONFIG_NET_TC_TX_COUNT && CONFIG_NET_TC_RX_COUNT */
 
+#if defined(CONFIG_NET_RX_QUEUE_COUNT)
+#define NET_RX_QUEUE_COUNT CONFIG_NET_RX_QUEUE_COUNT
+#else
+#define NET_RX_QUEUE_COUNT 1
+#endif
+
+/* Each Rx traffic class has NET_RX_QUEUE_COUNT queues */
+#define NET_RX_QUEUES (NET_TC_RX_COUNT * NET_RX_QUEUE_COUNT)
+
 /* @endcond */
 
 /**
@@ -404,6 +404,23 @@ struct net_traffic_class {
 	int tc;
 };
 
+#if defined(CONFIG_NET_BUF_QUOTA)
+/**
+ * @brief Limit on the network data buffers held by the packets of an
+ * interface or of a network context.
+ */
+struct net_buf_quota {
+	/** Number of buffers charged to the quota */
+	atomic_t used;
+
+	/** Maximum number of buffers, 0 if there is no limit */
+	u16_t limit;
+
+	/** Given when buffers are released or the limit changes */
+	struct k_sem released;
+};
+#endif /* CONFIG_NET_BUF_QUOTA */
+
 /**
  * @brief Network Interface Device structure
  *
@@ -469,6 +486,11 @@ struct net_if {
 
 	/** Network interface instance configuration */
 	struct net_if_config config;
+
+#if defined(CONFIG_NET_BUF_QUOTA)
+	/** Network data buffers held by the packets of this interface */
+	struct net_buf_quota buf_quota;
+#endif /* CONFIG_NET_BUF_QUOTA */
 } __net_if_align;
 
 /**
@@ -763,6 +785,23 @@ static inline void net_if_set_mtu(struct net_if *iface,
 	iface->if_dev->mtu = mtu;
 }
 
+/**
+ * @brief Set the maximum number of network data buffers that the packets
+ * allocated on an interface can hold at the same time.
+ *
+ * @param iface Pointer to a network interface structure
+ * @param limit Number of buffers, 0 for no limit
+ */
+#if defined(CONFIG_NET_BUF_QUOTA)
+void net_if_set_buf_quota(struct net_if *iface, u16_t limit);
+#else
+static inline void net_if_set_buf_quota(struct net_if *iface, u16_t limit)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(limit);
+}
+#endif /* CONFIG_NET_BUF_QUOTA */
+
 /**
  * @brief Set the infinite status of the network interface address
  *
@@ -1932,6 +1971,17 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface);
  */
 bool net_if_need_calc_tx_checksum(struct net_if *iface);
 
+/**
+ * @brief Check if TCP packets larger than the MTU need to be segmented by
+ * the IP stack before sending, or if the network device can do it itself
+ * (TCP segmentation offload).
+ *
+ * @param iface Network interface
+ *
+ * @return True if the IP stack needs to segment the packets, false otherwise.
+ */
+bool net_if_need_tx_segmentation(struct net_if *iface);
+
 /**
  * @brief Get interface according to index
  *
@@ -309,6 +309,16 @@ static inline int net_mgmt_event_wait_on_iface(struct net_if *iface,
 }
 #endif
 
+/**
+ * @brief Set the work queue running the event callbacks, with
+ *        CONFIG_NET_MGMT_EVENT_WORK_Q.
+ *
+ * @param work_q Work queue to use, or NULL for the system work queue.
+ */
+#ifdef CONFIG_NET_MGMT_EVENT_WORK_Q
+void net_mgmt_event_work_q_set(struct k_work_q *work_q);
+#endif
+
 /**
  * @brief Used by the core of the network stack to initialize the network
  *        event processing.
@@ -97,6 +97,14 @@ struct net_pkt {
 	struct net_if *orig_iface; /* Original network interface */
 #endif
 
+#if defined(CONFIG_NET_BUF_QUOTA)
+	/* Quotas the data buffers of the packet are charged to */
+	struct net_buf_quota *iface_quota;
+	struct net_buf_quota *context_quota;
+	u16_t iface_quota_bufs;
+	u16_t context_quota_bufs;
+#endif
+
 	/* We do not support combination of TXTIME and TXTIME_STATS as the
 	 * same variable is shared in net_pkt.h
 	 */
@@ -204,6 +212,20 @@ struct net_pkt {
 	u8_t priority;
 #endif
 
+#if NET_RX_QUEUE_COUNT > 1
+	/** Flow hash of a received packet, selecting its Rx queue.
+	 * Zero if not yet known.
+	 */
+	u32_t rx_hash;
+#endif
+
+#if defined(CONFIG_NET_TCP_GSO)
+	/** Maximum TCP payload of each segment this packet is to be
+	 * split into when sent. Zero if the packet is sent as is.
+	 */
+	u16_t gso_size;
+#endif
+
 #if defined(CONFIG_NET_VLAN)
 	/* VLAN TCI (Tag Control Information). This contains the Priority
 	 * Code Point (PCP), Drop Eligible Indicator (DEI) and VLAN
@@ -668,6 +690,50 @@ static inline u8_t net_pkt_priority(struct net_pkt *pkt)
 
 #endif /* NET_TC_COUNT > 1 */
 
+#if NET_RX_QUEUE_COUNT > 1
+static inline u32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	return pkt->rx_hash;
+}
+
+/* Drivers of network devices computing a receive side scaling hash
+ * should set it here before passing the packet to net_recv_data(), to
+ * save calculating one in software.
+ */
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, u32_t hash)
+{
+	pkt->rx_hash = hash;
+}
+#else /* NET_RX_QUEUE_COUNT == 1 */
+static inline u32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	return 0;
+}
+
+#define net_pkt_set_rx_hash(...)
+
+#endif /* NET_RX_QUEUE_COUNT > 1 */
+
+#if defined(CONFIG_NET_TCP_GSO)
+static inline u16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, u16_t size)
+{
+	pkt->gso_size = size;
+}
+#else
+static inline u16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return 0;
+}
+
+#define net_pkt_set_gso_size(...)
+
+#endif /* CONFIG_NET_TCP_GSO */
+
 #if defined(CONFIG_NET_VLAN)
 static inline u16_t net_pkt_vlan_tag(struct net_pkt *pkt)
 {
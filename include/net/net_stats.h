@@ -55,6 +55,22 @@ struct net_stats_pkts {
 	net_stats_t rx;
 };
 
+/**
+ * @brief Network context (socket) statistics.
+ */
+struct net_stats_context {
+	/** Number of bytes sent and received */
+	struct net_stats_bytes bytes;
+	/** Number of packets sent and received */
+	struct net_stats_pkts pkts;
+	/** Number of packets that could not be sent */
+	net_stats_t tx_errors;
+	/** Number of received packets that were dropped */
+	net_stats_t rx_drop;
+	/** Number of TCP segments resent */
+	net_stats_t resent;
+};
+
 /**
  * @brief IP layer statistics
  */
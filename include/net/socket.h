@@ -26,6 +26,8 @@
 #include <net/net_ip.h>
 #include <net/dns_resolve.h>
 #include <net/socket_select.h>
+#include <net/socket_epoll.h>
+#include <sys/atomic.h>
 #include <stdlib.h>
 
 #ifdef __cplusplus
@@ -38,6 +40,14 @@ struct zsock_pollfd {
 	short revents;
 };
 
+/** Message of zsock_sendmmsg() and zsock_recvmmsg() */
+struct zsock_mmsghdr {
+	/** Message to send or receive */
+	struct msghdr msg_hdr;
+	/** Number of bytes sent or received */
+	unsigned int msg_len;
+};
+
 /* ZSOCK_POLL* values are compatible with Linux */
 /** zsock_poll: Poll for readability */
 #define ZSOCK_POLLIN 1
@@ -119,6 +129,21 @@ struct zsock_pollfd {
  *    - 1 - server
  */
 #define TLS_DTLS_ROLE 6
+/** Socket option to enable TLS session caching for a client socket. The
+ *  session established by a successful handshake is kept and offered on the
+ *  next connection to the same peer address, so that the server can resume
+ *  it with the session ID or session ticket instead of a full handshake.
+ *  This option accepts and returns an integer:
+ *    - 0 - disabled (default)
+ *    - 1 - enabled
+ *
+ *  Requires CONFIG_NET_SOCKETS_TLS_SESSION_CACHING.
+ */
+#define TLS_SESSION_CACHE 7
+
+/** Values of TLS_SESSION_CACHE socket option. */
+#define TLS_SESSION_CACHE_DISABLED 0
+#define TLS_SESSION_CACHE_ENABLED 1
 
 /** @} */
 
@@ -285,6 +310,33 @@ static inline ssize_t zsock_send(int sock, const void *buf, size_t len,
 __syscall ssize_t zsock_sendmsg(int sock, const struct msghdr *msg,
 				int flags);
 
+struct net_buf;
+
+/**
+ * @brief Send a network buffer chain without copying it
+ *
+ * @details
+ * Like zsock_sendto(), but the data is given as a net_buf fragment
+ * chain which is linked into the outgoing packet as is. Fragments
+ * created with net_buf_alloc_with_data() let data in flash or in DMA
+ * buffers be sent without any copy; it must then stay valid until their
+ * pool's destroy callback is called. The caller's reference to @a frags
+ * is consumed whether the call succeeds or not.
+ *
+ * Only available to supervisor threads, and only for UDP sockets of the
+ * native network stack. The data must fit in a single packet.
+ *
+ * @param sock Socket to send on
+ * @param frags Data to send
+ * @param flags ZSOCK_MSG_DONTWAIT or 0
+ * @param dest_addr Destination address, NULL for a connected socket
+ * @param addrlen Length of @a dest_addr
+ *
+ * @return Number of bytes sent, or -1 with errno set on error.
+ */
+ssize_t zsock_send_buf(int sock, struct net_buf *frags, int flags,
+		       const struct sockaddr *dest_addr, socklen_t addrlen);
+
 /**
  * @brief Receive data from an arbitrary network address
  *
@@ -319,6 +371,82 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * @details
+ * @rst
+ * Equivalent to calling zsock_sendmsg() for each of the @a vlen messages
+ * of @a msgvec in turn, setting their ``msg_len`` to the number of bytes
+ * sent, but in a single call. This saves the per-call overhead, notably
+ * that of a system call for user mode threads.
+ * See `Linux man page
+ * <http://man7.org/linux/man-pages/man2/sendmmsg.2.html>`__
+ * for a description of the semantics.
+ * This function is also exposed as ``sendmmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages sent, or -1 with errno set if the first
+ *         one could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive multiple messages from a socket
+ *
+ * @details
+ * @rst
+ * Receive up to @a vlen datagrams in a single call, recording for each
+ * its length in ``msg_len`` and, if ``msg_name`` is set, its source
+ * address as zsock_recvfrom() does. Only the first message is waited
+ * for as @a flags specify, the call then returns with whatever further
+ * messages are already available (the Linux ``MSG_WAITFORONE``
+ * behavior). Each message must have a single iovec.
+ * See `Linux man page
+ * <http://man7.org/linux/man-pages/man2/recvmmsg.2.html>`__
+ * for a description of the semantics.
+ * This function is also exposed as ``recvmmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages received, or -1 with errno set if none
+ *         could be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive data from a socket without copying it
+ *
+ * @details
+ * Like zsock_recvfrom(), but instead of copying the received data into
+ * a buffer, hand the network buffers holding it over to the caller, as
+ * a fragment chain containing nothing but the data. The caller owns
+ * the chain and must release it with net_buf_unref(). As the buffers
+ * are taken from the network stack receive pool, they should be
+ * released as soon as possible.
+ *
+ * A datagram socket returns one whole datagram per call, a stream
+ * socket the data of one received segment.
+ *
+ * Only available to supervisor threads, and only for sockets of the
+ * native network stack (not offloaded or TLS sockets). ZSOCK_MSG_PEEK
+ * is not supported.
+ *
+ * @param sock Socket to receive from
+ * @param frags Set to the received fragment chain, NULL if it is empty
+ * @param flags ZSOCK_MSG_DONTWAIT or 0
+ * @param src_addr Source address of a datagram, as for zsock_recvfrom()
+ * @param addrlen Length of @a src_addr, as for zsock_recvfrom()
+ *
+ * @return Number of bytes in @a frags, 0 at end of stream, or -1 with
+ *         errno set on error.
+ */
+ssize_t zsock_recv_buf(int sock, struct net_buf **frags, int flags,
+		       struct sockaddr *src_addr, socklen_t *addrlen);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -554,6 +682,7 @@ int zsock_getnameinfo(const struct sockaddr *addr, socklen_t addrlen,
 #if defined(CONFIG_NET_SOCKETS_POSIX_NAMES)
 
 #define pollfd zsock_pollfd
+#define mmsghdr zsock_mmsghdr
 
 #if !defined(CONFIG_NET_SOCKETS_OFFLOAD)
 static inline int socket(int family, int type, int proto)
@@ -624,6 +753,18 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline int sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
+static inline int recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
 	return zsock_poll(fds, nfds, timeout);
@@ -780,6 +921,71 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 /** sockopt: Enable SOCKS5 for Socket */
 #define SO_SOCKS5 60
 
+/** sockopt: Socket statistics (struct net_stats_context), Zephyr specific */
+#define SO_NET_STATS 100
+
+/** sockopt: Packet socket level */
+#define SOL_PACKET 263
+
+/* Socket options for SOL_PACKET level */
+/** sockopt: Receive ring (struct zsock_tpacket_req), Zephyr specific layout */
+#define PACKET_RX_RING 5
+
+/** Ring frame status: owned by the network stack */
+#define ZSOCK_TP_STATUS_KERNEL 0
+/** Ring frame status: holds a received frame for the application */
+#define ZSOCK_TP_STATUS_USER BIT(0)
+/** Ring frame status: frames were dropped before this one, the ring being
+ *  full
+ */
+#define ZSOCK_TP_STATUS_LOSING BIT(2)
+
+/** Alignment of the frames of a receive ring */
+#define ZSOCK_TPACKET_ALIGNMENT 16
+
+/**
+ * @brief Receive ring of a packet socket, set with PACKET_RX_RING.
+ *
+ * Unlike Linux, the ring memory is provided by the application instead of
+ * being mapped afterwards. A ring with no frame removes the ring.
+ */
+struct zsock_tpacket_req {
+	/** Ring memory, aligned on ZSOCK_TPACKET_ALIGNMENT */
+	void *tp_buf;
+	/** Size of each frame, a multiple of ZSOCK_TPACKET_ALIGNMENT */
+	unsigned int tp_frame_size;
+	/** Number of frames */
+	unsigned int tp_frame_nr;
+};
+
+/**
+ * @brief Header starting each frame of a receive ring.
+ *
+ * The network stack fills frames in order and hands them over by setting
+ * ZSOCK_TP_STATUS_USER in tp_status. The application gives each frame back
+ * by setting tp_status to ZSOCK_TP_STATUS_KERNEL once read.
+ */
+struct zsock_tpacket_hdr {
+	/** ZSOCK_TP_STATUS_ flags */
+	atomic_t tp_status;
+	/** Length of the received frame */
+	u32_t tp_len;
+	/** Number of bytes of the frame stored in the ring */
+	u32_t tp_snaplen;
+	/** Offset of the frame data from the start of the header */
+	u16_t tp_mac;
+	/** Index of the network interface the frame was received on */
+	u16_t tp_ifindex;
+	/** Reception time, seconds */
+	u32_t tp_sec;
+	/** Reception time, microseconds */
+	u32_t tp_usec;
+};
+
+/** Offset of the frame data in the frames of a receive ring */
+#define ZSOCK_TPACKET_HDRLEN \
+	ROUND_UP(sizeof(struct zsock_tpacket_hdr), ZSOCK_TPACKET_ALIGNMENT)
+
 /** @cond INTERNAL_HIDDEN */
 /**
  * @brief Registration information for a given BSD socket family.
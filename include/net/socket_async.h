@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_ASYNC_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_ASYNC_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct zsock_async;
+
+/**
+ * @brief Socket readiness handler
+ *
+ * @param async Asynchronous wait which completed
+ * @param revents Ready events of the socket, as returned by zsock_poll(),
+ *        or 0 if the wait timed out
+ */
+typedef void (*zsock_async_handler_t)(struct zsock_async *async,
+				      short revents);
+
+/**
+ * @brief Asynchronous wait on a socket
+ *
+ * Embedded in the state of a protocol state machine, it lets the machine
+ * wait for a socket without a thread of its own: the handler is run on a
+ * work queue when the socket is ready, and typically processes the data
+ * and waits again. Many state machines can thus share the thread and
+ * stack of one work queue.
+ */
+struct zsock_async {
+	/** @cond INTERNAL_HIDDEN */
+	struct k_work_poll work;
+	/* The socket event, if the socket has one, then the ready signal */
+	struct k_poll_event events[2];
+	struct k_poll_signal ready;
+	struct k_work_q *work_q;
+	zsock_async_handler_t handler;
+	s32_t timeout;
+	int fd;
+	short wanted;
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize an asynchronous socket wait
+ *
+ * @param async Asynchronous wait
+ * @param handler Function called when a wait completes
+ */
+void zsock_async_init(struct zsock_async *async,
+		      zsock_async_handler_t handler);
+
+/**
+ * @brief Wait asynchronously for a socket to be ready
+ * @details
+ * @rst
+ * Returns at once, the handler being called once on the work queue when
+ * the socket is ready for any of ``events`` (``ZSOCK_POLLIN`` and
+ * ``ZSOCK_POLLOUT``), or with no event once the timeout expired. A new
+ * wait can be started from the handler. At most one wait can be pending
+ * on a given :c:type:`struct zsock_async`. The API is not available to user
+ * mode threads.
+ * @endrst
+ *
+ * @param async Asynchronous wait
+ * @param work_q Work queue running the handler
+ * @param fd Socket to wait for
+ * @param events Events to wait for
+ * @param timeout Timeout in milliseconds, or K_FOREVER
+ *
+ * @return 0 on success, or -1 with errno set.
+ */
+int zsock_async_wait(struct zsock_async *async, struct k_work_q *work_q,
+		     int fd, short events, s32_t timeout);
+
+/**
+ * @brief Cancel an asynchronous socket wait
+ *
+ * @param async Asynchronous wait
+ *
+ * @return 0 if the wait was cancelled, -EINVAL if the handler is already
+ *         pending or running.
+ */
+int zsock_async_cancel(struct zsock_async *async);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_ASYNC_H_ */
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** zsock_epoll_ctl: Register a socket in the epoll instance */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** zsock_epoll_ctl: Remove a socket from the epoll instance */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** zsock_epoll_ctl: Change the events of a registered socket */
+#define ZSOCK_EPOLL_CTL_MOD 3
+
+/** zsock_epoll: Socket is readable, same value as ZSOCK_POLLIN */
+#define ZSOCK_EPOLLIN 1
+/** zsock_epoll: Socket is writable, same value as ZSOCK_POLLOUT */
+#define ZSOCK_EPOLLOUT 4
+/** zsock_epoll: Error condition (output value only) */
+#define ZSOCK_EPOLLERR 8
+/** zsock_epoll: Closed connection (output value only) */
+#define ZSOCK_EPOLLHUP 0x10
+
+typedef union zsock_epoll_data {
+	void *ptr;
+	int fd;
+	u32_t u32;
+} zsock_epoll_data_t;
+
+struct zsock_epoll_event {
+	u32_t events;
+	zsock_epoll_data_t data;
+};
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @details
+ * @rst
+ * Returns a file descriptor for an instance which keeps its sockets
+ * registered with the kernel poll machinery between calls, so that
+ * :c:func:`zsock_epoll_wait()` only processes the sockets which became
+ * ready, unlike :c:func:`zsock_poll()` which prepares every socket on each
+ * call. The instance is released with :c:func:`zsock_close()`.
+ * Sockets are removed from the instances they are registered in when
+ * they are closed with :c:func:`zsock_close()`.
+ * This function is also exposed as ``epoll_create()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @param size Ignored, kept for compatibility, must be positive.
+ *
+ * @return File descriptor, or -1 with errno set.
+ */
+int zsock_epoll_create(int size);
+
+/**
+ * @brief Register, modify or remove a socket of an epoll instance
+ *
+ * @details
+ * @rst
+ * Sockets are always level triggered. At most
+ * :option:`CONFIG_NET_SOCKETS_EPOLL_MAX_FDS` sockets can be registered in
+ * one instance. This must not be called while another thread waits on the
+ * same instance, it blocks until that wait returns.
+ * This function is also exposed as ``epoll_ctl()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @param epfd Epoll instance returned by zsock_epoll_create()
+ * @param op ZSOCK_EPOLL_CTL_ADD, ZSOCK_EPOLL_CTL_MOD or ZSOCK_EPOLL_CTL_DEL
+ * @param fd Socket to operate on
+ * @param event Events to wait for and data returned with them, ignored
+ *        for ZSOCK_EPOLL_CTL_DEL
+ *
+ * @return 0 on success, or -1 with errno set.
+ */
+int zsock_epoll_ctl(int epfd, int op, int fd, struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for events on the sockets of an epoll instance
+ *
+ * @details
+ * @rst
+ * This function is also exposed as ``epoll_wait()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @param epfd Epoll instance returned by zsock_epoll_create()
+ * @param events Array receiving the ready sockets
+ * @param maxevents Size of the events array
+ * @param timeout Timeout in milliseconds, negative to wait forever
+ *
+ * @return Number of ready sockets, 0 on timeout, or -1 with errno set.
+ */
+int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+		     int maxevents, int timeout);
+
+#ifdef CONFIG_NET_SOCKETS_POSIX_NAMES
+
+#define epoll_event zsock_epoll_event
+#define epoll_data_t zsock_epoll_data_t
+
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+#define EPOLLIN ZSOCK_EPOLLIN
+#define EPOLLOUT ZSOCK_EPOLLOUT
+#define EPOLLERR ZSOCK_EPOLLERR
+#define EPOLLHUP ZSOCK_EPOLLHUP
+
+static inline int epoll_create(int size)
+{
+	return zsock_epoll_create(size);
+}
+
+static inline int epoll_ctl(int epfd, int op, int fd,
+			    struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+#endif /* CONFIG_NET_SOCKETS_POSIX_NAMES */
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
@@ -154,7 +154,8 @@ int websocket_send_msg(int ws_sock, const u8_t *payload, size_t payload_len,
  * @brief Receive websocket msg from peer.
  *
  * @details The function will automatically remove websocket header from the
- * message.
+ * message. A message longer than the buffer is returned in several calls,
+ * the data is unmasked in place so it does not need to fit in memory.
  *
  * @param ws_sock Websocket id returned by websocket_connect().
  * @param buf Buffer where websocket data is read.
@@ -41,6 +41,13 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 		 unsigned int msg_prio, const struct timespec *abstime);
 
+/* Zephyr extensions for zero-copy messaging */
+char *mq_alloc_np(mqd_t mqdes);
+int mq_send_np(mqd_t mqdes, char *msg_ptr, size_t msg_len,
+	       unsigned int msg_prio);
+ssize_t mq_receive_np(mqd_t mqdes, char **msg_ptr, unsigned int *msg_prio);
+int mq_free_np(mqd_t mqdes, char *msg_ptr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -48,6 +48,7 @@ typedef struct pthread_mutex {
 	pthread_t owner;
 	u16_t lock_count;
 	int type;
+	atomic_t state;
 	_wait_q_t wait_q;
 } pthread_mutex_t;
 
@@ -76,9 +77,8 @@ typedef struct pthread_barrierattr {
 typedef u32_t pthread_rwlockattr_t;
 
 typedef struct pthread_rwlock_obj {
-	struct k_sem rd_sem;
-	struct k_sem wr_sem;
-	struct k_sem reader_active;/* blocks WR till reader has acquired lock */
+	atomic_t state; /* reader count, writer and waiters flags */
+	_wait_q_t wait_q;
 	s32_t status;
 	k_tid_t wr_owner;
 } pthread_rwlock_t;
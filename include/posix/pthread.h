@@ -163,6 +163,7 @@ static inline int pthread_condattr_destroy(pthread_condattr_t *att)
 	struct pthread_mutex name = \
 	{ \
 		.lock_count = 0, \
+		.state = ATOMIC_INIT(0), \
 		.wait_q = Z_WAIT_Q_INIT(&name.wait_q),	\
 		.owner = NULL, \
 	}
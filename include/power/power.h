@@ -9,6 +9,7 @@
 
 #include <zephyr/types.h>
 #include <stdbool.h>
+#include <sys/dlist.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -212,6 +213,56 @@ extern bool sys_pm_ctrl_is_state_enabled(enum power_states state);
 
 #endif /* CONFIG_SYS_PM_STATE_LOCK */
 
+#ifdef CONFIG_SYS_PM_LATENCY
+/**
+ * @brief Wakeup latency request
+ *
+ * Held by a subsystem for as long as it needs the system to wake up
+ * within a given time, e.g. a radio while a connection is up.
+ */
+struct sys_pm_latency_request {
+	sys_dnode_t node;
+	u32_t latency_us;
+};
+
+/**
+ * @brief Add a wakeup latency constraint
+ *
+ * @details The power management policies skip the power states whose
+ *	    exit latency exceeds the smallest latency requested, until
+ *	    the request is removed.
+ *
+ * @param [in] req Request, owned by the caller until removed.
+ * @param [in] latency_us Maximum wakeup latency in microseconds.
+ */
+extern void sys_pm_latency_request_add(struct sys_pm_latency_request *req,
+				       u32_t latency_us);
+
+/**
+ * @brief Change the latency of a wakeup latency constraint
+ *
+ * @param [in] req Request previously added.
+ * @param [in] latency_us Maximum wakeup latency in microseconds.
+ */
+extern void sys_pm_latency_request_update(struct sys_pm_latency_request *req,
+					  u32_t latency_us);
+
+/**
+ * @brief Remove a wakeup latency constraint
+ *
+ * @param [in] req Request previously added.
+ */
+extern void sys_pm_latency_request_remove(struct sys_pm_latency_request *req);
+
+/**
+ * @brief Get the smallest wakeup latency requested
+ *
+ * @return Latency in microseconds, UINT32_MAX if there is no request.
+ */
+extern u32_t sys_pm_latency_get(void);
+
+#endif /* CONFIG_SYS_PM_LATENCY */
+
 /**
  * @}
  */
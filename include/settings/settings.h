@@ -312,6 +312,55 @@ int settings_save_one(const char *name, const void *value, size_t val_len);
  */
 int settings_delete(const char *name);
 
+#ifdef CONFIG_SETTINGS_TRANSACTION
+
+/**
+ * Start a settings transaction.
+ *
+ * Values set with @ref settings_transaction_set are buffered in RAM until
+ * @ref settings_transaction_commit. The settings lock is held for the
+ * duration of the transaction, other threads saving settings block until
+ * the transaction is committed or aborted.
+ *
+ * @return 0 on success, -EBUSY if a transaction is already in progress.
+ */
+int settings_transaction_begin(void);
+
+/**
+ * Buffer a value in the current transaction.
+ *
+ * Setting the same name again replaces the buffered value. A NULL value or
+ * zero length deletes the item on commit.
+ *
+ * @param name Name/key of the settings item.
+ * @param value Pointer to the value of the settings item.
+ * @param val_len Length of the value.
+ *
+ * @return 0 on success, -EINVAL without an open transaction, -ENOMEM when
+ * the transaction buffer is full.
+ */
+int settings_transaction_set(const char *name, const void *value,
+			     size_t val_len);
+
+/**
+ * Write all buffered values and close the transaction.
+ *
+ * Values equal to the persisted value, and deletes of keys which are not
+ * persisted, are skipped. The remaining values are written in one pass
+ * between the backend save start and end hooks.
+ * The transaction is closed even when a write fails.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_transaction_commit(void);
+
+/**
+ * Drop all buffered values and close the transaction.
+ */
+void settings_transaction_abort(void);
+
+#endif /* CONFIG_SETTINGS_TRANSACTION */
+
 /**
  * Call commit for all settings handler. This should apply all
  * settings which has been set, but not applied yet.
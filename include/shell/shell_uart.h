@@ -27,12 +27,17 @@ struct shell_uart_ctrl_blk {
 	void *context;
 	atomic_t tx_busy;
 	bool blocking_tx;
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+	u8_t rx_bufs[2][CONFIG_SHELL_BACKEND_SERIAL_ASYNC_RX_BUF_SIZE];
+	u8_t rx_buf_idx;
+#endif
 #ifdef CONFIG_MCUMGR_SMP_SHELL
 	struct smp_shell_data smp;
 #endif /* CONFIG_MCUMGR_SMP_SHELL */
 };
 
-#ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
+#if defined(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) || \
+	defined(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)
 #define UART_SHELL_TX_RINGBUF_DECLARE(_name, _size) \
 	RING_BUF_DECLARE(_name##_tx_ringbuf, _size)
 
@@ -45,13 +50,13 @@ struct shell_uart_ctrl_blk {
 
 #define UART_SHELL_RX_TIMER_PTR(_name) NULL
 
-#else /* CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN */
+#else /* CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN || ..._ASYNC */
 #define UART_SHELL_TX_RINGBUF_DECLARE(_name, _size) /* Empty */
 #define UART_SHELL_TX_BUF_DECLARE(_name) /* Empty */
 #define UART_SHELL_RX_TIMER_DECLARE(_name) static struct k_timer _name##_timer
 #define UART_SHELL_TX_RINGBUF_PTR(_name) NULL
 #define UART_SHELL_RX_TIMER_PTR(_name) (&_name##_timer)
-#endif /* CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN */
+#endif /* CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN || ..._ASYNC */
 
 /** @brief Shell UART transport instance structure. */
 struct shell_uart {
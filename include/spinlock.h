@@ -30,14 +30,41 @@ void z_spin_lock_set_owner(struct k_spinlock *l);
 
 struct k_spinlock_key {
 	int key;
+#ifdef CONFIG_SPINLOCK_STATS
+	/* Cycle count at the lock request */
+	u32_t start;
+#endif
 };
 
 typedef struct k_spinlock_key k_spinlock_key_t;
 
+#ifdef CONFIG_SPINLOCK_STATS
+struct k_spinlock_stats {
+	/* Number of times the lock was taken */
+	u32_t acquired;
+
+	/* Number of times the lock had to be waited for */
+	u32_t contended;
+
+	/* Longest time from a lock request to its release, in cycles */
+	atomic_t max_cycles;
+};
+
+struct k_spinlock;
+u32_t z_spin_stats_start(void);
+void z_spin_stats_end(struct k_spinlock *l, u32_t start);
+#endif
+
 struct k_spinlock {
 #ifdef CONFIG_SMP
+#ifdef CONFIG_SPINLOCK_TICKET
+	/* Next ticket to hand out, and ticket allowed to hold the lock */
+	atomic_t next;
+	atomic_t owner;
+#else
 	atomic_t locked;
 #endif
+#endif
 
 #ifdef SPIN_VALIDATE
 	/* Stores the thread that holds the lock with the locking CPU
@@ -46,7 +73,12 @@ struct k_spinlock {
 	uintptr_t thread_cpu;
 #endif
 
-#if defined(CONFIG_CPLUSPLUS) && !defined(CONFIG_SMP) && !defined(SPIN_VALIDATE)
+#ifdef CONFIG_SPINLOCK_STATS
+	struct k_spinlock_stats stats;
+#endif
+
+#if defined(CONFIG_CPLUSPLUS) && !defined(CONFIG_SMP) && \
+	!defined(SPIN_VALIDATE) && !defined(CONFIG_SPINLOCK_STATS)
 	/* If CONFIG_SMP and SPIN_VALIDATE are both not defined
 	 * the k_spinlock struct will have no members. The result
 	 * is that in C sizeof(k_spinlock) is 0 and in C++ it is 1.
@@ -64,6 +96,45 @@ struct k_spinlock {
 #endif
 };
 
+#ifdef CONFIG_SMP
+/* Takes the lock itself, returns true if it had to be waited for */
+static ALWAYS_INLINE bool z_spin_acquire(struct k_spinlock *l)
+{
+	bool waited = false;
+
+#ifdef CONFIG_SPINLOCK_TICKET
+	atomic_val_t ticket = atomic_inc(&l->next);
+
+	while (atomic_get(&l->owner) != ticket) {
+		waited = true;
+	}
+#else
+	while (!atomic_cas(&l->locked, 0, 1)) {
+		waited = true;
+	}
+#endif
+
+	return waited;
+}
+
+static ALWAYS_INLINE void z_spin_drop(struct k_spinlock *l)
+{
+#ifdef CONFIG_SPINLOCK_TICKET
+	/* Hands the lock to the next ticket */
+	(void)atomic_inc(&l->owner);
+#else
+	/* Strictly we don't need atomic_clear() here (which is an
+	 * exchange operation that returns the old value).  We are always
+	 * setting a zero and (because we hold the lock) know the existing
+	 * state won't change due to a race.  But some architectures need
+	 * a memory barrier when used like this, and we don't have a
+	 * Zephyr framework for that.
+	 */
+	atomic_clear(&l->locked);
+#endif
+}
+#endif /* CONFIG_SMP */
+
 static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 {
 	ARG_UNUSED(l);
@@ -79,9 +150,25 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 	__ASSERT(z_spin_lock_valid(l), "Recursive spinlock");
 #endif
 
+#ifdef CONFIG_SPINLOCK_STATS
+	/* Read before taking the lock, the cycle counter may use it */
+	k.start = z_spin_stats_start();
+#endif
+
 #ifdef CONFIG_SMP
-	while (!atomic_cas(&l->locked, 0, 1)) {
+	bool waited = z_spin_acquire(l);
+
+#ifdef CONFIG_SPINLOCK_STATS
+	if (waited) {
+		l->stats.contended++;
 	}
+#else
+	ARG_UNUSED(waited);
+#endif
+#endif
+
+#ifdef CONFIG_SPINLOCK_STATS
+	l->stats.acquired++;
 #endif
 
 #ifdef SPIN_VALIDATE
@@ -99,14 +186,11 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 #endif
 
 #ifdef CONFIG_SMP
-	/* Strictly we don't need atomic_clear() here (which is an
-	 * exchange operation that returns the old value).  We are always
-	 * setting a zero and (because we hold the lock) know the existing
-	 * state won't change due to a race.  But some architectures need
-	 * a memory barrier when used like this, and we don't have a
-	 * Zephyr framework for that.
-	 */
-	atomic_clear(&l->locked);
+	z_spin_drop(l);
+#endif
+
+#ifdef CONFIG_SPINLOCK_STATS
+	z_spin_stats_end(l, key.start);
 #endif
 	arch_irq_unlock(key.key);
 }
@@ -121,7 +205,7 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock!");
 #endif
 #ifdef CONFIG_SMP
-	atomic_clear(&l->locked);
+	z_spin_drop(l);
 #endif
 }
 
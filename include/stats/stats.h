@@ -46,6 +46,14 @@
  *     s<stat-idx>
  *
  * E.g., "s0", "s1", etc.
+ *
+ * With CONFIG_STATS_PER_CPU, each entry is an array holding one counter per
+ * CPU, so that increments on different CPUs never touch the same memory and
+ * need no atomic operation. The first element of the array is the total,
+ * refreshed by stats_walk() and stats_snapshot(): code reading entries at
+ * the offset passed to the walk callback keeps working unchanged. Entries
+ * must then only be updated with the STATS_ macros, and read with
+ * STATS_GET().
  */
 
 #ifndef ZEPHYR_INCLUDE_STATS_STATS_H_
@@ -53,6 +61,10 @@
 
 #include <stddef.h>
 #include <zephyr/types.h>
+#ifdef CONFIG_STATS_PER_CPU
+#include <string.h>
+#include <kernel.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -93,6 +105,15 @@ struct stats_hdr {
  */
 #ifdef CONFIG_STATS
 
+#ifdef CONFIG_STATS_PER_CPU
+/* Total followed by one counter per CPU */
+#define STATS_SLOTS (CONFIG_MP_NUM_CPUS + 1)
+#define Z_STATS_ENTRY(type__, var__) type__ var__[STATS_SLOTS];
+#else
+#define STATS_SLOTS 1
+#define Z_STATS_ENTRY(type__, var__) type__ var__;
+#endif
+
 /**
  * @brief Begins a stats group struct definition.
  *
@@ -107,28 +128,28 @@ struct stats_hdr {
  *
  * @param var__                 The name to assign to the entry.
  */
-#define STATS_SECT_ENTRY(var__) u32_t var__;
+#define STATS_SECT_ENTRY(var__) Z_STATS_ENTRY(u32_t, var__)
 
 /**
  * @brief Declares a 16-bit stat entry inside a group struct.
  *
  * @param var__                 The name to assign to the entry.
  */
-#define STATS_SECT_ENTRY16(var__) u16_t var__;
+#define STATS_SECT_ENTRY16(var__) Z_STATS_ENTRY(u16_t, var__)
 
 /**
  * @brief Declares a 32-bit stat entry inside a group struct.
  *
  * @param var__                 The name to assign to the entry.
  */
-#define STATS_SECT_ENTRY32(var__) u32_t var__;
+#define STATS_SECT_ENTRY32(var__) Z_STATS_ENTRY(u32_t, var__)
 
 /**
  * @brief Declares a 64-bit stat entry inside a group struct.
  *
  * @param var__                 The name to assign to the entry.
  */
-#define STATS_SECT_ENTRY64(var__) u64_t var__;
+#define STATS_SECT_ENTRY64(var__) Z_STATS_ENTRY(u64_t, var__)
 
 /**
  * @brief Increases a statistic entry by the specified amount.
@@ -140,8 +161,18 @@ struct stats_hdr {
  * @param var__                 The statistic entry to increase.
  * @param n__                   The amount to increase the statistic entry by.
  */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_INCN(group__, var__, n__)					\
+	do {								\
+		unsigned int key__ = arch_irq_lock();			\
+									\
+		(group__).var__[1 + _current_cpu->id] += (n__);		\
+		arch_irq_unlock(key__);					\
+	} while (false)
+#else
 #define STATS_INCN(group__, var__, n__)	\
 	((group__).var__ += (n__))
+#endif
 
 /**
  * @brief Increments a statistic entry.
@@ -164,8 +195,31 @@ struct stats_hdr {
  * @param group__               The group containing the entry to clear.
  * @param var__                 The statistic entry to clear.
  */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_CLEAR(group__, var__) \
+	((void)memset((group__).var__, 0, sizeof((group__).var__)))
+#else
 #define STATS_CLEAR(group__, var__) \
 	((group__).var__ = 0)
+#endif
+
+/**
+ * @brief Reads a statistic entry.
+ *
+ * Sums the per-CPU counters of the entry with CONFIG_STATS_PER_CPU.
+ *
+ * @param group__               The group containing the entry to read.
+ * @param var__                 The statistic entry to read.
+ *
+ * @return                      The value of the entry, as a u64_t.
+ */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_GET(group__, var__)					\
+	stats_value_get(&(group__).s_hdr,				\
+			offsetof(__typeof__(group__), var__))
+#else
+#define STATS_GET(group__, var__) ((u64_t)(group__).var__)
+#endif
 
 #define STATS_SIZE_16 (sizeof(u16_t))
 #define STATS_SIZE_32 (sizeof(u32_t))
@@ -173,7 +227,7 @@ struct stats_hdr {
 
 #define STATS_SIZE_INIT_PARMS(group__, size__) \
 	(size__),			       \
-	((sizeof(group__)) - sizeof(struct stats_hdr)) / (size__)
+	((sizeof(group__)) - sizeof(struct stats_hdr)) / ((size__) * STATS_SLOTS)
 
 /**
  * @brief Initializes and registers a statistics group.
@@ -193,7 +247,8 @@ struct stats_hdr {
 	stats_init_and_reg(						 \
 		&(group__).s_hdr,					 \
 		(size__),						 \
-		(sizeof(group__) - sizeof(struct stats_hdr)) / (size__), \
+		(sizeof(group__) - sizeof(struct stats_hdr)) /		 \
+			((size__) * STATS_SLOTS),			 \
 		STATS_NAME_INIT_PARMS(group__),				 \
 		(name__))
 
@@ -293,6 +348,38 @@ typedef int stats_walk_fn(struct stats_hdr *hdr, void *arg,
  */
 int stats_walk(struct stats_hdr *hdr, stats_walk_fn *walk_cb, void *arg);
 
+/**
+ * @brief Reads a stat entry.
+ *
+ * @param hdr                   The stats group containing the entry.
+ * @param off                   The offset of the entry, from `hdr`.
+ *
+ * @return                      The value of the entry, summed over the CPUs
+ *                              with CONFIG_STATS_PER_CPU.
+ */
+u64_t stats_value_get(const struct stats_hdr *hdr, u16_t off);
+
+/**
+ * @brief Exports all registered stats groups in binary form.
+ *
+ * Meant for polling the statistics in a single request, without walking
+ * the names of every entry. The groups are written one after the other,
+ * each as:
+ *
+ * - u8_t: length of the group name, followed by the name, not terminated.
+ * - u8_t: size of the entries, in bytes.
+ * - u16_t: number of entries, little endian.
+ * - The value of each entry, in order and little endian, on the size of
+ *   the entries.
+ *
+ * @param buf                   Destination buffer.
+ * @param size                  Size of the buffer.
+ *
+ * @return                      Number of bytes written;
+ *                              -ENOMEM if the buffer is too small.
+ */
+int stats_snapshot(void *buf, size_t size);
+
 /** @typedef stats_group_walk_fn
  * @brief Function that gets applied to every registered stats group.
  *
@@ -350,6 +437,7 @@ struct stats_hdr *stats_group_find(const char *name);
 #define STATS_INCN(group__, var__, n__)
 #define STATS_INC(group__, var__)
 #define STATS_CLEAR(group__, var__)
+#define STATS_GET(group__, var__) (0)
 #define STATS_INIT_AND_REG(group__, size__, name__) (0)
 
 #endif /* !CONFIG_STATS */
@@ -37,6 +37,25 @@ struct _isr_table_entry {
  */
 extern struct _isr_table_entry _sw_isr_table[];
 
+/**
+ * @brief Call the ISR connected to a _sw_isr_table entry
+ *
+ * With CONFIG_GEN_ISR_DISPATCH, the call is made by code generated at build
+ * time, which calls the ISR directly instead of loading the table entry.
+ *
+ * @param table_idx Index of the entry in _sw_isr_table
+ */
+#ifdef CONFIG_GEN_ISR_DISPATCH
+void z_sw_isr_dispatch(unsigned int table_idx);
+#else
+static inline void z_sw_isr_dispatch(unsigned int table_idx)
+{
+	struct _isr_table_entry *ite = &_sw_isr_table[table_idx];
+
+	ite->isr(ite->arg);
+}
+#endif
+
 /*
  * Data structure created in a special binary .intlist section for each
  * configured interrupt. gen_irq_tables.py pulls this out of the binary and
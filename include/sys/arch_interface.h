@@ -338,6 +338,17 @@ static inline struct _cpu *arch_curr_cpu(void);
  * This will invoke z_sched_ipi() on other CPUs in the system.
  */
 void arch_sched_ipi(void);
+
+#ifdef CONFIG_SCHED_IPI_DIRECTED
+/**
+ * Send an interrupt to a set of CPUs
+ *
+ * This will invoke z_sched_ipi() on the given CPUs.
+ *
+ * @param cpu_bitmap Bitmap of the CPUs to interrupt, by CPU index
+ */
+void arch_sched_directed_ipi(u32_t cpu_bitmap);
+#endif /* CONFIG_SCHED_IPI_DIRECTED */
 #endif /* CONFIG_SMP */
 
 /** @} */
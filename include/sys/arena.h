@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Arena (bump) allocator
+ *
+ * An arena hands out memory by advancing an offset in a buffer and never
+ * frees individual allocations: everything is released at once with
+ * sys_arena_reset(), or back to a point saved with sys_arena_save() for
+ * nested scopes.  This suits request-scoped temporaries, e.g. the many
+ * small objects built while parsing one protocol message, which then cost
+ * a pointer bump each and a single reset when the request is done.
+ *
+ * The arena is either a single static buffer, or a chain of blocks taken
+ * from a k_mem_slab as needed and returned to it on reset.
+ *
+ * Arenas are not thread safe, an arena is expected to be owned by the
+ * context processing the request.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_ARENA_H_
+#define ZEPHYR_INCLUDE_SYS_ARENA_H_
+
+#include <kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Alignment of the memory returned by sys_arena_alloc() */
+#define SYS_ARENA_ALIGN sizeof(long long)
+
+struct sys_arena {
+	/* Slab providing the blocks, NULL for a static buffer */
+	struct k_mem_slab *slab;
+	u8_t *block;
+	size_t size;
+	size_t used;
+};
+
+/** Position in an arena, see sys_arena_save() */
+struct sys_arena_mark {
+	u8_t *block;
+	size_t used;
+};
+
+/**
+ * @brief Statically define an arena backed by a static buffer
+ *
+ * @param name Name of the arena
+ * @param sz Size of the buffer in bytes
+ */
+#define SYS_ARENA_DEFINE(name, sz)					\
+	static u8_t __aligned(SYS_ARENA_ALIGN) _sys_arena_buf_##name[sz]; \
+	struct sys_arena name = {					\
+		.block = _sys_arena_buf_##name,				\
+		.size = (sz),						\
+	}
+
+/**
+ * @brief Statically define an arena backed by a memory slab
+ *
+ * @param name Name of the arena
+ * @param mem_slab Memory slab providing the blocks
+ */
+#define SYS_ARENA_SLAB_DEFINE(name, mem_slab)				\
+	struct sys_arena name = {					\
+		.slab = (mem_slab),					\
+	}
+
+/**
+ * @brief Initialize an arena backed by a buffer
+ *
+ * @param arena Arena
+ * @param buf Buffer
+ * @param size Size of @a buf in bytes
+ */
+void sys_arena_init(struct sys_arena *arena, void *buf, size_t size);
+
+/**
+ * @brief Initialize an arena backed by a memory slab
+ *
+ * Blocks are allocated from @a slab, without waiting, when the current
+ * one is exhausted. A single allocation can't be larger than a slab block
+ * minus a pointer used to chain the blocks.
+ *
+ * @param arena Arena
+ * @param slab Memory slab
+ */
+void sys_arena_init_slab(struct sys_arena *arena, struct k_mem_slab *slab);
+
+/**
+ * @brief Allocate aligned memory from an arena
+ *
+ * @param arena Arena
+ * @param align Alignment, a power of two
+ * @param size Size in bytes
+ *
+ * @return Allocated memory, or NULL if the arena is exhausted
+ */
+void *sys_arena_aligned_alloc(struct sys_arena *arena, size_t align,
+			      size_t size);
+
+/**
+ * @brief Allocate memory from an arena
+ *
+ * Memory is aligned to SYS_ARENA_ALIGN.
+ *
+ * @param arena Arena
+ * @param size Size in bytes
+ *
+ * @return Allocated memory, or NULL if the arena is exhausted
+ */
+static inline void *sys_arena_alloc(struct sys_arena *arena, size_t size)
+{
+	return sys_arena_aligned_alloc(arena, SYS_ARENA_ALIGN, size);
+}
+
+/**
+ * @brief Save the current position of an arena
+ *
+ * Opens a nested scope: sys_arena_restore() releases everything allocated
+ * after the position was saved.
+ *
+ * @param arena Arena
+ *
+ * @return Current position
+ */
+static inline struct sys_arena_mark sys_arena_save(struct sys_arena *arena)
+{
+	struct sys_arena_mark mark = {
+		.block = arena->block,
+		.used = arena->used,
+	};
+
+	return mark;
+}
+
+/**
+ * @brief Release memory allocated after a position was saved
+ *
+ * Positions saved after @a mark become invalid.
+ *
+ * @param arena Arena
+ * @param mark Position returned by sys_arena_save()
+ */
+void sys_arena_restore(struct sys_arena *arena, struct sys_arena_mark mark);
+
+/**
+ * @brief Release all memory allocated from an arena
+ *
+ * Slab blocks are returned to the slab.
+ *
+ * @param arena Arena
+ */
+void sys_arena_reset(struct sys_arena *arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_ARENA_H_ */
@@ -21,6 +21,9 @@ extern "C" {
 typedef int atomic_t;
 typedef atomic_t atomic_val_t;
 
+typedef void *atomic_ptr_t;
+typedef atomic_ptr_t atomic_ptr_val_t;
+
 /**
  * @defgroup atomic_apis Atomic Services APIs
  * @ingroup kernel_apis
@@ -299,6 +302,95 @@ extern atomic_val_t atomic_nand(atomic_t *target, atomic_val_t value);
 #endif
 
 
+/**
+ * @brief Atomic pointer compare-and-set.
+ *
+ * This routine performs an atomic compare-and-set on @a target. If the current
+ * value of @a target equals @a old_value, @a target is set to @a new_value.
+ * If the current value of @a target does not equal @a old_value, @a target
+ * is left unchanged.
+ *
+ * @note Unlike the integer operations, the pointer operations are not
+ * available from user mode when CONFIG_ATOMIC_OPERATIONS_C is used.
+ *
+ * @param target Address of atomic pointer.
+ * @param old_value Original value to compare against.
+ * @param new_value New value to store.
+ * @return true if @a new_value is written, false otherwise.
+ */
+#ifdef CONFIG_ATOMIC_OPERATIONS_BUILTIN
+static inline bool atomic_ptr_cas(atomic_ptr_t *target,
+				  atomic_ptr_val_t old_value,
+				  atomic_ptr_val_t new_value)
+{
+	return __atomic_compare_exchange_n(target, &old_value, new_value,
+					   0, __ATOMIC_SEQ_CST,
+					   __ATOMIC_SEQ_CST);
+}
+#else
+extern bool atomic_ptr_cas(atomic_ptr_t *target, atomic_ptr_val_t old_value,
+			   atomic_ptr_val_t new_value);
+#endif
+
+/**
+ *
+ * @brief Atomic pointer get.
+ *
+ * This routine performs an atomic read on @a target.
+ *
+ * @param target Address of atomic pointer.
+ *
+ * @return Value of @a target.
+ */
+#ifdef CONFIG_ATOMIC_OPERATIONS_BUILTIN
+static inline atomic_ptr_val_t atomic_ptr_get(const atomic_ptr_t *target)
+{
+	return __atomic_load_n(target, __ATOMIC_SEQ_CST);
+}
+#else
+extern atomic_ptr_val_t atomic_ptr_get(const atomic_ptr_t *target);
+#endif
+
+/**
+ *
+ * @brief Atomic pointer get-and-set.
+ *
+ * This routine atomically sets @a target to @a value and returns
+ * the previous value of @a target.
+ *
+ * @param target Address of atomic pointer.
+ * @param value Value to write to @a target.
+ *
+ * @return Previous value of @a target.
+ */
+#ifdef CONFIG_ATOMIC_OPERATIONS_BUILTIN
+static inline atomic_ptr_val_t atomic_ptr_set(atomic_ptr_t *target,
+					      atomic_ptr_val_t value)
+{
+	return __atomic_exchange_n(target, value, __ATOMIC_SEQ_CST);
+}
+#else
+extern atomic_ptr_val_t atomic_ptr_set(atomic_ptr_t *target,
+				       atomic_ptr_val_t value);
+#endif
+
+/**
+ *
+ * @brief Atomic pointer clear.
+ *
+ * This routine atomically sets @a target to NULL and returns its previous
+ * value. (Hence, it is equivalent to atomic_ptr_set(target, NULL).)
+ *
+ * @param target Address of atomic pointer.
+ *
+ * @return Previous value of @a target.
+ */
+static inline atomic_ptr_val_t atomic_ptr_clear(atomic_ptr_t *target)
+{
+	return atomic_ptr_set(target, NULL);
+}
+
+
 /**
  * @brief Initialize an atomic variable.
  *
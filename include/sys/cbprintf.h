@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_CBPRINTF_H_
+#define ZEPHYR_INCLUDE_SYS_CBPRINTF_H_
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup cbprintf_apis Formatted Output APIs
+ * @ingroup support_apis
+ * @{
+ */
+
+/** @brief Required alignment of the buffer given to cbprintf_package(). */
+#define CBPRINTF_PACKAGE_ALIGNMENT 8
+
+/**
+ * @brief Signature of a cbprintf callback function.
+ *
+ * @param c Character to output, converted to unsigned char.
+ * @param ctx Context provided to the formatting function.
+ *
+ * @return A non-negative value on success, EOF (-1) to abort the output.
+ */
+typedef int (*cbprintf_cb)(int c, void *ctx);
+
+/**
+ * @brief Format a string and emit it character by character.
+ *
+ * This is the formatter shared by printk(), the minimal libc printf family,
+ * logging and the shell. Supported are the flags "-+ #0", field width and
+ * precision (also as "*"), the length modifiers hh, h, l, ll, j, z and t,
+ * and the conversions d, i, o, u, x, X, c, s, p, n and %. The conversions
+ * e, E, f, F, g and G are supported with CONFIG_CBPRINTF_FP_SUPPORT.
+ *
+ * Without CONFIG_CBPRINTF_FULL_INTEGRAL, decimal values which do not fit in
+ * a long are printed as "ERR", which avoids 64-bit division on 32-bit
+ * targets. Octal and hexadecimal values are always printed in full.
+ *
+ * @param out Function called for each output character.
+ * @param ctx Context passed to @p out.
+ * @param format Format string.
+ * @param ... Arguments to the format string.
+ *
+ * @return Number of characters output, or EOF if @p out returned EOF.
+ */
+__printf_like(3, 4)
+int cbprintf(cbprintf_cb out, void *ctx, const char *format, ...);
+
+/**
+ * @brief Format a string and emit it character by character, va_list
+ * variant.
+ *
+ * @see cbprintf()
+ *
+ * @param out Function called for each output character.
+ * @param ctx Context passed to @p out.
+ * @param format Format string.
+ * @param ap Arguments to the format string.
+ *
+ * @return Number of characters output, or EOF if @p out returned EOF.
+ */
+__printf_like(3, 0)
+int cbvprintf(cbprintf_cb out, void *ctx, const char *format, va_list ap);
+
+/**
+ * @brief Capture a format string and its arguments for later formatting.
+ *
+ * Arguments are copied to @p packaged in their binary form, which is much
+ * cheaper than formatting them. The package is formatted later, possibly
+ * from another context, with cbpprintf(). Only the pointers of the format
+ * string and of "%s" arguments are stored, the strings must still be valid
+ * when the package is formatted.
+ *
+ * @param packaged Buffer aligned to CBPRINTF_PACKAGE_ALIGNMENT, or NULL to
+ * only compute the size of the package.
+ * @param len Size of @p packaged.
+ * @param format Format string.
+ * @param ... Arguments to the format string.
+ *
+ * @return Size of the package in bytes, or -ENOSPC if @p len is too small.
+ */
+__printf_like(3, 4)
+int cbprintf_package(void *packaged, size_t len, const char *format, ...);
+
+/**
+ * @brief Capture a format string and its arguments, va_list variant.
+ *
+ * @see cbprintf_package()
+ *
+ * @param packaged Buffer aligned to CBPRINTF_PACKAGE_ALIGNMENT, or NULL to
+ * only compute the size of the package.
+ * @param len Size of @p packaged.
+ * @param format Format string.
+ * @param ap Arguments to the format string.
+ *
+ * @return Size of the package in bytes, or -ENOSPC if @p len is too small.
+ */
+__printf_like(3, 0)
+int cbvprintf_package(void *packaged, size_t len, const char *format,
+		      va_list ap);
+
+/**
+ * @brief Format a package created with cbprintf_package().
+ *
+ * @param out Function called for each output character.
+ * @param ctx Context passed to @p out.
+ * @param packaged Package.
+ *
+ * @return Number of characters output, or EOF if @p out returned EOF.
+ */
+int cbpprintf(cbprintf_cb out, void *ctx, const void *packaged);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_CBPRINTF_H_ */
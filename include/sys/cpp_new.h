@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief C++ operator new size-class slabs
+ *
+ * With CONFIG_CPP_NEW_SLABS, operator new serves objects of up to
+ * CPP_NEW_MAX_SLAB_SIZE bytes from one memory slab per size class, in
+ * constant time and without fragmenting the heap. Larger objects, and
+ * objects whose size class is exhausted, are allocated with malloc().
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_CPP_NEW_H_
+#define ZEPHYR_INCLUDE_SYS_CPP_NEW_H_
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of size classes: 16, 32, 64 and 128 bytes */
+#define CPP_NEW_SIZE_CLASSES 4
+
+/** Size of the largest objects allocated from the slabs */
+#define CPP_NEW_MAX_SLAB_SIZE 128
+
+struct cpp_new_stats {
+	/** Allocations made from each size class, from the smallest one */
+	u32_t slab_allocs[CPP_NEW_SIZE_CLASSES];
+	/** Blocks currently allocated from each size class */
+	u32_t slab_used[CPP_NEW_SIZE_CLASSES];
+	/** Allocations made from the heap */
+	u32_t heap_allocs;
+	/** Heap allocations made because the size class was exhausted */
+	u32_t slab_full;
+	/** Failed allocations */
+	u32_t failures;
+};
+
+/**
+ * @brief Get the C++ allocation statistics
+ *
+ * Requires CONFIG_CPP_NEW_STATS.
+ *
+ * @param stats Filled with the counts since boot.
+ */
+void cpp_new_stats_get(struct cpp_new_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_CPP_NEW_H_ */
@@ -143,6 +143,21 @@ u32_t crc32_ieee(const u8_t *data, size_t len);
  */
 u32_t crc32_ieee_update(u32_t crc, const u8_t *data, size_t len);
 
+/**
+ * @brief Update an IEEE conforming CRC32 checksum with a hardware unit.
+ *
+ * Implemented by the driver of a hardware CRC unit which selects
+ * CONFIG_CRC32_IEEE_HW. crc32_ieee_update() then forwards to it, so users
+ * of the CRC API benefit from the hardware transparently.
+ *
+ * @param crc   CRC32 checksum that needs to be updated.
+ * @param *data Pointer to data on which the CRC should be calculated.
+ * @param len   Data length.
+ *
+ * @return CRC32 value.
+ */
+u32_t z_crc32_ieee_hw_update(u32_t crc, const u8_t *data, size_t len);
+
 /**
  * @brief Compute CCITT variant of CRC 8
  *
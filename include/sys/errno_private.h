@@ -25,12 +25,23 @@ extern "C" {
  *
  * @return Memory location of errno data for current thread
  */
+#ifdef CONFIG_ERRNO_IN_TLS
+extern __thread int z_errno_var;
+
+static inline int *z_errno(void)
+{
+	return &z_errno_var;
+}
+#else
 __syscall int *z_errno(void);
+#endif /* CONFIG_ERRNO_IN_TLS */
 
 #ifdef __cplusplus
 }
 #endif
 
+#ifndef CONFIG_ERRNO_IN_TLS
 #include <syscalls/errno_private.h>
+#endif
 
 #endif /* ZEPHYR_INCLUDE_SYS_ERRNO_PRIVATE_H_ */
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief public sys_futex_mutex APIs.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_FUTEX_MUTEX_H_
+#define ZEPHYR_INCLUDE_SYS_FUTEX_MUTEX_H_
+
+/*
+ * sys_futex_mutex is a lightweight lock that can reside in user memory.
+ * When user mode is enabled it is built on a k_futex: locking and
+ * unlocking an uncontended sys_futex_mutex are single atomic operations,
+ * and the kernel is only entered to sleep on, or wake waiters of, a
+ * contended one.  When user mode isn't enabled it behaves like k_mutex.
+ *
+ * Since user threads cannot cheaply identify themselves, the lock does not
+ * record its owner: it is not recursive, unlocking it from a thread that
+ * does not hold it is not detected, and it provides no priority
+ * inheritance with user mode enabled.  Use sys_mutex where those are
+ * needed.
+ */
+
+#include <kernel.h>
+#include <sys/atomic.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * sys_futex_mutex structure
+ */
+struct sys_futex_mutex {
+#ifdef CONFIG_USERSPACE
+	/* 0: unlocked, 1: locked, 2: locked with possible waiters */
+	struct k_futex futex;
+#else
+	struct k_mutex kernel_mutex;
+#endif
+};
+
+/**
+ * @brief Statically define and initialize a sys_futex_mutex
+ *
+ * The mutex can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct sys_futex_mutex <name>; @endcode
+ *
+ * Route this to memory domains using K_APP_DMEM().
+ *
+ * @param _name Name of the mutex.
+ */
+#ifdef CONFIG_USERSPACE
+#define SYS_FUTEX_MUTEX_DEFINE(_name) \
+	struct sys_futex_mutex _name = { \
+		.futex = { 0 } \
+	}
+#else
+#define SYS_FUTEX_MUTEX_DEFINE(_name) \
+	struct sys_futex_mutex _name = { \
+		.kernel_mutex = _K_MUTEX_INITIALIZER(_name.kernel_mutex) \
+	}
+#endif
+
+/**
+ * @brief Initialize a sys_futex_mutex.
+ *
+ * This routine initializes a mutex, prior to its first use. The mutex is
+ * initially unlocked.
+ *
+ * @param mutex Address of the mutex.
+ */
+void sys_futex_mutex_init(struct sys_futex_mutex *mutex);
+
+/**
+ * @brief Lock a sys_futex_mutex.
+ *
+ * This routine locks @a mutex. If the mutex is locked, the calling thread
+ * waits until the mutex becomes available or until a timeout occurs. The
+ * calling thread must not already hold the mutex.
+ *
+ * @param mutex Address of the mutex.
+ * @param timeout Waiting period to lock the mutex (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Mutex locked.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -ETIMEDOUT Waiting period timed out.
+ * @retval -EINVAL Mutex not recognized by the kernel.
+ * @retval -EACCES Caller does not have enough access.
+ */
+int sys_futex_mutex_lock(struct sys_futex_mutex *mutex, s32_t timeout);
+
+/**
+ * @brief Unlock a sys_futex_mutex.
+ *
+ * This routine unlocks @a mutex, which must be held by the calling thread,
+ * and wakes one thread waiting for it, if any.
+ *
+ * @param mutex Address of the mutex.
+ *
+ * @retval 0 Mutex unlocked.
+ * @retval -EINVAL Mutex was not locked, or not recognized by the kernel.
+ * @retval -EACCES Caller does not have enough access.
+ */
+int sys_futex_mutex_unlock(struct sys_futex_mutex *mutex);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
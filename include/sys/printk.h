@@ -24,20 +24,11 @@ extern "C" {
  * This routine prints a kernel debugging message to the system console.
  * Output is send immediately, without any mutual exclusion or buffering.
  *
- * A basic set of conversion specifier characters are supported:
- *   - signed decimal: \%d, \%i
- *   - unsigned decimal: \%u
- *   - unsigned hexadecimal: \%x (\%X is treated as \%x)
- *   - pointer: \%p
- *   - string: \%s
- *   - character: \%c
- *   - percent: \%\%
- *
- * Field width (with or without leading zeroes) is supported.
- * Length attributes h, hh, l, ll and z are supported. However, integral
- * values with %lld and %lli are only printed if they fit in a long
- * otherwise 'ERR' is printed. Full 64-bit values may be printed with %llx.
- * Flags and precision attributes are not supported.
+ * The string is formatted with cbvprintf(), so the flags, field width,
+ * precision and conversions documented for cbprintf() are supported.
+ * Without CONFIG_CBPRINTF_FULL_INTEGRAL, integral values with %lld, %lli
+ * and %llu are only printed if they fit in a long otherwise 'ERR' is
+ * printed. Full 64-bit values may always be printed with %llx.
  *
  * @param fmt Format string.
  * @param ... Optional list of format arguments.
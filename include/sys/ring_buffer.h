@@ -23,6 +23,10 @@ extern "C" {
 
 /**
  * @brief A structure to represent a ring buffer
+ *
+ * A single producer and a single consumer can access the ring buffer
+ * concurrently without locking, e.g. from an interrupt and a thread or from
+ * different CPUs. Use struct ring_buf_mpmc for more producers or consumers.
  */
 struct ring_buf {
 	u32_t head;	 /**< Index in buf for the head element */
@@ -413,6 +417,124 @@ int ring_buf_get_finish(struct ring_buf *buf, u32_t size);
  */
 u32_t ring_buf_get(struct ring_buf *buf, u8_t *data, u32_t size);
 
+/**
+ * @brief A structure to represent a multi-producer multi-consumer ring buffer
+ *
+ * Indices are free-running and the claims in progress are counted in the
+ * low bits of the reservation indices, see ring_buffer.c.
+ */
+struct ring_buf_mpmc {
+	atomic_t put_state; /**< Reserved tail and number of put claims */
+	atomic_t tail;      /**< Tail of the committed data */
+	atomic_t get_state; /**< Reserved head and number of get claims */
+	atomic_t head;      /**< Head of the data not yet freed */
+	u32_t mask;         /**< Modulo mask, size is a power of 2 */
+	u8_t *buf;          /**< Memory region for stored bytes */
+};
+
+/** @brief Maximum size of a multi-producer multi-consumer ring buffer. */
+#define RING_BUF_MPMC_MAX_SIZE BIT(22)
+
+/**
+ * @brief Statically define and initialize a multi-producer multi-consumer
+ * ring buffer for byte data.
+ *
+ * The ring buffer can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct ring_buf_mpmc <name>; @endcode
+ *
+ * @param name Name of the ring buffer.
+ * @param pow  Ring buffer size exponent, the buffer holds 2^pow bytes.
+ */
+#define RING_BUF_MPMC_DECLARE_POW2(name, pow) \
+	BUILD_ASSERT(BIT(pow) <= RING_BUF_MPMC_MAX_SIZE); \
+	static u8_t _ring_buffer_data_##name[BIT(pow)]; \
+	struct ring_buf_mpmc name = { \
+		.mask = BIT(pow) - 1, \
+		.buf = _ring_buffer_data_##name \
+	}
+
+/**
+ * @brief Initialize a multi-producer multi-consumer ring buffer.
+ *
+ * This routine initializes a ring buffer, prior to its first use. It is only
+ * used for ring buffers not defined using RING_BUF_MPMC_DECLARE_POW2.
+ *
+ * @param buf Address of ring buffer.
+ * @param size Ring buffer size in bytes, a power of 2 not larger than
+ *	       RING_BUF_MPMC_MAX_SIZE.
+ * @param data Ring buffer data area.
+ */
+static inline void ring_buf_mpmc_init(struct ring_buf_mpmc *buf, u32_t size,
+				      void *data)
+{
+	__ASSERT(is_power_of_two(size) && size <= RING_BUF_MPMC_MAX_SIZE,
+		 "Unsupported size %u", size);
+
+	memset(buf, 0, sizeof(struct ring_buf_mpmc));
+	buf->mask = size - 1;
+	buf->buf = (u8_t *)data;
+}
+
+/**
+ * @brief Allocate buffer for writing data to a multi-producer ring buffer.
+ *
+ * Any number of producers, in threads or interrupts and on any CPU, can
+ * allocate and fill buffers concurrently without locking. The allocated
+ * buffer must be committed with @ref ring_buf_mpmc_put_finish. Data
+ * becomes visible to consumers once all the buffers allocated before it
+ * have been committed too, so a producer preempted between the two calls
+ * delays, but never blocks, the other producers.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested allocation size (in bytes).
+ *
+ * @return Size of allocated buffer which can be smaller than requested if
+ *	   there is not enough free space or buffer wraps. Nothing has to be
+ *	   committed if it is 0.
+ */
+u32_t ring_buf_mpmc_put_claim(struct ring_buf_mpmc *buf, u8_t **data,
+			      u32_t size);
+
+/**
+ * @brief Commit the buffer allocated by @ref ring_buf_mpmc_put_claim.
+ *
+ * The whole allocated buffer is committed, it must have been filled.
+ *
+ * @param buf Address of ring buffer.
+ */
+void ring_buf_mpmc_put_finish(struct ring_buf_mpmc *buf);
+
+/**
+ * @brief Get address of valid data in a multi-consumer ring buffer.
+ *
+ * Any number of consumers can claim data concurrently without locking, each
+ * byte is claimed by a single consumer. The claimed data must be freed with
+ * @ref ring_buf_mpmc_get_finish. Space is given back to the producers once
+ * all the data claimed before it has been freed too.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested size (in bytes).
+ *
+ * @return Number of valid bytes in the provided buffer which can be smaller
+ *	   than requested if there is not enough data or buffer wraps.
+ *	   Nothing has to be freed if it is 0.
+ */
+u32_t ring_buf_mpmc_get_claim(struct ring_buf_mpmc *buf, u8_t **data,
+			      u32_t size);
+
+/**
+ * @brief Free the data claimed by @ref ring_buf_mpmc_get_claim.
+ *
+ * @param buf Address of ring buffer.
+ */
+void ring_buf_mpmc_get_finish(struct ring_buf_mpmc *buf);
+
 /**
  * @}
  */
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Sorted array of pointers
+ *
+ * This implements an ordered set of pointers stored contiguously in a
+ * caller-provided array, with the same usage as the red/black tree of
+ * rb.h: elements are user structs compared with a "less than" callback,
+ * and the container only stores pointers to them.
+ *
+ * Lookups are a binary search over a single array, which is much more
+ * cache friendly than chasing tree nodes and needs no stack.  Insertion
+ * and removal move the elements after the modified position, so they
+ * are O(N).  This makes it a good fit for read-mostly sets of moderate
+ * size, a red/black tree remains the better choice for sets which are
+ * modified often or whose size is not bounded.
+ *
+ * Without a callback, elements are ordered by their address, which
+ * allows lookups without dereferencing any element.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_SARRAY_H_
+#define ZEPHYR_INCLUDE_SYS_SARRAY_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @typedef sarray_lessthan_t
+ * @brief Returns true if element @a a sorts before element @a b
+ */
+typedef bool (*sarray_lessthan_t)(const void *a, const void *b);
+
+struct sarray {
+	void **elems;
+	size_t count;
+	size_t capacity;
+	sarray_lessthan_t lessthan_fn;
+};
+
+/**
+ * @brief Statically define a sorted array
+ *
+ * @param name Name of the sorted array
+ * @param cap Maximum number of elements
+ * @param lessthan Comparison callback, or NULL to order by address
+ */
+#define SARRAY_DEFINE(name, cap, lessthan)				\
+	static void *_sarray_elems_##name[cap];				\
+	struct sarray name = {						\
+		.elems = _sarray_elems_##name,				\
+		.capacity = (cap),					\
+		.lessthan_fn = (lessthan),				\
+	}
+
+/**
+ * @brief Initialize a sorted array
+ *
+ * @param sa Sorted array
+ * @param elems Storage for @a capacity element pointers
+ * @param capacity Maximum number of elements
+ * @param lessthan_fn Comparison callback, or NULL to order by address
+ */
+static inline void sarray_init(struct sarray *sa, void **elems,
+			       size_t capacity, sarray_lessthan_t lessthan_fn)
+{
+	sa->elems = elems;
+	sa->count = 0;
+	sa->capacity = capacity;
+	sa->lessthan_fn = lessthan_fn;
+}
+
+/**
+ * @brief Insert element into sorted array
+ *
+ * Elements which compare equal are kept in insertion order.
+ *
+ * @return 0 on success, -ENOMEM if the array is full
+ */
+int sarray_insert(struct sarray *sa, void *elem);
+
+/**
+ * @brief Remove element from sorted array
+ *
+ * @return 0 on success, -ENOENT if the element is not in the array
+ */
+int sarray_remove(struct sarray *sa, void *elem);
+
+/**
+ * @brief Returns true if the given element is part of the array
+ *
+ * As for rb_contains(), elements are tested for equality of the pointer
+ * value, so this can implement a "set" of arbitrary pointers.
+ */
+bool sarray_contains(struct sarray *sa, const void *elem);
+
+/**
+ * @brief Returns the number of elements in the array
+ */
+static inline size_t sarray_count(struct sarray *sa)
+{
+	return sa->count;
+}
+
+/**
+ * @brief Returns the lowest-sorted element, or NULL if empty
+ */
+static inline void *sarray_get_min(struct sarray *sa)
+{
+	return (sa->count != 0) ? sa->elems[0] : NULL;
+}
+
+/**
+ * @brief Returns the highest-sorted element, or NULL if empty
+ */
+static inline void *sarray_get_max(struct sarray *sa)
+{
+	return (sa->count != 0) ? sa->elems[sa->count - 1] : NULL;
+}
+
+/**
+ * @brief Walk a sorted array in order
+ *
+ * The loop is not safe against modifications of the array.
+ *
+ * @param sa A pointer to a struct sarray to walk
+ * @param elem The symbol name of a local pointer variable of the type of
+ *             the elements, used as the iterator
+ */
+#define SARRAY_FOR_EACH(sa, elem)					\
+	for (size_t __i = 0;						\
+	     (__i < (sa)->count) ? ((elem) = (sa)->elems[__i], true) : false; \
+	     __i++)
+
+#endif /* ZEPHYR_INCLUDE_SYS_SARRAY_H_ */
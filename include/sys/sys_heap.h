@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_SYS_HEAP_H_
+#define ZEPHYR_INCLUDE_SYS_SYS_HEAP_H_
+
+#include <zephyr/types.h>
+#include <sys/util.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+ * Two-level segregated fit (TLSF) heap.
+ *
+ * Free blocks are kept in per-size-class lists indexed by a first
+ * level (the log2 of the block size) and a second level (a linear
+ * subdivision of that power of two).  A bitmap per level lets both
+ * allocation and free run in constant time regardless of heap size or
+ * fragmentation state, and boundary tags allow freed blocks to be
+ * coalesced with their physical neighbors immediately.
+ *
+ * The heap is not internally synchronized; callers are expected to
+ * provide their own locking.
+ */
+
+/* Alignment and size granularity of returned blocks */
+#define Z_HEAP_ALIGN 8
+
+/* log2 of the number of second-level lists per first-level class */
+#define Z_HEAP_SL_LOG2 4
+#define Z_HEAP_SL_COUNT BIT(Z_HEAP_SL_LOG2)
+
+/* Blocks below BIT(Z_HEAP_FL_SHIFT) all share first-level class zero */
+#define Z_HEAP_FL_SHIFT (Z_HEAP_SL_LOG2 + 3)
+
+/* Per-block header: physical predecessor pointer and size word */
+#define Z_HEAP_BLOCK_HDR ROUND_UP(2 * sizeof(void *), Z_HEAP_ALIGN)
+
+/* Number of first-level classes needed to hold a block of n bytes */
+#define Z_HEAP_FL_COUNT(n)						\
+	((n) < BIT(Z_HEAP_FL_SHIFT) ? 1U :				\
+	 (u32_t)(31 - __builtin_clz((u32_t)(n)) - Z_HEAP_FL_SHIFT + 2))
+
+/* Bytes of heap control data needed for a given first-level count */
+#define Z_HEAP_CTRL_SIZE(flc)						\
+	(ROUND_UP(3 * sizeof(void *), Z_HEAP_ALIGN) +			\
+	 ROUND_UP(sizeof(u32_t) * (flc), Z_HEAP_ALIGN) +		\
+	 ROUND_UP(sizeof(void *) * Z_HEAP_SL_COUNT * (flc), Z_HEAP_ALIGN))
+
+/**
+ * @brief Heap buffer size needed to hold a set of allocations
+ *
+ * Evaluates to the size of a memory region that can be passed to
+ * sys_heap_init() such that @a nmax simultaneous allocations of @a sz
+ * bytes are guaranteed to succeed.
+ *
+ * @param sz Size of each allocation, in bytes
+ * @param nmax Number of allocations
+ */
+#define SYS_HEAP_BUF_SIZE(sz, nmax)					\
+	(Z_HEAP_PAYLOAD_SIZE(sz, nmax) + Z_HEAP_BLOCK_HDR +		\
+	 Z_HEAP_CTRL_SIZE(Z_HEAP_FL_COUNT(Z_HEAP_PAYLOAD_SIZE(sz, nmax))))
+
+/* Room for nmax blocks of sz bytes, plus slack for buffer alignment */
+#define Z_HEAP_PAYLOAD_SIZE(sz, nmax)					\
+	((nmax) * (ROUND_UP(MAX((sz), 2 * sizeof(void *)), Z_HEAP_ALIGN) \
+		   + Z_HEAP_BLOCK_HDR) + Z_HEAP_BLOCK_HDR)
+
+struct z_heap;
+
+struct sys_heap {
+	struct z_heap *heap;
+	void *init_mem;
+	size_t init_bytes;
+};
+
+/** @brief Initialize sys_heap
+ *
+ * Initializes a sys_heap struct to manage the specified memory.
+ *
+ * @param h Heap to initialize
+ * @param mem Untyped pointer to unused memory
+ * @param bytes Size of region pointed to by @a mem
+ */
+void sys_heap_init(struct sys_heap *h, void *mem, size_t bytes);
+
+/** @brief Allocate memory from a sys_heap
+ *
+ * Returns a pointer to a block of unused memory in the heap.  This
+ * memory will not otherwise be used until it is freed with
+ * sys_heap_free().  If no memory can be allocated, NULL will be
+ * returned.  The returned block is aligned to Z_HEAP_ALIGN bytes.
+ *
+ * @note The sys_heap implementation is not internally synchronized.
+ * No two sys_heap functions should operate on the same heap at the
+ * same time.  All locking must be provided by the user.
+ *
+ * @param h Heap from which to allocate
+ * @param bytes Number of bytes requested
+ * @return Pointer to memory the caller can now use
+ */
+void *sys_heap_alloc(struct sys_heap *h, size_t bytes);
+
+/** @brief Free memory into a sys_heap
+ *
+ * De-allocates a pointer to memory previously returned from
+ * sys_heap_alloc such that it can be used for other purposes.  The
+ * caller must not use the memory region after entry to this function.
+ *
+ * @note The sys_heap implementation is not internally synchronized.
+ * No two sys_heap functions should operate on the same heap at the
+ * same time.  All locking must be provided by the user.
+ *
+ * @param h Heap to which to return the memory
+ * @param mem A pointer previously returned from sys_heap_alloc()
+ */
+void sys_heap_free(struct sys_heap *h, void *mem);
+
+/** @brief Validate heap integrity
+ *
+ * Validates the internal integrity of a sys_heap.  Intended for unit
+ * test and validation code, though potentially useful as a user API
+ * for applications with complicated runtime reliability requirements.
+ * Note: this cannot catch every possible error, but if it returns
+ * true then the heap is in a consistent state and can correctly
+ * handle any sys_heap_alloc() request and free any live pointer
+ * returned from a previous allocation.
+ *
+ * @param h Heap to validate
+ * @return true, if the heap is valid, otherwise false
+ */
+bool sys_heap_validate(struct sys_heap *h);
+
+#endif /* ZEPHYR_INCLUDE_SYS_SYS_HEAP_H_ */
@@ -18,6 +18,7 @@
 
 #include <sys/util.h>
 #include <sys/dlist.h>
+#include <sys/rb.h>
 
 #include <toolchain.h>
 #include <zephyr/types.h>
@@ -136,9 +137,18 @@ struct _timeout;
 typedef void (*_timeout_func_t)(struct _timeout *t);
 
 struct _timeout {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	struct rbnode node;
+	u64_t expiry;		/* absolute tick, zero when not queued */
+	u32_t order_key;
+#else
 	sys_dnode_t node;
 	s32_t dticks;
+#endif
 	_timeout_func_t fn;
+#ifdef CONFIG_TIMEOUT_SLACK
+	u32_t slack;		/* ticks the expiry may be deferred by */
+#endif
 };
 
 #ifdef __cplusplus
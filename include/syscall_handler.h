@@ -72,6 +72,30 @@ extern void z_dump_object_error(int retval, void *obj, struct _k_object *ko,
  */
 extern struct _k_object *z_object_find(void *obj);
 
+#if (CONFIG_USERSPACE_OBJ_CACHE_SIZE > 0)
+/**
+ * Look up and validate a kernel object passed in by the current thread
+ *
+ * Same as z_object_validate() on the result of z_object_find(), with
+ * errors logged, except that objects which already passed validation for
+ * the current thread are found in its object cache and skip the lookup and
+ * the permission check. The cache is invalidated on any permission
+ * revocation or dynamic object release.
+ *
+ * @param obj Untrusted kernel object pointer
+ * @param otype Expected type of the kernel object, or K_OBJ_ANY
+ * @param init Expected initialization state, see z_object_validate()
+ * @return 0 If the object is valid, otherwise as z_object_validate()
+ */
+extern int z_object_cached_validate(void *obj, enum k_objects otype,
+				    enum _obj_init_check init);
+
+/**
+ * Invalidate the validated object caches of all threads
+ */
+extern void z_object_cache_invalidate(void);
+#endif
+
 typedef void (*_wordlist_cb_func_t)(struct _k_object *ko, void *context);
 
 /**
@@ -413,9 +437,16 @@ static inline int z_obj_validation_check(struct _k_object *ko,
 	return ret;
 }
 
+#if (CONFIG_USERSPACE_OBJ_CACHE_SIZE > 0)
+#define Z_SYSCALL_IS_OBJ(ptr, type, init) \
+	Z_SYSCALL_VERIFY_MSG(z_object_cached_validate((void *)ptr, type, \
+						      init) == 0, \
+			     "access denied")
+#else
 #define Z_SYSCALL_IS_OBJ(ptr, type, init) \
 	Z_SYSCALL_VERIFY_MSG(z_obj_validation_check(z_object_find((void *)ptr), (void *)ptr, \
 				   type, init) == 0, "access denied")
+#endif
 
 /**
  * @brief Runtime check driver object pointer for presence of operation
@@ -24,7 +24,14 @@ extern "C" {
 
 static inline void z_init_timeout(struct _timeout *t)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	t->expiry = 0U;
+#else
 	sys_dnode_init(&t->node);
+#endif
+#ifdef CONFIG_TIMEOUT_SLACK
+	t->slack = 0U;
+#endif
 }
 
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn, s32_t ticks);
@@ -33,7 +40,11 @@ int z_abort_timeout(struct _timeout *to);
 
 static inline bool z_is_inactive_timeout(struct _timeout *t)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	return t->expiry == 0U;
+#else
 	return !sys_dnode_is_linked(&t->node);
+#endif
 }
 
 static inline void z_init_thread_timeout(struct _thread_base *thread_base)
@@ -332,6 +332,74 @@ atomic_val_t z_impl_atomic_nand(atomic_t *target, atomic_val_t value)
 
 ATOMIC_SYSCALL_HANDLER_TARGET_VALUE(atomic_nand);
 
+/**
+ *
+ * @brief Atomic pointer compare-and-set primitive
+ *
+ * Pointer flavor of atomic_cas().  Not a system call.
+ *
+ * @param target address to be tested
+ * @param old_value value to compare against
+ * @param new_value value to store if <target> equals <old_value>
+ * @return Returns true if <new_value> is written, false otherwise.
+ */
+bool atomic_ptr_cas(atomic_ptr_t *target, atomic_ptr_val_t old_value,
+		    atomic_ptr_val_t new_value)
+{
+	k_spinlock_key_t key;
+	bool ret = false;
+
+	key = k_spin_lock(&lock);
+
+	if (*target == old_value) {
+		*target = new_value;
+		ret = true;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
+/**
+ *
+ * @brief Atomic pointer get primitive
+ *
+ * @param target memory location to read from
+ *
+ * @return The value read from <target>
+ */
+atomic_ptr_val_t atomic_ptr_get(const atomic_ptr_t *target)
+{
+	return *target;
+}
+
+/**
+ *
+ * @brief Atomic pointer get-and-set primitive
+ *
+ * Pointer flavor of atomic_set().  Not a system call.
+ *
+ * @param target the memory location to write to
+ * @param value the value to write
+ *
+ * @return The previous value from <target>
+ */
+atomic_ptr_val_t atomic_ptr_set(atomic_ptr_t *target, atomic_ptr_val_t value)
+{
+	k_spinlock_key_t key;
+	atomic_ptr_val_t ret;
+
+	key = k_spin_lock(&lock);
+
+	ret = *target;
+	*target = value;
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
 #ifdef CONFIG_USERSPACE
 #include <syscalls/atomic_add_mrsh.c>
 #include <syscalls/atomic_sub_mrsh.c>
@@ -6,6 +6,9 @@
 
 #include <string.h>
 #include <device.h>
+#include <init.h>
+#include <ksched.h>
+#include <wait_q.h>
 #include <sys/atomic.h>
 #include <syscall_handler.h>
 
@@ -25,6 +28,182 @@ extern u32_t __device_busy_end[];
 
 s8_t z_sys_device_level;
 
+#ifdef CONFIG_DEVICE_INIT_ASYNC
+enum {
+	INIT_PENDING,
+	INIT_RUNNING,
+	INIT_DONE,
+	INIT_FAILED,
+};
+#endif
+
+static void device_init(struct device *info)
+{
+	struct device_config *device_conf = info->config;
+	int retval;
+
+	retval = device_conf->init(info);
+	if (retval != 0) {
+		/* Initialization failed. Clear the API struct so that
+		 * device_get_binding() will not succeed for it.
+		 */
+		info->driver_api = NULL;
+	} else {
+		z_object_init(info);
+	}
+
+#ifdef CONFIG_DEVICE_INIT_ASYNC
+	(void)atomic_set(&info->init_state,
+			 retval != 0 ? INIT_FAILED : INIT_DONE);
+#endif
+}
+
+#ifdef CONFIG_DEVICE_INIT_ASYNC
+/*
+ * Asynchronous entries are claimed, by a worker thread or by whoever
+ * waits on them first, with a CAS on their init_state. Workers don't
+ * keep a queue: async_work gets one token per entry handed out below
+ * async_end, so a worker taking one finds something left to claim
+ * unless a waiter got to it first, or unless it is told to exit.
+ */
+K_THREAD_STACK_ARRAY_DEFINE(device_init_stacks,
+			    CONFIG_DEVICE_INIT_ASYNC_THREADS,
+			    CONFIG_DEVICE_INIT_ASYNC_STACK_SIZE);
+static struct k_thread device_init_threads[CONFIG_DEVICE_INIT_ASYNC_THREADS];
+static K_SEM_DEFINE(async_work, 0, UINT_MAX);
+static struct k_spinlock async_lock;
+static _wait_q_t async_wait_q = Z_WAIT_Q_INIT(&async_wait_q);
+static struct device *async_end = __device_init_start;
+static atomic_t async_pending;
+static bool async_exit;
+
+static bool device_init_claim(struct device *info)
+{
+	return info->config->init_async &&
+		atomic_cas(&info->init_state, INIT_PENDING,
+			   INIT_RUNNING);
+}
+
+/* Wakes up everything blocked in device_init_wait() */
+static void device_init_wake(bool async)
+{
+	k_spinlock_key_t key = k_spin_lock(&async_lock);
+	struct k_thread *thread;
+
+	if (async) {
+		(void)atomic_dec(&async_pending);
+	}
+
+	while ((thread = z_unpend_first_thread(&async_wait_q)) != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+
+	z_reschedule(&async_lock, key);
+}
+
+static void device_init_worker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		struct device *info;
+
+		k_sem_take(&async_work, K_FOREVER);
+
+		for (info = __device_init_start; info < async_end; info++) {
+			if (device_init_claim(info)) {
+				break;
+			}
+		}
+
+		if (info < async_end) {
+			device_init(info);
+			device_init_wake(true);
+		} else if (async_exit) {
+			return;
+		}
+	}
+}
+
+static void device_init_async_start(struct device *start, struct device *end)
+{
+	static bool started;
+	struct device *info;
+	int n = 0;
+
+	for (info = start; info < end; info++) {
+		n += info->config->init_async ? 1 : 0;
+	}
+
+	async_end = end;
+
+	if (n == 0) {
+		return;
+	}
+
+	(void)atomic_add(&async_pending, n);
+
+	if (!started) {
+		started = true;
+		for (int i = 0; i < CONFIG_DEVICE_INIT_ASYNC_THREADS; i++) {
+			k_thread_create(&device_init_threads[i],
+					device_init_stacks[i],
+					K_THREAD_STACK_SIZEOF(device_init_stacks[i]),
+					device_init_worker, NULL, NULL, NULL,
+					CONFIG_DEVICE_INIT_ASYNC_PRIORITY, 0,
+					K_NO_WAIT);
+		}
+	}
+
+	while (n-- > 0) {
+		k_sem_give(&async_work);
+	}
+}
+
+int device_init_wait(struct device *device)
+{
+	k_spinlock_key_t key;
+
+	__ASSERT(device < async_end, "init level of %s not reached",
+		 device->config->name);
+
+	/* Run it here rather than wait for a worker to get to it */
+	if (device_init_claim(device)) {
+		device_init(device);
+		device_init_wake(true);
+	}
+
+	key = k_spin_lock(&async_lock);
+	while (atomic_get(&device->init_state) == INIT_RUNNING) {
+		(void)z_pend_curr(&async_lock, key, &async_wait_q, K_FOREVER);
+		key = k_spin_lock(&async_lock);
+	}
+	k_spin_unlock(&async_lock, key);
+
+	return atomic_get(&device->init_state) == INIT_FAILED ?
+		-ENODEV : 0;
+}
+
+void z_sys_device_init_async_finish(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&async_lock);
+
+	while (atomic_get(&async_pending) != 0) {
+		(void)z_pend_curr(&async_lock, key, &async_wait_q, K_FOREVER);
+		key = k_spin_lock(&async_lock);
+	}
+	k_spin_unlock(&async_lock, key);
+
+	async_exit = true;
+	for (int i = 0; i < CONFIG_DEVICE_INIT_ASYNC_THREADS; i++) {
+		k_sem_give(&async_work);
+	}
+}
+#endif /* CONFIG_DEVICE_INIT_ASYNC */
+
 /**
  * @brief Execute all the device initialization functions at a given level
  *
@@ -34,6 +213,10 @@ s8_t z_sys_device_level;
  * they need to be invoked, with symbols indicating where one level leaves
  * off and the next one begins.
  *
+ * With CONFIG_DEVICE_INIT_ASYNC, the objects marked asynchronous are handed
+ * to worker threads first from the POST_KERNEL level on, and may still be
+ * running on return.
+ *
  * @param level init level to run.
  */
 void z_sys_device_do_config_level(s32_t level)
@@ -49,20 +232,33 @@ void z_sys_device_do_config_level(s32_t level)
 	};
 
 	z_sys_device_level = level;
+
+#ifdef CONFIG_DEVICE_INIT_ASYNC
+	if (level >= _SYS_INIT_LEVEL_POST_KERNEL) {
+		device_init_async_start(config_levels[level],
+					config_levels[level+1]);
+	} else {
+		async_end = config_levels[level+1];
+	}
+#endif
+
 	for (info = config_levels[level]; info < config_levels[level+1];
 								info++) {
-		int retval;
-		struct device_config *device_conf = info->config;
-
-		retval = device_conf->init(info);
-		if (retval != 0) {
-			/* Initialization failed. Clear the API struct so that
-			 * device_get_binding() will not succeed for it.
-			 */
-			info->driver_api = NULL;
-		} else {
-			z_object_init(info);
+#ifdef CONFIG_DEVICE_INIT_ASYNC
+		bool threads = level >= _SYS_INIT_LEVEL_POST_KERNEL;
+
+		if (threads && info->config->init_async) {
+			continue;
 		}
+
+		(void)atomic_set(&info->init_state, INIT_RUNNING);
+		device_init(info);
+		if (threads) {
+			device_init_wake(false);
+		}
+#else
+		device_init(info);
+#endif
 	}
 }
 
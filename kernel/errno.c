@@ -23,7 +23,10 @@
 const int _k_neg_eagain = -EAGAIN;
 
 #ifdef CONFIG_ERRNO
-#ifdef CONFIG_USERSPACE
+#if defined(CONFIG_ERRNO_IN_TLS)
+__thread int z_errno_var;
+
+#elif defined(CONFIG_USERSPACE)
 int *z_impl_z_errno(void)
 {
 	/* Initialized to the lowest address in the stack so the thread can
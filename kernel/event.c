@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Kernel event object.
+ *
+ * An event object holds 32 events that threads wait for any or all of.
+ * Waiting threads are pended on the object's wait queue with what they
+ * wait for, so that setting events only wakes up the threads the wait of
+ * which is satisfied, and a wait on events already set does not pend.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <wait_q.h>
+#include <ksched.h>
+#include <syscall_handler.h>
+
+/* What a pended thread waits for, referenced by its swap_data */
+struct event_wait {
+	u32_t events;
+	u32_t options;
+	u32_t result;
+};
+
+static bool is_satisfied(u32_t current, u32_t events, u32_t options)
+{
+	if ((options & K_EVENT_WAIT_ALL) != 0U) {
+		return (current & events) == events;
+	}
+
+	return (current & events) != 0U;
+}
+
+/* Consumes the events of a satisfied wait, returns the events as they
+ * were before
+ */
+static u32_t take(struct k_event *event, u32_t events, u32_t options)
+{
+	u32_t current = event->events;
+
+	if ((options & K_EVENT_NO_CLEAR) == 0U) {
+		event->events &= ~events;
+	}
+
+	return current;
+}
+
+void z_impl_k_event_init(struct k_event *event)
+{
+	event->events = 0U;
+	z_waitq_init(&event->wait_q);
+#if defined(CONFIG_POLL)
+	sys_dlist_init(&event->poll_events);
+#endif
+
+	z_object_init(event);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_event_init(struct k_event *event)
+{
+	Z_OOPS(Z_SYSCALL_OBJ_INIT(event, K_OBJ_EVENT));
+	z_impl_k_event_init(event);
+}
+#include <syscalls/k_event_init_mrsh.c>
+#endif
+
+u32_t z_impl_k_event_set(struct k_event *event, u32_t events)
+{
+	k_spinlock_key_t key = k_spin_lock(&event->lock);
+	struct k_thread *thread, *found;
+	bool woken = false;
+	u32_t ret;
+
+	event->events |= events;
+
+	/* Waiters are woken in priority order, each one consuming its events
+	 * before the next one is checked.
+	 */
+	do {
+		found = NULL;
+		_WAIT_Q_FOR_EACH(&event->wait_q, thread) {
+			struct event_wait *w = thread->base.swap_data;
+
+			if (is_satisfied(event->events, w->events,
+					 w->options)) {
+				found = thread;
+				break;
+			}
+		}
+
+		if (found != NULL) {
+			struct event_wait *w = found->base.swap_data;
+
+			w->result = take(event, w->events, w->options);
+			z_unpend_thread(found);
+			arch_thread_return_value_set(found, 0);
+			z_ready_thread(found);
+			woken = true;
+		}
+	} while (found != NULL);
+
+	ret = event->events;
+
+#ifdef CONFIG_POLL
+	if (ret != 0U) {
+		z_handle_obj_poll_events(&event->poll_events,
+					 K_POLL_STATE_EVENT_SET);
+	}
+#endif
+
+	if (woken) {
+		z_reschedule(&event->lock, key);
+	} else {
+		k_spin_unlock(&event->lock, key);
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline u32_t z_vrfy_k_event_set(struct k_event *event, u32_t events)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	return z_impl_k_event_set(event, events);
+}
+#include <syscalls/k_event_set_mrsh.c>
+#endif
+
+u32_t z_impl_k_event_clear(struct k_event *event, u32_t events)
+{
+	k_spinlock_key_t key = k_spin_lock(&event->lock);
+	u32_t ret = event->events;
+
+	event->events &= ~events;
+	k_spin_unlock(&event->lock, key);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline u32_t z_vrfy_k_event_clear(struct k_event *event, u32_t events)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	return z_impl_k_event_clear(event, events);
+}
+#include <syscalls/k_event_clear_mrsh.c>
+#endif
+
+u32_t z_impl_k_event_wait(struct k_event *event, u32_t events,
+			  u32_t options, s32_t timeout)
+{
+	struct event_wait w = {
+		.events = events,
+		.options = options,
+	};
+	k_spinlock_key_t key;
+
+	__ASSERT(((arch_is_in_isr() == false) || (timeout == K_NO_WAIT)), "");
+	__ASSERT(events != 0U, "no event to wait for");
+
+	key = k_spin_lock(&event->lock);
+
+	if (is_satisfied(event->events, events, options)) {
+		u32_t ret = take(event, events, options);
+
+		k_spin_unlock(&event->lock, key);
+		return ret;
+	}
+
+	if (timeout == K_NO_WAIT) {
+		k_spin_unlock(&event->lock, key);
+		return 0;
+	}
+
+	_current->base.swap_data = &w;
+	if (z_pend_curr(&event->lock, key, &event->wait_q, timeout) != 0) {
+		return 0;
+	}
+
+	return w.result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline u32_t z_vrfy_k_event_wait(struct k_event *event, u32_t events,
+					u32_t options, s32_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	Z_OOPS(Z_SYSCALL_VERIFY(events != 0U));
+	return z_impl_k_event_wait(event, events, options, timeout);
+}
+#include <syscalls/k_event_wait_mrsh.c>
+#endif
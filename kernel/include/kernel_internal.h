@@ -121,6 +121,22 @@ extern int z_stack_adjust_initialized;
 #ifdef CONFIG_BOOT_TIME_MEASUREMENT
 extern u32_t z_timestamp_main; /* timestamp when main task starts */
 extern u32_t z_timestamp_idle; /* timestamp when CPU goes idle */
+
+/* Boot phases, timestamped when they end. Timestamps taken before the
+ * system timer driver is initialized are only meaningful with cycle
+ * counters which run from reset.
+ */
+enum z_boot_phase {
+	/* Architecture setup, BSS zeroing and data copy */
+	Z_BOOT_PHASE_EARLY,
+	Z_BOOT_PHASE_PRE_KERNEL_1,
+	Z_BOOT_PHASE_PRE_KERNEL_2,
+	Z_BOOT_PHASE_POST_KERNEL,
+	Z_BOOT_PHASE_APPLICATION,
+	Z_BOOT_PHASE_NUM
+};
+
+extern u32_t z_timestamp_boot_phase[Z_BOOT_PHASE_NUM];
 #endif
 
 extern struct k_thread z_main_thread;
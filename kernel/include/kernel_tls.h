@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Kernel thread-local storage helpers
+ *
+ * Each thread owns a copy of the TLS image (the .tdata initializers
+ * followed by the zeroed .tbss), carved by arch_new_thread() from its
+ * stack. Pointing the architecture's thread pointer at it is up to the
+ * architecture, as is any control block it expects in front of it.
+ */
+
+#ifndef ZEPHYR_KERNEL_INCLUDE_KERNEL_TLS_H_
+#define ZEPHYR_KERNEL_INCLUDE_KERNEL_TLS_H_
+
+#include <zephyr/types.h>
+#include <string.h>
+
+/* Defined by include/linker/thread-local-storage.ld */
+extern char __tdata_start[];
+extern char __tdata_size[];
+extern char __tbss_size[];
+
+/**
+ * @brief Size of the TLS image, in bytes
+ */
+static inline size_t z_tls_data_size(void)
+{
+	return (size_t)(uintptr_t)__tdata_size +
+		(size_t)(uintptr_t)__tbss_size;
+}
+
+/**
+ * @brief Initialize a thread's TLS area
+ *
+ * @param dest Start of an area of z_tls_data_size() bytes, aligned to 8
+ */
+static inline void z_tls_copy(char *dest)
+{
+	size_t tdata_size = (size_t)(uintptr_t)__tdata_size;
+
+	(void)memcpy(dest, __tdata_start, tdata_size);
+	(void)memset(dest + tdata_size, 0, (size_t)(uintptr_t)__tbss_size);
+}
+
+#endif /* ZEPHYR_KERNEL_INCLUDE_KERNEL_TLS_H_ */
@@ -51,6 +51,15 @@ void z_reschedule_irqlock(u32_t key);
 struct k_thread *z_unpend_first_thread(_wait_q_t *wait_q);
 void z_unpend_thread(struct k_thread *thread);
 int z_unpend_all(_wait_q_t *wait_q);
+
+/* Unpends up to max threads (all of them if max is negative) from
+ * wait_q in priority order, sets their swap return value and readies
+ * them.  The scheduler lock is taken once for the whole batch and the
+ * cache update and IPI happen once at the end, so broadcasts don't pay
+ * a scheduling decision per woken thread.  The caller still has to
+ * reschedule.  Returns the number of threads unpended.
+ */
+int z_unpend_ready_n(_wait_q_t *wait_q, int max, int swap_retval);
 void z_thread_priority_set(struct k_thread *thread, int prio);
 bool z_set_prio(struct k_thread *thread, int prio);
 void *z_get_next_switch_handle(void *interrupted);
@@ -61,6 +70,7 @@ void z_time_slice(int ticks);
 void z_reset_time_slice(void);
 void z_sched_abort(struct k_thread *thread);
 void z_sched_ipi(void);
+void z_sched_cbs_release(struct k_thread *thread);
 
 static inline void z_pend_curr_unlocked(_wait_q_t *wait_q, s32_t timeout)
 {
@@ -107,7 +117,8 @@ static inline bool z_is_thread_prevented_from_running(struct k_thread *thread)
 	u8_t state = thread->base.thread_state;
 
 	return (state & (_THREAD_PENDING | _THREAD_PRESTART | _THREAD_DEAD |
-			 _THREAD_DUMMY | _THREAD_SUSPENDED)) != 0U;
+			 _THREAD_DUMMY | _THREAD_SUSPENDED |
+			 _THREAD_THROTTLED)) != 0U;
 
 }
 
@@ -291,7 +302,7 @@ static ALWAYS_INLINE void z_sched_unlock_no_reschedule(void)
 
 static ALWAYS_INLINE bool z_is_thread_timeout_expired(struct k_thread *thread)
 {
-#ifdef CONFIG_SYS_CLOCK_EXISTS
+#if defined(CONFIG_SYS_CLOCK_EXISTS) && !defined(CONFIG_TIMEOUT_QUEUE_SCALABLE)
 	return thread->base.timeout.dticks == _EXPIRED;
 #else
 	return 0;
@@ -16,6 +16,30 @@ extern void z_check_stack_sentinel(void);
 #define z_check_stack_sentinel() /**/
 #endif
 
+#ifdef CONFIG_STACK_WATERMARK
+extern void z_stack_watermark_update(struct k_thread *thread, uintptr_t sp);
+
+/* Called on the outgoing thread's stack, so its own frame tells how
+ * deep that stack is at the switch.
+ */
+static ALWAYS_INLINE void z_stack_watermark_sample(void)
+{
+	z_stack_watermark_update(_current,
+				 (uintptr_t)__builtin_frame_address(0));
+}
+#else
+#define z_stack_watermark_sample() /**/
+#endif
+
+#ifdef CONFIG_SCHED_THREAD_USAGE
+/* Charges the cycles since the last switch on this CPU to _current,
+ * must be called before _current is changed.
+ */
+extern void z_sched_usage_switch(void);
+#else
+#define z_sched_usage_switch() /**/
+#endif
+
 /* In SMP, the irq_lock() is a spinlock which is implicitly released
  * and reacquired on context switch to preserve the existing
  * semantics.  This means that whenever we are about to return to a
@@ -52,6 +76,8 @@ static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 	old_thread = _current;
 
 	z_check_stack_sentinel();
+	z_stack_watermark_sample();
+	z_sched_usage_switch();
 
 	sys_trace_thread_switched_out();
 
@@ -119,8 +145,13 @@ static inline int z_swap_irqlock(unsigned int key)
 {
 	int ret;
 	z_check_stack_sentinel();
+	z_stack_watermark_sample();
 
+	/* On ARM both are done in PendSV, which also sees preemption
+	 * from interrupts.
+	 */
 #ifndef CONFIG_ARM
+	z_sched_usage_switch();
 	sys_trace_thread_switched_out();
 #endif
 	ret = arch_swap(key);
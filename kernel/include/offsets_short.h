@@ -63,6 +63,9 @@
 
 #define _thread_offset_to_stack_start \
 	(___thread_t_stack_info_OFFSET + ___thread_stack_info_t_start_OFFSET)
+
+#define _thread_offset_to_tls \
+	(___thread_t_tls_OFFSET)
 /* end - threads */
 
 #endif /* ZEPHYR_KERNEL_INCLUDE_OFFSETS_SHORT_H_ */
@@ -54,6 +54,12 @@ LOG_MODULE_REGISTER(os);
 #ifdef CONFIG_BOOT_TIME_MEASUREMENT
 u32_t __noinit z_timestamp_main;  /* timestamp when main task starts */
 u32_t __noinit z_timestamp_idle;  /* timestamp when CPU goes idle */
+u32_t __noinit z_timestamp_boot_phase[Z_BOOT_PHASE_NUM];
+
+#define BOOT_PHASE_END(phase) \
+	(z_timestamp_boot_phase[phase] = k_cycle_get_32())
+#else
+#define BOOT_PHASE_END(phase) do { } while (false)
 #endif
 
 /* init/main and idle threads */
@@ -234,6 +240,7 @@ static void bg_thread_main(void *unused1, void *unused2, void *unused3)
 #endif
 
 	z_sys_device_do_config_level(_SYS_INIT_LEVEL_POST_KERNEL);
+	BOOT_PHASE_END(Z_BOOT_PHASE_POST_KERNEL);
 #if CONFIG_STACK_POINTER_RANDOM
 	z_stack_adjust_initialized = 1;
 #endif
@@ -255,6 +262,12 @@ static void bg_thread_main(void *unused1, void *unused2, void *unused3)
 
 	/* Final init level before app starts */
 	z_sys_device_do_config_level(_SYS_INIT_LEVEL_APPLICATION);
+	BOOT_PHASE_END(Z_BOOT_PHASE_APPLICATION);
+
+#ifdef CONFIG_DEVICE_INIT_ASYNC
+	/* main() may rely on everything being initialized */
+	z_sys_device_init_async_finish();
+#endif
 
 #ifdef CONFIG_CPLUSPLUS
 	/* Process the .ctors and .init_array sections */
@@ -340,6 +353,9 @@ static void prepare_multithreading(struct k_thread *dummy_thread)
 #ifdef CONFIG_THREAD_STACK_INFO
 	dummy_thread->stack_info.start = 0U;
 	dummy_thread->stack_info.size = 0U;
+#if defined(CONFIG_STACK_WATERMARK)
+	dummy_thread->stack_info.watermark = 0U;
+#endif
 #endif
 #ifdef CONFIG_USERSPACE
 	dummy_thread->mem_domain_info.mem_domain = 0;
@@ -493,6 +509,8 @@ FUNC_NORETURN void z_cstart(void)
 	uintptr_t stack_guard;
 #endif	/* CONFIG_STACK_CANARIES */
 
+	BOOT_PHASE_END(Z_BOOT_PHASE_EARLY);
+
 	/* gcov hook needed to get the coverage report.*/
 	gcov_static_init();
 
@@ -518,7 +536,9 @@ FUNC_NORETURN void z_cstart(void)
 
 	/* perform basic hardware initialization */
 	z_sys_device_do_config_level(_SYS_INIT_LEVEL_PRE_KERNEL_1);
+	BOOT_PHASE_END(Z_BOOT_PHASE_PRE_KERNEL_1);
 	z_sys_device_do_config_level(_SYS_INIT_LEVEL_PRE_KERNEL_2);
+	BOOT_PHASE_END(Z_BOOT_PHASE_PRE_KERNEL_2);
 
 #ifdef CONFIG_STACK_CANARIES
 	z_early_boot_rand_get((u8_t *)&stack_guard, sizeof(stack_guard));
@@ -13,6 +13,7 @@
 #include <sys/dlist.h>
 #include <ksched.h>
 #include <init.h>
+#include <string.h>
 
 static struct k_spinlock lock;
 
@@ -41,6 +42,10 @@ static void create_free_list(struct k_mem_slab *slab)
 	slab->free_list = NULL;
 	p = slab->buffer;
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	(void)memset(slab->cache, 0, sizeof(slab->cache));
+#endif
+
 	for (j = 0U; j < slab->num_blocks; j++) {
 		*(char **)p = slab->free_list;
 		slab->free_list = p;
@@ -84,11 +89,170 @@ void k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	z_object_init(slab);
 }
 
-int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+
+#define CACHE_BATCH MAX(CONFIG_MEM_SLAB_CPU_CACHE_SIZE / 2, 1)
+
+/*
+ * Each CPU keeps a small magazine of free blocks per slab.  Allocations
+ * from it only mask local interrupts, and the shared free list is
+ * touched once per CACHE_BATCH blocks, when a magazine runs empty or
+ * full.  slab->num_used counts every block off the shared list,
+ * including the ones parked in magazines.
+ *
+ * Blocked allocators can only see the shared list, so frees hand blocks
+ * to them first, flushing the local magazine.  Frees check for waiters
+ * under the slab lock, which allocators hold from their own check of
+ * the shared list until they pend, so no wakeup is lost.
+ */
+
+static inline struct z_mem_slab_cache *local_cache(struct k_mem_slab *slab)
+{
+	return &slab->cache[_current_cpu->id];
+}
+
+/* Moves up to n blocks from the front of *from to the front of *to,
+ * returning the number moved.
+ */
+static u32_t move_blocks(char **to, char **from, u32_t n)
+{
+	u32_t moved = 0U;
+
+	while (moved < n && *from != NULL) {
+		char *block = *from;
+
+		*from = *(char **)block;
+		*(char **)block = *to;
+		*to = block;
+		moved++;
+	}
+
+	return moved;
+}
+
+/* Called with slab lock held */
+static void cache_flush_locked(struct k_mem_slab *slab,
+			       struct z_mem_slab_cache *cache, u32_t n)
+{
+	u32_t moved = move_blocks(&slab->free_list, &cache->free_list, n);
+
+	cache->count -= moved;
+	slab->num_used -= moved;
+	cache->flushes++;
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	unsigned int key = arch_irq_lock();
+	struct z_mem_slab_cache *cache = local_cache(slab);
+	bool ret = false;
+
+	if (cache->count == 0U && slab->free_list != NULL) {
+		k_spinlock_key_t lkey = k_spin_lock(&lock);
+		u32_t moved = move_blocks(&cache->free_list, &slab->free_list,
+					  CACHE_BATCH);
+
+		if (moved != 0U) {
+			cache->count += moved;
+			slab->num_used += moved;
+			cache->refills++;
+		}
+		k_spin_unlock(&lock, lkey);
+	}
+
+	if (cache->count != 0U) {
+		*mem = cache->free_list;
+		cache->free_list = *(char **)cache->free_list;
+		cache->count--;
+		cache->hits++;
+		ret = true;
+	}
+
+	arch_irq_unlock(key);
+
+	return ret;
+}
+
+/* Called with slab lock held, when nobody waits for a block */
+static void cache_free_locked(struct k_mem_slab *slab, void *block)
+{
+	struct z_mem_slab_cache *cache = local_cache(slab);
+
+	if (cache->count == CONFIG_MEM_SLAB_CPU_CACHE_SIZE) {
+		cache_flush_locked(slab, cache, CACHE_BATCH);
+	}
+
+	*(char **)block = cache->free_list;
+	cache->free_list = block;
+	cache->count++;
+	cache->hits++;
+}
+
+/* Called with slab lock held, after waking a waiter: hands whatever
+ * this CPU had cached to further waiters and flushes the rest.
+ */
+static void cache_handoff_locked(struct k_mem_slab *slab)
+{
+	struct z_mem_slab_cache *cache = local_cache(slab);
+	struct k_thread *thread;
+
+	while (cache->count != 0U &&
+	       (thread = z_unpend_first_thread(&slab->wait_q)) != NULL) {
+		char *block = cache->free_list;
+
+		cache->free_list = *(char **)block;
+		cache->count--;
+		z_thread_return_value_set_with_data(thread, 0, block);
+		z_ready_thread(thread);
+	}
+
+	if (cache->count != 0U) {
+		cache_flush_locked(slab, cache, cache->count);
+	}
+}
+
+void k_mem_slab_cache_flush(struct k_mem_slab *slab)
 {
 	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct z_mem_slab_cache *cache = local_cache(slab);
+
+	if (cache->count != 0U) {
+		cache_flush_locked(slab, cache, cache->count);
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+void k_mem_slab_cache_stats_get(struct k_mem_slab *slab,
+				struct k_mem_slab_cache_stats *stats)
+{
+	int i;
+
+	(void)memset(stats, 0, sizeof(*stats));
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		stats->hits += slab->cache[i].hits;
+		stats->refills += slab->cache[i].refills;
+		stats->flushes += slab->cache[i].flushes;
+		stats->cached += slab->cache[i].count;
+	}
+}
+
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
+{
+	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cache_alloc(slab, mem)) {
+		return 0;
+	}
+#endif
+
+	key = k_spin_lock(&lock);
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -121,11 +285,18 @@ void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 	if (pending_thread != NULL) {
 		z_thread_return_value_set_with_data(pending_thread, 0, *mem);
 		z_ready_thread(pending_thread);
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		cache_handoff_locked(slab);
+#endif
 		z_reschedule(&lock, key);
 	} else {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		cache_free_locked(slab, *mem);
+#else
 		**(char ***)mem = slab->free_list;
 		slab->free_list = *(char **)mem;
 		slab->num_used--;
+#endif
 		k_spin_unlock(&lock, key);
 	}
 }
@@ -13,6 +13,77 @@
 #include <sys/math_extras.h>
 #include <stdbool.h>
 
+#ifdef CONFIG_MEM_POOL_HEAP_BACKEND
+
+static void k_mem_pool_init(struct k_mem_pool *p)
+{
+	z_waitq_init(&p->wait_q);
+	sys_heap_init(&p->heap, p->heap.init_mem, p->heap.init_bytes);
+}
+
+int k_mem_pool_alloc(struct k_mem_pool *p, struct k_mem_block *block,
+		     size_t size, s32_t timeout)
+{
+	k_spinlock_key_t key;
+	s64_t end = 0;
+
+	__ASSERT(!(arch_is_in_isr() && timeout != K_NO_WAIT), "");
+
+	if (timeout > 0) {
+		end = k_uptime_get() + timeout;
+	}
+
+	while (true) {
+		key = k_spin_lock(&p->lock);
+
+		block->data = sys_heap_alloc(&p->heap, size);
+		if (block->data != NULL) {
+			block->id.pool = p;
+			block->id.data = block->data;
+			k_spin_unlock(&p->lock, key);
+			return 0;
+		}
+
+		if (timeout == K_NO_WAIT) {
+			k_spin_unlock(&p->lock, key);
+			return -ENOMEM;
+		}
+
+		/* Pending under the pool lock closes the window in which
+		 * a free could otherwise slip in unnoticed.
+		 */
+		(void)z_pend_curr(&p->lock, key, &p->wait_q, timeout);
+
+		if (timeout != K_FOREVER) {
+			timeout = end - k_uptime_get();
+			if (timeout <= 0) {
+				break;
+			}
+		}
+	}
+
+	return -EAGAIN;
+}
+
+void k_mem_pool_free_id(struct k_mem_block_id *id)
+{
+	struct k_mem_pool *p = id->pool;
+	k_spinlock_key_t key = k_spin_lock(&p->lock);
+
+	sys_heap_free(&p->heap, id->data);
+
+	/* Wake up anyone blocked on this pool and let them repeat
+	 * their allocation attempts
+	 */
+	if (z_unpend_all(&p->wait_q) != 0) {
+		z_reschedule(&p->lock, key);
+	} else {
+		k_spin_unlock(&p->lock, key);
+	}
+}
+
+#else
+
 static struct k_spinlock lock;
 
 static struct k_mem_pool *get_pool(int id)
@@ -33,19 +104,6 @@ static void k_mem_pool_init(struct k_mem_pool *p)
 	z_sys_mem_pool_base_init(&p->base);
 }
 
-int init_static_pools(struct device *unused)
-{
-	ARG_UNUSED(unused);
-
-	Z_STRUCT_SECTION_FOREACH(k_mem_pool, p) {
-		k_mem_pool_init(p);
-	}
-
-	return 0;
-}
-
-SYS_INIT(init_static_pools, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
-
 int k_mem_pool_alloc(struct k_mem_pool *p, struct k_mem_block *block,
 		     size_t size, s32_t timeout)
 {
@@ -111,6 +169,21 @@ void k_mem_pool_free_id(struct k_mem_block_id *id)
 	}
 }
 
+#endif /* CONFIG_MEM_POOL_HEAP_BACKEND */
+
+int init_static_pools(struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	Z_STRUCT_SECTION_FOREACH(k_mem_pool, p) {
+		k_mem_pool_init(p);
+	}
+
+	return 0;
+}
+
+SYS_INIT(init_static_pools, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+
 void k_mem_pool_free(struct k_mem_block *block)
 {
 	k_mem_pool_free_id(&block->id);
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Lock-free multi-producer, single-consumer queue.
+ *
+ * Producers push items onto an atomic singly-linked LIFO with a CAS
+ * loop.  The consumer detaches the whole LIFO with a single atomic
+ * exchange and reverses it into a private FIFO it drains without any
+ * synchronization.  Since producers only ever push and the consumer
+ * only ever takes the whole list, there is no ABA problem.
+ *
+ * The kernel lock paths are only entered when the consumer has
+ * announced, through the "waiting" flag, that it is about to block or
+ * poll.  The consumer sets the flag before its final emptiness check
+ * and producers test it after publishing their item, so at least one
+ * side always sees the other.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <sys/slist.h>
+#include <sys/atomic.h>
+
+void k_mpsc_init(struct k_mpsc *queue)
+{
+	(void)atomic_ptr_clear(&queue->head);
+	sys_slist_init(&queue->ready);
+	(void)atomic_clear(&queue->waiting);
+	queue->lock = (struct k_spinlock) {};
+	z_waitq_init(&queue->wait_q);
+#if defined(CONFIG_POLL)
+	sys_dlist_init(&queue->poll_events);
+#endif
+}
+
+static void wake_consumer(struct k_mpsc *queue)
+{
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+	struct k_thread *thread = z_unpend_first_thread(&queue->wait_q);
+
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+
+#if defined(CONFIG_POLL)
+	z_handle_obj_poll_events(&queue->poll_events,
+				 K_POLL_STATE_DATA_AVAILABLE);
+#endif
+
+	z_reschedule(&queue->lock, key);
+}
+
+void k_mpsc_put(struct k_mpsc *queue, void *data)
+{
+	sys_snode_t *node = data;
+	void *head;
+
+	do {
+		head = atomic_ptr_get(&queue->head);
+		z_snode_next_set(node, head);
+	} while (!atomic_ptr_cas(&queue->head, head, node));
+
+	if (atomic_cas(&queue->waiting, 1, 0)) {
+		wake_consumer(queue);
+	}
+}
+
+static void *take(struct k_mpsc *queue)
+{
+	sys_snode_t *node = sys_slist_get(&queue->ready);
+
+	if (node == NULL) {
+		sys_snode_t *lifo = atomic_ptr_clear(&queue->head);
+
+		/* Reverse into arrival order */
+		while (lifo != NULL) {
+			sys_snode_t *next = z_snode_next_peek(lifo);
+
+			sys_slist_prepend(&queue->ready, lifo);
+			lifo = next;
+		}
+
+		node = sys_slist_get(&queue->ready);
+	}
+
+	return node;
+}
+
+void *k_mpsc_get(struct k_mpsc *queue, s32_t timeout)
+{
+	k_spinlock_key_t key;
+	void *data;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr() || timeout == K_NO_WAIT, "");
+
+	data = take(queue);
+	if (data != NULL || timeout == K_NO_WAIT) {
+		return data;
+	}
+
+	key = k_spin_lock(&queue->lock);
+
+	(void)atomic_set(&queue->waiting, 1);
+	data = take(queue);
+	if (data != NULL) {
+		(void)atomic_clear(&queue->waiting);
+		k_spin_unlock(&queue->lock, key);
+		return data;
+	}
+
+	ret = z_pend_curr(&queue->lock, key, &queue->wait_q, timeout);
+
+	return ret == 0 ? take(queue) : NULL;
+}
@@ -247,6 +247,141 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *q, void *data, s32_t timeout)
 #include <syscalls/k_msgq_get_mrsh.c>
 #endif
 
+int z_impl_k_msgq_put_many(struct k_msgq *msgq, void *data, u32_t count,
+			   s32_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || timeout == K_NO_WAIT, "");
+
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	char *msg = data;
+	u32_t sent = 0U;
+
+	if (count == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (msgq->used_msgs == msgq->max_msgs) {
+		k_spin_unlock(&msgq->lock, key);
+
+		/* nothing fits: behave like a single put of the first one */
+		int ret = z_impl_k_msgq_put(msgq, data, timeout);
+
+		return ret == 0 ? 1 : ret;
+	}
+
+	/*
+	 * Receivers only pend on an empty queue, so they are served first;
+	 * whatever is left over is buffered.
+	 */
+	while (sent < count &&
+	       (pending_thread = z_unpend_first_thread(&msgq->wait_q)) != NULL) {
+		(void)memcpy(pending_thread->base.swap_data, msg,
+			     msgq->msg_size);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		msg += msgq->msg_size;
+		sent++;
+	}
+
+	while (sent < count && msgq->used_msgs < msgq->max_msgs) {
+		(void)memcpy(msgq->write_ptr, msg, msgq->msg_size);
+		msgq->write_ptr += msgq->msg_size;
+		if (msgq->write_ptr == msgq->buffer_end) {
+			msgq->write_ptr = msgq->buffer_start;
+		}
+		msgq->used_msgs++;
+		msg += msgq->msg_size;
+		sent++;
+	}
+
+	z_reschedule(&msgq->lock, key);
+
+	return sent;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_many(struct k_msgq *q, void *data,
+					 u32_t count, s32_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_READ(data, count, q->msg_size));
+
+	return z_impl_k_msgq_put_many(q, data, count, timeout);
+}
+#include <syscalls/k_msgq_put_many_mrsh.c>
+#endif
+
+int z_impl_k_msgq_get_many(struct k_msgq *msgq, void *data, u32_t count,
+			   s32_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || timeout == K_NO_WAIT, "");
+
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	char *msg = data;
+	u32_t received = 0U;
+
+	if (count == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (msgq->used_msgs == 0U) {
+		k_spin_unlock(&msgq->lock, key);
+
+		/* nothing queued: behave like a single get */
+		int ret = z_impl_k_msgq_get(msgq, data, timeout);
+
+		return ret == 0 ? 1 : ret;
+	}
+
+	while (received < count && msgq->used_msgs > 0U) {
+		(void)memcpy(msg, msgq->read_ptr, msgq->msg_size);
+		msgq->read_ptr += msgq->msg_size;
+		if (msgq->read_ptr == msgq->buffer_end) {
+			msgq->read_ptr = msgq->buffer_start;
+		}
+		msgq->used_msgs--;
+		msg += msgq->msg_size;
+		received++;
+
+		/* refill the freed slot from the first waiting sender */
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread != NULL) {
+			(void)memcpy(msgq->write_ptr,
+				     pending_thread->base.swap_data,
+				     msgq->msg_size);
+			msgq->write_ptr += msgq->msg_size;
+			if (msgq->write_ptr == msgq->buffer_end) {
+				msgq->write_ptr = msgq->buffer_start;
+			}
+			msgq->used_msgs++;
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+		}
+	}
+
+	z_reschedule(&msgq->lock, key);
+
+	return received;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_many(struct k_msgq *q, void *data,
+					 u32_t count, s32_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, count, q->msg_size));
+
+	return z_impl_k_msgq_get_many(q, data, count, timeout);
+}
+#include <syscalls/k_msgq_get_many_mrsh.c>
+#endif
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
@@ -282,15 +417,11 @@ static inline int z_vrfy_k_msgq_peek(struct k_msgq *q, void *data)
 void z_impl_k_msgq_purge(struct k_msgq *msgq)
 {
 	k_spinlock_key_t key;
-	struct k_thread *pending_thread;
 
 	key = k_spin_lock(&msgq->lock);
 
 	/* wake up any threads that are waiting to write */
-	while ((pending_thread = z_unpend_first_thread(&msgq->wait_q)) != NULL) {
-		arch_thread_return_value_set(pending_thread, -ENOMSG);
-		z_ready_thread(pending_thread);
-	}
+	(void)z_unpend_ready_n(&msgq->wait_q, -1, -ENOMSG);
 
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
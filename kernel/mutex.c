@@ -24,6 +24,11 @@
  * When releasing the mutex, thread A must release M2 before it releases M1.
  * Failure to follow this nested model may result in threads running at
  * unexpected priority levels (too high, or too low).
+ *
+ * Inheritance is transitive: if the owner is itself waiting on a mutex, the
+ * boost is passed on to that mutex's owner, and so on for up to
+ * CONFIG_PRIORITY_INHERITANCE_DEPTH owners.  A waiter timing out lowers the
+ * owners along the chain again.
  */
 
 #include <kernel.h>
@@ -113,6 +118,110 @@ static bool adjust_owner_prio(struct k_mutex *mutex, s32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_PRIORITY_INHERITANCE_STATS
+static struct k_mutex_pi_stats pi_stats;
+
+#define PI_STATS_INC(field) (pi_stats.field++)
+
+static void pi_stats_depth(u32_t depth)
+{
+	pi_stats.max_chain_depth = MAX(pi_stats.max_chain_depth, depth);
+}
+
+void k_mutex_pi_stats_get(struct k_mutex_pi_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*stats = pi_stats;
+	k_spin_unlock(&lock, key);
+}
+
+void k_mutex_pi_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	pi_stats = (struct k_mutex_pi_stats) {};
+	k_spin_unlock(&lock, key);
+}
+#else
+#define PI_STATS_INC(field) do { } while (false)
+#define pi_stats_depth(depth) do { } while (false)
+#endif
+
+#if (CONFIG_PRIORITY_INHERITANCE_DEPTH > 1)
+/* Mutex that a thread is blocked on, or NULL */
+static struct k_mutex *blocking_mutex(struct k_thread *thread)
+{
+	struct k_mutex *mutex = thread->base.pended_mutex;
+
+	/* Cleared lazily once the wait ends: check it still applies */
+	if (mutex == NULL || !z_is_thread_pending(thread) ||
+	    thread->base.pended_on != &mutex->wait_q) {
+		return NULL;
+	}
+
+	return mutex;
+}
+
+static void set_pended_mutex(struct k_thread *thread, struct k_mutex *mutex)
+{
+	thread->base.pended_mutex = mutex;
+}
+#else
+#define blocking_mutex(thread) ((struct k_mutex *)NULL)
+#define set_pended_mutex(thread, mutex) do { } while (false)
+#endif
+
+/*
+ * The priority of @a thread, which owns a mutex, has changed: pass the
+ * change on along the chain of mutexes that owners are blocked on.  When
+ * @a boost is set owners are only ever raised; otherwise each is
+ * recomputed from its original priority and its best waiter, like the
+ * direct owner on a waiter timeout.
+ */
+static bool update_pi_chain(struct k_thread *thread, bool boost)
+{
+	bool resched = false;
+	u32_t depth;
+
+	for (depth = 1U; depth < CONFIG_PRIORITY_INHERITANCE_DEPTH; depth++) {
+		struct k_mutex *next = blocking_mutex(thread);
+		struct k_thread *waiter;
+		s32_t new_prio;
+
+		if (next == NULL) {
+			break;
+		}
+
+		waiter = z_waitq_head(&next->wait_q);
+		new_prio = (waiter != NULL) ?
+			new_prio_for_inheritance(waiter->base.prio,
+						 next->owner_orig_prio) :
+			next->owner_orig_prio;
+
+		if (new_prio == next->owner->base.prio ||
+		    (boost && !z_is_prio_higher(new_prio,
+						next->owner->base.prio))) {
+			break;
+		}
+
+		K_DEBUG("%p: passing prio %d on to %p via mutex %p\n",
+			thread, new_prio, next->owner, next);
+
+		PI_STATS_INC(chain_updates);
+		resched = adjust_owner_prio(next, new_prio) || resched;
+		thread = next->owner;
+	}
+
+	pi_stats_depth(depth);
+	if (depth == CONFIG_PRIORITY_INHERITANCE_DEPTH &&
+	    blocking_mutex(thread) != NULL) {
+		PI_STATS_INC(depth_limit_hits);
+	}
+
+	return resched;
+}
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 {
 	int new_prio;
@@ -153,9 +262,13 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 	K_DEBUG("adjusting prio up on mutex %p\n", mutex);
 
 	if (z_is_prio_higher(new_prio, mutex->owner->base.prio)) {
+		PI_STATS_INC(boosts);
 		resched = adjust_owner_prio(mutex, new_prio);
+		resched = update_pi_chain(mutex->owner, true) || resched;
 	}
 
+	set_pended_mutex(_current, mutex);
+
 	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
 
 	K_DEBUG("on mutex %p got_mutex value: %d\n", mutex, got_mutex);
@@ -174,6 +287,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 
 	key = k_spin_lock(&lock);
 
+	set_pended_mutex(_current, NULL);
+
 	struct k_thread *waiter = z_waitq_head(&mutex->wait_q);
 
 	new_prio = mutex->owner_orig_prio;
@@ -184,6 +299,7 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 	K_DEBUG("adjusting prio down on mutex %p\n", mutex);
 
 	resched = adjust_owner_prio(mutex, new_prio) || resched;
+	resched = update_pi_chain(mutex->owner, false) || resched;
 
 	if (resched) {
 		z_reschedule(&lock, key);
@@ -239,6 +355,7 @@ void z_impl_k_mutex_unlock(struct k_mutex *mutex)
 		 * ajust its priority
 		 */
 		mutex->owner_orig_prio = new_owner->base.prio;
+		set_pended_mutex(new_owner, NULL);
 		arch_thread_return_value_set(new_owner, 0);
 		z_ready_thread(new_owner);
 		z_reschedule(&lock, key);
@@ -738,6 +738,127 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 				    min_xfer, timeout);
 }
 
+/* Contiguous free space and data at the write and read indexes */
+static size_t pipe_put_run(struct k_pipe *pipe)
+{
+	return MIN(pipe->size - pipe->bytes_used,
+		   pipe->size - pipe->write_index);
+}
+
+static size_t pipe_get_run(struct k_pipe *pipe)
+{
+	return MIN(pipe->bytes_used, pipe->size - pipe->read_index);
+}
+
+size_t k_pipe_put_claim(struct k_pipe *pipe, u8_t **data, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	size = MIN(size, pipe_put_run(pipe));
+	*data = pipe->buffer + pipe->write_index;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return size;
+}
+
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	struct k_thread *thread;
+
+	if (size > pipe_put_run(pipe)) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index == pipe->size) {
+		pipe->write_index = 0;
+	}
+
+	/*
+	 * Readers only wait on an empty pipe, so whatever is buffered now
+	 * is the new data.  Hand it out in wait_q order; a reader that
+	 * still wants more stays pended with what it got so far.
+	 */
+	while (pipe->bytes_used != 0 &&
+	       (thread = z_waitq_head(&pipe->wait_q.readers)) != NULL) {
+		struct k_pipe_desc *desc = thread->base.swap_data;
+		size_t bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						      desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		if (desc->bytes_to_xfer != 0) {
+			break;
+		}
+
+		z_unpend_thread(thread);
+		z_ready_thread(thread);
+	}
+
+	z_reschedule(&pipe->lock, key);
+
+	return 0;
+}
+
+size_t k_pipe_get_claim(struct k_pipe *pipe, u8_t **data, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	size = MIN(size, pipe_get_run(pipe));
+	*data = pipe->buffer + pipe->read_index;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return size;
+}
+
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	struct k_thread *thread;
+
+	if (size > pipe_get_run(pipe)) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index == pipe->size) {
+		pipe->read_index = 0;
+	}
+
+	/*
+	 * Writers only wait on a full pipe: let them refill the space
+	 * just freed, in wait_q order, readying those that are done.
+	 */
+	while (pipe->bytes_used != pipe->size &&
+	       (thread = z_waitq_head(&pipe->wait_q.writers)) != NULL) {
+		struct k_pipe_desc *desc = thread->base.swap_data;
+		size_t bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						      desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		if (desc->bytes_to_xfer != 0) {
+			break;
+		}
+
+		z_unpend_thread(thread);
+		pipe_thread_ready(thread);
+	}
+
+	z_reschedule(&pipe->lock, key);
+
+	return 0;
+}
+
 #ifdef CONFIG_USERSPACE
 int z_vrfy_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 		     size_t *bytes_written, size_t min_xfer, s32_t timeout)
@@ -68,6 +68,22 @@ static inline bool is_condition_met(struct k_poll_event *event, u32_t *state)
 			return true;
 		}
 		break;
+	case K_POLL_TYPE_MPSC_DATA_AVAILABLE:
+		/* Ask producers to signal us before looking, see
+		 * k_mpsc_put()
+		 */
+		(void)atomic_set(&event->mpsc->waiting, 1);
+		if (!k_mpsc_is_empty(event->mpsc)) {
+			*state = K_POLL_STATE_DATA_AVAILABLE;
+			return true;
+		}
+		break;
+	case K_POLL_TYPE_EVENT:
+		if (event->event->events != 0U) {
+			*state = K_POLL_STATE_EVENT_SET;
+			return true;
+		}
+		break;
 	case K_POLL_TYPE_SIGNAL:
 		if (event->signal->signaled != 0U) {
 			*state = K_POLL_STATE_SIGNALED;
@@ -121,6 +137,14 @@ static inline int register_event(struct k_poll_event *event,
 		__ASSERT(event->queue != NULL, "invalid queue\n");
 		add_event(&event->queue->poll_events, event, poller);
 		break;
+	case K_POLL_TYPE_MPSC_DATA_AVAILABLE:
+		__ASSERT(event->mpsc != NULL, "invalid mpsc queue\n");
+		add_event(&event->mpsc->poll_events, event, poller);
+		break;
+	case K_POLL_TYPE_EVENT:
+		__ASSERT(event->event != NULL, "invalid event object\n");
+		add_event(&event->event->poll_events, event, poller);
+		break;
 	case K_POLL_TYPE_SIGNAL:
 		__ASSERT(event->signal != NULL, "invalid poll signal\n");
 		add_event(&event->signal->poll_events, event, poller);
@@ -154,6 +178,14 @@ static inline void clear_event_registration(struct k_poll_event *event)
 		__ASSERT(event->queue != NULL, "invalid queue\n");
 		remove = true;
 		break;
+	case K_POLL_TYPE_MPSC_DATA_AVAILABLE:
+		__ASSERT(event->mpsc != NULL, "invalid mpsc queue\n");
+		remove = true;
+		break;
+	case K_POLL_TYPE_EVENT:
+		__ASSERT(event->event != NULL, "invalid event object\n");
+		remove = true;
+		break;
 	case K_POLL_TYPE_SIGNAL:
 		__ASSERT(event->signal != NULL, "invalid poll signal\n");
 		remove = true;
@@ -357,6 +389,9 @@ static inline int z_vrfy_k_poll(struct k_poll_event *events,
 		case K_POLL_TYPE_DATA_AVAILABLE:
 			Z_OOPS(Z_SYSCALL_OBJ(e->queue, K_OBJ_QUEUE));
 			break;
+		case K_POLL_TYPE_EVENT:
+			Z_OOPS(Z_SYSCALL_OBJ(e->event, K_OBJ_EVENT));
+			break;
 		default:
 			ret = -EINVAL;
 			goto out_free;
@@ -690,3 +725,179 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+/* must be called with interrupts locked */
+static void poll_set_wake(struct k_poll_set *set)
+{
+	struct k_thread *thread = z_unpend_first_thread(&set->wait_q);
+
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+}
+
+/*
+ * The signaling object has already unlinked the event from its poll list,
+ * so it can go straight to the set's ready list. It stays there, without
+ * any registration, until reported and then re-armed by k_poll_set_wait().
+ */
+static int poll_set_cb(struct k_poll_event *event, u32_t state)
+{
+	struct k_poll_set *set =
+		CONTAINER_OF(event->poller, struct k_poll_set, poller);
+
+	sys_dlist_append(&set->ready, &event->_node);
+	poll_set_wake(set);
+
+	return 0;
+}
+
+/* must be called with interrupts locked */
+static bool poll_set_arm(struct k_poll_set *set, struct k_poll_event *event)
+{
+	u32_t state;
+
+	if (is_condition_met(event, &state)) {
+		event->poller = NULL;
+		event->state = state;
+		sys_dlist_append(&set->ready, &event->_node);
+		return true;
+	}
+
+	event->state = K_POLL_STATE_NOT_READY;
+	(void)register_event(event, &set->poller);
+
+	return false;
+}
+
+/* must be called with interrupts locked */
+static int poll_set_collect(struct k_poll_set *set,
+			    struct k_poll_event **events, int max_events)
+{
+	sys_dnode_t *node;
+	int count = 0;
+
+	while (count < max_events) {
+		struct k_poll_event *event;
+		u32_t state;
+
+		node = sys_dlist_get(&set->ready);
+		if (node == NULL) {
+			break;
+		}
+
+		event = CONTAINER_OF(node, struct k_poll_event, _node);
+		state = event->state & K_POLL_STATE_CANCELLED;
+
+		/* Another thread may have consumed the object since */
+		if (state == 0U && !is_condition_met(event, &state)) {
+			event->state = K_POLL_STATE_NOT_READY;
+			(void)register_event(event, &set->poller);
+			continue;
+		}
+
+		event->state = state;
+		sys_dlist_append(&set->reported, node);
+		events[count++] = event;
+	}
+
+	return count;
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = true;
+	set->poller.thread = _current;
+	set->poller.cb = poll_set_cb;
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->reported);
+	z_waitq_init(&set->wait_q);
+}
+
+void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	__ASSERT(event->mode == K_POLL_MODE_NOTIFY_ONLY,
+		 "only NOTIFY_ONLY mode is supported\n");
+
+	if (poll_set_arm(set, event)) {
+		poll_set_wake(set);
+	}
+
+	z_reschedule(&lock, key);
+}
+
+void k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	ARG_UNUSED(set);
+
+	/* Whether on an object's list or on one of the set's own */
+	if (sys_dnode_is_linked(&event->_node)) {
+		sys_dlist_remove(&event->_node);
+	}
+	event->poller = NULL;
+	event->state = K_POLL_STATE_NOT_READY;
+
+	k_spin_unlock(&lock, key);
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int max_events, s32_t timeout)
+{
+	k_spinlock_key_t key;
+	sys_dnode_t *node;
+	s64_t end = 0;
+	int count;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT(events != NULL, "NULL events\n");
+	__ASSERT(max_events > 0, "zero events\n");
+
+	if (timeout > 0) {
+		end = k_uptime_get() + timeout;
+	}
+
+	key = k_spin_lock(&lock);
+
+	set->poller.thread = _current;
+
+	while ((node = sys_dlist_get(&set->reported)) != NULL) {
+		(void)poll_set_arm(set,
+				   CONTAINER_OF(node, struct k_poll_event, _node));
+	}
+
+	for (;;) {
+		count = poll_set_collect(set, events, max_events);
+		if (count > 0) {
+			k_spin_unlock(&lock, key);
+			return count;
+		}
+
+		if (timeout == K_NO_WAIT) {
+			k_spin_unlock(&lock, key);
+			return -EAGAIN;
+		}
+
+		ret = z_pend_curr(&lock, key, &set->wait_q, timeout);
+		if (ret != 0) {
+			return ret;
+		}
+
+		/* A wakeup whose event went unready again before we ran must
+		 * not restart the full timeout.
+		 */
+		if (timeout != K_FOREVER) {
+			timeout = end - k_uptime_get();
+			if (timeout < 0) {
+				timeout = K_NO_WAIT;
+			}
+		}
+
+		key = k_spin_lock(&lock);
+	}
+}
@@ -13,6 +13,7 @@
 #include <syscall_handler.h>
 #include <drivers/timer/system_timer.h>
 #include <stdbool.h>
+#include <string.h>
 #include <kernel_internal.h>
 
 #if defined(CONFIG_SCHED_DUMB)
@@ -167,9 +168,201 @@ static ALWAYS_INLINE struct k_thread *_priq_dumb_mask_best(sys_dlist_t *pq)
 }
 #endif
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* Home CPU of a thread: the one it last ran on, unless its affinity
+ * mask forbids that, in which case the first CPU it may run on.
+ */
+static ALWAYS_INLINE int runq_cpu(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	if ((thread->base.cpu_mask & BIT(thread->base.cpu)) == 0U &&
+	    thread->base.cpu_mask != 0U) {
+		return __builtin_ctz(thread->base.cpu_mask);
+	}
+#endif
+	return thread->base.cpu;
+}
+#endif
+
+static ALWAYS_INLINE struct _ready_q *thread_runq(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+#ifdef CONFIG_SCHED_CPU_MASK
+	/* Threads allowed on no CPU at all are parked on the global
+	 * queue, which runq_best() never looks at in this mode
+	 */
+	if (thread->base.cpu_mask == 0U) {
+		return &_kernel.ready_q;
+	}
+#endif
+	return &_kernel.cpus[thread->base.cpu].ready_q;
+#else
+	ARG_UNUSED(thread);
+	return &_kernel.ready_q;
+#endif
+}
+
+#ifdef CONFIG_SCHED_STATS
+/* Scheduler instrumentation, all protected by sched_spinlock */
+static struct {
+	u32_t switches;
+	u32_t wakeups;
+	u32_t max_latency_us;
+	u32_t hist[K_SCHED_STATS_PRIOS][CONFIG_SCHED_STATS_HIST_BUCKETS];
+} sched_stats;
+
+static void stats_runq_add(struct _ready_q *rq)
+{
+	rq->depth++;
+	if (rq->depth > rq->max_depth) {
+		rq->max_depth = rq->depth;
+	}
+}
+
+static void stats_wakeup(struct k_thread *thread)
+{
+	u32_t now = k_cycle_get_32();
+
+	/* 0 is reserved for "not waiting to run" */
+	thread->base.ready_stamp = now != 0U ? now : 1U;
+	sched_stats.wakeups++;
+}
+
+/* The scheduler picked th to run next on this CPU */
+static void stats_selected(struct k_thread *th)
+{
+	u32_t us, bucket;
+	int prio;
+
+	if (th != _current) {
+		sched_stats.switches++;
+	}
+
+	if (th->base.ready_stamp == 0U) {
+		return;
+	}
+
+	us = k_cyc_to_us_floor32(k_cycle_get_32() - th->base.ready_stamp);
+	th->base.ready_stamp = 0U;
+
+	bucket = us == 0U ? 0U : 32U - __builtin_clz(us);
+	bucket = MIN(bucket, CONFIG_SCHED_STATS_HIST_BUCKETS - 1);
+
+	prio = MAX(MIN(th->base.prio, K_LOWEST_THREAD_PRIO),
+		   K_HIGHEST_THREAD_PRIO);
+	sched_stats.hist[prio - K_HIGHEST_THREAD_PRIO][bucket]++;
+	sched_stats.max_latency_us = MAX(sched_stats.max_latency_us, us);
+}
+#else
+#define stats_runq_add(rq) do { } while (false)
+#define stats_wakeup(thread) do { } while (false)
+#define stats_selected(th) do { } while (false)
+#endif
+
+static ALWAYS_INLINE void runq_add(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	thread->base.cpu = runq_cpu(thread);
+#endif
+	_priq_run_add(&thread_runq(thread)->runq, thread);
+	stats_runq_add(thread_runq(thread));
+}
+
+static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
+{
+	_priq_run_remove(&thread_runq(thread)->runq, thread);
+#ifdef CONFIG_SCHED_STATS
+	thread_runq(thread)->depth--;
+#endif
+}
+
+static ALWAYS_INLINE struct k_thread *runq_best(void)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* Prefer the local queue and steal from another CPU only when
+	 * it holds a strictly better thread (or we have nothing).  The
+	 * heads of all queues are still compared, so the highest
+	 * priority runnable threads always run, but equal-priority
+	 * work stays on the CPU whose cache it last warmed.
+	 */
+	struct k_thread *th = _priq_run_best(&_current_cpu->ready_q.runq);
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *t;
+
+		if (i == _current_cpu->id) {
+			continue;
+		}
+
+		t = _priq_run_best(&_kernel.cpus[i].ready_q.runq);
+#if defined(CONFIG_SCHED_CPU_MASK) && !defined(CONFIG_SCHED_DUMB)
+		/* Only the DUMB backend walks past threads masked off
+		 * this CPU, the others can only steal the head
+		 */
+		if (t != NULL &&
+		    (t->base.cpu_mask & BIT(_current_cpu->id)) == 0U) {
+			t = NULL;
+		}
+#endif
+		if (t != NULL &&
+		    (th == NULL || z_is_t1_higher_prio_than_t2(t, th))) {
+			th = t;
+		}
+	}
+
+	return th;
+#else
+	return _priq_run_best(&_kernel.ready_q.runq);
+#endif
+}
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* Returns the other CPU that should switch to the newly readied
+ * thread, judged against the thread its last next_up() selected (the
+ * one it is running or about to switch to), as a bitmask.  CPUs that
+ * are busy with higher priority or cooperative work don't need to be
+ * interrupted.  A single CPU is picked, as only one can run the
+ * thread: an idle one if any, else the one running the least
+ * important preemptible thread.  CPUs in @a taken, already picked for
+ * other threads of the same batch, are left out.
+ */
+static u32_t ipi_cpus(struct k_thread *thread, u32_t taken)
+{
+	struct k_thread *victim = NULL;
+	u32_t cpus = 0U;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *sel = _kernel.cpus[i].selected;
+
+		if (i == _current_cpu->id || (taken & BIT(i)) != 0U) {
+			continue;
+		}
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		if ((thread->base.cpu_mask & BIT(i)) == 0U) {
+			continue;
+		}
+#endif
+
+		if (sel == NULL || z_is_idle_thread_object(sel)) {
+			return BIT(i);
+		}
+
+		if (z_is_t1_higher_prio_than_t2(thread, sel) &&
+		    (is_preempt(sel) || is_metairq(thread)) &&
+		    (victim == NULL || z_is_t1_higher_prio_than_t2(victim, sel))) {
+			victim = sel;
+			cpus = BIT(i);
+		}
+	}
+
+	return cpus;
+}
+#endif
+
 static ALWAYS_INLINE struct k_thread *next_up(void)
 {
-	struct k_thread *th = _priq_run_best(&_kernel.ready_q.runq);
+	struct k_thread *th = runq_best();
 
 #if (CONFIG_NUM_METAIRQ_PRIORITIES > 0) && (CONFIG_NUM_COOP_PRIORITIES > 0)
 	/* MetaIRQs must always attempt to return back to a
@@ -229,16 +422,21 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 	/* Put _current back into the queue */
 	if (th != _current && active && !z_is_idle_thread_object(_current) &&
 	    !queued) {
-		_priq_run_add(&_kernel.ready_q.runq, _current);
+		runq_add(_current);
 		z_mark_thread_as_queued(_current);
 	}
 
 	/* Take the new _current out of the queue */
 	if (z_is_thread_queued(th)) {
-		_priq_run_remove(&_kernel.ready_q.runq, th);
+		runq_remove(th);
 	}
 	z_mark_thread_as_not_queued(th);
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	_current_cpu->selected = th;
+#endif
+	stats_selected(th);
+
 	return th;
 #endif
 }
@@ -328,6 +526,202 @@ static void update_metairq_preempt(struct k_thread *th)
 #endif
 }
 
+#ifdef CONFIG_SCHED_CBS
+/* Constant bandwidth server (CBS) reservations.  A reserved thread owns
+ * a budget of Q ticks in every period of T ticks and is ordered by the
+ * absolute deadline of its server, mirrored into the same prio_deadline
+ * key k_thread_deadline_set() uses.  Budget is charged while the thread
+ * is the one selected to run.  Its cbs.timer fires when the budget runs
+ * out, and again at the server deadline to replenish a throttled
+ * thread.  All of this is protected by sched_spinlock.
+ */
+static u32_t cbs_total_util;
+static struct k_thread *cbs_running;
+static s64_t cbs_started;
+
+static void update_cache(int preempt_ok);
+static void cbs_timer_expired(struct _timeout *t);
+
+static inline bool is_cbs(struct k_thread *th)
+{
+	return th->base.cbs.budget != 0U;
+}
+
+static void cbs_set_prio_deadline(struct k_thread *th, s64_t now)
+{
+	u64_t cyc = k_ticks_to_cyc_floor64(MAX(th->base.cbs.deadline - now, 0));
+
+	th->base.prio_deadline = k_cycle_get_32() + (u32_t)MIN(cyc, INT32_MAX);
+}
+
+static void cbs_requeue(struct k_thread *th)
+{
+	if (z_is_thread_queued(th)) {
+		runq_remove(th);
+		runq_add(th);
+	}
+}
+
+/* Start a server period at now with a full budget */
+static void cbs_new_period(struct k_thread *th, s64_t now)
+{
+	th->base.cbs.remaining = th->base.cbs.budget;
+	th->base.cbs.deadline = now + th->base.cbs.period;
+	cbs_set_prio_deadline(th, now);
+}
+
+/* A thread becoming runnable keeps its current budget and deadline
+ * only if spending the rest of that budget before the deadline stays
+ * within its bandwidth, i.e. c < (d - t) * Q / T.
+ */
+static void cbs_wakeup(struct k_thread *th)
+{
+	struct _thread_cbs *cbs = &th->base.cbs;
+	s64_t now;
+
+	if (!is_cbs(th)) {
+		return;
+	}
+
+	now = z_tick_get();
+	if (now >= cbs->deadline ||
+	    (s64_t)cbs->remaining * cbs->period >=
+	    (cbs->deadline - now) * cbs->budget) {
+		cbs_new_period(th, now);
+	} else {
+		cbs_set_prio_deadline(th, now);
+	}
+}
+
+static void cbs_charge(struct k_thread *th, s64_t now)
+{
+	th->base.cbs.remaining -= (s32_t)(now - cbs_started);
+	cbs_started = now;
+}
+
+static void cbs_arm(struct k_thread *th)
+{
+	z_add_timeout(&th->base.cbs.timer, cbs_timer_expired,
+		      th->base.cbs.remaining);
+}
+
+/* The budget ran out: throttle the thread until its deadline, or if
+ * that has already passed, start over at once with a new deadline.
+ * Returns true if the thread was throttled.
+ */
+static bool cbs_exhausted(struct k_thread *th, s64_t now)
+{
+	struct _thread_cbs *cbs = &th->base.cbs;
+
+	if (now >= cbs->deadline) {
+		cbs_new_period(th, now);
+		cbs_requeue(th);
+		return false;
+	}
+
+	th->base.thread_state |= _THREAD_THROTTLED;
+	if (z_is_thread_queued(th)) {
+		runq_remove(th);
+		z_mark_thread_as_not_queued(th);
+	}
+	z_add_timeout(&cbs->timer, cbs_timer_expired,
+		      (s32_t)(cbs->deadline - now));
+	return true;
+}
+
+static void cbs_timer_expired(struct _timeout *t)
+{
+	struct k_thread *th = CONTAINER_OF(t, struct k_thread, base.cbs.timer);
+
+	LOCKED(&sched_spinlock) {
+		s64_t now = z_tick_get();
+
+		if ((th->base.thread_state & _THREAD_THROTTLED) != 0U) {
+			th->base.thread_state &= ~_THREAD_THROTTLED;
+			cbs_new_period(th, now);
+			if (z_is_thread_ready(th)) {
+				runq_add(th);
+				z_mark_thread_as_queued(th);
+				stats_wakeup(th);
+			}
+		} else if (th == cbs_running) {
+			cbs_charge(th, now);
+			if (th->base.cbs.remaining > 0 ||
+			    !cbs_exhausted(th, now)) {
+				cbs_arm(th);
+			} else {
+				cbs_running = NULL;
+			}
+		}
+
+		update_cache(th == _current);
+	}
+}
+
+/* The scheduler picked th to run next */
+static void cbs_selected(struct k_thread *th)
+{
+	struct k_thread *prev = cbs_running;
+	s64_t now;
+
+	if (th == prev || (prev == NULL && !is_cbs(th))) {
+		return;
+	}
+
+	now = z_tick_get();
+	if (prev != NULL) {
+		cbs_running = NULL;
+		(void)z_abort_timeout(&prev->base.cbs.timer);
+		cbs_charge(prev, now);
+		if (prev->base.cbs.remaining <= 0) {
+			(void)cbs_exhausted(prev, now);
+		}
+	}
+
+	if (is_cbs(th)) {
+		__ASSERT_NO_MSG(th->base.cbs.remaining > 0);
+		cbs_running = th;
+		cbs_started = now;
+		cbs_arm(th);
+	}
+}
+
+static void cbs_release(struct k_thread *th)
+{
+	if (!is_cbs(th)) {
+		return;
+	}
+
+	(void)z_abort_timeout(&th->base.cbs.timer);
+	if (th == cbs_running) {
+		cbs_running = NULL;
+	}
+
+	cbs_total_util -= th->base.cbs.util;
+	th->base.cbs.budget = 0U;
+	th->base.cbs.util = 0U;
+
+	if ((th->base.thread_state & _THREAD_THROTTLED) != 0U) {
+		th->base.thread_state &= ~_THREAD_THROTTLED;
+		if (z_is_thread_ready(th)) {
+			runq_add(th);
+			z_mark_thread_as_queued(th);
+		}
+		update_cache(0);
+	}
+}
+
+void z_sched_cbs_release(struct k_thread *thread)
+{
+	LOCKED(&sched_spinlock) {
+		cbs_release(thread);
+	}
+}
+#else
+#define cbs_wakeup(th) do { } while (false)
+#define cbs_selected(th) do { } while (false)
+#endif
+
 static void update_cache(int preempt_ok)
 {
 #ifndef CONFIG_SMP
@@ -340,6 +734,12 @@ static void update_cache(int preempt_ok)
 		}
 #endif
 		update_metairq_preempt(th);
+#ifdef CONFIG_SCHED_STATS
+		if (th != _kernel.ready_q.cache) {
+			stats_selected(th);
+		}
+#endif
+		cbs_selected(th);
 		_kernel.ready_q.cache = th;
 	} else {
 		_kernel.ready_q.cache = _current;
@@ -356,14 +756,50 @@ static void update_cache(int preempt_ok)
 #endif
 }
 
+/* Queues a thread that became runnable, the caller updates the cache */
+static void add_to_ready_q_locked(struct k_thread *thread)
+{
+	cbs_wakeup(thread);
+	runq_add(thread);
+	z_mark_thread_as_queued(thread);
+	stats_wakeup(thread);
+}
+
+#if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
+/* CPUs to interrupt for a thread that became runnable, as a bitmask,
+ * besides the ones in @a taken
+ */
+static u32_t wakeup_ipi_cpus(struct k_thread *thread, u32_t taken)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	return ipi_cpus(thread, taken);
+#else
+	ARG_UNUSED(thread);
+	return BIT_MASK(CONFIG_MP_NUM_CPUS) & ~BIT(_current_cpu->id) & ~taken;
+#endif
+}
+
+static void wakeup_ipi(u32_t cpus)
+{
+	if (cpus == 0U) {
+		return;
+	}
+
+#ifdef CONFIG_SCHED_IPI_DIRECTED
+	arch_sched_directed_ipi(cpus);
+#else
+	arch_sched_ipi();
+#endif
+}
+#endif
+
 void z_add_thread_to_ready_q(struct k_thread *thread)
 {
 	LOCKED(&sched_spinlock) {
-		_priq_run_add(&_kernel.ready_q.runq, thread);
-		z_mark_thread_as_queued(thread);
+		add_to_ready_q_locked(thread);
 		update_cache(0);
 #if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
-		arch_sched_ipi();
+		wakeup_ipi(wakeup_ipi_cpus(thread, 0U));
 #endif
 	}
 }
@@ -372,9 +808,9 @@ void z_move_thread_to_end_of_prio_q(struct k_thread *thread)
 {
 	LOCKED(&sched_spinlock) {
 		if (z_is_thread_queued(thread)) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
+			runq_remove(thread);
 		}
-		_priq_run_add(&_kernel.ready_q.runq, thread);
+		runq_add(thread);
 		z_mark_thread_as_queued(thread);
 		update_cache(thread == _current);
 	}
@@ -384,7 +820,7 @@ void z_remove_thread_from_ready_q(struct k_thread *thread)
 {
 	LOCKED(&sched_spinlock) {
 		if (z_is_thread_queued(thread)) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
+			runq_remove(thread);
 			z_mark_thread_as_not_queued(thread);
 		}
 		update_cache(thread == _current);
@@ -530,13 +966,21 @@ bool z_set_prio(struct k_thread *thread, int prio)
 		if (need_sched) {
 			/* Don't requeue on SMP if it's the running thread */
 			if (!IS_ENABLED(CONFIG_SMP) || z_is_thread_queued(thread)) {
-				_priq_run_remove(&_kernel.ready_q.runq, thread);
+				runq_remove(thread);
 				thread->base.prio = prio;
-				_priq_run_add(&_kernel.ready_q.runq, thread);
+				runq_add(thread);
 			} else {
 				thread->base.prio = prio;
 			}
 			update_cache(1);
+		} else if (z_is_thread_pending(thread) &&
+			   thread->base.pended_on != NULL) {
+			/* Keep the wait queue in priority order */
+			_priq_wait_remove(&thread->base.pended_on->waitq,
+					  thread);
+			thread->base.prio = prio;
+			z_priq_wait_add(&thread->base.pended_on->waitq,
+					thread);
 		} else {
 			thread->base.prio = prio;
 		}
@@ -637,6 +1081,7 @@ void *z_get_next_switch_handle(void *interrupted)
 	_current->switch_handle = interrupted;
 
 	z_check_stack_sentinel();
+	z_sched_usage_switch();
 
 #ifdef CONFIG_SMP
 	LOCKED(&sched_spinlock) {
@@ -831,28 +1276,58 @@ struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 	return t;
 }
 
-int z_unpend_all(_wait_q_t *wait_q)
+int z_unpend_ready_n(_wait_q_t *wait_q, int max, int swap_retval)
 {
-	int need_sched = 0;
 	struct k_thread *th;
+	int n = 0;
+#if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
+	u32_t ipi = 0U;
+#endif
 
-	while ((th = z_waitq_head(wait_q)) != NULL) {
-		z_unpend_thread(th);
-		z_ready_thread(th);
-		need_sched = 1;
+	LOCKED(&sched_spinlock) {
+		while ((max < 0 || n < max) &&
+		       (th = _priq_wait_best(&wait_q->waitq)) != NULL) {
+			_priq_wait_remove(&wait_q->waitq, th);
+			z_mark_thread_as_not_pending(th);
+			th->base.pended_on = NULL;
+			(void)z_abort_thread_timeout(th);
+			arch_thread_return_value_set(th, swap_retval);
+
+			if (z_is_thread_ready(th)) {
+				add_to_ready_q_locked(th);
+#if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
+				ipi |= wakeup_ipi_cpus(th, ipi);
+#endif
+			}
+			sys_trace_thread_ready(th);
+			n++;
+		}
+
+		/* One scheduling decision for the whole batch */
+		if (n != 0) {
+			update_cache(0);
+		}
+#if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
+		wakeup_ipi(ipi);
+#endif
 	}
 
-	return need_sched;
+	return n;
 }
 
-void z_sched_init(void)
+int z_unpend_all(_wait_q_t *wait_q)
+{
+	return z_unpend_ready_n(wait_q, -1, 0) != 0;
+}
+
+static void init_ready_q(struct _ready_q *rq)
 {
 #ifdef CONFIG_SCHED_DUMB
-	sys_dlist_init(&_kernel.ready_q.runq);
+	sys_dlist_init(&rq->runq);
 #endif
 
 #ifdef CONFIG_SCHED_SCALABLE
-	_kernel.ready_q.runq = (struct _priq_rb) {
+	rq->runq = (struct _priq_rb) {
 		.tree = {
 			.lessthan_fn = z_priq_rb_lessthan,
 		}
@@ -860,10 +1335,20 @@ void z_sched_init(void)
 #endif
 
 #ifdef CONFIG_SCHED_MULTIQ
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
-		sys_dlist_init(&_kernel.ready_q.runq.queues[i]);
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
+		sys_dlist_init(&rq->runq.queues[i]);
 	}
 #endif
+}
+
+void z_sched_init(void)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		init_ready_q(&_kernel.cpus[i].ready_q);
+	}
+#endif
+	init_ready_q(&_kernel.ready_q);
 
 #ifdef CONFIG_TIMESLICING
 	k_sched_time_slice_set(CONFIG_TIMESLICE_SIZE,
@@ -871,6 +1356,61 @@ void z_sched_init(void)
 #endif
 }
 
+#ifdef CONFIG_SCHED_STATS
+static u32_t total_runq_depth(bool max)
+{
+	u32_t n = max ? _kernel.ready_q.max_depth : _kernel.ready_q.depth;
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		n += max ? _kernel.cpus[i].ready_q.max_depth :
+			_kernel.cpus[i].ready_q.depth;
+	}
+#endif
+
+	return n;
+}
+
+void k_sched_stats_get(struct k_sched_stats *stats)
+{
+	LOCKED(&sched_spinlock) {
+		stats->switches = sched_stats.switches;
+		stats->wakeups = sched_stats.wakeups;
+		stats->max_latency_us = sched_stats.max_latency_us;
+		stats->runq_depth = total_runq_depth(false);
+		stats->runq_max_depth = total_runq_depth(true);
+	}
+}
+
+int k_sched_latency_hist_get(int prio, u32_t *hist)
+{
+	if (prio < K_HIGHEST_THREAD_PRIO || prio > K_LOWEST_THREAD_PRIO) {
+		return -EINVAL;
+	}
+
+	LOCKED(&sched_spinlock) {
+		(void)memcpy(hist, sched_stats.hist[prio - K_HIGHEST_THREAD_PRIO],
+			     sizeof(sched_stats.hist[0]));
+	}
+
+	return 0;
+}
+
+void k_sched_stats_reset(void)
+{
+	LOCKED(&sched_spinlock) {
+		(void)memset(&sched_stats, 0, sizeof(sched_stats));
+		_kernel.ready_q.max_depth = _kernel.ready_q.depth;
+#ifdef CONFIG_SCHED_CPU_RUNQ
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			_kernel.cpus[i].ready_q.max_depth =
+				_kernel.cpus[i].ready_q.depth;
+		}
+#endif
+	}
+}
+#endif /* CONFIG_SCHED_STATS */
+
 int z_impl_k_thread_priority_get(k_tid_t thread)
 {
 	return thread->base.prio;
@@ -922,8 +1462,8 @@ void z_impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 	LOCKED(&sched_spinlock) {
 		th->base.prio_deadline = k_cycle_get_32() + deadline;
 		if (z_is_thread_queued(th)) {
-			_priq_run_remove(&_kernel.ready_q.runq, th);
-			_priq_run_add(&_kernel.ready_q.runq, th);
+			runq_remove(th);
+			runq_add(th);
 		}
 	}
 }
@@ -944,6 +1484,74 @@ static inline void z_vrfy_k_thread_deadline_set(k_tid_t tid, int deadline)
 #endif
 #endif
 
+#ifdef CONFIG_SCHED_CBS
+int z_impl_k_thread_cbs_set(k_tid_t tid, u32_t budget_us, u32_t period_us)
+{
+	struct k_thread *th = tid;
+	u32_t budget, period, util;
+	int ret = 0;
+
+	if (budget_us == 0U) {
+		z_sched_cbs_release(th);
+		return 0;
+	}
+
+	if (period_us == 0U || budget_us > period_us) {
+		return -EINVAL;
+	}
+
+	/* Enforcement has tick granularity, so admit what will actually
+	 * be enforced rather than what was asked for
+	 */
+	budget = k_us_to_ticks_ceil32(budget_us);
+	period = k_us_to_ticks_ceil32(period_us);
+	util = (u32_t)(((u64_t)budget * 1000000U) / period);
+
+	LOCKED(&sched_spinlock) {
+		u32_t total = cbs_total_util - th->base.cbs.util + util;
+
+		if (total > CONFIG_SCHED_CBS_MAX_UTILIZATION * 10000U) {
+			ret = -EBUSY;
+		} else {
+			s64_t now = z_tick_get();
+
+			cbs_total_util = total;
+			th->base.cbs.budget = budget;
+			th->base.cbs.period = period;
+			th->base.cbs.util = util;
+
+			if ((th->base.thread_state & _THREAD_THROTTLED) == 0U) {
+				cbs_new_period(th, now);
+				cbs_requeue(th);
+			}
+
+			/* Start enforcing right away if it is running */
+			if (th == _kernel.ready_q.cache) {
+				(void)z_abort_timeout(&th->base.cbs.timer);
+				cbs_running = th;
+				cbs_started = now;
+				cbs_arm(th);
+			}
+
+			update_cache(0);
+		}
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_thread_cbs_set(k_tid_t thread, u32_t budget_us,
+					  u32_t period_us)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(thread, K_OBJ_THREAD));
+
+	return z_impl_k_thread_cbs_set(thread, budget_us, period_us);
+}
+#include <syscalls/k_thread_cbs_set_mrsh.c>
+#endif
+#endif
+
 void z_impl_k_yield(void)
 {
 	__ASSERT(!arch_is_in_isr(), "");
@@ -952,10 +1560,9 @@ void z_impl_k_yield(void)
 		LOCKED(&sched_spinlock) {
 			if (!IS_ENABLED(CONFIG_SMP) ||
 			    z_is_thread_queued(_current)) {
-				_priq_run_remove(&_kernel.ready_q.runq,
-						 _current);
+				runq_remove(_current);
 			}
-			_priq_run_add(&_kernel.ready_q.runq, _current);
+			runq_add(_current);
 			z_mark_thread_as_queued(_current);
 			update_cache(1);
 		}
@@ -971,6 +1578,71 @@ static inline void z_vrfy_k_yield(void)
 #include <syscalls/k_yield_mrsh.c>
 #endif
 
+#ifdef CONFIG_SCHED_THREAD_USAGE
+/* Serializes the 64 bit usage counters, which are not updated atomically
+ * on 32 bit targets and may be read from another CPU.
+ */
+static struct k_spinlock usage_lock;
+
+void z_sched_usage_switch(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&usage_lock);
+	u32_t now = k_cycle_get_32();
+
+	/* Unsigned difference stays right across a counter wrap */
+	_current->usage += now - _current_cpu->usage_start;
+	_current_cpu->usage_start = now;
+
+	k_spin_unlock(&usage_lock, key);
+}
+#endif /* CONFIG_SCHED_THREAD_USAGE */
+
+int z_impl_k_thread_cycles_get(struct k_thread *thread, u64_t *cycles)
+{
+#ifdef CONFIG_SCHED_THREAD_USAGE
+	k_spinlock_key_t key = k_spin_lock(&usage_lock);
+	int i;
+
+	*cycles = thread->usage;
+
+	/* Include the current run, on whichever CPU the thread is on */
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (_kernel.cpus[i].current == thread) {
+			*cycles += k_cycle_get_32() -
+				   _kernel.cpus[i].usage_start;
+			break;
+		}
+	}
+
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+#else
+	ARG_UNUSED(thread);
+	ARG_UNUSED(cycles);
+	return -ENOSYS;
+#endif /* CONFIG_SCHED_THREAD_USAGE */
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_thread_cycles_get(struct k_thread *thread,
+					     u64_t *cycles)
+{
+	u64_t cycles_copy;
+	int ret;
+
+	Z_OOPS(Z_SYSCALL_OBJ(thread, K_OBJ_THREAD));
+	ret = z_impl_k_thread_cycles_get(thread, &cycles_copy);
+	if (ret == 0 && z_user_to_copy(cycles, &cycles_copy,
+				       sizeof(cycles_copy)) != 0) {
+		ret = -EFAULT;
+	}
+
+	return ret;
+}
+#include <syscalls/k_thread_cycles_get_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 static s32_t z_tick_sleep(s32_t ticks)
 {
 #ifdef CONFIG_MULTITHREADING
@@ -1128,7 +1800,7 @@ void z_sched_abort(struct k_thread *thread)
 			thread->base.thread_state |= _THREAD_DEAD;
 			k_spin_unlock(&sched_spinlock, key);
 		} else if (z_is_thread_queued(thread)) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
+			runq_remove(thread);
 			z_mark_thread_as_not_queued(thread);
 			thread->base.thread_state |= _THREAD_DEAD;
 			k_spin_unlock(&sched_spinlock, key);
@@ -1209,12 +1881,23 @@ int k_thread_cpu_mask_enable_all(k_tid_t thread)
 
 int k_thread_cpu_mask_enable(k_tid_t thread, int cpu)
 {
+	__ASSERT(cpu >= 0 && cpu < CONFIG_MP_NUM_CPUS, "invalid cpu %d", cpu);
+
 	return cpu_mask_mod(thread, BIT(cpu), 0);
 }
 
 int k_thread_cpu_mask_disable(k_tid_t thread, int cpu)
 {
+	__ASSERT(cpu >= 0 && cpu < CONFIG_MP_NUM_CPUS, "invalid cpu %d", cpu);
+
 	return cpu_mask_mod(thread, 0, BIT(cpu));
 }
 
+int k_thread_cpu_pin(k_tid_t thread, int cpu)
+{
+	__ASSERT(cpu >= 0 && cpu < CONFIG_MP_NUM_CPUS, "invalid cpu %d", cpu);
+
+	return cpu_mask_mod(thread, BIT(cpu), ~BIT(cpu));
+}
+
 #endif /* CONFIG_SCHED_CPU_MASK */
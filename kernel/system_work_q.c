@@ -18,6 +18,15 @@ K_THREAD_STACK_DEFINE(sys_work_q_stack, CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
 
 struct k_work_q k_sys_work_q;
 
+#if defined(CONFIG_SYSTEM_WORKQUEUE_EXTRA_THREADS) && \
+	CONFIG_SYSTEM_WORKQUEUE_EXTRA_THREADS > 0
+#define EXTRA_THREADS CONFIG_SYSTEM_WORKQUEUE_EXTRA_THREADS
+
+K_THREAD_STACK_ARRAY_DEFINE(sys_work_q_extra_stacks, EXTRA_THREADS,
+			    CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
+static struct k_thread sys_work_q_extra_threads[EXTRA_THREADS];
+#endif
+
 static int k_sys_work_q_init(struct device *dev)
 {
 	ARG_UNUSED(dev);
@@ -28,6 +37,17 @@ static int k_sys_work_q_init(struct device *dev)
 		       CONFIG_SYSTEM_WORKQUEUE_PRIORITY);
 	k_thread_name_set(&k_sys_work_q.thread, "sysworkq");
 
+#ifdef EXTRA_THREADS
+	for (int i = 0; i < EXTRA_THREADS; i++) {
+		k_work_q_worker_add(&k_sys_work_q,
+				    &sys_work_q_extra_threads[i],
+				    sys_work_q_extra_stacks[i],
+				    K_THREAD_STACK_SIZEOF(sys_work_q_extra_stacks[i]),
+				    CONFIG_SYSTEM_WORKQUEUE_PRIORITY);
+		k_thread_name_set(&sys_work_q_extra_threads[i], "sysworkq");
+	}
+#endif
+
 	return 0;
 }
 
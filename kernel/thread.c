@@ -276,6 +276,9 @@ const char *k_thread_state_str(k_tid_t thread_id)
 	case _THREAD_QUEUED:
 		return "queued";
 		break;
+	case _THREAD_THROTTLED:
+		return "throttled";
+		break;
 	}
 	return "unknown";
 }
@@ -314,6 +317,73 @@ static inline int z_vrfy_k_thread_name_copy(k_tid_t t, char *buf, size_t size)
 #endif /* CONFIG_USERSPACE */
 
 
+#ifdef CONFIG_STACK_WATERMARK
+void z_stack_watermark_update(struct k_thread *thread, uintptr_t sp)
+{
+	struct _thread_stack_info *info = &thread->stack_info;
+
+	/* Ignore samples taken off the thread stack, e.g. on the privileged
+	 * stack of a user thread in a system call, or for the dummy thread.
+	 */
+	if (sp < info->start || sp >= info->start + info->size) {
+		return;
+	}
+
+	if (IS_ENABLED(CONFIG_STACK_GROWS_UP) ? sp > info->watermark :
+						 sp < info->watermark) {
+		info->watermark = sp;
+	}
+}
+
+void k_thread_stack_watermark_sample(void)
+{
+	z_stack_watermark_update(_current,
+				 (uintptr_t)__builtin_frame_address(0));
+}
+#else
+void k_thread_stack_watermark_sample(void)
+{
+}
+#endif /* CONFIG_STACK_WATERMARK */
+
+int z_impl_k_thread_stack_watermark_get(struct k_thread *thread, size_t *used)
+{
+#ifdef CONFIG_STACK_WATERMARK
+	struct _thread_stack_info *info = &thread->stack_info;
+
+	if (IS_ENABLED(CONFIG_STACK_GROWS_UP)) {
+		*used = info->watermark - info->start;
+	} else {
+		*used = info->start + info->size - info->watermark;
+	}
+
+	return 0;
+#else
+	ARG_UNUSED(thread);
+	ARG_UNUSED(used);
+	return -ENOSYS;
+#endif /* CONFIG_STACK_WATERMARK */
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_thread_stack_watermark_get(struct k_thread *thread,
+						      size_t *used)
+{
+	size_t used_copy;
+	int ret;
+
+	Z_OOPS(Z_SYSCALL_OBJ(thread, K_OBJ_THREAD));
+	ret = z_impl_k_thread_stack_watermark_get(thread, &used_copy);
+	if (ret == 0 && z_user_to_copy(used, &used_copy,
+				       sizeof(used_copy)) != 0) {
+		ret = -EFAULT;
+	}
+
+	return ret;
+}
+#include <syscalls/k_thread_stack_watermark_get_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 #ifdef CONFIG_STACK_SENTINEL
 /* Check that the stack sentinel is still present
  *
@@ -471,6 +541,10 @@ void z_new_thread_init(struct k_thread *thread,
 #if defined(CONFIG_THREAD_STACK_INFO)
 	thread->stack_info.start = (uintptr_t)pStack;
 	thread->stack_info.size = (u32_t)stackSize;
+#if defined(CONFIG_STACK_WATERMARK)
+	thread->stack_info.watermark = IS_ENABLED(CONFIG_STACK_GROWS_UP) ?
+		(uintptr_t)pStack : (uintptr_t)pStack + stackSize;
+#endif
 #endif /* CONFIG_THREAD_STACK_INFO */
 }
 
@@ -489,6 +563,9 @@ void z_setup_new_thread(struct k_thread *new_thread,
 	z_object_init(new_thread);
 	z_object_init(stack);
 	new_thread->stack_obj = stack;
+#if (CONFIG_USERSPACE_OBJ_CACHE_SIZE > 0)
+	(void)memset(&new_thread->obj_cache, 0, sizeof(new_thread->obj_cache));
+#endif
 
 	/* Any given thread has access to itself */
 	k_object_access_grant(new_thread, new_thread);
@@ -560,6 +637,10 @@ void z_setup_new_thread(struct k_thread *new_thread,
 #endif
 #ifdef CONFIG_SCHED_DEADLINE
 	new_thread->base.prio_deadline = 0;
+#endif
+#ifdef CONFIG_SCHED_CBS
+	(void)memset(&new_thread->base.cbs, 0, sizeof(new_thread->base.cbs));
+	z_init_timeout(&new_thread->base.cbs.timer);
 #endif
 	new_thread->resource_pool = _current->resource_pool;
 	sys_trace_thread_create(new_thread);
@@ -722,6 +803,10 @@ void z_thread_single_abort(struct k_thread *thread)
 		thread->fn_abort();
 	}
 
+	if (IS_ENABLED(CONFIG_SCHED_CBS)) {
+		z_sched_cbs_release(thread);
+	}
+
 	if (IS_ENABLED(CONFIG_SMP)) {
 		z_sched_abort(thread);
 	}
@@ -882,6 +967,53 @@ void z_spin_lock_set_owner(struct k_spinlock *l)
 
 #endif
 
+#ifdef CONFIG_SPINLOCK_STATS
+/* Set while a CPU reads the cycle counter for the statistics, which may
+ * take a spinlock of the timer driver: that nested lock goes untimed.
+ * Only accessed with interrupts locked.
+ */
+static bool spin_stats_busy[CONFIG_MP_NUM_CPUS];
+
+u32_t z_spin_stats_start(void)
+{
+	bool *busy = &spin_stats_busy[_current_cpu->id];
+	u32_t now;
+
+	if (*busy) {
+		return 0;
+	}
+
+	*busy = true;
+	now = k_cycle_get_32();
+	*busy = false;
+
+	return now;
+}
+
+void z_spin_stats_end(struct k_spinlock *l, u32_t start)
+{
+	bool *busy = &spin_stats_busy[_current_cpu->id];
+	u32_t cycles;
+	atomic_val_t max;
+
+	if (*busy) {
+		return;
+	}
+
+	*busy = true;
+	cycles = k_cycle_get_32() - start;
+	*busy = false;
+
+	/* The lock is already released, other CPUs may race on the max */
+	do {
+		max = atomic_get(&l->stats.max_cycles);
+		if ((u32_t)max >= cycles) {
+			break;
+		}
+	} while (!atomic_cas(&l->stats.max_cycles, max, cycles));
+}
+#endif /* CONFIG_SPINLOCK_STATS */
+
 int z_impl_k_float_disable(struct k_thread *thread)
 {
 #if defined(CONFIG_FLOAT) && defined(CONFIG_FP_SHARING)
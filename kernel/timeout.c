@@ -19,7 +19,17 @@
 
 static u64_t curr_tick;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+static bool timeout_lessthan(struct rbnode *a, struct rbnode *b);
+
+static struct rbtree timeout_tree = {
+	.lessthan_fn = timeout_lessthan,
+};
+
+static u32_t next_order_key;
+#else
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
@@ -41,6 +51,69 @@ static inline int z_vrfy_z_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+
+/* The scalable backend keys each timeout by its absolute expiry tick
+ * in a red/black tree, so arming and cancelling are O(log N) in the
+ * number of queued timeouts.  Ties are broken by insertion order so
+ * that timeouts expiring on the same tick fire in the order they were
+ * added, exactly as with the delta list.
+ */
+static bool timeout_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	struct _timeout *ta = CONTAINER_OF(a, struct _timeout, node);
+	struct _timeout *tb = CONTAINER_OF(b, struct _timeout, node);
+
+	if (ta->expiry != tb->expiry) {
+		return ta->expiry < tb->expiry;
+	}
+
+	return ta->order_key < tb->order_key;
+}
+
+static struct _timeout *first(void)
+{
+	struct rbnode *n = rb_get_min(&timeout_tree);
+
+	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
+}
+
+/* Ticks from curr_tick until the timeout expires */
+static s32_t timeout_delta(struct _timeout *t)
+{
+	return (s32_t)MIN(t->expiry - curr_tick, (u64_t)INT_MAX);
+}
+
+static void insert_timeout(struct _timeout *to, s32_t ticks)
+{
+	struct _timeout *t;
+
+	/* Renumber before wraparound, see z_priq_rb_add() */
+	if (next_order_key == UINT32_MAX) {
+		next_order_key = 0U;
+		RB_FOR_EACH_CONTAINER(&timeout_tree, t, node) {
+			t->order_key = next_order_key++;
+		}
+	}
+
+	to->expiry = curr_tick + ticks;
+	to->order_key = next_order_key++;
+
+	rb_insert(&timeout_tree, &to->node);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	rb_remove(&timeout_tree, &t->node);
+	t->expiry = 0U;
+
+	if (timeout_tree.root == NULL) {
+		next_order_key = 0U;
+	}
+}
+
+#else
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -55,6 +128,30 @@ static struct _timeout *next(struct _timeout *t)
 	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
+static s32_t timeout_delta(struct _timeout *t)
+{
+	return t->dticks;
+}
+
+static void insert_timeout(struct _timeout *to, s32_t ticks)
+{
+	struct _timeout *t;
+
+	to->dticks = ticks;
+	for (t = first(); t != NULL; t = next(t)) {
+		__ASSERT(t->dticks >= 0, "");
+
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			return;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	sys_dlist_append(&timeout_list, &to->node);
+}
+
 static void remove_timeout(struct _timeout *t)
 {
 	if (next(t) != NULL) {
@@ -64,16 +161,52 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
+
 static s32_t elapsed(void)
 {
 	return announce_remaining == 0 ? z_clock_elapsed() : 0;
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/* Latest delta from curr_tick at which every armed timeout can still
+ * be served within its slack, i.e. the minimum of delta + slack.  The
+ * queue is sorted by delta, so the walk can stop at the first timeout
+ * due after the bound found so far.  Everything due by the bound then
+ * fires from the same announce.
+ */
+static s32_t slack_bound(void)
+{
+	s32_t bound = INT_MAX;
+	struct _timeout *t;
+	s32_t delta;
+
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	RB_FOR_EACH_CONTAINER(&timeout_tree, t, node) {
+		delta = timeout_delta(t);
+#else
+	delta = 0;
+	for (t = first(); t != NULL; t = next(t)) {
+		delta += t->dticks;
+#endif
+		if (delta >= bound) {
+			break;
+		}
+		bound = (s32_t)MIN((s64_t)delta + t->slack, (s64_t)bound);
+	}
+
+	return bound;
+}
+#else
+#define slack_bound() timeout_delta(first())
+#endif
+
 static s32_t next_timeout(void)
 {
 	struct _timeout *to = first();
 	s32_t ticks_elapsed = elapsed();
-	s32_t ret = to == NULL ? MAX_WAIT : MAX(0, to->dticks - ticks_elapsed);
+	s32_t ret = to == NULL ? MAX_WAIT
+		: MAX(0, slack_bound() - ticks_elapsed);
 
 #ifdef CONFIG_TIMESLICING
 	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
@@ -85,30 +218,17 @@ static s32_t next_timeout(void)
 
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn, s32_t ticks)
 {
-	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	__ASSERT(z_is_inactive_timeout(to), "");
 	to->fn = fn;
 	ticks = MAX(1, ticks);
 
 	LOCKED(&timeout_lock) {
-		struct _timeout *t;
-
-		to->dticks = ticks + elapsed();
-		for (t = first(); t != NULL; t = next(t)) {
-			__ASSERT(t->dticks >= 0, "");
-
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
+		insert_timeout(to, ticks + elapsed());
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
-
-		if (to == first()) {
+		/* With slack, a later timeout may still end the window
+		 * of those ahead of it
+		 */
+		if (to == first() || IS_ENABLED(CONFIG_TIMEOUT_SLACK)) {
 			z_clock_set_timeout(next_timeout(), false);
 		}
 	}
@@ -119,7 +239,7 @@ int z_abort_timeout(struct _timeout *to)
 	int ret = -EINVAL;
 
 	LOCKED(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
+		if (!z_is_inactive_timeout(to)) {
 			remove_timeout(to);
 			ret = 0;
 		}
@@ -137,12 +257,16 @@ s32_t z_timeout_remaining(struct _timeout *timeout)
 	}
 
 	LOCKED(&timeout_lock) {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+		ticks = timeout_delta(timeout);
+#else
 		for (struct _timeout *t = first(); t != NULL; t = next(t)) {
 			ticks += t->dticks;
 			if (timeout == t) {
 				break;
 			}
 		}
+#endif
 	}
 
 	return ticks - elapsed();
@@ -191,13 +315,15 @@ void z_clock_announce(s32_t ticks)
 
 	announce_remaining = ticks;
 
-	while (first() != NULL && first()->dticks <= announce_remaining) {
+	while (first() != NULL && timeout_delta(first()) <= announce_remaining) {
 		struct _timeout *t = first();
-		int dt = t->dticks;
+		int dt = timeout_delta(t);
 
 		curr_tick += dt;
 		announce_remaining -= dt;
+#ifndef CONFIG_TIMEOUT_QUEUE_SCALABLE
 		t->dticks = 0;
+#endif
 		remove_timeout(t);
 
 		k_spin_unlock(&timeout_lock, key);
@@ -205,9 +331,11 @@ void z_clock_announce(s32_t ticks)
 		key = k_spin_lock(&timeout_lock);
 	}
 
+#ifndef CONFIG_TIMEOUT_QUEUE_SCALABLE
 	if (first() != NULL) {
 		first()->dticks -= announce_remaining;
 	}
+#endif
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
@@ -222,7 +350,7 @@ s64_t z_tick_get(void)
 	u64_t t = 0U;
 
 	LOCKED(&timeout_lock) {
-		t = curr_tick + z_clock_elapsed();
+		t = curr_tick + elapsed();
 	}
 	return t;
 }
@@ -241,4 +241,14 @@ static inline void z_vrfy_k_timer_user_data_set(struct k_timer *timer,
 }
 #include <syscalls/k_timer_user_data_set_mrsh.c>
 
+#ifdef CONFIG_TIMEOUT_SLACK
+static inline void z_vrfy_k_timer_slack_set(struct k_timer *timer,
+					    u32_t slack_ms)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(timer, K_OBJ_TIMER));
+	z_impl_k_timer_slack_set(timer, slack_ms);
+}
+#include <syscalls/k_timer_slack_set_mrsh.c>
+#endif
+
 #endif
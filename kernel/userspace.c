@@ -123,6 +123,134 @@ static sys_dlist_t obj_list = SYS_DLIST_STATIC_INIT(&obj_list);
  * and obj_list.
  */
 
+#if (CONFIG_DYNAMIC_OBJECTS_HASH_SIZE > 0)
+/*
+ * Open addressing hash index of the allocated objects, looked up on every
+ * syscall without taking lists_lock. It only holds pointers, which are
+ * compared and never dereferenced, so a lookup racing with an update can
+ * at worst miss an object: the sequence counter, odd while the index is
+ * being updated, tells the lookup to retry then. Objects which do not fit
+ * in the index are only in obj_rb_tree, searched with the lock held.
+ */
+#define DYN_HASH_SIZE CONFIG_DYNAMIC_OBJECTS_HASH_SIZE
+#define DYN_HASH_MASK (DYN_HASH_SIZE - 1)
+#define DYN_HASH_MAX_LOAD (DYN_HASH_SIZE - DYN_HASH_SIZE / 4)
+
+BUILD_ASSERT((DYN_HASH_SIZE & DYN_HASH_MASK) == 0,
+	     "DYNAMIC_OBJECTS_HASH_SIZE must be a power of two");
+
+static struct dyn_obj *dyn_hash[DYN_HASH_SIZE];
+static atomic_t dyn_hash_seq;
+static size_t dyn_hash_count;
+static size_t dyn_hash_overflow; /* Allocated objects not in the index */
+
+static inline unsigned int dyn_hash_slot(struct dyn_obj *dyn_obj)
+{
+	/* Fibonacci hashing, the low bits of heap pointers being constant */
+	return (((uintptr_t)dyn_obj >> 2) * 2654435761U) & DYN_HASH_MASK;
+}
+
+static bool dyn_hash_contains(struct dyn_obj *dyn_obj)
+{
+	unsigned int i = dyn_hash_slot(dyn_obj);
+
+	for (int n = 0; n < DYN_HASH_SIZE; n++) {
+		struct dyn_obj *entry = __atomic_load_n(&dyn_hash[i],
+							__ATOMIC_ACQUIRE);
+
+		if (entry == dyn_obj) {
+			return true;
+		}
+
+		if (entry == NULL) {
+			break;
+		}
+
+		i = (i + 1) & DYN_HASH_MASK;
+	}
+
+	return false;
+}
+
+/* Must be called with lists_lock held */
+static void dyn_hash_insert(struct dyn_obj *dyn_obj)
+{
+	unsigned int i = dyn_hash_slot(dyn_obj);
+
+	if (dyn_hash_count >= DYN_HASH_MAX_LOAD) {
+		dyn_hash_overflow++;
+		return;
+	}
+
+	while (dyn_hash[i] != NULL) {
+		i = (i + 1) & DYN_HASH_MASK;
+	}
+
+	atomic_inc(&dyn_hash_seq);
+	__atomic_store_n(&dyn_hash[i], dyn_obj, __ATOMIC_RELEASE);
+	dyn_hash_count++;
+	atomic_inc(&dyn_hash_seq);
+}
+
+/* Must be called with lists_lock held */
+static void dyn_hash_remove(struct dyn_obj *dyn_obj)
+{
+	unsigned int i = dyn_hash_slot(dyn_obj);
+	unsigned int j, k;
+
+	while (dyn_hash[i] != dyn_obj) {
+		if (dyn_hash[i] == NULL) {
+			dyn_hash_overflow--;
+			return;
+		}
+		i = (i + 1) & DYN_HASH_MASK;
+	}
+
+	atomic_inc(&dyn_hash_seq);
+
+	/* Shift back the following entries of the cluster which would not
+	 * be found anymore past the hole, so that no tombstone is needed
+	 */
+	dyn_hash[i] = NULL;
+	for (j = (i + 1) & DYN_HASH_MASK; dyn_hash[j] != NULL;
+	     j = (j + 1) & DYN_HASH_MASK) {
+		k = dyn_hash_slot(dyn_hash[j]);
+		if (((j - k) & DYN_HASH_MASK) >= ((j - i) & DYN_HASH_MASK)) {
+			__atomic_store_n(&dyn_hash[i], dyn_hash[j],
+					 __ATOMIC_RELEASE);
+			__atomic_store_n(&dyn_hash[j], NULL,
+					 __ATOMIC_RELEASE);
+			i = j;
+		}
+	}
+
+	dyn_hash_count--;
+	atomic_inc(&dyn_hash_seq);
+}
+
+static bool dyn_hash_find(struct dyn_obj *dyn_obj)
+{
+	atomic_val_t seq;
+	bool found;
+
+	do {
+		seq = atomic_get(&dyn_hash_seq);
+		found = (seq & 1) == 0 && dyn_hash_contains(dyn_obj);
+	} while (!found && ((seq & 1) != 0 ||
+			    seq != atomic_get(&dyn_hash_seq)));
+
+	return found;
+}
+#else
+static inline void dyn_hash_insert(struct dyn_obj *dyn_obj)
+{
+}
+
+static inline void dyn_hash_remove(struct dyn_obj *dyn_obj)
+{
+}
+#endif /* CONFIG_DYNAMIC_OBJECTS_HASH_SIZE > 0 */
+
 static size_t obj_size_get(enum k_objects otype)
 {
 	size_t ret;
@@ -147,6 +275,20 @@ static inline struct dyn_obj *node_to_dyn_obj(struct rbnode *node)
 	return CONTAINER_OF(node, struct dyn_obj, node);
 }
 
+static void dyn_obj_add(struct dyn_obj *dyn_obj)
+{
+	rb_insert(&obj_rb_tree, &dyn_obj->node);
+	sys_dlist_append(&obj_list, &dyn_obj->obj_list);
+	dyn_hash_insert(dyn_obj);
+}
+
+static void dyn_obj_remove(struct dyn_obj *dyn_obj)
+{
+	rb_remove(&obj_rb_tree, &dyn_obj->node);
+	sys_dlist_remove(&dyn_obj->obj_list);
+	dyn_hash_remove(dyn_obj);
+}
+
 static struct dyn_obj *dyn_object_find(void *obj)
 {
 	struct rbnode *node;
@@ -159,6 +301,16 @@ static struct dyn_obj *dyn_object_find(void *obj)
 	 */
 	node = (struct rbnode *)((char *)obj - sizeof(struct rbnode));
 
+#if (CONFIG_DYNAMIC_OBJECTS_HASH_SIZE > 0)
+	if (dyn_hash_find(node_to_dyn_obj(node))) {
+		return node_to_dyn_obj(node);
+	}
+
+	if (dyn_hash_overflow == 0U) {
+		return NULL;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 	if (rb_contains(&obj_rb_tree, node)) {
 		ret = node_to_dyn_obj(node);
@@ -273,8 +425,7 @@ void *z_impl_k_object_alloc(enum k_objects otype)
 
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
-	rb_insert(&obj_rb_tree, &dyn_obj->node);
-	sys_dlist_append(&obj_list, &dyn_obj->obj_list);
+	dyn_obj_add(dyn_obj);
 	k_spin_unlock(&lists_lock, key);
 
 	return dyn_obj->kobj.name;
@@ -293,12 +444,14 @@ void k_object_free(void *obj)
 
 	dyn_obj = dyn_object_find(obj);
 	if (dyn_obj != NULL) {
-		rb_remove(&obj_rb_tree, &dyn_obj->node);
-		sys_dlist_remove(&dyn_obj->obj_list);
+		dyn_obj_remove(dyn_obj);
 
 		if (dyn_obj->kobj.type == K_OBJ_THREAD) {
 			thread_idx_free(dyn_obj->kobj.data);
 		}
+#if (CONFIG_USERSPACE_OBJ_CACHE_SIZE > 0)
+		z_object_cache_invalidate();
+#endif
 	}
 	k_spin_unlock(&objfree_lock, key);
 
@@ -358,6 +511,9 @@ static void unref_check(struct _k_object *ko, uintptr_t index)
 	k_spinlock_key_t key = k_spin_lock(&obj_lock);
 
 	sys_bitfield_clear_bit((mem_addr_t)&ko->perms, index);
+#if (CONFIG_USERSPACE_OBJ_CACHE_SIZE > 0)
+	z_object_cache_invalidate();
+#endif
 
 #ifdef CONFIG_DYNAMIC_OBJECTS
 	struct dyn_obj *dyn_obj =
@@ -393,8 +549,7 @@ static void unref_check(struct _k_object *ko, uintptr_t index)
 		break;
 	}
 
-	rb_remove(&obj_rb_tree, &dyn_obj->node);
-	sys_dlist_remove(&dyn_obj->obj_list);
+	dyn_obj_remove(dyn_obj);
 	k_free(dyn_obj);
 out:
 #endif
@@ -537,8 +692,8 @@ void k_object_access_all_grant(void *object)
 	}
 }
 
-int z_object_validate(struct _k_object *ko, enum k_objects otype,
-		       enum _obj_init_check init)
+static int object_validate(struct _k_object *ko, enum k_objects otype,
+			   enum _obj_init_check init, bool check_perms)
 {
 	if (unlikely((ko == NULL) ||
 		(otype != K_OBJ_ANY && ko->type != otype))) {
@@ -548,7 +703,7 @@ int z_object_validate(struct _k_object *ko, enum k_objects otype,
 	/* Manipulation of any kernel objects by a user thread requires that
 	 * thread be granted access first, even for uninitialized objects
 	 */
-	if (unlikely(thread_perms_test(ko) == 0)) {
+	if (unlikely(check_perms && thread_perms_test(ko) == 0)) {
 		return -EPERM;
 	}
 
@@ -570,6 +725,66 @@ int z_object_validate(struct _k_object *ko, enum k_objects otype,
 	return 0;
 }
 
+int z_object_validate(struct _k_object *ko, enum k_objects otype,
+		       enum _obj_init_check init)
+{
+	return object_validate(ko, otype, init, true);
+}
+
+#if (CONFIG_USERSPACE_OBJ_CACHE_SIZE > 0)
+/* Bumped to invalidate every thread's object cache at once */
+static atomic_t obj_cache_gen;
+
+void z_object_cache_invalidate(void)
+{
+	(void)atomic_inc(&obj_cache_gen);
+}
+
+int z_object_cached_validate(void *obj, enum k_objects otype,
+			     enum _obj_init_check init)
+{
+	struct _thread_obj_cache *cache = &_current->obj_cache;
+	u32_t gen = (u32_t)atomic_get(&obj_cache_gen);
+	struct _k_object *ko = NULL;
+	int ret;
+
+	/* Entries are only ever used by their own thread, no locking */
+	if (cache->gen != gen) {
+		(void)memset(cache->entry, 0, sizeof(cache->entry));
+		cache->gen = gen;
+	}
+
+	for (int i = 0; i < CONFIG_USERSPACE_OBJ_CACHE_SIZE; i++) {
+		if (cache->entry[i].obj == obj && obj != NULL) {
+			ko = cache->entry[i].ko;
+			break;
+		}
+	}
+
+	if (ko != NULL) {
+		/* Permission was granted and has not been revoked since */
+		ret = object_validate(ko, otype, init, false);
+	} else {
+		ko = z_object_find(obj);
+		ret = object_validate(ko, otype, init, true);
+		if (ret == 0) {
+			cache->entry[cache->next].obj = obj;
+			cache->entry[cache->next].ko = ko;
+			cache->next = (cache->next + 1U) %
+				CONFIG_USERSPACE_OBJ_CACHE_SIZE;
+		}
+	}
+
+#ifdef CONFIG_LOG
+	if (ret != 0) {
+		z_dump_object_error(ret, obj, ko, otype);
+	}
+#endif
+
+	return ret;
+}
+#endif
+
 void z_object_init(void *obj)
 {
 	struct _k_object *ko;
@@ -601,6 +816,9 @@ void z_object_recycle(void *obj)
 
 	if (ko != NULL) {
 		(void)memset(ko->perms, 0, sizeof(ko->perms));
+#if (CONFIG_USERSPACE_OBJ_CACHE_SIZE > 0)
+		z_object_cache_invalidate();
+#endif
 		z_thread_perms_set(ko, k_current_get());
 		ko->flags |= K_OBJ_FLAG_INITIALIZED;
 	}
@@ -25,12 +25,139 @@ static struct k_spinlock lock;
 
 extern void z_work_q_main(void *work_q_ptr, void *p2, void *p3);
 
+#ifdef CONFIG_WORKQUEUE_POOL
+/* A key being processed by one of the threads of a workqueue */
+struct running_key {
+	sys_snode_t node;
+	uintptr_t key;
+};
+
+/* Returns the work item if its key is free, which the calling thread
+ * then owns, or NULL if another thread is busy with that key, in
+ * which case the item is left for that thread to pick up.
+ */
+static struct k_work *claim_key(struct k_work_q *work_q, struct k_work *work,
+				struct running_key *rk)
+{
+	k_spinlock_key_t key = k_spin_lock(&work_q->lock);
+	struct running_key *r;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&work_q->running, r, node) {
+		if (r->key == work->key) {
+			/* The queue link is free again once dequeued */
+			sys_slist_append(&work_q->deferred,
+					 (sys_snode_t *)work);
+			k_spin_unlock(&work_q->lock, key);
+			return NULL;
+		}
+	}
+
+	rk->key = work->key;
+	sys_slist_append(&work_q->running, &rk->node);
+	k_spin_unlock(&work_q->lock, key);
+
+	return work;
+}
+
+/* Returns the oldest deferred item with the key the calling thread
+ * owns, or NULL after giving up the key if there is none.
+ */
+static struct k_work *next_for_key(struct k_work_q *work_q,
+				   struct running_key *rk)
+{
+	k_spinlock_key_t key = k_spin_lock(&work_q->lock);
+	sys_snode_t *node, *prev = NULL;
+
+	SYS_SLIST_FOR_EACH_NODE(&work_q->deferred, node) {
+		if (((struct k_work *)node)->key == rk->key) {
+			sys_slist_remove(&work_q->deferred, prev, node);
+			k_spin_unlock(&work_q->lock, key);
+			return (struct k_work *)node;
+		}
+		prev = node;
+	}
+
+	(void)sys_slist_find_and_remove(&work_q->running, &rk->node);
+	k_spin_unlock(&work_q->lock, key);
+
+	return NULL;
+}
+
+static void work_q_pool_main(void *work_q_ptr, void *p2, void *p3)
+{
+	struct k_work_q *work_q = work_q_ptr;
+	struct running_key rk;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		struct k_work *work;
+
+		/* Items of a key must be claimed in the order they are
+		 * dequeued, so no other thread may dequeue in between.
+		 * The get blocks, hence a mutex rather than work_q->lock.
+		 */
+		(void)k_mutex_lock(&work_q->get_lock, K_FOREVER);
+
+		work = k_queue_get(&work_q->queue, K_FOREVER);
+		if (work != NULL && work->key != 0U) {
+			work = claim_key(work_q, work, &rk);
+		}
+
+		(void)k_mutex_unlock(&work_q->get_lock);
+
+		while (work != NULL) {
+			k_work_handler_t handler = work->handler;
+			bool keyed = work->key != 0U;
+
+			/* Reset pending state so it can be resubmitted by
+			 * handler
+			 */
+			if (atomic_test_and_clear_bit(work->flags,
+						      K_WORK_STATE_PENDING)) {
+				handler(work);
+			}
+
+			/* Items with our key that arrived meanwhile are
+			 * ours to run, in order
+			 */
+			work = keyed ? next_for_key(work_q, &rk) : NULL;
+		}
+
+		/* Make sure we don't hog up the CPU if the FIFO never (or
+		 * very rarely) gets empty.
+		 */
+		k_yield();
+	}
+}
+
+void k_work_q_worker_add(struct k_work_q *work_q, struct k_thread *thread,
+			 k_thread_stack_t *stack, size_t stack_size, int prio)
+{
+	(void)k_thread_create(thread, stack, stack_size, work_q_pool_main,
+			      work_q, NULL, NULL, prio, 0, K_NO_WAIT);
+
+	k_thread_name_set(thread, WORKQUEUE_THREAD_NAME);
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 void k_work_q_start(struct k_work_q *work_q, k_thread_stack_t *stack,
 		    size_t stack_size, int prio)
 {
 	k_queue_init(&work_q->queue);
+#ifdef CONFIG_WORKQUEUE_POOL
+	work_q->lock = (struct k_spinlock) {};
+	k_mutex_init(&work_q->get_lock);
+	sys_slist_init(&work_q->running);
+	sys_slist_init(&work_q->deferred);
+	(void)k_thread_create(&work_q->thread, stack, stack_size,
+			      work_q_pool_main, work_q, NULL, NULL, prio, 0,
+			      K_NO_WAIT);
+#else
 	(void)k_thread_create(&work_q->thread, stack, stack_size, z_work_q_main,
 			work_q, NULL, NULL, prio, 0, K_NO_WAIT);
+#endif
 
 	k_thread_name_set(&work_q->thread, WORKQUEUE_THREAD_NAME);
 }
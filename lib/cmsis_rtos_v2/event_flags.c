@@ -18,8 +18,41 @@ static const osEventFlagsAttr_t init_event_flags_attrs = {
 	.cb_size = 0,
 };
 
-#define DONT_CARE               (0)
-#define NSEC_PER_MSEC           (NSEC_PER_USEC * USEC_PER_MSEC)
+/* Waits for flags of an event flags object or of a thread */
+u32_t cv2_flags_wait(struct k_event *flags, u32_t wait, u32_t options,
+		     u32_t timeout)
+{
+	u32_t k_options = 0U, ret;
+	s32_t timeout_ms;
+
+	if (wait == 0U) {
+		return osFlagsErrorParameter;
+	}
+
+	if (options & osFlagsWaitAll) {
+		k_options |= K_EVENT_WAIT_ALL;
+	}
+
+	if (options & osFlagsNoClear) {
+		k_options |= K_EVENT_NO_CLEAR;
+	}
+
+	switch (timeout) {
+	case 0:
+		timeout_ms = K_NO_WAIT;
+		break;
+	case osWaitForever:
+		timeout_ms = K_FOREVER;
+		break;
+	default:
+		timeout_ms = (s32_t)k_ticks_to_ms_floor64(timeout);
+		break;
+	}
+
+	ret = k_event_wait(flags, wait, k_options, timeout_ms);
+
+	return (ret != 0U) ? ret : osFlagsErrorTimeout;
+}
 
 /**
  * @brief Create and Initialize an Event Flags object.
@@ -43,10 +76,7 @@ osEventFlagsId_t osEventFlagsNew(const osEventFlagsAttr_t *attr)
 		return NULL;
 	}
 
-	k_poll_signal_init(&events->poll_signal);
-	k_poll_event_init(&events->poll_event, K_POLL_TYPE_SIGNAL,
-			  K_POLL_MODE_NOTIFY_ONLY, &events->poll_signal);
-	events->signal_results = 0U;
+	k_event_init(&events->flags);
 
 	if (attr->name == NULL) {
 		strncpy(events->name, init_event_flags_attrs.name,
@@ -64,19 +94,12 @@ osEventFlagsId_t osEventFlagsNew(const osEventFlagsAttr_t *attr)
 uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags)
 {
 	struct cv2_event_flags *events = (struct cv2_event_flags *)ef_id;
-	int key;
 
 	if ((ef_id == NULL) || (flags & 0x80000000)) {
 		return osFlagsErrorParameter;
 	}
 
-	key = irq_lock();
-	events->signal_results |= flags;
-	irq_unlock(key);
-
-	k_poll_signal_raise(&events->poll_signal, DONT_CARE);
-
-	return events->signal_results;
+	return k_event_set(&events->flags, flags);
 }
 
 /**
@@ -85,19 +108,12 @@ uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags)
 uint32_t osEventFlagsClear(osEventFlagsId_t ef_id, uint32_t flags)
 {
 	struct cv2_event_flags *events = (struct cv2_event_flags *)ef_id;
-	int key;
-	u32_t sig;
 
 	if ((ef_id == NULL) || (flags & 0x80000000)) {
 		return osFlagsErrorParameter;
 	}
 
-	key = irq_lock();
-	sig = events->signal_results;
-	events->signal_results &= ~(flags);
-	irq_unlock(key);
-
-	return sig;
+	return k_event_clear(&events->flags, flags);
 }
 
 /**
@@ -107,10 +123,6 @@ uint32_t osEventFlagsWait(osEventFlagsId_t ef_id, uint32_t flags,
 			  uint32_t options, uint32_t timeout)
 {
 	struct cv2_event_flags *events = (struct cv2_event_flags *)ef_id;
-	int retval, key;
-	u32_t sig;
-	u32_t time_delta_ms, timeout_ms = k_ticks_to_ms_floor64(timeout);
-	u64_t time_stamp_start, hwclk_cycles_delta, time_delta_ns;
 
 	/* Can be called from ISRs only if timeout is set to 0 */
 	if (timeout > 0 && k_is_in_isr()) {
@@ -121,81 +133,7 @@ uint32_t osEventFlagsWait(osEventFlagsId_t ef_id, uint32_t flags,
 		return osFlagsErrorParameter;
 	}
 
-	for (;;) {
-
-		time_stamp_start = (u64_t)k_cycle_get_32();
-
-		switch (timeout) {
-		case 0:
-			retval = k_poll(&events->poll_event, 1, K_NO_WAIT);
-			break;
-		case osWaitForever:
-			retval = k_poll(&events->poll_event, 1, K_FOREVER);
-			break;
-		default:
-			retval = k_poll(&events->poll_event, 1, timeout_ms);
-			break;
-		}
-
-		switch (retval) {
-		case 0:
-			break;
-		case -EAGAIN:
-			return osFlagsErrorTimeout;
-		default:
-			return osFlagsErrorUnknown;
-		}
-
-		__ASSERT(events->poll_event.state == K_POLL_STATE_SIGNALED,
-			 "event state not signalled!");
-		__ASSERT(events->poll_event.signal->signaled == 1U,
-			 "event signaled is not 1");
-
-		/* Reset the states to facilitate the next trigger */
-		events->poll_event.signal->signaled = 0U;
-		events->poll_event.state = K_POLL_STATE_NOT_READY;
-
-		if (options & osFlagsWaitAll) {
-
-			/* Check if all events we are waiting on have
-			 * been signalled
-			 */
-			if ((events->signal_results & flags) == flags) {
-				break;
-			}
-
-			/* If we need to wait on more signals, we need to
-			 * adjust the timeout value accordingly based on
-			 * the time that has already elapsed.
-			 */
-			hwclk_cycles_delta =
-				(u64_t)k_cycle_get_32() - time_stamp_start;
-
-			time_delta_ns =
-				(u32_t)k_cyc_to_ns_floor64(hwclk_cycles_delta);
-
-			time_delta_ms = (u32_t)time_delta_ns / NSEC_PER_MSEC;
-
-			if (timeout_ms > time_delta_ms) {
-				timeout_ms -= time_delta_ms;
-			} else {
-				timeout_ms = 0U;
-			}
-		} else {
-			break;
-		}
-	}
-
-	sig = events->signal_results;
-	if (!(options & osFlagsNoClear)) {
-
-		/* Clear signal flags as the thread is ready now */
-		key = irq_lock();
-		events->signal_results &= ~(flags);
-		irq_unlock(key);
-	}
-
-	return sig;
+	return cv2_flags_wait(&events->flags, flags, options, timeout);
 }
 
 /**
@@ -223,7 +161,7 @@ uint32_t osEventFlagsGet(osEventFlagsId_t ef_id)
 		return 0;
 	}
 
-	return events->signal_results;
+	return k_event_clear(&events->flags, 0);
 }
 
 /**
@@ -16,9 +16,7 @@
 struct cv2_thread {
 	sys_dnode_t node;
 	struct k_thread z_thread;
-	struct k_poll_signal poll_signal;
-	struct k_poll_event poll_event;
-	u32_t signal_results;
+	struct k_event flags;
 	char name[16];
 	u32_t attr_bits;
 	struct k_sem join_guard;
@@ -60,13 +58,13 @@ struct cv2_msgq {
 };
 
 struct cv2_event_flags {
-	struct k_poll_signal poll_signal;
-	struct k_poll_event poll_event;
-	u32_t signal_results;
+	struct k_event flags;
 	char name[16];
 };
 
 extern osThreadId_t get_cmsis_thread_id(k_tid_t tid);
 extern void *is_cmsis_rtos_v2_thread(void *thread_id);
+extern u32_t cv2_flags_wait(struct k_event *flags, u32_t wait,
+			    u32_t options, u32_t timeout);
 
 #endif
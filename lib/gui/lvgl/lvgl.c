@@ -11,6 +11,9 @@
 #ifdef CONFIG_LVGL_FILESYSTEM
 #include "lvgl_fs.h"
 #endif
+#ifdef CONFIG_LVGL_GPU_STM32_DMA2D
+#include "lvgl_gpu.h"
+#endif
 #include LV_MEM_CUSTOM_INCLUDE
 
 #define LOG_LEVEL CONFIG_LVGL_LOG_LEVEL
@@ -179,6 +182,13 @@ static int lvgl_init(struct device *dev)
 		return -ENOTSUP;
 	}
 
+#ifdef CONFIG_LVGL_GPU_STM32_DMA2D
+	/* Software rendering still works without the GPU */
+	if (lvgl_gpu_init(&disp_drv) != 0) {
+		LOG_WRN("GPU not available.");
+	}
+#endif
+
 	if (lv_disp_drv_register(&disp_drv) == NULL) {
 		LOG_ERR("Failed to register display device.");
 		return -EPERM;
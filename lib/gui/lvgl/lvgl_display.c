@@ -6,6 +6,27 @@
 
 #include "lvgl_display.h"
 
+static void lvgl_flush_done(const struct device *dev, int status,
+		void *user_data)
+{
+	lv_disp_flush_ready((lv_disp_drv_t *)user_data);
+}
+
+void lvgl_flush_write(struct _disp_drv_t *disp_drv, u16_t x, u16_t y,
+		const struct display_buffer_descriptor *desc,
+		const lv_color_t *color_p)
+{
+	struct device *display_dev = (struct device *)disp_drv->user_data;
+
+	/* The buffer is released to LVGL once the transfer completes, so
+	 * that with LVGL_DOUBLE_VDB the next area renders meanwhile.
+	 */
+	if (display_write_async(display_dev, x, y, desc, color_p,
+				lvgl_flush_done, disp_drv) < 0) {
+		lv_disp_flush_ready(disp_drv);
+	}
+}
+
 int set_lvgl_rendering_cb(lv_disp_drv_t *disp_drv)
 {
 	int err = 0;
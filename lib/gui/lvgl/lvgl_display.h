@@ -36,6 +36,10 @@ void lvgl_set_px_cb_32bit(struct _disp_drv_t *disp_drv,
 		u8_t *buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
 		lv_color_t color, lv_opa_t opa);
 
+void lvgl_flush_write(struct _disp_drv_t *disp_drv, u16_t x, u16_t y,
+		const struct display_buffer_descriptor *desc,
+		const lv_color_t *color_p);
+
 void lvgl_rounder_cb_mono(struct _disp_drv_t *disp_drv, lv_area_t *area);
 
 int set_lvgl_rendering_cb(lv_disp_drv_t *disp_drv);
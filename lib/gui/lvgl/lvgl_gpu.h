@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_GUI_LVGL_LVGL_GPU_H_
+#define ZEPHYR_LIB_GUI_LVGL_LVGL_GPU_H_
+
+#include <lvgl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Sets the GPU callbacks of the display driver, once the GPU is ready */
+int lvgl_gpu_init(lv_disp_drv_t *disp_drv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_LIB_GUI_LVGL_LVGL_GPU_H_ */
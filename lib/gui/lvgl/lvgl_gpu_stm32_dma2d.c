@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <soc.h>
+#include <drivers/clock_control.h>
+#include <drivers/clock_control/stm32_clock_control.h>
+#include <lvgl.h>
+#include "lvgl_gpu.h"
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(lvgl);
+
+#ifndef DMA2D
+#error "SoC has no DMA2D"
+#endif
+
+/* DMA2D transfer modes */
+#define DMA2D_MODE_M2M_BLEND	2
+#define DMA2D_MODE_R2M		3
+
+/* Alpha mode replacing the alpha of the foreground pixels */
+#define DMA2D_AM_REPLACE	1
+
+#if defined(CONFIG_LVGL_COLOR_DEPTH_16)
+#define DMA2D_CM		2 /* RGB565 */
+#else
+#define DMA2D_CM		0 /* ARGB8888 */
+#endif
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+#define dcache_clean(addr, size) \
+	SCB_CleanDCache_by_Addr((u32_t *)(addr), (s32_t)(size))
+#define dcache_clean_invalidate(addr, size) \
+	SCB_CleanInvalidateDCache_by_Addr((u32_t *)(addr), (s32_t)(size))
+#else
+#define dcache_clean(addr, size)
+#define dcache_clean_invalidate(addr, size)
+#endif
+
+/* LVGL renders from a single thread: transfers never overlap, and are
+ * short enough for polling to beat an interrupt round trip.
+ */
+static void dma2d_run(void)
+{
+	DMA2D->CR |= DMA2D_CR_START;
+	while (DMA2D->CR & DMA2D_CR_START) {
+	}
+}
+
+static void gpu_fill_cb(lv_disp_drv_t *disp_drv, lv_color_t *dest_buf,
+			lv_coord_t dest_width, const lv_area_t *fill_area,
+			lv_color_t color)
+{
+	lv_color_t *dest = dest_buf + dest_width * fill_area->y1 +
+			   fill_area->x1;
+	u32_t width = lv_area_get_width(fill_area);
+	u32_t height = lv_area_get_height(fill_area);
+
+	ARG_UNUSED(disp_drv);
+
+	/* Lines left dirty in the cache would overwrite the fill */
+	dcache_clean_invalidate(dest, ((height - 1) * dest_width + width) *
+				sizeof(lv_color_t));
+
+	DMA2D->CR = DMA2D_MODE_R2M << DMA2D_CR_MODE_Pos;
+	DMA2D->OPFCCR = DMA2D_CM;
+	DMA2D->OCOLR = color.full;
+	DMA2D->OMAR = (u32_t)dest;
+	DMA2D->OOR = dest_width - width;
+	DMA2D->NLR = (width << DMA2D_NLR_PL_Pos) | height;
+
+	dma2d_run();
+}
+
+static void gpu_blend_cb(lv_disp_drv_t *disp_drv, lv_color_t *dest,
+			 const lv_color_t *src, u32_t length, lv_opa_t opa)
+{
+	ARG_UNUSED(disp_drv);
+
+	dcache_clean(src, length * sizeof(lv_color_t));
+	dcache_clean_invalidate(dest, length * sizeof(lv_color_t));
+
+	DMA2D->CR = DMA2D_MODE_M2M_BLEND << DMA2D_CR_MODE_Pos;
+
+	/* Foreground is the source, at a constant opacity */
+	DMA2D->FGMAR = (u32_t)src;
+	DMA2D->FGOR = 0;
+	DMA2D->FGPFCCR = ((u32_t)opa << DMA2D_FGPFCCR_ALPHA_Pos) |
+			 (DMA2D_AM_REPLACE << DMA2D_FGPFCCR_AM_Pos) |
+			 (DMA2D_CM << DMA2D_FGPFCCR_CM_Pos);
+
+	/* Background and output are the destination */
+	DMA2D->BGMAR = (u32_t)dest;
+	DMA2D->BGOR = 0;
+	DMA2D->BGPFCCR = DMA2D_CM << DMA2D_BGPFCCR_CM_Pos;
+
+	DMA2D->OMAR = (u32_t)dest;
+	DMA2D->OOR = 0;
+	DMA2D->OPFCCR = DMA2D_CM;
+	DMA2D->NLR = (length << DMA2D_NLR_PL_Pos) | 1;
+
+	dma2d_run();
+}
+
+int lvgl_gpu_init(lv_disp_drv_t *disp_drv)
+{
+	struct device *clk = device_get_binding(STM32_CLOCK_CONTROL_NAME);
+	struct stm32_pclken pclken = {
+#if defined(CONFIG_SOC_SERIES_STM32H7X)
+		.bus = STM32_CLOCK_BUS_AHB3,
+		.enr = LL_AHB3_GRP1_PERIPH_DMA2D,
+#else
+		.bus = STM32_CLOCK_BUS_AHB1,
+		.enr = LL_AHB1_GRP1_PERIPH_DMA2D,
+#endif
+	};
+
+	if (clk == NULL ||
+	    clock_control_on(clk, (clock_control_subsys_t)&pclken) != 0) {
+		LOG_ERR("Could not enable DMA2D clock");
+		return -EIO;
+	}
+
+	disp_drv->gpu_fill_cb = gpu_fill_cb;
+	disp_drv->gpu_blend_cb = gpu_blend_cb;
+
+	return 0;
+}
@@ -9,6 +9,28 @@
 #include <string.h>
 #include <stdint.h>
 #include <sys/types.h>
+#include <stdbool.h>
+
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZED_STRING
+/* Word-at-a-time scanning. Words are only read when aligned so they never
+ * cross into a page or MPU region past the end of the string.
+ */
+#define WORD_ONES ((mem_word_t)-1 / 0xFF)
+#define WORD_HIGHS (WORD_ONES * 0x80)
+#define WORD_UNALIGNED(p) ((uintptr_t)(p) & (sizeof(mem_word_t) - 1))
+
+/* True if any byte of <w> is zero */
+static inline bool word_has_zero(mem_word_t w)
+{
+	return ((w - WORD_ONES) & ~w & WORD_HIGHS) != 0;
+}
+
+/* True if any byte of <w> equals the byte repeated in <pattern> */
+static inline bool word_has_byte(mem_word_t w, mem_word_t pattern)
+{
+	return word_has_zero(w ^ pattern);
+}
+#endif
 
 /**
  *
@@ -70,6 +92,23 @@ char *strchr(const char *s, int c)
 {
 	char tmp = (char) c;
 
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZED_STRING
+	while (WORD_UNALIGNED(s) && (*s != tmp) && (*s != '\0')) {
+		s++;
+	}
+
+	if (!WORD_UNALIGNED(s)) {
+		const mem_word_t *w = (const mem_word_t *)s;
+		mem_word_t pattern = WORD_ONES * (unsigned char)c;
+
+		while (!word_has_zero(*w) && !word_has_byte(*w, pattern)) {
+			w++;
+		}
+
+		s = (const char *)w;
+	}
+#endif
+
 	while ((*s != tmp) && (*s != '\0')) {
 		s++;
 	}
@@ -106,14 +145,29 @@ char *strrchr(const char *s, int c)
 
 size_t strlen(const char *s)
 {
-	size_t n = 0;
+	const char *start = s;
+
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZED_STRING
+	while (WORD_UNALIGNED(s) && (*s != '\0')) {
+		s++;
+	}
+
+	if (!WORD_UNALIGNED(s)) {
+		const mem_word_t *w = (const mem_word_t *)s;
+
+		while (!word_has_zero(*w)) {
+			w++;
+		}
+
+		s = (const char *)w;
+	}
+#endif
 
 	while (*s != '\0') {
 		s++;
-		n++;
 	}
 
-	return n;
+	return s - start;
 }
 
 /**
@@ -144,6 +198,30 @@ size_t strnlen(const char *s, size_t maxlen)
 
 int strcmp(const char *s1, const char *s2)
 {
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZED_STRING
+	/* Words can be compared only if both strings have the same alignment */
+	if ((((uintptr_t)s1 ^ (uintptr_t)s2) & (sizeof(mem_word_t) - 1)) == 0) {
+		while (WORD_UNALIGNED(s1) && (*s1 == *s2) && (*s1 != '\0')) {
+			s1++;
+			s2++;
+		}
+
+		if (!WORD_UNALIGNED(s1)) {
+			const mem_word_t *w1 = (const mem_word_t *)s1;
+			const mem_word_t *w2 = (const mem_word_t *)s2;
+
+			while ((*w1 == *w2) && !word_has_zero(*w1)) {
+				w1++;
+				w2++;
+			}
+
+			/* Bytes of the last word are compared below */
+			s1 = (const char *)w1;
+			s2 = (const char *)w2;
+		}
+	}
+#endif
+
 	while ((*s1 == *s2) && (*s1 != '\0')) {
 		s1++;
 		s2++;
@@ -214,73 +292,79 @@ int memcmp(const void *m1, const void *m2, size_t n)
 	return *c1 - *c2;
 }
 
-/**
- *
- * @brief Copy bytes in memory with overlapping areas
- *
- * @return pointer to destination buffer <d>
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZED_MEM
+/* Words moved per iteration of the unrolled loops. All loads of a block are
+ * done before the stores so that compilers can merge them into load/store
+ * multiple instructions (e.g. LDM/STM on ARM).
  */
+#define MEM_BLOCK_WORDS 8
+#define MEM_BLOCK_SIZE (MEM_BLOCK_WORDS * sizeof(mem_word_t))
+#endif
 
-void *memmove(void *d, const void *s, size_t n)
-{
-	char *dest = d;
-	const char *src  = s;
-
-	if ((size_t) (dest - src) < n) {
-		/*
-		 * The <src> buffer overlaps with the start of the <dest> buffer.
-		 * Copy backwards to prevent the premature corruption of <src>.
-		 */
-
-		while (n > 0) {
-			n--;
-			dest[n] = src[n];
-		}
-	} else {
-		/* It is safe to perform a forward-copy */
-		while (n > 0) {
-			*dest = *src;
-			dest++;
-			src++;
-			n--;
-		}
-	}
-
-	return d;
-}
-
-/**
- *
- * @brief Copy bytes in memory
- *
- * @return pointer to start of destination buffer
+/* Copies n bytes forward. Also used by memmove() when <d> is below <s>, so
+ * every source word must be read before the destination word it overlaps
+ * is written.
  */
-
-void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
+static inline void mem_copy_fwd(unsigned char *d_byte,
+				const unsigned char *s_byte, size_t n)
 {
-	/* attempt word-sized copying only if buffers have identical alignment */
-
-	unsigned char *d_byte = (unsigned char *)d;
-	const unsigned char *s_byte = (const unsigned char *)s;
 	const uintptr_t mask = sizeof(mem_word_t) - 1;
 
-	if ((((uintptr_t)d ^ (uintptr_t)s_byte) & mask) == 0) {
+	/* attempt word-sized copying only if buffers have identical alignment */
+
+	if ((((uintptr_t)d_byte ^ (uintptr_t)s_byte) & mask) == 0) {
 
 		/* do byte-sized copying until word-aligned or finished */
 
 		while (((uintptr_t)d_byte) & mask) {
 			if (n == 0) {
-				return d;
+				return;
 			}
 			*(d_byte++) = *(s_byte++);
 			n--;
 		};
 
+#if defined(CONFIG_MINIMAL_LIBC_OPTIMIZED_MEM) && defined(CONFIG_X86)
+		/* String instructions move a word per cycle or better */
+		size_t words = n / sizeof(mem_word_t);
+
+		__asm__ volatile(
+#if Z_MEM_WORD_T_WIDTH > 32
+			"rep movsq"
+#else
+			"rep movsl"
+#endif
+			: "+D" (d_byte), "+S" (s_byte), "+c" (words)
+			:
+			: "memory");
+		n &= mask;
+#else
 		/* do word-sized copying as long as possible */
 
 		mem_word_t *d_word = (mem_word_t *)d_byte;
 		const mem_word_t *s_word = (const mem_word_t *)s_byte;
 
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZED_MEM
+		while (n >= MEM_BLOCK_SIZE) {
+			mem_word_t w0 = s_word[0], w1 = s_word[1];
+			mem_word_t w2 = s_word[2], w3 = s_word[3];
+			mem_word_t w4 = s_word[4], w5 = s_word[5];
+			mem_word_t w6 = s_word[6], w7 = s_word[7];
+
+			d_word[0] = w0;
+			d_word[1] = w1;
+			d_word[2] = w2;
+			d_word[3] = w3;
+			d_word[4] = w4;
+			d_word[5] = w5;
+			d_word[6] = w6;
+			d_word[7] = w7;
+			d_word += MEM_BLOCK_WORDS;
+			s_word += MEM_BLOCK_WORDS;
+			n -= MEM_BLOCK_SIZE;
+		}
+#endif
+
 		while (n >= sizeof(mem_word_t)) {
 			*(d_word++) = *(s_word++);
 			n -= sizeof(mem_word_t);
@@ -288,6 +372,7 @@ void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 
 		d_byte = (unsigned char *)d_word;
 		s_byte = (unsigned char *)s_word;
+#endif
 	}
 
 	/* do byte-sized copying until finished */
@@ -296,6 +381,67 @@ void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 		*(d_byte++) = *(s_byte++);
 		n--;
 	}
+}
+
+/**
+ *
+ * @brief Copy bytes in memory with overlapping areas
+ *
+ * @return pointer to destination buffer <d>
+ */
+
+void *memmove(void *d, const void *s, size_t n)
+{
+	unsigned char *dest = d;
+	const unsigned char *src = s;
+
+	if ((size_t) (dest - src) < n) {
+		/*
+		 * The <src> buffer overlaps with the start of the <dest> buffer.
+		 * Copy backwards to prevent the premature corruption of <src>.
+		 */
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZED_MEM
+		const uintptr_t mask = sizeof(mem_word_t) - 1;
+
+		if ((((uintptr_t)dest ^ (uintptr_t)src) & mask) == 0) {
+			while (((uintptr_t)(dest + n)) & mask) {
+				if (n == 0) {
+					return d;
+				}
+				n--;
+				dest[n] = src[n];
+			}
+
+			while (n >= sizeof(mem_word_t)) {
+				n -= sizeof(mem_word_t);
+				*(mem_word_t *)(dest + n) =
+					*(const mem_word_t *)(src + n);
+			}
+		}
+#endif
+
+		while (n > 0) {
+			n--;
+			dest[n] = src[n];
+		}
+	} else {
+		/* It is safe to perform a forward-copy */
+		mem_copy_fwd(dest, src, n);
+	}
+
+	return d;
+}
+
+/**
+ *
+ * @brief Copy bytes in memory
+ *
+ * @return pointer to start of destination buffer
+ */
+
+void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
+{
+	mem_copy_fwd((unsigned char *)d, (const unsigned char *)s, n);
 
 	return d;
 }
@@ -333,10 +479,40 @@ void *memset(void *buf, int c, size_t n)
 	c_word |= c_word << 32;
 #endif
 
+#if defined(CONFIG_MINIMAL_LIBC_OPTIMIZED_MEM) && defined(CONFIG_X86)
+	size_t words = n / sizeof(mem_word_t);
+
+	__asm__ volatile(
+#if Z_MEM_WORD_T_WIDTH > 32
+		"rep stosq"
+#else
+		"rep stosl"
+#endif
+		: "+D" (d_word), "+c" (words)
+		: "a" (c_word)
+		: "memory");
+	n &= sizeof(mem_word_t) - 1;
+#else
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZED_MEM
+	while (n >= MEM_BLOCK_SIZE) {
+		d_word[0] = c_word;
+		d_word[1] = c_word;
+		d_word[2] = c_word;
+		d_word[3] = c_word;
+		d_word[4] = c_word;
+		d_word[5] = c_word;
+		d_word[6] = c_word;
+		d_word[7] = c_word;
+		d_word += MEM_BLOCK_WORDS;
+		n -= MEM_BLOCK_SIZE;
+	}
+#endif
+
 	while (n >= sizeof(mem_word_t)) {
 		*(d_word++) = c_word;
 		n -= sizeof(mem_word_t);
 	}
+#endif
 
 	/* do byte-sized initialization until finished */
 
@@ -359,9 +535,29 @@ void *memset(void *buf, int c, size_t n)
 
 void *memchr(const void *s, int c, size_t n)
 {
-	if (n != 0) {
-		const unsigned char *p = s;
+	const unsigned char *p = s;
+
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZED_STRING
+	while ((n != 0) && WORD_UNALIGNED(p)) {
+		if (*p == (unsigned char)c) {
+			return (void *)p;
+		}
+		p++;
+		n--;
+	}
+
+	const mem_word_t *w = (const mem_word_t *)p;
+	mem_word_t pattern = WORD_ONES * (unsigned char)c;
 
+	while ((n >= sizeof(mem_word_t)) && !word_has_byte(*w, pattern)) {
+		w++;
+		n -= sizeof(mem_word_t);
+	}
+
+	p = (const unsigned char *)w;
+#endif
+
+	if (n != 0) {
 		do {
 			if (*p++ == (unsigned char)c) {
 				return ((void *)(p - 1));
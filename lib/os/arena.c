@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/arena.h>
+#include <sys/util.h>
+
+/* Slab blocks start with a pointer to the previous block of the arena */
+#define BLOCK_HDR_SIZE sizeof(u8_t *)
+
+void sys_arena_init(struct sys_arena *arena, void *buf, size_t size)
+{
+	arena->slab = NULL;
+	arena->block = buf;
+	arena->size = size;
+	arena->used = 0;
+}
+
+void sys_arena_init_slab(struct sys_arena *arena, struct k_mem_slab *slab)
+{
+	arena->slab = slab;
+	arena->block = NULL;
+	arena->size = 0;
+	arena->used = 0;
+}
+
+static void *block_alloc(u8_t *block, size_t block_size, size_t used,
+			 size_t align, size_t size)
+{
+	uintptr_t start = ROUND_UP((uintptr_t)block + used, align);
+
+	if (block == NULL || start + size > (uintptr_t)block + block_size ||
+	    start + size < start) {
+		return NULL;
+	}
+
+	return (void *)start;
+}
+
+static void block_free(struct sys_arena *arena)
+{
+	u8_t *block = arena->block;
+
+	arena->block = *(u8_t **)block;
+	arena->size = (arena->block != NULL) ? arena->slab->block_size : 0;
+	k_mem_slab_free(arena->slab, (void **)&block);
+}
+
+void *sys_arena_aligned_alloc(struct sys_arena *arena, size_t align,
+			      size_t size)
+{
+	u8_t *mem, *block;
+
+	__ASSERT((align & (align - 1)) == 0, "align must be a power of two");
+
+	mem = block_alloc(arena->block, arena->size, arena->used, align, size);
+	if (mem == NULL) {
+		if (arena->slab == NULL) {
+			return NULL;
+		}
+
+		if (k_mem_slab_alloc(arena->slab, (void **)&block,
+				     K_NO_WAIT) != 0) {
+			return NULL;
+		}
+
+		mem = block_alloc(block, arena->slab->block_size,
+				  BLOCK_HDR_SIZE, align, size);
+		if (mem == NULL) {
+			k_mem_slab_free(arena->slab, (void **)&block);
+			return NULL;
+		}
+
+		*(u8_t **)block = arena->block;
+		arena->block = block;
+		arena->size = arena->slab->block_size;
+	}
+
+	arena->used = mem + size - arena->block;
+
+	return mem;
+}
+
+void sys_arena_restore(struct sys_arena *arena, struct sys_arena_mark mark)
+{
+	while (arena->block != mark.block) {
+		__ASSERT(arena->slab != NULL && arena->block != NULL,
+			 "invalid arena mark");
+		block_free(arena);
+	}
+
+	arena->used = mark.used;
+}
+
+void sys_arena_reset(struct sys_arena *arena)
+{
+	if (arena->slab != NULL) {
+		while (arena->block != NULL) {
+			block_free(arena);
+		}
+	}
+
+	arena->used = 0;
+}
@@ -0,0 +1,1053 @@
+/*
+ * Copyright (c) 1997-2010, 2012-2015 Wind River Systems, Inc.
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Formatted output engine shared by printk(), the minimal libc printf
+ * family, logging and the shell.
+ *
+ * Arguments are read through struct cbprintf_args, either from a va_list
+ * or from a package built by cbvprintf_package(), so that the same code
+ * formats immediately or later. The conversion specification parser is
+ * shared by the formatter and the packager, which guarantees that both
+ * consume the arguments identically.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/util.h>
+#include <sys/cbprintf.h>
+
+#ifndef EOF
+#define EOF  -1
+#endif
+
+/* Class of the argument consumed by a conversion */
+enum arg_class {
+	ARG_NONE,
+	ARG_INT,
+	ARG_LONG,
+	ARG_LLONG,
+	ARG_SIZE,
+	ARG_PTR,
+	ARG_DOUBLE,
+};
+
+struct conversion {
+	bool fminus;
+	bool fplus;
+	bool fspace;
+	bool falt;
+	bool fzero;
+	bool width_star;
+	bool prec_star;
+	int width;
+	int precision;
+	/* 0, 'H' (hh), 'h', 'l', 'L' (ll), 'z' */
+	char length;
+	char specifier;
+};
+
+struct zero_padding {
+	int predot, postdot, trail;
+};
+
+struct cbprintf_args {
+	/* NULL when reading from ap */
+	const u8_t *pkg;
+	size_t off;
+	va_list ap;
+};
+
+static const void *pkg_next(struct cbprintf_args *args, size_t size,
+			    size_t align)
+{
+	const void *p;
+
+	args->off = ROUND_UP(args->off, align);
+	p = &args->pkg[args->off];
+	args->off += size;
+
+	return p;
+}
+
+#define ARG_GET(args, type)						\
+	((args)->pkg != NULL ?						\
+	 *(type const *)pkg_next(args, sizeof(type), __alignof__(type)) :\
+	 va_arg((args)->ap, type))
+
+static int parse_number(const char **fmt)
+{
+	const char *p = *fmt;
+	int n = 0;
+
+	while (*p >= '0' && *p <= '9') {
+		n = 10 * n + *p++ - '0';
+	}
+
+	*fmt = p;
+
+	return n;
+}
+
+/* Parses the conversion specification following a '%'. Returns a pointer
+ * past the specifier, or to the terminating NUL if there is none.
+ */
+static const char *parse_conversion(const char *fmt, struct conversion *conv)
+{
+	*conv = (struct conversion){ .precision = -1 };
+
+	while (true) {
+		switch (*fmt) {
+		case '-':
+			conv->fminus = true;
+			break;
+		case '+':
+			conv->fplus = true;
+			break;
+		case ' ':
+			conv->fspace = true;
+			break;
+		case '#':
+			conv->falt = true;
+			break;
+		case '0':
+			conv->fzero = true;
+			break;
+		default:
+			goto flags_done;
+		}
+		fmt++;
+	}
+flags_done:
+
+	if (*fmt == '*') {
+		conv->width_star = true;
+		fmt++;
+	} else {
+		conv->width = parse_number(&fmt);
+	}
+
+	if (*fmt == '.') {
+		fmt++;
+		if (*fmt == '*') {
+			conv->prec_star = true;
+			fmt++;
+		} else {
+			conv->precision = parse_number(&fmt);
+		}
+	}
+
+	switch (*fmt) {
+	case 'h':
+	case 'l':
+		conv->length = *fmt++;
+		if (*fmt == conv->length) {
+			conv->length = (conv->length == 'h') ? 'H' : 'L';
+			fmt++;
+		}
+		break;
+	case 'j':
+		conv->length = 'L';
+		fmt++;
+		break;
+	case 'z':
+	case 't':
+		conv->length = 'z';
+		fmt++;
+		break;
+	default:
+		break;
+	}
+
+	conv->specifier = *fmt;
+	if (*fmt != '\0') {
+		fmt++;
+	}
+
+	return fmt;
+}
+
+static enum arg_class arg_class_get(const struct conversion *conv)
+{
+	switch (conv->specifier) {
+	case 'c':
+		return ARG_INT;
+	case 'd':
+	case 'i':
+	case 'o':
+	case 'u':
+	case 'x':
+	case 'X':
+		switch (conv->length) {
+		case 'l':
+			return ARG_LONG;
+		case 'L':
+			return ARG_LLONG;
+		case 'z':
+			return ARG_SIZE;
+		default:
+			return ARG_INT;
+		}
+	case 'n':
+	case 'p':
+	case 's':
+		return ARG_PTR;
+	case 'e':
+	case 'E':
+	case 'f':
+	case 'F':
+	case 'g':
+	case 'G':
+		return ARG_DOUBLE;
+	default:
+		return ARG_NONE;
+	}
+}
+
+/* Reads an integral argument, sign extended if the conversion is signed
+ * and truncated to the type given by the length modifier.
+ */
+static unsigned long long arg_get_int(struct cbprintf_args *args,
+				      const struct conversion *conv)
+{
+	bool is_signed = (conv->specifier == 'd') || (conv->specifier == 'i');
+	unsigned long long v;
+
+	switch (arg_class_get(conv)) {
+	case ARG_LONG:
+		v = is_signed ? (unsigned long long)ARG_GET(args, long) :
+				ARG_GET(args, unsigned long);
+		break;
+	case ARG_LLONG:
+		v = ARG_GET(args, unsigned long long);
+		break;
+	case ARG_SIZE:
+		v = is_signed ?
+		    (unsigned long long)(ssize_t)ARG_GET(args, size_t) :
+		    ARG_GET(args, size_t);
+		break;
+	default:
+		v = is_signed ? (long long)ARG_GET(args, int) :
+				ARG_GET(args, unsigned int);
+		break;
+	}
+
+	if (conv->length == 'H') {
+		v = is_signed ? (long long)(signed char)v : (unsigned char)v;
+	} else if (conv->length == 'h') {
+		v = is_signed ? (long long)(short)v : (unsigned short)v;
+	}
+
+	return v;
+}
+
+/* Number conversions write backwards from the end of the buffer. Values
+ * which fit in a long, by far the most common, are converted with native
+ * word arithmetic.
+ */
+static char *encode_udec(unsigned long long value, char *end)
+{
+	unsigned long v = value;
+
+	if (IS_ENABLED(CONFIG_CBPRINTF_FULL_INTEGRAL) && (value != v)) {
+		do {
+			*--end = '0' + (value % 10U);
+			value /= 10U;
+		} while (value != 0U);
+
+		return end;
+	}
+
+	do {
+		*--end = '0' + (v % 10U);
+		v /= 10U;
+	} while (v != 0U);
+
+	return end;
+}
+
+static char *encode_pow2(unsigned long long value, char *end,
+			 unsigned int shift, bool upper)
+{
+	const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+	unsigned int mask = BIT(shift) - 1U;
+	unsigned long v = value;
+
+	if (value != v) {
+		do {
+			*--end = digits[value & mask];
+			value >>= shift;
+		} while (value != 0U);
+
+		return end;
+	}
+
+	do {
+		*--end = digits[v & mask];
+		v >>= shift;
+	} while (v != 0U);
+
+	return end;
+}
+
+#ifdef CONFIG_CBPRINTF_FP_SUPPORT
+static void _rlrshift(uint64_t *v)
+{
+	*v = (*v & 1) + (*v >> 1);
+}
+
+/*
+ * Tiny integer divide-by-five routine.  The full 64 bit division
+ * implementations in libgcc are very large on some architectures, and
+ * currently nothing in Zephyr pulls it into the link.  So it makes
+ * sense to define this much smaller special case here to avoid
+ * including it just for printf.
+ *
+ * It works by iteratively dividing the most significant 32 bits of
+ * the 64 bit value by 5.  This will leave a remainder of 0-4
+ * (i.e. three significant bits), ensuring that the top 29 bits of the
+ * remainder are zero for the next iteration.  Thus in the second
+ * iteration only 35 significant bits remain, and in the third only
+ * six.  This was tested exhaustively through the first ~10B values in
+ * the input space, and for ~2e12 (4 hours runtime) random inputs
+ * taken from the full 64 bit space.
+ */
+static void _ldiv5(uint64_t *v)
+{
+	uint32_t hi;
+	uint64_t rem = *v, quot = 0U, q;
+	int i;
+
+	static const char shifts[] = { 32, 3, 0 };
+
+	/*
+	 * Usage in this file wants rounded behavior, not truncation.  So add
+	 * two to get the threshold right.
+	 */
+	rem += 2U;
+
+	for (i = 0; i < 3; i++) {
+		hi = rem >> shifts[i];
+		q = (uint64_t)(hi / 5U) << shifts[i];
+		rem -= q * 5U;
+		quot += q;
+	}
+
+	*v = quot;
+}
+
+static char _get_digit(uint64_t *fr, int *digit_count)
+{
+	char rval;
+
+	if (*digit_count > 0) {
+		*digit_count -= 1;
+		*fr = *fr * 10U;
+		rval = ((*fr >> 60) & 0xF) + '0';
+		*fr &= 0x0FFFFFFFFFFFFFFFull;
+	} else {
+		rval = '0';
+	}
+
+	return rval;
+}
+
+/*
+ *	_to_float
+ *
+ *	Convert a floating point # to ASCII.
+ *
+ *	Parameters:
+ *		"buf"		Buffer to write result into.
+ *		"double_temp"	# to convert (either IEEE single or double).
+ *		"c"		The conversion type (one of e,E,f,g,G).
+ *		"falt"		TRUE if "#" conversion flag in effect.
+ *		"fplus"		TRUE if "+" conversion flag in effect.
+ *		"fspace"	TRUE if " " conversion flag in effect.
+ *		"precision"	Desired precision (negative if undefined).
+ *		"zeropad"	To store padding info to be inserted later
+ */
+
+/*
+ *	The following two constants define the simulated binary floating
+ *	point limit for the first stage of the conversion (fraction times
+ *	power of two becomes fraction times power of 10), and the second
+ *	stage (pulling the resulting decimal digits outs).
+ */
+
+#define	MAXFP1	0xFFFFFFFF	/* Largest # if first fp format */
+#define HIGHBIT64 (1ull<<63)
+
+static int _to_float(char *buf, uint64_t double_temp, char c,
+		     bool falt, bool fplus, bool fspace, int precision,
+		     struct zero_padding *zp)
+{
+	int decexp;
+	int exp;
+	bool sign;
+	int digit_count;
+	uint64_t fract;
+	uint64_t ltemp;
+	bool prune_zero;
+	bool upper = (c >= 'A') && (c <= 'Z');
+	char *start = buf;
+
+	exp = double_temp >> 52 & 0x7ff;
+	fract = (double_temp << 11) & ~HIGHBIT64;
+	sign = !!(double_temp & HIGHBIT64);
+
+	if (sign) {
+		*buf++ = '-';
+	} else if (fplus) {
+		*buf++ = '+';
+	} else if (fspace) {
+		*buf++ = ' ';
+	}
+
+	if (exp == 0x7ff) {
+		if (!fract) {
+			*buf++ = upper ? 'I' : 'i';
+			*buf++ = upper ? 'N' : 'n';
+			*buf++ = upper ? 'F' : 'f';
+		} else {
+			*buf++ = upper ? 'N' : 'n';
+			*buf++ = upper ? 'A' : 'a';
+			*buf++ = upper ? 'N' : 'n';
+		}
+		*buf = 0;
+		return buf - start;
+	}
+
+	if (c == 'F') {
+		c = 'f';
+	}
+
+	if ((exp | fract) != 0) {
+		if (exp == 0) {
+			/* this is a denormal */
+			while (((fract <<= 1) & HIGHBIT64) == 0) {
+				exp--;
+			}
+		}
+		exp -= (1023 - 1);	/* +1 since .1 vs 1. */
+		fract |= HIGHBIT64;
+	}
+
+	decexp = 0;
+	while (exp <= -3) {
+		while ((fract >> 32) >= (MAXFP1 / 5)) {
+			_rlrshift(&fract);
+			exp++;
+		}
+		fract *= 5U;
+		exp++;
+		decexp--;
+
+		while ((fract >> 32) <= (MAXFP1 / 2)) {
+			fract <<= 1;
+			exp--;
+		}
+	}
+
+	while (exp > 0) {
+		_ldiv5(&fract);
+		exp--;
+		decexp++;
+		while ((fract >> 32) <= (MAXFP1 / 2)) {
+			fract <<= 1;
+			exp--;
+		}
+	}
+
+	while (exp < (0 + 4)) {
+		_rlrshift(&fract);
+		exp++;
+	}
+
+	if (precision < 0) {
+		precision = 6;		/* Default precision if none given */
+	}
+
+	prune_zero = false;		/* Assume trailing 0's allowed     */
+	if ((c == 'g') || (c == 'G')) {
+		if (decexp < (-4 + 1) || decexp > precision) {
+			c += 'e' - 'g';
+			if (precision > 0) {
+				precision--;
+			}
+		} else {
+			c = 'f';
+			precision -= decexp;
+		}
+		if (!falt && (precision > 0)) {
+			prune_zero = true;
+		}
+	}
+
+	if (c == 'f') {
+		exp = precision + decexp;
+		if (exp < 0) {
+			exp = 0;
+		}
+	} else {
+		exp = precision + 1;
+	}
+	digit_count = 16;
+	if (exp > 16) {
+		exp = 16;
+	}
+
+	ltemp = 0x0800000000000000;
+	while (exp--) {
+		_ldiv5(&ltemp);
+		_rlrshift(&ltemp);
+	}
+
+	fract += ltemp;
+	if ((fract >> 32) & 0xF0000000) {
+		_ldiv5(&fract);
+		_rlrshift(&fract);
+		decexp++;
+	}
+
+	if (c == 'f') {
+		if (decexp > 0) {
+			while (decexp > 0 && digit_count > 0) {
+				*buf++ = _get_digit(&fract, &digit_count);
+				decexp--;
+			}
+			zp->predot = decexp;
+			decexp = 0;
+		} else {
+			*buf++ = '0';
+		}
+		if (falt || (precision > 0)) {
+			*buf++ = '.';
+		}
+		if (decexp < 0 && precision > 0) {
+			zp->postdot = -decexp;
+			if (zp->postdot > precision) {
+				zp->postdot = precision;
+			}
+			precision -= zp->postdot;
+		}
+		while (precision > 0 && digit_count > 0) {
+			*buf++ = _get_digit(&fract, &digit_count);
+			precision--;
+		}
+		zp->trail = precision;
+	} else {
+		*buf = _get_digit(&fract, &digit_count);
+		if (*buf++ != '0') {
+			decexp--;
+		}
+		if (falt || (precision > 0)) {
+			*buf++ = '.';
+		}
+		while (precision > 0 && digit_count > 0) {
+			*buf++ = _get_digit(&fract, &digit_count);
+			precision--;
+		}
+		zp->trail = precision;
+	}
+
+	if (prune_zero) {
+		zp->trail = 0;
+		while (*--buf == '0')
+			;
+		if (*buf != '.') {
+			buf++;
+		}
+	}
+
+	if ((c == 'e') || (c == 'E')) {
+		*buf++ = c;
+		if (decexp < 0) {
+			decexp = -decexp;
+			*buf++ = '-';
+		} else {
+			*buf++ = '+';
+		}
+		if (decexp >= 100) {
+			*buf++ = (decexp / 100) + '0';
+			decexp %= 100;
+		}
+		*buf++ = (decexp / 10) + '0';
+		decexp %= 10;
+		*buf++ = decexp + '0';
+	}
+	*buf = 0;
+
+	return buf - start;
+}
+#endif /* CONFIG_CBPRINTF_FP_SUPPORT */
+
+static inline bool is_digit(char c)
+{
+	return (c >= '0') && (c <= '9');
+}
+
+static void store_count(struct cbprintf_args *args,
+			const struct conversion *conv, int count)
+{
+	void *dst = ARG_GET(args, void *);
+
+	switch (conv->length) {
+	case 'H':
+		*(signed char *)dst = count;
+		break;
+	case 'h':
+		*(short *)dst = count;
+		break;
+	case 'l':
+		*(long *)dst = count;
+		break;
+	case 'L':
+		*(long long *)dst = count;
+		break;
+	case 'z':
+		*(ssize_t *)dst = count;
+		break;
+	default:
+		*(int *)dst = count;
+		break;
+	}
+}
+
+static int cbprintf_impl(cbprintf_cb out, void *ctx, const char *format,
+			 struct cbprintf_args *args)
+{
+	/*
+	 * The work buffer has to accommodate for the largest data length.
+	 * The max range octal length is one prefix + 3 bits per digit
+	 * meaning 23 bytes for a 64-bit value.
+	 * The float code may extract up to 16 digits, plus a prefix,
+	 * a leading 0, a dot, and an exponent in the form e+xxx for
+	 * a total of 24. Add a trailing NULL so it is 25.
+	 */
+	char buf[25];
+	char *const end = buf + sizeof(buf);
+	struct conversion conv;
+	char c;
+	int count = 0;
+	const char *cptr;
+	int width, precision;
+	int clen, prefix, zero_head;
+	bool fzero;
+	struct zero_padding zero;
+
+#define PUTC(c)	do {							\
+		if (out((unsigned char)(c), ctx) == EOF) {		\
+			return EOF;					\
+		}							\
+	} while (false)
+
+	while ((c = *format++) != '\0') {
+		if (c != '%') {
+			PUTC(c);
+			count++;
+			continue;
+		}
+
+		format = parse_conversion(format, &conv);
+
+		width = conv.width_star ? ARG_GET(args, int) : conv.width;
+		if (width < 0) {
+			conv.fminus = true;
+			width = -width;
+		}
+
+		precision = conv.prec_star ? ARG_GET(args, int) :
+					     conv.precision;
+		if (precision < -1) {
+			precision = -1;
+		}
+
+		fzero = conv.fzero;
+		prefix = 0;
+		zero.predot = zero.postdot = zero.trail = 0;
+
+		switch (conv.specifier) {
+		case 'c':
+			buf[0] = ARG_GET(args, int);
+			cptr = buf;
+			clen = 1;
+			precision = 0;
+			break;
+
+		case 'd':
+		case 'i': {
+			unsigned long long val = arg_get_int(args, &conv);
+			bool neg = (long long)val < 0;
+			char *p;
+
+			if (neg) {
+				val = -val;
+			}
+
+			if (!IS_ENABLED(CONFIG_CBPRINTF_FULL_INTEGRAL) &&
+			    (val > ULONG_MAX)) {
+				cptr = "ERR";
+				clen = 3;
+				break;
+			}
+
+			p = encode_udec(val, end);
+			if (neg) {
+				*--p = '-';
+			} else if (conv.fplus) {
+				*--p = '+';
+			} else if (conv.fspace) {
+				*--p = ' ';
+			}
+			if (neg || conv.fplus || conv.fspace) {
+				prefix = 1;
+			}
+			cptr = p;
+			clen = end - p;
+			break;
+		}
+
+		case 'u': {
+			unsigned long long val = arg_get_int(args, &conv);
+
+			if (!IS_ENABLED(CONFIG_CBPRINTF_FULL_INTEGRAL) &&
+			    (val > ULONG_MAX)) {
+				cptr = "ERR";
+				clen = 3;
+				break;
+			}
+
+			cptr = encode_udec(val, end);
+			clen = end - cptr;
+			break;
+		}
+
+		case 'o': {
+			unsigned long long val = arg_get_int(args, &conv);
+			char *p = encode_pow2(val, end, 3, false);
+
+			/* No prefix accounting, "0" is part of the value */
+			if (conv.falt && (val != 0U)) {
+				*--p = '0';
+			}
+			cptr = p;
+			clen = end - p;
+			break;
+		}
+
+		case 'p':
+		case 'x':
+		case 'X': {
+			unsigned long long val;
+			bool alt = conv.falt;
+			char *p;
+
+			if (conv.specifier == 'p') {
+				val = (uintptr_t)ARG_GET(args, void *);
+				alt = true;
+			} else {
+				val = arg_get_int(args, &conv);
+			}
+
+			p = encode_pow2(val, end, 4, conv.specifier == 'X');
+			if (alt) {
+				*--p = (conv.specifier == 'X') ? 'X' : 'x';
+				*--p = '0';
+				prefix = 2;
+			}
+			cptr = p;
+			clen = end - p;
+			break;
+		}
+
+		case 's':
+			cptr = ARG_GET(args, const char *);
+			if (cptr == NULL) {
+				cptr = "(null)";
+			}
+			/* Get the string length */
+			if (precision < 0) {
+				precision = INT_MAX;
+			}
+			for (clen = 0; clen < precision; clen++) {
+				if (cptr[clen] == '\0') {
+					break;
+				}
+			}
+			precision = 0;
+			break;
+
+		case 'e':
+		case 'E':
+		case 'f':
+		case 'F':
+		case 'g':
+		case 'G': {
+			union {
+				double d;
+				uint64_t i;
+			} u;
+
+			u.d = ARG_GET(args, double);
+
+#ifdef CONFIG_CBPRINTF_FP_SUPPORT
+			clen = _to_float(buf, u.i, conv.specifier, conv.falt,
+					 conv.fplus, conv.fspace, precision,
+					 &zero);
+			if (conv.fplus || conv.fspace || (buf[0] == '-')) {
+				prefix = 1;
+			}
+			clen += zero.predot + zero.postdot + zero.trail;
+			if (!is_digit(buf[prefix])) {
+				/* inf or nan: no zero padding */
+				fzero = false;
+			}
+			cptr = buf;
+			precision = -1;
+			break;
+#else
+			/* Argument is consumed to keep the following ones */
+			(void)u;
+			PUTC('%');
+			PUTC(conv.specifier);
+			count += 2;
+			continue;
+#endif
+		}
+
+		case 'n':
+			store_count(args, &conv, count);
+			continue;
+
+		case '%':
+			PUTC('%');
+			count++;
+			continue;
+
+		case '\0':
+			return count;
+
+		default:
+			PUTC('%');
+			PUTC(conv.specifier);
+			count += 2;
+			continue;
+		}
+
+		if (precision >= 0) {
+			zero_head = precision - clen + prefix;
+		} else if (fzero) {
+			zero_head = width - clen;
+		} else {
+			zero_head = 0;
+		}
+		if (zero_head < 0) {
+			zero_head = 0;
+		}
+		width -= clen + zero_head;
+
+		/* padding for right justification */
+		if (!conv.fminus && width > 0) {
+			count += width;
+			while (width-- > 0) {
+				PUTC(' ');
+			}
+		}
+
+		/* data prefix */
+		clen -= prefix;
+		count += prefix;
+		while (prefix-- > 0) {
+			PUTC(*cptr++);
+		}
+
+		/* zero-padded head */
+		count += zero_head;
+		while (zero_head-- > 0) {
+			PUTC('0');
+		}
+
+		/*
+		 * main data:
+		 *
+		 * In the case of floats, 3 possible zero-padding
+		 * are included in the clen count, either with
+		 *	xxxxxx<zero.predot>.<zero.postdot>
+		 * or with
+		 *	x.<zero.postdot>xxxxxx<zero.trail>[e+xx]
+		 * In the non-float cases, those predot, postdot and
+		 * tail params are equal to 0.
+		 */
+		count += clen;
+		if (zero.predot) {
+			c = *cptr;
+			while (is_digit(c)) {
+				PUTC(c);
+				clen--;
+				c = *++cptr;
+			}
+			clen -= zero.predot;
+			while (zero.predot-- > 0) {
+				PUTC('0');
+			}
+		}
+		if (zero.postdot) {
+			do {
+				c = *cptr++;
+				PUTC(c);
+				clen--;
+			} while (c != '.');
+			clen -= zero.postdot;
+			while (zero.postdot-- > 0) {
+				PUTC('0');
+			}
+		}
+		if (zero.trail) {
+			c = *cptr;
+			while (is_digit(c) || c == '.') {
+				PUTC(c);
+				clen--;
+				c = *++cptr;
+			}
+			clen -= zero.trail;
+			while (zero.trail-- > 0) {
+				PUTC('0');
+			}
+		}
+		while (clen-- > 0) {
+			PUTC(*cptr++);
+		}
+
+		/* padding for left justification */
+		if (width > 0) {
+			count += width;
+			while (width-- > 0) {
+				PUTC(' ');
+			}
+		}
+	}
+
+	return count;
+
+#undef PUTC
+}
+
+int cbvprintf(cbprintf_cb out, void *ctx, const char *format, va_list ap)
+{
+	struct cbprintf_args args = { .pkg = NULL };
+	int ret;
+
+	va_copy(args.ap, ap);
+	ret = cbprintf_impl(out, ctx, format, &args);
+	va_end(args.ap);
+
+	return ret;
+}
+
+int cbprintf(cbprintf_cb out, void *ctx, const char *format, ...)
+{
+	va_list ap;
+	int ret;
+
+	va_start(ap, format);
+	ret = cbvprintf(out, ctx, format, ap);
+	va_end(ap);
+
+	return ret;
+}
+
+int cbvprintf_package(void *packaged, size_t len, const char *format,
+		      va_list ap)
+{
+	u8_t *buf = packaged;
+	size_t off = 0;
+	struct conversion conv;
+
+#define PKG_PUT(type, value) do {					\
+		type _v = (value);					\
+									\
+		off = ROUND_UP(off, __alignof__(type));			\
+		if (buf != NULL) {					\
+			if (off + sizeof(type) > len) {			\
+				return -ENOSPC;				\
+			}						\
+			memcpy(&buf[off], &_v, sizeof(type));		\
+		}							\
+		off += sizeof(type);					\
+	} while (false)
+
+	PKG_PUT(const char *, format);
+
+	while (*format != '\0') {
+		if (*format++ != '%') {
+			continue;
+		}
+
+		format = parse_conversion(format, &conv);
+
+		if (conv.width_star) {
+			PKG_PUT(int, va_arg(ap, int));
+		}
+		if (conv.prec_star) {
+			PKG_PUT(int, va_arg(ap, int));
+		}
+
+		switch (arg_class_get(&conv)) {
+		case ARG_INT:
+			PKG_PUT(int, va_arg(ap, int));
+			break;
+		case ARG_LONG:
+			PKG_PUT(long, va_arg(ap, long));
+			break;
+		case ARG_LLONG:
+			PKG_PUT(long long, va_arg(ap, long long));
+			break;
+		case ARG_SIZE:
+			PKG_PUT(size_t, va_arg(ap, size_t));
+			break;
+		case ARG_PTR:
+			PKG_PUT(void *, va_arg(ap, void *));
+			break;
+		case ARG_DOUBLE:
+			PKG_PUT(double, va_arg(ap, double));
+			break;
+		default:
+			break;
+		}
+	}
+
+	return off;
+
+#undef PKG_PUT
+}
+
+int cbprintf_package(void *packaged, size_t len, const char *format, ...)
+{
+	va_list ap;
+	int ret;
+
+	va_start(ap, format);
+	ret = cbvprintf_package(packaged, len, format, ap);
+	va_end(ap);
+
+	return ret;
+}
+
+int cbpprintf(cbprintf_cb out, void *ctx, const void *packaged)
+{
+	struct cbprintf_args args = {
+		.pkg = packaged,
+		.off = sizeof(const char *),
+	};
+
+	return cbprintf_impl(out, ctx, *(const char *const *)packaged, &args);
+}
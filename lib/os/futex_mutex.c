@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/futex_mutex.h>
+
+#ifdef CONFIG_USERSPACE
+#define FUTEX_MUTEX_UNLOCKED	0
+#define FUTEX_MUTEX_LOCKED	1
+#define FUTEX_MUTEX_CONTENDED	2
+
+void sys_futex_mutex_init(struct sys_futex_mutex *mutex)
+{
+	atomic_set(&mutex->futex.val, FUTEX_MUTEX_UNLOCKED);
+}
+
+int sys_futex_mutex_lock(struct sys_futex_mutex *mutex, s32_t timeout)
+{
+	atomic_t old_value;
+	s64_t end = 0;
+	int ret;
+
+	if (atomic_cas(&mutex->futex.val, FUTEX_MUTEX_UNLOCKED,
+		       FUTEX_MUTEX_LOCKED)) {
+		return 0;
+	}
+
+	if (timeout == K_NO_WAIT) {
+		return -EBUSY;
+	}
+
+	if (timeout != K_FOREVER) {
+		end = k_uptime_get() + timeout;
+	}
+
+	/*
+	 * Mark the mutex contended before sleeping so that the holder
+	 * knows to wake us.  Whoever takes it from here on keeps it marked,
+	 * since it cannot tell whether other waiters remain.
+	 */
+	old_value = atomic_set(&mutex->futex.val, FUTEX_MUTEX_CONTENDED);
+	while (old_value != FUTEX_MUTEX_UNLOCKED) {
+		/* Wakeups that lose the race must not restart the timeout */
+		if (timeout != K_FOREVER) {
+			s64_t remaining = end - k_uptime_get();
+
+			if (remaining <= 0) {
+				return -ETIMEDOUT;
+			}
+			timeout = (s32_t)remaining;
+		}
+
+		ret = k_futex_wait(&mutex->futex, FUTEX_MUTEX_CONTENDED,
+				   timeout);
+		if (ret != 0 && ret != -EAGAIN) {
+			return ret;
+		}
+
+		old_value = atomic_set(&mutex->futex.val,
+				       FUTEX_MUTEX_CONTENDED);
+	}
+
+	return 0;
+}
+
+int sys_futex_mutex_unlock(struct sys_futex_mutex *mutex)
+{
+	atomic_t old_value;
+	int ret;
+
+	do {
+		old_value = atomic_get(&mutex->futex.val);
+		if (old_value == FUTEX_MUTEX_UNLOCKED) {
+			return -EINVAL;
+		}
+	} while (atomic_cas(&mutex->futex.val, old_value,
+			    FUTEX_MUTEX_UNLOCKED) == 0);
+
+	if (old_value == FUTEX_MUTEX_LOCKED) {
+		return 0;
+	}
+
+	ret = k_futex_wake(&mutex->futex, false);
+
+	return ret < 0 ? ret : 0;
+}
+#else
+void sys_futex_mutex_init(struct sys_futex_mutex *mutex)
+{
+	k_mutex_init(&mutex->kernel_mutex);
+}
+
+int sys_futex_mutex_lock(struct sys_futex_mutex *mutex, s32_t timeout)
+{
+	int ret_value;
+
+	ret_value = k_mutex_lock(&mutex->kernel_mutex, timeout);
+	if (ret_value == -EAGAIN) {
+		ret_value = -ETIMEDOUT;
+	}
+
+	return ret_value;
+}
+
+int sys_futex_mutex_unlock(struct sys_futex_mutex *mutex)
+{
+	if (mutex->kernel_mutex.lock_count == 0U) {
+		return -EINVAL;
+	}
+
+	k_mutex_unlock(&mutex->kernel_mutex);
+
+	return 0;
+}
+#endif
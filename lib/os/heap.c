@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/sys_heap.h>
+#include <sys/__assert.h>
+#include <toolchain.h>
+#include <string.h>
+
+/* Every block starts with a header holding a pointer to its physical
+ * predecessor and its own size (header included).  The low bit of the
+ * size word flags a free block.  Free blocks additionally carry their
+ * free list links in what would otherwise be the user area.
+ */
+struct z_heap_block {
+	struct z_heap_block *prev_phys;
+	size_t size;
+	struct z_heap_block *next_free;
+	struct z_heap_block *prev_free;
+};
+
+#define BLOCK_FREE	BIT(0)
+#define MIN_BLOCK	ROUND_UP(sizeof(struct z_heap_block), Z_HEAP_ALIGN)
+
+/* Control data at the start of the heap memory.  It is followed by the
+ * second level bitmaps and by fl_count * Z_HEAP_SL_COUNT free list
+ * heads, see Z_HEAP_CTRL_SIZE().
+ */
+struct z_heap {
+	u32_t fl_bitmap;
+	u32_t fl_count;
+	struct z_heap_block *end;
+};
+
+BUILD_ASSERT(sizeof(struct z_heap) <= 3 * sizeof(void *));
+BUILD_ASSERT(offsetof(struct z_heap_block, next_free) == Z_HEAP_BLOCK_HDR);
+
+static inline u32_t *sl_bitmap(struct z_heap *h)
+{
+	return (u32_t *)((u8_t *)h + ROUND_UP(sizeof(*h), Z_HEAP_ALIGN));
+}
+
+static inline struct z_heap_block **free_list(struct z_heap *h, u32_t fl, u32_t sl)
+{
+	u8_t *lists = (u8_t *)sl_bitmap(h) +
+		ROUND_UP(sizeof(u32_t) * h->fl_count, Z_HEAP_ALIGN);
+
+	return &((struct z_heap_block **)lists)[fl * Z_HEAP_SL_COUNT + sl];
+}
+
+static inline size_t block_size(struct z_heap_block *b)
+{
+	return b->size & ~(size_t)BLOCK_FREE;
+}
+
+static inline bool block_is_free(struct z_heap_block *b)
+{
+	return (b->size & BLOCK_FREE) != 0U;
+}
+
+static inline struct z_heap_block *next_phys(struct z_heap_block *b)
+{
+	return (struct z_heap_block *)((u8_t *)b + block_size(b));
+}
+
+static inline int fls32(u32_t x)
+{
+	return 31 - __builtin_clz(x);
+}
+
+/* Size class holding blocks of the given size */
+static void mapping_insert(size_t size, u32_t *fl, u32_t *sl)
+{
+	if (size < BIT(Z_HEAP_FL_SHIFT)) {
+		*fl = 0;
+		*sl = size / (BIT(Z_HEAP_FL_SHIFT) / Z_HEAP_SL_COUNT);
+	} else {
+		int f = fls32(size);
+
+		*sl = (size >> (f - Z_HEAP_SL_LOG2)) - Z_HEAP_SL_COUNT;
+		*fl = f - Z_HEAP_FL_SHIFT + 1;
+	}
+}
+
+/* Smallest size class whose blocks are all at least size bytes */
+static void mapping_search(size_t size, u32_t *fl, u32_t *sl)
+{
+	if (size >= BIT(Z_HEAP_FL_SHIFT)) {
+		size += BIT(fls32(size) - Z_HEAP_SL_LOG2) - 1;
+	}
+	mapping_insert(size, fl, sl);
+}
+
+static void free_list_add(struct z_heap *h, struct z_heap_block *b)
+{
+	struct z_heap_block **head;
+	u32_t fl, sl;
+
+	mapping_insert(block_size(b), &fl, &sl);
+	head = free_list(h, fl, sl);
+
+	b->size |= BLOCK_FREE;
+	b->prev_free = NULL;
+	b->next_free = *head;
+	if (*head != NULL) {
+		(*head)->prev_free = b;
+	}
+	*head = b;
+
+	h->fl_bitmap |= BIT(fl);
+	sl_bitmap(h)[fl] |= BIT(sl);
+}
+
+static void free_list_remove(struct z_heap *h, struct z_heap_block *b)
+{
+	u32_t fl, sl;
+
+	mapping_insert(block_size(b), &fl, &sl);
+
+	if (b->prev_free != NULL) {
+		b->prev_free->next_free = b->next_free;
+	} else {
+		*free_list(h, fl, sl) = b->next_free;
+	}
+	if (b->next_free != NULL) {
+		b->next_free->prev_free = b->prev_free;
+	}
+
+	if (*free_list(h, fl, sl) == NULL) {
+		sl_bitmap(h)[fl] &= ~BIT(sl);
+		if (sl_bitmap(h)[fl] == 0U) {
+			h->fl_bitmap &= ~BIT(fl);
+		}
+	}
+
+	b->size &= ~(size_t)BLOCK_FREE;
+}
+
+/* Returns a free block of at least size bytes, or NULL */
+static struct z_heap_block *find_block(struct z_heap *h, size_t size)
+{
+	struct z_heap_block *b;
+	u32_t map;
+	u32_t fl, sl;
+
+	/* Any block in the rounded-up class fits without searching */
+	mapping_search(size, &fl, &sl);
+	if (fl < h->fl_count) {
+		map = sl_bitmap(h)[fl] & (~0U << sl);
+		if (map == 0U) {
+			map = h->fl_bitmap & (~0U << 1 << fl);
+			if (map != 0U) {
+				fl = __builtin_ctz(map);
+				map = sl_bitmap(h)[fl];
+			}
+		}
+		if (map != 0U) {
+			return *free_list(h, fl, __builtin_ctz(map));
+		}
+	}
+
+	/* Otherwise the class of the request itself may still hold a
+	 * big enough block; check its head only, to stay O(1).
+	 */
+	mapping_insert(size, &fl, &sl);
+	if (fl < h->fl_count) {
+		b = *free_list(h, fl, sl);
+		if (b != NULL && block_size(b) >= size) {
+			return b;
+		}
+	}
+
+	return NULL;
+}
+
+void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
+{
+	uintptr_t addr = ROUND_UP((uintptr_t)mem, Z_HEAP_ALIGN);
+	struct z_heap *h = (struct z_heap *)addr;
+	struct z_heap_block *b;
+	size_t ctrl;
+
+	heap->init_mem = mem;
+	heap->init_bytes = bytes;
+
+	bytes = ROUND_DOWN(bytes - (addr - (uintptr_t)mem), Z_HEAP_ALIGN);
+
+	/* Use as few first-level classes as the largest possible block
+	 * needs; the control data shrinks with them.
+	 */
+	h->fl_bitmap = 0U;
+	h->fl_count = 1U;
+	while (Z_HEAP_CTRL_SIZE(h->fl_count) + Z_HEAP_BLOCK_HDR < bytes &&
+	       Z_HEAP_FL_COUNT(bytes - Z_HEAP_CTRL_SIZE(h->fl_count) -
+			       Z_HEAP_BLOCK_HDR) > h->fl_count) {
+		h->fl_count++;
+	}
+	ctrl = Z_HEAP_CTRL_SIZE(h->fl_count);
+
+	__ASSERT(h->fl_count <= 32U, "heap too large");
+	__ASSERT(bytes >= ctrl + MIN_BLOCK + Z_HEAP_BLOCK_HDR,
+		 "heap too small");
+
+	(void)memset(sl_bitmap(h), 0, ctrl - ((u8_t *)sl_bitmap(h) - (u8_t *)h));
+
+	/* One free block spanning the heap, followed by a zero-sized
+	 * allocated sentinel so that every real block has a successor.
+	 */
+	b = (struct z_heap_block *)(addr + ctrl);
+	b->prev_phys = NULL;
+	b->size = bytes - ctrl - Z_HEAP_BLOCK_HDR;
+
+	h->end = next_phys(b);
+	h->end->prev_phys = b;
+	h->end->size = 0;
+
+	free_list_add(h, b);
+
+	heap->heap = h;
+}
+
+void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
+{
+	struct z_heap *h = heap->heap;
+	struct z_heap_block *b;
+	size_t size;
+
+	if (bytes == 0U || bytes > heap->init_bytes) {
+		return NULL;
+	}
+
+	size = MAX(ROUND_UP(bytes + Z_HEAP_BLOCK_HDR, Z_HEAP_ALIGN), MIN_BLOCK);
+
+	b = find_block(h, size);
+	if (b == NULL) {
+		return NULL;
+	}
+
+	free_list_remove(h, b);
+
+	/* Split off the tail if it can stand as a block of its own */
+	if (block_size(b) - size >= MIN_BLOCK) {
+		struct z_heap_block *rest = (struct z_heap_block *)((u8_t *)b + size);
+
+		rest->prev_phys = b;
+		rest->size = block_size(b) - size;
+		next_phys(rest)->prev_phys = rest;
+		b->size = size;
+		free_list_add(h, rest);
+	}
+
+	return (u8_t *)b + Z_HEAP_BLOCK_HDR;
+}
+
+void sys_heap_free(struct sys_heap *heap, void *mem)
+{
+	struct z_heap *h = heap->heap;
+	struct z_heap_block *b, *next;
+
+	if (mem == NULL) {
+		return;
+	}
+
+	b = (struct z_heap_block *)((u8_t *)mem - Z_HEAP_BLOCK_HDR);
+
+	__ASSERT(!block_is_free(b), "double free of %p", mem);
+	__ASSERT(next_phys(b)->prev_phys == b, "corrupt heap bounds (buffer overflow?)");
+
+	/* Coalesce with free physical neighbors */
+	next = next_phys(b);
+	if (block_is_free(next)) {
+		free_list_remove(h, next);
+		b->size += block_size(next);
+	}
+
+	if (b->prev_phys != NULL && block_is_free(b->prev_phys)) {
+		struct z_heap_block *prev = b->prev_phys;
+
+		free_list_remove(h, prev);
+		prev->size += block_size(b);
+		b = prev;
+	}
+
+	next_phys(b)->prev_phys = b;
+	free_list_add(h, b);
+}
+
+bool sys_heap_validate(struct sys_heap *heap)
+{
+	struct z_heap *h = heap->heap;
+	struct z_heap_block *b, *prev = NULL;
+	size_t nfree = 0, nlisted = 0;
+	u32_t fl, sl;
+
+	/* Walk the physical chain: links must be consistent and no two
+	 * free blocks may be adjacent.
+	 */
+	for (b = (struct z_heap_block *)((u8_t *)h +
+					 Z_HEAP_CTRL_SIZE(h->fl_count));
+	     b != h->end; b = next_phys(b)) {
+		if (b->prev_phys != prev || block_size(b) < MIN_BLOCK ||
+		    (block_size(b) % Z_HEAP_ALIGN) != 0U ||
+		    (u8_t *)next_phys(b) > (u8_t *)h->end) {
+			return false;
+		}
+		if (block_is_free(b)) {
+			if (prev != NULL && block_is_free(prev)) {
+				return false;
+			}
+			nfree++;
+		}
+		prev = b;
+	}
+
+	if (h->end->prev_phys != prev) {
+		return false;
+	}
+
+	/* Every free block must be listed in its size class, and the
+	 * bitmaps must agree with the lists.
+	 */
+	for (fl = 0; fl < h->fl_count; fl++) {
+		for (sl = 0; sl < Z_HEAP_SL_COUNT; sl++) {
+			struct z_heap_block *head = *free_list(h, fl, sl);
+			bool bit = (sl_bitmap(h)[fl] & BIT(sl)) != 0U;
+
+			if (bit != (head != NULL)) {
+				return false;
+			}
+
+			for (b = head; b != NULL; b = b->next_free) {
+				u32_t bfl, bsl;
+
+				mapping_insert(block_size(b), &bfl, &bsl);
+				if (!block_is_free(b) || bfl != fl ||
+				    bsl != sl || (b == head) !=
+				    (b->prev_free == NULL)) {
+					return false;
+				}
+				nlisted++;
+			}
+		}
+
+		if (((h->fl_bitmap & BIT(fl)) != 0U) !=
+		    (sl_bitmap(h)[fl] != 0U)) {
+			return false;
+		}
+	}
+
+	return nfree == nlisted;
+}
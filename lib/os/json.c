@@ -919,3 +919,565 @@ ssize_t json_calc_encoded_len(const struct json_obj_descr *descr,
 
 	return total;
 }
+
+enum json_stream_expect {
+	JSON_EXPECT_VALUE,
+	JSON_EXPECT_VALUE_OR_END,
+	JSON_EXPECT_KEY,
+	JSON_EXPECT_KEY_OR_END,
+	JSON_EXPECT_COLON,
+	JSON_EXPECT_COMMA_OR_END,
+	JSON_EXPECT_NOTHING,
+};
+
+static const char *const json_literals[] = {
+	[0] = "true",
+	[1] = "false",
+	[2] = "null",
+};
+
+void json_stream_init(struct json_stream *js, char *tok_buf,
+		      size_t tok_buf_size, json_token_cb_t cb,
+		      void *user_data)
+{
+	*js = (struct json_stream) {
+		.cb = cb,
+		.user_data = user_data,
+		.tok_buf = tok_buf,
+		.tok_buf_size = tok_buf_size,
+		.expect = JSON_EXPECT_VALUE,
+		.scan = JSON_TOK_NONE,
+	};
+}
+
+static bool stream_top_is_obj(const struct json_stream *js)
+{
+	return js->obj_stack & BIT(js->depth - 1);
+}
+
+static bool stream_expects_value(const struct json_stream *js)
+{
+	return js->expect == JSON_EXPECT_VALUE ||
+	       js->expect == JSON_EXPECT_VALUE_OR_END;
+}
+
+static void stream_value_done(struct json_stream *js)
+{
+	js->expect = js->depth ? JSON_EXPECT_COMMA_OR_END : JSON_EXPECT_NOTHING;
+}
+
+static int stream_emit(struct json_stream *js, enum json_tokens type,
+		       const char *start, size_t len)
+{
+	struct json_token token = {
+		.type = type,
+		.key = js->key,
+		.depth = js->depth,
+		.start = start,
+		.len = len,
+	};
+
+	return js->cb(&token, js->user_data);
+}
+
+static int stream_append(struct json_stream *js, const char *data,
+			 size_t len)
+{
+	if (len > js->tok_buf_size - js->tok_len) {
+		return -ENOMEM;
+	}
+
+	memcpy(&js->tok_buf[js->tok_len], data, len);
+	js->tok_len += len;
+	js->buffered = true;
+
+	return 0;
+}
+
+/* Reports the string or number token ending at data[end] */
+static int stream_emit_text(struct json_stream *js, const char *data,
+			    size_t start, size_t end)
+{
+	enum json_tokens type = js->scan;
+	int ret;
+
+	js->scan = JSON_TOK_NONE;
+
+	if (js->buffered) {
+		ret = stream_append(js, &data[start], end - start);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = stream_emit(js, type, js->tok_buf, js->tok_len);
+	} else {
+		ret = stream_emit(js, type, &data[start], end - start);
+	}
+
+	if (type == JSON_TOK_STRING && js->key) {
+		js->key = false;
+		js->expect = JSON_EXPECT_COLON;
+	} else {
+		stream_value_done(js);
+	}
+
+	return ret;
+}
+
+static void stream_start_scan(struct json_stream *js, enum json_tokens type)
+{
+	js->scan = type;
+	js->tok_len = 0U;
+	js->buffered = false;
+	js->escape = false;
+}
+
+static int stream_structural(struct json_stream *js, char chr)
+{
+	bool is_obj;
+	int ret;
+
+	switch (chr) {
+	case ' ':
+	case '\t':
+	case '\n':
+	case '\r':
+		return 0;
+	case '{':
+	case '[':
+		if (!stream_expects_value(js)) {
+			return -EINVAL;
+		}
+
+		if (js->depth == JSON_STREAM_MAX_DEPTH) {
+			return -ENOMEM;
+		}
+
+		ret = stream_emit(js, (enum json_tokens)chr, NULL, 0);
+
+		WRITE_BIT(js->obj_stack, js->depth, chr == '{');
+		js->depth++;
+		js->expect = (chr == '{') ? JSON_EXPECT_KEY_OR_END :
+					    JSON_EXPECT_VALUE_OR_END;
+
+		return ret;
+	case '}':
+	case ']':
+		is_obj = (chr == '}');
+
+		if (js->depth == 0 || stream_top_is_obj(js) != is_obj) {
+			return -EINVAL;
+		}
+
+		if (js->expect != JSON_EXPECT_COMMA_OR_END &&
+		    js->expect != (is_obj ? JSON_EXPECT_KEY_OR_END :
+					    JSON_EXPECT_VALUE_OR_END)) {
+			return -EINVAL;
+		}
+
+		js->depth--;
+		stream_value_done(js);
+
+		return stream_emit(js, (enum json_tokens)chr, NULL, 0);
+	case ',':
+		if (js->expect != JSON_EXPECT_COMMA_OR_END) {
+			return -EINVAL;
+		}
+
+		js->expect = stream_top_is_obj(js) ? JSON_EXPECT_KEY :
+						     JSON_EXPECT_VALUE;
+
+		return 0;
+	case ':':
+		if (js->expect != JSON_EXPECT_COLON) {
+			return -EINVAL;
+		}
+
+		js->expect = JSON_EXPECT_VALUE;
+
+		return 0;
+	case '"':
+		if (js->expect == JSON_EXPECT_KEY ||
+		    js->expect == JSON_EXPECT_KEY_OR_END) {
+			js->key = true;
+		} else if (!stream_expects_value(js)) {
+			return -EINVAL;
+		}
+
+		stream_start_scan(js, JSON_TOK_STRING);
+
+		return 0;
+	case 't':
+	case 'f':
+	case 'n':
+		if (!stream_expects_value(js)) {
+			return -EINVAL;
+		}
+
+		stream_start_scan(js, (enum json_tokens)chr);
+		js->lit_pos = 1U;
+
+		return 0;
+	default:
+		if (!isdigit((unsigned char)chr) && chr != '-') {
+			return -EINVAL;
+		}
+
+		if (!stream_expects_value(js)) {
+			return -EINVAL;
+		}
+
+		stream_start_scan(js, JSON_TOK_NUMBER);
+
+		return 0;
+	}
+}
+
+static const char *stream_literal(enum json_tokens type)
+{
+	switch (type) {
+	case JSON_TOK_TRUE:
+		return json_literals[0];
+	case JSON_TOK_FALSE:
+		return json_literals[1];
+	default:
+		return json_literals[2];
+	}
+}
+
+/* Returns 1 if the character ended a string, 0 if it was consumed */
+static int stream_string_char(struct json_stream *js, char chr)
+{
+	if (js->escape) {
+		if (js->lit_pos > 0U) {
+			/* Hexadecimal digits of \uXXXX */
+			if (!isxdigit((unsigned char)chr)) {
+				return -EINVAL;
+			}
+
+			js->lit_pos--;
+		} else if (chr == 'u') {
+			js->lit_pos = 4U;
+		} else if (strchr("\"\\/bfnrt", chr) == NULL || chr == '\0') {
+			return -EINVAL;
+		}
+
+		js->escape = (js->lit_pos > 0U);
+
+		return 0;
+	}
+
+	if (chr == '\\') {
+		js->escape = true;
+		return 0;
+	}
+
+	return (chr == '"') ? 1 : 0;
+}
+
+static bool is_number_char(char chr)
+{
+	return isdigit((unsigned char)chr) || chr == '.' || chr == 'e' ||
+	       chr == 'E' || chr == '+' || chr == '-';
+}
+
+int json_stream_feed(struct json_stream *js, const char *data, size_t len)
+{
+	size_t tok_start = 0;
+	size_t i;
+	int ret = 0;
+
+	if (js->err < 0) {
+		return js->err;
+	}
+
+	for (i = 0; i < len && ret >= 0; i++) {
+		char chr = data[i];
+
+		switch (js->scan) {
+		case JSON_TOK_STRING:
+			ret = stream_string_char(js, chr);
+			if (ret > 0) {
+				ret = stream_emit_text(js, data, tok_start, i);
+			}
+			continue;
+		case JSON_TOK_NUMBER:
+			if (is_number_char(chr)) {
+				continue;
+			}
+
+			ret = stream_emit_text(js, data, tok_start, i);
+			if (ret < 0) {
+				continue;
+			}
+
+			/* Character after the number is processed below */
+			break;
+		case JSON_TOK_TRUE:
+		case JSON_TOK_FALSE:
+		case JSON_TOK_NULL: {
+			const char *lit = stream_literal(js->scan);
+
+			if (chr != lit[js->lit_pos]) {
+				ret = -EINVAL;
+				continue;
+			}
+
+			if (lit[++js->lit_pos] == '\0') {
+				enum json_tokens type = js->scan;
+
+				js->scan = JSON_TOK_NONE;
+				stream_value_done(js);
+				ret = stream_emit(js, type, lit, js->lit_pos);
+			}
+			continue;
+		}
+		default:
+			break;
+		}
+
+		ret = stream_structural(js, chr);
+		if (js->scan == JSON_TOK_STRING) {
+			tok_start = i + 1;
+		} else if (js->scan == JSON_TOK_NUMBER) {
+			tok_start = i;
+		}
+	}
+
+	/* Keep the part of a string or number which continues in the next
+	 * chunk.
+	 */
+	if (ret >= 0 &&
+	    (js->scan == JSON_TOK_STRING || js->scan == JSON_TOK_NUMBER)) {
+		ret = stream_append(js, &data[tok_start], len - tok_start);
+	}
+
+	if (ret < 0) {
+		js->err = ret;
+		return ret;
+	}
+
+	return 0;
+}
+
+int json_stream_finish(struct json_stream *js)
+{
+	int ret;
+
+	if (js->err < 0) {
+		return js->err;
+	}
+
+	/* A number is only terminated by the following character */
+	if (js->scan == JSON_TOK_NUMBER) {
+		ret = stream_emit_text(js, js->tok_buf, js->tok_len,
+				       js->tok_len);
+		if (ret < 0) {
+			js->err = ret;
+			return ret;
+		}
+	}
+
+	if (js->scan != JSON_TOK_NONE || js->expect != JSON_EXPECT_NOTHING) {
+		js->err = -EINVAL;
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int json_token_to_s32(const struct json_token *token, s32_t *num)
+{
+	const char *p = token->start;
+	const char *end = token->start + token->len;
+	bool neg = false;
+	s64_t val = 0;
+
+	if (token->type != JSON_TOK_NUMBER) {
+		return -EINVAL;
+	}
+
+	if (p < end && *p == '-') {
+		neg = true;
+		p++;
+	}
+
+	if (p == end) {
+		return -EINVAL;
+	}
+
+	for (; p < end; p++) {
+		if (!isdigit((unsigned char)*p)) {
+			return -EINVAL;
+		}
+
+		val = val * 10 + (*p - '0');
+		if (val > (s64_t)INT32_MAX + 1) {
+			return -ERANGE;
+		}
+	}
+
+	if (neg) {
+		val = -val;
+	}
+
+	if (val > INT32_MAX) {
+		return -ERANGE;
+	}
+
+	*num = (s32_t)val;
+
+	return 0;
+}
+
+static int obj_array_store_str(struct json_obj_array_stream *s,
+			       const struct json_token *token, char **str)
+{
+	char *dst = &s->buf[s->buf_used];
+
+	if (token->len + 1 > s->buf_size - s->buf_used) {
+		return -ENOMEM;
+	}
+
+	/* Split tokens are already assembled in place */
+	if (token->start != dst) {
+		memcpy(dst, token->start, token->len);
+	}
+	dst[token->len] = '\0';
+	*str = dst;
+
+	s->buf_used += token->len + 1;
+
+	/* Following split tokens are assembled after the stored strings */
+	s->stream.tok_buf = &s->buf[s->buf_used];
+	s->stream.tok_buf_size = s->buf_size - s->buf_used;
+
+	return 0;
+}
+
+static int obj_array_decode(struct json_obj_array_stream *s,
+			    const struct json_token *token)
+{
+	const struct json_obj_descr *descr = s->field;
+	void *field = (char *)s->val + descr->offset;
+	int ret;
+
+	if (!equivalent_types(token->type, descr->type)) {
+		return -EINVAL;
+	}
+
+	switch (descr->type) {
+	case JSON_TOK_STRING:
+		ret = obj_array_store_str(s, token, field);
+		break;
+	case JSON_TOK_NUMBER:
+		ret = json_token_to_s32(token, field);
+		break;
+	default:
+		*(bool *)field = (token->type == JSON_TOK_TRUE);
+		ret = 0;
+		break;
+	}
+
+	if (ret == 0) {
+		s->decoded |= BIT(descr - s->descr);
+	}
+
+	return ret;
+}
+
+static int obj_array_token(const struct json_token *token, void *user_data)
+{
+	struct json_obj_array_stream *s = user_data;
+	size_t i;
+
+	switch (token->depth) {
+	case 0:
+		/* The document is an array */
+		return (token->type == JSON_TOK_LIST_START ||
+			token->type == JSON_TOK_LIST_END) ? 0 : -EINVAL;
+	case 1:
+		/* Which contains objects */
+		if (token->type == JSON_TOK_OBJECT_START) {
+			s->decoded = 0;
+			s->buf_used = 0;
+			s->stream.tok_buf = s->buf;
+			s->stream.tok_buf_size = s->buf_size;
+			return 0;
+		}
+
+		if (token->type == JSON_TOK_OBJECT_END) {
+			return s->cb(s->val, s->decoded, s->user_data);
+		}
+
+		return -EINVAL;
+	case 2:
+		break;
+	default:
+		/* Values of members which are not decoded */
+		return 0;
+	}
+
+	if (token->key) {
+		s->field = NULL;
+
+		for (i = 0; i < s->descr_len; i++) {
+			if (token->len == s->descr[i].field_name_len &&
+			    !memcmp(token->start, s->descr[i].field_name,
+				    token->len)) {
+				s->field = &s->descr[i];
+				break;
+			}
+		}
+
+		return 0;
+	}
+
+	/* Members which are not in the descriptor are skipped, including
+	 * the closing token of a skipped object or array.
+	 */
+	if (s->field == NULL) {
+		return 0;
+	}
+
+	return obj_array_decode(s, token);
+}
+
+int json_obj_array_stream_init(struct json_obj_array_stream *s,
+			       const struct json_obj_descr *descr,
+			       size_t descr_len, void *val,
+			       char *buf, size_t buf_size,
+			       json_obj_cb_t cb, void *user_data)
+{
+	size_t i;
+
+	if (descr_len >= sizeof(s->decoded) * CHAR_BIT - 1) {
+		return -EINVAL;
+	}
+
+	for (i = 0; i < descr_len; i++) {
+		switch (descr[i].type) {
+		case JSON_TOK_STRING:
+		case JSON_TOK_NUMBER:
+		case JSON_TOK_TRUE:
+		case JSON_TOK_FALSE:
+			break;
+		default:
+			return -EINVAL;
+		}
+	}
+
+	*s = (struct json_obj_array_stream) {
+		.descr = descr,
+		.descr_len = descr_len,
+		.val = val,
+		.buf = buf,
+		.buf_size = buf_size,
+		.cb = cb,
+		.user_data = user_data,
+	};
+
+	json_stream_init(&s->stream, buf, buf_size, obj_array_token, s);
+
+	return 0;
+}
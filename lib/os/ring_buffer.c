@@ -21,12 +21,27 @@ struct ring_element {
 	u32_t  value  :8;  /**< Room for small integral values */
 };
 
+/* Orders the accesses to the data with the updates of the indices, so that
+ * the producer and the consumer can run concurrently, also on different
+ * CPUs. The index of the other side is read before accessing the data and
+ * the own index is written once the data has been accessed.
+ */
+static inline void index_barrier(void)
+{
+#ifdef CONFIG_SMP
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+#else
+	compiler_barrier();
+#endif
+}
+
 int ring_buf_item_put(struct ring_buf *buf, u16_t type, u8_t value,
 		      u32_t *data, u8_t size32)
 {
 	u32_t i, space, index, rc;
 
 	space = ring_buf_space_get(buf);
+	index_barrier();
 	if (space >= (size32 + 1)) {
 		struct ring_element *header =
 			(struct ring_element *)&buf->buf.buf32[buf->tail];
@@ -39,12 +54,14 @@ int ring_buf_item_put(struct ring_buf *buf, u16_t type, u8_t value,
 				index = (i + buf->tail + 1) & buf->mask;
 				buf->buf.buf32[index] = data[i];
 			}
+			index_barrier();
 			buf->tail = (buf->tail + size32 + 1) & buf->mask;
 		} else {
 			for (i = 0U; i < size32; ++i) {
 				index = (i + buf->tail + 1) % buf->size;
 				buf->buf.buf32[index] = data[i];
 			}
+			index_barrier();
 			buf->tail = (buf->tail + size32 + 1) % buf->size;
 		}
 		rc = 0U;
@@ -66,6 +83,8 @@ int ring_buf_item_get(struct ring_buf *buf, u16_t *type, u8_t *value,
 		return -EAGAIN;
 	}
 
+	index_barrier();
+
 	header = (struct ring_element *) &buf->buf.buf32[buf->head];
 
 	if (header->length > *size32) {
@@ -82,12 +101,14 @@ int ring_buf_item_get(struct ring_buf *buf, u16_t *type, u8_t *value,
 			index = (i + buf->head + 1) & buf->mask;
 			data[i] = buf->buf.buf32[index];
 		}
+		index_barrier();
 		buf->head = (buf->head + header->length + 1) & buf->mask;
 	} else {
 		for (i = 0U; i < header->length; ++i) {
 			index = (i + buf->head + 1) % buf->size;
 			data[i] = buf->buf.buf32[index];
 		}
+		index_barrier();
 		buf->head = (buf->head + header->length + 1) % buf->size;
 	}
 
@@ -112,6 +133,7 @@ u32_t ring_buf_put_claim(struct ring_buf *buf, u8_t **data, u32_t size)
 
 	space = z_ring_buf_custom_space_get(buf->size, buf->head,
 					    buf->misc.byte_mode.tmp_tail);
+	index_barrier();
 
 	/* Limit requested size to available size. */
 	size = MIN(size, space);
@@ -133,6 +155,7 @@ int ring_buf_put_finish(struct ring_buf *buf, u32_t size)
 		return -EINVAL;
 	}
 
+	index_barrier();
 	buf->tail = wrap(buf->tail + size, buf->size);
 	buf->misc.byte_mode.tmp_tail = buf->tail;
 
@@ -168,6 +191,7 @@ u32_t ring_buf_get_claim(struct ring_buf *buf, u8_t **data, u32_t size)
 		z_ring_buf_custom_space_get(buf->size,
 					    buf->misc.byte_mode.tmp_head,
 					    buf->tail);
+	index_barrier();
 	trail_size = buf->size - buf->misc.byte_mode.tmp_head;
 
 	/* Limit requested size to available size. */
@@ -191,6 +215,7 @@ int ring_buf_get_finish(struct ring_buf *buf, u32_t size)
 		return -EINVAL;
 	}
 
+	index_barrier();
 	buf->head = wrap(buf->head + size, buf->size);
 	buf->misc.byte_mode.tmp_head = buf->head;
 
@@ -217,3 +242,127 @@ u32_t ring_buf_get(struct ring_buf *buf, u8_t *data, u32_t size)
 
 	return total_size;
 }
+
+/* Reservation state of a multi-producer multi-consumer ring buffer: the
+ * reserved index in the upper bits and the number of claims in progress in
+ * the lower bits, so that both are updated with a single atomic_cas().
+ */
+#define MPMC_CLAIMS_BITS 8
+#define MPMC_CLAIMS_MAX (BIT(MPMC_CLAIMS_BITS) - 1)
+#define MPMC_IDX_MASK (BIT(32 - MPMC_CLAIMS_BITS) - 1)
+
+#define MPMC_STATE(idx, claims) \
+	((atomic_val_t)((((idx) & MPMC_IDX_MASK) << MPMC_CLAIMS_BITS) | \
+			(claims)))
+#define MPMC_STATE_IDX(state) ((u32_t)(state) >> MPMC_CLAIMS_BITS)
+#define MPMC_STATE_CLAIMS(state) ((u32_t)(state) & MPMC_CLAIMS_MAX)
+
+static inline u32_t mpmc_idx_diff(u32_t idx1, u32_t idx2)
+{
+	return (idx1 - idx2) & MPMC_IDX_MASK;
+}
+
+static u32_t mpmc_claim(struct ring_buf_mpmc *buf, bool put, u8_t **data,
+			u32_t size)
+{
+	atomic_t *state_ptr = put ? &buf->put_state : &buf->get_state;
+	u32_t buf_size = buf->mask + 1;
+	atomic_val_t state;
+	u32_t claims;
+	u32_t avail;
+	u32_t idx;
+	u32_t len;
+
+	while (true) {
+		/* Indices of the other side are read so that they are never
+		 * newer than the reservation: the head is read before the
+		 * tail reservation and the tail after the head reservation.
+		 */
+		if (put) {
+			u32_t head = atomic_get(&buf->head);
+
+			state = atomic_get(state_ptr);
+			idx = MPMC_STATE_IDX(state);
+			avail = buf_size - mpmc_idx_diff(idx, head);
+		} else {
+			state = atomic_get(state_ptr);
+			idx = MPMC_STATE_IDX(state);
+			avail = mpmc_idx_diff(atomic_get(&buf->tail), idx);
+		}
+
+		/* Head read too long before the reservation, try again. */
+		if (avail > buf_size) {
+			continue;
+		}
+
+		claims = MPMC_STATE_CLAIMS(state);
+		len = MIN(size, avail);
+		len = MIN(len, buf_size - (idx & buf->mask));
+		if (len == 0U || claims == MPMC_CLAIMS_MAX) {
+			return 0;
+		}
+
+		if (atomic_cas(state_ptr, state,
+			       MPMC_STATE(idx + len, claims + 1))) {
+			break;
+		}
+	}
+
+	*data = &buf->buf[idx & buf->mask];
+
+	return len;
+}
+
+static void mpmc_finish(atomic_t *state_ptr, atomic_t *idx_ptr)
+{
+	atomic_val_t state;
+	atomic_val_t cur;
+	u32_t idx;
+
+	do {
+		state = atomic_get(state_ptr);
+		__ASSERT_NO_MSG(MPMC_STATE_CLAIMS(state) > 0U);
+	} while (!atomic_cas(state_ptr, state, state - 1));
+
+	/* Only the last claim in progress publishes the reserved index,
+	 * everything before it has been completed.
+	 */
+	if (MPMC_STATE_CLAIMS(state - 1) != 0U) {
+		return;
+	}
+
+	/* Another context may have published a newer index in between, as
+	 * the buffer is much smaller than the index range, an older index
+	 * appears to be behind by more than half the range.
+	 */
+	idx = MPMC_STATE_IDX(state);
+	do {
+		cur = atomic_get(idx_ptr);
+		if (mpmc_idx_diff(idx, cur) == 0U ||
+		    mpmc_idx_diff(idx, cur) > (MPMC_IDX_MASK >> 1)) {
+			return;
+		}
+	} while (!atomic_cas(idx_ptr, cur, idx));
+}
+
+u32_t ring_buf_mpmc_put_claim(struct ring_buf_mpmc *buf, u8_t **data,
+			      u32_t size)
+{
+	return mpmc_claim(buf, true, data, size);
+}
+
+void ring_buf_mpmc_put_finish(struct ring_buf_mpmc *buf)
+{
+	mpmc_finish(&buf->put_state, &buf->tail);
+}
+
+u32_t ring_buf_mpmc_get_claim(struct ring_buf_mpmc *buf, u8_t **data,
+			      u32_t size)
+{
+	return mpmc_claim(buf, false, data, size);
+}
+
+void ring_buf_mpmc_get_finish(struct ring_buf_mpmc *buf)
+{
+	mpmc_finish(&buf->get_state, &buf->head);
+}
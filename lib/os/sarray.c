@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/sarray.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+static inline bool lessthan(struct sarray *sa, const void *a, const void *b)
+{
+	if (sa->lessthan_fn == NULL) {
+		return (uintptr_t)a < (uintptr_t)b;
+	}
+
+	return sa->lessthan_fn(a, b);
+}
+
+/* Index of the first element for which before() is false. The search
+ * only narrows a [lo, lo + n) range, without early exit, so that its
+ * accesses stay in a few cache lines and its branches are predictable.
+ */
+static size_t bound(struct sarray *sa, const void *elem, bool upper)
+{
+	size_t lo = 0;
+	size_t n = sa->count;
+
+	while (n > 0) {
+		size_t half = n / 2;
+		void *mid = sa->elems[lo + half];
+		bool before = upper ? !lessthan(sa, elem, mid) :
+				      lessthan(sa, mid, elem);
+
+		if (before) {
+			lo += half + 1;
+			n -= half + 1;
+		} else {
+			n = half;
+		}
+	}
+
+	return lo;
+}
+
+/* Index of the element among those which compare equal, or -1 */
+static int find(struct sarray *sa, const void *elem)
+{
+	size_t i;
+
+	for (i = bound(sa, elem, false);
+	     i < sa->count && !lessthan(sa, elem, sa->elems[i]); i++) {
+		if (sa->elems[i] == elem) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+int sarray_insert(struct sarray *sa, void *elem)
+{
+	size_t i;
+
+	if (sa->count == sa->capacity) {
+		return -ENOMEM;
+	}
+
+	i = bound(sa, elem, true);
+	memmove(&sa->elems[i + 1], &sa->elems[i],
+		(sa->count - i) * sizeof(sa->elems[0]));
+	sa->elems[i] = elem;
+	sa->count++;
+
+	return 0;
+}
+
+int sarray_remove(struct sarray *sa, void *elem)
+{
+	int i = find(sa, elem);
+
+	if (i < 0) {
+		return -ENOENT;
+	}
+
+	sa->count--;
+	memmove(&sa->elems[i], &sa->elems[i + 1],
+		(sa->count - i) * sizeof(sa->elems[0]));
+
+	return 0;
+}
+
+bool sarray_contains(struct sarray *sa, const void *elem)
+{
+	return find(sa, elem) >= 0;
+}
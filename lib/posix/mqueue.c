@@ -10,11 +10,32 @@
 #include <posix/time.h>
 #include <posix/mqueue.h>
 
+/* Message slot, the message data follows the header */
+struct mqueue_msg {
+	sys_snode_t node;
+	size_t len;
+};
+
+#define MSG_DATA(msg) ((char *)(msg) + sizeof(struct mqueue_msg))
+#define DATA_MSG(data) \
+	((struct mqueue_msg *)((char *)(data) - sizeof(struct mqueue_msg)))
+
 typedef struct mqueue_object {
 	sys_snode_t snode;
 	char *mem_buffer;
 	char *mem_obj;
-	struct k_msgq queue;
+	struct k_spinlock lock;
+	/* Queued messages are kept in one FIFO per priority, with a bitmap
+	 * of the non-empty FIFOs, so both send and receive are O(1).
+	 */
+	sys_slist_t free_msgs;
+	sys_slist_t prio_msgs[CONFIG_MQUEUE_PRIO_MAX];
+	u32_t prio_bitmap;
+	struct k_sem free_sem;
+	struct k_sem used_sem;
+	long msg_size;
+	long max_msgs;
+	long used_msgs;
 	atomic_t ref_count;
 	char *name;
 } mqueue_object;
@@ -33,10 +54,17 @@ sys_slist_t mq_list = SYS_SLIST_STATIC_INIT(&mq_list);
 s64_t timespec_to_timeoutms(const struct timespec *abstime);
 static mqueue_object *find_in_list(const char *name);
 static s32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
-			  s32_t timeout);
+			  unsigned int msg_prio, s32_t timeout);
 static int receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
-			   s32_t timeout);
+			   unsigned int *msg_prio, s32_t timeout);
 static void remove_mq(mqueue_object *msg_queue);
+static s32_t wait_timeout(mqueue_desc *mqd, s32_t timeout);
+static struct mqueue_msg *msg_alloc(mqueue_object *mq, s32_t timeout);
+static void msg_free(mqueue_object *mq, struct mqueue_msg *msg);
+static void msg_put(mqueue_object *mq, struct mqueue_msg *msg,
+		    unsigned int msg_prio);
+static struct mqueue_msg *msg_get(mqueue_object *mq, unsigned int *msg_prio,
+				  s32_t timeout);
 
 /**
  * @brief Open a message queue.
@@ -55,6 +83,7 @@ mqd_t mq_open(const char *name, int oflags, ...)
 	mqueue_object *msg_queue;
 	mqueue_desc *msg_queue_desc = NULL, *mqd = (mqueue_desc *)(-1);
 	char *mq_desc_ptr, *mq_obj_ptr, *mq_buf_ptr, *mq_name_ptr;
+	size_t slot_size;
 
 	va_start(va, oflags);
 	if ((oflags & O_CREAT) != 0) {
@@ -136,19 +165,26 @@ mqd_t mq_open(const char *name, int oflags, ...)
 
 		strcpy(msg_queue->name, name);
 
-		mq_buf_ptr = k_malloc(msg_size * max_msgs * sizeof(u8_t));
+		slot_size = ROUND_UP(sizeof(struct mqueue_msg) + msg_size,
+				     sizeof(void *));
+		mq_buf_ptr = k_malloc(slot_size * max_msgs);
 		if (mq_buf_ptr != NULL) {
-			(void)memset(mq_buf_ptr, 0,
-				     msg_size * max_msgs * sizeof(u8_t));
 			msg_queue->mem_buffer = mq_buf_ptr;
 		} else {
 			goto free_mq_buffer;
 		}
 
+		for (long i = 0; i < max_msgs; i++) {
+			sys_slist_append(&msg_queue->free_msgs,
+				(sys_snode_t *)&mq_buf_ptr[i * slot_size]);
+		}
+
+		msg_queue->msg_size = msg_size;
+		msg_queue->max_msgs = max_msgs;
+		k_sem_init(&msg_queue->free_sem, max_msgs, max_msgs);
+		k_sem_init(&msg_queue->used_sem, 0, max_msgs);
+
 		(void)atomic_set(&msg_queue->ref_count, 1);
-		/* initialize zephyr message queue */
-		k_msgq_init(&msg_queue->queue, msg_queue->mem_buffer, msg_size,
-			    max_msgs);
 		k_sem_take(&mq_sem, K_FOREVER);
 		sys_slist_append(&mq_list, (sys_snode_t *)&(msg_queue->snode));
 		k_sem_give(&mq_sem);
@@ -225,7 +261,8 @@ int mq_unlink(const char *name)
 /**
  * @brief Send a message to a message queue.
  *
- * All messages in message queue are of equal priority.
+ * Messages are received by decreasing priority, and in FIFO order within
+ * a priority. Priority must be lower than CONFIG_MQUEUE_PRIO_MAX.
  *
  * See IEEE 1003.1
  */
@@ -235,14 +272,12 @@ int mq_send(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 	s32_t  timeout = K_FOREVER;
 
-	return send_message(mqd, msg_ptr, msg_len, timeout);
+	return send_message(mqd, msg_ptr, msg_len, msg_prio, timeout);
 }
 
 /**
  * @brief Send message to a message queue within abstime time.
  *
- * All messages in message queue are of equal priority.
- *
  * See IEEE 1003.1
  */
 int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
@@ -252,13 +287,13 @@ int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 	s32_t  timeout;
 
 	timeout = (s32_t) timespec_to_timeoutms(abstime);
-	return send_message(mqd, msg_ptr, msg_len, timeout);
+	return send_message(mqd, msg_ptr, msg_len, msg_prio, timeout);
 }
 
 /**
  * @brief Receive a message from a message queue.
  *
- * All messages in message queue are of equal priority.
+ * The oldest message of the highest priority is received.
  *
  * See IEEE 1003.1
  */
@@ -268,15 +303,12 @@ int mq_receive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 	s32_t  timeout = K_FOREVER;
 
-	return receive_message(mqd, msg_ptr, msg_len, timeout);
-
+	return receive_message(mqd, msg_ptr, msg_len, msg_prio, timeout);
 }
 
 /**
  * @brief Receive message from a message queue within abstime time.
  *
- * All messages in message queue are of equal priority.
- *
  * See IEEE 1003.1
  */
 int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
@@ -286,7 +318,7 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 	s32_t  timeout = K_NO_WAIT;
 
 	timeout = (s32_t) timespec_to_timeoutms(abstime);
-	return receive_message(mqd, msg_ptr, msg_len, timeout);
+	return receive_message(mqd, msg_ptr, msg_len, msg_prio, timeout);
 }
 
 /**
@@ -297,7 +329,6 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 int mq_getattr(mqd_t mqdes, struct mq_attr *mqstat)
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
-	struct k_msgq_attrs attrs;
 
 	if (mqd == NULL) {
 		errno = EBADF;
@@ -305,11 +336,10 @@ int mq_getattr(mqd_t mqdes, struct mq_attr *mqstat)
 	}
 
 	k_sem_take(&mq_sem, K_FOREVER);
-	k_msgq_get_attrs(&mqd->mqueue->queue, &attrs);
 	mqstat->mq_flags = mqd->flags;
-	mqstat->mq_maxmsg = attrs.max_msgs;
-	mqstat->mq_msgsize = attrs.msg_size;
-	mqstat->mq_curmsgs = attrs.used_msgs;
+	mqstat->mq_maxmsg = mqd->mqueue->max_msgs;
+	mqstat->mq_msgsize = mqd->mqueue->msg_size;
+	mqstat->mq_curmsgs = mqd->mqueue->used_msgs;
 	k_sem_give(&mq_sem);
 	return 0;
 }
@@ -345,6 +375,114 @@ int mq_setattr(mqd_t mqdes, const struct mq_attr *mqstat,
 	return 0;
 }
 
+/**
+ * @brief Allocate a message buffer from a message queue.
+ *
+ * Zephyr extension for zero-copy messaging. The buffer of mq_msgsize bytes
+ * is owned by the queue and must be either sent with mq_send_np() or
+ * released with mq_free_np(). Waits for a free buffer unless the
+ * descriptor is non-blocking.
+ *
+ * @return Message buffer, NULL with errno set otherwise.
+ */
+char *mq_alloc_np(mqd_t mqdes)
+{
+	mqueue_desc *mqd = (mqueue_desc *)mqdes;
+	struct mqueue_msg *msg;
+
+	if (mqd == NULL) {
+		errno = EBADF;
+		return NULL;
+	}
+
+	msg = msg_alloc(mqd->mqueue, wait_timeout(mqd, K_FOREVER));
+
+	return (msg != NULL) ? MSG_DATA(msg) : NULL;
+}
+
+/**
+ * @brief Send a message buffer allocated with mq_alloc_np().
+ *
+ * Zephyr extension for zero-copy messaging. The buffer is queued without
+ * copying and must not be accessed by the sender anymore. Never blocks.
+ *
+ * @return 0 on success, -1 with errno set otherwise.
+ */
+int mq_send_np(mqd_t mqdes, char *msg_ptr, size_t msg_len,
+	       unsigned int msg_prio)
+{
+	mqueue_desc *mqd = (mqueue_desc *)mqdes;
+
+	if (mqd == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (msg_len > mqd->mqueue->msg_size) {
+		errno = EMSGSIZE;
+		return -1;
+	}
+
+	if (msg_prio >= CONFIG_MQUEUE_PRIO_MAX) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	DATA_MSG(msg_ptr)->len = msg_len;
+	msg_put(mqd->mqueue, DATA_MSG(msg_ptr), msg_prio);
+
+	return 0;
+}
+
+/**
+ * @brief Receive a message without copying it.
+ *
+ * Zephyr extension for zero-copy messaging. The message is dequeued as with
+ * mq_receive() but left in its buffer, which must be released with
+ * mq_free_np() once processed.
+ *
+ * @return Length of the message, -1 with errno set otherwise.
+ */
+ssize_t mq_receive_np(mqd_t mqdes, char **msg_ptr, unsigned int *msg_prio)
+{
+	mqueue_desc *mqd = (mqueue_desc *)mqdes;
+	struct mqueue_msg *msg;
+
+	if (mqd == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	msg = msg_get(mqd->mqueue, msg_prio, wait_timeout(mqd, K_FOREVER));
+	if (msg == NULL) {
+		return -1;
+	}
+
+	*msg_ptr = MSG_DATA(msg);
+	return msg->len;
+}
+
+/**
+ * @brief Release a message buffer.
+ *
+ * Zephyr extension for zero-copy messaging, releases a buffer obtained
+ * with mq_alloc_np() or mq_receive_np().
+ *
+ * @return 0 on success, -1 with errno set otherwise.
+ */
+int mq_free_np(mqd_t mqdes, char *msg_ptr)
+{
+	mqueue_desc *mqd = (mqueue_desc *)mqdes;
+
+	if (mqd == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	msg_free(mqd->mqueue, DATA_MSG(msg_ptr));
+	return 0;
+}
+
 /* Internal functions */
 static mqueue_object *find_in_list(const char *name)
 {
@@ -365,9 +503,83 @@ static mqueue_object *find_in_list(const char *name)
 	return NULL;
 }
 
+static s32_t wait_timeout(mqueue_desc *mqd, s32_t timeout)
+{
+	return ((mqd->flags & O_NONBLOCK) != 0U) ? K_NO_WAIT : timeout;
+}
+
+static struct mqueue_msg *msg_alloc(mqueue_object *mq, s32_t timeout)
+{
+	struct mqueue_msg *msg;
+	k_spinlock_key_t key;
+
+	if (k_sem_take(&mq->free_sem, timeout) != 0) {
+		errno = (timeout == K_NO_WAIT) ? EAGAIN : ETIMEDOUT;
+		return NULL;
+	}
+
+	key = k_spin_lock(&mq->lock);
+	msg = (struct mqueue_msg *)sys_slist_get_not_empty(&mq->free_msgs);
+	k_spin_unlock(&mq->lock, key);
+
+	return msg;
+}
+
+static void msg_free(mqueue_object *mq, struct mqueue_msg *msg)
+{
+	k_spinlock_key_t key = k_spin_lock(&mq->lock);
+
+	sys_slist_prepend(&mq->free_msgs, &msg->node);
+	k_spin_unlock(&mq->lock, key);
+	k_sem_give(&mq->free_sem);
+}
+
+static void msg_put(mqueue_object *mq, struct mqueue_msg *msg,
+		    unsigned int msg_prio)
+{
+	k_spinlock_key_t key = k_spin_lock(&mq->lock);
+
+	sys_slist_append(&mq->prio_msgs[msg_prio], &msg->node);
+	mq->prio_bitmap |= BIT(msg_prio);
+	mq->used_msgs++;
+	k_spin_unlock(&mq->lock, key);
+	k_sem_give(&mq->used_sem);
+}
+
+static struct mqueue_msg *msg_get(mqueue_object *mq, unsigned int *msg_prio,
+				  s32_t timeout)
+{
+	struct mqueue_msg *msg;
+	k_spinlock_key_t key;
+	unsigned int prio;
+
+	if (k_sem_take(&mq->used_sem, timeout) != 0) {
+		errno = (timeout == K_NO_WAIT) ? EAGAIN : ETIMEDOUT;
+		return NULL;
+	}
+
+	/* used_sem guarantees that at least one FIFO is not empty */
+	key = k_spin_lock(&mq->lock);
+	prio = find_msb_set(mq->prio_bitmap) - 1;
+	msg = (struct mqueue_msg *)sys_slist_get_not_empty(
+							&mq->prio_msgs[prio]);
+	if (sys_slist_is_empty(&mq->prio_msgs[prio])) {
+		mq->prio_bitmap &= ~BIT(prio);
+	}
+	mq->used_msgs--;
+	k_spin_unlock(&mq->lock, key);
+
+	if (msg_prio != NULL) {
+		*msg_prio = prio;
+	}
+
+	return msg;
+}
+
 static s32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
-			  s32_t timeout)
+			  unsigned int msg_prio, s32_t timeout)
 {
+	struct mqueue_msg *msg;
 	s32_t ret = -1;
 
 	if (mqd == NULL) {
@@ -375,26 +587,32 @@ static s32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
 		return ret;
 	}
 
-	if ((mqd->flags & O_NONBLOCK) != 0U) {
-		timeout = K_NO_WAIT;
+	if (msg_len >  mqd->mqueue->msg_size) {
+		errno = EMSGSIZE;
+		return ret;
 	}
 
-	if (msg_len >  mqd->mqueue->queue.msg_size) {
-		errno = EMSGSIZE;
+	if (msg_prio >= CONFIG_MQUEUE_PRIO_MAX) {
+		errno = EINVAL;
 		return ret;
 	}
 
-	if (k_msgq_put(&mqd->mqueue->queue, (void *)msg_ptr, timeout) != 0) {
-		errno = (timeout == K_NO_WAIT) ?   EAGAIN : ETIMEDOUT;
+	msg = msg_alloc(mqd->mqueue, wait_timeout(mqd, timeout));
+	if (msg == NULL) {
 		return ret;
 	}
 
+	(void)memcpy(MSG_DATA(msg), msg_ptr, msg_len);
+	msg->len = msg_len;
+	msg_put(mqd->mqueue, msg, msg_prio);
+
 	return 0;
 }
 
 static s32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
-			     s32_t timeout)
+			     unsigned int *msg_prio, s32_t timeout)
 {
+	struct mqueue_msg *msg;
 	int ret = -1;
 
 	if (mqd == NULL) {
@@ -402,20 +620,19 @@ static s32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
 		return ret;
 	}
 
-	if (msg_len < mqd->mqueue->queue.msg_size) {
+	if (msg_len < mqd->mqueue->msg_size) {
 		errno = EMSGSIZE;
 		return ret;
 	}
 
-	if ((mqd->flags & O_NONBLOCK) != 0U) {
-		timeout = K_NO_WAIT;
+	msg = msg_get(mqd->mqueue, msg_prio, wait_timeout(mqd, timeout));
+	if (msg == NULL) {
+		return ret;
 	}
 
-	if (k_msgq_get(&mqd->mqueue->queue, (void *)msg_ptr, timeout) != 0) {
-		errno = (timeout != K_NO_WAIT) ? ETIMEDOUT : EAGAIN;
-	} else {
-		ret = mqd->mqueue->queue.msg_size;
-	}
+	(void)memcpy(msg_ptr, MSG_DATA(msg), msg->len);
+	ret = msg->len;
+	msg_free(mqd->mqueue, msg);
 
 	return ret;
 }
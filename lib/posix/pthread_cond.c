@@ -10,6 +10,7 @@
 #include <posix/pthread.h>
 
 s64_t timespec_to_timeoutms(const struct timespec *abstime);
+void z_pthread_mutex_release_irqlocked(pthread_mutex_t *m);
 
 static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut, int timeout)
 {
@@ -17,9 +18,7 @@ static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut, int timeout)
 
 	int ret, key = irq_lock();
 
-	mut->lock_count = 0U;
-	mut->owner = NULL;
-	_ready_one_thread(&mut->wait_q);
+	z_pthread_mutex_release_irqlocked(mut);
 	ret = z_pend_curr_irqlock(key, &cv->wait_q, timeout);
 
 	/* FIXME: this extra lock (and the potential context switch it
@@ -50,7 +49,7 @@ int pthread_cond_signal(pthread_cond_t *cv)
 {
 	int key = irq_lock();
 
-	_ready_one_thread(&cv->wait_q);
+	(void)z_unpend_ready_n(&cv->wait_q, 1, 0);
 	z_reschedule_irqlock(key);
 
 	return 0;
@@ -60,10 +59,7 @@ int pthread_cond_broadcast(pthread_cond_t *cv)
 {
 	int key = irq_lock();
 
-	while (z_waitq_head(&cv->wait_q)) {
-		_ready_one_thread(&cv->wait_q);
-	}
-
+	(void)z_unpend_ready_n(&cv->wait_q, -1, 0);
 	z_reschedule_irqlock(key);
 
 	return 0;
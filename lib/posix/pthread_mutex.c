@@ -20,17 +20,26 @@ static const pthread_mutexattr_t def_attr = {
 	.type = PTHREAD_MUTEX_DEFAULT,
 };
 
+/* Lock state. An uncontended mutex is taken and released with a single
+ * atomic operation, the kernel is only entered to wait for the mutex or to
+ * wake up a waiting thread.
+ */
+#define MUTEX_UNLOCKED 0
+#define MUTEX_LOCKED 1
+#define MUTEX_CONTENDED 2 /* Locked, threads may be waiting */
+
 static int acquire_mutex(pthread_mutex_t *m, int timeout)
 {
-	int rc = 0, key = irq_lock();
+	unsigned int key;
+	s64_t end;
+	int rc;
 
-	if (m->lock_count == 0U && m->owner == NULL) {
-		m->lock_count++;
-		m->owner = pthread_self();
+	if (atomic_cas(&m->state, MUTEX_UNLOCKED, MUTEX_LOCKED)) {
+		goto locked;
+	}
 
-		irq_unlock(key);
-		return 0;
-	} else if (m->owner == pthread_self()) {
+	/* Only the owner itself can find itself as the owner */
+	if (m->owner == pthread_self()) {
 		if (m->type == PTHREAD_MUTEX_RECURSIVE &&
 		    m->lock_count < MUTEX_MAX_REC_LOCK) {
 			m->lock_count++;
@@ -41,21 +50,53 @@ static int acquire_mutex(pthread_mutex_t *m, int timeout)
 			rc = EINVAL;
 		}
 
-		irq_unlock(key);
 		return rc;
 	}
 
 	if (timeout == K_NO_WAIT) {
-		irq_unlock(key);
 		return EINVAL;
 	}
 
-	rc = z_pend_curr_irqlock(key, &m->wait_q, timeout);
-	if (rc != 0) {
-		rc = ETIMEDOUT;
+	end = k_uptime_get() + timeout;
+
+	/* The mutex is flagged as contended before checking it a last time,
+	 * so that its owner wakes us up when unlocking it.
+	 */
+	key = irq_lock();
+	while (atomic_set(&m->state, MUTEX_CONTENDED) != MUTEX_UNLOCKED) {
+		rc = z_pend_curr_irqlock(key, &m->wait_q, timeout);
+		if (rc != 0) {
+			return ETIMEDOUT;
+		}
+
+		/* Woken up but another thread took the mutex first */
+		if (timeout != K_FOREVER) {
+			timeout = MAX(end - k_uptime_get(), K_NO_WAIT);
+		}
+
+		key = irq_lock();
 	}
+	irq_unlock(key);
+
+locked:
+	m->owner = pthread_self();
+	m->lock_count = 1U;
+
+	return 0;
+}
+
+/* Releases a mutex locked once by the current thread and readies a waiting
+ * thread if any, without rescheduling. Used by condition variables, must be
+ * called with interrupts locked.
+ */
+void z_pthread_mutex_release_irqlocked(pthread_mutex_t *m)
+{
+	m->lock_count = 0U;
+	m->owner = NULL;
 
-	return rc;
+	if (atomic_set(&m->state, MUTEX_UNLOCKED) == MUTEX_CONTENDED) {
+		(void)z_unpend_ready_n(&m->wait_q, 1, 0);
+	}
 }
 
 /**
@@ -93,6 +134,7 @@ int pthread_mutex_init(pthread_mutex_t *m,
 
 	m->owner = NULL;
 	m->lock_count = 0U;
+	atomic_clear(&m->state);
 
 	mattr = (attr == NULL) ? &def_attr : attr;
 
@@ -121,36 +163,30 @@ int pthread_mutex_lock(pthread_mutex_t *m)
  */
 int pthread_mutex_unlock(pthread_mutex_t *m)
 {
-	unsigned int key = irq_lock();
-
-	k_tid_t thread;
+	unsigned int key;
 
 	if (m->owner != pthread_self()) {
-		irq_unlock(key);
 		return EPERM;
 	}
 
 	if (m->lock_count == 0U) {
-		irq_unlock(key);
 		return EINVAL;
 	}
 
-	m->lock_count--;
+	if (m->lock_count > 1U) {
+		m->lock_count--;
+		return 0;
+	}
 
-	if (m->lock_count == 0U) {
-		thread = z_unpend_first_thread(&m->wait_q);
-		if (thread) {
-			m->owner = (pthread_t)thread;
-			m->lock_count++;
-			z_ready_thread(thread);
-			arch_thread_return_value_set(thread, 0);
-			z_reschedule_irqlock(key);
-			return 0;
-		}
-		m->owner = NULL;
+	m->lock_count = 0U;
+	m->owner = NULL;
 
+	if (atomic_set(&m->state, MUTEX_UNLOCKED) == MUTEX_CONTENDED) {
+		key = irq_lock();
+		(void)z_unpend_ready_n(&m->wait_q, 1, 0);
+		z_reschedule_irqlock(key);
 	}
-	irq_unlock(key);
+
 	return 0;
 }
 
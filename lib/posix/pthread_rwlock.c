@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <kernel.h>
+#include <ksched.h>
+#include <wait_q.h>
 #include <errno.h>
 #include <posix/time.h>
 #include <posix/posix_types.h>
@@ -11,7 +13,16 @@
 #define INITIALIZED 1
 #define NOT_INITIALIZED 0
 
-#define CONCURRENT_READER_LIMIT  (CONFIG_MAX_PTHREAD_COUNT + 1)
+/* Lock state. Uncontended locks are taken and released with atomic
+ * operations on the state only, the kernel is entered when a thread has to
+ * wait and to wake up the waiting threads.
+ */
+#define RW_WRITER BIT(30)
+#define RW_WAITERS BIT(29)
+/* A writer waits: new readers back off so that it is not starved */
+#define RW_WRITER_WAITING BIT(28)
+#define RW_READERS_MASK (RW_WRITER_WAITING - 1)
+#define RW_WAIT_FLAGS (RW_WAITERS | RW_WRITER_WAITING)
 
 s64_t timespec_to_timeoutms(const struct timespec *abstime);
 static u32_t read_lock_acquire(pthread_rwlock_t *rwlock, s32_t timeout);
@@ -25,10 +36,8 @@ static u32_t write_lock_acquire(pthread_rwlock_t *rwlock, s32_t timeout);
 int pthread_rwlock_init(pthread_rwlock_t *rwlock,
 			const pthread_rwlockattr_t *attr)
 {
-	k_sem_init(&rwlock->rd_sem, CONCURRENT_READER_LIMIT,
-		   CONCURRENT_READER_LIMIT);
-	k_sem_init(&rwlock->wr_sem, 1, 1);
-	k_sem_init(&rwlock->reader_active, 1, 1);
+	atomic_clear(&rwlock->state);
+	z_waitq_init(&rwlock->wait_q);
 	rwlock->wr_owner = NULL;
 	rwlock->status = INITIALIZED;
 	return 0;
@@ -60,8 +69,7 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for reading.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
+ * Readers which do not wait yet give way to waiting writers.
  *
  * See IEEE 1003.1
  */
@@ -77,8 +85,7 @@ int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for reading within specific time.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
+ * Readers which do not wait yet give way to waiting writers.
  *
  * See IEEE 1003.1
  */
@@ -105,8 +112,7 @@ int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
 /**
  * @brief Lock a read-write lock object for reading immedately.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
+ * Readers which do not wait yet give way to waiting writers.
  *
  * See IEEE 1003.1
  */
@@ -122,8 +128,7 @@ int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for writing.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * Waiting readers and writers get the lock based on priority.
  *
  * See IEEE 1003.1
  */
@@ -139,8 +144,7 @@ int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for writing within specific time.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * Waiting readers and writers get the lock based on priority.
  *
  * See IEEE 1003.1
  */
@@ -167,8 +171,7 @@ int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
 /**
  * @brief Lock a read-write lock object for writing immedately.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * Waiting readers and writers get the lock based on priority.
  *
  * See IEEE 1003.1
  */
@@ -189,6 +192,9 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
  */
 int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
 {
+	atomic_val_t state;
+	unsigned int key;
+
 	if (rwlock->status == NOT_INITIALIZED) {
 		return EINVAL;
 	}
@@ -196,60 +202,126 @@ int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
 	if (k_current_get() == rwlock->wr_owner) {
 		/* Write unlock */
 		rwlock->wr_owner = NULL;
-		k_sem_give(&rwlock->reader_active);
-		k_sem_give(&rwlock->wr_sem);
+		state = atomic_and(&rwlock->state, ~RW_WRITER) & ~RW_WRITER;
 	} else {
 		/* Read unlock */
-		if (k_sem_count_get(&rwlock->rd_sem) ==
-				    (CONCURRENT_READER_LIMIT - 1)) {
-			/* Last read lock, unlock writer */
-			k_sem_give(&rwlock->reader_active);
+		if ((atomic_get(&rwlock->state) & RW_READERS_MASK) == 0) {
+			return EPERM;
 		}
 
-		k_sem_give(&rwlock->rd_sem);
+		state = atomic_dec(&rwlock->state) - 1;
+	}
+
+	/* Last holder wakes up all the waiting threads, which then compete
+	 * for the lock again.
+	 */
+	if ((state & ~RW_WRITER_WAITING) == RW_WAITERS) {
+		key = irq_lock();
+		atomic_and(&rwlock->state, ~RW_WAIT_FLAGS);
+		(void)z_unpend_ready_n(&rwlock->wait_q, -1, 0);
+		z_reschedule_irqlock(key);
 	}
+
 	return 0;
 }
 
+/* Takes the lock for reading unless one of the busy flags is set */
+static bool read_trylock(pthread_rwlock_t *rwlock, atomic_val_t busy)
+{
+	atomic_val_t state;
 
-static u32_t read_lock_acquire(pthread_rwlock_t *rwlock, s32_t timeout)
+	do {
+		state = atomic_get(&rwlock->state);
+		if ((state & busy) != 0) {
+			return false;
+		}
+	} while (!atomic_cas(&rwlock->state, state, state + 1));
+
+	return true;
+}
+
+static bool write_trylock(pthread_rwlock_t *rwlock)
 {
-	u32_t ret = 0U;
+	atomic_val_t state;
 
-	if (k_sem_take(&rwlock->wr_sem, timeout) == 0) {
-		k_sem_take(&rwlock->reader_active, K_NO_WAIT);
-		k_sem_take(&rwlock->rd_sem, K_NO_WAIT);
-		k_sem_give(&rwlock->wr_sem);
-	} else {
-		ret = EBUSY;
-	}
+	do {
+		state = atomic_get(&rwlock->state);
+		if ((state & ~RW_WAIT_FLAGS) != 0) {
+			return false;
+		}
+	} while (!atomic_cas(&rwlock->state, state, state | RW_WRITER));
 
-	return ret;
+	return true;
 }
 
-static u32_t write_lock_acquire(pthread_rwlock_t *rwlock, s32_t timeout)
+static u32_t lock_wait(pthread_rwlock_t *rwlock, bool write, s32_t timeout)
 {
-	u32_t ret = 0U;
-	s64_t elapsed_time, st_time = k_uptime_get();
-
-	/* waiting for release of write lock */
-	if (k_sem_take(&rwlock->wr_sem, timeout) == 0) {
-		if (timeout > K_NO_WAIT) {
-			elapsed_time = k_uptime_get() - st_time;
-			timeout = timeout <= elapsed_time ? K_NO_WAIT :
-				  timeout - elapsed_time;
+	atomic_val_t busy = write ? ~RW_WAIT_FLAGS :
+				    RW_WRITER | RW_WRITER_WAITING;
+	atomic_val_t flags = write ? RW_WAIT_FLAGS : RW_WAITERS;
+	s64_t end = k_uptime_get() + timeout;
+	atomic_val_t state;
+	unsigned int key;
+
+	key = irq_lock();
+
+	while (!(write ? write_trylock(rwlock) :
+			 read_trylock(rwlock, busy))) {
+		if (timeout == K_NO_WAIT) {
+			irq_unlock(key);
+			return EBUSY;
 		}
 
-		/* waiting for reader to complete operation */
-		if (k_sem_take(&rwlock->reader_active, timeout) == 0) {
-			rwlock->wr_owner = k_current_get();
-		} else {
-			k_sem_give(&rwlock->wr_sem);
-			ret = EBUSY;
+		/* Waiters are flagged only if the lock is still busy, the
+		 * thread releasing it then wakes us up.
+		 */
+		state = atomic_get(&rwlock->state);
+		if ((state & busy) == 0 ||
+		    !atomic_cas(&rwlock->state, state, state | flags)) {
+			continue;
 		}
 
+		if (z_pend_curr_irqlock(key, &rwlock->wait_q, timeout) != 0) {
+			return EBUSY;
+		}
+
+		if (timeout != K_FOREVER) {
+			timeout = MAX(end - k_uptime_get(), K_NO_WAIT);
+		}
+
+		key = irq_lock();
+	}
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+static u32_t read_lock_acquire(pthread_rwlock_t *rwlock, s32_t timeout)
+{
+	/* Fast path, also backs off when a writer is waiting so that it
+	 * is not starved by a continuous flow of readers.
+	 */
+	if (read_trylock(rwlock, RW_WRITER | RW_WRITER_WAITING)) {
+		return 0;
+	}
+
+	return lock_wait(rwlock, false, timeout);
+}
+
+static u32_t write_lock_acquire(pthread_rwlock_t *rwlock, s32_t timeout)
+{
+	u32_t ret;
+
+	if (atomic_cas(&rwlock->state, 0, RW_WRITER)) {
+		ret = 0U;
 	} else {
-		ret = EBUSY;
+		ret = lock_wait(rwlock, true, timeout);
 	}
+
+	if (ret == 0U) {
+		rwlock->wr_owner = k_current_get();
+	}
+
 	return ret;
 }
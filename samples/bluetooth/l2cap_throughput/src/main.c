@@ -0,0 +1,209 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/types.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/printk.h>
+#include <zephyr.h>
+
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/hci.h>
+#include <bluetooth/conn.h>
+#include <bluetooth/l2cap.h>
+
+#define PSM		0x0080
+#define SDU_LEN		240
+
+/* Room for the SDU length, so that a single segment SDU is not copied */
+#define SDU_RESERVE	(BT_L2CAP_CHAN_SEND_RESERVE + 2)
+
+/* SDUs queued on the channel at the same time */
+#define SDU_IN_FLIGHT	4
+
+NET_BUF_POOL_DEFINE(tx_pool, SDU_IN_FLIGHT, SDU_RESERVE + SDU_LEN,
+		    BT_BUF_USER_DATA_MIN, NULL);
+NET_BUF_POOL_DEFINE(rx_pool, 1, CONFIG_BT_L2CAP_RX_MTU, BT_BUF_USER_DATA_MIN,
+		    NULL);
+
+static struct bt_l2cap_le_chan le_chan;
+static K_SEM_DEFINE(tx_sem, SDU_IN_FLIGHT, SDU_IN_FLIGHT);
+static K_SEM_DEFINE(connected_sem, 0, 1);
+static bool chan_connected;
+static u16_t sdu_len;
+
+static u32_t tx_bytes;
+static u32_t rx_bytes;
+
+static const struct bt_data ad[] = {
+	BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
+};
+
+static struct net_buf *chan_alloc_buf(struct bt_l2cap_chan *chan)
+{
+	return net_buf_alloc(&rx_pool, K_FOREVER);
+}
+
+static int chan_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
+{
+	rx_bytes += net_buf_frags_len(buf);
+
+	return 0;
+}
+
+static void chan_sent(struct bt_l2cap_chan *chan)
+{
+	tx_bytes += sdu_len;
+
+	k_sem_give(&tx_sem);
+}
+
+static void chan_connected_cb(struct bt_l2cap_chan *chan)
+{
+	printk("Channel connected, tx mtu %u mps %u\n",
+	       le_chan.tx.mtu, le_chan.tx.mps);
+
+	sdu_len = MIN(SDU_LEN, le_chan.tx.mtu);
+	chan_connected = true;
+	k_sem_give(&connected_sem);
+}
+
+static void chan_disconnected_cb(struct bt_l2cap_chan *chan)
+{
+	printk("Channel disconnected\n");
+
+	chan_connected = false;
+
+	/* Unblock the sender */
+	k_sem_give(&tx_sem);
+}
+
+static struct bt_l2cap_chan_ops chan_ops = {
+	.alloc_buf	= chan_alloc_buf,
+	.recv		= chan_recv,
+	.sent		= chan_sent,
+	.connected	= chan_connected_cb,
+	.disconnected	= chan_disconnected_cb,
+};
+
+static int server_accept(struct bt_conn *conn, struct bt_l2cap_chan **chan)
+{
+	if (le_chan.chan.conn) {
+		return -ENOMEM;
+	}
+
+	(void)memset(&le_chan, 0, sizeof(le_chan));
+	le_chan.chan.ops = &chan_ops;
+	le_chan.rx.mtu = CONFIG_BT_L2CAP_RX_MTU;
+
+	*chan = &le_chan.chan;
+
+	return 0;
+}
+
+static struct bt_l2cap_server server = {
+	.psm		= PSM,
+	.sec_level	= BT_SECURITY_L1,
+	.accept		= server_accept,
+};
+
+static void connected(struct bt_conn *conn, u8_t err)
+{
+	if (err) {
+		printk("Connection failed (err 0x%02x)\n", err);
+	} else {
+		printk("Connected\n");
+	}
+}
+
+static void disconnected(struct bt_conn *conn, u8_t reason)
+{
+	printk("Disconnected (reason 0x%02x)\n", reason);
+}
+
+static struct bt_conn_cb conn_callbacks = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+static void report(struct k_timer *timer)
+{
+	printk("tx %u bps rx %u bps\n", tx_bytes * 8U, rx_bytes * 8U);
+
+	tx_bytes = 0U;
+	rx_bytes = 0U;
+}
+
+static K_TIMER_DEFINE(report_timer, report, NULL);
+
+static void send_loop(void)
+{
+	struct net_buf *buf;
+	int err;
+
+	while (chan_connected) {
+		k_sem_take(&tx_sem, K_FOREVER);
+
+		if (!chan_connected) {
+			break;
+		}
+
+		buf = net_buf_alloc(&tx_pool, K_FOREVER);
+		net_buf_reserve(buf, SDU_RESERVE);
+		(void)memset(net_buf_add(buf, sdu_len), 0xa5, sdu_len);
+
+		/* Queued behind the SDUs still in flight */
+		err = bt_l2cap_chan_send(&le_chan.chan, buf);
+		if (err < 0) {
+			printk("Unable to send (err %d)\n", err);
+			net_buf_unref(buf);
+			k_sem_give(&tx_sem);
+			k_sleep(K_MSEC(100));
+		}
+	}
+}
+
+void main(void)
+{
+	int err;
+
+	err = bt_enable(NULL);
+	if (err) {
+		printk("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	printk("Bluetooth initialized\n");
+
+	bt_conn_cb_register(&conn_callbacks);
+
+	err = bt_l2cap_server_register(&server);
+	if (err) {
+		printk("Unable to register server (err %d)\n", err);
+		return;
+	}
+
+	err = bt_le_adv_start(BT_LE_ADV_CONN_NAME, ad, ARRAY_SIZE(ad), NULL, 0);
+	if (err) {
+		printk("Advertising failed to start (err %d)\n", err);
+		return;
+	}
+
+	printk("Advertising successfully started\n");
+
+	k_timer_start(&report_timer, K_SECONDS(1), K_SECONDS(1));
+
+	while (1) {
+		k_sem_take(&connected_sem, K_FOREVER);
+
+		k_sem_init(&tx_sem, SDU_IN_FLIGHT, SDU_IN_FLIGHT);
+
+		send_loop();
+	}
+}
@@ -21,6 +21,13 @@
 # ignored.
 # NOTE: multiple regions can be appended together like SRAM2_DATA_BSS
 # this will place data and bss inside SRAM2
+# Single functions can also be relocated, by listing them in a file given
+# with -f, one per line. Each line is the function name, optionally
+# prefixed by the memory region as in ITCM:z_arm_pendsv, else the region
+# given with -r is used. Anything after the name, like the sample count
+# of a profiler report, is ignored, as is anything after a '#'. Only the
+# .text.<function> section of the objects, as emitted with
+# -ffunction-sections, is relocated.
 
 import sys
 import argparse
@@ -172,6 +179,31 @@ def find_sections(filename, full_list_of_sections):
     return full_list_of_sections
 
 
+def find_func_sections(searchpath, func_names):
+    full_list_of_sections = {"text": [], "rodata": [], "data": [], "bss": []}
+    wanted = {".text." + name for name in func_names}
+    found = set()
+
+    for dirpath, _, files in os.walk(searchpath):
+        for filename in files:
+            if not filename.endswith(".obj"):
+                continue
+
+            with open(os.path.join(dirpath, filename), 'rb') as obj_file_desc:
+                for section in ELFFile(obj_file_desc).iter_sections():
+                    if section.name in wanted:
+                        found.add(section.name)
+
+    for section_name in sorted(wanted - found):
+        # inlined everywhere, or not part of the build
+        warnings.warn("Function: " + section_name[len(".text."):] +
+                      " Not found")
+
+    full_list_of_sections["text"] = sorted(found)
+
+    return full_list_of_sections
+
+
 def assign_to_correct_mem_region(memory_type,
                                  full_list_of_sections, complete_list_of_sections):
     all_regions = False
@@ -360,6 +392,10 @@ def parse_args():
                         help="Output sram bss ld file")
     parser.add_argument("-c", "--output_code", required=False,
                         help="Output relocation code header file")
+    parser.add_argument("-f", "--functions", required=False,
+                        help="file listing the functions to relocate")
+    parser.add_argument("-r", "--functions_region", default="SRAM",
+                        help="memory type of the functions not specifying one")
     parser.add_argument("-v", "--verbose", action="count", default=0,
                         help="Verbose Output")
     args = parser.parse_args()
@@ -383,7 +419,9 @@ def create_dict_wrt_mem():
     # need to support wild card *
     rel_dict = dict()
     if args.input_rel_dict == '':
-        sys.exit("Disable CONFIG_CODE_DATA_RELOCATION if no file needs relocation")
+        if not args.functions:
+            sys.exit("Disable CONFIG_CODE_DATA_RELOCATION if no file needs relocation")
+        return rel_dict
     for line in args.input_rel_dict.split(';'):
         mem_region, file_name = line.split(':')
 
@@ -403,6 +441,30 @@ def create_dict_wrt_mem():
     return rel_dict
 
 
+# Create a dict with key as memory type and function names as a list of values.
+def create_func_dict_wrt_mem():
+    func_dict = dict()
+    if not args.functions:
+        return func_dict
+
+    with open(args.functions) as file_desc:
+        for line in file_desc:
+            line = line.split('#')[0].split()
+            if not line:
+                continue
+
+            if ':' in line[0]:
+                mem_region, func_name = line[0].split(':', 1)
+            else:
+                mem_region, func_name = args.functions_region, line[0]
+
+            if args.verbose:
+                print("Memory region ", mem_region, " Selected for function:", func_name)
+            func_dict.setdefault(mem_region, []).append(func_name)
+
+    return func_dict
+
+
 def main():
     global mpu_align
     mpu_align = {}
@@ -412,6 +474,7 @@ def main():
     sram_data_linker_file = args.output_sram_data
     sram_bss_linker_file = args.output_sram_bss
     rel_dict = create_dict_wrt_mem()
+    func_dict = create_func_dict_wrt_mem()
     complete_list_of_sections = {}
 
     # Create/or trucate file contents if it already exists
@@ -434,6 +497,13 @@ def main():
                                                                  full_list_of_sections,
                                                                  complete_list_of_sections)
 
+    # the functions only bring their text section along
+    for memory_type, func_names in func_dict.items():
+        full_list_of_sections = find_func_sections(searchpath, func_names)
+        complete_list_of_sections = assign_to_correct_mem_region(memory_type,
+                                                                 full_list_of_sections,
+                                                                 complete_list_of_sections)
+
     generate_linker_script(linker_file, sram_data_linker_file,
                            sram_bss_linker_file, complete_list_of_sections)
 
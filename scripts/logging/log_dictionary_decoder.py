@@ -0,0 +1,243 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Decoder for dictionary based log output (CONFIG_LOG_DICTIONARY_SUPPORT).
+
+The target emits binary frames which contain addresses of format strings
+instead of formatted text. This script reads the strings from the ELF file
+the target is running and prints the log messages.
+
+Example:
+
+    log_dictionary_decoder.py build/zephyr/zephyr.elf /dev/ttyACM0
+    log_dictionary_decoder.py -f 32768 build/zephyr/zephyr.elf log.bin
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+LOG_DICT_TYPE_STD = 0xD0
+LOG_DICT_TYPE_HEXDUMP = 0xD1
+LOG_DICT_TYPE_RAW = 0xD2
+LOG_DICT_TYPE_DROPPED = 0xD3
+
+SHF_ALLOC = 0x2
+
+SEVERITY = [None, "err", "wrn", "inf", "dbg"]
+
+FMT_SPEC = re.compile(r"%([-+ #0]*)(\*|\d+)?(\.(?:\*|\d+))?([hlLjzt]*)"
+                      r"([diouxXcspfFeEgGaA%])")
+
+
+class Dictionary:
+    def __init__(self, elf_path):
+        self.fd = open(elf_path, "rb")
+        self.elf = ELFFile(self.fd)
+        self.endian = "<" if self.elf.little_endian else ">"
+        self.word = "Q" if self.elf.elfclass == 64 else "I"
+        self.word_size = struct.calcsize(self.word)
+        self.sections = [s for s in self.elf.iter_sections()
+                         if s["sh_flags"] & SHF_ALLOC and
+                         s["sh_type"] != "SHT_NOBITS"]
+        self.sources = self._load_sources()
+
+    def _section_for(self, addr):
+        for s in self.sections:
+            start = s["sh_addr"]
+            if start <= addr < start + s["sh_size"]:
+                return s
+        return None
+
+    def string(self, addr):
+        s = self._section_for(addr)
+        if s is None:
+            return "<unknown string @0x%x>" % addr
+        data = s.data()
+        off = addr - s["sh_addr"]
+        end = data.find(b"\0", off)
+        if end < 0:
+            end = len(data)
+        return data[off:end].decode("utf-8", "replace")
+
+    def _load_sources(self):
+        symtab = self.elf.get_section_by_name(".symtab")
+        if not isinstance(symtab, SymbolTableSection):
+            return {}
+
+        start = None
+        consts = []
+        for sym in symtab.iter_symbols():
+            if sym.name == "__log_const_start":
+                start = sym["st_value"]
+            elif sym.name.startswith("log_const_") and sym["st_size"]:
+                consts.append(sym)
+
+        if start is None or not consts:
+            return {}
+
+        # Source id is the index of the constant data in log_const_sections.
+        sources = {}
+        for sym in consts:
+            addr = sym["st_value"]
+            s = self._section_for(addr)
+            if s is None:
+                continue
+            off = addr - s["sh_addr"]
+            name_ptr = struct.unpack_from(self.endian + self.word,
+                                          s.data(), off)[0]
+            sources[(addr - start) // sym["st_size"]] = self.string(name_ptr)
+        return sources
+
+
+class Decoder:
+    def __init__(self, dictionary, freq):
+        self.dict = dictionary
+        self.freq = freq
+
+    def _timestamp(self, ts):
+        if not self.freq:
+            return "[%010u]" % ts
+        us = ts * 1000000 // self.freq
+        return "[%02u:%02u:%02u.%03u,%03u]" % (
+            us // 3600000000, (us // 60000000) % 60, (us // 1000000) % 60,
+            (us // 1000) % 1000, us % 1000)
+
+    def _prefix(self, level, source_id, ts):
+        src = self.dict.sources.get(source_id, "src%u" % source_id)
+        sev = SEVERITY[level] if level < len(SEVERITY) else "???"
+        return "%s <%s> %s: " % (self._timestamp(ts), sev, src)
+
+    def _format(self, fmt, args, strings):
+        bits = self.dict.word_size * 8
+        args = list(args)
+        strings = list(strings)
+
+        def conv(m):
+            flags, width, prec, _, spec = m.groups()
+            if spec == "%":
+                return "%"
+            if width == "*":
+                width = str(args.pop(0)) if args else ""
+            if prec == ".*":
+                prec = "." + str(args.pop(0)) if args else ""
+            if not args:
+                return m.group(0)
+            val = args.pop(0)
+            pyfmt = "%" + flags + (width or "") + (prec or "")
+            if spec == "s":
+                return (pyfmt + "s") % (strings.pop(0) if strings else "")
+            if spec == "p":
+                return "0x%x" % val
+            if spec == "c":
+                return (pyfmt + "c") % (val & 0xff)
+            if spec in "di":
+                if val & (1 << (bits - 1)):
+                    val -= 1 << bits
+                return (pyfmt + "d") % val
+            if spec == "u":
+                return (pyfmt + "d") % val
+            if spec in "ouxX":
+                return (pyfmt + spec) % val
+            return "<%s unsupported>" % m.group(0)
+
+        return FMT_SPEC.sub(conv, fmt)
+
+    def decode(self, stream):
+        e = self.dict.endian
+        word = self.dict.word
+        word_size = self.dict.word_size
+
+        def read(n):
+            data = stream.read(n)
+            if len(data) != n:
+                raise EOFError
+            return data
+
+        try:
+            while True:
+                frame_type = read(1)[0]
+
+                if frame_type == LOG_DICT_TYPE_DROPPED:
+                    cnt = struct.unpack(e + "I", read(4))[0]
+                    print("--- %u messages dropped ---" % cnt)
+                    continue
+
+                if frame_type not in (LOG_DICT_TYPE_STD,
+                                      LOG_DICT_TYPE_HEXDUMP,
+                                      LOG_DICT_TYPE_RAW):
+                    # Out of sync, look for the next frame.
+                    continue
+
+                level, _, source_id, ts = struct.unpack(e + "BBHI", read(8))
+
+                if frame_type == LOG_DICT_TYPE_STD:
+                    fmt = self.dict.string(
+                        struct.unpack(e + word, read(word_size))[0])
+                    nargs = read(1)[0]
+                    args = struct.unpack(e + word * nargs,
+                                         read(word_size * nargs))
+                    strings = []
+                    for m in FMT_SPEC.finditer(fmt):
+                        if m.group(5) == "s":
+                            s = b""
+                            c = read(1)
+                            while c != b"\0":
+                                s += c
+                                c = read(1)
+                            strings.append(s.decode("utf-8", "replace"))
+                    msg = self._format(fmt, args, strings).rstrip("\n")
+                    print(self._prefix(level, source_id, ts) + msg)
+                elif frame_type == LOG_DICT_TYPE_HEXDUMP:
+                    meta = self.dict.string(
+                        struct.unpack(e + word, read(word_size))[0])
+                    length = struct.unpack(e + "H", read(2))[0]
+                    data = read(length)
+                    print(self._prefix(level, source_id, ts) + meta)
+                    for i in range(0, length, 16):
+                        line = data[i:i + 16]
+                        print("    " + " ".join("%02x" % b for b in line))
+                else:
+                    length = struct.unpack(e + "H", read(2))[0]
+                    sys.stdout.write(read(length).decode("utf-8", "replace"))
+                sys.stdout.flush()
+        except EOFError:
+            pass
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="ELF file of the application")
+    parser.add_argument("input", nargs="?", default="-",
+                        help="binary log input (file or tty), "
+                             "stdin by default")
+    parser.add_argument("-f", "--freq", type=int, default=0,
+                        help="timestamp frequency in Hz, raw timestamps "
+                             "are printed if not given")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    dictionary = Dictionary(args.elf)
+
+    if args.input == "-":
+        stream = sys.stdin.buffer
+    else:
+        stream = open(args.input, "rb", buffering=0)
+
+    Decoder(dictionary, args.freq).decode(stream)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Symbolize samples collected by the sampling profiler (CONFIG_PROFILER).
+
+Input is console output containing profiler_dump() result. Output is in the
+folded stack format ("caller;function count") accepted by flamegraph.pl and
+speedscope. With --flat, a list of functions sorted by sample count is
+printed instead.
+
+Example:
+
+    profiler_decode.py build/zephyr/zephyr.elf console.log | flamegraph.pl
+"""
+
+import argparse
+import bisect
+import collections
+import re
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+SAMPLE_RE = re.compile(r"PROF ([0-9a-fA-F]{8}) ([0-9a-fA-F]{8})")
+
+
+class Symbolizer:
+    def __init__(self, elf_path):
+        with open(elf_path, "rb") as f:
+            elf = ELFFile(f)
+            symtab = elf.get_section_by_name(".symtab")
+            if not isinstance(symtab, SymbolTableSection):
+                sys.exit("No symbol table in %s" % elf_path)
+
+            funcs = {}
+            for sym in symtab.iter_symbols():
+                if sym["st_info"]["type"] != "STT_FUNC":
+                    continue
+                # Clear thumb bit.
+                addr = sym["st_value"] & ~1
+                funcs[addr] = (sym.name, sym["st_size"])
+
+        self.addrs = sorted(funcs)
+        self.funcs = [funcs[a] for a in self.addrs]
+
+    def name(self, addr):
+        addr &= ~1
+        idx = bisect.bisect_right(self.addrs, addr) - 1
+        if idx >= 0:
+            name, size = self.funcs[idx]
+            if size == 0 or addr < self.addrs[idx] + size:
+                return name
+        return "0x%08x" % addr
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="ELF file of the application")
+    parser.add_argument("input", nargs="?", default="-",
+                        help="console output, stdin by default")
+    parser.add_argument("--flat", action="store_true",
+                        help="print flat profile instead of folded stacks")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    sym = Symbolizer(args.elf)
+    stream = sys.stdin if args.input == "-" else open(args.input)
+
+    stacks = collections.Counter()
+    funcs = collections.Counter()
+    total = 0
+
+    for line in stream:
+        m = SAMPLE_RE.search(line)
+        if not m:
+            continue
+
+        pc = int(m.group(1), 16)
+        lr = int(m.group(2), 16)
+        total += 1
+
+        if pc == 0:
+            func = "[isr]"
+            stack = func
+        else:
+            func = sym.name(pc)
+            stack = func
+            if lr:
+                caller = sym.name(lr)
+                if caller != func:
+                    stack = caller + ";" + func
+
+        funcs[func] += 1
+        stacks[stack] += 1
+
+    if args.flat:
+        for func, cnt in funcs.most_common():
+            print("%6.2f%% %8u  %s" % (100.0 * cnt / total, cnt, func))
+    else:
+        for stack, cnt in stacks.most_common():
+            print("%s %u" % (stack, cnt))
+
+
+if __name__ == "__main__":
+    main()
@@ -71,6 +71,10 @@
 #include <stm32f0xx_ll_dma.h>
 #endif
 
+#ifdef CONFIG_CRC_STM32
+#include <stm32f0xx_ll_crc.h>
+#endif
+
 #endif /* !_ASMLANGUAGE */
 
 #endif /* _STM32F0_SOC_H_ */
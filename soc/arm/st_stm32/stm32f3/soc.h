@@ -78,6 +78,10 @@
 #include <stm32f3xx_ll_dma.h>
 #endif
 
+#ifdef CONFIG_CRC_STM32
+#include <stm32f3xx_ll_crc.h>
+#endif
+
 #endif /* !_ASMLANGUAGE */
 
 #endif /* _STM32F3_SOC_H_ */
@@ -111,6 +111,22 @@
 #define DT_UART_STM32_USART_1_CLOCK_BITS	DT_ST_STM32_USART_40011000_CLOCK_BITS
 #define DT_UART_STM32_USART_1_CLOCK_BUS		DT_ST_STM32_USART_40011000_CLOCK_BUS
 #define DT_UART_STM32_USART_1_HW_FLOW_CONTROL	DT_ST_STM32_USART_40011000_HW_FLOW_CONTROL
+#define DT_UART_STM32_USART_1_DMA_CONTROLLER_RX	\
+			DT_ST_STM32_USART_40011000_RX_DMAS_CONTROLLER
+#define DT_UART_STM32_USART_1_DMA_CHANNEL_RX	\
+			DT_ST_STM32_USART_40011000_RX_DMAS_CHANNEL
+#define DT_UART_STM32_USART_1_DMA_SLOT_RX	\
+			DT_ST_STM32_USART_40011000_RX_DMAS_SLOT
+#define DT_UART_STM32_USART_1_DMA_CHANNEL_CONFIG_RX	\
+			DT_ST_STM32_USART_40011000_RX_DMAS_CHANNEL_CONFIG
+#define DT_UART_STM32_USART_1_DMA_CONTROLLER_TX	\
+			DT_ST_STM32_USART_40011000_TX_DMAS_CONTROLLER
+#define DT_UART_STM32_USART_1_DMA_CHANNEL_TX	\
+			DT_ST_STM32_USART_40011000_TX_DMAS_CHANNEL
+#define DT_UART_STM32_USART_1_DMA_SLOT_TX	\
+			DT_ST_STM32_USART_40011000_TX_DMAS_SLOT
+#define DT_UART_STM32_USART_1_DMA_CHANNEL_CONFIG_TX	\
+			DT_ST_STM32_USART_40011000_TX_DMAS_CHANNEL_CONFIG
 
 #define DT_UART_STM32_USART_2_BASE_ADDRESS	DT_ST_STM32_USART_40004400_BASE_ADDRESS
 #define DT_UART_STM32_USART_2_BAUD_RATE		DT_ST_STM32_USART_40004400_CURRENT_SPEED
@@ -120,6 +136,22 @@
 #define DT_UART_STM32_USART_2_CLOCK_BITS	DT_ST_STM32_USART_40004400_CLOCK_BITS
 #define DT_UART_STM32_USART_2_CLOCK_BUS		DT_ST_STM32_USART_40004400_CLOCK_BUS
 #define DT_UART_STM32_USART_2_HW_FLOW_CONTROL	DT_ST_STM32_USART_40004400_HW_FLOW_CONTROL
+#define DT_UART_STM32_USART_2_DMA_CONTROLLER_RX	\
+			DT_ST_STM32_USART_40004400_RX_DMAS_CONTROLLER
+#define DT_UART_STM32_USART_2_DMA_CHANNEL_RX	\
+			DT_ST_STM32_USART_40004400_RX_DMAS_CHANNEL
+#define DT_UART_STM32_USART_2_DMA_SLOT_RX	\
+			DT_ST_STM32_USART_40004400_RX_DMAS_SLOT
+#define DT_UART_STM32_USART_2_DMA_CHANNEL_CONFIG_RX	\
+			DT_ST_STM32_USART_40004400_RX_DMAS_CHANNEL_CONFIG
+#define DT_UART_STM32_USART_2_DMA_CONTROLLER_TX	\
+			DT_ST_STM32_USART_40004400_TX_DMAS_CONTROLLER
+#define DT_UART_STM32_USART_2_DMA_CHANNEL_TX	\
+			DT_ST_STM32_USART_40004400_TX_DMAS_CHANNEL
+#define DT_UART_STM32_USART_2_DMA_SLOT_TX	\
+			DT_ST_STM32_USART_40004400_TX_DMAS_SLOT
+#define DT_UART_STM32_USART_2_DMA_CHANNEL_CONFIG_TX	\
+			DT_ST_STM32_USART_40004400_TX_DMAS_CHANNEL_CONFIG
 
 #define DT_UART_STM32_USART_3_BASE_ADDRESS	DT_ST_STM32_USART_40004800_BASE_ADDRESS
 #define DT_UART_STM32_USART_3_BAUD_RATE		DT_ST_STM32_USART_40004800_CURRENT_SPEED
@@ -156,6 +188,22 @@
 #define DT_UART_STM32_USART_6_CLOCK_BITS	DT_ST_STM32_USART_40011400_CLOCK_BITS
 #define DT_UART_STM32_USART_6_CLOCK_BUS		DT_ST_STM32_USART_40011400_CLOCK_BUS
 #define DT_UART_STM32_USART_6_HW_FLOW_CONTROL	DT_ST_STM32_USART_40011400_HW_FLOW_CONTROL
+#define DT_UART_STM32_USART_6_DMA_CONTROLLER_RX	\
+			DT_ST_STM32_USART_40011400_RX_DMAS_CONTROLLER
+#define DT_UART_STM32_USART_6_DMA_CHANNEL_RX	\
+			DT_ST_STM32_USART_40011400_RX_DMAS_CHANNEL
+#define DT_UART_STM32_USART_6_DMA_SLOT_RX	\
+			DT_ST_STM32_USART_40011400_RX_DMAS_SLOT
+#define DT_UART_STM32_USART_6_DMA_CHANNEL_CONFIG_RX	\
+			DT_ST_STM32_USART_40011400_RX_DMAS_CHANNEL_CONFIG
+#define DT_UART_STM32_USART_6_DMA_CONTROLLER_TX	\
+			DT_ST_STM32_USART_40011400_TX_DMAS_CONTROLLER
+#define DT_UART_STM32_USART_6_DMA_CHANNEL_TX	\
+			DT_ST_STM32_USART_40011400_TX_DMAS_CHANNEL
+#define DT_UART_STM32_USART_6_DMA_SLOT_TX	\
+			DT_ST_STM32_USART_40011400_TX_DMAS_SLOT
+#define DT_UART_STM32_USART_6_DMA_CHANNEL_CONFIG_TX	\
+			DT_ST_STM32_USART_40011400_TX_DMAS_CHANNEL_CONFIG
 
 #define DT_UART_STM32_UART_7_BASE_ADDRESS	DT_ST_STM32_UART_40007800_BASE_ADDRESS
 #define DT_UART_STM32_UART_7_BAUD_RATE		DT_ST_STM32_UART_40007800_CURRENT_SPEED
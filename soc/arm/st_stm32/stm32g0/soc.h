@@ -51,6 +51,10 @@
 /* Add include for DTS generated information */
 #include <generated_dts_board.h>
 
+#ifdef CONFIG_CRC_STM32
+#include <stm32g0xx_ll_crc.h>
+#endif
+
 #endif /* !_ASMLANGUAGE */
 
 #endif /* _STM32G0_SOC_H_ */
@@ -72,6 +72,10 @@
 #include <stm32l0xx_ll_dma.h>
 #endif
 
+#ifdef CONFIG_CRC_STM32
+#include <stm32l0xx_ll_crc.h>
+#endif
+
 #endif /* !_ASMLANGUAGE */
 
 #endif /* _STM32L0_SOC_H_ */
@@ -99,6 +99,10 @@
 #include <stm32l4xx_ll_system.h>
 #endif
 
+#ifdef CONFIG_CRC_STM32
+#include <stm32l4xx_ll_crc.h>
+#endif
+
 #endif /* !_ASMLANGUAGE */
 
 #endif /* _STM32L4X_SOC_H_ */
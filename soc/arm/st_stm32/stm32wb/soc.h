@@ -78,6 +78,10 @@
 #include <stm32wbxx_ll_system.h>
 #endif
 
+#ifdef CONFIG_CRC_STM32
+#include <stm32wbxx_ll_crc.h>
+#endif
+
 #endif /* !_ASMLANGUAGE */
 
 #endif /* _STM32WBX_SOC_H_ */
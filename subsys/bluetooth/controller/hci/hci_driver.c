@@ -67,6 +67,25 @@ static u32_t prio_ts;
 static u32_t rx_ts;
 #endif
 
+#if defined(CONFIG_BT_CTLR_RX_ZERO_COPY)
+/* Offset of the ACL header in a Rx node, right in front of the PDU payload.
+ * The header overwrites the PDU header and the tail of the node footer,
+ * neither of which is used once the node is handed to the host.
+ */
+#define ACL_HDR_OFFSET (offsetof(struct node_rx_pdu, pdu) + \
+			offsetof(struct pdu_data, lldata) - \
+			sizeof(struct bt_hci_acl_hdr))
+
+BUILD_ASSERT(ACL_HDR_OFFSET >= offsetof(struct node_rx_hdr, rx_ftr));
+
+static void acl_rx_destroy(struct net_buf *buf);
+
+NET_BUF_POOL_FIXED_DEFINE(acl_rx_pool, CONFIG_BT_CTLR_RX_BUFFERS, 0,
+			  acl_rx_destroy);
+
+static struct node_rx_pdu *acl_rx_nodes[CONFIG_BT_CTLR_RX_BUFFERS];
+#endif /* CONFIG_BT_CTLR_RX_ZERO_COPY */
+
 #if defined(CONFIG_BT_HCI_ACL_FLOW_CONTROL)
 static struct k_poll_signal hbuf_signal =
 		K_POLL_SIGNAL_INITIALIZER(hbuf_signal);
@@ -184,6 +203,69 @@ static void prio_recv_thread(void *p1, void *p2, void *p3)
 	}
 }
 
+#if defined(CONFIG_BT_CTLR_RX_ZERO_COPY)
+static void acl_rx_destroy(struct net_buf *buf)
+{
+	struct node_rx_pdu *node_rx = acl_rx_nodes[net_buf_id(buf)];
+
+	net_buf_destroy(buf);
+
+	/* Controller memory is otherwise only released from the cooperative
+	 * Bluetooth threads, keep them out while the host hands it back.
+	 */
+	__ASSERT_NO_MSG(!k_is_in_isr());
+	k_sched_lock();
+	node_rx->hdr.next = NULL;
+	ll_rx_mem_release((void **)&node_rx);
+	k_sched_unlock();
+}
+
+/**
+ * @brief Wrap ACL data of a Rx node in a buffer for the host
+ * @details Execution context: Host thread
+ * @return Buffer pointing into the node, or NULL if the data has to be copied
+ */
+static struct net_buf *acl_rx_wrap(struct node_rx_pdu *node_rx)
+{
+	struct pdu_data *pdu_data = PDU_DATA(node_rx);
+	struct bt_hci_acl_hdr *acl;
+	struct net_buf *buf;
+	u8_t len = pdu_data->len;
+	u8_t flags;
+
+	if (pdu_data->ll_id == PDU_DATA_LLID_DATA_START) {
+		/* The host appends continuation fragments to the buffer of
+		 * the start fragment, hence only complete L2CAP PDUs.
+		 */
+		if ((len < 4) || ((sys_get_le16(pdu_data->lldata) + 4) > len)) {
+			return NULL;
+		}
+
+		flags = BT_ACL_START;
+	} else {
+		flags = BT_ACL_CONT;
+	}
+
+	buf = net_buf_alloc_with_data(&acl_rx_pool,
+				      (u8_t *)node_rx + ACL_HDR_OFFSET,
+				      sizeof(*acl) + len, K_NO_WAIT);
+	if (!buf) {
+		return NULL;
+	}
+
+	acl_rx_nodes[net_buf_id(buf)] = node_rx;
+	bt_buf_set_type(buf, BT_BUF_ACL_IN);
+
+	/* PDU header fields have been read, overwrite them */
+	acl = (void *)buf->data;
+	acl->handle = sys_cpu_to_le16(bt_acl_handle_pack(node_rx->hdr.handle,
+							 flags));
+	acl->len = sys_cpu_to_le16(len);
+
+	return buf;
+}
+#endif /* CONFIG_BT_CTLR_RX_ZERO_COPY */
+
 static inline struct net_buf *encode_node(struct node_rx_pdu *node_rx,
 					  s8_t class)
 {
@@ -207,6 +289,14 @@ static inline struct net_buf *encode_node(struct node_rx_pdu *node_rx,
 		break;
 #if defined(CONFIG_BT_CONN)
 	case HCI_CLASS_ACL_DATA:
+#if defined(CONFIG_BT_CTLR_RX_ZERO_COPY)
+		/* node is released when the host releases the buffer */
+		buf = acl_rx_wrap(node_rx);
+		if (buf) {
+			return buf;
+		}
+#endif /* CONFIG_BT_CTLR_RX_ZERO_COPY */
+
 		/* generate ACL data */
 		buf = bt_buf_get_rx(BT_BUF_ACL_IN, K_FOREVER);
 		hci_acl_encode(node_rx, buf);
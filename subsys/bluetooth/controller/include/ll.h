@@ -110,6 +110,28 @@ u8_t ll_rx_get(void **node_rx, u16_t *handle);
 void ll_rx_dequeue(void);
 void ll_rx_mem_release(void **node_rx);
 
+/* Scheduling statistics */
+enum {
+	LL_SCHED_ROLE_ADV,
+	LL_SCHED_ROLE_SCAN,
+	LL_SCHED_ROLE_MASTER,
+	LL_SCHED_ROLE_SLAVE,
+	LL_SCHED_ROLE_MAX,
+};
+
+struct ll_sched_stats {
+	struct {
+		u32_t expire; /* Events handed to LLL */
+		u32_t skip;   /* Events skipped by the ticker (lazy) */
+		u32_t miss;   /* Connection events without a packet received */
+		u32_t air_ms; /* Radio time reserved by the expired events */
+	} role[LL_SCHED_ROLE_MAX];
+	u32_t cancel;         /* Prepares cancelled by an overlapping event */
+};
+
+void ll_sched_stats_get(struct ll_sched_stats *stats);
+void ll_sched_stats_reset(void);
+
 /* External co-operation */
 void ll_timeslice_ticker_id_get(u8_t * const instance_index, u8_t * const user_id);
 void ll_radio_state_abort(void);
@@ -42,6 +42,7 @@
 #include "ull_filter.h"
 
 #include "ull_internal.h"
+#include "ull_sched_internal.h"
 #include "ull_adv_internal.h"
 #include "ull_scan_internal.h"
 #include "ull_conn_internal.h"
@@ -343,6 +344,10 @@ void ll_reset(void)
 {
 	int err;
 
+	if (IS_ENABLED(CONFIG_BT_CTLR_SCHED_STATS)) {
+		ll_sched_stats_reset();
+	}
+
 #if defined(CONFIG_BT_BROADCASTER)
 	/* Reset adv state */
 	err = ull_adv_reset();
@@ -1676,6 +1681,11 @@ static inline void rx_demux_event_done(memq_link_t *link,
 		u8_t is_aborted = next->is_aborted;
 		u8_t is_resume = next->is_resume;
 
+		if (IS_ENABLED(CONFIG_BT_CTLR_SCHED_STATS) && is_aborted &&
+		    !is_resume) {
+			ull_sched_stats_cancel();
+		}
+
 		if (!is_aborted) {
 			static memq_link_t link;
 			static struct mayfly mfy = {0, 0, &link, NULL,
@@ -42,6 +42,7 @@
 #include "ull_scan_internal.h"
 #include "ull_conn_internal.h"
 #include "ull_internal.h"
+#include "ull_sched_internal.h"
 
 #define BT_DBG_ENABLED IS_ENABLED(CONFIG_BT_DEBUG_HCI_DRIVER)
 #define LOG_MODULE_NAME bt_ctlr_ull_adv
@@ -1025,6 +1026,11 @@ static void ticker_cb(u32_t ticks_at_expire, u32_t remainder, u16_t lazy,
 
 	lll = &adv->lll;
 
+	if (IS_ENABLED(CONFIG_BT_CTLR_SCHED_STATS)) {
+		ull_sched_stats_expire(LL_SCHED_ROLE_ADV, lazy,
+				       adv->evt.ticks_slot);
+	}
+
 	if (IS_ENABLED(CONFIG_BT_TICKER_COMPATIBILITY_MODE) ||
 	    (lazy != TICKER_LAZY_MUST_EXPIRE)) {
 		/* Increment prepare reference count */
@@ -766,6 +766,11 @@ int ull_conn_rx(memq_link_t *link, struct node_rx_pdu **rx)
 	return 0;
 }
 
+void ull_conn_upd_curr_reset(void)
+{
+	conn_upd_curr = NULL;
+}
+
 int ull_conn_llcp(struct ll_conn *conn, u32_t ticks_at_expire, u16_t lazy)
 {
 	LL_ASSERT(conn->lll.handle != 0xFFFF);
@@ -947,6 +952,11 @@ void ull_conn_done(struct node_rx_event_done *done)
 		return;
 	}
 
+	if (IS_ENABLED(CONFIG_BT_CTLR_SCHED_STATS) && !done->extra.trx_cnt) {
+		ull_sched_stats_miss(lll->role ? LL_SCHED_ROLE_SLAVE :
+						 LL_SCHED_ROLE_MASTER);
+	}
+
 #if defined(CONFIG_BT_CTLR_LE_ENC)
 	/* Check authenticated payload expiry or MIC failure */
 	switch (done->extra.mic_state) {
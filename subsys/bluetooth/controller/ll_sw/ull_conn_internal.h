@@ -34,6 +34,7 @@ u8_t ull_conn_default_phy_rx_get(void);
 void ull_conn_setup(memq_link_t *link, struct node_rx_hdr *rx);
 int ull_conn_rx(memq_link_t *link, struct node_rx_pdu **rx);
 int ull_conn_llcp(struct ll_conn *conn, u32_t ticks_at_expire, u16_t lazy);
+void ull_conn_upd_curr_reset(void);
 void ull_conn_done(struct node_rx_event_done *done);
 void ull_conn_tx_demux(u8_t count);
 void ull_conn_tx_lll_enqueue(struct ll_conn *conn, u8_t count);
@@ -38,6 +38,7 @@
 #include "ull_filter.h"
 
 #include "ull_internal.h"
+#include "ull_sched_internal.h"
 #include "ull_scan_internal.h"
 #include "ull_conn_internal.h"
 #include "ull_master_internal.h"
@@ -93,7 +94,12 @@ u8_t ll_create_connection(u16_t scan_interval, u16_t scan_window,
 	lll->adv_addr_type = peer_addr_type;
 	memcpy(lll->adv_addr, peer_addr, BDADDR_SIZE);
 	lll->conn_timeout = timeout;
-	lll->conn_ticks_slot = 0; /* TODO: */
+	/* Slot of the first connection event, before the radio ready delay
+	 * is known; used to place it after the existing masters.
+	 */
+	lll->conn_ticks_slot =
+		HAL_TICKER_US_TO_TICKS(EVENT_OVERHEAD_START_US + 328 +
+				       EVENT_IFS_US + 328);
 
 	conn_lll = &conn->lll;
 
@@ -617,6 +623,11 @@ void ull_master_ticker_cb(u32_t ticks_at_expire, u32_t remainder, u16_t lazy,
 
 	DEBUG_RADIO_PREPARE_M(1);
 
+	if (IS_ENABLED(CONFIG_BT_CTLR_SCHED_STATS)) {
+		ull_sched_stats_expire(LL_SCHED_ROLE_MASTER, lazy,
+				       conn->evt.ticks_slot);
+	}
+
 	/* Handle any LL Control Procedures */
 	ret = ull_conn_llcp(conn, ticks_at_expire, lazy);
 	if (ret) {
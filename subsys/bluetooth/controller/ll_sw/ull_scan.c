@@ -387,6 +387,11 @@ static void ticker_cb(u32_t ticks_at_expire, u32_t remainder, u16_t lazy,
 
 	DEBUG_RADIO_PREPARE_O(1);
 
+	if (IS_ENABLED(CONFIG_BT_CTLR_SCHED_STATS)) {
+		ull_sched_stats_expire(LL_SCHED_ROLE_SCAN, lazy,
+				       scan->evt.ticks_slot);
+	}
+
 	/* Increment prepare reference count */
 	ref = ull_ref_inc(&scan->ull);
 	LL_ASSERT(ref);
@@ -414,7 +419,7 @@ static void ticker_cb(u32_t ticks_at_expire, u32_t remainder, u16_t lazy,
 			ull_sched_mfy_after_mstr_offset_get};
 		u32_t retval;
 
-		s_mfy_sched_after_mstr_offset_get.param = (void *)scan;
+		s_mfy_sched_after_mstr_offset_get.param = (void *)&p;
 
 		retval = mayfly_enqueue(TICKER_USER_ID_ULL_HIGH,
 				TICKER_USER_ID_ULL_LOW, 1,
@@ -4,43 +4,496 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
-#include <zephyr/types.h>
-#include <toolchain.h>
+#include <string.h>
+#include <zephyr.h>
+#include <bluetooth/hci.h>
 
+#include "util/util.h"
 #include "util/memq.h"
 
+#include "hal/ticker.h"
+
+#include "ticker/ticker.h"
+
 #include "pdu.h"
 
 #include "lll.h"
+#include "lll_vendor.h"
 #include "lll_scan.h"
+#include "lll_conn.h"
 
 #include "ull_scan_types.h"
+#include "ull_conn_types.h"
+
+#include "ull_internal.h"
+#include "ull_sched_internal.h"
+#include "ull_conn_internal.h"
+
+#define BT_DBG_ENABLED IS_ENABLED(CONFIG_BT_DEBUG_HCI_DRIVER)
+#define LOG_MODULE_NAME bt_ctlr_ull_sched
+#include "common/log.h"
+#include <soc.h>
+#include "hal/debug.h"
+
+/* Implementation defined spacing between connection events of different
+ * connections with the same interval.
+ */
+#define EVENT_TIES_US 625
+
+static void after_mstr_offset_get(u16_t conn_interval, u32_t ticks_slot,
+				  u32_t ticks_anchor, u32_t *win_offset_us);
+static void win_offset_calc(struct ll_conn *conn_curr, u8_t is_select,
+			    u32_t *ticks_to_offset_next,
+			    u16_t conn_interval, u8_t *offset_max,
+			    u8_t *win_offset);
+static u32_t ticks_slot_abs_get(struct ll_conn *conn,
+				u32_t *ticks_prepare_reduced);
+static void ticker_op_cb(u32_t status, void *param);
 
 void ull_sched_after_mstr_slot_get(u8_t user_id, u32_t ticks_slot_abs,
 				   u32_t *ticks_anchor, u32_t *us_offset)
 {
-	/* TODO: */
+	u32_t ticks_to_expire_prev;
+	u32_t ticks_slot_abs_prev;
+	u32_t ticks_to_expire;
+	u8_t ticker_id_prev;
+	u8_t ticker_id;
+
+	ticks_slot_abs += HAL_TICKER_US_TO_TICKS(EVENT_JITTER_US << 3);
+
+	ticker_id = ticker_id_prev = 0xff;
+	ticks_to_expire = ticks_to_expire_prev = *us_offset = 0U;
+	ticks_slot_abs_prev = 0U;
+	while (1) {
+		u32_t volatile ret_cb = TICKER_STATUS_BUSY;
+		struct ll_conn *conn;
+		u32_t ret;
+
+		ret = ticker_next_slot_get(TICKER_INSTANCE_ID_CTLR, user_id,
+					   &ticker_id, ticks_anchor,
+					   &ticks_to_expire, ticker_op_cb,
+					   (void *)&ret_cb);
+		if (ret == TICKER_STATUS_BUSY) {
+			while (ret_cb == TICKER_STATUS_BUSY) {
+				ticker_job_sched(TICKER_INSTANCE_ID_CTLR,
+						 user_id);
+			}
+		}
+
+		LL_ASSERT(ret_cb == TICKER_STATUS_SUCCESS);
+
+		if (ticker_id == 0xff) {
+			break;
+		}
+
+		if ((ticker_id < TICKER_ID_CONN_BASE) ||
+		    (ticker_id > TICKER_ID_CONN_LAST)) {
+			continue;
+		}
+
+		conn = ll_conn_get(ticker_id - TICKER_ID_CONN_BASE);
+		if (conn && !conn->lll.role) {
+			u32_t ticks_to_expire_normal = ticks_to_expire;
+			u32_t ticks_prepare_reduced = 0U;
+			u32_t ticks_slot_abs_curr;
+
+			ticks_slot_abs_curr =
+				ticks_slot_abs_get(conn,
+						   &ticks_prepare_reduced) +
+				HAL_TICKER_US_TO_TICKS(EVENT_JITTER_US << 3);
+			ticks_to_expire_normal -= ticks_prepare_reduced;
+
+			/* Stop at the first gap between consecutive masters
+			 * that fits the requested slot.
+			 */
+			if ((ticker_id_prev != 0xff) &&
+			    (ticker_ticks_diff_get(ticks_to_expire_normal,
+						   ticks_to_expire_prev) >
+			     (ticks_slot_abs_prev + ticks_slot_abs))) {
+				break;
+			}
+
+			ticker_id_prev = ticker_id;
+			ticks_to_expire_prev = ticks_to_expire_normal;
+			ticks_slot_abs_prev = ticks_slot_abs_curr;
+		}
+	}
+
+	if (ticker_id_prev != 0xff) {
+		*us_offset = HAL_TICKER_TICKS_TO_US(ticks_to_expire_prev +
+						    ticks_slot_abs_prev) +
+			     (EVENT_JITTER_US << 3);
+	}
 }
 
+#if defined(CONFIG_BT_CENTRAL)
 void ull_sched_mfy_after_mstr_offset_get(void *param)
 {
-	struct ll_scan_set *scan = param;
+	struct lll_prepare_param *p = param;
+	struct lll_scan *lll = p->param;
 
-	/* TODO: */
-	scan->lll.conn_win_offset_us = 0;
+	after_mstr_offset_get(lll->conn->interval,
+			      (HAL_TICKER_US_TO_TICKS(EVENT_OVERHEAD_XTAL_US) +
+			       lll->conn_ticks_slot),
+			      p->ticks_at_expire, &lll->conn_win_offset_us);
 }
+#endif /* CONFIG_BT_CENTRAL */
 
-void ull_sched_mfy_free_win_offset_calc(void *param)
+void ull_sched_mfy_win_offset_use(void *param)
 {
-	/* TODO: */
+	struct ll_conn *conn = param;
+	u16_t win_offset;
+
+	after_mstr_offset_get(conn->lll.interval, conn->evt.ticks_slot,
+			      conn->llcp.conn_upd.ticks_anchor,
+			      &conn->llcp_cu.win_offset_us);
+
+	win_offset = conn->llcp_cu.win_offset_us / 1250U;
+	memcpy(conn->llcp.conn_upd.pdu_win_offset, &win_offset,
+	       sizeof(u16_t));
 }
 
-void ull_sched_mfy_win_offset_use(void *param)
+#if defined(CONFIG_BT_CTLR_CONN_PARAM_REQ)
+void ull_sched_mfy_free_win_offset_calc(void *param)
 {
-	/* TODO: */
+	u32_t ticks_to_offset_default = 0U;
+	u32_t *ticks_to_offset_next;
+	struct ll_conn *conn = param;
+	u8_t offset_max = 6U;
+
+	ticks_to_offset_next = &ticks_to_offset_default;
+
+#if defined(CONFIG_BT_PERIPHERAL)
+	if (conn->lll.role) {
+		conn->llcp_conn_param.ticks_to_offset_next =
+			conn->slave.ticks_to_offset;
+
+		ticks_to_offset_next =
+			&conn->llcp_conn_param.ticks_to_offset_next;
+	}
+#endif /* CONFIG_BT_PERIPHERAL */
+
+	win_offset_calc(conn, 0, ticks_to_offset_next,
+			conn->llcp_conn_param.interval_max, &offset_max,
+			(u8_t *)conn->llcp_conn_param.pdu_win_offset0);
 }
 
 void ull_sched_mfy_win_offset_select(void *param)
 {
-	/* TODO: */
+#define OFFSET_S_MAX 6
+#define OFFSET_M_MAX 6
+	u16_t win_offset_m[OFFSET_M_MAX] = {0, };
+	u8_t offset_m_max = OFFSET_M_MAX;
+	struct ll_conn *conn = param;
+	u8_t offset_index_s = 0U;
+	u8_t has_offset_s = 0U;
+	u32_t ticks_to_offset;
+	u16_t win_offset_s;
+
+	ticks_to_offset = HAL_TICKER_US_TO_TICKS(conn->llcp_conn_param.offset0 *
+						 1250U);
+
+	win_offset_calc(conn, 1, &ticks_to_offset,
+			conn->llcp_conn_param.interval_max, &offset_m_max,
+			(u8_t *)&win_offset_m[0]);
+
+	/* Use the first offset preferred by the peer that is also free
+	 * locally.
+	 */
+	while (offset_index_s < OFFSET_S_MAX) {
+		u8_t offset_index_m = 0U;
+
+		memcpy((u8_t *)&win_offset_s,
+		       ((u8_t *)&conn->llcp_conn_param.offset0 +
+			(sizeof(u16_t) * offset_index_s)), sizeof(u16_t));
+
+		while (offset_index_m < offset_m_max) {
+			if (win_offset_s != 0xffff) {
+				if (win_offset_s ==
+				    win_offset_m[offset_index_m]) {
+					break;
+				}
+
+				has_offset_s = 1U;
+			}
+
+			offset_index_m++;
+		}
+
+		if (offset_index_m < offset_m_max) {
+			break;
+		}
+
+		offset_index_s++;
+	}
+
+	if (offset_index_s < OFFSET_S_MAX) {
+		conn->llcp_cu.win_offset_us = win_offset_s * 1250U;
+		memcpy(conn->llcp.conn_upd.pdu_win_offset, &win_offset_s,
+		       sizeof(u16_t));
+	} else if (!has_offset_s) {
+		conn->llcp_cu.win_offset_us = win_offset_m[0] * 1250U;
+		memcpy(conn->llcp.conn_upd.pdu_win_offset, &win_offset_m[0],
+		       sizeof(u16_t));
+	} else {
+		struct pdu_data *pdu_ctrl_tx;
+
+		/* procedure request acked */
+		conn->llcp_ack = conn->llcp_req;
+
+		/* CPR request acked */
+		conn->llcp_conn_param.ack = conn->llcp_conn_param.req;
+
+		/* reset mutex */
+		ull_conn_upd_curr_reset();
+
+		/* send reject_ind_ext */
+		pdu_ctrl_tx = (void *)
+			((u8_t *)conn->llcp.conn_upd.pdu_win_offset -
+			 offsetof(struct pdu_data,
+				  llctrl.conn_update_ind.win_offset));
+		pdu_ctrl_tx->ll_id = PDU_DATA_LLID_CTRL;
+		pdu_ctrl_tx->len =
+			offsetof(struct pdu_data_llctrl, reject_ext_ind) +
+			sizeof(struct pdu_data_llctrl_reject_ext_ind);
+		pdu_ctrl_tx->llctrl.opcode =
+			PDU_DATA_LLCTRL_TYPE_REJECT_EXT_IND;
+		pdu_ctrl_tx->llctrl.reject_ext_ind.reject_opcode =
+			PDU_DATA_LLCTRL_TYPE_CONN_PARAM_REQ;
+		pdu_ctrl_tx->llctrl.reject_ext_ind.error_code =
+			BT_HCI_ERR_UNSUPP_LL_PARAM_VAL;
+	}
+}
+#endif /* CONFIG_BT_CTLR_CONN_PARAM_REQ */
+
+static void after_mstr_offset_get(u16_t conn_interval, u32_t ticks_slot,
+				  u32_t ticks_anchor, u32_t *win_offset_us)
+{
+	u32_t ticks_anchor_offset = ticks_anchor;
+
+	ull_sched_after_mstr_slot_get(TICKER_USER_ID_ULL_LOW, ticks_slot,
+				      &ticks_anchor_offset, win_offset_us);
+
+	if (!*win_offset_us) {
+		return;
+	}
+
+	LL_ASSERT(!((ticks_anchor_offset - ticks_anchor) &
+		    BIT(HAL_TICKER_CNTR_MSBIT)));
+
+	*win_offset_us += HAL_TICKER_TICKS_TO_US(
+		ticker_ticks_diff_get(ticks_anchor_offset, ticks_anchor));
+
+	if ((*win_offset_us & BIT(31)) == 0) {
+		u32_t conn_interval_us = conn_interval * 1250U;
+
+		while (*win_offset_us > conn_interval_us) {
+			*win_offset_us -= conn_interval_us;
+		}
+	}
+}
+
+#if defined(CONFIG_BT_CTLR_CONN_PARAM_REQ)
+static void win_offset_calc(struct ll_conn *conn_curr, u8_t is_select,
+			    u32_t *ticks_to_offset_next,
+			    u16_t conn_interval, u8_t *offset_max,
+			    u8_t *win_offset)
+{
+	u32_t ticks_prepare_reduced = 0U;
+	u32_t ticks_to_expire_prev;
+	u32_t ticks_slot_abs_prev;
+	u32_t ticks_anchor_prev;
+	u32_t ticks_to_expire;
+	u32_t ticks_slot_abs;
+	u8_t ticker_id_other;
+	u8_t ticker_id_prev;
+	u32_t ticks_anchor;
+	u8_t offset_index;
+	u16_t _win_offset;
+	u8_t ticker_id;
+
+	ticks_slot_abs = ticks_slot_abs_get(conn_curr,
+					    &ticks_prepare_reduced) +
+			 HAL_TICKER_US_TO_TICKS(EVENT_TIES_US + 1250U);
+
+	ticker_id = ticker_id_prev = ticker_id_other = 0xFF;
+	ticks_to_expire = ticks_to_expire_prev = ticks_anchor =
+		ticks_anchor_prev = offset_index = _win_offset = 0U;
+	ticks_slot_abs_prev = 0U;
+	do {
+		u32_t volatile ret_cb = TICKER_STATUS_BUSY;
+		struct ll_conn *conn;
+		u32_t ret;
+
+		ret = ticker_next_slot_get(TICKER_INSTANCE_ID_CTLR,
+					   TICKER_USER_ID_ULL_LOW,
+					   &ticker_id, &ticks_anchor,
+					   &ticks_to_expire, ticker_op_cb,
+					   (void *)&ret_cb);
+		if (ret == TICKER_STATUS_BUSY) {
+			while (ret_cb == TICKER_STATUS_BUSY) {
+				ticker_job_sched(TICKER_INSTANCE_ID_CTLR,
+						 TICKER_USER_ID_ULL_LOW);
+			}
+		}
+
+		LL_ASSERT(ret_cb == TICKER_STATUS_SUCCESS);
+
+		if (ticker_id == 0xff) {
+			break;
+		}
+
+		/* ticks_anchor shall not change during this loop */
+		LL_ASSERT((ticker_id_prev == 0xff) ||
+			  (ticks_anchor == ticks_anchor_prev));
+
+		/* Consider advertiser time as available. Any other time used
+		 * by tickers declared outside the controller is also
+		 * available.
+		 */
+		if ((ticker_id < TICKER_ID_ULL_BASE) ||
+		    (ticker_id > TICKER_ID_CONN_LAST)) {
+			continue;
+		}
+
+#if defined(CONFIG_BT_OBSERVER)
+		if ((ticker_id >= TICKER_ID_SCAN_BASE) &&
+		    (ticker_id <= TICKER_ID_SCAN_LAST)) {
+			/* Non conn role found which could have preempted a
+			 * conn role, hence do not consider this free space
+			 * and any further as free slot for offset.
+			 */
+			ticker_id_other = ticker_id;
+			continue;
+		}
+#endif /* CONFIG_BT_OBSERVER */
+
+		/* Advertiser and role stop tickers */
+		if (ticker_id < TICKER_ID_CONN_BASE) {
+			continue;
+		}
+
+		/* TODO: handle scanner; for now we exit with as much we
+		 * where able to fill (offsets).
+		 */
+		if (ticker_id_other != 0xFF) {
+			break;
+		}
+
+		conn = ll_conn_get(ticker_id - TICKER_ID_CONN_BASE);
+		if ((conn != conn_curr) && (is_select || !conn->lll.role)) {
+			u32_t ticks_to_expire_normal =
+				ticks_to_expire + ticks_prepare_reduced;
+			u32_t ticks_prepare_reduced_curr = 0U;
+			u32_t ticks_slot_abs_curr;
+
+			ticks_slot_abs_curr =
+				ticks_slot_abs_get(conn,
+						   &ticks_prepare_reduced_curr) +
+				HAL_TICKER_US_TO_TICKS(EVENT_TIES_US + 1250U);
+			ticks_to_expire_normal -= ticks_prepare_reduced_curr;
+
+			if (*ticks_to_offset_next < ticks_to_expire_normal) {
+				if (ticks_to_expire_prev < *ticks_to_offset_next) {
+					ticks_to_expire_prev =
+						*ticks_to_offset_next;
+				}
+
+				/* Report each 1.25 ms step of the gap before
+				 * this connection as a free window offset.
+				 */
+				while ((offset_index < *offset_max) &&
+				       (ticker_ticks_diff_get(
+						ticks_to_expire_normal,
+						ticks_to_expire_prev) >=
+					(ticks_slot_abs_prev +
+					 ticks_slot_abs))) {
+					_win_offset = HAL_TICKER_TICKS_TO_US(
+						ticks_to_expire_prev +
+						ticks_slot_abs_prev) / 1250U;
+					if (_win_offset >= conn_interval) {
+						ticks_to_expire_prev = 0U;
+
+						break;
+					}
+
+					memcpy(win_offset +
+					       (sizeof(u16_t) * offset_index),
+					       &_win_offset, sizeof(u16_t));
+					offset_index++;
+
+					ticks_to_expire_prev +=
+						HAL_TICKER_US_TO_TICKS(1250U);
+				}
+
+				*ticks_to_offset_next = ticks_to_expire_prev;
+
+				if (_win_offset >= conn_interval) {
+					break;
+				}
+			}
+
+			ticks_anchor_prev = ticks_anchor;
+			ticker_id_prev = ticker_id;
+			ticks_to_expire_prev = ticks_to_expire_normal;
+			ticks_slot_abs_prev = ticks_slot_abs_curr;
+		}
+	} while (offset_index < *offset_max);
+
+	if (ticker_id == 0xFF) {
+		if (ticks_to_expire_prev < *ticks_to_offset_next) {
+			ticks_to_expire_prev = *ticks_to_offset_next;
+		}
+
+		while (offset_index < *offset_max) {
+			_win_offset = HAL_TICKER_TICKS_TO_US(
+					ticks_to_expire_prev +
+					ticks_slot_abs_prev) / 1250U;
+			if (_win_offset >= conn_interval) {
+				ticks_to_expire_prev = 0U;
+
+				break;
+			}
+
+			memcpy(win_offset + (sizeof(u16_t) * offset_index),
+			       &_win_offset, sizeof(u16_t));
+			offset_index++;
+
+			ticks_to_expire_prev += HAL_TICKER_US_TO_TICKS(1250U);
+		}
+
+		*ticks_to_offset_next = ticks_to_expire_prev;
+	}
+
+	*offset_max = offset_index;
+}
+#endif /* CONFIG_BT_CTLR_CONN_PARAM_REQ */
+
+static u32_t ticks_slot_abs_get(struct ll_conn *conn,
+				u32_t *ticks_prepare_reduced)
+{
+	u32_t ticks_slot_abs;
+
+#if defined(CONFIG_BT_CTLR_XTAL_ADVANCED)
+	if (conn->evt.ticks_xtal_to_start & XON_BITMASK) {
+		u32_t ticks_prepare_to_start =
+			MAX(conn->evt.ticks_active_to_start,
+			    conn->evt.ticks_preempt_to_start);
+
+		ticks_slot_abs = conn->evt.ticks_xtal_to_start & ~XON_BITMASK;
+		*ticks_prepare_reduced = ticks_slot_abs -
+					 ticks_prepare_to_start;
+	} else
+#endif /* CONFIG_BT_CTLR_XTAL_ADVANCED */
+	{
+		ticks_slot_abs = MAX(conn->evt.ticks_active_to_start,
+				     conn->evt.ticks_xtal_to_start);
+	}
+
+	return ticks_slot_abs + conn->evt.ticks_slot;
+}
+
+static void ticker_op_cb(u32_t status, void *param)
+{
+	*((u32_t volatile *)param) = status;
 }
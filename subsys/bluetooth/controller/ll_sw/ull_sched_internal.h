@@ -10,3 +10,7 @@ void ull_sched_mfy_after_mstr_offset_get(void *param);
 void ull_sched_mfy_free_win_offset_calc(void *param);
 void ull_sched_mfy_win_offset_use(void *param);
 void ull_sched_mfy_win_offset_select(void *param);
+
+void ull_sched_stats_expire(u8_t role, u16_t lazy, u32_t ticks_slot);
+void ull_sched_stats_miss(u8_t role);
+void ull_sched_stats_cancel(void);
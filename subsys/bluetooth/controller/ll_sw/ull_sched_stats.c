@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr.h>
+#include <bluetooth/hci.h>
+
+#include "hal/ticker.h"
+
+#include "ticker/ticker.h"
+
+#include "ll.h"
+
+#include "ull_sched_internal.h"
+
+static struct {
+	struct {
+		u32_t expire;
+		u32_t skip;
+		u32_t miss;
+		u32_t slot_ticks;
+	} role[LL_SCHED_ROLE_MAX];
+	u32_t cancel;
+} stats;
+
+void ll_sched_stats_get(struct ll_sched_stats *s)
+{
+	for (u8_t i = 0U; i < LL_SCHED_ROLE_MAX; i++) {
+		s->role[i].expire = stats.role[i].expire;
+		s->role[i].skip = stats.role[i].skip;
+		s->role[i].miss = stats.role[i].miss;
+		/* Ticks to ms without overflowing the HAL conversion */
+		s->role[i].air_ms = ((u64_t)stats.role[i].slot_ticks *
+				     HAL_TICKER_TICKS_TO_US(1000)) / 1000000U;
+	}
+
+	s->cancel = stats.cancel;
+}
+
+void ll_sched_stats_reset(void)
+{
+	(void)memset(&stats, 0, sizeof(stats));
+}
+
+void ull_sched_stats_expire(u8_t role, u16_t lazy, u32_t ticks_slot)
+{
+	/* Ticker expiry to only enable the adv random delay update */
+	if (lazy == TICKER_LAZY_MUST_EXPIRE) {
+		return;
+	}
+
+	stats.role[role].expire++;
+	stats.role[role].skip += lazy;
+	stats.role[role].slot_ticks += ticks_slot;
+}
+
+void ull_sched_stats_miss(u8_t role)
+{
+	stats.role[role].miss++;
+}
+
+void ull_sched_stats_cancel(void)
+{
+	stats.cancel++;
+}
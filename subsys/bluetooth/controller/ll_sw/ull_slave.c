@@ -34,6 +34,7 @@
 #include "ull_filter.h"
 
 #include "ull_internal.h"
+#include "ull_sched_internal.h"
 #include "ull_adv_internal.h"
 #include "ull_conn_internal.h"
 #include "ull_slave_internal.h"
@@ -350,6 +351,11 @@ void ull_slave_ticker_cb(u32_t ticks_at_expire, u32_t remainder, u16_t lazy,
 
 	DEBUG_RADIO_PREPARE_S(1);
 
+	if (IS_ENABLED(CONFIG_BT_CTLR_SCHED_STATS)) {
+		ull_sched_stats_expire(LL_SCHED_ROLE_SLAVE, lazy,
+				       conn->evt.ticks_slot);
+	}
+
 	/* Handle any LL Control Procedures */
 	ret = ull_conn_llcp(conn, ticks_at_expire, lazy);
 	if (ret) {
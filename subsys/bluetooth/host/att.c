@@ -1927,6 +1927,7 @@ static att_type_t att_op_get_type(u8_t op)
 	case BT_ATT_OP_EXEC_WRITE_RSP:
 		return ATT_RESPONSE;
 	case BT_ATT_OP_NOTIFY:
+	case BT_ATT_OP_NOTIFY_MULT:
 		return ATT_NOTIFICATION;
 	case BT_ATT_OP_INDICATE:
 		return ATT_INDICATION;
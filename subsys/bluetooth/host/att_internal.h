@@ -208,6 +208,14 @@ struct bt_att_notify {
 	u8_t  value[0];
 } __packed;
 
+/* Handle Value Notification for multiple handles */
+#define BT_ATT_OP_NOTIFY_MULT			0x23
+struct bt_att_notify_mult {
+	u16_t handle;
+	u16_t len;
+	u8_t  value[0];
+} __packed;
+
 /* Handle Value Indication */
 #define BT_ATT_OP_INDICATE			0x1d
 struct bt_att_indicate {
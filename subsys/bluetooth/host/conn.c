@@ -386,6 +386,10 @@ static struct bt_conn *conn_new(void)
 	(void)memset(conn, 0, sizeof(*conn));
 	k_delayed_work_init(&conn->update_work, conn_update_timeout);
 
+#if defined(CONFIG_BT_CONN_TX_FAIR)
+	conn->tx_weight = CONFIG_BT_CONN_TX_WEIGHT;
+#endif /* CONFIG_BT_CONN_TX_FAIR */
+
 	k_work_init(&conn->tx_complete_work, tx_complete_work);
 
 	atomic_set(&conn->ref, 1);
@@ -1466,9 +1470,15 @@ static void conn_cleanup(struct bt_conn *conn)
 	k_delayed_work_submit(&conn->update_work, K_NO_WAIT);
 }
 
+#if defined(CONFIG_BT_CONN_TX_FAIR)
+/* Connection polled first, so that the connections take turns */
+static u8_t tx_first;
+#endif /* CONFIG_BT_CONN_TX_FAIR */
+
 int bt_conn_prepare_events(struct k_poll_event events[])
 {
 	int i, ev_count = 0;
+	int first = 0;
 
 	BT_DBG("");
 
@@ -1476,8 +1486,13 @@ int bt_conn_prepare_events(struct k_poll_event events[])
 	k_poll_event_init(&events[ev_count++], K_POLL_TYPE_SIGNAL,
 			  K_POLL_MODE_NOTIFY_ONLY, &conn_change);
 
+#if defined(CONFIG_BT_CONN_TX_FAIR)
+	first = tx_first;
+	tx_first = (tx_first + 1) % ARRAY_SIZE(conns);
+#endif /* CONFIG_BT_CONN_TX_FAIR */
+
 	for (i = 0; i < ARRAY_SIZE(conns); i++) {
-		struct bt_conn *conn = &conns[i];
+		struct bt_conn *conn = &conns[(first + i) % ARRAY_SIZE(conns)];
 
 		if (!atomic_get(&conn->ref)) {
 			continue;
@@ -1518,12 +1533,53 @@ void bt_conn_process_tx(struct bt_conn *conn)
 		return;
 	}
 
+#if defined(CONFIG_BT_CONN_TX_FAIR)
+	/* A connection in debt from a long packet waits for the turns it
+	 * took from the other connections.
+	 */
+	conn->tx_deficit += conn->tx_weight;
+
+	while (conn->tx_deficit > 0) {
+		buf = net_buf_get(&conn->tx_queue, K_NO_WAIT);
+		if (!buf) {
+			/* An idle connection does not save up turns */
+			conn->tx_deficit = 0;
+			break;
+		}
+
+		conn->tx_deficit -= ceiling_fraction(MAX(buf->len, 1),
+						     conn_mtu(conn));
+
+		if (!send_buf(conn, buf)) {
+			net_buf_unref(buf);
+			break;
+		}
+	}
+#else
 	/* Get next ACL packet for connection */
 	buf = net_buf_get(&conn->tx_queue, K_NO_WAIT);
 	BT_ASSERT(buf);
 	if (!send_buf(conn, buf)) {
 		net_buf_unref(buf);
 	}
+#endif /* CONFIG_BT_CONN_TX_FAIR */
+}
+
+int bt_conn_tx_weight_set(struct bt_conn *conn, u8_t weight)
+{
+	if (!IS_ENABLED(CONFIG_BT_CONN_TX_FAIR)) {
+		return -ENOTSUP;
+	}
+
+	if (!weight) {
+		return -EINVAL;
+	}
+
+#if defined(CONFIG_BT_CONN_TX_FAIR)
+	conn->tx_weight = weight;
+#endif /* CONFIG_BT_CONN_TX_FAIR */
+
+	return 0;
 }
 
 struct bt_conn *bt_conn_add_le(u8_t id, const bt_addr_le_t *peer)
@@ -128,6 +128,12 @@ struct bt_conn {
 	/* Queue for outgoing ACL data */
 	struct k_fifo		tx_queue;
 
+#if defined(CONFIG_BT_CONN_TX_FAIR)
+	/* ACL packets sent at each turn, and left to send in this turn */
+	u8_t			tx_weight;
+	s16_t			tx_deficit;
+#endif /* CONFIG_BT_CONN_TX_FAIR */
+
 	/* Active L2CAP channels */
 	sys_slist_t		channels;
 
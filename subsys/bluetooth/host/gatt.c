@@ -70,6 +70,33 @@ static sys_slist_t db;
 
 static atomic_t init;
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+/* Attributes by handle, static attributes do not have their handle set */
+static const struct bt_gatt_attr *attr_index[CONFIG_BT_GATT_ATTR_INDEX_SIZE];
+
+static void attr_index_set(u16_t handle, const struct bt_gatt_attr *attr)
+{
+	if (handle && handle <= ARRAY_SIZE(attr_index)) {
+		attr_index[handle - 1] = attr;
+	}
+}
+
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+static void attr_index_set_svc(struct bt_gatt_service *svc, bool add)
+{
+	int i;
+
+	for (i = 0; i < svc->attr_count; i++) {
+		attr_index_set(svc->attrs[i].handle,
+			       add ? &svc->attrs[i] : NULL);
+	}
+}
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+#else
+#define attr_index_set(...)
+#define attr_index_set_svc(...)
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 static ssize_t read_name(struct bt_conn *conn, const struct bt_gatt_attr *attr,
 			 void *buf, u16_t len, u16_t offset)
 {
@@ -231,7 +258,7 @@ static void sc_store(struct gatt_sc_cfg *cfg)
 				       &cfg->peer, NULL);
 	}
 
-	err = settings_save_one(key, (char *)&cfg->data, sizeof(cfg->data));
+	err = bt_settings_store(key, (char *)&cfg->data, sizeof(cfg->data));
 	if (err) {
 		BT_ERR("failed to store SC (err %d)", err);
 		return;
@@ -268,7 +295,7 @@ static void sc_clear(struct gatt_sc_cfg *cfg)
 						       &cfg->peer, NULL);
 			}
 
-			err = settings_delete(key);
+			err = bt_settings_delete(key);
 			if (err) {
 				BT_ERR("failed to delete SC (err %d)", err);
 			} else {
@@ -390,6 +417,13 @@ enum {
 };
 
 #define CF_ROBUST_CACHING(_cfg) (_cfg->data[0] & BIT(0))
+#define CF_NOTIFY_MULTI(_cfg) (_cfg->data[0] & BIT(2))
+
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+#define CF_SUPPORTED_BITS (BIT(0) | BIT(2))
+#else
+#define CF_SUPPORTED_BITS BIT(0)
+#endif
 
 struct gatt_cf_cfg {
 	u8_t                    id;
@@ -437,7 +471,7 @@ static bool cf_set_value(struct gatt_cf_cfg *cfg, const u8_t *value, u16_t len)
 {
 	u16_t i;
 	u8_t last_byte = 1U;
-	u8_t last_bit = 1U;
+	u8_t last_bit = IS_ENABLED(CONFIG_BT_GATT_NOTIFY_MULTIPLE) ? 3U : 1U;
 
 	/* Validate the bits */
 	for (i = 0U; i < len && i < last_byte; i++) {
@@ -455,7 +489,7 @@ static bool cf_set_value(struct gatt_cf_cfg *cfg, const u8_t *value, u16_t len)
 
 	/* Set the bits for each octect */
 	for (i = 0U; i < len && i < last_byte; i++) {
-		cfg->data[i] |= value[i] & ((1 << last_bit) - 1);
+		cfg->data[i] |= value[i] & CF_SUPPORTED_BITS;
 		BT_DBG("byte %u: data 0x%02x value 0x%02x", i, cfg->data[i],
 		       value[i]);
 	}
@@ -585,7 +619,7 @@ static void db_hash_store(void)
 {
 	int err;
 
-	err = settings_save_one("bt/hash", &db_hash, sizeof(db_hash));
+	err = bt_settings_store("bt/hash", &db_hash, sizeof(db_hash));
 	if (err) {
 		BT_ERR("Failed to save Database Hash (err %d)", err);
 	}
@@ -792,6 +826,7 @@ populate:
 	}
 
 	gatt_insert(svc, last_handle);
+	attr_index_set_svc(svc, true);
 
 	return 0;
 }
@@ -934,7 +969,9 @@ void bt_gatt_init(void)
 	}
 
 	Z_STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
-		last_static_handle += svc->attr_count;
+		for (int i = 0; i < svc->attr_count; i++) {
+			attr_index_set(++last_static_handle, &svc->attrs[i]);
+		}
 	}
 
 #if defined(CONFIG_BT_GATT_CACHING)
@@ -1058,6 +1095,8 @@ int bt_gatt_service_unregister(struct bt_gatt_service *svc)
 		return -ENOENT;
 	}
 
+	attr_index_set_svc(svc, false);
+
 	sc_indicate(svc->attrs[0].handle,
 		    svc->attrs[svc->attr_count - 1].handle);
 
@@ -1316,6 +1355,43 @@ void bt_gatt_foreach_attr_type(u16_t start_handle, u16_t end_handle,
 		num_matches = UINT16_MAX;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	/* The index is filled in at init */
+	if (atomic_get(&init) && start_handle <= ARRAY_SIZE(attr_index)) {
+		int handle = MAX(start_handle, 1);
+
+		for (; handle <= MIN(end_handle, ARRAY_SIZE(attr_index));
+		     handle++) {
+			const struct bt_gatt_attr *found = attr_index[handle - 1];
+			struct bt_gatt_attr attr;
+
+			if (!found) {
+				continue;
+			}
+
+			if (handle <= last_static_handle) {
+				memcpy(&attr, found, sizeof(attr));
+				attr.handle = handle;
+				found = &attr;
+			}
+
+			if (gatt_foreach_iter(found, start_handle, end_handle,
+					      uuid, attr_data, &num_matches,
+					      func, user_data) ==
+			    BT_GATT_ITER_STOP) {
+				return;
+			}
+		}
+
+		if (end_handle <= ARRAY_SIZE(attr_index)) {
+			return;
+		}
+
+		/* Walk the services for the handles past the index */
+		start_handle = ARRAY_SIZE(attr_index) + 1;
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	if (start_handle <= last_static_handle) {
 		u16_t handle = 1;
 
@@ -1757,26 +1833,12 @@ static u8_t match_uuid(const struct bt_gatt_attr *attr, void *user_data)
 	return BT_GATT_ITER_STOP;
 }
 
-int bt_gatt_notify_cb(struct bt_conn *conn,
-		      struct bt_gatt_notify_params *params)
+/* Returns the handle of the value to notify */
+static int notify_get_handle(struct bt_gatt_notify_params *params)
 {
-	struct notify_data data;
-	const struct bt_gatt_attr *attr;
+	const struct bt_gatt_attr *attr = params->attr;
 	u16_t handle;
 
-	__ASSERT(params, "invalid parameters\n");
-	__ASSERT(params->attr, "invalid parameters\n");
-
-	if (!atomic_test_bit(bt_dev.flags, BT_DEV_READY)) {
-		return -EAGAIN;
-	}
-
-	attr = params->attr;
-
-	if (conn && conn->state != BT_CONN_CONNECTED) {
-		return -ENOTCONN;
-	}
-
 	handle = attr->handle ? : find_static_attr(attr);
 	if (!handle) {
 		return -ENOENT;
@@ -1809,6 +1871,31 @@ int bt_gatt_notify_cb(struct bt_conn *conn,
 		handle = bt_gatt_attr_value_handle(attr);
 	}
 
+	return handle;
+}
+
+int bt_gatt_notify_cb(struct bt_conn *conn,
+		      struct bt_gatt_notify_params *params)
+{
+	struct notify_data data;
+	int handle;
+
+	__ASSERT(params, "invalid parameters\n");
+	__ASSERT(params->attr, "invalid parameters\n");
+
+	if (!atomic_test_bit(bt_dev.flags, BT_DEV_READY)) {
+		return -EAGAIN;
+	}
+
+	if (conn && conn->state != BT_CONN_CONNECTED) {
+		return -ENOTCONN;
+	}
+
+	handle = notify_get_handle(params);
+	if (handle < 0) {
+		return handle;
+	}
+
 	if (conn) {
 		return gatt_notify(conn, handle, params);
 	}
@@ -1823,6 +1910,246 @@ int bt_gatt_notify_cb(struct bt_conn *conn,
 	return data.err;
 }
 
+/* Notifications of a bt_gatt_notify_multiple() call waiting to be sent to
+ * a peer. The first one is kept aside until a second one can be packed
+ * with it, a Multiple Handle Value Notification has at least two values.
+ */
+struct notify_mult_pending {
+	struct bt_conn *conn;
+	struct bt_gatt_notify_params *first;
+	u16_t handle;
+	struct net_buf *buf;
+};
+
+struct notify_mult_data {
+	int err;
+	u16_t handle;
+	struct bt_gatt_notify_params *params;
+	struct notify_mult_pending pending[CONFIG_BT_MAX_CONN];
+};
+
+static int notify_mult_flush(struct notify_mult_pending *pending)
+{
+	int err;
+
+	if (!pending->conn) {
+		return 0;
+	}
+
+	if (pending->buf) {
+		err = bt_att_send(pending->conn, pending->buf,
+				  pending->first->func,
+				  pending->first->user_data);
+	} else {
+		err = gatt_notify(pending->conn, pending->handle,
+				  pending->first);
+	}
+
+	bt_conn_unref(pending->conn);
+	(void)memset(pending, 0, sizeof(*pending));
+
+	return err;
+}
+
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+static bool notify_mult_supported(struct bt_conn *conn)
+{
+	struct gatt_cf_cfg *cfg = find_cf_cfg(conn);
+
+	return cfg && CF_NOTIFY_MULTI(cfg);
+}
+
+static void notify_mult_add(struct net_buf *buf, u16_t handle,
+			    struct bt_gatt_notify_params *params)
+{
+	struct bt_att_notify_mult *nfy;
+
+	nfy = net_buf_add(buf, sizeof(*nfy));
+	nfy->handle = sys_cpu_to_le16(handle);
+	nfy->len = sys_cpu_to_le16(params->len);
+
+	net_buf_add_mem(buf, params->data, params->len);
+}
+
+static int notify_mult_pack(struct notify_mult_pending *pending, u16_t handle,
+			    struct bt_gatt_notify_params *params)
+{
+	size_t len;
+
+	if (pending->first->func != params->func ||
+	    pending->first->user_data != params->user_data) {
+		return -EINVAL;
+	}
+
+	len = pending->buf ? pending->buf->len :
+	      1 + sizeof(struct bt_att_notify_mult) + pending->first->len;
+	len += sizeof(struct bt_att_notify_mult) + params->len;
+
+	if (len > bt_att_get_mtu(pending->conn)) {
+		return -EMSGSIZE;
+	}
+
+	if (!pending->buf) {
+		pending->buf = bt_att_create_pdu(pending->conn,
+						 BT_ATT_OP_NOTIFY_MULT,
+						 len - 1);
+		if (!pending->buf) {
+			return -ENOMEM;
+		}
+
+		notify_mult_add(pending->buf, pending->handle, pending->first);
+	}
+
+	notify_mult_add(pending->buf, handle, params);
+
+	return 0;
+}
+#endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
+
+static int notify_mult_queue(struct notify_mult_data *data,
+			     struct bt_conn *conn)
+{
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+	struct notify_mult_pending *pending;
+	int err;
+
+	if (!notify_mult_supported(conn)) {
+		return gatt_notify(conn, data->handle, data->params);
+	}
+
+#if defined(CONFIG_BT_GATT_ENFORCE_CHANGE_UNAWARE)
+	if (!bt_gatt_change_aware(conn, false)) {
+		return -EAGAIN;
+	}
+#endif
+
+	pending = &data->pending[bt_conn_index(conn)];
+
+	if (pending->conn &&
+	    !notify_mult_pack(pending, data->handle, data->params)) {
+		return 0;
+	}
+
+	/* Send what could not be packed with this value */
+	err = notify_mult_flush(pending);
+	if (err < 0) {
+		return err;
+	}
+
+	pending->conn = bt_conn_ref(conn);
+	pending->first = data->params;
+	pending->handle = data->handle;
+
+	return 0;
+#else
+	return gatt_notify(conn, data->handle, data->params);
+#endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
+}
+
+static u8_t notify_mult_cb(const struct bt_gatt_attr *attr, void *user_data)
+{
+	struct notify_mult_data *data = user_data;
+	struct _bt_gatt_ccc *ccc;
+	size_t i;
+
+	if (attr->write != bt_gatt_attr_write_ccc) {
+		return BT_GATT_ITER_CONTINUE;
+	}
+
+	ccc = attr->user_data;
+
+	for (i = 0; i < ARRAY_SIZE(ccc->cfg); i++) {
+		struct bt_gatt_ccc_cfg *cfg = &ccc->cfg[i];
+		struct bt_conn *conn;
+		int err;
+
+		if (cfg->value != BT_GATT_CCC_NOTIFY) {
+			continue;
+		}
+
+		conn = bt_conn_lookup_addr_le(cfg->id, &cfg->peer);
+		if (!conn) {
+			continue;
+		}
+
+		if (conn->state != BT_CONN_CONNECTED ||
+		    (ccc->cfg_match && !ccc->cfg_match(conn, attr))) {
+			bt_conn_unref(conn);
+			continue;
+		}
+
+		err = notify_mult_queue(data, conn);
+
+		bt_conn_unref(conn);
+
+		if (err < 0) {
+			data->err = err;
+			return BT_GATT_ITER_STOP;
+		}
+
+		if (data->err == -ENOTCONN) {
+			data->err = 0;
+		}
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+int bt_gatt_notify_multiple(struct bt_conn *conn, u16_t num_params,
+			    struct bt_gatt_notify_params *params)
+{
+	struct notify_mult_data data;
+	int handle, err;
+	u16_t i;
+
+	__ASSERT(params, "invalid parameters\n");
+
+	if (!atomic_test_bit(bt_dev.flags, BT_DEV_READY)) {
+		return -EAGAIN;
+	}
+
+	if (conn && conn->state != BT_CONN_CONNECTED) {
+		return -ENOTCONN;
+	}
+
+	(void)memset(&data, 0, sizeof(data));
+	data.err = -ENOTCONN;
+
+	for (i = 0; i < num_params; i++) {
+		__ASSERT(params[i].attr, "invalid parameters\n");
+
+		handle = notify_get_handle(&params[i]);
+		if (handle < 0) {
+			data.err = handle;
+			break;
+		}
+
+		data.handle = handle;
+		data.params = &params[i];
+
+		if (conn) {
+			data.err = notify_mult_queue(&data, conn);
+		} else {
+			bt_gatt_foreach_attr_type(handle, 0xffff,
+						  BT_UUID_GATT_CCC, NULL, 1,
+						  notify_mult_cb, &data);
+		}
+
+		if (data.err < 0 && data.err != -ENOTCONN) {
+			break;
+		}
+	}
+
+	for (i = 0; i < ARRAY_SIZE(data.pending); i++) {
+		err = notify_mult_flush(&data.pending[i]);
+		if (err < 0 && data.err >= 0) {
+			data.err = err;
+		}
+	}
+
+	return data.err;
+}
+
 int bt_gatt_indicate(struct bt_conn *conn,
 		     struct bt_gatt_indicate_params *params)
 {
@@ -3801,6 +4128,9 @@ void bt_gatt_connected(struct bt_conn *conn)
 					       &conn->le.dst, NULL);
 		}
 
+		/* Pending CCC writes must be in the storage to be loaded */
+		bt_settings_store_flush();
+
 		settings_load_subtree_direct(key, ccc_set_direct, (void *)key);
 	}
 
@@ -3921,7 +4251,7 @@ static int bt_gatt_store_cf(struct bt_conn *conn)
 				       &conn->le.dst, NULL);
 	}
 
-	err = settings_save_one(key, str, len);
+	err = bt_settings_store(key, str, len);
 	if (err) {
 		BT_ERR("Failed to store Client Features (err %d)", err);
 		return err;
@@ -4032,7 +4362,7 @@ int bt_gatt_store_ccc(u8_t id, const bt_addr_le_t *addr)
 		len = 0;
 	}
 
-	err = settings_save_one(key, str, len);
+	err = bt_settings_store(key, str, len);
 	if (err) {
 		BT_ERR("Failed to store CCCs (err %d)", err);
 		return err;
@@ -4097,7 +4427,7 @@ static int bt_gatt_clear_ccc(u8_t id, const bt_addr_le_t *addr)
 	bt_gatt_foreach_attr(0x0001, 0xffff, remove_peer_from_attr,
 			     &addr_with_id);
 
-	return settings_delete(key);
+	return bt_settings_delete(key);
 }
 
 #if defined(CONFIG_BT_GATT_CACHING)
@@ -4137,7 +4467,7 @@ static int bt_gatt_clear_cf(u8_t id, const bt_addr_le_t *addr)
 		clear_cf_cfg(cfg);
 	}
 
-	return settings_delete(key);
+	return bt_settings_delete(key);
 #endif /* CONFIG_BT_GATT_CACHING */
 	return 0;
 
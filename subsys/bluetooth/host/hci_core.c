@@ -83,6 +83,27 @@ static bt_ready_cb_t ready_cb;
 
 static bt_le_scan_cb_t *scan_dev_found_cb;
 
+#if defined(CONFIG_BT_SCAN_FILTER)
+static struct {
+	bool enabled;
+	bool use_addr;
+	bool use_uuid;
+	bool use_rssi;
+	bool dup;
+	s8_t rssi_min;
+	u8_t uuid_len;
+	bt_addr_le_t addr;
+	union {
+		struct bt_uuid uuid;
+		struct bt_uuid_16 u16;
+		struct bt_uuid_32 u32;
+		struct bt_uuid_128 u128;
+	} uuid;
+	/* Hashes of the reports given to the application, 0 if unused */
+	u32_t dup_cache[CONFIG_BT_SCAN_FILTER_DUP_CACHE_SIZE];
+} scan_filter;
+#endif /* CONFIG_BT_SCAN_FILTER */
+
 #if defined(CONFIG_BT_HCI_VS_EVT_USER)
 static bt_hci_vnd_evt_cb_t *hci_vnd_evt_cb;
 #endif /* CONFIG_BT_HCI_VS_EVT_USER */
@@ -3605,6 +3626,181 @@ void bt_data_parse(struct net_buf_simple *ad,
 	}
 }
 
+#if defined(CONFIG_BT_SCAN_FILTER)
+struct scan_filter_uuid_data {
+	u8_t uuid_len;
+	bool found;
+};
+
+static bool scan_filter_uuid_cb(struct bt_data *data, void *user_data)
+{
+	struct scan_filter_uuid_data *match = user_data;
+	union {
+		struct bt_uuid uuid;
+		struct bt_uuid_16 u16;
+		struct bt_uuid_32 u32;
+		struct bt_uuid_128 u128;
+	} uuid;
+	u8_t len;
+
+	switch (data->type) {
+	case BT_DATA_UUID16_SOME:
+	case BT_DATA_UUID16_ALL:
+		len = 2U;
+		break;
+	case BT_DATA_UUID32_SOME:
+	case BT_DATA_UUID32_ALL:
+		len = 4U;
+		break;
+	case BT_DATA_UUID128_SOME:
+	case BT_DATA_UUID128_ALL:
+		len = 16U;
+		break;
+	default:
+		return true;
+	}
+
+	/* Compare as the advertised size only, bt_uuid_cmp() would widen
+	 * each entry to 128 bits otherwise.
+	 */
+	if (len != match->uuid_len) {
+		return true;
+	}
+
+	for (u8_t i = 0U; i + len <= data->data_len; i += len) {
+		if (!bt_uuid_create(&uuid.uuid, &data->data[i], len)) {
+			continue;
+		}
+
+		if (!bt_uuid_cmp(&uuid.uuid, &scan_filter.uuid.uuid)) {
+			match->found = true;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static u32_t scan_filter_hash(const bt_addr_le_t *addr, u8_t evt_type,
+			      const u8_t *data, u8_t len)
+{
+	/* FNV-1a */
+	u32_t hash = 2166136261U;
+	const u8_t *p = (const u8_t *)addr;
+
+	for (size_t i = 0; i < sizeof(*addr); i++) {
+		hash = (hash ^ p[i]) * 16777619U;
+	}
+
+	hash = (hash ^ evt_type) * 16777619U;
+
+	for (u8_t i = 0U; i < len; i++) {
+		hash = (hash ^ data[i]) * 16777619U;
+	}
+
+	/* 0 marks an unused cache entry */
+	return hash ? hash : 1U;
+}
+
+static bool scan_filter_match(const bt_addr_le_t *addr, s8_t rssi,
+			      u8_t evt_type, struct net_buf_simple *ad)
+{
+	if (!scan_filter.enabled) {
+		return true;
+	}
+
+	if (scan_filter.use_rssi &&
+	    ((rssi == (s8_t)BT_HCI_LE_RSSI_NOT_AVAILABLE) ||
+	     (rssi < scan_filter.rssi_min))) {
+		return false;
+	}
+
+	if (scan_filter.use_addr && bt_addr_le_cmp(addr, &scan_filter.addr)) {
+		return false;
+	}
+
+	if (scan_filter.use_uuid) {
+		struct scan_filter_uuid_data match = {
+			.uuid_len = scan_filter.uuid_len,
+		};
+		struct net_buf_simple_state state;
+
+		net_buf_simple_save(ad, &state);
+		bt_data_parse(ad, scan_filter_uuid_cb, &match);
+		net_buf_simple_restore(ad, &state);
+
+		if (!match.found) {
+			return false;
+		}
+	}
+
+	if (scan_filter.dup) {
+		u32_t hash = scan_filter_hash(addr, evt_type, ad->data,
+					      ad->len);
+		u32_t *entry = &scan_filter.dup_cache[hash %
+					ARRAY_SIZE(scan_filter.dup_cache)];
+
+		if (*entry == hash) {
+			return false;
+		}
+
+		*entry = hash;
+	}
+
+	return true;
+}
+
+int bt_le_scan_filter_set(const struct bt_le_scan_filter *filter)
+{
+	if (!filter) {
+		scan_filter.enabled = false;
+		return 0;
+	}
+
+	if (filter->uuid) {
+		switch (filter->uuid->type) {
+		case BT_UUID_TYPE_16:
+			memcpy(&scan_filter.uuid, filter->uuid,
+			       sizeof(struct bt_uuid_16));
+			scan_filter.uuid_len = 2U;
+			break;
+		case BT_UUID_TYPE_32:
+			memcpy(&scan_filter.uuid, filter->uuid,
+			       sizeof(struct bt_uuid_32));
+			scan_filter.uuid_len = 4U;
+			break;
+		case BT_UUID_TYPE_128:
+			memcpy(&scan_filter.uuid, filter->uuid,
+			       sizeof(struct bt_uuid_128));
+			scan_filter.uuid_len = 16U;
+			break;
+		default:
+			return -EINVAL;
+		}
+	}
+
+	scan_filter.use_uuid = filter->uuid != NULL;
+	scan_filter.use_addr = filter->addr != NULL;
+	if (filter->addr) {
+		bt_addr_le_copy(&scan_filter.addr, filter->addr);
+	}
+
+	scan_filter.use_rssi = filter->use_rssi;
+	scan_filter.rssi_min = filter->rssi_min;
+	scan_filter.dup = filter->dup;
+	(void)memset(scan_filter.dup_cache, 0, sizeof(scan_filter.dup_cache));
+	scan_filter.enabled = true;
+
+	return 0;
+}
+#else
+static inline bool scan_filter_match(const bt_addr_le_t *addr, s8_t rssi,
+				     u8_t evt_type, struct net_buf_simple *ad)
+{
+	return true;
+}
+#endif /* CONFIG_BT_SCAN_FILTER */
+
 static void le_adv_report(struct net_buf *buf)
 {
 	u8_t num_reports = net_buf_pull_u8(buf);
@@ -3644,8 +3840,11 @@ static void le_adv_report(struct net_buf *buf)
 			net_buf_simple_save(&buf->b, &state);
 
 			buf->len = info->length;
-			scan_dev_found_cb(&id_addr, rssi, info->evt_type,
-					  &buf->b);
+			if (scan_filter_match(&id_addr, rssi, info->evt_type,
+					      &buf->b)) {
+				scan_dev_found_cb(&id_addr, rssi,
+						  info->evt_type, &buf->b);
+			}
 
 			net_buf_simple_restore(&buf->b, &state);
 		}
@@ -4871,6 +5070,22 @@ int bt_send(struct net_buf *buf)
 	return bt_dev.drv->send(buf);
 }
 
+#if !defined(CONFIG_BT_RECV_IS_RX_THREAD)
+#if defined(CONFIG_BT_RECV_ACL_DIRECT)
+/* Buffers put in the RX queue and not processed yet */
+static atomic_t rx_queued;
+#endif /* CONFIG_BT_RECV_ACL_DIRECT */
+
+static void rx_queue_put(struct net_buf *buf)
+{
+#if defined(CONFIG_BT_RECV_ACL_DIRECT)
+	atomic_inc(&rx_queued);
+#endif /* CONFIG_BT_RECV_ACL_DIRECT */
+
+	net_buf_put(&bt_dev.rx_queue, buf);
+}
+#endif /* !CONFIG_BT_RECV_IS_RX_THREAD */
+
 int bt_recv(struct net_buf *buf)
 {
 	bt_monitor_send(bt_monitor_opcode(buf), buf->data, buf->len);
@@ -4883,7 +5098,14 @@ int bt_recv(struct net_buf *buf)
 #if defined(CONFIG_BT_RECV_IS_RX_THREAD)
 		hci_acl(buf);
 #else
-		net_buf_put(&bt_dev.rx_queue, buf);
+#if defined(CONFIG_BT_RECV_ACL_DIRECT)
+		/* Skip the RX thread when it has nothing left to process */
+		if (!k_is_in_isr() && !atomic_get(&rx_queued)) {
+			hci_acl(buf);
+			return 0;
+		}
+#endif /* CONFIG_BT_RECV_ACL_DIRECT */
+		rx_queue_put(buf);
 #endif
 		return 0;
 #endif /* BT_CONN */
@@ -4891,7 +5113,7 @@ int bt_recv(struct net_buf *buf)
 #if defined(CONFIG_BT_RECV_IS_RX_THREAD)
 		hci_event(buf);
 #else
-		net_buf_put(&bt_dev.rx_queue, buf);
+		rx_queue_put(buf);
 #endif
 		return 0;
 	default:
@@ -5063,6 +5285,10 @@ static void hci_rx_thread(void)
 			break;
 		}
 
+#if defined(CONFIG_BT_RECV_ACL_DIRECT)
+		atomic_dec(&rx_queued);
+#endif /* CONFIG_BT_RECV_ACL_DIRECT */
+
 		/* Make sure we don't hog the CPU if the rx_queue never
 		 * gets empty.
 		 */
@@ -5215,7 +5441,7 @@ int bt_set_name(const char *name)
 	}
 
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
-		err = settings_save_one("bt/name", bt_dev.name, len);
+		err = bt_settings_store("bt/name", bt_dev.name, len);
 		if (err) {
 			BT_WARN("Unable to store name");
 		}
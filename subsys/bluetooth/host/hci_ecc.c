@@ -58,6 +58,7 @@ static const u8_t debug_public_key[64] = {
 enum {
 	PENDING_PUB_KEY,
 	PENDING_DHKEY,
+	NEXT_KEY_READY,
 
 	/* Total number of flags - must be at the end of the enum */
 	NUM_FLAGS,
@@ -76,6 +77,16 @@ static struct {
 	};
 } ecc;
 
+#define ECC_THREAD_PRIO K_PRIO_PREEMPT(10)
+
+#if defined(CONFIG_BT_TINYCRYPT_ECC_PRECOMPUTE)
+/* Key pair generated ahead of time, valid with NEXT_KEY_READY */
+static struct {
+	u8_t private_key[32];
+	u8_t pk[64];
+} next_key;
+#endif
+
 static void send_cmd_status(u16_t opcode, u8_t status)
 {
 	struct bt_hci_evt_cmd_status *evt;
@@ -99,26 +110,45 @@ static void send_cmd_status(u16_t opcode, u8_t status)
 	bt_recv_prio(buf);
 }
 
-static u8_t generate_keys(void)
-{
 #if !defined(CONFIG_BT_USE_DEBUG_KEYS)
+static u8_t make_key(u8_t *pk, u8_t *private_key)
+{
 	do {
 		int rc;
 
-		rc = uECC_make_key(ecc.pk, ecc.private_key, &curve_secp256r1);
+		rc = uECC_make_key(pk, private_key, &curve_secp256r1);
 		if (rc == TC_CRYPTO_FAIL) {
 			BT_ERR("Failed to create ECC public/private pair");
 			return BT_HCI_ERR_UNSPECIFIED;
 		}
 
 	/* make sure generated key isn't debug key */
-	} while (memcmp(ecc.private_key, debug_private_key, 32) == 0);
+	} while (memcmp(private_key, debug_private_key, 32) == 0);
+
+	return 0;
+}
+#endif
+
+static u8_t generate_keys(void)
+{
+#if defined(CONFIG_BT_TINYCRYPT_ECC_PRECOMPUTE)
+	if (atomic_test_and_clear_bit(flags, NEXT_KEY_READY)) {
+		memcpy(ecc.private_key, next_key.private_key,
+		       sizeof(ecc.private_key));
+		memcpy(ecc.pk, next_key.pk, sizeof(ecc.pk));
+		return 0;
+	}
+#endif
+
+#if !defined(CONFIG_BT_USE_DEBUG_KEYS)
+	return make_key(ecc.pk, ecc.private_key);
 #else
 	sys_memcpy_swap(&ecc.pk, debug_public_key, 32);
 	sys_memcpy_swap(&ecc.pk[32], &debug_public_key[32], 32);
 	sys_memcpy_swap(ecc.private_key, debug_private_key, 32);
-#endif
+
 	return 0;
+#endif
 }
 
 static void emulate_le_p256_public_key_cmd(void)
@@ -204,9 +234,49 @@ static void emulate_le_generate_dhkey(void)
 	bt_recv(buf);
 }
 
+#if defined(CONFIG_BT_TINYCRYPT_ECC_PRECOMPUTE)
+/* Generates the next key pair with idle time, unless a command is pending.
+ * Commands raise the thread priority back to finish it early.
+ */
+static void precompute_key(void)
+{
+	if (atomic_test_bit(flags, NEXT_KEY_READY)) {
+		return;
+	}
+
+	k_thread_priority_set(k_current_get(),
+			      K_LOWEST_APPLICATION_THREAD_PRIO);
+
+	/* Checked once the priority is lowered, so that a command given
+	 * from now on raises it back.
+	 */
+	if (!k_sem_count_get(&cmd_sem) &&
+	    !make_key(next_key.pk, next_key.private_key)) {
+		atomic_set_bit(flags, NEXT_KEY_READY);
+	}
+
+	k_thread_priority_set(k_current_get(), ECC_THREAD_PRIO);
+}
+
+static void cmd_pending(void)
+{
+	k_thread_priority_set(&ecc_thread_data, ECC_THREAD_PRIO);
+	k_sem_give(&cmd_sem);
+}
+#else
+#define precompute_key(...)
+
+static void cmd_pending(void)
+{
+	k_sem_give(&cmd_sem);
+}
+#endif
+
 static void ecc_thread(void *p1, void *p2, void *p3)
 {
 	while (true) {
+		precompute_key();
+
 		k_sem_take(&cmd_sem, K_FOREVER);
 
 		if (atomic_test_bit(flags, PENDING_PUB_KEY)) {
@@ -261,7 +331,7 @@ static void le_gen_dhkey(struct net_buf *buf)
 	 */
 	sys_memcpy_swap(ecc.pk, cmd->key, 32);
 	sys_memcpy_swap(&ecc.pk[32], &cmd->key[32], 32);
-	k_sem_give(&cmd_sem);
+	cmd_pending();
 	status = BT_HCI_ERR_SUCCESS;
 
 send_status:
@@ -280,7 +350,7 @@ static void le_p256_pub_key(struct net_buf *buf)
 	} else if (atomic_test_and_set_bit(flags, PENDING_PUB_KEY)) {
 		status = BT_HCI_ERR_CMD_DISALLOWED;
 	} else {
-		k_sem_give(&cmd_sem);
+		cmd_pending();
 		status = BT_HCI_ERR_SUCCESS;
 	}
 
@@ -321,6 +391,6 @@ void bt_hci_ecc_init(void)
 {
 	k_thread_create(&ecc_thread_data, ecc_thread_stack,
 			K_THREAD_STACK_SIZEOF(ecc_thread_stack), ecc_thread,
-			NULL, NULL, NULL, K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+			NULL, NULL, NULL, ECC_THREAD_PRIO, 0, K_NO_WAIT);
 	k_thread_name_set(&ecc_thread_data, "BT ECC");
 }
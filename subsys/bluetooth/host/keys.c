@@ -257,7 +257,7 @@ void bt_keys_clear(struct bt_keys *keys)
 		}
 
 		BT_DBG("Deleting key %s", log_strdup(key));
-		settings_delete(key);
+		bt_settings_delete(key);
 	}
 
 	(void)memset(keys, 0, sizeof(*keys));
@@ -298,7 +298,7 @@ int bt_keys_store(struct bt_keys *keys)
 				       NULL);
 	}
 
-	err = settings_save_one(key, keys->storage_start, BT_KEYS_STORAGE_LEN);
+	err = bt_settings_store(key, keys->storage_start, BT_KEYS_STORAGE_LEN);
 	if (err) {
 		BT_ERR("Failed to save keys (err %d)", err);
 		return err;
@@ -720,6 +720,7 @@ static void l2cap_chan_rx_init(struct bt_l2cap_le_chan *chan)
 	 */
 	chan->rx.mps = MIN(chan->rx.mtu + 2, L2CAP_MAX_LE_MPS);
 	k_sem_init(&chan->rx.credits, 0, UINT_MAX);
+	atomic_clear(&chan->_credits);
 
 	if (BT_DBG_ENABLED &&
 	    chan->rx.init_credits * chan->rx.mps < chan->rx.mtu + 2) {
@@ -1267,7 +1268,8 @@ static void l2cap_chan_seg_sent(struct bt_conn *conn, void *user_data)
  * be sent later.
  */
 static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch,
-			      struct net_buf *buf, u16_t sdu_hdr_len)
+			      struct net_buf *buf, u16_t sdu_hdr_len,
+			      bool more)
 {
 	struct net_buf *seg;
 	struct net_buf_simple_state state;
@@ -1293,10 +1295,10 @@ static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch,
 
 	len = seg->len - sdu_hdr_len;
 
-	/* Set a callback if there is no data left in the buffer and sent
+	/* Set a callback if there is no data left in the SDU and sent
 	 * callback has been set.
 	 */
-	if ((buf == seg || !buf->len) && ch->chan.ops->sent) {
+	if (!more && (buf == seg || !buf->len) && ch->chan.ops->sent) {
 		err = bt_l2cap_send_cb(ch->chan.conn, ch->tx.cid, seg,
 				       l2cap_chan_sdu_sent, &ch->chan);
 	} else {
@@ -1334,7 +1336,7 @@ static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 				  struct net_buf **buf, u16_t sent)
 {
 	int ret, total_len;
-	struct net_buf *frag;
+	struct net_buf *frag, *next;
 
 	total_len = net_buf_frags_len(*buf) + sent;
 
@@ -1349,7 +1351,8 @@ static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 
 	if (!sent) {
 		/* Add SDU length for the first segment */
-		ret = l2cap_chan_le_send(ch, frag, BT_L2CAP_SDU_HDR_LEN);
+		ret = l2cap_chan_le_send(ch, frag, BT_L2CAP_SDU_HDR_LEN,
+					 frag->frags != NULL);
 		if (ret < 0) {
 			if (ret == -EAGAIN) {
 				/* Store sent data into user_data */
@@ -1368,8 +1371,22 @@ static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 			frag = net_buf_frag_del(NULL, frag);
 		}
 
-		ret = l2cap_chan_le_send(ch, frag, 0);
+		/* A fragment fitting a segment is sent as is, detached from
+		 * the following ones, instead of being copied.
+		 */
+		next = NULL;
+		if (frag->frags && frag->len <= ch->tx.mps &&
+		    net_buf_headroom(frag) >= BT_L2CAP_CHAN_SEND_RESERVE) {
+			next = frag->frags;
+			frag->frags = NULL;
+		}
+
+		ret = l2cap_chan_le_send(ch, frag, 0, next || frag->frags);
 		if (ret < 0) {
+			if (next) {
+				frag->frags = next;
+			}
+
 			if (ret == -EAGAIN) {
 				/* Store sent data into user_data */
 				data_sent(frag)->len = sent;
@@ -1377,6 +1394,11 @@ static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 			*buf = frag;
 			return ret;
 		}
+
+		if (next) {
+			net_buf_unref(frag);
+			frag = next;
+		}
 	}
 
 	BT_DBG("ch %p cid 0x%04x sent %u total_len %u", ch, ch->tx.cid, sent,
@@ -1586,6 +1608,24 @@ static void l2cap_chan_send_credits(struct bt_l2cap_le_chan *chan,
 	BT_DBG("chan %p credits %u", chan, k_sem_count_get(&chan->rx.credits));
 }
 
+/* Gives back the credits of received packets in batches */
+static void l2cap_chan_return_credits(struct bt_l2cap_le_chan *chan,
+				      struct net_buf *buf, u16_t credits)
+{
+	credits += atomic_add(&chan->_credits, credits);
+
+	/* Never leave the peer without credits */
+	if (credits < CONFIG_BT_L2CAP_RX_CREDITS_RETURN &&
+	    k_sem_count_get(&chan->rx.credits)) {
+		return;
+	}
+
+	credits = atomic_clear(&chan->_credits);
+	if (credits) {
+		l2cap_chan_send_credits(chan, buf, credits);
+	}
+}
+
 static void l2cap_chan_update_credits(struct bt_l2cap_le_chan *chan,
 				      struct net_buf *buf)
 {
@@ -1624,7 +1664,7 @@ int bt_l2cap_chan_recv_complete(struct bt_l2cap_chan *chan, struct net_buf *buf)
 	/* Restore credits used by packet */
 	memcpy(&credits, net_buf_user_data(buf), sizeof(credits));
 
-	l2cap_chan_send_credits(ch, buf, credits);
+	l2cap_chan_return_credits(ch, buf, credits);
 
 	net_buf_unref(buf);
 
@@ -1664,7 +1704,7 @@ static void l2cap_chan_le_recv_sdu(struct bt_l2cap_le_chan *chan,
 		return;
 	}
 
-	l2cap_chan_send_credits(chan, buf, seg);
+	l2cap_chan_return_credits(chan, buf, seg);
 	net_buf_unref(buf);
 }
 
@@ -1769,7 +1809,7 @@ static void l2cap_chan_le_recv(struct bt_l2cap_le_chan *chan,
 		return;
 	}
 
-	l2cap_chan_send_credits(chan, buf, 1);
+	l2cap_chan_return_credits(chan, buf, 1);
 }
 
 static void l2cap_chan_recv_queue(struct bt_l2cap_le_chan *chan,
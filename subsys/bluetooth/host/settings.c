@@ -5,6 +5,7 @@
  */
 
 #include <errno.h>
+#include <string.h>
 
 #include <zephyr.h>
 #include <settings/settings.h>
@@ -202,20 +203,135 @@ static int set(const char *name, size_t len_rd, settings_read_cb read_cb,
 	return -ENOENT;
 }
 
+#if defined(CONFIG_BT_SETTINGS_DELAYED_STORE)
+struct store_entry {
+	/* Empty when the entry is free */
+	char key[BT_SETTINGS_KEY_MAX];
+	bool delete;
+	u16_t len;
+	u8_t value[CONFIG_BT_SETTINGS_DELAYED_STORE_LEN];
+};
+
+static struct store_entry store_cache[CONFIG_BT_SETTINGS_DELAYED_STORE_COUNT];
+static K_MUTEX_DEFINE(store_lock);
+static struct k_delayed_work store_work;
+
+static void store_entry_write(struct store_entry *entry)
+{
+	int err;
+
+	BT_DBG("key %s len %u", log_strdup(entry->key), entry->len);
+
+	if (entry->delete) {
+		err = settings_delete(entry->key);
+	} else {
+		err = settings_save_one(entry->key, entry->value, entry->len);
+	}
+
+	if (err) {
+		BT_ERR("Failed to store %s (err %d)", log_strdup(entry->key),
+		       err);
+	}
+
+	entry->key[0] = '\0';
+}
+
+void bt_settings_store_flush(void)
+{
+	int i;
+
+	k_mutex_lock(&store_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(store_cache); i++) {
+		if (store_cache[i].key[0] != '\0') {
+			store_entry_write(&store_cache[i]);
+		}
+	}
+
+	k_mutex_unlock(&store_lock);
+}
+
+static void store_flush(struct k_work *work)
+{
+	bt_settings_store_flush();
+}
+
+int bt_settings_store(const char *key, const void *value, size_t len)
+{
+	struct store_entry *entry = NULL, *free = NULL;
+	int i, err = 0;
+
+	if (strlen(key) >= sizeof(store_cache[0].key)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&store_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(store_cache); i++) {
+		if (store_cache[i].key[0] == '\0') {
+			if (!free) {
+				free = &store_cache[i];
+			}
+		} else if (!strcmp(store_cache[i].key, key)) {
+			entry = &store_cache[i];
+			break;
+		}
+	}
+
+	if (!entry) {
+		entry = free;
+	}
+
+	/* Write at once what does not fit the cache, the older value of
+	 * the entry is dropped.
+	 */
+	if (!entry || len > sizeof(entry->value)) {
+		if (entry) {
+			entry->key[0] = '\0';
+		}
+
+		err = value ? settings_save_one(key, value, len) :
+		      settings_delete(key);
+		goto unlock;
+	}
+
+	strcpy(entry->key, key);
+	entry->delete = !value;
+	entry->len = len;
+
+	if (value) {
+		memcpy(entry->value, value, len);
+	}
+
+	/* The delay runs from the first change, so that a stream of
+	 * changes does not postpone the write forever.
+	 */
+	if (!k_delayed_work_remaining_get(&store_work)) {
+		k_delayed_work_submit(&store_work,
+				      K_MSEC(CONFIG_BT_SETTINGS_DELAYED_STORE_MS));
+	}
+
+unlock:
+	k_mutex_unlock(&store_lock);
+
+	return err;
+}
+#endif /* CONFIG_BT_SETTINGS_DELAYED_STORE */
+
 #define ID_DATA_LEN(array) (bt_dev.id_count * sizeof(array[0]))
 
 static void save_id(struct k_work *work)
 {
 	int err;
 	BT_INFO("Saving ID");
-	err = settings_save_one("bt/id", &bt_dev.id_addr,
+	err = bt_settings_store("bt/id", &bt_dev.id_addr,
 				ID_DATA_LEN(bt_dev.id_addr));
 	if (err) {
 		BT_ERR("Failed to save ID (err %d)", err);
 	}
 
 #if defined(CONFIG_BT_PRIVACY)
-	err = settings_save_one("bt/irk", bt_dev.irk, ID_DATA_LEN(bt_dev.irk));
+	err = bt_settings_store("bt/irk", bt_dev.irk, ID_DATA_LEN(bt_dev.irk));
 	if (err) {
 		BT_ERR("Failed to save IRK (err %d)", err);
 	}
@@ -275,5 +391,9 @@ int bt_settings_init(void)
 		return err;
 	}
 
+#if defined(CONFIG_BT_SETTINGS_DELAYED_STORE)
+	k_delayed_work_init(&store_work, store_flush);
+#endif /* CONFIG_BT_SETTINGS_DELAYED_STORE */
+
 	return 0;
 }
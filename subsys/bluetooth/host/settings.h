@@ -17,4 +17,18 @@ int bt_settings_decode_key(const char *key, bt_addr_le_t *addr);
 
 void bt_settings_save_id(void);
 
+#if defined(CONFIG_BT_SETTINGS_DELAYED_STORE)
+/* Write a value, or delete the entry when value is NULL, through the
+ * write-back cache.
+ */
+int bt_settings_store(const char *key, const void *value, size_t len);
+/* Write all the cached entries to the storage */
+void bt_settings_store_flush(void);
+#else
+#define bt_settings_store(key, value, len) settings_save_one(key, value, len)
+#define bt_settings_store_flush()
+#endif /* CONFIG_BT_SETTINGS_DELAYED_STORE */
+
+#define bt_settings_delete(key) bt_settings_store(key, NULL, 0)
+
 int bt_settings_init(void);
@@ -223,10 +223,49 @@ static inline void xor16(u8_t *dst, const u8_t *a, const u8_t *b)
 	dst[15] = a[15] ^ b[15];
 }
 
+/* Key of a CCM operation. With the host AES implementation the key
+ * schedule is expanded once per operation instead of once per block.
+ */
+struct ccm_key {
+#if defined(CONFIG_BT_HOST_CRYPTO)
+	struct tc_aes_key_sched_struct sched;
+#else
+	const u8_t *key;
+#endif
+};
+
+static int ccm_key_set(struct ccm_key *ccm_key, const u8_t key[16])
+{
+#if defined(CONFIG_BT_HOST_CRYPTO)
+	if (tc_aes128_set_encrypt_key(&ccm_key->sched, key) ==
+	    TC_CRYPTO_FAIL) {
+		return -EINVAL;
+	}
+#else
+	ccm_key->key = key;
+#endif
+
+	return 0;
+}
+
+static int ccm_block(const struct ccm_key *ccm_key, const u8_t in[16],
+		     u8_t out[16])
+{
+#if defined(CONFIG_BT_HOST_CRYPTO)
+	if (tc_aes_encrypt(out, in, &ccm_key->sched) == TC_CRYPTO_FAIL) {
+		return -EINVAL;
+	}
+
+	return 0;
+#else
+	return bt_encrypt_be(ccm_key->key, in, out);
+#endif
+}
+
 /* pmsg is assumed to have the nonce already present in bytes 1-13 */
-static int ccm_calculate_X0(const u8_t key[16], const u8_t *aad, u8_t aad_len,
-			    size_t mic_size, u8_t msg_len, u8_t b[16],
-			    u8_t X0[16])
+static int ccm_calculate_X0(const struct ccm_key *key, const u8_t *aad,
+			    u8_t aad_len, size_t mic_size, u8_t msg_len,
+			    u8_t b[16], u8_t X0[16])
 {
 	int i, j, err;
 
@@ -235,7 +274,7 @@ static int ccm_calculate_X0(const u8_t key[16], const u8_t *aad, u8_t aad_len,
 
 	sys_put_be16(msg_len, b + 14);
 
-	err = bt_encrypt_be(key, b, X0);
+	err = ccm_block(key, b, X0);
 	if (err) {
 		return err;
 	}
@@ -259,7 +298,7 @@ static int ccm_calculate_X0(const u8_t key[16], const u8_t *aad, u8_t aad_len,
 			aad_len -= 16;
 			i = 0;
 
-			err = bt_encrypt_be(key, b, X0);
+			err = ccm_block(key, b, X0);
 			if (err) {
 				return err;
 			}
@@ -273,7 +312,7 @@ static int ccm_calculate_X0(const u8_t key[16], const u8_t *aad, u8_t aad_len,
 			b[i] = X0[i];
 		}
 
-		err = bt_encrypt_be(key, b, X0);
+		err = ccm_block(key, b, X0);
 		if (err) {
 			return err;
 		}
@@ -282,7 +321,7 @@ static int ccm_calculate_X0(const u8_t key[16], const u8_t *aad, u8_t aad_len,
 	return 0;
 }
 
-static int ccm_auth(const u8_t key[16], u8_t nonce[13],
+static int ccm_auth(const struct ccm_key *key, u8_t nonce[13],
 		    const u8_t *cleartext_msg, size_t msg_len, const u8_t *aad,
 		    size_t aad_len, u8_t *mic, size_t mic_size)
 {
@@ -302,7 +341,7 @@ static int ccm_auth(const u8_t key[16], u8_t nonce[13],
 	/* S[0] = e(AppKey, 0x01 || nonce || 0x0000) */
 	sys_put_be16(0x0000, &b[14]);
 
-	err = bt_encrypt_be(key, b, s0);
+	err = ccm_block(key, b, s0);
 	if (err) {
 		return err;
 	}
@@ -321,7 +360,7 @@ static int ccm_auth(const u8_t key[16], u8_t nonce[13],
 			xor16(b, Xn, &cleartext_msg[j * 16]);
 		}
 
-		err = bt_encrypt_be(key, b, Xn);
+		err = ccm_block(key, b, Xn);
 		if (err) {
 			return err;
 		}
@@ -335,7 +374,7 @@ static int ccm_auth(const u8_t key[16], u8_t nonce[13],
 	return 0;
 }
 
-static int ccm_crypt(const u8_t key[16], const u8_t nonce[13],
+static int ccm_crypt(const struct ccm_key *key, const u8_t nonce[13],
 		     const u8_t *in_msg, u8_t *out_msg, size_t msg_len)
 {
 	u8_t a_i[16], s_i[16];
@@ -356,7 +395,7 @@ static int ccm_crypt(const u8_t key[16], const u8_t nonce[13],
 		/* S_1 = e(AppKey, 0x01 || nonce || 0x0001) */
 		sys_put_be16(j + 1, &a_i[14]);
 
-		err = bt_encrypt_be(key, a_i, s_i);
+		err = ccm_block(key, a_i, s_i);
 		if (err) {
 			return err;
 		}
@@ -379,15 +418,23 @@ static int bt_mesh_ccm_decrypt(const u8_t key[16], u8_t nonce[13],
 			       const u8_t *aad, size_t aad_len,
 			       u8_t *out_msg, size_t mic_size)
 {
+	struct ccm_key ccm_key;
 	u8_t mic[16];
+	int err;
 
 	if (msg_len == 0 || aad_len >= 0xff00) {
 		return -EINVAL;
 	}
 
-	ccm_crypt(key, nonce, enc_msg, out_msg, msg_len);
+	err = ccm_key_set(&ccm_key, key);
+	if (err) {
+		return err;
+	}
+
+	ccm_crypt(&ccm_key, nonce, enc_msg, out_msg, msg_len);
 
-	ccm_auth(key, nonce, out_msg, msg_len, aad, aad_len, mic, mic_size);
+	ccm_auth(&ccm_key, nonce, out_msg, msg_len, aad, aad_len, mic,
+		 mic_size);
 
 	if (memcmp(mic, enc_msg + msg_len, mic_size)) {
 		return -EBADMSG;
@@ -402,6 +449,8 @@ static int bt_mesh_ccm_encrypt(const u8_t key[16], u8_t nonce[13],
 			       u8_t *out_msg, size_t mic_size)
 {
 	u8_t *mic = out_msg + msg_len;
+	struct ccm_key ccm_key;
+	int err;
 
 	BT_DBG("key %s", bt_hex(key, 16));
 	BT_DBG("nonce %s", bt_hex(nonce, 13));
@@ -413,9 +462,15 @@ static int bt_mesh_ccm_encrypt(const u8_t key[16], u8_t nonce[13],
 		return -EINVAL;
 	}
 
-	ccm_auth(key, nonce, out_msg, msg_len, aad, aad_len, mic, mic_size);
+	err = ccm_key_set(&ccm_key, key);
+	if (err) {
+		return err;
+	}
+
+	ccm_auth(&ccm_key, nonce, out_msg, msg_len, aad, aad_len, mic,
+		 mic_size);
 
-	ccm_crypt(key, nonce, msg, out_msg, msg_len);
+	ccm_crypt(&ccm_key, nonce, msg, out_msg, msg_len);
 
 	return 0;
 }
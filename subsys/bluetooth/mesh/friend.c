@@ -27,11 +27,16 @@
 #include "foundation.h"
 #include "friend.h"
 
+#if CONFIG_BT_MESH_FRIEND_BUF_COUNT > 0
+/* The buffers are shared by all Friend Queues */
+#define FRIEND_BUF_COUNT    CONFIG_BT_MESH_FRIEND_BUF_COUNT
+#else
 /* We reserve one extra buffer for each friendship, since we need to be able
  * to resend the last sent PDU, which sits separately outside of the queue.
  */
 #define FRIEND_BUF_COUNT    ((CONFIG_BT_MESH_FRIEND_QUEUE_SIZE + 1) * \
 			     CONFIG_BT_MESH_FRIEND_LPN_COUNT)
+#endif
 
 #define FRIEND_ADV(buf) CONTAINER_OF(BT_MESH_ADV(buf), struct friend_adv, adv)
 
@@ -291,15 +296,65 @@ static void friend_sub_rem(struct bt_mesh_friend *frnd, u16_t addr)
 	}
 }
 
+/* Discard the oldest message, i.e. all of its segments, from the longest
+ * Friend Queue so that the shared buffer pool is not monopolized by the
+ * LPNs that poll the least often.
+ */
+static bool friend_queue_evict(void)
+{
+	struct bt_mesh_friend *victim = NULL;
+	bool pending_segments;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(bt_mesh.frnd); i++) {
+		struct bt_mesh_friend *frnd = &bt_mesh.frnd[i];
+
+		if (frnd->queue_size &&
+		    (!victim || frnd->queue_size > victim->queue_size)) {
+			victim = frnd;
+		}
+	}
+
+	if (!victim) {
+		return false;
+	}
+
+	BT_WARN("Discarding oldest message for LPN 0x%04x", victim->lpn);
+
+	do {
+		struct net_buf *buf = (void *)sys_slist_get(&victim->queue);
+
+		if (!buf) {
+			break;
+		}
+
+		victim->queue_size--;
+
+		pending_segments = (buf->flags & NET_BUF_FRAGS);
+
+		/* Make sure old slist entry state doesn't remain */
+		buf->frags = NULL;
+		buf->flags &= ~NET_BUF_FRAGS;
+
+		net_buf_unref(buf);
+	} while (pending_segments);
+
+	return true;
+}
+
 static struct net_buf *create_friend_pdu(struct bt_mesh_friend *frnd,
 					 struct friend_pdu_info *info,
 					 struct net_buf_simple *sdu)
 {
 	struct net_buf *buf;
 
-	buf = bt_mesh_adv_create_from_pool(&friend_buf_pool, adv_alloc,
-					   BT_MESH_ADV_DATA,
-					   FRIEND_XMIT, K_NO_WAIT);
+	do {
+		buf = bt_mesh_adv_create_from_pool(&friend_buf_pool, adv_alloc,
+						   BT_MESH_ADV_DATA,
+						   FRIEND_XMIT, K_NO_WAIT);
+	} while (!buf && CONFIG_BT_MESH_FRIEND_BUF_COUNT > 0 &&
+		 friend_queue_evict());
+
 	if (!buf) {
 		return NULL;
 	}
@@ -68,7 +68,18 @@
 
 static struct friend_cred friend_cred[FRIEND_CRED_COUNT];
 
-static u64_t msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+#define MSG_CACHE_NONE 0xffff
+
+/* The cache entries are replaced in FIFO order. Each entry is also linked
+ * in a hash bucket so that a lookup does not scan the whole cache.
+ */
+static struct {
+	u64_t hash;
+	u16_t next;
+} msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+static u16_t msg_cache_bucket[CONFIG_BT_MESH_MSG_CACHE_SIZE] = {
+	[0 ... (CONFIG_BT_MESH_MSG_CACHE_SIZE - 1)] = MSG_CACHE_NONE,
+};
 static u16_t msg_cache_next;
 
 /* Singleton network context (the implementation only supports one) */
@@ -96,6 +107,65 @@ struct bt_mesh_net bt_mesh = {
 static u32_t dup_cache[4];
 static int   dup_cache_next;
 
+#if defined(CONFIG_BT_MESH_RELAY_ADAPTIVE)
+/* Number of relayed messages after which the retransmit count is adjusted */
+#define RELAY_WINDOW 16
+
+/* Duplicates heard per relayed message above which the neighbourhood is
+ * considered dense enough to drop a retransmission, and below which a
+ * previously dropped retransmission is restored.
+ */
+#define RELAY_DUP_HIGH 3
+#define RELAY_DUP_LOW  1
+
+static struct {
+	u16_t relayed;
+	u16_t dups;
+	u8_t  skip;
+} relay_adapt;
+
+static void relay_adapt_dup(void)
+{
+	if (relay_adapt.dups < UINT16_MAX) {
+		relay_adapt.dups++;
+	}
+}
+
+static u8_t relay_adapt_transmit(u8_t transmit)
+{
+	u8_t count = BT_MESH_TRANSMIT_COUNT(transmit);
+
+	if (++relay_adapt.relayed >= RELAY_WINDOW) {
+		if (relay_adapt.dups >= RELAY_WINDOW * RELAY_DUP_HIGH) {
+			if (relay_adapt.skip < BT_MESH_TRANSMIT_COUNT(~0)) {
+				relay_adapt.skip++;
+			}
+		} else if (relay_adapt.dups < RELAY_WINDOW * RELAY_DUP_LOW) {
+			if (relay_adapt.skip) {
+				relay_adapt.skip--;
+			}
+		}
+
+		BT_DBG("%u dups in window, skipping %u retransmissions",
+		       relay_adapt.dups, relay_adapt.skip);
+
+		relay_adapt.relayed = 0U;
+		relay_adapt.dups = 0U;
+	}
+
+	count -= MIN(count, relay_adapt.skip);
+
+	return (transmit & ~BIT_MASK(3)) | count;
+}
+#else
+static inline void relay_adapt_dup(void) {}
+
+static inline u8_t relay_adapt_transmit(u8_t transmit)
+{
+	return transmit;
+}
+#endif
+
 static bool check_dup(struct net_buf_simple *data)
 {
 	const u8_t *tail = net_buf_simple_tail(data);
@@ -129,21 +199,61 @@ static u64_t msg_hash(struct bt_mesh_net_rx *rx, struct net_buf_simple *pdu)
 	return (u64_t)hash1 << 32 | (u64_t)hash2;
 }
 
+static u16_t *msg_cache_head(u64_t hash)
+{
+	u32_t fold = (u32_t)(hash >> 32) ^ (u32_t)hash;
+
+	return &msg_cache_bucket[fold % ARRAY_SIZE(msg_cache_bucket)];
+}
+
+static void msg_cache_remove(u16_t idx)
+{
+	u16_t *p;
+
+	if (!msg_cache[idx].hash) {
+		return;
+	}
+
+	p = msg_cache_head(msg_cache[idx].hash);
+	while (*p != idx) {
+		p = &msg_cache[*p].next;
+	}
+
+	*p = msg_cache[idx].next;
+	msg_cache[idx].hash = 0ULL;
+}
+
+static void msg_cache_clear(void)
+{
+	u16_t i;
+
+	(void)memset(msg_cache, 0, sizeof(msg_cache));
+	for (i = 0U; i < ARRAY_SIZE(msg_cache_bucket); i++) {
+		msg_cache_bucket[i] = MSG_CACHE_NONE;
+	}
+
+	msg_cache_next = 0U;
+}
+
 static bool msg_cache_match(struct bt_mesh_net_rx *rx,
 			    struct net_buf_simple *pdu)
 {
 	u64_t hash = msg_hash(rx, pdu);
+	u16_t *head = msg_cache_head(hash);
 	u16_t i;
 
-	for (i = 0U; i < ARRAY_SIZE(msg_cache); i++) {
-		if (msg_cache[i] == hash) {
+	for (i = *head; i != MSG_CACHE_NONE; i = msg_cache[i].next) {
+		if (msg_cache[i].hash == hash) {
 			return true;
 		}
 	}
 
-	/* Add to the cache */
+	/* Add to the cache, replacing the oldest entry */
 	rx->msg_cache_idx = msg_cache_next++;
-	msg_cache[rx->msg_cache_idx] = hash;
+	msg_cache_remove(rx->msg_cache_idx);
+	msg_cache[rx->msg_cache_idx].hash = hash;
+	msg_cache[rx->msg_cache_idx].next = *head;
+	*head = rx->msg_cache_idx;
 	msg_cache_next %= ARRAY_SIZE(msg_cache);
 
 	return false;
@@ -445,8 +555,7 @@ int bt_mesh_net_create(u16_t idx, u8_t flags, const u8_t key[16],
 
 	BT_DBG("NetKey %s", bt_hex(key, 16));
 
-	(void)memset(msg_cache, 0, sizeof(msg_cache));
-	msg_cache_next = 0U;
+	msg_cache_clear();
 
 	sub = &bt_mesh.sub[0];
 
@@ -998,6 +1107,7 @@ static int net_decrypt(struct bt_mesh_subnet *sub, const u8_t *enc,
 
 	if (rx->net_if == BT_MESH_NET_IF_ADV && msg_cache_match(rx, buf)) {
 		BT_WARN("Duplicate found in Network Message Cache");
+		relay_adapt_dup();
 		return -EALREADY;
 	}
 
@@ -1159,7 +1269,7 @@ static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 	 * use the Network Transmit state.
 	 */
 	if (rx->net_if == BT_MESH_NET_IF_ADV) {
-		transmit = bt_mesh_relay_retransmit_get();
+		transmit = relay_adapt_transmit(bt_mesh_relay_retransmit_get());
 	} else {
 		transmit = bt_mesh_net_transmit_get();
 	}
@@ -1336,7 +1446,7 @@ void bt_mesh_net_recv(struct net_buf_simple *data, s8_t rssi,
 	 */
 	if (bt_mesh_trans_recv(&buf, &rx) == -EAGAIN) {
 		BT_WARN("Removing rejected message from Network Message Cache");
-		msg_cache[rx.msg_cache_idx] = 0ULL;
+		msg_cache_remove(rx.msg_cache_idx);
 		/* Rewind the next index now that we're not using this entry */
 		msg_cache_next = rx.msg_cache_idx;
 	}
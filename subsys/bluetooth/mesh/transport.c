@@ -80,6 +80,11 @@ static struct seg_tx {
 				 new_key:1;     /* New/old key */
 	u8_t                     nack_count;    /* Number of unacked segs */
 	u8_t                     ttl;
+	u8_t                     seg_o;         /* Next segment to send */
+	u8_t                     in_flight:7,   /* Segments being sent */
+				 sending:1;     /* Sending new segments */
+	struct bt_mesh_net_tx    net_tx;        /* For deferred segments */
+	struct bt_mesh_msg_ctx   ctx;
 	const struct bt_mesh_send_cb *cb;
 	void                    *cb_data;
 	struct k_delayed_work    retransmit;    /* Retransmit timer */
@@ -194,6 +199,8 @@ static void seg_tx_reset(struct seg_tx *tx)
 	tx->seq_auth = 0U;
 	tx->sub = NULL;
 	tx->dst = BT_MESH_ADDR_UNASSIGNED;
+	tx->seg_o = 0U;
+	tx->in_flight = 0U;
 
 	if (!tx->nack_count) {
 		return;
@@ -240,6 +247,25 @@ static void seg_first_send_start(u16_t duration, int err, void *user_data)
 	}
 }
 
+static int seg_tx_send_new(struct seg_tx *tx);
+
+static void seg_send_done(struct seg_tx *tx, bool first)
+{
+	/* Only first transmissions count against the send window */
+	if (first && tx->in_flight) {
+		tx->in_flight--;
+	}
+
+	if (tx->nack_count && seg_tx_send_new(tx)) {
+		BT_ERR("Sending segment failed");
+		seg_tx_complete(tx, -EIO);
+		return;
+	}
+
+	k_delayed_work_submit(&tx->retransmit,
+			      SEG_RETRANSMIT_TIMEOUT(tx));
+}
+
 static void seg_send_start(u16_t duration, int err, void *user_data)
 {
 	struct seg_tx *tx = user_data;
@@ -249,8 +275,7 @@ static void seg_send_start(u16_t duration, int err, void *user_data)
 	 * case since otherwise we risk the transmission of becoming stale.
 	 */
 	if (err) {
-		k_delayed_work_submit(&tx->retransmit,
-				      SEG_RETRANSMIT_TIMEOUT(tx));
+		seg_send_done(tx, true);
 	}
 }
 
@@ -258,8 +283,23 @@ static void seg_sent(int err, void *user_data)
 {
 	struct seg_tx *tx = user_data;
 
-	k_delayed_work_submit(&tx->retransmit,
-			      SEG_RETRANSMIT_TIMEOUT(tx));
+	seg_send_done(tx, true);
+}
+
+static void seg_resend_start(u16_t duration, int err, void *user_data)
+{
+	struct seg_tx *tx = user_data;
+
+	if (err) {
+		seg_send_done(tx, false);
+	}
+}
+
+static void seg_resent(int err, void *user_data)
+{
+	struct seg_tx *tx = user_data;
+
+	seg_send_done(tx, false);
 }
 
 static const struct bt_mesh_send_cb first_sent_cb = {
@@ -272,11 +312,58 @@ static const struct bt_mesh_send_cb seg_sent_cb = {
 	.end = seg_sent,
 };
 
+static const struct bt_mesh_send_cb seg_resent_cb = {
+	.start = seg_resend_start,
+	.end = seg_resent,
+};
+
+/* Send the segments that have not been transmitted yet, keeping at most
+ * CONFIG_BT_MESH_TX_SEG_WINDOW segments in the advertising queue.
+ */
+static int seg_tx_send_new(struct seg_tx *tx)
+{
+	int err;
+
+	/* Segments to local elements complete synchronously */
+	if (tx->sending) {
+		return 0;
+	}
+
+	tx->sending = 1U;
+
+	while (tx->nack_count && tx->seg_o <= tx->seg_n &&
+	       tx->in_flight < CONFIG_BT_MESH_TX_SEG_WINDOW) {
+		struct net_buf *seg = tx->seg[tx->seg_o];
+		u8_t seg_o = tx->seg_o++;
+
+		if (!seg) {
+			continue;
+		}
+
+		BT_DBG("Sending %u/%u", seg_o, tx->seg_n);
+
+		tx->in_flight++;
+
+		err = bt_mesh_net_send(&tx->net_tx, net_buf_ref(seg),
+				       seg_o ? &seg_sent_cb : &first_sent_cb,
+				       tx);
+		if (err) {
+			tx->sending = 0U;
+			return err;
+		}
+	}
+
+	tx->sending = 0U;
+
+	return 0;
+}
+
 static void seg_tx_send_unacked(struct seg_tx *tx)
 {
 	int i, err;
 
-	for (i = 0; i <= tx->seg_n; i++) {
+	/* Segments from seg_o on have not been encrypted yet */
+	for (i = 0; i < tx->seg_o; i++) {
 		struct net_buf *seg = tx->seg[i];
 
 		if (!seg) {
@@ -297,7 +384,7 @@ static void seg_tx_send_unacked(struct seg_tx *tx)
 		BT_DBG("resending %u/%u", i, tx->seg_n);
 
 		err = bt_mesh_net_resend(tx->sub, seg, tx->new_key,
-					 &seg_sent_cb, tx);
+					 &seg_resent_cb, tx);
 		if (err) {
 			BT_ERR("Sending segment failed");
 			seg_tx_complete(tx, -EIO);
@@ -319,7 +406,7 @@ static int send_seg(struct bt_mesh_net_tx *net_tx, struct net_buf_simple *sdu,
 	u8_t seg_hdr, seg_o;
 	u16_t seq_zero;
 	struct seg_tx *tx;
-	int i;
+	int i, err;
 
 	BT_DBG("src 0x%04x dst 0x%04x app_idx 0x%04x aszmic %u sdu_len %u",
 	       net_tx->src, net_tx->ctx->addr, net_tx->ctx->app_idx,
@@ -362,6 +449,9 @@ static int send_seg(struct bt_mesh_net_tx *net_tx, struct net_buf_simple *sdu,
 	tx->new_key = net_tx->sub->kr_flag;
 	tx->cb = cb;
 	tx->cb_data = cb_data;
+	tx->ctx = *net_tx->ctx;
+	tx->net_tx = *net_tx;
+	tx->net_tx.ctx = &tx->ctx;
 
 	if (net_tx->ctx->send_ttl == BT_MESH_TTL_DEFAULT) {
 		tx->ttl = bt_mesh_default_ttl_get();
@@ -387,7 +477,6 @@ static int send_seg(struct bt_mesh_net_tx *net_tx, struct net_buf_simple *sdu,
 	for (seg_o = 0U; sdu->len; seg_o++) {
 		struct net_buf *seg;
 		u16_t len;
-		int err;
 
 		seg = bt_mesh_adv_create(BT_MESH_ADV_DATA, net_tx->xmit,
 					 BUF_TIMEOUT);
@@ -433,18 +522,7 @@ static int send_seg(struct bt_mesh_net_tx *net_tx, struct net_buf_simple *sdu,
 			}
 		}
 
-		tx->seg[seg_o] = net_buf_ref(seg);
-
-		BT_DBG("Sending %u/%u", seg_o, tx->seg_n);
-
-		err = bt_mesh_net_send(net_tx, seg,
-				       seg_o ? &seg_sent_cb : &first_sent_cb,
-				       tx);
-		if (err) {
-			BT_ERR("Sending segment failed");
-			seg_tx_reset(tx);
-			return err;
-		}
+		tx->seg[seg_o] = seg;
 	}
 
 	/* This can happen if segments only went into the Friend Queue */
@@ -456,6 +534,13 @@ static int send_seg(struct bt_mesh_net_tx *net_tx, struct net_buf_simple *sdu,
 		 * with the Friend Queue.
 		 */
 		send_cb_finalize(cb, cb_data);
+	} else {
+		err = seg_tx_send_new(tx);
+		if (err) {
+			BT_ERR("Sending segment failed");
+			seg_tx_reset(tx);
+			return err;
+		}
 	}
 
 	if (IS_ENABLED(CONFIG_BT_MESH_LOW_POWER) &&
@@ -539,12 +624,68 @@ int bt_mesh_trans_send(struct bt_mesh_net_tx *tx, struct net_buf_simple *msg,
 	return err;
 }
 
+/* Open addressed index of the RPL entries by source address. The index is
+ * only a cache: buckets left stale when the RPL is cleared are detected by
+ * comparing with the entry they point to, and a lookup miss falls back to
+ * scanning the RPL, e.g. for the entries restored from the settings.
+ */
+static struct {
+	u16_t src;
+	u16_t idx;
+} rpl_index[CONFIG_BT_MESH_CRPL * 2];
+
+static bool rpl_index_valid(u16_t i)
+{
+	return rpl_index[i].src &&
+	       bt_mesh.rpl[rpl_index[i].idx].src == rpl_index[i].src;
+}
+
+static struct bt_mesh_rpl *rpl_index_get(u16_t src)
+{
+	u16_t i, b;
+
+	for (i = 0U; i < ARRAY_SIZE(rpl_index); i++) {
+		b = (src + i) % ARRAY_SIZE(rpl_index);
+
+		if (!rpl_index_valid(b)) {
+			return NULL;
+		}
+
+		if (rpl_index[b].src == src) {
+			return &bt_mesh.rpl[rpl_index[b].idx];
+		}
+	}
+
+	return NULL;
+}
+
+static void rpl_index_add(struct bt_mesh_rpl *rpl)
+{
+	u16_t i, b;
+
+	for (i = 0U; i < ARRAY_SIZE(rpl_index); i++) {
+		b = (rpl->src + i) % ARRAY_SIZE(rpl_index);
+
+		if (!rpl_index_valid(b)) {
+			rpl_index[b].src = rpl->src;
+			rpl_index[b].idx = rpl - bt_mesh.rpl;
+			return;
+		}
+	}
+}
+
 static void update_rpl(struct bt_mesh_rpl *rpl, struct bt_mesh_net_rx *rx)
 {
+	bool is_new = (rpl->src != rx->ctx.addr);
+
 	rpl->src = rx->ctx.addr;
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
 
+	if (is_new) {
+		rpl_index_add(rpl);
+	}
+
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		bt_mesh_store_rpl(rpl);
 	}
@@ -557,6 +698,7 @@ static void update_rpl(struct bt_mesh_rpl *rpl, struct bt_mesh_net_rx *rx)
  */
 static bool is_replay(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match)
 {
+	struct bt_mesh_rpl *rpl;
 	int i;
 
 	/* Don't bother checking messages from ourselves */
@@ -569,8 +711,13 @@ static bool is_replay(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match)
 		return false;
 	}
 
+	rpl = rpl_index_get(rx->ctx.addr);
+	if (rpl) {
+		goto existing;
+	}
+
 	for (i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
-		struct bt_mesh_rpl *rpl = &bt_mesh.rpl[i];
+		rpl = &bt_mesh.rpl[i];
 
 		/* Empty slot */
 		if (!rpl->src) {
@@ -583,28 +730,31 @@ static bool is_replay(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match)
 			return false;
 		}
 
-		/* Existing slot for given address */
+		/* Existing slot for given address, not yet indexed */
 		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
+			rpl_index_add(rpl);
+			goto existing;
+		}
+	}
 
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				if (match) {
-					*match = rpl;
-				} else {
-					update_rpl(rpl, rx);
-				}
+	BT_ERR("RPL is full!");
+	return true;
 
-				return false;
-			} else {
-				return true;
-			}
+existing:
+	if (rx->old_iv && !rpl->old_iv) {
+		return true;
+	}
+
+	if ((!rx->old_iv && rpl->old_iv) || rpl->seq < rx->seq) {
+		if (match) {
+			*match = rpl;
+		} else {
+			update_rpl(rpl, rx);
 		}
+
+		return false;
 	}
 
-	BT_ERR("RPL is full!");
 	return true;
 }
 
@@ -1737,6 +1737,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(bt_cmds,
 #if defined(CONFIG_BT_LL_SW_SPLIT)
 	SHELL_CMD(ull_reset, NULL, HELP_NONE, cmd_ull_reset),
 #endif /* CONFIG_BT_LL_SW_SPLIT */
+#if defined(CONFIG_BT_CTLR_SCHED_STATS)
+	SHELL_CMD_ARG(ull_sched, NULL, "[reset]", cmd_ull_sched, 1, 1),
+#endif /* CONFIG_BT_CTLR_SCHED_STATS */
 	SHELL_SUBCMD_SET_END
 );
 
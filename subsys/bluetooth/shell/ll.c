@@ -349,3 +349,35 @@ int cmd_ull_reset(const struct shell *shell, size_t  argc, char *argv[])
 }
 
 #endif /* CONFIG_BT_LL_SW_SPLIT */
+
+#if defined(CONFIG_BT_CTLR_SCHED_STATS)
+int cmd_ull_sched(const struct shell *shell, size_t  argc, char *argv[])
+{
+	static const char * const role_str[] = {
+		"adv", "scan", "master", "slave",
+	};
+	struct ll_sched_stats stats;
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset")) {
+			return -EINVAL;
+		}
+
+		ll_sched_stats_reset();
+
+		return 0;
+	}
+
+	ll_sched_stats_get(&stats);
+
+	shell_print(shell, "role    expire    skip      miss      air (ms)");
+	for (u8_t i = 0U; i < LL_SCHED_ROLE_MAX; i++) {
+		shell_print(shell, "%-7s %-9u %-9u %-9u %u", role_str[i],
+			    stats.role[i].expire, stats.role[i].skip,
+			    stats.role[i].miss, stats.role[i].air_ms);
+	}
+	shell_print(shell, "cancelled prepares: %u", stats.cancel);
+
+	return 0;
+}
+#endif /* CONFIG_BT_CTLR_SCHED_STATS */
@@ -5,6 +5,7 @@
  */
 
 #include <stdlib.h>
+#include <sys/cpp_new.h>
 
 #if __cplusplus < 201103L
 #define NOEXCEPT
@@ -12,34 +13,45 @@
 #define NOEXCEPT noexcept
 #endif /* __cplusplus */
 
+#ifdef CONFIG_CPP_NEW_SLABS
+extern "C" void *z_cpp_new_alloc(size_t size);
+extern "C" void z_cpp_new_free(void *ptr);
+
+#define NEW_ALLOC(size) z_cpp_new_alloc(size)
+#define NEW_FREE(ptr) z_cpp_new_free(ptr)
+#else
+#define NEW_ALLOC(size) malloc(size)
+#define NEW_FREE(ptr) free(ptr)
+#endif /* CONFIG_CPP_NEW_SLABS */
+
 void* operator new(size_t size)
 {
-	return malloc(size);
+	return NEW_ALLOC(size);
 }
 
 void* operator new[](size_t size)
 {
-	return malloc(size);
+	return NEW_ALLOC(size);
 }
 
 void operator delete(void* ptr) NOEXCEPT
 {
-	free(ptr);
+	NEW_FREE(ptr);
 }
 
 void operator delete[](void* ptr) NOEXCEPT
 {
-	free(ptr);
+	NEW_FREE(ptr);
 }
 
 #if (__cplusplus > 201103L)
 void operator delete(void* ptr, size_t) NOEXCEPT
 {
-	free(ptr);
+	NEW_FREE(ptr);
 }
 
 void operator delete[](void* ptr, size_t) NOEXCEPT
 {
-	free(ptr);
+	NEW_FREE(ptr);
 }
 #endif // __cplusplus > 201103L
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <stdlib.h>
+#include <sys/atomic.h>
+#include <sys/cpp_new.h>
+
+/* Blocks are aligned for any fundamental type */
+#define SLAB_ALIGN sizeof(long long)
+
+K_MEM_SLAB_DEFINE(cpp_new_slab_16, 16, CONFIG_CPP_NEW_SLAB_16_BLOCKS,
+		  SLAB_ALIGN);
+K_MEM_SLAB_DEFINE(cpp_new_slab_32, 32, CONFIG_CPP_NEW_SLAB_32_BLOCKS,
+		  SLAB_ALIGN);
+K_MEM_SLAB_DEFINE(cpp_new_slab_64, 64, CONFIG_CPP_NEW_SLAB_64_BLOCKS,
+		  SLAB_ALIGN);
+K_MEM_SLAB_DEFINE(cpp_new_slab_128, 128, CONFIG_CPP_NEW_SLAB_128_BLOCKS,
+		  SLAB_ALIGN);
+
+static struct k_mem_slab *const slabs[CPP_NEW_SIZE_CLASSES] = {
+	&cpp_new_slab_16,
+	&cpp_new_slab_32,
+	&cpp_new_slab_64,
+	&cpp_new_slab_128,
+};
+
+BUILD_ASSERT(CPP_NEW_MAX_SLAB_SIZE == 16 << (CPP_NEW_SIZE_CLASSES - 1));
+
+#ifdef CONFIG_CPP_NEW_STATS
+static atomic_t slab_allocs[CPP_NEW_SIZE_CLASSES];
+static atomic_t heap_allocs;
+static atomic_t slab_full;
+static atomic_t failures;
+
+#define STAT_INC(stat) ((void)atomic_inc(&(stat)))
+#else
+#define STAT_INC(stat) do { } while (false)
+#endif
+
+/* Smallest class holding size bytes, size being at most
+ * CPP_NEW_MAX_SLAB_SIZE
+ */
+static int size_class(size_t size)
+{
+	int class = 0;
+
+	while ((16U << class) < size) {
+		class++;
+	}
+
+	return class;
+}
+
+static struct k_mem_slab *slab_of(void *ptr)
+{
+	for (int i = 0; i < CPP_NEW_SIZE_CLASSES; i++) {
+		struct k_mem_slab *slab = slabs[i];
+
+		if ((char *)ptr >= slab->buffer &&
+		    (char *)ptr < slab->buffer +
+				  slab->num_blocks * slab->block_size) {
+			return slab;
+		}
+	}
+
+	return NULL;
+}
+
+void *z_cpp_new_alloc(size_t size)
+{
+	void *ptr;
+
+	if (size <= CPP_NEW_MAX_SLAB_SIZE) {
+		int class = size_class(size);
+
+		if (k_mem_slab_alloc(slabs[class], &ptr, K_NO_WAIT) == 0) {
+			STAT_INC(slab_allocs[class]);
+			return ptr;
+		}
+
+		STAT_INC(slab_full);
+	}
+
+	ptr = malloc(size);
+	if (ptr != NULL) {
+		STAT_INC(heap_allocs);
+	} else {
+		STAT_INC(failures);
+	}
+
+	return ptr;
+}
+
+void z_cpp_new_free(void *ptr)
+{
+	struct k_mem_slab *slab;
+
+	if (ptr == NULL) {
+		return;
+	}
+
+	slab = slab_of(ptr);
+	if (slab != NULL) {
+		k_mem_slab_free(slab, &ptr);
+	} else {
+		free(ptr);
+	}
+}
+
+#ifdef CONFIG_CPP_NEW_STATS
+void cpp_new_stats_get(struct cpp_new_stats *stats)
+{
+	for (int i = 0; i < CPP_NEW_SIZE_CLASSES; i++) {
+		stats->slab_allocs[i] = atomic_get(&slab_allocs[i]);
+		stats->slab_used[i] = k_mem_slab_num_used_get(slabs[i]);
+	}
+
+	stats->heap_allocs = atomic_get(&heap_allocs);
+	stats->slab_full = atomic_get(&slab_full);
+	stats->failures = atomic_get(&failures);
+}
+#endif
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <debug/profiler.h>
+#include <sys/printk.h>
+#include <arch/arm/cortex_m/cmsis.h>
+
+static struct profiler_sample samples[CONFIG_PROFILER_SAMPLES];
+static volatile u32_t sample_cnt;
+static struct k_timer sample_timer;
+
+/* Timer expiry function is called from the system clock interrupt. If thread
+ * mode was interrupted (no other exception active), the interrupted context
+ * is stacked on the process stack: r0-r3, r12, lr, pc, xpsr.
+ */
+static void sample_take(struct k_timer *timer)
+{
+	struct profiler_sample *sample;
+
+	if (sample_cnt >= ARRAY_SIZE(samples)) {
+		k_timer_stop(timer);
+		return;
+	}
+
+	sample = &samples[sample_cnt];
+
+	if (SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) {
+		const u32_t *frame = (const u32_t *)__get_PSP();
+
+		sample->pc = frame[6];
+		sample->lr = IS_ENABLED(CONFIG_PROFILER_CALLER) ?
+			     frame[5] : 0U;
+	} else {
+		sample->pc = 0U;
+		sample->lr = 0U;
+	}
+
+	sample_cnt++;
+}
+
+void profiler_start(void)
+{
+	k_timer_stop(&sample_timer);
+	sample_cnt = 0U;
+	k_timer_start(&sample_timer, CONFIG_PROFILER_PERIOD_MS,
+		      CONFIG_PROFILER_PERIOD_MS);
+}
+
+void profiler_stop(void)
+{
+	k_timer_stop(&sample_timer);
+}
+
+u32_t profiler_samples_get(const struct profiler_sample **out)
+{
+	*out = samples;
+
+	return sample_cnt;
+}
+
+void profiler_dump(void)
+{
+	u32_t cnt = sample_cnt;
+
+	printk("PROF START %u %u\n", cnt, CONFIG_PROFILER_PERIOD_MS);
+	for (u32_t i = 0; i < cnt; i++) {
+		printk("PROF %08x %08x\n", samples[i].pc, samples[i].lr);
+	}
+	printk("PROF END\n");
+}
+
+static int profiler_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_timer_init(&sample_timer, sample_take, NULL);
+
+	if (IS_ENABLED(CONFIG_PROFILER_AUTOSTART)) {
+		profiler_start();
+	}
+
+	return 0;
+}
+
+SYS_INIT(profiler_init, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2020 Oticon A/S
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <sys/ring_buffer.h>
+#include "ctf_bottom.h"
+
+#if defined(CONFIG_TRACING_CTF_BOTTOM_BUFFERED_UART)
+#include <drivers/uart.h>
+#elif defined(CONFIG_TRACING_CTF_BOTTOM_BUFFERED_TCP)
+#include <net/socket.h>
+#include <errno.h>
+#endif
+
+#define BUF_SIZE CONFIG_TRACING_CTF_BOTTOM_BUFFERED_SIZE
+
+/* Each CPU is the only producer of its buffer and the drain thread is the
+ * only consumer so buffers are accessed without a global lock.
+ */
+static u8_t ring_data[CONFIG_MP_NUM_CPUS][BUF_SIZE];
+static struct ring_buf rings[CONFIG_MP_NUM_CPUS];
+
+ctf_bottom_ctx_t ctf_bottom;
+
+void ctf_bottom_emit(const void *ptr, size_t size)
+{
+	struct ring_buf *ring;
+	unsigned int key;
+
+	/* Only local interrupts are locked, it also prevents migration. */
+	key = arch_irq_lock();
+
+	ring = &rings[_current_cpu - &_kernel.cpus[0]];
+
+	/* Event is never split, it is either stored as a whole or dropped. */
+	if (ring_buf_space_get(ring) >= size) {
+		(void)ring_buf_put(ring, ptr, size);
+	} else {
+		atomic_inc(&ctf_bottom.dropped);
+	}
+
+	arch_irq_unlock(key);
+}
+
+#if defined(CONFIG_TRACING_CTF_BOTTOM_BUFFERED_UART)
+static struct device *uart_dev;
+static bool uart_async;
+static K_SEM_DEFINE(uart_tx_sem, 0, 1);
+
+static void uart_callback(struct uart_event *evt, void *user_data)
+{
+	if (evt->type == UART_TX_DONE || evt->type == UART_TX_ABORTED) {
+		k_sem_give(&uart_tx_sem);
+	}
+}
+
+static int output_open(void)
+{
+	uart_dev = device_get_binding(
+			CONFIG_TRACING_CTF_BOTTOM_BUFFERED_UART_DEV_NAME);
+	if (uart_dev == NULL) {
+		return -ENODEV;
+	}
+
+	if (IS_ENABLED(CONFIG_UART_ASYNC_API)) {
+		uart_async = (uart_callback_set(uart_dev, uart_callback,
+						NULL) == 0);
+	}
+
+	return 0;
+}
+
+static int output_write(const u8_t *data, size_t len)
+{
+	/* Buffer is sent directly from the ring buffer (e.g. using DMA). */
+	if (uart_async && uart_tx(uart_dev, data, len, K_FOREVER) == 0) {
+		k_sem_take(&uart_tx_sem, K_FOREVER);
+		return 0;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		uart_poll_out(uart_dev, data[i]);
+	}
+
+	return 0;
+}
+#elif defined(CONFIG_TRACING_CTF_BOTTOM_BUFFERED_TCP)
+static int sock = -1;
+
+static int output_open(void)
+{
+	struct sockaddr addr;
+	socklen_t addr_len;
+
+	(void)memset(&addr, 0, sizeof(addr));
+	if (!net_ipaddr_parse(CONFIG_TRACING_CTF_BOTTOM_BUFFERED_TCP_SERVER,
+			sizeof(CONFIG_TRACING_CTF_BOTTOM_BUFFERED_TCP_SERVER) - 1,
+			&addr)) {
+		return -EINVAL;
+	}
+
+	addr_len = (addr.sa_family == AF_INET6) ?
+		   sizeof(struct sockaddr_in6) : sizeof(struct sockaddr_in);
+
+	sock = zsock_socket(addr.sa_family, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	if (zsock_connect(sock, &addr, addr_len) < 0) {
+		(void)zsock_close(sock);
+		sock = -1;
+		return -errno;
+	}
+
+	return 0;
+}
+
+static int output_write(const u8_t *data, size_t len)
+{
+	while (len) {
+		ssize_t out = zsock_send(sock, data, len, 0);
+
+		if (out < 0) {
+			/* Connection is established again on next drain. */
+			(void)zsock_close(sock);
+			sock = -1;
+			return -errno;
+		}
+
+		data += out;
+		len -= out;
+	}
+
+	return 0;
+}
+#endif
+
+/* Drain data which is in the buffer at the moment of the call. Producer
+ * commits whole events so the amount is always on an event boundary and
+ * events from different CPUs are never interleaved.
+ */
+static int ring_drain(struct ring_buf *ring)
+{
+	u32_t avail = ring_buf_capacity_get(ring) - ring_buf_space_get(ring);
+	u8_t *data;
+	u32_t len;
+	int err = 0;
+
+	while (avail && err == 0) {
+		len = ring_buf_get_claim(ring, &data, avail);
+		err = output_write(data, len);
+		(void)ring_buf_get_finish(ring, len);
+		avail -= len;
+	}
+
+	return err;
+}
+
+static void ctf_drain_thread(void *p1, void *p2, void *p3)
+{
+	bool opened = false;
+
+	while (true) {
+		k_sleep(K_MSEC(CONFIG_TRACING_CTF_BOTTOM_BUFFERED_PERIOD_MS));
+
+		if (!opened) {
+			opened = (output_open() == 0);
+			if (!opened) {
+				continue;
+			}
+		}
+
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			if (ring_drain(&rings[i]) != 0) {
+				opened = false;
+				break;
+			}
+		}
+	}
+}
+
+K_THREAD_DEFINE(ctf_drain, CONFIG_TRACING_CTF_BOTTOM_BUFFERED_STACK_SIZE,
+		ctf_drain_thread, NULL, NULL, NULL,
+		CONFIG_TRACING_CTF_BOTTOM_BUFFERED_THREAD_PRIO, 0, K_NO_WAIT);
+
+void ctf_bottom_configure(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		ring_buf_init(&rings[i], BUF_SIZE, ring_data[i]);
+	}
+}
+
+void ctf_bottom_start(void)
+{
+}
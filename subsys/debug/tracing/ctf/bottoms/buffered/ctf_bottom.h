@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020 Oticon A/S
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SUBSYS_DEBUG_TRACING_BOTTOMS_BUFFERED_CTF_BOTTOM_H
+#define SUBSYS_DEBUG_TRACING_BOTTOMS_BUFFERED_CTF_BOTTOM_H
+
+#include <stddef.h>
+#include <string.h>
+#include <zephyr/types.h>
+#include <sys/atomic.h>
+#include <ctf_map.h>
+
+
+/* Obtain a field's size at compile-time.
+ * Internal to this bottom-layer.
+ */
+#define CTF_BOTTOM_INTERNAL_FIELD_SIZE(x)      + sizeof(x)
+
+/* Append a field to current event-packet.
+ * Internal to this bottom-layer.
+ */
+#define CTF_BOTTOM_INTERNAL_FIELD_APPEND(x)		 \
+	{						 \
+		memcpy(epacket_cursor, &(x), sizeof(x)); \
+		epacket_cursor += sizeof(x);		 \
+	}
+
+/* Gather fields to a contiguous event-packet, then atomically emit.
+ * Used by middle-layer.
+ */
+#define CTF_BOTTOM_FIELDS(...)						    \
+{									    \
+	u8_t epacket[0 MAP(CTF_BOTTOM_INTERNAL_FIELD_SIZE, ##__VA_ARGS__)]; \
+	u8_t *epacket_cursor = &epacket[0];				    \
+									    \
+	MAP(CTF_BOTTOM_INTERNAL_FIELD_APPEND, ##__VA_ARGS__)		    \
+	ctf_bottom_emit(epacket, sizeof(epacket));			    \
+}
+
+/* Each CPU writes to its own buffer with local interrupts locked in
+ * ctf_bottom_emit, no global lock is needed. Used by middle-layer.
+ */
+#define CTF_BOTTOM_LOCK()         { /* empty */ }
+#define CTF_BOTTOM_UNLOCK()       { /* empty */ }
+
+/* Events are timestamped when they are generated.
+ * Used by middle-layer.
+ */
+#define CTF_BOTTOM_TIMESTAMPED_INTERNALLY
+
+
+typedef struct {
+	/* Number of events dropped because CPU buffer was full. */
+	atomic_t dropped;
+} ctf_bottom_ctx_t;
+
+extern ctf_bottom_ctx_t ctf_bottom;
+
+
+/* Configure initializes ctf_bottom context and per-CPU buffers */
+void ctf_bottom_configure(void);
+
+/* Start a new trace stream */
+void ctf_bottom_start(void);
+
+/* Copy event to the buffer of the current CPU. Buffers are drained to the
+ * output channel by a low priority thread.
+ */
+void ctf_bottom_emit(const void *ptr, size_t size);
+
+#endif /* SUBSYS_DEBUG_TRACING_BOTTOMS_BUFFERED_CTF_BOTTOM_H */
@@ -89,6 +89,63 @@ static int flash_sector_from_off(struct flash_area const *fap, off_t off,
 	return rc;
 }
 
+#ifdef CONFIG_IMG_ERASE_AHEAD
+
+static void flash_erase_ahead_work(struct k_work *work)
+{
+	struct flash_img_context *ctx =
+		CONTAINER_OF(work, struct flash_img_context, erase_work);
+
+	LOG_DBG("Erasing sector at offset 0x%08lx ahead",
+		(long)ctx->erase_off);
+	ctx->erase_rc = flash_area_erase(ctx->flash_area,
+					 ctx->erase_off -
+					 ctx->flash_area->fa_off,
+					 ctx->erase_size);
+	k_sem_give(&ctx->erase_sem);
+}
+
+/**
+ * Wait for the background erase, if any.
+ *
+ * @return true if the sector at offset fs_off was erased in the background.
+ */
+static bool flash_erase_ahead_wait(struct flash_img_context *ctx,
+				   off_t fs_off)
+{
+	bool erased;
+
+	k_sem_take(&ctx->erase_sem, K_FOREVER);
+	erased = (ctx->erase_off == fs_off && ctx->erase_rc == 0);
+	ctx->erase_off = -1;
+	k_sem_give(&ctx->erase_sem);
+
+	return erased;
+}
+
+/**
+ * Start erasing the sector following the given one in the background.
+ */
+static void flash_erase_ahead_start(struct flash_img_context *ctx,
+				    struct flash_sector *sector)
+{
+	struct flash_sector next;
+	off_t off;
+
+	off = sector->fs_off + sector->fs_size - ctx->flash_area->fa_off;
+	if (off >= ctx->flash_area->fa_size ||
+	    flash_sector_from_off(ctx->flash_area, off, &next)) {
+		return;
+	}
+
+	k_sem_take(&ctx->erase_sem, K_FOREVER);
+	ctx->erase_off = next.fs_off;
+	ctx->erase_size = next.fs_size;
+	k_work_submit(&ctx->erase_work);
+}
+
+#endif /* CONFIG_IMG_ERASE_AHEAD */
+
 /**
  * Erase the image slot progressively
  *
@@ -111,6 +168,12 @@ static int flash_progressive_erase(struct flash_img_context *ctx, off_t off)
 	} else {
 		if (ctx->off_last != sector.fs_off) {
 			ctx->off_last = sector.fs_off;
+#ifdef CONFIG_IMG_ERASE_AHEAD
+			if (flash_erase_ahead_wait(ctx, sector.fs_off)) {
+				flash_erase_ahead_start(ctx, &sector);
+				return 0;
+			}
+#endif
 			LOG_INF("Erasing sector at offset 0x%08lx",
 				(long)sector.fs_off);
 			rc = flash_area_erase(ctx->flash_area,
@@ -120,6 +183,11 @@ static int flash_progressive_erase(struct flash_img_context *ctx, off_t off)
 			if (rc) {
 				LOG_ERR("Error %d while erasing sector", rc);
 			}
+#ifdef CONFIG_IMG_ERASE_AHEAD
+			if (rc == 0) {
+				flash_erase_ahead_start(ctx, &sector);
+			}
+#endif
 		}
 	}
 
@@ -132,6 +200,10 @@ static int flash_sync(struct flash_img_context *ctx)
 {
 	int rc = 0;
 
+#ifdef CONFIG_IMG_HASH_PROGRESSIVELY
+	(void)tc_sha256_update(&ctx->sha256, ctx->buf, ctx->buf_bytes);
+#endif
+
 	if (ctx->buf_bytes < CONFIG_IMG_BLOCK_BUF_SIZE) {
 		(void)memset(ctx->buf + ctx->buf_bytes, 0xFF,
 			     CONFIG_IMG_BLOCK_BUF_SIZE - ctx->buf_bytes);
@@ -215,6 +287,10 @@ int flash_img_buffered_write(struct flash_img_context *ctx, u8_t *data,
 		return rc;
 	}
 #endif
+#ifdef CONFIG_IMG_ERASE_AHEAD
+	/* the flash area must not be closed under a background erase */
+	(void)flash_erase_ahead_wait(ctx, -1);
+#endif
 
 	flash_area_close(ctx->flash_area);
 	ctx->flash_area = NULL;
@@ -227,12 +303,31 @@ size_t flash_img_bytes_written(struct flash_img_context *ctx)
 	return ctx->bytes_written;
 }
 
+#ifdef CONFIG_IMG_HASH_PROGRESSIVELY
+int flash_img_hash_get(struct flash_img_context *ctx, u8_t *hash)
+{
+	if (tc_sha256_final(hash, &ctx->sha256) != TC_CRYPTO_SUCCESS) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+#endif
+
 int flash_img_init(struct flash_img_context *ctx)
 {
 	ctx->bytes_written = 0;
 	ctx->buf_bytes = 0U;
 #ifdef CONFIG_IMG_ERASE_PROGRESSIVELY
 	ctx->off_last = -1;
+#endif
+#ifdef CONFIG_IMG_ERASE_AHEAD
+	k_work_init(&ctx->erase_work, flash_erase_ahead_work);
+	k_sem_init(&ctx->erase_sem, 1, 1);
+	ctx->erase_off = -1;
+#endif
+#ifdef CONFIG_IMG_HASH_PROGRESSIVELY
+	(void)tc_sha256_init(&ctx->sha256);
 #endif
 	return flash_area_open(FLASH_AREA_IMAGE_SECONDARY,
 			       (const struct flash_area **)&(ctx->flash_area));
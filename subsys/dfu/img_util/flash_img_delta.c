@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_MODULE_NAME fota_flash_delta
+#define LOG_LEVEL CONFIG_IMG_MANAGER_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+#include <zephyr/types.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/byteorder.h>
+#include <sys/util.h>
+#include <dfu/flash_img_delta.h>
+
+#include <generated_dts_board.h>
+#ifdef CONFIG_TRUSTED_EXECUTION_NONSECURE
+#define FLASH_AREA_IMAGE_PRIMARY DT_FLASH_AREA_IMAGE_0_NONSECURE_ID
+#else
+#define FLASH_AREA_IMAGE_PRIMARY DT_FLASH_AREA_IMAGE_0_ID
+#endif /* CONFIG_TRUSTED_EXECUTION_NONSECURE */
+
+/* Bytes of the old image read at once */
+#define DELTA_CHUNK_SIZE 64
+
+int flash_img_delta_init(struct flash_img_delta_context *ctx,
+			 struct flash_img_context *img)
+{
+	(void)memset(ctx, 0, sizeof(*ctx));
+	ctx->img = img;
+
+	return flash_area_open(FLASH_AREA_IMAGE_PRIMARY, &ctx->source);
+}
+
+static int delta_output(struct flash_img_delta_context *ctx, u8_t *data,
+			size_t len)
+{
+	ctx->new_left -= len;
+
+	return flash_img_buffered_write(ctx->img, data, len,
+					ctx->new_left == 0);
+}
+
+static int delta_diff(struct flash_img_delta_context *ctx, const u8_t *data,
+		      size_t len)
+{
+	u8_t buf[DELTA_CHUNK_SIZE];
+	size_t chunk;
+	int rc;
+
+	while (len > 0) {
+		chunk = MIN(len, sizeof(buf));
+
+		if (ctx->old_off < 0 ||
+		    ctx->old_off + chunk > ctx->source->fa_size) {
+			LOG_ERR("Patch reads outside the old image");
+			return -EINVAL;
+		}
+
+		rc = flash_area_read(ctx->source, ctx->old_off, buf, chunk);
+		if (rc) {
+			return rc;
+		}
+
+		for (size_t i = 0; i < chunk; i++) {
+			buf[i] += data[i];
+		}
+
+		rc = delta_output(ctx, buf, chunk);
+		if (rc) {
+			return rc;
+		}
+
+		ctx->old_off += chunk;
+		data += chunk;
+		len -= chunk;
+	}
+
+	return 0;
+}
+
+static int delta_extra(struct flash_img_delta_context *ctx, const u8_t *data,
+		       size_t len)
+{
+	u8_t buf[DELTA_CHUNK_SIZE];
+	size_t chunk;
+	int rc;
+
+	/* flash_img_buffered_write() takes a mutable buffer */
+	while (len > 0) {
+		chunk = MIN(len, sizeof(buf));
+		memcpy(buf, data, chunk);
+
+		rc = delta_output(ctx, buf, chunk);
+		if (rc) {
+			return rc;
+		}
+
+		data += chunk;
+		len -= chunk;
+	}
+
+	return 0;
+}
+
+static void delta_record_end(struct flash_img_delta_context *ctx)
+{
+	if (ctx->diff_left == 0 && ctx->extra_left == 0) {
+		ctx->old_off += ctx->seek;
+		ctx->seek = 0;
+	}
+}
+
+static int delta_ctrl(struct flash_img_delta_context *ctx)
+{
+	if (!ctx->header_done) {
+		if (sys_get_le32(&ctx->ctrl[0]) != FLASH_IMG_DELTA_MAGIC) {
+			LOG_ERR("Not a delta patch");
+			return -EINVAL;
+		}
+
+		if (sys_get_le32(&ctx->ctrl[4]) > ctx->source->fa_size) {
+			LOG_ERR("Old image larger than its slot");
+			return -EINVAL;
+		}
+
+		ctx->new_left = sys_get_le32(&ctx->ctrl[8]);
+		if (ctx->new_left == 0) {
+			LOG_ERR("Empty new image");
+			return -EINVAL;
+		}
+
+		ctx->header_done = true;
+
+		return 0;
+	}
+
+	ctx->diff_left = sys_get_le32(&ctx->ctrl[0]);
+	ctx->extra_left = sys_get_le32(&ctx->ctrl[4]);
+	ctx->seek = (s32_t)sys_get_le32(&ctx->ctrl[8]);
+
+	if ((size_t)ctx->diff_left + ctx->extra_left > ctx->new_left) {
+		LOG_ERR("Patch record beyond the new image size");
+		return -EINVAL;
+	}
+
+	delta_record_end(ctx);
+
+	return 0;
+}
+
+int flash_img_delta_write(struct flash_img_delta_context *ctx,
+			  const u8_t *data, size_t len)
+{
+	size_t chunk;
+	int rc;
+
+	while (len > 0) {
+		if (flash_img_delta_done(ctx)) {
+			LOG_ERR("Data after the end of the patch");
+			return -EINVAL;
+		}
+
+		if (ctx->diff_left > 0) {
+			chunk = MIN(len, ctx->diff_left);
+			rc = delta_diff(ctx, data, chunk);
+			ctx->diff_left -= chunk;
+			delta_record_end(ctx);
+		} else if (ctx->extra_left > 0) {
+			chunk = MIN(len, ctx->extra_left);
+			rc = delta_extra(ctx, data, chunk);
+			ctx->extra_left -= chunk;
+			delta_record_end(ctx);
+		} else {
+			/* header or control record, possibly split */
+			chunk = MIN(len, sizeof(ctx->ctrl) - ctx->ctrl_len);
+			memcpy(&ctx->ctrl[ctx->ctrl_len], data, chunk);
+			ctx->ctrl_len += chunk;
+			rc = 0;
+			if (ctx->ctrl_len == sizeof(ctx->ctrl)) {
+				ctx->ctrl_len = 0;
+				rc = delta_ctrl(ctx);
+			}
+		}
+
+		if (rc) {
+			return rc;
+		}
+
+		data += chunk;
+		len -= chunk;
+	}
+
+	return 0;
+}
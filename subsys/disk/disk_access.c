@@ -23,6 +23,147 @@ static sys_dlist_t disk_access_list;
 /* lock to protect storage layer registration */
 static struct k_mutex mutex;
 
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+struct disk_cache_entry {
+	struct disk_info *disk;
+	u32_t sector;
+	u32_t last_use;
+	u8_t data[CONFIG_DISK_ACCESS_CACHE_SECTOR_SIZE];
+};
+
+static struct disk_cache_entry disk_cache[CONFIG_DISK_ACCESS_CACHE_SECTORS];
+static u32_t disk_cache_use_cnt;
+
+/* lock to protect the sector cache */
+static struct k_mutex disk_cache_mutex;
+
+static bool disk_cache_usable(struct disk_info *disk)
+{
+	u32_t sector_size;
+
+	if ((disk->ops->ioctl == NULL) ||
+	    disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE, &sector_size)) {
+		return false;
+	}
+
+	return sector_size == CONFIG_DISK_ACCESS_CACHE_SECTOR_SIZE;
+}
+
+static struct disk_cache_entry *disk_cache_find(struct disk_info *disk,
+						u32_t sector)
+{
+	for (int i = 0; i < ARRAY_SIZE(disk_cache); i++) {
+		if ((disk_cache[i].disk == disk) &&
+		    (disk_cache[i].sector == sector)) {
+			disk_cache[i].last_use = ++disk_cache_use_cnt;
+			return &disk_cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* returns an unused or the least recently used entry */
+static struct disk_cache_entry *disk_cache_alloc(struct disk_info *disk,
+						 u32_t sector)
+{
+	struct disk_cache_entry *entry = &disk_cache[0];
+
+	for (int i = 0; i < ARRAY_SIZE(disk_cache); i++) {
+		if (disk_cache[i].disk == NULL) {
+			entry = &disk_cache[i];
+			break;
+		}
+		if ((s32_t)(disk_cache[i].last_use - entry->last_use) < 0) {
+			entry = &disk_cache[i];
+		}
+	}
+
+	entry->disk = disk;
+	entry->sector = sector;
+	entry->last_use = ++disk_cache_use_cnt;
+
+	return entry;
+}
+
+static void disk_cache_invalidate(struct disk_info *disk)
+{
+	for (int i = 0; i < ARRAY_SIZE(disk_cache); i++) {
+		if (disk_cache[i].disk == disk) {
+			disk_cache[i].disk = NULL;
+		}
+	}
+}
+
+static int disk_cache_read(struct disk_info *disk, u8_t *data_buf,
+			   u32_t start_sector, u32_t num_sector)
+{
+	struct disk_cache_entry *entry;
+	int rc;
+
+	if ((num_sector != 1U) || !disk_cache_usable(disk)) {
+		return disk->ops->read(disk, data_buf, start_sector,
+				       num_sector);
+	}
+
+	k_mutex_lock(&disk_cache_mutex, K_FOREVER);
+
+	entry = disk_cache_find(disk, start_sector);
+	if (entry == NULL) {
+		entry = disk_cache_alloc(disk, start_sector);
+		rc = disk->ops->read(disk, entry->data, start_sector, 1);
+		if (rc != 0) {
+			entry->disk = NULL;
+			goto out;
+		}
+	}
+
+	memcpy(data_buf, entry->data, sizeof(entry->data));
+	rc = 0;
+out:
+	k_mutex_unlock(&disk_cache_mutex);
+	return rc;
+}
+
+static int disk_cache_write(struct disk_info *disk, const u8_t *data_buf,
+			    u32_t start_sector, u32_t num_sector)
+{
+	struct disk_cache_entry *entry;
+	int rc;
+
+	if (!disk_cache_usable(disk)) {
+		return disk->ops->write(disk, data_buf, start_sector,
+					num_sector);
+	}
+
+	k_mutex_lock(&disk_cache_mutex, K_FOREVER);
+
+	rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+
+	for (u32_t i = 0; i < num_sector; i++) {
+		entry = disk_cache_find(disk, start_sector + i);
+		if (entry == NULL) {
+			if ((rc != 0) || (num_sector != 1U)) {
+				continue;
+			}
+			entry = disk_cache_alloc(disk, start_sector);
+		}
+
+		if (rc != 0) {
+			/* the media content is unknown now */
+			entry->disk = NULL;
+			continue;
+		}
+
+		memcpy(entry->data, &data_buf[i * sizeof(entry->data)],
+		       sizeof(entry->data));
+	}
+
+	k_mutex_unlock(&disk_cache_mutex);
+	return rc;
+}
+#endif /* CONFIG_DISK_ACCESS_CACHE */
+
 struct disk_info *disk_access_get_di(const char *name)
 {
 	struct disk_info *disk = NULL, *itr;
@@ -61,6 +202,12 @@ int disk_access_init(const char *pdrv)
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->init != NULL)) {
 		rc = disk->ops->init(disk);
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+		/* the media might have been replaced */
+		k_mutex_lock(&disk_cache_mutex, K_FOREVER);
+		disk_cache_invalidate(disk);
+		k_mutex_unlock(&disk_cache_mutex);
+#endif
 	}
 
 	return rc;
@@ -87,7 +234,11 @@ int disk_access_read(const char *pdrv, u8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->read != NULL)) {
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+		rc = disk_cache_read(disk, data_buf, start_sector, num_sector);
+#else
 		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+#endif
 	}
 
 	return rc;
@@ -101,7 +252,12 @@ int disk_access_write(const char *pdrv, const u8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->write != NULL)) {
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+		rc = disk_cache_write(disk, data_buf, start_sector,
+				      num_sector);
+#else
 		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+#endif
 	}
 
 	return rc;
@@ -163,6 +319,11 @@ int disk_access_unregister(struct disk_info *disk)
 	}
 	/* remove disk node from the list */
 	sys_dlist_remove(&disk->node);
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+	k_mutex_lock(&disk_cache_mutex, K_FOREVER);
+	disk_cache_invalidate(disk);
+	k_mutex_unlock(&disk_cache_mutex);
+#endif
 	LOG_DBG("disk interface(%s) unregistred", disk->name);
 unreg_err:
 	k_mutex_unlock(&mutex);
@@ -174,6 +335,9 @@ static int disk_init(struct device *dev)
 	ARG_UNUSED(dev);
 
 	k_mutex_init(&mutex);
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+	k_mutex_init(&disk_cache_mutex);
+#endif
 	sys_dlist_init(&disk_access_list);
 	return 0;
 }
@@ -369,41 +369,42 @@ static int sdhc_spi_rx_block(struct sdhc_spi_data *data,
 		return -EIO;
 	}
 
-	/* Read the data in batches */
-	for (i = 0; i < len; i += sizeof(sdhc_ones)) {
-		int remain = MIN(sizeof(sdhc_ones), len - i);
-
-		struct spi_buf tx_bufs[] = {
-			{
-				.buf = (u8_t *)sdhc_ones,
-				.len = remain
-			}
-		};
+	/* Clock out the whole block in a single transfer, repeating the
+	 * ones buffer as many times as needed.
+	 */
+	struct spi_buf tx_bufs[SDMMC_DEFAULT_BLOCK_SIZE / sizeof(sdhc_ones)];
 
-		const struct spi_buf_set tx = {
-			.buffers = tx_bufs,
-			.count = 1,
-		};
+	__ASSERT_NO_MSG(len <= sizeof(tx_bufs) / sizeof(tx_bufs[0]) *
+			sizeof(sdhc_ones));
 
-		struct spi_buf rx_bufs[] = {
-			{
-				.buf = &buf[i],
-				.len = remain
-			}
-		};
+	for (i = 0; i * sizeof(sdhc_ones) < len; i++) {
+		tx_bufs[i].buf = (u8_t *)sdhc_ones;
+		tx_bufs[i].len = MIN(sizeof(sdhc_ones),
+				     len - i * sizeof(sdhc_ones));
+	}
 
-		const struct spi_buf_set rx = {
-			.buffers = rx_bufs,
-			.count = 1,
-		};
+	const struct spi_buf_set tx = {
+		.buffers = tx_bufs,
+		.count = i,
+	};
 
-		err = sdhc_spi_trace(data, -1,
-				spi_transceive(data->spi, &data->cfg,
-				&tx, &rx),
-				&buf[i], remain);
-		if (err != 0) {
-			return err;
+	struct spi_buf rx_bufs[] = {
+		{
+			.buf = buf,
+			.len = len
 		}
+	};
+
+	const struct spi_buf_set rx = {
+		.buffers = rx_bufs,
+		.count = 1,
+	};
+
+	err = sdhc_spi_trace(data, -1,
+			spi_transceive(data->spi, &data->cfg, &tx, &rx),
+			buf, len);
+	if (err != 0) {
+		return err;
 	}
 
 	err = sdhc_spi_rx_bytes(data, crc, sizeof(crc));
@@ -421,13 +422,13 @@ static int sdhc_spi_rx_block(struct sdhc_spi_data *data,
 
 /* Transmits a SDHC data block */
 static int sdhc_spi_tx_block(struct sdhc_spi_data *data,
-	u8_t *send, int len)
+	u8_t token, u8_t *send, int len)
 {
 	u8_t buf[SDHC_CRC16_SIZE];
 	int err;
 
 	/* Start the block */
-	buf[0] = SDHC_TOKEN_SINGLE;
+	buf[0] = token;
 	err = sdhc_spi_tx(data, buf, 1);
 	if (err != 0) {
 		return err;
@@ -702,6 +703,78 @@ error:
 	return err;
 }
 
+/* Writes several blocks with a single WRITE_MULTIPLE_BLOCK command, which
+ * saves the command and status round trips of every block after the first.
+ */
+static int sdhc_spi_write_multi(struct sdhc_spi_data *data,
+	const u8_t *buf, u32_t sector, u32_t count)
+{
+	u8_t stop = SDHC_TOKEN_STOP_TRAN;
+	int err;
+	u32_t addr;
+
+	if (data->high_capacity) {
+		addr = sector;
+	} else {
+		addr = sector * SDMMC_DEFAULT_BLOCK_SIZE;
+	}
+
+	sdhc_spi_set_cs(data, 0);
+
+	err = sdhc_spi_cmd_r1(data, SDHC_WRITE_MULTIPLE_BLOCK, addr);
+	if (err < 0) {
+		goto error;
+	}
+
+	for (; count != 0U; count--) {
+		err = sdhc_spi_tx_block(data, SDHC_TOKEN_MULTI_WRITE,
+			(u8_t *)buf, SDMMC_DEFAULT_BLOCK_SIZE);
+		if (err != 0) {
+			goto abort;
+		}
+
+		/* Wait for the card to finish programming */
+		err = sdhc_spi_skip_until_ready(data);
+		if (err != 0) {
+			goto abort;
+		}
+
+		buf += SDMMC_DEFAULT_BLOCK_SIZE;
+	}
+
+	/* End the transfer, the card answers with one byte and then
+	 * signals busy until the last block is programmed.
+	 */
+	err = sdhc_spi_tx(data, &stop, sizeof(stop));
+	if (err != 0) {
+		goto error;
+	}
+
+	sdhc_spi_rx_u8(data);
+
+	err = sdhc_spi_skip_until_ready(data);
+	if (err != 0) {
+		goto error;
+	}
+
+	err = sdhc_spi_cmd_r2(data, SDHC_SEND_STATUS, 0);
+	goto error;
+
+abort:
+	/* Leave the card in the transfer state rather than in the middle of
+	 * a multi block write, keeping the original error.
+	 */
+	if (sdhc_spi_tx(data, &stop, sizeof(stop)) == 0) {
+		sdhc_spi_rx_u8(data);
+		(void)sdhc_spi_skip_until_ready(data);
+	}
+
+error:
+	sdhc_spi_set_cs(data, 1);
+
+	return err;
+}
+
 static int sdhc_spi_write(struct sdhc_spi_data *data,
 	const u8_t *buf, u32_t sector, u32_t count)
 {
@@ -713,6 +786,10 @@ static int sdhc_spi_write(struct sdhc_spi_data *data,
 		return err;
 	}
 
+	if (count > 1) {
+		return sdhc_spi_write_multi(data, buf, sector, count);
+	}
+
 	sdhc_spi_set_cs(data, 0);
 
 	/* Write the blocks one-by-one */
@@ -731,7 +808,7 @@ static int sdhc_spi_write(struct sdhc_spi_data *data,
 			goto error;
 		}
 
-		err = sdhc_spi_tx_block(data, (u8_t *)buf,
+		err = sdhc_spi_tx_block(data, SDHC_TOKEN_SINGLE, (u8_t *)buf,
 			SDMMC_DEFAULT_BLOCK_SIZE);
 		if (err != 0) {
 			goto error;
@@ -114,6 +114,10 @@ fcb_init(int f_area_id, struct fcb *fcb)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_FCB_ELEM_CACHE
+	(void)memset(fcb->f_elem_cache, 0, sizeof(fcb->f_elem_cache));
+#endif
+
 	/* Fill last used, first used */
 	for (i = 0; i < fcb->f_sector_cnt; i++) {
 		sector = &fcb->f_sectors[i];
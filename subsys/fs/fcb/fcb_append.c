@@ -133,5 +133,9 @@ fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
 	if (rc) {
 		return -EIO;
 	}
+
+#ifdef CONFIG_FCB_ELEM_CACHE
+	fcb_elem_cache_add(fcb, loc);
+#endif
 	return 0;
 }
@@ -63,6 +63,57 @@ fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, u8_t *c8p)
 	return 0;
 }
 
+#ifdef CONFIG_FCB_ELEM_CACHE
+static struct fcb_elem_cache_entry *
+fcb_elem_cache_slot(struct fcb *fcb, u8_t sector, u32_t elem_off)
+{
+	size_t pos = (elem_off + sector * 97U) % CONFIG_FCB_ELEM_CACHE_SIZE;
+
+	return &fcb->f_elem_cache[pos];
+}
+
+void fcb_elem_cache_add(struct fcb *fcb, const struct fcb_entry *loc)
+{
+	struct fcb_elem_cache_entry *entry;
+	u8_t sector = loc->fe_sector - fcb->f_sectors;
+
+	entry = fcb_elem_cache_slot(fcb, sector, loc->fe_elem_off);
+	entry->elem_off = loc->fe_elem_off;
+	entry->sector = sector;
+	entry->data_len = loc->fe_data_len;
+	entry->hdr_len = loc->fe_data_off - loc->fe_elem_off;
+}
+
+void fcb_elem_cache_invalidate(struct fcb *fcb,
+			       const struct flash_sector *sector)
+{
+	u8_t idx = sector - fcb->f_sectors;
+
+	for (int i = 0; i < CONFIG_FCB_ELEM_CACHE_SIZE; i++) {
+		if (fcb->f_elem_cache[i].sector == idx) {
+			fcb->f_elem_cache[i].elem_off = 0U;
+		}
+	}
+}
+
+static bool fcb_elem_cache_lookup(struct fcb *fcb, struct fcb_entry *loc)
+{
+	struct fcb_elem_cache_entry *entry;
+	u8_t sector = loc->fe_sector - fcb->f_sectors;
+
+	entry = fcb_elem_cache_slot(fcb, sector, loc->fe_elem_off);
+	if ((entry->elem_off != loc->fe_elem_off) ||
+	    (entry->sector != sector)) {
+		return false;
+	}
+
+	loc->fe_data_off = loc->fe_elem_off + entry->hdr_len;
+	loc->fe_data_len = entry->data_len;
+
+	return true;
+}
+#endif /* CONFIG_FCB_ELEM_CACHE */
+
 int fcb_elem_info(struct fcb *fcb, struct fcb_entry *loc)
 {
 	int rc;
@@ -70,6 +121,12 @@ int fcb_elem_info(struct fcb *fcb, struct fcb_entry *loc)
 	u8_t fl_crc8;
 	off_t off;
 
+#ifdef CONFIG_FCB_ELEM_CACHE
+	if (fcb_elem_cache_lookup(fcb, loc)) {
+		return 0;
+	}
+#endif
+
 	rc = fcb_elem_crc8(fcb, loc, &crc8);
 	if (rc) {
 		return rc;
@@ -84,5 +141,9 @@ int fcb_elem_info(struct fcb *fcb, struct fcb_entry *loc)
 	if (fl_crc8 != crc8) {
 		return -EBADMSG;
 	}
+
+#ifdef CONFIG_FCB_ELEM_CACHE
+	fcb_elem_cache_add(fcb, loc);
+#endif
 	return 0;
 }
@@ -47,6 +47,12 @@ int fcb_getnext_nolock(struct fcb *fcb, struct fcb_entry *loc);
 int fcb_elem_info(struct fcb *fcb, struct fcb_entry *loc);
 int fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, u8_t *crc8p);
 
+#ifdef CONFIG_FCB_ELEM_CACHE
+void fcb_elem_cache_add(struct fcb *fcb, const struct fcb_entry *loc);
+void fcb_elem_cache_invalidate(struct fcb *fcb,
+			       const struct flash_sector *sector);
+#endif
+
 int fcb_sector_hdr_init(struct fcb *fcb, struct flash_sector *sector, u16_t id);
 int fcb_sector_hdr_read(struct fcb *fcb, struct flash_sector *sector,
 			struct fcb_disk_area *fdap);
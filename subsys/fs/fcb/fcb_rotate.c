@@ -19,6 +19,9 @@ fcb_rotate(struct fcb *fcb)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_FCB_ELEM_CACHE
+	fcb_elem_cache_invalidate(fcb, fcb->f_oldest);
+#endif
 	rc = fcb_erase_sector(fcb, fcb->f_oldest);
 	if (rc) {
 		rc = -EIO;
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <errno.h>
+#include <string.h>
+#include <fs/fs.h>
+
+enum fs_async_op {
+	FS_ASYNC_READ,
+	FS_ASYNC_WRITE,
+};
+
+struct fs_async_req {
+	struct fs_file_t *zfp;
+	void *ptr;
+	size_t size;
+	struct k_poll_signal *sig;
+	enum fs_async_op op;
+};
+
+K_MSGQ_DEFINE(fs_async_msgq, sizeof(struct fs_async_req),
+	      CONFIG_FILE_SYSTEM_ASYNC_QUEUE_SIZE, 4);
+
+#if CONFIG_FILE_SYSTEM_ASYNC_MERGE_SIZE > 0
+static u8_t fs_async_merge_buf[CONFIG_FILE_SYSTEM_ASYNC_MERGE_SIZE];
+#endif
+
+static int fs_async_submit(struct fs_async_req *req)
+{
+	/* Never block the caller, this is the whole point of the API */
+	if (k_msgq_put(&fs_async_msgq, req, K_NO_WAIT)) {
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+int fs_read_async(struct fs_file_t *zfp, void *ptr, size_t size,
+		  struct k_poll_signal *sig)
+{
+	struct fs_async_req req = {
+		.zfp = zfp,
+		.ptr = ptr,
+		.size = size,
+		.sig = sig,
+		.op = FS_ASYNC_READ,
+	};
+
+	return fs_async_submit(&req);
+}
+
+int fs_write_async(struct fs_file_t *zfp, const void *ptr, size_t size,
+		   struct k_poll_signal *sig)
+{
+	struct fs_async_req req = {
+		.zfp = zfp,
+		.ptr = (void *)ptr,
+		.size = size,
+		.sig = sig,
+		.op = FS_ASYNC_WRITE,
+	};
+
+	return fs_async_submit(&req);
+}
+
+static void fs_async_signal(struct fs_async_req *req, ssize_t result)
+{
+	if (req->sig) {
+		k_poll_signal_raise(req->sig, result);
+	}
+}
+
+#if CONFIG_FILE_SYSTEM_ASYNC_MERGE_SIZE > 0
+/* Write req together with the writes to the same file queued right after
+ * it, as long as they fit in the merge buffer.
+ */
+static void fs_async_write_merged(struct fs_async_req *req)
+{
+	struct fs_async_req merged[CONFIG_FILE_SYSTEM_ASYNC_QUEUE_SIZE + 1];
+	struct fs_async_req next;
+	size_t cnt = 0;
+	size_t used = 0;
+	ssize_t ret;
+
+	while (1) {
+		memcpy(&fs_async_merge_buf[used], req->ptr, req->size);
+		used += req->size;
+		merged[cnt++] = *req;
+
+		if ((cnt == ARRAY_SIZE(merged)) ||
+		    k_msgq_peek(&fs_async_msgq, &next) ||
+		    (next.op != FS_ASYNC_WRITE) || (next.zfp != req->zfp) ||
+		    (next.size > sizeof(fs_async_merge_buf) - used)) {
+			break;
+		}
+
+		(void)k_msgq_get(&fs_async_msgq, &next, K_NO_WAIT);
+		req = &next;
+	}
+
+	ret = fs_write(merged[0].zfp, fs_async_merge_buf, used);
+
+	/* Report each request as if it had been written on its own */
+	for (size_t i = 0; i < cnt; i++) {
+		ssize_t result = ret;
+
+		if (ret >= 0) {
+			result = MIN(merged[i].size, (size_t)ret);
+			ret -= result;
+		}
+
+		fs_async_signal(&merged[i], result);
+	}
+}
+#endif /* CONFIG_FILE_SYSTEM_ASYNC_MERGE_SIZE > 0 */
+
+static void fs_async_thread(void *p1, void *p2, void *p3)
+{
+	struct fs_async_req req;
+
+	while (1) {
+		k_msgq_get(&fs_async_msgq, &req, K_FOREVER);
+
+		if (req.op == FS_ASYNC_READ) {
+			fs_async_signal(&req, fs_read(req.zfp, req.ptr,
+						      req.size));
+			continue;
+		}
+
+#if CONFIG_FILE_SYSTEM_ASYNC_MERGE_SIZE > 0
+		if (req.size <= sizeof(fs_async_merge_buf)) {
+			fs_async_write_merged(&req);
+			continue;
+		}
+#endif
+
+		fs_async_signal(&req, fs_write(req.zfp, req.ptr, req.size));
+	}
+}
+
+K_THREAD_DEFINE(fs_async_tid, CONFIG_FILE_SYSTEM_ASYNC_THREAD_STACK_SIZE,
+		fs_async_thread, NULL, NULL, NULL,
+		CONFIG_FILE_SYSTEM_ASYNC_THREAD_PRIO, 0, K_NO_WAIT);
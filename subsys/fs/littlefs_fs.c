@@ -132,12 +132,67 @@ static int errno_to_lfs(int error)
 }
 
 
+#ifdef CONFIG_FS_LITTLEFS_READ_AHEAD
+static inline struct fs_littlefs *lfs_api_fs(const struct lfs_config *c)
+{
+	return CONTAINER_OF(c, struct fs_littlefs, cfg);
+}
+
+static void lfs_api_ra_invalidate(const struct lfs_config *c,
+				  lfs_block_t block)
+{
+	struct fs_littlefs *fs = lfs_api_fs(c);
+
+	if (fs->ra_block == block) {
+		fs->ra_len = 0;
+	}
+}
+
+/* Serve a small read from the read ahead buffer, refilling it from the
+ * start of the requested range up to the end of the block on a miss.
+ */
+static int lfs_api_read_ahead(const struct lfs_config *c, lfs_block_t block,
+			      lfs_off_t off, void *buffer, lfs_size_t size)
+{
+	struct fs_littlefs *fs = lfs_api_fs(c);
+
+	if ((fs->ra_len == 0) || (fs->ra_block != block) ||
+	    (off < fs->ra_off) || (off + size > fs->ra_off + fs->ra_len)) {
+		const struct flash_area *fa = c->context;
+		lfs_size_t len = MIN(sizeof(fs->ra_buffer),
+				     c->block_size - off);
+		int rc;
+
+		rc = flash_area_read(fa, block * c->block_size + off,
+				     fs->ra_buffer, len);
+		if (rc < 0) {
+			fs->ra_len = 0;
+			return errno_to_lfs(rc);
+		}
+
+		fs->ra_block = block;
+		fs->ra_off = off;
+		fs->ra_len = len;
+	}
+
+	memcpy(buffer, &fs->ra_buffer[off - fs->ra_off], size);
+
+	return LFS_ERR_OK;
+}
+#endif /* CONFIG_FS_LITTLEFS_READ_AHEAD */
+
 static int lfs_api_read(const struct lfs_config *c, lfs_block_t block,
 			lfs_off_t off, void *buffer, lfs_size_t size)
 {
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size + off;
 
+#ifdef CONFIG_FS_LITTLEFS_READ_AHEAD
+	if (size < CONFIG_FS_LITTLEFS_READ_AHEAD_SIZE) {
+		return lfs_api_read_ahead(c, block, off, buffer, size);
+	}
+#endif
+
 	int rc = flash_area_read(fa, offset, buffer, size);
 
 	return errno_to_lfs(rc);
@@ -149,6 +204,10 @@ static int lfs_api_prog(const struct lfs_config *c, lfs_block_t block,
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size + off;
 
+#ifdef CONFIG_FS_LITTLEFS_READ_AHEAD
+	lfs_api_ra_invalidate(c, block);
+#endif
+
 	int rc = flash_area_write(fa, offset, buffer, size);
 
 	return errno_to_lfs(rc);
@@ -159,6 +218,10 @@ static int lfs_api_erase(const struct lfs_config *c, lfs_block_t block)
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size;
 
+#ifdef CONFIG_FS_LITTLEFS_READ_AHEAD
+	lfs_api_ra_invalidate(c, block);
+#endif
+
 	int rc = flash_area_erase(fa, offset, c->block_size);
 
 	return errno_to_lfs(rc);
@@ -627,6 +690,12 @@ static int littlefs_mount(struct fs_mount_t *mountp)
 	/* No, you don't get to override this. */
 	lfs_size_t block_count = fs->area->fa_size / block_size;
 
+	/* Each lookahead byte tracks 8 blocks, a buffer covering more
+	 * than the whole partition only makes allocation scans longer.
+	 */
+	lookahead_size = MIN(lookahead_size,
+			     ROUND_UP(ceiling_fraction(block_count, 8), 8));
+
 	LOG_INF("FS at %s:0x%x is %u 0x%x-byte blocks with %u cycle",
 		dev->config->name, (u32_t)fs->area->fa_off,
 		block_count, block_size, block_cycles);
@@ -645,6 +714,10 @@ static int littlefs_mount(struct fs_mount_t *mountp)
 	__ASSERT((block_size % cache_size) == 0,
 		 "cache size incompatible with block size");
 
+#ifdef CONFIG_FS_LITTLEFS_READ_AHEAD
+	fs->ra_len = 0;
+#endif
+
 	/* Set the validated/defaulted values. */
 	lcp->context = (void *)fs->area;
 	lcp->read = lfs_api_read;
@@ -16,6 +16,40 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(fs_nvs, CONFIG_NVS_LOG_LEVEL);
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+
+#define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
+
+static inline size_t nvs_lookup_cache_pos(u16_t id)
+{
+	u16_t hash = id;
+
+	/* Mix the bits so that ids at a fixed distance, like the settings
+	 * name and value ids, do not land in the same bucket.
+	 */
+	hash ^= hash >> 8;
+	hash *= 0x88b5U;
+	hash ^= hash >> 7;
+	hash *= 0xdb2dU;
+	hash ^= hash >> 9;
+
+	return hash % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+}
+
+/* drop all cache entries that point into the sector at addr */
+static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, u32_t addr)
+{
+	u32_t sector = addr >> ADDR_SECT_SHIFT;
+
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		if ((fs->lookup_cache[i] >> ADDR_SECT_SHIFT) == sector) {
+			fs->lookup_cache[i] = NVS_LOOKUP_CACHE_NO_ADDR;
+		}
+	}
+}
+
+#endif /* CONFIG_NVS_LOOKUP_CACHE */
+
 
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
@@ -103,6 +137,13 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 
 	rc = nvs_flash_al_wrt(fs, fs->ate_wra, entry,
 			       sizeof(struct nvs_ate));
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	/* 0xFFFF is a special-purpose identifier. Exclude it from the cache */
+	if (!rc && (entry->id != 0xFFFF)) {
+		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] =
+			fs->ate_wra;
+	}
+#endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	return rc;
@@ -221,6 +262,9 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, u32_t addr)
 	off_t offset;
 
 	addr &= ADDR_SECT_MASK;
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	nvs_lookup_cache_invalidate(fs, addr);
+#endif
 	rc = nvs_flash_cmp_const(fs, addr, 0xff, fs->sector_size);
 	if (rc <= 0) {
 		/* flash error or empty sector */
@@ -534,6 +578,90 @@ static int nvs_gc(struct nvs_fs *fs)
 	return 0;
 }
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+/* rebuild the cache by walking all ates from newest to oldest, the first
+ * valid ate found for a bucket is the most recent one.
+ */
+static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	u32_t addr, ate_addr;
+	u32_t *cache_entry;
+	struct nvs_ate ate;
+
+	memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+	addr = fs->ate_wra;
+
+	while (1) {
+		/* nvs_prev_ate() advances addr, keep the ate address */
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		cache_entry = &fs->lookup_cache[nvs_lookup_cache_pos(ate.id)];
+		if ((ate.id != 0xFFFF) &&
+		    (*cache_entry == NVS_LOOKUP_CACHE_NO_ADDR) &&
+		    (!nvs_ate_crc8_check(&ate))) {
+			*cache_entry = ate_addr;
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NVS_LOOKUP_CACHE */
+
+#ifdef CONFIG_NVS_BACKGROUND_GC
+/* background gc is needed when the write sector is filled above the
+ * watermark. It is done at most once per sector: when the entries copied
+ * by gc already fill the new sector past the watermark, gc'ing again will
+ * not free any space.
+ */
+static bool nvs_gc_bg_needed(struct nvs_fs *fs)
+{
+	size_t free_space;
+
+	if ((fs->ate_wra >> ADDR_SECT_SHIFT) == fs->gc_bg_sector) {
+		return false;
+	}
+
+	free_space = fs->ate_wra - fs->data_wra;
+
+	return free_space < (fs->sector_size *
+		(100 - CONFIG_NVS_BACKGROUND_GC_WATERMARK)) / 100U;
+}
+
+static void nvs_gc_work_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+	int rc;
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	if (!nvs_gc_bg_needed(fs)) {
+		goto end;
+	}
+
+	rc = nvs_sector_close(fs);
+	if (!rc) {
+		rc = nvs_gc(fs);
+	}
+	if (rc) {
+		LOG_ERR("Background gc failed (%d)", rc);
+	}
+
+	fs->gc_bg_sector = fs->ate_wra >> ADDR_SECT_SHIFT;
+
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+}
+#endif /* CONFIG_NVS_BACKGROUND_GC */
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -664,6 +792,10 @@ static int nvs_startup(struct nvs_fs *fs)
 		}
 	}
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	rc = nvs_lookup_cache_rebuild(fs);
+#endif
+
 end:
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
@@ -696,6 +828,10 @@ int nvs_init(struct nvs_fs *fs, const char *dev_name)
 	struct flash_pages_info info;
 
 	k_mutex_init(&fs->nvs_lock);
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	k_work_init(&fs->gc_work, nvs_gc_work_handler);
+	fs->gc_bg_sector = fs->sector_count;
+#endif
 
 	fs->flash_device = device_get_binding(dev_name);
 	if (!fs->flash_device) {
@@ -774,7 +910,14 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 	}
 
 	/* find latest entry with same id */
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		goto no_cached_entry;
+	}
+#else
 	wlk_addr = fs->ate_wra;
+#endif
 	rd_addr = wlk_addr;
 
 	while (1) {
@@ -792,6 +935,10 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 		}
 	}
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+no_cached_entry:
+#endif
+
 	if (prev_found) {
 		/* previous entry found */
 		rd_addr &= ADDR_SECT_MASK;
@@ -860,6 +1007,11 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 		gc_count++;
 	}
 	rc = len;
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	if (nvs_gc_bg_needed(fs)) {
+		k_work_submit(&fs->gc_work);
+	}
+#endif
 end:
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
@@ -892,7 +1044,15 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, u16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		rc = -ENOENT;
+		goto err;
+	}
+#else
 	wlk_addr = fs->ate_wra;
+#endif
 	rd_addr = wlk_addr;
 
 	while (cnt_his <= cnt) {
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <drivers/ipm.h>
+#include <ipc/ipc_shm.h>
+#include <logging/log.h>
+
+LOG_MODULE_REGISTER(ipc_shm, CONFIG_IPC_SHM_LOG_LEVEL);
+
+/* Ring entries hold the index of a block and the length of its message */
+#define ENTRY(idx, len)		(((u32_t)(idx) << 16) | (len))
+#define ENTRY_IDX(entry)	((entry) >> 16)
+#define ENTRY_LEN(entry)	((entry) & 0xffff)
+
+/* Orders the accesses to shared memory with respect to the other core */
+#define shm_barrier()		__sync_synchronize()
+
+static void ring_init(struct ipc_shm_ring *ring, volatile u32_t *hdr,
+		      volatile u32_t *slot, u16_t blocks)
+{
+	ring->head = &hdr[0];
+	ring->tail = &hdr[1];
+	ring->slot = slot;
+	ring->mask = blocks - 1;
+}
+
+static void region_init(struct ipc_shm_region *region,
+			const struct ipc_shm_region_cfg *cfg)
+{
+	volatile u32_t *hdr = cfg->shm;
+	volatile u32_t *slots = &hdr[4];
+
+	ring_init(&region->msg, &hdr[0], slots, cfg->blocks);
+	ring_init(&region->ret, &hdr[2], &slots[cfg->blocks], cfg->blocks);
+	region->pool = (u8_t *)&slots[2 * cfg->blocks];
+	region->block_size = cfg->block_size;
+}
+
+static bool ring_empty(const struct ipc_shm_ring *ring)
+{
+	return *ring->head == *ring->tail;
+}
+
+/* The ring holds at most one entry per block, so it is never full */
+static void ring_put(struct ipc_shm_ring *ring, u32_t entry)
+{
+	u32_t head = *ring->head;
+
+	ring->slot[head & ring->mask] = entry;
+	shm_barrier();
+	*ring->head = head + 1;
+}
+
+/* Returns true if the consumer had caught up before the entry was added */
+static bool ring_put_notify(struct ipc_shm_ring *ring, u32_t entry)
+{
+	u32_t head = *ring->head;
+
+	ring_put(ring, entry);
+
+	/* Pairs with the barrier of the consumer after updating the tail:
+	 * either it sees the new head, or we see that it stopped at the
+	 * previous one and needs a doorbell.
+	 */
+	shm_barrier();
+
+	return *ring->tail == head;
+}
+
+static bool ring_get(struct ipc_shm_ring *ring, u32_t *entry)
+{
+	u32_t tail = *ring->tail;
+
+	if (tail == *ring->head) {
+		return false;
+	}
+
+	shm_barrier();
+	*entry = ring->slot[tail & ring->mask];
+	shm_barrier();
+	*ring->tail = tail + 1;
+
+	return true;
+}
+
+static void ipc_shm_rx_work(struct k_work *work)
+{
+	struct ipc_shm *ipc = CONTAINER_OF(work, struct ipc_shm, rx_work);
+	const struct ipc_shm_cfg *cfg = ipc->cfg;
+	struct ipc_shm_region *rx = &ipc->rx;
+	u32_t entry;
+
+	do {
+		while (ring_get(&rx->msg, &entry)) {
+			if (ENTRY_IDX(entry) >= cfg->rx.blocks ||
+			    ENTRY_LEN(entry) > rx->block_size) {
+				LOG_ERR("Invalid message entry 0x%08x", entry);
+				continue;
+			}
+
+			cfg->cb(ipc, rx->pool + ENTRY_IDX(entry) *
+					rx->block_size,
+				ENTRY_LEN(entry), cfg->user_data);
+		}
+
+		/* Messages sent while the tail was updated did not ring */
+		shm_barrier();
+	} while (!ring_empty(&rx->msg));
+}
+
+static void ipc_shm_doorbell(void *context, u32_t id, volatile void *data)
+{
+	struct ipc_shm *ipc = context;
+
+	ARG_UNUSED(id);
+	ARG_UNUSED(data);
+
+	k_work_submit(&ipc->rx_work);
+}
+
+int ipc_shm_init(struct ipc_shm *ipc, const struct ipc_shm_cfg *cfg)
+{
+	int i;
+
+	if (cfg->cb == NULL || cfg->tx.shm == NULL || cfg->rx.shm == NULL ||
+	    cfg->tx.blocks == 0 || (cfg->tx.blocks & (cfg->tx.blocks - 1)) ||
+	    cfg->rx.blocks == 0 || (cfg->rx.blocks & (cfg->rx.blocks - 1)) ||
+	    (cfg->tx.block_size & 3) || (cfg->rx.block_size & 3)) {
+		return -EINVAL;
+	}
+
+	ipc->cfg = cfg;
+	region_init(&ipc->tx, &cfg->tx);
+	region_init(&ipc->rx, &cfg->rx);
+	k_work_init(&ipc->rx_work, ipc_shm_rx_work);
+
+	/* All the blocks start in the ring of released blocks */
+	*ipc->tx.msg.head = 0U;
+	*ipc->tx.msg.tail = 0U;
+	*ipc->tx.ret.tail = 0U;
+	for (i = 0; i < cfg->tx.blocks; i++) {
+		ipc->tx.ret.slot[i] = ENTRY(i, 0);
+	}
+	shm_barrier();
+	*ipc->tx.ret.head = cfg->tx.blocks;
+
+	ipm_register_callback(cfg->ipm_rx, ipc_shm_doorbell, ipc);
+
+	return ipm_set_enabled(cfg->ipm_rx, 1);
+}
+
+void *ipc_shm_alloc(struct ipc_shm *ipc)
+{
+	k_spinlock_key_t key = k_spin_lock(&ipc->lock);
+	u32_t entry;
+	bool ret;
+
+	ret = ring_get(&ipc->tx.ret, &entry);
+	k_spin_unlock(&ipc->lock, key);
+
+	if (!ret) {
+		return NULL;
+	}
+
+	return ipc->tx.pool + ENTRY_IDX(entry) * ipc->tx.block_size;
+}
+
+int ipc_shm_send(struct ipc_shm *ipc, void *buf, size_t len)
+{
+	size_t off = (u8_t *)buf - ipc->tx.pool;
+	k_spinlock_key_t key;
+	bool notify;
+
+	if ((u8_t *)buf < ipc->tx.pool || off % ipc->tx.block_size ||
+	    off / ipc->tx.block_size >= ipc->cfg->tx.blocks ||
+	    len > ipc->tx.block_size) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&ipc->lock);
+	notify = ring_put_notify(&ipc->tx.msg,
+				 ENTRY(off / ipc->tx.block_size, len));
+	k_spin_unlock(&ipc->lock, key);
+
+	if (!notify) {
+		/* The remote core is still draining the ring */
+		return 0;
+	}
+
+	return ipm_send(ipc->cfg->ipm_tx, 0, ipc->cfg->ipm_id, NULL, 0);
+}
+
+void ipc_shm_release(struct ipc_shm *ipc, void *data)
+{
+	size_t off = (u8_t *)data - ipc->rx.pool;
+	k_spinlock_key_t key;
+
+	__ASSERT(off % ipc->rx.block_size == 0 &&
+		 off / ipc->rx.block_size < ipc->cfg->rx.blocks,
+		 "Not a received message");
+
+	key = k_spin_lock(&ipc->lock);
+	ring_put(&ipc->rx.ret, ENTRY(off / ipc->rx.block_size, 0));
+	k_spin_unlock(&ipc->lock, key);
+}
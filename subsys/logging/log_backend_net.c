@@ -29,6 +29,12 @@ LOG_MODULE_REGISTER(log_backend_net, CONFIG_LOG_DEFAULT_LEVEL);
 #define MAX_HOSTNAME_LEN NET_IPV4_ADDR_LEN
 #endif
 
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+#define BATCH_TIMEOUT_MS CONFIG_LOG_BACKEND_NET_BATCH_TIMEOUT_MS
+#else
+#define BATCH_TIMEOUT_MS 0
+#endif
+
 static char hostname[MAX_HOSTNAME_LEN + 1];
 
 static u8_t output_buf[CONFIG_LOG_BACKEND_NET_MAX_BUF_SIZE];
@@ -36,6 +42,22 @@ static bool net_init_done;
 struct sockaddr server_addr;
 static bool panic_mode;
 
+/* Formatted message is collected in msg_buf and then appended (with an
+ * optional RFC 6587 octet counting prefix) to the batch which is sent when
+ * next message does not fit or when batching timeout expires.
+ */
+static u8_t msg_buf[CONFIG_LOG_BACKEND_NET_MAX_BUF_SIZE];
+static size_t msg_len;
+static u8_t batch_buf[CONFIG_LOG_BACKEND_NET_MAX_BUF_SIZE];
+static size_t batch_len;
+static u32_t dropped_cnt;
+static struct net_context *net_ctx;
+
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+static K_MUTEX_DEFINE(batch_mutex);
+static struct k_delayed_work batch_work;
+#endif
+
 const struct log_backend *log_backend_net_get(void);
 
 NET_PKT_SLAB_DEFINE(syslog_tx_pkts, CONFIG_LOG_BACKEND_NET_MAX_BUF);
@@ -56,24 +78,129 @@ struct net_buf_pool *get_data_pool(void)
 
 static int line_out(u8_t *data, size_t length, void *output_ctx)
 {
-	struct net_context *ctx = (struct net_context *)output_ctx;
-	int ret = -ENOMEM;
+	size_t len = MIN(length, sizeof(msg_buf) - msg_len);
+
+	/* Message is truncated if it does not fit. */
+	(void)memcpy(&msg_buf[msg_len], data, len);
+	msg_len += len;
+
+	return length;
+}
+
+LOG_OUTPUT_DEFINE(log_output, line_out, output_buf, sizeof(output_buf));
+
+static void batch_send(void)
+{
+	int ret;
 
-	if (ctx == NULL) {
-		return length;
+	if (batch_len == 0 || net_ctx == NULL) {
+		batch_len = 0;
+		return;
 	}
 
-	ret = net_context_send(ctx, data, length, NULL, K_NO_WAIT, NULL);
+	ret = net_context_send(net_ctx, batch_buf, batch_len, NULL,
+			       K_NO_WAIT, NULL);
 	if (ret < 0) {
-		goto fail;
+		DBG("Cannot send (%d)\n", ret);
+		if (IS_ENABLED(CONFIG_LOG_BACKEND_NET_TCP) &&
+		    ret == -ENOTCONN) {
+			/* Connection is established again on next message. */
+			(void)net_context_put(net_ctx);
+			net_ctx = NULL;
+			net_init_done = false;
+		}
+	} else {
+		DBG("%.*s", (int)batch_len, batch_buf);
 	}
 
-	DBG(data);
-fail:
-	return length;
+	batch_len = 0;
 }
 
-LOG_OUTPUT_DEFINE(log_output, line_out, output_buf, sizeof(output_buf));
+static void batch_lock(void)
+{
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+	(void)k_mutex_lock(&batch_mutex, K_FOREVER);
+#endif
+}
+
+static void batch_unlock(void)
+{
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+	(void)k_mutex_unlock(&batch_mutex);
+#endif
+}
+
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+static void batch_timeout(struct k_work *work)
+{
+	batch_lock();
+	batch_send();
+	batch_unlock();
+}
+#endif
+
+/* Move formatted message to the batch. */
+static void msg_commit(void)
+{
+	char prefix[sizeof("65535 ")];
+	int prefix_len = 0;
+
+	if (msg_len == 0) {
+		return;
+	}
+
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_NET_TCP)) {
+		prefix_len = snprintk(prefix, sizeof(prefix), "%u ",
+				      (unsigned int)msg_len);
+	}
+
+	batch_lock();
+
+	if (batch_len + prefix_len + msg_len > sizeof(batch_buf)) {
+		batch_send();
+	}
+
+	if (prefix_len + msg_len <= sizeof(batch_buf)) {
+		(void)memcpy(&batch_buf[batch_len], prefix, prefix_len);
+		batch_len += prefix_len;
+		(void)memcpy(&batch_buf[batch_len], msg_buf, msg_len);
+		batch_len += msg_len;
+	}
+
+	if (BATCH_TIMEOUT_MS == 0) {
+		batch_send();
+	}
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+	else if (!k_delayed_work_remaining_get(&batch_work)) {
+		(void)k_delayed_work_submit(&batch_work,
+					    K_MSEC(BATCH_TIMEOUT_MS));
+	}
+#endif
+
+	batch_unlock();
+
+	msg_len = 0;
+}
+
+/* Drop messages before they are formatted if there are no free network
+ * packets. Otherwise, message would be formatted only to be dropped by the
+ * network stack.
+ */
+static bool tx_congested(void)
+{
+	return k_mem_slab_num_free_get(get_tx_slab()) == 0U;
+}
+
+static void dropped_report(void)
+{
+	if (dropped_cnt == 0U) {
+		return;
+	}
+
+	log_output_dropped_process(&log_output, dropped_cnt);
+	msg_commit();
+	dropped_cnt = 0U;
+}
 
 static int do_net_init(void)
 {
@@ -103,7 +230,11 @@ static int do_net_init(void)
 
 	local_addr->sa_family = server_addr.sa_family;
 
-	ret = net_context_get(server_addr.sa_family, SOCK_DGRAM, IPPROTO_UDP,
+	ret = net_context_get(server_addr.sa_family,
+			      IS_ENABLED(CONFIG_LOG_BACKEND_NET_TCP) ?
+			      SOCK_STREAM : SOCK_DGRAM,
+			      IS_ENABLED(CONFIG_LOG_BACKEND_NET_TCP) ?
+			      IPPROTO_TCP : IPPROTO_UDP,
 			      &ctx);
 	if (ret < 0) {
 		DBG("Cannot get context (%d)\n", ret);
@@ -151,23 +282,37 @@ static int do_net_init(void)
 	ret = net_context_bind(ctx, local_addr, server_addr_len);
 	if (ret < 0) {
 		DBG("Cannot bind context (%d)\n", ret);
-		return ret;
+		goto fail;
 	}
 
-	(void)net_context_connect(ctx, &server_addr, server_addr_len,
-				  NULL, K_NO_WAIT, NULL);
-
-	/* We do not care about return value for this UDP connect call that
-	 * basically does nothing. Calling the connect is only useful so that
-	 * we can see the syslog connection in net-shell.
-	 */
-
 	net_context_setup_pools(ctx, get_tx_slab, get_data_pool);
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_NET_TCP)) {
+		ret = net_context_connect(ctx, &server_addr, server_addr_len,
+					  NULL, K_SECONDS(1), NULL);
+		if (ret < 0) {
+			DBG("Cannot connect (%d)\n", ret);
+			goto fail;
+		}
+	} else {
+		/* We do not care about return value for this UDP connect
+		 * call that basically does nothing. Calling the connect is
+		 * only useful so that we can see the syslog connection in
+		 * net-shell.
+		 */
+		(void)net_context_connect(ctx, &server_addr, server_addr_len,
+					  NULL, K_NO_WAIT, NULL);
+	}
+
+	net_ctx = ctx;
 	log_output_ctx_set(&log_output, ctx);
 	log_output_hostname_set(&log_output, hostname);
 
 	return 0;
+
+fail:
+	(void)net_context_put(ctx);
+	return ret;
 }
 
 static void send_output(const struct log_backend *const backend,
@@ -181,6 +326,13 @@ static void send_output(const struct log_backend *const backend,
 		net_init_done = true;
 	}
 
+	if (tx_congested()) {
+		dropped_cnt++;
+		return;
+	}
+
+	dropped_report();
+
 	log_msg_get(msg);
 
 	log_output_msg_process(&log_output, msg,
@@ -188,6 +340,7 @@ static void send_output(const struct log_backend *const backend,
 			       LOG_OUTPUT_FLAG_TIMESTAMP |
 			(IS_ENABLED(CONFIG_LOG_BACKEND_NET_SYST_ENABLE) ?
 			LOG_OUTPUT_FLAG_FORMAT_SYST : 0));
+	msg_commit();
 
 	log_msg_put(msg);
 }
@@ -196,6 +349,10 @@ static void init_net(void)
 {
 	int ret;
 
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+	k_delayed_work_init(&batch_work, batch_timeout);
+#endif
+
 	net_sin(&server_addr)->sin_port = htons(514);
 
 	ret = net_ipaddr_parse(CONFIG_LOG_BACKEND_NET_SERVER,
@@ -230,6 +387,7 @@ static void sync_string(const struct log_backend *const backend,
 
 	key = irq_lock();
 	log_output_string(&log_output, src_level, timestamp, fmt, ap, flags);
+	msg_commit();
 	irq_unlock(key);
 }
 
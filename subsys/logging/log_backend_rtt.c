@@ -224,6 +224,10 @@ static void put(const struct log_backend *const backend,
 	u32_t flag = IS_ENABLED(CONFIG_LOG_BACKEND_RTT_SYST_ENABLE) ?
 		LOG_OUTPUT_FLAG_FORMAT_SYST : 0;
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_RTT_OUTPUT_DICTIONARY)) {
+		flag = LOG_OUTPUT_FLAG_FORMAT_DICT;
+	}
+
 	log_backend_std_put(&log_output, flag, msg);
 }
 
@@ -255,6 +259,11 @@ static void dropped(const struct log_backend *const backend, u32_t cnt)
 {
 	ARG_UNUSED(backend);
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_RTT_OUTPUT_DICTIONARY)) {
+		log_output_dropped_dict_process(&log_output, cnt);
+		return;
+	}
+
 	log_backend_std_dropped(&log_output, cnt);
 }
 
@@ -265,6 +274,10 @@ static void sync_string(const struct log_backend *const backend,
 	u32_t flag = IS_ENABLED(CONFIG_LOG_BACKEND_RTT_SYST_ENABLE) ?
 		LOG_OUTPUT_FLAG_FORMAT_SYST : 0;
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_RTT_OUTPUT_DICTIONARY)) {
+		flag = LOG_OUTPUT_FLAG_FORMAT_DICT;
+	}
+
 	log_backend_std_sync_string(&log_output, flag, src_level,
 				    timestamp, fmt, ap);
 }
@@ -276,6 +289,10 @@ static void sync_hexdump(const struct log_backend *const backend,
 	u32_t flag = IS_ENABLED(CONFIG_LOG_BACKEND_RTT_SYST_ENABLE) ?
 		LOG_OUTPUT_FLAG_FORMAT_SYST : 0;
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_RTT_OUTPUT_DICTIONARY)) {
+		flag = LOG_OUTPUT_FLAG_FORMAT_DICT;
+	}
+
 	log_backend_std_sync_hexdump(&log_output, flag, src_level,
 				     timestamp, metadata, data, length);
 }
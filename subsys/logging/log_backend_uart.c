@@ -12,21 +12,130 @@
 #include <device.h>
 #include <drivers/uart.h>
 #include <assert.h>
+#include <string.h>
+
+static void poll_out(struct device *dev, u8_t *data, size_t length)
+{
+	for (size_t i = 0; i < length; i++) {
+		uart_poll_out(dev, data[i]);
+	}
+}
+
+#ifdef CONFIG_LOG_BACKEND_UART_ASYNC
+#define ASYNC_BUF_SIZE CONFIG_LOG_BACKEND_UART_ASYNC_BUF_SIZE
+#define OUTPUT_BUF_SIZE 32
+
+/* Formatted output is collected in one buffer while the other one is being
+ * transferred by the UART driver. Driver is switched back to the polling
+ * mode on panic or if it does not support the asynchronous API.
+ */
+static u8_t async_buf[2][ASYNC_BUF_SIZE];
+static size_t async_len[2];
+static u8_t async_fill;
+static bool async_busy;
+static volatile bool async_poll;
+static struct k_spinlock async_lock;
+static K_SEM_DEFINE(async_sem, 0, 1);
+
+/* Must be called with async_lock held. */
+static void async_tx_start(struct device *dev)
+{
+	u8_t idx = async_fill;
+
+	if (async_len[idx] == 0) {
+		return;
+	}
+
+	async_busy = true;
+	async_fill ^= 1U;
+
+	if (uart_tx(dev, async_buf[idx], async_len[idx], K_FOREVER) != 0) {
+		/* Data is dropped. */
+		async_len[idx] = 0;
+		async_busy = false;
+	}
+}
+
+static void async_callback(struct uart_event *evt, void *user_data)
+{
+	struct device *dev = (struct device *)user_data;
+	k_spinlock_key_t key;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		key = k_spin_lock(&async_lock);
+		async_len[async_fill ^ 1U] = 0;
+		async_busy = false;
+		if (!async_poll) {
+			async_tx_start(dev);
+		}
+		k_spin_unlock(&async_lock, key);
+		k_sem_give(&async_sem);
+		break;
+	default:
+		break;
+	}
+}
 
 static int char_out(u8_t *data, size_t length, void *ctx)
 {
 	struct device *dev = (struct device *)ctx;
+	k_spinlock_key_t key;
+	size_t len;
 
-	for (size_t i = 0; i < length; i++) {
-		uart_poll_out(dev, data[i]);
+	if (async_poll) {
+		poll_out(dev, data, length);
+		return length;
+	}
+
+	key = k_spin_lock(&async_lock);
+	len = MIN(length, ASYNC_BUF_SIZE - async_len[async_fill]);
+	memcpy(&async_buf[async_fill][async_len[async_fill]], data, len);
+	async_len[async_fill] += len;
+	if (!async_busy) {
+		async_tx_start(dev);
 	}
+	k_spin_unlock(&async_lock, key);
+
+	if (len == 0) {
+		/* Both buffers are in use, wait until transfer completes. */
+		k_sem_take(&async_sem, K_FOREVER);
+	}
+
+	return len;
+}
+
+static void async_panic(struct device *dev)
+{
+	k_spinlock_key_t key;
+
+	async_poll = true;
+
+	/* Data of the ongoing transfer is lost but the buffer that is being
+	 * filled is flushed in the polling mode.
+	 */
+	(void)uart_tx_abort(dev);
+
+	key = k_spin_lock(&async_lock);
+	poll_out(dev, async_buf[async_fill], async_len[async_fill]);
+	async_len[async_fill] = 0;
+	k_spin_unlock(&async_lock, key);
+}
+#else
+#define OUTPUT_BUF_SIZE 1
+
+static int char_out(u8_t *data, size_t length, void *ctx)
+{
+	poll_out((struct device *)ctx, data, length);
 
 	return length;
 }
+#endif /* CONFIG_LOG_BACKEND_UART_ASYNC */
 
-static u8_t buf;
+static u8_t buf[OUTPUT_BUF_SIZE];
 
-LOG_OUTPUT_DEFINE(log_output, char_out, &buf, 1);
+LOG_OUTPUT_DEFINE(log_output, char_out, buf, sizeof(buf));
 
 static void put(const struct log_backend *const backend,
 		struct log_msg *msg)
@@ -34,6 +143,10 @@ static void put(const struct log_backend *const backend,
 	u32_t flag = IS_ENABLED(CONFIG_LOG_BACKEND_UART_SYST_ENABLE) ?
 		LOG_OUTPUT_FLAG_FORMAT_SYST : 0;
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_UART_OUTPUT_DICTIONARY)) {
+		flag = LOG_OUTPUT_FLAG_FORMAT_DICT;
+	}
+
 	log_backend_std_put(&log_output, flag, msg);
 }
 
@@ -44,11 +157,21 @@ static void log_backend_uart_init(void)
 	dev = device_get_binding(CONFIG_UART_CONSOLE_ON_DEV_NAME);
 	assert(dev);
 
+#ifdef CONFIG_LOG_BACKEND_UART_ASYNC
+	if (uart_callback_set(dev, async_callback, dev) != 0) {
+		async_poll = true;
+	}
+#endif
+
 	log_output_ctx_set(&log_output, dev);
 }
 
 static void panic(struct log_backend const *const backend)
 {
+#ifdef CONFIG_LOG_BACKEND_UART_ASYNC
+	async_panic((struct device *)log_output.control_block->ctx);
+#endif
+
 	log_backend_std_panic(&log_output);
 }
 
@@ -56,6 +179,11 @@ static void dropped(const struct log_backend *const backend, u32_t cnt)
 {
 	ARG_UNUSED(backend);
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_UART_OUTPUT_DICTIONARY)) {
+		log_output_dropped_dict_process(&log_output, cnt);
+		return;
+	}
+
 	log_backend_std_dropped(&log_output, cnt);
 }
 
@@ -66,6 +194,10 @@ static void sync_string(const struct log_backend *const backend,
 	u32_t flag = IS_ENABLED(CONFIG_LOG_BACKEND_UART_SYST_ENABLE) ?
 		LOG_OUTPUT_FLAG_FORMAT_SYST : 0;
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_UART_OUTPUT_DICTIONARY)) {
+		flag = LOG_OUTPUT_FLAG_FORMAT_DICT;
+	}
+
 	log_backend_std_sync_string(&log_output, flag, src_level,
 				    timestamp, fmt, ap);
 }
@@ -77,6 +209,10 @@ static void sync_hexdump(const struct log_backend *const backend,
 	u32_t flag = IS_ENABLED(CONFIG_LOG_BACKEND_UART_SYST_ENABLE) ?
 		LOG_OUTPUT_FLAG_FORMAT_SYST : 0;
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_UART_OUTPUT_DICTIONARY)) {
+		flag = LOG_OUTPUT_FLAG_FORMAT_DICT;
+	}
+
 	log_backend_std_sync_hexdump(&log_output, flag, src_level,
 				     timestamp, metadata, data, length);
 }
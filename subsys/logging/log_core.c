@@ -59,6 +59,10 @@ static u8_t __noinit __aligned(sizeof(void *))
 		log_strdup_pool_buf[LOG_STRDUP_POOL_BUFFER_SIZE];
 
 static struct log_list_t list;
+/* Protects list only, producers on other CPUs are not serialized with
+ * unrelated irq_lock() users.
+ */
+static struct k_spinlock list_lock;
 static atomic_t initialized;
 static bool panic_mode;
 static bool backend_attached;
@@ -89,8 +93,8 @@ static u32_t dummy_timestamp(void)
  *
  * @note Algorithm does not take into account complex format specifiers as they
  *	 hardly used in log messages and including them would significantly
- *	 extended this function which is called on every log message is feature
- *	 is enabled.
+ *	 extended this function which is called on every log message with
+ *	 string arguments if feature is enabled.
  *
  * @param str String.
  * @param nargs Number of arguments in the string.
@@ -154,36 +158,29 @@ static bool is_rodata(const void *addr)
 		((const char *)addr < (const char *)RO_END));
 }
 
-/**
- * @brief Scan string arguments and report every address which is not in read
- *	  only memory and not yet duplicated.
- *
- * @param msg Log message.
- */
-static void detect_missed_strdup(struct log_msg *msg)
+void log_strdup_check(const char *str, log_arg_t *args, u32_t nargs,
+		      u32_t mask)
 {
 #define ERR_MSG	"argument %d in log message \"%s\" missing log_strdup()."
+	const char *arg;
 	u32_t idx;
-	const char *str;
-	const char *msg_str;
-	u32_t mask;
 
-	if (!log_msg_is_std(msg)) {
+	if (panic_mode) {
 		return;
 	}
 
-	msg_str = log_msg_str_get(msg);
-	mask = count_s(msg_str, log_msg_nargs_get(msg));
+	mask &= count_s(str, nargs);
 
 	while (mask) {
 		idx = 31 - __builtin_clz(mask);
-		str = (const char *)log_msg_arg_get(msg, idx);
-		if (!is_rodata(str) && !log_is_strdup(str) &&
-			(str != log_strdup_fail_msg)) {
+		arg = (const char *)args[idx];
+		if (!is_rodata(arg) && !log_is_strdup(arg) &&
+			(arg != log_strdup_fail_msg)) {
 			if (IS_ENABLED(CONFIG_ASSERT)) {
-				__ASSERT(0, ERR_MSG, idx, msg_str);
+				__ASSERT(0, ERR_MSG, idx, str);
 			} else {
-				LOG_ERR(ERR_MSG, idx, msg_str);
+				/* Cast prevents checking the error message. */
+				LOG_ERR(ERR_MSG, idx, (const void *)str);
 			}
 		}
 
@@ -196,27 +193,29 @@ static inline void msg_finalize(struct log_msg *msg,
 				struct log_msg_ids src_level)
 {
 	unsigned int key;
+	k_spinlock_key_t list_key;
+	atomic_val_t prev_cnt;
 
 	msg->hdr.ids = src_level;
 	msg->hdr.timestamp = timestamp_func();
 
-	atomic_inc(&buffered_cnt);
+	prev_cnt = atomic_inc(&buffered_cnt);
 
-	key = irq_lock();
+	list_key = k_spin_lock(&list_lock);
 
 	log_list_add_tail(&list, msg);
 
-	irq_unlock(key);
+	k_spin_unlock(&list_lock, list_key);
 
 	if (panic_mode) {
 		key = irq_lock();
 		(void)log_process(false);
 		irq_unlock(key);
-	} else if (proc_tid != NULL && buffered_cnt == 1) {
+	} else if (proc_tid != NULL && prev_cnt == 0) {
 		k_timer_start(&log_process_thread_timer,
 			CONFIG_LOG_PROCESS_THREAD_SLEEP_MS, K_NO_WAIT);
 	} else if (CONFIG_LOG_PROCESS_TRIGGER_THRESHOLD) {
-		if ((buffered_cnt == CONFIG_LOG_PROCESS_TRIGGER_THRESHOLD) &&
+		if (((prev_cnt + 1) == CONFIG_LOG_PROCESS_TRIGGER_THRESHOLD) &&
 		    (proc_tid != NULL)) {
 			k_timer_stop(&log_process_thread_timer);
 			k_sem_give(&log_process_thread_sem);
@@ -224,11 +223,178 @@ static inline void msg_finalize(struct log_msg *msg,
 	}
 }
 
+#ifdef CONFIG_LOG_RATE_LIMIT
+struct log_rate_state {
+	const char *last_str;
+	u32_t last_hash;
+	u32_t window_start;
+	u16_t cnt;
+	u16_t suppressed;
+	u32_t repeated;
+	u8_t last_level;
+};
+
+static struct log_rate_state rate_state[CONFIG_LOG_RATE_LIMIT_SOURCES];
+static struct k_spinlock rate_lock;
+static bool rate_timer_armed;
+
+static void rate_timer_expiry(struct k_timer *timer);
+static K_TIMER_DEFINE(rate_timer, rate_timer_expiry, NULL);
+
+/* Hash of the message arguments, telling repeated messages apart from
+ * messages with the same format string and different arguments.
+ */
+static u32_t rate_hash(const void *data, size_t len)
+{
+	const u8_t *p = data;
+	u32_t hash = 2166136261U; /* FNV-1a */
+
+	if (!IS_ENABLED(CONFIG_LOG_RATE_LIMIT_DEDUPLICATE)) {
+		return 0U;
+	}
+
+	while (len-- > 0) {
+		hash = (hash ^ *p++) * 16777619U;
+	}
+
+	return hash;
+}
+
+static void rate_note(const char *str, u32_t cnt,
+		      struct log_msg_ids src_level)
+{
+	struct log_msg *msg = log_msg_create_1(str, cnt);
+
+	if (msg != NULL) {
+		msg_finalize(msg, src_level);
+	}
+}
+
+/* Reports the repeat counts of sources which stopped logging, so that
+ * the last repeats are not kept back until the next different message.
+ */
+static void rate_timer_expiry(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	for (int i = 0; i < ARRAY_SIZE(rate_state); i++) {
+		struct log_rate_state *state = &rate_state[i];
+		struct log_msg_ids src_level = {
+			.domain_id = CONFIG_LOG_DOMAIN_ID,
+			.source_id = i,
+		};
+		k_spinlock_key_t key = k_spin_lock(&rate_lock);
+		u32_t repeated = state->repeated;
+
+		rate_timer_armed = false;
+		src_level.level = state->last_level;
+		state->repeated = 0U;
+		if (repeated != 0U) {
+			/* Next occurrence is printed again */
+			state->last_str = NULL;
+		}
+		k_spin_unlock(&rate_lock, key);
+
+		if (repeated != 0U) {
+			rate_note("--- last message repeated %u times ---",
+				  repeated, src_level);
+		}
+	}
+}
+
+/* Returns true if message shall be dropped. Check is performed before the
+ * message is allocated so flooding source does not consume the pool.
+ */
+static bool rate_limit_drop(const char *str, u32_t hash,
+			    struct log_msg_ids src_level)
+{
+	struct log_rate_state *state;
+	k_spinlock_key_t key;
+	u32_t now = k_uptime_get_32();
+	u32_t repeated = 0U;
+	u32_t suppressed = 0U;
+	bool drop = false;
+
+	if (panic_mode ||
+	    (src_level.domain_id != CONFIG_LOG_DOMAIN_ID) ||
+	    (src_level.source_id >= ARRAY_SIZE(rate_state))) {
+		return false;
+	}
+
+	state = &rate_state[src_level.source_id];
+
+	key = k_spin_lock(&rate_lock);
+
+	if (IS_ENABLED(CONFIG_LOG_RATE_LIMIT_DEDUPLICATE)) {
+		if (str == state->last_str && hash == state->last_hash) {
+			state->repeated++;
+			drop = true;
+			if (!rate_timer_armed) {
+				rate_timer_armed = true;
+				k_timer_start(&rate_timer,
+					      CONFIG_LOG_RATE_LIMIT_INTERVAL_MS,
+					      K_NO_WAIT);
+			}
+		} else {
+			repeated = state->repeated;
+			state->repeated = 0U;
+			state->last_str = str;
+			state->last_hash = hash;
+			state->last_level = src_level.level;
+		}
+	}
+
+	if (!drop) {
+		if ((now - state->window_start) >=
+		    CONFIG_LOG_RATE_LIMIT_INTERVAL_MS) {
+			suppressed = state->suppressed;
+			state->suppressed = 0U;
+			state->cnt = 0U;
+			state->window_start = now;
+		}
+
+		if (state->cnt >= CONFIG_LOG_RATE_LIMIT_BURST) {
+			if (state->suppressed < UINT16_MAX) {
+				state->suppressed++;
+			}
+			drop = true;
+		} else {
+			state->cnt++;
+		}
+	}
+
+	k_spin_unlock(&rate_lock, key);
+
+	if (repeated) {
+		rate_note("--- last message repeated %u times ---",
+			  repeated, src_level);
+	}
+
+	if (suppressed) {
+		rate_note("--- %u messages suppressed ---",
+			  suppressed, src_level);
+	}
+
+	return drop;
+}
+#else
+static inline u32_t rate_hash(const void *data, size_t len)
+{
+	return 0U;
+}
+
+static inline bool rate_limit_drop(const char *str, u32_t hash,
+				   struct log_msg_ids src_level)
+{
+	return false;
+}
+#endif /* CONFIG_LOG_RATE_LIMIT */
+
 void log_0(const char *str, struct log_msg_ids src_level)
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_0(str, src_level);
-	} else {
+	} else if (!rate_limit_drop(str, 0U, src_level)) {
 		struct log_msg *msg = log_msg_create_0(str);
 
 		if (msg == NULL) {
@@ -244,7 +410,8 @@ void log_1(const char *str,
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_1(str, arg0, src_level);
-	} else {
+	} else if (!rate_limit_drop(str, rate_hash(&arg0, sizeof(arg0)),
+				    src_level)) {
 		struct log_msg *msg = log_msg_create_1(str, arg0);
 
 		if (msg == NULL) {
@@ -261,7 +428,10 @@ void log_2(const char *str,
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_2(str, arg0, arg1, src_level);
-	} else {
+	} else if (!rate_limit_drop(str,
+				    rate_hash((log_arg_t[]){ arg0, arg1 },
+					      2 * sizeof(log_arg_t)),
+				    src_level)) {
 		struct log_msg *msg = log_msg_create_2(str, arg0, arg1);
 
 		if (msg == NULL) {
@@ -280,7 +450,10 @@ void log_3(const char *str,
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_3(str, arg0, arg1, arg2, src_level);
-	} else {
+	} else if (!rate_limit_drop(str,
+				    rate_hash((log_arg_t[]){ arg0, arg1, arg2 },
+					      3 * sizeof(log_arg_t)),
+				    src_level)) {
 		struct log_msg *msg = log_msg_create_3(str, arg0, arg1, arg2);
 
 		if (msg == NULL) {
@@ -298,7 +471,8 @@ void log_n(const char *str,
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_n(str, args, narg, src_level);
-	} else {
+	} else if (!rate_limit_drop(str, rate_hash(args, narg * sizeof(*args)),
+				    src_level)) {
 		struct log_msg *msg = log_msg_create_n(str, args, narg);
 
 		if (msg == NULL) {
@@ -316,7 +490,7 @@ void log_hexdump(const char *str,
 {
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_hexdump(str, data, length, src_level);
-	} else {
+	} else if (!rate_limit_drop(str, rate_hash(data, length), src_level)) {
 		struct log_msg *msg = log_msg_hexdump_create(str, data, length);
 
 		if (msg == NULL) {
@@ -413,6 +587,11 @@ void log_generic(struct log_msg_ids src_level, const char *fmt, va_list ap)
 			args[i] = va_arg(ap, log_arg_t);
 		}
 
+		if (IS_ENABLED(CONFIG_LOG_DETECT_MISSED_STRDUP)) {
+			log_strdup_check(fmt, args, nargs,
+					 Z_LOG_STR_MASK_UNKNOWN);
+		}
+
 		log_n(fmt, args, nargs, src_level);
 	}
 }
@@ -628,11 +807,6 @@ static void msg_process(struct log_msg *msg, bool bypass)
 	struct log_backend const *backend;
 
 	if (!bypass) {
-		if (IS_ENABLED(CONFIG_LOG_DETECT_MISSED_STRDUP) &&
-		    !panic_mode) {
-			detect_missed_strdup(msg);
-		}
-
 		for (int i = 0; i < log_backend_count_get(); i++) {
 			backend = log_backend_get(i);
 
@@ -666,10 +840,10 @@ bool z_impl_log_process(bool bypass)
 	if (!backend_attached && !bypass) {
 		return false;
 	}
-	unsigned int key = irq_lock();
+	k_spinlock_key_t key = k_spin_lock(&list_lock);
 
 	msg = log_list_head_get(&list);
-	irq_unlock(key);
+	k_spin_unlock(&list_lock, key);
 
 	if (msg != NULL) {
 		atomic_dec(&buffered_cnt);
@@ -12,6 +12,7 @@
 #include <time.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <sys/cbprintf.h>
 
 #define LOG_COLOR_CODE_DEFAULT "\x1B[0m"
 #define LOG_COLOR_CODE_RED     "\x1B[1;31m"
@@ -46,9 +47,6 @@ static u32_t timestamp_div;
 
 typedef int (*out_func_t)(int c, void *ctx);
 
-extern int z_prf(int (*func)(), void *dest, char *format, va_list vargs);
-extern void z_vprintk(out_func_t out, void *log_output,
-		     const char *fmt, va_list ap);
 extern void log_output_msg_syst_process(const struct log_output *log_output,
 				struct log_msg *msg, u32_t flag);
 extern void log_output_string_syst_process(const struct log_output *log_output,
@@ -57,6 +55,16 @@ extern void log_output_string_syst_process(const struct log_output *log_output,
 extern void log_output_hexdump_syst_process(const struct log_output *log_output,
 				struct log_msg_ids src_level,
 				const u8_t *data, u32_t length, u32_t flag);
+extern void log_output_msg_dict_process(const struct log_output *log_output,
+				struct log_msg *msg, u32_t flags);
+extern void log_output_string_dict_process(const struct log_output *log_output,
+				struct log_msg_ids src_level, u32_t timestamp,
+				const char *fmt, va_list ap, u32_t flags);
+extern void log_output_hexdump_dict_process(
+				const struct log_output *log_output,
+				struct log_msg_ids src_level, u32_t timestamp,
+				const char *metadata, const u8_t *data,
+				u32_t length, u32_t flags);
 
 /* The RFC 5424 allows very flexible mapping and suggest the value 0 being the
  * highest severity and 7 to be the lowest (debugging level) severity.
@@ -119,15 +127,10 @@ static int print_formatted(const struct log_output *log_output,
 			   const char *fmt, ...)
 {
 	va_list args;
-	int length = 0;
+	int length;
 
 	va_start(args, fmt);
-#if !defined(CONFIG_NEWLIB_LIBC) && !defined(CONFIG_ARCH_POSIX) && \
-    defined(CONFIG_LOG_ENABLE_FANCY_OUTPUT_FORMATTING)
-	length = z_prf(out_func, (void *)log_output, (char *)fmt, args);
-#else
-	z_vprintk(out_func, (void *)log_output, fmt, args);
-#endif
+	length = cbvprintf(out_func, (void *)log_output, fmt, args);
 	va_end(args);
 
 	return length;
@@ -528,6 +531,12 @@ void log_output_msg_process(const struct log_output *log_output,
 		return;
 	}
 
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT) &&
+	    flags & LOG_OUTPUT_FLAG_FORMAT_DICT) {
+		log_output_msg_dict_process(log_output, msg, flags);
+		return;
+	}
+
 	prefix_offset = raw_string ?
 			0 : prefix_print(log_output, flags, std_msg, timestamp,
 					 level, domain_id, source_id);
@@ -563,7 +572,6 @@ void log_output_string(const struct log_output *log_output,
 		       struct log_msg_ids src_level, u32_t timestamp,
 		       const char *fmt, va_list ap, u32_t flags)
 {
-	int length;
 	u8_t level = (u8_t)src_level.level;
 	u8_t domain_id = (u8_t)src_level.domain_id;
 	u16_t source_id = (u16_t)src_level.source_id;
@@ -576,19 +584,19 @@ void log_output_string(const struct log_output *log_output,
 		return;
 	}
 
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT) &&
+	    flags & LOG_OUTPUT_FLAG_FORMAT_DICT) {
+		log_output_string_dict_process(log_output, src_level,
+					       timestamp, fmt, ap, flags);
+		return;
+	}
+
 	if (!raw_string) {
 		prefix_print(log_output, flags, true, timestamp,
 				level, domain_id, source_id);
 	}
 
-#if !defined(CONFIG_NEWLIB_LIBC) && !defined(CONFIG_ARCH_POSIX) && \
-    defined(CONFIG_LOG_ENABLE_FANCY_OUTPUT_FORMATTING)
-	length = z_prf(out_func, (void *)log_output, (char *)fmt, ap);
-#else
-	z_vprintk(out_func, (void *)log_output, fmt, ap);
-#endif
-
-	(void)length;
+	(void)cbvprintf(out_func, (void *)log_output, fmt, ap);
 
 	if (raw_string) {
 		/* add \r if string ends with newline. */
@@ -619,6 +627,14 @@ void log_output_hexdump(const struct log_output *log_output,
 		return;
 	}
 
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT) &&
+	    flags & LOG_OUTPUT_FLAG_FORMAT_DICT) {
+		log_output_hexdump_dict_process(log_output, src_level,
+						timestamp, metadata, data,
+						length, flags);
+		return;
+	}
+
 	prefix_offset = prefix_print(log_output, flags, true, timestamp,
 				     level, domain_id, source_id);
 
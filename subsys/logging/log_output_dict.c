@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Dictionary based log output.
+ *
+ * Messages are not formatted on the target. Instead, each message is emitted
+ * as a binary frame containing the address of the format string, the raw
+ * arguments and message metadata. The address is looked up on the host in
+ * the ELF image (scripts/logging/log_dictionary_decoder.py) to recreate the
+ * text. Words are emitted in target endianness and have the size of
+ * log_arg_t (same as the pointer size).
+ *
+ * Frame layout:
+ *
+ *   u8 type, u8 level, u8 domain_id, u16 source_id, u32 timestamp, then
+ *   - LOG_DICT_TYPE_STD:     word fmt, u8 nargs, nargs words, followed by
+ *                            a NUL terminated copy of each %s argument.
+ *   - LOG_DICT_TYPE_HEXDUMP: word metadata, u16 length, data.
+ *   - LOG_DICT_TYPE_RAW:     u16 length, data.
+ *
+ *   LOG_DICT_TYPE_DROPPED frame consists of the type and u32 count only.
+ */
+
+#include <logging/log.h>
+#include <logging/log_ctrl.h>
+#include <logging/log_output.h>
+#include <string.h>
+
+#define LOG_DICT_MAGIC		0xD0
+#define LOG_DICT_TYPE_STD	(LOG_DICT_MAGIC | 0x0)
+#define LOG_DICT_TYPE_HEXDUMP	(LOG_DICT_MAGIC | 0x1)
+#define LOG_DICT_TYPE_RAW	(LOG_DICT_MAGIC | 0x2)
+#define LOG_DICT_TYPE_DROPPED	(LOG_DICT_MAGIC | 0x3)
+
+#define LOG_DICT_CHUNK_SIZE	32
+
+#define LOG_DICT_FMT_MODIFIERS	"-+ #0123456789.*hlLjzt"
+
+static void dict_out(const struct log_output *log_output,
+		     const void *data, size_t len)
+{
+	const u8_t *src = data;
+
+	while (len--) {
+		log_output->buf[log_output->control_block->offset++] = *src++;
+		if (log_output->control_block->offset == log_output->size) {
+			log_output_flush(log_output);
+		}
+	}
+}
+
+static void dict_hdr_out(const struct log_output *log_output, u8_t type,
+			 struct log_msg_ids src_level, u32_t timestamp)
+{
+	u8_t hdr[9];
+	u16_t source_id = src_level.source_id;
+
+	hdr[0] = type;
+	hdr[1] = src_level.level;
+	hdr[2] = src_level.domain_id;
+	memcpy(&hdr[3], &source_id, sizeof(source_id));
+	memcpy(&hdr[5], &timestamp, sizeof(timestamp));
+
+	dict_out(log_output, hdr, sizeof(hdr));
+}
+
+/* Returns a mask of the arguments which are strings. Strings may live in
+ * RAM (e.g. log_strdup) so they cannot be decoded from the ELF and must be
+ * copied to the output.
+ */
+static u32_t dict_str_args_mask(const char *fmt, u32_t nargs)
+{
+	u32_t mask = 0U;
+	u32_t idx = 0U;
+
+	while (*fmt != '\0' && idx < nargs) {
+		if (*fmt++ != '%') {
+			continue;
+		}
+
+		if (*fmt == '%') {
+			fmt++;
+			continue;
+		}
+
+		while (*fmt != '\0' && strchr(LOG_DICT_FMT_MODIFIERS, *fmt)) {
+			if (*fmt == '*') {
+				idx++;
+			}
+			fmt++;
+		}
+
+		if (*fmt == 's' && idx < nargs) {
+			mask |= BIT(idx);
+		}
+
+		if (*fmt != '\0') {
+			fmt++;
+		}
+		idx++;
+	}
+
+	return mask;
+}
+
+static void dict_str_out(const struct log_output *log_output, const char *str)
+{
+	size_t len = 0;
+
+	while (len < CONFIG_LOG_STRDUP_MAX_STRING && str[len] != '\0') {
+		len++;
+	}
+
+	dict_out(log_output, str, len);
+	dict_out(log_output, "", 1);
+}
+
+static void dict_std_out(const struct log_output *log_output, const char *fmt,
+			 log_arg_t *args, u32_t nargs)
+{
+	u8_t n = (u8_t)nargs;
+	u32_t mask;
+
+	dict_out(log_output, &fmt, sizeof(log_arg_t));
+	dict_out(log_output, &n, sizeof(n));
+	dict_out(log_output, args, nargs * sizeof(log_arg_t));
+
+	mask = dict_str_args_mask(fmt, nargs);
+	for (u32_t i = 0; i < nargs; i++) {
+		if (mask & BIT(i)) {
+			dict_str_out(log_output, (const char *)args[i]);
+		}
+	}
+}
+
+static void dict_data_out(const struct log_output *log_output,
+			  struct log_msg *msg, u16_t length)
+{
+	u8_t buf[LOG_DICT_CHUNK_SIZE];
+	size_t offset = 0;
+
+	dict_out(log_output, &length, sizeof(length));
+
+	while (offset < length) {
+		size_t part = MIN(sizeof(buf), length - offset);
+
+		log_msg_hexdump_data_get(msg, buf, &part, offset);
+		dict_out(log_output, buf, part);
+		offset += part;
+	}
+}
+
+void log_output_msg_dict_process(const struct log_output *log_output,
+				 struct log_msg *msg, u32_t flags)
+{
+	struct log_msg_ids src_level = {
+		.level = log_msg_level_get(msg),
+		.domain_id = log_msg_domain_id_get(msg),
+		.source_id = log_msg_source_id_get(msg),
+	};
+	u32_t timestamp = log_msg_timestamp_get(msg);
+
+	ARG_UNUSED(flags);
+
+	if (log_msg_is_std(msg)) {
+		log_arg_t args[LOG_MAX_NARGS];
+		u32_t nargs = log_msg_nargs_get(msg);
+
+		for (u32_t i = 0; i < nargs; i++) {
+			args[i] = log_msg_arg_get(msg, i);
+		}
+
+		dict_hdr_out(log_output, LOG_DICT_TYPE_STD, src_level,
+			     timestamp);
+		dict_std_out(log_output, log_msg_str_get(msg), args, nargs);
+	} else {
+		u16_t length = msg->hdr.params.hexdump.length;
+		bool raw_string =
+			(src_level.level == LOG_LEVEL_INTERNAL_RAW_STRING);
+
+		if (raw_string) {
+			dict_hdr_out(log_output, LOG_DICT_TYPE_RAW, src_level,
+				     timestamp);
+		} else {
+			const char *metadata = log_msg_str_get(msg);
+
+			dict_hdr_out(log_output, LOG_DICT_TYPE_HEXDUMP,
+				     src_level, timestamp);
+			dict_out(log_output, &metadata, sizeof(log_arg_t));
+		}
+
+		dict_data_out(log_output, msg, length);
+	}
+
+	log_output_flush(log_output);
+}
+
+void log_output_string_dict_process(const struct log_output *log_output,
+				    struct log_msg_ids src_level,
+				    u32_t timestamp, const char *fmt,
+				    va_list ap, u32_t flags)
+{
+	log_arg_t args[LOG_MAX_NARGS];
+	u32_t nargs = 0U;
+	const char *c;
+
+	ARG_UNUSED(flags);
+
+	/* Count conversion specifiers. Arguments are promoted to log_arg_t,
+	 * same as when a message is created in deferred mode.
+	 */
+	for (c = fmt; *c != '\0'; c++) {
+		if (*c == '%') {
+			if (*(c + 1) == '%') {
+				c++;
+			} else if (nargs < LOG_MAX_NARGS) {
+				args[nargs++] = va_arg(ap, log_arg_t);
+			}
+		}
+	}
+
+	dict_hdr_out(log_output, LOG_DICT_TYPE_STD, src_level, timestamp);
+	dict_std_out(log_output, fmt, args, nargs);
+	log_output_flush(log_output);
+}
+
+void log_output_hexdump_dict_process(const struct log_output *log_output,
+				     struct log_msg_ids src_level,
+				     u32_t timestamp, const char *metadata,
+				     const u8_t *data, u32_t length,
+				     u32_t flags)
+{
+	u16_t len = (u16_t)length;
+
+	ARG_UNUSED(flags);
+
+	dict_hdr_out(log_output, LOG_DICT_TYPE_HEXDUMP, src_level, timestamp);
+	dict_out(log_output, &metadata, sizeof(log_arg_t));
+	dict_out(log_output, &len, sizeof(len));
+	dict_out(log_output, data, len);
+	log_output_flush(log_output);
+}
+
+void log_output_dropped_dict_process(const struct log_output *log_output,
+				     u32_t cnt)
+{
+	u8_t type = LOG_DICT_TYPE_DROPPED;
+
+	dict_out(log_output, &type, sizeof(type));
+	dict_out(log_output, &cnt, sizeof(cnt));
+	log_output_flush(log_output);
+}
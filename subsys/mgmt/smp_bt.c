@@ -15,10 +15,12 @@
 #include <bluetooth/bluetooth.h>
 #include <bluetooth/uuid.h>
 #include <bluetooth/gatt.h>
+#include <sys/byteorder.h>
 
 #include <mgmt/smp_bt.h>
 #include <mgmt/buf.h>
 
+#include <mgmt/mgmt.h>
 #include <mgmt/smp.h>
 
 struct device;
@@ -29,6 +31,9 @@ struct smp_bt_user_data {
 
 static struct zephyr_smp_transport smp_bt_transport;
 
+/* Request being reassembled from several writes */
+static struct net_buf *smp_bt_rx_nb;
+
 /* SMP service.
  * {8D53DC1D-1DB7-4CD3-868B-8A527460AA84}
  */
@@ -43,8 +48,27 @@ static struct bt_uuid_128 smp_bt_chr_uuid = BT_UUID_INIT_128(
 	0x48, 0x7c, 0x99, 0x74, 0x11, 0x26, 0x9e, 0xae,
 	0x01, 0x4e, 0xce, 0xfb, 0x28, 0x78, 0x2e, 0xda);
 
+static void smp_bt_ud_free(void *ud);
+
+/**
+ * Drops the partially received request, if any.
+ */
+static void smp_bt_rx_drop(void)
+{
+	if (smp_bt_rx_nb != NULL) {
+		smp_bt_ud_free(net_buf_user_data(smp_bt_rx_nb));
+		mcumgr_buf_free(smp_bt_rx_nb);
+		smp_bt_rx_nb = NULL;
+	}
+}
+
 /**
  * Write handler for the SMP characteristic; processes an incoming SMP request.
+ *
+ * A request larger than the ATT MTU spans several writes, which are
+ * gathered until the length given in its header has been received. This
+ * lets clients send requests, e.g. image upload chunks, up to
+ * MCUMGR_BUF_SIZE whatever the MTU.
  */
 static ssize_t smp_bt_chr_write(struct bt_conn *conn,
 				const struct bt_gatt_attr *attr,
@@ -52,14 +76,46 @@ static ssize_t smp_bt_chr_write(struct bt_conn *conn,
 				u8_t flags)
 {
 	struct smp_bt_user_data *ud;
+	struct mgmt_hdr *hdr;
 	struct net_buf *nb;
 
-	nb = mcumgr_buf_alloc();
+	nb = smp_bt_rx_nb;
+	if (nb != NULL) {
+		ud = net_buf_user_data(nb);
+		if (ud->conn != conn) {
+			smp_bt_rx_drop();
+			nb = NULL;
+		}
+	}
+
+	if (nb == NULL) {
+		nb = mcumgr_buf_alloc();
+		if (nb == NULL) {
+			return BT_GATT_ERR(BT_ATT_ERR_INSUFFICIENT_RESOURCES);
+		}
+
+		ud = net_buf_user_data(nb);
+		ud->conn = bt_conn_ref(conn);
+		smp_bt_rx_nb = nb;
+	}
+
+	if (len > net_buf_tailroom(nb)) {
+		smp_bt_rx_drop();
+		return BT_GATT_ERR(BT_ATT_ERR_INSUFFICIENT_RESOURCES);
+	}
+
 	net_buf_add_mem(nb, buf, len);
 
-	ud = net_buf_user_data(nb);
-	ud->conn = bt_conn_ref(conn);
+	if (nb->len < sizeof(*hdr)) {
+		return len;
+	}
 
+	hdr = (struct mgmt_hdr *)nb->data;
+	if (nb->len < sizeof(*hdr) + sys_be16_to_cpu(hdr->nh_len)) {
+		return len;
+	}
+
+	smp_bt_rx_nb = NULL;
 	zephyr_smp_rx_req(&smp_bt_transport, nb);
 
 	return len;
@@ -180,10 +236,28 @@ int smp_bt_unregister(void)
 	return bt_gatt_service_unregister(&smp_bt_svc);
 }
 
+static void smp_bt_disconnected(struct bt_conn *conn, u8_t reason)
+{
+	struct smp_bt_user_data *ud;
+
+	if (smp_bt_rx_nb != NULL) {
+		ud = net_buf_user_data(smp_bt_rx_nb);
+		if (ud->conn == conn) {
+			smp_bt_rx_drop();
+		}
+	}
+}
+
+static struct bt_conn_cb smp_bt_conn_cb = {
+	.disconnected = smp_bt_disconnected,
+};
+
 static int smp_bt_init(struct device *dev)
 {
 	ARG_UNUSED(dev);
 
+	bt_conn_cb_register(&smp_bt_conn_cb);
+
 	zephyr_smp_transport_init(&smp_bt_transport, smp_bt_tx_pkt,
 				  smp_bt_get_mtu, smp_bt_ud_copy,
 				  smp_bt_ud_free);
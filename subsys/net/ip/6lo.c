@@ -1308,6 +1308,35 @@ static inline void uncompress_cid(struct net_pkt *pkt, u8_t cid,
 }
 #endif
 
+/* Link layer addresses may point in the frame header, right before the
+ * compressed header, and they are needed to uncompress the IPv6 addresses.
+ */
+static bool lladdr_in_buffers(struct net_linkaddr *lladdr, struct net_buf *buf)
+{
+	if (!lladdr->addr) {
+		return false;
+	}
+
+	for (; buf; buf = buf->frags) {
+		if (lladdr->addr + lladdr->len > buf->__buf &&
+		    lladdr->addr < buf->data + buf->len) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* The uncompressed headers can be written right in front of the compressed
+ * one, without moving the payload, when the headroom is not in use.
+ */
+static bool headroom_is_free(struct net_pkt *pkt, size_t diff)
+{
+	return net_buf_headroom(pkt->buffer) >= diff &&
+	       !lladdr_in_buffers(net_pkt_lladdr_src(pkt), pkt->buffer) &&
+	       !lladdr_in_buffers(net_pkt_lladdr_dst(pkt), pkt->buffer);
+}
+
 static bool uncompress_IPHC_header(struct net_pkt *pkt)
 {
 	struct net_udp_hdr *udp = NULL;
@@ -1348,7 +1377,12 @@ static bool uncompress_IPHC_header(struct net_pkt *pkt)
 			nhc_inline_size;
 	}
 
-	if (net_buf_tailroom(pkt->buffer) >= diff) {
+	if (headroom_is_free(pkt, diff)) {
+		NET_DBG("Enough headroom. Uncompress inplace");
+		frag = pkt->buffer;
+		cursor = frag->data;
+		net_buf_push(frag, diff);
+	} else if (net_buf_tailroom(pkt->buffer) >= diff) {
 		NET_DBG("Enough tailroom. Uncompress inplace");
 		frag = pkt->buffer;
 		net_buf_add(frag, diff);
@@ -1491,6 +1525,11 @@ static inline int compress_ipv6_header(struct net_pkt *pkt)
 {
 	struct net_buf *buffer = pkt->buffer;
 
+	if (net_buf_headroom(buffer) >= 1U) {
+		*(u8_t *)net_buf_push(buffer, 1U) = NET_6LO_DISPATCH_IPV6;
+		return 0;
+	}
+
 	if (net_buf_tailroom(buffer) >= 1U) {
 		memmove(buffer->data + 1U, buffer->data, buffer->len);
 		net_buf_add(buffer, 1U);
@@ -141,6 +141,102 @@ static void conn_set_unused(struct net_conn *conn)
 	sys_slist_prepend(&conn_unused, &conn->node);
 }
 
+#if defined(CONFIG_NET_CONN_HASH)
+#define NET_CONN_HASH_EXACT (NET_CONN_REMOTE_ADDR_SPEC |		\
+			     NET_CONN_REMOTE_PORT_SPEC |		\
+			     NET_CONN_LOCAL_PORT_SPEC)
+
+/* Handlers with a remote address and both ports, by protocol, ports and
+ * remote address.
+ */
+static sys_slist_t conn_exact[CONFIG_NET_CONN_HASH_SIZE];
+
+/* Other handlers with a local port, by protocol and local port */
+static sys_slist_t conn_port[CONFIG_NET_CONN_HASH_SIZE];
+
+/* Handlers without a local port */
+static sys_slist_t conn_wild;
+
+static inline u32_t conn_hash_mix(u32_t hash, u32_t value)
+{
+	hash ^= value;
+	hash *= 0x9e3779b1U;
+
+	return hash ^ (hash >> 16);
+}
+
+/* The ports are in network byte order */
+static u32_t conn_hash_port(u16_t proto, u16_t local_port)
+{
+	return conn_hash_mix(proto, local_port) % CONFIG_NET_CONN_HASH_SIZE;
+}
+
+static u32_t conn_hash_exact(u16_t proto, u16_t local_port,
+			     u16_t remote_port, sa_family_t family,
+			     const void *remote_addr)
+{
+	const u8_t *addr = remote_addr;
+	u32_t hash;
+	size_t len;
+	size_t i;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		len = sizeof(struct in6_addr);
+	} else {
+		len = sizeof(struct in_addr);
+	}
+
+	hash = conn_hash_mix(proto, ((u32_t)local_port << 16) | remote_port);
+
+	for (i = 0; i < len; i += sizeof(u32_t)) {
+		hash = conn_hash_mix(hash, UNALIGNED_GET((u32_t *)(addr + i)));
+	}
+
+	return hash % CONFIG_NET_CONN_HASH_SIZE;
+}
+
+static sys_slist_t *conn_hash_list(struct net_conn *conn)
+{
+	if ((conn->flags & NET_CONN_HASH_EXACT) == NET_CONN_HASH_EXACT) {
+		const void *addr;
+
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    conn->remote_addr.sa_family == AF_INET6) {
+			addr = &net_sin6(&conn->remote_addr)->sin6_addr;
+		} else {
+			addr = &net_sin(&conn->remote_addr)->sin_addr;
+		}
+
+		return &conn_exact[conn_hash_exact(
+				conn->proto,
+				net_sin(&conn->local_addr)->sin_port,
+				net_sin(&conn->remote_addr)->sin_port,
+				conn->remote_addr.sa_family, addr)];
+	}
+
+	if (conn->flags & NET_CONN_LOCAL_PORT_SPEC) {
+		return &conn_port[conn_hash_port(
+				conn->proto,
+				net_sin(&conn->local_addr)->sin_port)];
+	}
+
+	return &conn_wild;
+}
+
+static void conn_hash_add(struct net_conn *conn)
+{
+	sys_slist_prepend(conn_hash_list(conn), &conn->hash_node);
+}
+
+static void conn_hash_remove(struct net_conn *conn)
+{
+	sys_slist_find_and_remove(conn_hash_list(conn), &conn->hash_node);
+}
+#else
+#define conn_hash_add(...)
+#define conn_hash_remove(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
 /* Check if we already have identical connection handler installed. */
 static struct net_conn *conn_find_handler(u16_t proto, u8_t family,
 					  const struct sockaddr *remote_addr,
@@ -349,6 +445,7 @@ int net_conn_register(u16_t proto, u8_t family,
 	}
 
 	conn_set_used(conn);
+	conn_hash_add(conn);
 
 	conn_register_debug(conn, remote_port, local_port);
 
@@ -373,6 +470,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	NET_DBG("Connection handler %p removed", conn);
 
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_remove(conn);
 
 	conn_set_unused(conn);
 
@@ -452,6 +550,115 @@ static bool conn_addr_cmp(struct net_pkt *pkt,
 	return true;
 }
 
+/* Check the ports and addresses of a UDP or TCP handler */
+static bool conn_endpoints_match(struct net_conn *conn, struct net_pkt *pkt,
+				 union net_ip_header *ip_hdr,
+				 u16_t src_port, u16_t dst_port)
+{
+	if (net_sin(&conn->remote_addr)->sin_port) {
+		if (net_sin(&conn->remote_addr)->sin_port != src_port) {
+			return false;
+		}
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port) {
+		if (net_sin(&conn->local_addr)->sin_port != dst_port) {
+			return false;
+		}
+	}
+
+	if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+		if (!conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+			return false;
+		}
+	}
+
+	if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
+		if (!conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#if defined(CONFIG_NET_CONN_HASH)
+/* Same selection as the linear search in net_conn_input(), over one of
+ * the hash lists.
+ */
+static void conn_hash_best_match(sys_slist_t *list, struct net_pkt *pkt,
+				 union net_ip_header *ip_hdr, u8_t proto,
+				 u16_t src_port, u16_t dst_port,
+				 struct net_conn **best_match,
+				 s16_t *best_rank)
+{
+	struct net_conn *conn;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(list, conn, hash_node) {
+		/* A match with a remote port is not overridden by
+		 * a listening handler.
+		 */
+		if (*best_match != NULL &&
+		    (*best_match)->flags & NET_CONN_REMOTE_PORT_SPEC) {
+			return;
+		}
+
+		if (conn->proto != proto) {
+			continue;
+		}
+
+		if (conn->family != AF_UNSPEC &&
+		    conn->family != net_pkt_family(pkt)) {
+			continue;
+		}
+
+		if (!conn_endpoints_match(conn, pkt, ip_hdr,
+					  src_port, dst_port)) {
+			continue;
+		}
+
+		if (*best_rank < NET_CONN_RANK(conn->flags)) {
+			*best_rank = NET_CONN_RANK(conn->flags);
+			*best_match = conn;
+		}
+	}
+}
+
+/* Look up the handler of a unicast UDP or TCP packet: connected handlers
+ * first, then the ones bound to the destination port, then the rest.
+ */
+static struct net_conn *conn_hash_lookup(struct net_pkt *pkt,
+					 union net_ip_header *ip_hdr,
+					 u8_t proto,
+					 u16_t src_port, u16_t dst_port)
+{
+	struct net_conn *best_match = NULL;
+	s16_t best_rank = -1;
+	const void *addr;
+	u32_t hash;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		addr = &ip_hdr->ipv6->src;
+	} else {
+		addr = &ip_hdr->ipv4->src;
+	}
+
+	hash = conn_hash_exact(proto, dst_port, src_port,
+			       net_pkt_family(pkt), addr);
+	conn_hash_best_match(&conn_exact[hash], pkt, ip_hdr, proto,
+			     src_port, dst_port, &best_match, &best_rank);
+
+	hash = conn_hash_port(proto, dst_port);
+	conn_hash_best_match(&conn_port[hash], pkt, ip_hdr, proto,
+			     src_port, dst_port, &best_match, &best_rank);
+
+	conn_hash_best_match(&conn_wild, pkt, ip_hdr, proto,
+			     src_port, dst_port, &best_match, &best_rank);
+
+	return best_match;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
 static inline void conn_send_icmp_error(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
@@ -564,6 +771,15 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+#if defined(CONFIG_NET_CONN_HASH)
+	if (!is_mcast_pkt &&
+	    (proto == IPPROTO_UDP || proto == IPPROTO_TCP)) {
+		best_match = conn_hash_lookup(pkt, ip_hdr, proto,
+					      src_port, dst_port);
+		goto deliver;
+	}
+#endif
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
 		if (conn->proto != proto) {
 			continue;
@@ -576,34 +792,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 		if (IS_ENABLED(CONFIG_NET_UDP) ||
 		    IS_ENABLED(CONFIG_NET_TCP)) {
-			if (net_sin(&conn->remote_addr)->sin_port) {
-				if (net_sin(&conn->remote_addr)->sin_port !=
-				    src_port) {
-					continue;
-				}
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port) {
-				if (net_sin(&conn->local_addr)->sin_port !=
-				    dst_port) {
-					continue;
-				}
-			}
-
-			if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
-				if (!conn_addr_cmp(pkt, ip_hdr,
-						   &conn->remote_addr,
-						   true)) {
-					continue;
-				}
-			}
-
-			if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
-				if (!conn_addr_cmp(pkt, ip_hdr,
-						   &conn->local_addr,
-						   false)) {
-					continue;
-				}
+			if (!conn_endpoints_match(conn, pkt, ip_hdr,
+						  src_port, dst_port)) {
+				continue;
 			}
 
 			/* If we have an existing best_match, and that one
@@ -670,6 +861,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		return NET_OK;
 	}
 
+#if defined(CONFIG_NET_CONN_HASH)
+deliver:
+#endif
 	conn = best_match;
 	if (conn) {
 		NET_DBG("[%p] match found cb %p ud %p rank 0x%02x",
@@ -729,6 +923,15 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	for (i = 0; i < CONFIG_NET_CONN_HASH_SIZE; i++) {
+		sys_slist_init(&conn_exact[i]);
+		sys_slist_init(&conn_port[i]);
+	}
+
+	sys_slist_init(&conn_wild);
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
@@ -0,0 +1,258 @@
+/** @file
+ * @brief TCP generic receive offload
+ *
+ * Consecutive in-order data segments of a TCP flow that are queued in
+ * the same Rx queue are coalesced into one packet before entering the
+ * connection handlers, so that TCP processes and acknowledges them once.
+ * A segment is only held back while more packets are waiting in the
+ * queue, so coalescing never delays it past the end of the burst.
+ */
+
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <string.h>
+
+#include <net/net_pkt.h>
+#include <net/net_ip.h>
+#include <net/buf.h>
+#include <sys/byteorder.h>
+
+#include "net_private.h"
+#include "connection.h"
+#include "net_stats.h"
+#include "tcp_internal.h"
+#include "gro.h"
+
+/* Segment held back in an Rx queue */
+struct gro_slot {
+	struct net_pkt *pkt;
+	union net_ip_header ip;
+	/* The TCP header in the packet is not necessarily contiguous */
+	struct net_tcp_hdr tcp;
+	struct net_pkt_cursor cursor;
+	u32_t next_seq;
+	size_t len;
+};
+
+static struct gro_slot slots[NET_RX_QUEUES];
+
+/* Only plain data segments without options, and outside of IP fragments,
+ * can be coalesced.
+ */
+static bool gro_eligible(struct net_pkt *pkt, union net_ip_header *ip_hdr,
+			 struct net_tcp_hdr *tcp_hdr)
+{
+	if (NET_TCP_HDR_LEN(tcp_hdr) != sizeof(struct net_tcp_hdr) ||
+	    (NET_TCP_FLAGS(tcp_hdr) & ~NET_TCP_PSH) != NET_TCP_ACK) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		if (net_pkt_ipv4_opts_len(pkt) ||
+		    (sys_get_be16(ip_hdr->ipv4->offset) & 0x3fff) != 0U) {
+			return false;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		if (net_pkt_ipv6_ext_len(pkt)) {
+			return false;
+		}
+	} else {
+		return false;
+	}
+
+	return net_pkt_remaining_data(pkt) > 0;
+}
+
+static bool gro_same_flow(struct gro_slot *slot, struct net_pkt *pkt,
+			  union net_ip_header *ip_hdr,
+			  struct net_tcp_hdr *tcp_hdr)
+{
+	if (net_pkt_iface(pkt) != net_pkt_iface(slot->pkt) ||
+	    net_pkt_family(pkt) != net_pkt_family(slot->pkt) ||
+	    tcp_hdr->src_port != slot->tcp.src_port ||
+	    tcp_hdr->dst_port != slot->tcp.dst_port) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		return net_ipv4_addr_cmp(&ip_hdr->ipv4->src,
+					 &slot->ip.ipv4->src) &&
+			net_ipv4_addr_cmp(&ip_hdr->ipv4->dst,
+					  &slot->ip.ipv4->dst);
+	}
+
+	return net_ipv6_addr_cmp(&ip_hdr->ipv6->src, &slot->ip.ipv6->src) &&
+		net_ipv6_addr_cmp(&ip_hdr->ipv6->dst, &slot->ip.ipv6->dst);
+}
+
+static bool gro_can_merge(struct gro_slot *slot, struct net_pkt *pkt,
+			  union net_ip_header *ip_hdr,
+			  struct net_tcp_hdr *tcp_hdr, size_t len)
+{
+	return !(slot->tcp.flags & NET_TCP_PSH) &&
+		slot->len + len <= CONFIG_NET_TCP_GRO_MAX_SIZE &&
+		sys_get_be32(tcp_hdr->seq) == slot->next_seq &&
+		!memcmp(tcp_hdr->ack, slot->tcp.ack, sizeof(tcp_hdr->ack)) &&
+		gro_same_flow(slot, pkt, ip_hdr, tcp_hdr);
+}
+
+/* Move the payload of pkt, from its cursor on, to the end of the held
+ * packet, and release what is left of pkt.
+ */
+static void gro_merge(struct gro_slot *slot, struct net_pkt *pkt,
+		      struct net_tcp_hdr *tcp_hdr, size_t len)
+{
+	struct net_buf *frag = pkt->cursor.buf;
+	size_t skip = pkt->cursor.pos - frag->data;
+	struct net_buf *prev = NULL;
+	struct net_buf *buf;
+
+	for (buf = pkt->buffer; buf != frag; buf = buf->frags) {
+		prev = buf;
+	}
+
+	if (skip == frag->len) {
+		prev = frag;
+		frag = frag->frags;
+		skip = 0;
+	}
+
+	if (prev) {
+		prev->frags = NULL;
+	} else {
+		pkt->buffer = NULL;
+	}
+
+	net_buf_pull(frag, skip);
+	net_buf_frag_add(slot->pkt->buffer, frag);
+
+	net_pkt_unref(pkt);
+
+	slot->len += len;
+	slot->next_seq += len;
+	slot->tcp.flags |= tcp_hdr->flags & NET_TCP_PSH;
+	memcpy(slot->tcp.wnd, tcp_hdr->wnd, sizeof(slot->tcp.wnd));
+
+	/* The checksums were verified already and are not updated */
+	if (IS_ENABLED(CONFIG_NET_IPV4) &&
+	    net_pkt_family(slot->pkt) == AF_INET) {
+		slot->ip.ipv4->len = htons(ntohs(slot->ip.ipv4->len) + len);
+	} else {
+		slot->ip.ipv6->len = htons(ntohs(slot->ip.ipv6->len) + len);
+	}
+}
+
+static void gro_hold(struct gro_slot *slot, struct net_pkt *pkt,
+		     union net_ip_header *ip_hdr,
+		     struct net_tcp_hdr *tcp_hdr, size_t len)
+{
+	slot->pkt = pkt;
+	slot->ip = *ip_hdr;
+	slot->tcp = *tcp_hdr;
+	slot->next_seq = sys_get_be32(tcp_hdr->seq) + len;
+	slot->len = len;
+
+	net_pkt_cursor_backup(pkt, &slot->cursor);
+}
+
+static void gro_flush_slot(struct gro_slot *slot)
+{
+	struct net_pkt *pkt = slot->pkt;
+	union net_proto_header proto_hdr;
+	union net_ip_header ip_hdr;
+	struct net_tcp_hdr tcp_hdr;
+
+	if (!pkt) {
+		return;
+	}
+
+	/* The connection handler could receive and hold another segment,
+	 * looped back to us, so work on a copy of the slot.
+	 */
+	ip_hdr = slot->ip;
+	tcp_hdr = slot->tcp;
+	proto_hdr.tcp = &tcp_hdr;
+	slot->pkt = NULL;
+
+	net_pkt_cursor_restore(pkt, &slot->cursor);
+
+	if (net_conn_input(pkt, &ip_hdr, IPPROTO_TCP,
+			   &proto_hdr) == NET_DROP) {
+		if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		    net_pkt_family(pkt) == AF_INET) {
+			net_stats_update_ipv4_drop(net_pkt_iface(pkt));
+		} else {
+			net_stats_update_ipv6_drop(net_pkt_iface(pkt));
+		}
+
+		net_pkt_unref(pkt);
+	}
+}
+
+bool net_gro_receive(struct net_pkt *pkt, union net_ip_header *ip_hdr,
+		     struct net_tcp_hdr *tcp_hdr)
+{
+	int queue = net_tc_rx_queue_current();
+	struct gro_slot *slot;
+	size_t len;
+
+	/* Looped back packets are not received in an Rx queue */
+	if (queue < 0) {
+		return false;
+	}
+
+	slot = &slots[queue];
+
+	if (!gro_eligible(pkt, ip_hdr, tcp_hdr)) {
+		/* Keep the segments of a flow in order */
+		if (slot->pkt && gro_same_flow(slot, pkt, ip_hdr, tcp_hdr)) {
+			gro_flush_slot(slot);
+		}
+
+		return false;
+	}
+
+	len = net_pkt_remaining_data(pkt);
+
+	if (slot->pkt) {
+		if (gro_can_merge(slot, pkt, ip_hdr, tcp_hdr, len)) {
+			gro_merge(slot, pkt, tcp_hdr, len);
+
+			if (slot->tcp.flags & NET_TCP_PSH) {
+				gro_flush_slot(slot);
+			}
+
+			return true;
+		}
+
+		gro_flush_slot(slot);
+	}
+
+	/* Nothing to coalesce with */
+	if ((tcp_hdr->flags & NET_TCP_PSH) ||
+	    net_tc_rx_queue_is_empty(queue)) {
+		return false;
+	}
+
+	gro_hold(slot, pkt, ip_hdr, tcp_hdr, len);
+
+	return true;
+}
+
+void net_gro_flush(void)
+{
+	int queue = net_tc_rx_queue_current();
+
+	if (queue < 0 || !slots[queue].pkt ||
+	    !net_tc_rx_queue_is_empty(queue)) {
+		return;
+	}
+
+	gro_flush_slot(&slots[queue]);
+}
@@ -0,0 +1,73 @@
+/** @file
+ @brief TCP generic receive offload.
+
+ This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __GRO_H
+#define __GRO_H
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+
+#include <sys/util.h>
+
+#include <net/net_core.h>
+#include <net/net_ip.h>
+#include <net/net_pkt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_NET_TCP_GRO)
+/**
+ * @brief Try to coalesce a received TCP segment with the previous ones.
+ *
+ * Called once the IP and TCP headers of the segment have been checked,
+ * instead of passing it directly to net_conn_input(). A data segment is
+ * held back if more packets are waiting in the Rx queue, and the next
+ * in-order segments of the same flow get their payload appended to it.
+ * Any other segment first flushes the one being held.
+ *
+ * @param pkt Network packet, its cursor placed after the TCP header
+ * @param ip_hdr IP header of the packet
+ * @param tcp_hdr TCP header of the packet
+ *
+ * @return True if the packet was held or merged, in which case it must
+ * not be used anymore, false if it must be processed right away.
+ */
+bool net_gro_receive(struct net_pkt *pkt, union net_ip_header *ip_hdr,
+		     struct net_tcp_hdr *tcp_hdr);
+
+/**
+ * @brief Pass the segment held back by net_gro_receive() on to the
+ * connection handlers if the Rx queue of the calling thread is empty.
+ */
+void net_gro_flush(void);
+#else
+static inline bool net_gro_receive(struct net_pkt *pkt,
+				   union net_ip_header *ip_hdr,
+				   struct net_tcp_hdr *tcp_hdr)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(tcp_hdr);
+
+	return false;
+}
+
+static inline void net_gro_flush(void) { }
+#endif /* CONFIG_NET_TCP_GRO */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GRO_H */
@@ -22,6 +22,7 @@ LOG_MODULE_REGISTER(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
 #include "icmpv4.h"
 #include "udp_internal.h"
 #include "tcp_internal.h"
+#include "gro.h"
 #include "ipv4.h"
 #ifdef CONFIG_NET_TCP2
 #include "tcp2.h"
@@ -329,6 +330,11 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 
 	ip.ipv4 = hdr;
 
+	if (hdr->proto == IPPROTO_TCP &&
+	    net_gro_receive(pkt, &ip, proto_hdr.tcp)) {
+		return NET_OK;
+	}
+
 	verdict = net_conn_input(pkt, &ip, hdr->proto, &proto_hdr);
 	if (verdict != NET_DROP) {
 		return verdict;
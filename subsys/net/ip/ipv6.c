@@ -28,6 +28,7 @@ LOG_MODULE_REGISTER(net_ipv6, CONFIG_NET_IPV6_LOG_LEVEL);
 #include "icmpv6.h"
 #include "udp_internal.h"
 #include "tcp_internal.h"
+#include "gro.h"
 #include "ipv6.h"
 #include "nbr.h"
 #include "6lo.h"
@@ -275,6 +276,26 @@ static enum net_verdict ipv6_route_packet(struct net_pkt *pkt,
 	struct in6_addr *nexthop;
 	bool found;
 
+	if (hdr->hop_limit <= 1U) {
+		NET_DBG("DROP: hop limit exceeded, pkt %p", pkt);
+		net_icmpv6_send_error(pkt, NET_ICMPV6_TIME_EXCEEDED, 0, 0);
+		goto drop;
+	}
+
+	hdr->hop_limit--;
+
+	if (IS_ENABLED(CONFIG_NET_ROUTING) &&
+	    (net_ipv6_is_ll_addr(&hdr->src) ||
+	     net_ipv6_is_ll_addr(&hdr->dst))) {
+		/* RFC 4291 ch 2.5.6 */
+		ipv6_no_route_info(pkt, &hdr->src, &hdr->dst);
+		goto drop;
+	}
+
+	if (net_route_fast_forward(pkt, &hdr->dst) == 0) {
+		return NET_OK;
+	}
+
 	/* Check if the packet can be routed */
 	if (IS_ENABLED(CONFIG_NET_ROUTING)) {
 		found = net_route_get_info(NULL, &hdr->dst, &route,
@@ -287,14 +308,6 @@ static enum net_verdict ipv6_route_packet(struct net_pkt *pkt,
 	if (found) {
 		int ret;
 
-		if (IS_ENABLED(CONFIG_NET_ROUTING) &&
-		    (net_ipv6_is_ll_addr(&hdr->src) ||
-		     net_ipv6_is_ll_addr(&hdr->dst))) {
-			/* RFC 4291 ch 2.5.6 */
-			ipv6_no_route_info(pkt, &hdr->src, &hdr->dst);
-			goto drop;
-		}
-
 		/* Used when detecting if the original link
 		 * layer address length is changed or not.
 		 */
@@ -548,6 +561,11 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 
 	ip.ipv6 = hdr;
 
+	if (nexthdr == IPPROTO_TCP &&
+	    net_gro_receive(pkt, &ip, proto_hdr.tcp)) {
+		return NET_OK;
+	}
+
 	verdict = net_conn_input(pkt, &ip, nexthdr, &proto_hdr);
 	if (verdict != NET_DROP) {
 		return verdict;
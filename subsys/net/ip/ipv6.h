@@ -409,6 +409,14 @@ struct net_ipv6_reassembly {
 
 	/** IPv6 fragment identification */
 	u32_t id;
+
+	/** Length of the original fragmentable part, 0 until the last
+	 * fragment is received
+	 */
+	u32_t len;
+
+	/** Bytes of the fragmentable part received so far */
+	u32_t received;
 };
 
 /**
@@ -154,6 +154,8 @@ static struct net_ipv6_reassembly *reassembly_get(u32_t id,
 	net_ipaddr_copy(&reassembly[avail].dst, dst);
 
 	reassembly[avail].id = id;
+	reassembly[avail].len = 0U;
+	reassembly[avail].received = 0U;
 
 	return &reassembly[avail];
 }
@@ -245,7 +247,7 @@ static void reassemble_packet(struct net_ipv6_reassembly *reass)
 	/* We start from 2nd packet which is then appended to
 	 * the first one.
 	 */
-	for (i = 1; i < NET_IPV6_FRAGMENTS_MAX_PKT; i++) {
+	for (i = 1; i < NET_IPV6_FRAGMENTS_MAX_PKT && reass->pkt[i]; i++) {
 		int removed_len;
 
 		pkt = reass->pkt[i];
@@ -363,66 +365,60 @@ void net_ipv6_frag_foreach(net_ipv6_frag_cb_t cb, void *user_data)
 	}
 }
 
-/* Verify that we have all the fragments received and in correct order.
- */
-static bool fragment_verify(struct net_ipv6_reassembly *reass)
+/* Length of the fragmentable part carried by a fragment */
+static u16_t fragment_len(struct net_pkt *pkt)
 {
-	u16_t offset;
-	int i, prev_len;
+	return net_pkt_get_len(pkt) - net_pkt_ipv6_fragment_start(pkt) -
+		sizeof(struct net_ipv6_frag_hdr);
+}
 
-	prev_len = net_pkt_get_len(reass->pkt[0]);
-	offset = net_pkt_ipv6_fragment_offset(reass->pkt[0]);
+static u32_t fragment_end(struct net_pkt *pkt)
+{
+	return net_pkt_ipv6_fragment_offset(pkt) + fragment_len(pkt);
+}
 
-	NET_DBG("pkt %p offset %u", reass->pkt[0], offset);
+/* Insert the fragment in the list kept sorted by offset. As overlapping
+ * fragments are refused (RFC 5722), the fragments are complete once the
+ * sum of their lengths is the length of the original packet: no list walk
+ * is needed to find out.
+ */
+static int fragment_insert(struct net_ipv6_reassembly *reass,
+			   struct net_pkt *pkt)
+{
+	u16_t offset = net_pkt_ipv6_fragment_offset(pkt);
+	int i, count;
 
-	if (offset != 0U) {
-		return false;
+	for (count = 0; count < NET_IPV6_FRAGMENTS_MAX_PKT &&
+		     reass->pkt[count]; count++) {
 	}
 
-	for (i = 1; i < NET_IPV6_FRAGMENTS_MAX_PKT; i++) {
-		offset = net_pkt_ipv6_fragment_offset(reass->pkt[i]);
-
-		NET_DBG("pkt %p offset %u prev_len %d", reass->pkt[i],
-			offset, prev_len);
-
-		if (prev_len < offset) {
-			/* Something wrong with the offset value */
-			return false;
-		}
-
-		prev_len = net_pkt_get_len(reass->pkt[i]);
+	if (count == NET_IPV6_FRAGMENTS_MAX_PKT) {
+		return -ENOMEM;
 	}
 
-	return true;
-}
+	for (i = count; i > 0 &&
+	     net_pkt_ipv6_fragment_offset(reass->pkt[i - 1]) > offset; i--) {
+	}
 
-static int shift_packets(struct net_ipv6_reassembly *reass, int pos)
-{
-	int i;
+	if ((i > 0 && fragment_end(reass->pkt[i - 1]) > offset) ||
+	    (i < count && fragment_end(pkt) >
+	     net_pkt_ipv6_fragment_offset(reass->pkt[i]))) {
+		return -EINVAL;
+	}
 
-	for (i = pos + 1; i < NET_IPV6_FRAGMENTS_MAX_PKT; i++) {
-		if (!reass->pkt[i]) {
-			NET_DBG("Moving [%d] %p (offset 0x%x) to [%d]",
-				pos, reass->pkt[pos],
-				net_pkt_ipv6_fragment_offset(reass->pkt[pos]),
-				i);
-
-			/* Do we have enough space in packet array to make
-			 * the move?
-			 */
-			if (((i - pos) + 1) >
-			    (NET_IPV6_FRAGMENTS_MAX_PKT - i)) {
-				return -ENOMEM;
-			}
+	if (reass->len && fragment_end(i < count ? reass->pkt[count - 1] :
+				       pkt) > reass->len) {
+		return -EINVAL;
+	}
 
-			memmove(&reass->pkt[i], &reass->pkt[pos],
-				sizeof(void *) * (i - pos));
+	memmove(&reass->pkt[i + 1], &reass->pkt[i],
+		(count - i) * sizeof(reass->pkt[0]));
+	reass->pkt[i] = pkt;
+	reass->received += fragment_len(pkt);
 
-			return 0;
-		}
-	}
+	NET_DBG("Storing pkt %p to slot %d offset %d", pkt, i, offset);
 
-	return -EINVAL;
+	return 0;
 }
 
 enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
@@ -431,7 +427,6 @@ enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
 {
 	struct net_ipv6_reassembly *reass = NULL;
 	u16_t flag;
-	bool found;
 	u8_t more;
 	u32_t id;
 	int i;
@@ -468,62 +463,38 @@ enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
 	more = flag & 0x01;
 	net_pkt_set_ipv6_fragment_offset(pkt, flag & 0xfff8);
 
-	if (!reass->pkt[0]) {
-		NET_DBG("Storing pkt %p to slot %d offset %d",
-			pkt, 0, net_pkt_ipv6_fragment_offset(pkt));
-		reass->pkt[0] = pkt;
-
-		reassembly_info("Reassembly 1st pkt", reass);
-
-		/* Wait for more fragments to receive. */
-		goto accept;
+	if (more && fragment_len(pkt) % 8) {
+		/* Fragment length is not multiple of 8, discard
+		 * the packet and send parameter problem error.
+		 */
+		net_icmpv6_send_error(pkt, NET_ICMPV6_PARAM_PROBLEM,
+				      NET_ICMPV6_PARAM_PROB_OPTION, 0);
+		net_pkt_unref(pkt);
+		goto drop;
 	}
 
-	/* The fragments might come in wrong order so place them
-	 * in reassembly chain in correct order.
-	 */
-	for (i = 0, found = false; i < NET_IPV6_FRAGMENTS_MAX_PKT; i++) {
-		if (reass->pkt[i]) {
-			if (net_pkt_ipv6_fragment_offset(reass->pkt[i]) <
-			    net_pkt_ipv6_fragment_offset(pkt)) {
-				continue;
-			}
-
-			/* Make room for this fragment. If there is no room,
-			 * then it will discard the whole reassembly.
-			 */
-			if (shift_packets(reass, i)) {
-				break;
-			}
+	if (!more) {
+		if (reass->len) {
+			NET_DBG("Duplicate last fragment for 0x%x", reass->id);
+			net_pkt_unref(pkt);
+			goto drop;
 		}
 
-		NET_DBG("Storing pkt %p to slot %d offset %d",
-			pkt, i, net_pkt_ipv6_fragment_offset(pkt));
-		reass->pkt[i] = pkt;
-		found = true;
-
-		break;
+		reass->len = fragment_end(pkt);
 	}
 
-	if (!found) {
-		/* We could not add this fragment into our saved fragment
-		 * list. We must discard the whole packet at this point.
-		 */
-		NET_DBG("No slots available for 0x%x", reass->id);
+	/* The fragments might come in wrong order so place them
+	 * in reassembly chain in correct order. If there is no room
+	 * or the fragment overlaps another one, the whole reassembly
+	 * is discarded.
+	 */
+	if (fragment_insert(reass, pkt) < 0) {
+		NET_DBG("Cannot store fragment for 0x%x", reass->id);
 		net_pkt_unref(pkt);
 		goto drop;
 	}
 
-	if (more) {
-		if (net_pkt_get_len(pkt) % 8) {
-			/* Fragment length is not multiple of 8, discard
-			 * the packet and send parameter problem error.
-			 */
-			net_icmpv6_send_error(pkt, NET_ICMPV6_PARAM_PROBLEM,
-					      NET_ICMPV6_PARAM_PROB_OPTION, 0);
-			goto drop;
-		}
-
+	if (!reass->len || reass->received < reass->len) {
 		reassembly_info("Reassembly nth pkt", reass);
 
 		NET_DBG("More fragments to be received");
@@ -532,20 +503,7 @@ enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
 
 	reassembly_info("Reassembly last pkt", reass);
 
-	if (!fragment_verify(reass)) {
-		NET_DBG("Reassembled IPv6 verify failed, dropping id %u",
-			reass->id);
-
-		/* Let the caller release the already inserted pkt */
-		if (i < NET_IPV6_FRAGMENTS_MAX_PKT) {
-			reass->pkt[i] = NULL;
-		}
-
-		net_pkt_unref(pkt);
-		goto drop;
-	}
-
-	/* The last fragment received, reassemble the packet */
+	/* All the fragments received, reassemble the packet */
 	reassemble_packet(reass);
 
 accept:
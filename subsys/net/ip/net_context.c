@@ -57,6 +57,23 @@ static struct net_context contexts[NET_MAX_CONTEXT];
  */
 static struct k_sem contexts_lock;
 
+#if defined(CONFIG_NET_BUF_QUOTA)
+/* Kept outside of the contexts, as packets sent on a context can still
+ * hold buffers after it has been released and taken again.
+ */
+static struct net_buf_quota context_quotas[NET_MAX_CONTEXT];
+
+struct net_buf_quota *net_context_buf_quota(struct net_context *context)
+{
+	return &context_quotas[context - contexts];
+}
+
+#define context_buf_quota_is_full(context) \
+	net_buf_quota_is_full(net_context_buf_quota(context))
+#else
+#define context_buf_quota_is_full(...) false
+#endif /* CONFIG_NET_BUF_QUOTA */
+
 #if defined(CONFIG_NET_UDP) || defined(CONFIG_NET_TCP)
 static int check_used_port(enum net_ip_protocol ip_proto,
 			   u16_t local_port,
@@ -288,6 +305,11 @@ int net_context_get(sa_family_t family,
 		k_sem_init(&contexts[i].recv_data_wait, 1, UINT_MAX);
 #endif /* CONFIG_NET_CONTEXT_SYNC_RECV */
 
+#if defined(CONFIG_NET_BUF_QUOTA)
+		net_buf_quota_set(&context_quotas[i],
+				  CONFIG_NET_BUF_QUOTA_CONTEXT);
+#endif /* CONFIG_NET_BUF_QUOTA */
+
 		k_mutex_init(&contexts[i].lock);
 
 		contexts[i].flags |= NET_CONTEXT_IN_USE;
@@ -1181,6 +1203,51 @@ static int get_context_txtime(struct net_context *context,
 #endif
 }
 
+static int get_context_buf_quota(struct net_context *context,
+				 void *value, size_t *len)
+{
+#if defined(CONFIG_NET_BUF_QUOTA)
+	*((u16_t *)value) = net_context_buf_quota(context)->limit;
+
+	if (len) {
+		*len = sizeof(u16_t);
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+static int get_context_stats(struct net_context *context,
+			     void *value, size_t *len)
+{
+#if defined(CONFIG_NET_CONTEXT_STATISTICS)
+	struct net_stats_context *stats = value;
+	int i;
+
+	(void)memset(stats, 0, sizeof(*stats));
+
+	for (i = 0; i < ARRAY_SIZE(context->stats); i++) {
+		stats->bytes.sent += context->stats[i].bytes.sent;
+		stats->bytes.received += context->stats[i].bytes.received;
+		stats->pkts.tx += context->stats[i].pkts.tx;
+		stats->pkts.rx += context->stats[i].pkts.rx;
+		stats->tx_errors += context->stats[i].tx_errors;
+		stats->rx_drop += context->stats[i].rx_drop;
+		stats->resent += context->stats[i].resent;
+	}
+
+	if (len) {
+		*len = sizeof(struct net_stats_context);
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
  * to net_pkt from msghdr.
  */
@@ -1278,6 +1345,19 @@ static void context_finalize_packet(struct net_context *context,
 	}
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+static void context_set_gso_size(struct net_context *context,
+				 struct net_pkt *pkt)
+{
+	if (net_context_get_ip_proto(context) == IPPROTO_TCP &&
+	    context->tcp) {
+		net_pkt_set_gso_size(pkt, net_tcp_get_gso_size(context->tcp));
+	}
+}
+#else
+#define context_set_gso_size(...)
+#endif
+
 static struct net_pkt *context_alloc_pkt(struct net_context *context,
 					 size_t len, s32_t timeout)
 {
@@ -1293,6 +1373,34 @@ static struct net_pkt *context_alloc_pkt(struct net_context *context,
 		net_pkt_set_iface(pkt, net_context_get_iface(context));
 		net_pkt_set_family(pkt, net_context_get_family(context));
 		net_pkt_set_context(pkt, context);
+		context_set_gso_size(context, pkt);
+
+		if (net_pkt_alloc_buffer(pkt, len,
+					 net_context_get_ip_proto(context),
+					 timeout)) {
+			net_pkt_unref(pkt);
+			return NULL;
+		}
+
+		return pkt;
+	}
+#endif
+#if defined(CONFIG_NET_TCP_GSO) || defined(CONFIG_NET_BUF_QUOTA)
+	/* The GSO size must be known before allocating the buffer, so
+	 * that it is not limited to the MTU, and the context before the
+	 * buffer is charged to its quota.
+	 */
+	if (IS_ENABLED(CONFIG_NET_BUF_QUOTA) ||
+	    net_context_get_ip_proto(context) == IPPROTO_TCP) {
+		pkt = net_pkt_alloc_on_iface(net_context_get_iface(context),
+					     timeout);
+		if (!pkt) {
+			return NULL;
+		}
+
+		net_pkt_set_family(pkt, net_context_get_family(context));
+		net_pkt_set_context(pkt, context);
+		context_set_gso_size(context, pkt);
 
 		if (net_pkt_alloc_buffer(pkt, len,
 					 net_context_get_ip_proto(context),
@@ -1332,6 +1440,47 @@ static void set_pkt_txtime(struct net_pkt *pkt, const struct msghdr *msghdr)
 	}
 }
 
+static void context_set_pkt_options(struct net_context *context,
+				    struct net_pkt *pkt)
+{
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_PRIORITY)) {
+		u8_t priority;
+
+		get_context_priority(context, &priority, NULL);
+		net_pkt_set_priority(pkt, priority);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMP)) {
+		bool timestamp;
+
+		get_context_timepstamp(context, &timestamp, NULL);
+		if (timestamp) {
+			struct net_ptp_time tp = {
+				/* Use the nanosecond field to temporarily
+				 * store the cycle count as it is a 32-bit
+				 * variable. The value is checked in
+				 * net_if.c:net_if_tx()
+				 *
+				 * The net_pkt timestamp field is used in two
+				 * roles here:
+				 * 1) To calculate how long it takes the packet
+				 *    from net_context to be sent by the
+				 *    network device driver.
+				 * 2) gPTP enabled Ethernet device driver will
+				 *    use the value to tell gPTP what time the
+				 *    packet was sent.
+				 *
+				 * Because these two things are happening at
+				 * different times, we can share the variable.
+				 */
+				.nanosecond = k_cycle_get_32(),
+			};
+
+			net_pkt_set_timestamp(pkt, &tp);
+		}
+	}
+}
+
 static int context_sendto(struct net_context *context,
 			  const void *buf,
 			  size_t len,
@@ -1476,6 +1625,11 @@ static int context_sendto(struct net_context *context,
 
 	pkt = context_alloc_pkt(context, len, PKT_WAIT_TIME);
 	if (!pkt) {
+		/* Let the sender back off until its buffers are released */
+		if (context_buf_quota_is_full(context)) {
+			return -EAGAIN;
+		}
+
 		return -ENOMEM;
 	}
 
@@ -1488,42 +1642,7 @@ static int context_sendto(struct net_context *context,
 	context->send_cb = cb;
 	context->user_data = user_data;
 
-	if (IS_ENABLED(CONFIG_NET_CONTEXT_PRIORITY)) {
-		u8_t priority;
-
-		get_context_priority(context, &priority, NULL);
-		net_pkt_set_priority(pkt, priority);
-	}
-
-	if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMP)) {
-		bool timestamp;
-
-		get_context_timepstamp(context, &timestamp, NULL);
-		if (timestamp) {
-			struct net_ptp_time tp = {
-				/* Use the nanosecond field to temporarily
-				 * store the cycle count as it is a 32-bit
-				 * variable. The value is checked in
-				 * net_if.c:net_if_tx()
-				 *
-				 * The net_pkt timestamp field is used in two
-				 * roles here:
-				 * 1) To calculate how long it takes the packet
-				 *    from net_context to be sent by the
-				 *    network device driver.
-				 * 2) gPTP enabled Ethernet device driver will
-				 *    use the value to tell gPTP what time the
-				 *    packet was sent.
-				 *
-				 * Because these two things are happening at
-				 * different times, we can share the variable.
-				 */
-				.nanosecond = k_cycle_get_32(),
-			};
-
-			net_pkt_set_timestamp(pkt, &tp);
-		}
-	}
+	context_set_pkt_options(context, pkt);
 
 	/* If there is ancillary data in msghdr, then we need to add that
 	 * to net_pkt as there is no other way to store it.
@@ -1690,6 +1809,117 @@ int net_context_sendmsg(struct net_context *context,
 	return ret;
 }
 
+int net_context_send_buf(struct net_context *context,
+			 struct net_buf *frags,
+			 const struct sockaddr *dst_addr,
+			 socklen_t addrlen,
+			 net_context_send_cb_t cb,
+			 s32_t timeout,
+			 void *user_data)
+{
+	size_t len = net_buf_frags_len(frags);
+	socklen_t min_addrlen;
+	struct net_pkt *pkt;
+	u16_t mtu;
+	int ret;
+
+	NET_ASSERT(PART_OF_ARRAY(contexts, context));
+
+	if (!frags) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (!net_context_is_used(context)) {
+		ret = -EBADF;
+		goto unlock;
+	}
+
+	/* Only UDP sends the data out as is, through the native stack */
+	if (!IS_ENABLED(CONFIG_NET_UDP) ||
+	    net_context_get_ip_proto(context) != IPPROTO_UDP ||
+	    (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	     net_if_is_ip_offloaded(net_context_get_iface(context)))) {
+		ret = -EOPNOTSUPP;
+		goto unlock;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) &&
+	    net_context_get_family(context) == AF_INET6) {
+		min_addrlen = sizeof(struct sockaddr_in6);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		   net_context_get_family(context) == AF_INET) {
+		min_addrlen = sizeof(struct sockaddr_in);
+	} else {
+		ret = -EINVAL;
+		goto unlock;
+	}
+
+	if (!dst_addr) {
+		if (!(context->flags & NET_CONTEXT_REMOTE_ADDR_SET)) {
+			ret = -EDESTADDRREQ;
+			goto unlock;
+		}
+
+		dst_addr = &context->remote;
+		addrlen = min_addrlen;
+	}
+
+	if (addrlen < min_addrlen) {
+		ret = -EINVAL;
+		goto unlock;
+	}
+
+	/* Room for the headers only, the data is linked in */
+	pkt = context_alloc_pkt(context, 0, PKT_WAIT_TIME);
+	if (!pkt) {
+		ret = -ENOMEM;
+		goto unlock;
+	}
+
+	context->send_cb = cb;
+	context->user_data = user_data;
+
+	context_set_pkt_options(context, pkt);
+
+	ret = context_setup_udp_packet(context, pkt, NULL, 0, NULL,
+				       dst_addr, addrlen);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	mtu = net_if_get_mtu(net_pkt_iface(pkt));
+	if (mtu && net_pkt_get_len(pkt) + len > mtu) {
+		ret = -EMSGSIZE;
+		goto fail;
+	}
+
+	net_pkt_append_buffer(pkt, frags);
+	frags = NULL;
+
+	context_finalize_packet(context, pkt);
+
+	ret = net_send_data(pkt);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	k_mutex_unlock(&context->lock);
+
+	return len;
+fail:
+	net_pkt_unref(pkt);
+unlock:
+	k_mutex_unlock(&context->lock);
+
+	if (frags) {
+		net_buf_unref(frags);
+	}
+
+	return ret;
+}
+
 int net_context_sendto(struct net_context *context,
 		       const void *buf,
 		       size_t len,
@@ -1732,6 +1962,18 @@ enum net_verdict net_context_packet_received(struct net_conn *conn,
 	 * the packet.
 	 */
 	if (!context->recv_cb) {
+		net_stats_update_context_rx_drop(context);
+		goto unlock;
+	}
+
+	/* TCP data has been acknowledged already, its receive window is
+	 * what limits the buffers held by the context.
+	 */
+	if (net_context_get_ip_proto(context) != IPPROTO_TCP &&
+	    net_pkt_context_charge(pkt) < 0) {
+		NET_DBG("Context %p over its buffer quota, drop pkt %p",
+			context, pkt);
+		net_stats_update_context_rx_drop(context);
 		goto unlock;
 	}
 
@@ -1740,6 +1982,8 @@ enum net_verdict net_context_packet_received(struct net_conn *conn,
 					  net_pkt_remaining_data(pkt));
 	}
 
+	net_stats_update_context_recv(context, net_pkt_remaining_data(pkt));
+
 	context->recv_cb(context, pkt, ip_hdr, proto_hdr, 0, user_data);
 
 #if defined(CONFIG_NET_CONTEXT_SYNC_RECV)
@@ -1839,12 +2083,15 @@ static enum net_verdict net_context_raw_packet_received(
 	 */
 
 	if (!context->recv_cb) {
+		net_stats_update_context_rx_drop(context);
 		return NET_DROP;
 	}
 
 	net_context_set_iface(context, net_pkt_iface(pkt));
 	net_pkt_set_context(pkt, context);
 
+	net_stats_update_context_recv(context, net_pkt_remaining_data(pkt));
+
 	context->recv_cb(context, pkt, ip_hdr, proto_hdr, 0, user_data);
 
 #if defined(CONFIG_NET_CONTEXT_SYNC_RECV)
@@ -2039,6 +2286,23 @@ static int set_context_txtime(struct net_context *context,
 #endif
 }
 
+static int set_context_buf_quota(struct net_context *context,
+				 const void *value, size_t len)
+{
+#if defined(CONFIG_NET_BUF_QUOTA)
+	if (len > sizeof(u16_t)) {
+		return -EINVAL;
+	}
+
+	net_buf_quota_set(net_context_buf_quota(context),
+			  *((u16_t *)value));
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 static int set_context_proxy(struct net_context *context,
 			     const void *value, size_t len)
 {
@@ -2089,6 +2353,12 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_SOCKS5:
 		ret = set_context_proxy(context, value, len);
 		break;
+	case NET_OPT_BUF_QUOTA:
+		ret = set_context_buf_quota(context, value, len);
+		break;
+	case NET_OPT_STATS:
+		ret = -EINVAL;
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -2123,6 +2393,12 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_SOCKS5:
 		ret = get_context_proxy(context, value, len);
 		break;
+	case NET_OPT_BUF_QUOTA:
+		ret = get_context_buf_quota(context, value, len);
+		break;
+	case NET_OPT_STATS:
+		ret = get_context_stats(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -2153,5 +2429,14 @@ void net_context_foreach(net_context_cb_t cb, void *user_data)
 
 void net_context_init(void)
 {
+#if defined(CONFIG_NET_BUF_QUOTA)
+	int i;
+
+	for (i = 0; i < NET_MAX_CONTEXT; i++) {
+		net_buf_quota_init(&context_quotas[i],
+				   CONFIG_NET_BUF_QUOTA_CONTEXT);
+	}
+#endif /* CONFIG_NET_BUF_QUOTA */
+
 	k_sem_init(&contexts_lock, 1, UINT_MAX);
 }
@@ -51,6 +51,7 @@ LOG_MODULE_REGISTER(net_core, CONFIG_NET_CORE_LOG_LEVEL);
 #include "connection.h"
 #include "udp_internal.h"
 #include "tcp_internal.h"
+#include "gro.h"
 #include "ipv4_autoconf_internal.h"
 
 #include "net_stats.h"
@@ -365,6 +366,9 @@ static void process_rx_packet(struct k_work *work)
 	pkt = CONTAINER_OF(work, struct net_pkt, work);
 
 	net_rx(net_pkt_iface(pkt), pkt);
+
+	/* End of the burst, deliver any coalesced TCP segment */
+	net_gro_flush();
 }
 
 static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
@@ -85,6 +85,176 @@ static struct {
 } ipv4_addresses[CONFIG_NET_IF_MAX_IPV4_COUNT];
 #endif /* CONFIG_NET_IPV4 */
 
+#if defined(CONFIG_NET_IF_ADDR_HASH)
+#if defined(CONFIG_NET_NATIVE_IPV6)
+#define ADDR_HASH_IPV6_COUNT (CONFIG_NET_IF_MAX_IPV6_COUNT * NET_IF_MAX_IPV6_ADDR)
+#else
+#define ADDR_HASH_IPV6_COUNT 0
+#endif
+
+#if defined(CONFIG_NET_NATIVE_IPV4)
+#define ADDR_HASH_IPV4_COUNT (CONFIG_NET_IF_MAX_IPV4_COUNT * NET_IF_MAX_IPV4_ADDR)
+#else
+#define ADDR_HASH_IPV4_COUNT 0
+#endif
+
+/* Twice the number of addresses, so that the table never fills up and the
+ * linear probing stays short.
+ */
+#define ADDR_HASH_SIZE (2 * (ADDR_HASH_IPV6_COUNT + ADDR_HASH_IPV4_COUNT))
+
+/* Unicast address to interface, with the first interface in iteration
+ * order owning an address set on several of them, as for a full scan.
+ */
+static struct {
+	struct net_if_addr *ifaddr;
+	struct net_if *iface;
+} addr_hash[ADDR_HASH_SIZE];
+
+static u32_t addr_hash_slot(sa_family_t family, const void *addr)
+{
+	const u32_t *word = addr;
+	u32_t hash = UNALIGNED_GET(&word[0]);
+
+	if (family == AF_INET6) {
+		hash ^= UNALIGNED_GET(&word[1]) ^ UNALIGNED_GET(&word[2]) ^
+			UNALIGNED_GET(&word[3]);
+	}
+
+	return ((hash * 2654435761U) >> 8) % ADDR_HASH_SIZE;
+}
+
+static bool addr_hash_match(struct net_if_addr *ifaddr, sa_family_t family,
+			    const void *addr)
+{
+	if (ifaddr->address.family != family) {
+		return false;
+	}
+
+	if (family == AF_INET6) {
+		return !memcmp(&ifaddr->address.in6_addr, addr,
+			       sizeof(struct in6_addr));
+	}
+
+	return !memcmp(&ifaddr->address.in_addr, addr,
+		       sizeof(struct in_addr));
+}
+
+static int addr_hash_find(sa_family_t family, const void *addr)
+{
+	u32_t i = addr_hash_slot(family, addr);
+
+	while (addr_hash[i].ifaddr) {
+		if (addr_hash_match(addr_hash[i].ifaddr, family, addr)) {
+			return i;
+		}
+
+		i = (i + 1) % ADDR_HASH_SIZE;
+	}
+
+	return -ENOENT;
+}
+
+static struct net_if_addr *addr_hash_lookup(sa_family_t family,
+					    const void *addr,
+					    struct net_if **ret)
+{
+	int i = addr_hash_find(family, addr);
+
+	if (i < 0) {
+		return NULL;
+	}
+
+	if (ret) {
+		*ret = addr_hash[i].iface;
+	}
+
+	return addr_hash[i].ifaddr;
+}
+
+static void addr_hash_add(struct net_if *iface, struct net_if_addr *ifaddr)
+{
+	const void *addr = &ifaddr->address.in6_addr;
+	sa_family_t family = ifaddr->address.family;
+	int i = addr_hash_find(family, addr);
+
+	if (i < 0) {
+		i = addr_hash_slot(family, addr);
+
+		while (addr_hash[i].ifaddr) {
+			i = (i + 1) % ADDR_HASH_SIZE;
+		}
+	} else if (addr_hash[i].iface < iface) {
+		return;
+	}
+
+	addr_hash[i].ifaddr = ifaddr;
+	addr_hash[i].iface = iface;
+}
+
+#if defined(CONFIG_NET_NATIVE_IPV6)
+static struct net_if_addr *ipv6_addr_scan(const struct in6_addr *addr,
+					  struct net_if **ret);
+#endif
+#if defined(CONFIG_NET_NATIVE_IPV4)
+static struct net_if_addr *ipv4_addr_scan(const struct in_addr *addr,
+					  struct net_if **ret);
+#endif
+
+/* Must be called once the address is no longer used, so that another
+ * interface holding the same address can take over the entry.
+ */
+static void addr_hash_del(struct net_if_addr *ifaddr)
+{
+	const void *addr = &ifaddr->address.in6_addr;
+	sa_family_t family = ifaddr->address.family;
+	struct net_if_addr *next = NULL;
+	struct net_if *iface = NULL;
+	int i = addr_hash_find(family, addr);
+	int j, home;
+
+	if (i < 0 || addr_hash[i].ifaddr != ifaddr) {
+		return;
+	}
+
+	/* Backward shift deletion: move up the entries whose probe sequence
+	 * goes through the freed slot.
+	 */
+	for (j = (i + 1) % ADDR_HASH_SIZE; addr_hash[j].ifaddr;
+	     j = (j + 1) % ADDR_HASH_SIZE) {
+		home = addr_hash_slot(addr_hash[j].ifaddr->address.family,
+				      &addr_hash[j].ifaddr->address.in6_addr);
+
+		if ((j > i && (home <= i || home > j)) ||
+		    (j < i && home <= i && home > j)) {
+			addr_hash[i] = addr_hash[j];
+			i = j;
+		}
+	}
+
+	addr_hash[i].ifaddr = NULL;
+	addr_hash[i].iface = NULL;
+
+#if defined(CONFIG_NET_NATIVE_IPV6)
+	if (family == AF_INET6) {
+		next = ipv6_addr_scan(addr, &iface);
+	}
+#endif
+#if defined(CONFIG_NET_NATIVE_IPV4)
+	if (family == AF_INET) {
+		next = ipv4_addr_scan(addr, &iface);
+	}
+#endif
+
+	if (next) {
+		addr_hash_add(iface, next);
+	}
+}
+#else
+#define addr_hash_add(...)
+#define addr_hash_del(...)
+#endif /* CONFIG_NET_IF_ADDR_HASH */
+
 /* We keep track of the link callbacks in this list.
  */
 static sys_slist_t link_callbacks;
@@ -135,6 +305,8 @@ static inline void net_context_send_cb(struct net_context *context,
 		context->send_cb(context, status, context->user_data);
 	}
 
+	net_stats_update_context_sent(context, status);
+
 	if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_ip_proto(context) == IPPROTO_UDP) {
 		net_stats_update_udp_sent(net_context_get_iface(context));
@@ -298,6 +470,10 @@ static inline void init_iface(struct net_if *iface)
 {
 	const struct net_if_api *api = net_if_get_device(iface)->driver_api;
 
+#if defined(CONFIG_NET_BUF_QUOTA)
+	net_buf_quota_init(&iface->buf_quota, CONFIG_NET_BUF_QUOTA_IFACE);
+#endif
+
 	if (!api || !api->init) {
 		NET_ERR("Iface %p driver API init NULL", iface);
 		return;
@@ -308,6 +484,13 @@ static inline void init_iface(struct net_if *iface)
 	api->init(iface);
 }
 
+#if defined(CONFIG_NET_BUF_QUOTA)
+void net_if_set_buf_quota(struct net_if *iface, u16_t limit)
+{
+	net_buf_quota_set(&iface->buf_quota, limit);
+}
+#endif /* CONFIG_NET_BUF_QUOTA */
+
 enum net_verdict net_if_send_data(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct net_context *context = net_pkt_context(pkt);
@@ -768,6 +951,18 @@ int net_if_config_ipv6_put(struct net_if *iface)
 		iface->config.ip.ipv6 = NULL;
 		ipv6_addresses[i].iface = NULL;
 
+		if (IS_ENABLED(CONFIG_NET_IF_ADDR_HASH)) {
+			struct net_if_addr *unicast =
+				ipv6_addresses[i].ipv6.unicast;
+			int j;
+
+			for (j = 0; j < NET_IF_MAX_IPV6_ADDR; j++) {
+				if (unicast[j].is_used) {
+					addr_hash_del(&unicast[j]);
+				}
+			}
+		}
+
 		return 0;
 	}
 
@@ -1105,8 +1300,8 @@ static inline void iface_ipv6_nd_init(void)
 #define iface_ipv6_nd_init(...)
 #endif /* CONFIG_NET_IPV6_ND */
 
-struct net_if_addr *net_if_ipv6_addr_lookup(const struct in6_addr *addr,
-					    struct net_if **ret)
+static struct net_if_addr *ipv6_addr_scan(const struct in6_addr *addr,
+					  struct net_if **ret)
 {
 	struct net_if *iface;
 
@@ -1141,6 +1336,16 @@ struct net_if_addr *net_if_ipv6_addr_lookup(const struct in6_addr *addr,
 	return NULL;
 }
 
+struct net_if_addr *net_if_ipv6_addr_lookup(const struct in6_addr *addr,
+					    struct net_if **ret)
+{
+#if defined(CONFIG_NET_IF_ADDR_HASH)
+	return addr_hash_lookup(AF_INET6, addr, ret);
+#else
+	return ipv6_addr_scan(addr, ret);
+#endif
+}
+
 struct net_if_addr *net_if_ipv6_addr_lookup_by_iface(struct net_if *iface,
 						     struct in6_addr *addr)
 {
@@ -1417,6 +1622,7 @@ struct net_if_addr *net_if_ipv6_addr_add(struct net_if *iface,
 
 		net_if_addr_init(&ipv6->unicast[i], addr, addr_type,
 				 vlifetime);
+		addr_hash_add(iface, &ipv6->unicast[i]);
 
 		NET_DBG("[%d] interface %p address %s type %s added", i,
 			iface, log_strdup(net_sprint_ipv6_addr(addr)),
@@ -1485,6 +1691,7 @@ bool net_if_ipv6_addr_rm(struct net_if *iface, const struct in6_addr *addr)
 		}
 
 		ipv6->unicast[i].is_used = false;
+		addr_hash_del(&ipv6->unicast[i]);
 
 		net_ipv6_addr_create_solicited_node(addr, &maddr);
 
@@ -2519,6 +2726,18 @@ int net_if_config_ipv4_put(struct net_if *iface)
 		iface->config.ip.ipv4 = NULL;
 		ipv4_addresses[i].iface = NULL;
 
+		if (IS_ENABLED(CONFIG_NET_IF_ADDR_HASH)) {
+			struct net_if_addr *unicast =
+				ipv4_addresses[i].ipv4.unicast;
+			int j;
+
+			for (j = 0; j < NET_IF_MAX_IPV4_ADDR; j++) {
+				if (unicast[j].is_used) {
+					addr_hash_del(&unicast[j]);
+				}
+			}
+		}
+
 		return 0;
 	}
 
@@ -2788,8 +3007,8 @@ const struct in_addr *net_if_ipv4_select_src_addr(struct net_if *dst_iface,
 	return src;
 }
 
-struct net_if_addr *net_if_ipv4_addr_lookup(const struct in_addr *addr,
-					    struct net_if **ret)
+static struct net_if_addr *ipv4_addr_scan(const struct in_addr *addr,
+					  struct net_if **ret)
 {
 	struct net_if *iface;
 
@@ -2822,6 +3041,16 @@ struct net_if_addr *net_if_ipv4_addr_lookup(const struct in_addr *addr,
 	return NULL;
 }
 
+struct net_if_addr *net_if_ipv4_addr_lookup(const struct in_addr *addr,
+					    struct net_if **ret)
+{
+#if defined(CONFIG_NET_IF_ADDR_HASH)
+	return addr_hash_lookup(AF_INET, addr, ret);
+#else
+	return ipv4_addr_scan(addr, ret);
+#endif
+}
+
 int z_impl_net_if_ipv4_addr_lookup_by_index(const struct in_addr *addr)
 {
 	struct net_if_addr *if_addr;
@@ -2995,6 +3224,12 @@ struct net_if_addr *net_if_ipv4_addr_add(struct net_if *iface,
 	}
 
 	if (ifaddr) {
+		if (ifaddr->is_used) {
+			/* Overriding a previous address */
+			ifaddr->is_used = false;
+			addr_hash_del(ifaddr);
+		}
+
 		ifaddr->is_used = true;
 		ifaddr->address.family = AF_INET;
 		ifaddr->address.in_addr.s4_addr32[0] =
@@ -3014,6 +3249,8 @@ struct net_if_addr *net_if_ipv4_addr_add(struct net_if *iface,
 		 */
 		ifaddr->addr_state = NET_ADDR_PREFERRED;
 
+		addr_hash_add(iface, ifaddr);
+
 		NET_DBG("[%d] interface %p address %s type %s added", i, iface,
 			log_strdup(net_sprint_ipv4_addr(addr)),
 			net_addr_type2str(addr_type));
@@ -3048,6 +3285,7 @@ bool net_if_ipv4_addr_rm(struct net_if *iface, const struct in_addr *addr)
 		}
 
 		ipv4->unicast[i].is_used = false;
+		addr_hash_del(&ipv4->unicast[i]);
 
 		NET_DBG("[%d] interface %p address %s removed",
 			i, iface, log_strdup(net_sprint_ipv4_addr(addr)));
@@ -3400,6 +3638,11 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface)
 	return need_calc_checksum(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD);
 }
 
+bool net_if_need_tx_segmentation(struct net_if *iface)
+{
+	return need_calc_checksum(iface, ETHERNET_HW_TX_TSO);
+}
+
 struct net_if *net_if_get_by_index(int index)
 {
 	if (index <= 0) {
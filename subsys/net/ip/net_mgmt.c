@@ -32,17 +32,41 @@ struct mgmt_event_wait {
 	struct net_if *iface;
 };
 
-static K_SEM_DEFINE(network_event, 0, UINT_MAX);
 static K_SEM_DEFINE(net_mgmt_lock, 1, 1);
 
+#if !defined(CONFIG_NET_MGMT_EVENT_DIRECT)
+static K_SEM_DEFINE(network_event, 0, UINT_MAX);
+static struct mgmt_event_entry events[CONFIG_NET_MGMT_EVENT_QUEUE_SIZE];
+static s16_t in_event;
+static s16_t out_event;
+#endif
+
+#if defined(CONFIG_NET_MGMT_EVENT_THREAD)
 NET_STACK_DEFINE(MGMT, mgmt_stack, CONFIG_NET_MGMT_EVENT_STACK_SIZE,
 		 CONFIG_NET_MGMT_EVENT_STACK_SIZE);
 static struct k_thread mgmt_thread_data;
-static struct mgmt_event_entry events[CONFIG_NET_MGMT_EVENT_QUEUE_SIZE];
+#elif defined(CONFIG_NET_MGMT_EVENT_WORK_Q)
+static struct k_work_q *mgmt_work_q = &k_sys_work_q;
+static struct k_work mgmt_work;
+#endif
+
 static u32_t global_event_mask;
-static sys_slist_t event_callbacks;
-static s16_t in_event;
-static s16_t out_event;
+
+/* Callbacks are indexed on the layer and layer code of their event mask,
+ * which an event must match exactly: dispatching an event only walks the
+ * callbacks of its own bucket.
+ */
+static sys_slist_t event_callbacks[CONFIG_NET_MGMT_EVENT_CALLBACK_BUCKETS];
+
+static inline sys_slist_t *mgmt_event_callbacks(u32_t mgmt_event)
+{
+	u32_t key = (mgmt_event & (NET_MGMT_LAYER_MASK |
+				   NET_MGMT_LAYER_CODE_MASK)) >> 16;
+
+	return &event_callbacks[key % CONFIG_NET_MGMT_EVENT_CALLBACK_BUCKETS];
+}
+
+#if !defined(CONFIG_NET_MGMT_EVENT_DIRECT)
 
 static inline void mgmt_push_event(u32_t mgmt_event, struct net_if *iface,
 				   void *info, size_t length)
@@ -120,6 +144,7 @@ static inline struct mgmt_event_entry *mgmt_pop_event(void)
 
 	return &events[o_idx];
 }
+#endif /* !CONFIG_NET_MGMT_EVENT_DIRECT */
 
 static inline void mgmt_clean_event(struct mgmt_event_entry *mgmt_event)
 {
@@ -136,10 +161,15 @@ static inline void mgmt_rebuild_global_event_mask(void)
 {
 	struct net_mgmt_event_callback *cb, *tmp;
 
+	int i;
+
 	global_event_mask = 0U;
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&event_callbacks, cb, tmp, node) {
-		mgmt_add_event_mask(cb->event_mask);
+	for (i = 0; i < ARRAY_SIZE(event_callbacks); i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&event_callbacks[i], cb, tmp,
+						  node) {
+			mgmt_add_event_mask(cb->event_mask);
+		}
 	}
 }
 
@@ -158,6 +188,7 @@ static inline bool mgmt_is_event_handled(u32_t mgmt_event)
 
 static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 {
+	sys_slist_t *callbacks = mgmt_event_callbacks(mgmt_event->event);
 	sys_snode_t *prev = NULL;
 	struct net_mgmt_event_callback *cb, *tmp;
 
@@ -166,7 +197,8 @@ static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 		NET_MGMT_GET_LAYER_CODE(mgmt_event->event),
 		NET_MGMT_GET_COMMAND(mgmt_event->event));
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&event_callbacks, cb, tmp, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(callbacks, cb, tmp, node) {
+		/* Other layer codes may share the bucket */
 		if (!(NET_MGMT_GET_LAYER(mgmt_event->event) ==
 		      NET_MGMT_GET_LAYER(cb->event_mask)) ||
 		    !(NET_MGMT_GET_LAYER_CODE(mgmt_event->event) ==
@@ -203,7 +235,7 @@ static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 			cb->raised_event = mgmt_event->event;
 			sync_data->iface = mgmt_event->iface;
 
-			sys_slist_remove(&event_callbacks, prev, &cb->node);
+			sys_slist_remove(callbacks, prev, &cb->node);
 
 			k_sem_give(cb->sync_call);
 		} else {
@@ -215,47 +247,104 @@ static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 		}
 	}
 
-#ifdef CONFIG_NET_DEBUG_MGMT_EVENT_STACK
+#if defined(CONFIG_NET_DEBUG_MGMT_EVENT_STACK) && \
+	defined(CONFIG_NET_MGMT_EVENT_THREAD)
 	net_analyze_stack("Net MGMT event stack",
 			  Z_THREAD_STACK_BUFFER(mgmt_stack),
 			  K_THREAD_STACK_SIZEOF(mgmt_stack));
 #endif
 }
 
-static void mgmt_thread(void)
+#if !defined(CONFIG_NET_MGMT_EVENT_DIRECT)
+/* Called once per event given to network_event */
+static void mgmt_handle_event(void)
 {
 	struct mgmt_event_entry *mgmt_event;
 
-	while (1) {
-		k_sem_take(&network_event, K_FOREVER);
-		k_sem_take(&net_mgmt_lock, K_FOREVER);
+	k_sem_take(&net_mgmt_lock, K_FOREVER);
 
-		NET_DBG("Handling events, forwarding it relevantly");
+	NET_DBG("Handling events, forwarding it relevantly");
 
-		mgmt_event = mgmt_pop_event();
-		if (!mgmt_event) {
-			/* System is over-loaded?
-			 * At this point we have most probably notified
-			 * more events than we could handle
-			 */
-			NET_DBG("Some event got probably lost (%u)",
-				k_sem_count_get(&network_event));
+	mgmt_event = mgmt_pop_event();
+	if (!mgmt_event) {
+		/* System is over-loaded?
+		 * At this point we have most probably notified
+		 * more events than we could handle
+		 */
+		NET_DBG("Some event got probably lost (%u)",
+			k_sem_count_get(&network_event));
 
-			k_sem_init(&network_event, 0, UINT_MAX);
-			k_sem_give(&net_mgmt_lock);
+		k_sem_init(&network_event, 0, UINT_MAX);
+		k_sem_give(&net_mgmt_lock);
 
-			continue;
-		}
+		return;
+	}
 
-		mgmt_run_callbacks(mgmt_event);
+	mgmt_run_callbacks(mgmt_event);
 
-		mgmt_clean_event(mgmt_event);
+	mgmt_clean_event(mgmt_event);
 
-		k_sem_give(&net_mgmt_lock);
+	k_sem_give(&net_mgmt_lock);
+}
+#endif /* !CONFIG_NET_MGMT_EVENT_DIRECT */
+
+#if defined(CONFIG_NET_MGMT_EVENT_THREAD)
+static void mgmt_thread(void)
+{
+	while (1) {
+		k_sem_take(&network_event, K_FOREVER);
+
+		mgmt_handle_event();
 
 		k_yield();
 	}
 }
+#elif defined(CONFIG_NET_MGMT_EVENT_WORK_Q)
+static void mgmt_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	while (k_sem_take(&network_event, K_NO_WAIT) == 0) {
+		mgmt_handle_event();
+	}
+}
+
+void net_mgmt_event_work_q_set(struct k_work_q *work_q)
+{
+	mgmt_work_q = work_q ? work_q : &k_sys_work_q;
+}
+#else
+static void mgmt_run_event(u32_t mgmt_event, struct net_if *iface,
+			   void *info, size_t length)
+{
+	struct mgmt_event_entry entry = {
+		.event = mgmt_event,
+		.iface = iface,
+	};
+
+	__ASSERT(!k_is_in_isr(), "Events cannot be notified from an ISR");
+
+#ifdef CONFIG_NET_MGMT_EVENT_INFO
+	if (info && length) {
+		if (length > NET_EVENT_INFO_MAX_SIZE) {
+			NET_ERR("Event info length %zu > max size %zu",
+				length, NET_EVENT_INFO_MAX_SIZE);
+			return;
+		}
+
+		memcpy(entry.info, info, length);
+		entry.info_length = length;
+	}
+#else
+	ARG_UNUSED(info);
+	ARG_UNUSED(length);
+#endif /* CONFIG_NET_MGMT_EVENT_INFO */
+
+	k_sem_take(&net_mgmt_lock, K_FOREVER);
+	mgmt_run_callbacks(&entry);
+	k_sem_give(&net_mgmt_lock);
+}
+#endif
 
 static int mgmt_event_wait_call(struct net_if *iface,
 				u32_t mgmt_event_mask,
@@ -316,7 +405,7 @@ void net_mgmt_add_event_callback(struct net_mgmt_event_callback *cb)
 
 	k_sem_take(&net_mgmt_lock, K_FOREVER);
 
-	sys_slist_prepend(&event_callbacks, &cb->node);
+	sys_slist_prepend(mgmt_event_callbacks(cb->event_mask), &cb->node);
 
 	mgmt_add_event_mask(cb->event_mask);
 
@@ -329,7 +418,8 @@ void net_mgmt_del_event_callback(struct net_mgmt_event_callback *cb)
 
 	k_sem_take(&net_mgmt_lock, K_FOREVER);
 
-	sys_slist_find_and_remove(&event_callbacks, &cb->node);
+	sys_slist_find_and_remove(mgmt_event_callbacks(cb->event_mask),
+				  &cb->node);
 
 	mgmt_rebuild_global_event_mask();
 
@@ -345,8 +435,15 @@ void net_mgmt_event_notify_with_info(u32_t mgmt_event, struct net_if *iface,
 			NET_MGMT_GET_LAYER_CODE(mgmt_event),
 			NET_MGMT_GET_COMMAND(mgmt_event));
 
+#if defined(CONFIG_NET_MGMT_EVENT_DIRECT)
+		mgmt_run_event(mgmt_event, iface, info, length);
+#else
 		mgmt_push_event(mgmt_event, iface, info, length);
 		k_sem_give(&network_event);
+#if defined(CONFIG_NET_MGMT_EVENT_WORK_Q)
+		k_work_submit_to_queue(mgmt_work_q, &mgmt_work);
+#endif
+#endif
 	}
 }
 
@@ -379,15 +476,23 @@ int net_mgmt_event_wait_on_iface(struct net_if *iface,
 
 void net_mgmt_event_init(void)
 {
-	sys_slist_init(&event_callbacks);
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(event_callbacks); i++) {
+		sys_slist_init(&event_callbacks[i]);
+	}
+
 	global_event_mask = 0U;
 
+#if !defined(CONFIG_NET_MGMT_EVENT_DIRECT)
 	in_event = -1;
 	out_event = -1;
 
 	(void)memset(events, 0, CONFIG_NET_MGMT_EVENT_QUEUE_SIZE *
 			sizeof(struct mgmt_event_entry));
+#endif
 
+#if defined(CONFIG_NET_MGMT_EVENT_THREAD)
 	k_thread_create(&mgmt_thread_data, mgmt_stack,
 			K_THREAD_STACK_SIZEOF(mgmt_stack),
 			(k_thread_entry_t)mgmt_thread, NULL, NULL, NULL,
@@ -398,4 +503,7 @@ void net_mgmt_event_init(void)
 	NET_DBG("Net MGMT initialized: queue of %u entries, stack size of %u",
 		CONFIG_NET_MGMT_EVENT_QUEUE_SIZE,
 		CONFIG_NET_MGMT_EVENT_STACK_SIZE);
+#elif defined(CONFIG_NET_MGMT_EVENT_WORK_Q)
+	k_work_init(&mgmt_work, mgmt_work_handler);
+#endif
 }
@@ -112,7 +112,60 @@ LOG_MODULE_REGISTER(net_pkt, CONFIG_NET_PKT_LOG_LEVEL);
 K_MEM_SLAB_DEFINE(rx_pkts, sizeof(struct net_pkt), CONFIG_NET_PKT_RX_COUNT, 4);
 K_MEM_SLAB_DEFINE(tx_pkts, sizeof(struct net_pkt), CONFIG_NET_PKT_TX_COUNT, 4);
 
-#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+#if defined(CONFIG_NET_BUF_DATA_DMA)
+
+/* Each buffer gets an aligned block, starting with its headroom */
+#define DMA_BLOCK_SIZE ROUND_UP(CONFIG_NET_BUF_DATA_HEADROOM +	\
+				CONFIG_NET_BUF_DATA_SIZE,		\
+				CONFIG_NET_BUF_DATA_DMA_ALIGN)
+
+#if defined(CONFIG_NOCACHE_MEMORY)
+#define __dma_data __nocache
+#else
+#define __dma_data __noinit
+#endif
+
+static u8_t *dma_data_alloc(struct net_buf *buf, size_t *size,
+			    s32_t timeout)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+	u8_t *blocks = pool->alloc->alloc_data;
+
+	ARG_UNUSED(timeout);
+
+	*size = MIN(CONFIG_NET_BUF_DATA_SIZE, *size);
+
+	return blocks + DMA_BLOCK_SIZE * net_buf_id(buf) +
+		CONFIG_NET_BUF_DATA_HEADROOM;
+}
+
+static void dma_data_unref(struct net_buf *buf, u8_t *data)
+{
+	/* Nothing needed for fixed-size data pools */
+}
+
+static const struct net_buf_data_cb dma_data_cb = {
+	.alloc = dma_data_alloc,
+	.unref = dma_data_unref,
+};
+
+#define NET_PKT_DMA_POOL_DEFINE(_name, _count)				\
+	static struct net_buf net_buf_##_name[_count] __noinit;		\
+	static u8_t __dma_data __aligned(CONFIG_NET_BUF_DATA_DMA_ALIGN)	\
+		net_buf_data_##_name[_count][DMA_BLOCK_SIZE];		\
+	static const struct net_buf_data_alloc net_buf_dma_alloc_##_name = { \
+		.cb = &dma_data_cb,					\
+		.alloc_data = (void *)net_buf_data_##_name,		\
+	};								\
+	struct net_buf_pool _name __net_buf_align			\
+			__in_section(_net_buf_pool, static, _name) =	\
+		NET_BUF_POOL_INITIALIZER(_name, &net_buf_dma_alloc_##_name, \
+					 net_buf_##_name, _count, NULL)
+
+NET_PKT_DMA_POOL_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT);
+NET_PKT_DMA_POOL_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT);
+
+#elif defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
 
 NET_BUF_POOL_FIXED_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT,
 			  CONFIG_NET_BUF_DATA_SIZE, NULL);
@@ -493,6 +546,168 @@ static inline struct net_buf_pool *get_data_pool(struct net_context *context)
 #define get_data_pool(...) NULL
 #endif /* CONFIG_NET_CONTEXT_NET_PKT_POOL */
 
+#if defined(CONFIG_NET_BUF_QUOTA)
+void net_buf_quota_init(struct net_buf_quota *quota, u16_t limit)
+{
+	atomic_clear(&quota->used);
+	quota->limit = limit;
+	k_sem_init(&quota->released, 0, 1);
+}
+
+void net_buf_quota_set(struct net_buf_quota *quota, u16_t limit)
+{
+	quota->limit = limit;
+
+	/* Let the waiters check the new limit */
+	k_sem_give(&quota->released);
+}
+
+bool net_buf_quota_is_full(struct net_buf_quota *quota)
+{
+	return quota->limit && atomic_get(&quota->used) >= quota->limit;
+}
+
+/* A quota is only checked before allocating, so the packet that fills it
+ * can go over it by the few buffers it needs.
+ */
+static int buf_quota_wait(struct net_buf_quota *quota, u32_t start,
+			  s32_t timeout)
+{
+	bool waited = false;
+
+	while (net_buf_quota_is_full(quota)) {
+		if (timeout != K_NO_WAIT && timeout != K_FOREVER) {
+			u32_t diff = k_uptime_get_32() - start;
+
+			timeout -= MIN(timeout, diff);
+		}
+
+		if (timeout == K_NO_WAIT ||
+		    k_sem_take(&quota->released, timeout)) {
+			return -ENOBUFS;
+		}
+
+		waited = true;
+	}
+
+	/* There is only one wake up per release, pass it on */
+	if (waited) {
+		k_sem_give(&quota->released);
+	}
+
+	return 0;
+}
+
+static void buf_quota_release(struct net_buf_quota *quota, u16_t count)
+{
+	if (!quota || !count) {
+		return;
+	}
+
+	atomic_sub(&quota->used, count);
+	k_sem_give(&quota->released);
+}
+
+static struct net_buf_quota *pkt_iface_quota(struct net_pkt *pkt)
+{
+	if (pkt->iface_quota) {
+		return pkt->iface_quota;
+	}
+
+	return pkt->iface ? &pkt->iface->buf_quota : NULL;
+}
+
+static struct net_buf_quota *pkt_context_quota(struct net_pkt *pkt)
+{
+	if (pkt->context_quota) {
+		return pkt->context_quota;
+	}
+
+	return pkt->context ? net_context_buf_quota(pkt->context) : NULL;
+}
+
+static int pkt_buf_quota_wait(struct net_pkt *pkt, u32_t start,
+			      s32_t timeout)
+{
+	struct net_buf_quota *quota;
+
+	quota = pkt_context_quota(pkt);
+	if (quota && buf_quota_wait(quota, start, timeout)) {
+		NET_DBG("Context %p over its buffer quota", pkt->context);
+		return -ENOBUFS;
+	}
+
+	quota = pkt_iface_quota(pkt);
+	if (quota && buf_quota_wait(quota, start, timeout)) {
+		NET_DBG("Iface %p over its buffer quota", pkt->iface);
+		return -ENOBUFS;
+	}
+
+	return 0;
+}
+
+static u16_t buf_count(struct net_buf *buf)
+{
+	u16_t count = 0U;
+
+	for (; buf; buf = buf->frags) {
+		count++;
+	}
+
+	return count;
+}
+
+static void pkt_buf_quota_charge(struct net_pkt *pkt, struct net_buf *buf)
+{
+	u16_t count = buf_count(buf);
+
+	pkt->context_quota = pkt_context_quota(pkt);
+	if (pkt->context_quota) {
+		atomic_add(&pkt->context_quota->used, count);
+		pkt->context_quota_bufs += count;
+	}
+
+	pkt->iface_quota = pkt_iface_quota(pkt);
+	if (pkt->iface_quota) {
+		atomic_add(&pkt->iface_quota->used, count);
+		pkt->iface_quota_bufs += count;
+	}
+}
+
+static void pkt_buf_quota_release(struct net_pkt *pkt)
+{
+	buf_quota_release(pkt->context_quota, pkt->context_quota_bufs);
+	buf_quota_release(pkt->iface_quota, pkt->iface_quota_bufs);
+}
+
+int net_pkt_context_charge(struct net_pkt *pkt)
+{
+	struct net_buf_quota *quota;
+	u16_t count;
+
+	if (pkt->context_quota || !pkt->context) {
+		return 0;
+	}
+
+	quota = net_context_buf_quota(pkt->context);
+	if (net_buf_quota_is_full(quota)) {
+		return -ENOBUFS;
+	}
+
+	count = buf_count(pkt->buffer);
+
+	atomic_add(&quota->used, count);
+	pkt->context_quota = quota;
+	pkt->context_quota_bufs = count;
+
+	return 0;
+}
+#else
+#define pkt_buf_quota_wait(...) 0
+#define pkt_buf_quota_charge(...)
+#define pkt_buf_quota_release(...)
+#endif /* CONFIG_NET_BUF_QUOTA */
+
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
 void net_pkt_unref_debug(struct net_pkt *pkt, const char *caller, int line)
 {
@@ -586,6 +801,8 @@ done:
 		net_pkt_frag_unref(pkt->frags);
 	}
 
+	pkt_buf_quota_release(pkt);
+
 	if (IS_ENABLED(CONFIG_NET_DEBUG_NET_PKT_NON_FRAGILE_ACCESS)) {
 		pkt->buffer = NULL;
 		net_pkt_cursor_init(pkt);
@@ -952,6 +1169,13 @@ static size_t pkt_buffer_length(struct net_pkt *pkt,
 		max_len = 0;
 	}
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* TCP segments it into MTU sized packets only when sending */
+	if (net_pkt_gso_size(pkt)) {
+		max_len = MAX(max_len, CONFIG_NET_TCP_GSO_MAX_SIZE);
+	}
+#endif
+
 	/* Family vs iface MTU */
 	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
 		if (IS_ENABLED(CONFIG_NET_IPV6_FRAGMENT) && (size > max_len)) {
@@ -1137,6 +1361,10 @@ int net_pkt_alloc_buffer(struct net_pkt *pkt,
 		pool = pkt->slab == &tx_pkts ? &tx_bufs : &rx_bufs;
 	}
 
+	if (pkt_buf_quota_wait(pkt, alloc_start, timeout)) {
+		return -ENOBUFS;
+	}
+
 	if (timeout != K_NO_WAIT && timeout != K_FOREVER) {
 		u32_t diff = k_uptime_get_32() - alloc_start;
 
@@ -1154,6 +1382,8 @@ int net_pkt_alloc_buffer(struct net_pkt *pkt,
 		return -ENOMEM;
 	}
 
+	pkt_buf_quota_charge(pkt, buf);
+
 	net_pkt_append_buffer(pkt, buf);
 
 	return 0;
@@ -1701,6 +1931,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_timestamp(clone_pkt, net_pkt_timestamp(pkt));
 	net_pkt_set_priority(clone_pkt, net_pkt_priority(pkt));
 	net_pkt_set_orig_iface(clone_pkt, net_pkt_orig_iface(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
 		net_pkt_set_ipv4_ttl(clone_pkt, net_pkt_ipv4_ttl(pkt));
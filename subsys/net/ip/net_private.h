@@ -78,6 +78,11 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 #endif
 extern void net_tc_submit_to_tx_queue(u8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(u8_t tc, struct net_pkt *pkt);
+#if defined(CONFIG_NET_TCP_GRO)
+/* Index of the Rx queue handled by the calling thread, or -1 */
+extern int net_tc_rx_queue_current(void);
+extern bool net_tc_rx_queue_is_empty(int queue);
+#endif
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -103,6 +108,24 @@ static inline int net_context_get_timestamp(struct net_context *context,
 }
 #endif
 
+#if defined(CONFIG_NET_BUF_QUOTA)
+extern void net_buf_quota_init(struct net_buf_quota *quota, u16_t limit);
+extern void net_buf_quota_set(struct net_buf_quota *quota, u16_t limit);
+extern bool net_buf_quota_is_full(struct net_buf_quota *quota);
+extern struct net_buf_quota *net_context_buf_quota(struct net_context *ctx);
+/* Charge the buffers of a received packet to its context, without waiting.
+ * Returns -ENOBUFS if the context is over its quota.
+ */
+extern int net_pkt_context_charge(struct net_pkt *pkt);
+#else
+static inline int net_pkt_context_charge(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+#endif /* CONFIG_NET_BUF_QUOTA */
+
 #if defined(CONFIG_COAP)
 /**
  * @brief CoAP init function declaration. It belongs here because we don't want
@@ -148,6 +171,11 @@ extern char *net_byte_to_hex(char *ptr, u8_t byte, char base, bool pad);
 extern char *net_sprint_ll_addr_buf(const u8_t *ll, u8_t ll_len,
 				    char *buf, int buflen);
 extern u16_t net_calc_chksum(struct net_pkt *pkt, u8_t proto);
+/* Incrementally update a checksum field, in network byte order, after
+ * len bytes of the covered data changed from old to new (RFC 1624).
+ */
+extern u16_t net_calc_chksum_update(u16_t chksum, const void *old,
+				    const void *new, size_t len);
 
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
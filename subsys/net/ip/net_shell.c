@@ -251,6 +251,7 @@ static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_PROMISC_MODE,         "Promiscuous mode"),
 	EC(ETHERNET_PRIORITY_QUEUES,      "Priority queues"),
 	EC(ETHERNET_HW_FILTERING,         "MAC address filtering"),
+	EC(ETHERNET_HW_TX_TSO,            "TCP segmentation offload"),
 };
 
 static void print_supported_ethernet_capabilities(
@@ -2272,6 +2273,18 @@ static int cmd_net_gptp(const struct shell *shell, size_t argc, char *argv[])
 		PR("\tThe local clock has expired    : %s\n",
 		   domain->state.clk_slave_sync.rcvd_local_clk_tick ?
 							   "yes" : "no");
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+		PR("\tServo locked                   : %s\n",
+		   domain->state.clk_slave_sync.servo_locked ? "yes" : "no");
+		PR("\tOffset from master             : %d ns\n",
+		   (int)domain->state.clk_slave_sync.servo_offset);
+		PR("\tLargest offset since locked    : %d ns\n",
+		   (int)domain->state.clk_slave_sync.servo_offset_max);
+		PR("\tOffset jitter                  : %d ns\n",
+		   (int)domain->state.clk_slave_sync.servo_jitter);
+		PR("\tFrequency correction           : %d ppb\n",
+		   (int)domain->state.clk_slave_sync.servo_freq);
+#endif
 
 		PR("PortRoleSelection state machine variables:\n");
 		PR("\tCurrent state                  : %s\n",
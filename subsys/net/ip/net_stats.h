@@ -463,6 +463,52 @@ static inline void net_stats_update_tc_rx_time(struct net_if *iface,
 #endif /* NET_PKT_RXTIME_STATS && NET_STATISTICS */
 #endif /* NET_TC_COUNT > 1 */
 
+#if defined(CONFIG_NET_CONTEXT_STATISTICS)
+#include <net/net_context.h>
+
+/* Each CPU updates its own copy of the context statistics */
+#if defined(CONFIG_SMP)
+#define CONTEXT_STAT(_ctx) ((_ctx)->stats[arch_curr_cpu()->id])
+#else
+#define CONTEXT_STAT(_ctx) ((_ctx)->stats[0])
+#endif
+
+static inline void net_stats_update_context_sent(struct net_context *ctx,
+						 int status)
+{
+	if (status < 0) {
+		CONTEXT_STAT(ctx).tx_errors++;
+	} else {
+		CONTEXT_STAT(ctx).pkts.tx++;
+		CONTEXT_STAT(ctx).bytes.sent += status;
+	}
+}
+
+static inline void net_stats_update_context_recv(struct net_context *ctx,
+						 u32_t bytes)
+{
+	CONTEXT_STAT(ctx).pkts.rx++;
+	CONTEXT_STAT(ctx).bytes.received += bytes;
+}
+
+static inline void net_stats_update_context_rx_drop(struct net_context *ctx)
+{
+	CONTEXT_STAT(ctx).rx_drop++;
+}
+
+static inline void net_stats_update_context_resent(struct net_context *ctx)
+{
+	if (ctx) {
+		CONTEXT_STAT(ctx).resent++;
+	}
+}
+#else
+#define net_stats_update_context_sent(ctx, status)
+#define net_stats_update_context_recv(ctx, bytes)
+#define net_stats_update_context_rx_drop(ctx)
+#define net_stats_update_context_resent(ctx)
+#endif /* CONFIG_NET_CONTEXT_STATISTICS */
+
 #if defined(CONFIG_NET_STATISTICS_PERIODIC_OUTPUT) \
 	&& defined(CONFIG_NET_NATIVE)
 /* A simple periodic statistic printer, used only in net core */
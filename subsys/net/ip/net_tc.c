@@ -13,6 +13,8 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <net/net_core.h>
 #include <net/net_pkt.h>
 #include <net/net_stats.h>
+#include <net/ethernet.h>
+#include <sys/byteorder.h>
 
 #include "net_private.h"
 #include "net_stats.h"
@@ -28,21 +30,178 @@ NET_STACK_ARRAY_DEFINE(TX, tx_stack,
 NET_STACK_ARRAY_DEFINE(RX, rx_stack,
 		       CONFIG_NET_RX_STACK_SIZE,
 		       CONFIG_NET_RX_STACK_SIZE,
-		       NET_TC_RX_COUNT);
+		       NET_RX_QUEUES);
 
 static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[NET_RX_QUEUES];
 
 void net_tc_submit_to_tx_queue(u8_t tc, struct net_pkt *pkt)
 {
 	k_work_submit_to_queue(&tx_classes[tc].work_q, net_pkt_work(pkt));
 }
 
+#if NET_RX_QUEUE_COUNT > 1
+#if defined(CONFIG_NET_L2_ETHERNET)
+static u32_t flow_hash_mix(u32_t hash, u32_t value)
+{
+	hash ^= value;
+	hash *= 0x9e3779b1U;
+
+	return hash ^ (hash >> 16);
+}
+
+/* Hash the addresses, protocol and ports of an IP packet. The ports are
+ * left out of fragments, which would otherwise not land in the same
+ * queue as the first fragment.
+ */
+static u32_t flow_hash_ip(const u8_t *data, size_t len)
+{
+	const u8_t *ports = NULL;
+	u32_t hash = 0U;
+	u8_t proto = 0U;
+	size_t addr_len = 0;
+	size_t hdr_len = 0;
+	const u8_t *addr;
+	size_t i;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && len >= sizeof(struct net_ipv4_hdr) &&
+	    (data[0] >> 4) == 4) {
+		const struct net_ipv4_hdr *hdr = (const void *)data;
+
+		proto = hdr->proto;
+		addr = (const u8_t *)&hdr->src;
+		addr_len = 2 * sizeof(struct in_addr);
+		hdr_len = (data[0] & 0x0f) * 4U;
+
+		/* Fragment offset or more fragments flag set */
+		if ((sys_get_be16(hdr->offset) & 0x3fff) != 0U) {
+			hdr_len = 0;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   len >= sizeof(struct net_ipv6_hdr) && (data[0] >> 4) == 6) {
+		const struct net_ipv6_hdr *hdr = (const void *)data;
+
+		proto = hdr->nexthdr;
+		addr = (const u8_t *)&hdr->src;
+		addr_len = 2 * sizeof(struct in6_addr);
+		hdr_len = sizeof(struct net_ipv6_hdr);
+	} else {
+		return 0;
+	}
+
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP) && hdr_len != 0U &&
+	    len >= hdr_len + 2 * sizeof(u16_t)) {
+		ports = data + hdr_len;
+	}
+
+	for (i = 0; i < addr_len; i += sizeof(u32_t)) {
+		hash = flow_hash_mix(hash, UNALIGNED_GET((u32_t *)(addr + i)));
+	}
+
+	hash = flow_hash_mix(hash, proto);
+
+	if (ports != NULL) {
+		hash = flow_hash_mix(hash, UNALIGNED_GET((u32_t *)ports));
+	}
+
+	return hash;
+}
+
+/* Software flow hash, looking at the first fragment of the packet only */
+static u32_t flow_hash(struct net_pkt *pkt)
+{
+	const u8_t *data;
+	size_t len;
+	u16_t type;
+
+	if (!pkt->buffer ||
+	    net_if_l2(net_pkt_iface(pkt)) != &NET_L2_GET_NAME(ETHERNET)) {
+		return 0;
+	}
+
+	data = pkt->buffer->data;
+	len = pkt->buffer->len;
+
+	if (len < sizeof(struct net_eth_hdr)) {
+		return 0;
+	}
+
+	type = sys_get_be16(data + offsetof(struct net_eth_hdr, type));
+	data += sizeof(struct net_eth_hdr);
+	len -= sizeof(struct net_eth_hdr);
+
+	if (type == NET_ETH_PTYPE_VLAN) {
+		if (len < 2 * sizeof(u16_t)) {
+			return 0;
+		}
+
+		type = sys_get_be16(data + sizeof(u16_t));
+		data += 2 * sizeof(u16_t);
+		len -= 2 * sizeof(u16_t);
+	}
+
+	if (type != NET_ETH_PTYPE_IP && type != NET_ETH_PTYPE_IPV6) {
+		return 0;
+	}
+
+	return flow_hash_ip(data, len);
+}
+#else
+/* Only Ethernet frames are parsed, other packets need a driver hash */
+static inline u32_t flow_hash(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+#endif /* CONFIG_NET_L2_ETHERNET */
+
+/* Select the queue of the traffic class for the flow of the packet */
+static int rx_flow_queue(struct net_pkt *pkt)
+{
+	u32_t hash = net_pkt_rx_hash(pkt);
+
+	if (hash == 0U) {
+		hash = flow_hash(pkt);
+		net_pkt_set_rx_hash(pkt, hash);
+	}
+
+	return hash % NET_RX_QUEUE_COUNT;
+}
+#endif /* NET_RX_QUEUE_COUNT > 1 */
+
 void net_tc_submit_to_rx_queue(u8_t tc, struct net_pkt *pkt)
 {
-	k_work_submit_to_queue(&rx_classes[tc].work_q, net_pkt_work(pkt));
+	int idx = tc;
+
+#if NET_RX_QUEUE_COUNT > 1
+	idx = tc * NET_RX_QUEUE_COUNT + rx_flow_queue(pkt);
+#endif
+
+	k_work_submit_to_queue(&rx_classes[idx].work_q, net_pkt_work(pkt));
+}
+
+#if defined(CONFIG_NET_TCP_GRO)
+int net_tc_rx_queue_current(void)
+{
+	k_tid_t current = k_current_get();
+	int i;
+
+	for (i = 0; i < NET_RX_QUEUES; i++) {
+		if (current == &rx_classes[i].work_q.thread) {
+			return i;
+		}
+	}
+
+	return -1;
 }
 
+bool net_tc_rx_queue_is_empty(int queue)
+{
+	return k_queue_is_empty(&rx_classes[queue].work_q.queue);
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
 int net_tx_priority2tc(enum net_priority prio)
 {
 	if (prio > NET_PRIORITY_NC) {
@@ -177,6 +336,25 @@ static u8_t rx_tc2thread(u8_t tc)
 #define RX_STACK(idx) NET_STACK_GET_NAME(RX, rx_stack, 0)[idx]
 #endif
 
+#if defined(CONFIG_NET_TC_THREAD_CPU_AFFINITY)
+/* Spread the queue threads over the CPUs */
+static void tc_thread_pin(struct k_thread *thread, int idx)
+{
+	int cpu = idx % CONFIG_MP_NUM_CPUS;
+
+	/* The CPU mask can only be changed while the thread cannot run */
+	k_thread_suspend(thread);
+
+	if (k_thread_cpu_pin(thread, cpu) < 0) {
+		NET_WARN("Cannot pin thread %p to CPU %d", thread, cpu);
+	}
+
+	k_thread_resume(thread);
+}
+#else
+#define tc_thread_pin(...)
+#endif
+
 #if defined(CONFIG_NET_STATISTICS)
 /* Fixup the traffic class statistics so that "net stats" shell command will
  * print output correctly.
@@ -258,6 +436,7 @@ void net_tc_tx_init(void)
 			       K_THREAD_STACK_SIZEOF(tx_stack[i]),
 			       K_PRIO_COOP(thread_priority));
 		k_thread_name_set(&tx_classes[i].work_q.thread, "tx_workq");
+		tc_thread_pin(&tx_classes[i].work_q.thread, i);
 	}
 }
 
@@ -271,10 +450,10 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_RX_QUEUES; i++) {
 		u8_t thread_priority;
 
-		thread_priority = rx_tc2thread(i);
+		thread_priority = rx_tc2thread(i / NET_RX_QUEUE_COUNT);
 		rx_classes[i].tc = thread_priority;
 
 #if defined(CONFIG_NET_SHELL)
@@ -297,5 +476,6 @@ void net_tc_rx_init(void)
 			       K_THREAD_STACK_SIZEOF(rx_stack[i]),
 			       K_PRIO_COOP(thread_priority));
 		k_thread_name_set(&rx_classes[i].work_q.thread, "rx_workq");
+		tc_thread_pin(&rx_classes[i].work_q.thread, i);
 	}
 }
@@ -14,6 +14,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 
 #include <kernel.h>
 #include <limits.h>
+#include <string.h>
 #include <zephyr/types.h>
 #include <sys/slist.h>
 
@@ -24,6 +25,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 #include <net/net_ip.h>
 
 #include "net_private.h"
+#include "net_stats.h"
 #include "ipv6.h"
 #include "icmpv6.h"
 #include "nbr.h"
@@ -253,12 +255,142 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
+	if (sys_slist_peek_head(&routes) == &route->node) {
+		return;
+	}
+
 	sys_slist_find_and_remove(&routes, &route->node);
 	sys_slist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+#if defined(CONFIG_NET_ROUTE_HASH) || defined(CONFIG_NET_ROUTE_CACHE) || \
+	defined(CONFIG_NET_ROUTING_FAST_PATH)
+static inline u32_t route_hash_mix(u32_t hash, u32_t value)
+{
+	hash ^= value;
+	hash *= 0x9e3779b1U;
+
+	return hash ^ (hash >> 16);
+}
+
+static u32_t route_hash_addr(u32_t hash, const struct in6_addr *addr)
+{
+	int i;
+
+	for (i = 0; i < 4; i++) {
+		hash = route_hash_mix(hash, UNALIGNED_GET(&addr->s6_addr32[i]));
+	}
+
+	return hash;
+}
+#endif
+
+#if defined(CONFIG_NET_ROUTE_HASH)
+#define NET_ROUTE_PREFIX_LENGTHS 129
+
+/* The routes are hashed by prefix and prefix length. A lookup tries the
+ * prefix lengths in use from the longest one, so the first matching
+ * route is the longest match.
+ */
+static sys_slist_t route_hash[CONFIG_NET_ROUTE_HASH_SIZE];
+static u16_t route_prefix_count[NET_ROUTE_PREFIX_LENGTHS];
+static u32_t route_prefix_map[(NET_ROUTE_PREFIX_LENGTHS + 31) / 32];
+
+static void route_prefix_get(struct in6_addr *prefix,
+			     const struct in6_addr *addr, u8_t len)
+{
+	int i;
+
+	for (i = 0; i < sizeof(prefix->s6_addr); i++) {
+		if (len >= 8U) {
+			prefix->s6_addr[i] = addr->s6_addr[i];
+			len -= 8U;
+		} else {
+			prefix->s6_addr[i] = addr->s6_addr[i] &
+				(u8_t)(0xff << (8 - len));
+			len = 0U;
+		}
+	}
+}
+
+static sys_slist_t *route_hash_list(const struct in6_addr *addr, u8_t len)
+{
+	struct in6_addr prefix;
+
+	route_prefix_get(&prefix, addr, len);
+
+	return &route_hash[route_hash_addr(len, &prefix) %
+			   CONFIG_NET_ROUTE_HASH_SIZE];
+}
+
+static void route_hash_add(struct net_route_entry *route)
+{
+	u8_t len = route->prefix_len;
+
+	sys_slist_prepend(route_hash_list(&route->addr, len),
+			  &route->hash_node);
+
+	if (route_prefix_count[len]++ == 0U) {
+		route_prefix_map[len / 32] |= BIT(len % 32);
+	}
+}
+
+static void route_hash_del(struct net_route_entry *route)
+{
+	u8_t len = route->prefix_len;
+
+	if (!sys_slist_find_and_remove(route_hash_list(&route->addr, len),
+				       &route->hash_node)) {
+		return;
+	}
+
+	if (--route_prefix_count[len] == 0U) {
+		route_prefix_map[len / 32] &= ~BIT(len % 32);
+	}
+}
+
+static struct net_route_entry *route_table_lookup(struct net_if *iface,
+						  struct in6_addr *dst)
+{
+	struct net_route_entry *route;
+	int word;
+
+	for (word = ARRAY_SIZE(route_prefix_map) - 1; word >= 0; word--) {
+		u32_t map = route_prefix_map[word];
+
+		while (map) {
+			int bit = find_msb_set(map) - 1;
+			u8_t len = word * 32 + bit;
+
+			map &= ~BIT(bit);
+
+			SYS_SLIST_FOR_EACH_CONTAINER(route_hash_list(dst, len),
+						     route, hash_node) {
+				if (route->prefix_len != len) {
+					continue;
+				}
+
+				if (iface && route->iface != iface) {
+					continue;
+				}
+
+				if (net_ipv6_is_prefix((u8_t *)dst,
+						       (u8_t *)&route->addr,
+						       len)) {
+					return route;
+				}
+			}
+		}
+	}
+
+	return NULL;
+}
+#else
+#define route_hash_add(...)
+#define route_hash_del(...)
+
+static struct net_route_entry *route_table_lookup(struct net_if *iface,
+						  struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	u8_t longest_match = 0U;
@@ -286,6 +418,171 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+#endif /* CONFIG_NET_ROUTE_HASH */
+
+#if defined(CONFIG_NET_ROUTE_CACHE)
+/* Last routes found, by interface and destination. Only the successful
+ * lookups are cached, and the whole cache is flushed when a route is
+ * added or deleted.
+ */
+struct route_cache_entry {
+	struct net_if *iface;
+	struct net_route_entry *route;
+	struct in6_addr dst;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+
+static struct route_cache_entry *route_cache_slot(struct net_if *iface,
+						  struct in6_addr *dst)
+{
+	u32_t hash = route_hash_addr((u32_t)(uintptr_t)iface, dst);
+
+	return &route_cache[hash % CONFIG_NET_ROUTE_CACHE_SIZE];
+}
+
+static struct net_route_entry *route_cache_lookup(struct net_if *iface,
+						  struct in6_addr *dst)
+{
+	struct route_cache_entry *slot = route_cache_slot(iface, dst);
+
+	if (slot->route && slot->iface == iface &&
+	    net_ipv6_addr_cmp(&slot->dst, dst)) {
+		return slot->route;
+	}
+
+	return NULL;
+}
+
+static void route_cache_add(struct net_if *iface, struct in6_addr *dst,
+			    struct net_route_entry *route)
+{
+	struct route_cache_entry *slot = route_cache_slot(iface, dst);
+
+	slot->iface = iface;
+	slot->route = route;
+	net_ipaddr_copy(&slot->dst, dst);
+}
+
+static inline void route_cache_flush(void)
+{
+	(void)memset(route_cache, 0, sizeof(route_cache));
+}
+#else
+#define route_cache_lookup(...) NULL
+#define route_cache_add(...)
+#define route_cache_flush(...)
+#endif /* CONFIG_NET_ROUTE_CACHE */
+
+#if defined(CONFIG_NET_ROUTING_FAST_PATH)
+/* Outgoing neighbor of the last forwarded destinations, by incoming
+ * interface and destination. The neighbor is checked on each use, as it
+ * can be released or reused for another address at any time.
+ */
+struct route_fwd_entry {
+	struct net_if *iface;
+	struct net_nbr *nbr;
+	struct in6_addr dst;
+	struct in6_addr nexthop;
+};
+
+static struct route_fwd_entry route_fwd[CONFIG_NET_ROUTING_FAST_PATH_SIZE];
+
+static struct route_fwd_entry *route_fwd_slot(struct net_if *iface,
+					      struct in6_addr *dst)
+{
+	u32_t hash = route_hash_addr((u32_t)(uintptr_t)iface, dst);
+
+	return &route_fwd[hash % CONFIG_NET_ROUTING_FAST_PATH_SIZE];
+}
+
+static void route_fwd_add(struct net_pkt *pkt, struct in6_addr *nexthop,
+			  struct net_nbr *nbr)
+{
+	struct in6_addr *dst = &NET_IPV6_HDR(pkt)->dst;
+	struct route_fwd_entry *entry;
+
+	entry = route_fwd_slot(net_pkt_orig_iface(pkt), dst);
+	entry->iface = net_pkt_orig_iface(pkt);
+	entry->nbr = nbr;
+	net_ipaddr_copy(&entry->dst, dst);
+	net_ipaddr_copy(&entry->nexthop, nexthop);
+}
+
+static inline void route_fwd_flush(void)
+{
+	(void)memset(route_fwd, 0, sizeof(route_fwd));
+}
+
+int net_route_fast_forward(struct net_pkt *pkt, struct in6_addr *dst)
+{
+	struct route_fwd_entry *entry = route_fwd_slot(net_pkt_iface(pkt),
+						       dst);
+	struct net_linkaddr_storage *lladdr;
+	struct net_nbr *nbr = entry->nbr;
+	struct net_if *iface;
+
+	if (!nbr || entry->iface != net_pkt_iface(pkt) ||
+	    !net_ipv6_addr_cmp(&entry->dst, dst)) {
+		return -ENOENT;
+	}
+
+	if (!nbr->ref || nbr->idx == NET_NBR_LLADDR_UNKNOWN ||
+	    !net_ipv6_addr_cmp(&net_ipv6_nbr_data(nbr)->addr,
+			       &entry->nexthop)) {
+		entry->nbr = NULL;
+		return -ENOENT;
+	}
+
+	/* Leave the error handling to the normal path */
+	iface = nbr->iface;
+	if (!net_if_is_up(iface) ||
+	    net_pkt_get_len(pkt) > net_if_get_mtu(iface) ||
+	    !net_pkt_lladdr_src(pkt)->addr) {
+		return -ENOENT;
+	}
+
+	lladdr = net_nbr_get_lladdr(nbr->idx);
+
+	net_pkt_set_orig_iface(pkt, net_pkt_iface(pkt));
+	net_pkt_set_iface(pkt, iface);
+	net_pkt_set_forwarding(pkt, true);
+
+	net_pkt_lladdr_src(pkt)->addr = net_pkt_lladdr_if(pkt)->addr;
+	net_pkt_lladdr_src(pkt)->type = net_pkt_lladdr_if(pkt)->type;
+	net_pkt_lladdr_src(pkt)->len = net_pkt_lladdr_if(pkt)->len;
+
+	net_pkt_lladdr_dst(pkt)->addr = lladdr->addr;
+	net_pkt_lladdr_dst(pkt)->type = lladdr->type;
+	net_pkt_lladdr_dst(pkt)->len = lladdr->len;
+
+	net_stats_update_ipv6_sent(iface);
+
+	net_pkt_cursor_init(pkt);
+	net_if_queue_tx(iface, pkt);
+
+	return 0;
+}
+#else
+#define route_fwd_add(...)
+#define route_fwd_flush(...)
+#endif /* CONFIG_NET_ROUTING_FAST_PATH */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	found = route_cache_lookup(iface, dst);
+	if (!found) {
+		found = route_table_lookup(iface, dst);
+		if (found) {
+			route_cache_add(iface, dst, found);
+		}
+	}
+
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -317,6 +614,11 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 		return NULL;
 	}
 
+	if (prefix_len > 128) {
+		NET_DBG("Invalid prefix length %u", prefix_len);
+		return NULL;
+	}
+
 	nbr_nexthop = net_ipv6_nbr_lookup(iface, nexthop);
 	if (!nbr_nexthop) {
 		NET_DBG("No such neighbor %s found",
@@ -402,6 +704,9 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route->iface = iface;
 
 	sys_slist_prepend(&routes, &route->node);
+	route_hash_add(route);
+	route_cache_flush();
+	route_fwd_flush();
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -455,6 +760,9 @@ int net_route_del(struct net_route_entry *route)
 #endif
 
 	sys_slist_find_and_remove(&routes, &route->node);
+	route_hash_del(route);
+	route_cache_flush();
+	route_fwd_flush();
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -822,6 +1130,8 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 
 	net_pkt_set_iface(pkt, nbr->iface);
 
+	route_fwd_add(pkt, nexthop, nbr);
+
 	return net_send_data(pkt);
 }
 
@@ -48,6 +48,11 @@ struct net_route_entry {
 	 */
 	sys_snode_t node;
 
+#if defined(CONFIG_NET_ROUTE_HASH)
+	/** Node in the route hash table */
+	sys_snode_t hash_node;
+#endif
+
 	/** List of neighbors that the routes go through. */
 	sys_slist_t nexthop;
 
@@ -262,6 +267,29 @@ bool net_route_get_info(struct net_if *iface,
  */
 int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop);
 
+/**
+ * @brief Forward the network packet to the neighbor used for the previous
+ * packets to the same destination, if it is still known.
+ *
+ * @param pkt Network packet to forward, not destined to this host.
+ * @param dst Destination IPv6 address of the packet.
+ *
+ * @return 0 if the packet was queued for sending, <0 if it must go
+ * through the normal routing path.
+ */
+#if defined(CONFIG_NET_ROUTING_FAST_PATH)
+int net_route_fast_forward(struct net_pkt *pkt, struct in6_addr *dst);
+#else
+static inline int net_route_fast_forward(struct net_pkt *pkt,
+					 struct in6_addr *dst)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(dst);
+
+	return -ENOTSUP;
+}
+#endif /* CONFIG_NET_ROUTING_FAST_PATH */
+
 #if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_NATIVE)
 void net_route_init(void);
 #else
@@ -252,6 +252,8 @@ static void tcp_retry_expired(struct k_work *work)
 				net_stats_update_tcp_seg_rexmit(
 							net_pkt_iface(pkt));
 			}
+
+			net_stats_update_context_resent(tcp->context);
 		}
 	} else if (CONFIG_NET_TCP_TIME_WAIT_DELAY != 0) {
 		if (tcp->fin_sent && tcp->fin_rcvd) {
@@ -659,6 +661,181 @@ u16_t net_tcp_get_recv_mss(const struct net_tcp *tcp)
 	return 0;
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+u16_t net_tcp_get_gso_size(const struct net_tcp *tcp)
+{
+	struct net_if *iface = net_context_get_iface(tcp->context);
+	sa_family_t family = net_context_get_family(tcp->context);
+	u16_t mtu;
+
+	if (!iface) {
+		return 0;
+	}
+
+	mtu = net_if_get_mtu(iface);
+
+	/* Same segment size as when TCP data is queued in MTU sized
+	 * packets, see pkt_buffer_length() in net_pkt.c
+	 */
+	if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET) {
+		return MAX(mtu, NET_IPV4_MTU) - NET_IPV4TCPH_LEN;
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		return MAX(mtu, NET_IPV6_MTU) - NET_IPV6TCPH_LEN;
+	}
+
+	return 0;
+}
+
+/* Split a packet queued with a GSO size into segments carrying at most
+ * that much payload each, and send them. The original packet stays in
+ * the sent list for retransmission, so it is only unreferenced, like
+ * net_send_data() would do once it has sent it.
+ */
+static int tcp_gso_send(struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	size_t mss = net_pkt_gso_size(pkt);
+	size_t len = net_pkt_get_len(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	size_t hdr_len, offset, seg_len;
+	struct net_pkt *seg;
+	u8_t flags;
+	u32_t seq;
+	int ret;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		return -EMSGSIZE;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		return -EMSGSIZE;
+	}
+
+	hdr_len = ip_len + NET_TCP_HDR_LEN(tcp_hdr);
+	seq = sys_get_be32(tcp_hdr->seq);
+	flags = tcp_hdr->flags;
+
+	for (offset = hdr_len; offset < len; offset += seg_len) {
+		seg_len = MIN(mss, len - offset);
+
+		seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt),
+						hdr_len + seg_len,
+						AF_UNSPEC, 0, ALLOC_TIMEOUT);
+		if (!seg) {
+			return -ENOMEM;
+		}
+
+		net_pkt_set_family(seg, net_pkt_family(pkt));
+		net_pkt_set_context(seg, net_pkt_context(pkt));
+		net_pkt_set_priority(seg, net_pkt_priority(pkt));
+		net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+
+		if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		    net_pkt_family(pkt) == AF_INET) {
+			net_pkt_set_ipv4_opts_len(seg,
+						  net_pkt_ipv4_opts_len(pkt));
+		} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+			   net_pkt_family(pkt) == AF_INET6) {
+			net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+			net_pkt_set_ipv6_next_hdr(seg,
+						  net_pkt_ipv6_next_hdr(pkt));
+		}
+
+		/* Headers, then this segment's share of the payload */
+		net_pkt_cursor_init(pkt);
+		if (net_pkt_copy(seg, pkt, hdr_len) ||
+		    net_pkt_skip(pkt, offset - hdr_len) ||
+		    net_pkt_copy(seg, pkt, seg_len)) {
+			ret = -ENOBUFS;
+			goto fail;
+		}
+
+		net_pkt_cursor_init(seg);
+		net_pkt_set_overwrite(seg, true);
+
+		if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		    net_pkt_family(seg) == AF_INET) {
+			NET_IPV4_HDR(seg)->chksum = 0U;
+		}
+
+		if (net_pkt_skip(seg, ip_len)) {
+			ret = -ENOBUFS;
+			goto fail;
+		}
+
+		tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg,
+								 &tcp_access);
+		if (!tcp_hdr) {
+			ret = -ENOBUFS;
+			goto fail;
+		}
+
+		sys_put_be32(seq + offset - hdr_len, tcp_hdr->seq);
+
+		/* PSH and FIN belong to the end of the data only */
+		if (offset + seg_len < len) {
+			tcp_hdr->flags = flags & ~(NET_TCP_PSH | NET_TCP_FIN);
+		}
+
+		net_pkt_set_data(seg, &tcp_access);
+
+		net_pkt_cursor_init(seg);
+
+		if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		    net_pkt_family(seg) == AF_INET) {
+			ret = net_ipv4_finalize(seg, IPPROTO_TCP);
+		} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+			   net_pkt_family(seg) == AF_INET6) {
+			ret = net_ipv6_finalize(seg, IPPROTO_TCP);
+		} else {
+			ret = -EPFNOSUPPORT;
+		}
+
+		if (ret < 0) {
+			goto fail;
+		}
+
+		ret = net_send_data(seg);
+		if (ret < 0) {
+			goto fail;
+		}
+	}
+
+	net_pkt_unref(pkt);
+
+	return 0;
+
+fail:
+	net_pkt_unref(seg);
+
+	return ret;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+/* Pass a TCP packet down to the IP layer, segmenting it first if it is
+ * larger than the MTU and the network device cannot do it.
+ */
+static int tcp_pkt_send(struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_TCP_GSO)
+	size_t hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			 sizeof(struct net_tcp_hdr);
+
+	if (net_pkt_gso_size(pkt) &&
+	    net_pkt_get_len(pkt) > hdr_len + net_pkt_gso_size(pkt) &&
+	    net_if_need_tx_segmentation(net_pkt_iface(pkt))) {
+		return tcp_gso_send(pkt);
+	}
+#endif
+
+	return net_send_data(pkt);
+}
+
 static void net_tcp_set_syn_opt(struct net_tcp *tcp, u8_t *options,
 				u8_t *optionlen)
 {
@@ -959,19 +1136,20 @@ int net_tcp_send_pkt(struct net_pkt *pkt)
 			 * return < 0, the caller will unref the original pkt.
 			 * This would leak the new_pkt so remove it here.
 			 */
-			ret = net_send_data(new_pkt);
+			ret = tcp_pkt_send(new_pkt);
 			if (ret < 0) {
 				net_pkt_unref(new_pkt);
 			} else {
 				net_stats_update_tcp_seg_rexmit(
 							net_pkt_iface(pkt));
+				net_stats_update_context_resent(ctx);
 			}
 
 			return ret;
 		}
 	}
 
-	return net_send_data(pkt);
+	return tcp_pkt_send(pkt);
 }
 
 static void flush_queue(struct net_context *context)
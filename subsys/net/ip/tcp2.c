@@ -16,6 +16,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include "connection.h"
 #include "net_stats.h"
 #include "net_private.h"
+#include "tcp2.h"
 #include "tcp2_priv.h"
 
 static int tcp_rto = 500; /* Retransmission timeout, msec */
@@ -23,6 +24,16 @@ static int tcp_retries = 3;
 static int tcp_window = NET_IPV6_MTU;
 static bool tcp_echo;
 
+#define TCP_MSS_DEFAULT 536 /* RFC 1122, 4.2.2.6 */
+#define TCP_OPTIONS_LEN 12 /* MSS, window scale and SACK permitted */
+
+/* Outgoing segments are linearized in a single fragment */
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+#define TCP_SEG_MAX (CONFIG_NET_BUF_DATA_SIZE - 40)
+#else
+#define TCP_SEG_MAX (NET_IPV6_MTU - 40)
+#endif
+
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MEM_SLAB_DEFINE(tcp_conns_slab, sizeof(struct tcp),
@@ -442,45 +453,94 @@ out:
 static void tcp_win_append(struct tcp_win *w, const char *name,
 				const void *data, size_t len)
 {
-	struct net_buf *buf = tcp_nbuf_alloc(&tcp_nbufs, len);
 	size_t prev_len = w->len;
 
 	NET_ASSERT_INFO(len, "Zero length data");
 
-	memcpy(net_buf_add(buf, len), data, len);
+	while (len) {
+		struct net_buf *buf = tcp_nbuf_alloc(&tcp_nbufs, len);
+		size_t chunk = MIN(len, net_buf_tailroom(buf));
 
-	sys_slist_append(&w->bufs, (void *)&buf->user_data);
+		memcpy(net_buf_add(buf, chunk), data, chunk);
 
-	w->len += len;
+		sys_slist_append(&w->bufs, (void *)&buf->user_data);
+
+		w->len += chunk;
+		data = (const u8_t *)data + chunk;
+		len -= chunk;
+	}
 
 	NET_DBG("%s %p %zu->%zu byte(s)", name, buf, prev_len, w->len);
 }
 
-static struct net_buf *tcp_win_peek(struct tcp_win *w, const char *name,
-					size_t len)
+/* Append len bytes of the window, starting at offset, to the packet */
+static void tcp_win_copy(struct tcp_win *w, struct net_pkt *pkt,
+				size_t offset, size_t len)
 {
-	struct net_buf *out = tcp_nbuf_alloc(&tcp_nbufs, len);
 	struct net_buf *buf = tcp_slist(&w->bufs, peek_head, struct net_buf,
 					user_data);
-	while (buf) {
+	struct net_buf *frag = NULL;
 
-		if (len <= 0) {
-			break;
+	NET_ASSERT_INFO(offset + len <= w->len, "Insufficient window length, "
+			"len: %zu, req: %zu", w->len, offset + len);
+
+	for ( ; buf && len; buf = tcp_slist((sys_snode_t *)&buf->user_data,
+					peek_next, struct net_buf, user_data)) {
+		size_t pos;
+
+		if (offset >= buf->len) {
+			offset -= buf->len;
+			continue;
 		}
 
-		memcpy(net_buf_add(out, buf->len), buf->data, buf->len);
+		pos = offset;
+		offset = 0;
 
-		len -= buf->len;
+		while (pos < buf->len && len) {
+			size_t chunk;
+
+			if (frag == NULL || net_buf_tailroom(frag) == 0) {
+				frag = net_pkt_get_frag(pkt, K_NO_WAIT);
+				net_pkt_frag_add(pkt, frag);
+			}
+
+			chunk = MIN(MIN(buf->len - pos, len),
+					net_buf_tailroom(frag));
 
-		buf = tcp_slist((sys_snode_t *)&buf->user_data, peek_next,
-				struct net_buf, user_data);
+			memcpy(net_buf_add(frag, chunk), buf->data + pos,
+			       chunk);
+
+			pos += chunk;
+			len -= chunk;
+		}
 	}
+}
 
-	NET_ASSERT_INFO(len == 0, "Unfulfilled request, len: %zu", len);
+/* Release the first len bytes of the window */
+static void tcp_win_consume(struct tcp_win *w, const char *name, size_t len)
+{
+	NET_ASSERT_INFO(len <= w->len, "Insufficient window length, "
+			"len: %zu, req: %zu", w->len, len);
 
-	NET_DBG("%s len=%zu", name, net_buf_frags_len(out));
+	while (len) {
+		struct net_buf *buf = tcp_slist(&w->bufs, peek_head,
+						struct net_buf, user_data);
 
-	return out;
+		if (buf->len > len) {
+			net_buf_pull(buf, len);
+			w->len -= len;
+			break;
+		}
+
+		sys_slist_get(&w->bufs);
+
+		w->len -= buf->len;
+		len -= buf->len;
+
+		tcp_nbuf_unref(buf);
+	}
+
+	NET_DBG("%s len=%zu", name, w->len);
 }
 
 static const char *tcp_conn_state(struct tcp *conn, struct net_pkt *pkt)
@@ -530,6 +590,18 @@ static bool tcp_options_check(void *buf, ssize_t len)
 				goto end;
 			}
 			break;
+		case TCPOPT_SACK_PERM:
+			if (opt_len != 2) {
+				result = false;
+				goto end;
+			}
+			break;
+		case TCPOPT_SACK:
+			if (opt_len < 10 || ((opt_len - 2) % 8) != 0) {
+				result = false;
+				goto end;
+			}
+			break;
 		default:
 			continue;
 		}
@@ -556,6 +628,154 @@ static size_t tcp_data_len(struct net_pkt *pkt)
 	return data_len > 0 ? data_len : 0;
 }
 
+static inline u32_t tcp_snd_una(struct tcp *conn)
+{
+	return conn->seq - conn->unacked_len;
+}
+
+static size_t tcp_mss(struct tcp *conn)
+{
+	return MIN(conn->send_mss, TCP_SEG_MAX);
+}
+
+/* Pick the options negotiated by a SYN and the SACK blocks of an ACK */
+static void tcp_options_in(struct tcp *conn, struct tcphdr *th)
+{
+	u8_t *options = (u8_t *)(th + 1), opt, opt_len;
+	ssize_t len = (th->th_off - 5) * 4;
+	bool syn = th->th_flags & SYN;
+	int i;
+
+	if (syn) {
+		conn->send_mss = TCP_MSS_DEFAULT;
+		conn->snd_wscale = 0U;
+		conn->wscale_ok = false;
+		conn->sack_ok = false;
+	}
+
+	conn->sack_hole = 0U;
+
+	if (len <= 0 || false == tcp_options_check(options, len)) {
+		return;
+	}
+
+	for ( ; len >= 2; options += opt_len, len -= opt_len) {
+		opt = options[0];
+		opt_len = options[1];
+
+		if (opt == TCPOPT_PAD) {
+			break;
+		}
+		if (opt == TCPOPT_NOP) {
+			opt_len = 1;
+			continue;
+		} else if (opt_len < 2 || opt_len > len) {
+			break;
+		}
+
+		switch (opt) {
+		case TCPOPT_MAXSEG:
+			if (syn) {
+				conn->send_mss = MAX(ntohs(UNALIGNED_GET(
+						(u16_t *)(options + 2))), 1U);
+			}
+			break;
+		case TCPOPT_WINDOW:
+			if (syn && IS_ENABLED(CONFIG_NET_TCP2_WINDOW_SCALE)) {
+				conn->snd_wscale = MIN(options[2],
+						       TCP_WSCALE_MAX);
+				conn->wscale_ok = true;
+			}
+			break;
+		case TCPOPT_SACK_PERM:
+			if (syn && IS_ENABLED(CONFIG_NET_TCP2_SACK)) {
+				conn->sack_ok = true;
+			}
+			break;
+		case TCPOPT_SACK:
+			if (!conn->sack_ok) {
+				break;
+			}
+
+			/* Only the left edges are of use, to retransmit the
+			 * hole before the first SACK block
+			 */
+			for (i = 2; i + 8 <= opt_len; i += 8) {
+				u32_t left = ntohl(UNALIGNED_GET(
+						(u32_t *)(options + i)));
+				u32_t hole = left - tcp_snd_una(conn);
+
+				if (hole > 0U && hole <= conn->unacked_len &&
+				    (conn->sack_hole == 0U ||
+				     hole < conn->sack_hole)) {
+					conn->sack_hole = hole;
+				}
+			}
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+static size_t tcp_options_make(struct tcp *conn, u8_t flags, u8_t *options)
+{
+	/* A SYN,ACK only carries the options offered by the peer */
+	bool offer = !(flags & ACK);
+	u8_t *opt = options;
+	u16_t mtu = conn->iface ? net_if_get_mtu(conn->iface) : 0U;
+
+	if (!(flags & SYN)) {
+		return 0;
+	}
+
+	*opt++ = TCPOPT_MAXSEG;
+	*opt++ = 4U;
+	UNALIGNED_PUT(htons(mtu > 40U ? mtu - 40U : TCP_MSS_DEFAULT),
+		      (u16_t *)opt);
+	opt += 2;
+
+	if (IS_ENABLED(CONFIG_NET_TCP2_WINDOW_SCALE) &&
+	    (offer || conn->wscale_ok)) {
+		*opt++ = TCPOPT_NOP;
+		*opt++ = TCPOPT_WINDOW;
+		*opt++ = 3U;
+		*opt++ = conn->rcv_wscale;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP2_SACK) && (offer || conn->sack_ok)) {
+		*opt++ = TCPOPT_NOP;
+		*opt++ = TCPOPT_NOP;
+		*opt++ = TCPOPT_SACK_PERM;
+		*opt++ = 2U;
+	}
+
+	return opt - options;
+}
+
+/* The window of a SYN is never scaled, RFC 7323, 2.2 */
+static u16_t tcp_win_adv(struct tcp *conn, u8_t flags)
+{
+	u32_t win = conn->win;
+
+	if (!(flags & SYN) && conn->wscale_ok) {
+		win >>= conn->rcv_wscale;
+	}
+
+	return MIN(win, 0xffff);
+}
+
+static u8_t tcp_wscale(u32_t win)
+{
+	u8_t shift = 0U;
+
+	while (shift < TCP_WSCALE_MAX && (win >> shift) > 0xffff) {
+		shift++;
+	}
+
+	return shift;
+}
+
 static size_t tcp_data_get(struct tcp *conn, struct net_pkt *pkt)
 {
 	struct net_ipv4_hdr *ip = ip_get(pkt);
@@ -571,6 +791,8 @@ static size_t tcp_data_get(struct tcp *conn, struct net_pkt *pkt)
 
 		tcp_win_append(conn->rcv, "RCV", buf, len);
 
+		conn->stats.bytes_received += len;
+
 		if (tcp_echo) {
 			tcp_win_append(conn->snd, "SND", buf, len);
 		}
@@ -603,7 +825,9 @@ static void tcp_adj(struct net_pkt *pkt, int req_len)
 
 static struct net_pkt *tcp_pkt_make(struct tcp *conn, u8_t flags)
 {
-	const size_t len = 40;
+	u8_t options[TCP_OPTIONS_LEN];
+	size_t opts_len = tcp_options_make(conn, flags, options);
+	const size_t len = 40 + opts_len;
 	struct net_pkt *pkt = tcp_pkt_alloc(len);
 	struct net_ipv4_hdr *ip = ip_get(pkt);
 	struct tcphdr *th = (void *) (ip + 1);
@@ -621,11 +845,13 @@ static struct net_pkt *tcp_pkt_make(struct tcp *conn, u8_t flags)
 	th->th_sport = conn->src->sin.sin_port;
 	th->th_dport = conn->dst->sin.sin_port;
 
-	th->th_off = 5;
+	th->th_off = 5 + opts_len / 4;
 	th->th_flags = flags;
-	th->th_win = htons(conn->win);
+	th->th_win = htons(tcp_win_adv(conn, flags));
 	th->th_seq = htonl(conn->seq);
 
+	memcpy(th + 1, options, opts_len);
+
 	if (ACK & flags) {
 		th->th_ack = htonl(conn->ack);
 	}
@@ -691,69 +917,146 @@ static struct net_pkt *tcp_pkt_linearize(struct net_pkt *pkt)
 	return new;
 }
 
-static void tcp_chain_free(struct net_buf *head)
+static void tcp_out_pkt(struct tcp *conn, struct net_pkt *pkt)
 {
-	struct net_buf *next;
+	pkt = tcp_pkt_linearize(pkt);
 
-	for ( ; head; head = next) {
-		next = head->frags;
-		head->frags = NULL;
-		tcp_nbuf_unref(head);
+	tcp_csum(pkt);
+
+	NET_DBG("%s", tcp_th(pkt));
+
+	if (tcp_send_cb) {
+		tcp_send_cb(pkt);
+		goto out;
 	}
+
+	sys_slist_append(&conn->send_queue, &pkt->next);
+
+	tcp_send_process(&conn->send_timer);
+out:
+	return;
 }
 
-static void tcp_chain(struct net_pkt *pkt, struct net_buf *head)
+static void tcp_out(struct tcp *conn, u8_t flags)
 {
-	struct net_buf *buf;
+	tcp_out_pkt(conn, tcp_pkt_make(conn, flags));
+}
 
-	for ( ; head; head = head->frags) {
-		buf = net_pkt_get_frag(pkt, K_NO_WAIT);
-		memcpy(net_buf_add(buf, head->len), head->data, head->len);
-		net_pkt_frag_add(pkt, buf);
-	}
+/* Send len bytes of the send window, offset bytes after the first
+ * unacknowledged one
+ */
+static void tcp_out_data(struct tcp *conn, size_t offset, size_t len)
+{
+	struct net_pkt *pkt = tcp_pkt_make(conn, PSH);
+
+	th_get(pkt)->th_seq = htonl(tcp_snd_una(conn) + offset);
+
+	tcp_win_copy(conn->snd, pkt, offset, len);
+
+	tcp_adj(pkt, len);
+
+	conn->stats.bytes_sent += len;
+	conn->stats.segs_sent++;
+
+	tcp_out_pkt(conn, pkt);
 }
 
-static void tcp_out(struct tcp *conn, u8_t flags, ...)
+/* Send the queued data the peer's window and the congestion window
+ * leave room for
+ */
+static void tcp_send_data(struct tcp *conn)
 {
-	struct net_pkt *pkt = tcp_pkt_make(conn, flags);
+	u32_t wnd = MIN(conn->cc_data.cwnd, conn->snd_wnd);
 
-	if (PSH & flags) {
-		size_t len = conn->snd->len;
-		struct net_buf *buf = tcp_win_peek(conn->snd, "SND", len);
+	while (conn->unacked_len < conn->snd->len && conn->unacked_len < wnd) {
+		size_t len = MIN(conn->snd->len - conn->unacked_len,
+				 wnd - conn->unacked_len);
 
-		{
-			va_list ap;
-			ssize_t *out_len;
+		len = MIN(len, tcp_mss(conn));
 
-			va_start(ap, flags);
-			out_len = va_arg(ap, ssize_t *);
-			*out_len = len;
-			va_end(ap);
-		}
+		tcp_out_data(conn, conn->unacked_len, len);
 
-		tcp_chain(pkt, buf);
+		conn->unacked_len += len;
+		conn_seq(conn, + len);
+	}
+}
 
-		tcp_chain_free(buf);
+/* Resend the first unacknowledged segment, or only the bytes missing
+ * before the first SACK block
+ */
+static void tcp_retransmit(struct tcp *conn)
+{
+	size_t len = MIN(conn->unacked_len, tcp_mss(conn));
 
-		tcp_adj(pkt, len);
+	if (conn->sack_hole) {
+		len = MIN(len, conn->sack_hole);
 	}
 
-	pkt = tcp_pkt_linearize(pkt);
+	if (len == 0) {
+		return;
+	}
 
-	tcp_csum(pkt);
+	tcp_out_data(conn, 0, len);
 
-	NET_DBG("%s", tcp_th(pkt));
+	conn->stats.retransmits++;
+}
 
-	if (tcp_send_cb) {
-		tcp_send_cb(pkt);
-		goto out;
+static void tcp_cc_setup(struct tcp *conn)
+{
+	conn->cc_data.mss = tcp_mss(conn);
+	conn->cc->init(&conn->cc_data);
+}
+
+/* Process the acknowledgment number and the window of a segment, and
+ * recover from losses signaled by duplicate ACKs (RFC 6582)
+ */
+static void tcp_ack_in(struct tcp *conn, struct net_pkt *pkt)
+{
+	struct tcphdr *th = th_get(pkt);
+	u32_t acked = th_ack(th) - tcp_snd_una(conn);
+
+	if (acked > conn->unacked_len) {
+		NET_DBG("Ignoring ACK=%u, una=%u", th_ack(th),
+			tcp_snd_una(conn));
+		return;
 	}
 
-	sys_slist_append(&conn->send_queue, &pkt->next);
+	conn->snd_wnd = (u32_t)ntohs(th->th_win) << conn->snd_wscale;
 
-	tcp_send_process(&conn->send_timer);
-out:
-	return;
+	if (acked) {
+		tcp_win_consume(conn->snd, "SND", acked);
+		conn->unacked_len -= acked;
+		conn->stats.bytes_acked += acked;
+		conn->dup_acks = 0U;
+	}
+
+	tcp_options_in(conn, th);
+
+	if (acked == 0U) {
+		if (conn->unacked_len && tcp_data_len(pkt) == 0) {
+			conn->stats.dup_acks++;
+
+			if (++conn->dup_acks == TCP_DUP_ACKS &&
+			    !conn->in_recovery) {
+				conn->in_recovery = true;
+				conn->recover = conn->seq;
+				conn->cc->loss(&conn->cc_data,
+					       conn->unacked_len);
+				tcp_retransmit(conn);
+			}
+		}
+	} else if (conn->in_recovery) {
+		if ((s32_t)(th_ack(th) - conn->recover) >= 0) {
+			conn->in_recovery = false;
+		} else {
+			/* Partial ACK, the next segment was lost too */
+			tcp_retransmit(conn);
+		}
+	} else {
+		conn->cc->ack(&conn->cc_data, acked);
+	}
+
+	tcp_send_data(conn);
 }
 
 static void tcp_conn_ref(struct tcp *conn)
@@ -778,6 +1081,15 @@ static struct tcp *tcp_conn_alloc(void)
 	conn->state = TCP_LISTEN;
 
 	conn->win = tcp_window;
+	conn->snd_wnd = tcp_window;
+	conn->send_mss = TCP_MSS_DEFAULT;
+
+	if (IS_ENABLED(CONFIG_NET_TCP2_WINDOW_SCALE)) {
+		conn->rcv_wscale = tcp_wscale(conn->win);
+	}
+
+	conn->cc = tcp_cc_find(NULL);
+	tcp_cc_setup(conn);
 
 	conn->rcv = tcp_win_new();
 	conn->snd = tcp_win_new();
@@ -1002,6 +1314,8 @@ next_state:
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
+			tcp_options_in(conn, th);
+			conn->snd_wnd = ntohs(th->th_win);
 			tcp_out(conn, SYN | ACK);
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
@@ -1014,6 +1328,9 @@ next_state:
 	case TCP_SYN_RECEIVED:
 		if (FL(&fl, &, ACK, th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			conn->snd_wnd = (u32_t)ntohs(th->th_win) <<
+				conn->snd_wscale;
+			tcp_cc_setup(conn);
 			next = TCP_ESTABLISHED;
 			if (FL(&fl, &, PSH)) {
 				tcp_data_get(conn, pkt);
@@ -1033,17 +1350,17 @@ next_state:
 			}
 			if (FL(&fl, &, SYN)) {
 				conn_ack(conn, th_seq(th) + 1);
+				tcp_options_in(conn, th);
+				conn->snd_wnd = ntohs(th->th_win);
 				tcp_out(conn, ACK);
 			}
+			tcp_cc_setup(conn);
 		}
 		break;
 	case TCP_ESTABLISHED:
 		net_context_set_state(conn->context, NET_CONTEXT_CONNECTED);
 		if (!th && conn->snd->len) { /* TODO: Out of the loop */
-			ssize_t data_len;
-
-			tcp_out(conn, PSH, &data_len);
-			conn_seq(conn, + data_len);
+			tcp_send_data(conn);
 			break;
 		}
 		/* full-close */
@@ -1071,8 +1388,7 @@ next_state:
 				tcp_out(conn, ACK);
 
 				if (tcp_echo) { /* TODO: Out of the loop? */
-					tcp_out(conn, PSH, &len);
-					conn_seq(conn, + len);
+					tcp_send_data(conn);
 				}
 			} else {
 				tcp_out(conn, RST);
@@ -1080,9 +1396,8 @@ next_state:
 				break;
 			}
 		}
-		if (FL(&fl, ==, ACK, th_ack(th) == conn->seq)) {
-			tcp_win_free(conn->snd, "SND");
-			conn->snd = tcp_win_new();
+		if (FL(&fl, ==, ACK)) {
+			tcp_ack_in(conn, pkt);
 		}
 		break; /* TODO: Catch all the rest here */
 	case TCP_CLOSE_WAIT:
@@ -1358,6 +1673,50 @@ int net_tcp_recv(struct net_context *context, net_context_recv_cb_t cb,
 	return 0;
 }
 
+int net_tcp_set_cc(struct net_context *context, const char *name)
+{
+	struct tcp *conn = context->tcp;
+	const struct tcp_cc *cc;
+
+	if (conn == NULL) {
+		return -EINVAL;
+	}
+
+	cc = tcp_cc_find(name);
+	if (cc == NULL) {
+		return -ENOENT;
+	}
+
+	conn->cc = cc;
+	tcp_cc_setup(conn);
+
+	return 0;
+}
+
+int net_tcp_get_conn_stats(struct net_context *context,
+			   struct net_tcp_conn_stats *stats)
+{
+	struct tcp *conn = context->tcp;
+
+	if (conn == NULL) {
+		return -EINVAL;
+	}
+
+	*stats = conn->stats;
+
+	stats->cc = conn->cc->name;
+	stats->cwnd = conn->cc_data.cwnd;
+	stats->ssthresh = conn->cc_data.ssthresh;
+	stats->snd_wnd = conn->snd_wnd;
+	stats->rcv_wnd = conn->win;
+	stats->mss = tcp_mss(conn);
+	stats->snd_wscale = conn->wscale_ok ? conn->snd_wscale : 0U;
+	stats->rcv_wscale = conn->wscale_ok ? conn->rcv_wscale : 0U;
+	stats->sack = conn->sack_ok;
+
+	return 0;
+}
+
 void net_tcp_init(void)
 {
 	/* nothing to do here */
@@ -1407,6 +1766,17 @@ drop:
 #if defined(CONFIG_NET_TEST_PROTOCOL)
 static sys_slist_t tp_q = SYS_SLIST_STATIC_INIT(&tp_q);
 
+static void tcp_chain_free(struct net_buf *head)
+{
+	struct net_buf *next;
+
+	for ( ; head; head = next) {
+		next = head->frags;
+		head->frags = NULL;
+		tcp_nbuf_unref(head);
+	}
+}
+
 static struct net_buf *tcp_win_pop(struct tcp_win *w, const char *name,
 					size_t len)
 {
@@ -32,6 +32,42 @@ extern "C" {
 #endif
 
 #include <sys/types.h>
+#include <zephyr/types.h>
+#include <stdbool.h>
+
+/** Statistics of a TCP connection */
+struct net_tcp_conn_stats {
+	/** Name of the congestion control algorithm */
+	const char *cc;
+	/** Congestion window, bytes */
+	u32_t cwnd;
+	/** Slow start threshold, bytes */
+	u32_t ssthresh;
+	/** Receive window of the peer, bytes */
+	u32_t snd_wnd;
+	/** Our receive window, bytes */
+	u32_t rcv_wnd;
+	/** Maximum segment size used for sending */
+	u16_t mss;
+	/** Window scale of the peer, 0 if not negotiated */
+	u8_t snd_wscale;
+	/** Our window scale, 0 if not negotiated */
+	u8_t rcv_wscale;
+	/** Selective acknowledgments are negotiated */
+	bool sack;
+	/** Data bytes sent, retransmissions included */
+	u32_t bytes_sent;
+	/** Data bytes acknowledged by the peer */
+	u32_t bytes_acked;
+	/** Data bytes received */
+	u32_t bytes_received;
+	/** Data segments sent */
+	u32_t segs_sent;
+	/** Data segments retransmitted */
+	u32_t retransmits;
+	/** Duplicate ACKs received */
+	u32_t dup_acks;
+};
 
 /**
  * @brief Allocate a TCP connecton for the net_context
@@ -117,6 +153,29 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 
 /* No ops, provided for compatibility with the old TCP */
 
+/**
+ * @brief Select the congestion control algorithm of a TCP connection
+ *
+ * @param context Network context
+ * @param name Name of the algorithm ("newreno", "cubic"), NULL for the
+ *        default one
+ *
+ * @return 0 on success, -ENOENT if there is no such algorithm, -EINVAL
+ *         if the context has no TCP connection
+ */
+int net_tcp_set_cc(struct net_context *context, const char *name);
+
+/**
+ * @brief Get the statistics of a TCP connection
+ *
+ * @param context Network context
+ * @param stats Filled with the statistics of the connection
+ *
+ * @return 0 on success, -EINVAL if the context has no TCP connection
+ */
+int net_tcp_get_conn_stats(struct net_context *context,
+			   struct net_tcp_conn_stats *stats);
+
 void net_tcp_init(void);
 int net_tcp_update_recv_wnd(struct net_context *context, s32_t delta);
 int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt);
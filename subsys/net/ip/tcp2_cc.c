@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <sys/util.h>
+
+#include "tcp2_cc.h"
+
+/* Initial window of RFC 5681 */
+static void tcp_cc_initial_window(struct tcp_cc_data *cc)
+{
+	cc->cwnd = MIN(4U * cc->mss, MAX(2U * cc->mss, 4380U));
+	cc->ssthresh = UINT32_MAX;
+}
+
+static void tcp_cc_slow_start(struct tcp_cc_data *cc, u32_t acked)
+{
+	cc->cwnd += MIN(acked, cc->mss);
+}
+
+/* NewReno, RFC 5681 and RFC 6582 */
+
+static void newreno_init(struct tcp_cc_data *cc)
+{
+	tcp_cc_initial_window(cc);
+}
+
+static void newreno_ack(struct tcp_cc_data *cc, u32_t acked)
+{
+	if (cc->cwnd < cc->ssthresh) {
+		tcp_cc_slow_start(cc, acked);
+		return;
+	}
+
+	cc->cwnd += MAX(1U, (u32_t)cc->mss * cc->mss / cc->cwnd);
+}
+
+static void newreno_loss(struct tcp_cc_data *cc, u32_t flight)
+{
+	cc->ssthresh = MAX(flight / 2U, 2U * cc->mss);
+	cc->cwnd = cc->ssthresh;
+}
+
+static const struct tcp_cc tcp_cc_newreno = {
+	.name = "newreno",
+	.init = newreno_init,
+	.ack = newreno_ack,
+	.loss = newreno_loss,
+};
+
+/* CUBIC, RFC 8312
+ *
+ * W(t) = C * (t - K)^3 + W_max, with C = 0.4 and t in seconds, is computed
+ * with t in msec and W in bytes: W(t) = mss * (t - K)^3 / CUBIC_C_DIV.
+ * The TCP friendly region is not implemented as tcp2 has no RTT estimate.
+ */
+#define CUBIC_C_DIV 2500000000LL
+#define CUBIC_T_MAX 30000LL /* msec, keeps (t - K)^3 * mss in 64 bits */
+
+static u32_t cubic_cbrt(u64_t x)
+{
+	u32_t root = 0U;
+	int bit;
+
+	for (bit = 20; bit >= 0; bit--) {
+		u64_t r = root | BIT(bit);
+
+		if (r * r * r <= x) {
+			root = r;
+		}
+	}
+
+	return root;
+}
+
+static void cubic_init(struct tcp_cc_data *cc)
+{
+	tcp_cc_initial_window(cc);
+
+	memset(&cc->cubic, 0, sizeof(cc->cubic));
+}
+
+static void cubic_ack(struct tcp_cc_data *cc, u32_t acked)
+{
+	struct tcp_cc_cubic *cubic = &cc->cubic;
+	u32_t now = k_uptime_get_32();
+	s64_t t, target;
+
+	if (cc->cwnd < cc->ssthresh) {
+		tcp_cc_slow_start(cc, acked);
+		return;
+	}
+
+	if (cubic->epoch == 0U) {
+		cubic->epoch = now ? now : 1U;
+
+		if (cc->cwnd < cubic->w_max) {
+			u32_t segs = (cubic->w_max - cc->cwnd) / cc->mss;
+
+			cubic->k = cubic_cbrt((u64_t)segs * CUBIC_C_DIV);
+		} else {
+			cubic->k = 0U;
+			cubic->w_max = cc->cwnd;
+		}
+	}
+
+	t = (s64_t)(now - cubic->epoch) - cubic->k;
+	t = MAX(MIN(t, CUBIC_T_MAX), -CUBIC_T_MAX);
+
+	target = (s64_t)cubic->w_max + t * t * t * cc->mss / CUBIC_C_DIV;
+	target = MIN(target, (s64_t)cc->cwnd + cc->cwnd / 2U);
+
+	if (target > cc->cwnd) {
+		cc->cwnd += (target - cc->cwnd) * acked / cc->cwnd;
+	} else {
+		cc->cwnd += MAX(1U, (u32_t)cc->mss * acked / (100U * cc->cwnd));
+	}
+}
+
+static void cubic_loss(struct tcp_cc_data *cc, u32_t flight)
+{
+	struct tcp_cc_cubic *cubic = &cc->cubic;
+
+	ARG_UNUSED(flight);
+
+	/* Fast convergence, release bandwidth to the newer flows */
+	if (cc->cwnd < cubic->w_max) {
+		cubic->w_max = cc->cwnd * 17U / 20U;
+	} else {
+		cubic->w_max = cc->cwnd;
+	}
+
+	cubic->epoch = 0U;
+
+	cc->ssthresh = MAX(cc->cwnd * 7U / 10U, 2U * cc->mss);
+	cc->cwnd = cc->ssthresh;
+}
+
+static const struct tcp_cc tcp_cc_cubic = {
+	.name = "cubic",
+	.init = cubic_init,
+	.ack = cubic_ack,
+	.loss = cubic_loss,
+};
+
+static const struct tcp_cc *const tcp_ccs[] = {
+	&tcp_cc_newreno,
+	&tcp_cc_cubic,
+};
+
+const struct tcp_cc *tcp_cc_find(const char *name)
+{
+	int i;
+
+	if (name == NULL) {
+		return IS_ENABLED(CONFIG_NET_TCP2_CC_CUBIC) ?
+			&tcp_cc_cubic : &tcp_cc_newreno;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(tcp_ccs); i++) {
+		if (strcmp(tcp_ccs[i]->name, name) == 0) {
+			return tcp_ccs[i];
+		}
+	}
+
+	return NULL;
+}
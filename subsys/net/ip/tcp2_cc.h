@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief TCP congestion control algorithms
+ *
+ * An algorithm is a struct tcp_cc of callbacks operating on the
+ * congestion state of one connection. The TCP code calls init() when
+ * the connection is set up, ack() for every acknowledgment of new data
+ * outside of loss recovery, and loss() when it starts a fast retransmit.
+ * New algorithms are added to the table in tcp2_cc.c.
+ */
+
+#ifndef TCP2_CC_H
+#define TCP2_CC_H
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct tcp_cc_cubic {
+	u32_t w_max;	/* Window before the last reduction, bytes */
+	u32_t k;	/* Time to get back to w_max, msec */
+	u32_t epoch;	/* Start of the current epoch, msec, 0 if none */
+};
+
+struct tcp_cc_data { /* Congestion state of a connection */
+	u32_t cwnd;	/* Congestion window, bytes */
+	u32_t ssthresh;	/* Slow start threshold, bytes */
+	u16_t mss;	/* Sender maximum segment size */
+	union {
+		struct tcp_cc_cubic cubic;
+	};
+};
+
+struct tcp_cc {
+	const char *name;
+	/* Set the initial window */
+	void (*init)(struct tcp_cc_data *cc);
+	/* New data has been acknowledged */
+	void (*ack)(struct tcp_cc_data *cc, u32_t acked);
+	/* A segment was lost while flight bytes were outstanding */
+	void (*loss)(struct tcp_cc_data *cc, u32_t flight);
+};
+
+/**
+ * @brief Look up a congestion control algorithm
+ *
+ * @param name Name of the algorithm, NULL for the default one
+ *
+ * @return Algorithm, NULL if there is none with that name
+ */
+const struct tcp_cc *tcp_cc_find(const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TCP2_CC_H */
@@ -5,6 +5,7 @@
  */
 
 #include "tp.h"
+#include "tcp2_cc.h"
 
 #define is(_a, _b) (strcmp((_a), (_b)) == 0)
 #define is_timer_subscribed(_t) (k_timer_remaining_get(_t))
@@ -97,6 +98,11 @@ static struct net_pkt *tcp_pkt_alloc(size_t len)
 #define TCPOPT_NOP	1
 #define TCPOPT_MAXSEG	2
 #define TCPOPT_WINDOW	3
+#define TCPOPT_SACK_PERM	4
+#define TCPOPT_SACK	5
+
+#define TCP_WSCALE_MAX	14 /* RFC 7323, 2.3 */
+#define TCP_DUP_ACKS	3 /* Duplicate ACKs triggering a fast retransmit */
 
 enum pkt_addr {
 	SRC = 1,
@@ -165,9 +171,23 @@ struct tcp { /* TCP connection */
 	u32_t ack;
 	union tcp_endpoint *src;
 	union tcp_endpoint *dst;
-	u16_t win;
+	u32_t win;
 	struct tcp_win *rcv;
 	struct tcp_win *snd;
+	size_t unacked_len; /* Head of snd sent but not acknowledged */
+	u32_t snd_wnd; /* Peer's receive window */
+	u16_t send_mss;
+	u8_t snd_wscale;
+	u8_t rcv_wscale;
+	bool wscale_ok;
+	bool sack_ok;
+	u32_t sack_hole; /* Unacknowledged bytes before the first SACK block */
+	u8_t dup_acks;
+	bool in_recovery;
+	u32_t recover; /* Highest sequence sent when the recovery started */
+	const struct tcp_cc *cc;
+	struct tcp_cc_data cc_data;
+	struct net_tcp_conn_stats stats;
 	struct k_timer send_timer;
 	sys_slist_t send_queue;
 	bool in_retransmission;
@@ -484,6 +484,24 @@ static inline u16_t net_tcp_get_recv_mss(const struct net_tcp *tcp)
 }
 #endif
 
+/**
+ * @brief Returns the TCP payload size of the MTU sized segments a packet
+ * queued for segmentation offload is split into.
+ *
+ * @param tcp TCP context
+ *
+ * @return Segment size, or 0 if it cannot be determined
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+u16_t net_tcp_get_gso_size(const struct net_tcp *tcp);
+#else
+static inline u16_t net_tcp_get_gso_size(const struct net_tcp *tcp)
+{
+	ARG_UNUSED(tcp);
+	return 0;
+}
+#endif
+
 /**
  * @brief Returns the receive window for a given TCP context
  *
@@ -20,6 +20,8 @@ LOG_MODULE_REGISTER(net_utils, CONFIG_NET_UTILS_LOG_LEVEL);
 #include <string.h>
 #include <errno.h>
 
+#include <sys/byteorder.h>
+
 #include <net/net_ip.h>
 #include <net/net_pkt.h>
 #include <net/net_core.h>
@@ -489,32 +491,53 @@ int z_vrfy_net_addr_pton(sa_family_t family, const char *src,
 #include <syscalls/net_addr_pton_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static inline u16_t chksum_add(u16_t sum, u16_t value)
+{
+	sum += value;
+
+	return sum < value ? sum + 1 : sum;
+}
+
+/* The one's complement sum does not depend on the byte order (RFC 1071),
+ * so the data is summed a native 32-bit word at a time, and the result
+ * is only swapped to the big endian interpretation of the 16-bit words
+ * that the callers use at the end.
+ */
 static u16_t calc_chksum(u16_t sum, const u8_t *data, size_t len)
 {
-	const u8_t *end;
-	u16_t tmp;
+	u64_t acc = 0U;
 
-	end = data + len - 1;
+	while (len >= 16U) {
+		acc += UNALIGNED_GET((u32_t *)data);
+		acc += UNALIGNED_GET((u32_t *)(data + 4));
+		acc += UNALIGNED_GET((u32_t *)(data + 8));
+		acc += UNALIGNED_GET((u32_t *)(data + 12));
+		data += 16;
+		len -= 16U;
+	}
 
-	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	while (len >= 4U) {
+		acc += UNALIGNED_GET((u32_t *)data);
+		data += 4;
+		len -= 4U;
+	}
 
+	if (len >= 2U) {
+		acc += UNALIGNED_GET((u16_t *)data);
 		data += 2;
+		len -= 2U;
 	}
 
-	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	/* A trailing byte is the first one of a zero padded word */
+	if (len) {
+		acc += sys_be16_to_cpu(data[0] << 8);
 	}
 
-	return sum;
+	while (acc >> 16) {
+		acc = (acc & 0xffff) + (acc >> 16);
+	}
+
+	return chksum_add(sum, sys_be16_to_cpu((u16_t)acc));
 }
 
 static inline u16_t pkt_calc_chksum(struct net_pkt *pkt, u16_t sum)
@@ -539,10 +562,7 @@ static inline u16_t pkt_calc_chksum(struct net_pkt *pkt, u16_t sum)
 		cur->pos = cur->buf->data;
 
 		if (len % 2) {
-			sum += *cur->pos;
-			if (sum < *cur->pos) {
-				sum++;
-			}
+			sum = chksum_add(sum, *cur->pos);
 
 			cur->pos++;
 			len = cur->buf->len - 1;
@@ -602,6 +622,18 @@ u16_t net_calc_chksum(struct net_pkt *pkt, u8_t proto)
 	return ~sum;
 }
 
+u16_t net_calc_chksum_update(u16_t chksum, const void *old, const void *new,
+			     size_t len)
+{
+	u16_t sum;
+
+	/* RFC 1624, HC' = ~(~HC + ~m + m') */
+	sum = chksum_add(~ntohs(chksum), ~calc_chksum(0, old, len));
+	sum = calc_chksum(sum, new, len);
+
+	return htons(~sum);
+}
+
 #if defined(CONFIG_NET_IPV4)
 u16_t net_calc_chksum_ipv4(struct net_pkt *pkt)
 {
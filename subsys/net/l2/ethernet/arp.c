@@ -28,20 +28,40 @@ static struct arp_entry arp_entries[CONFIG_NET_ARP_TABLE_SIZE];
 
 static sys_slist_t arp_free_entries;
 static sys_slist_t arp_pending_entries;
-static sys_slist_t arp_table;
+
+/* Resolved entries, hashed on their IPv4 address */
+static sys_slist_t arp_table[CONFIG_NET_ARP_HASH_SIZE];
 
 struct k_delayed_work arp_request_timer;
 
+static inline sys_slist_t *arp_table_bucket(struct in_addr *addr)
+{
+	u32_t hash = (u32_t)addr->s4_addr[0] << 24 | addr->s4_addr[1] << 16 |
+		     addr->s4_addr[2] << 8 | addr->s4_addr[3];
+
+	/* Hosts of a subnet only differ in the last bytes */
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return &arp_table[hash % CONFIG_NET_ARP_HASH_SIZE];
+}
+
 static void arp_entry_cleanup(struct arp_entry *entry, bool pending)
 {
+	int i;
+
 	NET_DBG("%p", entry);
 
-	if (pending) {
+	for (i = 0; pending && i < CONFIG_NET_ARP_PENDING_COUNT; i++) {
+		if (!entry->pending[i]) {
+			continue;
+		}
+
 		NET_DBG("Releasing pending pkt %p (ref %d)",
-			entry->pending,
-			atomic_get(&entry->pending->atomic_ref) - 1);
-		net_pkt_unref(entry->pending);
-		entry->pending = NULL;
+			entry->pending[i],
+			atomic_get(&entry->pending[i]->atomic_ref) - 1);
+		net_pkt_unref(entry->pending[i]);
+		entry->pending[i] = NULL;
 	}
 
 	entry->iface = NULL;
@@ -74,30 +94,31 @@ static struct arp_entry *arp_entry_find(sys_slist_t *list,
 	return NULL;
 }
 
-static inline struct arp_entry *arp_entry_find_move_first(struct net_if *iface,
-							  struct in_addr *dst)
+static inline struct arp_entry *arp_entry_find_used(struct net_if *iface,
+						    struct in_addr *dst)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(dst)));
 
-	entry = arp_entry_find(&arp_table, iface, dst, &prev);
+	entry = arp_entry_find(arp_table_bucket(dst), iface, dst, NULL);
 	if (entry) {
-		/* Let's assume the target is going to be accessed
-		 * more than once here in a short time frame. So we
-		 * place the entry first in position into the table
-		 * in order to reduce subsequent find.
+		/* The least recently used entry is the one replaced when
+		 * the cache is full.
 		 */
-		if (&entry->node != sys_slist_peek_head(&arp_table)) {
-			sys_slist_remove(&arp_table, prev, &entry->node);
-			sys_slist_prepend(&arp_table, &entry->node);
-		}
+		entry->last_used = k_uptime_get_32();
 	}
 
 	return entry;
 }
 
+static void arp_entry_table_add(struct arp_entry *entry)
+{
+	entry->last_used = k_uptime_get_32();
+
+	sys_slist_prepend(arp_table_bucket(&entry->ip), &entry->node);
+}
+
 static inline
 struct arp_entry *arp_entry_find_pending(struct net_if *iface,
 					 struct in_addr *dst)
@@ -145,23 +166,45 @@ static struct arp_entry *arp_entry_get_free(void)
 
 static struct arp_entry *arp_entry_get_last_from_table(void)
 {
-	sys_snode_t *node;
+	struct arp_entry *entry, *oldest = NULL;
+	u32_t current = k_uptime_get_32();
+	int i;
 
-	/* We assume last entry is the oldest one,
-	 * so is the preferred one to be taken out.
-	 */
+	for (i = 0; i < ARRAY_SIZE(arp_table); i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&arp_table[i], entry, node) {
+			if (!oldest || (current - entry->last_used >
+					current - oldest->last_used)) {
+				oldest = entry;
+			}
+		}
+	}
 
-	node = sys_slist_peek_tail(&arp_table);
-	if (!node) {
+	if (!oldest) {
 		return NULL;
 	}
 
-	sys_slist_find_and_remove(&arp_table, node);
+	sys_slist_find_and_remove(arp_table_bucket(&oldest->ip),
+				  &oldest->node);
 
-	return CONTAINER_OF(node, struct arp_entry, node);
+	return oldest;
 }
 
 
+static void arp_entry_queue_pending(struct arp_entry *entry,
+				    struct net_pkt *pkt)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_NET_ARP_PENDING_COUNT; i++) {
+		if (!entry->pending[i]) {
+			entry->pending[i] = net_pkt_ref(pkt);
+			return;
+		}
+	}
+
+	NET_DBG("No room for pending pkt %p", pkt);
+}
+
 static void arp_entry_register_pending(struct arp_entry *entry)
 {
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(&entry->ip)));
@@ -266,7 +309,8 @@ static inline struct net_pkt *arp_prepare(struct net_if *iface,
 	 * request and we want to send it again.
 	 */
 	if (entry) {
-		entry->pending = net_pkt_ref(pending);
+		(void)memset(entry->pending, 0, sizeof(entry->pending));
+		entry->pending[0] = net_pkt_ref(pending);
 		entry->iface = net_pkt_iface(pkt);
 
 		net_ipaddr_copy(&entry->ip, next_addr);
@@ -349,7 +393,7 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 	/* If the destination address is already known, we do not need
 	 * to send any ARP packet.
 	 */
-	entry = arp_entry_find_move_first(net_pkt_iface(pkt), addr);
+	entry = arp_entry_find_used(net_pkt_iface(pkt), addr);
 	if (!entry) {
 		struct net_pkt *req;
 
@@ -362,7 +406,13 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 				entry = arp_entry_get_last_from_table();
 			}
 		} else {
-			/* There is a pending already */
+			/* There is a pending already, the packet is sent
+			 * too when the reply arrives.
+			 */
+			if (!current_ip) {
+				arp_entry_queue_pending(entry, pkt);
+			}
+
 			entry = NULL;
 		}
 
@@ -370,9 +420,8 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 				  current_ip);
 
 		if (!entry) {
-			/* We cannot send the packet, the ARP cache is full
-			 * or there is already a pending query to this IP
-			 * address, so this packet must be discarded.
+			/* The ARP cache is full or there is already a
+			 * pending query to this IP address.
 			 */
 			NET_DBG("Resending ARP %p", req);
 		}
@@ -399,10 +448,9 @@ static void arp_gratuitous(struct net_if *iface,
 			   struct in_addr *src,
 			   struct net_eth_addr *hwaddr)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
-	entry = arp_entry_find(&arp_table, iface, src, &prev);
+	entry = arp_entry_find(arp_table_bucket(src), iface, src, NULL);
 	if (entry) {
 		NET_DBG("Gratuitous ARP hwaddr %s -> %s",
 			log_strdup(net_sprint_ll_addr(
@@ -422,8 +470,9 @@ static void arp_update(struct net_if *iface,
 		       bool gratuitous,
 		       bool force)
 {
+	struct net_pkt *pending[CONFIG_NET_ARP_PENDING_COUNT];
 	struct arp_entry *entry;
-	struct net_pkt *pkt;
+	int i;
 
 	NET_DBG("src %s", log_strdup(net_sprint_ipv4_addr(src)));
 
@@ -434,10 +483,10 @@ static void arp_update(struct net_if *iface,
 		}
 
 		if (force) {
-			sys_snode_t *prev = NULL;
 			struct arp_entry *entry;
 
-			entry = arp_entry_find(&arp_table, iface, src, &prev);
+			entry = arp_entry_find(arp_table_bucket(src), iface,
+					       src, NULL);
 			if (entry) {
 				memcpy(&entry->eth, hwaddr,
 				       sizeof(struct net_eth_addr));
@@ -456,7 +505,7 @@ static void arp_update(struct net_if *iface,
 					entry->iface = iface;
 					net_ipaddr_copy(&entry->ip, src);
 					memcpy(&entry->eth, hwaddr, sizeof(entry->eth));
-					sys_slist_prepend(&arp_table, &entry->node);
+					arp_entry_table_add(entry);
 				}
 			}
 		}
@@ -464,24 +513,27 @@ static void arp_update(struct net_if *iface,
 		return;
 	}
 
-	/* Set the dst in the pending packet */
-	net_pkt_lladdr_dst(entry->pending)->len = sizeof(struct net_eth_addr);
-	net_pkt_lladdr_dst(entry->pending)->addr =
-		(u8_t *) &NET_ETH_HDR(entry->pending)->dst.addr;
-
-	NET_DBG("dst %s pending %p frag %p",
-		log_strdup(net_sprint_ipv4_addr(&entry->ip)),
-		entry->pending, entry->pending->frags);
-
-	pkt = entry->pending;
-	entry->pending = NULL;
+	/* The pending packets share their memory with the hw address */
+	memcpy(pending, entry->pending, sizeof(pending));
 
 	memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
 
 	/* Inserting entry into the table */
-	sys_slist_prepend(&arp_table, &entry->node);
+	arp_entry_table_add(entry);
 
-	net_if_queue_tx(iface, pkt);
+	for (i = 0; i < CONFIG_NET_ARP_PENDING_COUNT && pending[i]; i++) {
+		/* Set the dst in the pending packet */
+		net_pkt_lladdr_dst(pending[i])->len =
+			sizeof(struct net_eth_addr);
+		net_pkt_lladdr_dst(pending[i])->addr =
+			(u8_t *) &NET_ETH_HDR(pending[i])->dst.addr;
+
+		NET_DBG("dst %s pending %p frag %p",
+			log_strdup(net_sprint_ipv4_addr(&entry->ip)),
+			pending[i], pending[i]->frags);
+
+		net_if_queue_tx(iface, pending[i]);
+	}
 }
 
 static inline struct net_pkt *arp_prepare_reply(struct net_if *iface,
@@ -669,21 +721,27 @@ enum net_verdict net_arp_input(struct net_pkt *pkt,
 
 void net_arp_clear_cache(struct net_if *iface)
 {
-	sys_snode_t *prev = NULL;
+	sys_snode_t *prev;
 	struct arp_entry *entry, *next;
+	int i;
 
 	NET_DBG("Flushing ARP table");
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_table, entry, next, node) {
-		if (iface && iface != entry->iface) {
-			prev = &entry->node;
-			continue;
-		}
+	for (i = 0; i < ARRAY_SIZE(arp_table); i++) {
+		prev = NULL;
+
+		SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_table[i], entry, next,
+						  node) {
+			if (iface && iface != entry->iface) {
+				prev = &entry->node;
+				continue;
+			}
 
-		arp_entry_cleanup(entry, false);
+			arp_entry_cleanup(entry, false);
 
-		sys_slist_remove(&arp_table, prev, &entry->node);
-		sys_slist_prepend(&arp_free_entries, &entry->node);
+			sys_slist_remove(&arp_table[i], prev, &entry->node);
+			sys_slist_prepend(&arp_free_entries, &entry->node);
+		}
 	}
 
 	prev = NULL;
@@ -712,10 +770,13 @@ int net_arp_foreach(net_arp_cb_t cb, void *user_data)
 {
 	int ret = 0;
 	struct arp_entry *entry;
+	int i;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&arp_table, entry, node) {
-		ret++;
-		cb(entry, user_data);
+	for (i = 0; i < ARRAY_SIZE(arp_table); i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&arp_table[i], entry, node) {
+			ret++;
+			cb(entry, user_data);
+		}
 	}
 
 	return ret;
@@ -731,7 +792,10 @@ void net_arp_init(void)
 
 	sys_slist_init(&arp_free_entries);
 	sys_slist_init(&arp_pending_entries);
-	sys_slist_init(&arp_table);
+
+	for (i = 0; i < ARRAY_SIZE(arp_table); i++) {
+		sys_slist_init(&arp_table[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_ARP_TABLE_SIZE; i++) {
 		/* Inserting entry as free */
@@ -52,10 +52,11 @@ enum net_verdict net_arp_input(struct net_pkt *pkt,
 struct arp_entry {
 	sys_snode_t node;
 	u32_t req_start;
+	u32_t last_used;
 	struct net_if *iface;
 	struct in_addr ip;
 	union {
-		struct net_pkt *pending;
+		struct net_pkt *pending[CONFIG_NET_ARP_PENDING_COUNT];
 		struct net_eth_addr eth;
 	};
 };
@@ -976,6 +976,84 @@ void net_eth_carrier_off(struct net_if *iface)
 	handle_carrier(ctx, iface, carrier_off);
 }
 
+#if defined(CONFIG_NET_ETHERNET_RX_POLL)
+K_THREAD_STACK_DEFINE(rx_poll_stack, CONFIG_NET_ETHERNET_RX_POLL_STACK_SIZE);
+static struct k_work_q rx_poll_work_q;
+
+static void rx_poll_handler(struct k_work *work)
+{
+	struct ethernet_context *ctx = CONTAINER_OF(work,
+						    struct ethernet_context,
+						    rx_poll.work);
+	struct device *dev = net_if_get_device(ctx->rx_poll.iface);
+	const struct ethernet_api *api = dev->driver_api;
+	int budget = ctx->rx_poll.budget;
+
+	if (api->rx_poll(dev, budget) < budget) {
+		api->rx_irq_enable(dev, true);
+		return;
+	}
+
+	/* More frames are pending, let the other interfaces and the
+	 * threads of the same priority run before polling again.
+	 */
+	k_work_submit_to_queue(&rx_poll_work_q, work);
+	k_yield();
+}
+
+void net_eth_rx_schedule(struct net_if *iface)
+{
+	struct ethernet_context *ctx = net_if_l2_data(iface);
+	struct device *dev = net_if_get_device(iface);
+	const struct ethernet_api *api = dev->driver_api;
+
+	api->rx_irq_enable(dev, false);
+
+	k_work_submit_to_queue(&rx_poll_work_q, &ctx->rx_poll.work);
+}
+
+int net_eth_set_rx_poll_budget(struct net_if *iface, int budget)
+{
+	struct ethernet_context *ctx;
+
+	if (budget <= 0 ||
+	    net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return -EINVAL;
+	}
+
+	ctx = net_if_l2_data(iface);
+	ctx->rx_poll.budget = budget;
+
+	return 0;
+}
+
+static void rx_poll_init(struct ethernet_context *ctx, struct net_if *iface)
+{
+	static bool work_q_started;
+
+	if (!work_q_started) {
+		k_work_q_start(&rx_poll_work_q, rx_poll_stack,
+			       K_THREAD_STACK_SIZEOF(rx_poll_stack),
+			       K_PRIO_PREEMPT(
+				       CONFIG_NET_ETHERNET_RX_POLL_PRIORITY));
+		k_thread_name_set(&rx_poll_work_q.thread, "eth_rx_poll");
+
+		work_q_started = true;
+	}
+
+	/* Virtual LAN interfaces share the context of the main one */
+	if (ctx->is_init) {
+		return;
+	}
+
+	k_work_init(&ctx->rx_poll.work, rx_poll_handler);
+	ctx->rx_poll.iface = iface;
+	ctx->rx_poll.budget = CONFIG_NET_ETHERNET_RX_POLL_BUDGET;
+}
+#else
+#define rx_poll_init(...)
+#endif /* CONFIG_NET_ETHERNET_RX_POLL */
+
 #if defined(CONFIG_PTP_CLOCK)
 struct device *net_eth_get_ptp_clock(struct net_if *iface)
 {
@@ -1073,6 +1151,8 @@ void ethernet_init(struct net_if *iface)
 		ctx->ethernet_l2_flags |= NET_L2_PROMISC_MODE;
 	}
 
+	rx_poll_init(ctx, iface);
+
 #if defined(CONFIG_NET_VLAN)
 	if (!(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_VLAN)) {
 		return;
@@ -679,6 +679,103 @@ static void gptp_mi_clk_slave_sync_compute(void)
 }
 
 #if defined(CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE)
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+/* Largest frequency correction of the servo, in ppb */
+#define GPTP_SERVO_MAX_PPB 200000.0
+
+static inline double gptp_servo_clamp(double ppb)
+{
+	if (ppb > GPTP_SERVO_MAX_PPB) {
+		return GPTP_SERVO_MAX_PPB;
+	} else if (ppb < -GPTP_SERVO_MAX_PPB) {
+		return -GPTP_SERVO_MAX_PPB;
+	}
+
+	return ppb;
+}
+
+static void gptp_servo_reset(struct gptp_clk_slave_sync_state *state)
+{
+	state->servo_locked = false;
+	state->servo_drift = 0.0;
+	state->servo_freq = 0.0;
+}
+
+/* Returns false when the clock is to be stepped instead */
+static bool gptp_servo_update(struct gptp_clk_slave_sync_state *state,
+			      struct device *clk, double neighbor_rate_ratio,
+			      s64_t offset)
+{
+	u64_t now = GPTP_GLOBAL_DS()->sync_receipt_local_time;
+	double interval, freq;
+	s64_t change;
+
+	if (offset < -5000 || offset > 5000) {
+		gptp_servo_reset(state);
+		return false;
+	}
+
+	if (!state->servo_locked) {
+		/* Start from the frequency of the neighbor, the drift
+		 * left is tracked by the integral term.
+		 */
+		ptp_clock_rate_adjust(clk, neighbor_rate_ratio);
+
+		state->servo_locked = true;
+		state->servo_last_sync = now;
+		state->servo_offset = offset;
+		state->servo_offset_max = 0;
+		state->servo_jitter = 0;
+
+		return true;
+	}
+
+	if (now <= state->servo_last_sync) {
+		return true;
+	}
+
+	interval = (double)(now - state->servo_last_sync) / NSEC_PER_SEC;
+	state->servo_last_sync = now;
+
+	change = offset - state->servo_offset;
+	if (change < 0) {
+		change = -change;
+	}
+
+	state->servo_jitter += (change - state->servo_jitter) / 16;
+	state->servo_offset = offset;
+
+	if (offset > state->servo_offset_max) {
+		state->servo_offset_max = offset;
+	} else if (-offset > state->servo_offset_max) {
+		state->servo_offset_max = -offset;
+	}
+
+	/* An offset of n ns is corrected in the next interval with a
+	 * correction of n / interval ppb.
+	 */
+	state->servo_drift = gptp_servo_clamp(state->servo_drift +
+		CONFIG_NET_GPTP_SERVO_KI * offset / (interval * 1000.0));
+
+	freq = gptp_servo_clamp(state->servo_drift +
+		CONFIG_NET_GPTP_SERVO_KP * offset / (interval * 1000.0));
+
+	NET_DBG("offset %d ns jitter %d ns freq %d ppb", (int)offset,
+		(int)state->servo_jitter, (int)freq);
+
+	/* The rate adjustment is relative to the current rate */
+	if (ptp_clock_rate_adjust(clk, (1.0 + freq / NSEC_PER_SEC) /
+				  (1.0 + state->servo_freq / NSEC_PER_SEC)) < 0) {
+		/* The clock can only be stepped */
+		ptp_clock_adjust(clk, MAX(-200, MIN(offset, 200)));
+	} else {
+		state->servo_freq = freq;
+	}
+
+	return true;
+}
+#endif /* CONFIG_NET_GPTP_SERVO_PI */
+
 static void gptp_update_local_port_clock(void)
 {
 	struct gptp_clk_slave_sync_state *state;
@@ -689,6 +786,7 @@ static void gptp_update_local_port_clock(void)
 	s64_t second_diff;
 	struct device *clk;
 	struct net_ptp_time tm;
+	bool rate_ratio_valid;
 	int key;
 
 	state = &GPTP_STATE()->clk_slave_sync;
@@ -698,12 +796,22 @@ static void gptp_update_local_port_clock(void)
 
 	port_ds = GPTP_PORT_DS(port);
 
-	/* Check if the last neighbor rate ratio can still be used */
-	if (!port_ds->neighbor_rate_ratio_valid) {
+	/* Check if the last neighbor rate ratio can still be used. Once
+	 * locked the servo does not need it, the clock is updated on
+	 * each Sync.
+	 */
+	rate_ratio_valid = port_ds->neighbor_rate_ratio_valid;
+	port_ds->neighbor_rate_ratio_valid = false;
+
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+	if (!rate_ratio_valid && !state->servo_locked) {
 		return;
 	}
-
-	port_ds->neighbor_rate_ratio_valid = false;
+#else
+	if (!rate_ratio_valid) {
+		return;
+	}
+#endif
 
 	second_diff = global_ds->sync_receipt_time.second -
 		(global_ds->sync_receipt_local_time / NSEC_PER_SEC);
@@ -726,6 +834,25 @@ static void gptp_update_local_port_clock(void)
 		nanosecond_diff = -NSEC_PER_SEC + nanosecond_diff;
 	}
 
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+	if (second_diff == 0 &&
+	    gptp_servo_update(state, clk, port_ds->neighbor_rate_ratio,
+			      nanosecond_diff)) {
+		return;
+	}
+
+	if (second_diff) {
+		gptp_servo_reset(state);
+	}
+
+	/* The clock is stepped below, the servo is back in control once
+	 * it is close enough to the master.
+	 */
+	if (!rate_ratio_valid) {
+		return;
+	}
+#endif
+
 	ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio);
 
 	/* If time difference is too high, set the clock value.
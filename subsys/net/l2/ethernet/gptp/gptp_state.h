@@ -379,6 +379,29 @@ struct gptp_clk_slave_sync_state {
 
 	/** The local clock has expired. */
 	bool rcvd_local_clk_tick;
+
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+	/** Frequency drift estimated by the servo, in ppb. */
+	double servo_drift;
+
+	/** Frequency correction applied to the local clock, in ppb. */
+	double servo_freq;
+
+	/** Local time of the last Sync used by the servo, in ns. */
+	u64_t servo_last_sync;
+
+	/** Last offset from the master, in ns. */
+	s64_t servo_offset;
+
+	/** Largest absolute offset since the servo locked, in ns. */
+	s64_t servo_offset_max;
+
+	/** Average change of the offset between two Syncs, in ns. */
+	s64_t servo_jitter;
+
+	/** The servo corrects the offset, the clock is no longer stepped. */
+	bool servo_locked;
+#endif
 };
 
 /* ClockMasterSyncOffset state machine variables. */
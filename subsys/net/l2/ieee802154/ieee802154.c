@@ -28,6 +28,82 @@ LOG_MODULE_REGISTER(net_ieee802154, CONFIG_NET_L2_IEEE802154_LOG_LEVEL);
 
 #define BUF_TIMEOUT K_MSEC(50)
 
+#if defined(CONFIG_NET_L2_IEEE802154_TX_QUEUE)
+struct tx_frame_info {
+	struct net_if *iface;
+	struct net_pkt *pkt;
+	bool last;
+};
+
+/* No need to hold space for the FCS */
+NET_BUF_POOL_DEFINE(tx_frame_pool, CONFIG_NET_L2_IEEE802154_TX_QUEUE_DEPTH,
+		    IEEE802154_MTU - 2, sizeof(struct tx_frame_info), NULL);
+
+static K_FIFO_DEFINE(tx_queue);
+
+static struct net_buf *frame_get(void)
+{
+	/* Frames are always released by the TX thread */
+	return net_buf_alloc(&tx_frame_pool, K_FOREVER);
+}
+
+static void frame_release(struct net_buf *frame)
+{
+	net_buf_unref(frame);
+}
+
+/* Each frame holds a reference on its packet, which the radio drivers
+ * get along with the frame.
+ */
+static int frame_send(struct net_if *iface, struct net_pkt *pkt,
+		      struct net_buf *frame, bool last)
+{
+	struct tx_frame_info *info = net_buf_user_data(frame);
+
+	info->iface = iface;
+	info->pkt = net_pkt_ref(pkt);
+	info->last = last;
+
+	net_buf_put(&tx_queue, frame);
+
+	return 0;
+}
+
+static void tx_thread(void)
+{
+	struct net_pkt *failed = NULL;
+	struct tx_frame_info *info;
+	struct net_buf *frame;
+	int ret;
+
+	while (1) {
+		frame = net_buf_get(&tx_queue, K_FOREVER);
+		info = net_buf_user_data(frame);
+
+		/* The other fragments are useless once one is lost */
+		if (info->pkt != failed) {
+			ret = ieee802154_radio_send(info->iface, info->pkt,
+						    frame);
+			if (ret) {
+				NET_DBG("pkt %p frame %p not sent (%d)",
+					info->pkt, frame, ret);
+				failed = info->pkt;
+			}
+		}
+
+		if (info->last && info->pkt == failed) {
+			failed = NULL;
+		}
+
+		net_pkt_unref(info->pkt);
+		net_buf_unref(frame);
+	}
+}
+
+K_THREAD_DEFINE(ieee802154_tx, CONFIG_NET_L2_IEEE802154_TX_STACK_SIZE,
+		(k_thread_entry_t)tx_thread, NULL, NULL, NULL,
+		K_PRIO_COOP(CONFIG_NET_L2_IEEE802154_TX_PRIORITY), 0, K_NO_WAIT);
+#else
 /* No need to hold space for the FCS */
 static u8_t frame_buffer_data[IEEE802154_MTU - 2];
 
@@ -38,6 +114,22 @@ static struct net_buf frame_buf = {
 	.__buf = frame_buffer_data,
 };
 
+static struct net_buf *frame_get(void)
+{
+	frame_buf.len = 0U;
+
+	return &frame_buf;
+}
+
+#define frame_release(...)
+
+static int frame_send(struct net_if *iface, struct net_pkt *pkt,
+		      struct net_buf *frame, bool last)
+{
+	return ieee802154_radio_send(iface, pkt, frame);
+}
+#endif /* CONFIG_NET_L2_IEEE802154_TX_QUEUE */
+
 #define PKT_TITLE      "IEEE 802.15.4 packet content:"
 #define TX_PKT_TITLE   "> " PKT_TITLE
 #define RX_PKT_TITLE   "< " PKT_TITLE
@@ -228,6 +320,7 @@ static int ieee802154_send(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct ieee802154_context *ctx = net_if_l2_data(iface);
 	struct ieee802154_fragment_ctx f_ctx;
+	struct net_buf *frame;
 	struct net_buf *buf;
 	u8_t ll_hdr_size;
 	bool fragment;
@@ -250,45 +343,36 @@ static int ieee802154_send(struct net_if *iface, struct net_pkt *pkt)
 	ieee802154_fragment_ctx_init(&f_ctx, pkt, len, true);
 
 	len = 0;
-	frame_buf.len = 0U;
 	buf = pkt->buffer;
 
 	while (buf) {
 		int ret;
 
-		net_buf_add(&frame_buf, ll_hdr_size);
+		frame = frame_get();
+
+		net_buf_add(frame, ll_hdr_size);
 
 		if (fragment) {
-			ieee802154_fragment(&f_ctx, &frame_buf, true);
+			ieee802154_fragment(&f_ctx, frame, true);
 			buf = f_ctx.buf;
 		} else {
-			memcpy(frame_buf.data + frame_buf.len,
-			       buf->data, buf->len);
-			net_buf_add(&frame_buf, buf->len);
+			memcpy(frame->data + frame->len, buf->data, buf->len);
+			net_buf_add(frame, buf->len);
 			buf = buf->frags;
 		}
 
 		if (!ieee802154_create_data_frame(ctx, net_pkt_lladdr_dst(pkt),
-						  &frame_buf, ll_hdr_size)) {
+						  frame, ll_hdr_size)) {
+			frame_release(frame);
 			return -EINVAL;
 		}
 
-		if (IS_ENABLED(CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA) &&
-		    ieee802154_get_hw_capabilities(iface) &
-		    IEEE802154_HW_CSMA) {
-			ret = ieee802154_tx(iface, pkt, &frame_buf);
-		} else {
-			ret = ieee802154_radio_send(iface, pkt, &frame_buf);
-		}
+		len += frame->len;
 
+		ret = frame_send(iface, pkt, frame, buf == NULL);
 		if (ret) {
 			return ret;
 		}
-
-		len += frame_buf.len;
-
-		/* Reinitializing frame_buf */
-		frame_buf.len = 0U;
 	}
 
 	net_pkt_unref(pkt);
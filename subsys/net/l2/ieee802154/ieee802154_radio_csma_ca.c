@@ -28,6 +28,8 @@ static inline int csma_ca_radio_send(struct net_if *iface,
 	u8_t retries = CONFIG_NET_L2_IEEE802154_RADIO_TX_RETRIES;
 	struct ieee802154_context *ctx = net_if_l2_data(iface);
 	bool ack_required = prepare_for_ack(ctx, pkt, frag);
+	bool hw_csma = ieee802154_get_hw_capabilities(iface) &
+		IEEE802154_HW_CSMA;
 	u8_t be = CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA_MIN_BE;
 	u8_t nb = 0U;
 	int ret = -EIO;
@@ -38,13 +40,16 @@ loop:
 	while (retries) {
 		retries--;
 
-		if (be) {
+		/* The radio runs the backoffs and the CCA itself, only the
+		 * retries are left to us.
+		 */
+		if (!hw_csma && be) {
 			u8_t bo_n = sys_rand32_get() & ((1 << be) - 1);
 
 			k_busy_wait(bo_n * 20U);
 		}
 
-		while (1) {
+		while (!hw_csma) {
 			if (!ieee802154_cca(iface)) {
 				break;
 			}
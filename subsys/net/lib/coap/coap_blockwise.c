@@ -0,0 +1,399 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_coap, CONFIG_COAP_LOG_LEVEL);
+
+#include <string.h>
+#include <errno.h>
+#include <kernel.h>
+
+#include <net/coap.h>
+#include <net/coap_blockwise.h>
+
+#define GET_BLOCK_SIZE(v) (((v) & 0x7))
+#define GET_MORE(v) (!!((v) & 0x08))
+#define GET_NUM(v) ((v) >> 4)
+
+#define SET_BLOCK_SIZE(v, b) (v |= ((b) & 0x07))
+#define SET_NUM(v, n) ((v) |= ((n) << 4))
+
+#define BLOCK_NUM_UNKNOWN UINT32_MAX
+
+/* Time to wait for a separate response after an empty ACK, the span of
+ * all the retransmissions.
+ */
+#define SEPARATE_RESPONSE_TIMEOUT (CONFIG_COAP_INIT_ACK_TIMEOUT_MS * 15)
+
+enum {
+	SLOT_FREE,
+	SLOT_SENT,
+	SLOT_RECEIVED,
+};
+
+static void blockwise_stop(struct coap_blockwise *bw)
+{
+	int i;
+
+	bw->active = false;
+
+	for (i = 0; i < ARRAY_SIZE(bw->slots); i++) {
+		bw->slots[i].state = SLOT_FREE;
+	}
+}
+
+static void blockwise_fail(struct coap_blockwise *bw, int status)
+{
+	NET_DBG("Block-wise transfer failed (%d)", status);
+
+	blockwise_stop(bw);
+
+	bw->cb(bw, status, 0, NULL, 0, true);
+}
+
+static int get_option_int(const struct coap_packet *cpkt, u16_t code)
+{
+	struct coap_option option;
+
+	if (coap_find_options(cpkt, code, &option, 1) <= 0) {
+		return -ENOENT;
+	}
+
+	return coap_option_value_to_int(&option);
+}
+
+static int blockwise_send(struct coap_blockwise *bw,
+			  struct coap_blockwise_slot *slot, u32_t num)
+{
+	struct coap_packet request;
+	unsigned int val = 0U;
+	int i, r;
+
+	r = coap_packet_init(&request, slot->request, sizeof(slot->request),
+			     1, COAP_TYPE_CON, sizeof(slot->token),
+			     coap_next_token(), COAP_METHOD_GET,
+			     coap_next_id());
+	if (r < 0) {
+		return r;
+	}
+
+	for (i = 0; bw->path && bw->path[i]; i++) {
+		r = coap_packet_append_option(&request, COAP_OPTION_URI_PATH,
+					      (const u8_t *)bw->path[i],
+					      strlen(bw->path[i]));
+		if (r < 0) {
+			return r;
+		}
+	}
+
+	SET_BLOCK_SIZE(val, bw->block_size);
+	SET_NUM(val, num);
+
+	r = coap_append_option_int(&request, COAP_OPTION_BLOCK2, val);
+	if (r < 0) {
+		return r;
+	}
+
+	(void)coap_header_get_token(&request, slot->token);
+
+	coap_pending_init(&slot->pending, &request, &bw->addr);
+	coap_pending_cycle(&slot->pending);
+
+	slot->num = num;
+	slot->acked = 0U;
+	slot->state = SLOT_SENT;
+	slot->deadline = k_uptime_get() + slot->pending.timeout;
+
+	return bw->send(bw, slot->pending.data, slot->pending.len);
+}
+
+/* Keep up to NSTART requests in flight once the block size is known */
+static void blockwise_fill(struct coap_blockwise *bw)
+{
+	int i, r;
+
+	if (bw->deliver_num == 0U) {
+		return;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(bw->slots) && bw->active; i++) {
+		if (bw->slots[i].state != SLOT_FREE) {
+			continue;
+		}
+
+		if (bw->last_num != BLOCK_NUM_UNKNOWN &&
+		    bw->next_num > bw->last_num) {
+			break;
+		}
+
+		r = blockwise_send(bw, &bw->slots[i], bw->next_num++);
+		if (r < 0) {
+			blockwise_fail(bw, r);
+		}
+	}
+}
+
+static void blockwise_set_last(struct coap_blockwise *bw, u32_t last_num)
+{
+	int i;
+
+	bw->last_num = last_num;
+
+	/* Requests past the end are not answered with content */
+	for (i = 0; i < ARRAY_SIZE(bw->slots); i++) {
+		if (bw->slots[i].num > last_num) {
+			bw->slots[i].state = SLOT_FREE;
+		}
+	}
+}
+
+static void blockwise_deliver(struct coap_blockwise *bw)
+{
+	u16_t bytes = coap_block_size_to_bytes(bw->block_size);
+	struct coap_blockwise_slot *slot;
+	bool last;
+	int i;
+
+	while (bw->active) {
+		slot = NULL;
+
+		for (i = 0; i < ARRAY_SIZE(bw->slots); i++) {
+			if (bw->slots[i].state == SLOT_RECEIVED &&
+			    bw->slots[i].num == bw->deliver_num) {
+				slot = &bw->slots[i];
+				break;
+			}
+		}
+
+		if (slot == NULL) {
+			break;
+		}
+
+		if (slot->code != COAP_RESPONSE_CODE_CONTENT) {
+			blockwise_fail(bw, slot->code);
+			break;
+		}
+
+		last = slot->num == bw->last_num;
+
+		/* The slot is not reused before the callback returns */
+		slot->state = SLOT_FREE;
+		bw->deliver_num++;
+
+		if (last) {
+			blockwise_stop(bw);
+		}
+
+		bw->cb(bw, 0, (size_t)slot->num * bytes, slot->payload,
+		       slot->payload_len, last);
+	}
+}
+
+static int blockwise_content(struct coap_blockwise *bw,
+			     struct coap_blockwise_slot *slot,
+			     const struct coap_packet *response)
+{
+	const u8_t *payload;
+	int block, size;
+	u16_t bytes, len;
+	bool more;
+
+	payload = coap_packet_get_payload(response, &len);
+	bytes = coap_block_size_to_bytes(bw->block_size);
+
+	block = get_option_int(response, COAP_OPTION_BLOCK2);
+	if (block == -ENOENT) {
+		/* The whole resource in a single response */
+		if (slot->num != 0U || len > sizeof(slot->payload)) {
+			return -EINVAL;
+		}
+
+		more = false;
+	} else {
+		/* Only the first block is in flight when the server picks a
+		 * smaller block size.
+		 */
+		if (slot->num == 0U && GET_BLOCK_SIZE(block) < bw->block_size) {
+			bw->block_size = GET_BLOCK_SIZE(block);
+		}
+
+		bytes = coap_block_size_to_bytes(bw->block_size);
+		more = GET_MORE(block);
+
+		if (GET_BLOCK_SIZE(block) != bw->block_size ||
+		    GET_NUM(block) != slot->num || len > bytes ||
+		    (more && len != bytes)) {
+			return -EINVAL;
+		}
+	}
+
+	if (!more) {
+		blockwise_set_last(bw, slot->num);
+	} else if (bw->last_num == BLOCK_NUM_UNKNOWN) {
+		size = get_option_int(response, COAP_OPTION_SIZE2);
+		if (size > 0) {
+			blockwise_set_last(bw, (size - 1) / bytes);
+		}
+	}
+
+	if (len > 0) {
+		memcpy(slot->payload, payload, len);
+	}
+
+	slot->payload_len = len;
+
+	return 0;
+}
+
+int coap_blockwise_get(struct coap_blockwise *bw, const struct sockaddr *addr,
+		       const char * const *path,
+		       enum coap_block_size block_size,
+		       coap_blockwise_send_t send, coap_blockwise_cb_t cb,
+		       void *user_data)
+{
+	int r;
+
+	if (!bw || !addr || !send || !cb || block_size > COAP_BLOCK_1024 ||
+	    coap_block_size_to_bytes(block_size) >
+					CONFIG_COAP_BLOCKWISE_BLOCK_SIZE) {
+		return -EINVAL;
+	}
+
+	memset(bw, 0, sizeof(*bw));
+
+	memcpy(&bw->addr, addr, sizeof(bw->addr));
+	bw->path = path;
+	bw->send = send;
+	bw->cb = cb;
+	bw->user_data = user_data;
+	bw->block_size = block_size;
+	bw->last_num = BLOCK_NUM_UNKNOWN;
+	bw->active = true;
+
+	r = blockwise_send(bw, &bw->slots[0], bw->next_num++);
+	if (r < 0) {
+		blockwise_stop(bw);
+	}
+
+	return r;
+}
+
+int coap_blockwise_received(struct coap_blockwise *bw,
+			    const struct coap_packet *response)
+{
+	struct coap_blockwise_slot *slot = NULL;
+	u8_t code = coap_header_get_code(response);
+	u16_t id = coap_header_get_id(response);
+	u8_t token[8];
+	u8_t tkl;
+	int i, r;
+
+	if (!bw->active) {
+		return -ENOENT;
+	}
+
+	tkl = coap_header_get_token(response, token);
+
+	for (i = 0; i < ARRAY_SIZE(bw->slots); i++) {
+		struct coap_blockwise_slot *s = &bw->slots[i];
+
+		if (s->state != SLOT_SENT) {
+			continue;
+		}
+
+		if ((tkl == sizeof(s->token) &&
+		     !memcmp(token, s->token, tkl)) ||
+		    (code == COAP_CODE_EMPTY && id == s->pending.id)) {
+			slot = s;
+			break;
+		}
+	}
+
+	if (slot == NULL) {
+		return -ENOENT;
+	}
+
+	if (code == COAP_CODE_EMPTY) {
+		if (coap_header_get_type(response) == COAP_TYPE_RESET) {
+			blockwise_fail(bw, -ECONNRESET);
+			return 0;
+		}
+
+		/* Stop retransmitting, a separate response follows */
+		slot->acked = 1U;
+		slot->deadline = k_uptime_get() + SEPARATE_RESPONSE_TIMEOUT;
+
+		return 0;
+	}
+
+	/* An error response for a block past the end of a resource of
+	 * unknown size is dropped once the last block is known.
+	 */
+	if (code == COAP_RESPONSE_CODE_CONTENT) {
+		r = blockwise_content(bw, slot, response);
+		if (r < 0) {
+			blockwise_fail(bw, r);
+			return 0;
+		}
+	}
+
+	if (slot->state == SLOT_SENT) {
+		slot->code = code;
+		slot->state = SLOT_RECEIVED;
+	}
+
+	blockwise_deliver(bw);
+	blockwise_fill(bw);
+
+	return 0;
+}
+
+s32_t coap_blockwise_cycle(struct coap_blockwise *bw)
+{
+	s64_t now = k_uptime_get();
+	s64_t next = 0;
+	int i, r;
+
+	for (i = 0; i < ARRAY_SIZE(bw->slots) && bw->active; i++) {
+		struct coap_blockwise_slot *slot = &bw->slots[i];
+
+		if (slot->state != SLOT_SENT) {
+			continue;
+		}
+
+		if (slot->deadline <= now) {
+			if (slot->acked || !coap_pending_cycle(&slot->pending)) {
+				blockwise_fail(bw, -ETIMEDOUT);
+				break;
+			}
+
+			NET_DBG("Retransmitting block %u", slot->num);
+
+			slot->deadline = now + slot->pending.timeout;
+
+			r = bw->send(bw, slot->pending.data, slot->pending.len);
+			if (r < 0) {
+				blockwise_fail(bw, r);
+				break;
+			}
+		}
+
+		if (next == 0 || slot->deadline < next) {
+			next = slot->deadline;
+		}
+	}
+
+	if (!bw->active || next == 0) {
+		return K_FOREVER;
+	}
+
+	return (s32_t)(next - now);
+}
+
+void coap_blockwise_cancel(struct coap_blockwise *bw)
+{
+	blockwise_stop(bw);
+}
@@ -322,6 +322,10 @@ int dns_resolve_init(struct dns_resolve_context *ctx, const char *servers[],
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	k_mutex_init(&ctx->cache.lock);
+#endif
+
 	ctx->is_used = true;
 	ctx->buf_timeout = DNS_BUF_TIMEOUT;
 
@@ -355,6 +359,214 @@ static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 	return -ENOENT;
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+static struct dns_cache_entry *dns_cache_find(struct dns_resolve_context *ctx,
+					      const char *query,
+					      enum dns_query_type type,
+					      s64_t now)
+{
+	struct dns_cache_entry *entry;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(ctx->cache.entries); i++) {
+		entry = &ctx->cache.entries[i];
+
+		if (entry->expiry == 0) {
+			continue;
+		}
+
+		if (entry->expiry <= now) {
+			entry->expiry = 0;
+			continue;
+		}
+
+		if (entry->query_type == type && !strcmp(entry->name, query)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Answer the query from the cache, the callback is called without the
+ * cache lock held.
+ */
+static bool dns_cache_lookup(struct dns_resolve_context *ctx,
+			     const char *query, enum dns_query_type type,
+			     dns_resolve_cb_t cb, void *user_data)
+{
+	struct dns_cache_entry *found;
+	struct dns_cache_entry entry;
+	int i;
+
+	k_mutex_lock(&ctx->cache.lock, K_FOREVER);
+
+	found = dns_cache_find(ctx, query, type, k_uptime_get());
+	if (found) {
+		memcpy(&entry, found, sizeof(entry));
+
+		if (entry.status) {
+			ctx->cache.stats.negative_hits++;
+		} else {
+			ctx->cache.stats.hits++;
+		}
+	} else {
+		ctx->cache.stats.misses++;
+	}
+
+	k_mutex_unlock(&ctx->cache.lock);
+
+	if (!found) {
+		return false;
+	}
+
+	NET_DBG("Cached %s (%d)", log_strdup(query), entry.status);
+
+	if (entry.status) {
+		cb(entry.status, NULL, user_data);
+		return true;
+	}
+
+	for (i = 0; i < entry.count; i++) {
+		struct dns_addrinfo info = { 0 };
+
+		memcpy(&info.ai_addr, &entry.addrs[i], sizeof(info.ai_addr));
+		info.ai_family = info.ai_addr.sa_family;
+
+		if (IS_ENABLED(CONFIG_NET_IPV6) && info.ai_family == AF_INET6) {
+			info.ai_addrlen = sizeof(struct sockaddr_in6);
+		} else {
+			info.ai_addrlen = sizeof(struct sockaddr_in);
+		}
+
+		cb(DNS_EAI_INPROGRESS, &info, user_data);
+	}
+
+	cb(DNS_EAI_ALLDONE, NULL, user_data);
+
+	return true;
+}
+
+static void dns_cache_collect(struct dns_resolve_context *ctx, int query_idx,
+			      const struct sockaddr *addr, u32_t ttl)
+{
+	struct dns_pending_query *pending_query = &ctx->queries[query_idx];
+
+	pending_query->cache_ttl = MIN(pending_query->cache_ttl, ttl);
+
+	if (pending_query->cache_count <
+	    ARRAY_SIZE(pending_query->cache_addrs)) {
+		memcpy(&pending_query->cache_addrs[pending_query->cache_count++],
+		       addr, sizeof(*addr));
+	}
+}
+
+/* Store the final status of a query, DNS_EAI_ALLDONE with the collected
+ * addresses, or a failure for the negative TTL.
+ */
+static void dns_cache_store(struct dns_resolve_context *ctx, int query_idx,
+			    int status)
+{
+	struct dns_pending_query *pending_query = &ctx->queries[query_idx];
+	struct dns_cache_entry *entry;
+	s64_t now;
+	u32_t ttl;
+	int i;
+
+	/* mDNS answers come from several responders, do not cache them */
+	if (pending_query->id == 0U ||
+	    strlen(pending_query->query) > CONFIG_DNS_RESOLVER_CACHE_NAME_LEN) {
+		return;
+	}
+
+	if (status == DNS_EAI_ALLDONE) {
+		ttl = MIN(pending_query->cache_ttl,
+			  CONFIG_DNS_RESOLVER_CACHE_MAX_TTL);
+		status = 0;
+	} else {
+		ttl = CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL;
+	}
+
+	if (ttl == 0U) {
+		return;
+	}
+
+	k_mutex_lock(&ctx->cache.lock, K_FOREVER);
+
+	now = k_uptime_get();
+
+	entry = dns_cache_find(ctx, pending_query->query,
+			       pending_query->query_type, now);
+	if (!entry) {
+		/* Take a free entry, or the one expiring first */
+		entry = &ctx->cache.entries[0];
+
+		for (i = 0; i < ARRAY_SIZE(ctx->cache.entries); i++) {
+			if (ctx->cache.entries[i].expiry == 0) {
+				entry = &ctx->cache.entries[i];
+				break;
+			}
+
+			if (ctx->cache.entries[i].expiry < entry->expiry) {
+				entry = &ctx->cache.entries[i];
+			}
+		}
+
+		if (entry->expiry) {
+			ctx->cache.stats.evictions++;
+		}
+	}
+
+	strcpy(entry->name, pending_query->query);
+	entry->query_type = pending_query->query_type;
+	entry->status = status;
+	entry->count = status ? 0 : pending_query->cache_count;
+	memcpy(entry->addrs, pending_query->cache_addrs,
+	       entry->count * sizeof(entry->addrs[0]));
+	entry->expiry = now + (s64_t)ttl * MSEC_PER_SEC;
+
+	k_mutex_unlock(&ctx->cache.lock);
+}
+
+static void dns_cache_reset(struct dns_resolve_context *ctx, int query_idx)
+{
+	ctx->queries[query_idx].cache_ttl = UINT32_MAX;
+	ctx->queries[query_idx].cache_count = 0U;
+}
+
+void dns_resolve_cache_flush(struct dns_resolve_context *ctx)
+{
+	int i;
+
+	k_mutex_lock(&ctx->cache.lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(ctx->cache.entries); i++) {
+		ctx->cache.entries[i].expiry = 0;
+	}
+
+	k_mutex_unlock(&ctx->cache.lock);
+}
+
+int dns_resolve_cache_stats_get(struct dns_resolve_context *ctx,
+				struct dns_cache_stats *stats)
+{
+	if (!ctx || !ctx->is_used || !stats) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&ctx->cache.lock, K_FOREVER);
+	memcpy(stats, &ctx->cache.stats, sizeof(*stats));
+	k_mutex_unlock(&ctx->cache.lock);
+
+	return 0;
+}
+#else
+#define dns_cache_lookup(...) false
+#define dns_cache_collect(...)
+#define dns_cache_store(...)
+#define dns_cache_reset(...)
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 static int dns_read(struct dns_resolve_context *ctx,
 		    struct net_pkt *pkt,
 		    struct net_buf *dns_data,
@@ -364,7 +576,7 @@ static int dns_read(struct dns_resolve_context *ctx,
 	struct dns_addrinfo info = { 0 };
 	/* Helper struct to track the dns msg received from the server */
 	struct dns_msg_t dns_msg;
-	u32_t ttl; /* RR ttl, so far it is not passed to caller */
+	u32_t ttl; /* RR ttl, only used by the cache */
 	u8_t *src, *addr;
 	int address_size;
 	/* index that points to the current answer being analyzed */
@@ -408,6 +620,12 @@ static int dns_read(struct dns_resolve_context *ctx,
 
 	ret = dns_unpack_response_header(&dns_msg, *dns_id);
 	if (ret < 0) {
+		/* A name without data of the asked type */
+		if (dns_header_rcode(dns_msg.msg) == DNS_HEADER_NOERROR &&
+		    dns_header_ancount(dns_msg.msg) == 0) {
+			dns_cache_store(ctx, query_idx, DNS_EAI_FAIL);
+		}
+
 		ret = DNS_EAI_FAIL;
 		goto quit;
 	}
@@ -493,6 +711,8 @@ static int dns_read(struct dns_resolve_context *ctx,
 
 			memcpy(addr, src, address_size);
 
+			dns_cache_collect(ctx, query_idx, &info.ai_addr, ttl);
+
 			ctx->queries[query_idx].cb(DNS_EAI_INPROGRESS, &info,
 					ctx->queries[query_idx].user_data);
 			items++;
@@ -542,6 +762,8 @@ static int dns_read(struct dns_resolve_context *ctx,
 		ret = DNS_EAI_ALLDONE;
 	}
 
+	dns_cache_store(ctx, query_idx, ret);
+
 	if (k_delayed_work_remaining_get(&ctx->queries[query_idx].timer) > 0) {
 		k_delayed_work_cancel(&ctx->queries[query_idx].timer);
 	}
@@ -842,11 +1064,21 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	}
 
 try_resolve:
+	if (dns_cache_lookup(ctx, query, type, cb, user_data)) {
+		if (dns_id) {
+			*dns_id = 0U;
+		}
+
+		return 0;
+	}
+
 	i = get_cb_slot(ctx);
 	if (i < 0) {
 		return -EAGAIN;
 	}
 
+	dns_cache_reset(ctx, i);
+
 	ctx->queries[i].cb = cb;
 	ctx->queries[i].timeout = timeout;
 	ctx->queries[i].query = query;
@@ -1006,6 +1238,8 @@ int dns_resolve_close(struct dns_resolve_context *ctx)
 		}
 	}
 
+	dns_resolve_cache_flush(ctx);
+
 	ctx->is_used = false;
 
 	return 0;
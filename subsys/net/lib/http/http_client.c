@@ -251,8 +251,14 @@ static int on_body(struct http_parser *parser, const char *at, size_t length)
 						struct http_request,
 						internal.parser);
 
+	if (req->internal.response.body_skipped) {
+		return 0;
+	}
+
 	req->internal.response.body_found = 1;
 	req->internal.response.processed += length;
+	req->internal.response.body_frag_start = (u8_t *)at;
+	req->internal.response.body_frag_len = length;
 
 	NET_DBG("Processed %zd length %zd", req->internal.response.processed,
 		length);
@@ -292,6 +298,32 @@ static int on_body(struct http_parser *parser, const char *at, size_t length)
 	return 0;
 }
 
+/* A body skipped by on_headers_complete() hides where the next response of
+ * the connection starts.
+ */
+static bool http_has_body(const struct http_parser *parser)
+{
+	return (parser->flags & F_CHUNKED) ||
+		(parser->content_length > 0 &&
+		 parser->content_length != ULLONG_MAX);
+}
+
+/* The unwanted body is still parsed, so that exactly the Content-Length or
+ * the chunked body is consumed before the next response, but on_body() does
+ * not report it.
+ */
+static int http_skip_body(struct http_request *req,
+			  const struct http_parser *parser)
+{
+	if (!http_has_body(parser)) {
+		return 1;
+	}
+
+	req->internal.response.body_skipped = 1;
+
+	return 0;
+}
+
 static int on_headers_complete(struct http_parser *parser)
 {
 	struct http_request *req = CONTAINER_OF(parser,
@@ -305,7 +337,7 @@ static int on_headers_complete(struct http_parser *parser)
 
 	if (parser->status_code >= 500 && parser->status_code < 600) {
 		NET_DBG("Status %d, skipping body", parser->status_code);
-		return 1;
+		return http_skip_body(req, parser);
 	}
 
 	if ((req->method == HTTP_HEAD || req->method == HTTP_OPTIONS) &&
@@ -317,7 +349,7 @@ static int on_headers_complete(struct http_parser *parser)
 	if ((req->method == HTTP_PUT || req->method == HTTP_POST) &&
 	    req->internal.response.content_length == 0) {
 		NET_DBG("No body expected");
-		return 1;
+		return http_skip_body(req, parser);
 	}
 
 	NET_DBG("Headers complete");
@@ -364,6 +396,11 @@ static int on_message_complete(struct http_parser *parser)
 					  req->internal.user_data);
 	}
 
+	/* Stop at the end of the response, the data after it belongs to the
+	 * next pipelined response.
+	 */
+	http_parser_pause(parser, 1);
+
 	return 0;
 }
 
@@ -412,87 +449,353 @@ static void http_client_init_parser(struct http_parser *parser,
 	settings->on_url = on_url;
 }
 
-static int http_wait_data(int sock, struct http_request *req)
+
+#if defined(CONFIG_HTTP_CLIENT_POOL)
+struct http_conn {
+	/** Uptime in ms when the connection was last returned to the pool */
+	s64_t last_used;
+
+	char host[CONFIG_HTTP_CLIENT_POOL_HOST_LEN + 1];
+	char port[sizeof("65535")];
+	int proto;
+	int sock;
+
+	/** Socket is open */
+	u8_t connected : 1;
+
+	/** Socket is given to the application */
+	u8_t in_use : 1;
+
+	/** Responses so far allow sending another request */
+	u8_t reusable : 1;
+};
+
+static struct http_conn http_conns[CONFIG_HTTP_CLIENT_POOL_SIZE];
+static K_MUTEX_DEFINE(http_conns_lock);
+
+static struct http_conn *http_conn_find(int sock)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(http_conns); i++) {
+		if (http_conns[i].in_use && http_conns[i].connected &&
+		    http_conns[i].sock == sock) {
+			return &http_conns[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void http_conn_close(struct http_conn *conn)
+{
+	NET_DBG("Closing connection to %s:%s (%d)", log_strdup(conn->host),
+		log_strdup(conn->port), conn->sock);
+
+	(void)close(conn->sock);
+	conn->connected = false;
+}
+
+/* An idle connection has nothing to read unless the server closed it */
+static bool http_conn_is_alive(struct http_conn *conn, s64_t now)
+{
+	struct pollfd fds = {
+		.fd = conn->sock,
+		.events = POLLIN,
+	};
+
+	if (now - conn->last_used >
+	    CONFIG_HTTP_CLIENT_POOL_IDLE_TIMEOUT * MSEC_PER_SEC) {
+		return false;
+	}
+
+	return poll(&fds, 1, 0) == 0;
+}
+
+static int http_conn_connect(struct http_conn *conn,
+			     http_conn_setup_cb_t setup_cb, void *user_data)
+{
+	struct addrinfo hints = {
+		.ai_socktype = SOCK_STREAM,
+	};
+	struct addrinfo *ai;
+	int sock, ret;
+
+	ret = getaddrinfo(conn->host, conn->port, &hints, &ai);
+	if (ret != 0) {
+		NET_DBG("Cannot resolve %s (%d)", log_strdup(conn->host), ret);
+		return -EHOSTUNREACH;
+	}
+
+	sock = socket(ai->ai_family, SOCK_STREAM, conn->proto);
+	if (sock < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+	if (setup_cb) {
+		ret = setup_cb(sock, user_data);
+		if (ret < 0) {
+			(void)close(sock);
+			goto out;
+		}
+	}
+
+	if (connect(sock, ai->ai_addr, ai->ai_addrlen) < 0) {
+		ret = -errno;
+		(void)close(sock);
+		goto out;
+	}
+
+	conn->sock = sock;
+	ret = 0;
+
+out:
+	freeaddrinfo(ai);
+
+	return ret;
+}
+
+int http_client_conn_get(const char *host, const char *port, int proto,
+			 http_conn_setup_cb_t setup_cb, void *user_data)
+{
+	struct http_conn *conn = NULL, *free_conn = NULL, *idle = NULL;
+	s64_t now = k_uptime_get();
+	int i, ret;
+
+	if (host == NULL || port == NULL ||
+	    strlen(host) > CONFIG_HTTP_CLIENT_POOL_HOST_LEN ||
+	    strlen(port) >= sizeof(http_conns[0].port)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&http_conns_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(http_conns); i++) {
+		struct http_conn *c = &http_conns[i];
+
+		if (c->in_use) {
+			continue;
+		}
+
+		if (c->connected && c->proto == proto &&
+		    !strcmp(c->host, host) && !strcmp(c->port, port)) {
+			if (http_conn_is_alive(c, now)) {
+				conn = c;
+				break;
+			}
+
+			http_conn_close(c);
+		}
+
+		if (!c->connected) {
+			if (free_conn == NULL) {
+				free_conn = c;
+			}
+		} else if (idle == NULL || c->last_used < idle->last_used) {
+			idle = c;
+		}
+	}
+
+	if (conn) {
+		conn->in_use = true;
+		conn->reusable = true;
+		k_mutex_unlock(&http_conns_lock);
+
+		NET_DBG("Reusing connection to %s:%s (%d)", log_strdup(host),
+			log_strdup(port), conn->sock);
+
+		return conn->sock;
+	}
+
+	/* Make room by closing the connection idle for the longest time */
+	if (free_conn == NULL && idle) {
+		http_conn_close(idle);
+		free_conn = idle;
+	}
+
+	if (free_conn == NULL) {
+		k_mutex_unlock(&http_conns_lock);
+		return -ENOMEM;
+	}
+
+	free_conn->in_use = true;
+	free_conn->proto = proto;
+	strcpy(free_conn->host, host);
+	strcpy(free_conn->port, port);
+
+	k_mutex_unlock(&http_conns_lock);
+
+	/* Connect without the lock, other connections can be taken
+	 * meanwhile.
+	 */
+	ret = http_conn_connect(free_conn, setup_cb, user_data);
+
+	k_mutex_lock(&http_conns_lock, K_FOREVER);
+
+	if (ret < 0) {
+		free_conn->in_use = false;
+	} else {
+		free_conn->connected = true;
+		free_conn->reusable = true;
+		ret = free_conn->sock;
+	}
+
+	k_mutex_unlock(&http_conns_lock);
+
+	return ret;
+}
+
+void http_client_conn_put(int sock)
 {
+	struct http_conn *conn;
+
+	k_mutex_lock(&http_conns_lock, K_FOREVER);
+
+	conn = http_conn_find(sock);
+	if (conn) {
+		if (!conn->reusable) {
+			http_conn_close(conn);
+		}
+
+		conn->in_use = false;
+		conn->last_used = k_uptime_get();
+	}
+
+	k_mutex_unlock(&http_conns_lock);
+}
+
+static void http_conn_update(int sock, bool keep_alive)
+{
+	struct http_conn *conn;
+
+	k_mutex_lock(&http_conns_lock, K_FOREVER);
+
+	conn = http_conn_find(sock);
+	if (conn && !keep_alive) {
+		conn->reusable = false;
+	}
+
+	k_mutex_unlock(&http_conns_lock);
+}
+#else
+#define http_conn_update(...)
+#endif /* CONFIG_HTTP_CLIENT_POOL */
+
+/* Receive with the deadline of the request, end is 0 when there is none */
+static int http_recv(int sock, void *buf, size_t len, s64_t end)
+{
+	struct pollfd fds = {
+		.fd = sock,
+		.events = POLLIN,
+	};
+	s64_t remaining;
+	int ret;
+
+	if (end) {
+		remaining = end - k_uptime_get();
+		if (remaining <= 0) {
+			return -ETIMEDOUT;
+		}
+
+		ret = poll(&fds, 1, (int)remaining);
+		if (ret == 0) {
+			return -ETIMEDOUT;
+		} else if (ret < 0) {
+			return -errno;
+		}
+	}
+
+	ret = recv(sock, buf, len, 0);
+	if (ret < 0) {
+		return -errno;
+	}
+
+	return ret;
+}
+
+/* On entry rest_len bytes received with the previous response are at the
+ * start of the receive buffer. On return rest_offset and rest_len tell
+ * where the data received after this response is.
+ */
+static int http_wait_data(int sock, struct http_request *req, s64_t end,
+			  size_t *rest_offset, size_t *rest_len)
+{
+	struct http_response *rsp = &req->internal.response;
+	size_t received = *rest_len;
 	int total_received = 0;
 	size_t offset = 0;
-	int received, ret;
+	size_t parsed;
+	int ret;
+
+	*rest_len = 0;
 
 	do {
-		received = recv(sock, req->internal.response.recv_buf + offset,
-				req->internal.response.recv_buf_len - offset,
-				0);
 		if (received == 0) {
-			/* Connection closed */
-			LOG_DBG("Connection closed");
-			ret = total_received;
-			break;
-		} else if (received < 0) {
-			/* Socket error */
-			LOG_DBG("Connection error (%d)", errno);
-			ret = -errno;
-			break;
-		} else {
-			req->internal.response.data_len += received;
+			ret = http_recv(sock, rsp->recv_buf + offset,
+					rsp->recv_buf_len - offset, end);
+			if (ret == 0) {
+				/* Connection closed, this ends a response
+				 * without a length.
+				 */
+				LOG_DBG("Connection closed");
+				(void)http_parser_execute(
+					&req->internal.parser,
+					&req->internal.parser_settings,
+					NULL, 0);
+				ret = total_received;
+				break;
+			} else if (ret < 0) {
+				/* Socket error */
+				LOG_DBG("Connection error (%d)", ret);
+				break;
+			}
 
-			(void)http_parser_execute(
-				&req->internal.parser,
-				&req->internal.parser_settings,
-				req->internal.response.recv_buf + offset,
-				received);
+			received = ret;
 		}
 
-		total_received += received;
-		offset += received;
+		rsp->data_len += received;
 
-		if (offset >= req->internal.response.recv_buf_len) {
-			offset = 0;
-		}
+		parsed = http_parser_execute(&req->internal.parser,
+					     &req->internal.parser_settings,
+					     rsp->recv_buf + offset, received);
 
-		if (req->internal.response.message_complete) {
+		total_received += received;
+
+		if (rsp->message_complete) {
+			*rest_offset = offset + parsed;
+			*rest_len = received - parsed;
 			ret = total_received;
 			break;
 		}
 
+		offset += received;
+		received = 0;
+
+		if (offset >= rsp->recv_buf_len) {
+			offset = 0;
+		}
 	} while (true);
 
 	return ret;
 }
 
-static void http_timeout(struct k_work *work)
+static bool http_keep_alive(struct http_request *req)
 {
-	struct http_client_internal_data *data =
-		CONTAINER_OF(work, struct http_client_internal_data, work);
-
-	(void)close(data->sock);
+	return req->internal.response.message_complete &&
+		http_should_keep_alive(&req->internal.parser);
 }
 
-int http_client_req(int sock, struct http_request *req,
-		    s32_t timeout, void *user_data)
+static int http_send_req(int sock, struct http_request *req, void *user_data)
 {
 	/* Utilize the network usage by sending data in bigger blocks */
 	char send_buf[MAX_SEND_BUF_LEN];
 	const size_t send_buf_max_len = sizeof(send_buf);
 	size_t send_buf_pos = 0;
 	int total_sent = 0;
-	int ret, total_recv, i;
+	int ret, i;
 	const char *method;
 
-	if (sock < 0 || req == NULL || req->response == NULL ||
-	    req->recv_buf == NULL || req->recv_buf_len == 0) {
-		return -EINVAL;
-	}
-
-	memset(&req->internal.response, 0, sizeof(req->internal.response));
-
-	req->internal.response.http_cb = req->http_cb;
-	req->internal.response.cb = req->response;
-	req->internal.response.recv_buf = req->recv_buf;
-	req->internal.response.recv_buf_len = req->recv_buf_len;
-	req->internal.user_data = user_data;
-	req->internal.timeout = timeout;
-	req->internal.sock = sock;
-
 	method = http_method_str(req->method);
 
 	ret = http_send_data(sock, send_buf, send_buf_max_len, &send_buf_pos,
@@ -630,30 +933,109 @@ int http_client_req(int sock, struct http_request *req,
 		total_sent += ret;
 	}
 
-	NET_DBG("Sent %d bytes", total_sent);
+	return total_sent;
+
+out:
+	return ret;
+}
+
+int http_client_req_pipeline(int sock, struct http_request **reqs,
+			     size_t count, s32_t timeout, void *user_data)
+{
+	size_t rest_offset = 0, rest_len = 0;
+	bool keep_alive = true;
+	int total_sent = 0;
+	int ret, total_recv;
+	s64_t end = 0;
+	size_t i;
+
+	if (sock < 0 || reqs == NULL || count == 0) {
+		return -EINVAL;
+	}
+
+	for (i = 0; i < count; i++) {
+		struct http_request *req = reqs[i];
+
+		if (req == NULL || req->response == NULL ||
+		    req->recv_buf == NULL || req->recv_buf_len == 0) {
+			return -EINVAL;
+		}
 
-	http_client_init_parser(&req->internal.parser,
-				&req->internal.parser_settings);
+		memset(&req->internal.response, 0,
+		       sizeof(req->internal.response));
+
+		req->internal.response.http_cb = req->http_cb;
+		req->internal.response.cb = req->response;
+		req->internal.response.recv_buf = req->recv_buf;
+		req->internal.response.recv_buf_len = req->recv_buf_len;
+		req->internal.user_data = user_data;
+		req->internal.timeout = timeout;
+		req->internal.sock = sock;
+	}
+
+	/* Send all the requests before waiting for the first response */
+	for (i = 0; i < count; i++) {
+		ret = http_send_req(sock, reqs[i], user_data);
+		if (ret < 0) {
+			http_conn_update(sock, false);
+			return ret;
+		}
+
+		total_sent += ret;
+	}
+
+	NET_DBG("Sent %d bytes", total_sent);
 
 	if (timeout != K_FOREVER && timeout != K_NO_WAIT) {
-		k_delayed_work_init(&req->internal.work, http_timeout);
-		(void)k_delayed_work_submit(&req->internal.work, timeout);
+		end = k_uptime_get() + timeout;
 	}
 
-	/* Request is sent, now wait data to be received */
-	total_recv = http_wait_data(sock, req);
-	if (total_recv < 0) {
-		NET_DBG("Wait data failure (%d)", total_recv);
-	} else {
+	for (i = 0; i < count; i++) {
+		struct http_request *req = reqs[i];
+
+		if (rest_len > req->recv_buf_len) {
+			NET_DBG("Next response does not fit (%zd > %zd)",
+				rest_len, req->recv_buf_len);
+			keep_alive = false;
+			break;
+		}
+
+		if (rest_len > 0) {
+			memmove(req->recv_buf,
+				reqs[i - 1]->recv_buf + rest_offset, rest_len);
+		}
+
+		http_client_init_parser(&req->internal.parser,
+					&req->internal.parser_settings);
+
+		/* Request is sent, now wait data to be received */
+		total_recv = http_wait_data(sock, req, end, &rest_offset,
+					    &rest_len);
+		if (total_recv < 0) {
+			NET_DBG("Wait data failure (%d)", total_recv);
+			keep_alive = false;
+			break;
+		}
+
 		NET_DBG("Received %d bytes", total_recv);
+
+		if (!http_keep_alive(req)) {
+			keep_alive = false;
+		}
 	}
 
-	if (timeout != K_FOREVER && timeout != K_NO_WAIT) {
-		(void)k_delayed_work_cancel(&req->internal.work);
+	if (rest_len > 0) {
+		NET_DBG("Dropping %zd unexpected bytes", rest_len);
+		keep_alive = false;
 	}
 
+	http_conn_update(sock, keep_alive);
+
 	return total_sent;
+}
 
-out:
-	return ret;
+int http_client_req(int sock, struct http_request *req,
+		    s32_t timeout, void *user_data)
+{
+	return http_client_req_pipeline(sock, &req, 1, timeout, user_data);
 }
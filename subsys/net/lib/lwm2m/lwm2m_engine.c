@@ -49,6 +49,9 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #ifdef CONFIG_LWM2M_RW_JSON_SUPPORT
 #include "lwm2m_rw_json.h"
 #endif
+#ifdef CONFIG_LWM2M_RW_CBOR_SUPPORT
+#include "lwm2m_rw_cbor.h"
+#endif
 #ifdef CONFIG_LWM2M_RD_CLIENT_SUPPORT
 #include "lwm2m_rd_client.h"
 #endif
@@ -127,6 +130,17 @@ static sys_slist_t engine_obj_inst_list;
 static sys_slist_t engine_observer_list;
 static sys_slist_t engine_service_list;
 
+/* Object instances are also hashed by object and instance id, so that
+ * resolving a path does not walk every instance.
+ */
+#define OBJ_INST_HASH_SIZE	16
+static sys_slist_t engine_obj_inst_hash[OBJ_INST_HASH_SIZE];
+
+/* Earliest time an observer can be due, the observers are only scanned
+ * from then on.
+ */
+static s64_t engine_observer_next_due;
+
 static K_THREAD_STACK_DEFINE(engine_thread_stack,
 			      CONFIG_LWM2M_ENGINE_STACK_SIZE);
 static struct k_thread engine_thread_data;
@@ -370,6 +384,25 @@ static void clear_attrs(void *ref)
 	}
 }
 
+static s64_t observer_next_due(const struct observe_node *obs)
+{
+	/* both notify conditions are strict, see lwm2m_engine_service() */
+	if (obs->event_timestamp > obs->last_timestamp) {
+		return obs->last_timestamp + K_SECONDS(obs->min_period_sec) + 1;
+	}
+
+	return obs->last_timestamp + K_SECONDS(obs->max_period_sec) + 1;
+}
+
+static void observer_schedule(const struct observe_node *obs)
+{
+	s64_t due = observer_next_due(obs);
+
+	if (due < engine_observer_next_due) {
+		engine_observer_next_due = due;
+	}
+}
+
 int lwm2m_notify_observer(u16_t obj_id, u16_t obj_inst_id, u16_t res_id)
 {
 	struct observe_node *obs;
@@ -383,6 +416,7 @@ int lwm2m_notify_observer(u16_t obj_id, u16_t obj_inst_id, u16_t res_id)
 		     obs->path.res_id == res_id)) {
 			/* update the event time for this observer */
 			obs->event_timestamp = k_uptime_get();
+			observer_schedule(obs);
 
 			LOG_DBG("NOTIFY EVENT %u/%u/%u",
 				obj_id, obj_inst_id, res_id);
@@ -539,6 +573,7 @@ static int engine_add_observer(struct lwm2m_message *msg,
 	observe_node_data[i].counter = 1U;
 	sys_slist_append(&engine_observer_list,
 			 &observe_node_data[i].node);
+	observer_schedule(&observe_node_data[i]);
 
 	LOG_DBG("OBSERVER ADDED %u/%u/%u(%u) token:'%s' addr:%s",
 		msg->path.obj_id, msg->path.obj_inst_id,
@@ -645,9 +680,18 @@ lwm2m_get_engine_obj_field(struct lwm2m_engine_obj *obj, int res_id)
 
 /* engine object instance */
 
+static sys_slist_t *obj_inst_bucket(u16_t obj_id, u16_t obj_inst_id)
+{
+	return &engine_obj_inst_hash[(obj_id * 31U + obj_inst_id) %
+				     OBJ_INST_HASH_SIZE];
+}
+
 static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 {
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_append(obj_inst_bucket(obj_inst->obj->obj_id,
+					 obj_inst->obj_inst_id),
+			 &obj_inst->hash_node);
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
@@ -655,6 +699,9 @@ static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 	engine_remove_observer_by_id(
 			obj_inst->obj->obj_id, obj_inst->obj_inst_id);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_find_and_remove(obj_inst_bucket(obj_inst->obj->obj_id,
+						  obj_inst->obj_inst_id),
+				  &obj_inst->hash_node);
 }
 
 static struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id,
@@ -662,8 +709,13 @@ static struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id,
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst,
-				     node) {
+	if (obj_id < 0 || obj_id > UINT16_MAX ||
+	    obj_inst_id < 0 || obj_inst_id > UINT16_MAX) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_inst_bucket(obj_id, obj_inst_id),
+				     obj_inst, hash_node) {
 		if (obj_inst->obj->obj_id == obj_id &&
 		    obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
@@ -1137,6 +1189,16 @@ static int select_writer(struct lwm2m_output_context *out, u16_t accept)
 		break;
 #endif
 
+#ifdef CONFIG_LWM2M_RW_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_CBOR:
+		out->writer = &cbor_writer;
+		break;
+
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		out->writer = &senml_cbor_writer;
+		break;
+#endif
+
 	default:
 		LOG_WRN("Unknown content type %u", accept);
 		return -ENOMSG;
@@ -1168,6 +1230,13 @@ static int select_reader(struct lwm2m_input_context *in, u16_t format)
 		break;
 #endif
 
+#ifdef CONFIG_LWM2M_RW_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_CBOR:
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		in->reader = &cbor_reader;
+		break;
+#endif
+
 	default:
 		LOG_WRN("Unknown content type %u", format);
 		return -ENOMSG;
@@ -1178,8 +1247,8 @@ static int select_reader(struct lwm2m_input_context *in, u16_t format)
 
 /* user data setter functions */
 
-static int string_to_path(char *pathstr, struct lwm2m_obj_path *path,
-			  char delim)
+int lwm2m_string_to_path(char *pathstr, struct lwm2m_obj_path *path,
+			 char delim)
 {
 	u16_t value, len;
 	int i, tokstart = -1, toklen;
@@ -1326,7 +1395,7 @@ int lwm2m_engine_create_obj_inst(char *pathstr)
 	LOG_DBG("path:%s", log_strdup(pathstr));
 
 	/* translate path -> path_obj */
-	ret = string_to_path(pathstr, &path, '/');
+	ret = lwm2m_string_to_path(pathstr, &path, '/');
 	if (ret < 0) {
 		return ret;
 	}
@@ -1347,7 +1416,7 @@ int lwm2m_engine_set_res_data(char *pathstr, void *data_ptr, u16_t data_len,
 	int ret = 0;
 
 	/* translate path -> path_obj */
-	ret = string_to_path(pathstr, &path, '/');
+	ret = lwm2m_string_to_path(pathstr, &path, '/');
 	if (ret < 0) {
 		return ret;
 	}
@@ -1391,7 +1460,7 @@ static int lwm2m_engine_set(char *pathstr, void *value, u16_t len)
 	LOG_DBG("path:%s, value:%p, len:%d", log_strdup(pathstr), value, len);
 
 	/* translate path -> path_obj */
-	ret = string_to_path(pathstr, &path, '/');
+	ret = lwm2m_string_to_path(pathstr, &path, '/');
 	if (ret < 0) {
 		return ret;
 	}
@@ -1607,7 +1676,7 @@ int lwm2m_engine_get_res_data(char *pathstr, void **data_ptr, u16_t *data_len,
 	int ret = 0;
 
 	/* translate path -> path_obj */
-	ret = string_to_path(pathstr, &path, '/');
+	ret = lwm2m_string_to_path(pathstr, &path, '/');
 	if (ret < 0) {
 		return ret;
 	}
@@ -1649,7 +1718,7 @@ static int lwm2m_engine_get(char *pathstr, void *buf, u16_t buflen)
 	LOG_DBG("path:%s, buf:%p, buflen:%d", log_strdup(pathstr), buf, buflen);
 
 	/* translate path -> path_obj */
-	ret = string_to_path(pathstr, &path, '/');
+	ret = lwm2m_string_to_path(pathstr, &path, '/');
 	if (ret < 0) {
 		return ret;
 	}
@@ -1838,7 +1907,7 @@ int lwm2m_engine_get_resource(char *pathstr, struct lwm2m_engine_res **res)
 	int ret;
 	struct lwm2m_obj_path path;
 
-	ret = string_to_path(pathstr, &path, '/');
+	ret = lwm2m_string_to_path(pathstr, &path, '/');
 	if (ret < 0) {
 		return ret;
 	}
@@ -1858,7 +1927,7 @@ int lwm2m_engine_create_res_inst(char *pathstr)
 	struct lwm2m_engine_res_inst *res_inst = NULL;
 	struct lwm2m_obj_path path;
 
-	ret = string_to_path(pathstr, &path, '/');
+	ret = lwm2m_string_to_path(pathstr, &path, '/');
 	if (ret < 0) {
 		return ret;
 	}
@@ -1910,7 +1979,7 @@ int lwm2m_engine_delete_res_inst(char *pathstr)
 	struct lwm2m_engine_res_inst *res_inst = NULL;
 	struct lwm2m_obj_path path;
 
-	ret = string_to_path(pathstr, &path, '/');
+	ret = lwm2m_string_to_path(pathstr, &path, '/');
 	if (ret < 0) {
 		return ret;
 	}
@@ -2736,6 +2805,7 @@ static int lwm2m_write_attr_handler(struct lwm2m_engine_obj *obj,
 			nattrs.pmin, MAX(nattrs.pmin, nattrs.pmax));
 		obs->min_period_sec = (u32_t)nattrs.pmin;
 		obs->max_period_sec = (u32_t)MAX(nattrs.pmin, nattrs.pmax);
+		observer_schedule(obs);
 		(void)memset(&nattrs, 0, sizeof(nattrs));
 	}
 
@@ -2802,6 +2872,14 @@ static int do_read_op(struct lwm2m_message *msg, u16_t content_format)
 		return do_read_op_json(msg, content_format);
 #endif
 
+#if defined(CONFIG_LWM2M_RW_CBOR_SUPPORT)
+	case LWM2M_FORMAT_APP_CBOR:
+		return do_read_op_cbor(msg, content_format);
+
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		return do_read_op_senml_cbor(msg, content_format);
+#endif
+
 	default:
 		LOG_ERR("Unsupported content-format: %u", content_format);
 		return -ENOMSG;
@@ -3205,6 +3283,14 @@ static int do_write_op(struct lwm2m_message *msg,
 		return do_write_op_json(msg);
 #endif
 
+#ifdef CONFIG_LWM2M_RW_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_CBOR:
+		return do_write_op_cbor(msg);
+
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		return do_write_op_senml_cbor(msg);
+#endif
+
 	default:
 		LOG_ERR("Unsupported format: %u", format);
 		return -ENOMSG;
@@ -3863,6 +3949,14 @@ s32_t engine_next_service_timeout_ms(u32_t max_timeout)
 	u64_t time_left_ms, timestamp = k_uptime_get();
 	u32_t timeout = max_timeout;
 
+	if (engine_observer_next_due <= timestamp) {
+		return 0;
+	}
+
+	if (engine_observer_next_due - timestamp < timeout) {
+		timeout = engine_observer_next_due - timestamp;
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_service_list, srv, node) {
 		time_left_ms = srv->last_timestamp +
 				  K_MSEC(srv->min_call_period);
@@ -3920,6 +4014,12 @@ static int lwm2m_engine_service(void)
 	 *    attaching the notify response handler
 	 */
 	timestamp = k_uptime_get();
+	if (timestamp < engine_observer_next_due) {
+		goto services;
+	}
+
+	engine_observer_next_due = INT64_MAX;
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_observer_list, obs, node) {
 		/*
 		 * manual notify requirements:
@@ -3942,8 +4042,10 @@ static int lwm2m_engine_service(void)
 			generate_notify_message(obs, false);
 		}
 
+		observer_schedule(obs);
 	}
 
+services:
 	timestamp = k_uptime_get();
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_service_list, srv, node) {
 		service_due_timestamp = srv->last_timestamp +
@@ -342,6 +342,9 @@ struct lwm2m_engine_obj_inst {
 	/* instance list */
 	sys_snode_t node;
 
+	/* instance hash bucket */
+	sys_snode_t hash_node;
+
 	struct lwm2m_engine_obj *obj;
 	struct lwm2m_engine_res *resources;
 
@@ -0,0 +1,847 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * CBOR (RFC 7049) and SenML-CBOR (RFC 8428) content formats.
+ *
+ * A SenML pack is an array of records, each record a map with integer
+ * labels. The base name is only sent with the first record, the names of
+ * the following records are relative to it, as with the JSON writer.
+ */
+
+#define LOG_MODULE_NAME net_lwm2m_cbor
+#define LOG_LEVEL CONFIG_LWM2M_LOG_LEVEL
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/byteorder.h>
+
+#include "lwm2m_object.h"
+#include "lwm2m_rw_cbor.h"
+#include "lwm2m_rw_plain_text.h"
+#include "lwm2m_engine.h"
+#include "lwm2m_util.h"
+
+/* CBOR major types */
+#define CBOR_UINT	0
+#define CBOR_NINT	1
+#define CBOR_BSTR	2
+#define CBOR_TSTR	3
+#define CBOR_ARRAY	4
+#define CBOR_MAP	5
+#define CBOR_TAG	6
+#define CBOR_SIMPLE	7
+
+#define CBOR_AI_MASK		0x1f
+#define CBOR_AI_INDEFINITE	31
+
+/* initial bytes of the simple values and floats */
+#define CBOR_FALSE	0xf4
+#define CBOR_TRUE	0xf5
+#define CBOR_FLOAT32	0xfa
+#define CBOR_FLOAT64	0xfb
+#define CBOR_BREAK	0xff
+
+/* cbor_get_head() return value for indefinite length items */
+#define CBOR_INDEFINITE	1
+
+/* SenML labels */
+#define SENML_BN	-2
+#define SENML_N		0
+#define SENML_V		2
+#define SENML_VS	3
+#define SENML_VB	4
+#define SENML_VD	8
+
+#define NAME_BUF_LEN	sizeof("65535/65535/65535")
+
+struct senml_out_formatter_data {
+	/* offset of the array head, the record count is patched in */
+	u16_t mark_pos;
+	u16_t record_count;
+
+	/* flags */
+	u8_t writer_flags;
+
+	/* path storage */
+	u8_t path_level;
+
+	/* base name goes with the next record */
+	bool bn_pending;
+};
+
+/* encode */
+
+static size_t cbor_encode_head(u8_t *buf, u8_t major, u64_t value)
+{
+	major <<= 5;
+
+	if (value < 24) {
+		buf[0] = major | value;
+		return 1;
+	}
+
+	if (value <= UINT8_MAX) {
+		buf[0] = major | 24;
+		buf[1] = value;
+		return 2;
+	}
+
+	if (value <= UINT16_MAX) {
+		buf[0] = major | 25;
+		sys_put_be16(value, &buf[1]);
+		return 3;
+	}
+
+	if (value <= UINT32_MAX) {
+		buf[0] = major | 26;
+		sys_put_be32(value, &buf[1]);
+		return 5;
+	}
+
+	buf[0] = major | 27;
+	sys_put_be64(value, &buf[1]);
+	return 9;
+}
+
+static size_t cbor_put_head(struct lwm2m_output_context *out, u8_t major,
+			    u64_t value)
+{
+	u8_t buf[9];
+	size_t len;
+
+	len = cbor_encode_head(buf, major, value);
+	if (buf_append(CPKT_BUF_WRITE(out->out_cpkt), buf, len) < 0) {
+		return 0;
+	}
+
+	return len;
+}
+
+static size_t cbor_put_int(struct lwm2m_output_context *out, s64_t value)
+{
+	if (value < 0) {
+		return cbor_put_head(out, CBOR_NINT, (u64_t)(-(value + 1)));
+	}
+
+	return cbor_put_head(out, CBOR_UINT, (u64_t)value);
+}
+
+static size_t cbor_put_data(struct lwm2m_output_context *out, u8_t major,
+			    const u8_t *buf, size_t buflen)
+{
+	size_t len;
+
+	len = cbor_put_head(out, major, buflen);
+	if (len == 0 || (buflen > 0 &&
+			 buf_append(CPKT_BUF_WRITE(out->out_cpkt),
+				    (u8_t *)buf, buflen) < 0)) {
+		return 0;
+	}
+
+	return len + buflen;
+}
+
+/* an initial byte followed by the value bytes, for floats and bools */
+static size_t cbor_put_raw(struct lwm2m_output_context *out, u8_t initial,
+			   const u8_t *buf, size_t buflen)
+{
+	if (buf_append(CPKT_BUF_WRITE(out->out_cpkt), &initial, 1) < 0 ||
+	    (buflen > 0 && buf_append(CPKT_BUF_WRITE(out->out_cpkt),
+				      (u8_t *)buf, buflen) < 0)) {
+		return 0;
+	}
+
+	return buflen + 1;
+}
+
+/* Starts a SenML record up to the value label, a no-op for plain CBOR */
+static size_t senml_put_record(struct lwm2m_output_context *out,
+			       struct lwm2m_obj_path *path, int label)
+{
+	struct senml_out_formatter_data *fd;
+	char name[NAME_BUF_LEN];
+	size_t len;
+	int n;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	len = cbor_put_head(out, CBOR_MAP, fd->bn_pending ? 3 : 2);
+
+	if (fd->bn_pending) {
+		if (fd->path_level >= 2U) {
+			n = snprintk(name, sizeof(name), "/%u/%u/",
+				     path->obj_id, path->obj_inst_id);
+		} else {
+			n = snprintk(name, sizeof(name), "/%u/", path->obj_id);
+		}
+
+		len += cbor_put_int(out, SENML_BN);
+		len += cbor_put_data(out, CBOR_TSTR, (u8_t *)name, n);
+		fd->bn_pending = false;
+	}
+
+	if (fd->path_level >= 2U) {
+		if (fd->writer_flags & WRITER_RESOURCE_INSTANCE) {
+			n = snprintk(name, sizeof(name), "%u/%u",
+				     path->res_id, path->res_inst_id);
+		} else {
+			n = snprintk(name, sizeof(name), "%u", path->res_id);
+		}
+	} else {
+		if (fd->writer_flags & WRITER_RESOURCE_INSTANCE) {
+			n = snprintk(name, sizeof(name), "%u/%u/%u",
+				     path->obj_inst_id, path->res_id,
+				     path->res_inst_id);
+		} else {
+			n = snprintk(name, sizeof(name), "%u/%u",
+				     path->obj_inst_id, path->res_id);
+		}
+	}
+
+	len += cbor_put_int(out, SENML_N);
+	len += cbor_put_data(out, CBOR_TSTR, (u8_t *)name, n);
+	len += cbor_put_int(out, label);
+
+	fd->record_count++;
+
+	return len;
+}
+
+static size_t put_begin(struct lwm2m_output_context *out,
+			struct lwm2m_obj_path *path)
+{
+	struct senml_out_formatter_data *fd;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	/* the record count is not known yet, see put_end() */
+	fd->mark_pos = out->out_cpkt->offset;
+	fd->record_count = 0U;
+	fd->bn_pending = true;
+
+	return cbor_put_head(out, CBOR_ARRAY, 0);
+}
+
+static size_t put_end(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path)
+{
+	struct senml_out_formatter_data *fd;
+	u8_t head[9];
+	size_t len;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd || fd->mark_pos >= out->out_cpkt->offset) {
+		return 0;
+	}
+
+	len = cbor_encode_head(head, CBOR_ARRAY, fd->record_count);
+
+	out->out_cpkt->data[fd->mark_pos] = head[0];
+	if (len > 1 && buf_insert(CPKT_BUF_WRITE(out->out_cpkt),
+				  fd->mark_pos + 1, &head[1], len - 1) < 0) {
+		return 0;
+	}
+
+	return len - 1;
+}
+
+static size_t put_begin_ri(struct lwm2m_output_context *out,
+			   struct lwm2m_obj_path *path)
+{
+	struct senml_out_formatter_data *fd;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	fd->writer_flags |= WRITER_RESOURCE_INSTANCE;
+	return 0;
+}
+
+static size_t put_end_ri(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path)
+{
+	struct senml_out_formatter_data *fd;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	fd->writer_flags &= ~WRITER_RESOURCE_INSTANCE;
+	return 0;
+}
+
+static size_t put_s64(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, s64_t value)
+{
+	size_t len;
+
+	len = senml_put_record(out, path, SENML_V);
+	len += cbor_put_int(out, value);
+	return len;
+}
+
+static size_t put_s32(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, s32_t value)
+{
+	return put_s64(out, path, (s64_t)value);
+}
+
+static size_t put_s16(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, s16_t value)
+{
+	return put_s64(out, path, (s64_t)value);
+}
+
+static size_t put_s8(struct lwm2m_output_context *out,
+		     struct lwm2m_obj_path *path, s8_t value)
+{
+	return put_s64(out, path, (s64_t)value);
+}
+
+static size_t put_string(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 char *buf, size_t buflen)
+{
+	size_t len;
+
+	len = senml_put_record(out, path, SENML_VS);
+	len += cbor_put_data(out, CBOR_TSTR, (u8_t *)buf, buflen);
+	return len;
+}
+
+static size_t put_float32fix(struct lwm2m_output_context *out,
+			     struct lwm2m_obj_path *path,
+			     float32_value_t *value)
+{
+	size_t len;
+	u8_t b32[4];
+	int ret;
+
+	ret = lwm2m_f32_to_b32(value, b32, sizeof(b32));
+	if (ret < 0) {
+		LOG_ERR("float32 conversion error: %d", ret);
+		return 0;
+	}
+
+	len = senml_put_record(out, path, SENML_V);
+	len += cbor_put_raw(out, CBOR_FLOAT32, b32, sizeof(b32));
+	return len;
+}
+
+static size_t put_float64fix(struct lwm2m_output_context *out,
+			     struct lwm2m_obj_path *path,
+			     float64_value_t *value)
+{
+	size_t len;
+	u8_t b64[8];
+	int ret;
+
+	ret = lwm2m_f64_to_b64(value, b64, sizeof(b64));
+	if (ret < 0) {
+		LOG_ERR("float64 conversion error: %d", ret);
+		return 0;
+	}
+
+	len = senml_put_record(out, path, SENML_V);
+	len += cbor_put_raw(out, CBOR_FLOAT64, b64, sizeof(b64));
+	return len;
+}
+
+static size_t put_bool(struct lwm2m_output_context *out,
+		       struct lwm2m_obj_path *path,
+		       bool value)
+{
+	size_t len;
+
+	len = senml_put_record(out, path, SENML_VB);
+	len += cbor_put_raw(out, value ? CBOR_TRUE : CBOR_FALSE, NULL, 0);
+	return len;
+}
+
+/* decode */
+
+static int cbor_peek(struct lwm2m_input_context *in, u8_t *initial)
+{
+	if (in->offset >= in->in_cpkt->offset) {
+		return -ENODATA;
+	}
+
+	*initial = in->in_cpkt->data[in->offset];
+	return 0;
+}
+
+/* Returns 0 for a definite length item, CBOR_INDEFINITE for an indefinite
+ * length one and negative on error. The value of floats is their raw bits.
+ */
+static int cbor_get_head(struct lwm2m_input_context *in, u8_t *major,
+			 u64_t *value)
+{
+	u8_t initial, b;
+	int i, len;
+
+	if (buf_read_u8(&initial, CPKT_BUF_READ(in->in_cpkt),
+			&in->offset) < 0) {
+		return -ENODATA;
+	}
+
+	*major = initial >> 5;
+	*value = initial & CBOR_AI_MASK;
+
+	if (*value < 24) {
+		return 0;
+	}
+
+	if (*value == CBOR_AI_INDEFINITE) {
+		*value = 0U;
+		return CBOR_INDEFINITE;
+	}
+
+	if (*value > 27) {
+		return -EINVAL;
+	}
+
+	len = 1 << (*value - 24);
+	*value = 0U;
+
+	for (i = 0; i < len; i++) {
+		if (buf_read_u8(&b, CPKT_BUF_READ(in->in_cpkt),
+				&in->offset) < 0) {
+			return -ENODATA;
+		}
+
+		*value = (*value << 8) | b;
+	}
+
+	return 0;
+}
+
+static int cbor_to_s64(u8_t major, u64_t raw, s64_t *value)
+{
+	if (major == CBOR_UINT) {
+		*value = (s64_t)raw;
+	} else if (major == CBOR_NINT) {
+		*value = -1 - (s64_t)raw;
+	} else {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Skips a single data item, SenML values are never arrays or maps */
+static int cbor_skip(struct lwm2m_input_context *in)
+{
+	u8_t major;
+	u64_t value;
+
+	do {
+		if (cbor_get_head(in, &major, &value) != 0) {
+			return -EINVAL;
+		}
+	} while (major == CBOR_TAG);
+
+	if (major == CBOR_ARRAY || major == CBOR_MAP || value > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	if ((major == CBOR_BSTR || major == CBOR_TSTR) &&
+	    buf_skip(value, CPKT_BUF_READ(in->in_cpkt), &in->offset) < 0) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Steps through the items of a definite or indefinite length array / map.
+ * Returns 1 when another item follows, 0 at the end and -EINVAL when the
+ * input ends before the break of an indefinite length item.
+ */
+static int cbor_next(struct lwm2m_input_context *in, int head, u64_t *count)
+{
+	u8_t initial;
+
+	if (head == CBOR_INDEFINITE) {
+		if (cbor_peek(in, &initial) < 0) {
+			return -EINVAL;
+		}
+
+		if (initial == CBOR_BREAK) {
+			in->offset++;
+			return 0;
+		}
+
+		return 1;
+	}
+
+	if (*count == 0U) {
+		return 0;
+	}
+
+	(*count)--;
+	return 1;
+}
+
+static size_t get_s64(struct lwm2m_input_context *in, s64_t *value)
+{
+	u16_t start = in->offset;
+	u8_t major;
+	u64_t raw;
+
+	if (cbor_get_head(in, &major, &raw) != 0 ||
+	    cbor_to_s64(major, raw, value) < 0) {
+		return 0;
+	}
+
+	return in->offset - start;
+}
+
+static size_t get_s32(struct lwm2m_input_context *in, s32_t *value)
+{
+	s64_t tmp = 0;
+	size_t len;
+
+	len = get_s64(in, &tmp);
+	if (len > 0) {
+		*value = (s32_t)tmp;
+	}
+
+	return len;
+}
+
+static size_t get_string(struct lwm2m_input_context *in,
+			 u8_t *buf, size_t buflen)
+{
+	u16_t start = in->offset;
+	u16_t copy;
+	u8_t major;
+	u64_t len;
+
+	if (buflen == 0) {
+		return 0;
+	}
+
+	buf[0] = '\0';
+
+	if (cbor_get_head(in, &major, &len) != 0 ||
+	    (major != CBOR_TSTR && major != CBOR_BSTR) || len > UINT16_MAX) {
+		return 0;
+	}
+
+	/* truncate the string to the buffer */
+	copy = MIN(len, buflen - 1);
+
+	if (buf_read(buf, copy, CPKT_BUF_READ(in->in_cpkt),
+		     &in->offset) < 0 ||
+	    buf_skip(len - copy, CPKT_BUF_READ(in->in_cpkt),
+		     &in->offset) < 0) {
+		buf[0] = '\0';
+		return 0;
+	}
+
+	buf[copy] = '\0';
+	return in->offset - start;
+}
+
+static size_t get_float32fix(struct lwm2m_input_context *in,
+			     float32_value_t *value)
+{
+	u16_t start = in->offset;
+	float64_value_t f64;
+	u8_t initial, major;
+	u8_t b[8];
+	u64_t raw;
+	s64_t tmp;
+	int ret;
+
+	if (cbor_peek(in, &initial) < 0 ||
+	    cbor_get_head(in, &major, &raw) != 0) {
+		return 0;
+	}
+
+	if (initial == CBOR_FLOAT32) {
+		sys_put_be32(raw, b);
+		ret = lwm2m_b32_to_f32(b, 4, value);
+	} else if (initial == CBOR_FLOAT64) {
+		sys_put_be64(raw, b);
+		ret = lwm2m_b64_to_f64(b, 8, &f64);
+		value->val1 = (s32_t)f64.val1;
+		value->val2 = (s32_t)(f64.val2 / (LWM2M_FLOAT64_DEC_MAX /
+						  LWM2M_FLOAT32_DEC_MAX));
+	} else {
+		ret = cbor_to_s64(major, raw, &tmp);
+		value->val1 = (s32_t)tmp;
+		value->val2 = 0;
+	}
+
+	if (ret < 0) {
+		LOG_ERR("float32 conversion error: %d", ret);
+		return 0;
+	}
+
+	return in->offset - start;
+}
+
+static size_t get_float64fix(struct lwm2m_input_context *in,
+			     float64_value_t *value)
+{
+	u16_t start = in->offset;
+	float32_value_t f32;
+	u8_t initial, major;
+	u8_t b[8];
+	u64_t raw;
+	int ret;
+
+	if (cbor_peek(in, &initial) < 0 ||
+	    cbor_get_head(in, &major, &raw) != 0) {
+		return 0;
+	}
+
+	if (initial == CBOR_FLOAT64) {
+		sys_put_be64(raw, b);
+		ret = lwm2m_b64_to_f64(b, 8, value);
+	} else if (initial == CBOR_FLOAT32) {
+		sys_put_be32(raw, b);
+		ret = lwm2m_b32_to_f32(b, 4, &f32);
+		value->val1 = f32.val1;
+		value->val2 = (s64_t)f32.val2 * (LWM2M_FLOAT64_DEC_MAX /
+						 LWM2M_FLOAT32_DEC_MAX);
+	} else {
+		ret = cbor_to_s64(major, raw, &value->val1);
+		value->val2 = 0;
+	}
+
+	if (ret < 0) {
+		LOG_ERR("float64 conversion error: %d", ret);
+		return 0;
+	}
+
+	return in->offset - start;
+}
+
+static size_t get_bool(struct lwm2m_input_context *in, bool *value)
+{
+	u8_t initial;
+
+	if (buf_read_u8(&initial, CPKT_BUF_READ(in->in_cpkt),
+			&in->offset) < 0) {
+		return 0;
+	}
+
+	if (initial != CBOR_TRUE && initial != CBOR_FALSE) {
+		return 0;
+	}
+
+	*value = (initial == CBOR_TRUE);
+	return 1;
+}
+
+static size_t get_opaque(struct lwm2m_input_context *in,
+			 u8_t *value, size_t buflen, bool *last_block)
+{
+	u8_t major;
+	u64_t len;
+
+	if (cbor_get_head(in, &major, &len) != 0 ||
+	    (major != CBOR_BSTR && major != CBOR_TSTR) || len > UINT16_MAX) {
+		return 0;
+	}
+
+	in->opaque_len = len;
+	return lwm2m_engine_get_opaque_more(in, value, buflen, last_block);
+}
+
+const struct lwm2m_writer cbor_writer = {
+	.put_s8 = put_s8,
+	.put_s16 = put_s16,
+	.put_s32 = put_s32,
+	.put_s64 = put_s64,
+	.put_string = put_string,
+	.put_float32fix = put_float32fix,
+	.put_float64fix = put_float64fix,
+	.put_bool = put_bool,
+};
+
+const struct lwm2m_writer senml_cbor_writer = {
+	.put_begin = put_begin,
+	.put_end = put_end,
+	.put_begin_ri = put_begin_ri,
+	.put_end_ri = put_end_ri,
+	.put_s8 = put_s8,
+	.put_s16 = put_s16,
+	.put_s32 = put_s32,
+	.put_s64 = put_s64,
+	.put_string = put_string,
+	.put_float32fix = put_float32fix,
+	.put_float64fix = put_float64fix,
+	.put_bool = put_bool,
+};
+
+const struct lwm2m_reader cbor_reader = {
+	.get_s32 = get_s32,
+	.get_s64 = get_s64,
+	.get_string = get_string,
+	.get_float32fix = get_float32fix,
+	.get_float64fix = get_float64fix,
+	.get_bool = get_bool,
+	.get_opaque = get_opaque,
+};
+
+int do_read_op_cbor(struct lwm2m_message *msg, int content_format)
+{
+	/* Plain CBOR can only return single resource */
+	if (msg->path.level != 3U) {
+		return -EPERM; /* NOT_ALLOWED */
+	}
+
+	return lwm2m_perform_read_op(msg, content_format);
+}
+
+int do_write_op_cbor(struct lwm2m_message *msg)
+{
+	/* a single value, the resource is found as for plain text */
+	return do_write_op_plain_text(msg);
+}
+
+int do_read_op_senml_cbor(struct lwm2m_message *msg, int content_format)
+{
+	struct senml_out_formatter_data fd;
+	int ret;
+
+	(void)memset(&fd, 0, sizeof(fd));
+	engine_set_out_user_data(&msg->out, &fd);
+	/* save the level for output processing */
+	fd.path_level = msg->path.level;
+	ret = lwm2m_perform_read_op(msg, content_format);
+	engine_clear_out_user_data(&msg->out);
+
+	return ret;
+}
+
+int do_write_op_senml_cbor(struct lwm2m_message *msg)
+{
+	struct lwm2m_input_context *in = &msg->in;
+	struct lwm2m_obj_path orig_path;
+	char base_name[MAX_RESOURCE_LEN];
+	char name[MAX_RESOURCE_LEN];
+	char full_name[MAX_RESOURCE_LEN * 2];
+	u16_t value_offset = 0U, record_end;
+	u64_t records, fields;
+	bool has_value;
+	int array, map;
+	s64_t label;
+	u8_t major;
+	int ret = 0;
+
+	/* store a copy of the original path */
+	memcpy(&orig_path, &msg->path, sizeof(msg->path));
+	base_name[0] = '\0';
+
+	array = cbor_get_head(in, &major, &records);
+	if (array < 0 || major != CBOR_ARRAY) {
+		LOG_ERR("Error parsing SenML pack!");
+		return -EINVAL;
+	}
+
+	while ((ret = cbor_next(in, array, &records)) > 0) {
+		map = cbor_get_head(in, &major, &fields);
+		if (map < 0 || major != CBOR_MAP) {
+			ret = -EINVAL;
+			break;
+		}
+
+		/* the base name carries over to the following records */
+		name[0] = '\0';
+		has_value = false;
+
+		while ((ret = cbor_next(in, map, &fields)) > 0) {
+			if (get_s64(in, &label) == 0) {
+				ret = -EINVAL;
+				break;
+			}
+
+			if (label == SENML_BN) {
+				if (get_string(in, (u8_t *)base_name,
+					       sizeof(base_name)) == 0) {
+					ret = -EINVAL;
+				}
+			} else if (label == SENML_N) {
+				if (get_string(in, (u8_t *)name,
+					       sizeof(name)) == 0) {
+					ret = -EINVAL;
+				}
+			} else {
+				/* the name may follow the value */
+				if (label == SENML_V || label == SENML_VS ||
+				    label == SENML_VB || label == SENML_VD) {
+					value_offset = in->offset;
+					has_value = true;
+				}
+
+				ret = cbor_skip(in);
+			}
+
+			if (ret < 0) {
+				break;
+			}
+		}
+
+		if (ret < 0) {
+			LOG_ERR("Error parsing SenML record!");
+			break;
+		}
+
+		if (!has_value) {
+			continue;
+		}
+
+		snprintk(full_name, sizeof(full_name), "%s%s",
+			 base_name, name);
+
+		ret = lwm2m_string_to_path(full_name, &msg->path, '/');
+		if (ret < 0) {
+			break;
+		}
+
+		if (msg->path.level < 3U) {
+			LOG_ERR("Record without resource: %s", full_name);
+			ret = -EINVAL;
+			break;
+		}
+
+		/* read the value, then go on after the record */
+		record_end = in->offset;
+		in->offset = value_offset;
+		ret = do_write_op_plain_text(msg);
+		in->offset = record_end;
+
+		if (ret < 0 && (orig_path.level >= 3U || ret != -ENOENT)) {
+			/* return errors on a single write */
+			break;
+		}
+
+		/* optional resources are ignored */
+		ret = 0;
+	}
+
+	memcpy(&msg->path, &orig_path, sizeof(msg->path));
+
+	return ret;
+}
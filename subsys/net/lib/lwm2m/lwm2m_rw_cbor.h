@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LWM2M_RW_CBOR_H_
+#define LWM2M_RW_CBOR_H_
+
+#include "lwm2m_object.h"
+
+/* application/cbor: a single resource value */
+extern const struct lwm2m_writer cbor_writer;
+
+/* application/senml+cbor: a pack of records, RFC 8428 */
+extern const struct lwm2m_writer senml_cbor_writer;
+
+/* Reads a CBOR value at the input offset, for both content formats */
+extern const struct lwm2m_reader cbor_reader;
+
+int do_read_op_cbor(struct lwm2m_message *msg, int content_format);
+int do_write_op_cbor(struct lwm2m_message *msg);
+
+int do_read_op_senml_cbor(struct lwm2m_message *msg, int content_format);
+int do_write_op_senml_cbor(struct lwm2m_message *msg);
+
+#endif /* LWM2M_RW_CBOR_H_ */
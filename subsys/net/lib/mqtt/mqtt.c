@@ -25,6 +25,13 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+
+#if defined(CONFIG_MQTT_LIB_TX_BATCH)
+	client->internal.tx_batch_len = 0U;
+#endif
+#if CONFIG_MQTT_LIB_TX_INFLIGHT_MAX > 0
+	client->internal.inflight_count = 0U;
+#endif
 }
 
 /** @brief Initialize tx buffer. */
@@ -136,8 +143,8 @@ static int client_read(struct mqtt_client *client)
 	return err_code;
 }
 
-static int client_write(struct mqtt_client *client, const u8_t *data,
-			u32_t datalen)
+static int client_transport_write(struct mqtt_client *client,
+				  const u8_t *data, u32_t datalen)
 {
 	int err_code;
 
@@ -157,6 +164,139 @@ static int client_write(struct mqtt_client *client, const u8_t *data,
 	return 0;
 }
 
+#if defined(CONFIG_MQTT_LIB_TX_BATCH)
+static int tx_batch_flush(struct mqtt_client *client)
+{
+	u32_t len = client->internal.tx_batch_len;
+
+	if (len == 0U) {
+		return 0;
+	}
+
+	MQTT_TRC("[%p]: Flushing %d queued bytes.", client, len);
+
+	client->internal.tx_batch_len = 0U;
+
+	return client_transport_write(client, client->internal.tx_batch, len);
+}
+
+static bool tx_batch_append(struct mqtt_client *client,
+			    const u8_t *header, u32_t header_len,
+			    const u8_t *payload, u32_t payload_len)
+{
+	u32_t len = client->internal.tx_batch_len;
+
+	if (header_len + payload_len > sizeof(client->internal.tx_batch) - len) {
+		return false;
+	}
+
+	memcpy(client->internal.tx_batch + len, header, header_len);
+	len += header_len;
+
+	if (payload_len > 0U) {
+		memcpy(client->internal.tx_batch + len, payload, payload_len);
+		len += payload_len;
+	}
+
+	client->internal.tx_batch_len = len;
+
+	return true;
+}
+#else
+#define tx_batch_flush(...) 0
+#define tx_batch_append(...) false
+#endif /* CONFIG_MQTT_LIB_TX_BATCH */
+
+/* The queued PUBLISH packets are written first to keep the packet order */
+static int client_write(struct mqtt_client *client, const u8_t *data,
+			u32_t datalen)
+{
+	int err_code;
+
+	err_code = tx_batch_flush(client);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	return client_transport_write(client, data, datalen);
+}
+
+static int client_write_publish(struct mqtt_client *client,
+				const u8_t *header, u32_t header_len,
+				const u8_t *payload, u32_t payload_len)
+{
+	int err_code;
+
+	if (tx_batch_append(client, header, header_len,
+			    payload, payload_len)) {
+		return 0;
+	}
+
+	err_code = tx_batch_flush(client);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	if (tx_batch_append(client, header, header_len,
+			    payload, payload_len)) {
+		return 0;
+	}
+
+	err_code = client_transport_write(client, header, header_len);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	return client_transport_write(client, payload, payload_len);
+}
+
+#if CONFIG_MQTT_LIB_TX_INFLIGHT_MAX > 0
+/* Returns 1 when a new slot was taken, 0 when none was needed and a negative
+ * error code when the window is full.
+ */
+static int inflight_add(struct mqtt_client *client,
+			const struct mqtt_publish_param *param)
+{
+	u32_t i;
+
+	if (param->message.topic.qos == MQTT_QOS_0_AT_MOST_ONCE) {
+		return 0;
+	}
+
+	/* A retransmission keeps the slot of the original message */
+	for (i = 0U; i < client->internal.inflight_count; i++) {
+		if (client->internal.inflight[i] == param->message_id) {
+			return 0;
+		}
+	}
+
+	if (client->internal.inflight_count ==
+	    ARRAY_SIZE(client->internal.inflight)) {
+		return -EAGAIN;
+	}
+
+	client->internal.inflight[client->internal.inflight_count++] =
+							param->message_id;
+
+	return 1;
+}
+
+void mqtt_inflight_remove(struct mqtt_client *client, u16_t message_id)
+{
+	u32_t i;
+
+	for (i = 0U; i < client->internal.inflight_count; i++) {
+		if (client->internal.inflight[i] == message_id) {
+			client->internal.inflight[i] = client->internal.inflight[
+					--client->internal.inflight_count];
+			break;
+		}
+	}
+}
+#else
+#define inflight_add(...) 0
+#endif /* CONFIG_MQTT_LIB_TX_INFLIGHT_MAX > 0 */
+
 void mqtt_client_init(struct mqtt_client *client)
 {
 	NULL_PARAM_CHECK_VOID(client);
@@ -230,6 +370,7 @@ int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param)
 {
 	int err_code;
+	int inflight;
 	struct buf_ctx packet;
 
 	NULL_PARAM_CHECK(client);
@@ -254,13 +395,20 @@ int mqtt_publish(struct mqtt_client *client,
 		goto error;
 	}
 
-	err_code = client_write(client, packet.cur, packet.end - packet.cur);
-	if (err_code < 0) {
+	inflight = inflight_add(client, param);
+	if (inflight < 0) {
+		err_code = inflight;
 		goto error;
 	}
 
-	err_code = client_write(client, param->message.payload.data,
-				param->message.payload.len);
+	err_code = client_write_publish(client, packet.cur,
+					packet.end - packet.cur,
+					param->message.payload.data,
+					param->message.payload.len);
+	if (err_code < 0 && inflight > 0) {
+		/* The message never left, so no acknowledgment will free it. */
+		mqtt_inflight_remove(client, param->message_id);
+	}
 
 error:
 	MQTT_TRC("[CID %p]:[State 0x%02x]: << result 0x%08x",
@@ -271,6 +419,27 @@ error:
 	return err_code;
 }
 
+int mqtt_publish_flush(struct mqtt_client *client)
+{
+	int err_code;
+
+	NULL_PARAM_CHECK(client);
+
+	mqtt_mutex_lock(client);
+
+	err_code = verify_tx_state(client);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	err_code = tx_batch_flush(client);
+
+error:
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+
 int mqtt_publish_qos1_ack(struct mqtt_client *client,
 			  const struct mqtt_puback_param *param)
 {
@@ -580,6 +749,8 @@ int mqtt_live(struct mqtt_client *client)
 	if (MQTT_HAS_STATE(client, MQTT_STATE_DISCONNECTING)) {
 		client_disconnect(client, 0);
 	} else {
+		(void)tx_batch_flush(client);
+
 		elapsed_time = mqtt_elapsed_time_in_ms_get(
 					client->internal.last_activity);
 
@@ -153,6 +153,17 @@ enum mqtt_state {
  */
 void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt);
 
+#if CONFIG_MQTT_LIB_TX_INFLIGHT_MAX > 0
+/**@brief Releases the in-flight slot of an acknowledged message.
+ *
+ * @param[in] client Identifies the client for which the ack was received.
+ * @param[in] message_id Message id of the PUBACK or PUBCOMP.
+ */
+void mqtt_inflight_remove(struct mqtt_client *client, u16_t message_id);
+#else
+#define mqtt_inflight_remove(...)
+#endif
+
 /**@brief Handles MQTT messages received from the peer.
  *
  * @param[in] client Identifies the client for which the data was received.
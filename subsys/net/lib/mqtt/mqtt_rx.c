@@ -75,6 +75,12 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBACK;
 		err_code = publish_ack_decode(buf, &evt.param.puback);
 		evt.result = err_code;
+
+		if (err_code == 0) {
+			mqtt_inflight_remove(client,
+					     evt.param.puback.message_id);
+		}
+
 		break;
 
 	case MQTT_PKT_TYPE_PUBREC:
@@ -99,6 +105,12 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBCOMP;
 		err_code = publish_complete_decode(buf, &evt.param.pubcomp);
 		evt.result = err_code;
+
+		if (err_code == 0) {
+			mqtt_inflight_remove(client,
+					     evt.param.pubcomp.message_id);
+		}
+
 		break;
 
 	case MQTT_PKT_TYPE_SUBACK:
@@ -43,6 +43,9 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #define FRAME_TYPE_MASK 0x07
 #define FRAME_TYPE_ACK 0x02
 
+#define OT_RADIO_TX_STACK_SIZE CONFIG_OPENTHREAD_RADIO_TX_STACK_SIZE
+#define OT_RADIO_TX_PRIORITY K_PRIO_COOP(CONFIG_OPENTHREAD_THREAD_PRIORITY)
+
 static otRadioState sState = OT_RADIO_STATE_DISABLED;
 
 static otRadioFrame sTransmitFrame;
@@ -58,6 +61,17 @@ static struct ieee802154_radio_api *radio_api;
 static s8_t tx_power;
 static u16_t channel;
 
+/* The radio driver transmits synchronously, waiting for the CCA, the frame
+ * and its ACK. This is done on a work queue of its own so that the
+ * OpenThread thread keeps processing tasklets meanwhile, the result being
+ * reported from platformRadioProcess() once the work is done.
+ */
+K_THREAD_STACK_DEFINE(tx_stack_area, OT_RADIO_TX_STACK_SIZE);
+static struct k_work_q tx_work_q;
+static struct k_work tx_work;
+static atomic_t tx_done;
+static otError tx_result;
+
 enum net_verdict ieee802154_radio_handle_ack(struct net_if *iface,
 					     struct net_pkt *pkt)
 {
@@ -90,6 +104,31 @@ enum net_verdict ieee802154_radio_handle_ack(struct net_if *iface,
 	return NET_OK;
 }
 
+static void tx_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	otError result = OT_ERROR_NONE;
+
+	radio_api->set_channel(radio_dev, sTransmitFrame.mChannel);
+	radio_api->set_txpower(radio_dev, tx_power);
+
+	if (sTransmitFrame.mInfo.mTxInfo.mCsmaCaEnabled) {
+		if (radio_api->cca(radio_dev) ||
+		    radio_api->tx(radio_dev, tx_pkt, tx_payload)) {
+			result = OT_ERROR_CHANNEL_ACCESS_FAILURE;
+		}
+	} else {
+		if (radio_api->tx(radio_dev, tx_pkt, tx_payload)) {
+			result = OT_ERROR_CHANNEL_ACCESS_FAILURE;
+		}
+	}
+
+	tx_result = result;
+	atomic_set(&tx_done, 1);
+	otSysEventSignalPending();
+}
+
 static void dataInit(void)
 {
 	tx_pkt = net_pkt_alloc(K_NO_WAIT);
@@ -119,37 +158,18 @@ void platformRadioInit(void)
 		 & IEEE802154_HW_TX_RX_ACK,
 		 "Only radios with automatic ack handling "
 		 "are currently supported");
+
+	k_work_init(&tx_work, tx_work_handler);
+	k_work_q_start(&tx_work_q, tx_stack_area,
+		       K_THREAD_STACK_SIZEOF(tx_stack_area),
+		       OT_RADIO_TX_PRIORITY);
+	k_thread_name_set(&tx_work_q.thread, "openthread_radio_tx");
 }
 
 void platformRadioProcess(otInstance *aInstance)
 {
-	if (sState == OT_RADIO_STATE_TRANSMIT) {
-		otError result = OT_ERROR_NONE;
-
-		/*
-		 * The payload is already in tx_payload->data,
-		 * but we need to set the length field
-		 * according to sTransmitFrame.length.
-		 * We subtract the FCS size as radio driver
-		 * adds CRC and increases frame length on its own.
-		 */
-		tx_payload->len = sTransmitFrame.mLength - FCS_SIZE;
-
-		channel = sTransmitFrame.mChannel;
-
-		radio_api->set_channel(radio_dev, sTransmitFrame.mChannel);
-		radio_api->set_txpower(radio_dev, tx_power);
-
-		if (sTransmitFrame.mInfo.mTxInfo.mCsmaCaEnabled) {
-			if (radio_api->cca(radio_dev) ||
-			    radio_api->tx(radio_dev, tx_pkt, tx_payload)) {
-				result = OT_ERROR_CHANNEL_ACCESS_FAILURE;
-			}
-		} else {
-			if (radio_api->tx(radio_dev, tx_pkt, tx_payload)) {
-				result = OT_ERROR_CHANNEL_ACCESS_FAILURE;
-			}
-		}
+	if (sState == OT_RADIO_STATE_TRANSMIT && atomic_cas(&tx_done, 1, 0)) {
+		otError result = tx_result;
 
 		sState = OT_RADIO_STATE_RECEIVE;
 
@@ -286,7 +306,19 @@ otError otPlatRadioTransmit(otInstance *aInstance, otRadioFrame *aPacket)
 	if (sState == OT_RADIO_STATE_RECEIVE) {
 		error = OT_ERROR_NONE;
 		sState = OT_RADIO_STATE_TRANSMIT;
-		otSysEventSignalPending();
+
+		/*
+		 * The payload is already in tx_payload->data,
+		 * but we need to set the length field
+		 * according to sTransmitFrame.length.
+		 * We subtract the FCS size as radio driver
+		 * adds CRC and increases frame length on its own.
+		 */
+		tx_payload->len = sTransmitFrame.mLength - FCS_SIZE;
+
+		channel = sTransmitFrame.mChannel;
+
+		k_work_submit_to_queue(&tx_work_q, &tx_work);
 	}
 
 	return error;
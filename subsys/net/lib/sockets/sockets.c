@@ -6,6 +6,7 @@
 
 /* libc headers */
 #include <fcntl.h>
+#include <limits.h>
 
 /* Zephyr headers */
 #include <logging/log.h>
@@ -214,6 +215,10 @@ int z_impl_zsock_close(int sock)
 
 	NET_DBG("close: ctx=%p, fd=%d", ctx, sock);
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	zsock_epoll_obj_closed(ctx);
+#endif
+
 	return z_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_CLOSE);
 }
 
@@ -550,6 +555,55 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	return status;
 }
 
+ssize_t zsock_send_buf(int sock, struct net_buf *frags, int flags,
+		       const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	const struct socket_op_vtable *vtable;
+	s32_t timeout = K_FOREVER;
+	struct net_context *ctx;
+	int status;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL || vtable != &sock_fd_op_vtable) {
+		if (ctx != NULL) {
+			errno = EOPNOTSUPP;
+		}
+
+		if (frags) {
+			net_buf_unref(frags);
+		}
+
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	/* Register the callback before sending in order to receive the response
+	 * from the peer.
+	 */
+	status = net_context_recv(ctx, zsock_received_cb,
+				  K_NO_WAIT, ctx->user_data);
+	if (status < 0) {
+		if (frags) {
+			net_buf_unref(frags);
+		}
+
+		errno = -status;
+		return -1;
+	}
+
+	status = net_context_send_buf(ctx, frags, dest_addr, addrlen, NULL,
+				      timeout, ctx->user_data);
+	if (status < 0) {
+		errno = -status;
+		return -1;
+	}
+
+	return status;
+}
+
 ssize_t z_impl_zsock_sendto(int sock, const void *buf, size_t len, int flags,
 			   const struct sockaddr *dest_addr, socklen_t addrlen)
 {
@@ -715,6 +769,32 @@ error:
 	return ret;
 }
 
+/* As sock_get_pkt_src_addr(), also setting the value-result addrlen
+ * argument to the actual size of the source address.
+ */
+static int sock_get_pkt_src_addrlen(struct net_pkt *pkt,
+				    enum net_ip_protocol proto,
+				    struct sockaddr *addr,
+				    socklen_t *addrlen)
+{
+	int rv;
+
+	rv = sock_get_pkt_src_addr(pkt, proto, addr, *addrlen);
+	if (rv < 0) {
+		return rv;
+	}
+
+	if (addr->sa_family == AF_INET) {
+		*addrlen = sizeof(struct sockaddr_in);
+	} else if (addr->sa_family == AF_INET6) {
+		*addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 				       void *buf,
 				       size_t max_len,
@@ -756,24 +836,12 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 	if (src_addr && addrlen) {
 		int rv;
 
-		rv = sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
-					   src_addr, *addrlen);
+		rv = sock_get_pkt_src_addrlen(pkt, net_context_get_ip_proto(ctx),
+					      src_addr, addrlen);
 		if (rv < 0) {
 			errno = -rv;
 			return -1;
 		}
-
-		/* addrlen is a value-result argument, set to actual
-		 * size of source address
-		 */
-		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
-		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
-		} else {
-			errno = ENOTSUP;
-			return -1;
-		}
 	}
 
 	recv_len = net_pkt_remaining_data(pkt);
@@ -951,6 +1019,358 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* Look up the socket of a batch once, checking that it has the operation
+ * the batch needs.
+ */
+static void *sock_mmsg_get(int sock, const struct socket_op_vtable **vtable,
+			   bool send)
+{
+	void *ctx;
+
+	ctx = get_sock_vtable(sock, vtable);
+	if (ctx == NULL) {
+		return NULL;
+	}
+
+	if ((send && (*vtable)->sendmsg == NULL) ||
+	    (!send && (*vtable)->recvfrom == NULL)) {
+		errno = EOPNOTSUPP;
+		return NULL;
+	}
+
+	return ctx;
+}
+
+static int sock_sendmmsg(void *ctx, const struct socket_op_vtable *vtable,
+			 struct zsock_mmsghdr *msgvec, unsigned int vlen,
+			 int flags)
+{
+	unsigned int i;
+	ssize_t len;
+
+	for (i = 0; i < vlen; i++) {
+		len = vtable->sendmsg(ctx, &msgvec[i].msg_hdr, flags);
+		if (len < 0) {
+			/* Report the messages sent so far, if any */
+			return i > 0 ? i : -1;
+		}
+
+		msgvec[i].msg_len = len;
+	}
+
+	return vlen;
+}
+
+int z_impl_zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	void *ctx;
+
+	ctx = sock_mmsg_get(sock, &vtable, true);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	return sock_sendmmsg(ctx, vtable, msgvec, MIN(vlen, INT_MAX), flags);
+}
+
+#ifdef CONFIG_USERSPACE
+/* Maximum number of iovecs per message from user mode */
+#define SOCK_MMSG_IOV_MAX 8
+
+static inline int z_vrfy_zsock_sendmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct iovec iov[SOCK_MMSG_IOV_MAX];
+	struct zsock_mmsghdr mmsg;
+	unsigned int i;
+	void *ctx;
+	size_t j;
+	int ret;
+
+	vlen = MIN(vlen, INT_MAX);
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(*msgvec)));
+
+	/* The messages are copied in one at a time, the socket is only
+	 * looked up once for them all.
+	 */
+	ctx = sock_mmsg_get(sock, &vtable, true);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		struct msghdr *msg = &mmsg.msg_hdr;
+
+		Z_OOPS(z_user_from_copy(&mmsg, &msgvec[i], sizeof(mmsg)));
+
+		if (msg->msg_iovlen > ARRAY_SIZE(iov)) {
+			if (i > 0) {
+				return i;
+			}
+
+			errno = EMSGSIZE;
+			return -1;
+		}
+
+		Z_OOPS(z_user_from_copy(iov, msg->msg_iov,
+					msg->msg_iovlen * sizeof(iov[0])));
+		for (j = 0; j < msg->msg_iovlen; j++) {
+			Z_OOPS(Z_SYSCALL_MEMORY_READ(iov[j].iov_base,
+						     iov[j].iov_len));
+		}
+
+		Z_OOPS(msg->msg_name &&
+		       Z_SYSCALL_MEMORY_READ(msg->msg_name,
+					     msg->msg_namelen));
+		Z_OOPS(msg->msg_control &&
+		       Z_SYSCALL_MEMORY_READ(msg->msg_control,
+					     msg->msg_controllen));
+
+		msg->msg_iov = iov;
+
+		ret = sock_sendmmsg(ctx, vtable, &mmsg, 1, flags);
+		if (ret < 0) {
+			return i > 0 ? i : ret;
+		}
+
+		msgvec[i].msg_len = mmsg.msg_len;
+	}
+
+	return vlen;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static int sock_recvmmsg(void *ctx, const struct socket_op_vtable *vtable,
+			 struct zsock_mmsghdr *msgvec, unsigned int vlen,
+			 int flags)
+{
+	unsigned int i;
+	ssize_t len;
+
+	for (i = 0; i < vlen; i++) {
+		struct msghdr *msg = &msgvec[i].msg_hdr;
+
+		if (msg->msg_iovlen != 1) {
+			if (i > 0) {
+				return i;
+			}
+
+			errno = EINVAL;
+			return -1;
+		}
+
+		len = vtable->recvfrom(ctx, msg->msg_iov[0].iov_base,
+				       msg->msg_iov[0].iov_len, flags,
+				       msg->msg_name,
+				       msg->msg_name ? &msg->msg_namelen :
+						       NULL);
+		if (len < 0) {
+			/* Report the messages received so far, if any */
+			return i > 0 ? i : -1;
+		}
+
+		msgvec[i].msg_len = len;
+		msg->msg_flags = 0;
+
+		/* Only wait for the first message */
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	return vlen;
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	void *ctx;
+
+	ctx = sock_mmsg_get(sock, &vtable, false);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	return sock_recvmmsg(ctx, vtable, msgvec, MIN(vlen, INT_MAX), flags);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct zsock_mmsghdr mmsg;
+	struct iovec iov;
+	unsigned int i;
+	void *ctx;
+	int ret;
+
+	vlen = MIN(vlen, INT_MAX);
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(*msgvec)));
+
+	ctx = sock_mmsg_get(sock, &vtable, false);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		struct msghdr *msg = &mmsg.msg_hdr;
+
+		Z_OOPS(z_user_from_copy(&mmsg, &msgvec[i], sizeof(mmsg)));
+
+		if (msg->msg_iovlen != 1) {
+			if (i > 0) {
+				return i;
+			}
+
+			errno = EINVAL;
+			return -1;
+		}
+
+		Z_OOPS(z_user_from_copy(&iov, msg->msg_iov, sizeof(iov)));
+		Z_OOPS(Z_SYSCALL_MEMORY_WRITE(iov.iov_base, iov.iov_len));
+		Z_OOPS(msg->msg_name &&
+		       Z_SYSCALL_MEMORY_WRITE(msg->msg_name,
+					      msg->msg_namelen));
+
+		msg->msg_iov = &iov;
+
+		ret = sock_recvmmsg(ctx, vtable, &mmsg, 1, flags);
+		if (ret < 0) {
+			return i > 0 ? i : ret;
+		}
+
+		msgvec[i].msg_len = mmsg.msg_len;
+		msgvec[i].msg_hdr.msg_namelen = msg->msg_namelen;
+		msgvec[i].msg_hdr.msg_flags = msg->msg_flags;
+
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	return vlen;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+/* Detach the unread data of a packet, i.e. from its cursor on, as a
+ * fragment chain of its own. The fragments already read stay with the
+ * packet.
+ */
+static struct net_buf *sock_pkt_detach_data(struct net_pkt *pkt)
+{
+	struct net_buf *frags = pkt->cursor.buf;
+	struct net_buf *prev;
+
+	if (!frags) {
+		return NULL;
+	}
+
+	if (frags == pkt->buffer) {
+		pkt->buffer = NULL;
+	} else {
+		for (prev = pkt->buffer; prev->frags != frags;
+		     prev = prev->frags) {
+		}
+
+		prev->frags = NULL;
+	}
+
+	net_buf_pull(frags, pkt->cursor.pos - frags->data);
+	net_pkt_cursor_init(pkt);
+
+	return frags;
+}
+
+ssize_t zsock_recv_buf(int sock, struct net_buf **frags, int flags,
+		       struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	const struct socket_op_vtable *vtable;
+	s32_t timeout = K_FOREVER;
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	bool stream;
+	size_t len;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	/* The data has to be in net_bufs of the native stack */
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (!frags || (flags & ZSOCK_MSG_PEEK)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	stream = net_context_get_type(ctx) == SOCK_STREAM;
+
+	do {
+		if (stream && sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		pkt = k_fifo_get(&ctx->recv_q, timeout);
+		if (!pkt) {
+			/* Either timeout expired, or wait was cancelled
+			 * due to connection closure by peer.
+			 */
+			if (stream && sock_is_eof(ctx)) {
+				return 0;
+			}
+
+			errno = EAGAIN;
+			return -1;
+		}
+
+		if (!stream && src_addr && addrlen) {
+			int rv;
+
+			rv = sock_get_pkt_src_addrlen(pkt,
+						      net_context_get_ip_proto(ctx),
+						      src_addr, addrlen);
+			if (rv < 0) {
+				net_pkt_unref(pkt);
+				errno = -rv;
+				return -1;
+			}
+		}
+
+		len = net_pkt_remaining_data(pkt);
+		*frags = len ? sock_pkt_detach_data(pkt) : NULL;
+
+		if (stream && net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		net_stats_update_tc_rx_time(net_pkt_iface(pkt),
+					    net_pkt_priority(pkt),
+					    net_pkt_timestamp(pkt)->nanosecond,
+					    k_cycle_get_32());
+
+		net_pkt_unref(pkt);
+	} while (stream && len == 0);
+
+	if (stream) {
+		net_context_update_recv_wnd(ctx, len);
+	}
+
+	return len;
+}
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -1238,6 +1658,28 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 				return 0;
 			}
+
+			break;
+
+		case SO_NET_STATS:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_STATISTICS)) {
+				if (*optlen < sizeof(struct net_stats_context)) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				ret = net_context_get_option(ctx,
+							     NET_OPT_STATS,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
 		}
 
 		break;
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <kernel.h>
+#include <errno.h>
+#include <string.h>
+#include <net/socket.h>
+#include <net/socket_async.h>
+#include <sys/fdtable.h>
+
+/* The socket readiness is waited for through a triggered work item,
+ * watching the kernel poll event the socket provides for reading. Sockets
+ * which cannot be waited for by the kernel (writable or already at EOF)
+ * raise the ready signal instead, so that the work item is run at once.
+ */
+
+static int async_prepare(struct zsock_async *async, int *num_events)
+{
+	const struct fd_op_vtable *vtable;
+	struct k_poll_event *pev = async->events;
+	struct zsock_pollfd pfd = {
+		.fd = async->fd,
+		.events = async->wanted,
+	};
+	bool ready = (async->wanted & ZSOCK_POLLOUT) != 0;
+	void *obj;
+
+	obj = z_get_fd_obj_and_vtable(async->fd, &vtable);
+	if (obj == NULL) {
+		return -1;
+	}
+
+	(void)memset(async->events, 0, sizeof(async->events));
+
+	if (z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_PREPARE, &pfd,
+				 &pev, &async->events[1]) < 0) {
+		if (errno != EALREADY) {
+			return -1;
+		}
+
+		ready = true;
+	}
+
+	k_poll_signal_reset(&async->ready);
+	k_poll_event_init(pev, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+			  &async->ready);
+	if (ready) {
+		k_poll_signal_raise(&async->ready, 0);
+	}
+
+	*num_events = pev - async->events + 1;
+
+	return 0;
+}
+
+/* Returns the ready events, 0 if the socket event fired without anything
+ * for the user
+ */
+static int async_update(struct zsock_async *async)
+{
+	const struct fd_op_vtable *vtable;
+	struct k_poll_event *pev = async->events;
+	struct zsock_pollfd pfd = {
+		.fd = async->fd,
+		.events = async->wanted,
+	};
+	void *obj;
+
+	obj = z_get_fd_obj_and_vtable(async->fd, &vtable);
+	if (obj == NULL) {
+		return ZSOCK_POLLNVAL;
+	}
+
+	if (z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_UPDATE, &pfd,
+				 &pev) < 0) {
+		return (errno == EAGAIN) ? 0 : ZSOCK_POLLERR;
+	}
+
+	return pfd.revents;
+}
+
+static void async_work_handler(struct k_work *work)
+{
+	struct zsock_async *async =
+		CONTAINER_OF(work, struct zsock_async, work.work);
+	int revents = 0;
+	int num_events;
+
+	if (async->work.poll_result == 0) {
+		revents = async_update(async);
+		if (revents == 0) {
+			/* Nothing for the user after all, wait again. The
+			 * timeout restarts, as it does for zsock_poll().
+			 */
+			if (async_prepare(async, &num_events) == 0 &&
+			    k_work_poll_submit_to_queue(async->work_q,
+							&async->work,
+							async->events,
+							num_events,
+							async->timeout) == 0) {
+				return;
+			}
+
+			revents = ZSOCK_POLLERR;
+		}
+	}
+
+	async->handler(async, revents);
+}
+
+void zsock_async_init(struct zsock_async *async,
+		      zsock_async_handler_t handler)
+{
+	k_work_poll_init(&async->work, async_work_handler);
+	k_poll_signal_init(&async->ready);
+	async->handler = handler;
+	async->fd = -1;
+}
+
+int zsock_async_wait(struct zsock_async *async, struct k_work_q *work_q,
+		     int fd, short events, s32_t timeout)
+{
+	int num_events, ret;
+
+	async->work_q = work_q;
+	async->timeout = timeout;
+	async->fd = fd;
+	async->wanted = events & (ZSOCK_POLLIN | ZSOCK_POLLOUT);
+
+	if (async_prepare(async, &num_events) < 0) {
+		return -1;
+	}
+
+	ret = k_work_poll_submit_to_queue(work_q, &async->work, async->events,
+					  num_events, timeout);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+int zsock_async_cancel(struct zsock_async *async)
+{
+	return k_work_poll_cancel(&async->work);
+}
@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <kernel.h>
+#include <errno.h>
+#include <string.h>
+#include <net/socket.h>
+#include <sys/fdtable.h>
+
+#include "sockets_internal.h"
+
+struct epoll_item {
+	void *obj;
+	const struct fd_op_vtable *vtable;
+	struct zsock_epoll_event event;
+	/* Reported without waiting, e.g. at EOF */
+	bool ready;
+};
+
+/* The kernel poll events are kept for the lifetime of the instance,
+ * poll_events[0] is the wake signal and poll_events[i + 1] belongs to
+ * items[i]. Sockets which do not wait for EPOLLIN keep an ignored event
+ * so that both arrays stay in sync.
+ */
+struct epoll_instance {
+	struct k_mutex lock;
+	struct k_poll_signal wake;
+	struct epoll_item items[CONFIG_NET_SOCKETS_EPOLL_MAX_FDS];
+	struct k_poll_event poll_events[CONFIG_NET_SOCKETS_EPOLL_MAX_FDS + 1];
+	int count;
+	bool in_use;
+};
+
+static struct epoll_instance epoll_instances[CONFIG_NET_SOCKETS_EPOLL_MAX];
+static K_MUTEX_DEFINE(epoll_lock);
+
+static const struct fd_op_vtable epoll_fd_op_vtable;
+
+static struct k_poll_event *epoll_event(struct epoll_instance *ep,
+					struct epoll_item *item)
+{
+	return &ep->poll_events[1 + (item - ep->items)];
+}
+
+/* Takes the instance lock, out of a waiter blocked in k_poll() first */
+static void epoll_lock_wake(struct epoll_instance *ep)
+{
+	k_poll_signal_raise(&ep->wake, 0);
+	k_mutex_lock(&ep->lock, K_FOREVER);
+}
+
+static struct epoll_item *epoll_find(struct epoll_instance *ep, void *obj)
+{
+	int i;
+
+	for (i = 0; i < ep->count; i++) {
+		if (ep->items[i].obj == obj) {
+			return &ep->items[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void epoll_remove(struct epoll_instance *ep, struct epoll_item *item)
+{
+	int i = item - ep->items;
+
+	ep->count--;
+
+	if (i != ep->count) {
+		ep->items[i] = ep->items[ep->count];
+		*epoll_event(ep, item) = *epoll_event(ep, &ep->items[ep->count]);
+	}
+}
+
+/* Let the socket fill in its kernel poll event, EALREADY means that the
+ * socket is already at EOF and is reported on the next wait.
+ */
+static int epoll_prepare(struct epoll_instance *ep, struct epoll_item *item)
+{
+	struct k_poll_event *pev = epoll_event(ep, item);
+	struct zsock_pollfd pfd = {
+		.events = item->event.events & (ZSOCK_POLLIN | ZSOCK_POLLOUT),
+	};
+
+	memset(pev, 0, sizeof(*pev));
+	pev->type = K_POLL_TYPE_IGNORE;
+	pev->mode = K_POLL_MODE_NOTIFY_ONLY;
+	pev->state = K_POLL_STATE_NOT_READY;
+
+	item->ready = false;
+
+	if (z_fdtable_call_ioctl(item->vtable, item->obj,
+				 ZFD_IOCTL_POLL_PREPARE, &pfd, &pev,
+				 pev + 1) < 0) {
+		if (errno != EALREADY) {
+			return -1;
+		}
+
+		item->ready = true;
+	}
+
+	return 0;
+}
+
+int zsock_epoll_create(int size)
+{
+	struct epoll_instance *ep = NULL;
+	int fd, i;
+
+	if (size <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(epoll_instances); i++) {
+		if (!epoll_instances[i].in_use) {
+			ep = &epoll_instances[i];
+			k_mutex_init(&ep->lock);
+			k_poll_signal_init(&ep->wake);
+			k_poll_event_init(&ep->poll_events[0],
+					  K_POLL_TYPE_SIGNAL,
+					  K_POLL_MODE_NOTIFY_ONLY, &ep->wake);
+			ep->count = 0;
+			ep->in_use = true;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&epoll_lock);
+
+	if (ep == NULL) {
+		z_free_fd(fd);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	z_finalize_fd(fd, ep, &epoll_fd_op_vtable);
+
+	NET_DBG("epoll: ep=%p, fd=%d", ep, fd);
+
+	return fd;
+}
+
+int zsock_epoll_ctl(int epfd, int op, int fd, struct zsock_epoll_event *event)
+{
+	const struct fd_op_vtable *vtable;
+	struct epoll_instance *ep;
+	struct epoll_item *item;
+	void *obj;
+	int ret = 0;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	obj = z_get_fd_obj_and_vtable(fd, &vtable);
+	if (obj == NULL) {
+		return -1;
+	}
+
+	if (vtable == &epoll_fd_op_vtable ||
+	    (op != ZSOCK_EPOLL_CTL_DEL && event == NULL)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	epoll_lock_wake(ep);
+
+	item = epoll_find(ep, obj);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		if (item != NULL) {
+			errno = EEXIST;
+			ret = -1;
+			break;
+		}
+
+		if (ep->count == ARRAY_SIZE(ep->items)) {
+			errno = ENOSPC;
+			ret = -1;
+			break;
+		}
+
+		item = &ep->items[ep->count++];
+		item->obj = obj;
+		item->vtable = vtable;
+		item->event = *event;
+
+		ret = epoll_prepare(ep, item);
+		if (ret < 0) {
+			epoll_remove(ep, item);
+		}
+
+		break;
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		if (item == NULL) {
+			errno = ENOENT;
+			ret = -1;
+			break;
+		}
+
+		item->event = *event;
+
+		ret = epoll_prepare(ep, item);
+		if (ret < 0) {
+			epoll_remove(ep, item);
+		}
+
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		if (item == NULL) {
+			errno = ENOENT;
+			ret = -1;
+			break;
+		}
+
+		epoll_remove(ep, item);
+		break;
+
+	default:
+		errno = EINVAL;
+		ret = -1;
+		break;
+	}
+
+	k_mutex_unlock(&ep->lock);
+
+	return ret;
+}
+
+/* Only called for the sockets whose event fired, or which cannot be
+ * waited for by the kernel: writable or already at EOF sockets. The
+ * event is prepared again afterwards, which also tells whether the
+ * socket is still to be reported without waiting.
+ */
+static int epoll_update(struct epoll_instance *ep, struct epoll_item *item,
+			struct zsock_epoll_event *event)
+{
+	struct k_poll_event *pev = epoll_event(ep, item);
+	struct zsock_pollfd pfd = {
+		.events = item->event.events & (ZSOCK_POLLIN | ZSOCK_POLLOUT),
+	};
+
+	if (z_fdtable_call_ioctl(item->vtable, item->obj,
+				 ZFD_IOCTL_POLL_UPDATE, &pfd, &pev) < 0) {
+		/* EAGAIN, the event fired without data for the user */
+		pfd.revents = 0;
+	}
+
+	(void)epoll_prepare(ep, item);
+
+	if (pfd.revents == 0) {
+		return 0;
+	}
+
+	event->events = pfd.revents;
+	event->data = item->event.data;
+
+	return 1;
+}
+
+static bool epoll_item_is_pending(struct epoll_instance *ep,
+				  struct epoll_item *item)
+{
+	return (item->event.events & ZSOCK_EPOLLOUT) || item->ready ||
+		epoll_event(ep, item)->state != K_POLL_STATE_NOT_READY;
+}
+
+int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+		     int maxevents, int timeout)
+{
+	u32_t entry_time = k_uptime_get_32();
+	struct epoll_instance *ep;
+	int ret, i, remaining_time;
+	bool pending;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (timeout < 0) {
+		timeout = K_FOREVER;
+	}
+
+	k_mutex_lock(&ep->lock, K_FOREVER);
+
+	remaining_time = timeout;
+
+	do {
+		pending = false;
+
+		for (i = 0; i < ep->count && !pending; i++) {
+			pending = epoll_item_is_pending(ep, &ep->items[i]);
+		}
+
+		ret = k_poll(ep->poll_events, ep->count + 1,
+			     pending ? K_NO_WAIT : remaining_time);
+		/* EAGAIN when timeout expired, EINTR when cancelled (i.e. EOF) */
+		if (ret != 0 && ret != -EAGAIN && ret != -EINTR) {
+			k_mutex_unlock(&ep->lock);
+			errno = -ret;
+			return -1;
+		}
+
+		/* Let epoll_ctl() or a close waiting on the lock in, the
+		 * mutex is handed over to it on unlock.
+		 */
+		if (ep->poll_events[0].state != K_POLL_STATE_NOT_READY) {
+			k_poll_signal_reset(&ep->wake);
+			ep->poll_events[0].state = K_POLL_STATE_NOT_READY;
+			k_mutex_unlock(&ep->lock);
+			k_mutex_lock(&ep->lock, K_FOREVER);
+		}
+
+		ret = 0;
+
+		for (i = 0; i < ep->count && ret < maxevents; i++) {
+			struct epoll_item *item = &ep->items[i];
+
+			if (epoll_item_is_pending(ep, item)) {
+				ret += epoll_update(ep, item, &events[ret]);
+			}
+		}
+
+		if (ret > 0 || timeout == K_NO_WAIT) {
+			break;
+		}
+
+		if (timeout != K_FOREVER) {
+			u32_t elapsed = k_uptime_get_32() - entry_time;
+
+			remaining_time = timeout - elapsed;
+		}
+	} while (timeout == K_FOREVER || remaining_time > 0);
+
+	k_mutex_unlock(&ep->lock);
+
+	return ret;
+}
+
+void zsock_epoll_obj_closed(void *obj)
+{
+	struct epoll_item *item;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(epoll_instances); i++) {
+		struct epoll_instance *ep = &epoll_instances[i];
+
+		if (!ep->in_use || ep == obj) {
+			continue;
+		}
+
+		epoll_lock_wake(ep);
+
+		item = epoll_find(ep, obj);
+		if (item != NULL) {
+			epoll_remove(ep, item);
+		}
+
+		k_mutex_unlock(&ep->lock);
+	}
+}
+
+static int epoll_ioctl_vmeth(void *obj, unsigned int request, va_list args)
+{
+	struct epoll_instance *ep = obj;
+
+	ARG_UNUSED(args);
+
+	switch (request) {
+	case ZFD_IOCTL_CLOSE:
+		k_mutex_lock(&epoll_lock, K_FOREVER);
+		ep->count = 0;
+		ep->in_use = false;
+		k_mutex_unlock(&epoll_lock);
+
+		return 0;
+
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+static ssize_t epoll_read_vmeth(void *obj, void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write_vmeth(void *obj, const void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static const struct fd_op_vtable epoll_fd_op_vtable = {
+	.read = epoll_read_vmeth,
+	.write = epoll_write_vmeth,
+	.ioctl = epoll_ioctl_vmeth,
+};
@@ -48,4 +48,9 @@ struct socket_op_vtable {
 	ssize_t (*sendmsg)(void *obj, const struct msghdr *msg, int flags);
 };
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+/* Remove a closed socket from the epoll instances it is registered in */
+void zsock_epoll_obj_closed(void *obj);
+#endif
+
 #endif /* _SOCKETS_INTERNAL_H_ */
@@ -36,6 +36,219 @@ static inline int k_fifo_wait_non_empty(struct k_fifo *fifo, int32_t timeout)
 	return k_poll(events, ARRAY_SIZE(events), timeout);
 }
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_RING)
+struct packet_ring {
+	struct net_context *ctx;
+	u8_t *buf;
+	u32_t frame_size;
+	u32_t frame_nr;
+	/* Next frame to fill */
+	u32_t head;
+	bool losing;
+	struct k_poll_signal ready;
+};
+
+static struct packet_ring rings[CONFIG_NET_SOCKETS_PACKET_RING_COUNT];
+static K_MUTEX_DEFINE(rings_lock);
+
+static struct packet_ring *ring_find(struct net_context *ctx)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(rings); i++) {
+		if (rings[i].ctx == ctx) {
+			return &rings[i];
+		}
+	}
+
+	return NULL;
+}
+
+static inline struct zsock_tpacket_hdr *ring_frame(struct packet_ring *ring,
+						   u32_t idx)
+{
+	return (struct zsock_tpacket_hdr *)(ring->buf + idx * ring->frame_size);
+}
+
+/* The application still owns the last filled frame */
+static bool ring_readable(struct packet_ring *ring)
+{
+	u32_t last = (ring->head ? ring->head : ring->frame_nr) - 1;
+
+	return atomic_get(&ring_frame(ring, last)->tp_status) &
+		ZSOCK_TP_STATUS_USER;
+}
+
+static int ring_setup(struct net_context *ctx,
+		      const struct zsock_tpacket_req *req)
+{
+	struct packet_ring *ring;
+	u32_t i;
+
+	if (req->tp_frame_nr && (!req->tp_buf ||
+	    req->tp_frame_size <= ZSOCK_TPACKET_HDRLEN ||
+	    req->tp_frame_size % ZSOCK_TPACKET_ALIGNMENT ||
+	    (uintptr_t)req->tp_buf % ZSOCK_TPACKET_ALIGNMENT)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&rings_lock, K_FOREVER);
+
+	ring = ring_find(ctx);
+	if (!req->tp_frame_nr) {
+		if (ring) {
+			ring->ctx = NULL;
+		}
+
+		k_mutex_unlock(&rings_lock);
+		return 0;
+	}
+
+	if (!ring) {
+		ring = ring_find(NULL);
+		if (!ring) {
+			k_mutex_unlock(&rings_lock);
+			return -ENOMEM;
+		}
+	}
+
+	ring->ctx = ctx;
+	ring->buf = req->tp_buf;
+	ring->frame_size = req->tp_frame_size;
+	ring->frame_nr = req->tp_frame_nr;
+	ring->head = 0U;
+	ring->losing = false;
+	k_poll_signal_init(&ring->ready);
+
+	for (i = 0U; i < ring->frame_nr; i++) {
+		atomic_set(&ring_frame(ring, i)->tp_status,
+			   ZSOCK_TP_STATUS_KERNEL);
+	}
+
+	k_mutex_unlock(&rings_lock);
+
+	return 0;
+}
+
+/* Stores the packet in the ring of the socket, if it has one, which then
+ * consumes the packet even if it does not fit.
+ */
+static bool ring_put(struct net_context *ctx, struct net_pkt *pkt)
+{
+	struct zsock_tpacket_hdr *hdr;
+	struct packet_ring *ring;
+	size_t len, snaplen;
+
+	k_mutex_lock(&rings_lock, K_FOREVER);
+
+	ring = ring_find(ctx);
+	if (!ring) {
+		k_mutex_unlock(&rings_lock);
+		return false;
+	}
+
+	hdr = ring_frame(ring, ring->head);
+	if (atomic_get(&hdr->tp_status) != ZSOCK_TP_STATUS_KERNEL) {
+		NET_DBG("Ring of ctx %p is full", ctx);
+		ring->losing = true;
+		goto out;
+	}
+
+	len = net_pkt_get_len(pkt);
+	snaplen = MIN(len, ring->frame_size - ZSOCK_TPACKET_HDRLEN);
+
+	net_pkt_cursor_init(pkt);
+	if (net_pkt_read(pkt, (u8_t *)hdr + ZSOCK_TPACKET_HDRLEN, snaplen)) {
+		ring->losing = true;
+		goto out;
+	}
+
+	hdr->tp_len = len;
+	hdr->tp_snaplen = snaplen;
+	hdr->tp_mac = ZSOCK_TPACKET_HDRLEN;
+	hdr->tp_ifindex = net_if_get_by_iface(net_pkt_iface(pkt));
+
+#if defined(CONFIG_NET_PKT_TIMESTAMP)
+	hdr->tp_sec = net_pkt_timestamp(pkt)->second;
+	hdr->tp_usec = net_pkt_timestamp(pkt)->nanosecond / NSEC_PER_USEC;
+#else
+	{
+		s64_t now = k_uptime_get();
+
+		hdr->tp_sec = now / MSEC_PER_SEC;
+		hdr->tp_usec = (now % MSEC_PER_SEC) * USEC_PER_MSEC;
+	}
+#endif
+
+	/* Hands the frame over, the data being written */
+	atomic_set(&hdr->tp_status, ZSOCK_TP_STATUS_USER |
+		   (ring->losing ? ZSOCK_TP_STATUS_LOSING : 0));
+
+	ring->losing = false;
+	ring->head = (ring->head + 1U) % ring->frame_nr;
+
+	k_poll_signal_raise(&ring->ready, 0);
+
+out:
+	k_mutex_unlock(&rings_lock);
+
+	net_pkt_unref(pkt);
+
+	return true;
+}
+
+static int ring_poll_prepare(struct packet_ring *ring,
+			     struct zsock_pollfd *pfd,
+			     struct k_poll_event **pev,
+			     struct k_poll_event *pev_end)
+{
+	if (!(pfd->events & ZSOCK_POLLIN)) {
+		return 0;
+	}
+
+	if (*pev == pev_end) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	/* Reset before checking, so that a frame filled in between still
+	 * raises the signal.
+	 */
+	k_poll_signal_reset(&ring->ready);
+
+	(*pev)->obj = &ring->ready;
+	(*pev)->type = K_POLL_TYPE_SIGNAL;
+	(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+	(*pev)->state = K_POLL_STATE_NOT_READY;
+	(*pev)++;
+
+	if (ring_readable(ring)) {
+		errno = EALREADY;
+		return -1;
+	}
+
+	return 0;
+}
+
+static int ring_poll_update(struct packet_ring *ring,
+			    struct zsock_pollfd *pfd,
+			    struct k_poll_event **pev)
+{
+	if (pfd->events & ZSOCK_POLLOUT) {
+		pfd->revents |= ZSOCK_POLLOUT;
+	}
+
+	if (pfd->events & ZSOCK_POLLIN) {
+		if (ring_readable(ring)) {
+			pfd->revents |= ZSOCK_POLLIN;
+		}
+		(*pev)++;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_PACKET_RING */
+
 static int zpacket_socket(int family, int type, int proto)
 {
 	struct net_context *ctx;
@@ -109,6 +322,12 @@ static void zpacket_received_cb(struct net_context *ctx,
 		return;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_RING)
+	if (ring_put(ctx, pkt)) {
+		return;
+	}
+#endif
+
 	/* Normal packet */
 	net_pkt_set_eof(pkt, false);
 
@@ -246,6 +465,25 @@ int zpacket_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 int zpacket_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			const void *optval, socklen_t optlen)
 {
+#if defined(CONFIG_NET_SOCKETS_PACKET_RING)
+	if (level == SOL_PACKET && optname == PACKET_RX_RING) {
+		int ret;
+
+		if (!optval || optlen != sizeof(struct zsock_tpacket_req)) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		ret = ring_setup(ctx, optval);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+
+		return 0;
+	}
+#endif
+
 	return sock_fd_op_vtable.setsockopt(ctx, level, optname,
 					    optval, optlen);
 }
@@ -264,6 +502,39 @@ static ssize_t packet_sock_write_vmeth(void *obj, const void *buffer,
 static int packet_sock_ioctl_vmeth(void *obj, unsigned int request,
 				   va_list args)
 {
+#if defined(CONFIG_NET_SOCKETS_PACKET_RING)
+	struct packet_ring *ring;
+
+	k_mutex_lock(&rings_lock, K_FOREVER);
+	ring = ring_find(obj);
+	if (ring && request == ZFD_IOCTL_CLOSE) {
+		ring->ctx = NULL;
+	}
+	k_mutex_unlock(&rings_lock);
+
+	if (ring && request == ZFD_IOCTL_POLL_PREPARE) {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+		struct k_poll_event *pev_end;
+
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+		pev_end = va_arg(args, struct k_poll_event *);
+
+		return ring_poll_prepare(ring, pfd, pev, pev_end);
+	}
+
+	if (ring && request == ZFD_IOCTL_POLL_UPDATE) {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+
+		return ring_poll_update(ring, pfd, pev);
+	}
+#endif
+
 	return sock_fd_op_vtable.fd_vtable.ioctl(obj, request, args);
 }
 
@@ -102,6 +102,9 @@ struct tls_context {
 
 		/** DTLS role, client by default. */
 		s8_t role;
+
+		/** Information whether the session is cached for resumption. */
+		bool cache_enabled;
 	} options;
 
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
@@ -147,6 +150,26 @@ static struct tls_context tls_contexts[CONFIG_NET_SOCKETS_TLS_MAX_CONTEXTS];
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHING)
+/** A TLS client session, kept to resume it on the next connection. */
+struct tls_session_cache {
+	/** Time of the last use, 0 if the entry is free. */
+	u32_t timestamp;
+
+	/** Peer address the session was established with. */
+	struct sockaddr peer_addr;
+
+	/** mbedTLS session, with its session ID or ticket. */
+	mbedtls_ssl_session session;
+};
+
+static struct tls_session_cache
+	client_cache[CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SIZE];
+
+/* A mutex for protecting the client session cache. */
+static struct k_mutex client_cache_lock;
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_CACHING */
+
 #define IS_LISTENING(context) (net_context_get_state(context) == \
 			       NET_CONTEXT_LISTENING)
 
@@ -275,6 +298,11 @@ static int tls_init(struct device *unused)
 
 	k_mutex_init(&context_lock);
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHING)
+	(void)memset(client_cache, 0, sizeof(client_cache));
+	k_mutex_init(&client_cache_lock);
+#endif
+
 	mbedtls_ctr_drbg_init(&tls_ctr_drbg);
 
 	ret = mbedtls_ctr_drbg_seed(&tls_ctr_drbg, tls_entropy_func, dev,
@@ -753,6 +781,160 @@ exit:
 	return err;
 }
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHING)
+static const struct sockaddr *tls_session_peer_addr(struct net_context *context)
+{
+#if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
+	if (net_context_get_type(context) == SOCK_DGRAM) {
+		return &context->tls->dtls_peer_addr;
+	}
+#endif
+
+	return &context->remote;
+}
+
+static bool tls_session_addr_cmp(const struct sockaddr *addr1,
+				 const struct sockaddr *addr2)
+{
+	if (addr1->sa_family != addr2->sa_family) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr1->sa_family == AF_INET6) {
+		return net_sin6(addr1)->sin6_port == net_sin6(addr2)->sin6_port &&
+			net_ipv6_addr_cmp(&net_sin6(addr1)->sin6_addr,
+					  &net_sin6(addr2)->sin6_addr);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && addr1->sa_family == AF_INET) {
+		return net_sin(addr1)->sin_port == net_sin(addr2)->sin_port &&
+			net_ipv4_addr_cmp(&net_sin(addr1)->sin_addr,
+					  &net_sin(addr2)->sin_addr);
+	}
+
+	return false;
+}
+
+static struct tls_session_cache *tls_session_find(struct net_context *context)
+{
+	const struct sockaddr *peer_addr = tls_session_peer_addr(context);
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(client_cache); i++) {
+		if (client_cache[i].timestamp != 0U &&
+		    tls_session_addr_cmp(&client_cache[i].peer_addr,
+					 peer_addr)) {
+			return &client_cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void tls_session_free(struct tls_session_cache *entry)
+{
+	mbedtls_ssl_session_free(&entry->session);
+	entry->timestamp = 0U;
+}
+
+/* Offer the cached session of the peer, if any, in the next handshake. */
+static void tls_session_restore(struct net_context *context)
+{
+	struct tls_session_cache *entry;
+
+	if (!context->tls->options.cache_enabled) {
+		return;
+	}
+
+	k_mutex_lock(&client_cache_lock, K_FOREVER);
+
+	entry = tls_session_find(context);
+	if (entry != NULL) {
+		if (mbedtls_ssl_set_session(&context->tls->ssl,
+					    &entry->session) == 0) {
+			entry->timestamp = k_uptime_get_32() | 1U;
+		} else {
+			tls_session_free(entry);
+		}
+	}
+
+	k_mutex_unlock(&client_cache_lock);
+}
+
+/* Store the session of a completed client handshake, replacing the peer
+ * entry or the least recently used one.
+ */
+static void tls_session_store(struct net_context *context)
+{
+	struct tls_session_cache *entry;
+	int i;
+
+	if (!context->tls->options.cache_enabled ||
+	    context->tls->config.endpoint != MBEDTLS_SSL_IS_CLIENT) {
+		return;
+	}
+
+	k_mutex_lock(&client_cache_lock, K_FOREVER);
+
+	entry = tls_session_find(context);
+	if (entry == NULL) {
+		entry = &client_cache[0];
+
+		for (i = 0; i < ARRAY_SIZE(client_cache); i++) {
+			if (client_cache[i].timestamp == 0U) {
+				entry = &client_cache[i];
+				break;
+			}
+
+			if ((s32_t)(client_cache[i].timestamp -
+				    entry->timestamp) < 0) {
+				entry = &client_cache[i];
+			}
+		}
+	}
+
+	if (entry->timestamp != 0U) {
+		tls_session_free(entry);
+	}
+
+	mbedtls_ssl_session_init(&entry->session);
+
+	if (mbedtls_ssl_get_session(&context->tls->ssl,
+				    &entry->session) == 0) {
+		memcpy(&entry->peer_addr, tls_session_peer_addr(context),
+		       sizeof(entry->peer_addr));
+		entry->timestamp = k_uptime_get_32() | 1U;
+	} else {
+		mbedtls_ssl_session_free(&entry->session);
+	}
+
+	k_mutex_unlock(&client_cache_lock);
+}
+
+/* Do not offer a session again to a peer that failed the handshake. */
+static void tls_session_purge(struct net_context *context)
+{
+	struct tls_session_cache *entry;
+
+	if (!context->tls->options.cache_enabled) {
+		return;
+	}
+
+	k_mutex_lock(&client_cache_lock, K_FOREVER);
+
+	entry = tls_session_find(context);
+	if (entry != NULL) {
+		tls_session_free(entry);
+	}
+
+	k_mutex_unlock(&client_cache_lock);
+}
+#else
+#define tls_session_restore(...)
+#define tls_session_store(...)
+#define tls_session_purge(...)
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_CACHING */
+
 static int tls_mbedtls_reset(struct net_context *context)
 {
 	int ret;
@@ -799,12 +981,14 @@ static int tls_mbedtls_handshake(struct net_context *context, bool block)
 		}
 
 		NET_ERR("TLS handshake error: -%x", -ret);
+		tls_session_purge(context);
 		ret = -ECONNABORTED;
 		break;
 	}
 
 	if (ret == 0) {
 		k_sem_give(&context->tls->tls_established);
+		tls_session_store(context);
 	}
 
 	return ret;
@@ -914,6 +1098,10 @@ static int tls_mbedtls_init(struct net_context *context, bool is_server)
 		return -ENOMEM;
 	}
 
+	if (!is_server) {
+		tls_session_restore(context);
+	}
+
 	context->tls->is_initialized = true;
 
 	return 0;
@@ -1107,6 +1295,48 @@ static int tls_opt_dtls_role_set(struct net_context *context,
 	return 0;
 }
 
+static int tls_opt_session_cache_set(struct net_context *context,
+				     const void *optval, socklen_t optlen)
+{
+	int *cache;
+
+	if (!optval) {
+		return -EINVAL;
+	}
+
+	if (optlen != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	if (!IS_ENABLED(CONFIG_NET_SOCKETS_TLS_SESSION_CACHING)) {
+		return -ENOTSUP;
+	}
+
+	cache = (int *)optval;
+	if (*cache != TLS_SESSION_CACHE_DISABLED &&
+	    *cache != TLS_SESSION_CACHE_ENABLED) {
+		return -EINVAL;
+	}
+
+	context->tls->options.cache_enabled =
+				(*cache == TLS_SESSION_CACHE_ENABLED);
+
+	return 0;
+}
+
+static int tls_opt_session_cache_get(struct net_context *context,
+				     void *optval, socklen_t *optlen)
+{
+	if (*optlen != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	*(int *)optval = context->tls->options.cache_enabled ?
+		TLS_SESSION_CACHE_ENABLED : TLS_SESSION_CACHE_DISABLED;
+
+	return 0;
+}
+
 static int ztls_socket(int family, int type, int proto)
 {
 	enum net_ip_protocol_secure tls_proto = 0;
@@ -1866,6 +2096,10 @@ int ztls_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 		err = tls_opt_ciphersuite_used_get(ctx, optval, optlen);
 		break;
 
+	case TLS_SESSION_CACHE:
+		err = tls_opt_session_cache_get(ctx, optval, optlen);
+		break;
+
 	default:
 		/* Unknown or write-only option. */
 		err = -ENOPROTOOPT;
@@ -1916,6 +2150,10 @@ int ztls_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 		err = tls_opt_dtls_role_set(ctx, optval, optlen);
 		break;
 
+	case TLS_SESSION_CACHE:
+		err = tls_opt_session_cache_set(ctx, optval, optlen);
+		break;
+
 	default:
 		/* Unknown or read-only option. */
 		err = -ENOPROTOOPT;
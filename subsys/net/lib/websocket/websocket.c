@@ -442,13 +442,39 @@ static int websocket_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 	return sock_fd_op_vtable.fd_vtable.ioctl(obj, request, args);
 }
 
+/* Masks or unmasks the payload in place, offset is the position of the
+ * first byte in the message as the masking key repeats every 4 bytes.
+ */
 static void websocket_mask_payload(u8_t *payload, size_t payload_len,
-				   u32_t masking_value)
+				   u32_t masking_value, u64_t offset)
 {
-	int i;
+	u8_t key[4], word_key[4];
+	u32_t word;
+	int i, n;
+
+	for (i = 0; i < sizeof(key); i++) {
+		key[i] = masking_value >> (8 * (3 - (offset + i) % 4));
+	}
+
+	/* Do the bytes before the first word boundary */
+	for (n = 0; payload_len > 0 && ((uintptr_t)payload & 0x03); n++) {
+		*payload++ ^= key[n];
+		payload_len--;
+	}
+
+	for (i = 0; i < sizeof(word_key); i++) {
+		word_key[i] = key[(n + i) % sizeof(key)];
+	}
+
+	memcpy(&word, word_key, sizeof(word));
+
+	for (; payload_len >= sizeof(word); payload_len -= sizeof(word)) {
+		*(u32_t *)payload ^= word;
+		payload += sizeof(word);
+	}
 
 	for (i = 0; i < payload_len; i++) {
-		payload[i] ^= masking_value >> (8 * (3 - i % 4));
+		payload[i] ^= word_key[i];
 	}
 }
 
@@ -479,14 +505,88 @@ static int websocket_prepare_and_send(struct websocket_context *ctx,
 		       timeout == K_NO_WAIT ? MSG_DONTWAIT : 0);
 }
 
+/* Waits until more of a partially sent frame can be written */
+static int websocket_wait_writable(struct websocket_context *ctx,
+				   s32_t timeout)
+{
+	struct pollfd fds = {
+		.fd = ctx->real_sock,
+		.events = POLLOUT,
+	};
+	int ret;
+
+	/* The frame cannot be abandoned, so K_NO_WAIT waits as well */
+	ret = poll(&fds, 1, timeout == K_NO_WAIT ? K_FOREVER : timeout);
+	if (ret < 0) {
+		return -errno;
+	}
+
+	return ret == 0 ? -ETIMEDOUT : 0;
+}
+
+/* Sends the header and the payload, masked in chunks if needed. Header and
+ * payload progress are tracked separately, as a send may stop anywhere in
+ * either of them. Once part of the frame is sent, the rest has to follow or
+ * the stream is corrupted, so a full send buffer is then waited for instead
+ * of returning -EAGAIN.
+ */
+static int websocket_send_frame(struct websocket_context *ctx,
+				u8_t *header, size_t header_len,
+				const u8_t *payload, size_t payload_len,
+				bool mask, s32_t timeout)
+{
+	u8_t chunk[CONFIG_WEBSOCKET_MASK_BUF_LEN];
+	size_t hdr_sent = 0, sent = 0, len;
+	u8_t *data;
+	int ret;
+
+	while (hdr_sent < header_len || sent < payload_len) {
+		len = payload_len - sent;
+
+		if (mask) {
+			len = MIN(len, sizeof(chunk));
+			memcpy(chunk, &payload[sent], len);
+			websocket_mask_payload(chunk, len, ctx->masking_value,
+					       sent);
+			data = chunk;
+		} else {
+			data = (u8_t *)&payload[sent];
+		}
+
+		ret = websocket_prepare_and_send(ctx, &header[hdr_sent],
+						 header_len - hdr_sent,
+						 data, len, timeout);
+		if (ret < 0) {
+			ret = -errno;
+
+			if (ret == -EAGAIN && (hdr_sent > 0 || sent > 0)) {
+				ret = websocket_wait_writable(ctx, timeout);
+				if (ret == 0) {
+					continue;
+				}
+			}
+
+			NET_DBG("Cannot send ws msg (%d)", ret);
+			return ret;
+		}
+
+		if ((size_t)ret < header_len - hdr_sent) {
+			hdr_sent += ret;
+		} else {
+			sent += ret - (header_len - hdr_sent);
+			hdr_sent = header_len;
+		}
+	}
+
+	return sent;
+}
+
 int websocket_send_msg(int ws_sock, const u8_t *payload, size_t payload_len,
 		       enum websocket_opcode opcode, bool mask, bool final,
 		       s32_t timeout)
 {
 	struct websocket_context *ctx;
 	u8_t header[MAX_HEADER_LEN], hdr_len = 2;
-	u8_t *data_to_send = (u8_t *)payload;
-	int ret;
 
 	if (opcode != WEBSOCKET_OPCODE_DATA_TEXT &&
 	    opcode != WEBSOCKET_OPCODE_DATA_BINARY &&
@@ -548,31 +648,10 @@ int websocket_send_msg(int ws_sock, const u8_t *payload, size_t payload_len,
 		header[hdr_len++] |= ctx->masking_value >> 16;
 		header[hdr_len++] |= ctx->masking_value >> 8;
 		header[hdr_len++] |= ctx->masking_value;
-
-		data_to_send = k_malloc(payload_len);
-		if (!data_to_send) {
-			return -ENOMEM;
-		}
-
-		memcpy(data_to_send, payload, payload_len);
-
-		websocket_mask_payload(data_to_send, payload_len,
-				       ctx->masking_value);
 	}
 
-	ret = websocket_prepare_and_send(ctx, header, hdr_len,
-					 data_to_send, payload_len, timeout);
-	if (ret < 0) {
-		NET_DBG("Cannot send ws msg (%d)", -errno);
-		goto quit;
-	}
-
-quit:
-	if (data_to_send != payload) {
-		k_free(data_to_send);
-	}
-
-	return ret - hdr_len;
+	return websocket_send_frame(ctx, header, hdr_len, payload, payload_len,
+				    mask, timeout);
 }
 
 static bool websocket_parse_header(u8_t *buf, size_t buf_len, bool *masked,
@@ -644,6 +723,8 @@ int websocket_recv_msg(int ws_sock, u8_t *buf, size_t buf_len,
 {
 	struct websocket_context *ctx;
 	size_t header_len, pos_to_write = 0;
+	size_t chunk_len;
+	u64_t chunk_start;
 	int recv_len = 0;
 	int ret;
 
@@ -759,6 +840,8 @@ int websocket_recv_msg(int ws_sock, u8_t *buf, size_t buf_len,
 		ctx->pos = 0;
 	}
 
+	chunk_len = pos_to_write;
+
 	if (ctx->total_read < ctx->message_len) {
 		if (ctx->tmp_buf_len > 0) {
 			NET_DBG("Using %zd bytes from tmp buf",
@@ -783,12 +866,18 @@ int websocket_recv_msg(int ws_sock, u8_t *buf, size_t buf_len,
 
 		ctx->total_read += recv_len;
 		recv_len += pos_to_write;
+		chunk_len = recv_len;
 	}
 
-	/* Unmask the data */
-	if (ctx->masked) {
-		websocket_mask_payload(buf, ctx->total_read,
-				       ctx->masking_value);
+	/* Unmask in place the message data read by this call, the data of
+	 * a next message is left as is.
+	 */
+	chunk_start = ctx->total_read - chunk_len;
+
+	if (ctx->masked && chunk_start < ctx->message_len) {
+		websocket_mask_payload(buf, MIN(chunk_len,
+					       ctx->message_len - chunk_start),
+				       ctx->masking_value, chunk_start);
 	}
 
 #if HEXDUMP_RECV_PACKETS
@@ -17,6 +17,73 @@ LOG_MODULE_DECLARE(power);
 #define DEVICE_PM_SYNC			(0 << 0)
 #define DEVICE_PM_ASYNC			(1 << 0)
 
+static void device_pm_notify(struct device_pm *pm, int status)
+{
+	struct device_pm_async *req;
+	sys_snode_t *node;
+	k_spinlock_key_t key;
+
+	for (;;) {
+		key = k_spin_lock(&pm->notify_lock);
+		node = sys_slist_get(&pm->notify);
+		k_spin_unlock(&pm->notify_lock, key);
+
+		if (node == NULL) {
+			break;
+		}
+
+		req = CONTAINER_OF(node, struct device_pm_async, node);
+		req->handler(pm->dev, status, req);
+	}
+}
+
+static void device_pm_parent_resumed(struct device *parent, int status,
+				     struct device_pm_async *req)
+{
+	struct device_pm *pm = CONTAINER_OF(req, struct device_pm, parent_req);
+
+	if (status != 0) {
+		LOG_ERR("Parent %s of %s failed to resume",
+			parent->config->name, pm->dev->config->name);
+
+		/* Child stays suspended, next request retries the parent */
+		pm->parent_held = false;
+		(void)device_pm_put(parent);
+
+		device_pm_notify(pm, status);
+		k_poll_signal_raise(&pm->signal, DEVICE_PM_SUSPEND_STATE);
+		return;
+	}
+
+	pm->parent_ready = true;
+	k_work_submit(&pm->work);
+}
+
+/* Takes a usage count on the parent, returns true once it is active */
+static bool device_pm_parent_get(struct device_pm *pm)
+{
+	if (pm->parent == NULL || pm->parent_ready) {
+		return true;
+	}
+
+	if (!pm->parent_held) {
+		pm->parent_held = true;
+		pm->parent_req.handler = device_pm_parent_resumed;
+		(void)device_pm_get_async(pm->parent, &pm->parent_req);
+	}
+
+	return false;
+}
+
+static void device_pm_parent_put(struct device_pm *pm)
+{
+	if (pm->parent_held && pm->parent_ready) {
+		pm->parent_held = false;
+		pm->parent_ready = false;
+		(void)device_pm_put(pm->parent);
+	}
+}
+
 static void device_pm_callback(struct device *dev,
 			       int retval, void *context, void *arg)
 {
@@ -59,12 +126,17 @@ static void pm_work_handler(struct k_work *work)
 	case DEVICE_PM_FSM_STATE_SUSPENDED:
 		if ((atomic_get(&dev->config->pm->usage) > 0) ||
 					!dev->config->pm->enable) {
+			if (!device_pm_parent_get(pm)) {
+				/* Resumed once notified the parent is active */
+				break;
+			}
 			atomic_set(&dev->config->pm->fsm_state,
 					DEVICE_PM_FSM_STATE_RESUMING);
 			ret = device_set_power_state(dev,
 						DEVICE_PM_ACTIVE_STATE,
 						device_pm_callback, NULL);
 		} else {
+			device_pm_parent_put(pm);
 			pm_state = DEVICE_PM_SUSPEND_STATE;
 			goto fsm_out;
 		}
@@ -79,12 +151,28 @@ static void pm_work_handler(struct k_work *work)
 
 	__ASSERT(ret == 0, "Set Power state error");
 
+	if (ret != 0) {
+		device_pm_notify(pm, ret);
+	}
+
 	return;
 
 fsm_out:
+	if (pm_state == DEVICE_PM_ACTIVE_STATE) {
+		device_pm_notify(pm, 0);
+	}
+
 	k_poll_signal_raise(&dev->config->pm->signal, pm_state);
 }
 
+static void pm_autosuspend_handler(struct k_work *work)
+{
+	struct device_pm *pm = CONTAINER_OF(work, struct device_pm,
+					    autosuspend_work.work);
+
+	pm_work_handler(&pm->work);
+}
+
 static int device_pm_request(struct device *dev,
 			     u32_t target_state, u32_t pm_flags)
 {
@@ -98,10 +186,19 @@ static int device_pm_request(struct device *dev,
 		if (atomic_inc(&dev->config->pm->usage) < 0) {
 			return 0;
 		}
+
+		(void)k_delayed_work_cancel(&dev->config->pm->autosuspend_work);
 	} else {
 		if (atomic_dec(&dev->config->pm->usage) > 1) {
 			return 0;
 		}
+
+		if ((pm_flags & DEVICE_PM_ASYNC) &&
+		    dev->config->pm->autosuspend_delay > 0) {
+			k_delayed_work_submit(&dev->config->pm->autosuspend_work,
+				K_MSEC(dev->config->pm->autosuspend_delay));
+			return 0;
+		}
 	}
 
 	k_work_submit(&dev->config->pm->work);
@@ -136,6 +233,20 @@ int device_pm_get_sync(struct device *dev)
 	return device_pm_request(dev, DEVICE_PM_ACTIVE_STATE, 0);
 }
 
+int device_pm_get_async(struct device *dev, struct device_pm_async *req)
+{
+	struct device_pm *pm = dev->config->pm;
+	k_spinlock_key_t key;
+
+	__ASSERT(req->handler != NULL, "No completion handler");
+
+	key = k_spin_lock(&pm->notify_lock);
+	sys_slist_append(&pm->notify, &req->node);
+	k_spin_unlock(&pm->notify_lock, key);
+
+	return device_pm_request(dev, DEVICE_PM_ACTIVE_STATE, DEVICE_PM_ASYNC);
+}
+
 int device_pm_put(struct device *dev)
 {
 	return device_pm_request(dev,
@@ -161,6 +272,8 @@ void device_pm_enable(struct device *dev)
 		atomic_set(&dev->config->pm->fsm_state,
 					DEVICE_PM_FSM_STATE_SUSPENDED);
 		k_work_init(&dev->config->pm->work, pm_work_handler);
+		k_delayed_work_init(&dev->config->pm->autosuspend_work,
+				    pm_autosuspend_handler);
 	} else {
 		k_work_submit(&dev->config->pm->work);
 	}
@@ -175,3 +288,15 @@ void device_pm_disable(struct device *dev)
 	k_work_submit(&dev->config->pm->work);
 	k_sem_give(&dev->config->pm->lock);
 }
+
+void device_pm_set_autosuspend_delay(struct device *dev, u32_t delay_ms)
+{
+	dev->config->pm->autosuspend_delay = delay_ms;
+}
+
+void device_pm_set_parent(struct device *dev, struct device *parent)
+{
+	__ASSERT(!dev->config->pm->enable, "Device idle PM already enabled");
+
+	dev->config->pm->parent = parent;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2020 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <spinlock.h>
+#include <sys/dlist.h>
+#include <power/power.h>
+
+static sys_dlist_t latency_requests = SYS_DLIST_STATIC_INIT(&latency_requests);
+static struct k_spinlock latency_lock;
+
+/* Smallest latency requested, read by the policy on each idle entry */
+static u32_t latency_min = UINT32_MAX;
+
+static void latency_update_min(void)
+{
+	struct sys_pm_latency_request *req;
+	u32_t min = UINT32_MAX;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&latency_requests, req, node) {
+		min = MIN(min, req->latency_us);
+	}
+
+	latency_min = min;
+}
+
+void sys_pm_latency_request_add(struct sys_pm_latency_request *req,
+				u32_t latency_us)
+{
+	k_spinlock_key_t key = k_spin_lock(&latency_lock);
+
+	req->latency_us = latency_us;
+	sys_dlist_append(&latency_requests, &req->node);
+	latency_min = MIN(latency_min, latency_us);
+
+	k_spin_unlock(&latency_lock, key);
+}
+
+void sys_pm_latency_request_update(struct sys_pm_latency_request *req,
+				   u32_t latency_us)
+{
+	k_spinlock_key_t key = k_spin_lock(&latency_lock);
+
+	__ASSERT(sys_dnode_is_linked(&req->node), "Request not added");
+	req->latency_us = latency_us;
+	latency_update_min();
+
+	k_spin_unlock(&latency_lock, key);
+}
+
+void sys_pm_latency_request_remove(struct sys_pm_latency_request *req)
+{
+	k_spinlock_key_t key = k_spin_lock(&latency_lock);
+
+	sys_dlist_remove(&req->node);
+	latency_update_min();
+
+	k_spin_unlock(&latency_lock, key);
+}
+
+u32_t sys_pm_latency_get(void)
+{
+	return latency_min;
+}
@@ -31,8 +31,30 @@ static const unsigned int pm_min_residency[] = {
 #endif /* CONFIG_SYS_POWER_SLEEP_STATES */
 };
 
+#ifdef CONFIG_SYS_PM_LATENCY
+/* Exit latencies in microseconds, matching pm_min_residency */
+static const u32_t pm_exit_latency[] = {
+#ifdef CONFIG_SYS_POWER_SLEEP_STATES
+#ifdef CONFIG_HAS_SYS_POWER_STATE_SLEEP_1
+	CONFIG_SYS_PM_EXIT_LATENCY_SLEEP_1,
+#endif
+
+#ifdef CONFIG_HAS_SYS_POWER_STATE_SLEEP_2
+	CONFIG_SYS_PM_EXIT_LATENCY_SLEEP_2,
+#endif
+
+#ifdef CONFIG_HAS_SYS_POWER_STATE_SLEEP_3
+	CONFIG_SYS_PM_EXIT_LATENCY_SLEEP_3,
+#endif
+#endif /* CONFIG_SYS_POWER_SLEEP_STATES */
+};
+#endif /* CONFIG_SYS_PM_LATENCY */
+
 enum power_states sys_pm_policy_next_state(s32_t ticks)
 {
+#ifdef CONFIG_SYS_PM_LATENCY
+	u32_t max_latency = sys_pm_latency_get();
+#endif
 	int i;
 
 	if ((ticks != K_FOREVER) && (ticks < pm_min_residency[0])) {
@@ -45,6 +67,11 @@ enum power_states sys_pm_policy_next_state(s32_t ticks)
 		if (!sys_pm_ctrl_is_state_enabled((enum power_states)(i))) {
 			continue;
 		}
+#endif
+#ifdef CONFIG_SYS_PM_LATENCY
+		if (pm_exit_latency[i] > max_latency) {
+			continue;
+		}
 #endif
 		if ((ticks == K_FOREVER) ||
 		    (ticks >= pm_min_residency[i])) {
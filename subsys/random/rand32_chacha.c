@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* ChaCha20 based CSPRNG.
+ *
+ * Each CPU owns a generator keyed from the entropy driver, whose output is
+ * the ChaCha20 keystream. The key is replaced by keystream after every
+ * request ("fast key erasure"), so a compromised state does not reveal
+ * earlier output. Entropy for reseeding is harvested in the background,
+ * with the non-blocking ISR API of the driver, into a pool the generators
+ * draw from without ever waiting on the entropy source.
+ */
+
+#include <init.h>
+#include <device.h>
+#include <drivers/entropy.h>
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <string.h>
+#include <sys/byteorder.h>
+#include <sys/util.h>
+#include <random/rand32.h>
+
+#define CHACHA_KEY_SIZE		32
+#define CHACHA_BLOCK_SIZE	64
+#define CHACHA_ROUNDS		20
+
+struct chacha_state {
+	struct k_spinlock lock;
+	u32_t key[CHACHA_KEY_SIZE / 4];
+	u64_t counter;
+	/* Bytes generated since the last reseed */
+	u32_t generated;
+};
+
+static struct chacha_state states[CONFIG_MP_NUM_CPUS];
+
+static struct device *entropy_driver;
+
+static struct k_spinlock pool_lock;
+static u8_t pool[CONFIG_CS_CHACHA_POOL_SIZE];
+static size_t pool_len;
+static struct k_delayed_work harvest_work;
+static atomic_t harvesting;
+
+#define ROTL32(v, n) (((v) << (n)) | ((v) >> (32 - (n))))
+
+#define QUARTERROUND(a, b, c, d)			\
+	do {						\
+		a += b; d ^= a; d = ROTL32(d, 16);	\
+		c += d; b ^= c; b = ROTL32(b, 12);	\
+		a += b; d ^= a; d = ROTL32(d, 8);	\
+		c += d; b ^= c; b = ROTL32(b, 7);	\
+	} while (false)
+
+static void chacha_block(const u32_t key[8], u64_t counter,
+			 u8_t out[CHACHA_BLOCK_SIZE])
+{
+	u32_t in[16] = {
+		0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+		key[0], key[1], key[2], key[3],
+		key[4], key[5], key[6], key[7],
+		(u32_t)counter, (u32_t)(counter >> 32), 0, 0,
+	};
+	u32_t x[16];
+	int i;
+
+	memcpy(x, in, sizeof(x));
+
+	for (i = 0; i < CHACHA_ROUNDS; i += 2) {
+		QUARTERROUND(x[0], x[4], x[8], x[12]);
+		QUARTERROUND(x[1], x[5], x[9], x[13]);
+		QUARTERROUND(x[2], x[6], x[10], x[14]);
+		QUARTERROUND(x[3], x[7], x[11], x[15]);
+		QUARTERROUND(x[0], x[5], x[10], x[15]);
+		QUARTERROUND(x[1], x[6], x[11], x[12]);
+		QUARTERROUND(x[2], x[7], x[8], x[13]);
+		QUARTERROUND(x[3], x[4], x[9], x[14]);
+	}
+
+	for (i = 0; i < 16; i++) {
+		sys_put_le32(x[i] + in[i], &out[i * 4]);
+	}
+
+	memset(x, 0, sizeof(x));
+	memset(in, 0, sizeof(in));
+}
+
+static void harvest_start(void)
+{
+	if (atomic_cas(&harvesting, 0, 1)) {
+		k_delayed_work_submit(&harvest_work, K_NO_WAIT);
+	}
+}
+
+static void harvest_handler(struct k_work *work)
+{
+	u8_t buf[CONFIG_CS_CHACHA_POOL_SIZE];
+	k_spinlock_key_t key;
+	size_t len;
+	int ret;
+
+	key = k_spin_lock(&pool_lock);
+	len = sizeof(pool) - pool_len;
+	k_spin_unlock(&pool_lock, key);
+
+	/* Only takes what the driver has ready, never waits on it */
+	ret = (len > 0) ? entropy_get_entropy_isr(entropy_driver, buf, len, 0) :
+			  0;
+	if (ret == -ENOTSUP) {
+		atomic_set(&harvesting, 0);
+		return;
+	}
+
+	key = k_spin_lock(&pool_lock);
+	if (ret > 0) {
+		len = MIN((size_t)ret, sizeof(pool) - pool_len);
+		memcpy(&pool[pool_len], buf, len);
+		pool_len += len;
+	}
+	len = pool_len;
+	k_spin_unlock(&pool_lock, key);
+
+	memset(buf, 0, sizeof(buf));
+
+	if (len < sizeof(pool)) {
+		k_delayed_work_submit(&harvest_work,
+				      K_MSEC(CONFIG_CS_CHACHA_HARVEST_INTERVAL));
+	} else {
+		atomic_set(&harvesting, 0);
+	}
+}
+
+/* Takes a key worth of entropy from the pool, if available */
+static bool pool_get(u8_t seed[CHACHA_KEY_SIZE])
+{
+	k_spinlock_key_t key = k_spin_lock(&pool_lock);
+	bool ret = false;
+
+	if (pool_len >= CHACHA_KEY_SIZE) {
+		pool_len -= CHACHA_KEY_SIZE;
+		memcpy(seed, &pool[pool_len], CHACHA_KEY_SIZE);
+		memset(&pool[pool_len], 0, CHACHA_KEY_SIZE);
+		ret = true;
+	}
+
+	k_spin_unlock(&pool_lock, key);
+
+	return ret;
+}
+
+static void chacha_reseed(struct chacha_state *state)
+{
+	u8_t seed[CHACHA_KEY_SIZE];
+	int i;
+
+	if (!pool_get(seed)) {
+		/* Keep going on the current key, the pool is being refilled */
+		harvest_start();
+		return;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(state->key); i++) {
+		state->key[i] ^= sys_get_le32(&seed[i * 4]);
+	}
+
+	state->generated = 0;
+	memset(seed, 0, sizeof(seed));
+
+	harvest_start();
+}
+
+int sys_csrand_get(void *dst, size_t outlen)
+{
+	struct chacha_state *state;
+	u8_t block[CHACHA_BLOCK_SIZE];
+	u8_t *out = dst;
+	k_spinlock_key_t key;
+	size_t len;
+	int i;
+
+	if (unlikely(entropy_driver == NULL)) {
+		return -EIO;
+	}
+
+	/* Should the thread migrate before taking the lock, it merely shares
+	 * the state of another CPU for this request.
+	 */
+	state = &states[_current_cpu->id];
+	key = k_spin_lock(&state->lock);
+
+	if (state->generated >= CONFIG_CS_CHACHA_RESEED_INTERVAL) {
+		chacha_reseed(state);
+	}
+
+	/* Generate straight into the destination for whole blocks */
+	while (outlen >= CHACHA_BLOCK_SIZE) {
+		chacha_block(state->key, state->counter++, out);
+		out += CHACHA_BLOCK_SIZE;
+		outlen -= CHACHA_BLOCK_SIZE;
+		state->generated += CHACHA_BLOCK_SIZE;
+	}
+
+	chacha_block(state->key, state->counter++, block);
+	len = outlen;
+	if (len > CHACHA_BLOCK_SIZE - CHACHA_KEY_SIZE) {
+		/* The rest of the block is the next key, use a fresh one */
+		memcpy(out, block, len);
+		chacha_block(state->key, state->counter++, block);
+	} else {
+		memcpy(out, &block[CHACHA_KEY_SIZE], len);
+	}
+	state->generated += outlen;
+
+	for (i = 0; i < ARRAY_SIZE(state->key); i++) {
+		state->key[i] = sys_get_le32(&block[i * 4]);
+	}
+
+	k_spin_unlock(&state->lock, key);
+
+	memset(block, 0, sizeof(block));
+
+	return 0;
+}
+
+static int chacha_initialize(struct device *dev)
+{
+	u8_t seed[CHACHA_KEY_SIZE];
+	int i, j, ret;
+
+	dev = device_get_binding(CONFIG_ENTROPY_NAME);
+	if (!dev) {
+		return -EINVAL;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(states); i++) {
+		ret = entropy_get_entropy_isr(dev, seed, sizeof(seed),
+					      ENTROPY_BUSYWAIT);
+		if (ret != sizeof(seed)) {
+			return -EIO;
+		}
+
+		for (j = 0; j < ARRAY_SIZE(states[i].key); j++) {
+			states[i].key[j] = sys_get_le32(&seed[j * 4]);
+		}
+	}
+
+	memset(seed, 0, sizeof(seed));
+
+	k_delayed_work_init(&harvest_work, harvest_handler);
+	entropy_driver = dev;
+
+	return 0;
+}
+
+static int chacha_harvest_start(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	if (entropy_driver != NULL) {
+		harvest_start();
+	}
+
+	return 0;
+}
+
+/* In-tree entropy drivers will initialize in PRE_KERNEL_1; ensure that they're
+ * initialized properly before initializing ourselves. Harvesting needs the
+ * system work queue, which is only started in POST_KERNEL.
+ */
+SYS_INIT(chacha_initialize, PRE_KERNEL_2,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+SYS_INIT(chacha_harvest_start, POST_KERNEL,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
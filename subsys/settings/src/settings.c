@@ -24,6 +24,97 @@ sys_slist_t settings_handlers;
 
 K_MUTEX_DEFINE(settings_lock);
 
+#if defined(CONFIG_SETTINGS_HANDLER_HASH)
+/* Handlers indexed by a hash of their full name. A key is dispatched by
+ * looking up its prefixes, longest first, so the cost depends on the
+ * depth of the key and not on the number of registered handlers.
+ */
+static struct settings_handler_static *
+	settings_handler_hash[CONFIG_SETTINGS_HANDLER_HASH_SIZE];
+static bool settings_handler_hash_ready;
+
+static size_t settings_handler_hash_pos(const char *name, size_t len)
+{
+	u32_t hash = 2166136261U;
+
+	/* FNV-1a */
+	while (len--) {
+		hash ^= (u8_t)*name++;
+		hash *= 16777619U;
+	}
+
+	return hash % CONFIG_SETTINGS_HANDLER_HASH_SIZE;
+}
+
+static void settings_handler_hash_add(struct settings_handler_static *ch)
+{
+	size_t pos = settings_handler_hash_pos(ch->name, strlen(ch->name));
+
+	for (int i = 0; i < CONFIG_SETTINGS_HANDLER_HASH_SIZE; i++) {
+		if (!settings_handler_hash[pos]) {
+			settings_handler_hash[pos] = ch;
+			return;
+		}
+		pos = (pos + 1) % CONFIG_SETTINGS_HANDLER_HASH_SIZE;
+	}
+
+	LOG_WRN("Handler hash full, falling back to linear lookup");
+	settings_handler_hash_ready = false;
+}
+
+static struct settings_handler_static *
+settings_handler_hash_find(const char *name, size_t len)
+{
+	struct settings_handler_static *ch;
+	size_t pos = settings_handler_hash_pos(name, len);
+
+	for (int i = 0; i < CONFIG_SETTINGS_HANDLER_HASH_SIZE; i++) {
+		ch = settings_handler_hash[pos];
+		if (!ch) {
+			break;
+		}
+		if (!strncmp(ch->name, name, len) && (ch->name[len] == '\0')) {
+			return ch;
+		}
+		pos = (pos + 1) % CONFIG_SETTINGS_HANDLER_HASH_SIZE;
+	}
+
+	return NULL;
+}
+
+static struct settings_handler_static *
+settings_handler_hash_lookup(const char *name, const char **next)
+{
+	struct settings_handler_static *ch;
+	size_t len, end;
+
+	if (!name) {
+		return NULL;
+	}
+
+	end = 0;
+	while ((name[end] != '\0') && (name[end] != SETTINGS_NAME_END)) {
+		end++;
+	}
+
+	len = end;
+	while (len) {
+		ch = settings_handler_hash_find(name, len);
+		if (ch) {
+			if (next && (len < end)) {
+				*next = &name[len + 1];
+			}
+			return ch;
+		}
+
+		/* strip the last name segment */
+		while ((len > 0) && (name[--len] != SETTINGS_NAME_SEPARATOR)) {
+		}
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_SETTINGS_HANDLER_HASH */
 
 void settings_store_init(void);
 
@@ -32,6 +123,12 @@ void settings_init(void)
 #if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
 	sys_slist_init(&settings_handlers);
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+#if defined(CONFIG_SETTINGS_HANDLER_HASH)
+	settings_handler_hash_ready = true;
+	Z_STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
+		settings_handler_hash_add(ch);
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_HASH */
 	settings_store_init();
 }
 
@@ -57,6 +154,9 @@ int settings_register(struct settings_handler *handler)
 		}
 	}
 	sys_slist_append(&settings_handlers, &handler->node);
+#if defined(CONFIG_SETTINGS_HANDLER_HASH)
+	settings_handler_hash_add((struct settings_handler_static *)handler);
+#endif /* CONFIG_SETTINGS_HANDLER_HASH */
 	rc = 0;
 end:
 	k_mutex_unlock(&settings_lock);
@@ -146,6 +246,12 @@ struct settings_handler_static *settings_parse_and_lookup(const char *name,
 		*next = NULL;
 	}
 
+#if defined(CONFIG_SETTINGS_HANDLER_HASH)
+	if (settings_handler_hash_ready) {
+		return settings_handler_hash_lookup(name, next);
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_HASH */
+
 	Z_STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
 		if (!settings_name_steq(name, ch->name, &tmpnext)) {
 			continue;
@@ -166,6 +166,223 @@ int settings_save(void)
 	return rc;
 }
 
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+struct settings_tx_entry {
+	u16_t name_off;
+	u16_t val_off;
+	u16_t val_len;
+	bool valid;
+	bool unchanged;
+};
+
+static struct {
+	struct settings_tx_entry entries[CONFIG_SETTINGS_TRANSACTION_MAX_ENTRIES];
+	u8_t buf[CONFIG_SETTINGS_TRANSACTION_BUF_SIZE];
+	u16_t entry_cnt;
+	u16_t buf_used;
+	bool active;
+} settings_tx;
+
+static u8_t settings_tx_cmp_buf[SETTINGS_MAX_VAL_LEN];
+
+static const char *settings_tx_name(const struct settings_tx_entry *entry)
+{
+	return (const char *)&settings_tx.buf[entry->name_off];
+}
+
+int settings_transaction_begin(void)
+{
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if (settings_tx.active) {
+		k_mutex_unlock(&settings_lock);
+		return -EBUSY;
+	}
+
+	settings_tx.entry_cnt = 0U;
+	settings_tx.buf_used = 0U;
+	settings_tx.active = true;
+
+	/* settings_lock stays taken until commit or abort */
+	return 0;
+}
+
+int settings_transaction_set(const char *name, const void *value,
+			     size_t val_len)
+{
+	struct settings_tx_entry *entry;
+	size_t name_len;
+	int rc;
+
+	if (!name) {
+		return -EINVAL;
+	}
+
+	if (!value) {
+		val_len = 0;
+	}
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if (!settings_tx.active) {
+		rc = -EINVAL;
+		goto end;
+	}
+
+	name_len = strlen(name) + 1;
+	if ((settings_tx.entry_cnt == ARRAY_SIZE(settings_tx.entries)) ||
+	    (name_len + val_len >
+	     sizeof(settings_tx.buf) - settings_tx.buf_used)) {
+		rc = -ENOMEM;
+		goto end;
+	}
+
+	/* only the last value set for a name is written */
+	for (int i = 0; i < settings_tx.entry_cnt; i++) {
+		entry = &settings_tx.entries[i];
+		if (entry->valid && !strcmp(settings_tx_name(entry), name)) {
+			entry->valid = false;
+		}
+	}
+
+	entry = &settings_tx.entries[settings_tx.entry_cnt++];
+	entry->name_off = settings_tx.buf_used;
+	memcpy(&settings_tx.buf[settings_tx.buf_used], name, name_len);
+	settings_tx.buf_used += name_len;
+
+	entry->val_off = settings_tx.buf_used;
+	entry->val_len = val_len;
+	if (val_len) {
+		memcpy(&settings_tx.buf[settings_tx.buf_used], value, val_len);
+		settings_tx.buf_used += val_len;
+	}
+
+	entry->valid = true;
+	/* deleting a key which is not persisted is a no-op */
+	entry->unchanged = (val_len == 0);
+	rc = 0;
+end:
+	k_mutex_unlock(&settings_lock);
+	return rc;
+}
+
+/* Called for every persisted item. Backends may report several records
+ * for a name, oldest first, so the last match decides whether the buffered
+ * value differs from the persisted one.
+ */
+static int settings_tx_cmp_cb(const char *key, size_t len,
+			      settings_read_cb read_cb, void *cb_arg,
+			      void *param)
+{
+	struct settings_tx_entry *entry;
+	const char *next;
+	ssize_t rc;
+	bool read = false;
+
+	for (int i = 0; i < settings_tx.entry_cnt; i++) {
+		entry = &settings_tx.entries[i];
+		if (!entry->valid ||
+		    !settings_name_steq(key, settings_tx_name(entry), &next) ||
+		    next) {
+			continue;
+		}
+
+		entry->unchanged = false;
+		if ((len != entry->val_len) ||
+		    (len > sizeof(settings_tx_cmp_buf))) {
+			continue;
+		}
+
+		if (!read) {
+			rc = read_cb(cb_arg, settings_tx_cmp_buf, len);
+			if (rc != (ssize_t)len) {
+				continue;
+			}
+			read = true;
+		}
+
+		entry->unchanged = !memcmp(settings_tx_cmp_buf,
+					   &settings_tx.buf[entry->val_off],
+					   len);
+	}
+
+	return 0;
+}
+
+static void settings_tx_end(void)
+{
+	settings_tx.active = false;
+	/* release the lock taken by settings_transaction_begin() */
+	k_mutex_unlock(&settings_lock);
+}
+
+int settings_transaction_commit(void)
+{
+	struct settings_store *cs;
+	struct settings_tx_entry *entry;
+	int rc = 0;
+	int rc2;
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if (!settings_tx.active) {
+		k_mutex_unlock(&settings_lock);
+		return -EINVAL;
+	}
+
+	cs = settings_save_dst;
+	if (!cs) {
+		rc = -ENOENT;
+		goto end;
+	}
+
+	if (settings_load_subtree_direct(NULL, settings_tx_cmp_cb, NULL)) {
+		/* persisted values unknown, write everything */
+		for (int i = 0; i < settings_tx.entry_cnt; i++) {
+			settings_tx.entries[i].unchanged = false;
+		}
+	}
+
+	if (cs->cs_itf->csi_save_start) {
+		cs->cs_itf->csi_save_start(cs);
+	}
+
+	for (int i = 0; i < settings_tx.entry_cnt; i++) {
+		entry = &settings_tx.entries[i];
+		if (!entry->valid || entry->unchanged) {
+			continue;
+		}
+
+		rc2 = cs->cs_itf->csi_save(cs, settings_tx_name(entry),
+				(char *)&settings_tx.buf[entry->val_off],
+				entry->val_len);
+		if (!rc) {
+			rc = rc2;
+		}
+	}
+
+	if (cs->cs_itf->csi_save_end) {
+		cs->cs_itf->csi_save_end(cs);
+	}
+
+end:
+	k_mutex_unlock(&settings_lock);
+	settings_tx_end();
+	return rc;
+}
+
+void settings_transaction_abort(void)
+{
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if (settings_tx.active) {
+		settings_tx_end();
+	}
+
+	k_mutex_unlock(&settings_lock);
+}
+#endif /* CONFIG_SETTINGS_TRANSACTION */
+
 void settings_store_init(void)
 {
 	sys_slist_init(&settings_load_srcs);
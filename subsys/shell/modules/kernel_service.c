@@ -14,6 +14,7 @@
 #include <string.h>
 #include <device.h>
 #include <drivers/timer/system_timer.h>
+#include <timeout_q.h>
 
 static int cmd_kernel_version(const struct shell *shell,
 			      size_t argc, char **argv)
@@ -50,8 +51,23 @@ static int cmd_kernel_cycles(const struct shell *shell,
 	return 0;
 }
 
-#if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_MONITOR) \
-				&& defined(CONFIG_THREAD_STACK_INFO)
+#if (defined(CONFIG_INIT_STACKS) || defined(CONFIG_STACK_WATERMARK)) \
+	&& defined(CONFIG_THREAD_MONITOR) && defined(CONFIG_THREAD_STACK_INFO)
+static unsigned int thread_stack_unused(struct k_thread *thread)
+{
+	unsigned int size = thread->stack_info.size;
+	size_t used;
+
+	/* A painted stack gives the exact figure, prefer it */
+	if (IS_ENABLED(CONFIG_INIT_STACKS) ||
+	    k_thread_stack_watermark_get(thread, &used) != 0) {
+		return stack_unused_space_get((char *)thread->stack_info.start,
+					      size);
+	}
+
+	return size - used;
+}
+
 static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 {
 	struct k_thread *thread = (struct k_thread *)cthread;
@@ -60,7 +76,7 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	unsigned int size = thread->stack_info.size;
 	const char *tname;
 
-	unused = stack_unused_space_get((char *)thread->stack_info.start, size);
+	unused = thread_stack_unused(thread);
 
 	/* Calculate the real size reserved for the stack */
 	pcnt = ((size - unused) * 100U) / size;
@@ -74,8 +90,20 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	shell_print(shell, "\toptions: 0x%x, priority: %d timeout: %d",
 		      thread->base.user_options,
 		      thread->base.prio,
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+		      z_timeout_remaining(&thread->base.timeout));
+#else
 		      thread->base.timeout.dticks);
+#endif
 	shell_print(shell, "\tstate: %s", k_thread_state_str(thread));
+#ifdef CONFIG_SCHED_THREAD_USAGE
+	u64_t cycles, total = k_ms_to_cyc_floor64(k_uptime_get());
+
+	(void)k_thread_cycles_get(thread, &cycles);
+	shell_print(shell, "\tcpu usage: %u ms (%u %%)",
+		      (u32_t)k_cyc_to_ms_floor64(cycles),
+		      total ? (u32_t)((cycles * 100U) / total) : 0U);
+#endif
 	shell_print(shell, "\tstack size %u, unused %u, usage %u / %u (%u %%)\n",
 		      size, unused, size - unused, size, pcnt);
 
@@ -100,7 +128,7 @@ static void shell_stack_dump(const struct k_thread *thread, void *user_data)
 	const char *tname;
 
 	tname = k_thread_name_get((struct k_thread *)thread);
-	unused = stack_unused_space_get((char *)thread->stack_info.start, size);
+	unused = thread_stack_unused((struct k_thread *)thread);
 
 	/* Calculate the real size reserved for the stack */
 	pcnt = ((size - unused) * 100U) / size;
@@ -122,6 +150,57 @@ static int cmd_kernel_stacks(const struct shell *shell,
 }
 #endif
 
+#if defined(CONFIG_SCHED_STATS)
+static int cmd_kernel_sched(const struct shell *shell,
+			    size_t argc, char **argv)
+{
+	u32_t hist[CONFIG_SCHED_STATS_HIST_BUCKETS];
+	struct k_sched_stats stats;
+	int prio, i;
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset") != 0) {
+			shell_error(shell, "unknown argument: %s", argv[1]);
+			return -EINVAL;
+		}
+		k_sched_stats_reset();
+		shell_print(shell, "statistics reset");
+		return 0;
+	}
+
+	k_sched_stats_get(&stats);
+
+	shell_print(shell, "switches: %u, wakeups: %u",
+		      stats.switches, stats.wakeups);
+	shell_print(shell, "run queue depth: %u (max %u)",
+		      stats.runq_depth, stats.runq_max_depth);
+	shell_print(shell, "max wake-up latency: %u us",
+		      stats.max_latency_us);
+	shell_print(shell, "latency histograms (bucket n: < 2^n us):");
+
+	for (prio = K_HIGHEST_THREAD_PRIO; prio <= K_LOWEST_THREAD_PRIO;
+	     prio++) {
+		u32_t total = 0U;
+
+		(void)k_sched_latency_hist_get(prio, hist);
+		for (i = 0; i < ARRAY_SIZE(hist); i++) {
+			total += hist[i];
+		}
+		if (total == 0U) {
+			continue;
+		}
+
+		shell_fprintf(shell, SHELL_NORMAL, "prio %3d:", prio);
+		for (i = 0; i < ARRAY_SIZE(hist); i++) {
+			shell_fprintf(shell, SHELL_NORMAL, " %u", hist[i]);
+		}
+		shell_fprintf(shell, SHELL_NORMAL, "\n");
+	}
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_REBOOT)
 static int cmd_kernel_reboot_warm(const struct shell *shell,
 				  size_t argc, char **argv)
@@ -153,8 +232,13 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 #if defined(CONFIG_REBOOT)
 	SHELL_CMD(reboot, &sub_kernel_reboot, "Reboot.", NULL),
 #endif
-#if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_MONITOR) \
-				&& defined(CONFIG_THREAD_STACK_INFO)
+#if defined(CONFIG_SCHED_STATS)
+	SHELL_CMD_ARG(sched, NULL,
+		      "Scheduler statistics, 'reset' clears them.",
+		      cmd_kernel_sched, 1, 1),
+#endif
+#if (defined(CONFIG_INIT_STACKS) || defined(CONFIG_STACK_WATERMARK)) \
+	&& defined(CONFIG_THREAD_MONITOR) && defined(CONFIG_THREAD_STACK_INFO)
 	SHELL_CMD(stacks, NULL, "List threads stack usage.", cmd_kernel_stacks),
 	SHELL_CMD(threads, NULL, "List kernel threads.", cmd_kernel_threads),
 #endif
@@ -295,12 +295,18 @@ static void find_completion_candidates(const struct shell *shell,
 	size_t incompl_cmd_len = shell_strlen(incompl_cmd);
 	const struct shell_static_entry *candidate;
 	struct shell_static_entry dynamic_entry;
+	bool root = shell_root_cmds_lvl(shell, cmd ? 1 : 0);
 	bool found = false;
 	size_t idx = 0;
 
 	*longest = 0U;
 	*cnt = 0;
 
+	/* Candidates among sorted root commands are contiguous */
+	if (root) {
+		idx = shell_root_cmd_lower_bound(incompl_cmd, incompl_cmd_len);
+	}
+
 	while (true) {
 		bool is_empty;
 		bool is_candidate;
@@ -326,6 +332,8 @@ static void find_completion_candidates(const struct shell *shell,
 			}
 
 			found = true;
+		} else if (root && !is_candidate) {
+			break;
 		}
 		idx++;
 	}
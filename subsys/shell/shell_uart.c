@@ -132,6 +132,104 @@ static void uart_callback(void *user_data)
 }
 #endif /* CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN */
 
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+/* Idle time (in milliseconds) after which received data is reported. */
+#define ASYNC_RX_TIMEOUT 1
+
+/* Starts sending the content of the TX ring buffer if the driver is idle.
+ * Data is sent in place, the space is released on completion.
+ */
+static void async_tx_kick(const struct shell_uart *sh_uart)
+{
+	u8_t *data;
+	u32_t len;
+
+	if (ring_buf_is_empty(sh_uart->tx_ringbuf) ||
+	    atomic_set(&sh_uart->ctrl_blk->tx_busy, 1) != 0) {
+		return;
+	}
+
+	len = ring_buf_get_claim(sh_uart->tx_ringbuf, &data,
+				 sh_uart->tx_ringbuf->size);
+	if (uart_tx(sh_uart->ctrl_blk->dev, data, len, K_FOREVER) != 0) {
+		(void)ring_buf_get_finish(sh_uart->tx_ringbuf, 0);
+		atomic_clear(&sh_uart->ctrl_blk->tx_busy);
+	}
+}
+
+static void async_rx_handle(const struct shell_uart *sh_uart,
+			    const u8_t *data, size_t len)
+{
+	u32_t cnt = 0U;
+
+#ifdef CONFIG_MCUMGR_SMP_SHELL
+	/* Divert bytes from shell handling if they are part of an mcumgr
+	 * frame.
+	 */
+	for (size_t i = 0; i < len; i++) {
+		if (!smp_shell_rx_byte(&sh_uart->ctrl_blk->smp, data[i])) {
+			cnt += ring_buf_put(sh_uart->rx_ringbuf, &data[i], 1);
+		} else {
+			cnt++;
+		}
+	}
+#else
+	cnt = ring_buf_put(sh_uart->rx_ringbuf, data, len);
+#endif /* CONFIG_MCUMGR_SMP_SHELL */
+
+	if (cnt < len) {
+		LOG_WRN("RX ring buffer full.");
+	}
+
+	sh_uart->ctrl_blk->handler(SHELL_TRANSPORT_EVT_RX_RDY,
+				   sh_uart->ctrl_blk->context);
+}
+
+static void uart_async_callback(struct uart_event *evt, void *user_data)
+{
+	const struct shell_uart *sh_uart = (struct shell_uart *)user_data;
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		(void)ring_buf_get_finish(sh_uart->tx_ringbuf,
+					  evt->data.tx.len);
+		atomic_clear(&ctrl_blk->tx_busy);
+		if (!ctrl_blk->blocking_tx) {
+			async_tx_kick(sh_uart);
+		}
+		ctrl_blk->handler(SHELL_TRANSPORT_EVT_TX_RDY,
+				  ctrl_blk->context);
+		break;
+
+	case UART_RX_RDY:
+		async_rx_handle(sh_uart,
+				&evt->data.rx.buf[evt->data.rx.offset],
+				evt->data.rx.len);
+		break;
+
+	case UART_RX_BUF_REQUEST:
+		ctrl_blk->rx_buf_idx ^= 1U;
+		(void)uart_rx_buf_rsp(ctrl_blk->dev,
+				      ctrl_blk->rx_bufs[ctrl_blk->rx_buf_idx],
+				      sizeof(ctrl_blk->rx_bufs[0]));
+		break;
+
+	case UART_RX_DISABLED:
+		/* Reception stops on errors, restart it. */
+		(void)uart_rx_enable(ctrl_blk->dev,
+				     ctrl_blk->rx_bufs[ctrl_blk->rx_buf_idx],
+				     sizeof(ctrl_blk->rx_bufs[0]),
+				     ASYNC_RX_TIMEOUT);
+		break;
+
+	default:
+		break;
+	}
+}
+#endif /* CONFIG_SHELL_BACKEND_SERIAL_ASYNC */
+
 static void uart_irq_init(const struct shell_uart *sh_uart)
 {
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
@@ -142,6 +240,27 @@ static void uart_irq_init(const struct shell_uart *sh_uart)
 #endif
 }
 
+static int uart_async_init(const struct shell_uart *sh_uart)
+{
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+	int err;
+
+	err = uart_callback_set(ctrl_blk->dev, uart_async_callback,
+				(void *)sh_uart);
+	if (err != 0) {
+		return err;
+	}
+
+	ctrl_blk->rx_buf_idx = 0U;
+
+	return uart_rx_enable(ctrl_blk->dev, ctrl_blk->rx_bufs[0],
+			      sizeof(ctrl_blk->rx_bufs[0]), ASYNC_RX_TIMEOUT);
+#else
+	return -ENOTSUP;
+#endif
+}
+
 static void timer_handler(struct k_timer *timer)
 {
 	u8_t c;
@@ -168,6 +287,10 @@ static int init(const struct shell_transport *transport,
 	sh_uart->ctrl_blk->handler = evt_handler;
 	sh_uart->ctrl_blk->context = context;
 
+	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)) {
+		return uart_async_init(sh_uart);
+	}
+
 	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
 		uart_irq_init(sh_uart);
 	} else {
@@ -193,6 +316,10 @@ static int enable(const struct shell_transport *transport, bool blocking_tx)
 	if (blocking_tx) {
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
 		uart_irq_tx_disable(sh_uart->ctrl_blk->dev);
+#endif
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+		/* Pending data is dropped, output continues by polling. */
+		(void)uart_tx_abort(sh_uart->ctrl_blk->dev);
 #endif
 	}
 
@@ -211,13 +338,27 @@ static void irq_write(const struct shell_uart *sh_uart, const void *data,
 	}
 }
 
+static void async_write(const struct shell_uart *sh_uart, const void *data,
+			size_t length, size_t *cnt)
+{
+	/* Whole chunk is copied at once, the driver sends it in place. */
+	*cnt = ring_buf_put(sh_uart->tx_ringbuf, data, length);
+
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+	async_tx_kick(sh_uart);
+#endif
+}
+
 static int write(const struct shell_transport *transport,
 		 const void *data, size_t length, size_t *cnt)
 {
 	const struct shell_uart *sh_uart = (struct shell_uart *)transport->ctx;
 	const u8_t *data8 = (const u8_t *)data;
 
-	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) &&
+	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC) &&
+	    !sh_uart->ctrl_blk->blocking_tx) {
+		async_write(sh_uart, data, length, cnt);
+	} else if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) &&
 		!sh_uart->ctrl_blk->blocking_tx) {
 		irq_write(sh_uart, data, length, cnt);
 	} else {
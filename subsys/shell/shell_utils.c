@@ -225,13 +225,36 @@ static inline u32_t shell_root_cmd_count(void)
 				sizeof(struct shell_cmd_entry);
 }
 
+/* Root commands are sorted by syntax at link time, as their sections are
+ * named after it: binary search for the first one whose first len
+ * characters are not lower than syntax.
+ */
+size_t shell_root_cmd_lower_bound(const char *syntax, size_t len)
+{
+	size_t lo = 0;
+	size_t hi = shell_root_cmd_count();
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		const struct shell_cmd_entry *cmd = shell_root_cmd_get(mid);
+
+		if (strncmp(cmd->u.entry->syntax, syntax, len) < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
 /* Function returning pointer to root command matching requested syntax. */
 const struct shell_static_entry *shell_root_cmd_find(const char *syntax)
 {
-	const size_t cmd_count = shell_root_cmd_count();
+	size_t cmd_idx = shell_root_cmd_lower_bound(syntax, SIZE_MAX);
 	const struct shell_cmd_entry *cmd;
 
-	for (size_t cmd_idx = 0; cmd_idx < cmd_count; ++cmd_idx) {
+	if (cmd_idx < shell_root_cmd_count()) {
 		cmd = shell_root_cmd_get(cmd_idx);
 		if (strcmp(syntax, cmd->u.entry->syntax) == 0) {
 			return cmd->u.entry;
@@ -305,6 +328,10 @@ static const struct shell_static_entry *find_cmd(
 	const struct shell_static_entry *entry = NULL;
 	size_t idx = 0;
 
+	if (shell_root_cmds_lvl(shell, lvl)) {
+		return shell_root_cmd_find(cmd_str);
+	}
+
 	do {
 		shell_cmd_get(shell, cmd, lvl, idx++, &entry, d_entry);
 		if (entry && (strcmp(cmd_str, entry->syntax) == 0)) {
@@ -89,6 +89,11 @@ int shell_command_add(char *buff, u16_t *buff_len,
 
 const struct shell_static_entry *shell_root_cmd_find(const char *syntax);
 
+/* @internal @brief Index of the first root command whose syntax, limited to
+ * len characters, is not lower than given string. Root commands are sorted.
+ */
+size_t shell_root_cmd_lower_bound(const char *syntax, size_t len);
+
 void shell_spaces_trim(char *str);
 
 static inline void transport_buffer_flush(const struct shell *shell)
@@ -103,6 +108,14 @@ static inline bool shell_in_select_mode(const struct shell *shell)
 	return shell->ctx->selected_cmd == NULL ? false : true;
 }
 
+/* Commands of given level are the sorted root commands */
+static inline bool shell_root_cmds_lvl(const struct shell *shell, size_t lvl)
+{
+	return (lvl == SHELL_CMD_ROOT_LVL) &&
+	       !(shell_in_select_mode(shell) &&
+		 IS_ENABLED(CONFIG_SHELL_CMDS_SELECT));
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,6 +9,7 @@
 #include <stdio.h>
 #include <errno.h>
 #include <zephyr/types.h>
+#include <sys/byteorder.h>
 #include <stats/stats.h>
 
 #define STATS_GEN_NAME_MAX_LEN  (sizeof("s255"))
@@ -44,7 +45,70 @@ stats_get_name(const struct stats_hdr *hdr, int idx)
 static u16_t
 stats_get_off(const struct stats_hdr *hdr, int idx)
 {
-	return sizeof(*hdr) + idx * hdr->s_size;
+	return sizeof(*hdr) + idx * hdr->s_size * STATS_SLOTS;
+}
+
+static u64_t
+stats_get_slot(const u8_t *entry, u8_t size, int slot)
+{
+	switch (size) {
+	case sizeof(u16_t):
+		return ((const u16_t *)entry)[slot];
+	case sizeof(u32_t):
+		return ((const u32_t *)entry)[slot];
+	case sizeof(u64_t):
+		return ((const u64_t *)entry)[slot];
+	default:
+		return 0;
+	}
+}
+
+u64_t
+stats_value_get(const struct stats_hdr *hdr, u16_t off)
+{
+	const u8_t *entry = (const u8_t *)hdr + off;
+	u64_t sum = 0;
+	int i;
+
+	if (STATS_SLOTS == 1) {
+		return stats_get_slot(entry, hdr->s_size, 0);
+	}
+
+	/* The first slot holds the total, the per-CPU counters follow */
+	for (i = 1; i < STATS_SLOTS; i++) {
+		sum += stats_get_slot(entry, hdr->s_size, i);
+	}
+
+	return sum;
+}
+
+/**
+ * Refreshes the total of an entry from its per-CPU counters, so that
+ * readers accessing the entry directly see the sum.
+ */
+static u64_t
+stats_fold(struct stats_hdr *hdr, u16_t off)
+{
+	u8_t *entry = (u8_t *)hdr + off;
+	u64_t sum = stats_value_get(hdr, off);
+
+	if (STATS_SLOTS == 1) {
+		return sum;
+	}
+
+	switch (hdr->s_size) {
+	case sizeof(u16_t):
+		*(u16_t *)entry = sum;
+		break;
+	case sizeof(u32_t):
+		*(u32_t *)entry = sum;
+		break;
+	case sizeof(u64_t):
+		*(u64_t *)entry = sum;
+		break;
+	}
+
+	return sum;
 }
 
 /**
@@ -109,6 +173,8 @@ stats_walk(struct stats_hdr *hdr, stats_walk_fn *walk_func, void *arg)
 			name = name_buf;
 		}
 
+		(void)stats_fold(hdr, stats_get_off(hdr, i));
+
 		rc = walk_func(hdr, arg, name, stats_get_off(hdr, i));
 		if (rc != 0) {
 			return rc;
@@ -281,5 +347,65 @@ stats_init_and_reg(struct stats_hdr *shdr, u8_t size, u16_t cnt,
 void
 stats_reset(struct stats_hdr *hdr)
 {
-	(void)memset((u8_t *)hdr + sizeof(*hdr), 0, hdr->s_size * hdr->s_cnt);
+	(void)memset((u8_t *)hdr + sizeof(*hdr), 0,
+		     hdr->s_size * hdr->s_cnt * STATS_SLOTS);
+}
+
+/**
+ * Exports all registered statistics groups in binary form, see the
+ * description of the format in stats.h.  Like stats_group_walk(), this
+ * assumes that the list is not being changed by another task.
+ *
+ * @param buf The destination buffer
+ * @param size The size of the destination buffer
+ *
+ * @return The number of bytes written, -ENOMEM if the buffer is too small.
+ */
+int
+stats_snapshot(void *buf, size_t size)
+{
+	const struct stats_hdr *hdr;
+	u8_t *dst = buf;
+	size_t name_len;
+	size_t len = 0;
+	u64_t val;
+	int i;
+
+	for (hdr = stats_list; hdr != NULL; hdr = hdr->s_next) {
+		name_len = strlen(hdr->s_name);
+		if (name_len > UINT8_MAX) {
+			name_len = UINT8_MAX;
+		}
+
+		if (len + 4 + name_len + hdr->s_cnt * hdr->s_size > size) {
+			return -ENOMEM;
+		}
+
+		dst[len++] = name_len;
+		memcpy(&dst[len], hdr->s_name, name_len);
+		len += name_len;
+		dst[len++] = hdr->s_size;
+		sys_put_le16(hdr->s_cnt, &dst[len]);
+		len += sizeof(u16_t);
+
+		for (i = 0; i < hdr->s_cnt; i++) {
+			val = stats_fold((struct stats_hdr *)hdr,
+					 stats_get_off(hdr, i));
+
+			switch (hdr->s_size) {
+			case sizeof(u16_t):
+				sys_put_le16(val, &dst[len]);
+				break;
+			case sizeof(u32_t):
+				sys_put_le32(val, &dst[len]);
+				break;
+			case sizeof(u64_t):
+				sys_put_le64(val, &dst[len]);
+				break;
+			}
+			len += hdr->s_size;
+		}
+	}
+
+	return len;
 }
@@ -67,6 +67,11 @@ LOG_MODULE_REGISTER(usb_cdc_acm);
 /* Size of the internal buffer used for storing received data */
 #define CDC_ACM_BUFFER_SIZE (CONFIG_CDC_ACM_BULK_EP_MPS)
 
+/* Size of the internal buffer used for sending data, the USB device stack
+ * splits it into bulk packets.
+ */
+#define CDC_ACM_TX_BUFFER_SIZE (CONFIG_USB_CDC_ACM_TX_TRANSFER_SIZE)
+
 /* Serial state notification timeout */
 #define CDC_CONTROL_SERIAL_STATE_TIMEOUT_US 100000
 
@@ -182,7 +187,7 @@ struct cdc_acm_dev_data_t {
 	bool tx_irq_ena;			/* Tx interrupt enable status */
 	bool rx_irq_ena;			/* Rx interrupt enable status */
 	u8_t rx_buf[CDC_ACM_BUFFER_SIZE];	/* Internal RX buffer */
-	u8_t tx_buf[CDC_ACM_BUFFER_SIZE];	/* Internal TX buffer */
+	u8_t tx_buf[CDC_ACM_TX_BUFFER_SIZE];	/* Internal TX buffer */
 	struct ring_buf *rx_ringbuf;
 	struct ring_buf *tx_ringbuf;
 	/* Interface data buffer */
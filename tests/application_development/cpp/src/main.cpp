@@ -20,6 +20,7 @@
 #include <sys/byteorder.h>
 #include <sys/crc.h>
 #include <sys/crc.h>
+#include <sys/cpp_new.h>
 
 #include <drivers/gpio.h>
 #include <drivers/led_strip.h>
@@ -65,10 +66,37 @@ static void test_new_delete(void)
 	delete test_foo;
 }
 
+static void test_new_delete_slabs(void)
+{
+#ifdef CONFIG_CPP_NEW_STATS
+	struct cpp_new_stats before, stats;
+
+	cpp_new_stats_get(&before);
+
+	foo_class *test_foo = new foo_class(10);
+	cpp_new_stats_get(&stats);
+	zassert_equal(stats.slab_allocs[0], before.slab_allocs[0] + 1, NULL);
+	zassert_equal(stats.slab_used[0], before.slab_used[0] + 1, NULL);
+
+	delete test_foo;
+	cpp_new_stats_get(&stats);
+	zassert_equal(stats.slab_used[0], before.slab_used[0], NULL);
+	zassert_equal(stats.heap_allocs, before.heap_allocs, NULL);
+
+	char *large = new char[CPP_NEW_MAX_SLAB_SIZE + 1];
+	cpp_new_stats_get(&stats);
+	zassert_equal(stats.heap_allocs, before.heap_allocs + 1, NULL);
+	delete[] large;
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(cpp_tests,
-			 ztest_unit_test(test_new_delete)
+			 ztest_unit_test(test_new_delete),
+			 ztest_unit_test(test_new_delete_slabs)
 		);
 
 	ztest_run_test_suite(cpp_tests);
@@ -13,12 +13,48 @@
  *  1. From __start to main()
  *  2. From __start to task
  *  3. From __start to idle
+ *
+ * The time from __start to main() is also broken down per boot phase.
+ *
+ * With CONFIG_BOOT_TIME_SLOW_INIT, simulated slow drivers are added to the
+ * boot to compare serial and asynchronous device initialization.
  */
 
 #include <zephyr.h>
 #include <tc_util.h>
 #include <kernel_internal.h>
 
+static const char *const phase_names[Z_BOOT_PHASE_NUM] = {
+	[Z_BOOT_PHASE_EARLY] = "early (BSS, data)",
+	[Z_BOOT_PHASE_PRE_KERNEL_1] = "PRE_KERNEL_1",
+	[Z_BOOT_PHASE_PRE_KERNEL_2] = "PRE_KERNEL_2",
+	[Z_BOOT_PHASE_POST_KERNEL] = "POST_KERNEL",
+	[Z_BOOT_PHASE_APPLICATION] = "APPLICATION",
+};
+
+static u32_t cycles_to_us(u32_t cycles)
+{
+	return (u32_t)ceiling_fraction(USEC_PER_SEC * (u64_t)cycles,
+				       sys_clock_hw_cycles_per_sec());
+}
+
+static void print_boot_phases(void)
+{
+	u32_t start = 0U;
+
+	for (int i = 0; i < Z_BOOT_PHASE_NUM; i++) {
+		u32_t end = z_timestamp_boot_phase[i];
+
+		TC_PRINT("  %-18s: %u cycles, %u us\n", phase_names[i],
+			 end - start, cycles_to_us(end - start));
+		start = end;
+	}
+
+	TC_PRINT("  %-18s: %u cycles, %u us\n", "rest to main()",
+		 z_timestamp_main - start,
+		 cycles_to_us(z_timestamp_main - start));
+}
+
 void main(void)
 {
 	u32_t task_time_stamp;	/* timestamp at beginning of first task */
@@ -52,6 +88,13 @@ void main(void)
 						       task_us);
 	TC_PRINT("_start->idle  : %u cycles, %u us\n", z_timestamp_idle,
 						       idle_us);
+	TC_PRINT("Boot phases:\n");
+	print_boot_phases();
+#ifdef CONFIG_BOOT_TIME_SLOW_INIT
+	TC_PRINT("slow init     : 4 x %d ms, %s\n",
+		 CONFIG_BOOT_TIME_SLOW_INIT_MS,
+		 IS_ENABLED(CONFIG_DEVICE_INIT_ASYNC) ? "async" : "serial");
+#endif
 	TC_PRINT("Boot Time Measurement finished\n");
 
 	TC_END_RESULT(TC_PASS);
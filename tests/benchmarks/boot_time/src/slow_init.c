@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Simulated slow init entries
+ *
+ * Three independent entries that sleep, and a fourth depending on the
+ * first one. With CONFIG_DEVICE_INIT_ASYNC the sleeps overlap.
+ */
+
+#include <zephyr.h>
+#include <init.h>
+
+static int slow_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_sleep(K_MSEC(CONFIG_BOOT_TIME_SLOW_INIT_MS));
+
+	return 0;
+}
+
+DEVICE_AND_API_INIT_ASYNC(slow_0, "SLOW_0", slow_init, NULL, NULL,
+			  POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE,
+			  NULL);
+DEVICE_AND_API_INIT_ASYNC(slow_1, "SLOW_1", slow_init, NULL, NULL,
+			  POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE,
+			  NULL);
+DEVICE_AND_API_INIT_ASYNC(slow_2, "SLOW_2", slow_init, NULL, NULL,
+			  POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE,
+			  NULL);
+
+static int slow_dependent_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	if (device_init_wait(DEVICE_GET(slow_0)) != 0) {
+		return -ENODEV;
+	}
+
+	return slow_init(dev);
+}
+
+SYS_INIT_ASYNC(slow_dependent_init, POST_KERNEL,
+	       CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/cbprintf.h>
+#include <stdio.h>
+
+/* Microbenchmark of the formatted output paths. A set of format strings
+ * representative of log and console output is formatted with each method
+ * and the best of N_RUNS runs is reported in cycles.
+ */
+
+#define N_RUNS 16
+
+enum method {
+	M_CBVPRINTF,
+	M_SNPRINTK,
+	M_SNPRINTF,
+	M_PACKAGE,
+	M_CBPPRINTF,
+};
+
+static const char *const method_names[] = {
+	[M_CBVPRINTF] = "cbvprintf",
+	[M_SNPRINTK] = "snprintk",
+	[M_SNPRINTF] = "snprintf",
+	[M_PACKAGE] = "package",
+	[M_CBPPRINTF] = "cbpprintf",
+};
+
+struct str_ctx {
+	char *buf;
+	size_t len;
+	size_t pos;
+};
+
+#define N_LINES 5
+
+static char out_buf[128];
+static u8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) pkg_buf[N_LINES][64];
+
+static int str_out(int c, void *ctx)
+{
+	struct str_ctx *s = ctx;
+
+	if (s->pos < s->len - 1) {
+		s->buf[s->pos++] = c;
+	}
+
+	return c;
+}
+
+/* Routes the arguments of line idx to the method under test */
+static void format(enum method m, int idx, const char *fmt, ...)
+{
+	struct str_ctx ctx = { .buf = out_buf, .len = sizeof(out_buf) };
+	va_list ap;
+
+	va_start(ap, fmt);
+
+	switch (m) {
+	case M_CBVPRINTF:
+		(void)cbvprintf(str_out, &ctx, fmt, ap);
+		break;
+	case M_SNPRINTK:
+		(void)vsnprintk(out_buf, sizeof(out_buf), fmt, ap);
+		break;
+	case M_SNPRINTF:
+		(void)vsnprintf(out_buf, sizeof(out_buf), fmt, ap);
+		break;
+	case M_PACKAGE:
+		(void)cbvprintf_package(pkg_buf[idx], sizeof(pkg_buf[idx]),
+					fmt, ap);
+		break;
+	case M_CBPPRINTF:
+		(void)cbpprintf(str_out, &ctx, pkg_buf[idx]);
+		break;
+	}
+
+	va_end(ap);
+}
+
+static void run_all(enum method m)
+{
+	format(m, 0, "Hello world\n");
+	format(m, 1, "%s: %d bytes at %p\n", "rx", 1234, (void *)0x20001000);
+	format(m, 2, "[%08u] <%s> %s: %x %x %x %x\n", 123456U, "inf", "main",
+	       0xdeadU, 0xbeefU, 1U, 0x7fffffffU);
+	format(m, 3, "%-10s|%10d|%05u|%#x\n", "left", -42, 7U, 255U);
+	format(m, 4, "%lld %llx\n", 1234567LL, 0x123456789abcdefULL);
+}
+
+static u32_t bench_once(enum method m)
+{
+	u32_t start = k_cycle_get_32();
+
+	run_all(m);
+
+	return k_cycle_get_32() - start;
+}
+
+static void bench(enum method m)
+{
+	u32_t best = UINT32_MAX;
+
+	for (int i = 0; i < N_RUNS; i++) {
+		best = MIN(best, bench_once(m));
+	}
+
+	printk("%-10s %8u cycles\n", method_names[m], best);
+}
+
+void main(void)
+{
+	/* Packages formatted by the cbpprintf case */
+	run_all(M_PACKAGE);
+
+	for (int m = M_CBVPRINTF; m <= M_CBPPRINTF; m++) {
+		bench(m);
+	}
+
+	printk("fin\n");
+}
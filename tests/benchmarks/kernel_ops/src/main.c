@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/atomic.h>
+
+/* Microbenchmark of the kernel primitives. Each operation is run N_WARMUP
+ * times, then N_SAMPLES times timed, and the distribution of the durations
+ * is printed in cycles as one JSON object per line.
+ *
+ * Wakeups are timed from the call of the waker to the point where the
+ * woken thread, of a higher priority than the main thread, returns from
+ * the wait.
+ */
+
+#define N_WARMUP 16
+#define N_SAMPLES 256
+
+#define STACK_SIZE 1024
+#define HELPER_PRIO K_PRIO_PREEMPT(1)
+
+#define BLOCK_SIZE 64
+
+static u32_t samples[N_SAMPLES];
+
+K_SEM_DEFINE(sem, 0, 1);
+K_SEM_DEFINE(wake_sem, 0, 1);
+K_MUTEX_DEFINE(mutex);
+K_MSGQ_DEFINE(msgq, sizeof(u32_t), 4, 4);
+K_PIPE_DEFINE(pipe, 64, 4);
+K_MEM_SLAB_DEFINE(slab, BLOCK_SIZE, 4, 4);
+K_MEM_POOL_DEFINE(pool, BLOCK_SIZE, BLOCK_SIZE, 4, 4);
+K_TIMER_DEFINE(timer, NULL, NULL);
+
+static K_THREAD_STACK_DEFINE(helper_stack, STACK_SIZE);
+static struct k_thread helper_thread;
+
+static K_THREAD_STACK_DEFINE(work_q_stack, STACK_SIZE);
+static struct k_work_q work_q;
+static struct k_work work;
+
+/* Stamped by the woken thread, then counted */
+static volatile u32_t wake_stamp;
+static atomic_t wake_count;
+
+static void woken(void)
+{
+	wake_stamp = k_cycle_get_32();
+	atomic_inc(&wake_count);
+}
+
+/* Returns the time of the wakeup following the given count */
+static u32_t wait_wake(atomic_val_t count)
+{
+	while (atomic_get(&wake_count) == count) {
+	}
+
+	return wake_stamp;
+}
+
+static void sort(u32_t *v, int n)
+{
+	for (int i = 1; i < n; i++) {
+		u32_t x = v[i];
+		int j;
+
+		for (j = i; j > 0 && v[j - 1] > x; j--) {
+			v[j] = v[j - 1];
+		}
+		v[j] = x;
+	}
+}
+
+static void run(const char *name, u32_t (*fn)(void))
+{
+	u64_t total = 0;
+
+	for (int i = 0; i < N_WARMUP; i++) {
+		(void)fn();
+	}
+
+	for (int i = 0; i < N_SAMPLES; i++) {
+		samples[i] = fn();
+		total += samples[i];
+	}
+
+	sort(samples, N_SAMPLES);
+
+	printk("{\"bench\":\"%s\",\"n\":%d,\"min\":%u,\"p50\":%u,\"p90\":%u,"
+	       "\"p99\":%u,\"max\":%u,\"avg\":%u}\n", name, N_SAMPLES,
+	       samples[0], samples[N_SAMPLES * 50 / 100],
+	       samples[N_SAMPLES * 90 / 100], samples[N_SAMPLES * 99 / 100],
+	       samples[N_SAMPLES - 1], (u32_t)(total / N_SAMPLES));
+}
+
+static u32_t bench_sem_give_take(void)
+{
+	u32_t start = k_cycle_get_32();
+
+	k_sem_give(&sem);
+	k_sem_take(&sem, K_NO_WAIT);
+
+	return k_cycle_get_32() - start;
+}
+
+static u32_t bench_mutex_lock_unlock(void)
+{
+	u32_t start = k_cycle_get_32();
+
+	k_mutex_lock(&mutex, K_FOREVER);
+	k_mutex_unlock(&mutex);
+
+	return k_cycle_get_32() - start;
+}
+
+static u32_t bench_msgq_put_get(void)
+{
+	u32_t msg = 0;
+	u32_t start = k_cycle_get_32();
+
+	k_msgq_put(&msgq, &msg, K_NO_WAIT);
+	k_msgq_get(&msgq, &msg, K_NO_WAIT);
+
+	return k_cycle_get_32() - start;
+}
+
+static u32_t bench_pipe_put_get(void)
+{
+	u8_t data[16];
+	size_t len;
+	u32_t start = k_cycle_get_32();
+
+	k_pipe_put(&pipe, data, sizeof(data), &len, sizeof(data), K_NO_WAIT);
+	k_pipe_get(&pipe, data, sizeof(data), &len, sizeof(data), K_NO_WAIT);
+
+	return k_cycle_get_32() - start;
+}
+
+static u32_t bench_mem_slab_alloc_free(void)
+{
+	void *block;
+	u32_t start = k_cycle_get_32();
+
+	k_mem_slab_alloc(&slab, &block, K_NO_WAIT);
+	k_mem_slab_free(&slab, &block);
+
+	return k_cycle_get_32() - start;
+}
+
+static u32_t bench_mem_pool_alloc_free(void)
+{
+	struct k_mem_block block;
+	u32_t start = k_cycle_get_32();
+
+	k_mem_pool_alloc(&pool, &block, BLOCK_SIZE, K_NO_WAIT);
+	k_mem_pool_free(&block);
+
+	return k_cycle_get_32() - start;
+}
+
+static u32_t bench_poll_ready(void)
+{
+	struct k_poll_event event =
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SEM_AVAILABLE,
+					 K_POLL_MODE_NOTIFY_ONLY, &sem);
+	u32_t start, cycles;
+
+	k_sem_give(&sem);
+
+	start = k_cycle_get_32();
+	k_poll(&event, 1, K_NO_WAIT);
+	cycles = k_cycle_get_32() - start;
+
+	k_sem_take(&sem, K_NO_WAIT);
+
+	return cycles;
+}
+
+static u32_t bench_timer_start_stop(void)
+{
+	u32_t start = k_cycle_get_32();
+
+	k_timer_start(&timer, 1000, 0);
+	k_timer_stop(&timer);
+
+	return k_cycle_get_32() - start;
+}
+
+static void sem_waiter(void *p1, void *p2, void *p3)
+{
+	for (;;) {
+		k_sem_take(&wake_sem, K_FOREVER);
+		woken();
+	}
+}
+
+static u32_t bench_sem_wake(void)
+{
+	atomic_val_t count = atomic_get(&wake_count);
+	u32_t start = k_cycle_get_32();
+
+	k_sem_give(&wake_sem);
+
+	return wait_wake(count) - start;
+}
+
+static void work_handler(struct k_work *item)
+{
+	woken();
+}
+
+static u32_t bench_work_submit_wake(void)
+{
+	atomic_val_t count = atomic_get(&wake_count);
+	u32_t start = k_cycle_get_32();
+
+	k_work_submit_to_queue(&work_q, &work);
+
+	return wait_wake(count) - start;
+}
+
+#ifdef CONFIG_USERSPACE
+static struct k_futex futex;
+
+static void futex_waiter(void *p1, void *p2, void *p3)
+{
+	for (;;) {
+		k_futex_wait(&futex, 0, K_FOREVER);
+		woken();
+	}
+}
+
+static u32_t bench_futex_wake(void)
+{
+	atomic_val_t count = atomic_get(&wake_count);
+	u32_t start = k_cycle_get_32();
+
+	k_futex_wake(&futex, false);
+
+	return wait_wake(count) - start;
+}
+#endif
+
+/* Runs a wakeup benchmark against a helper thread, created on the given
+ * CPU if not negative.
+ */
+static void run_wake(const char *name, u32_t (*fn)(void),
+		     k_thread_entry_t waiter, int cpu)
+{
+	k_thread_create(&helper_thread, helper_stack,
+			K_THREAD_STACK_SIZEOF(helper_stack), waiter,
+			NULL, NULL, NULL, HELPER_PRIO, 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+	if (cpu >= 0) {
+		k_thread_cpu_pin(&helper_thread, cpu);
+	}
+#endif
+	/* The helper preempts us and waits */
+	k_thread_start(&helper_thread);
+
+	run(name, fn);
+
+	k_thread_abort(&helper_thread);
+}
+
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_CPU_MASK)
+static K_THREAD_STACK_DEFINE(smp_stack, STACK_SIZE);
+static struct k_thread smp_thread;
+static K_SEM_DEFINE(smp_done, 0, 1);
+
+/* Runs on CPU 0, waking a helper on CPU 1 */
+static void smp_bench(void *p1, void *p2, void *p3)
+{
+	run_wake("smp_sem_wake", bench_sem_wake, sem_waiter, 1);
+	k_sem_give(&smp_done);
+}
+
+static void run_smp(void)
+{
+	k_thread_create(&smp_thread, smp_stack,
+			K_THREAD_STACK_SIZEOF(smp_stack), smp_bench,
+			NULL, NULL, NULL, HELPER_PRIO + 1, 0, K_FOREVER);
+	k_thread_cpu_pin(&smp_thread, 0);
+	k_thread_start(&smp_thread);
+	k_sem_take(&smp_done, K_FOREVER);
+}
+#endif
+
+void main(void)
+{
+	k_work_q_start(&work_q, work_q_stack,
+		       K_THREAD_STACK_SIZEOF(work_q_stack), HELPER_PRIO);
+	k_work_init(&work, work_handler);
+
+	run("sem_give_take", bench_sem_give_take);
+	run("mutex_lock_unlock", bench_mutex_lock_unlock);
+	run("msgq_put_get", bench_msgq_put_get);
+	run("pipe_put_get", bench_pipe_put_get);
+	run("mem_slab_alloc_free", bench_mem_slab_alloc_free);
+	run("mem_pool_alloc_free", bench_mem_pool_alloc_free);
+	run("poll_ready", bench_poll_ready);
+	run("timer_start_stop", bench_timer_start_stop);
+
+	run_wake("sem_wake", bench_sem_wake, sem_waiter, -1);
+	run("work_submit_wake", bench_work_submit_wake);
+#ifdef CONFIG_USERSPACE
+	run_wake("futex_wake", bench_futex_wake, futex_waiter, -1);
+#endif
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_CPU_MASK)
+	run_smp();
+#endif
+
+	printk("fin\n");
+}
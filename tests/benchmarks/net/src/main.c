@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+
+/* Throughput and latency of the network stack, through the socket API.
+ * The main thread sends to a peer thread listening on the address of the
+ * board, over the loopback interface, so that no external setup is needed
+ * and only the stack itself is measured.
+ */
+
+#define ADDR "192.0.2.1"
+#define PORT 4242
+
+#define BULK_TOTAL (256 * 1024)
+#define BULK_CHUNK 1024
+#define SMALL_SIZE 16
+#define SMALL_COUNT 2000
+#define ECHO_COUNT 200
+
+/* How long the receiver of a UDP test waits for late datagrams */
+#define UDP_IDLE_MS 200
+
+#define PEER_STACK_SIZE 2048
+#define PEER_PRIO K_PRIO_PREEMPT(1)
+
+static K_THREAD_STACK_DEFINE(peer_stack, PEER_STACK_SIZE);
+static struct k_thread peer_thread;
+static K_SEM_DEFINE(peer_ready, 0, 1);
+static K_SEM_DEFINE(peer_done, 0, 1);
+
+static u8_t main_buf[BULK_CHUNK];
+static u8_t peer_buf[BULK_CHUNK];
+
+/* Filled by the peer */
+static s64_t rx_end;
+static size_t rx_count;
+
+static void fatal(const char *what)
+{
+	printk("%s failed: %d\n", what, errno);
+	k_panic();
+}
+
+static struct sockaddr_in peer_addr(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PORT),
+	};
+
+	inet_pton(AF_INET, ADDR, &addr.sin_addr);
+
+	return addr;
+}
+
+static int peer_socket(int type)
+{
+	struct sockaddr_in addr = peer_addr();
+	int sock;
+
+	sock = socket(AF_INET, type,
+		      type == SOCK_STREAM ? IPPROTO_TCP : IPPROTO_UDP);
+	if (sock < 0) {
+		fatal("socket");
+	}
+
+	if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		fatal("bind");
+	}
+
+	return sock;
+}
+
+static int main_socket(int type)
+{
+	struct sockaddr_in addr = peer_addr();
+	int sock;
+
+	sock = socket(AF_INET, type,
+		      type == SOCK_STREAM ? IPPROTO_TCP : IPPROTO_UDP);
+	if (sock < 0) {
+		fatal("socket");
+	}
+
+	if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		fatal("connect");
+	}
+
+	return sock;
+}
+
+static void peer_tcp(void)
+{
+	int sock = peer_socket(SOCK_STREAM);
+	int conn;
+	ssize_t len;
+
+	if (listen(sock, 1) < 0) {
+		fatal("listen");
+	}
+
+	k_sem_give(&peer_ready);
+
+	conn = accept(sock, NULL, NULL);
+	if (conn < 0) {
+		fatal("accept");
+	}
+
+	rx_count = 0;
+	while (rx_count < BULK_TOTAL) {
+		len = recv(conn, peer_buf, sizeof(peer_buf), 0);
+		if (len <= 0) {
+			fatal("recv");
+		}
+		rx_count += len;
+	}
+	rx_end = k_uptime_get();
+
+	close(conn);
+	close(sock);
+}
+
+/* Counts datagrams until none came for UDP_IDLE_MS */
+static void peer_udp(void)
+{
+	int sock = peer_socket(SOCK_DGRAM);
+	struct pollfd pfd = { .fd = sock, .events = POLLIN };
+
+	k_sem_give(&peer_ready);
+
+	rx_count = 0;
+	rx_end = k_uptime_get();
+	while (poll(&pfd, 1, UDP_IDLE_MS) > 0) {
+		if (recv(sock, peer_buf, sizeof(peer_buf), 0) < 0) {
+			fatal("recv");
+		}
+		rx_count++;
+		rx_end = k_uptime_get();
+	}
+
+	close(sock);
+}
+
+static void peer_echo(void)
+{
+	int sock = peer_socket(SOCK_DGRAM);
+	struct sockaddr_in from;
+	socklen_t from_len;
+	ssize_t len;
+
+	k_sem_give(&peer_ready);
+
+	for (int i = 0; i < ECHO_COUNT; i++) {
+		from_len = sizeof(from);
+		len = recvfrom(sock, peer_buf, sizeof(peer_buf), 0,
+			       (struct sockaddr *)&from, &from_len);
+		if (len < 0 || sendto(sock, peer_buf, len, 0,
+				      (struct sockaddr *)&from, from_len) < 0) {
+			fatal("echo");
+		}
+	}
+
+	close(sock);
+}
+
+static void peer_entry(void *p1, void *p2, void *p3)
+{
+	void (*fn)(void) = p1;
+
+	fn();
+	k_sem_give(&peer_done);
+}
+
+static void peer_start(void (*fn)(void))
+{
+	k_thread_create(&peer_thread, peer_stack,
+			K_THREAD_STACK_SIZEOF(peer_stack), peer_entry,
+			fn, NULL, NULL, PEER_PRIO, 0, K_NO_WAIT);
+	k_sem_take(&peer_ready, K_FOREVER);
+}
+
+static u32_t kbit_per_s(size_t bytes, s64_t ms)
+{
+	return (u32_t)(((u64_t)bytes * 8U) / MAX(ms, 1));
+}
+
+static void bench_tcp(void)
+{
+	int sock;
+	s64_t start, tx_end;
+	size_t sent;
+	ssize_t len;
+
+	peer_start(peer_tcp);
+	sock = main_socket(SOCK_STREAM);
+
+	start = k_uptime_get();
+	for (sent = 0; sent < BULK_TOTAL; sent += len) {
+		len = send(sock, main_buf, sizeof(main_buf), 0);
+		if (len < 0) {
+			fatal("send");
+		}
+	}
+	tx_end = k_uptime_get();
+
+	k_sem_take(&peer_done, K_FOREVER);
+	close(sock);
+
+	printk("tcp_tx %u kbit/s\n", kbit_per_s(sent, tx_end - start));
+	printk("tcp_rx %u kbit/s\n", kbit_per_s(rx_count, rx_end - start));
+}
+
+static void bench_udp(const char *name, size_t size, int count)
+{
+	int sock, sent = 0;
+	s64_t start, tx_ms;
+
+	peer_start(peer_udp);
+	sock = main_socket(SOCK_DGRAM);
+
+	/* A datagram the stack has no buffer for is counted as lost */
+	start = k_uptime_get();
+	for (int i = 0; i < count; i++) {
+		if (send(sock, main_buf, size, 0) >= 0) {
+			sent++;
+		}
+	}
+	tx_ms = MAX(k_uptime_get() - start, 1);
+
+	k_sem_take(&peer_done, K_FOREVER);
+	close(sock);
+
+	if (size == SMALL_SIZE) {
+		printk("%s_tx %u pkt/s\n", name,
+		       (u32_t)(sent * 1000LL / tx_ms));
+		printk("%s_rx %u pkt/s\n", name,
+		       (u32_t)(rx_count * 1000LL / MAX(rx_end - start, 1)));
+	} else {
+		printk("%s_tx %u kbit/s\n", name,
+		       kbit_per_s(size * sent, tx_ms));
+		printk("%s_rx %u kbit/s\n", name,
+		       kbit_per_s(size * rx_count, rx_end - start));
+	}
+	printk("%s_lost %u pkt\n", name, (u32_t)(count - rx_count));
+}
+
+static void bench_latency(void)
+{
+	u32_t min = UINT32_MAX, max = 0;
+	u64_t total = 0;
+	u32_t start, us;
+	int sock;
+
+	peer_start(peer_echo);
+	sock = main_socket(SOCK_DGRAM);
+
+	for (int i = 0; i < ECHO_COUNT; i++) {
+		start = k_cycle_get_32();
+		if (send(sock, main_buf, SMALL_SIZE, 0) < 0 ||
+		    recv(sock, main_buf, SMALL_SIZE, 0) < 0) {
+			fatal("echo");
+		}
+		us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+		min = MIN(min, us);
+		max = MAX(max, us);
+		total += us;
+	}
+
+	k_sem_take(&peer_done, K_FOREVER);
+	close(sock);
+
+	printk("latency_udp %u us min %u us avg %u us max\n",
+	       min, (u32_t)(total / ECHO_COUNT), max);
+}
+
+void main(void)
+{
+	for (size_t i = 0; i < sizeof(main_buf); i++) {
+		main_buf[i] = (u8_t)i;
+	}
+
+	bench_tcp();
+	bench_udp("udp", BULK_CHUNK, BULK_TOTAL / BULK_CHUNK);
+	bench_udp("udp_small", SMALL_SIZE, SMALL_COUNT);
+	bench_latency();
+
+	printk("fin\n");
+}
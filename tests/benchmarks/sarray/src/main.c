@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/rb.h>
+#include <sys/sarray.h>
+
+/* Microbenchmark of the red/black tree against the sorted array, used as
+ * a set of objects ordered by address. Each operation is applied to the
+ * whole set and the best of N_RUNS runs is reported, per object.
+ */
+
+#define N_RUNS 8
+#define MAX_OBJS 1024
+
+struct obj {
+	struct rbnode node;
+	u32_t data[2];
+};
+
+static struct obj objs[MAX_OBJS];
+static struct obj *order[MAX_OBJS];
+static void *sarray_elems[MAX_OBJS];
+
+static bool node_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return a < b;
+}
+
+static struct rbtree tree = {
+	.lessthan_fn = node_lessthan
+};
+
+static struct sarray set;
+
+enum op {
+	OP_INSERT,
+	OP_CONTAINS,
+	OP_FOREACH,
+	OP_REMOVE,
+};
+
+static const char *const op_names[] = {
+	[OP_INSERT] = "insert",
+	[OP_CONTAINS] = "contains",
+	[OP_FOREACH] = "foreach",
+	[OP_REMOVE] = "remove",
+};
+
+/* Same LCRNG as the rbtree unit test, for a repeatable order */
+static unsigned int next_rand_mod(unsigned int mod)
+{
+	static unsigned long long state = 123456789; /* seed */
+
+	state = state * 2862933555777941757ULL + 3037000493ULL;
+
+	return ((unsigned int)(state >> 32)) % mod;
+}
+
+static void shuffle(int n)
+{
+	for (int i = 0; i < n; i++) {
+		order[i] = &objs[i];
+	}
+
+	for (int i = n - 1; i > 0; i--) {
+		int j = next_rand_mod(i + 1);
+		struct obj *tmp = order[i];
+
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+}
+
+static volatile int found;
+
+static u32_t run_rb(enum op op, int n)
+{
+	struct rbnode *node;
+	u32_t start = k_cycle_get_32();
+
+	switch (op) {
+	case OP_INSERT:
+		for (int i = 0; i < n; i++) {
+			rb_insert(&tree, &order[i]->node);
+		}
+		break;
+	case OP_CONTAINS:
+		for (int i = 0; i < n; i++) {
+			found += rb_contains(&tree, &order[i]->node);
+		}
+		break;
+	case OP_FOREACH:
+		RB_FOR_EACH(&tree, node) {
+			found += (node != NULL);
+		}
+		break;
+	case OP_REMOVE:
+		for (int i = 0; i < n; i++) {
+			rb_remove(&tree, &order[i]->node);
+		}
+		break;
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static u32_t run_sarray(enum op op, int n)
+{
+	struct obj *o;
+	u32_t start = k_cycle_get_32();
+
+	switch (op) {
+	case OP_INSERT:
+		for (int i = 0; i < n; i++) {
+			(void)sarray_insert(&set, order[i]);
+		}
+		break;
+	case OP_CONTAINS:
+		for (int i = 0; i < n; i++) {
+			found += sarray_contains(&set, order[i]);
+		}
+		break;
+	case OP_FOREACH:
+		SARRAY_FOR_EACH(&set, o) {
+			found += (o != NULL);
+		}
+		break;
+	case OP_REMOVE:
+		for (int i = 0; i < n; i++) {
+			(void)sarray_remove(&set, order[i]);
+		}
+		break;
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static void bench(int n)
+{
+	u32_t best_rb[ARRAY_SIZE(op_names)];
+	u32_t best_sa[ARRAY_SIZE(op_names)];
+	enum op op;
+
+	for (op = OP_INSERT; op <= OP_REMOVE; op++) {
+		best_rb[op] = UINT32_MAX;
+		best_sa[op] = UINT32_MAX;
+	}
+
+	for (int run = 0; run < N_RUNS; run++) {
+		/* Each run goes through the whole life of the set, in a
+		 * new random order for each operation.
+		 */
+		for (op = OP_INSERT; op <= OP_REMOVE; op++) {
+			shuffle(n);
+			best_rb[op] = MIN(best_rb[op], run_rb(op, n));
+			best_sa[op] = MIN(best_sa[op], run_sarray(op, n));
+		}
+	}
+
+	for (op = OP_INSERT; op <= OP_REMOVE; op++) {
+		printk("%-8s %4d rb %6u cycles sarray %6u cycles\n",
+		       op_names[op], n, best_rb[op] / n, best_sa[op] / n);
+	}
+}
+
+void main(void)
+{
+	static const int sizes[] = { 16, 128, MAX_OBJS };
+
+	sarray_init(&set, sarray_elems, MAX_OBJS, NULL);
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		bench(sizes[i]);
+	}
+
+	printk("fin\n");
+}
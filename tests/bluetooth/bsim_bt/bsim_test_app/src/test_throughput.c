@@ -0,0 +1,422 @@
+/*
+ * Copyright (c) 2019 Oticon A/S
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "kernel.h"
+
+#include "bs_types.h"
+#include "bs_tracing.h"
+#include "time_machine.h"
+#include "bstests.h"
+
+#include <zephyr/types.h>
+#include <stddef.h>
+#include <errno.h>
+#include <string.h>
+#include <zephyr.h>
+#include <sys/printk.h>
+
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/hci.h>
+#include <bluetooth/conn.h>
+#include <bluetooth/uuid.h>
+#include <bluetooth/gatt.h>
+
+/*
+ * GATT throughput and connection latency benchmark:
+ *   The central connects to the peripheral advertising the benchmark
+ *   service and reports the connection setup time. The peripheral then
+ *   notifies as fast as it can for BENCH_TIME ms, after which the central
+ *   writes without response for the same time.
+ *
+ *   Every result is printed on a single line starting with "BENCH " and
+ *   followed by a JSON object, so that it can be collected by scripts for
+ *   regression tracking.
+ */
+
+#define WAIT_TIME  30   /* seconds */
+#define BENCH_TIME 5000 /* milliseconds */
+#define IDLE_TIME  500  /* milliseconds without data ending a phase */
+#define DATA_LEN   20   /* ATT payload with the default MTU of 23 */
+
+extern enum bst_result_t bst_result;
+
+#define FAIL(...)					\
+	do {						\
+		bst_result = Failed;			\
+		bs_trace_error_time_line(__VA_ARGS__);	\
+	} while (0)
+
+#define PASS(...)					\
+	do {						\
+		bst_result = Passed;			\
+		bs_trace_info_time(1, __VA_ARGS__);	\
+	} while (0)
+
+#define BT_UUID_BENCH_VAL BT_UUID_128_ENCODE(0x7a3a0d80, 0x63a5, 0x4e6b, \
+					     0x9d4c, 0x36bd2a1e6f01)
+#define BT_UUID_BENCH     BT_UUID_DECLARE_128(BT_UUID_BENCH_VAL)
+#define BT_UUID_BENCH_CHR BT_UUID_DECLARE_128( \
+			  BT_UUID_128_ENCODE(0x7a3a0d81, 0x63a5, 0x4e6b, \
+					     0x9d4c, 0x36bd2a1e6f01))
+
+struct bench_rx {
+	u32_t bytes;
+	u32_t first;
+	u32_t last;
+};
+
+static struct bt_conn *default_conn;
+static u8_t bench_data[DATA_LEN];
+
+static K_SEM_DEFINE(sem_connected, 0, 1);
+static K_SEM_DEFINE(sem_ready, 0, 1);
+
+static void bench_rx_add(struct bench_rx *rx, u16_t len)
+{
+	u32_t now = k_uptime_get_32();
+
+	if (!rx->bytes) {
+		rx->first = now;
+	}
+
+	rx->bytes += len;
+	rx->last = now;
+}
+
+static bool bench_rx_done(struct bench_rx *rx)
+{
+	return rx->bytes && (k_uptime_get_32() - rx->last) > IDLE_TIME;
+}
+
+static void bench_report(const char *test, u32_t bytes, u32_t time_ms)
+{
+	/* bits per millisecond is kbit/s */
+	printk("BENCH {\"test\":\"%s\",\"bytes\":%u,\"time_ms\":%u,"
+	       "\"kbps\":%u}\n", test, bytes, time_ms,
+	       time_ms ? (bytes * 8U) / time_ms : 0U);
+}
+
+static void test_throughput_init(void)
+{
+	bst_ticker_set_next_tick_absolute(WAIT_TIME*1e6);
+	bst_result = In_progress;
+}
+
+static void test_throughput_tick(bs_time_t HW_device_time)
+{
+	if (bst_result != Passed) {
+		FAIL("test_throughput failed (not passed after %i seconds)\n",
+		     WAIT_TIME);
+	}
+}
+
+static void disconnected(struct bt_conn *conn, u8_t reason)
+{
+	printk("Disconnected (reason 0x%02x)\n", reason);
+
+	if (default_conn == conn) {
+		bt_conn_unref(default_conn);
+		default_conn = NULL;
+	}
+}
+
+/* Peripheral role */
+
+static struct bench_rx write_rx;
+
+static void bench_ccc_cfg_changed(const struct bt_gatt_attr *attr,
+				  u16_t value)
+{
+	if (value == BT_GATT_CCC_NOTIFY) {
+		k_sem_give(&sem_ready);
+	}
+}
+
+static ssize_t bench_write(struct bt_conn *conn,
+			   const struct bt_gatt_attr *attr, const void *buf,
+			   u16_t len, u16_t offset, u8_t flags)
+{
+	bench_rx_add(&write_rx, len);
+
+	return len;
+}
+
+BT_GATT_SERVICE_DEFINE(bench_svc,
+	BT_GATT_PRIMARY_SERVICE(BT_UUID_BENCH),
+	BT_GATT_CHARACTERISTIC(BT_UUID_BENCH_CHR,
+			       BT_GATT_CHRC_NOTIFY |
+			       BT_GATT_CHRC_WRITE_WITHOUT_RESP,
+			       BT_GATT_PERM_WRITE, NULL, bench_write, NULL),
+	BT_GATT_CCC(bench_ccc_cfg_changed,
+		    BT_GATT_PERM_READ | BT_GATT_PERM_WRITE),
+);
+
+static const struct bt_data ad[] = {
+	BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
+	BT_DATA_BYTES(BT_DATA_UUID128_ALL, BT_UUID_BENCH_VAL),
+};
+
+static void periph_connected(struct bt_conn *conn, u8_t err)
+{
+	if (err) {
+		FAIL("Connection failed (err 0x%02x)\n", err);
+		return;
+	}
+
+	printk("Connected\n");
+	default_conn = bt_conn_ref(conn);
+}
+
+static struct bt_conn_cb periph_conn_callbacks = {
+	.connected = periph_connected,
+	.disconnected = disconnected,
+};
+
+static void test_throughput_periph_main(void)
+{
+	u32_t start, bytes = 0U;
+	u16_t len;
+	int err;
+
+	err = bt_enable(NULL);
+	if (err) {
+		FAIL("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	bt_conn_cb_register(&periph_conn_callbacks);
+
+	err = bt_le_adv_start(BT_LE_ADV_CONN, ad, ARRAY_SIZE(ad), NULL, 0);
+	if (err) {
+		FAIL("Advertising failed to start (err %d)\n", err);
+		return;
+	}
+
+	k_sem_take(&sem_ready, K_FOREVER);
+
+	len = MIN(bt_gatt_get_mtu(default_conn) - 3, sizeof(bench_data));
+
+	start = k_uptime_get_32();
+	while (k_uptime_get_32() - start < BENCH_TIME) {
+		err = bt_gatt_notify(default_conn, &bench_svc.attrs[1],
+				     bench_data, len);
+		if (err) {
+			k_sleep(K_MSEC(1));
+			continue;
+		}
+
+		bytes += len;
+	}
+
+	bench_report("gatt_notify_tx", bytes, k_uptime_get_32() - start);
+
+	while (!bench_rx_done(&write_rx)) {
+		k_sleep(K_MSEC(100));
+	}
+
+	bench_report("gatt_write_cmd_rx", write_rx.bytes,
+		     write_rx.last - write_rx.first);
+
+	PASS("Testcase passed\n");
+}
+
+/* Central role */
+
+static struct bench_rx notify_rx;
+static struct bt_gatt_discover_params discover_params;
+static struct bt_gatt_subscribe_params subscribe_params;
+static u32_t conn_create_time;
+
+static u8_t notify_func(struct bt_conn *conn,
+			struct bt_gatt_subscribe_params *params,
+			const void *data, u16_t length)
+{
+	if (!data) {
+		params->value_handle = 0U;
+		return BT_GATT_ITER_STOP;
+	}
+
+	bench_rx_add(&notify_rx, length);
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static u8_t discover_func(struct bt_conn *conn,
+			  const struct bt_gatt_attr *attr,
+			  struct bt_gatt_discover_params *params)
+{
+	int err;
+
+	if (!attr) {
+		FAIL("Benchmark characteristic not found\n");
+		return BT_GATT_ITER_STOP;
+	}
+
+	/* The CCC directly follows the characteristic value */
+	subscribe_params.notify = notify_func;
+	subscribe_params.value = BT_GATT_CCC_NOTIFY;
+	subscribe_params.value_handle = attr->handle + 1;
+	subscribe_params.ccc_handle = attr->handle + 2;
+
+	err = bt_gatt_subscribe(conn, &subscribe_params);
+	if (err && err != -EALREADY) {
+		FAIL("Subscribe failed (err %d)\n", err);
+	}
+
+	return BT_GATT_ITER_STOP;
+}
+
+static void central_connected(struct bt_conn *conn, u8_t err)
+{
+	if (err) {
+		FAIL("Connection failed (err 0x%02x)\n", err);
+		return;
+	}
+
+	bench_report("conn_setup", 0U, k_uptime_get_32() - conn_create_time);
+
+	k_sem_give(&sem_connected);
+}
+
+static struct bt_conn_cb central_conn_callbacks = {
+	.connected = central_connected,
+	.disconnected = disconnected,
+};
+
+static bool ad_has_bench_uuid(struct bt_data *data, void *user_data)
+{
+	bool *found = user_data;
+	struct bt_uuid_128 uuid;
+
+	if (data->type != BT_DATA_UUID128_ALL ||
+	    data->data_len != sizeof(uuid.val)) {
+		return true;
+	}
+
+	uuid.uuid.type = BT_UUID_TYPE_128;
+	memcpy(uuid.val, data->data, sizeof(uuid.val));
+	*found = !bt_uuid_cmp(&uuid.uuid, BT_UUID_BENCH);
+
+	return !*found;
+}
+
+static void device_found(const bt_addr_le_t *addr, s8_t rssi, u8_t type,
+			 struct net_buf_simple *ad)
+{
+	bool found = false;
+	int err;
+
+	if (default_conn || type != BT_LE_ADV_IND) {
+		return;
+	}
+
+	bt_data_parse(ad, ad_has_bench_uuid, &found);
+	if (!found) {
+		return;
+	}
+
+	err = bt_le_scan_stop();
+	if (err) {
+		FAIL("Stop LE scan failed (err %d)\n", err);
+		return;
+	}
+
+	conn_create_time = k_uptime_get_32();
+	default_conn = bt_conn_create_le(addr, BT_LE_CONN_PARAM_DEFAULT);
+	if (!default_conn) {
+		FAIL("Create connection failed\n");
+	}
+}
+
+static void test_throughput_central_main(void)
+{
+	u32_t start, bytes = 0U;
+	u16_t len, handle;
+	int err;
+
+	err = bt_enable(NULL);
+	if (err) {
+		FAIL("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	bt_conn_cb_register(&central_conn_callbacks);
+
+	err = bt_le_scan_start(BT_LE_SCAN_PASSIVE, device_found);
+	if (err) {
+		FAIL("Scanning failed to start (err %d)\n", err);
+		return;
+	}
+
+	k_sem_take(&sem_connected, K_FOREVER);
+
+	discover_params.uuid = BT_UUID_BENCH_CHR;
+	discover_params.func = discover_func;
+	discover_params.start_handle = 0x0001;
+	discover_params.end_handle = 0xffff;
+	discover_params.type = BT_GATT_DISCOVER_CHARACTERISTIC;
+
+	err = bt_gatt_discover(default_conn, &discover_params);
+	if (err) {
+		FAIL("Discover failed (err %d)\n", err);
+		return;
+	}
+
+	while (!bench_rx_done(&notify_rx)) {
+		k_sleep(K_MSEC(100));
+	}
+
+	bench_report("gatt_notify_rx", notify_rx.bytes,
+		     notify_rx.last - notify_rx.first);
+
+	len = MIN(bt_gatt_get_mtu(default_conn) - 3, sizeof(bench_data));
+
+	handle = subscribe_params.value_handle;
+
+	start = k_uptime_get_32();
+	while (k_uptime_get_32() - start < BENCH_TIME) {
+		err = bt_gatt_write_without_response(default_conn, handle,
+						     bench_data, len, false);
+		if (err) {
+			k_sleep(K_MSEC(1));
+			continue;
+		}
+
+		bytes += len;
+	}
+
+	bench_report("gatt_write_cmd_tx", bytes, k_uptime_get_32() - start);
+
+	PASS("Testcase passed\n");
+}
+
+static const struct bst_test_instance test_throughput[] = {
+	{
+		.test_id = "throughput_peripheral",
+		.test_descr = "GATT throughput benchmark, peripheral side. "
+			      "Notifies for 5 seconds, then receives writes "
+			      "without response and reports both rates.",
+		.test_post_init_f = test_throughput_init,
+		.test_tick_f = test_throughput_tick,
+		.test_main_f = test_throughput_periph_main
+	},
+	{
+		.test_id = "throughput_central",
+		.test_descr = "GATT throughput benchmark, central side. "
+			      "Reports the connection setup time and the "
+			      "notification and write without response "
+			      "rates.",
+		.test_post_init_f = test_throughput_init,
+		.test_tick_f = test_throughput_tick,
+		.test_main_f = test_throughput_central_main
+	},
+	BSTEST_END_MARKER
+};
+
+struct bst_test_list *test_throughput_install(struct bst_test_list *tests)
+{
+	tests = bst_add_tests(tests, test_throughput);
+	return tests;
+}
@@ -263,6 +263,83 @@ void test_gatt_write(void)
 			  "Attribute write value don't match");
 }
 
+static void check_handles(const struct bt_gatt_attr *attrs, size_t count,
+			  bool registered)
+{
+	const struct bt_gatt_attr *attr;
+	u16_t handle;
+	size_t i;
+
+	for (i = 0; i < count; i++) {
+		handle = attrs[0].handle + i;
+
+		attr = NULL;
+		bt_gatt_foreach_attr(handle, handle, find_attr, &attr);
+
+		if (registered) {
+			zassert_equal_ptr(attr, &attrs[i],
+					  "Handle 0x%04x not found", handle);
+			zassert_equal(attr->handle, handle,
+				      "Attribute handle don't match");
+		} else {
+			zassert_is_null(attr, "Handle 0x%04x found", handle);
+		}
+	}
+}
+
+static u8_t get_handle(const struct bt_gatt_attr *attr, void *user_data)
+{
+	u16_t *handle = user_data;
+
+	*handle = attr->handle;
+
+	return BT_GATT_ITER_STOP;
+}
+
+void test_gatt_attr_index(void)
+{
+	u16_t start, end, handle, found, num = 0;
+
+	/* Start over from the services left by the previous tests */
+	(void)bt_gatt_service_unregister(&test_svc);
+	(void)bt_gatt_service_unregister(&test1_svc);
+
+	zassert_false(bt_gatt_service_register(&test_svc),
+		     "Test service registration failed");
+	zassert_false(bt_gatt_service_register(&test1_svc),
+		     "Test service1 registration failed");
+
+	/* Every handle leads to its own attribute */
+	check_handles(test_attrs, ARRAY_SIZE(test_attrs), true);
+	check_handles(test1_attrs, ARRAY_SIZE(test1_attrs), true);
+
+	/* A range is walked in handle order without gaps */
+	start = test_attrs[0].handle;
+	end = test1_attrs[ARRAY_SIZE(test1_attrs) - 1].handle;
+	bt_gatt_foreach_attr(start, end, count_attr, &num);
+	zassert_equal(num, end - start + 1, "Number of attributes don't match");
+
+	/* Handles of unregistered services lead nowhere */
+	zassert_false(bt_gatt_service_unregister(&test1_svc),
+		     "Test service1 unregister failed");
+	check_handles(test1_attrs, ARRAY_SIZE(test1_attrs), false);
+	check_handles(test_attrs, ARRAY_SIZE(test_attrs), true);
+
+	/* Static attributes are found by their handle too */
+	handle = 0U;
+	bt_gatt_foreach_attr_type(0x0001, 0xffff, BT_UUID_GAP_DEVICE_NAME, NULL,
+				  1, get_handle, &handle);
+	zassert_not_equal(handle, 0U, "Device name not found");
+
+	found = 0U;
+	bt_gatt_foreach_attr_type(handle, handle, BT_UUID_GAP_DEVICE_NAME,
+				  NULL, 1, get_handle, &found);
+	zassert_equal(found, handle, "Device name not found by its handle");
+
+	zassert_false(bt_gatt_service_unregister(&test_svc),
+		     "Test service unregister failed");
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -271,6 +348,7 @@ void test_main(void)
 			 ztest_unit_test(test_gatt_unregister),
 			 ztest_unit_test(test_gatt_foreach),
 			 ztest_unit_test(test_gatt_read),
-			 ztest_unit_test(test_gatt_write));
+			 ztest_unit_test(test_gatt_write),
+			 ztest_unit_test(test_gatt_attr_index));
 	ztest_run_test_suite(test_gatt);
 }
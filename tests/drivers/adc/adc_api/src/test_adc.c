@@ -549,3 +549,79 @@ void test_adc_invalid_request(void)
 {
 	zassert_true(test_task_invalid_request() == TC_PASS, NULL);
 }
+
+/*
+ * test_adc_stream
+ */
+#if defined(CONFIG_ADC_STREAM)
+#define STREAM_BLOCK_SAMPLES 32
+#define STREAM_BLOCKS        4
+static s16_t m_stream_buffers[2][STREAM_BLOCK_SAMPLES];
+static K_SEM_DEFINE(stream_sem, 0, STREAM_BLOCKS);
+static u8_t m_stream_blocks;
+
+static void stream_callback(struct device *dev, void *block, size_t size,
+			    void *user_data)
+{
+	zassert_equal(block, m_stream_buffers[m_stream_blocks % 2],
+		      "blocks not delivered alternately");
+	zassert_equal(size, sizeof(m_stream_buffers[0]), NULL);
+
+	if (++m_stream_blocks <= STREAM_BLOCKS) {
+		k_sem_give(&stream_sem);
+	}
+}
+
+static int test_task_stream(void)
+{
+	int ret;
+	int i;
+	const struct adc_sequence_options options = {
+		.interval_us = 100,
+	};
+	const struct adc_sequence sequence = {
+		.options     = &options,
+		.channels    = BIT(ADC_1ST_CHANNEL_ID),
+		.resolution  = ADC_RESOLUTION,
+	};
+	const struct adc_stream_config config = {
+		.sequence   = &sequence,
+		.buffers    = { m_stream_buffers[0], m_stream_buffers[1] },
+		.block_size = sizeof(m_stream_buffers[0]),
+		.callback   = stream_callback,
+	};
+
+	struct device *adc_dev = init_adc();
+
+	if (!adc_dev) {
+		return TC_FAIL;
+	}
+
+	ret = adc_stream_start(adc_dev, &config);
+	if (ret == -ENOTSUP) {
+		ztest_test_skip();
+	}
+	zassert_equal(ret, 0, "adc_stream_start() failed with code %d", ret);
+
+	for (i = 0; i < STREAM_BLOCKS; i++) {
+		ret = k_sem_take(&stream_sem, K_MSEC(100));
+		zassert_equal(ret, 0, "block %d not delivered", i);
+	}
+
+	ret = adc_stream_stop(adc_dev);
+	zassert_equal(ret, 0, "adc_stream_stop() failed with code %d", ret);
+
+	zassert_not_equal(m_stream_buffers[0][0], 0, "no samples");
+
+	return TC_PASS;
+}
+#endif /* defined(CONFIG_ADC_STREAM) */
+
+void test_adc_stream(void)
+{
+#if defined(CONFIG_ADC_STREAM)
+	zassert_true(test_task_stream() == TC_PASS, NULL);
+#else
+	ztest_test_skip();
+#endif /* defined(CONFIG_ADC_STREAM) */
+}
@@ -260,6 +260,75 @@ static void test_double_write(void)
 	zassert_equal(-EIO, rc, "Unexpected error code (%d)", rc);
 }
 
+#if defined(CONFIG_FLASH_ASYNC)
+static int async_wait(struct k_poll_signal *sig)
+{
+	struct k_poll_event evt = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, sig);
+	unsigned int signaled;
+	int result;
+	int rc;
+
+	rc = k_poll(&evt, 1, K_SECONDS(1));
+	zassert_equal(0, rc, "Request not completed");
+
+	k_poll_signal_check(sig, &signaled, &result);
+	zassert_true(signaled, NULL);
+	k_poll_signal_reset(sig);
+
+	return result;
+}
+
+static void test_async(void)
+{
+	static u32_t data[FLASH_SIMULATOR_ERASE_UNIT / 4];
+	struct k_poll_signal sig = K_POLL_SIGNAL_INITIALIZER(sig);
+	off_t off;
+	int rc;
+
+	/* Write protection is left as set by the caller */
+	rc = flash_write_protection_set(flash_dev, true);
+	zassert_equal(0, rc, NULL);
+
+	rc = flash_erase_async(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+			       FLASH_SIMULATOR_ERASE_UNIT, &sig);
+	zassert_equal(0, rc, "flash_erase_async should succeed");
+	rc = async_wait(&sig);
+	zassert_equal(-EACCES, rc, "Unexpected error code (%d)", rc);
+
+	rc = flash_write_protection_set(flash_dev, false);
+	zassert_equal(0, rc, NULL);
+
+	for (off = 0; off < ARRAY_SIZE(data); off++) {
+		data[off] = off;
+	}
+
+	/* Requests are executed in order */
+	rc = flash_erase_async(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+			       FLASH_SIMULATOR_ERASE_UNIT, NULL);
+	zassert_equal(0, rc, "flash_erase_async should succeed");
+	rc = flash_write_async(flash_dev, FLASH_SIMULATOR_BASE_OFFSET, data,
+			       sizeof(data), &sig);
+	zassert_equal(0, rc, "flash_write_async should succeed");
+	rc = async_wait(&sig);
+	zassert_equal(0, rc, "Unexpected error code (%d)", rc);
+
+	pattern32_ini(0);
+	test_check_pattern32(FLASH_SIMULATOR_BASE_OFFSET, pattern32_inc,
+			     FLASH_SIMULATOR_ERASE_UNIT);
+
+	/* Protection is still disabled after the requests */
+	rc = flash_erase(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+			 FLASH_SIMULATOR_ERASE_UNIT);
+	zassert_equal(0, rc, "flash_erase should succeed");
+}
+#else
+static void test_async(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 void test_main(void)
 {
 	ztest_test_suite(flash_sim_api,
@@ -269,7 +338,8 @@ void test_main(void)
 			 ztest_unit_test(test_access),
 			 ztest_unit_test(test_out_of_bounds),
 			 ztest_unit_test(test_align),
-			 ztest_unit_test(test_double_write));
+			 ztest_unit_test(test_double_write),
+			 ztest_unit_test(test_async));
 
 	ztest_run_test_suite(flash_sim_api);
 }
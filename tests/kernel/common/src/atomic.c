@@ -19,7 +19,8 @@
  * atomic_inc(), atomic_dec(), atomic_get(), atomic_set(),
  * atomic_clear(), atomic_or(), atomic_and(), atomic_xor(),
  * atomic_nand(), atomic_test_bit(), atomic_test_and_clear_bit(),
- * atomic_test_and_set_bit(), atomic_clear_bit(), atomic_set_bit()
+ * atomic_test_and_set_bit(), atomic_clear_bit(), atomic_set_bit(),
+ * atomic_ptr_cas(), atomic_ptr_get(), atomic_ptr_set(), atomic_ptr_clear()
  */
 void test_atomic(void)
 {
@@ -28,6 +29,8 @@ void test_atomic(void)
 	atomic_t target, orig;
 	atomic_val_t value;
 	atomic_val_t oldvalue;
+	atomic_ptr_t ptr_target;
+	int ptr_a, ptr_b;
 
 	target = 4;
 	value = 5;
@@ -101,6 +104,27 @@ void test_atomic(void)
 	zassert_true((atomic_nand(&target, value) == 0xFF00), "atomic_nand");
 	zassert_true((target == 0xFFFFF0FF), "atomic_nand");
 
+	/* atomic_ptr_cas() */
+	ptr_target = &ptr_a;
+	zassert_false(atomic_ptr_cas(&ptr_target, &ptr_b, &ptr_a),
+		      "atomic_ptr_cas");
+	zassert_true(atomic_ptr_cas(&ptr_target, &ptr_a, &ptr_b),
+		     "atomic_ptr_cas");
+	zassert_true(ptr_target == &ptr_b, "atomic_ptr_cas");
+
+	/* atomic_ptr_get() */
+	zassert_true(atomic_ptr_get(&ptr_target) == &ptr_b, "atomic_ptr_get");
+
+	/* atomic_ptr_set() */
+	zassert_true(atomic_ptr_set(&ptr_target, &ptr_a) == &ptr_b,
+		     "atomic_ptr_set");
+	zassert_true(ptr_target == &ptr_a, "atomic_ptr_set");
+
+	/* atomic_ptr_clear() */
+	zassert_true(atomic_ptr_clear(&ptr_target) == &ptr_a,
+		     "atomic_ptr_clear");
+	zassert_true(ptr_target == NULL, "atomic_ptr_clear");
+
 	/* atomic_test_bit() */
 	for (i = 0; i < 32; i++) {
 		target = 0x0F0F0F0F;
@@ -15,35 +15,22 @@ void __printk_hook_install(int (*fn)(int));
 void *__printk_get_hook(void);
 int (*_old_char_out)(int);
 
-#ifndef CONFIG_64BIT
-
 char *expected = "22 113 10000 32768 40000 22\n"
 		 "p 112 -10000 -32768 -40000 -22\n"
-		 "0xcafebabe 0x0000beef\n"
+		 "0xcafebabe 0xbeef\n"
 		 "0x1 0x01 0x0001 0x00000001 0x0000000000000001\n"
 		 "0x1 0x 1 0x   1 0x       1\n"
 		 "42 42 0042 00000042\n"
 		 "-42 -42 -042 -0000042\n"
 		 "42 42   42       42\n"
 		 "42 42 0042 00000042\n"
-		 "255     42    abcdef  0x0000002a      42\n"
-		 "ERR -1 ERR ffffffffffffffff\n"
-;
-#else
-
-char *expected = "22 113 10000 32768 40000 22\n"
-		 "p 112 -10000 -32768 -40000 -22\n"
-		 "0xcafebabe 0x000000000000beef\n"
-		 "0x1 0x01 0x0001 0x00000001 0x0000000000000001\n"
-		 "0x1 0x 1 0x   1 0x       1\n"
-		 "42 42 0042 00000042\n"
-		 "-42 -42 -042 -0000042\n"
-		 "42 42   42       42\n"
-		 "42 42 0042 00000042\n"
-		 "255     42    abcdef  0x000000000000002a      42\n"
+		 "255     42    abcdef0x2a      42\n"
+#ifdef CONFIG_CBPRINTF_FULL_INTEGRAL
 		 "68719476735 -1 18446744073709551615 ffffffffffffffff\n"
-;
+#else
+		 "ERR -1 ERR ffffffffffffffff\n"
 #endif
+;
 
 size_t stv = 22;
 unsigned char uc = 'q';
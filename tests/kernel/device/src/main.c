@@ -56,6 +56,26 @@ void test_dummy_device(void)
 	zassert_true((dev == NULL), NULL);
 }
 
+/**
+ * @brief Test device binding resolved once per call site
+ *
+ * @see DEVICE_GET_BINDING_ONCE()
+ */
+static struct device *get_dummy_once(void)
+{
+	return DEVICE_GET_BINDING_ONCE(DUMMY_PORT_2);
+}
+
+void test_device_get_binding_once(void)
+{
+	struct device *dev = device_get_binding(DUMMY_PORT_2);
+
+	zassert_not_null(dev, NULL);
+	zassert_equal(get_dummy_once(), dev, NULL);
+	zassert_equal(get_dummy_once(), dev, NULL);
+	zassert_is_null(DEVICE_GET_BINDING_ONCE(BAD_DRIVER), NULL);
+}
+
 /**
  * @brief Test device binding for existing device
  *
@@ -252,6 +272,7 @@ void test_main(void)
 			 ztest_unit_test(test_dummy_device_pm),
 			 ztest_unit_test(build_suspend_device_list),
 			 ztest_unit_test(test_dummy_device),
+			 ztest_unit_test(test_device_get_binding_once),
 			 ztest_unit_test(test_pre_kernel_detection),
 			 ztest_user_unit_test(test_bogus_dynamic_name),
 			 ztest_user_unit_test(test_dynamic_name));
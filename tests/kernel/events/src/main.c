@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+#define EV_A BIT(0)
+#define EV_B BIT(1)
+#define EV_C BIT(2)
+
+K_EVENT_DEFINE(kevent);
+static struct k_event event;
+
+K_THREAD_STACK_DEFINE(waiter_stack, STACK_SIZE);
+static struct k_thread waiter_thread;
+
+static volatile u32_t waiter_result;
+static volatile bool waiter_done;
+
+static void waiter_entry(void *p1, void *p2, void *p3)
+{
+	waiter_result = k_event_wait(p1, POINTER_TO_UINT(p2),
+				     POINTER_TO_UINT(p3), K_FOREVER);
+	waiter_done = true;
+}
+
+/* Higher priority than the (preemptible) test thread: pends on the event
+ * before we go on, and runs as soon as it is woken up
+ */
+static void spawn_waiter(struct k_event *ev, u32_t events, u32_t options)
+{
+	waiter_result = 0U;
+	waiter_done = false;
+	k_thread_create(&waiter_thread, waiter_stack, STACK_SIZE,
+			waiter_entry, ev, UINT_TO_POINTER(events),
+			UINT_TO_POINTER(options),
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+}
+
+/**
+ * @brief Test waiting for events already set
+ */
+void test_event_no_wait(void)
+{
+	k_event_init(&event);
+
+	zassert_equal(k_event_wait(&event, EV_A, 0, K_NO_WAIT), 0, NULL);
+
+	zassert_equal(k_event_set(&event, EV_A | EV_B), EV_A | EV_B, NULL);
+	zassert_equal(k_event_wait(&event, EV_A | EV_C, 0, K_NO_WAIT),
+		      EV_A | EV_B, "wait for any failed");
+	zassert_equal(k_event_clear(&event, 0), EV_B, "event not consumed");
+
+	zassert_equal(k_event_wait(&event, EV_B | EV_C, K_EVENT_WAIT_ALL,
+				   K_NO_WAIT), 0, "wait for all succeeded");
+	zassert_equal(k_event_wait(&event, EV_B, K_EVENT_NO_CLEAR, K_NO_WAIT),
+		      EV_B, NULL);
+	zassert_equal(k_event_clear(&event, EV_B), EV_B, "event consumed");
+	zassert_equal(k_event_clear(&event, 0), 0, NULL);
+}
+
+/**
+ * @brief Test that only satisfied waiters are woken up
+ */
+void test_event_wait_all(void)
+{
+	spawn_waiter(&kevent, EV_A | EV_B, K_EVENT_WAIT_ALL);
+
+	k_event_set(&kevent, EV_A);
+	zassert_false(waiter_done, "woken up with one event of two");
+
+	k_event_set(&kevent, EV_B | EV_C);
+	zassert_true(waiter_done, "not woken up");
+	zassert_equal(waiter_result, EV_A | EV_B | EV_C, NULL);
+	zassert_equal(k_event_clear(&kevent, EV_C), EV_C,
+		      "waited events not consumed");
+}
+
+static void isr_set(void *param)
+{
+	k_event_set(param, EV_C);
+}
+
+/**
+ * @brief Test setting events from an ISR
+ */
+void test_event_isr_set(void)
+{
+	k_event_init(&event);
+	spawn_waiter(&event, EV_B | EV_C, 0);
+
+	irq_offload(isr_set, &event);
+	zassert_true(waiter_done, "not woken up");
+	zassert_equal(waiter_result, EV_C, NULL);
+}
+
+/**
+ * @brief Test waiting for events with a timeout
+ */
+void test_event_timeout(void)
+{
+	k_event_init(&event);
+	k_event_set(&event, EV_A);
+
+	zassert_equal(k_event_wait(&event, EV_A | EV_B, K_EVENT_WAIT_ALL,
+				   K_MSEC(10)), 0, "no timeout");
+	zassert_equal(k_event_clear(&event, 0), EV_A, NULL);
+}
+
+/**
+ * @brief Test polling an event object
+ */
+void test_event_poll(void)
+{
+	struct k_poll_event poll_event;
+
+	k_event_init(&event);
+	k_poll_event_init(&poll_event, K_POLL_TYPE_EVENT,
+			  K_POLL_MODE_NOTIFY_ONLY, &event);
+
+	zassert_equal(k_poll(&poll_event, 1, K_NO_WAIT), -EAGAIN, NULL);
+
+	irq_offload(isr_set, &event);
+	zassert_equal(k_poll(&poll_event, 1, K_NO_WAIT), 0, NULL);
+	zassert_equal(poll_event.state, K_POLL_STATE_EVENT_SET, NULL);
+	zassert_equal(k_event_clear(&event, EV_C), EV_C, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(events,
+			 ztest_unit_test(test_event_no_wait),
+			 ztest_unit_test(test_event_wait_all),
+			 ztest_unit_test(test_event_isr_set),
+			 ztest_unit_test(test_event_timeout),
+			 ztest_unit_test(test_event_poll));
+	ztest_run_test_suite(events);
+}
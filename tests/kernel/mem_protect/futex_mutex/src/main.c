@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/futex_mutex.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define TIMEOUT K_MSEC(100)
+
+ZTEST_BMEM struct sys_futex_mutex mutex;
+ZTEST_DMEM SYS_FUTEX_MUTEX_DEFINE(static_mutex);
+ZTEST_BMEM int shared_count;
+
+K_THREAD_STACK_DEFINE(stack_1, STACK_SIZE);
+struct k_thread tid_1;
+
+#ifdef CONFIG_USERSPACE
+#define THREAD_FLAGS (K_USER | K_INHERIT_PERMS)
+#else
+#define THREAD_FLAGS 0
+#endif
+
+static void lock_helper(void *p1, void *p2, void *p3)
+{
+	zassert_equal(sys_futex_mutex_lock(&mutex, K_FOREVER), 0, NULL);
+	shared_count++;
+	zassert_equal(sys_futex_mutex_unlock(&mutex), 0, NULL);
+}
+
+static void hold_helper(void *p1, void *p2, void *p3)
+{
+	zassert_equal(sys_futex_mutex_lock(&mutex, K_NO_WAIT), 0, NULL);
+	k_sleep(TIMEOUT);
+	zassert_equal(sys_futex_mutex_unlock(&mutex), 0, NULL);
+}
+
+/**
+ * @brief Test uncontended locking and unlocking
+ */
+void test_futex_mutex_uncontended(void)
+{
+	sys_futex_mutex_init(&mutex);
+
+	zassert_equal(sys_futex_mutex_unlock(&mutex), -EINVAL, NULL);
+	zassert_equal(sys_futex_mutex_lock(&mutex, K_NO_WAIT), 0, NULL);
+#ifdef CONFIG_USERSPACE
+	/* an uncontended lock never marks the mutex for a wake-up */
+	zassert_equal(atomic_get(&mutex.futex.val), 1, NULL);
+#endif
+	zassert_equal(sys_futex_mutex_unlock(&mutex), 0, NULL);
+
+	zassert_equal(sys_futex_mutex_lock(&static_mutex, TIMEOUT), 0, NULL);
+	zassert_equal(sys_futex_mutex_unlock(&static_mutex), 0, NULL);
+	zassert_equal(sys_futex_mutex_unlock(&static_mutex), -EINVAL, NULL);
+}
+
+/**
+ * @brief Test that a waiter gets the mutex when it is released
+ */
+void test_futex_mutex_contended(void)
+{
+	sys_futex_mutex_init(&mutex);
+	shared_count = 0;
+
+	zassert_equal(sys_futex_mutex_lock(&mutex, K_FOREVER), 0, NULL);
+
+	k_thread_create(&tid_1, stack_1, STACK_SIZE, lock_helper,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), THREAD_FLAGS,
+			K_NO_WAIT);
+	k_sleep(TIMEOUT);
+	zassert_equal(shared_count, 0, "waiter ran while mutex was held");
+
+	zassert_equal(sys_futex_mutex_unlock(&mutex), 0, NULL);
+	k_sleep(TIMEOUT);
+	zassert_equal(shared_count, 1, "waiter did not get the mutex");
+
+	zassert_equal(sys_futex_mutex_lock(&mutex, K_NO_WAIT), 0, NULL);
+	zassert_equal(sys_futex_mutex_unlock(&mutex), 0, NULL);
+}
+
+/**
+ * @brief Test lock attempts on a held mutex that give up
+ */
+void test_futex_mutex_busy(void)
+{
+	sys_futex_mutex_init(&mutex);
+
+	k_thread_create(&tid_1, stack_1, STACK_SIZE, hold_helper,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), THREAD_FLAGS,
+			K_NO_WAIT);
+	k_sleep(TIMEOUT / 2);
+
+	zassert_equal(sys_futex_mutex_lock(&mutex, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(sys_futex_mutex_lock(&mutex, K_MSEC(10)), -ETIMEDOUT,
+		      NULL);
+	zassert_equal(sys_futex_mutex_lock(&mutex, K_FOREVER), 0, NULL);
+	zassert_equal(sys_futex_mutex_unlock(&mutex), 0, NULL);
+}
+
+void test_main(void)
+{
+#ifdef CONFIG_USERSPACE
+	k_thread_access_grant(k_current_get(), &stack_1, &tid_1);
+#endif
+
+	ztest_test_suite(test_futex_mutex,
+			 ztest_user_unit_test(test_futex_mutex_uncontended),
+			 ztest_1cpu_user_unit_test(test_futex_mutex_contended),
+			 ztest_1cpu_user_unit_test(test_futex_mutex_busy));
+	ztest_run_test_suite(test_futex_mutex);
+}
@@ -106,10 +106,120 @@ void test_generic_object(void)
 	}
 }
 
+#define DYN_INDEX_COUNT 12
+
+/**
+ * @brief Tests the lookup of dynamic objects as they come and go
+ *
+ * With a small index most objects overflow it, and frees in a scattered
+ * order move the remaining entries of the index around.
+ *
+ * @ingroup kernel_memprotect_tests
+ *
+ * @see k_object_alloc(), k_object_free()
+ */
+void test_dynamic_object_index(void)
+{
+	static const u8_t order[DYN_INDEX_COUNT] = {
+		5, 0, 11, 3, 8, 1, 10, 6, 2, 9, 4, 7
+	};
+	struct k_sem *sems[DYN_INDEX_COUNT];
+	bool freed[DYN_INDEX_COUNT] = { false };
+	struct _k_object *ko;
+
+	for (int i = 0; i < DYN_INDEX_COUNT; i++) {
+		sems[i] = k_object_alloc(K_OBJ_SEM);
+		zassert_not_null(sems[i], "couldn't allocate semaphore");
+	}
+
+	for (int i = 0; i < DYN_INDEX_COUNT; i++) {
+		ko = z_object_find(sems[i]);
+		zassert_not_null(ko, "object %d not found", i);
+		zassert_equal_ptr(ko->name, sems[i], NULL);
+	}
+
+	for (int i = 0; i < DYN_INDEX_COUNT; i++) {
+		k_object_free(sems[order[i]]);
+		freed[order[i]] = true;
+
+		/**TESTPOINT: only the freed objects are gone */
+		for (int j = 0; j < DYN_INDEX_COUNT; j++) {
+			ko = z_object_find(sems[j]);
+			zassert_equal(ko == NULL, freed[j],
+				      "object %d %s after freeing %d", j,
+				      freed[j] ? "found" : "lost", order[i]);
+		}
+	}
+}
+
+#if (CONFIG_USERSPACE_OBJ_CACHE_SIZE > 0)
+static struct k_sem sem4;
+
+static bool obj_cached(void *obj)
+{
+	struct _thread_obj_cache *cache = &k_current_get()->obj_cache;
+
+	for (int i = 0; i < CONFIG_USERSPACE_OBJ_CACHE_SIZE; i++) {
+		if (cache->entry[i].obj == obj) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Tests the per-thread cache of validated objects
+ *
+ * @ingroup kernel_memprotect_tests
+ *
+ * @see k_object_access_grant(), k_object_access_revoke(), k_object_free()
+ */
+void test_object_cache(void)
+{
+	struct k_sem *dsem;
+
+	k_object_access_grant(&sem4, k_current_get());
+	k_sem_init(&sem4, 0, 1);
+
+	/**TESTPOINT: a validated object is cached and still type checked */
+	zassert_equal(z_object_cached_validate(&sem4, K_OBJ_SEM,
+					       _OBJ_INIT_TRUE), 0, NULL);
+	zassert_true(obj_cached(&sem4), NULL);
+	zassert_equal(z_object_cached_validate(&sem4, K_OBJ_SEM,
+					       _OBJ_INIT_TRUE), 0, NULL);
+	zassert_equal(z_object_cached_validate(&sem4, K_OBJ_MUTEX,
+					       _OBJ_INIT_TRUE), -EBADF, NULL);
+
+	/**TESTPOINT: revoking permission invalidates the cache */
+	k_object_access_revoke(&sem4, k_current_get());
+	zassert_equal(z_object_cached_validate(&sem4, K_OBJ_SEM,
+					       _OBJ_INIT_TRUE), -EPERM, NULL);
+	zassert_false(obj_cached(&sem4), NULL);
+
+	/**TESTPOINT: freeing a dynamic object invalidates the cache */
+	dsem = k_object_alloc(K_OBJ_SEM);
+	zassert_not_null(dsem, "couldn't allocate semaphore");
+	k_sem_init(dsem, 0, 1);
+	zassert_equal(z_object_cached_validate(dsem, K_OBJ_SEM,
+					       _OBJ_INIT_TRUE), 0, NULL);
+	k_object_free(dsem);
+	zassert_equal(z_object_cached_validate(dsem, K_OBJ_SEM,
+					       _OBJ_INIT_TRUE), -EBADF, NULL);
+}
+#else
+void test_object_cache(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
 	ztest_test_suite(object_validation,
-			 ztest_unit_test(test_generic_object));
+			 ztest_unit_test(test_generic_object),
+			 ztest_unit_test(test_dynamic_object_index),
+			 ztest_unit_test(test_object_cache));
 	ztest_run_test_suite(object_validation);
 }
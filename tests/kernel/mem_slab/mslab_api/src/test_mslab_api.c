@@ -222,3 +222,53 @@ void test_mslab_used_get(void)
 	tmslab_used_get(&mslab);
 	tmslab_used_get(&kmslab);
 }
+
+/**
+ * @brief Verify per-CPU cache accounting of a memory slab
+ *
+ * @details With CONFIG_MEM_SLAB_CPU_CACHE, allocate and free every
+ * block of the slab twice and check that the second round is served
+ * from the CPU cache, that cached blocks still count as free, and
+ * that k_mem_slab_cache_flush() returns them to the shared list.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+void test_mslab_cpu_cache(void)
+{
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	struct k_mem_slab_cache_stats before, after;
+	void *block[BLK_NUM];
+	int i, round;
+
+	k_mem_slab_init(&mslab, tslab, BLK_SIZE, BLK_NUM);
+	k_mem_slab_cache_stats_get(&mslab, &before);
+
+	for (round = 0; round < 2; round++) {
+		for (i = 0; i < BLK_NUM; i++) {
+			zassert_equal(k_mem_slab_alloc(&mslab, &block[i],
+						       K_NO_WAIT), 0, NULL);
+		}
+		zassert_equal(k_mem_slab_num_free_get(&mslab), 0, NULL);
+		zassert_equal(k_mem_slab_alloc(&mslab, &block[0], K_NO_WAIT),
+			      -ENOMEM, NULL);
+
+		for (i = 0; i < BLK_NUM; i++) {
+			k_mem_slab_free(&mslab, &block[i]);
+		}
+		zassert_equal(k_mem_slab_num_used_get(&mslab), 0, NULL);
+		zassert_equal(k_mem_slab_num_free_get(&mslab), BLK_NUM, NULL);
+	}
+
+	k_mem_slab_cache_stats_get(&mslab, &after);
+	zassert_true(after.hits > before.hits, "no cache hits");
+	zassert_true(after.refills > before.refills, "no cache refills");
+	zassert_true(after.cached > 0, "no blocks cached");
+
+	k_mem_slab_cache_flush(&mslab);
+	k_mem_slab_cache_stats_get(&mslab, &after);
+	zassert_equal(after.cached, 0, "cache not flushed");
+	zassert_equal(k_mem_slab_num_free_get(&mslab), BLK_NUM, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
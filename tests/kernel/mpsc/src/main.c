@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+
+#define NUM_ITEMS 4
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+struct item {
+	void *reserved;
+	int value;
+};
+
+static struct item items[NUM_ITEMS];
+
+K_MPSC_DEFINE(kmpsc);
+static struct k_mpsc mpsc;
+
+K_THREAD_STACK_DEFINE(producer_stack, STACK_SIZE);
+static struct k_thread producer_thread;
+
+static void producer_entry(void *p1, void *p2, void *p3)
+{
+	struct k_mpsc *queue = p1;
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_mpsc_put(queue, &items[i]);
+	}
+}
+
+static void isr_put(void *param)
+{
+	struct k_mpsc *queue = param;
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_mpsc_put(queue, &items[i]);
+	}
+}
+
+static void check_all_items(struct k_mpsc *queue, s32_t timeout)
+{
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		struct item *it = k_mpsc_get(queue, timeout);
+
+		zassert_equal(it, &items[i], "items out of order");
+		zassert_equal(it->value, i, NULL);
+	}
+
+	zassert_true(k_mpsc_is_empty(queue), NULL);
+	zassert_is_null(k_mpsc_get(queue, K_NO_WAIT), NULL);
+}
+
+static void spawn_producer(struct k_mpsc *queue)
+{
+	/* Lower priority than us: only runs once we block */
+	k_thread_create(&producer_thread, producer_stack, STACK_SIZE,
+			producer_entry, queue, NULL, NULL,
+			k_thread_priority_get(k_current_get()) + 1, 0,
+			K_NO_WAIT);
+}
+
+/**
+ * @brief Verify items put by a thread are returned in order
+ */
+void test_mpsc_thread2thread(void)
+{
+	k_mpsc_init(&mpsc);
+	zassert_true(k_mpsc_is_empty(&mpsc), NULL);
+
+	producer_entry(&mpsc, NULL, NULL);
+	zassert_false(k_mpsc_is_empty(&mpsc), NULL);
+	check_all_items(&mpsc, K_NO_WAIT);
+
+	/* Statically defined queue */
+	producer_entry(&kmpsc, NULL, NULL);
+	check_all_items(&kmpsc, K_NO_WAIT);
+}
+
+/**
+ * @brief Verify items put from an ISR are returned in order
+ */
+void test_mpsc_isr2thread(void)
+{
+	k_mpsc_init(&mpsc);
+	irq_offload(isr_put, &mpsc);
+	check_all_items(&mpsc, K_NO_WAIT);
+}
+
+/**
+ * @brief Verify that getting from an empty queue times out
+ */
+void test_mpsc_get_fail(void)
+{
+	k_mpsc_init(&mpsc);
+	zassert_is_null(k_mpsc_get(&mpsc, K_NO_WAIT), NULL);
+	zassert_is_null(k_mpsc_get(&mpsc, K_MSEC(20)), NULL);
+}
+
+/**
+ * @brief Verify a blocked consumer is woken by a producer
+ */
+void test_mpsc_get_wait(void)
+{
+	k_mpsc_init(&mpsc);
+	spawn_producer(&mpsc);
+	check_all_items(&mpsc, K_FOREVER);
+	k_thread_abort(&producer_thread);
+}
+
+/**
+ * @brief Verify k_poll() integration
+ */
+void test_mpsc_poll(void)
+{
+	struct k_poll_event event;
+	int ret;
+
+	k_mpsc_init(&mpsc);
+	k_poll_event_init(&event, K_POLL_TYPE_MPSC_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &mpsc);
+
+	ret = k_poll(&event, 1, K_NO_WAIT);
+	zassert_equal(ret, -EAGAIN, NULL);
+
+	spawn_producer(&mpsc);
+	ret = k_poll(&event, 1, K_FOREVER);
+	zassert_equal(ret, 0, NULL);
+	zassert_equal(event.state, K_POLL_STATE_DATA_AVAILABLE, NULL);
+
+	/* Let the producer finish putting the remaining items */
+	k_sleep(K_MSEC(10));
+	check_all_items(&mpsc, K_NO_WAIT);
+	k_thread_abort(&producer_thread);
+}
+
+void test_main(void)
+{
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		items[i].value = i;
+	}
+
+	ztest_test_suite(mpsc_api,
+			 ztest_unit_test(test_mpsc_thread2thread),
+			 ztest_unit_test(test_mpsc_isr2thread),
+			 ztest_unit_test(test_mpsc_get_fail),
+			 ztest_1cpu_unit_test(test_mpsc_get_wait),
+			 ztest_1cpu_unit_test(test_mpsc_poll));
+	ztest_run_test_suite(mpsc_api);
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_LEN 4
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+static char __aligned(4) bbuffer[MSG_SIZE * BATCH_LEN];
+static struct k_msgq bmsgq;
+static K_SEM_DEFINE(batch_sema, 0, 1);
+static u32_t rx[BATCH_LEN];
+
+static void batch_reader(void *p1, void *p2, void *p3)
+{
+	/* pends on the empty queue, then gets exactly one message */
+	zassert_equal(k_msgq_get_many(&bmsgq, rx, BATCH_LEN, K_FOREVER), 1,
+		      NULL);
+	k_sem_give(&batch_sema);
+}
+
+static void batch_writer(void *p1, void *p2, void *p3)
+{
+	static u32_t tx[2] = { 100, 101 };
+
+	/* pends on the full queue, then sends only the first message */
+	zassert_equal(k_msgq_put_many(&bmsgq, tx, 2, K_FOREVER), 1, NULL);
+	k_sem_give(&batch_sema);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test batched put and get on a message queue
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+void test_msgq_batch(void)
+{
+	u32_t tx[BATCH_LEN + 2] = { 0, 1, 2, 3, 4, 5 };
+
+	k_msgq_init(&bmsgq, bbuffer, MSG_SIZE, BATCH_LEN);
+
+	/**TESTPOINT: empty and full queues */
+	zassert_equal(k_msgq_get_many(&bmsgq, rx, BATCH_LEN, K_NO_WAIT),
+		      -ENOMSG, NULL);
+	zassert_equal(k_msgq_put_many(&bmsgq, tx, 0, K_NO_WAIT), 0, NULL);
+
+	/**TESTPOINT: a batch is truncated to the free space */
+	zassert_equal(k_msgq_put_many(&bmsgq, tx, BATCH_LEN + 2, K_NO_WAIT),
+		      BATCH_LEN, NULL);
+	zassert_equal(k_msgq_num_used_get(&bmsgq), BATCH_LEN, NULL);
+	zassert_equal(k_msgq_put_many(&bmsgq, tx, 1, K_NO_WAIT), -ENOMSG,
+		      NULL);
+
+	/**TESTPOINT: messages come out in order, across the wrap */
+	zassert_equal(k_msgq_get_many(&bmsgq, rx, 3, K_NO_WAIT), 3, NULL);
+	zassert_true(rx[0] == 0 && rx[1] == 1 && rx[2] == 2, NULL);
+	zassert_equal(k_msgq_put_many(&bmsgq, &tx[4], 2, K_NO_WAIT), 2, NULL);
+	zassert_equal(k_msgq_get_many(&bmsgq, rx, BATCH_LEN, K_NO_WAIT), 3,
+		      NULL);
+	zassert_true(rx[0] == 3 && rx[1] == 4 && rx[2] == 5, NULL);
+
+	/**TESTPOINT: a batch put serves a pended receiver first */
+	k_thread_create(&tdata, tstack, STACK_SIZE, batch_reader,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(TIMEOUT >> 1);
+	zassert_equal(k_msgq_put_many(&bmsgq, tx, 3, K_NO_WAIT), 3, NULL);
+	zassert_false(k_sem_take(&batch_sema, TIMEOUT), NULL);
+	zassert_equal(rx[0], 0, NULL);
+	zassert_equal(k_msgq_num_used_get(&bmsgq), 2, NULL);
+
+	/**TESTPOINT: a batch get refills from a pended sender */
+	zassert_equal(k_msgq_put_many(&bmsgq, tx, 2, K_NO_WAIT), 2, NULL);
+	k_thread_create(&tdata, tstack, STACK_SIZE, batch_writer,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(TIMEOUT >> 1);
+	zassert_equal(k_msgq_get_many(&bmsgq, rx, BATCH_LEN, K_NO_WAIT),
+		      BATCH_LEN, NULL);
+	zassert_true(rx[0] == 1 && rx[1] == 2 && rx[2] == 0 && rx[3] == 1,
+		     NULL);
+	zassert_false(k_sem_take(&batch_sema, TIMEOUT), NULL);
+	zassert_equal(k_msgq_get_many(&bmsgq, rx, BATCH_LEN, K_NO_WAIT), 1,
+		      NULL);
+	zassert_equal(rx[0], 100, NULL);
+}
+
+/**
+ * @}
+ */
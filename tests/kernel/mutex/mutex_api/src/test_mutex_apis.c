@@ -138,6 +138,90 @@ void test_mutex_lock_unlock(void)
 	tmutex_test_lock_unlock(&kmutex);
 }
 
+static K_THREAD_STACK_ARRAY_DEFINE(chain_stack, 3, STACK_SIZE);
+static struct k_thread chain_thread[3];
+static K_MUTEX_DEFINE(chain_m1);
+static K_MUTEX_DEFINE(chain_m2);
+static K_SEM_DEFINE(chain_release, 0, 1);
+
+static void chain_low(void *p1, void *p2, void *p3)
+{
+	zassert_false(k_mutex_lock(&chain_m1, K_FOREVER), NULL);
+	k_sem_take(&chain_release, K_FOREVER);
+	k_mutex_unlock(&chain_m1);
+}
+
+static void chain_mid(void *p1, void *p2, void *p3)
+{
+	zassert_false(k_mutex_lock(&chain_m2, K_FOREVER), NULL);
+	zassert_false(k_mutex_lock(&chain_m1, K_FOREVER), NULL);
+	k_mutex_unlock(&chain_m1);
+	k_mutex_unlock(&chain_m2);
+}
+
+static void chain_high(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_mutex_lock(&chain_m2, TIMEOUT), -EAGAIN, NULL);
+}
+
+/**
+ * @brief Test transitive priority inheritance along a chain of owners
+ *
+ * @details The low priority thread owns m1, the mid one owns m2 and
+ * waits on m1, and the high one waits on m2: both owners run at the high
+ * priority until the high thread gives up and then drop back to the mid
+ * priority.
+ *
+ * @see k_mutex_lock(), k_mutex_unlock()
+ */
+void test_mutex_priority_inheritance_chain(void)
+{
+	k_tid_t low, mid;
+
+	low = k_thread_create(&chain_thread[0], chain_stack[0], STACK_SIZE,
+			      chain_low, NULL, NULL, NULL,
+			      K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(20));
+	mid = k_thread_create(&chain_thread[1], chain_stack[1], STACK_SIZE,
+			      chain_mid, NULL, NULL, NULL,
+			      K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(20));
+	zassert_equal(k_thread_priority_get(low), K_PRIO_PREEMPT(8), NULL);
+
+	k_thread_create(&chain_thread[2], chain_stack[2], STACK_SIZE,
+			chain_high, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(20));
+
+	/**TESTPOINT: the boost reaches the owner at the end of the chain */
+	zassert_equal(k_thread_priority_get(mid), K_PRIO_PREEMPT(5), NULL);
+	if (CONFIG_PRIORITY_INHERITANCE_DEPTH > 1) {
+		zassert_equal(k_thread_priority_get(low), K_PRIO_PREEMPT(5),
+			      NULL);
+	}
+
+	/**TESTPOINT: the chain is lowered again on a waiter timeout */
+	k_sleep(TIMEOUT + 100);
+	zassert_equal(k_thread_priority_get(mid), K_PRIO_PREEMPT(8), NULL);
+	zassert_equal(k_thread_priority_get(low), K_PRIO_PREEMPT(8), NULL);
+
+#ifdef CONFIG_PRIORITY_INHERITANCE_STATS
+	struct k_mutex_pi_stats stats;
+
+	k_mutex_pi_stats_get(&stats);
+	zassert_true(stats.boosts >= 2U, NULL);
+	zassert_true(stats.chain_updates >= 2U, NULL);
+	zassert_true(stats.max_chain_depth >= 2U, NULL);
+#endif
+
+	/* let the chain unwind: low unlocks m1, mid takes it and exits */
+	k_sem_give(&chain_release);
+	k_sleep(K_MSEC(20));
+	zassert_equal(k_thread_priority_get(low), K_PRIO_PREEMPT(10), NULL);
+	zassert_true(k_mutex_lock(&chain_m2, K_NO_WAIT) == 0, NULL);
+	k_mutex_unlock(&chain_m2);
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -149,7 +233,8 @@ void test_main(void)
 			 ztest_1cpu_user_unit_test(test_mutex_reent_lock_forever),
 			 ztest_user_unit_test(test_mutex_reent_lock_no_wait),
 			 ztest_user_unit_test(test_mutex_reent_lock_timeout_fail),
-			 ztest_1cpu_user_unit_test(test_mutex_reent_lock_timeout_pass)
+			 ztest_1cpu_user_unit_test(test_mutex_reent_lock_timeout_pass),
+			 ztest_1cpu_unit_test(test_mutex_priority_inheritance_chain)
 			 );
 	ztest_run_test_suite(mutex_api);
 }
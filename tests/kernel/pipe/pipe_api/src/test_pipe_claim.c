@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <string.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define PIPE_LEN	16
+
+K_PIPE_DEFINE(claim_pipe, PIPE_LEN, 4);
+static K_THREAD_STACK_DEFINE(claim_stack, STACK_SIZE);
+static struct k_thread claim_thread;
+static K_SEM_DEFINE(claim_done, 0, 1);
+
+static unsigned char rx_buf[PIPE_LEN];
+
+static void claim_reader(void *p1, void *p2, void *p3)
+{
+	size_t bytes_read;
+
+	zassert_false(k_pipe_get(&claim_pipe, rx_buf, PIPE_LEN / 2,
+				 &bytes_read, PIPE_LEN / 2, K_FOREVER), NULL);
+	zassert_equal(bytes_read, PIPE_LEN / 2, NULL);
+	k_sem_give(&claim_done);
+}
+
+static void claim_writer(void *p1, void *p2, void *p3)
+{
+	static unsigned char tx[PIPE_LEN / 2] = "WXYZwxyz";
+	size_t bytes_written;
+
+	/* The pipe is full: this pends until space is released */
+	zassert_false(k_pipe_put(&claim_pipe, tx, sizeof(tx), &bytes_written,
+				 sizeof(tx), K_FOREVER), NULL);
+	zassert_equal(bytes_written, sizeof(tx), NULL);
+	k_sem_give(&claim_done);
+}
+
+/**
+ * @brief Test in-place writes and reads with the pipe claim API
+ *
+ * @ingroup kernel_pipe_tests
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_finish(),
+ * k_pipe_get_claim(), k_pipe_get_finish()
+ */
+void test_pipe_claim(void)
+{
+	u8_t *data;
+	size_t n;
+
+	/**TESTPOINT: claims are bounded by free space and data */
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, 4), 0, NULL);
+	n = k_pipe_put_claim(&claim_pipe, &data, PIPE_LEN + 4);
+	zassert_equal(n, PIPE_LEN, NULL);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, PIPE_LEN + 1), -EINVAL,
+		      NULL);
+
+	memcpy(data, "0123456789abcdef", 12);
+	zassert_false(k_pipe_put_finish(&claim_pipe, 12), NULL);
+	zassert_equal(claim_pipe.bytes_used, 12, NULL);
+
+	/**TESTPOINT: claimed data is what was written in place */
+	n = k_pipe_get_claim(&claim_pipe, &data, 8);
+	zassert_equal(n, 8, NULL);
+	zassert_false(memcmp(data, "01234567", 8), NULL);
+	zassert_false(k_pipe_get_finish(&claim_pipe, 8), NULL);
+
+	/**TESTPOINT: a claim stops at the end of the ring buffer */
+	n = k_pipe_put_claim(&claim_pipe, &data, 8);
+	zassert_equal(n, 4, NULL);
+	memcpy(data, "ghij", 4);
+	zassert_false(k_pipe_put_finish(&claim_pipe, 4), NULL);
+	n = k_pipe_put_claim(&claim_pipe, &data, 8);
+	zassert_equal(n, 8, NULL);
+	memcpy(data, "klmnopqr", 8);
+	zassert_false(k_pipe_put_finish(&claim_pipe, 8), NULL);
+	zassert_equal(claim_pipe.bytes_used, PIPE_LEN, NULL);
+
+	/**TESTPOINT: releasing space lets a pended writer finish */
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, claim_writer,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+
+	n = k_pipe_get_claim(&claim_pipe, &data, PIPE_LEN);
+	zassert_equal(n, 8, NULL);
+	zassert_false(memcmp(data, "89abghij", 8), NULL);
+	zassert_false(k_pipe_get_finish(&claim_pipe, 8), NULL);
+	zassert_false(k_sem_take(&claim_done, K_MSEC(100)), NULL);
+	zassert_equal(claim_pipe.bytes_used, PIPE_LEN, NULL);
+
+	n = k_pipe_get_claim(&claim_pipe, &data, PIPE_LEN);
+	zassert_equal(n, PIPE_LEN, NULL);
+	zassert_false(memcmp(data, "klmnopqrWXYZwxyz", PIPE_LEN), NULL);
+	zassert_false(k_pipe_get_finish(&claim_pipe, PIPE_LEN), NULL);
+
+	/**TESTPOINT: committing data feeds a pended reader */
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, claim_reader,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+
+	n = k_pipe_put_claim(&claim_pipe, &data, PIPE_LEN);
+	zassert_equal(n, PIPE_LEN, NULL);
+	memcpy(data, "ABCDEFGH", 8);
+	zassert_false(k_pipe_put_finish(&claim_pipe, 8), NULL);
+	zassert_false(k_sem_take(&claim_done, K_MSEC(100)), NULL);
+	zassert_false(memcmp(rx_buf, "ABCDEFGH", 8), NULL);
+	zassert_equal(claim_pipe.bytes_used, 0, NULL);
+}
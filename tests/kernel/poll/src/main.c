@@ -12,6 +12,7 @@ extern void test_poll_cancel_main_high_prio(void);
 extern void test_poll_multi(void);
 extern void test_poll_threadstate(void);
 extern void test_poll_grant_access(void);
+extern void test_poll_set(void);
 
 #ifdef CONFIG_64BIT
 #define MAX_SZ	256
@@ -34,6 +35,7 @@ void test_main(void)
 			 ztest_1cpu_unit_test(test_poll_cancel_main_low_prio),
 			 ztest_1cpu_unit_test(test_poll_cancel_main_high_prio),
 			 ztest_unit_test(test_poll_multi),
-			 ztest_1cpu_unit_test(test_poll_threadstate));
+			 ztest_1cpu_unit_test(test_poll_threadstate),
+			 ztest_1cpu_unit_test(test_poll_set));
 	ztest_run_test_suite(poll_api);
 }
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <kernel.h>
+
+#define SET_SIZE 8
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static struct k_poll_set set;
+static struct k_sem set_sems[SET_SIZE];
+static struct k_poll_signal set_signal;
+static struct k_poll_event set_events[SET_SIZE + 1];
+static struct k_thread set_thread;
+K_THREAD_STACK_DEFINE(set_stack, STACK_SIZE);
+
+static void set_giver(void *p1, void *p2, void *p3)
+{
+	k_sem_give(&set_sems[POINTER_TO_INT(p1)]);
+}
+
+/**
+ * @brief Test persistent poll sets
+ *
+ * @details Only ready events are reported, registrations survive across
+ * waits and events whose condition still holds are reported again.
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_init(), k_poll_set_add(), k_poll_set_remove(),
+ * k_poll_set_wait()
+ */
+void test_poll_set(void)
+{
+	struct k_poll_event *ready[SET_SIZE + 1];
+	int i, rc;
+
+	k_poll_set_init(&set);
+	for (i = 0; i < SET_SIZE; i++) {
+		k_sem_init(&set_sems[i], 0, 1);
+		k_poll_event_init(&set_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &set_sems[i]);
+		set_events[i].tag = i;
+		k_poll_set_add(&set, &set_events[i]);
+	}
+	k_poll_signal_init(&set_signal);
+	k_poll_event_init(&set_events[SET_SIZE], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_signal);
+	set_events[SET_SIZE].tag = SET_SIZE;
+	k_poll_set_add(&set, &set_events[SET_SIZE]);
+
+	/* nothing ready */
+	rc = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(rc, -EAGAIN, "");
+	rc = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), 10);
+	zassert_equal(rc, -EAGAIN, "");
+
+	/* only the ready events are reported */
+	k_sem_give(&set_sems[2]);
+	k_sem_give(&set_sems[5]);
+	rc = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(rc, 2, "");
+	zassert_equal(ready[0], &set_events[2], "");
+	zassert_equal(ready[1], &set_events[5], "");
+	zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE, "");
+
+	/* level-triggered: an event is reported until consumed */
+	zassert_equal(k_sem_take(&set_sems[2], K_NO_WAIT), 0, "");
+	rc = k_poll_set_wait(&set, ready, 1, K_NO_WAIT);
+	zassert_equal(rc, 1, "");
+	zassert_equal(ready[0], &set_events[5], "");
+	zassert_equal(k_sem_take(&set_sems[5], K_NO_WAIT), 0, "");
+	rc = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(rc, -EAGAIN, "");
+
+	/* registrations survive: wake up on an event given while waiting */
+	k_thread_create(&set_thread, set_stack,
+			K_THREAD_STACK_SIZEOF(set_stack), set_giver,
+			INT_TO_POINTER(7), NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, 10);
+	rc = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_FOREVER);
+	zassert_equal(rc, 1, "");
+	zassert_equal(ready[0]->tag, 7, "");
+	zassert_equal(k_sem_take(&set_sems[7], K_NO_WAIT), 0, "");
+	k_thread_abort(&set_thread);
+
+	zassert_equal(k_poll_signal_raise(&set_signal, 0x1337), 0, "");
+	rc = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(rc, 1, "");
+	zassert_equal(ready[0]->state, K_POLL_STATE_SIGNALED, "");
+	k_poll_signal_reset(&set_signal);
+
+	/* removed events are no longer reported */
+	k_poll_set_remove(&set, &set_events[3]);
+	k_sem_give(&set_sems[3]);
+	rc = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(rc, -EAGAIN, "");
+
+	for (i = 0; i <= SET_SIZE; i++) {
+		k_poll_set_remove(&set, &set_events[i]);
+	}
+}
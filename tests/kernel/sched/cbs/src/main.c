@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr.h>
+#include <ztest.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+#define RUN_MS 1000
+#define BUDGET_US 20000
+#define PERIOD_US 100000
+
+K_THREAD_STACK_DEFINE(cbs_stack, STACK_SIZE);
+K_THREAD_STACK_DEFINE(bg_stack, STACK_SIZE);
+struct k_thread cbs_thread;
+struct k_thread bg_thread;
+
+volatile u32_t cbs_cyc, bg_cyc;
+
+/* Spin forever, adding up the cycles we ran for.  Any gap longer than
+ * one loop iteration can take means we were switched out.
+ */
+static void spinner(void *p1, void *p2, void *p3)
+{
+	volatile u32_t *cyc = p1;
+	u32_t gap = k_us_to_cyc_ceil32(100);
+	u32_t last = k_cycle_get_32();
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		u32_t now = k_cycle_get_32();
+
+		if (now - last < gap) {
+			*cyc += now - last;
+		}
+		last = now;
+	}
+}
+
+static k_tid_t spawn(struct k_thread *thread, k_thread_stack_t *stack,
+		     volatile u32_t *cyc, int prio)
+{
+	return k_thread_create(thread, stack, STACK_SIZE, spinner,
+			       (void *)cyc, NULL, NULL, prio, 0, K_FOREVER);
+}
+
+void test_cbs_admission(void)
+{
+	k_tid_t a = spawn(&cbs_thread, cbs_stack, &cbs_cyc, K_PRIO_PREEMPT(1));
+	k_tid_t b = spawn(&bg_thread, bg_stack, &bg_cyc, K_PRIO_PREEMPT(1));
+
+	zassert_equal(k_thread_cbs_set(a, 2000, 1000), -EINVAL, "");
+	zassert_equal(k_thread_cbs_set(a, 1000, 0), -EINVAL, "");
+
+	zassert_equal(k_thread_cbs_set(a, 50000, 100000), 0, "");
+	zassert_equal(k_thread_cbs_set(b, 50000, 100000), -EBUSY,
+		      "admitted more than the utilization limit");
+	zassert_equal(k_thread_cbs_set(b, 30000, 100000), 0, "");
+
+	/* Changing a reservation only accounts for the difference */
+	zassert_equal(k_thread_cbs_set(a, 60000, 100000), 0, "");
+	zassert_equal(k_thread_cbs_set(a, 70000, 100000), -EBUSY, "");
+
+	/* Removing one, or aborting its thread, frees its share */
+	zassert_equal(k_thread_cbs_set(a, 0, 0), 0, "");
+	zassert_equal(k_thread_cbs_set(b, 90000, 100000), 0, "");
+	k_thread_abort(b);
+	zassert_equal(k_thread_cbs_set(a, 90000, 100000), 0, "");
+	k_thread_abort(a);
+}
+
+void test_cbs_throttle(void)
+{
+	k_tid_t cbs, bg;
+	u32_t cbs_ms, bg_ms;
+
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(0));
+
+	/* Without its reservation the higher priority spinner would
+	 * starve the background one completely
+	 */
+	cbs_cyc = bg_cyc = 0U;
+	cbs = spawn(&cbs_thread, cbs_stack, &cbs_cyc, K_PRIO_PREEMPT(1));
+	bg = spawn(&bg_thread, bg_stack, &bg_cyc, K_PRIO_PREEMPT(2));
+
+	zassert_equal(k_thread_cbs_set(cbs, BUDGET_US, PERIOD_US), 0, "");
+
+	k_thread_start(bg);
+	k_thread_start(cbs);
+	k_sleep(K_MSEC(RUN_MS));
+
+	k_thread_abort(cbs);
+	k_thread_abort(bg);
+
+	cbs_ms = k_cyc_to_ms_floor32(cbs_cyc);
+	bg_ms = k_cyc_to_ms_floor32(bg_cyc);
+	TC_PRINT("reserved thread ran %u ms, background %u ms\n",
+		 cbs_ms, bg_ms);
+
+	/* Leave a period and a tick of slack either way */
+	zassert_true(cbs_ms <= RUN_MS * BUDGET_US / PERIOD_US +
+		     PERIOD_US / 1000, "reserved thread overran its budget");
+	zassert_true(cbs_ms >= RUN_MS * BUDGET_US / PERIOD_US -
+		     PERIOD_US / 1000, "reserved thread got too little time");
+	zassert_true(bg_ms >= RUN_MS / 2, "background thread starved");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(suite_cbs,
+			 ztest_unit_test(test_cbs_admission),
+			 ztest_unit_test(test_cbs_throttle));
+	ztest_run_test_suite(suite_cbs);
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define WAKER_PRIO K_PRIO_PREEMPT(5)
+#define WAKEE_PRIO K_PRIO_PREEMPT(2)
+#define ROUNDS 10
+
+K_THREAD_STACK_DEFINE(wakee_stack, STACK_SIZE);
+static struct k_thread wakee_thread;
+static K_SEM_DEFINE(wake_sem, 0, 1);
+static volatile int wakeups_seen;
+
+static void wakee(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < ROUNDS; i++) {
+		k_sem_take(&wake_sem, K_FOREVER);
+		wakeups_seen++;
+	}
+}
+
+static u32_t hist_total(int prio)
+{
+	u32_t hist[CONFIG_SCHED_STATS_HIST_BUCKETS];
+	u32_t total = 0U;
+
+	zassert_equal(k_sched_latency_hist_get(prio, hist), 0, NULL);
+	for (int i = 0; i < ARRAY_SIZE(hist); i++) {
+		total += hist[i];
+	}
+
+	return total;
+}
+
+/**
+ * @brief Verify wake-up latency and switch accounting
+ *
+ * A higher priority thread is woken repeatedly through a semaphore;
+ * every wake-up must land in that priority's histogram and cause a
+ * context switch.
+ */
+void test_sched_stats_wakeup(void)
+{
+	struct k_sched_stats before, after;
+
+	k_thread_priority_set(k_current_get(), WAKER_PRIO);
+	k_sched_stats_reset();
+	k_sched_stats_get(&before);
+	zassert_equal(before.switches, 0, "reset did not clear switches");
+	zassert_equal(hist_total(WAKEE_PRIO), 0, "reset did not clear hist");
+
+	k_thread_create(&wakee_thread, wakee_stack, STACK_SIZE, wakee,
+			NULL, NULL, NULL, WAKEE_PRIO, 0, K_NO_WAIT);
+
+	for (int i = 0; i < ROUNDS; i++) {
+		k_sem_give(&wake_sem);
+		zassert_equal(wakeups_seen, i + 1, "wakee did not preempt");
+	}
+
+	k_sched_stats_get(&after);
+	zassert_true(after.switches >= 2 * ROUNDS, "switches not counted");
+	zassert_true(after.wakeups >= ROUNDS, "wakeups not counted");
+	zassert_true(after.runq_max_depth >= 1, "run queue depth not tracked");
+	zassert_true(hist_total(WAKEE_PRIO) >= ROUNDS,
+		     "latencies not recorded");
+}
+
+/**
+ * @brief Verify histogram API argument checking
+ */
+void test_sched_stats_bad_prio(void)
+{
+	u32_t hist[CONFIG_SCHED_STATS_HIST_BUCKETS];
+
+	zassert_equal(k_sched_latency_hist_get(K_HIGHEST_THREAD_PRIO - 1, hist),
+		      -EINVAL, NULL);
+	zassert_equal(k_sched_latency_hist_get(K_LOWEST_THREAD_PRIO + 1, hist),
+		      -EINVAL, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(sched_stats,
+			 ztest_1cpu_unit_test(test_sched_stats_wakeup),
+			 ztest_unit_test(test_sched_stats_bad_prio));
+	ztest_run_test_suite(sched_stats);
+}
@@ -20,6 +20,15 @@ static struct k_spinlock bounce_lock;
 
 volatile int bounce_owner, bounce_done;
 
+static bool spin_locked(struct k_spinlock *l)
+{
+#ifdef CONFIG_SPINLOCK_TICKET
+	return atomic_get(&l->next) != atomic_get(&l->owner);
+#else
+	return l->locked;
+#endif
+}
+
 /**
  * @brief Tests for spinlock
  *
@@ -43,15 +52,20 @@ void test_spinlock_basic(void)
 	k_spinlock_key_t key;
 	static struct k_spinlock l;
 
-	zassert_true(!l.locked, "Spinlock initialized to locked");
+	zassert_true(!spin_locked(&l), "Spinlock initialized to locked");
 
 	key = k_spin_lock(&l);
 
-	zassert_true(l.locked, "Spinlock failed to lock");
+	zassert_true(spin_locked(&l), "Spinlock failed to lock");
 
 	k_spin_unlock(&l, key);
 
-	zassert_true(!l.locked, "Spinlock failed to unlock");
+	zassert_true(!spin_locked(&l), "Spinlock failed to unlock");
+
+#ifdef CONFIG_SPINLOCK_STATS
+	zassert_equal(l.stats.acquired, 1, "Acquisition not counted");
+	zassert_equal(l.stats.contended, 0, "Spurious contention");
+#endif
 }
 
 void bounce_once(int id)
@@ -127,6 +141,13 @@ void test_spinlock_bounce(void)
 	}
 
 	bounce_done = 1;
+
+#ifdef CONFIG_SPINLOCK_STATS
+	zassert_true(bounce_lock.stats.acquired >= 10000,
+		     "Acquisitions not counted");
+	zassert_true(atomic_get(&bounce_lock.stats.max_cycles) > 0,
+		     "Hold time not tracked");
+#endif
 }
 
 void test_main(void)
@@ -37,6 +37,7 @@ extern void test_k_thread_foreach(void);
 extern void test_threads_cpu_mask(void);
 extern void test_threads_suspend_timeout(void);
 extern void test_threads_suspend(void);
+extern void test_thread_stack_watermark(void);
 
 struct k_thread tdata;
 #define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
@@ -307,7 +308,8 @@ void test_main(void)
 			 ztest_unit_test(test_user_mode),
 			 ztest_1cpu_unit_test(test_threads_cpu_mask),
 			 ztest_unit_test(test_threads_suspend_timeout),
-			 ztest_unit_test(test_threads_suspend)
+			 ztest_unit_test(test_threads_suspend),
+			 ztest_1cpu_unit_test(test_thread_stack_watermark)
 			 );
 
 	ztest_run_test_suite(threads_lifecycle);
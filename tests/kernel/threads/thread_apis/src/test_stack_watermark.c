@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define WM_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define WM_DEPTH 256
+
+static K_THREAD_STACK_DEFINE(wm_stack, WM_STACK_SIZE);
+static struct k_thread wm_thread;
+static K_SEM_DEFINE(wm_done, 0, 1);
+
+static void __noinline deep_sleep(void)
+{
+	volatile u8_t buf[WM_DEPTH];
+
+	buf[0] = 1U;
+	buf[WM_DEPTH - 1] = buf[0];
+
+	/* context switch with buf on the stack */
+	k_sleep(K_MSEC(1));
+}
+
+static void __noinline deep_busy(void)
+{
+	volatile u8_t buf[2 * WM_DEPTH];
+
+	buf[0] = 1U;
+	buf[2 * WM_DEPTH - 1] = buf[0];
+
+	k_thread_stack_watermark_sample();
+}
+
+static void wm_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	if (p1 != NULL) {
+		deep_busy();
+	} else {
+		deep_sleep();
+	}
+
+	k_sem_give(&wm_done);
+}
+
+static size_t wm_run(void *arg)
+{
+	size_t used;
+
+	k_thread_create(&wm_thread, wm_stack, WM_STACK_SIZE, wm_entry,
+			arg, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sem_take(&wm_done, K_FOREVER);
+	k_thread_abort(&wm_thread);
+
+	zassert_equal(k_thread_stack_watermark_get(&wm_thread, &used), 0,
+		      NULL);
+	zassert_true(used < WM_STACK_SIZE, "watermark out of the stack");
+
+	return used;
+}
+
+/**
+ * @ingroup kernel_thread_tests
+ * @brief Test the sampled stack high-water mark
+ *
+ * @see k_thread_stack_watermark_get(), k_thread_stack_watermark_sample()
+ */
+void test_thread_stack_watermark(void)
+{
+	size_t used;
+
+	if (!IS_ENABLED(CONFIG_STACK_WATERMARK)) {
+		zassert_equal(k_thread_stack_watermark_get(k_current_get(),
+							   &used),
+			      -ENOSYS, NULL);
+		ztest_test_skip();
+	}
+
+	/* Depth at a context switch is sampled */
+	used = wm_run(NULL);
+	zassert_true(used >= WM_DEPTH, "watermark %zu too low", used);
+
+	/* So is an explicit sample deeper than any switch */
+	used = wm_run(INT_TO_POINTER(1));
+	zassert_true(used >= 2 * WM_DEPTH, "watermark %zu too low", used);
+
+	/* The current thread has been switched out at least once */
+	zassert_equal(k_thread_stack_watermark_get(k_current_get(), &used),
+		      0, NULL);
+	zassert_true(used > 0, NULL);
+}
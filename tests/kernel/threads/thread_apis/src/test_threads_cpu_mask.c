@@ -41,7 +41,10 @@ void test_threads_cpu_mask(void)
 	ret = k_thread_cpu_mask_disable(k_current_get(), 0);
 	zassert_true(ret == -EINVAL, "");
 
-	for (pass = 0; pass < 4; pass++) {
+	ret = k_thread_cpu_pin(k_current_get(), 0);
+	zassert_true(ret == -EINVAL, "");
+
+	for (pass = 0; pass < 5; pass++) {
 		child_has_run = false;
 
 		/* Create a thread at a higher priority, don't start
@@ -65,9 +68,12 @@ void test_threads_cpu_mask(void)
 		} else if (pass == 2) {
 			ret = k_thread_cpu_mask_disable(thread, 0);
 			zassert_true(ret == 0, "");
-		} else {
+		} else if (pass == 3) {
 			ret = k_thread_cpu_mask_enable(thread, 0);
 			zassert_true(ret == 0, "");
+		} else {
+			ret = k_thread_cpu_pin(thread, 0);
+			zassert_true(ret == 0, "");
 		}
 
 		/* Start it.  If it is runnable, it will do so
@@ -77,7 +83,7 @@ void test_threads_cpu_mask(void)
 		k_thread_start(thread);
 		k_yield();
 
-		if (pass == 1 || pass == 3) {
+		if (pass == 1 || pass == 3 || pass == 4) {
 			zassert_true(child_has_run, "");
 		} else {
 			zassert_false(child_has_run, "");
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <errno.h>
+
+#define STACKSIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define TLS_INIT 0x5a5a5a5aU
+
+static K_THREAD_STACK_DEFINE(tls_stack, STACKSIZE);
+static struct k_thread tls_thread;
+static K_SEM_DEFINE(start_sem, 0, 1);
+static K_SEM_DEFINE(end_sem, 0, 1);
+
+/* One variable in .tdata and one in .tbss */
+static __thread u32_t tls_data = TLS_INIT;
+static __thread u32_t tls_bss;
+
+static void tls_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* A new thread sees the initial image, whatever main did */
+	zassert_equal(tls_data, TLS_INIT, "tdata not initialized");
+	zassert_equal(tls_bss, 0U, "tbss not zeroed");
+
+	tls_data = 2U;
+	tls_bss = 2U;
+#ifdef CONFIG_ERRNO_IN_TLS
+	errno = 2;
+#endif
+
+	k_sem_give(&end_sem);
+	k_sem_take(&start_sem, K_FOREVER);
+
+	/* Still ours after main has modified its own copies */
+	zassert_equal(tls_data, 2U, "tdata changed by another thread");
+	zassert_equal(tls_bss, 2U, "tbss changed by another thread");
+#ifdef CONFIG_ERRNO_IN_TLS
+	zassert_equal(errno, 2, "errno changed by another thread");
+#endif
+
+	k_sem_give(&end_sem);
+}
+
+/**
+ * @brief Test that __thread variables are private to each thread
+ *
+ * @ingroup kernel_thread_tests
+ */
+void test_tls_isolation(void)
+{
+	tls_data = 1U;
+	tls_bss = 1U;
+#ifdef CONFIG_ERRNO_IN_TLS
+	errno = 1;
+#endif
+
+	k_thread_create(&tls_thread, tls_stack, STACKSIZE, tls_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	k_sem_take(&end_sem, K_FOREVER);
+	zassert_equal(tls_data, 1U, "tdata changed by another thread");
+	zassert_equal(tls_bss, 1U, "tbss changed by another thread");
+#ifdef CONFIG_ERRNO_IN_TLS
+	zassert_equal(errno, 1, "errno changed by another thread");
+#endif
+
+	tls_data = 3U;
+	tls_bss = 3U;
+	k_sem_give(&start_sem);
+	k_sem_take(&end_sem, K_FOREVER);
+
+	zassert_equal(tls_data, 3U, "tdata changed by another thread");
+	k_thread_abort(&tls_thread);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(thread_tls,
+			 ztest_unit_test(test_tls_isolation));
+	ztest_run_test_suite(thread_tls);
+}
@@ -535,6 +535,52 @@ void test_timer_remaining_get(void)
 	zassert_true(remaining <= (DURATION / 2) + k_ticks_to_ms_floor64(1), NULL);
 }
 
+static u32_t slack_expired_at[2];
+
+static void slack_expire(struct k_timer *timer)
+{
+	slack_expired_at[(intptr_t)k_timer_user_data_get(timer)] =
+		k_uptime_get_32();
+}
+
+K_TIMER_DEFINE(slack_timer0, slack_expire, NULL);
+K_TIMER_DEFINE(slack_timer1, slack_expire, NULL);
+
+/**
+ * @brief Test coalescing of timers with slack
+ *
+ * Starts a timer allowed to expire up to DURATION late and a second
+ * one without slack that expires a bit after the first, and checks
+ * that the first one was deferred to expire together with the second,
+ * but not before its own expiry time.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_slack_set()
+ */
+void test_timer_slack(void)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	u32_t start;
+
+	k_timer_user_data_set(&slack_timer0, (void *)0);
+	k_timer_user_data_set(&slack_timer1, (void *)1);
+	k_timer_slack_set(&slack_timer0, DURATION);
+
+	start = k_uptime_get_32();
+	k_timer_start(&slack_timer0, DURATION, K_NO_WAIT);
+	k_timer_start(&slack_timer1, DURATION + DURATION / 2, K_NO_WAIT);
+	k_sleep(2 * DURATION);
+
+	zassert_true(slack_expired_at[0] - start >= DURATION,
+		     "timer expired early");
+	zassert_equal(slack_expired_at[0], slack_expired_at[1],
+		      "timers not coalesced");
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
@@ -568,6 +614,7 @@ void test_main(void)
 			 ztest_user_unit_test(test_timer_status_sync),
 			 ztest_user_unit_test(test_timer_k_define),
 			 ztest_user_unit_test(test_timer_user_data),
-			 ztest_user_unit_test(test_timer_remaining_get));
+			 ztest_user_unit_test(test_timer_remaining_get),
+			 ztest_unit_test(test_timer_slack));
 	ztest_run_test_suite(timer_api);
 }
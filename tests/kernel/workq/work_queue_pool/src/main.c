@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define NUM_EXTRA 2
+#define NUM_KEYED 6
+
+static K_THREAD_STACK_DEFINE(main_stack, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(extra_stacks, NUM_EXTRA, STACK_SIZE);
+static struct k_thread extra_threads[NUM_EXTRA];
+static struct k_work_q pool;
+
+static K_SEM_DEFINE(release_sem, 0, 1);
+static K_SEM_DEFINE(done_sem, 0, NUM_KEYED);
+
+static struct k_work blocking_work, quick_work;
+static struct k_work keyed_work[NUM_KEYED];
+
+static volatile bool quick_ran;
+static int order[NUM_KEYED];
+static int n_order;
+static atomic_t in_key;
+static volatile bool overlapped;
+
+static void blocking_handler(struct k_work *work)
+{
+	k_sem_take(&release_sem, K_FOREVER);
+}
+
+static void quick_handler(struct k_work *work)
+{
+	quick_ran = true;
+}
+
+static void keyed_handler(struct k_work *work)
+{
+	if (atomic_inc(&in_key) != 0) {
+		overlapped = true;
+	}
+
+	order[n_order++] = work - keyed_work;
+
+	/* Give the other threads a chance to pick up our siblings */
+	k_sleep(K_MSEC(5));
+
+	atomic_dec(&in_key);
+	k_sem_give(&done_sem);
+}
+
+/**
+ * @brief Test that a blocked handler does not hold up other work
+ *
+ * @see k_work_q_worker_add()
+ */
+void test_pool_no_head_of_line_blocking(void)
+{
+	k_work_init(&blocking_work, blocking_handler);
+	k_work_init(&quick_work, quick_handler);
+
+	k_work_submit_to_queue(&pool, &blocking_work);
+	k_work_submit_to_queue(&pool, &quick_work);
+	k_sleep(K_MSEC(50));
+
+	zassert_true(quick_ran, "work item stuck behind a blocked handler");
+
+	k_sem_give(&release_sem);
+	k_sleep(K_MSEC(10));
+	zassert_false(k_work_pending(&blocking_work), NULL);
+}
+
+/**
+ * @brief Test that work items sharing a key run one at a time, in order
+ *
+ * @see k_work_order_key_set()
+ */
+void test_pool_ordering_key(void)
+{
+	int i;
+
+	for (i = 0; i < NUM_KEYED; i++) {
+		k_work_init(&keyed_work[i], keyed_handler);
+		k_work_order_key_set(&keyed_work[i], (uintptr_t)&pool);
+	}
+
+	for (i = 0; i < NUM_KEYED; i++) {
+		k_work_submit_to_queue(&pool, &keyed_work[i]);
+	}
+
+	for (i = 0; i < NUM_KEYED; i++) {
+		zassert_equal(k_sem_take(&done_sem, K_MSEC(1000)), 0,
+			      "keyed work item never ran");
+	}
+
+	zassert_false(overlapped, "items with the same key ran concurrently");
+	for (i = 0; i < NUM_KEYED; i++) {
+		zassert_equal(order[i], i, "items with the same key reordered");
+	}
+}
+
+void test_main(void)
+{
+	k_work_q_start(&pool, main_stack, K_THREAD_STACK_SIZEOF(main_stack),
+		       K_PRIO_PREEMPT(1));
+	for (int i = 0; i < NUM_EXTRA; i++) {
+		k_work_q_worker_add(&pool, &extra_threads[i], extra_stacks[i],
+				    K_THREAD_STACK_SIZEOF(extra_stacks[i]),
+				    K_PRIO_PREEMPT(1));
+	}
+
+	ztest_test_suite(workqueue_pool,
+			 ztest_unit_test(test_pool_no_head_of_line_blocking),
+			 ztest_unit_test(test_pool_ordering_key));
+	ztest_run_test_suite(workqueue_pool);
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/arena.h>
+
+#define BUF_SZ 128
+#define BLOCK_SZ 64
+#define BLOCK_N 3
+
+SYS_ARENA_DEFINE(buf_arena, BUF_SZ);
+
+K_MEM_SLAB_DEFINE(arena_slab, BLOCK_SZ, BLOCK_N, 8);
+SYS_ARENA_SLAB_DEFINE(slab_arena, &arena_slab);
+
+static bool is_aligned(void *p, size_t align)
+{
+	return ((uintptr_t)p & (align - 1)) == 0;
+}
+
+void test_arena_buffer(void)
+{
+	struct sys_arena_mark mark;
+	u8_t *p1, *p2, *p3;
+
+	p1 = sys_arena_alloc(&buf_arena, 1);
+	p2 = sys_arena_alloc(&buf_arena, 3);
+	zassert_not_null(p1, NULL);
+	zassert_not_null(p2, NULL);
+	zassert_true(is_aligned(p2, SYS_ARENA_ALIGN), "misaligned");
+	zassert_equal(p2 - p1, SYS_ARENA_ALIGN, "not a bump allocation");
+
+	p3 = sys_arena_aligned_alloc(&buf_arena, 32, 4);
+	zassert_true(is_aligned(p3, 32), "misaligned");
+
+	/* Nested scope */
+	mark = sys_arena_save(&buf_arena);
+	p1 = sys_arena_alloc(&buf_arena, 16);
+	zassert_not_null(p1, NULL);
+	zassert_is_null(sys_arena_alloc(&buf_arena, BUF_SZ), "arena overflow");
+	sys_arena_restore(&buf_arena, mark);
+	zassert_equal(sys_arena_alloc(&buf_arena, 16), p1, "scope not released");
+
+	sys_arena_reset(&buf_arena);
+	p1 = sys_arena_alloc(&buf_arena, BUF_SZ);
+	zassert_not_null(p1, "reset did not release the buffer");
+	zassert_is_null(sys_arena_alloc(&buf_arena, 1), "arena overflow");
+	sys_arena_reset(&buf_arena);
+}
+
+void test_arena_slab(void)
+{
+	struct sys_arena_mark mark;
+	u8_t *p1, *p2;
+	int i;
+
+	zassert_is_null(sys_arena_alloc(&slab_arena, BLOCK_SZ),
+			"allocation larger than a block");
+	zassert_equal(k_mem_slab_num_used_get(&arena_slab), 0,
+		      "block leaked");
+
+	p1 = sys_arena_alloc(&slab_arena, 8);
+	zassert_not_null(p1, NULL);
+	zassert_equal(k_mem_slab_num_used_get(&arena_slab), 1, NULL);
+
+	/* Scope spanning a new block is released with the block */
+	mark = sys_arena_save(&slab_arena);
+	p2 = sys_arena_alloc(&slab_arena, BLOCK_SZ - 8);
+	zassert_not_null(p2, NULL);
+	zassert_equal(k_mem_slab_num_used_get(&arena_slab), 2, NULL);
+	sys_arena_restore(&slab_arena, mark);
+	zassert_equal(k_mem_slab_num_used_get(&arena_slab), 1, NULL);
+
+	for (i = 0; i < BLOCK_N; i++) {
+		zassert_not_null(sys_arena_alloc(&slab_arena, BLOCK_SZ / 2),
+				 NULL);
+	}
+	zassert_equal(k_mem_slab_num_used_get(&arena_slab), BLOCK_N, NULL);
+	zassert_is_null(sys_arena_alloc(&slab_arena, BLOCK_SZ / 2),
+			"slab overflow");
+
+	sys_arena_reset(&slab_arena);
+	zassert_equal(k_mem_slab_num_used_get(&arena_slab), 0,
+		      "blocks not released");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(arena,
+			 ztest_unit_test(test_arena_buffer),
+			 ztest_unit_test(test_arena_slab));
+	ztest_run_test_suite(arena);
+}
@@ -319,6 +319,272 @@ void test_bsearch(void)
 	zassert_not_null(result, "bsearch -key found");
 }
 
+/*
+ * variables used during memory move testing, the copies and fills cover
+ * all mutual alignments and lengths around the word and block sizes
+ */
+
+#define MEMTEST_SIZE 96
+#define MEMTEST_ALIGN 8
+
+static const size_t memtest_len[] = {
+	0, 1, 3, 4, 7, 8, 15, 31, 32, 33, 63, 64, 65, MEMTEST_SIZE
+};
+
+static u8_t memtest_src[MEMTEST_SIZE + 4 * MEMTEST_ALIGN] __aligned(8);
+static u8_t memtest_dst[MEMTEST_SIZE + 4 * MEMTEST_ALIGN] __aligned(8);
+static u8_t memtest_ref[MEMTEST_SIZE + 4 * MEMTEST_ALIGN];
+
+static void memtest_fill(u8_t *buf, size_t len, u8_t seed)
+{
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = (u8_t)(seed + i * 7U);
+	}
+}
+
+/**
+ *
+ * @brief Test memory copy function with all alignments
+ *
+ */
+
+void test_memcpy_align(void)
+{
+	for (unsigned int s = 0; s < MEMTEST_ALIGN; s++) {
+		for (unsigned int d = 0; d < MEMTEST_ALIGN; d++) {
+			for (size_t i = 0; i < ARRAY_SIZE(memtest_len); i++) {
+				unsigned int len = memtest_len[i];
+				void *ret;
+
+				memtest_fill(memtest_src, sizeof(memtest_src),
+					     1U);
+				(void)memset(memtest_dst, 0xaa,
+					     sizeof(memtest_dst));
+
+				ret = memcpy(&memtest_dst[d], &memtest_src[s],
+					     len);
+				zassert_equal_ptr(ret, &memtest_dst[d], NULL);
+				zassert_true(memcmp(&memtest_dst[d],
+						    &memtest_src[s], len) == 0,
+					     "memcpy src %u dst %u len %u",
+					     s, d, len);
+				zassert_equal(memtest_dst[d + len], 0xaa,
+					      "memcpy overrun len %u", len);
+				zassert_true(d == 0 ||
+					     memtest_dst[d - 1] == 0xaa,
+					     "memcpy underrun dst %u", d);
+			}
+		}
+	}
+}
+
+/**
+ *
+ * @brief Test overlapping memory move in both directions
+ *
+ */
+
+void test_memmove_overlap(void)
+{
+	static const int shift[] = { -9, -8, -4, -1, 1, 4, 8, 9 };
+
+	for (size_t i = 0; i < ARRAY_SIZE(shift); i++) {
+		for (unsigned int s = 2 * MEMTEST_ALIGN; s < 3 * MEMTEST_ALIGN;
+		     s++) {
+			for (size_t l = 0; l < ARRAY_SIZE(memtest_len); l++) {
+				unsigned int d = s + shift[i];
+				unsigned int len = memtest_len[l];
+				void *ret;
+
+				memtest_fill(memtest_dst, sizeof(memtest_dst),
+					     3U);
+				memtest_fill(memtest_ref, sizeof(memtest_ref),
+					     3U);
+
+				/* reference: go through a separate buffer */
+				for (unsigned int k = 0; k < len; k++) {
+					memtest_src[k] = memtest_ref[s + k];
+				}
+				for (unsigned int k = 0; k < len; k++) {
+					memtest_ref[d + k] = memtest_src[k];
+				}
+
+				ret = memmove(&memtest_dst[d], &memtest_dst[s],
+					      len);
+				zassert_equal_ptr(ret, &memtest_dst[d], NULL);
+				zassert_true(memcmp(memtest_dst, memtest_ref,
+						    sizeof(memtest_dst)) == 0,
+					     "memmove src %u dst %u len %u",
+					     s, d, len);
+			}
+		}
+	}
+}
+
+/**
+ *
+ * @brief Test memory fill function with all alignments
+ *
+ */
+
+void test_memset_align(void)
+{
+	for (unsigned int d = 0; d < MEMTEST_ALIGN; d++) {
+		for (size_t i = 0; i < ARRAY_SIZE(memtest_len); i++) {
+			unsigned int len = memtest_len[i];
+			void *ret;
+
+			(void)memset(memtest_dst, 0xaa, sizeof(memtest_dst));
+			(void)memset(memtest_ref, 0xaa, sizeof(memtest_ref));
+			for (unsigned int k = 0; k < len; k++) {
+				memtest_ref[d + k] = 0x5c;
+			}
+
+			ret = memset(&memtest_dst[d], 0x5c, len);
+			zassert_equal_ptr(ret, &memtest_dst[d], NULL);
+			zassert_true(memcmp(memtest_dst, memtest_ref,
+					    sizeof(memtest_dst)) == 0,
+				     "memset dst %u len %u", d, len);
+		}
+	}
+}
+
+/*
+ * variables used during string scanning testing, the strings start at all
+ * alignments and end in all positions of a word
+ */
+
+#define STRTEST_LEN 40
+
+static char strtest_s1[STRTEST_LEN + 2 * MEMTEST_ALIGN] __aligned(8);
+static char strtest_s2[STRTEST_LEN + 2 * MEMTEST_ALIGN] __aligned(8);
+
+static char *strtest_fill(char *buf, unsigned int off, unsigned int len)
+{
+	(void)memset(buf, 0x7f, STRTEST_LEN + 2 * MEMTEST_ALIGN);
+	for (unsigned int k = 0; k < len; k++) {
+		buf[off + k] = (char)('a' + k % 26);
+	}
+	buf[off + len] = '\0';
+
+	return &buf[off];
+}
+
+/**
+ *
+ * @brief Test string length function with all alignments
+ *
+ */
+
+void test_strlen_align(void)
+{
+	for (unsigned int off = 0; off < MEMTEST_ALIGN; off++) {
+		for (unsigned int len = 0; len <= STRTEST_LEN; len++) {
+			char *s = strtest_fill(strtest_s1, off, len);
+
+			zassert_equal(strlen(s), len, "strlen off %u len %u",
+				      off, len);
+		}
+	}
+}
+
+/**
+ *
+ * @brief Test string scanning function with all alignments
+ *
+ */
+
+void test_strchr_align(void)
+{
+	for (unsigned int off = 0; off < MEMTEST_ALIGN; off++) {
+		for (unsigned int len = 0; len <= STRTEST_LEN; len++) {
+			char *s = strtest_fill(strtest_s1, off, len);
+
+			/* found at every position, first match wins */
+			for (unsigned int k = 0; k < len; k++) {
+				s[k] = (char)0xf0;
+				zassert_equal_ptr(strchr(s, 0xf0), &s[k],
+						  "strchr off %u pos %u",
+						  off, k);
+				s[k] = '-';
+			}
+
+			/* not found, the bytes past the end match */
+			zassert_is_null(strchr(s, 0x7f), "strchr off %u len %u",
+					off, len);
+			zassert_equal_ptr(strchr(s, '\0'), &s[len],
+					  "strchr nul off %u len %u", off, len);
+		}
+	}
+}
+
+/**
+ *
+ * @brief Test memory scanning function with all alignments
+ *
+ */
+
+void test_memchr_align(void)
+{
+	for (unsigned int off = 0; off < MEMTEST_ALIGN; off++) {
+		for (unsigned int len = 0; len <= STRTEST_LEN; len++) {
+			char *s = strtest_fill(strtest_s1, off, len);
+
+			for (unsigned int k = 0; k < len; k++) {
+				s[k] = (char)0x80;
+				zassert_equal_ptr(memchr(s, 0x80, len), &s[k],
+						  "memchr off %u pos %u",
+						  off, k);
+				s[k] = '-';
+			}
+
+			/* the terminator and the fill past it are not
+			 * within the scanned length
+			 */
+			zassert_is_null(memchr(s, '\0', len),
+					"memchr off %u len %u", off, len);
+			zassert_is_null(memchr(s, 0x7f, len + 1),
+					"memchr tail off %u len %u", off, len);
+		}
+	}
+}
+
+/**
+ *
+ * @brief Test string compare function with all alignments
+ *
+ */
+
+void test_strcmp_align(void)
+{
+	for (unsigned int o1 = 0; o1 < MEMTEST_ALIGN; o1++) {
+		for (unsigned int o2 = 0; o2 < MEMTEST_ALIGN; o2++) {
+			unsigned int len = STRTEST_LEN - MEMTEST_ALIGN + o2;
+			char *s1 = strtest_fill(strtest_s1, o1, len);
+			char *s2 = strtest_fill(strtest_s2, o2, len);
+
+			zassert_equal(strcmp(s1, s2), 0, "strcmp %u %u",
+				      o1, o2);
+
+			for (unsigned int k = 0; k < len; k++) {
+				char c = s2[k];
+
+				s2[k] = '~';
+				zassert_true(strcmp(s1, s2) < 0,
+					     "strcmp %u %u pos %u", o1, o2, k);
+				zassert_true(strcmp(s2, s1) > 0,
+					     "strcmp %u %u pos %u", o1, o2, k);
+				s2[k] = c;
+			}
+
+			/* a prefix is smaller */
+			s2[len - 1] = '\0';
+			zassert_true(strcmp(s1, s2) > 0, "strcmp prefix");
+			zassert_true(strcmp(s2, s1) < 0, "strcmp prefix");
+		}
+	}
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_c_lib,
@@ -335,7 +601,14 @@ void test_main(void)
 			 ztest_unit_test(test_strlen),
 			 ztest_unit_test(test_strcmp),
 			 ztest_unit_test(test_strxspn),
-			 ztest_unit_test(test_bsearch)
+			 ztest_unit_test(test_bsearch),
+			 ztest_unit_test(test_memcpy_align),
+			 ztest_unit_test(test_memmove_overlap),
+			 ztest_unit_test(test_memset_align),
+			 ztest_unit_test(test_strlen_align),
+			 ztest_unit_test(test_strchr_align),
+			 ztest_unit_test(test_memchr_align),
+			 ztest_unit_test(test_strcmp_align)
 			 );
 	ztest_run_test_suite(test_c_lib);
 }
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/cbprintf.h>
+#include <string.h>
+
+#define BUF_SZ 128
+
+struct str_ctx {
+	char buf[BUF_SZ];
+	size_t pos;
+};
+
+static struct str_ctx direct;
+static struct str_ctx deferred;
+static u8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) pkg[BUF_SZ];
+
+static int str_out(int c, void *ctx)
+{
+	struct str_ctx *s = ctx;
+
+	zassert_true(s->pos < BUF_SZ - 1, "output too long");
+	s->buf[s->pos++] = c;
+	s->buf[s->pos] = '\0';
+
+	return c;
+}
+
+/* Formats directly and through a package, both must give expected */
+static void check(const char *expected, const char *fmt, ...)
+{
+	va_list ap;
+	int len, pkg_len;
+
+	memset(&direct, 0, sizeof(direct));
+	memset(&deferred, 0, sizeof(deferred));
+
+	va_start(ap, fmt);
+	len = cbvprintf(str_out, &direct, fmt, ap);
+	va_end(ap);
+
+	zassert_equal(strcmp(direct.buf, expected), 0,
+		      "'%s': expected '%s', got '%s'", fmt, expected,
+		      direct.buf);
+	zassert_equal(len, strlen(expected), "'%s': wrong length %d", fmt,
+		      len);
+
+	va_start(ap, fmt);
+	pkg_len = cbvprintf_package(NULL, 0, fmt, ap);
+	va_end(ap);
+
+	zassert_true(pkg_len > 0 && pkg_len <= sizeof(pkg),
+		     "'%s': wrong package size %d", fmt, pkg_len);
+
+	va_start(ap, fmt);
+	zassert_equal(cbvprintf_package(pkg, pkg_len, fmt, ap), pkg_len,
+		      "'%s': package failed", fmt);
+	va_end(ap);
+
+	len = cbpprintf(str_out, &deferred, pkg);
+
+	zassert_equal(strcmp(deferred.buf, expected), 0,
+		      "'%s': expected '%s', got '%s' from package", fmt,
+		      expected, deferred.buf);
+	zassert_equal(len, strlen(expected), "'%s': wrong length %d", fmt,
+		      len);
+}
+
+void test_cbprintf_integral(void)
+{
+	check("-5 42 3000000000", "%d %i %u", -5, 42, 3000000000U);
+	check("beef BEEF 10 0xff 010", "%x %X %o %#x %#o", 0xbeef, 0xbeef,
+	      8, 255, 8);
+	check("44 -12 200 65535", "%hhd %hd %hhu %hu", 300, 65524, 200,
+	      -1);
+	check("7 -7 -1", "%zu %zd %ld", (size_t)7, (ssize_t)-7, -1L);
+	check("ffffffffffffffff", "%llx", 0xffffffffffffffffULL);
+
+	if (IS_ENABLED(CONFIG_CBPRINTF_FULL_INTEGRAL)) {
+		check("68719476735 -1", "%lld %lld", 0xfffffffffLL, -1LL);
+	} else if (sizeof(long) < sizeof(long long)) {
+		check("ERR -1", "%lld %lld", 0xfffffffffLL, -1LL);
+	}
+}
+
+void test_cbprintf_padding(void)
+{
+	check("    1|2    |00003|+4| 5|006|     007",
+	      "%5d|%-5d|%05d|%+d|% d|%.3d|%8.3d", 1, 2, 3, 4, 5, 6, 7);
+	check("  abc|ab|x   |", "%5s|%.2s|%-*s|", "abc", "abcd", 4, "x");
+	check("0x2a 100%", "%p 100%%", (void *)0x2a);
+}
+
+void test_cbprintf_string(void)
+{
+	check("hello world c", "hello %s %c", "world", 'c');
+}
+
+void test_cbprintf_package_size(void)
+{
+	int len = cbprintf_package(NULL, 0, "%d %s", 1, "x");
+
+	zassert_true(len > 0, "size not computed");
+	zassert_equal(cbprintf_package(pkg, len - 1, "%d %s", 1, "x"),
+		      -ENOSPC, "short buffer not detected");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_cbprintf,
+			 ztest_unit_test(test_cbprintf_integral),
+			 ztest_unit_test(test_cbprintf_padding),
+			 ztest_unit_test(test_cbprintf_string),
+			 ztest_unit_test(test_cbprintf_package_size));
+	ztest_run_test_suite(test_cbprintf);
+}
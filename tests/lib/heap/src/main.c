@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/sys_heap.h>
+#include <string.h>
+
+#define SMALL_SZ 24
+#define SMALL_N 10
+#define BIG_HEAP_SZ 8192
+#define NPTRS 64
+
+static char __aligned(Z_HEAP_ALIGN)
+	small_mem[SYS_HEAP_BUF_SIZE(SMALL_SZ, SMALL_N)];
+static char __aligned(Z_HEAP_ALIGN) big_mem[BIG_HEAP_SZ];
+
+static struct sys_heap heap;
+
+/* LCG, good enough to scramble the allocation pattern reproducibly */
+static u32_t rand32(void)
+{
+	static u32_t state = 123456789U;
+
+	state = state * 1103515245U + 12345U;
+	return state >> 8;
+}
+
+/**
+ * @brief Verify SYS_HEAP_BUF_SIZE() sizing guarantee
+ *
+ * Fill a heap sized for SMALL_N blocks, check they are all distinct
+ * and aligned, then free them and check the heap is whole again.
+ */
+void test_heap_sizing(void)
+{
+	void *p[SMALL_N];
+	int i;
+
+	sys_heap_init(&heap, small_mem, sizeof(small_mem));
+	zassert_true(sys_heap_validate(&heap), "fresh heap invalid");
+
+	for (i = 0; i < SMALL_N; i++) {
+		p[i] = sys_heap_alloc(&heap, SMALL_SZ);
+		zassert_not_null(p[i], "allocation %d failed", i);
+		zassert_true(((uintptr_t)p[i] % Z_HEAP_ALIGN) == 0U,
+			     "misaligned block");
+		(void)memset(p[i], i, SMALL_SZ);
+	}
+	zassert_true(sys_heap_validate(&heap), "full heap invalid");
+
+	for (i = 0; i < SMALL_N; i++) {
+		zassert_equal(((u8_t *)p[i])[SMALL_SZ - 1], i,
+			      "block %d overwritten", i);
+		sys_heap_free(&heap, p[i]);
+	}
+	zassert_true(sys_heap_validate(&heap), "emptied heap invalid");
+
+	/* Everything coalesced back into one block */
+	p[0] = sys_heap_alloc(&heap, SMALL_N * SMALL_SZ);
+	zassert_not_null(p[0], "heap did not coalesce");
+	sys_heap_free(&heap, p[0]);
+}
+
+/**
+ * @brief Verify edge cases of the allocation API
+ */
+void test_heap_edges(void)
+{
+	sys_heap_init(&heap, big_mem, sizeof(big_mem));
+
+	zassert_is_null(sys_heap_alloc(&heap, 0), "zero-sized alloc");
+	zassert_is_null(sys_heap_alloc(&heap, BIG_HEAP_SZ), "oversized alloc");
+	zassert_is_null(sys_heap_alloc(&heap, (size_t)-1), "huge alloc");
+
+	sys_heap_free(&heap, NULL);
+	zassert_true(sys_heap_validate(&heap), "heap invalid");
+}
+
+/**
+ * @brief Stress the heap with a random mix of sizes
+ *
+ * Interleave allocations and frees of random sizes, checking block
+ * contents and heap integrity along the way.
+ */
+void test_heap_stress(void)
+{
+	static void *ptrs[NPTRS];
+	static size_t sizes[NPTRS];
+	int i, iter;
+
+	sys_heap_init(&heap, big_mem, sizeof(big_mem));
+
+	for (iter = 0; iter < 4000; iter++) {
+		i = rand32() % NPTRS;
+
+		if (ptrs[i] != NULL) {
+			zassert_equal(((u8_t *)ptrs[i])[sizes[i] - 1],
+				      (u8_t)i, "block %d overwritten", i);
+			sys_heap_free(&heap, ptrs[i]);
+			ptrs[i] = NULL;
+		} else {
+			sizes[i] = 1 + rand32() % ((rand32() & 3) ? 48 : 600);
+			ptrs[i] = sys_heap_alloc(&heap, sizes[i]);
+			if (ptrs[i] != NULL) {
+				(void)memset(ptrs[i], i, sizes[i]);
+			}
+		}
+
+		if ((iter % 64) == 0) {
+			zassert_true(sys_heap_validate(&heap),
+				     "heap invalid at iteration %d", iter);
+		}
+	}
+
+	for (i = 0; i < NPTRS; i++) {
+		sys_heap_free(&heap, ptrs[i]);
+		ptrs[i] = NULL;
+	}
+	zassert_true(sys_heap_validate(&heap), "heap invalid");
+	zassert_not_null(sys_heap_alloc(&heap, BIG_HEAP_SZ / 2),
+			 "heap did not coalesce");
+}
+
+/**
+ * @brief Verify k_malloc() when k_mem_pool is backed by the heap
+ */
+void test_heap_k_malloc(void)
+{
+#if defined(CONFIG_MEM_POOL_HEAP_BACKEND) && (CONFIG_HEAP_MEM_POOL_SIZE > 0)
+	void *p[8];
+	int i;
+
+	/* Odd sizes no longer round up to a power of 4 */
+	for (i = 0; i < ARRAY_SIZE(p); i++) {
+		p[i] = k_malloc(CONFIG_HEAP_MEM_POOL_SIZE / 10);
+		zassert_not_null(p[i], "k_malloc %d failed", i);
+	}
+	for (i = 0; i < ARRAY_SIZE(p); i++) {
+		k_free(p[i]);
+	}
+
+	p[0] = k_malloc(CONFIG_HEAP_MEM_POOL_SIZE / 2);
+	zassert_not_null(p[0], "heap did not coalesce");
+	k_free(p[0]);
+#else
+	ztest_test_skip();
+#endif
+}
+
+void test_main(void)
+{
+	ztest_test_suite(heap,
+			 ztest_unit_test(test_heap_sizing),
+			 ztest_unit_test(test_heap_edges),
+			 ztest_unit_test(test_heap_stress),
+			 ztest_unit_test(test_heap_k_malloc));
+	ztest_run_test_suite(heap);
+}
@@ -519,6 +519,172 @@ static void test_json_escape_bounds_check(void)
 	zassert_equal(ret, -ENOMEM, "Bounds check OK");
 }
 
+struct stream_ctx {
+	char text[256];
+	size_t len;
+	int tokens;
+};
+
+static int stream_token_cb(const struct json_token *token, void *user_data)
+{
+	struct stream_ctx *ctx = user_data;
+	int ret;
+
+	/* Record the tokens as "<depth><type>[text]" */
+	ret = snprintk(&ctx->text[ctx->len], sizeof(ctx->text) - ctx->len,
+		       "%u%c%s%.*s ", token->depth, token->type,
+		       token->key ? "k" : "", (int)token->len,
+		       token->start ? token->start : "");
+	ctx->len += ret;
+	ctx->tokens++;
+
+	return 0;
+}
+
+static int stream_parse(const char *doc, size_t chunk, char *tok_buf,
+			size_t tok_buf_size, struct stream_ctx *ctx)
+{
+	struct json_stream js;
+	size_t len = strlen(doc);
+	size_t pos;
+	int ret;
+
+	(void)memset(ctx, 0, sizeof(*ctx));
+	json_stream_init(&js, tok_buf, tok_buf_size, stream_token_cb, ctx);
+
+	for (pos = 0; pos < len; pos += chunk) {
+		ret = json_stream_feed(&js, &doc[pos], MIN(chunk, len - pos));
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return json_stream_finish(&js);
+}
+
+static void test_json_stream_chunked(void)
+{
+	const char *doc = "{\"name\":\"zephyr\\\"os\", \"list\":[1,-23.5e+2,"
+			  "true,false,null,{}],\"empty\":\"\"}";
+	const char *expected = "0{ 1\"kname 1\"zephyr\\\"os 1\"klist 1[ "
+			       "201 20-23.5e+2 2ttrue 2ffalse 2nnull 2{ "
+			       "2} 1] 1\"kempty 1\" 0} ";
+	struct stream_ctx whole;
+	struct stream_ctx ctx;
+	char tok_buf[16];
+	size_t chunk;
+	int ret;
+
+	ret = stream_parse(doc, strlen(doc), tok_buf, 0, &whole);
+	zassert_equal(ret, 0, "Document parsed in one chunk");
+	zassert_true(!strcmp(whole.text, expected), "Tokens are correct");
+
+	for (chunk = 1; chunk < 8; chunk++) {
+		ret = stream_parse(doc, chunk, tok_buf, sizeof(tok_buf), &ctx);
+		zassert_equal(ret, 0, "Document parsed in chunks");
+		zassert_true(!strcmp(ctx.text, whole.text),
+			     "Tokens do not depend on the chunk size");
+	}
+
+	ret = stream_parse("42", 1, tok_buf, sizeof(tok_buf), &ctx);
+	zassert_equal(ret, 0, "Top level number is terminated by the end");
+	zassert_true(!strcmp(ctx.text, "0042 "), "Number is reported");
+}
+
+static void test_json_stream_zero_copy(void)
+{
+	const char *doc = "[\"abc\",\"def\"]";
+	struct stream_ctx ctx;
+	char tok_buf[2];
+	int ret;
+
+	/* Tokens within a chunk do not use the token buffer */
+	ret = stream_parse(doc, strlen(doc), tok_buf, sizeof(tok_buf), &ctx);
+	zassert_equal(ret, 0, "Document parsed without the token buffer");
+
+	/* Split tokens must fit in the token buffer */
+	ret = stream_parse(doc, 3, tok_buf, sizeof(tok_buf), &ctx);
+	zassert_equal(ret, -ENOMEM, "Token buffer overflow detected");
+}
+
+static void test_json_stream_invalid(void)
+{
+	const char *docs[] = {
+		"{\"a\":1,}", "[1 2]", "{\"a\" 1}", "{1:2}", "[1}", "]",
+		"[tru]", "\"abc", "[1", "{\"a\":1}}", "1 2", "\"\\x\"",
+		"\"\\u12g4\"", "",
+	};
+	struct stream_ctx ctx;
+	char tok_buf[8];
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(docs); i++) {
+		ret = stream_parse(docs[i], 1, tok_buf, sizeof(tok_buf), &ctx);
+		zassert_equal(ret, -EINVAL, "Invalid document detected");
+	}
+}
+
+static int stream_elt_cb(void *val, s32_t decoded, void *user_data)
+{
+	struct obj_array *arr = user_data;
+	struct elt *elt = val;
+
+	zassert_equal(decoded, 0x3, "All fields decoded");
+	zassert_true(arr->num_elements < ARRAY_SIZE(arr->elements),
+		     "Not too many elements");
+
+	/* Strings are only valid during the callback */
+	arr->elements[arr->num_elements].name = strcmp(elt->name, "Zephyr") ?
+						"other" : "Zephyr";
+	arr->elements[arr->num_elements].height = elt->height;
+	arr->num_elements++;
+
+	return 0;
+}
+
+static void test_json_obj_arr_stream_decoding(void)
+{
+	const char *doc = "[{\"height\":100,\"name\":\"Zephyr\","
+			  "\"skipped\":[1,{\"a\":2}]},"
+			  "{\"name\":\"long name\",\"height\":-42}]";
+	struct json_obj_array_stream s;
+	struct obj_array arr;
+	struct elt elt;
+	char buf[16];
+	size_t pos;
+	int ret;
+
+	for (size_t chunk = 1; chunk < 5; chunk++) {
+		(void)memset(&arr, 0, sizeof(arr));
+
+		ret = json_obj_array_stream_init(&s, elt_descr,
+						 ARRAY_SIZE(elt_descr), &elt,
+						 buf, sizeof(buf),
+						 stream_elt_cb, &arr);
+		zassert_equal(ret, 0, "Stream initialized");
+
+		for (pos = 0; pos < strlen(doc); pos += chunk) {
+			ret = json_obj_array_stream_feed(&s, &doc[pos],
+						MIN(chunk, strlen(doc) - pos));
+			zassert_equal(ret, 0, "Chunk decoded");
+		}
+
+		ret = json_obj_array_stream_finish(&s);
+		zassert_equal(ret, 0, "Document decoded");
+		zassert_equal(arr.num_elements, 2, "Two objects decoded");
+		zassert_true(!strcmp(arr.elements[0].name, "Zephyr"),
+			     "First name decoded");
+		zassert_equal(arr.elements[0].height, 100, "Height decoded");
+		zassert_equal(arr.elements[1].height, -42, "Height decoded");
+	}
+
+	ret = json_obj_array_stream_init(&s, obj_array_descr,
+					 ARRAY_SIZE(obj_array_descr), &arr,
+					 buf, sizeof(buf),
+					 stream_elt_cb, &arr);
+	zassert_equal(ret, -EINVAL, "Nested descriptors are not supported");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_json_test,
@@ -539,7 +705,11 @@ void test_main(void)
 			 ztest_unit_test(test_json_escape_one),
 			 ztest_unit_test(test_json_escape_empty),
 			 ztest_unit_test(test_json_escape_no_op),
-			 ztest_unit_test(test_json_escape_bounds_check)
+			 ztest_unit_test(test_json_escape_bounds_check),
+			 ztest_unit_test(test_json_stream_chunked),
+			 ztest_unit_test(test_json_stream_zero_copy),
+			 ztest_unit_test(test_json_stream_invalid),
+			 ztest_unit_test(test_json_obj_arr_stream_decoding)
 			 );
 
 	ztest_run_test_suite(lib_json_test);
@@ -443,6 +443,83 @@ void test_reset(void)
 	zassert_true(granted == RINGBUFFER_SIZE - 1, NULL);
 }
 
+#define MPMC_POW 5
+RING_BUF_MPMC_DECLARE_POW2(ringbuf_mpmc, MPMC_POW);
+
+static void tringbuf_mpmc_put(void *p)
+{
+	u8_t *data;
+	u32_t len;
+
+	len = ring_buf_mpmc_put_claim(&ringbuf_mpmc, &data, 2);
+	zassert_equal(len, 2, NULL);
+	data[0] = 0xaa;
+	data[1] = 0xbb;
+	ring_buf_mpmc_put_finish(&ringbuf_mpmc);
+}
+
+void test_ringbuffer_mpmc(void)
+{
+	u8_t *first, *second, *data;
+	u32_t len;
+
+	/**TESTPOINT: data is visible once all earlier claims are committed*/
+	len = ring_buf_mpmc_put_claim(&ringbuf_mpmc, &first, 4);
+	zassert_equal(len, 4, NULL);
+	len = ring_buf_mpmc_put_claim(&ringbuf_mpmc, &second, 4);
+	zassert_equal(len, 4, NULL);
+	zassert_equal(second, first + 4, NULL);
+
+	memset(second, 2, 4);
+	ring_buf_mpmc_put_finish(&ringbuf_mpmc);
+	zassert_equal(ring_buf_mpmc_get_claim(&ringbuf_mpmc, &data, 8), 0,
+		      "Data committed before an earlier claim");
+
+	memset(first, 1, 4);
+	ring_buf_mpmc_put_finish(&ringbuf_mpmc);
+
+	/**TESTPOINT: producer in an ISR while a thread claim is pending*/
+	len = ring_buf_mpmc_put_claim(&ringbuf_mpmc, &first, 2);
+	zassert_equal(len, 2, NULL);
+	irq_offload(tringbuf_mpmc_put, NULL);
+	memset(first, 3, 2);
+	ring_buf_mpmc_put_finish(&ringbuf_mpmc);
+
+	/**TESTPOINT: consumers claim disjoint data*/
+	len = ring_buf_mpmc_get_claim(&ringbuf_mpmc, &first, 6);
+	zassert_equal(len, 6, NULL);
+	len = ring_buf_mpmc_get_claim(&ringbuf_mpmc, &second, 32);
+	zassert_equal(len, 6, NULL);
+	zassert_equal(first[0], 1, NULL);
+	zassert_equal(first[4], 2, NULL);
+	zassert_equal(second[2], 3, NULL);
+	zassert_equal(second[4], 0xaa, NULL);
+	zassert_equal(second[5], 0xbb, NULL);
+
+	/**TESTPOINT: space is freed once all earlier claims are freed*/
+	ring_buf_mpmc_get_finish(&ringbuf_mpmc);
+	len = ring_buf_mpmc_put_claim(&ringbuf_mpmc, &data, BIT(MPMC_POW));
+	zassert_equal(len, BIT(MPMC_POW) - 12, "Buffer does not wrap");
+	ring_buf_mpmc_put_finish(&ringbuf_mpmc);
+	len = ring_buf_mpmc_put_claim(&ringbuf_mpmc, &data, BIT(MPMC_POW));
+	zassert_equal(len, 0, "Space freed before an earlier claim");
+
+	ring_buf_mpmc_get_finish(&ringbuf_mpmc);
+	len = ring_buf_mpmc_put_claim(&ringbuf_mpmc, &data, BIT(MPMC_POW));
+	zassert_equal(len, 12, NULL);
+	zassert_equal(data, ringbuf_mpmc.buf, NULL);
+	ring_buf_mpmc_put_finish(&ringbuf_mpmc);
+
+	len = ring_buf_mpmc_get_claim(&ringbuf_mpmc, &data, BIT(MPMC_POW));
+	zassert_equal(len, BIT(MPMC_POW) - 12, NULL);
+	ring_buf_mpmc_get_finish(&ringbuf_mpmc);
+	len = ring_buf_mpmc_get_claim(&ringbuf_mpmc, &data, BIT(MPMC_POW));
+	zassert_equal(len, 12, NULL);
+	ring_buf_mpmc_get_finish(&ringbuf_mpmc);
+	zassert_equal(ring_buf_mpmc_get_claim(&ringbuf_mpmc, &data, 1), 0,
+		      NULL);
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -461,7 +538,8 @@ void test_main(void)
 			 ztest_unit_test(test_byte_put_free),
 			 ztest_unit_test(test_byte_put_free),
 			 ztest_unit_test(test_capacity),
-			 ztest_unit_test(test_reset)
+			 ztest_unit_test(test_reset),
+			 ztest_unit_test(test_ringbuffer_mpmc)
 			 );
 	ztest_run_test_suite(test_ringbuffer_api);
 }
@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(net_test, LOG_LEVEL_DBG);
 #include <kernel.h>
 
 #include <net/coap.h>
+#include <net/coap_blockwise.h>
 
 #include <tc_util.h>
 
@@ -1454,6 +1455,189 @@ done:
 	return result;
 }
 
+#define BLOCKWISE_SIZE 200
+#define BLOCKWISE_MAX_REQUESTS 8
+
+static const char * const blockwise_path[] = { "fw", NULL };
+static u8_t blockwise_requests[BLOCKWISE_MAX_REQUESTS][COAP_BUF_SIZE];
+static u16_t blockwise_request_lens[BLOCKWISE_MAX_REQUESTS];
+static int blockwise_request_count;
+static u8_t blockwise_resource[BLOCKWISE_SIZE];
+static u8_t blockwise_received[BLOCKWISE_SIZE];
+static size_t blockwise_received_len;
+static bool blockwise_done;
+
+static int blockwise_send_cb(struct coap_blockwise *bw, const u8_t *data,
+			     u16_t len)
+{
+	if (blockwise_request_count == BLOCKWISE_MAX_REQUESTS) {
+		return -ENOMEM;
+	}
+
+	memcpy(blockwise_requests[blockwise_request_count], data, len);
+	blockwise_request_lens[blockwise_request_count++] = len;
+
+	return 0;
+}
+
+static void blockwise_cb(struct coap_blockwise *bw, int status,
+			 size_t offset, const u8_t *data, u16_t len, bool last)
+{
+	if (status != 0 || offset != blockwise_received_len) {
+		TC_PRINT("Unexpected block status %d offset %zd\n", status,
+			 offset);
+		return;
+	}
+
+	memcpy(blockwise_received + offset, data, len);
+	blockwise_received_len += len;
+	blockwise_done = last;
+}
+
+/* Server side, answers the request with its block of the resource */
+static int blockwise_respond(struct coap_blockwise *bw, int idx)
+{
+	struct coap_packet req, rsp;
+	struct coap_option option;
+	u8_t rsp_data[COAP_BUF_SIZE];
+	u8_t token[8];
+	unsigned int block;
+	size_t offset, len;
+	u8_t tkl;
+	int r;
+
+	r = coap_packet_parse(&req, blockwise_requests[idx],
+			      blockwise_request_lens[idx], NULL, 0);
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_find_options(&req, COAP_OPTION_BLOCK2, &option, 1);
+	if (r != 1) {
+		return -EINVAL;
+	}
+
+	block = coap_option_value_to_int(&option);
+	tkl = coap_header_get_token(&req, token);
+
+	/* 64 bytes blocks */
+	offset = (block >> 4) * 64U;
+	len = MIN(64U, BLOCKWISE_SIZE - offset);
+	block = (block & ~0x0f) | COAP_BLOCK_64;
+	if (offset + len < BLOCKWISE_SIZE) {
+		block |= 0x08;
+	}
+
+	r = coap_packet_init(&rsp, rsp_data, sizeof(rsp_data), 1,
+			     COAP_TYPE_ACK, tkl, token,
+			     COAP_RESPONSE_CODE_CONTENT,
+			     coap_header_get_id(&req));
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_append_option_int(&rsp, COAP_OPTION_BLOCK2, block);
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_append_option_int(&rsp, COAP_OPTION_SIZE2, BLOCKWISE_SIZE);
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_packet_append_payload_marker(&rsp);
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_packet_append_payload(&rsp, blockwise_resource + offset, len);
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_packet_parse(&rsp, rsp_data, rsp.offset, NULL, 0);
+	if (r < 0) {
+		return r;
+	}
+
+	return coap_blockwise_received(bw, &rsp);
+}
+
+static int test_blockwise(void)
+{
+	static struct coap_blockwise bw;
+	int result = TC_FAIL;
+	int r, i;
+
+	for (i = 0; i < BLOCKWISE_SIZE; i++) {
+		blockwise_resource[i] = i;
+	}
+
+	/* The server answers with 64 bytes blocks to a 128 bytes request */
+	r = coap_blockwise_get(&bw, (struct sockaddr *)&dummy_addr,
+			       blockwise_path, COAP_BLOCK_128,
+			       blockwise_send_cb, blockwise_cb, NULL);
+	if (r < 0 || blockwise_request_count != 1) {
+		TC_PRINT("Could not start the transfer\n");
+		goto done;
+	}
+
+	if (blockwise_respond(&bw, 0) < 0) {
+		TC_PRINT("First block not accepted\n");
+		goto done;
+	}
+
+	/* Size2 bounds the requests to the last block */
+	if (blockwise_received_len != 64U ||
+	    blockwise_request_count != 1 + CONFIG_COAP_BLOCKWISE_NSTART) {
+		TC_PRINT("Blocks not requested (%d)\n",
+			 blockwise_request_count);
+		goto done;
+	}
+
+	/* Lost ACK, the request is sent again */
+	bw.slots[0].deadline = k_uptime_get();
+	if (coap_blockwise_cycle(&bw) <= 0 || blockwise_request_count != 5 ||
+	    blockwise_request_lens[4] != blockwise_request_lens[1] ||
+	    memcmp(blockwise_requests[4], blockwise_requests[1],
+		   blockwise_request_lens[1])) {
+		TC_PRINT("Request not retransmitted\n");
+		goto done;
+	}
+
+	/* Out of order blocks are delivered in order */
+	if (blockwise_respond(&bw, 3) < 0 || blockwise_received_len != 64U) {
+		TC_PRINT("Last block delivered too early\n");
+		goto done;
+	}
+
+	if (blockwise_respond(&bw, 1) < 0 || blockwise_respond(&bw, 2) < 0) {
+		TC_PRINT("Blocks not accepted\n");
+		goto done;
+	}
+
+	if (!blockwise_done || blockwise_received_len != BLOCKWISE_SIZE ||
+	    memcmp(blockwise_received, blockwise_resource, BLOCKWISE_SIZE)) {
+		TC_PRINT("Resource not received\n");
+		goto done;
+	}
+
+	/* The retransmission answer is a duplicate */
+	if (blockwise_respond(&bw, 4) != -ENOENT ||
+	    coap_blockwise_cycle(&bw) != K_FOREVER) {
+		TC_PRINT("Transfer not finished\n");
+		goto done;
+	}
+
+	result = TC_PASS;
+
+done:
+	TC_END_RESULT(result);
+
+	return result;
+}
+
 static const struct {
 	const char *name;
 	int (*func)(void);
@@ -1476,6 +1660,7 @@ static const struct {
 	{ "Test retransmission", test_retransmit_second_round, },
 	{ "Test observer server", test_observer_server, },
 	{ "Test observer client", test_observer_client, },
+	{ "Test block-wise transfer engine", test_blockwise, },
 };
 
 void main(void)
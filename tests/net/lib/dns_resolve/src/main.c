@@ -750,6 +750,108 @@ static void dns_query_ipv6_numeric(void)
 }
 #endif
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE) && defined(CONFIG_NET_IPV4)
+#define NAME_NX "nx.zephyr.test"
+
+static int cache_status;
+static int cache_count;
+static struct sockaddr cache_addr;
+
+static void dns_cache_cb(enum dns_resolve_status status,
+			 struct dns_addrinfo *info,
+			 void *user_data)
+{
+	if (status == DNS_EAI_INPROGRESS) {
+		memcpy(&cache_addr, &info->ai_addr, sizeof(cache_addr));
+		cache_count++;
+	} else {
+		cache_status = status;
+	}
+}
+
+static void dns_cache_query(const char *name, u16_t *dns_id)
+{
+	int ret;
+
+	cache_status = 0;
+	cache_count = 0;
+	*dns_id = 0xffff;
+
+	ret = dns_get_addr_info(name, DNS_QUERY_TYPE_A, dns_id,
+				dns_cache_cb, NULL, DNS_TIMEOUT);
+	zassert_equal(ret, 0, "Cannot create query for %s", name);
+}
+
+static void dns_cache_add(struct dns_cache_entry *entry, const char *name,
+			  int status)
+{
+	strcpy(entry->name, name);
+	entry->query_type = DNS_QUERY_TYPE_A;
+	entry->status = status;
+	entry->count = status ? 0 : 1;
+	net_sin(&entry->addrs[0])->sin_family = AF_INET;
+	net_ipaddr_copy(&net_sin(&entry->addrs[0])->sin_addr, &my_addr2);
+	entry->expiry = k_uptime_get() + MSEC_PER_SEC * 60;
+}
+
+static void dns_query_cache(void)
+{
+	struct dns_resolve_context *ctx = dns_resolve_get_default();
+	struct dns_cache_stats before, after;
+	u16_t dns_id;
+
+	timeout_query = true;
+
+	dns_resolve_cache_flush(ctx);
+	zassert_equal(dns_resolve_cache_stats_get(ctx, &before), 0, "");
+
+	dns_cache_add(&ctx->cache.entries[0], NAME4, 0);
+	dns_cache_add(&ctx->cache.entries[1], NAME_NX, DNS_EAI_NODATA);
+
+	/* A cached answer is given at once, without sending a query */
+	dns_cache_query(NAME4, &dns_id);
+	zassert_equal(dns_id, 0, "Query sent for a cached name");
+	zassert_equal(cache_count, 1, "Cached address not returned");
+	zassert_true(net_ipv4_addr_cmp(&net_sin(&cache_addr)->sin_addr,
+				       &my_addr2), "Wrong cached address");
+	zassert_equal(cache_status, DNS_EAI_ALLDONE, "");
+
+	/* A cached failure is returned as the final status */
+	dns_cache_query(NAME_NX, &dns_id);
+	zassert_equal(dns_id, 0, "Query sent for a cached failure");
+	zassert_equal(cache_count, 0, "");
+	zassert_equal(cache_status, DNS_EAI_NODATA, "");
+
+	zassert_equal(dns_resolve_cache_stats_get(ctx, &after), 0, "");
+	zassert_equal(after.hits, before.hits + 1, "");
+	zassert_equal(after.negative_hits, before.negative_hits + 1, "");
+	zassert_equal(after.misses, before.misses, "");
+
+	/* An expired answer sends a new query */
+	ctx->cache.entries[0].expiry = 1;
+
+	dns_cache_query(NAME4, &dns_id);
+	zassert_not_equal(dns_id, 0, "Expired answer used");
+	zassert_equal(cache_count, 0, "");
+	zassert_equal(dns_cancel_addr_info(dns_id), 0, "Cannot cancel query");
+
+	/* A flushed answer too */
+	dns_resolve_cache_flush(ctx);
+
+	dns_cache_query(NAME_NX, &dns_id);
+	zassert_not_equal(dns_id, 0, "Flushed answer used");
+	zassert_equal(dns_cancel_addr_info(dns_id), 0, "Cannot cancel query");
+
+	zassert_equal(dns_resolve_cache_stats_get(ctx, &after), 0, "");
+	zassert_equal(after.misses, before.misses + 2, "");
+}
+#else
+static void dns_query_cache(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 void test_main(void)
 {
 	ztest_test_suite(dns_tests,
@@ -767,7 +869,8 @@ void test_main(void)
 			 ztest_unit_test(dns_query_ipv4_cancel),
 			 ztest_unit_test(dns_query_ipv6_cancel),
 			 ztest_unit_test(dns_query_ipv4),
-			 ztest_unit_test(dns_query_ipv4_numeric));
+			 ztest_unit_test(dns_query_ipv4_numeric),
+			 ztest_unit_test(dns_query_cache));
 
 	ztest_run_test_suite(dns_tests);
 }
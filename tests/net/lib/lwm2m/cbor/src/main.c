@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <string.h>
+
+#include "lwm2m_object.h"
+#include "lwm2m_rw_cbor.h"
+
+static u8_t payload[64];
+static struct coap_packet cpkt;
+static struct lwm2m_message msg;
+
+static void set_input(const u8_t *data, u16_t len)
+{
+	memcpy(payload, data, len);
+
+	(void)memset(&cpkt, 0, sizeof(cpkt));
+	cpkt.data = payload;
+	cpkt.offset = len;
+	cpkt.max_len = len;
+
+	(void)memset(&msg, 0, sizeof(msg));
+	msg.in.in_cpkt = &cpkt;
+	msg.in.reader = &cbor_reader;
+	msg.path.obj_id = 3U;
+	msg.path.level = 1U;
+}
+
+#define SET_INPUT(...) do {					\
+		static const u8_t data[] = { __VA_ARGS__ };	\
+		set_input(data, sizeof(data));			\
+	} while (false)
+
+static void test_cbor_integers(void)
+{
+	s32_t v32;
+	s64_t v64;
+
+	SET_INPUT(0x18, 0x64);
+	zassert_equal(cbor_reader.get_s32(&msg.in, &v32), 2, "");
+	zassert_equal(v32, 100, "");
+
+	SET_INPUT(0x38, 0x63);
+	zassert_equal(cbor_reader.get_s32(&msg.in, &v32), 2, "");
+	zassert_equal(v32, -100, "");
+
+	SET_INPUT(0x1b, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00);
+	zassert_equal(cbor_reader.get_s64(&msg.in, &v64), 9, "");
+	zassert_equal(v64, 0x100000000LL, "");
+}
+
+static void test_cbor_truncated(void)
+{
+	float32_value_t f32;
+	u8_t str[8];
+	s32_t v32;
+	s64_t v64;
+
+	set_input(payload, 0);
+	zassert_equal(cbor_reader.get_s64(&msg.in, &v64), 0,
+		      "empty input accepted");
+
+	SET_INPUT(0x19, 0x01);
+	zassert_equal(cbor_reader.get_s32(&msg.in, &v32), 0,
+		      "truncated uint16 accepted");
+
+	SET_INPUT(0x1b, 0x00, 0x00, 0x00);
+	zassert_equal(cbor_reader.get_s64(&msg.in, &v64), 0,
+		      "truncated uint64 accepted");
+
+	SET_INPUT(0x65, 'a', 'b');
+	zassert_equal(cbor_reader.get_string(&msg.in, str, sizeof(str)), 0,
+		      "truncated string accepted");
+	zassert_equal(str[0], '\0', "partial string returned");
+
+	SET_INPUT(0xfa, 0x3f, 0x80);
+	zassert_equal(cbor_reader.get_float32fix(&msg.in, &f32), 0,
+		      "truncated float accepted");
+}
+
+static void test_cbor_malformed(void)
+{
+	u8_t str[8];
+	s64_t v64;
+	bool b;
+
+	/* additional information 28 is reserved */
+	SET_INPUT(0x1c);
+	zassert_equal(cbor_reader.get_s64(&msg.in, &v64), 0, "");
+
+	SET_INPUT(0x61, 'a');
+	zassert_equal(cbor_reader.get_s64(&msg.in, &v64), 0,
+		      "string read as integer");
+
+	SET_INPUT(0x01);
+	zassert_equal(cbor_reader.get_bool(&msg.in, &b), 0,
+		      "integer read as boolean");
+
+	/* indefinite length strings are not supported */
+	SET_INPUT(0x7f, 0x61, 'a', 0xff);
+	zassert_equal(cbor_reader.get_string(&msg.in, str, sizeof(str)), 0,
+		      "");
+}
+
+static void test_senml_malformed(void)
+{
+	/* a map instead of the array of records */
+	SET_INPUT(0xa0);
+	zassert_equal(do_write_op_senml_cbor(&msg), -EINVAL, "");
+
+	/* a record which is not a map */
+	SET_INPUT(0x81, 0x01);
+	zassert_equal(do_write_op_senml_cbor(&msg), -EINVAL, "");
+
+	/* a non-integer label */
+	SET_INPUT(0x81, 0xa1, 0x61, 'n', 0x60);
+	zassert_equal(do_write_op_senml_cbor(&msg), -EINVAL, "");
+}
+
+static void test_senml_truncated(void)
+{
+	/* two records announced, one present */
+	SET_INPUT(0x82, 0xa0);
+	zassert_equal(do_write_op_senml_cbor(&msg), -EINVAL, "");
+
+	/* a label without its value */
+	SET_INPUT(0x81, 0xa1, 0x00);
+	zassert_equal(do_write_op_senml_cbor(&msg), -EINVAL, "");
+
+	/* a value cut short */
+	SET_INPUT(0x81, 0xa1, 0x02, 0x19, 0x01);
+	zassert_equal(do_write_op_senml_cbor(&msg), -EINVAL, "");
+
+	SET_INPUT(0x81, 0xa1, 0x03, 0x65, 'a');
+	zassert_equal(do_write_op_senml_cbor(&msg), -EINVAL, "");
+
+	/* an indefinite length pack without its break */
+	SET_INPUT(0x9f, 0xa0);
+	zassert_equal(do_write_op_senml_cbor(&msg), -EINVAL, "");
+
+	SET_INPUT(0x81, 0xbf, 0x00, 0x60);
+	zassert_equal(do_write_op_senml_cbor(&msg), -EINVAL, "");
+}
+
+static void test_senml_no_values(void)
+{
+	/* records without values are skipped, the path is restored */
+	SET_INPUT(0x9f, 0xa1, 0x21, 0x65, '/', '3', '/', '0', '/', 0xa0, 0xff);
+	zassert_equal(do_write_op_senml_cbor(&msg), 0, "");
+	zassert_equal(msg.path.level, 1U, "");
+	zassert_equal(msg.path.obj_id, 3U, "");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(lwm2m_cbor,
+			 ztest_unit_test(test_cbor_integers),
+			 ztest_unit_test(test_cbor_truncated),
+			 ztest_unit_test(test_cbor_malformed),
+			 ztest_unit_test(test_senml_malformed),
+			 ztest_unit_test(test_senml_truncated),
+			 ztest_unit_test(test_senml_no_values));
+	ztest_run_test_suite(lwm2m_cbor);
+}
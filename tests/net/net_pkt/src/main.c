@@ -629,6 +629,49 @@ void test_net_pkt_copy(void)
 		     "Pkt not properly unreferenced");
 }
 
+#if defined(CONFIG_NET_BUF_QUOTA)
+static void test_net_pkt_buf_quota(void)
+{
+	struct net_pkt *pkt1, *pkt2, *pkt3;
+
+	/* Each of these packets fits in one buffer */
+	net_if_set_buf_quota(eth_if, 2);
+
+	pkt1 = net_pkt_alloc_with_buffer(eth_if, 64, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_true(pkt1 != NULL, "Pkt not allocated");
+
+	pkt2 = net_pkt_alloc_with_buffer(eth_if, 64, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_true(pkt2 != NULL, "Pkt not allocated");
+
+	/* The quota is used up, even though the pool is not */
+	pkt3 = net_pkt_alloc_with_buffer(eth_if, 64, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_true(pkt3 == NULL, "Pkt allocated over the quota");
+
+	pkt3 = net_pkt_rx_alloc_with_buffer(eth_if, 64, AF_UNSPEC, 0,
+					    K_MSEC(10));
+	zassert_true(pkt3 == NULL, "Pkt allocated over the quota");
+
+	/* Releasing a packet gives its buffers back to the quota */
+	net_pkt_unref(pkt1);
+
+	pkt3 = net_pkt_alloc_with_buffer(eth_if, 64, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_true(pkt3 != NULL, "Pkt not allocated");
+
+	net_pkt_unref(pkt2);
+	net_pkt_unref(pkt3);
+
+	zassert_equal(atomic_get(&eth_if->buf_quota.used), 0,
+		      "Buffers still charged to the iface");
+
+	net_if_set_buf_quota(eth_if, 0);
+}
+#else
+static void test_net_pkt_buf_quota(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_NET_BUF_QUOTA */
+
 void test_main(void)
 {
 	eth_if = net_if_get_default();
@@ -639,7 +682,8 @@ void test_main(void)
 			 ztest_unit_test(test_net_pkt_basics_of_rw),
 			 ztest_unit_test(test_net_pkt_advanced_basics),
 			 ztest_unit_test(test_net_pkt_easier_rw_usage),
-			 ztest_unit_test(test_net_pkt_copy)
+			 ztest_unit_test(test_net_pkt_copy),
+			 ztest_unit_test(test_net_pkt_buf_quota)
 		);
 
 	ztest_run_test_suite(net_pkt_tests);
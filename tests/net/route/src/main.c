@@ -424,6 +424,35 @@ static void route_lookup_fail(void)
 			"Route lookup failed for peer address");
 }
 
+static void route_lookup_longest_prefix(void)
+{
+	struct net_route_entry *prefix_entry, *found;
+	struct in6_addr other_addr = generic_addr;
+
+	prefix_entry = net_route_add(my_iface, &generic_addr, 64, &peer_addr);
+	zassert_not_null(prefix_entry, "Prefix route add failed");
+
+	found = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(found, entry, "Host route is not the longest match");
+
+	other_addr.s6_addr[15] = 0x42;
+
+	found = net_route_lookup(my_iface, &other_addr);
+	zassert_equal_ptr(found, prefix_entry, "Prefix route not found");
+
+	/* Looking up again gives the same result */
+	found = net_route_lookup(my_iface, &other_addr);
+	zassert_equal_ptr(found, prefix_entry, "Prefix route not found again");
+
+	zassert_false(net_route_del(prefix_entry), "Prefix route del failed");
+
+	found = net_route_lookup(my_iface, &other_addr);
+	zassert_is_null(found, "Deleted prefix route still found");
+
+	found = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(found, entry, "Host route lost");
+}
+
 static void route_del_nexthop(void)
 {
 	struct in6_addr *nexthop = &peer_addr;
@@ -480,6 +509,7 @@ void test_main(void)
 			ztest_unit_test(route_get_nexthop),
 			ztest_unit_test(route_lookup_ok),
 			ztest_unit_test(route_lookup_fail),
+			ztest_unit_test(route_lookup_longest_prefix),
 			ztest_unit_test(route_del),
 			ztest_unit_test(route_add),
 			ztest_unit_test(route_del_nexthop),
@@ -11,6 +11,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <ztest_assert.h>
 
 #include <net/socket.h>
+#include <net/socket_async.h>
 
 #include "../../socket_helpers.h"
 
@@ -123,10 +124,277 @@ void test_poll(void)
 	zassert_equal(res, 0, "close failed");
 }
 
+void test_epoll(void)
+{
+	int res;
+	int c_sock;
+	int s_sock;
+	int epfd;
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	struct epoll_event ev;
+	struct epoll_event events[2];
+	u32_t tstamp;
+	ssize_t len;
+	char buf[10];
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, CLIENT_PORT,
+			    &c_sock, &c_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &s_sock, &s_addr);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+
+	epfd = epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed");
+
+	ev.events = EPOLLIN;
+	ev.data.fd = c_sock;
+	res = epoll_ctl(epfd, EPOLL_CTL_ADD, c_sock, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed");
+
+	ev.data.fd = s_sock;
+	res = epoll_ctl(epfd, EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EEXIST, "");
+
+	/* Wait on non-ready sockets with timeout of 0 and 30 */
+	tstamp = k_uptime_get_32();
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_true(k_uptime_get_32() - tstamp <= FUZZ, "");
+	zassert_equal(res, 0, "");
+
+	tstamp = k_uptime_get_32();
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_true(tstamp >= 30U && tstamp <= 30 + FUZZ * 2, "tstamp %d",
+		     tstamp);
+	zassert_equal(res, 0, "");
+
+	/* Send pkt for s_sock, it is reported until it is received */
+	len = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	tstamp = k_uptime_get_32();
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_true(k_uptime_get_32() - tstamp <= FUZZ, "");
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+
+	len = recv(s_sock, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* Removed sockets are not reported anymore */
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "epoll_ctl failed");
+
+	len = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 0, "");
+
+	/* Writable sockets are always ready */
+	ev.events = EPOLLOUT;
+	ev.data.fd = c_sock;
+	res = epoll_ctl(epfd, EPOLL_CTL_MOD, c_sock, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLOUT, "");
+	zassert_equal(events[0].data.fd, c_sock, "");
+
+	/* Closing a socket removes it from the instance */
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = close(epfd);
+	zassert_equal(res, 0, "close failed");
+}
+
+static K_THREAD_STACK_DEFINE(epoll_waiter_stack, 1024);
+static struct k_thread epoll_waiter_thread;
+static int epoll_waiter_res;
+static K_SEM_DEFINE(epoll_waiter_done, 0, 1);
+
+static void epoll_waiter(void *p1, void *p2, void *p3)
+{
+	struct epoll_event events[1];
+
+	epoll_waiter_res = epoll_wait(POINTER_TO_INT(p1), events,
+				      ARRAY_SIZE(events), -1);
+	k_sem_give(&epoll_waiter_done);
+}
+
+void test_epoll_ctl_while_waiting(void)
+{
+	int res;
+	int c_sock;
+	int s_sock;
+	int epfd;
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	struct epoll_event ev;
+	ssize_t len;
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, CLIENT_PORT,
+			    &c_sock, &c_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &s_sock, &s_addr);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+
+	epfd = epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed");
+
+	/* Block a waiter on the empty instance, with no timeout */
+	epoll_waiter_res = -2;
+	k_thread_create(&epoll_waiter_thread, epoll_waiter_stack,
+			K_THREAD_STACK_SIZEOF(epoll_waiter_stack),
+			epoll_waiter, INT_TO_POINTER(epfd), NULL, NULL,
+			K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+
+	/* Adding a socket must not wait for the waiter to return */
+	ev.events = EPOLLIN;
+	ev.data.fd = s_sock;
+	res = epoll_ctl(epfd, EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed");
+	zassert_equal(epoll_waiter_res, -2, "waiter returned early");
+
+	/* The waiter now waits on the added socket too */
+	len = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	res = k_sem_take(&epoll_waiter_done, K_MSEC(100));
+	zassert_equal(res, 0, "waiter not woken up");
+	zassert_equal(epoll_waiter_res, 1, "");
+
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = close(epfd);
+	zassert_equal(res, 0, "close failed");
+}
+
+static K_SEM_DEFINE(async_sem, 0, 1);
+static short async_revents;
+
+static void async_handler(struct zsock_async *async, short revents)
+{
+	async_revents = revents;
+	k_sem_give(&async_sem);
+}
+
+void test_async(void)
+{
+	int res;
+	int c_sock;
+	int s_sock;
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	struct zsock_async async;
+	u32_t tstamp;
+	ssize_t len;
+	char buf[10];
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, CLIENT_PORT,
+			    &c_sock, &c_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &s_sock, &s_addr);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+
+	zsock_async_init(&async, async_handler);
+
+	/* The handler is called with no event on timeout */
+	tstamp = k_uptime_get_32();
+	res = zsock_async_wait(&async, &k_sys_work_q, s_sock, POLLIN, 30);
+	zassert_equal(res, 0, "zsock_async_wait failed");
+	zassert_equal(k_sem_take(&async_sem, 100), 0, "handler not called");
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_true(tstamp >= 30U && tstamp <= 30 + FUZZ * 2, "tstamp %d",
+		     tstamp);
+	zassert_equal(async_revents, 0, "");
+
+	/* And with the ready events once data arrives */
+	res = zsock_async_wait(&async, &k_sys_work_q, s_sock, POLLIN,
+			       K_FOREVER);
+	zassert_equal(res, 0, "zsock_async_wait failed");
+	zassert_not_equal(k_sem_take(&async_sem, 30), 0, "handler called");
+
+	len = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	zassert_equal(k_sem_take(&async_sem, 100), 0, "handler not called");
+	zassert_equal(async_revents, POLLIN, "");
+
+	len = recv(s_sock, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+
+	/* Writable sockets are always ready */
+	res = zsock_async_wait(&async, &k_sys_work_q, c_sock, POLLOUT,
+			       K_FOREVER);
+	zassert_equal(res, 0, "zsock_async_wait failed");
+	zassert_equal(k_sem_take(&async_sem, 100), 0, "handler not called");
+	zassert_equal(async_revents, POLLOUT, "");
+
+	/* Cancelled waits do not call the handler */
+	res = zsock_async_wait(&async, &k_sys_work_q, s_sock, POLLIN,
+			       K_FOREVER);
+	zassert_equal(res, 0, "zsock_async_wait failed");
+	zassert_equal(zsock_async_cancel(&async), 0, "cancel failed");
+
+	len = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+	zassert_not_equal(k_sem_take(&async_sem, 30), 0, "handler called");
+
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(socket_poll,
-			 ztest_unit_test(test_poll));
+			 ztest_unit_test(test_poll),
+			 ztest_unit_test(test_epoll),
+			 ztest_unit_test(test_epoll_ctl_while_waiting),
+			 ztest_unit_test(test_async));
 
 	ztest_run_test_suite(socket_poll);
 }
@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include <net/socket.h>
 #include <net/ethernet.h>
+#include <net/buf.h>
 
 #include "ipv6.h"
 #include "../../socket_helpers.h"
@@ -205,6 +206,138 @@ void test_v6_sendto_recvfrom(void)
 	zassert_equal(rv, 0, "close failed");
 }
 
+void test_v4_recv_buf(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr addr;
+	socklen_t addrlen;
+	struct net_buf *frags, *frag;
+	static char rx_buf[400];
+	ssize_t recved;
+	size_t off = 0;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	addrlen = sizeof(addr);
+	recved = zsock_recv_buf(server_sock, &frags, 0, &addr, &addrlen);
+	zassert_equal(recved, STRLEN(TEST_STR2), "unexpected received bytes");
+	zassert_equal(addrlen, sizeof(struct sockaddr_in),
+		      "unexpected addrlen");
+	zassert_not_null(frags, "no fragments");
+
+	/* The chain holds the payload only */
+	for (frag = frags; frag; frag = frag->frags) {
+		zassert_true(off + frag->len <= sizeof(rx_buf), "too long");
+		memcpy(rx_buf + off, frag->data, frag->len);
+		off += frag->len;
+	}
+
+	zassert_equal(off, STRLEN(TEST_STR2), "wrong chain length");
+	zassert_mem_equal(rx_buf, BUF_AND_SIZE(TEST_STR2), "wrong data");
+
+	net_buf_unref(frags);
+
+	/* Nothing left, and peeking is refused */
+	recved = zsock_recv_buf(server_sock, &frags, MSG_DONTWAIT, NULL, NULL);
+	zassert_equal(recved, -1, "unexpected data");
+	zassert_equal(errno, EAGAIN, "unexpected errno");
+
+	recved = zsock_recv_buf(server_sock, &frags, MSG_PEEK, NULL, NULL);
+	zassert_equal(recved, -1, "MSG_PEEK accepted");
+	zassert_equal(errno, EINVAL, "unexpected errno");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+static bool ext_buf_freed;
+
+static void ext_buf_destroy(struct net_buf *buf)
+{
+	ext_buf_freed = true;
+	net_buf_destroy(buf);
+}
+
+/* Buffers referencing external data only */
+NET_BUF_POOL_DEFINE(ext_pool, 2, 1, 0, ext_buf_destroy);
+
+void test_v4_send_buf(void)
+{
+	static char part1[] = "The Zephyr Project, ";
+	static char part2[] = "a Linux Foundation hosted Collaboration Project";
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct net_buf *frags, *frag;
+	static char rx_buf[100];
+	ssize_t recved;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	frags = net_buf_alloc_with_data(&ext_pool, part1, STRLEN(part1),
+					K_NO_WAIT);
+	zassert_not_null(frags, "cannot allocate buffer");
+	frags->len = STRLEN(part1);
+
+	frag = net_buf_alloc_with_data(&ext_pool, part2, STRLEN(part2),
+				       K_NO_WAIT);
+	zassert_not_null(frag, "cannot allocate buffer");
+	frag->len = STRLEN(part2);
+	net_buf_frag_add(frags, frag);
+
+	ext_buf_freed = false;
+
+	rv = zsock_send_buf(client_sock, frags, 0,
+			    (struct sockaddr *)&server_addr,
+			    sizeof(server_addr));
+	zassert_equal(rv, STRLEN(part1) + STRLEN(part2), "send_buf failed");
+
+	clear_buf(rx_buf);
+	recved = recv(server_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(recved, STRLEN(part1) + STRLEN(part2),
+		      "unexpected received bytes");
+	zassert_mem_equal(rx_buf, part1, STRLEN(part1), "wrong data");
+	zassert_mem_equal(rx_buf + STRLEN(part1), part2, STRLEN(part2),
+			  "wrong data");
+
+	/* The stack has let go of the external data */
+	k_sleep(K_MSEC(10));
+	zassert_true(ext_buf_freed, "buffers not released");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 void test_v4_bind_sendto(void)
 {
 	int rv;
@@ -409,6 +542,86 @@ static void comm_sendmsg_recvfrom(int client_sock,
 	}
 }
 
+#define MMSG_COUNT 3
+
+void test_v4_sendmmsg_recvmmsg(void)
+{
+	static const char * const data[MMSG_COUNT] = {
+		"first", "second", "third"
+	};
+	int rv;
+	int i;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in src_addr[MMSG_COUNT];
+	struct mmsghdr msgs[MMSG_COUNT];
+	struct iovec iov[MMSG_COUNT];
+	char rx_buf[MMSG_COUNT][16];
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	memset(msgs, 0, sizeof(msgs));
+	for (i = 0; i < MMSG_COUNT; i++) {
+		iov[i].iov_base = (void *)data[i];
+		iov[i].iov_len = strlen(data[i]);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &server_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+	}
+
+	rv = sendmmsg(client_sock, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, strlen(data[i]),
+			      "unexpected sent bytes");
+	}
+
+	memset(msgs, 0, sizeof(msgs));
+	for (i = 0; i < MMSG_COUNT; i++) {
+		iov[i].iov_base = rx_buf[i];
+		iov[i].iov_len = sizeof(rx_buf[i]);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &src_addr[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(src_addr[i]);
+	}
+
+	/* All the datagrams are queued by now */
+	rv = recvmmsg(server_sock, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "recvmmsg failed (%d)", errno);
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, strlen(data[i]),
+			      "unexpected received bytes");
+		zassert_mem_equal(rx_buf[i], data[i], strlen(data[i]),
+				  "wrong data");
+		zassert_equal(msgs[i].msg_hdr.msg_namelen,
+			      sizeof(struct sockaddr_in), "unexpected addrlen");
+	}
+
+	/* Nothing left to receive */
+	rv = recvmmsg(server_sock, msgs, MMSG_COUNT, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "unexpected data");
+	zassert_equal(errno, EAGAIN, "unexpected errno");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 void test_v4_sendmsg_recvfrom(void)
 {
 	int rv;
@@ -914,6 +1127,10 @@ void test_main(void)
 			 ztest_unit_test(test_send_recv_2_sock),
 			 ztest_unit_test(test_v4_sendto_recvfrom),
 			 ztest_unit_test(test_v6_sendto_recvfrom),
+			 ztest_unit_test(test_v4_recv_buf),
+			 ztest_unit_test(test_v4_send_buf),
+			 ztest_unit_test(test_v4_sendmmsg_recvmmsg),
+			 ztest_user_unit_test(test_v4_sendmmsg_recvmmsg),
 			 ztest_unit_test(test_v4_bind_sendto),
 			 ztest_unit_test(test_v6_bind_sendto),
 			 ztest_unit_test(test_so_priority),
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <string.h>
+#include <sys/fdtable.h>
+#include <net/socket.h>
+
+#include "../../socket/socket_helpers.h"
+
+#include "tcp2.h"
+#include "tcp2_cc.h"
+
+#define MY_IPV4_ADDR "192.0.2.1"
+#define SERVER_PORT 4242
+
+#define TEST_CHUNK 256
+#define TEST_CHUNKS 4
+
+#define INITIAL_WINDOW(mss) MIN(4U * (mss), MAX(2U * (mss), 4380U))
+
+static void test_cc_find(void)
+{
+	const struct tcp_cc *cc = tcp_cc_find(NULL);
+
+	zassert_not_null(cc, "no default algorithm");
+	zassert_true(strcmp(cc->name, IS_ENABLED(CONFIG_NET_TCP2_CC_CUBIC) ?
+			    "cubic" : "newreno") == 0,
+		     "wrong default algorithm %s", cc->name);
+
+	zassert_not_null(tcp_cc_find("newreno"), "");
+	zassert_not_null(tcp_cc_find("cubic"), "");
+	zassert_is_null(tcp_cc_find("vegas"), "unknown algorithm found");
+}
+
+static void test_cc_newreno(void)
+{
+	const struct tcp_cc *cc = tcp_cc_find("newreno");
+	struct tcp_cc_data data = { .mss = 1000U };
+
+	cc->init(&data);
+	zassert_equal(data.cwnd, INITIAL_WINDOW(1000U), "");
+	zassert_equal(data.ssthresh, UINT32_MAX, "");
+
+	/* Slow start grows by at most one MSS per ACK */
+	cc->ack(&data, 500U);
+	zassert_equal(data.cwnd, 4500U, "");
+	cc->ack(&data, 3000U);
+	zassert_equal(data.cwnd, 5500U, "");
+
+	/* A loss halves the flight size */
+	cc->loss(&data, 10000U);
+	zassert_equal(data.ssthresh, 5000U, "");
+	zassert_equal(data.cwnd, 5000U, "");
+
+	/* Congestion avoidance adds MSS * MSS / cwnd per ACK */
+	cc->ack(&data, 1000U);
+	zassert_equal(data.cwnd, 5200U, "");
+
+	/* The threshold does not drop below two segments */
+	cc->loss(&data, 1000U);
+	zassert_equal(data.ssthresh, 2000U, "");
+	zassert_equal(data.cwnd, 2000U, "");
+}
+
+static void test_cc_cubic(void)
+{
+	const struct tcp_cc *cc = tcp_cc_find("cubic");
+	struct tcp_cc_data data = { .mss = 1000U };
+	u32_t cwnd;
+	int i;
+
+	cc->init(&data);
+	zassert_equal(data.cwnd, INITIAL_WINDOW(1000U), "");
+
+	for (i = 0; i < 6; i++) {
+		cc->ack(&data, 1000U);
+	}
+
+	zassert_equal(data.cwnd, 10000U, "");
+
+	/* Multiplicative decrease by 0.7 */
+	cc->loss(&data, data.cwnd);
+	zassert_equal(data.cubic.w_max, 10000U, "");
+	zassert_equal(data.ssthresh, 7000U, "");
+	zassert_equal(data.cwnd, 7000U, "");
+
+	/* Right after the loss the window stays in the concave region */
+	cc->ack(&data, 1000U);
+	zassert_true(data.cwnd >= 7000U && data.cwnd < 7100U,
+		     "cwnd %u", data.cwnd);
+
+	/* A loss below w_max releases bandwidth, fast convergence */
+	cwnd = data.cwnd;
+	cc->loss(&data, cwnd);
+	zassert_equal(data.cubic.w_max, cwnd * 17U / 20U, "");
+	zassert_equal(data.cwnd, cwnd * 7U / 10U, "");
+}
+
+static void tcp_connect(u16_t port, int *c_sock, int *s_sock, int *new_sock)
+{
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, 0, c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, port, s_sock, &s_saddr);
+
+	zassert_equal(bind(*s_sock, (struct sockaddr *)&s_saddr,
+			   sizeof(s_saddr)), 0, "bind failed");
+	zassert_equal(listen(*s_sock, 1), 0, "listen failed");
+	zassert_equal(connect(*c_sock, (struct sockaddr *)&s_saddr,
+			      sizeof(s_saddr)), 0, "connect failed");
+
+	*new_sock = accept(*s_sock, &addr, &addrlen);
+	zassert_true(*new_sock >= 0, "accept failed");
+}
+
+static void tcp_close(int c_sock, int s_sock, int new_sock)
+{
+	zassert_equal(close(new_sock), 0, "close failed");
+	zassert_equal(close(c_sock), 0, "close failed");
+	zassert_equal(close(s_sock), 0, "close failed");
+
+	/* Let the connections go through their shutdown */
+	k_sleep(K_MSEC(500));
+}
+
+static void get_stats(int sock, struct net_tcp_conn_stats *stats)
+{
+	struct net_context *ctx = z_get_fd_obj(sock, NULL, 0);
+
+	zassert_not_null(ctx, "no context for socket %d", sock);
+	zassert_equal(net_tcp_get_conn_stats(ctx, stats), 0, "no stats");
+}
+
+static void test_tcp2_options(void)
+{
+	struct net_tcp_conn_stats c, s;
+	int c_sock, s_sock, new_sock;
+
+	tcp_connect(SERVER_PORT, &c_sock, &s_sock, &new_sock);
+
+	get_stats(c_sock, &c);
+	get_stats(new_sock, &s);
+
+	/* Options are used only when both SYNs carried them */
+	zassert_equal(c.sack, IS_ENABLED(CONFIG_NET_TCP2_SACK), "client SACK");
+	zassert_equal(s.sack, IS_ENABLED(CONFIG_NET_TCP2_SACK), "server SACK");
+
+	zassert_equal(c.snd_wscale, s.rcv_wscale, "window scale mismatch");
+	zassert_equal(s.snd_wscale, c.rcv_wscale, "window scale mismatch");
+
+	/* Each side uses the MSS announced by the other */
+	zassert_true(c.mss > 0, "no MSS");
+	zassert_equal(c.mss, s.mss, "MSS mismatch");
+
+	zassert_equal(c.cwnd, INITIAL_WINDOW(c.mss), "initial window");
+	zassert_equal(c.bytes_sent, 0, "");
+
+	tcp_close(c_sock, s_sock, new_sock);
+}
+
+static void test_tcp2_cwnd(void)
+{
+	static u8_t buf[TEST_CHUNK * TEST_CHUNKS];
+	struct net_tcp_conn_stats c, s;
+	int c_sock, s_sock, new_sock;
+	u32_t initial;
+	size_t received = 0;
+	ssize_t ret;
+	int i;
+
+	/* A new port, the previous connection may still be in TIME_WAIT */
+	tcp_connect(SERVER_PORT + 1, &c_sock, &s_sock, &new_sock);
+
+	get_stats(c_sock, &c);
+	initial = c.cwnd;
+
+	for (i = 0; i < TEST_CHUNKS; i++) {
+		zassert_equal(send(c_sock, buf, TEST_CHUNK, 0), TEST_CHUNK,
+			      "send failed");
+	}
+
+	while (received < sizeof(buf)) {
+		ret = recv(new_sock, buf, sizeof(buf), 0);
+		zassert_true(ret > 0, "recv failed");
+		received += ret;
+	}
+
+	for (i = 0; i < 10; i++) {
+		get_stats(c_sock, &c);
+		if (c.bytes_acked == sizeof(buf)) {
+			break;
+		}
+
+		k_sleep(K_MSEC(100));
+	}
+
+	zassert_equal(c.bytes_acked, sizeof(buf), "data not acknowledged");
+
+	/* Still in slow start, each ACK adds at most what it acknowledged */
+	zassert_true(c.cwnd > initial, "cwnd did not grow");
+	zassert_true(c.cwnd <= initial + sizeof(buf), "cwnd grew too fast");
+	zassert_equal(c.ssthresh, UINT32_MAX, "");
+
+	get_stats(new_sock, &s);
+	zassert_equal(s.bytes_received, sizeof(buf), "");
+
+	tcp_close(c_sock, s_sock, new_sock);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_tcp2,
+			 ztest_unit_test(test_cc_find),
+			 ztest_unit_test(test_cc_newreno),
+			 ztest_unit_test(test_cc_cubic),
+			 ztest_unit_test(test_tcp2_options),
+			 ztest_unit_test(test_tcp2_cwnd));
+	ztest_run_test_suite(net_tcp2);
+}
@@ -0,0 +1,278 @@
+/* main.c - TCP generic receive offload tests */
+
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr.h>
+#include <zephyr/types.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <device.h>
+#include <init.h>
+#include <sys/byteorder.h>
+#include <net/buf.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_ip.h>
+#include <net/ethernet.h>
+#include <net/dummy.h>
+
+#include <ztest.h>
+
+#include "net_private.h"
+#include "connection.h"
+#include "tcp_internal.h"
+#include "ipv4.h"
+
+#define SEG_LEN 64
+#define MY_PORT 4242
+#define PEER_PORT 4243
+#define WAIT_TIME K_MSEC(100)
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_if *iface;
+static struct net_conn_handle *handle;
+static struct k_sem recv_sem;
+
+static int recv_count;
+static size_t recv_len;
+static u8_t recv_flags;
+static u8_t recv_buf[4 * SEG_LEN];
+
+struct net_gro_context {
+	u8_t mac_addr[sizeof(struct net_eth_addr)];
+};
+
+static struct net_gro_context net_gro_context_data;
+
+static int net_gro_dev_init(struct device *dev)
+{
+	return 0;
+}
+
+static void net_gro_iface_init(struct net_if *iface)
+{
+	struct net_gro_context *context =
+		net_if_get_device(iface)->driver_data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	context->mac_addr[0] = 0x00;
+	context->mac_addr[1] = 0x00;
+	context->mac_addr[2] = 0x5E;
+	context->mac_addr[3] = 0x00;
+	context->mac_addr[4] = 0x53;
+	context->mac_addr[5] = 0x01;
+
+	net_if_set_link_addr(iface, context->mac_addr,
+			     sizeof(context->mac_addr), NET_LINK_ETHERNET);
+}
+
+static int tester_send(struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api net_gro_if_api = {
+	.iface_api.init = net_gro_iface_init,
+	.send = tester_send,
+};
+
+NET_DEVICE_INIT(net_gro_test, "net_gro_test",
+		net_gro_dev_init, &net_gro_context_data, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&net_gro_if_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2),
+		NET_IPV4_MTU);
+
+static enum net_verdict tcp_received(struct net_conn *conn,
+				     struct net_pkt *pkt,
+				     union net_ip_header *ip_hdr,
+				     union net_proto_header *proto_hdr,
+				     void *user_data)
+{
+	size_t len = net_pkt_remaining_data(pkt);
+
+	if (recv_len + len <= sizeof(recv_buf) &&
+	    !net_pkt_read(pkt, recv_buf + recv_len, len)) {
+		recv_len += len;
+	}
+
+	recv_flags = proto_hdr->tcp->flags;
+	recv_count++;
+
+	net_pkt_unref(pkt);
+
+	k_sem_give(&recv_sem);
+
+	return NET_OK;
+}
+
+static void send_segment(u32_t seq, u8_t flags)
+{
+	struct net_tcp_hdr tcp_hdr = { 0 };
+	u8_t data[SEG_LEN];
+	struct net_pkt *pkt;
+	int i;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(tcp_hdr) + SEG_LEN,
+					AF_INET, IPPROTO_TCP, K_FOREVER);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	zassert_equal(net_ipv4_create(pkt, &peer_addr, &my_addr), 0,
+		      "Cannot create IPv4 header");
+
+	tcp_hdr.src_port = htons(PEER_PORT);
+	tcp_hdr.dst_port = htons(MY_PORT);
+	sys_put_be32(seq, tcp_hdr.seq);
+	sys_put_be32(1, tcp_hdr.ack);
+	tcp_hdr.offset = (sizeof(tcp_hdr) / 4U) << 4;
+	tcp_hdr.flags = flags;
+	sys_put_be16(NET_IPV4_MTU, tcp_hdr.wnd);
+
+	/* The payload is the low byte of the sequence number of each byte */
+	for (i = 0; i < SEG_LEN; i++) {
+		data[i] = (u8_t)(seq + i);
+	}
+
+	zassert_equal(net_pkt_write(pkt, &tcp_hdr, sizeof(tcp_hdr)), 0,
+		      "Cannot write TCP header");
+	zassert_equal(net_pkt_write(pkt, data, sizeof(data)), 0,
+		      "Cannot write data");
+
+	net_pkt_cursor_init(pkt);
+	zassert_equal(net_ipv4_finalize(pkt, IPPROTO_TCP), 0,
+		      "Cannot finalize packet");
+
+	net_pkt_cursor_init(pkt);
+	zassert_equal(net_recv_data(iface, pkt), 0, "Cannot receive packet");
+}
+
+/* Wait for all the deliveries, and check the data received */
+static void check_received(int count, size_t len, u32_t seq)
+{
+	size_t i;
+
+	while (k_sem_take(&recv_sem, WAIT_TIME) == 0) {
+	}
+
+	zassert_equal(recv_count, count, "Received %d packets, expected %d",
+		      recv_count, count);
+	zassert_equal(recv_len, len, "Received %zu bytes, expected %zu",
+		      recv_len, len);
+
+	for (i = 0; i < len; i++) {
+		zassert_equal(recv_buf[i], (u8_t)(seq + i),
+			      "Invalid data at %zu", i);
+	}
+
+	recv_count = 0;
+	recv_len = 0;
+}
+
+static void test_gro_setup(void)
+{
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+	};
+	struct sockaddr_in remote = {
+		.sin_family = AF_INET,
+	};
+	int ret;
+
+	k_sem_init(&recv_sem, 0, UINT_MAX);
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "No dummy interface");
+
+	zassert_not_null(net_if_ipv4_addr_add(iface, &my_addr,
+					      NET_ADDR_MANUAL, 0),
+			 "Cannot add IPv4 address");
+
+	net_ipaddr_copy(&local.sin_addr, &my_addr);
+	net_ipaddr_copy(&remote.sin_addr, &peer_addr);
+
+	ret = net_conn_register(IPPROTO_TCP, AF_INET,
+				(struct sockaddr *)&remote,
+				(struct sockaddr *)&local,
+				PEER_PORT, MY_PORT, tcp_received, NULL,
+				&handle);
+	zassert_equal(ret, 0, "Cannot register connection (%d)", ret);
+}
+
+static void test_gro_single(void)
+{
+	/* Nothing is queued behind it, so it is delivered as is */
+	send_segment(0, NET_TCP_ACK);
+
+	check_received(1, SEG_LEN, 0);
+}
+
+static void test_gro_coalesce(void)
+{
+	/* Queue the whole burst before the Rx thread gets to run */
+	k_sched_lock();
+	send_segment(100, NET_TCP_ACK);
+	send_segment(100 + SEG_LEN, NET_TCP_ACK);
+	send_segment(100 + 2 * SEG_LEN, NET_TCP_ACK | NET_TCP_PSH);
+	k_sched_unlock();
+
+	check_received(1, 3 * SEG_LEN, 100);
+
+	zassert_true(recv_flags & NET_TCP_PSH, "PSH flag lost");
+}
+
+static void test_gro_hole(void)
+{
+	k_sched_lock();
+	send_segment(1000, NET_TCP_ACK);
+	send_segment(1000 + 2 * SEG_LEN, NET_TCP_ACK);
+	k_sched_unlock();
+
+	/* Out of order segments are not coalesced */
+	while (k_sem_take(&recv_sem, WAIT_TIME) == 0) {
+	}
+
+	zassert_equal(recv_count, 2, "Received %d packets, expected 2",
+		      recv_count);
+
+	recv_count = 0;
+	recv_len = 0;
+}
+
+static void test_gro_control(void)
+{
+	k_sched_lock();
+	send_segment(2000, NET_TCP_ACK);
+	send_segment(2000 + SEG_LEN, NET_TCP_ACK | NET_TCP_FIN);
+	k_sched_unlock();
+
+	/* The FIN is delivered on its own, after the held segment */
+	check_received(2, 2 * SEG_LEN, 2000);
+}
+
+static void test_gro_cleanup(void)
+{
+	zassert_equal(net_conn_unregister(handle), 0,
+		      "Cannot unregister connection");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_tcp_gro,
+			 ztest_unit_test(test_gro_setup),
+			 ztest_unit_test(test_gro_single),
+			 ztest_unit_test(test_gro_coalesce),
+			 ztest_unit_test(test_gro_hole),
+			 ztest_unit_test(test_gro_control),
+			 ztest_unit_test(test_gro_cleanup));
+
+	ztest_run_test_suite(net_tcp_gro);
+}
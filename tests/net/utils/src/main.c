@@ -832,12 +832,99 @@ void test_addr_parse(void)
 #endif
 }
 
+/* Chunk sizes of the UDP payload, the odd ones exercise the byte carried
+ * over the fragment boundaries.
+ */
+static const u8_t chksum_frags[] = { 23, 1, 77, 20 };
+
+static u16_t chksum_ref(const u8_t *data, size_t len, u32_t sum)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		sum += (i % 2) ? data[i] : data[i] << 8;
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+void test_chksum(void)
+{
+	u8_t data[sizeof(struct net_ipv6_hdr) + 23 + 1 + 77 + 20];
+	struct net_ipv6_hdr *hdr = (struct net_ipv6_hdr *)data;
+	size_t payload_len = sizeof(data) - sizeof(*hdr);
+	struct in6_addr new_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x42 } } };
+	struct net_pkt *pkt;
+	struct net_buf *frag;
+	size_t offset;
+	u16_t chksum, ref;
+	int i;
+
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = (i * 7U + 3U) ^ (i >> 3);
+	}
+
+	hdr->vtc = 0x60;
+	hdr->len = htons(payload_len);
+	hdr->nexthdr = IPPROTO_UDP;
+
+	pkt = net_pkt_alloc(K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	net_pkt_set_family(pkt, AF_INET6);
+	net_pkt_set_ip_hdr_len(pkt, sizeof(*hdr));
+
+	offset = 0;
+	for (i = 0; i < ARRAY_SIZE(chksum_frags); i++) {
+		size_t len = chksum_frags[i];
+
+		if (i == 0) {
+			len += sizeof(*hdr);
+		}
+
+		frag = net_pkt_get_frag(pkt, K_NO_WAIT);
+		zassert_not_null(frag, "Cannot allocate frag");
+
+		net_buf_add_mem(frag, data + offset, len);
+		net_pkt_frag_add(pkt, frag);
+		offset += len;
+	}
+
+	ref = chksum_ref((u8_t *)&hdr->src, 2 * sizeof(struct in6_addr),
+			 payload_len + IPPROTO_UDP);
+	ref = chksum_ref(data + sizeof(*hdr), payload_len, ref);
+	ref = ~ref;
+
+	chksum = net_calc_chksum(pkt, IPPROTO_UDP);
+	zassert_equal(ntohs(chksum), ref, "Checksum 0x%04x, expected 0x%04x",
+		      ntohs(chksum), ref);
+
+	/* Changing the destination address must give the same result
+	 * incrementally as a full recomputation.
+	 */
+	chksum = net_calc_chksum_update(chksum, &hdr->dst, &new_addr,
+					sizeof(new_addr));
+
+	net_ipaddr_copy(&NET_IPV6_HDR(pkt)->dst, &new_addr);
+
+	zassert_equal(chksum, net_calc_chksum(pkt, IPPROTO_UDP),
+		      "Incremental checksum update mismatch");
+
+	net_pkt_unref(pkt);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_utils_fn,
 			 ztest_unit_test(test_net_addr),
 			 ztest_user_unit_test(test_net_addr),
-			 ztest_unit_test(test_addr_parse));
+			 ztest_unit_test(test_addr_parse),
+			 ztest_unit_test(test_chksum));
 
 	ztest_run_test_suite(test_utils_fn);
 }
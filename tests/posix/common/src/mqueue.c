@@ -107,3 +107,62 @@ void test_posix_mqueue(void)
 		      "unable to close message queue descriptor.");
 	zassert_false(mq_unlink(queue), "Not able to unlink Queue");
 }
+
+void test_posix_mqueue_prio(void)
+{
+	static const unsigned int prios[MESG_COUNT_PERMQ] = { 1, 5, 1, 3 };
+	static const unsigned int order[MESG_COUNT_PERMQ] = { 1, 3, 0, 2 };
+	char data[MESSAGE_SIZE];
+	struct mq_attr attrs;
+	unsigned int prio;
+	char *buf;
+	mqd_t mqd;
+	int i;
+
+	attrs.mq_msgsize = MESSAGE_SIZE;
+	attrs.mq_maxmsg = MESG_COUNT_PERMQ;
+
+	mqd = mq_open(queue, O_RDWR | O_CREAT | O_NONBLOCK, 0777, &attrs);
+	zassert_not_equal(mqd, (mqd_t)-1, "unable to open message queue");
+
+	for (i = 0; i < MESG_COUNT_PERMQ; i++) {
+		data[0] = i;
+		zassert_false(mq_send(mqd, data, 1, prios[i]),
+			      "unable to send message");
+	}
+
+	zassert_equal(mq_send(mqd, data, 1, 0), -1, "queue is not full");
+	zassert_equal(errno, EAGAIN, NULL);
+
+	/* Highest priority first, FIFO within a priority */
+	for (i = 0; i < MESG_COUNT_PERMQ; i++) {
+		zassert_equal(mq_receive(mqd, data, MESSAGE_SIZE, &prio), 1,
+			      "unable to receive message");
+		zassert_equal(data[0], order[i], "wrong message order");
+		zassert_equal(prio, prios[order[i]], "wrong priority");
+	}
+
+	zassert_equal(mq_send(mqd, data, 1, CONFIG_MQUEUE_PRIO_MAX), -1,
+		      "invalid priority accepted");
+	zassert_equal(errno, EINVAL, NULL);
+
+	zassert_equal(mq_receive_np(mqd, &buf, &prio), -1, "queue is not empty");
+	zassert_equal(errno, EAGAIN, NULL);
+
+	/* Zero-copy: the receiver gets the buffer filled by the sender */
+	buf = mq_alloc_np(mqd);
+	zassert_not_null(buf, "unable to allocate message buffer");
+	strcpy(buf, send_data);
+	zassert_false(mq_send_np(mqd, buf, sizeof(send_data), 2),
+		      "unable to send message buffer");
+
+	zassert_equal(mq_receive_np(mqd, &buf, &prio), sizeof(send_data),
+		      "unable to receive message buffer");
+	zassert_equal(prio, 2, "wrong priority");
+	zassert_false(strcmp(buf, send_data), "Error in data reception");
+	zassert_false(mq_free_np(mqd, buf), "unable to free message buffer");
+
+	zassert_false(mq_close(mqd),
+		      "unable to close message queue descriptor.");
+	zassert_false(mq_unlink(queue), "Not able to unlink Queue");
+}
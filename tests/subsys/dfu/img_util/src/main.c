@@ -7,6 +7,8 @@
 #include <ztest.h>
 #include <storage/flash_map.h>
 #include <dfu/flash_img.h>
+#include <dfu/flash_img_delta.h>
+#include <sys/byteorder.h>
 
 void test_collecting(void)
 {
@@ -59,6 +61,23 @@ void test_collecting(void)
 	zassert(flash_img_buffered_write(&ctx, data, 0, true) == 0, "pass",
 					 "fail");
 
+#ifdef CONFIG_IMG_HASH_PROGRESSIVELY
+	struct tc_sha256_state_struct sha256;
+	u8_t expected[TC_SHA256_DIGEST_SIZE];
+	u8_t hash[TC_SHA256_DIGEST_SIZE];
+
+	(void)tc_sha256_init(&sha256);
+	for (i = 0U; i < 300 * sizeof(data); i++) {
+		temp = i;
+		(void)tc_sha256_update(&sha256, &temp, 1);
+	}
+	(void)tc_sha256_final(expected, &sha256);
+
+	ret = flash_img_hash_get(&ctx, hash);
+	zassert_true(ret == 0, "Hash failure (%d)", ret);
+	zassert_mem_equal(hash, expected, sizeof(hash), "Wrong image hash");
+#endif
+
 
 	ret = flash_area_open(DT_FLASH_AREA_IMAGE_1_ID, &fa);
 	if (ret) {
@@ -83,9 +102,98 @@ void test_collecting(void)
 #endif
 }
 
+#ifdef CONFIG_IMG_DELTA_UPDATE
+#define OLD_SIZE 256
+#define NEW_SIZE 384
+
+static u8_t patch[FLASH_IMG_DELTA_CTRL_SIZE * 3 + NEW_SIZE];
+static size_t patch_len;
+
+static void patch_put_le32(u32_t val)
+{
+	sys_put_le32(val, &patch[patch_len]);
+	patch_len += sizeof(val);
+}
+
+void test_delta(void)
+{
+	struct flash_img_delta_context delta;
+	struct flash_img_context ctx;
+	const struct flash_area *fa;
+	u8_t old[OLD_SIZE], new[NEW_SIZE], temp;
+	size_t i, chunk;
+	int ret;
+
+	for (i = 0; i < OLD_SIZE; i++) {
+		old[i] = i * 7U;
+	}
+
+	ret = flash_area_open(DT_FLASH_AREA_IMAGE_0_ID, &fa);
+	zassert_true(ret == 0, "Flash area open failure (%d)", ret);
+	ret = flash_area_erase(fa, 0, fa->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+	ret = flash_area_write(fa, 0, old, sizeof(old));
+	zassert_true(ret == 0, "Flash write failure (%d)", ret);
+
+	/* New image: the old one with a few changed bytes, followed by
+	 * bytes not found in the old one.
+	 */
+	memcpy(new, old, OLD_SIZE);
+	new[10] ^= 0x55;
+	new[200] ^= 0xaa;
+	for (i = OLD_SIZE; i < NEW_SIZE; i++) {
+		new[i] = i;
+	}
+
+	patch_put_le32(FLASH_IMG_DELTA_MAGIC);
+	patch_put_le32(OLD_SIZE);
+	patch_put_le32(NEW_SIZE);
+	patch_put_le32(OLD_SIZE);
+	patch_put_le32(NEW_SIZE - OLD_SIZE);
+	patch_put_le32(0);
+	for (i = 0; i < OLD_SIZE; i++) {
+		patch[patch_len++] = new[i] - old[i];
+	}
+	memcpy(&patch[patch_len], &new[OLD_SIZE], NEW_SIZE - OLD_SIZE);
+	patch_len += NEW_SIZE - OLD_SIZE;
+
+	ret = flash_img_init(&ctx);
+	zassert_true(ret == 0, "Flash img init");
+	ret = flash_area_erase(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+
+	ret = flash_img_delta_init(&delta, &ctx);
+	zassert_true(ret == 0, "Delta init failure (%d)", ret);
+
+	/* Odd chunks, to split records and headers */
+	for (i = 0; i < patch_len; i += chunk) {
+		chunk = MIN(patch_len - i, 5);
+		ret = flash_img_delta_write(&delta, &patch[i], chunk);
+		zassert_true(ret == 0, "Delta write failure (%d)", ret);
+	}
+
+	zassert_true(flash_img_delta_done(&delta), "Delta not complete");
+	zassert_equal(flash_img_delta_write(&delta, patch, 1), -EINVAL,
+		      "Data accepted after the end of the patch");
+
+	ret = flash_area_open(DT_FLASH_AREA_IMAGE_1_ID, &fa);
+	zassert_true(ret == 0, "Flash area open failure (%d)", ret);
+	for (i = 0; i < NEW_SIZE; i++) {
+		zassert_true(flash_area_read(fa, i, &temp, 1) == 0, NULL);
+		zassert_equal(temp, new[i], "Wrong byte at %zu", i);
+	}
+}
+#else
+void test_delta(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 void test_main(void)
 {
 	ztest_test_suite(test_util,
-			ztest_unit_test(test_collecting));
+			ztest_unit_test(test_collecting),
+			ztest_unit_test(test_delta));
 	ztest_run_test_suite(test_util);
 }
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Test log rate limiting and deduplication
+ *
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <string.h>
+#include <logging/log_backend.h>
+#include <logging/log_ctrl.h>
+#include <logging/log.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+#define REPEAT_NOTE "--- last message repeated %u times ---"
+#define SUPPRESS_NOTE "--- %u messages suppressed ---"
+
+struct backend_cb {
+	size_t counter;
+	const char *last_str;
+	u32_t last_arg;
+	u32_t repeat_cnt;
+	u32_t suppressed_cnt;
+};
+
+static struct backend_cb backend_cb;
+
+static void put(struct log_backend const *const backend,
+		struct log_msg *msg)
+{
+	struct backend_cb *cb = (struct backend_cb *)backend->cb->ctx;
+
+	log_msg_get(msg);
+
+	cb->counter++;
+	cb->last_str = log_msg_str_get(msg);
+	cb->last_arg = log_msg_nargs_get(msg) > 0 ?
+		       log_msg_arg_get(msg, 0) : 0U;
+
+	if (strcmp(cb->last_str, REPEAT_NOTE) == 0) {
+		cb->repeat_cnt = cb->last_arg;
+	} else if (strcmp(cb->last_str, SUPPRESS_NOTE) == 0) {
+		cb->suppressed_cnt = cb->last_arg;
+	}
+
+	log_msg_put(msg);
+}
+
+static void panic(struct log_backend const *const backend)
+{
+	ARG_UNUSED(backend);
+}
+
+const struct log_backend_api log_backend_test_api = {
+	.put = put,
+	.panic = panic,
+};
+
+LOG_BACKEND_DEFINE(backend1, log_backend_test_api, false);
+
+static void process_all(void)
+{
+	while (log_process(false)) {
+	}
+}
+
+/* Lets the rate limit window and pending repeat counts from the previous
+ * test expire, then starts counting from zero.
+ */
+static void log_setup(void)
+{
+	log_init();
+	log_backend_enable(&backend1, &backend_cb, LOG_LEVEL_DBG);
+
+	k_sleep(2 * CONFIG_LOG_RATE_LIMIT_INTERVAL_MS);
+	process_all();
+
+	memset(&backend_cb, 0, sizeof(backend_cb));
+}
+
+static void test_log_dedup_same_args(void)
+{
+	log_setup();
+
+	for (int i = 0; i < 4; i++) {
+		LOG_INF("same %d", 1);
+	}
+	process_all();
+
+	zassert_equal(backend_cb.counter, 1, "Repeats not suppressed");
+
+	LOG_INF("other");
+	process_all();
+
+	/* repeat note followed by the new message */
+	zassert_equal(backend_cb.counter, 3, "Unexpected message count");
+	zassert_equal(backend_cb.repeat_cnt, 3, "Unexpected repeat count");
+	zassert_true(strcmp(backend_cb.last_str, "other") == 0, NULL);
+}
+
+static void test_log_dedup_different_args(void)
+{
+	log_setup();
+
+	for (int i = 0; i < 5; i++) {
+		LOG_INF("rx %d", i);
+	}
+	process_all();
+
+	zassert_equal(backend_cb.counter, 5,
+		      "Messages with different arguments dropped");
+	zassert_equal(backend_cb.last_arg, 4, "Unexpected last argument");
+}
+
+static void test_log_dedup_timer_flush(void)
+{
+	log_setup();
+
+	for (int i = 0; i < 3; i++) {
+		LOG_INF("tick");
+	}
+	process_all();
+
+	zassert_equal(backend_cb.counter, 1, "Repeats not suppressed");
+
+	k_sleep(CONFIG_LOG_RATE_LIMIT_INTERVAL_MS + 50);
+	process_all();
+
+	zassert_equal(backend_cb.counter, 2, "Repeat count not flushed");
+	zassert_true(strcmp(backend_cb.last_str, REPEAT_NOTE) == 0, NULL);
+	zassert_equal(backend_cb.last_arg, 2, "Unexpected repeat count");
+
+	/* After the flush the message is printed again */
+	LOG_INF("tick");
+	process_all();
+
+	zassert_equal(backend_cb.counter, 3, "Message not printed");
+}
+
+static void test_log_burst_limit(void)
+{
+	log_setup();
+
+	for (int i = 0; i < CONFIG_LOG_RATE_LIMIT_BURST + 5; i++) {
+		LOG_INF("burst %d", i);
+	}
+	process_all();
+
+	zassert_equal(backend_cb.counter, CONFIG_LOG_RATE_LIMIT_BURST,
+		      "Burst limit not applied");
+
+	k_sleep(CONFIG_LOG_RATE_LIMIT_INTERVAL_MS + 10);
+	LOG_INF("after");
+	process_all();
+
+	zassert_equal(backend_cb.counter, CONFIG_LOG_RATE_LIMIT_BURST + 2,
+		      "Unexpected message count");
+	zassert_equal(backend_cb.suppressed_cnt, 5,
+		      "Unexpected suppressed count");
+	zassert_true(strcmp(backend_cb.last_str, "after") == 0, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_log_rate_limit,
+			 ztest_unit_test(test_log_dedup_same_args),
+			 ztest_unit_test(test_log_dedup_different_args),
+			 ztest_unit_test(test_log_dedup_timer_flush),
+			 ztest_unit_test(test_log_burst_limit));
+	ztest_run_test_suite(test_log_rate_limit);
+}
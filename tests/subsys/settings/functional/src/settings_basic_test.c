@@ -613,6 +613,46 @@ static void test_direct_loading_filter(void)
 	}
 }
 
+#define BENCH_SETTINGS_COUNT 100
+
+static int bench_loader(const char *key, size_t len, settings_read_cb read_cb,
+			void *cb_arg, void *param)
+{
+	u32_t value;
+
+	if (read_cb(cb_arg, &value, sizeof(value)) == sizeof(value)) {
+		(*(int *)param)++;
+	}
+
+	return 0;
+}
+
+/* Measure how long loading a populated settings area takes, this is what
+ * dominates boot time on devices with many stored settings.
+ */
+static void test_load_benchmark(void)
+{
+	char name[32];
+	u32_t start, cycles;
+	int loaded = 0;
+	int rc;
+
+	for (u32_t i = 0; i < BENCH_SETTINGS_COUNT; i++) {
+		snprintk(name, sizeof(name), "bench/%u", i);
+		rc = settings_save_one(name, &i, sizeof(i));
+		zassert_equal(0, rc, "can't save %s", name);
+	}
+
+	start = k_cycle_get_32();
+	rc = settings_load_subtree_direct("bench", bench_loader, &loaded);
+	cycles = k_cycle_get_32() - start;
+	zassert_equal(0, rc, NULL);
+	zassert_equal(BENCH_SETTINGS_COUNT, loaded, "loaded %d settings",
+		      loaded);
+
+	TC_PRINT("Loaded %d settings in %u us\n", loaded,
+		 k_cyc_to_us_floor32(cycles));
+}
 
 void test_main(void)
 {
@@ -621,7 +661,8 @@ void test_main(void)
 			 ztest_unit_test(test_support_rtn),
 			 ztest_unit_test(test_register_and_loading),
 			 ztest_unit_test(test_direct_loading),
-			 ztest_unit_test(test_direct_loading_filter)
+			 ztest_unit_test(test_direct_loading_filter),
+			 ztest_unit_test(test_load_benchmark)
 			);
 
 	ztest_run_test_suite(settings_test_suite);
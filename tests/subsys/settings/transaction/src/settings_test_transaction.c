@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <errno.h>
+#include <string.h>
+#include <settings/settings.h>
+
+/* RAM back-end counting the writes made to it */
+#define RAM_ENTRY_CNT 8
+
+struct ram_entry {
+	char name[16];
+	u8_t val[4];
+	size_t len;
+	bool used;
+};
+
+static struct ram_entry ram_entries[RAM_ENTRY_CNT];
+static int ram_save_cnt;
+
+static struct ram_entry *ram_find(const char *name)
+{
+	for (int i = 0; i < ARRAY_SIZE(ram_entries); i++) {
+		if (ram_entries[i].used && !strcmp(ram_entries[i].name, name)) {
+			return &ram_entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+static ssize_t ram_read(void *cb_arg, void *data, size_t len)
+{
+	struct ram_entry *entry = cb_arg;
+
+	len = MIN(len, entry->len);
+	memcpy(data, entry->val, len);
+
+	return len;
+}
+
+static int ram_load(struct settings_store *cs,
+		    const struct settings_load_arg *arg)
+{
+	int rc;
+
+	for (int i = 0; i < ARRAY_SIZE(ram_entries); i++) {
+		struct ram_entry *entry = &ram_entries[i];
+
+		if (!entry->used) {
+			continue;
+		}
+
+		rc = settings_call_set_handler(entry->name, entry->len,
+					       ram_read, entry, arg);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+static int ram_save(struct settings_store *cs, const char *name,
+		    const char *value, size_t val_len)
+{
+	struct ram_entry *entry = ram_find(name);
+
+	ram_save_cnt++;
+
+	if (!val_len) {
+		if (entry) {
+			entry->used = false;
+		}
+		return 0;
+	}
+
+	for (int i = 0; !entry && i < ARRAY_SIZE(ram_entries); i++) {
+		if (!ram_entries[i].used) {
+			entry = &ram_entries[i];
+		}
+	}
+
+	if (!entry || val_len > sizeof(entry->val) ||
+	    strlen(name) >= sizeof(entry->name)) {
+		return -ENOMEM;
+	}
+
+	strcpy(entry->name, name);
+	memcpy(entry->val, value, val_len);
+	entry->len = val_len;
+	entry->used = true;
+
+	return 0;
+}
+
+static struct settings_store_itf ram_itf = {
+	.csi_load = ram_load,
+	.csi_save = ram_save,
+};
+
+static struct settings_store ram_store = {
+	.cs_itf = &ram_itf,
+};
+
+int settings_backend_init(void)
+{
+	settings_src_register(&ram_store);
+	settings_dst_register(&ram_store);
+
+	return 0;
+}
+
+static void ram_reset(void)
+{
+	memset(ram_entries, 0, sizeof(ram_entries));
+	ram_save_cnt = 0;
+}
+
+static void check_value(const char *name, u8_t exp)
+{
+	struct ram_entry *entry = ram_find(name);
+
+	zassert_not_null(entry, "%s not persisted", name);
+	zassert_equal(1, entry->len, NULL);
+	zassert_equal(exp, entry->val[0], "%s has value %u", name,
+		      entry->val[0]);
+}
+
+static void test_transaction_commit(void)
+{
+	u8_t val;
+	int rc;
+
+	ram_reset();
+
+	val = 1;
+	rc = settings_transaction_set("tx/a", &val, sizeof(val));
+	zassert_equal(-EINVAL, rc, "set without a transaction");
+
+	rc = settings_transaction_begin();
+	zassert_equal(0, rc, NULL);
+
+	/* Only the last value of a name is written */
+	rc = settings_transaction_set("tx/a", &val, sizeof(val));
+	zassert_equal(0, rc, NULL);
+	val = 2;
+	rc = settings_transaction_set("tx/a", &val, sizeof(val));
+	zassert_equal(0, rc, NULL);
+	val = 3;
+	rc = settings_transaction_set("tx/b", &val, sizeof(val));
+	zassert_equal(0, rc, NULL);
+
+	zassert_equal(0, ram_save_cnt, "Written before commit");
+
+	rc = settings_transaction_commit();
+	zassert_equal(0, rc, NULL);
+	zassert_equal(2, ram_save_cnt, NULL);
+	check_value("tx/a", 2);
+	check_value("tx/b", 3);
+
+	/* Values equal to the persisted ones are skipped */
+	rc = settings_transaction_begin();
+	zassert_equal(0, rc, NULL);
+	val = 2;
+	rc = settings_transaction_set("tx/a", &val, sizeof(val));
+	zassert_equal(0, rc, NULL);
+	val = 4;
+	rc = settings_transaction_set("tx/b", &val, sizeof(val));
+	zassert_equal(0, rc, NULL);
+
+	rc = settings_transaction_commit();
+	zassert_equal(0, rc, NULL);
+	zassert_equal(3, ram_save_cnt, NULL);
+	check_value("tx/a", 2);
+	check_value("tx/b", 4);
+}
+
+static void test_transaction_abort(void)
+{
+	u8_t val = 5;
+	int rc;
+
+	ram_reset();
+
+	rc = settings_transaction_begin();
+	zassert_equal(0, rc, NULL);
+	zassert_equal(-EBUSY, settings_transaction_begin(), NULL);
+
+	rc = settings_transaction_set("tx/c", &val, sizeof(val));
+	zassert_equal(0, rc, NULL);
+
+	settings_transaction_abort();
+
+	zassert_equal(0, ram_save_cnt, "Aborted value written");
+	zassert_is_null(ram_find("tx/c"), NULL);
+	zassert_equal(-EINVAL, settings_transaction_commit(),
+		      "Commit without a transaction");
+}
+
+static void test_transaction_delete(void)
+{
+	u8_t val = 6;
+	int rc;
+
+	ram_reset();
+
+	rc = settings_save_one("tx/d", &val, sizeof(val));
+	zassert_equal(0, rc, NULL);
+	zassert_equal(1, ram_save_cnt, NULL);
+
+	rc = settings_transaction_begin();
+	zassert_equal(0, rc, NULL);
+	rc = settings_transaction_set("tx/d", NULL, 0);
+	zassert_equal(0, rc, NULL);
+	/* Deleting a key which is not persisted is skipped */
+	rc = settings_transaction_set("tx/absent", NULL, 0);
+	zassert_equal(0, rc, NULL);
+
+	rc = settings_transaction_commit();
+	zassert_equal(0, rc, NULL);
+	zassert_equal(2, ram_save_cnt, NULL);
+	zassert_is_null(ram_find("tx/d"), "tx/d not deleted");
+}
+
+void test_main(void)
+{
+	zassert_equal(0, settings_subsys_init(), NULL);
+
+	ztest_test_suite(settings_transaction,
+			 ztest_unit_test(test_transaction_commit),
+			 ztest_unit_test(test_transaction_abort),
+			 ztest_unit_test(test_transaction_delete));
+
+	ztest_run_test_suite(settings_transaction);
+}
@@ -23,6 +23,20 @@ void test_crc32_ieee(void)
 	zassert_equal(crc32_ieee(test3, sizeof(test3)), 0x20089AA4, NULL);
 }
 
+void test_crc32_ieee_long(void)
+{
+	/* Long enough for the sliced loops, also from an unaligned start */
+	u8_t test[] = "xThe quick brown fox jumps over the lazy dog";
+	u32_t crc;
+
+	zassert_equal(crc32_ieee(&test[1], sizeof(test) - 2), 0x414FA339,
+		      NULL);
+
+	crc = crc32_ieee_update(0, &test[1], 13);
+	crc = crc32_ieee_update(crc, &test[14], sizeof(test) - 15);
+	zassert_equal(crc, 0x414FA339, NULL);
+}
+
 void test_crc16(void)
 {
 	u8_t test0[] = { };
@@ -126,6 +140,7 @@ void test_main(void)
 {
 	ztest_test_suite(test_crc,
 			 ztest_unit_test(test_crc32_ieee),
+			 ztest_unit_test(test_crc32_ieee_long),
 			 ztest_unit_test(test_crc16),
 			 ztest_unit_test(test_crc16_ansi),
 			 ztest_unit_test(test_crc16_ccitt),
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <ztest.h>
+#include <sys/sarray.h>
+
+#include "../../../lib/os/sarray.c"
+
+#define MAX_ELEMS 64
+
+struct elem {
+	int key;
+};
+
+static struct elem elems[MAX_ELEMS];
+
+SARRAY_DEFINE(by_key, MAX_ELEMS, NULL);
+
+static bool key_lessthan(const void *a, const void *b)
+{
+	return ((const struct elem *)a)->key < ((const struct elem *)b)->key;
+}
+
+/* Simple LCRNG (modulus is 2^64!) cribbed from:
+ * https://nuclear.llnl.gov/CNP/rng/rngman/node4.html
+ *
+ * Don't need much in the way of quality, do need repeatability across
+ * platforms.
+ */
+static unsigned int next_rand_mod(unsigned int mod)
+{
+	static unsigned long long state = 123456789; /* seed */
+
+	state = state * 2862933555777941757ULL + 3037000493ULL;
+
+	return ((unsigned int)(state >> 32)) % mod;
+}
+
+static void check_sorted(struct sarray *sa)
+{
+	struct elem *e, *prev = NULL;
+	size_t n = 0;
+
+	SARRAY_FOR_EACH(sa, e) {
+		if (prev != NULL) {
+			zassert_false(sa->lessthan_fn(e, prev),
+				      "Array is not sorted");
+			/* Elements comparing equal keep insertion order,
+			 * which is the index order in this test.
+			 */
+			zassert_true(prev->key != e->key || prev < e,
+				     "Insertion order not kept");
+		}
+		prev = e;
+		n++;
+	}
+
+	zassert_equal(n, sarray_count(sa), "Wrong element count");
+}
+
+void test_sarray_key(void)
+{
+	int i;
+
+	sarray_init(&by_key, by_key.elems, MAX_ELEMS, key_lessthan);
+
+	/* Few distinct keys, so that there are many duplicates */
+	for (i = 0; i < MAX_ELEMS; i++) {
+		elems[i].key = next_rand_mod(MAX_ELEMS / 4);
+		zassert_equal(sarray_insert(&by_key, &elems[i]), 0, NULL);
+		check_sorted(&by_key);
+	}
+
+	zassert_equal(sarray_insert(&by_key, &elems[0]), -ENOMEM,
+		      "Full array not detected");
+
+	for (i = 0; i < MAX_ELEMS; i++) {
+		zassert_true(sarray_contains(&by_key, &elems[i]), NULL);
+	}
+
+	for (i = 0; i < MAX_ELEMS; i += 2) {
+		zassert_equal(sarray_remove(&by_key, &elems[i]), 0, NULL);
+		check_sorted(&by_key);
+	}
+
+	for (i = 0; i < MAX_ELEMS; i++) {
+		zassert_equal(sarray_contains(&by_key, &elems[i]), i & 1,
+			      "Element %d wrongly found or missing", i);
+	}
+
+	zassert_equal(sarray_remove(&by_key, &elems[0]), -ENOENT,
+		      "Removed element found");
+	zassert_equal(sarray_count(&by_key), MAX_ELEMS / 2, NULL);
+}
+
+void test_sarray_address(void)
+{
+	void *storage[MAX_ELEMS];
+	struct sarray set;
+	int i, idx;
+
+	sarray_init(&set, storage, MAX_ELEMS, NULL);
+	zassert_is_null(sarray_get_min(&set), NULL);
+	zassert_is_null(sarray_get_max(&set), NULL);
+
+	for (i = 0; i < MAX_ELEMS; i++) {
+		idx = (i * 7) % MAX_ELEMS;
+		zassert_equal(sarray_insert(&set, &elems[idx]), 0, NULL);
+	}
+
+	for (i = 0; i < MAX_ELEMS; i++) {
+		zassert_equal(set.elems[i], &elems[i], "Not in address order");
+	}
+
+	zassert_equal(sarray_get_min(&set), &elems[0], NULL);
+	zassert_equal(sarray_get_max(&set), &elems[MAX_ELEMS - 1], NULL);
+
+	/* Only the pointer value is tested, like rb_contains() */
+	zassert_false(sarray_contains(&set, (char *)&elems[1] + 1), NULL);
+
+	zassert_equal(sarray_remove(&set, &elems[MAX_ELEMS - 1]), 0, NULL);
+	zassert_equal(sarray_get_max(&set), &elems[MAX_ELEMS - 2], NULL);
+	zassert_false(sarray_contains(&set, &elems[MAX_ELEMS - 1]), NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_sarray,
+			 ztest_unit_test(test_sarray_key),
+			 ztest_unit_test(test_sarray_address));
+	ztest_run_test_suite(test_sarray);
+}